@@ -3,6 +3,9 @@
 #include <ATen/BatchedFallback.h>
 #include <ATen/native/ResizeCommon.h>
 #include <ATen/ATen.h>
+#include <c10/util/accumulate.h>
+
+#include <numeric>
 
 namespace at {
 
@@ -869,6 +872,52 @@ Tensor mm_batching_rule(const Tensor& self, const Tensor& other) {
   TORCH_INTERNAL_ASSERT(false, "either self or other must be a BatchedTensor");
 }
 
+Tensor matmul_batching_rule(const Tensor& self, const Tensor& other) {
+  auto self_batched = isBatchedTensor(self);
+  auto other_batched = isBatchedTensor(other);
+
+  TORCH_CHECK(/*logical*/self.dim() > 0 && /*logical*/other.dim() > 0,
+      "matmul(self, other): Shape mismatch: both arguments to matmul need to be "
+      "at least 1D (got `self` of size ", self.sizes(), ") ",
+      "and `other` of size ", other.sizes(), ")");
+
+  // at::matmul treats a 1D argument as a vector, but the physical version of a
+  // batched 1D argument is 2D. Turn vectors into matrices on the logical level
+  // and squeeze the corresponding dimensions out of the result at the end.
+  auto self_is_vector = self.dim() == 1;
+  auto other_is_vector = other.dim() == 1;
+  auto self_matrix = self_is_vector ? self.unsqueeze(0) : self;
+  auto other_matrix = other_is_vector ? other.unsqueeze(-1) : other;
+  auto squeeze_result = [&](Tensor result) {
+    if (other_is_vector) {
+      result = result.squeeze(-1);
+    }
+    if (self_is_vector) {
+      result = result.squeeze(-1 - !other_is_vector);
+    }
+    return result;
+  };
+
+  // See Note [Batching rules for matmul-like operators] for why we have cases.
+  // If the unbatched argument is a matrix then at::matmul broadcasts the batch
+  // dims of the batched argument over it without any expansion.
+  if (self_batched && !other_batched && other_matrix.dim() == 2) {
+    auto self_physical = MultiBatchVmapTransform::logicalToPhysical(self_matrix);
+    auto result = at::matmul(self_physical.tensor(), other_matrix);
+    return self_physical.getPhysicalToLogicalMap().apply(squeeze_result(result));
+  }
+  if (!self_batched && other_batched && self_matrix.dim() == 2) {
+    auto other_physical = MultiBatchVmapTransform::logicalToPhysical(other_matrix);
+    auto result = at::matmul(self_matrix, other_physical.tensor());
+    return other_physical.getPhysicalToLogicalMap().apply(squeeze_result(result));
+  }
+  // Otherwise the logical batch dims of the two arguments have to be lined up
+  // with each other, just like in a broadcasting pointwise operator.
+  auto physical_args = BroadcastingVmapTransform::logicalToPhysical({self_matrix, other_matrix});
+  auto result = at::matmul(physical_args[0].tensor(), physical_args[1].tensor());
+  return physical_args[0].getPhysicalToLogicalMap().apply(squeeze_result(result));
+}
+
 Tensor cat_batching_rule(TensorList tensors, int64_t dim) {
   auto physical_views = MultiBatchVmapTransform::logicalToPhysical(tensors);
   auto physical_tensors = fmap(
@@ -893,6 +942,214 @@ Tensor stack_batching_rule(TensorList tensors, int64_t dim) {
   return physical_views[0].getPhysicalToLogicalMap().apply(result);
 }
 
+// Note [Batching rule for convolution]
+// - If only `input` is batched, the vmap dims are folded into the batch
+//   dimension N of the convolution.
+// - If `weight` is batched, we have B different convolutions. This is a
+//   grouped convolution with B * groups groups: the per-example weights get
+//   stacked along dim 0 of the weight and the per-example inputs get stacked
+//   along the channel dim of the input.
+// - If `bias` is batched, it gets added to the result separately.
+Tensor convolution_batching_rule(
+    const Tensor& input, const Tensor& weight, const c10::optional<Tensor>& bias,
+    IntArrayRef stride, IntArrayRef padding, IntArrayRef dilation,
+    bool transposed, IntArrayRef output_padding, int64_t groups) {
+  auto input_batched = isBatchedTensor(input);
+  auto weight_batched = isBatchedTensor(weight);
+  auto bias_batched = bias.has_value() && isBatchedTensor(*bias);
+
+  TORCH_CHECK(/*logical*/input.dim() >= 3 && /*logical*/input.dim() == weight.dim(),
+      "convolution(input, weight): Shape mismatch: expected `input` and `weight` "
+      "with the same number of dimensions (at least 3) "
+      "(got `input` of size ", input.sizes(), ") ",
+      "and `weight` of size ", weight.sizes(), ")");
+
+  if (bias_batched) {
+    auto result = at::convolution(
+        input, weight, c10::nullopt, stride, padding, dilation,
+        transposed, output_padding, groups);
+    // bias: [C_out] -> [C_out, 1, ..., 1] so that it broadcasts over result.
+    VmapDimVector bias_shape(/*logical*/input.dim() - 1, 1);
+    bias_shape[0] = -1;
+    return result + bias->view(bias_shape);
+  }
+
+  if (input_batched && !weight_batched) {
+    // input_physical: [B..., N, C, *spatial] -> [B... * N, C, *spatial]
+    auto input_physical = MultiBatchVmapTransform::logicalToPhysical(input);
+    auto num_batch_dims = input_physical.numBatchDims();
+    auto input_sizes = input_physical.tensor().sizes();
+    VmapDimVector folded_shape = {-1};
+    folded_shape.append(input_sizes.begin() + num_batch_dims + 1, input_sizes.end());
+    auto result = at::convolution(
+        input_physical.tensor().reshape(folded_shape), weight, bias, stride, padding,
+        dilation, transposed, output_padding, groups);
+    VmapDimVector result_shape(input_sizes.begin(), input_sizes.begin() + num_batch_dims + 1);
+    result_shape.append(result.sizes().begin() + 1, result.sizes().end());
+    return input_physical.getPhysicalToLogicalMap().apply(result.view(result_shape));
+  }
+
+  TORCH_INTERNAL_ASSERT(weight_batched, "either input, weight or bias must be a BatchedTensor");
+  // input_physical: [B..., N, C, *spatial] -> [N, B... * C, *spatial]
+  // weight_physical: [B..., C_out, C_in / groups, *kernel] (or, if transposed,
+  // [B..., C_in, C_out / groups, *kernel]) -> [B... * C_out, C_in / groups, *kernel]
+  auto physical_args = MultiBatchVmapTransform::logicalToPhysical({input, weight});
+  auto num_batch_dims = physical_args[0].numBatchDims();
+  auto batch_sizes = physical_args[0].tensor().sizes().slice(0, num_batch_dims);
+  auto batch_numel = c10::multiply_integers(batch_sizes);
+  auto input_grouped = physical_args[0].tensor()
+      .flatten(0, num_batch_dims - 1)
+      .transpose(0, 1)
+      .flatten(1, 2);
+  auto weight_grouped = physical_args[1].tensor().flatten(0, num_batch_dims);
+  c10::optional<Tensor> bias_grouped = c10::nullopt;
+  if (bias.has_value() && bias->defined()) {
+    bias_grouped = bias->repeat({batch_numel});
+  }
+  auto result = at::convolution(
+      input_grouped, weight_grouped, bias_grouped, stride, padding, dilation,
+      transposed, output_padding, groups * batch_numel);
+
+  // result: [N, B... * C_out, *spatial] -> [B..., N, C_out, *spatial]
+  auto result_sizes = result.sizes();
+  VmapDimVector result_shape = {result_sizes[0]};
+  result_shape.append(batch_sizes.begin(), batch_sizes.end());
+  result_shape.push_back(-1);
+  result_shape.append(result_sizes.begin() + 2, result_sizes.end());
+  VmapDimVector source(num_batch_dims);
+  std::iota(source.begin(), source.end(), 1);
+  VmapDimVector destination(num_batch_dims);
+  std::iota(destination.begin(), destination.end(), 0);
+  auto result_physical = result.view(result_shape).movedim(source, destination);
+  return physical_args[0].getPhysicalToLogicalMap().apply(result_physical);
+}
+
+Tensor conv_batching_rule(
+    const Tensor& input, const Tensor& weight, const c10::optional<Tensor>& bias,
+    IntArrayRef stride, IntArrayRef padding, IntArrayRef dilation, int64_t groups) {
+  return at::convolution(
+      input, weight, bias, stride, padding, dilation,
+      /*transposed=*/false, /*output_padding=*/{0}, groups);
+}
+
+Tensor conv_transpose_batching_rule(
+    const Tensor& input, const Tensor& weight, const c10::optional<Tensor>& bias,
+    IntArrayRef stride, IntArrayRef padding, IntArrayRef output_padding,
+    int64_t groups, IntArrayRef dilation) {
+  return at::convolution(
+      input, weight, bias, stride, padding, dilation,
+      /*transposed=*/true, output_padding, groups);
+}
+
+Tensor index_select_batching_rule(const Tensor& self, int64_t dim, const Tensor& index) {
+  // index_select on a zero-dim `self` returns a zero-dim tensor. Give `self`
+  // a logical dim so that `dim` can be mapped to a physical dim.
+  if (/*logical*/self.dim() == 0) {
+    return at::index_select(self.unsqueeze(0), 0, index).squeeze(0);
+  }
+
+  if (!isBatchedTensor(index)) {
+    auto self_physical = MultiBatchVmapTransform::logicalToPhysical(self);
+    auto dim_physical = self_physical.getPhysicalDim(dim);
+    auto result = at::index_select(self_physical.tensor(), dim_physical, index);
+    return self_physical.getPhysicalToLogicalMap().apply(result);
+  }
+
+  TORCH_CHECK(/*logical*/index.dim() <= 1,
+      "index_select(self, dim, index): Index is supposed to be a vector "
+      "(got `index` of size ", index.sizes(), ")");
+
+  // A batched index selects different elements for every example, which is a
+  // gather with the index expanded over all of the other dims:
+  // self_physical: [B..., *sizes], index_physical: [B..., K]
+  // -> gather(self_physical, dim_physical, index_expanded: [B..., *sizes with K at dim])
+  auto physical_args = MultiBatchVmapTransform::logicalToPhysical({self, index.reshape({-1})});
+  const auto& self_physical = physical_args[0];
+  const auto& index_physical = physical_args[1];
+  auto dim_physical = self_physical.getPhysicalDim(dim);
+  auto num_batch_dims = self_physical.numBatchDims();
+  auto index_sizes = index_physical.tensor().sizes();
+
+  VmapDimVector view_shape(self_physical.tensor().dim(), 1);
+  std::copy(index_sizes.begin(), index_sizes.begin() + num_batch_dims, view_shape.begin());
+  view_shape[dim_physical] = index_sizes.back();
+  VmapDimVector expanded_shape(self_physical.tensor().sizes().begin(), self_physical.tensor().sizes().end());
+  expanded_shape[dim_physical] = index_sizes.back();
+
+  auto index_expanded = index_physical.tensor().view(view_shape).expand(expanded_shape);
+  auto result = at::gather(self_physical.tensor(), dim_physical, index_expanded);
+  return self_physical.getPhysicalToLogicalMap().apply(result);
+}
+
+// gather/scatter-like operators already work independently along `dim` for
+// every position along the other dims, so lining up the batch dims of all of
+// the arguments at the front is enough. Zero-dim arguments get a logical dim
+// so that `dim` can be mapped to a physical dim.
+Tensor gather_batching_rule(const Tensor& self, int64_t dim, const Tensor& index, bool sparse_grad) {
+  if (/*logical*/self.dim() == 0 && /*logical*/index.dim() == 0) {
+    return at::gather(self.unsqueeze(0), 0, index.unsqueeze(0), sparse_grad).squeeze(0);
+  }
+  auto physical_args = MultiBatchVmapTransform::logicalToPhysical({self, index});
+  auto dim_physical = physical_args[0].getPhysicalDim(dim);
+  auto result = at::gather(
+      physical_args[0].tensor(), dim_physical, physical_args[1].tensor(), sparse_grad);
+  return physical_args[0].getPhysicalToLogicalMap().apply(result);
+}
+
+template <typename F, F Func>
+Tensor scatter_batching_rule(const Tensor& self, int64_t dim, const Tensor& index, const Tensor& src) {
+  if (/*logical*/self.dim() == 0 && /*logical*/index.dim() == 0 && /*logical*/src.dim() == 0) {
+    return Func(self.unsqueeze(0), 0, index.unsqueeze(0), src.unsqueeze(0)).squeeze(0);
+  }
+  auto physical_args = MultiBatchVmapTransform::logicalToPhysical({self, index, src});
+  auto dim_physical = physical_args[0].getPhysicalDim(dim);
+  auto result = Func(
+      physical_args[0].tensor(), dim_physical,
+      physical_args[1].tensor(), physical_args[2].tensor());
+  return physical_args[0].getPhysicalToLogicalMap().apply(result);
+}
+
+Tensor scatter_value_batching_rule(const Tensor& self, int64_t dim, const Tensor& index, Scalar value) {
+  if (/*logical*/self.dim() == 0 && /*logical*/index.dim() == 0) {
+    return at::scatter(self.unsqueeze(0), 0, index.unsqueeze(0), value).squeeze(0);
+  }
+  auto physical_args = MultiBatchVmapTransform::logicalToPhysical({self, index});
+  auto dim_physical = physical_args[0].getPhysicalDim(dim);
+  auto result = at::scatter(
+      physical_args[0].tensor(), dim_physical, physical_args[1].tensor(), value);
+  return physical_args[0].getPhysicalToLogicalMap().apply(result);
+}
+
+// Note [Batching rules for linalg operators]
+// Most linalg operators already treat all but the last two dims of their input
+// as batch dims, so moving the vmap dims to the front is all that is needed.
+// The logical input must still be a matrix (or a batch of them): otherwise the
+// operator would silently treat a vmap dim as one of the matrix dims.
+static void checkLinalgInput(const Tensor& self) {
+  TORCH_CHECK(/*logical*/self.dim() >= 2,
+      "Expected a tensor with 2 or more dimensions of size (*, m, n) ",
+      "(got a tensor of size ", self.sizes(), ")");
+}
+
+template <typename F, F Func, typename... ExtraArgs>
+Tensor linalg_batching_rule(const Tensor& self, ExtraArgs... extra_args) {
+  checkLinalgInput(self);
+  auto self_physical = MultiBatchVmapTransform::logicalToPhysical(self);
+  auto result = Func(self_physical.tensor(), extra_args...);
+  return self_physical.getPhysicalToLogicalMap().apply(result);
+}
+
+template <typename F, F Func, typename... ExtraArgs>
+std::tuple<Tensor,Tensor> linalg_tuple_batching_rule(const Tensor& self, ExtraArgs... extra_args) {
+  checkLinalgInput(self);
+  auto self_physical = MultiBatchVmapTransform::logicalToPhysical(self);
+  auto results = Func(self_physical.tensor(), extra_args...);
+  auto physical_to_logical_map = self_physical.getPhysicalToLogicalMap();
+  return std::make_tuple(
+      physical_to_logical_map.apply(std::get<0>(results)),
+      physical_to_logical_map.apply(std::get<1>(results)));
+}
+
 // I am quite sad that we need to register operators with exploded TensorOptions,
 // even though the native:: implementations can use TensorOptions&.
 // This also makes it hard to metaprogram: i.e., we can't use
@@ -1013,6 +1270,16 @@ Tensor comparison_pointwise_batching_rule(const Tensor& self, const Tensor& othe
   return physical_args[0].getPhysicalToLogicalMap().apply(result);
 }
 
+// Forward-mode AD with batched tangents: only the tangent is vmapped over and
+// it is attached as is to the (regular) primal. See Note [Batched tangents]
+// in torch/csrc/autograd/autograd_meta.cpp.
+Tensor _make_dual_batching_rule(const Tensor& primal, const Tensor& tangent, int64_t level) {
+  TORCH_CHECK(!isBatchedTensor(primal),
+      "vmap: make_dual(primal, tangent) is only supported when the tangent is ",
+      "vmapped over, not the primal.");
+  return native::_make_dual(primal, tangent, level);
+}
+
 TORCH_LIBRARY_IMPL(_, Batched, m) {
   m.fallback(torch::CppFunction::makeFromBoxedFunction<&batchedTensorForLoopFallback>());
 }
@@ -1025,6 +1292,7 @@ TORCH_LIBRARY_IMPL(aten, Batched, m) {
   m.impl("size.int", static_cast<int64_t (*)(const Tensor&, int64_t)>(native::size));
   m.impl("_add_batch_dim", native::_add_batch_dim);
   m.impl("_remove_batch_dim", native::_remove_batch_dim);
+  m.impl("_make_dual", _make_dual_batching_rule);
 
   m.impl("sum.dim_IntList", sum_batching_rule);
   m.impl("is_complex", native::is_complex);
@@ -1186,6 +1454,49 @@ TORCH_LIBRARY_IMPL(aten, Batched, m) {
   m.impl("dot", dot_batching_rule);
   m.impl("bmm", bmm_batching_rule);
   m.impl("mm", mm_batching_rule);
+  m.impl("matmul", matmul_batching_rule);
+
+  // convolutions
+  m.impl("convolution", convolution_batching_rule);
+  m.impl("conv1d", conv_batching_rule);
+  m.impl("conv2d", conv_batching_rule);
+  m.impl("conv3d", conv_batching_rule);
+  m.impl("conv_transpose1d", conv_transpose_batching_rule);
+  m.impl("conv_transpose2d", conv_transpose_batching_rule);
+  m.impl("conv_transpose3d", conv_transpose_batching_rule);
+
+  // indexing operators
+  using TensorIntTensorTensorType = Tensor (*)(const Tensor&, int64_t, const Tensor&, const Tensor&);
+  m.impl("index_select", index_select_batching_rule);
+  m.impl("gather", gather_batching_rule);
+  m.impl("scatter.src", scatter_batching_rule<TensorIntTensorTensorType, at::scatter>);
+  m.impl("scatter.value", scatter_value_batching_rule);
+  m.impl("scatter_add", scatter_batching_rule<TensorIntTensorTensorType, at::scatter_add>);
+
+  // linalg operators, see Note [Batching rules for linalg operators]
+#define LINALG_OP(op) m.impl(#op, \
+    linalg_batching_rule<Tensor (*)(const Tensor&), at::op>);
+  LINALG_OP(inverse);
+  LINALG_OP(linalg_inv);
+  LINALG_OP(det);
+  LINALG_OP(linalg_det);
+  LINALG_OP(logdet);
+  LINALG_OP(matrix_exp);
+  LINALG_OP(linalg_cholesky);
+#undef LINALG_OP
+  m.impl("cholesky", linalg_batching_rule<Tensor (*)(const Tensor&, bool), at::cholesky, bool>);
+  m.impl("linalg_eigvalsh",
+      linalg_batching_rule<Tensor (*)(const Tensor&, std::string), at::linalg_eigvalsh, std::string>);
+  {
+    using TupleType = std::tuple<Tensor,Tensor> (*)(const Tensor&);
+    m.impl("slogdet", linalg_tuple_batching_rule<TupleType, at::slogdet>);
+    m.impl("linalg_slogdet", linalg_tuple_batching_rule<TupleType, at::linalg_slogdet>);
+  }
+  m.impl("linalg_eigh",
+      linalg_tuple_batching_rule<
+          std::tuple<Tensor,Tensor> (*)(const Tensor&, std::string),
+          at::linalg_eigh,
+          std::string>);
 
   // cat/stack
   m.impl("cat", cat_batching_rule);
@@ -0,0 +1,110 @@
+#include <ATen/NestedTensorImpl.h>
+
+#include <c10/util/Exception.h>
+#include <c10/util/irange.h>
+
+#include <algorithm>
+
+namespace at {
+
+NestedTensorImpl::NestedTensorImpl(Tensor buffer, std::vector<int64_t> offsets)
+  : TensorImpl(
+      c10::DispatchKeySet(DispatchKey::NestedTensor),
+      buffer.dtype(),
+      buffer.device()
+    )
+  , buffer_(std::move(buffer))
+  , offsets_(std::move(offsets))
+{
+  TORCH_INTERNAL_ASSERT(buffer_.defined() && !offsets_.empty());
+  set_storage_access_should_throw();
+
+  int64_t max_length = 0;
+  for (const auto i : c10::irange(num_components())) {
+    max_length = std::max(max_length, length(i));
+  }
+  const auto buffer_sizes = buffer_.sizes();
+  sizes_and_strides_.resize(buffer_sizes.size() + 1);
+  sizes_and_strides_.size_at_unchecked(0) = num_components();
+  sizes_and_strides_.size_at_unchecked(1) = max_length;
+  for (const auto d : c10::irange(1, buffer_sizes.size())) {
+    sizes_and_strides_.size_at_unchecked(d + 1) = buffer_sizes[d];
+  }
+  // Only the packed elements are stored, see the note in NestedTensorImpl.h
+  numel_ = buffer_.numel();
+}
+
+// The following are publically exposed as methods of Tensor
+IntArrayRef NestedTensorImpl::strides() const {
+  TORCH_CHECK(false, "NestedTensors do not have strides");
+}
+int64_t NestedTensorImpl::stride(int64_t d) const {
+  TORCH_CHECK(false, "NestedTensors do not have strides");
+}
+bool NestedTensorImpl::is_contiguous(at::MemoryFormat memory_format) const {
+  // The buffer is always contiguous, and so are ops that produce NestedTensors
+  return memory_format == MemoryFormat::Contiguous;
+}
+
+// The following are some internal inherited methods that we do not support.
+// They should never get called.
+void NestedTensorImpl::set_size(int64_t dim, int64_t new_size) {
+  TORCH_INTERNAL_ASSERT(false, "Can't set_size for NestedTensorImpl");
+}
+void NestedTensorImpl::set_stride(int64_t dim, int64_t new_stride) {
+  TORCH_INTERNAL_ASSERT(false, "Can't set_stride for NestedTensorImpl");
+}
+void NestedTensorImpl::set_storage_offset(int64_t storage_offset) {
+  TORCH_INTERNAL_ASSERT(false, "Can't set_storage_offset for NestedTensorImpl");
+}
+#ifdef DEBUG
+bool NestedTensorImpl::has_storage() const {
+  TORCH_INTERNAL_ASSERT_DEBUG_ONLY(!storage_, "NestedTensorImpl assumes that storage_ is never set");
+  return false;
+}
+#endif
+
+c10::intrusive_ptr<TensorImpl> NestedTensorImpl::shallow_copy_and_detach(
+    const c10::VariableVersion& version_counter,
+    bool allow_tensor_metadata_change) const {
+  auto impl = c10::make_intrusive<NestedTensorImpl>(buffer_, offsets_);
+  copy_tensor_metadata(
+      /*src_impl=*/this,
+      /*dest_impl=*/impl.get(),
+      /*version_counter=*/version_counter,
+      /*allow_tensor_metadata_change=*/allow_tensor_metadata_change);
+  return impl;
+}
+
+c10::intrusive_ptr<TensorImpl> NestedTensorImpl::shallow_copy_and_detach(
+    c10::VariableVersion&& version_counter,
+    bool allow_tensor_metadata_change) const {
+  auto impl = c10::make_intrusive<NestedTensorImpl>(buffer_, offsets_);
+  copy_tensor_metadata(
+      /*src_impl=*/this,
+      /*dest_impl=*/impl.get(),
+      /*version_counter=*/std::move(version_counter),
+      /*allow_tensor_metadata_change=*/allow_tensor_metadata_change);
+  return impl;
+}
+
+void NestedTensorImpl::shallow_copy_from(const c10::intrusive_ptr<TensorImpl>& impl) {
+  TORCH_CHECK(false, "Can't shallow_copy_from into a NestedTensor, e.g. by setting its .data");
+}
+
+const char* NestedTensorImpl::tensorimpl_type_name() const {
+  return "NestedTensorImpl";
+}
+
+Tensor makeNestedTensor(Tensor buffer, std::vector<int64_t> offsets) {
+  TORCH_CHECK(!isNestedTensor(buffer), "Expected the buffer of a NestedTensor to be a regular tensor");
+  TORCH_CHECK(buffer.dim() >= 1, "Expected the buffer of a NestedTensor to have at least one dimension");
+  TORCH_CHECK(buffer.is_contiguous(), "Expected the buffer of a NestedTensor to be contiguous");
+  TORCH_CHECK(!offsets.empty() && offsets.front() == 0 && offsets.back() == buffer.size(0),
+      "Expected the offsets of a NestedTensor to go from 0 to the size of its buffer, ", buffer.size(0));
+  TORCH_CHECK(std::is_sorted(offsets.begin(), offsets.end()),
+      "Expected the offsets of a NestedTensor to be non-decreasing");
+  return at::detail::make_tensor<NestedTensorImpl>(std::move(buffer), std::move(offsets));
+}
+
+} // namespace at
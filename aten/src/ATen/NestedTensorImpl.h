@@ -0,0 +1,96 @@
+#pragma once
+
+#include <ATen/Tensor.h>
+#include <c10/core/MemoryFormat.h>
+#include <c10/core/TensorImpl.h>
+#include <c10/util/Exception.h>
+
+#include <vector>
+
+namespace at {
+
+// A NestedTensor is a batch of tensors that only differ in the size of their
+// first dimension, e.g. sequences of different lengths, stored without padding.
+//
+// The components are packed one after the other along the first dimension of
+// a contiguous buffer: a batch of B tensors of sizes (L_i, *inner) is a buffer
+// of size (L_0 + ... + L_{B-1}, *inner), and component i is
+// buffer[offsets[i]:offsets[i + 1]]. Ops that act on every row of the buffer
+// independently, like pointwise ops, or linear and layer_norm over the inner
+// dimensions, run on the buffer directly and never see any padding.
+//
+// The sizes of a NestedTensor are the sizes of its padded form
+// (B, max_i L_i, *inner), and numel() is the number of elements actually
+// stored. It has no strides and no storage of its own. Kernels are registered
+// for DispatchKey::NestedTensor in native/NestedTensorMath.cpp; NestedTensors
+// don't support autograd.
+struct TORCH_API NestedTensorImpl : public c10::TensorImpl {
+  explicit NestedTensorImpl(Tensor buffer, std::vector<int64_t> offsets);
+
+  // The packed components, of size (sum of lengths, *inner)
+  const Tensor& buffer() const { return buffer_; }
+
+  // num_components() + 1 offsets into the first dimension of buffer()
+  const std::vector<int64_t>& offsets() const { return offsets_; }
+
+  int64_t num_components() const {
+    return offsets_.size() - 1;
+  }
+
+  int64_t length(int64_t i) const {
+    return offsets_[i + 1] - offsets_[i];
+  }
+
+  // A view of the i-th component in buffer()
+  Tensor component(int64_t i) const {
+    return buffer_.narrow(0, offsets_[i], length(i));
+  }
+
+  // Override a bunch of methods inherited from TensorImpl to return error messages.
+  IntArrayRef strides() const override;
+  int64_t stride(int64_t d) const override;
+  bool is_contiguous(at::MemoryFormat memory_format=at::MemoryFormat::Contiguous) const override;
+  void set_size(int64_t dim, int64_t new_size) override;
+  void set_stride(int64_t dim, int64_t new_stride) override;
+  void set_storage_offset(int64_t storage_offset) override;
+#ifdef DEBUG
+  bool has_storage() const override;
+#endif
+
+  c10::intrusive_ptr<TensorImpl> shallow_copy_and_detach(
+      const c10::VariableVersion& version_counter,
+      bool allow_tensor_metadata_change) const override;
+  c10::intrusive_ptr<TensorImpl> shallow_copy_and_detach(
+      c10::VariableVersion&& version_counter,
+      bool allow_tensor_metadata_change) const override;
+  void shallow_copy_from(const c10::intrusive_ptr<TensorImpl>& impl) override;
+
+ private:
+  const char* tensorimpl_type_name() const override;
+
+  Tensor buffer_;
+  std::vector<int64_t> offsets_;
+};
+
+inline bool isNestedTensor(const Tensor& tensor) {
+  return tensor.unsafeGetTensorImpl()->key_set().has(DispatchKey::NestedTensor);
+}
+
+// It is unsafe to call this on a Tensor that is not backed by a
+// NestedTensorImpl. Please use `maybeGetNestedTensorImpl` whenever possible.
+inline NestedTensorImpl* unsafeGetNestedTensorImpl(const Tensor& tensor) {
+  return static_cast<NestedTensorImpl*>(tensor.unsafeGetTensorImpl());
+}
+
+inline NestedTensorImpl* maybeGetNestedTensorImpl(const Tensor& tensor) {
+  if (!isNestedTensor(tensor)) {
+    return nullptr;
+  }
+  return unsafeGetNestedTensorImpl(tensor);
+}
+
+// Use this to construct a NestedTensor from a packed buffer and the offsets of
+// its components
+TORCH_API Tensor makeNestedTensor(Tensor buffer, std::vector<int64_t> offsets);
+
+} // namespace at
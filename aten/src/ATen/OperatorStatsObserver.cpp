@@ -0,0 +1,264 @@
+#include <ATen/OperatorStatsObserver.h>
+
+#include <ATen/core/Tensor.h>
+#include <c10/util/flat_hash_map.h>
+#include <c10/util/llvmMathExtras.h>
+#include <c10/util/Optional.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace at {
+
+namespace {
+
+// Counters of one operator on one thread. Only the owning thread writes
+// them, with relaxed loads and stores instead of read-modify-write atomics;
+// readers on other threads may see slightly stale values.
+struct Counters {
+  explicit Counters(std::string name) : name(std::move(name)) {
+    calls.store(0, std::memory_order_relaxed);
+    total_ns.store(0, std::memory_order_relaxed);
+    for (auto& bucket : latency_histogram) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+    for (auto& bucket : shape_histogram) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  static void bump(std::atomic<int64_t>& counter, int64_t value) {
+    counter.store(
+        counter.load(std::memory_order_relaxed) + value,
+        std::memory_order_relaxed);
+  }
+
+  const std::string name;
+  std::atomic<int64_t> calls;
+  std::atomic<int64_t> total_ns;
+  std::array<std::atomic<int64_t>, kOperatorStatsLatencyBuckets>
+      latency_histogram;
+  std::array<std::atomic<int64_t>, kOperatorStatsShapeBuckets>
+      shape_histogram;
+};
+
+struct ThreadStats {
+  // Only accessed by the owning thread
+  ska::flat_hash_map<std::string, Counters*> index;
+
+  // Guards counters, which the owning thread only appends to the first time
+  // it sees an operator
+  std::mutex mutex;
+  std::vector<std::unique_ptr<Counters>> counters;
+};
+
+void accumulate(OperatorStats& stats, const Counters& counters) {
+  stats.sampled_calls += counters.calls.load(std::memory_order_relaxed);
+  stats.total_ns += counters.total_ns.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < kOperatorStatsLatencyBuckets; ++i) {
+    stats.latency_histogram[i] +=
+        counters.latency_histogram[i].load(std::memory_order_relaxed);
+  }
+  for (size_t i = 0; i < kOperatorStatsShapeBuckets; ++i) {
+    stats.shape_histogram[i] +=
+        counters.shape_histogram[i].load(std::memory_order_relaxed);
+  }
+}
+
+void subtract(OperatorStats& stats, const OperatorStats& other) {
+  stats.sampled_calls -= other.sampled_calls;
+  stats.total_ns -= other.total_ns;
+  for (size_t i = 0; i < kOperatorStatsLatencyBuckets; ++i) {
+    stats.latency_histogram[i] -= other.latency_histogram[i];
+  }
+  for (size_t i = 0; i < kOperatorStatsShapeBuckets; ++i) {
+    stats.shape_histogram[i] -= other.shape_histogram[i];
+  }
+}
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<ThreadStats*> threads;
+  // stats of threads that exited
+  std::map<std::string, OperatorStats> retired;
+  // totals at the last reset, subtracted from the reported stats
+  std::map<std::string, OperatorStats> baseline;
+  c10::optional<CallbackHandle> handle;
+  double sampling_prob = 1.0;
+};
+
+Registry& registry() {
+  // leaked, threads may exit after static destructors ran
+  static Registry* registry = new Registry();
+  return *registry;
+}
+
+struct ThreadStatsHolder {
+  ThreadStatsHolder() {
+    auto& r = registry();
+    std::lock_guard<std::mutex> guard(r.mutex);
+    r.threads.push_back(&stats);
+  }
+
+  ~ThreadStatsHolder() {
+    auto& r = registry();
+    std::lock_guard<std::mutex> guard(r.mutex);
+    for (const auto& counters : stats.counters) {
+      auto& retired = r.retired[counters->name];
+      retired.name = counters->name;
+      accumulate(retired, *counters);
+    }
+    r.threads.erase(std::find(r.threads.begin(), r.threads.end(), &stats));
+  }
+
+  ThreadStats stats;
+};
+
+ThreadStats& threadStats() {
+  static thread_local ThreadStatsHolder holder;
+  return holder.stats;
+}
+
+Counters& countersFor(const char* name) {
+  auto& stats = threadStats();
+  auto it = stats.index.find(name);
+  if (C10_LIKELY(it != stats.index.end())) {
+    return *it->second;
+  }
+  auto counters = std::make_unique<Counters>(name);
+  auto* result = counters.get();
+  {
+    std::lock_guard<std::mutex> guard(stats.mutex);
+    stats.counters.push_back(std::move(counters));
+  }
+  stats.index.emplace(name, result);
+  return *result;
+}
+
+// index of the highest set bit, 0 for 0 and 1
+size_t log2Floor(uint64_t value) {
+  return value <= 1 ? 0 : 63 - c10::llvm::countLeadingZeros(value);
+}
+
+size_t latencyBucket(int64_t latency_ns) {
+  return std::min<size_t>(
+      log2Floor(std::max<int64_t>(latency_ns, 0)),
+      kOperatorStatsLatencyBuckets - 1);
+}
+
+size_t shapeBucket(uint64_t numel) {
+  return numel == 0
+      ? 0
+      : std::min<size_t>(log2Floor(numel) + 1, kOperatorStatsShapeBuckets - 1);
+}
+
+int64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+struct OperatorStatsContext : ObserverContext {
+  int64_t start_ns = 0;
+  int64_t shape_bucket = -1;
+};
+
+std::unique_ptr<ObserverContext> onFunctionEnter(const RecordFunction& fn) {
+  auto ctx = std::make_unique<OperatorStatsContext>();
+  if (fn.needsInputs()) {
+    uint64_t numel = 0;
+    for (const auto& input : fn.inputs()) {
+      if (input.isTensor() && input.toTensor().defined()) {
+        numel += input.toTensor().numel();
+      }
+    }
+    ctx->shape_bucket = shapeBucket(numel);
+  }
+  ctx->start_ns = nowNs();
+  return ctx;
+}
+
+void onFunctionExit(const RecordFunction& fn, ObserverContext* ctx_ptr) {
+  int64_t end_ns = nowNs();
+  auto* ctx = static_cast<OperatorStatsContext*>(ctx_ptr);
+  TORCH_INTERNAL_ASSERT_DEBUG_ONLY(ctx);
+  int64_t latency_ns = end_ns - ctx->start_ns;
+
+  auto& counters = countersFor(fn.name().str());
+  Counters::bump(counters.calls, 1);
+  Counters::bump(counters.total_ns, latency_ns);
+  Counters::bump(counters.latency_histogram[latencyBucket(latency_ns)], 1);
+  if (ctx->shape_bucket >= 0) {
+    Counters::bump(counters.shape_histogram[ctx->shape_bucket], 1);
+  }
+}
+
+} // namespace
+
+void enableOperatorStatsObserver(double sampling_prob, bool record_shapes) {
+  auto& r = registry();
+  std::lock_guard<std::mutex> guard(r.mutex);
+  TORCH_CHECK(!r.handle, "The operator stats observer is already enabled");
+  r.sampling_prob = sampling_prob;
+  r.handle = addGlobalCallback(
+      RecordFunctionCallback(onFunctionEnter, onFunctionExit)
+          .samplingProb(sampling_prob)
+          .needsInputs(record_shapes)
+          .scopes({RecordScope::FUNCTION}));
+}
+
+void disableOperatorStatsObserver() {
+  auto& r = registry();
+  std::lock_guard<std::mutex> guard(r.mutex);
+  if (r.handle) {
+    removeCallback(*r.handle);
+    r.handle = c10::nullopt;
+  }
+}
+
+bool isOperatorStatsObserverEnabled() {
+  auto& r = registry();
+  std::lock_guard<std::mutex> guard(r.mutex);
+  return r.handle.has_value();
+}
+
+std::vector<OperatorStats> getOperatorStats(bool reset) {
+  auto& r = registry();
+  std::lock_guard<std::mutex> guard(r.mutex);
+  std::map<std::string, OperatorStats> totals = r.retired;
+  for (auto* thread : r.threads) {
+    std::lock_guard<std::mutex> thread_guard(thread->mutex);
+    for (const auto& counters : thread->counters) {
+      auto& stats = totals[counters->name];
+      stats.name = counters->name;
+      accumulate(stats, *counters);
+    }
+  }
+
+  std::vector<OperatorStats> result;
+  result.reserve(totals.size());
+  for (const auto& entry : totals) {
+    OperatorStats stats = entry.second;
+    auto baseline = r.baseline.find(entry.first);
+    if (baseline != r.baseline.end()) {
+      subtract(stats, baseline->second);
+    }
+    if (stats.sampled_calls == 0) {
+      continue;
+    }
+    stats.estimated_calls = r.sampling_prob > 0
+        ? static_cast<int64_t>(stats.sampled_calls / r.sampling_prob)
+        : stats.sampled_calls;
+    result.push_back(std::move(stats));
+  }
+  if (reset) {
+    r.baseline = std::move(totals);
+  }
+  return result;
+}
+
+} // namespace at
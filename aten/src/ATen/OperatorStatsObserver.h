@@ -0,0 +1,62 @@
+#pragma once
+
+#include <ATen/record_function.h>
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace at {
+
+// Operator stats observer: always-on, sampled telemetry for operators.
+//
+// The observer is a global RecordFunction callback for RecordScope::FUNCTION
+// (operators called through the dispatcher). For every sampled call it
+// records the latency and, optionally, the total number of elements of the
+// tensor inputs. Each thread aggregates into its own counters, so recording
+// a call doesn't take a lock or write to memory shared with other threads;
+// getOperatorStats() sums the counters of all threads.
+//
+// The default sampling probability keeps the RecordFunction pre-sampling fast
+// path, calls that are not sampled then only pay for a thread local counter.
+// Sampling probabilities above 0.001 disable pre-sampling and every operator
+// call flips a coin.
+//
+// Like any global callback, the observer should be enabled and disabled when
+// no other code is running, e.g. during initialization.
+
+constexpr size_t kOperatorStatsLatencyBuckets = 32;
+constexpr size_t kOperatorStatsShapeBuckets = 48;
+
+struct TORCH_API OperatorStats {
+  std::string name;
+  // number of sampled calls
+  int64_t sampled_calls = 0;
+  // sampled_calls divided by the sampling probability
+  int64_t estimated_calls = 0;
+  // sum of the latencies of the sampled calls
+  int64_t total_ns = 0;
+  // latency_histogram[i] counts sampled calls that took [2^i, 2^(i+1)) ns,
+  // the first and last buckets also count faster and slower calls
+  std::array<int64_t, kOperatorStatsLatencyBuckets> latency_histogram{};
+  // shape_histogram[0] counts sampled calls without tensor input elements,
+  // shape_histogram[i] calls with [2^(i-1), 2^i) elements in all tensor
+  // inputs. Only filled when the observer records shapes.
+  std::array<int64_t, kOperatorStatsShapeBuckets> shape_histogram{};
+};
+
+// Registers the observer, record_shapes passes the inputs of sampled calls to
+// the observer (which boxes them) to fill OperatorStats::shape_histogram
+TORCH_API void enableOperatorStatsObserver(
+    double sampling_prob = 0.001,
+    bool record_shapes = false);
+TORCH_API void disableOperatorStatsObserver();
+TORCH_API bool isOperatorStatsObserverEnabled();
+
+// Returns the stats of every operator sampled since the observer was first
+// enabled or since the last call with reset = true, sorted by name. Stats
+// are collected while threads run, so counters of calls that finish during
+// the pull may or may not be included.
+TORCH_API std::vector<OperatorStats> getOperatorStats(bool reset = false);
+
+} // namespace at
@@ -2,6 +2,7 @@
 
 #include <ATen/Parallel.h>
 #include <c10/core/thread_pool.h>
+#include <c10/core/work_stealing_thread_pool.h>
 
 namespace at {
 
@@ -10,8 +11,21 @@ public:
   explicit PTThreadPool(
       int pool_size,
       int numa_node_id = -1)
-    : c10::ThreadPool(pool_size, numa_node_id, [](){
+    : c10::ThreadPool(pool_size, numa_node_id, [numa_node_id](){
         c10::setThreadName("PTThreadPool");
+        c10::NUMABind(numa_node_id);
+        at::init_num_threads();
+      }) {}
+};
+
+class TORCH_API PTWorkStealingThreadPool : public c10::WorkStealingThreadPool {
+public:
+  explicit PTWorkStealingThreadPool(
+      int pool_size,
+      int numa_node_id = -1)
+    : c10::WorkStealingThreadPool(pool_size, numa_node_id, [numa_node_id](){
+        c10::setThreadName("PTThreadPool");
+        c10::NUMABind(numa_node_id);
         at::init_num_threads();
       }) {}
 };
@@ -25,6 +25,17 @@ TORCH_API int get_thread_num();
 // Checks whether the code runs in parallel region
 TORCH_API bool in_parallel_region();
 
+// Enables NUMA aware intra-op parallelism: intra-op workers are split into
+// one group per NUMA node and bound to it, parallel primitives keep contiguous
+// ranges of work on one node, and CPU allocations are placed on the node of
+// the allocating thread. Only supported by the native parallel backend in
+// builds with USE_NUMA, and like set_num_threads it has to be called before
+// parallel work starts.
+TORCH_API void set_numa_aware_parallelism(bool enabled);
+
+// Returns whether NUMA aware intra-op parallelism was requested
+TORCH_API bool get_numa_aware_parallelism();
+
 namespace internal {
 
 // Initialise num_threads lazily at first parallel call
@@ -118,10 +129,48 @@ TORCH_API void set_num_interop_threads(int);
 // Returns the number of threads used for inter-op parallelism
 TORCH_API int get_num_interop_threads();
 
+// Sets the number of threads that inter-op tasks and the intra-op work they
+// start may keep busy at once. Every running inter-op task gets an equal
+// share of the budget as its intra-op width, so that nested parallel_for,
+// OpenMP and MKL calls from concurrent tasks do not oversubscribe the cores.
+// Defaults to the ATEN_THREAD_BUDGET environment variable, or to the default
+// number of intra-op threads.
+TORCH_API void set_thread_budget(int);
+
+// Returns the number of threads shared by the running inter-op tasks
+TORCH_API int get_thread_budget();
+
 // Launches inter-op parallel task
 TORCH_API void launch(std::function<void()> func);
 namespace internal {
 void launch_no_thread_state(std::function<void()> fn);
+
+// Returns the intra-op width the current thread is restricted to, or 0 when
+// it is not restricted
+TORCH_API int intraop_width_limit();
+
+// Counts the current thread as running an inter-op task for its lifetime and
+// restricts its intra-op width, including the OpenMP and MKL threads of the
+// OpenMP backend, to the task's share of the thread budget. Nested guards,
+// e.g. for tasks run while waiting on other tasks, can only narrow it.
+class TORCH_API InteropTaskBudgetGuard {
+ public:
+  InteropTaskBudgetGuard();
+  ~InteropTaskBudgetGuard();
+
+  InteropTaskBudgetGuard(const InteropTaskBudgetGuard&) = delete;
+  InteropTaskBudgetGuard& operator=(const InteropTaskBudgetGuard&) = delete;
+
+ private:
+  int prev_limit_;
+  int prev_omp_threads_;
+  int prev_mkl_threads_;
+};
+
+// Runs a queued inter-op task if called from a thread of the inter-op pool
+// and there is one, returns whether it did. A pool thread about to block on
+// other inter-op tasks can call it to help them along instead.
+TORCH_API bool run_pending_interop_task();
 } // namespace internal
 
 // Launches intra-op parallel task
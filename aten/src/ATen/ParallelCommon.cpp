@@ -4,6 +4,8 @@
 #include <ATen/PTThreadPool.h>
 #include <ATen/Version.h>
 
+#include <algorithm>
+#include <atomic>
 #include <sstream>
 #include <thread>
 
@@ -40,8 +42,87 @@ size_t get_env_num_threads(const char* var_name, size_t def_value = 0) {
   return def_value;
 }
 
+// Set by set_thread_budget, or on first use; 0 until then
+std::atomic<int> thread_budget{0};
+
+// Number of threads inside an InteropTaskBudgetGuard
+std::atomic<int> num_running_interop_tasks{0};
+
+// Intra-op width of the current thread, 0 when not restricted
+thread_local int intraop_width_limit_ = 0;
+
 } // namespace
 
+void set_thread_budget(int nthreads) {
+  TORCH_CHECK(nthreads > 0, "Expected positive number of threads");
+  thread_budget.store(nthreads);
+}
+
+int get_thread_budget() {
+  int budget = thread_budget.load();
+  if (budget > 0) {
+    return budget;
+  }
+#ifdef C10_MOBILE
+  budget = TaskThreadPoolBase::defaultNumThreads();
+#else
+  budget = get_env_num_threads(
+      "ATEN_THREAD_BUDGET", intraop_default_num_threads());
+#endif
+  // keep a value set concurrently by set_thread_budget
+  int no_value = 0;
+  thread_budget.compare_exchange_strong(no_value, budget);
+  return thread_budget.load();
+}
+
+namespace internal {
+
+int intraop_width_limit() {
+  return intraop_width_limit_;
+}
+
+InteropTaskBudgetGuard::InteropTaskBudgetGuard()
+    : prev_limit_(intraop_width_limit_),
+      prev_omp_threads_(0),
+      prev_mkl_threads_(0) {
+  // the first parallel call would reset the OpenMP and MKL settings below
+  lazy_init_num_threads();
+  const int num_tasks = ++num_running_interop_tasks;
+  int width = std::max(1, get_thread_budget() / num_tasks);
+  if (prev_limit_ > 0) {
+    width = std::min(width, prev_limit_);
+  }
+  intraop_width_limit_ = width;
+#if AT_PARALLEL_OPENMP
+  // Both are thread local: the OpenMP team size of the parallel regions this
+  // thread starts, and the number of threads MKL uses when called from it.
+#ifdef _OPENMP
+  prev_omp_threads_ = omp_get_max_threads();
+  omp_set_num_threads(std::min(width, prev_omp_threads_));
+#endif
+#ifdef TH_BLAS_MKL
+  prev_mkl_threads_ =
+      mkl_set_num_threads_local(std::min(width, mkl_get_max_threads()));
+#endif
+#endif // AT_PARALLEL_OPENMP
+}
+
+InteropTaskBudgetGuard::~InteropTaskBudgetGuard() {
+#if AT_PARALLEL_OPENMP
+#ifdef _OPENMP
+  omp_set_num_threads(prev_omp_threads_);
+#endif
+#ifdef TH_BLAS_MKL
+  // 0 restores the global setting
+  mkl_set_num_threads_local(prev_mkl_threads_);
+#endif
+#endif // AT_PARALLEL_OPENMP
+  intraop_width_limit_ = prev_limit_;
+  --num_running_interop_tasks;
+}
+
+} // namespace internal
+
 std::string get_parallel_info() {
   std::ostringstream ss;
 
@@ -49,6 +130,10 @@ std::string get_parallel_info() {
      << at::get_num_threads() << std::endl;
   ss << "\tat::get_num_interop_threads() : "
      << at::get_num_interop_threads() << std::endl;
+  ss << "\tat::get_thread_budget() : "
+     << at::get_thread_budget() << std::endl;
+  ss << "\tat::get_numa_aware_parallelism() : "
+     << at::get_numa_aware_parallelism() << std::endl;
 
   ss << at::get_openmp_version() << std::endl;
 #ifdef _OPENMP
@@ -70,12 +155,14 @@ std::string get_parallel_info() {
      << get_env_var("OMP_NUM_THREADS", "[not set]") << std::endl;
   ss << "\tMKL_NUM_THREADS : "
      << get_env_var("MKL_NUM_THREADS", "[not set]") << std::endl;
+  ss << "\tATEN_THREAD_BUDGET : "
+     << get_env_var("ATEN_THREAD_BUDGET", "[not set]") << std::endl;
 
   ss << "ATen parallel backend: ";
   #if AT_PARALLEL_OPENMP
   ss << "OpenMP";
   #elif AT_PARALLEL_NATIVE
-  ss << "native thread pool";
+  ss << "native thread pool (" << at::internal::intraop_pool_backend() << ")";
   #elif AT_PARALLEL_NATIVE_TBB
   ss << "native thread pool and TBB";
   #endif
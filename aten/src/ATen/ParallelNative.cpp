@@ -10,6 +10,8 @@
 #endif // C10_MOBILE
 
 #include <atomic>
+#include <cstdlib>
+#include <cstring>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -55,6 +57,9 @@ const int CONSUMED = -2;
 //  - CONSUMED - pool is initialized
 std::atomic<int> num_intraop_threads{NOT_SET};
 
+// Set by set_numa_aware_parallelism, read once when the pool is created
+std::atomic<bool> numa_aware_parallelism{false};
+
 int _num_pool_threads(int nthreads) {
   if (nthreads == NOT_SET) {
     nthreads = intraop_default_num_threads();
@@ -65,13 +70,125 @@ int _num_pool_threads(int nthreads) {
   return nthreads - 1;
 }
 
+// Whether the intra-op pool uses per-worker queues with work stealing instead
+// of a single shared queue. Defaults to the build setting
+// (ATEN_THREADING=NATIVE_WORK_STEALING) and can be overridden with the
+// ATEN_INTRAOP_POOL environment variable ("work_stealing" or "default"),
+// which is read once when the pool is created.
+bool _use_work_stealing_pool() {
+  static const bool use_work_stealing = []() {
+    const char* env = std::getenv("ATEN_INTRAOP_POOL");
+    if (env == nullptr || *env == '\0') {
+      return AT_INTRAOP_WORK_STEALING == 1;
+    }
+    if (std::strcmp(env, "work_stealing") == 0) {
+      return true;
+    }
+    if (std::strcmp(env, "default") != 0) {
+      TORCH_WARN(
+          "Unknown ATEN_INTRAOP_POOL value '", env, "', expected "
+          "'work_stealing' or 'default'; using the default pool");
+    }
+    return false;
+  }();
+  return use_work_stealing;
+}
+
+std::shared_ptr<TaskThreadPoolBase> _create_node_pool(
+    int pool_size,
+    int numa_node_id) {
+  if (_use_work_stealing_pool()) {
+    return std::make_shared<PTWorkStealingThreadPool>(pool_size, numa_node_id);
+  }
+  return std::make_shared<PTThreadPool>(pool_size, numa_node_id);
+}
+
+// Intra-op pool made of one pool per NUMA node, whose workers are bound to
+// that node (see c10::NUMABind), so that tasks can be kept on the node that
+// holds their data.
+class NUMAIntraOpPool : public TaskThreadPoolBase {
+ public:
+  NUMAIntraOpPool(int pool_size, int num_nodes) {
+    for (int node = 0; node < num_nodes; ++node) {
+      const int node_size =
+          pool_size / num_nodes + (node < pool_size % num_nodes ? 1 : 0);
+      pools_.emplace_back(
+          node_size > 0 ? _create_node_pool(node_size, node) : nullptr);
+      size_ += node_size;
+    }
+  }
+
+  void run(std::function<void()> func) override {
+    runOnNode(c10::GetCurrentNUMANode(), std::move(func));
+  }
+
+  // Runs func on a worker of the given node, or of the next node that has
+  // workers.
+  void runOnNode(int node, std::function<void()> func) {
+    const int num_nodes = pools_.size();
+    node = node < 0 ? 0 : node % num_nodes;
+    for (int i = 0; i < num_nodes; ++i) {
+      auto& pool = pools_[(node + i) % num_nodes];
+      if (pool) {
+        pool->run(std::move(func));
+        return;
+      }
+    }
+    throw std::runtime_error("No threads to run a task");
+  }
+
+  size_t size() const override {
+    return size_;
+  }
+
+  size_t numAvailable() const override {
+    size_t available = 0;
+    for (const auto& pool : pools_) {
+      available += pool ? pool->numAvailable() : 0;
+    }
+    return available;
+  }
+
+  bool inThreadPool() const override {
+    for (const auto& pool : pools_) {
+      if (pool && pool->inThreadPool()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  int numNodes() const {
+    return pools_.size();
+  }
+
+ private:
+  std::vector<std::shared_ptr<TaskThreadPoolBase>> pools_;
+  size_t size_{0};
+};
+
+// Set when the intra-op pool is NUMA aware, only valid after
+// _get_intraop_pool() was called
+NUMAIntraOpPool* numa_intraop_pool = nullptr;
+
 TaskThreadPoolBase& _get_intraop_pool() {
   static std::shared_ptr<TaskThreadPoolBase> pool =
-      ThreadPoolRegistry()->Create(
-          "C10",
-          /* device_id */ 0,
-          /* pool_size */ _num_pool_threads(num_intraop_threads.exchange(CONSUMED)),
-          /* create_new */ true); // create a separate thread pool for intra-op
+      []() -> std::shared_ptr<TaskThreadPoolBase> {
+    const int pool_size =
+        _num_pool_threads(num_intraop_threads.exchange(CONSUMED));
+    if (numa_aware_parallelism.load() && c10::IsNUMAEnabled() &&
+        c10::GetNumNUMANodes() > 1) {
+      auto numa_pool =
+          std::make_shared<NUMAIntraOpPool>(pool_size, c10::GetNumNUMANodes());
+      numa_intraop_pool = numa_pool.get();
+      return numa_pool;
+    }
+    return ThreadPoolRegistry()->Create(
+        _use_work_stealing_pool() ? "C10WorkStealing" : "C10",
+        /* device_id */ 0,
+        /* pool_size */ pool_size,
+        /* create_new */ true); // create a separate thread pool for intra-op
+  }();
   return *pool;
 }
 
@@ -81,8 +198,22 @@ TaskThreadPoolBase& _get_intraop_pool() {
 // `fn` will be called with params: (thread_pool_task_id, task_id).
 void _run_with_pool(const std::function<void(int, size_t)>& fn, size_t range) {
 #ifndef C10_MOBILE
-  for (size_t i = 1; i < range; ++i) {
-    _get_intraop_pool().run([fn, i]() { fn((int)i, i); });
+  auto& pool = _get_intraop_pool();
+  if (numa_intraop_pool) {
+    // Split the tasks into one contiguous block per node, so that neighbouring
+    // ranges, which usually touch neighbouring memory, stay on one node. The
+    // first block goes to the node of the current thread, which runs task 0.
+    const int num_nodes = numa_intraop_pool->numNodes();
+    const int first_node = std::max(c10::GetCurrentNUMANode(), 0);
+    for (size_t i = 1; i < range; ++i) {
+      numa_intraop_pool->runOnNode(
+          first_node + static_cast<int>(i * num_nodes / range),
+          [fn, i]() { fn((int)i, i); });
+    }
+  } else {
+    for (size_t i = 1; i < range; ++i) {
+      pool.run([fn, i]() { fn((int)i, i); });
+    }
   }
   // Run the first task on the current thread directly.
   fn(0, 0);
@@ -116,6 +247,14 @@ struct ParallelRegionGuard {
 
 namespace internal {
 
+const char* intraop_pool_backend() {
+#ifndef C10_MOBILE
+  return _use_work_stealing_pool() ? "work stealing" : "shared queue";
+#else
+  return "pthreadpool";
+#endif // C10_MOBILE
+}
+
 void _parallel_run(
   const int64_t begin,
   const int64_t end,
@@ -218,14 +357,15 @@ int get_num_threads() {
   // not initializing pool unnecessarily,
   // because pool cannot be resized after initialization
   int nthreads = num_intraop_threads.load();
-  if (nthreads > 0) {
-    return nthreads;
-  } else if (nthreads == NOT_SET) {
-    return intraop_default_num_threads();
-  } else {
+  if (nthreads == NOT_SET) {
+    nthreads = intraop_default_num_threads();
+  } else if (nthreads <= 0) {
     TORCH_INTERNAL_ASSERT(nthreads == CONSUMED);
-    return _get_intraop_pool().size() + 1;
+    nthreads = _get_intraop_pool().size() + 1;
   }
+  // inter-op tasks only use their share of the thread budget
+  const int width_limit = internal::intraop_width_limit();
+  return width_limit > 0 ? std::min(nthreads, width_limit) : nthreads;
 #else
   caffe2::PThreadPool* const pool = caffe2::pthreadpool();
   TORCH_INTERNAL_ASSERT(pool, "Invalid thread pool!")
@@ -237,6 +377,41 @@ int get_thread_num() {
   return thread_num_;
 }
 
+void set_numa_aware_parallelism(bool enabled) {
+#ifndef C10_MOBILE
+  if (num_intraop_threads.load() == CONSUMED) {
+    if (enabled != numa_aware_parallelism.load()) {
+      TORCH_WARN(
+        "Cannot change NUMA aware parallelism after parallel work has "
+        "started when using native parallel backend");
+    }
+    return;
+  }
+  numa_aware_parallelism.store(enabled);
+  if (enabled) {
+    // place CPU allocations on the node of the allocating thread
+    FLAGS_caffe2_cpu_numa_enabled = true;
+    if (!c10::IsNUMAEnabled()) {
+      TORCH_WARN(
+        "NUMA aware parallelism requested, but NUMA is not available "
+        "(PyTorch built without USE_NUMA or no NUMA support on this host)");
+    }
+  }
+#else
+  if (enabled) {
+    TORCH_WARN("NUMA aware parallelism is not supported on mobile");
+  }
+#endif // C10_MOBILE
+}
+
+bool get_numa_aware_parallelism() {
+#ifndef C10_MOBILE
+  return numa_aware_parallelism.load();
+#else
+  return false;
+#endif // C10_MOBILE
+}
+
 bool in_parallel_region() {
 #ifndef C10_MOBILE
   return in_parallel_region_ || (
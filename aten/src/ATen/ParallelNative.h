@@ -22,6 +22,9 @@ inline std::tuple<size_t, size_t> calc_num_tasks_and_chunk_size(
   return std::make_tuple(num_tasks, chunk_size);
 }
 
+// Describes the thread pool backing intra-op parallelism
+TORCH_API const char* intraop_pool_backend();
+
 TORCH_API void _parallel_run(
   const int64_t begin,
   const int64_t end,
@@ -3,6 +3,7 @@
 #include <ATen/Parallel.h>
 #include <ATen/PTThreadPool.h>
 
+#include <algorithm>
 #include <atomic>
 #include <mutex>
 
@@ -66,7 +67,10 @@ void set_num_threads(int nthreads) {
 }
 
 int get_num_threads() {
-  return tbb::this_task_arena::max_concurrency();
+  const int nthreads = tbb::this_task_arena::max_concurrency();
+  // inter-op tasks split their work into their share of the thread budget
+  const int width_limit = internal::intraop_width_limit();
+  return width_limit > 0 ? std::min(nthreads, width_limit) : nthreads;
 }
 
 int get_thread_num() {
@@ -77,6 +81,18 @@ bool in_parallel_region() {
   return tbb::this_task_arena::current_thread_index() != -1;
 }
 
+void set_numa_aware_parallelism(bool enabled) {
+  if (enabled) {
+    TORCH_WARN(
+      "NUMA aware parallelism is only supported by the native parallel "
+      "backend");
+  }
+}
+
+bool get_numa_aware_parallelism() {
+  return false;
+}
+
 void intraop_launch(std::function<void()> func) {
   if (get_num_threads() > 1) {
     tg_.run(func);
@@ -80,6 +80,18 @@ int get_thread_num() {
 #endif
 }
 
+void set_numa_aware_parallelism(bool enabled) {
+  if (enabled) {
+    TORCH_WARN(
+      "NUMA aware parallelism is only supported by the native parallel "
+      "backend");
+  }
+}
+
+bool get_numa_aware_parallelism() {
+  return false;
+}
+
 bool in_parallel_region() {
 #ifdef _OPENMP
   return omp_in_parallel();
@@ -5,6 +5,8 @@
 #include <ATen/ThreadLocalState.h>
 
 #include <atomic>
+#include <cstdlib>
+#include <cstring>
 
 namespace at {
 
@@ -19,12 +21,32 @@ const int CONSUMED = -2;
 // NOT_SET -> CONSUMED
 std::atomic<int> num_interop_threads{NOT_SET};
 
+// Whether the inter-op pool uses per-worker queues with work stealing,
+// which lets a worker that waits on other tasks, e.g. a TorchScript
+// fork, run them instead of blocking. Can be overridden with the
+// ATEN_INTEROP_POOL environment variable ("work_stealing" or "default"),
+// which is read once when the pool is created.
+bool use_work_stealing_pool() {
+  const char* env = std::getenv("ATEN_INTEROP_POOL");
+  if (env == nullptr || *env == '\0' ||
+      std::strcmp(env, "work_stealing") == 0) {
+    return true;
+  }
+  if (std::strcmp(env, "default") != 0) {
+    TORCH_WARN(
+        "Unknown ATEN_INTEROP_POOL value '", env, "', expected "
+        "'work_stealing' or 'default'; using the work stealing pool");
+    return true;
+  }
+  return false;
+}
+
 // thread pool global instance is hidden,
 // users should use at::launch and get/set_num_interop_threads interface
 TaskThreadPoolBase& get_pool() {
   static std::shared_ptr<TaskThreadPoolBase> pool =
       ThreadPoolRegistry()->Create(
-          "C10",
+          use_work_stealing_pool() ? "C10WorkStealing" : "C10",
           /* device_id */ 0,
           /* pool_size */ num_interop_threads.exchange(CONSUMED),
           /* create_new */ true);
@@ -43,9 +65,26 @@ std::shared_ptr<TaskThreadPoolBase> create_c10_threadpool(
   return std::make_shared<PTThreadPool>(pool_size);
 }
 
+// Factory function for ThreadPoolRegistry, pool with per-worker lock-free
+// queues and work stealing
+std::shared_ptr<TaskThreadPoolBase> create_c10_work_stealing_threadpool(
+    int device_id,
+    int pool_size,
+    bool create_new) {
+  // For now, the only accepted device id is 0
+  TORCH_CHECK(device_id == 0);
+  // Create new thread pool
+  TORCH_CHECK(create_new);
+  return std::make_shared<PTWorkStealingThreadPool>(pool_size);
+}
+
 } // namespace
 
 C10_REGISTER_CREATOR(ThreadPoolRegistry, C10, create_c10_threadpool);
+C10_REGISTER_CREATOR(
+    ThreadPoolRegistry,
+    C10WorkStealing,
+    create_c10_work_stealing_threadpool);
 
 void set_num_interop_threads(int nthreads) {
   TORCH_CHECK(nthreads > 0, "Expected positive number of threads");
@@ -73,7 +112,25 @@ void launch_no_thread_state(std::function<void()> fn) {
 #if AT_EXPERIMENTAL_SINGLE_THREAD_POOL
   intraop_launch(std::move(fn));
 #else
-  get_pool().run(std::move(fn));
+  get_pool().run(std::bind([](const std::function<void()>& f) {
+      InteropTaskBudgetGuard budget_guard;
+      f();
+    },
+    std::move(fn)
+  ));
+#endif
+}
+
+bool run_pending_interop_task() {
+#if AT_EXPERIMENTAL_SINGLE_THREAD_POOL
+  return false;
+#else
+  // Doesn't create the pool just to find it empty
+  if (num_interop_threads.load() != CONSUMED) {
+    return false;
+  }
+  auto& pool = get_pool();
+  return pool.inThreadPool() && pool.runPendingTask();
 #endif
 }
 } // namespace internal
@@ -1,5 +1,6 @@
 #include <ATen/ATen.h>
 #include <ATen/SparseTensorImpl.h>
+#include <ATen/SparseTensorUtils.h>
 #include <ATen/InitialTensorOptions.h>
 #include <ATen/core/LegacyTypeDispatch.h>
 
@@ -115,6 +116,29 @@ void SparseTensorImpl::set_indices_and_values_unsafe(const Tensor& indices, cons
   AT_ASSERT(values_.device() == indices_.device());
 
   coalesced_ = false;
+  invalidate_csr_cache();
+}
+
+Tensor SparseTensorImpl::csr_row_pointers() const {
+  TORCH_INTERNAL_ASSERT(coalesced_ && sparse_dim_ == 2 && device().is_cpu());
+  // Modifications of inference tensors can't be detected, so their row
+  // pointers are not cached
+  if (indices_.unsafeGetTensorImpl()->is_inference()) {
+    return sparse::coo_to_csr(
+        indices_.select(0, 0).contiguous().data_ptr<int64_t>(), size(0), nnz());
+  }
+  const auto indices_version = indices_.unsafeGetTensorImpl()->version_counter().current_version();
+  auto cache = std::atomic_load(&csr_cache_);
+  // The cache holds on to the indices, so they can only be the same tensor
+  // if the cache is still valid, unless they were modified in place.
+  if (cache && cache->indices.is_same(indices_) && cache->indices_version == indices_version) {
+    return cache->row_pointers;
+  }
+  Tensor rows = indices_.select(0, 0).contiguous();
+  Tensor row_pointers = sparse::coo_to_csr(rows.data_ptr<int64_t>(), size(0), nnz());
+  std::atomic_store(&csr_cache_, std::shared_ptr<const CsrCache>(
+      std::make_shared<const CsrCache>(CsrCache{indices_, indices_version, row_pointers})));
+  return row_pointers;
 }
 
 
@@ -4,6 +4,8 @@
 #include <c10/core/TensorImpl.h>
 #include <c10/util/Exception.h>
 
+#include <memory>
+
 namespace at {
 struct TORCH_API SparseTensorImpl : public TensorImpl {
   // Stored in COO format, indices + values.
@@ -29,6 +31,14 @@ struct TORCH_API SparseTensorImpl : public TensorImpl {
   // because many algorithms proceed by merging two sorted lists (of indices).
   bool coalesced_ = false;
 
+  // See csr_row_pointers()
+  struct CsrCache {
+    Tensor indices;
+    uint32_t indices_version;
+    Tensor row_pointers;
+  };
+  mutable std::shared_ptr<const CsrCache> csr_cache_;
+
 public:
   // Public for now...
   explicit SparseTensorImpl(at::DispatchKeySet, const caffe2::TypeMeta);
@@ -40,6 +50,12 @@ public:
   Tensor indices() const { return indices_; }
   Tensor values() const { return values_; }
 
+  // Returns the CSR row pointers of a coalesced matrix: the position of the
+  // first nonzero of each row, followed by nnz. They are cached until the
+  // indices change, so that repeated products with the same sparse matrix
+  // don't recompute them.
+  Tensor csr_row_pointers() const;
+
   IntArrayRef strides() const override;
   bool is_contiguous(at::MemoryFormat memory_format=at::MemoryFormat::Contiguous) const override;
   int64_t stride(int64_t d) const override;
@@ -59,6 +75,7 @@ public:
     sparse_dim_ = sparse_dim;
     dense_dim_ = dense_dim;
     refresh_numel();
+    invalidate_csr_cache();
   }
 
   // NOTE: This function preserves invariants of sparse_dim/dense_dim with respect to
@@ -141,6 +158,7 @@ public:
     sparse_dim_ = sparse_dim;
     dense_dim_ = dense_dim;
     refresh_numel();
+    invalidate_csr_cache();
   }
 
   // NOTE: this function will resize the sparse tensor and also set `indices` and `values` to empty.
@@ -164,6 +182,7 @@ public:
   void set_coalesced(bool coalesced) {
     TORCH_CHECK(allow_tensor_metadata_change(), "set_coalesced ", err_msg_tensor_metadata_change_not_allowed);
     coalesced_ = coalesced;
+    invalidate_csr_cache();
   }
 
   // NOTE: this function is only used internally and not exposed to Python frontend
@@ -172,6 +191,7 @@ public:
     AT_ASSERT(new_nnz <= nnz());
     indices_ = indices_.narrow(1, 0, new_nnz);
     values_ = values_.narrow(0, 0, new_nnz);
+    invalidate_csr_cache();
   }
 
   // Takes indices and values and directly puts them into the sparse tensor, no copy.
@@ -236,10 +256,15 @@ public:
       /*version_counter=*/version_counter(),
       /*allow_tensor_metadata_change=*/allow_tensor_metadata_change());
     refresh_numel();
+    invalidate_csr_cache();
   }
 private:
     explicit SparseTensorImpl(at::DispatchKeySet, const caffe2::TypeMeta, at::Tensor indices, at::Tensor values);
 
+  void invalidate_csr_cache() {
+    std::atomic_store(&csr_cache_, std::shared_ptr<const CsrCache>());
+  }
+
   /**
    * Copy the tensor metadata fields (e.g. sizes / strides / storage pointer / storage_offset)
    * from one TensorImpl to another TensorImpl.
@@ -4,6 +4,11 @@
 #include <ATen/SparseTensorImpl.h>
 #include <ATen/Parallel.h>
 
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
 namespace at { namespace sparse {
 
 // NOTE [ Flatten Sparse Indices ]
@@ -110,4 +115,111 @@ Tensor coo_to_csr(const int64_t* indices, int64_t dim, int64_t nnz) {
   return csr;
 }
 
+namespace {
+
+// Stable LSD radix sort of the flattened indices of a sparse tensor, with one
+// pass per 8-bit digit of max_key, which bounds all keys. Every chunk of the
+// input counts its digits in parallel, and then scatters its keys to the
+// positions that follow those of the same digit in all previous chunks.
+// Returns the sorted keys and the permutation that sorts them, like sort().
+std::tuple<Tensor, Tensor> radix_sort_flattened_indices(const Tensor& keys, int64_t max_key) {
+  constexpr int64_t kRadixBits = 8;
+  constexpr int64_t kRadix = 1 << kRadixBits;
+  const int64_t n = keys.numel();
+  Tensor sorted_keys = keys.clone(at::MemoryFormat::Contiguous);
+  Tensor permutation = at::arange(n, keys.options());
+  Tensor keys_buffer = at::empty_like(sorted_keys);
+  Tensor permutation_buffer = at::empty_like(permutation);
+
+  const int64_t num_chunks = std::min<int64_t>(at::get_num_threads(), divup(n, at::internal::GRAIN_SIZE));
+  const int64_t chunk_size = divup(n, num_chunks);
+  std::vector<int64_t> offsets(num_chunks * kRadix);
+  for (int64_t shift = 0; shift < 64 && (max_key >> shift) > 0; shift += kRadixBits) {
+    const int64_t* keys_in = sorted_keys.data_ptr<int64_t>();
+    const int64_t* permutation_in = permutation.data_ptr<int64_t>();
+    int64_t* keys_out = keys_buffer.data_ptr<int64_t>();
+    int64_t* permutation_out = permutation_buffer.data_ptr<int64_t>();
+    auto digit = [&](int64_t i) { return (keys_in[i] >> shift) & (kRadix - 1); };
+
+    at::parallel_for(0, num_chunks, 1, [&](int64_t start, int64_t end) {
+      for (int64_t c = start; c < end; c++) {
+        int64_t* counts = offsets.data() + c * kRadix;
+        std::fill(counts, counts + kRadix, 0);
+        for (int64_t i = c * chunk_size; i < std::min(n, (c + 1) * chunk_size); i++) {
+          counts[digit(i)]++;
+        }
+      }
+    });
+    int64_t total = 0;
+    for (int64_t d = 0; d < kRadix; d++) {
+      for (int64_t c = 0; c < num_chunks; c++) {
+        const int64_t count = offsets[c * kRadix + d];
+        offsets[c * kRadix + d] = total;
+        total += count;
+      }
+    }
+    at::parallel_for(0, num_chunks, 1, [&](int64_t start, int64_t end) {
+      for (int64_t c = start; c < end; c++) {
+        int64_t* positions = offsets.data() + c * kRadix;
+        for (int64_t i = c * chunk_size; i < std::min(n, (c + 1) * chunk_size); i++) {
+          const int64_t pos = positions[digit(i)]++;
+          keys_out[pos] = keys_in[i];
+          permutation_out[pos] = permutation_in[i];
+        }
+      }
+    });
+    std::swap(sorted_keys, keys_buffer);
+    std::swap(permutation, permutation_buffer);
+  }
+  return std::make_tuple(sorted_keys, permutation);
+}
+
+} // namespace
+
+std::tuple<Tensor, Tensor> sort_flattened_indices(const Tensor& keys) {
+  // The number of passes of the radix sort depends on the largest key
+  if (keys.numel() >= at::internal::GRAIN_SIZE && keys.min().item<int64_t>() >= 0) {
+    return radix_sort_flattened_indices(keys, keys.max().item<int64_t>());
+  }
+  return keys.sort(0);
+}
+
+std::vector<int64_t> find_run_starts(const Tensor& sorted_keys) {
+  TORCH_INTERNAL_ASSERT(sorted_keys.dim() == 1 && sorted_keys.is_contiguous());
+  const int64_t n = sorted_keys.numel();
+  const int64_t* keys = sorted_keys.data_ptr<int64_t>();
+  auto is_start = [&](int64_t i) { return i == 0 || keys[i] != keys[i - 1]; };
+
+  // Every chunk counts its runs, and then writes their starts after those of
+  // the previous chunks.
+  const int64_t num_chunks = std::max<int64_t>(
+      1, std::min<int64_t>(at::get_num_threads(), divup(n, at::internal::GRAIN_SIZE)));
+  const int64_t chunk_size = divup(n, num_chunks);
+  std::vector<int64_t> chunk_offsets(num_chunks + 1, 0);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t start, int64_t end) {
+    for (int64_t c = start; c < end; c++) {
+      int64_t count = 0;
+      for (int64_t i = c * chunk_size; i < std::min(n, (c + 1) * chunk_size); i++) {
+        count += is_start(i);
+      }
+      chunk_offsets[c + 1] = count;
+    }
+  });
+  std::partial_sum(chunk_offsets.begin(), chunk_offsets.end(), chunk_offsets.begin());
+
+  std::vector<int64_t> starts(chunk_offsets[num_chunks] + 1);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t start, int64_t end) {
+    for (int64_t c = start; c < end; c++) {
+      int64_t pos = chunk_offsets[c];
+      for (int64_t i = c * chunk_size; i < std::min(n, (c + 1) * chunk_size); i++) {
+        if (is_start(i)) {
+          starts[pos++] = i;
+        }
+      }
+    }
+  });
+  starts.back() = n;
+  return starts;
+}
+
 }} // namespace at::sparse
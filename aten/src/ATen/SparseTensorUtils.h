@@ -97,4 +97,15 @@ TORCH_API Tensor flatten_indices_by_dims(const Tensor& indices, const IntArrayRe
 // Find the CSR representation for a row `indices` from the COO format
 TORCH_API Tensor coo_to_csr(const int64_t* indices, int64_t dim, int64_t nnz);
 
+// Sorts flattened indices (see NOTE [ Flatten Sparse Indices ]) like
+// keys.sort(0), returning the sorted keys and the permutation that sorts them.
+// Large inputs of non-negative keys are sorted with a parallel radix sort,
+// which, unlike the comparison sort, keeps equal keys in their input order.
+TORCH_API std::tuple<Tensor, Tensor> sort_flattened_indices(const Tensor& keys);
+
+// Returns the positions where the runs of equal keys of the contiguous sorted
+// 1D tensor `sorted_keys` start, followed by its size, so that run i is
+// [starts[i], starts[i + 1]). The runs are found in parallel.
+TORCH_API std::vector<int64_t> find_run_starts(const Tensor& sorted_keys);
+
 }} // namespace at::sparse
@@ -7,6 +7,11 @@
 #include <ATen/MemoryOverlap.h>
 #include <ATen/native/Resize.h>
 #include <ATen/TensorOperators.h>
+#include <c10/util/flat_hash_map.h>
+#include <c10/util/hash.h>
+
+#include <atomic>
+#include <mutex>
 
 namespace at {
 
@@ -426,19 +431,19 @@ void TensorIteratorBase::allocate_or_resize_outputs() {
         // can just return contiguous output
         // it is faster because it avoids allocating 0 size tensor and
         // resizing and restriding it
-        set_output(i, tensor_shape, {}, op.options(), names_);
+        record_set_output(i, tensor_shape, {}, op.options(), names_);
       } else {
         auto tensor_stride = invert_perm(op.stride_bytes);
         for (int dim = 0; dim < ndim(); dim++) {
           tensor_stride[dim] /= element_size;
         }
-        set_output(i, tensor_shape, tensor_stride, op.options(), names_);
+        record_set_output(i, tensor_shape, tensor_stride, op.options(), names_);
       }
       op.current_dtype = op.target_dtype;
     } else if (op.tensor.defined()) {
       // Even if we don't resize, we still need to tell set_output about
       // the output, so that we properly set guard and propagate names
-      set_output(i, op.tensor.sizes(), {}, op.tensor.options(), names_);
+      record_set_output(i, op.tensor.sizes(), {}, op.tensor.options(), names_);
     }
   }
 }
@@ -1094,7 +1099,7 @@ bool TensorIteratorBase::fast_set_up(const TensorIteratorConfig& config) {
           if (!op.tensor.defined()) {
             TORCH_INTERNAL_ASSERT(op.is_type_defined(), "no type for operand", i);
           }
-          set_output(i, shape_, {}, op.options().memory_format(MemoryFormat::Contiguous), names_);
+          record_set_output(i, shape_, {}, op.options().memory_format(MemoryFormat::Contiguous), names_);
         }
         break;
       }
@@ -1105,7 +1110,7 @@ bool TensorIteratorBase::fast_set_up(const TensorIteratorConfig& config) {
           if (!op.tensor.defined()) {
             TORCH_INTERNAL_ASSERT(op.is_type_defined(), "no type for operand", i);
           }
-          set_output(i, shape_, {}, op.options().memory_format(MemoryFormat::ChannelsLast), names_);
+          record_set_output(i, shape_, {}, op.options().memory_format(MemoryFormat::ChannelsLast), names_);
         }
         break;
       }
@@ -1122,7 +1127,7 @@ bool TensorIteratorBase::fast_set_up(const TensorIteratorConfig& config) {
           if (!op.tensor.defined()) {
             TORCH_INTERNAL_ASSERT(op.is_type_defined(), "no type for operand", i);
           }
-          set_output(i, shape_, operands_[i_defined].tensor.strides(), op.options(), names_);
+          record_set_output(i, shape_, operands_[i_defined].tensor.strides(), op.options(), names_);
         }
         break;
       }
@@ -1199,6 +1204,252 @@ FastSetupType TensorIteratorBase::compute_fast_setup_type(const TensorIteratorCo
   return FastSetupType::NONE;
 }
 
+namespace detail {
+
+struct TensorIteratorPlan {
+  struct Operand {
+    StrideVector stride_bytes;
+    ScalarType target_dtype = ScalarType::Undefined;
+    ScalarType current_dtype = ScalarType::Undefined;
+    Device device = kCPU;
+  };
+
+  struct SetOutputCall {
+    int64_t output_idx;
+    DimVector sizes;
+    DimVector strides;
+    TensorOptions options;
+  };
+
+  // false if builds with this key can't be cached, so that they don't pay
+  // for recording a plan every time
+  bool cacheable = false;
+  DimVector shape;
+  DimVector perm;
+  bool has_coalesced_dimensions = false;
+  bool all_ops_same_shape = false;
+  ScalarType common_dtype = ScalarType::Undefined;
+  SmallVector<Operand, 4> operands;
+  SmallVector<SetOutputCall, 1> set_output_calls;
+};
+
+} // namespace detail
+
+namespace {
+
+using detail::TensorIteratorPlan;
+using detail::TensorIteratorPlanKey;
+
+std::atomic<bool> plan_cache_enabled{false};
+
+struct PlanKeyHash {
+  size_t operator()(const TensorIteratorPlanKey& key) const {
+    size_t hash = key.size();
+    for (auto value : key) {
+      hash = c10::hash_combine(hash, std::hash<int64_t>()(value));
+    }
+    return hash;
+  }
+};
+
+// Only the owning thread touches plans and writes the counters
+struct PlanCache {
+  ska::flat_hash_map<TensorIteratorPlanKey, TensorIteratorPlan, PlanKeyHash> plans;
+  std::atomic<int64_t> hits{0};
+  std::atomic<int64_t> misses{0};
+  std::atomic<int64_t> uncacheable{0};
+
+  static void bump(std::atomic<int64_t>& counter) {
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+};
+
+struct PlanCacheRegistry {
+  std::mutex mutex;
+  std::vector<PlanCache*> caches;
+  // stats of threads that exited, minus the totals at the last reset
+  TensorIteratorPlanCacheStats retired;
+};
+
+PlanCacheRegistry& plan_cache_registry() {
+  // leaked, threads may exit after static destructors ran
+  static auto* registry = new PlanCacheRegistry();
+  return *registry;
+}
+
+struct PlanCacheHolder {
+  PlanCacheHolder() {
+    auto& registry = plan_cache_registry();
+    std::lock_guard<std::mutex> guard(registry.mutex);
+    registry.caches.push_back(&cache);
+  }
+
+  ~PlanCacheHolder() {
+    auto& registry = plan_cache_registry();
+    std::lock_guard<std::mutex> guard(registry.mutex);
+    registry.retired.hits += cache.hits.load(std::memory_order_relaxed);
+    registry.retired.misses += cache.misses.load(std::memory_order_relaxed);
+    registry.retired.uncacheable += cache.uncacheable.load(std::memory_order_relaxed);
+    registry.caches.erase(std::find(registry.caches.begin(), registry.caches.end(), &cache));
+  }
+
+  PlanCache cache;
+};
+
+PlanCache& thread_plan_cache() {
+  static thread_local PlanCacheHolder holder;
+  return holder.cache;
+}
+
+} // namespace
+
+void set_tensor_iterator_plan_cache_enabled(bool enabled) {
+  plan_cache_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool tensor_iterator_plan_cache_enabled() {
+  return plan_cache_enabled.load(std::memory_order_relaxed);
+}
+
+TensorIteratorPlanCacheStats tensor_iterator_plan_cache_stats() {
+  auto& registry = plan_cache_registry();
+  std::lock_guard<std::mutex> guard(registry.mutex);
+  auto stats = registry.retired;
+  for (auto* cache : registry.caches) {
+    stats.hits += cache->hits.load(std::memory_order_relaxed);
+    stats.misses += cache->misses.load(std::memory_order_relaxed);
+    stats.uncacheable += cache->uncacheable.load(std::memory_order_relaxed);
+  }
+  return stats;
+}
+
+void reset_tensor_iterator_plan_cache_stats() {
+  auto& registry = plan_cache_registry();
+  std::lock_guard<std::mutex> guard(registry.mutex);
+  // the counters are only written by their threads, so fold the current
+  // totals into retired with the opposite sign instead of zeroing them
+  registry.retired = TensorIteratorPlanCacheStats();
+  for (auto* cache : registry.caches) {
+    registry.retired.hits -= cache->hits.load(std::memory_order_relaxed);
+    registry.retired.misses -= cache->misses.load(std::memory_order_relaxed);
+    registry.retired.uncacheable -= cache->uncacheable.load(std::memory_order_relaxed);
+  }
+}
+
+void clear_tensor_iterator_plan_cache() {
+  thread_plan_cache().plans.clear();
+}
+
+bool TensorIteratorBase::compute_plan_key(const TensorIteratorConfig& config, TensorIteratorPlanKey& key) const {
+  key.push_back(
+      config.check_mem_overlap_ |
+      config.allow_cpu_scalars_ << 1 |
+      config.is_reduction_ << 2 |
+      config.resize_outputs_ << 3 |
+      config.check_all_same_dtype_ << 4 |
+      config.check_all_same_device_ << 5 |
+      config.enforce_safe_casting_to_output_ << 6 |
+      config.promote_inputs_to_common_dtype_ << 7 |
+      config.promote_integer_inputs_to_float_ << 8 |
+      config.cast_common_dtype_to_outputs_ << 9);
+  key.push_back(num_outputs_);
+  key.push_back(ntensors());
+  if (config.promote_integer_inputs_to_float_) {
+    key.push_back(static_cast<int64_t>(c10::typeMetaToScalarType(c10::get_default_dtype())));
+  }
+  if (config.static_dtype_and_device_.has_value()) {
+    const auto& dtype_and_device = *config.static_dtype_and_device_;
+    key.push_back(static_cast<int64_t>(dtype_and_device.first));
+    key.push_back(static_cast<int64_t>(dtype_and_device.second.type()));
+    key.push_back(dtype_and_device.second.index());
+  } else {
+    key.push_back(-1);
+  }
+  if (config.static_shape_.has_value()) {
+    key.push_back(static_cast<int64_t>(config.static_shape_->size()));
+    key.append(config.static_shape_->begin(), config.static_shape_->end());
+  } else {
+    key.push_back(-1);
+  }
+  for (const auto& op : operands_) {
+    const auto& tensor = op.tensor;
+    if (!tensor.defined()) {
+      key.push_back(-1);
+      continue;
+    }
+    if (tensor.has_names()) {
+      return false;
+    }
+    key.push_back(static_cast<int64_t>(tensor.scalar_type()));
+    key.push_back(static_cast<int64_t>(tensor.device().type()));
+    key.push_back(tensor.device().index());
+    key.push_back(tensor.unsafeGetTensorImpl()->is_wrapped_number() | op.is_read_write << 1);
+    key.push_back(tensor.dim());
+    key.append(tensor.sizes().begin(), tensor.sizes().end());
+    key.append(tensor.strides().begin(), tensor.strides().end());
+  }
+  return true;
+}
+
+bool TensorIteratorBase::save_plan(TensorIteratorPlan& plan) const {
+  if (!names_.empty()) {
+    return false;
+  }
+  for (const auto& op : operands_) {
+    // temporaries for type promotion and resized outputs are new tensors
+    // with their own metadata on every build
+    if (op.original_tensor.defined() || op.will_resize) {
+      return false;
+    }
+  }
+  plan.shape = shape_;
+  plan.perm = perm_;
+  plan.has_coalesced_dimensions = has_coalesced_dimensions_;
+  plan.all_ops_same_shape = all_ops_same_shape_;
+  plan.common_dtype = common_dtype_;
+  plan.operands.resize(ntensors());
+  for (int i = 0; i < ntensors(); i++) {
+    const auto& op = operands_[i];
+    auto& saved = plan.operands[i];
+    saved.stride_bytes = op.stride_bytes;
+    saved.target_dtype = op.target_dtype;
+    saved.current_dtype = op.current_dtype;
+    saved.device = op.device;
+  }
+  return true;
+}
+
+void TensorIteratorBase::apply_plan(const TensorIteratorPlan& plan) {
+  TORCH_INTERNAL_ASSERT_DEBUG_ONLY(plan.operands.size() == operands_.size());
+  shape_ = plan.shape;
+  perm_ = plan.perm;
+  has_coalesced_dimensions_ = plan.has_coalesced_dimensions;
+  all_ops_same_shape_ = plan.all_ops_same_shape;
+  common_dtype_ = plan.common_dtype;
+  for (int i = 0; i < ntensors(); i++) {
+    auto& op = operands_[i];
+    const auto& saved = plan.operands[i];
+    op.stride_bytes = saved.stride_bytes;
+    op.target_dtype = saved.target_dtype;
+    op.device = saved.device;
+  }
+  // set_output reads the target dtypes restored above
+  for (const auto& call : plan.set_output_calls) {
+    set_output(call.output_idx, call.sizes, call.strides, call.options, names_);
+  }
+  for (int i = 0; i < ntensors(); i++) {
+    operands_[i].current_dtype = plan.operands[i].current_dtype;
+  }
+}
+
+void TensorIteratorBase::record_set_output(int64_t output_idx, IntArrayRef sizes, IntArrayRef strides, TensorOptions options, DimnameList names) {
+  if (recording_plan_) {
+    recording_plan_->set_output_calls.push_back(
+        {output_idx, DimVector(sizes), DimVector(strides), options});
+  }
+  set_output(output_idx, sizes, strides, options, names);
+}
+
 TensorIteratorBase::TensorIteratorBase() {}
 
 void TensorIteratorBase::build(TensorIteratorConfig& config) {
@@ -1212,24 +1463,63 @@ void TensorIteratorBase::build(TensorIteratorConfig& config) {
   // Check that the outputs have no internal overlap
   // and do not share memory with inputs.
   compute_mem_overlaps(config);
-  // Check that input dimensions are aligned correctly & compute outnames.
-  compute_names(config);
-  // compute the broadcasted shape
-  compute_shape(config);
-  // mark outputs for resizing if necessary
-  mark_resize_outputs(config);
-  // compute the result dtype and device
-  compute_types(config);
-  // try fast setup output tensor, if failed, fallback to normal setup
-  if (!fast_set_up(config)) {
-    // compute each tensor's stride after broadcasting
-    compute_strides(config);
-    // re-order dimensions to improve coalescing
-    reorder_dimensions();
-    // allocate the output tensor if it's not provided
-    allocate_or_resize_outputs();
-    // coalesce adjacent dimensions when possible
-    if (!is_meta_) coalesce_dimensions();
+
+  // look up the layout in the plan cache, see Note [TensorIterator plan cache]
+  TensorIteratorPlanKey plan_key;
+  TensorIteratorPlan new_plan;
+  bool record_plan = false;
+  const TensorIteratorPlan* cached_plan = nullptr;
+  if (C10_UNLIKELY(plan_cache_enabled.load(std::memory_order_relaxed))) {
+    auto& cache = thread_plan_cache();
+    if (is_meta_ || !compute_plan_key(config, plan_key)) {
+      PlanCache::bump(cache.uncacheable);
+    } else {
+      auto it = cache.plans.find(plan_key);
+      if (it == cache.plans.end()) {
+        PlanCache::bump(cache.misses);
+        record_plan = true;
+        recording_plan_ = &new_plan;
+      } else if (it->second.cacheable) {
+        PlanCache::bump(cache.hits);
+        cached_plan = &it->second;
+      } else {
+        PlanCache::bump(cache.uncacheable);
+      }
+    }
+  }
+
+  if (cached_plan) {
+    apply_plan(*cached_plan);
+  } else {
+    // Check that input dimensions are aligned correctly & compute outnames.
+    compute_names(config);
+    // compute the broadcasted shape
+    compute_shape(config);
+    // mark outputs for resizing if necessary
+    mark_resize_outputs(config);
+    // compute the result dtype and device
+    compute_types(config);
+    // try fast setup output tensor, if failed, fallback to normal setup
+    if (!fast_set_up(config)) {
+      // compute each tensor's stride after broadcasting
+      compute_strides(config);
+      // re-order dimensions to improve coalescing
+      reorder_dimensions();
+      // allocate the output tensor if it's not provided
+      allocate_or_resize_outputs();
+      // coalesce adjacent dimensions when possible
+      if (!is_meta_) coalesce_dimensions();
+    }
+  }
+
+  if (record_plan) {
+    recording_plan_ = nullptr;
+    auto& plans = thread_plan_cache().plans;
+    if (plans.size() >= kTensorIteratorPlanCacheSize) {
+      plans.clear();
+    }
+    new_plan.cacheable = save_plan(new_plan);
+    plans.emplace(std::move(plan_key), std::move(new_plan));
   }
 
   if (is_meta_) return;
@@ -141,6 +141,54 @@ enum class FastSetupType : uint8_t {
 class TensorIteratorConfig;
 struct TensorIterator;
 
+// Note [TensorIterator plan cache]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Most of the time spent building a TensorIterator for a small tensor goes
+// into computing its layout: the broadcasted shape, the dtypes, the
+// permuted and coalesced strides. That layout only depends on the
+// configuration and on the metadata (dtype, device, sizes and strides) of
+// the operands, so code that calls the same operators on same shaped tensors
+// over and over, like an inference loop, computes it over and over.
+//
+// When the plan cache is enabled, build() looks the layout up in a per
+// thread cache keyed by the configuration and the metadata of the operands.
+// On a hit it replays the set_output calls of the original build, restores
+// the layout and only binds the new data pointers. Memory overlap is still
+// checked on every build, since it depends on the data pointers. The key
+// doesn't include the operator, two operators with the same configuration
+// and operands compute the same layout.
+//
+// Builds with named tensors, meta tensors, temporaries for type promotion
+// or outputs that need to be resized are never cached.
+//
+// The cache is disabled by default and only meant for workloads with a
+// small number of distinct shapes; each thread keeps up to
+// kTensorIteratorPlanCacheSize plans and drops all of them when it is full.
+
+constexpr size_t kTensorIteratorPlanCacheSize = 1024;
+
+struct TORCH_API TensorIteratorPlanCacheStats {
+  // builds that reused a cached plan
+  int64_t hits = 0;
+  // builds that computed and cached a new plan
+  int64_t misses = 0;
+  // builds that can't be cached, see above
+  int64_t uncacheable = 0;
+};
+
+TORCH_API void set_tensor_iterator_plan_cache_enabled(bool enabled);
+TORCH_API bool tensor_iterator_plan_cache_enabled();
+// Sums the stats of all threads since the last reset
+TORCH_API TensorIteratorPlanCacheStats tensor_iterator_plan_cache_stats();
+TORCH_API void reset_tensor_iterator_plan_cache_stats();
+// Drops the plans cached by the calling thread
+TORCH_API void clear_tensor_iterator_plan_cache();
+
+namespace detail {
+struct TensorIteratorPlan;
+using TensorIteratorPlanKey = SmallVector<int64_t, 48>;
+} // namespace detail
+
 struct TORCH_API TensorIteratorBase : public impl::MetaBase {
   using DimMask = std::bitset<64>;
   using PtrVector = SmallVector<char*, 4>;
@@ -248,6 +296,15 @@ struct TORCH_API TensorIteratorBase : public impl::MetaBase {
 
   void parallel_reduce(loop2d_t loop);
 
+  /// Reductions put all their reduced dimensions first. When the input isn't
+  /// contiguous in the innermost one, e.g. for x.sum((0, 2)) with x in NCHW,
+  /// the 2-d loops of parallel_reduce would only see reduced dimensions and
+  /// read one strided element at a time. If the input and the output are
+  /// both contiguous in a kept dimension, this moves that dimension second,
+  /// so that the loops reduce down contiguous columns instead. Returns
+  /// whether it did.
+  bool reorder_for_outer_reduction();
+
   void serial_for_each(loop_t loop, Range range) const;
   void serial_for_each(loop2d_t loop, Range range) const;
 
@@ -311,6 +368,7 @@ protected:
   void compute_strides(const TensorIteratorConfig&);
   void reorder_dimensions();
   void permute_dimensions(IntArrayRef perm);
+  int find_outer_reduction_dim() const;
   void compute_types(const TensorIteratorConfig&);
   ScalarType compute_common_dtype();
   void allocate_or_resize_outputs();
@@ -320,6 +378,13 @@ protected:
   void propagate_names_to_outputs();
   void coalesce_dimensions();
 
+  // See Note [TensorIterator plan cache]
+  bool compute_plan_key(const TensorIteratorConfig&, detail::TensorIteratorPlanKey&) const;
+  bool save_plan(detail::TensorIteratorPlan&) const;
+  void apply_plan(const detail::TensorIteratorPlan&);
+  // Calls set_output and records the call in the plan being built, if any
+  void record_set_output(int64_t output_idx, IntArrayRef sizes, IntArrayRef strides, TensorOptions options, DimnameList names);
+
 protected:
 
   /// Records the "computation" shape of the output tensor.  The computation
@@ -406,6 +471,10 @@ protected:
 
   /// Set by populate_operands(), says if we're handling meta tensors
   bool is_meta_ = false;
+
+  /// The plan build() is filling in, only set while building with the plan
+  /// cache enabled.  See Note [TensorIterator plan cache]
+  detail::TensorIteratorPlan* recording_plan_ = nullptr;
 };
 
 struct TORCH_API TensorIterator final : public TensorIteratorBase {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <c10/core/InferenceMode.h>
 #include <c10/core/impl/LocalDispatchKeySet.h>
 #include <c10/util/Exception.h>
 #include <c10/util/ThreadLocalDebugInfo.h>
@@ -30,6 +31,9 @@ class TORCH_API ThreadLocalState {
   // with DebugInfoGuard
   std::shared_ptr<c10::ThreadLocalDebugInfo> debug_info_;
 
+  // InferenceMode, whose autograd keys are part of dispatch_key_
+  bool inference_mode_enabled_;
+
   // RecordFunction TLS
   RecordFunctionTLS rf_tls_;
 
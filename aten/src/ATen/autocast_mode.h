@@ -4,8 +4,10 @@ namespace at {
 namespace autocast {
 
 namespace {
-  bool is_autocast_eligible(const Tensor& tensor) {
-    return (tensor.is_cuda() || tensor.is_xla()) && tensor.is_floating_point();
+  bool is_autocast_eligible(const Tensor& tensor, DeviceType device_type) {
+    return device_type == DeviceType::CUDA
+        ? (tensor.is_cuda() || tensor.is_xla()) && tensor.is_floating_point()
+        : (tensor.is_cpu() || tensor.is_mkldnn()) && tensor.is_floating_point();
   }
 } // namespace
 
@@ -14,6 +16,16 @@ TORCH_API void set_enabled(bool enabled);
 TORCH_API void clear_cache();
 TORCH_API int increment_nesting();
 TORCH_API int decrement_nesting();
+TORCH_API bool is_cpu_enabled();
+TORCH_API void set_cpu_enabled(bool enabled);
+TORCH_API at::ScalarType get_autocast_cpu_dtype();
+TORCH_API void set_autocast_cpu_dtype(at::ScalarType dtype);
+
+// The type the lower precision ops run in: float16 on CUDA, and bfloat16
+// (unless set otherwise with set_autocast_cpu_dtype) on CPU.
+inline at::ScalarType get_lower_precision_fp_from_device_type(DeviceType device_type) {
+  return device_type == DeviceType::CUDA ? at::kHalf : get_autocast_cpu_dtype();
+}
 
 /********************************************************************
 Logic to extract the promote type from any Tensor or TensorList args.
@@ -22,19 +34,19 @@ Logic to extract the promote type from any Tensor or TensorList args.
 // Overload to catch Tensor args.
 // If nextArg is floating-point, compare its scalar_type with our
 // current best guess for the promote type, and update if necessary.
-inline at::ScalarType prioritize(at::ScalarType current, const Tensor& nextArg) {
+inline at::ScalarType prioritize(at::ScalarType current, const Tensor& nextArg, DeviceType device_type) {
   if (current == at::kDouble) {
     AT_ERROR("promote type is double in at::autocast::prioritize");
     return current;
   }
-  if (is_autocast_eligible(nextArg)) {
+  if (is_autocast_eligible(nextArg, device_type)) {
     auto next = nextArg.scalar_type();
     if (next == at::kDouble) {
       return current; // ignores double tensors
     } else if (current == at::kFloat || next == at::kFloat) {
-      return at::kFloat; // prioritizes float over half
-    } else if (current == at::kHalf && next == at::kHalf) {
-      return at::kHalf;
+      return at::kFloat; // prioritizes float over the lower precision type
+    } else if (current == next) {
+      return current; // both are the lower precision type
     } else {
       AT_ERROR("Unexpected floating ScalarType in at::autocast::prioritize");
       return current;
@@ -46,64 +58,64 @@ inline at::ScalarType prioritize(at::ScalarType current, const Tensor& nextArg)
 
 // Overload to catch TensorList args (for e.g. cat, stack).
 // Reuses the overload above to process each Tensor in the list.
-inline at::ScalarType prioritize(at::ScalarType current, const TensorList& list) {
+inline at::ScalarType prioritize(at::ScalarType current, const TensorList& list, DeviceType device_type) {
   for (const auto& tensor : list) {
-    current = prioritize(current, tensor);
+    current = prioritize(current, tensor, device_type);
   }
   return current;
 }
 
 // Template to catch non-Tensor args (no-op that returns current best guess)
 template<typename T>
-inline at::ScalarType prioritize(at::ScalarType current, T nextArg) {
+inline at::ScalarType prioritize(at::ScalarType current, T nextArg, DeviceType device_type) {
   return current;
 }
 
 // Overload for the tail case.
-inline at::ScalarType promote_type(at::ScalarType current) {
+inline at::ScalarType promote_type(at::ScalarType current, DeviceType device_type) {
   return current;
 }
 
-// Unpack args and determine if incoming float16 tensors need to be promoted to float32.
+// Unpack args and determine if incoming lower precision tensors need to be promoted to float32.
 // Non-Tensor arguments are ignored.
 template<typename Arg0, typename... Args>
-inline at::ScalarType promote_type(at::ScalarType current, Arg0 arg0, Args... args) {
-  auto new_current = prioritize(current, arg0);
-  return promote_type(new_current, args...);
+inline at::ScalarType promote_type(at::ScalarType current, DeviceType device_type, Arg0 arg0, Args... args) {
+  auto new_current = prioritize(current, arg0, device_type);
+  return promote_type(new_current, device_type, args...);
 }
 
 /****************************************************
 Logic to apply cached casting to any Tensor argument.
 ****************************************************/
-inline bool is_eligible(const Tensor& arg) {
-  return (arg.defined() && is_autocast_eligible(arg) && (arg.scalar_type() != at::kDouble));
+inline bool is_eligible(const Tensor& arg, DeviceType device_type) {
+  return (arg.defined() && is_autocast_eligible(arg, device_type) && (arg.scalar_type() != at::kDouble));
 }
 
 // Overload to catch Tensor args
-TORCH_API Tensor cached_cast(at::ScalarType to_type, const Tensor& arg);
+TORCH_API Tensor cached_cast(at::ScalarType to_type, const Tensor& arg, DeviceType device_type);
 
 // Overload to process optional<Tensor>
-inline c10::optional<Tensor> cached_cast(at::ScalarType to_type, const c10::optional<Tensor>& arg) {
+inline c10::optional<Tensor> cached_cast(at::ScalarType to_type, const c10::optional<Tensor>& arg, DeviceType device_type) {
   if (arg.has_value()) {
-    return cached_cast(to_type, *arg);
+    return cached_cast(to_type, *arg, device_type);
   } else {
     return c10::nullopt;
   }
 }
 
 // Overload to process TensorLists
-inline std::vector<Tensor> cached_cast(at::ScalarType to_type, const TensorList& arg) {
+inline std::vector<Tensor> cached_cast(at::ScalarType to_type, const TensorList& arg, DeviceType device_type) {
   std::vector<Tensor> vec;
   vec.reserve(arg.size());
   for (const auto& t : arg) {
-    vec.push_back(cached_cast(to_type, t));
+    vec.push_back(cached_cast(to_type, t, device_type));
   }
   return vec;
 }
 
 // Template to catch non-Tensor args.
 template<typename T>
-inline T cached_cast(at::ScalarType to_type, T arg) {
+inline T cached_cast(at::ScalarType to_type, T arg, DeviceType device_type) {
   return arg;
 }
 
@@ -129,13 +141,13 @@ inline T set_opt_dtype(at::ScalarType to_type, T arg) {
 }
 
 template<typename... Args>
-inline bool firstarg_is_eligible(const Tensor& arg, Args... args) {
-  return is_eligible(arg);
+inline bool firstarg_is_eligible(DeviceType device_type, const Tensor& arg, Args... args) {
+  return is_eligible(arg, device_type);
 }
 
 template<typename... Args>
-inline at::ScalarType type_from_firstarg(at::ScalarType to_type, const Tensor& arg, Args... args) {
-  return (is_eligible(arg) ? to_type : arg.scalar_type());
+inline at::ScalarType type_from_firstarg(DeviceType device_type, at::ScalarType to_type, const Tensor& arg, Args... args) {
+  return (is_eligible(arg, device_type) ? to_type : arg.scalar_type());
 }
 
 } // namespace autocast
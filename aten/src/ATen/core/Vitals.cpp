@@ -1,5 +1,10 @@
 #include <ATen/core/Vitals.h>
+#include <c10/util/Exception.h>
+
+#include <algorithm>
 #include <cstdlib>
+#include <map>
+#include <mutex>
 
 namespace at {
 namespace vitals {
@@ -30,5 +35,203 @@ bool torchVitalEnabled() {
   return enabled;
 }
 
+size_t Counter::currentThreadShard() {
+  static std::atomic<size_t> next_shard{0};
+  thread_local size_t shard =
+      next_shard.fetch_add(1, std::memory_order_relaxed) % kNumShards;
+  return shard;
+}
+
+int64_t Counter::value() const {
+  int64_t total = 0;
+  for (const auto& shard : shards_) {
+    total += shard.value.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+void Counter::reset() {
+  for (auto& shard : shards_) {
+    shard.value.store(0, std::memory_order_relaxed);
+  }
+}
+
+Histogram::Histogram(std::vector<double> bounds)
+    : bounds_(std::move(bounds)),
+      counts_(new std::atomic<int64_t>[bounds_.size() + 1]) {
+  TORCH_CHECK(
+      std::is_sorted(bounds_.begin(), bounds_.end()),
+      "Expected the bounds of a histogram to be sorted");
+  for (size_t i = 0; i <= bounds_.size(); ++i) {
+    counts_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+void Histogram::observe(double v) {
+  const size_t bucket =
+      std::lower_bound(bounds_.begin(), bounds_.end(), v) - bounds_.begin();
+  counts_[bucket].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  double sum = sum_.load(std::memory_order_relaxed);
+  while (!sum_.compare_exchange_weak(
+      sum, sum + v, std::memory_order_relaxed)) {
+  }
+}
+
+std::vector<int64_t> Histogram::counts() const {
+  std::vector<int64_t> result(bounds_.size() + 1);
+  for (size_t i = 0; i < result.size(); ++i) {
+    result[i] = counts_[i].load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+void Histogram::reset() {
+  for (size_t i = 0; i <= bounds_.size(); ++i) {
+    counts_[i].store(0, std::memory_order_relaxed);
+  }
+  count_.store(0, std::memory_order_relaxed);
+  sum_.store(0, std::memory_order_relaxed);
+}
+
+namespace {
+
+struct MetricEntry {
+  MetricKind kind;
+  // Only the one of kind is set
+  std::unique_ptr<Counter> counter;
+  std::unique_ptr<Gauge> gauge;
+  std::unique_ptr<Histogram> histogram;
+};
+
+struct MetricRegistry {
+  std::mutex mutex;
+  std::map<std::string, MetricEntry> metrics;
+};
+
+MetricRegistry& metricRegistry() {
+  // Leaked, so that metrics can still be updated from static destructors
+  static auto* registry = new MetricRegistry();
+  return *registry;
+}
+
+const char* metricKindName(MetricKind kind) {
+  switch (kind) {
+    case MetricKind::Counter:
+      return "counter";
+    case MetricKind::Gauge:
+      return "gauge";
+    case MetricKind::Histogram:
+      return "histogram";
+  }
+  return "";
+}
+
+// Returns the entry of name, after checking that it is of kind. created is set
+// if the entry didn't exist yet. Must be called with the registry locked.
+MetricEntry& getOrCreateEntry(
+    MetricRegistry& registry,
+    const std::string& name,
+    MetricKind kind,
+    bool& created) {
+  auto it = registry.metrics.find(name);
+  created = it == registry.metrics.end();
+  if (created) {
+    it = registry.metrics
+             .emplace(name, MetricEntry{kind, nullptr, nullptr, nullptr})
+             .first;
+  }
+  TORCH_CHECK(
+      it->second.kind == kind,
+      "Metric ", name, " is already registered as a ",
+      metricKindName(it->second.kind), ", not as a ", metricKindName(kind));
+  return it->second;
+}
+
+} // namespace
+
+Counter& counter(const std::string& name) {
+  auto& registry = metricRegistry();
+  std::lock_guard<std::mutex> guard(registry.mutex);
+  bool created = false;
+  auto& entry = getOrCreateEntry(registry, name, MetricKind::Counter, created);
+  if (created) {
+    entry.counter = std::make_unique<Counter>();
+  }
+  return *entry.counter;
+}
+
+Gauge& gauge(const std::string& name) {
+  auto& registry = metricRegistry();
+  std::lock_guard<std::mutex> guard(registry.mutex);
+  bool created = false;
+  auto& entry = getOrCreateEntry(registry, name, MetricKind::Gauge, created);
+  if (created) {
+    entry.gauge = std::make_unique<Gauge>();
+  }
+  return *entry.gauge;
+}
+
+Histogram& histogram(
+    const std::string& name,
+    const std::vector<double>& bounds) {
+  // Checked before registering name, so that a failed registration leaves no
+  // entry behind
+  TORCH_CHECK(
+      std::is_sorted(bounds.begin(), bounds.end()),
+      "Expected the bounds of histogram ", name, " to be sorted");
+  auto& registry = metricRegistry();
+  std::lock_guard<std::mutex> guard(registry.mutex);
+  bool created = false;
+  auto& entry = getOrCreateEntry(registry, name, MetricKind::Histogram, created);
+  if (created) {
+    entry.histogram = std::make_unique<Histogram>(bounds);
+  }
+  TORCH_CHECK(
+      entry.histogram->bounds() == bounds,
+      "Histogram ", name, " is already registered with different bounds");
+  return *entry.histogram;
+}
+
+std::vector<MetricSnapshot> snapshotMetrics() {
+  auto& registry = metricRegistry();
+  std::lock_guard<std::mutex> guard(registry.mutex);
+  std::vector<MetricSnapshot> result;
+  result.reserve(registry.metrics.size());
+  for (const auto& it : registry.metrics) {
+    MetricSnapshot snapshot;
+    snapshot.name = it.first;
+    snapshot.kind = it.second.kind;
+    switch (it.second.kind) {
+      case MetricKind::Counter:
+        snapshot.value = it.second.counter->value();
+        break;
+      case MetricKind::Gauge:
+        snapshot.value = it.second.gauge->value();
+        break;
+      case MetricKind::Histogram:
+        snapshot.bounds = it.second.histogram->bounds();
+        snapshot.counts = it.second.histogram->counts();
+        snapshot.count = it.second.histogram->count();
+        snapshot.sum = it.second.histogram->sum();
+        break;
+    }
+    result.push_back(std::move(snapshot));
+  }
+  return result;
+}
+
+void resetMetrics() {
+  auto& registry = metricRegistry();
+  std::lock_guard<std::mutex> guard(registry.mutex);
+  for (auto& it : registry.metrics) {
+    if (it.second.counter) {
+      it.second.counter->reset();
+    } else if (it.second.histogram) {
+      it.second.histogram->reset();
+    }
+  }
+}
+
 } // namespace at
 } // namespace vitals
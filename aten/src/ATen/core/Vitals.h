@@ -1,8 +1,16 @@
 #pragma once
+#include <c10/macros/Macros.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
+#include <memory>
 #include <sstream>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace at {
 namespace vitals {
@@ -40,6 +48,115 @@ struct TorchVital {
   }
 };
 
+// Metrics are counters, gauges and histograms that subsystems look up by name
+// once, typically into a function-local static, and then update from any
+// thread. Unlike the attributes above they are always on: an update is a
+// relaxed atomic add. snapshotMetrics() reads all of them, e.g. to export
+// them to a monitoring system.
+//
+//   static auto& compilations = at::vitals::counter("jit.compilations");
+//   compilations.add();
+//
+// Metrics live until the end of the process, and names are unique across
+// kinds.
+
+enum class MetricKind { Counter, Gauge, Histogram };
+
+// A monotonic count. Updates are spread over shards, so that threads that
+// update the same counter don't contend on one cache line.
+class TORCH_API Counter {
+ public:
+  void add(int64_t n = 1) {
+    shards_[currentThreadShard()].value.fetch_add(n, std::memory_order_relaxed);
+  }
+  int64_t value() const;
+  void reset();
+
+ private:
+  static constexpr size_t kNumShards = 16;
+  static size_t currentThreadShard();
+
+  // Padded to a cache line. Not alignas, which would need aligned new.
+  struct Shard {
+    std::atomic<int64_t> value{0};
+    char padding[64 - sizeof(std::atomic<int64_t>)];
+  };
+  std::array<Shard, kNumShards> shards_;
+};
+
+// A value that goes up and down, e.g. the depth of a queue
+class TORCH_API Gauge {
+ public:
+  void set(int64_t v) {
+    value_.store(v, std::memory_order_relaxed);
+  }
+  void add(int64_t n) {
+    value_.fetch_add(n, std::memory_order_relaxed);
+  }
+  int64_t value() const {
+    return value_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<int64_t> value_{0};
+};
+
+// Counts observations in buckets: bucket i counts the values in
+// (bounds[i - 1], bounds[i]], and a last bucket counts the values above
+// bounds.back().
+class TORCH_API Histogram {
+ public:
+  explicit Histogram(std::vector<double> bounds);
+
+  void observe(double v);
+
+  const std::vector<double>& bounds() const {
+    return bounds_;
+  }
+  std::vector<int64_t> counts() const;
+  int64_t count() const {
+    return count_.load(std::memory_order_relaxed);
+  }
+  double sum() const {
+    return sum_.load(std::memory_order_relaxed);
+  }
+  void reset();
+
+ private:
+  const std::vector<double> bounds_;
+  std::unique_ptr<std::atomic<int64_t>[]> counts_;
+  std::atomic<int64_t> count_{0};
+  std::atomic<double> sum_{0};
+};
+
+struct TORCH_API MetricSnapshot {
+  std::string name;
+  MetricKind kind;
+  // The value of a counter or a gauge
+  int64_t value = 0;
+  // The buckets of a histogram, see Histogram
+  std::vector<double> bounds;
+  std::vector<int64_t> counts;
+  int64_t count = 0;
+  double sum = 0;
+};
+
+// Returns the metric registered under name, registering it on first use.
+// Registering a name again with a different kind, or a histogram with
+// different bounds, is an error.
+TORCH_API Counter& counter(const std::string& name);
+TORCH_API Gauge& gauge(const std::string& name);
+TORCH_API Histogram& histogram(
+    const std::string& name,
+    const std::vector<double>& bounds);
+
+// The current values of all the registered metrics, sorted by name
+TORCH_API std::vector<MetricSnapshot> snapshotMetrics();
+
+// Sets the counters and histograms back to zero. Gauges track the state of
+// their subsystem, and are left alone.
+TORCH_API void resetMetrics();
+
 } // namespace at
 } // namespace vitals
 
@@ -28,6 +28,7 @@ _(aten, _arange) \
 _(aten, _argmax) \
 _(aten, _argmin) \
 _(aten, _baddbmm_mkl) \
+_(aten, _batch_norm_relu_inference) \
 _(aten, _cast_Byte) \
 _(aten, _cast_Char) \
 _(aten, _cast_Double) \
@@ -56,7 +57,9 @@ _(aten, _cudnn_rnn) \
 _(aten, _cudnn_rnn_backward) \
 _(aten, _cudnn_rnn_flatten_weight) \
 _(aten, _cufft_clear_plan_cache) \
+_(aten, _cufft_get_plan_cache_hits) \
 _(aten, _cufft_get_plan_cache_max_size) \
+_(aten, _cufft_get_plan_cache_misses) \
 _(aten, _cufft_get_plan_cache_size) \
 _(aten, _cufft_set_plan_cache_max_size) \
 _(aten, _cumprod) \
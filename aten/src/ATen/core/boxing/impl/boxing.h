@@ -176,7 +176,9 @@ struct BoxedKernelWrapper<
     DispatchKeySet dispatchKeySet,
     Args... args
   ) {
-    torch::jit::Stack stack = boxArgs(args...);
+    // Arguments taken by value are moved onto the stack, only the ones taken
+    // by reference are copied
+    torch::jit::Stack stack = boxArgs<Args...>(std::forward<Args>(args)...);
     (*boxed_kernel_func)(functor, opHandle, dispatchKeySet, &stack);
 
     return guts::if_constexpr<!std::is_same<void, Result>::value>(
@@ -1,30 +1,10 @@
 #pragma once
 
-#include <c10/macros/Macros.h>
+#include <c10/core/GradMode.h>
 
+// GradMode lives in c10 so that InferenceMode can disable it
 namespace at {
-
-struct TORCH_API GradMode {
-  static bool is_enabled();
-  static void set_enabled(bool enabled);
-};
-
-// A RAII, thread local (!) guard that enables or disables grad mode upon
-// construction, and sets it back to the original value upon destruction.
-struct TORCH_API AutoGradMode {
-  AutoGradMode(bool enabled) : prev_mode(GradMode::is_enabled()) {
-    GradMode::set_enabled(enabled);
-  }
-  ~AutoGradMode() {
-    GradMode::set_enabled(prev_mode);
-  }
-  bool prev_mode;
-};
-
-// A RAII, thread local (!) guard that stops future operations from building
-// gradients.
-struct TORCH_API NoGradGuard : public AutoGradMode {
-  NoGradGuard() : AutoGradMode(/*enabled=*/false) {}
-};
-
+using c10::AutoGradMode;
+using c10::GradMode;
+using c10::NoGradGuard;
 }
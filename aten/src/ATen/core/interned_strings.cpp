@@ -20,6 +20,10 @@ const std::string& domain_prefix() {
 }
 
 Symbol InternedStrings::symbol(const std::string& s) {
+  auto sym = lookup(s);
+  if (sym) {
+    return *sym;
+  }
   std::lock_guard<std::mutex> guard(mutex_);
   return _symbol(s);
 }
@@ -46,8 +50,7 @@ std::pair<const char*, const char*> InternedStrings::string(Symbol sym) {
 
 Symbol InternedStrings::ns(Symbol sym) {
 #if defined C10_MOBILE
-  std::lock_guard<std::mutex> guard(mutex_);
-  return sym_to_info_.at(sym).ns;
+  return info(sym).ns;
 #else
   switch (sym) {
 #define DEFINE_CASE(ns, s) \
@@ -55,18 +58,17 @@ Symbol InternedStrings::ns(Symbol sym) {
     return namespaces::ns;
     FORALL_NS_SYMBOLS(DEFINE_CASE)
 #undef DEFINE_CASE
-    default: {
-      std::lock_guard<std::mutex> guard(mutex_);
-      return sym_to_info_.at(sym).ns;
-    }
+    default:
+      return info(sym).ns;
   }
 #endif
 }
 
 Symbol InternedStrings::_symbol(const std::string& s) {
-  auto it = string_to_sym_.find(s);
-  if (it != string_to_sym_.end())
-    return it->second;
+  // Another thread may have interned it since the lookup in symbol()
+  auto existing = lookup(s);
+  if (existing)
+    return *existing;
 
   auto pos = s.find("::");
   if (pos == std::string::npos) {
@@ -76,15 +78,34 @@ Symbol InternedStrings::_symbol(const std::string& s) {
   }
   Symbol ns = _symbol("namespaces::" + s.substr(0, pos));
 
-  Symbol sym(sym_to_info_.size());
-  string_to_sym_[s] = sym;
-  sym_to_info_.push_back({ns, s, s.substr(pos + strlen("::"))});
+  Symbol sym(infos_.size());
+  infos_.push_back({ns, s, s.substr(pos + strlen("::"))});
+  const SymbolInfo* new_info = &infos_.back();
+  tables_.write([&](Tables& tables) {
+    tables.string_to_sym.emplace(s, sym);
+    tables.sym_to_info.push_back(new_info);
+  });
   return sym;
 }
 
+c10::optional<Symbol> InternedStrings::lookup(const std::string& s) const {
+  return tables_.read([&](const Tables& tables) -> c10::optional<Symbol> {
+    auto it = tables.string_to_sym.find(s);
+    if (it == tables.string_to_sym.end()) {
+      return c10::nullopt;
+    }
+    return it->second;
+  });
+}
+
+const InternedStrings::SymbolInfo& InternedStrings::info(Symbol sym) const {
+  return *tables_.read([&](const Tables& tables) {
+    return tables.sym_to_info.at(sym);
+  });
+}
+
 std::pair<const char*, const char*> InternedStrings::customString(Symbol sym) {
-  std::lock_guard<std::mutex> guard(mutex_);
-  SymbolInfo& s = sym_to_info_.at(sym);
+  const SymbolInfo& s = info(sym);
   return {s.qual_name.c_str(), s.unqual_name.c_str()};
 }
 
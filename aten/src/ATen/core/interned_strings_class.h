@@ -1,5 +1,6 @@
 #include <cstdint>
 #include <cstring>
+#include <deque>
 #include <iostream>
 #include <mutex>
 #include <sstream>
@@ -8,6 +9,8 @@
 #include <vector>
 #include <ATen/core/interned_strings.h>
 #include <c10/util/Exception.h>
+#include <c10/util/LeftRight.h>
+#include <c10/util/Optional.h>
 
 namespace c10 {
 
@@ -18,18 +21,33 @@ struct TORCH_API InternedStrings {
   Symbol ns(Symbol sym);
 
  private:
-  // prereq - holding mutex_
-  Symbol _symbol(const std::string& s);
-  std::pair<const char*, const char*> customString(Symbol sym);
-  std::unordered_map<std::string, Symbol> string_to_sym_;
-
   struct SymbolInfo {
     Symbol ns;
     std::string qual_name;
     std::string unqual_name;
   };
-  std::vector<SymbolInfo> sym_to_info_;
 
+  // The lookup tables are read far more often than they are extended (every
+  // symbol is interned once, and then looked up by every model compiled or
+  // loaded), so they are kept in a LeftRight: lookups never take a lock and
+  // only the interning of new symbols is serialized. The SymbolInfo entries
+  // live in infos_ and never move, so both copies of the tables point to
+  // the same ones, and the strings handed out stay valid forever.
+  struct Tables {
+    std::unordered_map<std::string, Symbol> string_to_sym;
+    std::vector<const SymbolInfo*> sym_to_info;
+  };
+
+  // prereq - holding mutex_
+  Symbol _symbol(const std::string& s);
+  c10::optional<Symbol> lookup(const std::string& s) const;
+  const SymbolInfo& info(Symbol sym) const;
+  std::pair<const char*, const char*> customString(Symbol sym);
+
+  LeftRight<Tables> tables_;
+  // Only grows, while holding mutex_.
+  std::deque<SymbolInfo> infos_;
+  // Serializes the interning of new symbols, not their lookup.
   std::mutex mutex_;
 };
 
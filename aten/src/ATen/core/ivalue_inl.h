@@ -251,8 +251,13 @@ struct TORCH_API Tuple : c10::intrusive_ptr_target {
 
   template <typename... Args>
   static c10::intrusive_ptr<Tuple> create(Args... elements_) {
-    return c10::make_intrusive<Tuple>(
-        std::vector<IValue>{IValue(elements_)...});
+    // Not an initializer list, whose elements could only be copied into the
+    // vector
+    std::vector<IValue> elements;
+    elements.reserve(sizeof...(Args));
+    (void)std::initializer_list<int>{
+        (elements.emplace_back(std::move(elements_)), 0)...};
+    return c10::make_intrusive<Tuple>(std::move(elements));
   }
 
   const std::vector<IValue>& elements() const& {
@@ -987,10 +992,11 @@ c10::optional<T> generic_to(IValue ivalue, _fake_type<c10::optional<T>>) {
 namespace detail {
 template <typename Tuple, std::size_t... INDEX>
 Tuple generic_to_tuple_impl(
-    const std::vector<IValue>& t,
+    std::vector<IValue>& t,
     std::index_sequence<INDEX...>) {
   return std::make_tuple(
-      t[INDEX].to<typename std::tuple_element<INDEX, Tuple>::type>()...);
+      std::move(t[INDEX])
+          .to<typename std::tuple_element<INDEX, Tuple>::type>()...);
 }
 } // namespace detail
 
@@ -1003,8 +1009,16 @@ template <
             guts::negation<std::is_constructible<IValue, Args>>...>::value,
         std::nullptr_t> = nullptr>
 std::tuple<Args...> generic_to(IValue ivalue, _fake_type<std::tuple<Args...>>) {
-  auto vals = ivalue.toTuple()->elements();
-  TORCH_CHECK(vals.size() == sizeof...(Args));
+  auto tuple = std::move(ivalue).toTuple();
+  TORCH_CHECK(tuple->elements().size() == sizeof...(Args));
+  // Move the elements out of tuples that nothing else refers to, instead of
+  // copying them
+  std::vector<IValue> vals;
+  if (tuple.use_count() == 1) {
+    vals = std::move(*tuple).elements();
+  } else {
+    vals = tuple->elements();
+  }
   return detail::generic_to_tuple_impl<std::tuple<Args...>>(vals, Indices{});
 }
 
@@ -42,7 +42,7 @@ constexpr Entry entries[] = {
 } // namespace
 
 InternedStrings::InternedStrings()
-    : sym_to_info_(static_cast<size_t>(_keys::num_symbols)) {
+    : infos_(static_cast<size_t>(_keys::num_symbols)) {
   // Instead of a loop, this could be done by expanding the
   // assignments directly into FORALL_NS_SYMBOLS, but it would create
   // a huge function (thanks to all the std::string constructors and
@@ -50,11 +50,16 @@ InternedStrings::InternedStrings()
   // static C array of constexpr-constructible structs takes instead
   // no time to compile.
   for (const auto& entry : entries) {
-    auto qual_name = qual_name_for_entry(entry);
-    string_to_sym_[qual_name] = entry.sym;
-    sym_to_info_[entry.sym] = {
-      entry.ns_sym, std::move(qual_name), entry.unqual_name};
+    infos_[entry.sym] = {
+      entry.ns_sym, qual_name_for_entry(entry), entry.unqual_name};
   }
+  tables_.write([&](Tables& tables) {
+    tables.sym_to_info.reserve(infos_.size());
+    for (const auto& info : infos_) {
+      tables.string_to_sym[info.qual_name] = Symbol(tables.sym_to_info.size());
+      tables.sym_to_info.push_back(&info);
+    }
+  });
 }
 
 } // namespace c10
@@ -0,0 +1,332 @@
+#pragma once
+
+// DO NOT DEFINE STATIC DATA IN THIS HEADER!
+// See Note [Do not compile initializers with AVX]
+
+#include <ATen/cpu/vec256/functional_base.h>
+
+#include <tuple>
+
+namespace at { namespace vec256 {
+
+// Note [BFloat16 functional]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Calling the functions of functional_base.h with BFloat16 data and an op
+// taking Vec256<float> picks the overloads below. They convert every
+// Vec256<BFloat16> of input into two Vec256<float> once, apply the op on
+// float and round the result back to BFloat16 once, instead of rounding
+// after every operation like Vec256<BFloat16> arithmetic does. Reductions
+// accumulate and return float.
+//
+// Ops taking Vec256<BFloat16> keep using the generic versions.
+
+// Scalar type kernels compute and accumulate scalar_t in, write their ops
+// for Vec256<vec_scalar_t<scalar_t>>
+template <typename scalar_t>
+struct VecScalarType { using type = scalar_t; };
+template <>
+struct VecScalarType<BFloat16> { using type = float; };
+template <typename scalar_t>
+using vec_scalar_t = typename VecScalarType<scalar_t>::type;
+
+template <typename scalar_t, typename Op>
+using enable_if_bfloat16_float_op_t = typename std::enable_if<
+    is_bfloat16_float_op<scalar_t, Op>::value, int>::type;
+
+// See Note [Acceptable use of anonymous namespace in header]
+namespace {
+
+inline Vec256<BFloat16> load_bfloat16(const BFloat16* data, int64_t count) {
+  if (count == Vec256<BFloat16>::size()) {
+    return Vec256<BFloat16>::loadu(data);
+  }
+  return Vec256<BFloat16>::loadu(data, count);
+}
+
+inline std::tuple<Vec256<float>, Vec256<float>> load_float2(
+    const float* data,
+    int64_t count) {
+  using fVec = Vec256<float>;
+  if (count == 2 * fVec::size()) {
+    return std::make_tuple(fVec::loadu(data), fVec::loadu(data + fVec::size()));
+  }
+  if (count > fVec::size()) {
+    return std::make_tuple(
+        fVec::loadu(data),
+        fVec::loadu(data + fVec::size(), count - fVec::size()));
+  }
+  return std::make_tuple(fVec::loadu(data, count), fVec(0));
+}
+
+inline void store_float2(
+    float* data,
+    const Vec256<float>& vec0,
+    const Vec256<float>& vec1,
+    int64_t count) {
+  using fVec = Vec256<float>;
+  if (count > fVec::size()) {
+    vec0.store(data);
+    vec1.store(data + fVec::size(), count - fVec::size());
+  } else {
+    vec0.store(data, count);
+  }
+}
+
+// load_map(d, count) returns the mapped float values of the count (at most
+// Vec256<BFloat16>::size()) elements at offset d
+template <typename ReduceOp, typename LoadMapOp>
+inline float bfloat16_reduce_all(
+    const ReduceOp& red_fun,
+    const LoadMapOp& load_map,
+    int64_t size) {
+  using bVec = Vec256<BFloat16>;
+  using fVec = Vec256<float>;
+  fVec acc_fvec0, acc_fvec1;
+  if (size < bVec::size()) {
+    std::tie(acc_fvec0, acc_fvec1) = load_map(0, size);
+    if (size > fVec::size()) {
+      acc_fvec0 = fVec::set(
+          acc_fvec0, red_fun(acc_fvec0, acc_fvec1), size - fVec::size());
+      return vec_reduce_all<float>(red_fun, acc_fvec0, fVec::size());
+    }
+    return vec_reduce_all<float>(red_fun, acc_fvec0, size);
+  }
+  std::tie(acc_fvec0, acc_fvec1) = load_map(0, bVec::size());
+  int64_t d = bVec::size();
+  for (; d < size - (size % bVec::size()); d += bVec::size()) {
+    fVec data_fvec0, data_fvec1;
+    std::tie(data_fvec0, data_fvec1) = load_map(d, bVec::size());
+    acc_fvec0 = red_fun(acc_fvec0, data_fvec0);
+    acc_fvec1 = red_fun(acc_fvec1, data_fvec1);
+  }
+  if (size - d > 0) {
+    fVec data_fvec0, data_fvec1;
+    std::tie(data_fvec0, data_fvec1) = load_map(d, size - d);
+    if (size - d > fVec::size()) {
+      acc_fvec0 = red_fun(acc_fvec0, data_fvec0);
+      acc_fvec1 = fVec::set(
+          acc_fvec1, red_fun(acc_fvec1, data_fvec1), size - d - fVec::size());
+    } else {
+      acc_fvec0 =
+          fVec::set(acc_fvec0, red_fun(acc_fvec0, data_fvec0), size - d);
+    }
+  }
+  acc_fvec0 = red_fun(acc_fvec0, acc_fvec1);
+  return vec_reduce_all<float>(red_fun, acc_fvec0, fVec::size());
+}
+
+} // namespace
+
+template <typename scalar_t, typename Op,
+          enable_if_bfloat16_float_op_t<scalar_t, Op> = 0>
+inline float reduce_all(const Op& vec_fun, const scalar_t* data, int64_t size) {
+  return bfloat16_reduce_all(
+      vec_fun,
+      [data](int64_t d, int64_t count) {
+        return convert_bfloat16_float(load_bfloat16(data + d, count));
+      },
+      size);
+}
+
+template <typename scalar_t, typename MapOp, typename ReduceOp,
+          enable_if_bfloat16_float_op_t<scalar_t, MapOp> = 0>
+inline float map_reduce_all(
+    const MapOp& map_fun,
+    const ReduceOp& red_fun,
+    const scalar_t* data,
+    int64_t size) {
+  using fVec = Vec256<float>;
+  return bfloat16_reduce_all(
+      red_fun,
+      [&map_fun, data](int64_t d, int64_t count) {
+        fVec data_fvec0, data_fvec1;
+        std::tie(data_fvec0, data_fvec1) =
+            convert_bfloat16_float(load_bfloat16(data + d, count));
+        return std::make_tuple(map_fun(data_fvec0), map_fun(data_fvec1));
+      },
+      size);
+}
+
+template <typename scalar_t, typename MapOp, typename ReduceOp,
+          enable_if_bfloat16_float_op_t<scalar_t, MapOp> = 0>
+inline float map2_reduce_all(
+    const MapOp& map_fun,
+    const ReduceOp& red_fun,
+    const scalar_t* data,
+    const scalar_t* data2,
+    int64_t size) {
+  using fVec = Vec256<float>;
+  return bfloat16_reduce_all(
+      red_fun,
+      [&map_fun, data, data2](int64_t d, int64_t count) {
+        fVec data_fvec0, data_fvec1;
+        std::tie(data_fvec0, data_fvec1) =
+            convert_bfloat16_float(load_bfloat16(data + d, count));
+        fVec data2_fvec0, data2_fvec1;
+        std::tie(data2_fvec0, data2_fvec1) =
+            convert_bfloat16_float(load_bfloat16(data2 + d, count));
+        return std::make_tuple(
+            map_fun(data_fvec0, data2_fvec0), map_fun(data_fvec1, data2_fvec1));
+      },
+      size);
+}
+
+template <typename scalar_t, typename MapOp, typename ReduceOp,
+          enable_if_bfloat16_float_op_t<scalar_t, MapOp> = 0>
+inline float map3_reduce_all(
+    const MapOp& map_fun,
+    const ReduceOp& red_fun,
+    const scalar_t* data,
+    const scalar_t* data2,
+    const scalar_t* data3,
+    int64_t size) {
+  using fVec = Vec256<float>;
+  return bfloat16_reduce_all(
+      red_fun,
+      [&map_fun, data, data2, data3](int64_t d, int64_t count) {
+        fVec data_fvec0, data_fvec1;
+        std::tie(data_fvec0, data_fvec1) =
+            convert_bfloat16_float(load_bfloat16(data + d, count));
+        fVec data2_fvec0, data2_fvec1;
+        std::tie(data2_fvec0, data2_fvec1) =
+            convert_bfloat16_float(load_bfloat16(data2 + d, count));
+        fVec data3_fvec0, data3_fvec1;
+        std::tie(data3_fvec0, data3_fvec1) =
+            convert_bfloat16_float(load_bfloat16(data3 + d, count));
+        return std::make_tuple(
+            map_fun(data_fvec0, data2_fvec0, data3_fvec0),
+            map_fun(data_fvec1, data2_fvec1, data3_fvec1));
+      },
+      size);
+}
+
+template <typename scalar_t, typename Op,
+          enable_if_bfloat16_float_op_t<scalar_t, Op> = 0>
+inline void map(
+    const Op& vec_fun,
+    scalar_t* output_data,
+    const scalar_t* input_data,
+    int64_t size) {
+  using bVec = Vec256<BFloat16>;
+  using fVec = Vec256<float>;
+  for (int64_t d = 0; d < size; d += bVec::size()) {
+    const int64_t count = std::min<int64_t>(size - d, bVec::size());
+    fVec data_fvec0, data_fvec1;
+    std::tie(data_fvec0, data_fvec1) =
+        convert_bfloat16_float(load_bfloat16(input_data + d, count));
+    bVec output_bvec =
+        convert_float_bfloat16(vec_fun(data_fvec0), vec_fun(data_fvec1));
+    output_bvec.store(output_data + d, count);
+  }
+}
+
+template <typename scalar_t, typename Op,
+          enable_if_bfloat16_float_op_t<scalar_t, Op> = 0>
+inline void map2(
+    const Op& vec_fun,
+    scalar_t* output_data,
+    const scalar_t* input_data,
+    const scalar_t* input_data2,
+    int64_t size) {
+  using bVec = Vec256<BFloat16>;
+  using fVec = Vec256<float>;
+  for (int64_t d = 0; d < size; d += bVec::size()) {
+    const int64_t count = std::min<int64_t>(size - d, bVec::size());
+    fVec data_fvec0, data_fvec1;
+    std::tie(data_fvec0, data_fvec1) =
+        convert_bfloat16_float(load_bfloat16(input_data + d, count));
+    fVec data2_fvec0, data2_fvec1;
+    std::tie(data2_fvec0, data2_fvec1) =
+        convert_bfloat16_float(load_bfloat16(input_data2 + d, count));
+    bVec output_bvec = convert_float_bfloat16(
+        vec_fun(data_fvec0, data2_fvec0), vec_fun(data_fvec1, data2_fvec1));
+    output_bvec.store(output_data + d, count);
+  }
+}
+
+template <typename scalar_t, typename Op,
+          enable_if_bfloat16_float_op_t<scalar_t, Op> = 0>
+inline void map3(
+    const Op& vec_fun,
+    scalar_t* output_data,
+    const scalar_t* input_data1,
+    const scalar_t* input_data2,
+    const scalar_t* input_data3,
+    int64_t size) {
+  using bVec = Vec256<BFloat16>;
+  using fVec = Vec256<float>;
+  for (int64_t d = 0; d < size; d += bVec::size()) {
+    const int64_t count = std::min<int64_t>(size - d, bVec::size());
+    fVec data1_fvec0, data1_fvec1;
+    std::tie(data1_fvec0, data1_fvec1) =
+        convert_bfloat16_float(load_bfloat16(input_data1 + d, count));
+    fVec data2_fvec0, data2_fvec1;
+    std::tie(data2_fvec0, data2_fvec1) =
+        convert_bfloat16_float(load_bfloat16(input_data2 + d, count));
+    fVec data3_fvec0, data3_fvec1;
+    std::tie(data3_fvec0, data3_fvec1) =
+        convert_bfloat16_float(load_bfloat16(input_data3 + d, count));
+    bVec output_bvec = convert_float_bfloat16(
+        vec_fun(data1_fvec0, data2_fvec0, data3_fvec0),
+        vec_fun(data1_fvec1, data2_fvec1, data3_fvec1));
+    output_bvec.store(output_data + d, count);
+  }
+}
+
+// Variants accumulating BFloat16 inputs into a float buffer, e.g.
+// map2<BFloat16>(op, acc, acc, bf16_data, size)
+template <typename scalar_t, typename Op,
+          typename std::enable_if<std::is_same<scalar_t, BFloat16>::value, int>::type = 0>
+inline void map2(
+    const Op& vec_fun,
+    float* output_data,
+    const float* input_data,
+    const scalar_t* input_data2,
+    int64_t size) {
+  using bVec = Vec256<BFloat16>;
+  using fVec = Vec256<float>;
+  for (int64_t d = 0; d < size; d += bVec::size()) {
+    const int64_t count = std::min<int64_t>(size - d, bVec::size());
+    fVec data_fvec0, data_fvec1;
+    std::tie(data_fvec0, data_fvec1) = load_float2(input_data + d, count);
+    fVec data2_fvec0, data2_fvec1;
+    std::tie(data2_fvec0, data2_fvec1) =
+        convert_bfloat16_float(load_bfloat16(input_data2 + d, count));
+    store_float2(
+        output_data + d,
+        vec_fun(data_fvec0, data2_fvec0),
+        vec_fun(data_fvec1, data2_fvec1),
+        count);
+  }
+}
+
+template <typename scalar_t, typename Op,
+          typename std::enable_if<std::is_same<scalar_t, BFloat16>::value, int>::type = 0>
+inline void map3(
+    const Op& vec_fun,
+    float* output_data,
+    const float* input_data1,
+    const scalar_t* input_data2,
+    const scalar_t* input_data3,
+    int64_t size) {
+  using bVec = Vec256<BFloat16>;
+  using fVec = Vec256<float>;
+  for (int64_t d = 0; d < size; d += bVec::size()) {
+    const int64_t count = std::min<int64_t>(size - d, bVec::size());
+    fVec data1_fvec0, data1_fvec1;
+    std::tie(data1_fvec0, data1_fvec1) = load_float2(input_data1 + d, count);
+    fVec data2_fvec0, data2_fvec1;
+    std::tie(data2_fvec0, data2_fvec1) =
+        convert_bfloat16_float(load_bfloat16(input_data2 + d, count));
+    fVec data3_fvec0, data3_fvec1;
+    std::tie(data3_fvec0, data3_fvec1) =
+        convert_bfloat16_float(load_bfloat16(input_data3 + d, count));
+    store_float2(
+        output_data + d,
+        vec_fun(data1_fvec0, data2_fvec0, data3_fvec0),
+        vec_fun(data1_fvec1, data2_fvec1, data3_fvec1),
+        count);
+  }
+}
+
+}} // namespace at::vec256
@@ -5,16 +5,18 @@
 
 #include <ATen/cpu/vec256/intrinsics.h>
 #include <ATen/cpu/vec256/vec256_base.h>
-#if defined(CPU_CAPABILITY_AVX2) && !defined(_MSC_VER)
+#if (defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)) && !defined(_MSC_VER)
 #include <sleef.h>
 #endif
 
+#include <tuple>
+
 namespace at {
 namespace vec256 {
 // See Note [Acceptable use of anonymous namespace in header]
 namespace {
 
-#if defined(CPU_CAPABILITY_AVX2) && !defined(_MSC_VER)
+#if (defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)) && !defined(_MSC_VER)
 
 static inline void cvtbf16_fp32(const __m256i& a, __m256& o1, __m256& o2) {
   __m128i lo = _mm256_extractf128_si256(a, 0);
@@ -23,6 +25,12 @@ static inline void cvtbf16_fp32(const __m256i& a, __m256& o1, __m256& o2) {
   o2 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(hi), 16));
 }
 static inline __m256i cvtfp32_bf16(const __m256& a, const __m256& b) {
+#if defined(__AVX512BF16__) && defined(__AVX512DQ__)
+  // vcvtneps2bf16 also rounds to nearest even, but it keeps the payload of
+  // NaNs instead of returning 0xffff and treats denormal inputs as zero.
+  __m512 ab = _mm512_insertf32x8(_mm512_castps256_ps512(a), b, 1);
+  return (__m256i)_mm512_cvtneps_pbh(ab);
+#else
   __m256i lo = _mm256_castps_si256(a);
   __m256i hi = _mm256_castps_si256(b);
   __m256i nan = _mm256_set1_epi32(0xffff);
@@ -48,6 +56,7 @@ static inline __m256i cvtfp32_bf16(const __m256& a, const __m256& b) {
 
   t_lo = _mm256_packus_epi32(t_lo, t_hi);      // t_hi[4-7] t_lo[4-7] t_hi[0-4] t_lo[0-4]
   return _mm256_permute4x64_epi64(t_lo, 0xd8); // 11        01        10        00
+#endif
 }
 
 template <> class Vec256<BFloat16> {
@@ -195,12 +204,8 @@ public:
     return cvtfp32_bf16(o1, o2);
   }
   Vec256<BFloat16> abs() const {
-    __m256 lo, hi;
-    cvtbf16_fp32(values, lo, hi);
-    auto mask = _mm256_set1_ps(-0.f);
-    auto o1 = _mm256_andnot_ps(mask, lo);
-    auto o2 = _mm256_andnot_ps(mask, hi);
-    return cvtfp32_bf16(o1, o2);
+    // clears the sign bits, no need to convert to float
+    return _mm256_and_si256(values, _mm256_set1_epi16(0x7fff));
   }
   Vec256<BFloat16> angle() const {
     __m256 lo, hi;
@@ -385,12 +390,7 @@ public:
     return cvtfp32_bf16(o1, o2);
   }
   Vec256<BFloat16> neg() const {
-    __m256 lo, hi;
-    cvtbf16_fp32(values, lo, hi);
-    auto mask = _mm256_set1_ps(-0.f);
-    auto o1 = _mm256_xor_ps(mask, lo);
-    auto o2 = _mm256_xor_ps(mask, hi);
-    return cvtfp32_bf16(o1, o2);
+    return _mm256_xor_si256(values, _mm256_set1_epi16(static_cast<int16_t>(0x8000)));
   }
   Vec256<BFloat16> round() const {
     __m256 lo, hi;
@@ -657,6 +657,58 @@ Vec256<BFloat16> inline fmadd(const Vec256<BFloat16>& a,
   return cvtfp32_bf16(o1, o2);
 }
 
+// Every arithmetic op on Vec256<BFloat16> converts its inputs to float and
+// rounds the result back. Kernels evaluating longer expressions should
+// convert once with convert_bfloat16_float, compute on Vec256<float> and
+// round once with convert_float_bfloat16, which is both faster and more
+// accurate.
+inline std::tuple<Vec256<float>, Vec256<float>> convert_bfloat16_float(const Vec256<BFloat16>& a) {
+  __m256 o1, o2;
+  cvtbf16_fp32(__m256i(a), o1, o2);
+  return std::make_tuple(o1, o2);
+}
+
+inline Vec256<BFloat16> convert_float_bfloat16(const Vec256<float>& a, const Vec256<float>& b) {
+  return cvtfp32_bf16(__m256(a), __m256(b));
+}
+
+// Loads Vec256<float>::size() BFloat16 values
+inline void load_fp32_from_bf16(const c10::BFloat16* data, Vec256<float>& out) {
+  auto values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+  out = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(values), 16));
+}
+
+#else // (defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)) && !defined(_MSC_VER)
+
+inline std::tuple<Vec256<float>, Vec256<float>> convert_bfloat16_float(const Vec256<BFloat16>& a) {
+  constexpr int64_t K = Vec256<BFloat16>::size();
+  __at_align32__ float arr[K];
+  __at_align32__ BFloat16 arr2[K];
+  a.store(arr2);
+  convert(arr2, arr, K);
+  return std::make_tuple(
+      Vec256<float>::loadu(arr),
+      Vec256<float>::loadu(arr + Vec256<float>::size()));
+}
+
+inline Vec256<BFloat16> convert_float_bfloat16(const Vec256<float>& a, const Vec256<float>& b) {
+  constexpr int64_t K = Vec256<BFloat16>::size();
+  __at_align32__ float arr[K];
+  __at_align32__ BFloat16 arr2[K];
+  a.store(arr);
+  b.store(arr + Vec256<float>::size());
+  convert(arr, arr2, K);
+  return Vec256<BFloat16>::loadu(arr2);
+}
+
+inline void load_fp32_from_bf16(const c10::BFloat16* data, Vec256<float>& out) {
+  __at_align32__ float values[Vec256<float>::size()];
+  for (int64_t k = 0; k < Vec256<float>::size(); ++k) {
+    values[k] = data[k];
+  }
+  out = Vec256<float>::loadu(values);
+}
+
 #endif
 
 }}}
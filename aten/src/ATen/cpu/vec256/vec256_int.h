@@ -11,7 +11,7 @@ namespace at {
 namespace vec256 {
 namespace {
 
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
 
 struct Vec256i {
 protected:
@@ -35,7 +35,7 @@ struct Vec256i {};  // dummy definition to make Vec256i always defined
 
 #endif // CPU_CAPABILITY_AVX2
 
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
 
 template <>
 class Vec256<int64_t> : public Vec256i {
@@ -39,7 +39,7 @@ namespace at {
 namespace vec256 {
 namespace {
 
-#if (defined(CPU_CAPABILITY_AVX) || defined(CPU_CAPABILITY_AVX2)) && !defined(_MSC_VER)
+#if (defined(CPU_CAPABILITY_AVX) || defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)) && !defined(_MSC_VER)
 
 struct Vec256qi {
  protected:
@@ -53,7 +53,7 @@ struct Vec256qi {
   }
 };
 
-#if defined(CPU_CAPABILITY_AVX2)
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
 template <typename T>
 __m256i pack_saturate_and_clamp(
     __m256i first,
@@ -103,7 +103,7 @@ inline void __attribute__((always_inline)) QuantizeAvx2(
     int len,
     float inverse_scale,
     int64_t zero_point) {
-#if defined(CPU_CAPABILITY_AVX2)
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
   constexpr int VLEN = 8;
   constexpr auto min_val = std::numeric_limits<typename T::underlying>::min();
   constexpr auto max_val = std::numeric_limits<typename T::underlying>::max();
@@ -265,7 +265,7 @@ struct Vec256<c10::qint32> : public Vec256qi {
         Vec256<float> zero_point,
         Vec256<float> scale_zp_premul) const {
       __m256 float_vals = _mm256_cvtepi32_ps(vals);
-#if defined(CPU_CAPABILITY_AVX2)
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
       return {vec256::fmadd(scale, Vec256<float>(float_vals), scale_zp_premul)};
 #else
       return {scale * (Vec256<float>(float_vals) - zero_point)};
@@ -285,7 +285,7 @@ struct Vec256<c10::qint32> : public Vec256qi {
     }
 
     Vec256<c10::qint32> maximum(Vec256<c10::qint32> b) const {
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
       return _mm256_max_epi32(vals, b.vals);
 #else
       // Pray the compiler can autovectorize this
@@ -303,7 +303,7 @@ struct Vec256<c10::qint32> : public Vec256qi {
     }
 
     Vec256<c10::qint32> minimum(Vec256<c10::qint32> b) const {
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
       return _mm256_min_epi32(vals, b.vals);
 #else
       // Pray the compiler can autovectorize this
@@ -327,7 +327,7 @@ struct Vec256<c10::qint32> : public Vec256qi {
     Vec256<c10::qint32> relu6(
         Vec256<c10::qint32> zero_point,
         Vec256<c10::qint32> q_six) {
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
       return _mm256_min_epi32(
           _mm256_max_epi32(vals, zero_point.vals), q_six.vals);
 #else
@@ -349,7 +349,7 @@ struct Vec256<c10::qint32> : public Vec256qi {
     }
 
     int_vec_return_type widening_subtract(Vec256<c10::qint32> b) const {
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
       return {_mm256_sub_epi32(vals, b)};
 #else
       std::array<int32_t, size()> int_vals;
@@ -368,7 +368,7 @@ struct Vec256<c10::qint32> : public Vec256qi {
         const int_vec_return_type& inp,
         float multiplier,
         int32_t zero_point) {
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
       __m256 multiplier_v = _mm256_set1_ps(multiplier);
       __m256i zero_point_v = _mm256_set1_epi32(zero_point);
 
@@ -410,7 +410,7 @@ template <>
 Vec256<c10::qint32> inline operator*(
     const Vec256<c10::qint32>& a,
     const Vec256<c10::qint32>& b) {
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
   return _mm256_mullo_epi32(a, b);
 #else
   // Pray the compiler can autovectorize this
@@ -430,7 +430,7 @@ template <>
 Vec256<c10::qint32> inline operator+(
     const Vec256<c10::qint32>& a,
     const Vec256<c10::qint32>& b) {
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
   return _mm256_add_epi32(a, b);
 #else
   // Pray the compiler can autovectorize this
@@ -446,7 +446,7 @@ Vec256<c10::qint32> inline operator+(
 #endif
 }
 
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
 /*
  * Convert values from int32 back to int8/uint8
  */
@@ -542,7 +542,7 @@ struct Vec256<c10::qint8> : public Vec256qi {
 
  private:
     __m256i cvtepi8_epi32(__m128i epi8_vals) const {
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
         return _mm256_cvtepi8_epi32(epi8_vals);
 #else  // CPU_CAPABILITY_AVX2
         __m128i result_data[2];
@@ -574,7 +574,7 @@ struct Vec256<c10::qint8> : public Vec256qi {
     __m256 float_val2 = _mm256_cvtepi32_ps(cvtepi8_epi32(int_val2));
     __m256 float_val3 = _mm256_cvtepi32_ps(cvtepi8_epi32(int_val3));
 
-#if defined(CPU_CAPABILITY_AVX2)
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
     auto val0 =
         vec256::fmadd(scale, Vec256<float>(float_val0), scale_neg_zp_premul);
     auto val1 =
@@ -605,7 +605,7 @@ struct Vec256<c10::qint8> : public Vec256qi {
   }
 
   Vec256<c10::qint8> maximum(Vec256<c10::qint8> b) const {
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
       return _mm256_max_epi8(vals, b.vals);
 #else
       // Pray the compiler can autovectorize this
@@ -623,7 +623,7 @@ struct Vec256<c10::qint8> : public Vec256qi {
     }
 
   Vec256<c10::qint8> minimum(Vec256<c10::qint8> b) const {
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
       return _mm256_min_epi8(vals, b.vals);
 #else
       // Pray the compiler can autovectorize this
@@ -647,7 +647,7 @@ struct Vec256<c10::qint8> : public Vec256qi {
     Vec256<c10::qint8> relu6(
         Vec256<c10::qint8> zero_point,
         Vec256<c10::qint8> q_six) {
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
       return _mm256_min_epi8(
           _mm256_max_epi8(vals, zero_point.vals), q_six.vals);
 #else
@@ -669,7 +669,7 @@ struct Vec256<c10::qint8> : public Vec256qi {
     }
 
     int_vec_return_type widening_subtract(Vec256<c10::qint8> b) const {
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
       __m128i int_val0 = _mm_set1_epi64x(_mm256_extract_epi64(vals, 0));
       __m128i int_val1 = _mm_set1_epi64x(_mm256_extract_epi64(vals, 1));
       __m128i int_val2 = _mm_set1_epi64x(_mm256_extract_epi64(vals, 2));
@@ -724,7 +724,7 @@ struct Vec256<c10::qint8> : public Vec256qi {
         const int_vec_return_type& inp,
         float multiplier,
         int32_t zero_point) {
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
       __m256 multiplier_v = _mm256_set1_ps(multiplier);
       __m256i zero_point_v = _mm256_set1_epi32(zero_point);
       return RequantizeAvx2<value_type>(inp, multiplier_v, zero_point_v);
@@ -814,7 +814,7 @@ struct Vec256<c10::quint8> : public Vec256qi {
 
  private:
     __m256i cvtepu8_epi32(__m128i epu8_vals) const {
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
         return _mm256_cvtepu8_epi32(epu8_vals);
 #else  // CPU_CAPABILITY_AVX2
         __m128i result_data[2];
@@ -845,7 +845,7 @@ struct Vec256<c10::quint8> : public Vec256qi {
     __m256 float_val2 = _mm256_cvtepi32_ps(cvtepu8_epi32(int_val2));
     __m256 float_val3 = _mm256_cvtepi32_ps(cvtepu8_epi32(int_val3));
 
-#if defined(CPU_CAPABILITY_AVX2)
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
     auto val0 =
         vec256::fmadd(scale, Vec256<float>(float_val0), scale_zp_premul);
     auto val1 =
@@ -876,7 +876,7 @@ struct Vec256<c10::quint8> : public Vec256qi {
   }
 
   Vec256<c10::quint8> maximum(Vec256<c10::quint8> b) const {
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
       return _mm256_max_epu8(vals, b.vals);
 #else
       // Pray the compiler can autovectorize this
@@ -894,7 +894,7 @@ struct Vec256<c10::quint8> : public Vec256qi {
     }
 
   Vec256<c10::quint8> minimum(Vec256<c10::quint8> b) const {
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
       return _mm256_min_epu8(vals, b.vals);
 #else
       // Pray the compiler can autovectorize this
@@ -918,7 +918,7 @@ struct Vec256<c10::quint8> : public Vec256qi {
     Vec256<c10::quint8> relu6(
         Vec256<c10::quint8> zero_point,
         Vec256<c10::quint8> q_six) {
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
       return _mm256_min_epu8(
           _mm256_max_epu8(vals, zero_point.vals), q_six.vals);
 #else
@@ -940,7 +940,7 @@ struct Vec256<c10::quint8> : public Vec256qi {
     }
 
     int_vec_return_type widening_subtract(Vec256<c10::quint8> b) const {
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
       __m128i int_val0 = _mm_set1_epi64x(_mm256_extract_epi64(vals, 0));
       __m128i int_val1 = _mm_set1_epi64x(_mm256_extract_epi64(vals, 1));
       __m128i int_val2 = _mm_set1_epi64x(_mm256_extract_epi64(vals, 2));
@@ -994,7 +994,7 @@ struct Vec256<c10::quint8> : public Vec256qi {
         const int_vec_return_type& inp,
         float multiplier,
         int32_t zero_point) {
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
       __m256 multiplier_v = _mm256_set1_ps(multiplier);
       __m256i zero_point_v = _mm256_set1_epi32(zero_point);
       return RequantizeAvx2<value_type>(inp, multiplier_v, zero_point_v);
@@ -1494,6 +1494,6 @@ Vec256<c10::quint8> inline maximum(const Vec256<c10::quint8>& a, const Vec256<c1
   return a.maximum(b);
 }
 
-#endif // (defined(CPU_CAPABILITY_AVX) || defined(CPU_CAPABILITY_AVX2)) && !defined(_MSC_VER)
+#endif // (defined(CPU_CAPABILITY_AVX) || defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)) && !defined(_MSC_VER)
 
 }}}
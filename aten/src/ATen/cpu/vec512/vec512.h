@@ -0,0 +1,39 @@
+#pragma once
+
+// DO NOT DEFINE STATIC DATA IN THIS HEADER!
+// See Note [Do not compile initializers with AVX]
+
+#include <ATen/cpu/vec512/vec512_base.h>
+#include <ATen/cpu/vec512/vec512_float.h>
+#include <ATen/cpu/vec512/vec512_double.h>
+
+namespace at {
+namespace vec256 {
+// See Note [Acceptable use of anonymous namespace in header]
+namespace {
+
+// Vectorized<T> is the widest vector type for T in the CPU capability the
+// code is compiled for: Vec512<T> for the types that have AVX512
+// specializations when compiling for AVX512, Vec256<T> otherwise. Kernels
+// that use it get twice as many lanes on AVX512 machines without any change.
+template <typename T>
+struct vectorized_type {
+  using type = Vec256<T>;
+};
+
+#if defined(CPU_CAPABILITY_AVX512) && !defined(_MSC_VER)
+template <>
+struct vectorized_type<float> {
+  using type = Vec512<float>;
+};
+
+template <>
+struct vectorized_type<double> {
+  using type = Vec512<double>;
+};
+#endif
+
+template <typename T>
+using Vectorized = typename vectorized_type<T>::type;
+
+}}}
@@ -0,0 +1,70 @@
+#pragma once
+
+// DO NOT DEFINE STATIC DATA IN THIS HEADER!
+// See Note [Do not compile initializers with AVX]
+
+#include <ATen/cpu/vec256/vec256_base.h>
+
+#include <ostream>
+
+#if defined(__GNUC__)
+#define __at_align64__ __attribute__((aligned(64)))
+#elif defined(_WIN32)
+#define __at_align64__ __declspec(align(64))
+#else
+#define __at_align64__
+#endif
+
+namespace at {
+namespace vec256 {
+// See Note [Acceptable use of anonymous namespace in header]
+namespace {
+
+// 512-bit vectors for the AVX512 CPU capability. Unlike Vec256 there is no
+// generic implementation: Vec512 is only specialized for the types that have
+// AVX512 kernels, and only in code compiled for that capability. Kernels
+// don't name it directly, they use Vectorized<T> (see vec512.h), which falls
+// back to Vec256<T> everywhere else.
+//
+// The specializations have the same interface as Vec256<T>, so that code
+// written against Vectorized<T> compiles with either width. They live in the
+// vec256 namespace with Vec256 for the same reason.
+template <class T> class Vec512;
+
+template <typename T>
+inline Vec512<T>& operator += (Vec512<T>& a, const Vec512<T>& b) {
+  a = a + b;
+  return a;
+}
+template <typename T>
+inline Vec512<T>& operator -= (Vec512<T>& a, const Vec512<T>& b) {
+  a = a - b;
+  return a;
+}
+template <typename T>
+inline Vec512<T>& operator /= (Vec512<T>& a, const Vec512<T>& b) {
+  a = a / b;
+  return a;
+}
+template <typename T>
+inline Vec512<T>& operator *= (Vec512<T>& a, const Vec512<T>& b) {
+  a = a * b;
+  return a;
+}
+
+template <typename T>
+std::ostream& operator<<(std::ostream& stream, const Vec512<T>& vec) {
+  T buf[Vec512<T>::size()];
+  vec.store(buf);
+  stream << "vec[";
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    if (i != 0) {
+      stream << ", ";
+    }
+    stream << buf[i];
+  }
+  stream << "]";
+  return stream;
+}
+
+}}}
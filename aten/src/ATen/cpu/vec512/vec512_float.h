@@ -0,0 +1,405 @@
+#pragma once
+
+// DO NOT DEFINE STATIC DATA IN THIS HEADER!
+// See Note [Do not compile initializers with AVX]
+
+#include <ATen/cpu/vec256/intrinsics.h>
+#include <ATen/cpu/vec512/vec512_base.h>
+#if defined(CPU_CAPABILITY_AVX512) && !defined(_MSC_VER)
+#include <sleef.h>
+#endif
+
+namespace at {
+namespace vec256 {
+// See Note [Acceptable use of anonymous namespace in header]
+namespace {
+
+#if defined(CPU_CAPABILITY_AVX512) && !defined(_MSC_VER)
+
+template <> class Vec512<float> {
+private:
+  __m512 values;
+  static __mmask16 count_mask(int64_t count) {
+    return static_cast<__mmask16>((1ULL << count) - 1);
+  }
+  static Vec512<float> from_mask(__mmask16 mask) {
+    return _mm512_castsi512_ps(
+        _mm512_mask_set1_epi32(_mm512_setzero_si512(), mask, 0xFFFFFFFF));
+  }
+public:
+  using value_type = float;
+  static constexpr int size() {
+    return 16;
+  }
+  Vec512() {}
+  Vec512(__m512 v) : values(v) {}
+  Vec512(float val) {
+    values = _mm512_set1_ps(val);
+  }
+  Vec512(float val1, float val2, float val3, float val4,
+         float val5, float val6, float val7, float val8,
+         float val9, float val10, float val11, float val12,
+         float val13, float val14, float val15, float val16) {
+    values = _mm512_setr_ps(val1, val2, val3, val4, val5, val6, val7, val8,
+                            val9, val10, val11, val12, val13, val14, val15, val16);
+  }
+  operator __m512() const {
+    return values;
+  }
+  template <int64_t mask>
+  static Vec512<float> blend(const Vec512<float>& a, const Vec512<float>& b) {
+    return _mm512_mask_blend_ps(static_cast<__mmask16>(mask), a.values, b.values);
+  }
+  static Vec512<float> blendv(const Vec512<float>& a, const Vec512<float>& b,
+                              const Vec512<float>& mask) {
+    // like _mm256_blendv_ps, select by the sign bit of the mask lanes
+    auto mask_bits = _mm512_cmp_epi32_mask(
+        _mm512_castps_si512(mask.values), _mm512_setzero_si512(), _MM_CMPINT_LT);
+    return _mm512_mask_blend_ps(mask_bits, a.values, b.values);
+  }
+  template<typename step_t>
+  static Vec512<float> arange(float base = 0.f, step_t step = static_cast<step_t>(1)) {
+    return Vec512<float>(
+      base,             base +      step, base +  2 * step, base +  3 * step,
+      base +  4 * step, base +  5 * step, base +  6 * step, base +  7 * step,
+      base +  8 * step, base +  9 * step, base + 10 * step, base + 11 * step,
+      base + 12 * step, base + 13 * step, base + 14 * step, base + 15 * step);
+  }
+  static Vec512<float> set(const Vec512<float>& a, const Vec512<float>& b,
+                           int64_t count = size()) {
+    if (count >= size()) {
+      return b;
+    }
+    return _mm512_mask_blend_ps(count_mask(count), a.values, b.values);
+  }
+  static Vec512<float> loadu(const void* ptr, int64_t count = size()) {
+    if (count == size())
+      return _mm512_loadu_ps(reinterpret_cast<const float*>(ptr));
+    // masked out lanes are zeroed and never read, so this doesn't fault past
+    // the end of ptr
+    return _mm512_maskz_loadu_ps(count_mask(count), ptr);
+  }
+  void store(void* ptr, int64_t count = size()) const {
+    if (count == size()) {
+      _mm512_storeu_ps(reinterpret_cast<float*>(ptr), values);
+    } else if (count > 0) {
+      _mm512_mask_storeu_ps(ptr, count_mask(count), values);
+    }
+  }
+  const float& operator[](int idx) const  = delete;
+  float& operator[](int idx) = delete;
+  int zero_mask() const {
+    // returns an integer mask where all zero elements are translated to 1-bit and others are translated to 0-bit
+    return _mm512_cmp_ps_mask(values, _mm512_setzero_ps(), _CMP_EQ_OQ);
+  }
+  Vec512<float> map(float (*f)(float)) const {
+    __at_align64__ float tmp[size()];
+    store(tmp);
+    for (int64_t i = 0; i < size(); i++) {
+      tmp[i] = f(tmp[i]);
+    }
+    return loadu(tmp);
+  }
+  Vec512<float> abs() const {
+    return _mm512_abs_ps(values);
+  }
+  Vec512<float> angle() const {
+    const auto zero_vec = _mm512_setzero_ps();
+    const auto nan_mask = _mm512_cmp_ps_mask(values, values, _CMP_UNORD_Q);
+    const auto neg_mask = _mm512_cmp_ps_mask(values, zero_vec, _CMP_LT_OQ);
+    auto angle = _mm512_mask_blend_ps(neg_mask, zero_vec, _mm512_set1_ps(c10::pi<float>));
+    return _mm512_mask_blend_ps(nan_mask, angle, _mm512_set1_ps(NAN));
+  }
+  Vec512<float> real() const {
+    return *this;
+  }
+  Vec512<float> imag() const {
+    return _mm512_setzero_ps();
+  }
+  Vec512<float> conj() const {
+    return *this;
+  }
+  Vec512<float> acos() const {
+    return Vec512<float>(Sleef_acosf16_u10(values));
+  }
+  Vec512<float> asin() const {
+    return Vec512<float>(Sleef_asinf16_u10(values));
+  }
+  Vec512<float> atan() const {
+    return Vec512<float>(Sleef_atanf16_u10(values));
+  }
+  Vec512<float> atan2(const Vec512<float> &b) const {
+    return Vec512<float>(Sleef_atan2f16_u10(values, b));
+  }
+  Vec512<float> erf() const {
+    return Vec512<float>(Sleef_erff16_u10(values));
+  }
+  Vec512<float> erfc() const {
+    return Vec512<float>(Sleef_erfcf16_u15(values));
+  }
+  Vec512<float> erfinv() const {
+    return map(calc_erfinv);
+  }
+  Vec512<float> exp() const {
+    return Vec512<float>(Sleef_expf16_u10(values));
+  }
+  Vec512<float> expm1() const {
+    return Vec512<float>(Sleef_expm1f16_u10(values));
+  }
+  Vec512<float> fmod(const Vec512<float>& q) const {
+    return Vec512<float>(Sleef_fmodf16(values, q));
+  }
+  Vec512<float> log() const {
+    return Vec512<float>(Sleef_logf16_u10(values));
+  }
+  Vec512<float> log2() const {
+    return Vec512<float>(Sleef_log2f16_u10(values));
+  }
+  Vec512<float> log10() const {
+    return Vec512<float>(Sleef_log10f16_u10(values));
+  }
+  Vec512<float> log1p() const {
+    return Vec512<float>(Sleef_log1pf16_u10(values));
+  }
+  Vec512<float> frac() const;
+  Vec512<float> sin() const {
+    return Vec512<float>(Sleef_sinf16_u10(values));
+  }
+  Vec512<float> sinh() const {
+    return Vec512<float>(Sleef_sinhf16_u10(values));
+  }
+  Vec512<float> cos() const {
+    return Vec512<float>(Sleef_cosf16_u10(values));
+  }
+  Vec512<float> cosh() const {
+    return Vec512<float>(Sleef_coshf16_u10(values));
+  }
+  Vec512<float> ceil() const {
+    return _mm512_roundscale_ps(values, (_MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC));
+  }
+  Vec512<float> floor() const {
+    return _mm512_roundscale_ps(values, (_MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+  }
+  Vec512<float> hypot(const Vec512<float> &b) const {
+    return Vec512<float>(Sleef_hypotf16_u05(values, b));
+  }
+  Vec512<float> i0() const {
+    return map(calc_i0);
+  }
+  Vec512<float> igamma(const Vec512<float> &x) const {
+    __at_align64__ float tmp[size()];
+    __at_align64__ float tmp_x[size()];
+    store(tmp);
+    x.store(tmp_x);
+    for (int64_t i = 0; i < size(); i++) {
+      tmp[i] = calc_igamma(tmp[i], tmp_x[i]);
+    }
+    return loadu(tmp);
+  }
+  Vec512<float> igammac(const Vec512<float> &x) const {
+    __at_align64__ float tmp[size()];
+    __at_align64__ float tmp_x[size()];
+    store(tmp);
+    x.store(tmp_x);
+    for (int64_t i = 0; i < size(); i++) {
+      tmp[i] = calc_igammac(tmp[i], tmp_x[i]);
+    }
+    return loadu(tmp);
+  }
+  Vec512<float> neg() const {
+    return _mm512_xor_ps(_mm512_set1_ps(-0.f), values);
+  }
+  Vec512<float> nextafter(const Vec512<float> &b) const {
+    return Vec512<float>(Sleef_nextafterf16(values, b));
+  }
+  Vec512<float> round() const {
+    return _mm512_roundscale_ps(values, (_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+  }
+  Vec512<float> tan() const {
+    return Vec512<float>(Sleef_tanf16_u10(values));
+  }
+  Vec512<float> tanh() const {
+    return Vec512<float>(Sleef_tanhf16_u10(values));
+  }
+  Vec512<float> trunc() const {
+    return _mm512_roundscale_ps(values, (_MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+  }
+  Vec512<float> lgamma() const {
+    return Vec512<float>(Sleef_lgammaf16_u10(values));
+  }
+  Vec512<float> sqrt() const {
+    return _mm512_sqrt_ps(values);
+  }
+  Vec512<float> reciprocal() const {
+    return _mm512_div_ps(_mm512_set1_ps(1), values);
+  }
+  Vec512<float> rsqrt() const {
+    return _mm512_div_ps(_mm512_set1_ps(1), _mm512_sqrt_ps(values));
+  }
+  Vec512<float> pow(const Vec512<float> &b) const {
+    return Vec512<float>(Sleef_powf16_u10(values, b));
+  }
+  // Comparisons return all ones in the lanes where they hold, like Vec256.
+  // They use the _CMP_**_OQ predicates.
+  //   `O`: get false if an operand is NaN
+  //   `Q`: do not raise if an operand is NaN
+  Vec512<float> operator==(const Vec512<float>& other) const {
+    return from_mask(_mm512_cmp_ps_mask(values, other.values, _CMP_EQ_OQ));
+  }
+
+  Vec512<float> operator!=(const Vec512<float>& other) const {
+    return from_mask(_mm512_cmp_ps_mask(values, other.values, _CMP_NEQ_UQ));
+  }
+
+  Vec512<float> operator<(const Vec512<float>& other) const {
+    return from_mask(_mm512_cmp_ps_mask(values, other.values, _CMP_LT_OQ));
+  }
+
+  Vec512<float> operator<=(const Vec512<float>& other) const {
+    return from_mask(_mm512_cmp_ps_mask(values, other.values, _CMP_LE_OQ));
+  }
+
+  Vec512<float> operator>(const Vec512<float>& other) const {
+    return from_mask(_mm512_cmp_ps_mask(values, other.values, _CMP_GT_OQ));
+  }
+
+  Vec512<float> operator>=(const Vec512<float>& other) const {
+    return from_mask(_mm512_cmp_ps_mask(values, other.values, _CMP_GE_OQ));
+  }
+
+  Vec512<float> eq(const Vec512<float>& other) const;
+  Vec512<float> ne(const Vec512<float>& other) const;
+  Vec512<float> gt(const Vec512<float>& other) const;
+  Vec512<float> ge(const Vec512<float>& other) const;
+  Vec512<float> lt(const Vec512<float>& other) const;
+  Vec512<float> le(const Vec512<float>& other) const;
+};
+
+Vec512<float> inline operator+(const Vec512<float>& a, const Vec512<float>& b) {
+  return _mm512_add_ps(a, b);
+}
+
+Vec512<float> inline operator-(const Vec512<float>& a, const Vec512<float>& b) {
+  return _mm512_sub_ps(a, b);
+}
+
+Vec512<float> inline operator*(const Vec512<float>& a, const Vec512<float>& b) {
+  return _mm512_mul_ps(a, b);
+}
+
+Vec512<float> inline operator/(const Vec512<float>& a, const Vec512<float>& b) {
+  return _mm512_div_ps(a, b);
+}
+
+// frac. Implement this here so we can use subtraction
+Vec512<float> Vec512<float>::frac() const {
+  return *this - this->trunc();
+}
+
+// Implements the IEEE 754 201X `maximum` operation, which propagates NaN if
+// either input is a NaN.
+Vec512<float> inline maximum(const Vec512<float>& a, const Vec512<float>& b) {
+  auto max = _mm512_max_ps(a, b);
+  auto isnan = _mm512_cmp_ps_mask(a, b, _CMP_UNORD_Q);
+  // all ones is a NaN, same as Vec256
+  return _mm512_mask_blend_ps(isnan, max, _mm512_castsi512_ps(_mm512_set1_epi32(-1)));
+}
+
+// Implements the IEEE 754 201X `minimum` operation, which propagates NaN if
+// either input is a NaN.
+Vec512<float> inline minimum(const Vec512<float>& a, const Vec512<float>& b) {
+  auto min = _mm512_min_ps(a, b);
+  auto isnan = _mm512_cmp_ps_mask(a, b, _CMP_UNORD_Q);
+  return _mm512_mask_blend_ps(isnan, min, _mm512_castsi512_ps(_mm512_set1_epi32(-1)));
+}
+
+Vec512<float> inline clamp(const Vec512<float>& a, const Vec512<float>& min, const Vec512<float>& max) {
+  return _mm512_min_ps(max, _mm512_max_ps(min, a));
+}
+
+Vec512<float> inline clamp_max(const Vec512<float>& a, const Vec512<float>& max) {
+  return _mm512_min_ps(max, a);
+}
+
+Vec512<float> inline clamp_min(const Vec512<float>& a, const Vec512<float>& min) {
+  return _mm512_max_ps(min, a);
+}
+
+Vec512<float> inline operator&(const Vec512<float>& a, const Vec512<float>& b) {
+  return _mm512_and_ps(a, b);
+}
+
+Vec512<float> inline operator|(const Vec512<float>& a, const Vec512<float>& b) {
+  return _mm512_or_ps(a, b);
+}
+
+Vec512<float> inline operator^(const Vec512<float>& a, const Vec512<float>& b) {
+  return _mm512_xor_ps(a, b);
+}
+
+Vec512<float> Vec512<float>::eq(const Vec512<float>& other) const {
+  return (*this == other) & Vec512<float>(1.0f);
+}
+
+Vec512<float> Vec512<float>::ne(const Vec512<float>& other) const {
+  return (*this != other) & Vec512<float>(1.0f);
+}
+
+Vec512<float> Vec512<float>::gt(const Vec512<float>& other) const {
+  return (*this > other) & Vec512<float>(1.0f);
+}
+
+Vec512<float> Vec512<float>::ge(const Vec512<float>& other) const {
+  return (*this >= other) & Vec512<float>(1.0f);
+}
+
+Vec512<float> Vec512<float>::lt(const Vec512<float>& other) const {
+  return (*this < other) & Vec512<float>(1.0f);
+}
+
+Vec512<float> Vec512<float>::le(const Vec512<float>& other) const {
+  return (*this <= other) & Vec512<float>(1.0f);
+}
+
+Vec512<float> inline fmadd(const Vec512<float>& a, const Vec512<float>& b, const Vec512<float>& c) {
+  return _mm512_fmadd_ps(a, b, c);
+}
+
+
+// Same layout as interleave2 and deinterleave2 for Vec256, see vec256.h
+std::pair<Vec512<float>, Vec512<float>>
+inline interleave2(const Vec512<float>& a, const Vec512<float>& b) {
+  // inputs:
+  //   a = {a0, a1, a2, ..., a15}
+  //   b = {b0, b1, b2, ..., b15}
+  // outputs:
+  //   {a0, b0, a1, b1, ..., a7, b7}
+  //   {a8, b8, a9, b9, ..., a15, b15}
+  // index bit 4 selects b
+  const __m512i lo_idx = _mm512_setr_epi32(0, 16, 1, 17, 2, 18, 3, 19,
+                                           4, 20, 5, 21, 6, 22, 7, 23);
+  const __m512i hi_idx = _mm512_setr_epi32(8, 24, 9, 25, 10, 26, 11, 27,
+                                           12, 28, 13, 29, 14, 30, 15, 31);
+  return std::make_pair(_mm512_permutex2var_ps(a, lo_idx, b),
+                        _mm512_permutex2var_ps(a, hi_idx, b));
+}
+
+std::pair<Vec512<float>, Vec512<float>>
+inline deinterleave2(const Vec512<float>& a, const Vec512<float>& b) {
+  // inputs:
+  //   a = {a0, b0, a1, b1, ..., a7, b7}
+  //   b = {a8, b8, a9, b9, ..., a15, b15}
+  // outputs:
+  //   {a0, a1, a2, ..., a15}
+  //   {b0, b1, b2, ..., b15}
+  const __m512i even_idx = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14,
+                                             16, 18, 20, 22, 24, 26, 28, 30);
+  const __m512i odd_idx = _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15,
+                                            17, 19, 21, 23, 25, 27, 29, 31);
+  return std::make_pair(_mm512_permutex2var_ps(a, even_idx, b),
+                        _mm512_permutex2var_ps(a, odd_idx, b));
+}
+
+#endif
+
+}}}
@@ -30,7 +30,7 @@ CUDAGraph::CUDAGraph()
 #endif
 }
 
-void CUDAGraph::capture_begin() {
+void CUDAGraph::capture_begin(c10::cuda::CUDACachingAllocator::MempoolId_t pool) {
 #if CUDA_VERSION >= 11000
   TORCH_CHECK(!has_graph_exec_,
               "This CUDAGraph instance already owns a captured graph. "
@@ -68,6 +68,15 @@ void CUDAGraph::capture_begin() {
   cudaStreamCaptureStatus status;
   AT_CUDA_CHECK(cudaStreamGetCaptureInfo(stream, &status, &id_));
   TORCH_INTERNAL_ASSERT(status == cudaStreamCaptureStatus::cudaStreamCaptureStatusActive);
+
+  // Serves the allocations made during capture from a private pool, so that
+  // memory the graph reads or writes on replay is never handed out to tensors
+  // created outside of it. The graph keeps a reference to the pool until reset.
+  capture_dev_ = c10::cuda::current_device();
+  mempool_id_ = pool != 0 ? pool : c10::cuda::CUDACachingAllocator::createPoolId();
+  c10::cuda::CUDACachingAllocator::retainPool(capture_dev_, mempool_id_);
+  c10::cuda::CUDACachingAllocator::beginAllocateToPool(
+      capture_dev_, mempool_id_, capture_stream_);
 #else
   TORCH_CHECK(false, "CUDA graphs may only be used in Pytorch built with CUDA >= 11.0");
 #endif
@@ -80,7 +89,9 @@ void CUDAGraph::capture_end() {
   TORCH_CHECK(stream == capture_stream_,
               "Capture must end on the same stream it began on.");
 
-  AT_CUDA_CHECK(cudaStreamEndCapture(capture_stream_, &graph_));
+  cudaError_t err = cudaStreamEndCapture(capture_stream_, &graph_);
+  c10::cuda::CUDACachingAllocator::endAllocateToPool(capture_dev_, capture_stream_);
+  AT_CUDA_CHECK(err);
   TORCH_CHECK(graph_ != NULL, "Invalid capture.");
   has_graph_ = true;
 
@@ -155,11 +166,27 @@ void CUDAGraph::reset() {
   if (has_graph_exec_) {
     C10_CUDA_CHECK_WARN(cudaGraphExecDestroy(graph_exec_));
   }
+  if (mempool_id_ != 0) {
+    // The pool's memory is returned to the driver by the next emptyCache or
+    // OOM retry once no other graph uses it.
+    try {
+      c10::cuda::CUDACachingAllocator::releasePool(capture_dev_, mempool_id_);
+    } catch (const c10::Error& e) {
+      TORCH_WARN("Failed to release the private memory pool of a CUDA graph: ", e.what_without_backtrace());
+    }
+    mempool_id_ = 0;
+  }
 #else
   TORCH_CHECK(false, "CUDA graphs may only be used in Pytorch built with CUDA >= 11.0");
 #endif
 }
 
+c10::cuda::CUDACachingAllocator::MempoolId_t CUDAGraph::pool() {
+  TORCH_CHECK(mempool_id_ != 0,
+              "Called CUDAGraph::pool() without a preceding capture_begin.");
+  return mempool_id_;
+}
+
 CUDAGraph::~CUDAGraph() {
   reset();
 }
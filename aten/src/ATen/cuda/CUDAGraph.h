@@ -1,5 +1,6 @@
 #include <ATen/Tensor.h>
 #include <c10/core/Device.h>
+#include <c10/cuda/CUDACachingAllocator.h>
 #include <c10/cuda/CUDAStream.h>
 #include <ATen/CUDAGeneratorImpl.h>
 
@@ -10,10 +11,14 @@ struct TORCH_CUDA_CPP_API CUDAGraph {
   CUDAGraph();
   ~CUDAGraph();
 
-  void capture_begin();
+  // Allocations made during capture come from the private pool given, or a
+  // new one if pool is 0. Graphs may share a pool if they are replayed in the
+  // order they were captured.
+  void capture_begin(c10::cuda::CUDACachingAllocator::MempoolId_t pool = 0);
   void capture_end();
   void replay();
   void reset();
+  c10::cuda::CUDACachingAllocator::MempoolId_t pool();
 
   protected:
 #if CUDA_VERSION >= 11000
@@ -31,6 +36,12 @@ struct TORCH_CUDA_CPP_API CUDAGraph {
   // Stream on which capture began
   at::cuda::CUDAStream capture_stream_;
 
+  // Device on which capture began
+  int capture_dev_;
+
+  // Private pool holding the memory the graph uses, 0 before capture_begin
+  c10::cuda::CUDACachingAllocator::MempoolId_t mempool_id_ = 0;
+
   // Default generator on device where capture began
   at::CUDAGeneratorImpl* capture_gen_;
 
@@ -335,6 +335,84 @@ void gesvdjBatched<c10::complex<double>>(
     lwork, info, params, batchSize));
 }
 
+template<>
+void syevjBatched<float>(
+    cusolverDnHandle_t handle, cusolverEigMode_t jobz, cublasFillMode_t uplo, int n, float* A, int lda, float* W,
+    int *info, syevjInfo_t params, int batchSize
+) {
+  int lwork;
+  TORCH_CUSOLVER_CHECK(cusolverDnSsyevjBatched_bufferSize(handle, jobz, uplo, n, A, lda, W, &lwork, params, batchSize));
+
+  auto& allocator = *::c10::cuda::CUDACachingAllocator::get();
+  auto dataPtr = allocator.allocate(sizeof(float)*lwork);
+
+  TORCH_CUSOLVER_CHECK(cusolverDnSsyevjBatched(
+    handle, jobz, uplo, n, A, lda, W,
+    static_cast<float*>(dataPtr.get()),
+    lwork, info, params, batchSize));
+}
+
+template<>
+void syevjBatched<double>(
+    cusolverDnHandle_t handle, cusolverEigMode_t jobz, cublasFillMode_t uplo, int n, double* A, int lda, double* W,
+    int *info, syevjInfo_t params, int batchSize
+) {
+  int lwork;
+  TORCH_CUSOLVER_CHECK(cusolverDnDsyevjBatched_bufferSize(handle, jobz, uplo, n, A, lda, W, &lwork, params, batchSize));
+
+  auto& allocator = *::c10::cuda::CUDACachingAllocator::get();
+  auto dataPtr = allocator.allocate(sizeof(double)*lwork);
+
+  TORCH_CUSOLVER_CHECK(cusolverDnDsyevjBatched(
+    handle, jobz, uplo, n, A, lda, W,
+    static_cast<double*>(dataPtr.get()),
+    lwork, info, params, batchSize));
+}
+
+template<>
+void syevjBatched<c10::complex<float>>(
+    cusolverDnHandle_t handle, cusolverEigMode_t jobz, cublasFillMode_t uplo, int n, c10::complex<float>* A, int lda, float* W,
+    int *info, syevjInfo_t params, int batchSize
+) {
+  int lwork;
+  TORCH_CUSOLVER_CHECK(cusolverDnCheevjBatched_bufferSize(
+    handle, jobz, uplo, n,
+    reinterpret_cast<cuComplex*>(A),
+    lda, W, &lwork, params, batchSize));
+
+  auto& allocator = *::c10::cuda::CUDACachingAllocator::get();
+  auto dataPtr = allocator.allocate(sizeof(cuComplex)*lwork);
+
+  TORCH_CUSOLVER_CHECK(cusolverDnCheevjBatched(
+    handle, jobz, uplo, n,
+    reinterpret_cast<cuComplex*>(A),
+    lda, W,
+    static_cast<cuComplex*>(dataPtr.get()),
+    lwork, info, params, batchSize));
+}
+
+template<>
+void syevjBatched<c10::complex<double>>(
+    cusolverDnHandle_t handle, cusolverEigMode_t jobz, cublasFillMode_t uplo, int n, c10::complex<double>* A, int lda, double* W,
+    int *info, syevjInfo_t params, int batchSize
+) {
+  int lwork;
+  TORCH_CUSOLVER_CHECK(cusolverDnZheevjBatched_bufferSize(
+    handle, jobz, uplo, n,
+    reinterpret_cast<cuDoubleComplex*>(A),
+    lda, W, &lwork, params, batchSize));
+
+  auto& allocator = *::c10::cuda::CUDACachingAllocator::get();
+  auto dataPtr = allocator.allocate(sizeof(cuDoubleComplex)*lwork);
+
+  TORCH_CUSOLVER_CHECK(cusolverDnZheevjBatched(
+    handle, jobz, uplo, n,
+    reinterpret_cast<cuDoubleComplex*>(A),
+    lda, W,
+    static_cast<cuDoubleComplex*>(dataPtr.get()),
+    lwork, info, params, batchSize));
+}
+
 } // namespace solver
 } // namespace cuda
 } // namespace at
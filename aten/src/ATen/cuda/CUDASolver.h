@@ -77,6 +77,23 @@ void gesvdjBatched<c10::complex<float>>(CUDASOLVER_GESVDJ_BATCHED_ARGTYPES(c10::
 template<>
 void gesvdjBatched<c10::complex<double>>(CUDASOLVER_GESVDJ_BATCHED_ARGTYPES(c10::complex<double>, double));
 
+#define CUDASOLVER_SYEVJ_BATCHED_ARGTYPES(Dtype, Vtype)  \
+    cusolverDnHandle_t handle, cusolverEigMode_t jobz, cublasFillMode_t uplo, int n, Dtype* A, int lda, Vtype* W, \
+    int *info, syevjInfo_t params, int batchSize
+
+template<class Dtype, class Vtype>
+void syevjBatched(CUDASOLVER_SYEVJ_BATCHED_ARGTYPES(Dtype, Vtype)) {
+  TORCH_INTERNAL_ASSERT(false, "at::cuda::solver::syevjBatched: not implemented for ", typeid(Dtype).name());
+}
+template<>
+void syevjBatched<float>(CUDASOLVER_SYEVJ_BATCHED_ARGTYPES(float, float));
+template<>
+void syevjBatched<double>(CUDASOLVER_SYEVJ_BATCHED_ARGTYPES(double, double));
+template<>
+void syevjBatched<c10::complex<float>>(CUDASOLVER_SYEVJ_BATCHED_ARGTYPES(c10::complex<float>, float));
+template<>
+void syevjBatched<c10::complex<double>>(CUDASOLVER_SYEVJ_BATCHED_ARGTYPES(c10::complex<double>, double));
+
 } // namespace solver
 } // namespace cuda
 } // namespace at
@@ -357,6 +357,22 @@ int64_t CUDAHooks::cuFFTGetPlanCacheSize(int64_t device_index) const {
 #endif
 }
 
+int64_t CUDAHooks::cuFFTGetPlanCacheHits(int64_t device_index) const {
+#ifndef __HIP_PLATFORM_HCC__
+  return at::native::detail::cufft_get_plan_cache_hits_impl(device_index);
+#else
+  AT_ERROR("cuFFT with HIP is not supported");
+#endif
+}
+
+int64_t CUDAHooks::cuFFTGetPlanCacheMisses(int64_t device_index) const {
+#ifndef __HIP_PLATFORM_HCC__
+  return at::native::detail::cufft_get_plan_cache_misses_impl(device_index);
+#else
+  AT_ERROR("cuFFT with HIP is not supported");
+#endif
+}
+
 void CUDAHooks::cuFFTClearPlanCache(int64_t device_index) const {
 #ifndef __HIP_PLATFORM_HCC__
   at::native::detail::cufft_clear_plan_cache_impl(device_index);
@@ -36,6 +36,8 @@ struct CUDAHooks : public at::CUDAHooksInterface {
   int64_t cuFFTGetPlanCacheMaxSize(int64_t device_index) const override;
   void cuFFTSetPlanCacheMaxSize(int64_t device_index, int64_t max_size) const override;
   int64_t cuFFTGetPlanCacheSize(int64_t device_index) const override;
+  int64_t cuFFTGetPlanCacheHits(int64_t device_index) const override;
+  int64_t cuFFTGetPlanCacheMisses(int64_t device_index) const override;
   void cuFFTClearPlanCache(int64_t device_index) const override;
   int getNumGPUs() const override;
   void deviceSynchronize(int64_t device_index) const override;
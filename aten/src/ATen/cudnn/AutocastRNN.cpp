@@ -67,9 +67,9 @@ _cudnn_rnn_cast_reflatten(const Tensor & input,
   }
   bool needs_cast_and_flatten = (weight_buf.defined() ?
                                  // weight_buf is valid.  Only change it if it's eligible and not already FP16.
-                                 is_eligible(weight_buf) && (weight_buf.scalar_type() != at::kHalf) :
+                                 is_eligible(weight_buf, DeviceType::CUDA) && (weight_buf.scalar_type() != at::kHalf) :
                                  // weight_buf is not valid.  Only create it if other weights are eligible and not already FP16.
-                                 is_eligible(weight[0]) && (weight[0].scalar_type() != at::kHalf));
+                                 is_eligible(weight[0], DeviceType::CUDA) && (weight[0].scalar_type() != at::kHalf));
   if (needs_cast_and_flatten) {
     // Casts weight tensors to FP16 and ensures all weights for all layers are views into a large flat buffer,
     // with the right locations and layouts expected by cudnn.
@@ -96,12 +96,12 @@ _cudnn_rnn_cast_reflatten(const Tensor & input,
             /*include_bias=*/include_bias);
   }
   return at::_cudnn_rnn(
-      cached_cast(at::kHalf, input),
+      cached_cast(at::kHalf, input, DeviceType::CUDA),
       needs_cast_and_flatten ? TensorList(redispatch_weight) : weight,
       weight_stride0,
       needs_cast_and_flatten ? redispatch_weight_buf : weight_buf,
-      cached_cast(at::kHalf, hx),
-      cached_cast(at::kHalf, cx),
+      cached_cast(at::kHalf, hx, DeviceType::CUDA),
+      cached_cast(at::kHalf, cx, DeviceType::CUDA),
       mode,
       hidden_size,
       proj_size,
@@ -8,6 +8,9 @@
 namespace at {
 namespace native {
 
+DEFINE_DISPATCH(avg_pool_channels_last_kernel);
+DEFINE_DISPATCH(avg_pool_channels_last_backward_kernel);
+
 namespace {
 
 template <typename scalar_t>
@@ -138,6 +141,13 @@ void avg_pool2d_out_cpu_template(
     inputHeight, inputWidth,
     outputHeight, outputWidth, input_.suggest_memory_format());
 
+  if (use_channels_last_pooling(input_)) {
+    output.resize_({nbatch, nInputPlane, outputHeight, outputWidth}, at::MemoryFormat::ChannelsLast);
+    PoolingWindow3D window{1, kH, kW, 1, dH, dW, 0, padH, padW, 1, 1, 1};
+    avg_pool_channels_last_kernel(kCPU, output, input_, window, count_include_pad, divisor_override);
+    return;
+  }
+
   if (input_.ndimension() == 3) {
     output.resize_({nInputPlane, outputHeight, outputWidth});
   }
@@ -295,6 +305,14 @@ Tensor& avg_pool2d_backward_out_cpu_template(
     outputHeight, outputWidth,
     input.suggest_memory_format());
 
+  if (use_channels_last_pooling(input)) {
+    gradInput.resize_(input.sizes(), at::MemoryFormat::ChannelsLast);
+    gradInput.zero_();
+    PoolingWindow3D window{1, kH, kW, 1, dH, dW, 0, padH, padW, 1, 1, 1};
+    avg_pool_channels_last_backward_kernel(kCPU, gradInput, gradOutput_, window, count_include_pad, divisor_override);
+    return gradInput;
+  }
+
   /* get contiguous gradOutput */
   const Tensor gradOutput = gradOutput_.contiguous();
 
@@ -163,6 +163,13 @@ void avg_pool3d_out_cpu_template(
     otime, oheight, owidth,
     /*check_input_size=*/ true);
 
+  if (use_channels_last_pooling(input_)) {
+    output.resize_({input_.size(0), nslices, otime, oheight, owidth}, at::MemoryFormat::ChannelsLast3d);
+    PoolingWindow3D window{kT, kH, kW, dT, dH, dW, padT, padH, padW, 1, 1, 1};
+    avg_pool_channels_last_kernel(kCPU, output, input_, window, count_include_pad, divisor_override);
+    return;
+  }
+
   /* get contiguous input */
   Tensor input = input_.contiguous();
 
@@ -350,12 +357,6 @@ Tensor& avg_pool3d_backward_out_cpu_template(
   const int64_t iheight = input.size(-2);
   const int64_t iwidth = input.size(-1);
 
-  /* get contiguous gradOutput */
-  Tensor gradOutput = gradOutput_.contiguous();
-
-  const int64_t otime = gradOutput.size(-3);
-  const int64_t oheight = gradOutput.size(-2);
-  const int64_t owidth = gradOutput.size(-1);
 
   /* XXX shape check behavior from TH */
   const int64_t otime_for_shape_check = pooling_output_shape<int64_t>(itime, kT, padT, dT, 1, ceil_mode);
@@ -372,6 +373,21 @@ Tensor& avg_pool3d_backward_out_cpu_template(
     itime, iheight, iwidth,
     otime_for_shape_check, oheight_for_shape_check, owidth_for_shape_check);
 
+  if (use_channels_last_pooling(input)) {
+    gradInput.resize_(input.sizes(), at::MemoryFormat::ChannelsLast3d);
+    gradInput.zero_();
+    PoolingWindow3D window{kT, kH, kW, dT, dH, dW, padT, padH, padW, 1, 1, 1};
+    avg_pool_channels_last_backward_kernel(kCPU, gradInput, gradOutput_, window, count_include_pad, divisor_override);
+    return gradInput;
+  }
+
+  /* get contiguous gradOutput */
+  Tensor gradOutput = gradOutput_.contiguous();
+
+  const int64_t otime = gradOutput.size(-3);
+  const int64_t oheight = gradOutput.size(-2);
+  const int64_t owidth = gradOutput.size(-1);
+
   /* resize */
   gradInput.resize_as_(input);
   gradInput.zero_();
@@ -14,6 +14,8 @@
 
 #include <TH/TH.h>  // for USE_LAPACK
 
+#include <algorithm>
+#include <type_traits>
 #include <vector>
 
 // First the required LAPACK implementations are registered here.
@@ -427,6 +429,146 @@ template<> void lapackLuSolve<float>(char trans, int n, int nrhs, float *a, int
 // Below of the definitions of the functions operating on a batch that are going to be dispatched
 // in the main helper functions for the linear algebra operations
 
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ small matrices ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/*
+Note [batched small matrix kernels]
+For batches of tiny matrices the per-matrix LAPACK call overhead dominates the
+cost of solve, inverse, cholesky, lu and lu_solve, and the batch loop runs on a
+single thread. For real square matrices of size at most kSmallMatrixMaxSize we
+instead use the unblocked algorithms below, instantiated for every size so that
+the compiler can fully unroll them, and split the batch across threads with
+at::parallel_for. They follow the reference LAPACK routines getf2, getrs and
+potf2, so the factorizations, pivots and info codes match what LAPACK reports up
+to rounding. Larger matrices keep the serial loop over LAPACK calls, as the
+LAPACK library may be multithreaded itself.
+*/
+constexpr int64_t kSmallMatrixMaxSize = 8;
+
+template <typename scalar_t>
+static inline bool use_small_matrix_kernels(int64_t n) {
+  return !c10::is_complex<scalar_t>::value && n >= 1 && n <= kSmallMatrixMaxSize;
+}
+
+// Calls f with std::integral_constant<int, n>, for 1 <= n <= kSmallMatrixMaxSize
+template <typename F>
+static inline void dispatch_small_matrix_size(int64_t n, const F& f) {
+  switch (n) {
+    case 1: f(std::integral_constant<int, 1>()); break;
+    case 2: f(std::integral_constant<int, 2>()); break;
+    case 3: f(std::integral_constant<int, 3>()); break;
+    case 4: f(std::integral_constant<int, 4>()); break;
+    case 5: f(std::integral_constant<int, 5>()); break;
+    case 6: f(std::integral_constant<int, 6>()); break;
+    case 7: f(std::integral_constant<int, 7>()); break;
+    case 8: f(std::integral_constant<int, 8>()); break;
+    default: TORCH_INTERNAL_ASSERT(false, "unexpected small matrix size ", n);
+  }
+}
+
+// Runs f(i) for every matrix i of the batch, splitting the batch across threads
+template <typename F>
+static inline void parallel_for_small_matrices(int64_t batch_size, int64_t n, const F& f) {
+  const int64_t grain_size = std::max<int64_t>(1, at::internal::GRAIN_SIZE / (n * n * n));
+  at::parallel_for(0, batch_size, grain_size, [&](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; i++) {
+      f(i);
+    }
+  });
+}
+
+// LU factorization with partial pivoting of the N x N column major matrix a,
+// like LAPACK's getf2. 'ipiv' is 1-based and 'info' is the 1-based index of
+// the first zero pivot, or 0.
+template <typename scalar_t, int N>
+static inline void small_lu(scalar_t* a, int* ipiv, int* info) {
+  *info = 0;
+  for (int j = 0; j < N; j++) {
+    int p = j;
+    scalar_t max_abs = std::abs(a[j + j * N]);
+    for (int i = j + 1; i < N; i++) {
+      if (std::abs(a[i + j * N]) > max_abs) {
+        max_abs = std::abs(a[i + j * N]);
+        p = i;
+      }
+    }
+    ipiv[j] = p + 1;
+    if (a[p + j * N] != scalar_t(0)) {
+      if (p != j) {
+        for (int k = 0; k < N; k++) {
+          std::swap(a[j + k * N], a[p + k * N]);
+        }
+      }
+      for (int i = j + 1; i < N; i++) {
+        a[i + j * N] /= a[j + j * N];
+      }
+    } else if (*info == 0) {
+      *info = j + 1;
+    }
+    for (int k = j + 1; k < N; k++) {
+      const scalar_t u = a[j + k * N];
+      for (int i = j + 1; i < N; i++) {
+        a[i + k * N] -= a[i + j * N] * u;
+      }
+    }
+  }
+}
+
+// Solves A X = B given the output of small_lu for A, like LAPACK's getrs.
+// b is an N x nrhs column major matrix that is overwritten by X.
+template <typename scalar_t, int N>
+static inline void small_lu_solve(const scalar_t* lu, const int* ipiv, scalar_t* b, int64_t nrhs) {
+  for (int64_t c = 0; c < nrhs; c++) {
+    scalar_t* x = b + c * N;
+    for (int i = 0; i < N; i++) {
+      std::swap(x[i], x[ipiv[i] - 1]);
+    }
+    // L is unit lower triangular
+    for (int j = 0; j < N; j++) {
+      for (int i = j + 1; i < N; i++) {
+        x[i] -= lu[i + j * N] * x[j];
+      }
+    }
+    for (int j = N - 1; j >= 0; j--) {
+      x[j] /= lu[j + j * N];
+      for (int i = 0; i < j; i++) {
+        x[i] -= lu[i + j * N] * x[j];
+      }
+    }
+  }
+}
+
+// Cholesky factorization of the N x N column major matrix a, like LAPACK's
+// potf2. Only the triangle given by 'upper' is referenced and overwritten.
+template <typename scalar_t, int N>
+static inline void small_cholesky(scalar_t* a, bool upper, int* info) {
+  // l(i, k) is the entry of L = U^T in the upper case
+  const int row_stride = upper ? N : 1;
+  const int col_stride = upper ? 1 : N;
+  auto l = [&](int i, int k) -> scalar_t& { return a[i * row_stride + k * col_stride]; };
+  *info = 0;
+  for (int j = 0; j < N; j++) {
+    scalar_t ajj = l(j, j);
+    for (int k = 0; k < j; k++) {
+      ajj -= l(j, k) * l(j, k);
+    }
+    if (!(ajj > scalar_t(0))) {
+      l(j, j) = ajj;
+      *info = j + 1;
+      return;
+    }
+    ajj = std::sqrt(ajj);
+    l(j, j) = ajj;
+    for (int i = j + 1; i < N; i++) {
+      scalar_t lij = l(i, j);
+      for (int k = 0; k < j; k++) {
+        lij -= l(i, k) * l(j, k);
+      }
+      l(i, j) = lij / ajj;
+    }
+  }
+}
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ solve ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 /*
@@ -453,9 +595,26 @@ static void apply_solve(Tensor& b, Tensor& A, Tensor& infos) {
   auto nrhs = b.size(-1);
   auto lda = std::max<int64_t>(1, n);
 
+  auto infos_data = infos.data_ptr<int>();
+
+  // See Note [batched small matrix kernels]
+  if (use_small_matrix_kernels<scalar_t>(n)) {
+    dispatch_small_matrix_size(n, [&](auto size) {
+      constexpr int N = decltype(size)::value;
+      parallel_for_small_matrices(batch_size, n, [&](int64_t i) {
+        scalar_t* A_working_ptr = &A_data[i * A_mat_stride];
+        int ipiv[N];
+        small_lu<scalar_t, N>(A_working_ptr, ipiv, &infos_data[i]);
+        if (infos_data[i] == 0) {
+          small_lu_solve<scalar_t, N>(A_working_ptr, ipiv, &b_data[i * b_mat_stride], nrhs);
+        }
+      });
+    });
+    return;
+  }
+
   auto ipiv = at::empty({lda}, b.options().dtype(kInt));
   auto ipiv_data = ipiv.data_ptr<int>();
-  auto infos_data = infos.data_ptr<int>();
 
   for (const auto i : c10::irange(batch_size)) {
     scalar_t* A_working_ptr = &A_data[i * A_mat_stride];
@@ -682,11 +841,36 @@ static void apply_inverse(Tensor& self, Tensor& infos_lu, Tensor& infos_getri) {
   auto n = self.size(-2);
   auto lda = std::max<int64_t>(1, n);
 
-  auto ipiv = at::empty({lda}, self.options().dtype(kInt));
-  auto ipiv_data = ipiv.data_ptr<int>();
   auto infos_lu_data = infos_lu.data_ptr<int>();
   auto infos_getri_data = infos_getri.data_ptr<int>();
 
+  // See Note [batched small matrix kernels]
+  if (use_small_matrix_kernels<scalar_t>(n)) {
+    dispatch_small_matrix_size(n, [&](auto size) {
+      constexpr int N = decltype(size)::value;
+      parallel_for_small_matrices(batch_size, n, [&](int64_t i) {
+        scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
+        int ipiv[N];
+        small_lu<scalar_t, N>(self_working_ptr, ipiv, &infos_lu_data[i]);
+        // getri reports the same singular diagonal element of U as getrf
+        infos_getri_data[i] = infos_lu_data[i];
+        if (infos_lu_data[i] != 0) {
+          return;
+        }
+        scalar_t lu[N * N];
+        std::copy(self_working_ptr, self_working_ptr + N * N, lu);
+        for (int k = 0; k < N * N; k++) {
+          self_working_ptr[k] = k % (N + 1) == 0 ? scalar_t(1) : scalar_t(0);
+        }
+        small_lu_solve<scalar_t, N>(lu, ipiv, self_working_ptr, N);
+      });
+    });
+    return;
+  }
+
+  auto ipiv = at::empty({lda}, self.options().dtype(kInt));
+  auto ipiv_data = ipiv.data_ptr<int>();
+
   int info;
   // Run once, first to get the optimum work size
   // Since we deal with batches of matrices with the same dimensions, doing this outside
@@ -913,6 +1097,19 @@ static void apply_cholesky(Tensor& self, bool upper, std::vector<int64_t>& infos
   auto n = self.size(-2);
   auto lda = std::max<int64_t>(1, n);
 
+  // See Note [batched small matrix kernels]
+  if (use_small_matrix_kernels<scalar_t>(n)) {
+    dispatch_small_matrix_size(n, [&](auto size) {
+      constexpr int N = decltype(size)::value;
+      parallel_for_small_matrices(batch_size, n, [&](int64_t i) {
+        int info;
+        small_cholesky<scalar_t, N>(&self_data[i * self_matrix_stride], upper, &info);
+        infos[i] = info;
+      });
+    });
+    return;
+  }
+
   int info;
   for (const auto i : c10::irange(batch_size)) {
     scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
@@ -1073,6 +1270,18 @@ static void apply_lu(Tensor& self, Tensor& pivots, Tensor& infos) {
   auto m = self.size(-2);
   auto n = self.size(-1);
 
+  // See Note [batched small matrix kernels]
+  if (m == n && use_small_matrix_kernels<scalar_t>(n)) {
+    dispatch_small_matrix_size(n, [&](auto size) {
+      constexpr int N = decltype(size)::value;
+      parallel_for_small_matrices(batch_size, n, [&](int64_t i) {
+        small_lu<scalar_t, N>(&self_data[i * self_matrix_stride],
+                              &pivots_data[i * pivots_matrix_stride], &infos_data[i]);
+      });
+    });
+    return;
+  }
+
   for (const auto i : c10::irange(batch_size)) {
     scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
     int* pivots_working_ptr = &pivots_data[i * pivots_matrix_stride];
@@ -1942,6 +2151,18 @@ static void apply_lu_solve(Tensor& b, const Tensor& lu, const Tensor& pivots, st
   auto n = lu.size(-2);
   auto nrhs = b.size(-1);
 
+  // See Note [batched small matrix kernels]
+  if (use_small_matrix_kernels<scalar_t>(n)) {
+    dispatch_small_matrix_size(n, [&](auto size) {
+      constexpr int N = decltype(size)::value;
+      parallel_for_small_matrices(batch_size, n, [&](int64_t i) {
+        small_lu_solve<scalar_t, N>(&lu_data[i * lu_stride], &pivots_data[i * pivots_stride],
+                                    &b_data[i * b_stride], nrhs);
+      });
+    });
+    return;
+  }
+
   int info;
   for (const auto i : c10::irange(batch_size)) {
     scalar_t* b_working_ptr = &b_data[i * b_stride];
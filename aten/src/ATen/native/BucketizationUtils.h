@@ -1,11 +1,17 @@
 #pragma once
 
 #include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
 #include <ATen/native/TypeProperties.h>
 
 namespace at {
 namespace native {
 
+// result, input, boundaries, right. input and boundaries are contiguous and of
+// the same dtype, and result is Long or Int depending on out_int32.
+using searchsorted_fn = void(*)(Tensor&, const Tensor&, const Tensor&, bool);
+DECLARE_DISPATCH(searchsorted_fn, searchsorted_stub);
+
 inline void searchsorted_maybe_trim_input_tensors(
   Tensor& trimmed_input,
   Tensor& trimmed_boundaries,
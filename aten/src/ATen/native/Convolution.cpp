@@ -1,6 +1,7 @@
 #include <ATen/ATen.h>
 #include <ATen/Parallel.h>
 #include <ATen/native/ConvUtils.h>
+#include <ATen/native/ConvolutionDirect2d.h>
 #include <ATen/native/cpu/DepthwiseConvKernel.h>
 #include <ATen/native/utils/ParamUtils.h>
 #include <ATen/native/xnnpack/Engine.h>
@@ -16,6 +17,10 @@
 #include <nnpack.h>
 #endif
 
+#if AT_MKLDNN_ENABLED()
+#include <ATen/native/mkldnn/Utils.h>
+#endif
+
 
 constexpr int MIOPEN_DIM_MAX = 5;
 
@@ -44,6 +49,7 @@ struct ConvParams {
   bool is_stride_nonpos() const;
   void view1d_as_2d();
   bool use_cpu_depthwise3x3_winograd(const at::Tensor& input, const at::Tensor& weight, const at::Tensor& bias) const;
+  bool use_cpu_direct_channels_last(const at::Tensor& input, const at::Tensor& weight, const at::Tensor& bias) const;
   bool needs_64bit_indexing_no_split(const at::Tensor& input, const at::Tensor& weight) const;
   bool use_cudnn(const at::Tensor& input, const at::Tensor& weight) const;
   bool use_cudnn_depthwise(const at::Tensor& input, const at::Tensor& weight) const;
@@ -164,6 +170,27 @@ auto ConvParams::use_cpu_depthwise3x3_winograd(
 #endif
 }
 
+// Channels last convolutions with few input channels, such as the first layer
+// of most vision models, are computed without im2col when nothing faster is
+// available. See Note [direct channels last convolution]
+auto ConvParams::use_cpu_direct_channels_last(
+    const at::Tensor& input,
+    const at::Tensor& weight,
+    const at::Tensor& bias) const -> bool {
+  return input.device().is_cpu() &&
+         !input.is_mkldnn() &&
+         (input.scalar_type() == at::kFloat || input.scalar_type() == at::kDouble) &&
+         (weight.scalar_type() == input.scalar_type()) &&
+         (!bias.defined() || bias.scalar_type() == input.scalar_type()) &&
+         (input.ndimension() == 4) &&
+         (weight.ndimension() == 4) &&
+         input.suggest_memory_format() == at::MemoryFormat::ChannelsLast &&
+         (input.size(1) <= kConv2dDirectMaxInputChannels) &&
+         groups == 1 &&
+         !is_dilated() &&
+         !transposed;
+}
+
 auto ConvParams::needs_64bit_indexing_no_split(const at::Tensor& input, const at::Tensor& weight) const -> bool {
   constexpr int64_t int_max = std::numeric_limits<int>::max();
   int64_t numel_input = input.numel();
@@ -234,7 +261,9 @@ auto ConvParams::use_mkldnn(const at::Tensor& input, const at::Tensor& weight) c
   }
   return (input.is_mkldnn()) || // input is mkldnn Tensor
     (input.device().is_cpu() &&
-     input.scalar_type() == kFloat && // only on CPU Float Tensors
+     (input.scalar_type() == kFloat || // only on CPU Float Tensors
+      // or BFloat16 ones (e.g. from CPU autocast) on CPUs with the avx512 bf16 path
+      (input.scalar_type() == kBFloat16 && mkldnn_bf16_device_check())) &&
      !transposed && // or transposed tensors
      // For 1x1 filters, MKLDNN is faster than THNN when multi-threaded,
      // but THNN is faster when single-threaded.
@@ -791,6 +820,8 @@ at::Tensor _convolution(
         params.stride,
         params.padding,
         params.groups);
+  } else if (params.use_cpu_direct_channels_last(input, weight, bias)) {
+    output = at::_conv2d_direct_channels_last(input, weight, bias, params.padding, params.stride);
   } else if (
         !params.transposed && (input.ndimension() == 5) &&
         (input.device().is_cpu()) &&
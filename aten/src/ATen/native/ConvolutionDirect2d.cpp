@@ -0,0 +1,62 @@
+#include <ATen/ATen.h>
+#include <ATen/native/ConvolutionDirect2d.h>
+#include <ATen/native/ConvUtils.h>
+
+namespace at { namespace native {
+
+// Note [direct channels last convolution]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// thnn_conv2d unfolds its input into a column buffer with one row per
+// (input channel, kernel position) and one column per output pixel, then
+// multiplies it by the weight. For a stem layer with 3 input channels, a 7x7
+// kernel and stride 2, the buffer holds 49 / 4 times as many elements as the
+// input, and the GEMM is too thin to make up for writing and reading it.
+//
+// With channels last tensors, the input channels of a pixel and the output
+// channels of a pixel are contiguous, so the convolution can be computed
+// directly: every output pixel accumulates, over the kernel window, the input
+// channels of each input pixel times the weight rearranged to
+// [kh][kw][ic][oc]. The kernel vectorizes over output channels and keeps a
+// block of them in registers; it sweeps a row of output pixels for each block,
+// so that the block's weights stay in cache. Only the weight is rearranged, no
+// buffer proportional to the input is allocated.
+
+Tensor _conv2d_direct_channels_last(
+    const Tensor& input,
+    const Tensor& weight,
+    const Tensor& bias,
+    IntArrayRef padding,
+    IntArrayRef stride) {
+  TORCH_CHECK(input.dim() == 4 && weight.dim() == 4,
+      "_conv2d_direct_channels_last: expected 4-D input and weight, got ",
+      input.dim(), "-D input and ", weight.dim(), "-D weight");
+  TORCH_CHECK(input.size(1) == weight.size(1),
+      "_conv2d_direct_channels_last: expected input with ", weight.size(1),
+      " channels, got ", input.size(1));
+  TORCH_CHECK(input.scalar_type() == weight.scalar_type() &&
+      (!bias.defined() || bias.scalar_type() == input.scalar_type()),
+      "_conv2d_direct_channels_last: expected input, weight and bias of the same type");
+  TORCH_CHECK(padding.size() == 2 && stride.size() == 2 && stride[0] > 0 && stride[1] > 0,
+      "_conv2d_direct_channels_last: expected 2 positive strides and 2 paddings");
+
+  auto output_size = conv_output_size(input.sizes(), weight.sizes(), padding, stride);
+  TORCH_CHECK(output_size[2] > 0 && output_size[3] > 0,
+      "_conv2d_direct_channels_last: output size is too small: ", output_size);
+  Tensor output = at::empty(output_size, input.options().memory_format(at::MemoryFormat::ChannelsLast));
+  if (output.numel() == 0) {
+    return output;
+  }
+  conv2d_channels_last_direct_kernel(
+      kCPU,
+      output,
+      input.contiguous(at::MemoryFormat::ChannelsLast),
+      weight,
+      bias.defined() ? bias.contiguous() : bias,
+      stride,
+      padding);
+  return output;
+}
+
+DEFINE_DISPATCH(conv2d_channels_last_direct_kernel);
+
+}} // namespace at::native
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+// Direct (no im2col) 2d convolution of channels last tensors, meant for layers
+// with few input channels, whose column buffer would be far larger than the
+// input. See [direct channels last convolution] in ConvolutionDirect2d.cpp.
+using conv2d_channels_last_direct_fn = void(*)(
+    Tensor& output, const Tensor& input, const Tensor& weight, const Tensor& bias,
+    IntArrayRef stride, IntArrayRef padding);
+DECLARE_DISPATCH(conv2d_channels_last_direct_fn, conv2d_channels_last_direct_kernel);
+
+// Input channels up to which the direct convolution is used.
+constexpr int64_t kConv2dDirectMaxInputChannels = 16;
+
+}} // namespace at::native
@@ -9,6 +9,9 @@
 namespace at {
 namespace native {
 
+DEFINE_DISPATCH(max_pool_channels_last_kernel);
+DEFINE_DISPATCH(max_pool_channels_last_backward_kernel);
+
 namespace {
 
 template <typename scalar_t>
@@ -171,6 +174,14 @@ void max_pool2d_with_indices_out_cpu_template(
     inputHeight, inputWidth,
     outputHeight, outputWidth, input_.suggest_memory_format());
 
+  if (use_channels_last_pooling(input_)) {
+    output.resize_({nbatch, nInputPlane, outputHeight, outputWidth}, at::MemoryFormat::ChannelsLast);
+    indices.resize_({nbatch, nInputPlane, outputHeight, outputWidth}, at::MemoryFormat::ChannelsLast);
+    PoolingWindow3D window{1, kH, kW, 1, dH, dW, 0, padH, padW, 1, dilationH, dilationW};
+    max_pool_channels_last_kernel(kCPU, output, indices, input_, window);
+    return;
+  }
+
   /* get contiguous input */
   Tensor input = input_.contiguous();
 
@@ -333,20 +344,13 @@ Tensor& max_pool2d_with_indices_backward_out_cpu_template(
   TORCH_CHECK((input.ndimension() == 3 || input.ndimension() == 4),
     "non-empty 3D or 4D (batch mode) tensor expected for input");
 
-  /* get contiguous gradOutput */
-  const Tensor gradOutput = gradOutput_.contiguous();
-
-  /* resize */
-  gradInput.resize_as_(input);
-  gradInput.zero_();
-
   /* sizes */
   const int64_t nbatch = input.ndimension() == 4 ? input.size(-4) : 1;
   const int64_t nInputPlane = input.size(-3);
   const int64_t inputHeight = input.size(-2);
   const int64_t inputWidth = input.size(-1);
-  const int64_t outputHeight = gradOutput.size(-2);
-  const int64_t outputWidth = gradOutput.size(-1);
+  const int64_t outputHeight = gradOutput_.size(-2);
+  const int64_t outputWidth = gradOutput_.size(-1);
 
   /* XXX preserve the existing shape check behavior */
   const int64_t outputHeight_for_shape_check = pooling_output_shape<int64_t>(inputHeight, kH, padH, dH, dilationH, ceil_mode);
@@ -363,6 +367,20 @@ Tensor& max_pool2d_with_indices_backward_out_cpu_template(
     outputHeight_for_shape_check, outputWidth_for_shape_check,
     input.suggest_memory_format());
 
+  if (use_channels_last_pooling(input)) {
+    gradInput.resize_(input.sizes(), at::MemoryFormat::ChannelsLast);
+    gradInput.zero_();
+    max_pool_channels_last_backward_kernel(kCPU, gradInput, gradOutput_, indices);
+    return gradInput;
+  }
+
+  /* get contiguous gradOutput */
+  const Tensor gradOutput = gradOutput_.contiguous();
+
+  /* resize */
+  gradInput.resize_as_(input);
+  gradInput.zero_();
+
   /* backprop */
   if (input.ndimension() == 3)
   {
@@ -196,6 +196,14 @@ void max_pool3d_with_indices_out_cpu_template(
     itime, iheight, iwidth,
     otime, oheight, owidth);
 
+  if (use_channels_last_pooling(input_)) {
+    output.resize_({input_.size(0), nslices, otime, oheight, owidth}, at::MemoryFormat::ChannelsLast3d);
+    indices.resize_({input_.size(0), nslices, otime, oheight, owidth}, at::MemoryFormat::ChannelsLast3d);
+    PoolingWindow3D window{kT, kH, kW, dT, dH, dW, pT, pH, pW, dilationT, dilationH, dilationW};
+    max_pool_channels_last_kernel(kCPU, output, indices, input_, window);
+    return;
+  }
+
   /* get contiguous input */
   Tensor input = input_.contiguous();
 
@@ -390,20 +398,13 @@ Tensor& max_pool3d_with_indices_backward_out_cpu_template(
   const int64_t iheight = input.size(-2);
   const int64_t iwidth = input.size(-1);
 
-  /* get contiguous gradOutput */
-  Tensor gradOutput = gradOutput_.contiguous();
-
-  /* resize */
-  gradInput.resize_as_(input);
-  gradInput.zero_();
-
-  const int64_t otime = gradOutput.size(-3);
-  const int64_t oheight = gradOutput.size(-2);
-  const int64_t owidth = gradOutput.size(-1);
+  const int64_t otime = gradOutput_.size(-3);
+  const int64_t oheight = gradOutput_.size(-2);
+  const int64_t owidth = gradOutput_.size(-1);
 
   max_pool3d_backward_shape_check(
     input,
-    gradOutput,
+    gradOutput_,
     indices,
     nslices,
     kT, kH, kW,
@@ -413,6 +414,20 @@ Tensor& max_pool3d_with_indices_backward_out_cpu_template(
     itime, iheight, iwidth,
     otime, oheight, owidth);
 
+  if (use_channels_last_pooling(input)) {
+    gradInput.resize_(input.sizes(), at::MemoryFormat::ChannelsLast3d);
+    gradInput.zero_();
+    max_pool_channels_last_backward_kernel(kCPU, gradInput, gradOutput_, indices);
+    return gradInput;
+  }
+
+  /* get contiguous gradOutput */
+  Tensor gradOutput = gradOutput_.contiguous();
+
+  /* resize */
+  gradInput.resize_as_(input);
+  gradInput.zero_();
+
   /* backprop */
   if (input.ndimension() == 4) /* non-batch mode*/
   {
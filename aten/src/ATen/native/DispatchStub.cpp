@@ -16,6 +16,9 @@ static CPUCapability compute_cpu_capability() {
       return CPUCapability::VSX;
     }
 #else
+    if (strcmp(envar, "avx512") == 0) {
+      return CPUCapability::AVX512;
+    }
     if (strcmp(envar, "avx2") == 0) {
       return CPUCapability::AVX2;
     }
@@ -31,6 +34,13 @@ static CPUCapability compute_cpu_capability() {
 
 #if !defined(__powerpc__) && !defined(__s390x__)
   if (cpuinfo_initialize()) {
+    // the AVX512 kernels are compiled for Skylake-SP and later, which have
+    // all of these
+    if (cpuinfo_has_x86_avx512f() && cpuinfo_has_x86_avx512bw() &&
+        cpuinfo_has_x86_avx512vl() && cpuinfo_has_x86_avx512dq() &&
+        cpuinfo_has_x86_fma3()) {
+      return CPUCapability::AVX512;
+    }
     if (cpuinfo_has_x86_avx2() && cpuinfo_has_x86_fma3()) {
       return CPUCapability::AVX2;
     }
@@ -60,6 +70,9 @@ void* DispatchStubImpl::get_call_ptr(
 #ifdef HAVE_AVX2_CPU_DEFINITION
   , void *AVX2
 #endif
+#ifdef HAVE_AVX512_CPU_DEFINITION
+  , void *AVX512
+#endif
 #ifdef HAVE_VSX_CPU_DEFINITION
   , void *VSX
 #endif
@@ -78,6 +91,9 @@ void* DispatchStubImpl::get_call_ptr(
 #ifdef HAVE_AVX2_CPU_DEFINITION
           , AVX2
 #endif
+#ifdef HAVE_AVX512_CPU_DEFINITION
+          , AVX512
+#endif
 #ifdef HAVE_VSX_CPU_DEFINITION
           , VSX
 #endif
@@ -108,12 +124,21 @@ void* DispatchStubImpl::choose_cpu_impl(
 #ifdef HAVE_AVX2_CPU_DEFINITION
   , void *AVX2
 #endif
+#ifdef HAVE_AVX512_CPU_DEFINITION
+  , void *AVX512
+#endif
 #ifdef HAVE_VSX_CPU_DEFINITION
   , void *VSX
 #endif
 ) {
   auto capability = static_cast<int>(get_cpu_capability());
   (void)capability;
+#ifdef HAVE_AVX512_CPU_DEFINITION
+  if (capability >= static_cast<int>(CPUCapability::AVX512)) {
+    TORCH_INTERNAL_ASSERT(AVX512, "DispatchStub: missing AVX512 kernel");
+    return AVX512;
+  }
+#endif
 #ifdef HAVE_AVX2_CPU_DEFINITION
   if (capability >= static_cast<int>(CPUCapability::AVX2)) {
     TORCH_INTERNAL_ASSERT(AVX2, "DispatchStub: missing AVX2 kernel");
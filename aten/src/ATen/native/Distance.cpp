@@ -30,17 +30,65 @@ Tensor _euclidean_dist(const Tensor& x1, const Tensor& x2) {
   /** This function does the fist part of the euclidean distance calculation
    * We divide it in two steps to simplify dealing with subgradients in the
    * backward step */
+  // ||x1||^2 + ||x2||^2 - 2 x1 x2^T, with the norms added to the product in
+  // place rather than concatenated to copies of the inputs
   Tensor x1_norm = x1.pow(2).sum(-1, true);
-  Tensor x1_pad = at::ones_like(x1_norm, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
   Tensor x2_norm = x2.pow(2).sum(-1, true);
-  Tensor x2_pad = at::ones_like(x2_norm, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
-  Tensor x1_ = at::cat({x1.mul(-2), x1_norm, x1_pad}, -1);
-  Tensor x2_ = at::cat({x2, x2_pad, x2_norm}, -1);
-  Tensor result = x1_.matmul(x2_.transpose(-2, -1));
+  Tensor result = x1.matmul(x2.transpose(-2, -1));
+  result.mul_(-2).add_(x1_norm).add_(x2_norm.transpose(-2, -1));
   result.clamp_min_(0).sqrt_();
   return result;
 }
 
+// The distances of a block of kCdistTopkQueryBlock queries to a tile of
+// kCdistTopkTile rows of x2 are computed with one GEMM and merged with the k
+// smallest distances so far, so the full r1 x r2 matrix is never allocated.
+// Squared distances are compared, and only the k results are square rooted.
+static constexpr int64_t kCdistTopkQueryBlock = 1024;
+static constexpr int64_t kCdistTopkTile = 4096;
+
+std::tuple<Tensor, Tensor> _cdist_topk(const Tensor& x1, const Tensor& x2, int64_t k) {
+  TORCH_CHECK(x1.dim() == 2 && x2.dim() == 2,
+      "_cdist_topk only supports 2D tensors, X1 got: ", x1.dim(), "D, X2 got: ", x2.dim(), "D");
+  TORCH_CHECK(at::isFloatingType(x1.scalar_type()), "_cdist_topk only supports floating-point dtypes, X1 got: ", x1.scalar_type());
+  TORCH_CHECK(x1.scalar_type() == x2.scalar_type(), "X1 and X2 must have the same dtype. X1: ", x1.scalar_type(), " X2: ", x2.scalar_type());
+  TORCH_CHECK(x1.size(1) == x2.size(1), "X1 and X2 must have the same number of columns. X1: ", x1.size(1), " X2: ", x2.size(1));
+  TORCH_CHECK(k >= 0 && k <= x2.size(0), "_cdist_topk: k (", k, ") must be in [0, ", x2.size(0), "]");
+  const int64_t r1 = x1.size(0);
+  const int64_t r2 = x2.size(0);
+  Tensor values = at::empty({r1, k}, x1.options());
+  Tensor indices = at::empty({r1, k}, x1.options().dtype(kLong));
+  if (r1 == 0 || k == 0) {
+    return std::make_tuple(values, indices);
+  }
+
+  Tensor x2_norm = x2.pow(2).sum(-1);
+  for (int64_t q = 0; q < r1; q += kCdistTopkQueryBlock) {
+    Tensor queries = x1.narrow(0, q, std::min(kCdistTopkQueryBlock, r1 - q));
+    Tensor queries_norm = queries.pow(2).sum(-1, true);
+    Tensor best_values, best_indices;
+    for (int64_t t = 0; t < r2; t += kCdistTopkTile) {
+      const int64_t tile_size = std::min(kCdistTopkTile, r2 - t);
+      Tensor dist = at::addmm(
+          x2_norm.narrow(0, t, tile_size), queries, x2.narrow(0, t, tile_size).t(), 1, -2);
+      dist.add_(queries_norm);
+      Tensor tile_indices = at::arange(t, t + tile_size, indices.options()).expand_as(dist);
+      if (best_values.defined()) {
+        dist = at::cat({best_values, dist}, 1);
+        tile_indices = at::cat({best_indices, tile_indices}, 1);
+      }
+      Tensor selected;
+      std::tie(best_values, selected) = dist.topk(std::min(k, dist.size(1)), 1, /*largest=*/false, /*sorted=*/false);
+      best_indices = tile_indices.gather(1, selected);
+    }
+    Tensor order;
+    std::tie(best_values, order) = best_values.sort(1);
+    values.narrow(0, q, queries.size(0)).copy_(best_values.clamp_min_(0).sqrt_());
+    indices.narrow(0, q, queries.size(0)).copy_(best_indices.gather(1, order));
+  }
+  return std::make_tuple(values, indices);
+}
+
 static Tensor cdist_impl(const Tensor& x1, const Tensor& x2, const double p, c10::optional<int64_t> compute_mode) {
   TORCH_CHECK(at::isFloatingType(x1.scalar_type()), "cdist only supports floating-point dtypes, X1 got: ", x1.scalar_type());
   auto device1 = x1.device().type();
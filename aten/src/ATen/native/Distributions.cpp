@@ -20,6 +20,7 @@
 #include <ATen/native/cpu/Loops.h>
 
 #include <type_traits>
+#include <vector>
 #include <functional>
 #include <assert.h>
 #include <float.h>
@@ -119,6 +120,7 @@ DEFINE_DISPATCH(bernoulli_scalar_stub);
 DEFINE_DISPATCH(cauchy_stub);
 DEFINE_DISPATCH(exponential_stub);
 DEFINE_DISPATCH(multinomial_with_replacement_stub);
+DEFINE_DISPATCH(multinomial_alias_draw_stub);
 DEFINE_DISPATCH(geometric_stub);
 DEFINE_DISPATCH(log_normal_stub);
 DEFINE_DISPATCH(uniform_stub);
@@ -554,4 +556,100 @@ Tensor multinomial(
   return result;
 }
 
+// Vose's alias method: multinomial samples of a fixed distribution are drawn
+// in O(1) each, once its table is built in O(n_categories).
+// Reference: M. D. Vose, A linear algorithm for generating random numbers with
+// a given distribution, IEEE Transactions on Software Engineering, 1991.
+std::tuple<Tensor, Tensor> _multinomial_alias_setup(const Tensor& probs) {
+  TORCH_CHECK(
+      probs.dim() == 1,
+      "_multinomial_alias_setup: expected a 1-D probability tensor, but got ",
+      probs.dim(), "-D");
+  TORCH_CHECK(
+      at::isFloatingType(probs.scalar_type()),
+      "_multinomial_alias_setup only supports floating-point dtypes, got: ",
+      probs.scalar_type());
+  const int64_t n_categories = probs.numel();
+  TORCH_CHECK(n_categories > 0, "_multinomial_alias_setup: expected a non-empty probability tensor");
+
+  // The construction is sequential and done once per distribution, so it runs
+  // on the CPU, in double precision
+  Tensor p = probs.to(kCPU, kDouble).contiguous();
+  const double* p_data = p.data_ptr<double>();
+  double sum = 0;
+  for (int64_t i = 0; i < n_categories; i++) {
+    TORCH_CHECK(
+        p_data[i] >= 0 && std::isfinite(p_data[i]),
+        "invalid multinomial distribution (encountering probability entry < 0, infinity or NaN)");
+    sum += p_data[i];
+  }
+  TORCH_CHECK(sum > 0, "invalid multinomial distribution (sum of probabilities <= 0)");
+
+  Tensor q = at::empty({n_categories}, p.options());
+  Tensor J = at::empty({n_categories}, p.options().dtype(kLong));
+  double* q_data = q.data_ptr<double>();
+  int64_t* J_data = J.data_ptr<int64_t>();
+  std::vector<int64_t> smaller;
+  std::vector<int64_t> larger;
+  for (int64_t i = 0; i < n_categories; i++) {
+    q_data[i] = p_data[i] * n_categories / sum;
+    J_data[i] = i;
+    if (q_data[i] < 1) {
+      smaller.push_back(i);
+    } else {
+      larger.push_back(i);
+    }
+  }
+  // Each category with q < 1 gives the rest of its slot to one with q >= 1
+  while (!smaller.empty() && !larger.empty()) {
+    const int64_t small = smaller.back();
+    const int64_t large = larger.back();
+    smaller.pop_back();
+    J_data[small] = large;
+    q_data[large] = (q_data[large] + q_data[small]) - 1;
+    if (q_data[large] < 1) {
+      larger.pop_back();
+      smaller.push_back(large);
+    }
+  }
+  // The categories left have q = 1 up to rounding errors
+  for (const auto i : smaller) {
+    q_data[i] = 1;
+  }
+  for (const auto i : larger) {
+    q_data[i] = 1;
+  }
+
+  return std::make_tuple(
+      J.to(probs.device()), q.to(probs.device(), probs.scalar_type()));
+}
+
+Tensor _multinomial_alias_draw(
+    const Tensor& J,
+    const Tensor& q,
+    int64_t n_sample,
+    c10::optional<Generator> gen) {
+  TORCH_CHECK(
+      J.device() == q.device(),
+      "_multinomial_alias_draw arguments must have the same device");
+  TORCH_CHECK(
+      J.dim() == 1 && J.scalar_type() == kLong,
+      "_multinomial_alias_draw: expected a 1-D Long tensor J");
+  TORCH_CHECK(
+      q.dim() == 1 && at::isFloatingType(q.scalar_type()),
+      "_multinomial_alias_draw: expected a 1-D floating-point tensor q");
+  TORCH_CHECK(
+      J.numel() == q.numel() && q.numel() > 0,
+      "_multinomial_alias_draw: expected J and q of the same, non-zero size, but got ",
+      J.numel(), " and ", q.numel());
+  TORCH_CHECK(n_sample >= 0, "cannot sample n_sample < 0 samples");
+
+  Tensor result = at::empty({n_sample}, J.options());
+  if (n_sample > 0) {
+    multinomial_alias_draw_stub(
+        result.device().type(), result, J.contiguous(), q.contiguous(), gen);
+  }
+  return result;
+}
+
 }} // namespace at::native
@@ -1,6 +1,9 @@
 #include <ATen/ATen.h>
+#include <ATen/CPUGeneratorImpl.h>
 #include <ATen/Dispatch.h>
 #include <ATen/NamedTensorUtils.h>
+#include <ATen/Parallel.h>
+#include <ATen/core/PhiloxRNGEngine.h>
 
 namespace at { namespace native {
 
@@ -82,6 +85,78 @@ ALIAS_SPECIALIZATION(_feature_alpha_dropout, true,  true )
 
 } // anomymous namepsace
 
+// _fused_dropout_packed keeps one bit per element of the mask: element i is
+// kept if bit i % 8 of mask[i / 8] is set. Element i is kept when the i-th
+// number of a Philox engine seeded from the generator is below p, so every
+// byte of the mask starts at counter offset 2 * (i / 8) and the result does
+// not depend on the number of threads.
+std::tuple<Tensor, Tensor> fused_dropout_packed_cpu(const Tensor& self, double p, c10::optional<Generator> gen_) {
+  TORCH_CHECK(p > 0 && p <= 1, "_fused_dropout_packed: keep probability has to be in (0, 1], but got ", p);
+  auto input = self.contiguous();
+  Tensor ret = at::empty_like(input, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  const int64_t nelem = input.numel();
+  Tensor mask = at::empty({(nelem + 7) / 8}, self.options().dtype(kByte));
+  if (nelem == 0) {
+    return std::make_tuple(ret, mask);
+  }
+  auto gen = get_generator_or_default<CPUGeneratorImpl>(gen_, detail::getDefaultCPUGenerator());
+  uint64_t seed;
+  {
+    // See Note [Acquire lock when using random generators]
+    std::lock_guard<std::mutex> lock(gen->mutex_);
+    seed = gen->random64();
+  }
+  // compared with the low 24 bits of the random numbers, as in
+  // uniform_real_distribution<float>
+  const uint32_t threshold = static_cast<uint32_t>(p * (1 << 24));
+  AT_DISPATCH_FLOATING_TYPES_AND(ScalarType::BFloat16, ret.scalar_type(), "fused_dropout_packed_cpu", [&] {
+    const scalar_t* in = input.data_ptr<scalar_t>();
+    scalar_t* out = ret.data_ptr<scalar_t>();
+    uint8_t* mask_data = mask.data_ptr<uint8_t>();
+    const scalar_t scale = static_cast<scalar_t>(1. / p);
+    at::parallel_for(0, (nelem + 7) / 8, at::internal::GRAIN_SIZE / 8, [&](int64_t begin, int64_t end) {
+      at::Philox4_32_10 engine(seed, 0, begin * 2);
+      for (int64_t byte = begin; byte < end; ++byte) {
+        uint8_t bits = 0;
+        const int64_t n = std::min<int64_t>(8, nelem - byte * 8);
+        for (int64_t j = 0; j < 8; ++j) {
+          // the numbers of the padding bits are drawn all the same
+          const bool keep = (engine() & ((1 << 24) - 1)) < threshold;
+          if (j < n) {
+            const int64_t i = byte * 8 + j;
+            out[i] = keep ? in[i] * scale : scalar_t(0);
+            bits |= static_cast<uint8_t>(keep) << j;
+          }
+        }
+        mask_data[byte] = bits;
+      }
+    });
+  });
+  return std::make_tuple(ret, mask);
+}
+
+Tensor masked_scale_packed_cpu(const Tensor& self, const Tensor& mask, double scale) {
+  TORCH_CHECK(mask.scalar_type() == ScalarType::Byte, "mask should be torch.uint8 dtype");
+  TORCH_CHECK(mask.numel() == (self.numel() + 7) / 8,
+      "_masked_scale_packed: expected a mask of ", (self.numel() + 7) / 8, " bytes for ",
+      self.numel(), " elements, but got ", mask.numel());
+  auto input = self.contiguous();
+  auto mask_ = mask.contiguous();
+  Tensor ret = at::empty_like(input, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  AT_DISPATCH_FLOATING_TYPES_AND(ScalarType::BFloat16, ret.scalar_type(), "masked_scale_packed_cpu", [&] {
+    const scalar_t* in = input.data_ptr<scalar_t>();
+    scalar_t* out = ret.data_ptr<scalar_t>();
+    const uint8_t* mask_data = mask_.data_ptr<uint8_t>();
+    const scalar_t s = static_cast<scalar_t>(scale);
+    at::parallel_for(0, input.numel(), at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        out[i] = (mask_data[i >> 3] >> (i & 7)) & 1 ? in[i] * s : scalar_t(0);
+      }
+    });
+  });
+  return ret;
+}
+
 Tensor dropout(const Tensor& input, double p, bool train) {
   auto result = [&]() {
     NoNamesGuard guard;
@@ -4,6 +4,7 @@
 #include <ATen/TensorUtils.h>
 
 #include <ATen/native/CPUBlas.h>
+#include <ATen/native/EmbeddingBag.h>
 
 #ifdef USE_FBGEMM
 #include <fbgemm/Fbgemm.h>
@@ -41,266 +42,214 @@ static void make_offset2bag(const Tensor &offsets, Tensor& offset2bag) {
 
 namespace {
 
-bool isFastPathIndexSelect(const Tensor& src, Tensor& output) {
-  return src.scalar_type() == kFloat && src.stride(1) == 1 && output.stride(1) == 1;
+// Half and BFloat16 tables are reduced in float and rounded once per output.
+template <typename data_t>
+struct EmbeddingBagAccType { using type = data_t; };
+template <>
+struct EmbeddingBagAccType<at::Half> { using type = float; };
+template <>
+struct EmbeddingBagAccType<at::BFloat16> { using type = float; };
+
+template <typename data_t>
+constexpr bool has_fast_path_kernel =
+    std::is_same<data_t, float>::value || std::is_same<data_t, at::Half>::value;
+
+// Number of lookups ahead of the current one whose rows are prefetched. The
+// FBGEMM kernels are generated with the same distance.
+constexpr int64_t kPrefetchDistance = 16;
+constexpr int64_t kCacheLineSize = 64;
+
+inline void prefetch_row(const void* row, int64_t row_bytes) {
+#if defined(__GNUC__) || defined(__clang__)
+  const char* ptr = static_cast<const char*>(row);
+  for (int64_t b = 0; b < row_bytes; b += kCacheLineSize) {
+    __builtin_prefetch(ptr + b, /*rw=*/0, /*locality=*/1);
+  }
+#endif
 }
 
-bool isFastPathIndexSelectScale(const Tensor& src, const Tensor& scale, Tensor& output) {
-  return src.scalar_type() == kFloat && src.stride(1) == 1 && output.stride(1) == 1 && scale.stride(0) == 1;
+// Sum and mean over float and fp16 tables with unit-stride rows go through the
+// FBGEMM JIT kernels (or the caffe2 perfkernels in builds without FBGEMM).
+bool isFastPathEmbeddingBag(const Tensor& src, const Tensor& scale, const Tensor& output, int64_t mode) {
+  return (src.scalar_type() == kFloat || src.scalar_type() == kHalf) &&
+      mode != MODE_MAX && src.stride(1) == 1 && output.stride(1) == 1 &&
+      (!scale.defined() || scale.stride(0) == 1);
 }
 
-// This function combines index_select (using select_indices as the index) and
-// index_add (using add_indices as the index), without creating an intermediary
-// tensor to hold the selected embeddings
-template<typename data_t, typename index_t>
-typename std::enable_if<!std::is_same<data_t, float>::value, void>::type
-index_select_add(const Tensor &select_indices,
-                             const Tensor &add_indices,
-                             const Tensor &src,
-                             Tensor &output,
-                             const Tensor& /*offsets*/,
-                             bool /*include_last_offset*/) {
-  AT_ASSERT(select_indices.numel() == add_indices.numel());
-  auto* add_indices_data = add_indices.data_ptr<index_t>();
-  auto* select_indices_data = select_indices.data_ptr<index_t>();
-  auto* src_data = src.data_ptr<data_t>();
-  auto* output_data = output.data_ptr<data_t>();
-  auto numel = add_indices.numel();
-  int64_t ddim = src.size(1);
-  auto src_stride0 = src.stride(0);
-  auto src_stride1 = src.stride(1);
-  auto output_stride0 = output.stride(0);
-  auto output_stride1 = output.stride(1);
-
-  for (int64_t i = 0; i < numel; i++) {
-    at::native::cpublas::axpy<data_t>(ddim, 1,
-            src_data + src_stride0 * select_indices_data[i], src_stride1,
-            output_data + output_stride0 * add_indices_data[i], output_stride1);
+// Returns offsets holding num_bags + 1 entries, so that bag i covers
+// indices [offsets[i], offsets[i + 1]). Without include_last_offset the
+// closing entry is appended into `storage`.
+template <typename index_t>
+const index_t* offsets_include_last(
+    const Tensor& offsets,
+    int64_t num_indices,
+    bool include_last_offset,
+    std::vector<index_t>& storage) {
+  auto* offsets_data = offsets.data_ptr<index_t>();
+  if (include_last_offset) {
+    return offsets_data;
   }
+  storage.resize(offsets.numel() + 1);
+  std::memcpy(storage.data(), offsets_data, sizeof(index_t) * offsets.numel());
+  storage[offsets.numel()] = num_indices;
+  return storage.data();
 }
 
-template<typename data_t, typename index_t>
-typename std::enable_if<std::is_same<data_t, float>::value, void>::type
-index_select_add(const Tensor &select_indices,
-                             const Tensor &add_indices,
-                             const Tensor &src,
-                             Tensor &output,
-                             const Tensor& offsets,
-                             bool include_last_offset) {
+template <typename data_t, typename index_t>
+typename std::enable_if<!has_fast_path_kernel<data_t>, void>::type
+embedding_bag_cpu_fast_sum(const Tensor& /*src*/,
+                           const index_t* /*indices_data*/,
+                           const index_t* /*offsets_data*/,
+                           int64_t /*num_bags*/,
+                           bool /*normalize_by_lengths*/,
+                           const Tensor& /*scale*/,
+                           Tensor& /*output*/) {
+  TORCH_INTERNAL_ASSERT(false, "embedding_bag: no fast path kernel for this dtype");
+}
+
+// Sum or mean of every bag, optionally scaled by per_sample_weights, through
+// the vectorized embedding lookup kernels. These accumulate in float and
+// prefetch the rows of upcoming lookups themselves.
+template <typename data_t, typename index_t>
+typename std::enable_if<has_fast_path_kernel<data_t>, void>::type
+embedding_bag_cpu_fast_sum(const Tensor& src,
+                           const index_t* indices_data,
+                           const index_t* offsets_data,
+                           int64_t num_bags,
+                           bool normalize_by_lengths,
+                           const Tensor& scale,
+                           Tensor& output) {
   int64_t ddim = src.size(1);
-  auto* select_indices_data = select_indices.data_ptr<index_t>();
-  auto* output_data = output.data_ptr<float>();
-
-  if (isFastPathIndexSelect(src, output)) {
-    auto src_contig = src.contiguous();
-    auto* src_data = src_contig.data_ptr<float>();
-    int64_t output_size = offsets.numel() - 1;
-    auto* offsets_data = offsets.data_ptr<index_t>();
-    std::vector<index_t> offsets_include_last;
-
-    if (include_last_offset) {
-      output_size = offsets.numel() - 1;
-    } else {
-      output_size = offsets.numel();
-      offsets_include_last.resize(offsets.numel() + 1);
-      std::memcpy(
-          offsets_include_last.data(),
-          offsets.data_ptr<index_t>(),
-          sizeof(index_t) * offsets.numel());
-      offsets_include_last[offsets.numel()] = select_indices.numel();
-      offsets_data = offsets_include_last.data();
-    }
+  auto src_contig = src.contiguous();
+  auto* src_data = src_contig.data_ptr<data_t>();
+  auto* output_data = output.data_ptr<data_t>();
+  // The kernels take float per_sample_weights whatever the table dtype is.
+  Tensor scale_fp32;
+  const float* scale_data = nullptr;
+  if (scale.defined()) {
+    scale_fp32 = scale.to(kFloat).contiguous();
+    scale_data = scale_fp32.data_ptr<float>();
+  }
+  constexpr bool is_fp16 = std::is_same<data_t, at::Half>::value;
 
 #ifdef USE_FBGEMM
-    auto kernel_fp32_index_t =
-      fbgemm::GenerateEmbeddingSpMDM<float, index_t, index_t>(
-        /* block_size */ddim,
-        /* has_weight */false,
-        /* normalize_by_lengths */false,
-        /* prefetch */16,
-        /* is_weight_positional */false,
-        /* use_offsets */true
-      );
+  using fbgemm_data_t = typename std::conditional<is_fp16, fbgemm::float16, float>::type;
+  auto kernel = fbgemm::GenerateEmbeddingSpMDM<fbgemm_data_t, index_t, index_t>(
+      /* block_size */ddim,
+      /* has_weight */scale_data != nullptr,
+      /* normalize_by_lengths */normalize_by_lengths,
+      /* prefetch */kPrefetchDistance,
+      /* is_weight_positional */false,
+      /* use_offsets */true);
 #endif
-    at::parallel_for(
-        0, output_size, 1, [&](index_t start_idx, index_t end_idx) {
+  at::parallel_for(0, num_bags, 1, [&](int64_t start_idx, int64_t end_idx) {
+    // fp16 tables are reduced into a float scratch buffer first.
+    std::vector<float> buffer(is_fp16 ? (end_idx - start_idx) * ddim : 0);
+    float* out = is_fp16 ? buffer.data()
+                         : reinterpret_cast<float*>(output_data + start_idx * ddim);
+    const float* weights = scale_data ? scale_data + offsets_data[start_idx] : nullptr;
 #ifdef USE_FBGEMM
-          kernel_fp32_index_t(
-            /* output_size */end_idx - start_idx,
-            /* index_size */offsets_data[end_idx] - offsets_data[start_idx],
-            /* data_size */src.size(0),
-            /* input */src_data,
-            /* indices */select_indices_data + offsets_data[start_idx],
-            /* offsets_or_lengths */offsets_data + start_idx,
-            /* weights */nullptr,
-            /* output */output_data + start_idx * ddim);
+    kernel(
+        /* output_size */end_idx - start_idx,
+        /* index_size */offsets_data[end_idx] - offsets_data[start_idx],
+        /* data_size */src.size(0),
+        /* input */reinterpret_cast<const fbgemm_data_t*>(src_data),
+        /* indices */indices_data + offsets_data[start_idx],
+        /* offsets_or_lengths */offsets_data + start_idx,
+        /* weights */weights,
+        /* output */out);
 #else
-          caffe2::EmbeddingLookupIdx(
-              /*block_size=*/ddim,
-              /*output_size=*/end_idx - start_idx,
-              /*index_size=*/offsets_data[end_idx] - offsets_data[start_idx],
-              /*data_size=*/src.size(0),
-              /*input=*/src_data,
-              /*indices=*/select_indices_data + offsets_data[start_idx],
-              /*offsets=*/offsets_data + start_idx,
-              /*weights=*/nullptr,
-              /*scale_bias=*/nullptr,
-              /*normalize_by_lengths=*/false,
-              /*out=*/output_data + start_idx * ddim);
+    caffe2::EmbeddingLookupIdx(
+        /*block_size=*/ddim,
+        /*output_size=*/end_idx - start_idx,
+        /*index_size=*/offsets_data[end_idx] - offsets_data[start_idx],
+        /*data_size=*/src.size(0),
+        /*input=*/src_data,
+        /*indices=*/indices_data + offsets_data[start_idx],
+        /*offsets=*/offsets_data + start_idx,
+        /*weights=*/weights,
+        /*scale_bias=*/nullptr,
+        /*normalize_by_lengths=*/normalize_by_lengths,
+        /*out=*/out);
 #endif
-        });
-  } else {
-    AT_ASSERT(select_indices.numel() == add_indices.numel());
-    auto* src_data = src.data_ptr<float>();
-    auto* add_indices_data = add_indices.data_ptr<index_t>();
-    auto src_stride0 = src.stride(0);
-    auto src_stride1 = src.stride(1);
-    auto output_stride0 = output.stride(0);
-    auto output_stride1 = output.stride(1);
-    auto numel = add_indices.numel();
-    for (int64_t i = 0; i < numel; i++) {
-      at::native::cpublas::axpy<float>(
-          ddim,
-          1,
-          src_data + src_stride0 * select_indices_data[i],
-          src_stride1,
-          output_data + output_stride0 * add_indices_data[i],
-          output_stride1);
+    if (is_fp16) {
+      auto* output_base = output_data + start_idx * ddim;
+      for (size_t i = 0; i < buffer.size(); i++) {
+        output_base[i] = static_cast<data_t>(buffer[i]);
+      }
     }
-  }
+  });
 }
 
-// This function fuses the following three fns:
-// index_select (using select_indices as the index)
-// mul (scaling by per_sample_weights)
-// index_add (using add_indices as the index)
-template<typename data_t, typename index_t>
-static typename std::enable_if<!std::is_same<data_t, float>::value, void>::type
-index_select_scale_add(const Tensor &select_indices,
-                                   const Tensor &add_indices,
-                                   const Tensor &scale,
-                                   const Tensor &src,
-                                   Tensor &output,
-                                   const Tensor& /*offsets*/,
-                                   bool /*include_last_offset*/) {
-  AT_ASSERT(select_indices.numel() == add_indices.numel());
-  auto* add_indices_data = add_indices.data_ptr<index_t>();
-  auto* select_indices_data = select_indices.data_ptr<index_t>();
+// Reduces every bag straight from `offsets`, in parallel over bags, for all
+// modes, dtypes and strides. Rows of upcoming lookups are prefetched, and for
+// MODE_MAX the index of the selected row is recorded per feature in
+// max_indices_data (empty bags keep zeros).
+template <typename data_t, typename index_t>
+void embedding_bag_cpu_per_bag(const Tensor& src,
+                               const index_t* indices_data,
+                               const index_t* offsets_data,
+                               int64_t num_bags,
+                               int64_t mode,
+                               const Tensor& scale,
+                               Tensor& output,
+                               index_t* max_indices_data) {
+  using acc_t = typename EmbeddingBagAccType<data_t>::type;
+  int64_t ddim = src.size(1);
   auto* src_data = src.data_ptr<data_t>();
   auto* output_data = output.data_ptr<data_t>();
-  auto numel = add_indices.numel();
-  int64_t ddim = src.size(1);
   auto src_stride0 = src.stride(0);
   auto src_stride1 = src.stride(1);
   auto output_stride0 = output.stride(0);
   auto output_stride1 = output.stride(1);
-
-  auto* scale_data = scale.data_ptr<data_t>();
-  auto scale_stride = scale.stride(0);
-
-  for (int64_t i = 0; i < numel; i++) {
-    auto* src_base = src_data + src_stride0 * select_indices_data[i];
-    auto* output_base = output_data + output_stride0 * add_indices_data[i];
-    auto scale = scale_data[i * scale_stride];
-    for (int64_t j = 0; j < ddim; j++) {
-      output_base[j * output_stride1] += src_base[j * src_stride1] * scale;
-    }
-  }
-}
-
-template<typename data_t, typename index_t>
-typename std::enable_if<std::is_same<data_t, float>::value, void>::type
-index_select_scale_add(const Tensor &select_indices,
-                                          const Tensor &add_indices,
-                                          const Tensor &scale,
-                                          const Tensor &src,
-                                          Tensor &output,
-                                          const Tensor& offsets,
-                                          bool include_last_offset) {
-  int64_t ddim = src.size(1);
-  auto* scale_data = scale.data_ptr<float>();
-  auto* select_indices_data = select_indices.data_ptr<index_t>();
-  auto* output_data = output.data_ptr<float>();
-
-  if (isFastPathIndexSelectScale(src, scale, output)) {
-    auto src_contig = src.contiguous();
-    auto* src_data = src_contig.data_ptr<float>();
-    int64_t output_size = offsets.numel() - 1;
-    auto* offsets_data = offsets.data_ptr<index_t>();
-    std::vector<index_t> offsets_include_last;
-
-    if (include_last_offset) {
-      output_size = offsets.numel() - 1;
-    } else {
-      output_size = offsets.numel();
-      offsets_include_last.resize(offsets.numel() + 1);
-      std::memcpy(
-          offsets_include_last.data(),
-          offsets.data_ptr<index_t>(),
-          sizeof(index_t) * offsets.numel());
-      offsets_include_last[offsets.numel()] = select_indices.numel();
-      offsets_data = offsets_include_last.data();
-    }
-
-#ifdef USE_FBGEMM
-    auto kernel_fp32_index_t =
-      fbgemm::GenerateEmbeddingSpMDM<float, index_t, index_t>(
-        /* block_size */ddim,
-        /* has_weight */true,
-        /* normalize_by_lengths */false,
-        /* prefetch */16,
-        /* is_weight_positional */false,
-        /* use_offsets */true
-      );
-#endif
-    at::parallel_for(
-        0, output_size, 1, [&](index_t start_idx, index_t end_idx) {
-#ifdef USE_FBGEMM
-          kernel_fp32_index_t(
-            /* output_size */end_idx - start_idx,
-            /* index_size */offsets_data[end_idx] - offsets_data[start_idx],
-            /* data_size */src.size(0),
-            /* input */src_data,
-            /* indices */select_indices_data + offsets_data[start_idx],
-            /* offsets_or_lengths */offsets_data + start_idx,
-            /* weights */scale_data + offsets_data[start_idx],
-            /* output */output_data + start_idx * ddim);
-#else
-          caffe2::EmbeddingLookupIdx(
-              /*block_size=*/ddim,
-              /*output_size=*/end_idx - start_idx,
-              /*index_size=*/offsets_data[end_idx] - offsets_data[start_idx],
-              /*data_size=*/src.size(0),
-              /*input=*/src_data,
-              /*indices=*/select_indices_data + offsets_data[start_idx],
-              /*offsets=*/offsets_data + start_idx,
-              /*weights=*/scale_data + offsets_data[start_idx],
-              /*scale_bias=*/nullptr,
-              /*normalize_by_lengths=*/false,
-              /*out=*/output_data + start_idx * ddim);
-#endif
-        });
-  } else {
-    AT_ASSERT(select_indices.numel() == add_indices.numel());
-    auto* src_data = src.data_ptr<float>();
-    auto* add_indices_data = add_indices.data_ptr<index_t>();
-    auto src_stride0 = src.stride(0);
-    auto src_stride1 = src.stride(1);
-    auto output_stride0 = output.stride(0);
-    auto output_stride1 = output.stride(1);
-    auto scale_stride = scale.stride(0);
-    auto numel = add_indices.numel();
-
-
-    for (int64_t i = 0; i < numel; i++) {
-      auto* src_base = src_data + src_stride0 * select_indices_data[i];
-      auto* output_base = output_data + output_stride0 * add_indices_data[i];
-      auto scale = scale_data[i * scale_stride];
+  const data_t* scale_data = scale.defined() ? scale.data_ptr<data_t>() : nullptr;
+  auto scale_stride = scale.defined() ? scale.stride(0) : 0;
+  // Only rows with unit stride are contiguous cache lines worth prefetching.
+  int64_t row_bytes = src_stride1 == 1 ? ddim * sizeof(data_t) : 0;
+
+  at::parallel_for(0, num_bags, 1, [&](int64_t begin, int64_t end) {
+    std::vector<acc_t> acc(ddim);
+    index_t last_index = offsets_data[end];
+    for (int64_t bag = begin; bag < end; bag++) {
+      index_t bag_start = offsets_data[bag];
+      index_t bag_end = offsets_data[bag + 1];
+      std::fill(acc.begin(), acc.end(), acc_t(0));
+      for (index_t i = bag_start; i < bag_end; i++) {
+        if (row_bytes > 0 && i + kPrefetchDistance < last_index) {
+          prefetch_row(src_data + src_stride0 * indices_data[i + kPrefetchDistance], row_bytes);
+        }
+        auto word_idx = indices_data[i];
+        const data_t* src_base = src_data + src_stride0 * word_idx;
+        if (mode == MODE_MAX) {
+          index_t* max_indices_base = max_indices_data + bag * ddim;
+          bool is_first_for_bag = i == bag_start;
+          for (int64_t j = 0; j < ddim; j++) {
+            acc_t weight_item = static_cast<acc_t>(src_base[j * src_stride1]);
+            if (is_first_for_bag || weight_item > acc[j]) {
+              acc[j] = weight_item;
+              max_indices_base[j] = word_idx;
+            }
+          }
+        } else {
+          acc_t weight = scale_data ? static_cast<acc_t>(scale_data[i * scale_stride]) : acc_t(1);
+          for (int64_t j = 0; j < ddim; j++) {
+            acc[j] += static_cast<acc_t>(src_base[j * src_stride1]) * weight;
+          }
+        }
+      }
+      // Empty bags return all 0s instead of dividing by 0
+      if (mode == MODE_MEAN && bag_end > bag_start) {
+        acc_t bag_size = static_cast<acc_t>(bag_end - bag_start);
+        for (int64_t j = 0; j < ddim; j++) {
+          acc[j] /= bag_size;
+        }
+      }
+      auto* output_base = output_data + output_stride0 * bag;
       for (int64_t j = 0; j < ddim; j++) {
-        output_base[j * output_stride1] += src_base[j * src_stride1] * scale;
+        output_base[j * output_stride1] = static_cast<data_t>(acc[j]);
       }
     }
-  }
+  });
 }
 
 }  // namespace
@@ -327,26 +276,6 @@ static at::Tensor make_bag_size(
   return bag_size;
 }
 
-static Tensor apply_bag_size(const Tensor &offsets, const Tensor &indices,
-                             const int64_t mode, Tensor &output,
-                             const Tensor &bag_size) {
-  if (mode == MODE_MEAN) {
-    // Avoid dividing by 0 for empty bags.
-    // Instead we want empty bags to return all 0s
-    if (offsets.size(0) == 1) {
-      auto bag_size_ = std::max(indices.size(0), static_cast<int64_t>(1));
-      output /= bag_size_;
-    } else {
-      auto bag_size_ = at::max(bag_size, at::ones_like(bag_size, LEGACY_CONTIGUOUS_MEMORY_FORMAT))
-                           .to(output.options())
-                           .unsqueeze(1)
-                           .expand_as(output);
-      output /= bag_size_;
-    }
-  }
-  return output;
-}
-
 static Tensor apply_bag_size_backward(const Tensor &offsets,
                                       const Tensor &indices, const int64_t mode,
                                       Tensor &output, const Tensor &offset2bag,
@@ -365,64 +294,6 @@ static Tensor apply_bag_size_backward(const Tensor &offsets,
   return output;
 }
 
-template <typename scalar_t>
-std::tuple<Tensor, Tensor, Tensor, Tensor> embedding_bag_cpu_max(
-    const Tensor& weight,
-    const Tensor& indices,
-    const Tensor& offset2bag,
-    const Tensor& output,
-    const Tensor& bag_size,
-    const Tensor& offsets,
-    bool include_last_offset) {
-  int64_t numIndices = indices.numel();
-  int64_t numBags = offsets.size(0);
-  int64_t featureSize = weight.size(1);
-  if (include_last_offset) {
-    // Check https://github.com/pytorch/pytorch/issues/29019
-    // We plan to add one more element in offsets, which is equal to the size of
-    // indices. Currently for cuda devices, we still use the legacy
-    // implementation even this flag is enabled.
-    TORCH_CHECK(
-        numBags >= 1, "include_last_offset: numBags should be at least 1");
-    numBags -= 1;
-  }
-  auto max_indices =
-      at::zeros({numBags, featureSize}, indices.options());
-  AT_DISPATCH_INDEX_TYPES(indices.scalar_type(), "embedding_bag_cpu_max", [&] {
-    auto* indices_data = indices.data_ptr<index_t>();
-    auto* offset2bag_data = offset2bag.data_ptr<index_t>();
-
-    auto* max_indices_data = max_indices.data_ptr<index_t>();
-    auto max_indices_stride = max_indices.stride(0);
-
-    auto* weight_data = weight.data_ptr<scalar_t>();
-    auto* output_data = output.data_ptr<scalar_t>();
-    auto weight_stride0 = weight.stride(0);
-    auto weight_stride1 = weight.stride(1);
-    auto output_stride = output.stride(0);
-
-    for (int i = 0; i < numIndices; ++i) {
-      auto bag = offset2bag_data[i];
-      auto word_idx = indices_data[i];
-
-      for (int dim = 0; dim < featureSize; dim++) {
-        auto& current_item = output_data[output_stride * bag + dim];
-        auto weight_item =
-            weight_data[weight_stride0 * word_idx + dim * weight_stride1];
-        bool is_first_for_bag = (i == 0) || offset2bag_data[i - 1] != bag;
-
-        if (is_first_for_bag || weight_item > current_item) {
-          current_item = weight_item;
-          max_indices_data[max_indices_stride * bag + dim] = word_idx;
-        }
-      }
-    }
-  });
-
-  return std::tuple<Tensor, Tensor, Tensor, Tensor>(
-      output, offset2bag, bag_size, max_indices);
-}
-
 // Assumes all input tensors except for `weight` are contiguous.
 // See NOTE [ embedding_bag Native Functions ] in native_functions.yaml for details
 std::tuple<Tensor, Tensor, Tensor, Tensor> _embedding_bag_cpu_impl(
@@ -439,7 +310,7 @@ std::tuple<Tensor, Tensor, Tensor, Tensor> _embedding_bag_cpu_impl(
   checkScalarTypes("embedding_bag", offsets_arg, {kLong, kInt});
   checkSameType("embedding_bag", indices_arg, offsets_arg);
   auto weight_arg = TensorArg(weight, "weight", 1);
-  checkScalarTypes("embedding_bag", weight_arg, {kFloat, kDouble});
+  checkScalarTypes("embedding_bag", weight_arg, {kFloat, kDouble, kHalf, kBFloat16});
 
   AT_DISPATCH_INDEX_TYPES(offsets.scalar_type(), "_embedding_bag_cpu_impl", [&]() {
     index_t offset_0 = offsets.data_ptr<index_t>()[0];
@@ -478,71 +349,48 @@ std::tuple<Tensor, Tensor, Tensor, Tensor> _embedding_bag_cpu_impl(
         "include_last_offset: number of offset should be at least 1");
   }
 
-  auto output = at::empty(
-      {include_last_offset ? offsets.size(0) - 1 : offsets.size(0),
-       weight.size(1)},
-      weight.options());
-
-  // To save compute, if we are going to go down the fast path case for the 'sum'
-  // mode, we skip calculating offset2bag, since it is not going to be used.
-  auto fast_path_sum = [&weight, &per_sample_weights, &output]() {
-    if (per_sample_weights.defined()) {
-      return isFastPathIndexSelectScale(weight, per_sample_weights, output);
-    } else {
-      return isFastPathIndexSelect(weight, output);
-    }
-  };
+  int64_t num_bags = include_last_offset ? offsets.size(0) - 1 : offsets.size(0);
+  auto output = at::empty({num_bags, weight.size(1)}, weight.options());
+  Tensor max_indices;
+  if (mode == MODE_MAX) {
+    max_indices = at::zeros({num_bags, weight.size(1)}, indices.options());
+  }
 
-  // Use an empty 0-element tensor as a sentinel that we have skipped the
-  // creation of offset2bag because autograd chokes when trying to use an
-  // undefined tensor as an input to a backward op.
+  // Every mode reduces bag by bag straight from `offsets`, so offset2bag is
+  // never materialized here; backward recomputes it when it needs it. Use an
+  // empty 0-element tensor as a sentinel for that because autograd chokes
+  // when trying to use an undefined tensor as an input to a backward op.
   Tensor offset2bag = at::empty({0}, offsets.options());
-  if (mode == MODE_MEAN || mode == MODE_MAX || !fast_path_sum()) {
-    // If the last entries are empty, that the last offsets are irrelevant as they
-    // won't change anything in the assignment of ID -> bag, but index_add would
-    // throw out of bounds error. So to keep it simple we just add one more
-    // entry to the end then get rid of it after make_offset2bag.
-    offset2bag = at::zeros(
-       {indices.sizes()[0] + 1}, offsets.options()); // offset2bag = [0 0 0 0 0]
-
-    make_offset2bag(offsets, offset2bag);
-
-    offset2bag.resize_({indices.sizes()[0]});
 
-    // only initialize output in slow path
-    output.zero_();
-  }
-
-  if (mode == MODE_MEAN || mode == MODE_SUM) {
-    // explicitly capture all required variables to work around windows build
-    // TODO: fix this when windows can correctly capture variables in nested lambda
-    AT_DISPATCH_FLOATING_TYPES(weight.scalar_type(), "embedding_bag_cpu",
-      [&indices, &offset2bag, &per_sample_weights, &weight, &output, &offsets, &include_last_offset, &mode]() {
-      AT_DISPATCH_INDEX_TYPES(indices.scalar_type(), "embedding_bag_cpu",
-        [&indices, &offset2bag, &per_sample_weights, &weight, &output, &offsets, &include_last_offset, &mode]() {
-        if (per_sample_weights.defined()) {
-          AT_ASSERT(mode == MODE_SUM);
-          index_select_scale_add<scalar_t, index_t>(
-              indices, offset2bag, per_sample_weights, weight, output, offsets, include_last_offset);
-        } else {
-          index_select_add<scalar_t, index_t>(indices, offset2bag, weight, output, offsets, include_last_offset);
-        }
-      });
-    });
-    auto ret = apply_bag_size(offsets, indices, mode, output, bag_size);
-    return std::tuple<Tensor, Tensor, Tensor, Tensor>(ret, offset2bag, bag_size, bag_size);
-  } else { // MODE_MAX
-    at::optional<Tensor> maybe_per_sample_weights;
-    if (per_sample_weights.defined()) {
-      maybe_per_sample_weights = per_sample_weights;
-    }
-    return AT_DISPATCH_FLOATING_TYPES_AND_HALF(
-      weight.scalar_type(), "embedding_bag_cpu_max", [&]() {
-        return embedding_bag_cpu_max<scalar_t>(
-            weight, indices, offset2bag, output, bag_size, offsets, include_last_offset);
+  // explicitly capture all required variables to work around windows build
+  // TODO: fix this when windows can correctly capture variables in nested lambda
+  AT_DISPATCH_FLOATING_TYPES_AND2(at::ScalarType::Half, at::ScalarType::BFloat16,
+    weight.scalar_type(), "embedding_bag_cpu",
+    [&indices, &per_sample_weights, &weight, &output, &offsets, &include_last_offset,
+      &mode, &num_bags, &max_indices]() {
+    AT_DISPATCH_INDEX_TYPES(indices.scalar_type(), "embedding_bag_cpu",
+      [&indices, &per_sample_weights, &weight, &output, &offsets, &include_last_offset,
+        &mode, &num_bags, &max_indices]() {
+      std::vector<index_t> offsets_storage;
+      const index_t* offsets_data = offsets_include_last<index_t>(
+          offsets, indices.numel(), include_last_offset, offsets_storage);
+      const index_t* indices_data = indices.data_ptr<index_t>();
+      if (isFastPathEmbeddingBag(weight, per_sample_weights, output, mode)) {
+        embedding_bag_cpu_fast_sum<scalar_t, index_t>(
+            weight, indices_data, offsets_data, num_bags,
+            /*normalize_by_lengths=*/mode == MODE_MEAN, per_sample_weights, output);
+      } else {
+        embedding_bag_cpu_per_bag<scalar_t, index_t>(
+            weight, indices_data, offsets_data, num_bags, mode, per_sample_weights, output,
+            mode == MODE_MAX ? max_indices.data_ptr<index_t>() : nullptr);
       }
-    );
+    });
+  });
+
+  if (mode == MODE_MAX) {
+    return std::tuple<Tensor, Tensor, Tensor, Tensor>(output, offset2bag, bag_size, max_indices);
   }
+  return std::tuple<Tensor, Tensor, Tensor, Tensor>(output, offset2bag, bag_size, bag_size);
 }
 
 // embedding_bag wrapper to enforce contiguity in tensors other than `weight`.
@@ -940,5 +788,171 @@ Tensor _embedding_bag_sparse_backward(
   return native::embedding_backward(index_grad, indices, num_weights, -1,
                                     scale_grad_by_freq, true);
 }
+
+DEFINE_DISPATCH(embedding_bag_batched_stub);
+DEFINE_DISPATCH(embedding_bag_batched_backward_stub);
+
+namespace {
+
+// Checks the arguments of the table-batched ops against the layout described
+// in EmbeddingBag.h, and returns the number of tables. `weight` is the tensor
+// holding one row per embedding, i.e. the gradient in the backward.
+int64_t check_embedding_bag_batched_args(
+    const char* name, const Tensor& weight, const Tensor& weight_offsets,
+    const Tensor& indices, const Tensor& offsets, int64_t mode,
+    const Tensor& per_sample_weights) {
+  auto weight_arg = TensorArg(weight, "weight", 1);
+  auto weight_offsets_arg = TensorArg(weight_offsets, "weight_offsets", 2);
+  auto indices_arg = TensorArg(indices, "indices", 3);
+  auto offsets_arg = TensorArg(offsets, "offsets", 4);
+  checkDim(name, weight_arg, 2);
+  checkDim(name, weight_offsets_arg, 1);
+  checkDim(name, indices_arg, 1);
+  checkDim(name, offsets_arg, 1);
+  checkScalarType(name, weight_offsets_arg, kLong);
+  checkScalarTypes(name, indices_arg, {kLong, kInt});
+  checkSameType(name, indices_arg, offsets_arg);
+  for (const Tensor& t : {weight_offsets, indices, offsets}) {
+    TORCH_CHECK(t.device() == weight.device(), name, ": expected all tensors to be on ",
+                weight.device(), ", but got one on ", t.device());
+  }
+  TORCH_CHECK(mode == MODE_SUM || mode == MODE_MEAN,
+              name, ": only mode='sum' and mode='mean' are supported");
+
+  const int64_t num_tables = weight_offsets.numel() - 1;
+  TORCH_CHECK(num_tables >= 1, name, ": expected weight_offsets to hold the first row of every "
+              "table followed by the number of rows, but got ", weight_offsets.numel(), " entries");
+  TORCH_CHECK(offsets.numel() >= 1 && (offsets.numel() - 1) % num_tables == 0,
+              name, ": expected offsets to hold num_tables * batch_size + 1 entries for ",
+              num_tables, " tables, but got ", offsets.numel());
+
+  if (per_sample_weights.defined()) {
+    TORCH_CHECK(mode == MODE_SUM, name, ": per_sample_weights only supported with mode='sum'");
+    auto per_sample_weights_arg = TensorArg(per_sample_weights, "per_sample_weights", 6);
+    checkSameType(name, weight_arg, per_sample_weights_arg);
+    checkDim(name, per_sample_weights_arg, 1);
+    checkNumel(name, per_sample_weights_arg, indices.numel());
+    TORCH_CHECK(per_sample_weights.device() == weight.device(), name, ": expected all tensors to be on ",
+                weight.device(), ", but got one on ", per_sample_weights.device());
+  }
+  return num_tables;
+}
+
+// Groups the index positions by the row of weight they look up, by sorting
+// them on it. See EmbeddingBagBatchedSegments.
+EmbeddingBagBatchedSegments make_embedding_bag_batched_segments(
+    const Tensor& weight_offsets, const Tensor& indices, const Tensor& offsets, int64_t batch_size) {
+  const int64_t num_tables = weight_offsets.numel() - 1;
+  const int64_t num_bags = offsets.numel() - 1;
+  EmbeddingBagBatchedSegments segments;
+  segments.bags = at::repeat_interleave(
+      offsets.narrow(0, 1, num_bags) - offsets.narrow(0, 0, num_bags));
+  TORCH_CHECK(segments.bags.numel() == indices.numel(),
+              "_embedding_bag_batched: expected offsets to start at 0 and end at the number of "
+              "indices, ", indices.numel());
+
+  auto row_starts = weight_offsets.narrow(0, 0, num_tables).repeat_interleave(batch_size);
+  auto rows = indices.to(kLong) + row_starts.index_select(0, segments.bags);
+  Tensor sorted_rows, counts;
+  std::tie(sorted_rows, segments.positions) = rows.sort();
+  std::tie(segments.rows, std::ignore, counts) = at::unique_consecutive(
+      sorted_rows, /*return_inverse=*/false, /*return_counts=*/true);
+  segments.segment_offsets = at::cat({at::zeros({1}, counts.options()), counts.cumsum(0)});
+  return segments;
+}
+
+void embedding_bag_batched_backward_impl(
+    const char* name, Tensor& target, Tensor& momentum, const Tensor& grad_,
+    const Tensor& weight_offsets, const Tensor& indices, const Tensor& offsets_,
+    int64_t mode, const Tensor& per_sample_weights, EmbeddingBagBatchedUpdate update,
+    double lr, double eps) {
+  const int64_t num_tables = check_embedding_bag_batched_args(
+      name, target, weight_offsets, indices, offsets_, mode, per_sample_weights);
+  const int64_t batch_size = (offsets_.numel() - 1) / num_tables;
+  auto grad_arg = TensorArg(grad_, "grad", 1);
+  checkSize(name, grad_arg, {batch_size, num_tables * target.size(1)});
+  checkSameType(name, grad_arg, TensorArg(target, "weight", 2));
+  TORCH_CHECK(grad_.device() == target.device(), name, ": expected all tensors to be on ",
+              target.device(), ", but got one on ", grad_.device());
+  if (indices.numel() == 0 || target.size(1) == 0) {
+    return;
+  }
+
+  auto offsets = offsets_.to(kLong).contiguous();
+  auto segments = make_embedding_bag_batched_segments(
+      weight_offsets.contiguous(), indices.contiguous(), offsets, batch_size);
+  auto grad = grad_.contiguous();
+  embedding_bag_batched_backward_stub(
+      target.device().type(), target, momentum, grad, segments, offsets,
+      per_sample_weights.defined() ? per_sample_weights.contiguous() : per_sample_weights,
+      mode == MODE_MEAN, update, lr, eps);
+}
+
+} // namespace
+
+// Looks up the bags of several tables in one op, see EmbeddingBag.h for the
+// layout of the arguments and of the output.
+Tensor _embedding_bag_batched(
+    const Tensor& weight, const Tensor& weight_offsets, const Tensor& indices,
+    const Tensor& offsets, int64_t mode, const Tensor& per_sample_weights) {
+  const int64_t num_tables = check_embedding_bag_batched_args(
+      "_embedding_bag_batched", weight, weight_offsets, indices, offsets, mode, per_sample_weights);
+  const int64_t batch_size = (offsets.numel() - 1) / num_tables;
+  auto output = at::empty({batch_size, num_tables * weight.size(1)}, weight.options());
+  if (output.numel() != 0) {
+    embedding_bag_batched_stub(
+        weight.device().type(), output, weight.contiguous(), weight_offsets.contiguous(),
+        indices.contiguous(), offsets.contiguous(),
+        per_sample_weights.defined() ? per_sample_weights.contiguous() : per_sample_weights,
+        mode == MODE_MEAN);
+  }
+  return output;
+}
+
+Tensor _embedding_bag_batched_backward(
+    const Tensor& grad, const Tensor& weight_offsets, const Tensor& indices,
+    const Tensor& offsets, int64_t num_weights, int64_t mode,
+    const Tensor& per_sample_weights) {
+  const int64_t num_tables = std::max<int64_t>(weight_offsets.numel() - 1, 1);
+  auto grad_weight = at::zeros({num_weights, grad.size(-1) / num_tables}, grad.options());
+  Tensor momentum;
+  embedding_bag_batched_backward_impl(
+      "_embedding_bag_batched_backward", grad_weight, momentum, grad, weight_offsets, indices,
+      offsets, mode, per_sample_weights, EmbeddingBagBatchedUpdate::Grad, 0, 0);
+  return grad_weight;
+}
+
+// The optimizer steps only touch the rows that were looked up, each with the
+// sum of its gradients over the batch, so the gradient of the whole table is
+// never materialized.
+void _embedding_bag_batched_sgd_update(
+    Tensor& weight, const Tensor& weight_offsets, const Tensor& indices,
+    const Tensor& offsets, const Tensor& grad, int64_t mode,
+    const Tensor& per_sample_weights, double lr) {
+  TORCH_CHECK(weight.is_contiguous(), "_embedding_bag_batched_sgd_update: expected a contiguous weight");
+  Tensor momentum;
+  embedding_bag_batched_backward_impl(
+      "_embedding_bag_batched_sgd_update", weight, momentum, grad, weight_offsets, indices,
+      offsets, mode, per_sample_weights, EmbeddingBagBatchedUpdate::SGD, lr, 0);
+}
+
+void _embedding_bag_batched_rowwise_adagrad_update(
+    Tensor& weight, Tensor& momentum, const Tensor& weight_offsets, const Tensor& indices,
+    const Tensor& offsets, const Tensor& grad, int64_t mode,
+    const Tensor& per_sample_weights, double lr, double eps) {
+  const char* name = "_embedding_bag_batched_rowwise_adagrad_update";
+  TORCH_CHECK(weight.is_contiguous(), name, ": expected a contiguous weight");
+  TORCH_CHECK(momentum.is_contiguous() && momentum.dim() == 1 && momentum.size(0) == weight.size(0),
+              name, ": expected momentum to be a contiguous tensor holding one entry per row of "
+              "weight, but got sizes ", momentum.sizes());
+  // half tables keep their momentum in float
+  const auto momentum_type = weight.scalar_type() == kHalf ? kFloat : weight.scalar_type();
+  TORCH_CHECK(momentum.scalar_type() == momentum_type && momentum.device() == weight.device(),
+              name, ": expected momentum to be a ", momentum_type, " tensor on ", weight.device(),
+              ", but got a ", momentum.scalar_type(), " tensor on ", momentum.device());
+  embedding_bag_batched_backward_impl(
+      name, weight, momentum, grad, weight_offsets, indices, offsets, mode, per_sample_weights,
+      EmbeddingBagBatchedUpdate::RowwiseAdagrad, lr, eps);
+}
 }
 } // namespace at::native
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+// Table-batched embedding bags, see _embedding_bag_batched. The T tables are
+// stacked in one weight of shape [sum of rows, D], and table t owns the rows
+// [weight_offsets[t], weight_offsets[t + 1]). indices holds the lookups of all
+// tables, table-major, with rows local to their table, and offsets holds the
+// T * B + 1 bag boundaries into it, bag t * B + b being sample b of table t.
+// The bags of sample b are written next to each other, into row b of an
+// output of shape [B, T * D].
+
+// The index positions of a backward grouped by the row of weight they read.
+// Segment s covers positions[segment_offsets[s]:segment_offsets[s + 1]], which
+// all look up rows[s]; bags gives the bag of every index position. All of
+// them are int64.
+struct EmbeddingBagBatchedSegments {
+  Tensor rows;
+  Tensor segment_offsets;
+  Tensor positions;
+  Tensor bags;
+};
+
+// What the backward does with the reduced gradient of each looked up row.
+enum class EmbeddingBagBatchedUpdate {
+  Grad,           // write it to the (zero initialized) gradient of the weight
+  SGD,            // weight -= lr * grad
+  RowwiseAdagrad  // momentum += mean(grad^2); weight -= lr * grad / (sqrt(momentum) + eps)
+};
+
+// output, weight, weight_offsets, indices, offsets, per_sample_weights, mean
+using embedding_bag_batched_fn = void(*)(Tensor&, const Tensor&, const Tensor&, const Tensor&,
+                                         const Tensor&, const Tensor&, bool);
+// The target is the gradient of the weight for Grad and the weight otherwise;
+// momentum is only used by RowwiseAdagrad.
+using embedding_bag_batched_backward_fn = void(*)(Tensor& target, Tensor& momentum, const Tensor& grad,
+                                                  const EmbeddingBagBatchedSegments& segments,
+                                                  const Tensor& offsets, const Tensor& per_sample_weights,
+                                                  bool mean, EmbeddingBagBatchedUpdate update,
+                                                  double lr, double eps);
+
+DECLARE_DISPATCH(embedding_bag_batched_fn, embedding_bag_batched_stub);
+DECLARE_DISPATCH(embedding_bag_batched_backward_fn, embedding_bag_batched_backward_stub);
+
+}} // namespace at::native
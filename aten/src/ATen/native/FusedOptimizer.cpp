@@ -0,0 +1,159 @@
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/native/ForeachUtils.h>
+#include <ATen/native/FusedOptimizer.h>
+#include <c10/util/irange.h>
+
+#include <cmath>
+
+namespace at { namespace native {
+
+namespace {
+
+void check_fused_optimizer_lists(TensorList params, TensorList other, const char* name) {
+  TORCH_CHECK(other.size() == params.size(), "Expected as many ", name, " as parameters, got ",
+              other.size(), " and ", params.size());
+  for (const auto i : c10::irange(params.size())) {
+    TORCH_CHECK(other[i].sizes() == params[i].sizes(), "Expected ", name, "[", i, "] to have the size of ",
+                "the parameter, got ", other[i].sizes(), " and ", params[i].sizes());
+  }
+}
+
+// The stubs walk the tensors as flat arrays, which needs all of them to have the same device, dtype
+// and strides, and to be dense. Anything else, e.g. a sparse gradient, runs through the slow path.
+bool can_use_fused_route(TensorList params, std::initializer_list<TensorList> lists) {
+  const auto expected_device = params[0].device();
+  const auto expected_dtype = params[0].scalar_type();
+  if (!(expected_device.is_cpu() || expected_device.is_cuda()) || !at::isFloatingType(expected_dtype)) {
+    return false;
+  }
+  if (expected_device.is_cpu() && expected_dtype != kFloat && expected_dtype != kDouble) {
+    return false;
+  }
+#ifdef __HIP_PLATFORM_HCC__
+  // same as can_use_fast_route
+  if (expected_device.is_cuda()) {
+    return false;
+  }
+#endif
+  for (const auto i : c10::irange(params.size())) {
+    std::vector<Tensor> tensors{params[i]};
+    for (const auto& list : lists) {
+      tensors.push_back(list[i]);
+    }
+    for (const auto& t : tensors) {
+      if (t.scalar_type() != expected_dtype) {
+        return false;
+      }
+    }
+    if (!has_same_attributes(expected_device, tensors)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+DEFINE_DISPATCH(fused_adam_stub);
+DEFINE_DISPATCH(fused_sgd_stub);
+
+void _fused_adam_(TensorList self, TensorList grads, TensorList exp_avgs, TensorList exp_avg_sqs,
+                  TensorList max_exp_avg_sqs, int64_t step, double lr, double beta1, double beta2,
+                  double weight_decay, double eps, bool decoupled_weight_decay) {
+  if (self.empty()) {
+    return;
+  }
+  const bool amsgrad = !max_exp_avg_sqs.empty();
+  check_fused_optimizer_lists(self, grads, "grads");
+  check_fused_optimizer_lists(self, exp_avgs, "exp_avgs");
+  check_fused_optimizer_lists(self, exp_avg_sqs, "exp_avg_sqs");
+  if (amsgrad) {
+    check_fused_optimizer_lists(self, max_exp_avg_sqs, "max_exp_avg_sqs");
+  }
+  TORCH_CHECK(step > 0, "Expected a positive step, got ", step);
+
+  const double bias_correction1 = 1 - std::pow(beta1, step);
+  const double bias_correction2 = 1 - std::pow(beta2, step);
+
+  const bool fused = amsgrad
+      ? can_use_fused_route(self, {grads, exp_avgs, exp_avg_sqs, max_exp_avg_sqs})
+      : can_use_fused_route(self, {grads, exp_avgs, exp_avg_sqs});
+  if (fused) {
+    fused_adam_stub(self[0].device().type(), self, grads, exp_avgs, exp_avg_sqs, max_exp_avg_sqs,
+                    lr, beta1, beta2, weight_decay, eps, bias_correction1, bias_correction2,
+                    decoupled_weight_decay);
+    return;
+  }
+
+  for (const auto i : c10::irange(self.size())) {
+    Tensor param = self[i];
+    Tensor grad = grads[i];
+    Tensor exp_avg = exp_avgs[i];
+    Tensor exp_avg_sq = exp_avg_sqs[i];
+    if (weight_decay != 0) {
+      if (decoupled_weight_decay) {
+        param.mul_(1 - lr * weight_decay);
+      } else {
+        grad = grad.add(param, weight_decay);
+      }
+    }
+    exp_avg.mul_(beta1).add_(grad, 1 - beta1);
+    exp_avg_sq.mul_(beta2).addcmul_(grad, grad, 1 - beta2);
+
+    Tensor denom;
+    if (amsgrad) {
+      Tensor max_exp_avg_sq = max_exp_avg_sqs[i];
+      at::max_out(max_exp_avg_sq, exp_avg_sq, max_exp_avg_sq);
+      denom = (max_exp_avg_sq.sqrt() / std::sqrt(bias_correction2)).add_(eps);
+    } else {
+      denom = (exp_avg_sq.sqrt() / std::sqrt(bias_correction2)).add_(eps);
+    }
+    param.addcdiv_(exp_avg, denom, -lr / bias_correction1);
+  }
+}
+
+void _fused_sgd_(TensorList self, TensorList grads, TensorList momentum_buffers, double lr, double momentum,
+                 double dampening, double weight_decay, bool nesterov, bool is_first_step) {
+  if (self.empty()) {
+    return;
+  }
+  check_fused_optimizer_lists(self, grads, "grads");
+  TORCH_CHECK(momentum == 0 || !momentum_buffers.empty(), "Expected momentum buffers for a non-zero momentum");
+  if (momentum != 0) {
+    check_fused_optimizer_lists(self, momentum_buffers, "momentum_buffers");
+  }
+
+  const bool fused = momentum != 0
+      ? can_use_fused_route(self, {grads, momentum_buffers})
+      : can_use_fused_route(self, {grads});
+  if (fused) {
+    fused_sgd_stub(self[0].device().type(), self, grads, momentum != 0 ? momentum_buffers : TensorList(),
+                   lr, momentum, dampening, weight_decay, nesterov, is_first_step);
+    return;
+  }
+
+  for (const auto i : c10::irange(self.size())) {
+    Tensor param = self[i];
+    Tensor d_p = grads[i];
+    if (weight_decay != 0) {
+      d_p = d_p.add(param, weight_decay);
+    }
+    if (momentum != 0) {
+      Tensor buf = momentum_buffers[i];
+      if (is_first_step) {
+        buf.copy_(d_p);
+      } else {
+        buf.mul_(momentum).add_(d_p, 1 - dampening);
+      }
+      if (nesterov) {
+        d_p = d_p.add(buf, momentum);
+      } else {
+        d_p = buf;
+      }
+    }
+    param.add_(d_p, -lr);
+  }
+}
+
+}} // namespace at::native
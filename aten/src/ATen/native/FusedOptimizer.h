@@ -0,0 +1,22 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+// Single pass optimizer updates over lists of parameters, see _fused_adam_ and _fused_sgd_.
+// All tensors are on the same device, have the same dtype, and corresponding tensors of
+// the lists have the same sizes and strides and are non-overlapping and dense, so that
+// they can be walked as flat arrays. max_exp_avg_sqs is empty unless amsgrad is used,
+// and momentum_buffers is empty when momentum is 0.
+using fused_adam_fn = void(*)(TensorList params, TensorList grads, TensorList exp_avgs, TensorList exp_avg_sqs,
+                              TensorList max_exp_avg_sqs, double lr, double beta1, double beta2, double weight_decay,
+                              double eps, double bias_correction1, double bias_correction2, bool decoupled_weight_decay);
+using fused_sgd_fn = void(*)(TensorList params, TensorList grads, TensorList momentum_buffers, double lr,
+                             double momentum, double dampening, double weight_decay, bool nesterov, bool is_first_step);
+
+DECLARE_DISPATCH(fused_adam_fn, fused_adam_stub);
+DECLARE_DISPATCH(fused_sgd_fn, fused_sgd_stub);
+
+}} // namespace at::native
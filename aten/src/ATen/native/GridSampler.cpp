@@ -17,6 +17,8 @@ using at::native::detail::GridSamplerPadding;
 
 namespace {
 
+  // Scalar implementations of 3D grid sample, used instead of the vectorized
+  // kernels when the gather offsets don't fit in 32 bits.
   template<typename scalar_t>
   Tensor grid_sampler_3d_cpu_impl(const Tensor& input, const Tensor& grid,
                                   GridSamplerInterpolation interpolation_mode,
@@ -759,13 +761,32 @@ DEFINE_DISPATCH(grid_sampler_2d_cpu_kernel);
 Tensor grid_sampler_3d_cpu(const Tensor& input, const Tensor& grid,
                            int64_t interpolation_mode, int64_t padding_mode,
                            bool align_corners) {
-  return AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "grid_sampler3d_cpu", [&] {
-    return grid_sampler_3d_cpu_impl<scalar_t>(
-      input, grid, static_cast<GridSamplerInterpolation>(interpolation_mode),
-      static_cast<GridSamplerPadding>(padding_mode), align_corners);
-  });
+
+  // AVX gather instructions use signed 32-bit offsets to gather float values.
+  // Check for possible overflow and fallback to scalar implementation
+  if (input.scalar_type() == kFloat) {
+    auto sizes = input.sizes();
+    auto strides = input.strides();
+    const auto grid_sW = grid.strides()[3];
+    // NOTE: Gather offsets are only used for the input D, H, W dimensions
+    //       or only for strided access to the grid tensor
+    auto max_gather_offset = std::max(
+      (sizes[2] - 1) * strides[2] + (sizes[3] - 1) * strides[3] + (sizes[4] - 1) * strides[4],
+      grid_sW * (vec256::Vec256<float>::size() - 1));
+
+    if (max_gather_offset > std::numeric_limits<int32_t>::max()) {
+      return grid_sampler_3d_cpu_impl<float>(
+        input, grid, static_cast<GridSamplerInterpolation>(interpolation_mode),
+        static_cast<GridSamplerPadding>(padding_mode), align_corners);
+    }
+  }
+
+  return grid_sampler_3d_cpu_kernel(
+    kCPU, input, grid, interpolation_mode, padding_mode, align_corners);
 }
 
+DEFINE_DISPATCH(grid_sampler_3d_cpu_kernel);
+
 // No shape checking needed here. See # NOTE [ grid_sampler Native Functions ].
 std::tuple<Tensor, Tensor>
 grid_sampler_2d_backward_cpu(const Tensor& grad_output, const Tensor& input, const Tensor& grid,
@@ -804,14 +825,35 @@ DEFINE_DISPATCH(grid_sampler_2d_backward_cpu_kernel);
 std::tuple<Tensor, Tensor>
 grid_sampler_3d_backward_cpu(const Tensor& grad_output, const Tensor& input, const Tensor& grid,
                              int64_t interpolation_mode, int64_t padding_mode, bool align_corners) {
-  return AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "grid_sampler_3d_backward_cpu", [&] {
-    return grid_sampler_3d_backward_cpu_impl<scalar_t>(
-      grad_output, input, grid,
-      static_cast<GridSamplerInterpolation>(interpolation_mode),
-      static_cast<GridSamplerPadding>(padding_mode), align_corners);
-  });
+
+  // AVX gather instructions use signed 32-bit offsets to gather float values.
+  // Check for possible overflow and fallback to scalar implementation
+  if (input.scalar_type() == kFloat) {
+    auto sizes = input.sizes();
+    auto strides = input.strides();
+    const auto grid_sW = grid.strides()[3];
+    // NOTE: The scatter offsets into the contiguous grad_input go up to the
+    //       size of its D, H, W dimensions
+    auto max_gather_offset = std::max(
+      std::max(
+        (sizes[2] - 1) * strides[2] + (sizes[3] - 1) * strides[3] + (sizes[4] - 1) * strides[4],
+        sizes[2] * sizes[3] * sizes[4]),
+      grid_sW * (vec256::Vec256<float>::size() - 1));
+
+    if (max_gather_offset > std::numeric_limits<int32_t>::max()) {
+      return grid_sampler_3d_backward_cpu_impl<float>(
+        grad_output, input, grid,
+        static_cast<GridSamplerInterpolation>(interpolation_mode),
+        static_cast<GridSamplerPadding>(padding_mode), align_corners);
+    }
+  }
+
+  return grid_sampler_3d_backward_cpu_kernel(
+    kCPU, grad_output, input, grid, interpolation_mode, padding_mode, align_corners);
 }
 
+DEFINE_DISPATCH(grid_sampler_3d_backward_cpu_kernel);
+
 Tensor grid_sampler(const Tensor& input, const Tensor& grid,
                     int64_t interpolation_mode, int64_t padding_mode,
                     bool align_corners) {
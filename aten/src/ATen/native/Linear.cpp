@@ -1,5 +1,7 @@
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/native/Activation.h>
+#include <ATen/native/TensorIterator.h>
 #include <ATen/native/xnnpack/Engine.h>
 #include <ATen/WrapDimUtilsMulti.h>
 #include <c10/macros/Macros.h>
@@ -34,6 +36,80 @@ Tensor linear(const Tensor& input, const Tensor& weight, const Tensor& bias) {
   return output;
 }
 
+namespace {
+
+enum class LinearActivation { None, Relu, Gelu };
+
+LinearActivation linear_activation_from_string(const std::string& activation) {
+  if (activation == "none") {
+    return LinearActivation::None;
+  } else if (activation == "relu") {
+    return LinearActivation::Relu;
+  } else if (activation == "gelu") {
+    return LinearActivation::Gelu;
+  }
+  TORCH_CHECK(false, "_linear_activation: expected activation to be one of none, relu or gelu, but got ", activation);
+}
+
+void apply_linear_activation_cpu_(Tensor& output, LinearActivation activation) {
+  if (activation == LinearActivation::Relu) {
+    output.relu_();
+  } else if (activation == LinearActivation::Gelu) {
+    auto iter = TensorIterator::unary_op(output, output);
+    GeluKernel(kCPU, iter);
+  }
+}
+
+// Size of the output rows of one GEMM block of _linear_activation, which
+// should still be in L2 when the activation runs over them
+constexpr int64_t kLinearEpilogueBlockBytes = 256 * 1024;
+
+} // namespace
+
+// linear followed by a pointwise activation. On CPU the GEMM runs on blocks of
+// rows, and the activation is applied to every block of the output right
+// after it is computed, instead of in a second pass over the whole output.
+Tensor _linear_activation(const Tensor& input, const Tensor& weight, const Tensor& bias, std::string activation_) {
+  const auto activation = linear_activation_from_string(activation_);
+  const bool requires_grad = GradMode::is_enabled()
+      && (input.requires_grad() || weight.requires_grad() || (bias.defined() && bias.requires_grad()));
+  // The blocks are written through addmm_out, which autograd does not
+  // support, so gradients go through linear
+  if (requires_grad || !input.device().is_cpu() || input.is_mkldnn() || input.dim() < 2
+      || !at::isFloatingType(input.scalar_type())) {
+    auto output = at::linear(input, weight, bias);
+    if (activation == LinearActivation::Relu) {
+      return at::relu(output);
+    } else if (activation == LinearActivation::Gelu) {
+      return at::gelu(output);
+    }
+    return output;
+  }
+
+  const auto input_2d = input.reshape({-1, input.size(-1)});
+  const auto weight_t = weight.t();
+  const int64_t m = input_2d.size(0);
+  const int64_t n = weight.size(0);
+  auto output = at::empty({m, n}, input.options());
+  const int64_t block_rows = std::max<int64_t>(
+      kLinearEpilogueBlockBytes / std::max<int64_t>(n * input.element_size(), 1), 1);
+  for (int64_t start = 0; start < m; start += block_rows) {
+    const int64_t end = std::min(start + block_rows, m);
+    auto output_block = output.narrow(0, start, end - start);
+    auto input_block = input_2d.narrow(0, start, end - start);
+    if (bias.defined()) {
+      at::addmm_out(output_block, bias, input_block, weight_t);
+    } else {
+      at::mm_out(output_block, input_block, weight_t);
+    }
+    apply_linear_activation_cpu_(output_block, activation);
+  }
+
+  auto output_size = input.sizes().vec();
+  output_size.back() = n;
+  return output.view(output_size);
+}
+
 // sumproduct_pair computes `(left*right).sum(sumdims)` by means of permutation and
 // batch matrix multiplication
 // its main purpose is to provide a pairwise reduction for einsum
@@ -119,8 +119,12 @@ static inline void batchCheckErrors(const Tensor& infos, const char* name, bool
     auto info = infos_data[i];
     if (info < 0) {
       AT_ERROR(name, ": For batch ", i/info_per_batch, ": Argument ", -info, " has illegal value");
-    } else if (!allow_singular && info > 0) {
-      AT_ERROR(name, ": For batch ", i/info_per_batch, ": U(", info, ",", info, ") is zero, singular U.");
+    } else if (info > 0) {
+      if (strstr(name, "symeig") || strstr(name, "syevd")) {
+        AT_ERROR(name, ": For batch ", i/info_per_batch, ": the algorithm failed to converge (error: ", info, ")");
+      } else if (!allow_singular) {
+        AT_ERROR(name, ": For batch ", i/info_per_batch, ": U(", info, ",", info, ") is zero, singular U.");
+      }
     }
   }
 }
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+// The alpha recursion of the CTC loss forward, and the beta recursion and gradient of its backward, on CPU.
+// log_probs is input_length x batch_size x num_labels; the targets of batch item b start at
+// tg_batch_offsets[b] in targets and are tg_target_stride apart, for both concatenated and padded targets.
+using ctc_loss_fn = void(*)(Tensor& neg_log_likelihood, Tensor& log_alpha, const Tensor& log_probs, const Tensor& targets,
+                            IntArrayRef input_lengths, IntArrayRef target_lengths, IntArrayRef tg_batch_offsets,
+                            int64_t tg_target_stride, int64_t BLANK);
+using ctc_loss_backward_fn = void(*)(Tensor& grad, const Tensor& grad_out, const Tensor& log_probs, const Tensor& targets,
+                                     IntArrayRef input_lengths, IntArrayRef target_lengths, IntArrayRef tg_batch_offsets,
+                                     int64_t tg_target_stride, const Tensor& neg_log_likelihood, const Tensor& log_alpha,
+                                     int64_t BLANK, bool zero_infinity);
+
+DECLARE_DISPATCH(ctc_loss_fn, ctc_loss_stub);
+DECLARE_DISPATCH(ctc_loss_backward_fn, ctc_loss_backward_stub);
+
+}} // namespace at::native
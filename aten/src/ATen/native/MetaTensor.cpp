@@ -1,9 +1,23 @@
 #include <ATen/ATen.h>
+#include <ATen/ExpandUtils.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/WrapDimUtils.h>
+#include <ATen/native/ConvUtils.h>
+#include <ATen/native/Pool.h>
+#include <ATen/native/ReduceOpsUtils.h>
+#include <ATen/native/utils/ParamUtils.h>
+#include <c10/util/irange.h>
 
 namespace at {
 namespace native {
 
+// Meta tensors carry sizes, strides and dtype but no storage, so running a
+// model on them computes the shape of every intermediate without touching
+// any data. The kernels below are the shape functions of the operators that
+// aren't structured (structured operators get their meta kernel for free);
+// together with the composite operators built on top of them, they cover
+// what the common inference models need.
+
 Tensor empty_meta(
   IntArrayRef size,
   c10::optional<ScalarType> dtype,
@@ -29,5 +43,403 @@ Tensor empty_meta(
   return tensor;
 }
 
+Tensor empty_strided_meta(
+  IntArrayRef size,
+  IntArrayRef stride,
+  c10::optional<ScalarType> dtype,
+  c10::optional<Layout> layout,
+  c10::optional<Device> device,
+  c10::optional<bool> pin_memory
+) {
+  at::check_size_nonnegative(size);
+  TORCH_CHECK(size.size() == stride.size(), "mismatch in length of strides and shape");
+  auto tensor = at::native::empty_meta({0}, dtype, layout, device, pin_memory, c10::nullopt);
+  tensor.unsafeGetTensorImpl()->set_sizes_and_strides(size, stride);
+  return tensor;
+}
+
+// The views of a meta tensor don't share anything with it but their metadata,
+// there is no storage to alias (or to check the new geometry against).
+Tensor as_strided_meta(const Tensor& self, IntArrayRef size, IntArrayRef stride, optional<int64_t> storage_offset_) {
+  auto storage_offset = storage_offset_.value_or(self.storage_offset());
+  TORCH_CHECK(size.size() == stride.size(), "mismatch in length of strides and shape");
+  TORCH_CHECK(storage_offset >= 0, "Tensor: invalid storage offset ", storage_offset);
+  for (auto val : stride) {
+    TORCH_CHECK(val >= 0,
+                "as_strided: Negative strides are not supported at the moment, "
+                "got strides: ", stride);
+  }
+  auto result = detail::make_tensor<TensorImpl>(self.key_set(), self.dtype(), self.device());
+  result.unsafeGetTensorImpl()->set_storage_offset(storage_offset);
+  result.unsafeGetTensorImpl()->set_sizes_and_strides(size, stride);
+  return result;
+}
+
+Tensor& copy_meta_(Tensor& self, const Tensor& src, bool non_blocking) {
+  TORCH_CHECK(is_expandable_to(src.sizes(), self.sizes()),
+              "copy_: the size of src ", src.sizes(),
+              " is not broadcastable to the size of self ", self.sizes());
+  return self;
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ activations ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+Tensor relu_meta(const Tensor& self) {
+  return at::empty_like(self);
+}
+
+Tensor hardtanh_meta(const Tensor& self, Scalar min_val, Scalar max_val) {
+  return at::empty_like(self);
+}
+
+Tensor gelu_meta(const Tensor& self) {
+  return at::empty_like(self);
+}
+
+// integral inputs are promoted to the default floating point type
+static Tensor unary_float_meta(const Tensor& self) {
+  if (isIntegralType(self.scalar_type(), /*includeBool=*/true)) {
+    return at::empty_like(self, self.options().dtype(c10::typeMetaToScalarType(c10::get_default_dtype())));
+  }
+  return at::empty_like(self);
+}
+
+Tensor sigmoid_meta(const Tensor& self) {
+  return unary_float_meta(self);
+}
+
+Tensor tanh_meta(const Tensor& self) {
+  return unary_float_meta(self);
+}
+
+static Tensor softmax_meta_impl(const Tensor& self, int64_t dim, bool half_to_float, const char* name) {
+  maybe_wrap_dim(dim, self.dim());
+  TORCH_CHECK(!half_to_float || self.scalar_type() == ScalarType::Half,
+              name, " with half to float conversion expects a Half input");
+  if (half_to_float) {
+    return at::empty_like(self, self.options().dtype(ScalarType::Float));
+  }
+  return at::empty_like(self);
+}
+
+Tensor softmax_meta(const Tensor& self, int64_t dim, bool half_to_float) {
+  return softmax_meta_impl(self, dim, half_to_float, "softmax");
+}
+
+Tensor log_softmax_meta(const Tensor& self, int64_t dim, bool half_to_float) {
+  return softmax_meta_impl(self, dim, half_to_float, "log_softmax");
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ blas ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+static void check_mm_meta(const Tensor& self, const Tensor& mat2, const char* name) {
+  TORCH_CHECK(self.dim() == 2, name, ": expected 2D tensor for argument #1 'self' but got ", self.dim(), "D");
+  TORCH_CHECK(mat2.dim() == 2, name, ": expected 2D tensor for argument #2 'mat2' but got ", mat2.dim(), "D");
+  TORCH_CHECK(self.size(1) == mat2.size(0), name, ": mat1 and mat2 shapes cannot be multiplied (",
+              self.size(0), "x", self.size(1), " and ", mat2.size(0), "x", mat2.size(1), ")");
+  TORCH_CHECK(self.scalar_type() == mat2.scalar_type(), name, ": expected mat1 and mat2 to have the same dtype, but got ",
+              self.scalar_type(), " != ", mat2.scalar_type());
+}
+
+Tensor mm_meta(const Tensor& self, const Tensor& mat2) {
+  check_mm_meta(self, mat2, "mm");
+  return at::empty({self.size(0), mat2.size(1)}, self.options());
+}
+
+Tensor addmm_meta(const Tensor& self, const Tensor& mat1, const Tensor& mat2, Scalar beta, Scalar alpha) {
+  check_mm_meta(mat1, mat2, "addmm");
+  TORCH_CHECK(is_expandable_to(self.sizes(), {mat1.size(0), mat2.size(1)}),
+              "addmm: the size of self ", self.sizes(), " is not broadcastable to ",
+              IntArrayRef{mat1.size(0), mat2.size(1)});
+  return at::empty({mat1.size(0), mat2.size(1)}, mat1.options());
+}
+
+Tensor bmm_meta(const Tensor& self, const Tensor& mat2) {
+  TORCH_CHECK(self.dim() == 3, "bmm: expected 3D tensor for argument #1 'batch1' but got ", self.dim(), "D");
+  TORCH_CHECK(mat2.dim() == 3, "bmm: expected 3D tensor for argument #2 'batch2' but got ", mat2.dim(), "D");
+  TORCH_CHECK(self.size(0) == mat2.size(0), "bmm: batch1 and batch2 must have the same number of batches, got ",
+              self.size(0), " and ", mat2.size(0));
+  TORCH_CHECK(self.size(2) == mat2.size(1), "bmm: batch1 and batch2 shapes cannot be multiplied (",
+              self.size(1), "x", self.size(2), " and ", mat2.size(1), "x", mat2.size(2), ")");
+  return at::empty({self.size(0), self.size(1), mat2.size(2)}, self.options());
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ convolution ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// _convolution hands the meta inputs down to convolution_overrideable, the
+// entry point for backends without their own convolution.
+Tensor convolution_overrideable_meta(
+    const Tensor& input, const Tensor& weight, const Tensor& bias,
+    IntArrayRef stride, IntArrayRef padding, IntArrayRef dilation,
+    bool transposed, IntArrayRef output_padding, int64_t groups) {
+  const int64_t k = weight.dim();
+  TORCH_CHECK(k >= 3, "weight should have at least three dimensions");
+  TORCH_CHECK(input.dim() == k, "Expected ", k, "-dimensional input for ", k,
+              "-dimensional weight ", weight.sizes(), ", but got ", input.dim(),
+              "-dimensional input of size ", input.sizes(), " instead");
+  TORCH_CHECK(groups > 0, "non-positive groups is not supported");
+  const int64_t dim = k - 2;
+  auto stride_ = expand_param_if_needed(stride, "stride", dim);
+  auto padding_ = expand_param_if_needed(padding, "padding", dim);
+  auto dilation_ = expand_param_if_needed(dilation, "dilation", dim);
+
+  std::vector<int64_t> output_size;
+  if (!transposed) {
+    TORCH_CHECK(input.size(1) == weight.size(1) * groups,
+                "Given groups=", groups, ", weight of size ", weight.sizes(),
+                ", expected input", input.sizes(), " to have ", weight.size(1) * groups,
+                " channels, but got ", input.size(1), " channels instead");
+    output_size = conv_output_size(input.sizes(), weight.sizes(), padding_, stride_, dilation_);
+  } else {
+    TORCH_CHECK(input.size(1) == weight.size(0),
+                "Given transposed=1, weight of size ", weight.sizes(),
+                ", expected input", input.sizes(), " to have ", weight.size(0),
+                " channels, but got ", input.size(1), " channels instead");
+    auto output_padding_ = expand_param_if_needed(output_padding, "output_padding", dim);
+    output_size = conv_input_size(input.sizes(), weight.sizes(), padding_, output_padding_,
+                                  stride_, dilation_, groups);
+  }
+  for (auto s : output_size) {
+    TORCH_CHECK(s >= 0, "Calculated output size ", IntArrayRef(output_size), " is too small");
+  }
+  const int64_t out_channels = output_size[1];
+  TORCH_CHECK(!bias.defined() || (bias.dim() == 1 && bias.size(0) == out_channels),
+              "Given weight of size ", weight.sizes(), ", expected bias to be 1-dimensional with ",
+              out_channels, " elements, but got bias of size ", bias.sizes(), " instead");
+  return at::empty(output_size, input.options(), input.suggest_memory_format());
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ pooling ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+std::tuple<Tensor, Tensor> max_pool2d_with_indices_meta(
+    const Tensor& input,
+    IntArrayRef kernel_size,
+    IntArrayRef stride,
+    IntArrayRef padding,
+    IntArrayRef dilation,
+    bool ceil_mode) {
+  TORCH_CHECK(kernel_size.size() == 1 || kernel_size.size() == 2,
+    "max_pool2d: kernel_size must either be a single int, or a tuple of two ints")
+  const int kH = safe_downcast<int, int64_t>(kernel_size[0]);
+  const int kW = kernel_size.size() == 1 ? kH : safe_downcast<int, int64_t>(kernel_size[1]);
+
+  TORCH_CHECK(stride.size() == 0 || stride.size() == 1 || stride.size() == 2,
+    "max_pool2d: stride must either be omitted, a single int, or a tuple of two ints")
+  const int dH = stride.empty() ? kH : safe_downcast<int, int64_t>(stride[0]);
+  const int dW = stride.empty() ? kW :
+                 stride.size() == 1 ? dH : safe_downcast<int, int64_t>(stride[1]);
+
+  TORCH_CHECK(padding.size() == 1 || padding.size() == 2,
+    "max_pool2d: padding must be either be a single int, or a tuple of two ints");
+  const int padH = safe_downcast<int, int64_t>(padding[0]);
+  const int padW = padding.size() == 1 ? padH : safe_downcast<int, int64_t>(padding[1]);
+
+  TORCH_CHECK(dilation.size() == 1 || dilation.size() == 2,
+    "max_pool2d: dilation must be either a single int, or a tuple of two ints");
+  const int dilationH = safe_downcast<int, int64_t>(dilation[0]);
+  const int dilationW = dilation.size() == 1 ? dilationH : safe_downcast<int, int64_t>(dilation[1]);
+
+  TORCH_CHECK((input.ndimension() == 3 || input.ndimension() == 4),
+    "non-empty 3D or 4D (batch mode) tensor expected for input");
+
+  const int64_t nInputPlane = input.size(-3);
+  const int64_t inputHeight = input.size(-2);
+  const int64_t inputWidth = input.size(-1);
+  const int64_t outputHeight = pooling_output_shape<int64_t>(inputHeight, kH, padH, dH, dilationH, ceil_mode);
+  const int64_t outputWidth = pooling_output_shape<int64_t>(inputWidth, kW, padW, dW, dilationW, ceil_mode);
+
+  const auto memory_format = input.suggest_memory_format();
+  pool2d_shape_check(
+    input,
+    kH, kW, dH, dW, padH, padW, dilationH, dilationW,
+    nInputPlane,
+    inputHeight, inputWidth,
+    outputHeight, outputWidth, memory_format);
+
+  DimVector output_size(input.sizes().begin(), input.sizes().end() - 2);
+  output_size.push_back(outputHeight);
+  output_size.push_back(outputWidth);
+  return std::make_tuple(
+      at::empty(output_size, input.options(), memory_format),
+      at::empty(output_size, input.options().dtype(kLong), memory_format));
+}
+
+Tensor avg_pool2d_meta(
+    const Tensor& input,
+    IntArrayRef kernel_size,
+    IntArrayRef stride,
+    IntArrayRef padding,
+    bool ceil_mode,
+    bool count_include_pad,
+    c10::optional<int64_t> divisor_override) {
+  TORCH_CHECK(kernel_size.size() == 1 || kernel_size.size() == 2,
+    "avg_pool2d: kernel_size must either be a single int, or a tuple of two ints");
+  const int kH = safe_downcast<int, int64_t>(kernel_size[0]);
+  const int kW = kernel_size.size() == 1 ? kH : safe_downcast<int, int64_t>(kernel_size[1]);
+
+  TORCH_CHECK(stride.empty() || stride.size() == 1 || stride.size() == 2,
+    "avg_pool2d: stride must either be omitted, a single int, or a tuple of two ints");
+  const int dH = stride.empty() ? kH : safe_downcast<int, int64_t>(stride[0]);
+  const int dW = stride.empty() ? kW :
+                 stride.size() == 1 ? dH : safe_downcast<int, int64_t>(stride[1]);
+
+  TORCH_CHECK(padding.size() == 1 || padding.size() == 2,
+    "avg_pool2d: padding must either be a single int, or a tuple of two ints");
+  const int padH = safe_downcast<int, int64_t>(padding[0]);
+  const int padW = padding.size() == 1 ? padH : safe_downcast<int, int64_t>(padding[1]);
+
+  TORCH_CHECK(!divisor_override.has_value() || divisor_override.value() != 0,
+    "divisor must be not zero");
+  TORCH_CHECK((input.ndimension() == 3 || input.ndimension() == 4),
+    "non-empty 3D or 4D (batch mode) tensor expected for input");
+
+  const int64_t nInputPlane = input.size(-3);
+  const int64_t inputHeight = input.size(-2);
+  const int64_t inputWidth = input.size(-1);
+  const int64_t outputHeight = pooling_output_shape<int64_t>(inputHeight, kH, padH, dH, 1, ceil_mode);
+  const int64_t outputWidth = pooling_output_shape<int64_t>(inputWidth, kW, padW, dW, 1, ceil_mode);
+
+  const auto memory_format = input.suggest_memory_format();
+  pool2d_shape_check(
+    input,
+    kH, kW, dH, dW, padH, padW, 1, 1,
+    nInputPlane,
+    inputHeight, inputWidth,
+    outputHeight, outputWidth, memory_format);
+
+  DimVector output_size(input.sizes().begin(), input.sizes().end() - 2);
+  output_size.push_back(outputHeight);
+  output_size.push_back(outputWidth);
+  return at::empty(output_size, input.options(), memory_format);
+}
+
+Tensor adaptive_avg_pool2d_meta(const Tensor& input, IntArrayRef output_size) {
+  TORCH_CHECK(output_size.size() == 2, "adaptive_avg_pool2d: output_size must be 2");
+  TORCH_CHECK((input.ndimension() == 3 || input.ndimension() == 4),
+    "adaptive_avg_pool2d(): Expected 3D or 4D tensor, but got ", input.sizes());
+  for (int64_t i = 0; i < input.ndimension(); i++) {
+    TORCH_CHECK(input.size(i) > 0,
+      "adaptive_avg_pool2d(): Expected input to have non-empty spatial dimensions, "
+      "but input has sizes ", input.sizes(), " with dimension ", i, " being empty");
+  }
+
+  DimVector sizes(input.sizes().begin(), input.sizes().end() - 2);
+  sizes.push_back(output_size[0]);
+  sizes.push_back(output_size[1]);
+  return at::empty(sizes, input.options(), input.suggest_memory_format());
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ normalization ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+std::tuple<Tensor, Tensor, Tensor> batch_norm_meta(
+    const Tensor& input, const Tensor& weight, const Tensor& bias,
+    const Tensor& running_mean, const Tensor& running_var,
+    bool train, double momentum, double eps) {
+  TORCH_CHECK(input.dim() >= 2, "batch_norm: expected at least 2D input, but got ", input.sizes());
+  const int64_t num_features = input.size(1);
+  for (const Tensor* t : {&weight, &bias, &running_mean, &running_var}) {
+    TORCH_CHECK(!t->defined() || t->numel() == num_features,
+                "batch_norm: expected a tensor of ", num_features, " elements but got ", t->sizes());
+  }
+  // the saved statistics are only produced in training mode
+  const int64_t saved_size = train ? num_features : 0;
+  auto options = input.options().dtype(
+      input.scalar_type() == ScalarType::Half || input.scalar_type() == ScalarType::BFloat16
+          ? ScalarType::Float : input.scalar_type());
+  return std::make_tuple(
+      at::empty_like(input, input.options(), input.suggest_memory_format()),
+      at::empty({saved_size}, options),
+      at::empty({saved_size}, options));
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ cat ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+Tensor cat_meta(TensorList tensors, int64_t dim) {
+  TORCH_CHECK(tensors.size() > 0, "expected a non-empty list of Tensors");
+  // size [0] tensors are skipped, like the CPU and CUDA kernels do
+  auto should_skip = [](const Tensor& t) { return t.dim() == 1 && t.size(0) == 0; };
+  const ScalarType high_type = result_type(tensors);
+
+  const Tensor* first = nullptr;
+  for (const auto& t : tensors) {
+    if (!should_skip(t)) {
+      first = &t;
+      break;
+    }
+  }
+  if (!first) {
+    return at::empty({0}, tensors[0].options().dtype(high_type));
+  }
+
+  dim = legacy_cat_wrap_dim(dim, tensors);
+  auto sizes = first->sizes().vec();
+  int64_t cat_dim_size = 0;
+  for (const auto i : c10::irange(tensors.size())) {
+    const Tensor& t = tensors[i];
+    if (should_skip(t)) {
+      continue;
+    }
+    TORCH_CHECK(t.dim() == first->dim(),
+                "Tensors must have same number of dimensions: got ", first->dim(),
+                " and ", t.dim());
+    for (int64_t d = 0; d < t.dim(); d++) {
+      TORCH_CHECK(d == dim || t.size(d) == sizes[d],
+                  "Sizes of tensors must match except in dimension ", dim,
+                  ". Got ", sizes[d], " and ", t.size(d), " in dimension ", d,
+                  " (The offending index is ", i, ")");
+    }
+    cat_dim_size += t.size(dim);
+  }
+  sizes[dim] = cat_dim_size;
+  return at::empty(sizes, first->options().dtype(high_type), first->suggest_memory_format());
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ reductions ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+static Tensor reduction_meta(const Tensor& self, IntArrayRef dim, bool keepdim, ScalarType dtype) {
+  Tensor result;
+  allocate_reduction_result(result, self, make_dim_mask(dim, self.dim()), keepdim, dtype);
+  return result;
+}
+
+static ScalarType sum_meta_dtype(const Tensor& self, c10::optional<ScalarType> dtype) {
+  return dtype.value_or(
+      isIntegralType(self.scalar_type(), /*includeBool=*/true) ? ScalarType::Long : self.scalar_type());
+}
+
+static ScalarType mean_meta_dtype(const Tensor& self, c10::optional<ScalarType> dtype) {
+  const ScalarType result = dtype.value_or(self.scalar_type());
+  TORCH_CHECK(
+      isFloatingType(result) || isComplexType(result),
+      "Can only calculate the mean of floating types. Got ",
+      toString(result),
+      " instead.");
+  return result;
+}
+
+Tensor sum_meta(const Tensor& self, IntArrayRef dim, bool keepdim, c10::optional<ScalarType> dtype) {
+  return reduction_meta(self, dim, keepdim, sum_meta_dtype(self, dtype));
+}
+
+Tensor sum_meta(const Tensor& self, c10::optional<ScalarType> dtype) {
+  return reduction_meta(self, {}, false, sum_meta_dtype(self, dtype));
+}
+
+Tensor mean_meta(const Tensor& self, IntArrayRef dim, bool keepdim, c10::optional<ScalarType> dtype) {
+  return reduction_meta(self, dim, keepdim, mean_meta_dtype(self, dtype));
+}
+
+Tensor mean_meta(const Tensor& self, c10::optional<ScalarType> dtype) {
+  return reduction_meta(self, {}, false, mean_meta_dtype(self, dtype));
+}
+
+Tensor amax_meta(const Tensor& self, IntArrayRef dim, bool keepdim) {
+  return reduction_meta(self, dim, keepdim, self.scalar_type());
+}
+
+Tensor amin_meta(const Tensor& self, IntArrayRef dim, bool keepdim) {
+  return reduction_meta(self, dim, keepdim, self.scalar_type());
+}
+
 } // namespace native
 } // namespace at
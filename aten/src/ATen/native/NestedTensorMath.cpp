@@ -0,0 +1,247 @@
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/NestedTensorImpl.h>
+#include <ATen/WrapDimUtils.h>
+#include <c10/util/irange.h>
+#include <torch/library.h>
+
+namespace at {
+namespace native {
+
+// Conversions between NestedTensors and regular tensors. These are Math
+// functions so that they accept regular tensors coming from any backend.
+
+Tensor _nested_tensor_from_tensor_list(TensorList list) {
+  TORCH_CHECK(!list.empty(), "nested_tensor: expected a non-empty list of tensors");
+  const auto& first = list[0];
+  std::vector<int64_t> offsets{0};
+  offsets.reserve(list.size() + 1);
+  std::vector<Tensor> components;
+  components.reserve(list.size());
+  for (const auto i : c10::irange(list.size())) {
+    const auto& t = list[i];
+    TORCH_CHECK(!isNestedTensor(t), "nested_tensor: expected regular tensors, but component ", i, " is nested");
+    TORCH_CHECK(t.dim() >= 1 && t.dim() == first.dim() && t.sizes().slice(1) == first.sizes().slice(1),
+        "nested_tensor: expected all components to have the same number of dimensions and to only differ ",
+        "in the size of their first dimension, but got ", first.sizes(), " for component 0 and ",
+        t.sizes(), " for component ", i);
+    TORCH_CHECK(t.scalar_type() == first.scalar_type() && t.device() == first.device(),
+        "nested_tensor: expected all components to have the same dtype and device");
+    offsets.push_back(offsets.back() + t.size(0));
+    components.push_back(t.contiguous());
+  }
+  return makeNestedTensor(at::cat(components, 0), std::move(offsets));
+}
+
+Tensor _nested_from_padded(const Tensor& padded, IntArrayRef lengths) {
+  TORCH_CHECK(!isNestedTensor(padded), "from_padded: expected a regular tensor");
+  TORCH_CHECK(padded.dim() >= 2, "from_padded: expected a tensor of size (batch, length, *), but got ",
+      padded.sizes());
+  TORCH_CHECK(static_cast<int64_t>(lengths.size()) == padded.size(0),
+      "from_padded: expected one length per batch element, i.e. ", padded.size(0), ", but got ",
+      lengths.size());
+  std::vector<int64_t> offsets{0};
+  offsets.reserve(lengths.size() + 1);
+  std::vector<Tensor> components;
+  components.reserve(lengths.size());
+  for (const auto i : c10::irange(lengths.size())) {
+    TORCH_CHECK(lengths[i] >= 0 && lengths[i] <= padded.size(1),
+        "from_padded: expected lengths between 0 and ", padded.size(1), ", but got ", lengths[i]);
+    offsets.push_back(offsets.back() + lengths[i]);
+    components.push_back(padded.select(0, i).narrow(0, 0, lengths[i]));
+  }
+  return makeNestedTensor(at::cat(components, 0).contiguous(), std::move(offsets));
+}
+
+Tensor to_padded_tensor(const Tensor& self, double padding) {
+  auto* nt = maybeGetNestedTensorImpl(self);
+  TORCH_CHECK(nt, "to_padded_tensor: expected a NestedTensor");
+  auto result = at::full(self.sizes(), padding, nt->buffer().options());
+  for (const auto i : c10::irange(nt->num_components())) {
+    result.select(0, i).narrow(0, 0, nt->length(i)).copy_(nt->component(i));
+  }
+  return result;
+}
+
+namespace {
+
+// Kernels for DispatchKey::NestedTensor. Rows of the buffer are independent
+// for everything below except softmax over the ragged dimension, so most ops
+// run once on the whole buffer and reuse the offsets of their input.
+
+Tensor wrap_buffer(const NestedTensorImpl* nt, Tensor buffer) {
+  return makeNestedTensor(std::move(buffer), nt->offsets());
+}
+
+template <Tensor (*F)(const Tensor&)>
+Tensor nested_unary(const Tensor& self) {
+  auto* nt = unsafeGetNestedTensorImpl(self);
+  return wrap_buffer(nt, F(nt->buffer()));
+}
+
+Tensor& nested_relu_(Tensor& self) {
+  at::relu_(unsafeGetNestedTensorImpl(self)->buffer());
+  return self;
+}
+
+// Returns what to apply to the buffer of nt in place of operand. A NestedTensor
+// needs the same offsets, so that its rows line up with the rows of nt. A
+// regular tensor may only broadcast over the inner dimensions: its size in the
+// batch and ragged dimensions, if it has them, must be 1.
+Tensor pointwise_operand(const NestedTensorImpl* nt, const Tensor& operand, const char* op) {
+  if (auto* other = maybeGetNestedTensorImpl(operand)) {
+    TORCH_CHECK(other->offsets() == nt->offsets(),
+        op, ": expected NestedTensors with the same component lengths");
+    return other->buffer();
+  }
+  const int64_t nested_dim = nt->dim();
+  const int64_t inner_dim = nested_dim - 2;
+  TORCH_CHECK(operand.dim() <= nested_dim,
+      op, ": expected a tensor with at most ", nested_dim, " dimensions, but got ", operand.sizes());
+  if (operand.dim() <= inner_dim) {
+    return operand;
+  }
+  const int64_t leading = operand.dim() - inner_dim;
+  for (const auto d : c10::irange(leading)) {
+    TORCH_CHECK(operand.size(d) == 1,
+        op, ": can only broadcast a regular tensor over the inner dimensions of a NestedTensor, but got ",
+        operand.sizes(), " for a NestedTensor of size ", nt->sizes());
+  }
+  return operand.reshape(operand.sizes().slice(leading));
+}
+
+// Either operand may be the NestedTensor, e.g. for `2 * nt`
+const NestedTensorImpl* get_nested_operand(const Tensor& self, const Tensor& other) {
+  if (auto* nt = maybeGetNestedTensorImpl(self)) {
+    return nt;
+  }
+  return unsafeGetNestedTensorImpl(other);
+}
+
+Tensor nested_add(const Tensor& self, const Tensor& other, Scalar alpha) {
+  auto* nt = get_nested_operand(self, other);
+  return wrap_buffer(nt, at::add(
+      pointwise_operand(nt, self, "add"), pointwise_operand(nt, other, "add"), alpha));
+}
+
+Tensor nested_sub(const Tensor& self, const Tensor& other, Scalar alpha) {
+  auto* nt = get_nested_operand(self, other);
+  return wrap_buffer(nt, at::sub(
+      pointwise_operand(nt, self, "sub"), pointwise_operand(nt, other, "sub"), alpha));
+}
+
+Tensor nested_mul(const Tensor& self, const Tensor& other) {
+  auto* nt = get_nested_operand(self, other);
+  return wrap_buffer(nt, at::mul(
+      pointwise_operand(nt, self, "mul"), pointwise_operand(nt, other, "mul")));
+}
+
+Tensor nested_div(const Tensor& self, const Tensor& other) {
+  auto* nt = get_nested_operand(self, other);
+  return wrap_buffer(nt, at::div(
+      pointwise_operand(nt, self, "div"), pointwise_operand(nt, other, "div")));
+}
+
+Tensor& nested_add_(Tensor& self, const Tensor& other, Scalar alpha) {
+  auto* nt = maybeGetNestedTensorImpl(self);
+  TORCH_CHECK(nt, "add_: can't add a NestedTensor in-place to a regular tensor");
+  nt->buffer().add_(pointwise_operand(nt, other, "add_"), alpha);
+  return self;
+}
+
+Tensor& nested_mul_(Tensor& self, const Tensor& other) {
+  auto* nt = maybeGetNestedTensorImpl(self);
+  TORCH_CHECK(nt, "mul_: can't multiply a regular tensor in-place by a NestedTensor");
+  nt->buffer().mul_(pointwise_operand(nt, other, "mul_"));
+  return self;
+}
+
+Tensor nested_linear(const Tensor& input, const Tensor& weight, const c10::optional<Tensor>& bias) {
+  auto* nt = unsafeGetNestedTensorImpl(input);
+  TORCH_CHECK(!isNestedTensor(weight) && !(bias.has_value() && isNestedTensor(*bias)),
+      "linear: expected regular tensors for weight and bias");
+  TORCH_CHECK(nt->dim() >= 3, "linear: expected a NestedTensor with at least 3 dimensions, but got ",
+      nt->dim());
+  return wrap_buffer(nt, at::linear(nt->buffer(), weight, bias));
+}
+
+Tensor nested_layer_norm(
+    const Tensor& input,
+    IntArrayRef normalized_shape,
+    const c10::optional<Tensor>& weight,
+    const c10::optional<Tensor>& bias,
+    double eps,
+    bool cudnn_enable) {
+  auto* nt = unsafeGetNestedTensorImpl(input);
+  TORCH_CHECK(static_cast<int64_t>(normalized_shape.size()) <= nt->dim() - 2,
+      "layer_norm: can only normalize over the inner dimensions of a NestedTensor of size ", nt->sizes(),
+      ", but got normalized_shape ", normalized_shape);
+  return wrap_buffer(nt, at::layer_norm(nt->buffer(), normalized_shape, weight, bias, eps, cudnn_enable));
+}
+
+// Softmax over the ragged dimension only sees the elements of each component,
+// i.e. what a masked softmax over the padded form would compute.
+Tensor nested_softmax(const Tensor& self, int64_t dim, bool half_to_float) {
+  auto* nt = unsafeGetNestedTensorImpl(self);
+  dim = maybe_wrap_dim(dim, nt->dim());
+  TORCH_CHECK(dim != 0, "softmax: can't compute softmax over the batch dimension of a NestedTensor");
+  if (dim > 1) {
+    return wrap_buffer(nt, at::_softmax(nt->buffer(), dim - 1, half_to_float));
+  }
+  std::vector<Tensor> components;
+  components.reserve(nt->num_components());
+  for (const auto i : c10::irange(nt->num_components())) {
+    components.push_back(at::_softmax(nt->component(i), 0, half_to_float));
+  }
+  return wrap_buffer(nt, at::cat(components, 0));
+}
+
+std::vector<Tensor> nested_unbind(const Tensor& self, int64_t dim) {
+  auto* nt = unsafeGetNestedTensorImpl(self);
+  dim = maybe_wrap_dim(dim, nt->dim());
+  TORCH_CHECK(dim == 0, "unbind: NestedTensors can only be unbound along their batch dimension");
+  std::vector<Tensor> components;
+  components.reserve(nt->num_components());
+  for (const auto i : c10::irange(nt->num_components())) {
+    components.push_back(nt->component(i));
+  }
+  return components;
+}
+
+Tensor nested_clone(const Tensor& self, c10::optional<MemoryFormat> memory_format) {
+  auto* nt = unsafeGetNestedTensorImpl(self);
+  const auto format = memory_format.value_or(MemoryFormat::Preserve);
+  TORCH_CHECK(format == MemoryFormat::Preserve || format == MemoryFormat::Contiguous,
+      "clone: NestedTensors only support the preserve and contiguous memory formats, but got ", format);
+  return wrap_buffer(nt, nt->buffer().clone());
+}
+
+} // namespace
+
+TORCH_LIBRARY_IMPL(aten, NestedTensor, m) {
+  m.impl("relu", nested_unary<at::relu>);
+  m.impl("relu_", nested_relu_);
+  m.impl("gelu", nested_unary<at::gelu>);
+  m.impl("tanh", nested_unary<at::tanh>);
+  m.impl("sigmoid", nested_unary<at::sigmoid>);
+  m.impl("neg", nested_unary<at::neg>);
+  m.impl("exp", nested_unary<at::exp>);
+  m.impl("abs", nested_unary<at::abs>);
+
+  m.impl("add.Tensor", nested_add);
+  m.impl("sub.Tensor", nested_sub);
+  m.impl("mul.Tensor", nested_mul);
+  m.impl("div.Tensor", nested_div);
+  m.impl("add_.Tensor", nested_add_);
+  m.impl("mul_.Tensor", nested_mul_);
+
+  m.impl("linear", nested_linear);
+  m.impl("layer_norm", nested_layer_norm);
+  m.impl("_softmax", nested_softmax);
+
+  m.impl("unbind.int", nested_unbind);
+  m.impl("clone", nested_clone);
+}
+
+} // namespace native
+} // namespace at
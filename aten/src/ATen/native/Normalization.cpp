@@ -17,6 +17,10 @@ static const int MIOPEN_DIM_MAX = 5;
 namespace at { namespace native {
 
 DEFINE_DISPATCH(batch_norm_cpu_inference_contiguous_stub);
+DEFINE_DISPATCH(batch_norm_cpu_inference_channels_last_stub);
+DEFINE_DISPATCH(batch_norm_cpu_transform_channels_last_stub);
+DEFINE_DISPATCH(batch_norm_cpu_collect_stats_channels_last_stub);
+DEFINE_DISPATCH(batch_norm_cpu_backward_channels_last_stub);
 
 namespace {
   void check_dims_match_num_input_features(const char* arg_name, int64_t expected, int64_t actual){
@@ -30,6 +34,13 @@ namespace {
     }
     return t;
   }
+
+  // Channels last inputs of 4 or 5 dims are (N, HxW, C) in memory, which is
+  // what the channels last kernels work on
+  static inline bool batch_norm_use_channels_last_kernels(const Tensor& input) {
+    return (input.dim() == 4 && input.is_contiguous(at::MemoryFormat::ChannelsLast))
+        || (input.dim() == 5 && input.is_contiguous(at::MemoryFormat::ChannelsLast3d));
+  }
 }
 
 // TensorAccessor when it is defined to work around undefined...
@@ -59,89 +70,6 @@ struct Var {
   }
 };
 
-template<typename scalar_t>
-void batch_norm_cpu_inference_collect_linear_and_constant_terms(
-    scalar_t* alpha, scalar_t* beta, int64_t n_channel,
-    const Tensor& weight /* optional */, const Tensor& bias /* optional */,
-    const Tensor& mean, const Tensor& variance, double eps) {
-
-  const scalar_t* weight_data = weight.defined() ? weight.data_ptr<scalar_t>() : nullptr;
-  const scalar_t* bias_data = bias.defined() ? bias.data_ptr<scalar_t>() : nullptr;
-  const scalar_t* mean_data = mean.data_ptr<scalar_t>();
-  const scalar_t* var_data = variance.data_ptr<scalar_t>();
-
-  /// Collect the linear and constant terms regarding the input.
-  /// output(n, c, h, w)
-  ///     = (input(n, c, h, w) - mean(c)) / sqrt(var(c) + eps) * weight(c)
-  ///         + bias(c)
-  ///     = input(n, c, h, w) * inv_var(c) * weight(c)
-  ///         - mean(c) * inv_var(c) * weight(c) + bias(c),
-  /// where inv_var(c) = 1 / sqrt(var(c) + eps).
-  /// So the linear term, alpha(c) = inv_var(c) * weight(c),
-  ///   the constant term beta(c) = bias(c) - mean(c) * inv_var(c) * weight(c)
-  /// Note that this is only a good idea if (input_size >> c), in degenerate
-  /// cases where image_size == 1 && batch_size == 1, it is slow.
-  for (int64_t c = 0; c < n_channel; c++) {
-    scalar_t inv_var = 1 / std::sqrt(var_data[c] + static_cast<scalar_t>(eps));
-    scalar_t weight_v = weight_data ? weight_data[c] : 1;
-    scalar_t bias_v = bias_data ? bias_data[c] : 0;
-    alpha[c] = inv_var * weight_v;
-    beta[c] = bias_v - mean_data[c] * inv_var * weight_v;
-  }
-}
-
-/// A fast path for CPU inference when all tensors are channels last contiguous.
-/// This code achieves machine bandwidth peak without AVX support.
-/// If this changes for future architectures, we can move it to the cpu/
-/// directory.
-template<typename scalar_t>
-void batch_norm_cpu_inference_channels_last(Tensor& output, const Tensor& input,
-    const Tensor& weight /* optional */, const Tensor& bias /* optional */,
-    const Tensor& mean, const Tensor& variance, double eps) {
-
-  int64_t n_batch = input.size(0);
-  int64_t n_channel = input.size(1);
-  int64_t image_size = input.numel() / n_batch / n_channel;
-
-  scalar_t* output_data = output.data_ptr<scalar_t>();
-  const scalar_t* input_data = input.data_ptr<scalar_t>();
-
-  Tensor alpha = at::empty_like(mean, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
-  Tensor beta = at::empty_like(mean, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
-  scalar_t* alpha_data = alpha.data_ptr<scalar_t>();
-  scalar_t* beta_data = beta.data_ptr<scalar_t>();
-
-  batch_norm_cpu_inference_collect_linear_and_constant_terms<scalar_t>(
-      alpha_data, beta_data, n_channel, weight, bias, mean, variance, eps);
-
-  // Apply the linear terms to the input,
-  // output(n, c, h, w) = input(n, c, h, w) * alpha(c) + beta(c)
-  // No need to use parallel_for as this function is supposed to be
-  // memory-limited.
-  // Keep the loop structure simple to make sure compiler vectorization kicks in.
-  if (n_channel != 1) {
-    for (int64_t n = 0; n < n_batch; ++n) {
-      for (int64_t i = 0; i < image_size; ++i) {
-        for (int64_t c = 0; c < n_channel; ++c) {
-          // Keep all the offset calculation within the inner loop for
-          // simplicity. Compilers are very good at hoisting the common part
-          // outside.
-          int64_t offset = n * image_size * n_channel + i * n_channel + c;
-          output_data[offset] = input_data[offset] * alpha_data[c] + beta_data[c];
-        }
-      }
-    }
-  } else {
-    // n_channel == 1
-    for (int64_t n = 0; n < n_batch; ++n) {
-      for (int64_t i = 0; i < image_size; ++i) {
-        int64_t offset = n * image_size + i;
-        output_data[offset] = input_data[offset] * alpha_data[0] + beta_data[0];
-      }
-    }
-  }
-}
-
 template<typename scalar_t>
 std::tuple<Tensor,Tensor,Tensor> batch_norm_cpu_transform_input_template(
     const Tensor& input, const Tensor& weight, const Tensor& bias,
@@ -158,20 +86,32 @@ std::tuple<Tensor,Tensor,Tensor> batch_norm_cpu_transform_input_template(
 
     Tensor output = at::empty_like(input, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
     batch_norm_cpu_inference_contiguous_stub(kCPU, output, input, weight,
-        bias, running_mean, running_var, eps);
+        bias, running_mean, running_var, eps, /*fuse_relu=*/false);
     return std::make_tuple(output, save_mean, save_invstd);
   }
 
   // Check if we should use the fast path for channel last memory format
-  if (!train && input.is_contiguous(at::MemoryFormat::ChannelsLast)
+  if (!train && batch_norm_use_channels_last_kernels(input)
       && (!weight.defined() || weight.is_contiguous())
       && (!bias.defined() || bias.is_contiguous())
       && running_mean.is_contiguous()
       && running_var.is_contiguous()) {
 
-    Tensor output = at::empty_like(input, at::MemoryFormat::ChannelsLast);
-    batch_norm_cpu_inference_channels_last<scalar_t>(
-      output, input, weight, bias, running_mean, running_var, eps);
+    Tensor output = at::empty_like(input, input.suggest_memory_format());
+    batch_norm_cpu_inference_channels_last_stub(kCPU, output, input, weight,
+        bias, running_mean, running_var, eps, /*fuse_relu=*/false);
+    return std::make_tuple(output, save_mean, save_invstd);
+  }
+
+  // Check if we should use the fast path for channel last memory format in
+  // training, which applies the statistics of the batch
+  if (train && batch_norm_use_channels_last_kernels(input)
+      && (!weight.defined() || weight.is_contiguous())
+      && (!bias.defined() || bias.is_contiguous())) {
+
+    Tensor output = at::empty_like(input, input.suggest_memory_format());
+    batch_norm_cpu_transform_channels_last_stub(kCPU, output, input, weight,
+        bias, save_mean, save_invstd);
     return std::make_tuple(output, save_mean, save_invstd);
   }
 
@@ -230,6 +170,28 @@ std::tuple<Tensor,Tensor> batch_norm_cpu_update_stats_template(
   auto running_mean_a = conditional_accessor_1d<scalar_t>(running_mean);
   auto running_var_a = conditional_accessor_1d<scalar_t>(running_var);
 
+  // A channels last input is reduced along its rows, all channels at once
+  if (batch_norm_use_channels_last_kernels(input)) {
+    Tensor var_sum = at::empty({n_input}, input.options());
+    batch_norm_cpu_collect_stats_channels_last_stub(kCPU, save_mean, var_sum, input);
+    auto var_sum_a = var_sum.accessor<scalar_t, 1>();
+    for (int64_t f = 0; f < n_input; ++f) {
+      scalar_t mean = save_mean_a[f];
+      accscalar_t var_sum_f = var_sum_a[f];
+      save_var_transform_a[f] = VarTransform<accscalar_t>{}(var_sum_f / n, eps);
+
+      // update running averages
+      if (running_mean.defined()) {
+        running_mean_a[f] = momentum * mean + (1 - momentum) * running_mean_a[f];
+      }
+      if (running_var.defined()) {
+        accscalar_t unbiased_var = var_sum_f / (n - 1);
+        running_var_a[f] = momentum * unbiased_var + (1 - momentum) * running_var_a[f];
+      }
+    }
+    return std::make_tuple(save_mean, save_var_transform);
+  }
+
   parallel_for(0, n_input, 1, [&](int64_t b_begin, int64_t b_end) {
     for (int64_t f = b_begin; f < b_end; ++f) {
       Tensor in = input.select(1, f);
@@ -279,6 +241,26 @@ std::tuple<Tensor, Tensor, Tensor> batch_norm_backward_cpu_template(const Tensor
   Tensor grad_input;
   Tensor grad_weight;
   Tensor grad_bias;
+
+  // Check if we should use the fast path for channel last memory format
+  if (batch_norm_use_channels_last_kernels(input)
+      && (!weight.defined() || weight.is_contiguous())) {
+    if (grad_input_mask[0]) {
+      grad_input = at::empty_like(input, input.suggest_memory_format());
+    }
+    if (grad_input_mask[1]) {
+      grad_weight = at::empty_like(weight, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+    }
+    if (grad_input_mask[2]) {
+      grad_bias = at::empty_like(weight, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+    }
+    Tensor mean = train ? save_mean.contiguous() : running_mean.contiguous();
+    Tensor invstd = train ? save_invstd.contiguous() : at::rsqrt(running_var + eps);
+    batch_norm_cpu_backward_channels_last_stub(kCPU, grad_input, grad_weight, grad_bias,
+        grad_out_.contiguous(input.suggest_memory_format()), input, weight, mean, invstd, train);
+    return std::make_tuple(grad_input, grad_weight, grad_bias);
+  }
+
   if (grad_input_mask[0]) {
     grad_input = at::empty_like(input, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
   }
@@ -562,6 +544,46 @@ std::tuple<Tensor, Tensor, Tensor> batch_norm_cpu(const Tensor& self, const Tens
     });
 }
 
+// Inference batch norm followed by a relu in one pass over the input, e.g.
+// for the frozen graphs where the batch norm could not be folded into a conv.
+Tensor batch_norm_relu_inference_cpu(
+    const Tensor& input, const c10::optional<Tensor>& weight_opt, const c10::optional<Tensor>& bias_opt,
+    const Tensor& running_mean, const Tensor& running_var, double eps) {
+  const Tensor& weight = c10::value_or_else(weight_opt, [] {return Tensor();});
+  const Tensor& bias = c10::value_or_else(bias_opt, [] {return Tensor();});
+  TORCH_CHECK(input.dim() >= 2, "_batch_norm_relu_inference: expected an input with at least 2 dims, but got ",
+              input.dim());
+  auto num_features = input.size(1);
+  check_dims_match_num_input_features("running_mean", num_features, running_mean.numel());
+  check_dims_match_num_input_features("running_var", num_features, running_var.numel());
+  if (weight.defined()) {
+    check_dims_match_num_input_features("weight", num_features, weight.numel());
+  }
+  if (bias.defined()) {
+    check_dims_match_num_input_features("bias", num_features, bias.numel());
+  }
+  checkBackend("batch_norm_relu_inference_cpu", {input, weight, bias, running_mean, running_var}, Backend::CPU);
+  if (input.numel() == 0) {
+    return at::empty_like(input);
+  }
+
+  const Tensor weight_c = weight.defined() ? weight.contiguous() : weight;
+  const Tensor bias_c = bias.defined() ? bias.contiguous() : bias;
+  const Tensor running_mean_c = running_mean.contiguous();
+  const Tensor running_var_c = running_var.contiguous();
+  if (batch_norm_use_channels_last_kernels(input)) {
+    Tensor output = at::empty_like(input, input.suggest_memory_format());
+    batch_norm_cpu_inference_channels_last_stub(kCPU, output, input, weight_c,
+        bias_c, running_mean_c, running_var_c, eps, /*fuse_relu=*/true);
+    return output;
+  }
+  const Tensor input_c = input.contiguous();
+  Tensor output = at::empty_like(input_c, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  batch_norm_cpu_inference_contiguous_stub(kCPU, output, input_c, weight_c,
+      bias_c, running_mean_c, running_var_c, eps, /*fuse_relu=*/true);
+  return output;
+}
+
 std::tuple<Tensor, Tensor, Tensor> batch_norm_backward_cpu(const Tensor& grad_out, const Tensor& self, const Tensor& weight,
                                                            const Tensor& running_mean, const Tensor& running_var, const Tensor& save_mean, const Tensor& save_invstd,
                                                            bool train, double eps, std::array<bool,3> grad_input_mask) {
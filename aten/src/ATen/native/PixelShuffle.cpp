@@ -33,6 +33,15 @@ Tensor pixel_shuffle(const Tensor& self, int64_t upscale_factor) {
   int64_t oh = h * upscale_factor;
   int64_t ow = w * upscale_factor;
 
+  if (self.dim() == 4 && self.suggest_memory_format() == at::MemoryFormat::ChannelsLast) {
+    // Shuffle the NHWC data directly, so that the result stays channels last
+    // and is written with a single copy instead of going through NCHW.
+    const int64_t n = self.size(0);
+    const auto input_nhwc = self.permute({0, 2, 3, 1}).reshape({n, h, w, oc, upscale_factor, upscale_factor});
+    const auto output_nhwc = input_nhwc.permute({0, 1, 4, 2, 5, 3}).reshape({n, oh, ow, oc});
+    return output_nhwc.permute({0, 3, 1, 2});
+  }
+
   // First, reshape to split the channels dim from c into 3 separate dims: (oc,
   // upscale_factor, upscale_factor). This allows shuffling to be done next by
   // permuting dims.
@@ -86,6 +95,14 @@ Tensor pixel_unshuffle(const Tensor& self, int64_t downscale_factor) {
   int64_t oh = h / downscale_factor;
   int64_t ow = w / downscale_factor;
 
+  if (self.dim() == 4 && self.suggest_memory_format() == at::MemoryFormat::ChannelsLast) {
+    // Same as pixel_shuffle: unshuffle the NHWC data directly.
+    const int64_t n = self.size(0);
+    const auto input_nhwc = self.permute({0, 2, 3, 1}).reshape({n, oh, downscale_factor, ow, downscale_factor, c});
+    const auto output_nhwc = input_nhwc.permute({0, 1, 3, 5, 2, 4}).reshape({n, oh, ow, oc});
+    return output_nhwc.permute({0, 3, 1, 2});
+  }
+
   // First, reshape to split height dim into (oh, downscale_factor) dims and
   // width dim into (ow, downscale_factor) dims. This allows unshuffling to be
   // done next by permuting dims.
@@ -2,6 +2,7 @@
 #include <ATen/Parallel.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/div_rtn.h>
+#include <ATen/native/DispatchStub.h>
 #include <tuple>
 
 #pragma once
@@ -264,5 +265,39 @@ avg_pool3d_backward_shape_check(
 
 } // namespace
 
+// Window of a 2D (with kernel, stride and dilation 1 and padding 0 in T) or
+// 3D pooling, in T, H, W order
+struct PoolingWindow3D {
+  int64_t kT, kH, kW;
+  int64_t dT, dH, dW;
+  int64_t pT, pH, pW;
+  int64_t dilationT, dilationH, dilationW;
+};
+
+// Kernels for NHWC and NDHWC tensors, vectorized over the channels. The
+// tensors are 4D or 5D and, at the indices, H and W (or T, H and W) are
+// flattened as in the contiguous kernels.
+using max_pool_channels_last_fn = void(*)(Tensor& output, Tensor& indices, const Tensor& input, const PoolingWindow3D& window);
+using max_pool_channels_last_backward_fn = void(*)(Tensor& grad_input, const Tensor& grad_output, const Tensor& indices);
+using avg_pool_channels_last_fn = void(*)(Tensor& output, const Tensor& input, const PoolingWindow3D& window,
+                                          bool count_include_pad, c10::optional<int64_t> divisor_override);
+using avg_pool_channels_last_backward_fn = void(*)(Tensor& grad_input, const Tensor& grad_output, const PoolingWindow3D& window,
+                                                   bool count_include_pad, c10::optional<int64_t> divisor_override);
+DECLARE_DISPATCH(max_pool_channels_last_fn, max_pool_channels_last_kernel);
+DECLARE_DISPATCH(max_pool_channels_last_backward_fn, max_pool_channels_last_backward_kernel);
+DECLARE_DISPATCH(avg_pool_channels_last_fn, avg_pool_channels_last_kernel);
+DECLARE_DISPATCH(avg_pool_channels_last_backward_fn, avg_pool_channels_last_backward_kernel);
+
+// Whether the CPU pooling of input runs the channels last kernels
+static inline bool use_channels_last_pooling(const Tensor& input) {
+  if (!input.device().is_cpu() || !at::isFloatingType(input.scalar_type()) ||
+      input.scalar_type() == at::ScalarType::Half || input.scalar_type() == at::ScalarType::BFloat16) {
+    return false;
+  }
+  auto memory_format = input.suggest_memory_format();
+  return (input.dim() == 4 && memory_format == at::MemoryFormat::ChannelsLast) ||
+      (input.dim() == 5 && memory_format == at::MemoryFormat::ChannelsLast3d);
+}
+
 } // at::native
 } // at
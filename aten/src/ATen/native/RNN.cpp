@@ -4,6 +4,7 @@
 #include <ATen/NativeFunctions.h>
 #include <ATen/core/op_registration/op_registration.h>
 #include <ATen/cpp_custom_type_hack.h>
+#include <ATen/native/mkl/PackedLinear.h>
 #include <ATen/native/quantized/cpu/packed_params.h>
 #include <ATen/native/quantized/cpu/fbgemm_utils.h>
 #include <ATen/native/quantized/cpu/qnnpack_utils.h>
@@ -103,6 +104,8 @@ struct CellParams : public CellParamsBase {
   const Tensor& b_ih_; /* optional */
   const Tensor& b_hh_; /* optional */
   const Tensor& w_hr;  /* only defined for LSTMs with projections */
+  mutable MklPackedLinearWeight w_hh_packed;
+  mutable int64_t linear_hh_calls = 0;
 
   Tensor matmul_ih(const Tensor& input) const override {
     return at::matmul(input, w_ih.t());
@@ -120,6 +123,16 @@ struct CellParams : public CellParamsBase {
     return at::linear(input, w_ih, b_ih_);
   }
   Tensor linear_hh(const Tensor& h) const override {
+    // The recurrent weight is multiplied with the hidden state at every step,
+    // so once it is reused it is packed for MKL for the rest of the layer.
+    if (use_mkl_packed_linear(h, w_hh, b_hh_)) {
+      if (!w_hh_packed.packed.defined() && ++linear_hh_calls > 1) {
+        w_hh_packed = mkl_pack_linear_weight(w_hh, h.size(0));
+      }
+      if (w_hh_packed.packed.defined() && w_hh_packed.rows == h.size(0)) {
+        return mkl_packed_linear(h, w_hh_packed, b_hh_);
+      }
+    }
     return at::linear(h, w_hh, b_hh_);
   }
   const Tensor& b_ih() const override {
@@ -717,6 +730,19 @@ struct SimpleCell : Cell<Tensor, cell_params> {
   }
 };
 
+// Whether the fused CPU kernels in RNNCellKernel.cpp can compute the gates
+// and states of a step from the outputs of its GEMMs. These kernels are not
+// differentiable, so they are only used when no gradient is required.
+bool use_fused_cell_cpu(TensorList tensors) {
+  for (const auto& t : tensors) {
+    if (t.requires_grad() || !t.device().is_cpu() || t.layout() != kStrided || t.dim() != 2 ||
+        t.scalar_type() != tensors[0].scalar_type()) {
+      return false;
+    }
+  }
+  return tensors[0].scalar_type() == kFloat || tensors[0].scalar_type() == kDouble;
+}
+
 // TODO: can use inplace ops?
 template <typename cell_params>
 struct LSTMCell : Cell<std::tuple<Tensor, Tensor>, cell_params> {
@@ -744,6 +770,13 @@ struct LSTMCell : Cell<std::tuple<Tensor, Tensor>, cell_params> {
 
     const auto gates = params.linear_hh(hx).add_(
         pre_compute_input ? input : params.linear_ih(input));
+    if (use_fused_cell_cpu({gates, cx})) {
+      const auto cx_contig = cx.contiguous();
+      auto hy = at::empty_like(cx_contig);
+      auto cy = at::empty_like(cx_contig);
+      lstm_cell_cpu_stub(kCPU, hy, cy, gates.contiguous(), cx_contig);
+      return std::make_tuple(params.matmul_hr(hy), std::move(cy));
+    }
     auto chunked_gates = gates.unsafe_chunk(4, 1);
     auto ingate = chunked_gates[0].sigmoid_();
     auto forgetgate = chunked_gates[1].sigmoid_();
@@ -775,10 +808,16 @@ struct GRUCell : Cell<Tensor, cell_params> {
       // Slice off the workspace argument (it's needed only for AD).
       return std::move(std::get<0>(result));
     }
-    const auto chunked_igates = pre_compute_input
-        ? input.unsafe_chunk(3, 1)
-        : params.linear_ih(input).unsafe_chunk(3, 1);
-    auto chunked_hgates = params.linear_hh(hidden).unsafe_chunk(3, 1);
+    const auto igates = pre_compute_input ? input : params.linear_ih(input);
+    const auto hgates = params.linear_hh(hidden);
+    if (use_fused_cell_cpu({igates, hgates, hidden})) {
+      const auto hx = hidden.contiguous();
+      auto hy = at::empty_like(hx);
+      gru_cell_cpu_stub(kCPU, hy, igates.contiguous(), hgates.contiguous(), hx);
+      return hy;
+    }
+    const auto chunked_igates = igates.unsafe_chunk(3, 1);
+    auto chunked_hgates = hgates.unsafe_chunk(3, 1);
     const auto reset_gate =
         chunked_hgates[0].add_(chunked_igates[0]).sigmoid_();
     const auto input_gate =
@@ -1425,6 +1464,8 @@ DEFINE_DISPATCH(lstm_cudnn_stub);
 DEFINE_DISPATCH(lstm_packed_cudnn_stub);
 DEFINE_DISPATCH(lstm_miopen_stub);
 DEFINE_DISPATCH(lstm_packed_miopen_stub);
+DEFINE_DISPATCH(lstm_cell_cpu_stub);
+DEFINE_DISPATCH(gru_cell_cpu_stub);
 REGISTER_NO_CPU_DISPATCH(lstm_cudnn_stub, lstm_fn);
 REGISTER_NO_CPU_DISPATCH(lstm_packed_cudnn_stub, lstm_packed_fn);
 REGISTER_NO_CPU_DISPATCH(lstm_miopen_stub, lstm_fn);
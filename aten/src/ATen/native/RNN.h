@@ -27,6 +27,15 @@ DECLARE_DISPATCH(rnn_packed_fn, rnn_tanh_packed_miopen_stub);
 DECLARE_DISPATCH(rnn_packed_fn, rnn_relu_packed_cudnn_stub);
 DECLARE_DISPATCH(rnn_packed_fn, rnn_relu_packed_miopen_stub);
 
+// Fused gate and state update of a single LSTM or GRU step on CPU, after the
+// GEMMs. They are not differentiable and are only used when no gradient is
+// required. All tensors are contiguous.
+using lstm_cell_fn = void(*)(Tensor& hy, Tensor& cy, const Tensor& gates, const Tensor& cx);
+using gru_cell_fn = void(*)(Tensor& hy, const Tensor& igates, const Tensor& hgates, const Tensor& hx);
+
+DECLARE_DISPATCH(lstm_cell_fn, lstm_cell_cpu_stub);
+DECLARE_DISPATCH(gru_cell_fn, gru_cell_cpu_stub);
+
 inline void check_attributes(const Tensor& input, const TensorList& params, const TensorList& hiddens, bool check_dtype=false) {
   auto input_device = input.device();
   auto input_dtype = input.scalar_type();
@@ -2,6 +2,7 @@
 #include <ATen/AccumulateType.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/Parallel.h>
+#include <ATen/ExpandUtils.h>
 #include <ATen/TensorUtils.h>
 #include <ATen/WrapDimUtils.h>
 #include <ATen/native/cpu/SoftmaxKernel.h>
@@ -134,9 +135,7 @@ Tensor softmax_cpu(const Tensor& input_, const int64_t dim_, const bool half_to_
   if (input.ndimension() > 0 && dim == input.ndimension() - 1) {
     softmax_lastdim_kernel(kCPU, output, input);
   } else {
-    AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "softmax", [&] {
-      host_softmax<scalar_t, false>(output, input, dim);
-    });
+    softmax_kernel(kCPU, output, input, dim);
   }
   return output;
 }
@@ -157,10 +156,10 @@ Tensor log_softmax_cpu(const Tensor& input_, const int64_t dim_, const bool half
       "dim must be non-negative and less than input dimensions");
   if (input.ndimension() > 0 && dim == input.ndimension() - 1) {
     log_softmax_lastdim_kernel(kCPU, output, input);
+  } else if (input.scalar_type() == at::ScalarType::BFloat16) {
+    host_softmax<BFloat16, true>(output, input, dim);
   } else {
-    AT_DISPATCH_FLOATING_TYPES_AND(
-        at::ScalarType::BFloat16, input.scalar_type(), "log_softmax",
-        [&] { host_softmax<scalar_t, true>(output, input, dim); });
+    log_softmax_kernel(kCPU, output, input, dim);
   }
   return output;
 }
@@ -277,10 +276,37 @@ Tensor log_softmax(const Tensor& input_, const int64_t dim_, c10::optional<Scala
   return result;
 }
 
+Tensor scaled_masked_softmax(const Tensor& self, const Tensor& mask, double scale, int64_t dim_) {
+  TORCH_CHECK(
+      is_expandable_to(mask.sizes(), self.sizes()),
+      "_scaled_masked_softmax: mask of shape ", mask.sizes(),
+      " is not broadcastable to input of shape ", self.sizes());
+  int64_t dim = maybe_wrap_dim(dim_, self.dim());
+  // The fused kernel reads the mask in place, including broadcast views
+  bool use_fused_kernel = self.device().is_cpu() && self.dim() > 0 &&
+      dim == self.dim() - 1 && self.numel() > 0 &&
+      (self.scalar_type() == kFloat || self.scalar_type() == kDouble) &&
+      mask.scalar_type() == self.scalar_type() && mask.device() == self.device();
+  if (!use_fused_kernel) {
+    return at::_softmax(self * scale + mask, dim, false);
+  }
+  auto input = self.contiguous();
+  auto expanded_mask = mask.expand(input.sizes());
+  if (expanded_mask.stride(-1) != 1) {
+    expanded_mask = expanded_mask.contiguous();
+  }
+  Tensor output = at::native::empty_like(input, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  scaled_masked_softmax_lastdim_kernel(kCPU, output, input, expanded_mask, scale);
+  return output;
+}
+
 DEFINE_DISPATCH(softmax_lastdim_kernel);
 DEFINE_DISPATCH(log_softmax_lastdim_kernel);
 DEFINE_DISPATCH(softmax_backward_lastdim_kernel);
 DEFINE_DISPATCH(log_softmax_backward_lastdim_kernel);
+DEFINE_DISPATCH(softmax_kernel);
+DEFINE_DISPATCH(log_softmax_kernel);
+DEFINE_DISPATCH(scaled_masked_softmax_lastdim_kernel);
 
 Tensor softmax(const Tensor& self, Dimname dim, optional<ScalarType> dtype) {
   return at::softmax(self, dimname_to_position(self, dim), dtype);
@@ -2,11 +2,51 @@
 
 #include <ATen/ATen.h>
 #include <ATen/Dispatch.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/Parallel.h>
 
+#include <cmath>
 #include <tuple>
 
 namespace at { namespace native {
 
+namespace {
+
+// Accumulates weight_of(i) into bin bin_of(i) for every i in [0, numel), and
+// returns the histogram as an acc_t tensor of nbins elements. Negative bins
+// are skipped. Every thread fills its own partial histogram, and the partials
+// are summed at the end; when they would hold more elements than the input,
+// one thread does the whole pass instead.
+template <typename acc_t, typename BinOp, typename WeightOp>
+Tensor parallel_histogram(int64_t numel, int64_t nbins, ScalarType acc_type,
+                          const BinOp& bin_of, const WeightOp& weight_of) {
+  const int64_t num_threads = at::get_num_threads();
+  const bool parallel = numel >= at::internal::GRAIN_SIZE && nbins * num_threads <= numel;
+  auto partials = at::zeros({parallel ? num_threads : 1, nbins}, at::dtype(acc_type));
+  acc_t* partials_data = partials.data_ptr<acc_t>();
+  auto accumulate = [&](int64_t begin, int64_t end, acc_t* hist) {
+    for (int64_t i = begin; i < end; i++) {
+      const int64_t bin = bin_of(i);
+      if (bin >= 0) {
+        hist[bin] += weight_of(i);
+      }
+    }
+  };
+  if (!parallel) {
+    accumulate(0, numel, partials_data);
+    return partials[0];
+  }
+  at::parallel_for(0, numel, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    const int64_t tid = at::get_thread_num();
+    TORCH_CHECK(tid < num_threads,
+                "expect thread id smaller than ", num_threads, ", got thread id ", tid);
+    accumulate(begin, end, partials_data + tid * nbins);
+  });
+  return partials.sum(0);
+}
+
+} // namespace
+
 ///////////////// bincount /////////////////
 namespace {
 
@@ -21,7 +61,12 @@ Tensor _bincount_cpu_template(
   if (self.dim() == 1 && self.numel() == 0) {
     return native::zeros({minlength}, kLong);
   }
-  if (self.dim() != 1 || *self.min().data_ptr<input_t>() < 0) {
+  if (self.dim() != 1) {
+    AT_ERROR("bincount only supports 1-d non-negative integral inputs.");
+  }
+  Tensor min, max;
+  std::tie(min, max) = at::_aminmax(self);
+  if (*min.data_ptr<input_t>() < 0) {
     AT_ERROR("bincount only supports 1-d non-negative integral inputs.");
   }
 
@@ -32,23 +77,19 @@ Tensor _bincount_cpu_template(
 
   Tensor output;
   int64_t self_size = self.size(0);
-  int64_t nbins = static_cast<int64_t>(*self.max().data_ptr<input_t>()) + 1L;
+  int64_t nbins = static_cast<int64_t>(*max.data_ptr<input_t>()) + 1L;
   nbins = std::max(nbins, minlength); // at least minlength # of bins
 
   const input_t* self_p = self.data_ptr<input_t>();
+  auto bin_of = [self_p](int64_t i) -> int64_t { return self_p[i]; };
   if (has_weights) {
-    output = native::zeros({nbins}, weights.options());
-    weights_t* output_p = output.data_ptr<weights_t>();
     const weights_t* weights_p = weights.data_ptr<weights_t>();
-    for (int64_t i = 0; i < self_size; i++) {
-      output_p[self_p[i]] += weights_p[i];
-    }
+    output = parallel_histogram<weights_t>(
+        self_size, nbins, weights.scalar_type(), bin_of,
+        [weights_p](int64_t i) { return weights_p[i]; });
   } else {
-    output = native::zeros({nbins}, kLong);
-    int64_t* output_p = output.data_ptr<int64_t>();
-    for (int64_t i = 0; i < self_size; i++) {
-      output_p[self_p[i]] += 1L;
-    }
+    output = parallel_histogram<int64_t>(
+        self_size, nbins, kLong, bin_of, [](int64_t /*i*/) { return int64_t(1); });
   }
   return output;
 }
@@ -65,4 +106,59 @@ _bincount_cpu(const Tensor& self, const Tensor& weights, int64_t minlength) {
   });
 }
 
+///////////////// histc /////////////////
+namespace {
+
+template <typename input_t>
+void histc_cpu_template(Tensor& hist, const Tensor& self, int64_t nbins, Scalar min, Scalar max) {
+  input_t minval = min.to<input_t>();
+  input_t maxval = max.to<input_t>();
+  if (minval == maxval) {
+    Tensor self_min, self_max;
+    std::tie(self_min, self_max) = at::_aminmax(self);
+    minval = self_min.item<input_t>();
+    maxval = self_max.item<input_t>();
+  }
+  if (minval == maxval) {
+    minval = minval - 1;
+    maxval = maxval + 1;
+  }
+  TORCH_CHECK(!(std::isinf(minval) || std::isinf(maxval) || std::isnan(minval) || std::isnan(maxval)),
+              "range of [", minval, ", ", maxval, "] is not finite");
+  TORCH_CHECK(minval < maxval, "max must be larger than min");
+
+  // Counted in int64 whatever the dtype, so large bins are exact
+  const auto input = self.contiguous();
+  const input_t* input_data = input.data_ptr<input_t>();
+  auto bin_of = [=](int64_t i) -> int64_t {
+    const input_t value = input_data[i];
+    // 'nan' values fail both comparisons and are not counted
+    if (!(value >= minval && value <= maxval)) {
+      return -1;
+    }
+    const int64_t bin = static_cast<int64_t>((value - minval) / (maxval - minval) * nbins);
+    return std::min(bin, nbins - 1);
+  };
+  hist.copy_(parallel_histogram<int64_t>(
+      input.numel(), nbins, kLong, bin_of, [](int64_t /*i*/) { return int64_t(1); }));
+}
+
+} // namespace
+
+Tensor& histc_out_cpu(Tensor& hist, const Tensor& self, int64_t nbins, Scalar min, Scalar max) {
+  TORCH_CHECK(nbins > 0, "bins must be > 0");
+  TORCH_CHECK(hist.scalar_type() == self.scalar_type(),
+              "histc: expected out to have dtype ", self.scalar_type(), ", but got ", hist.scalar_type());
+  hist.resize_({nbins});
+  AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "histc_cpu", [&] {
+    histc_cpu_template<scalar_t>(hist, self, nbins, min, max);
+  });
+  return hist;
+}
+
+Tensor histc_cpu(const Tensor& self, int64_t nbins, Scalar min, Scalar max) {
+  Tensor hist = at::empty({0}, self.options(), MemoryFormat::Contiguous);
+  return histc_out_cpu(hist, self, nbins, min, max);
+}
+
 }} // namespace at::native
@@ -61,6 +61,7 @@
 #include <ATen/Parallel.h>
 
 #include <algorithm>
+#include <cstring>
 #include <functional>
 #include <numeric>
 #include <vector>
@@ -76,6 +77,7 @@ REGISTER_NO_CPU_DISPATCH(index_put_accum_stub, index_put_accum_fn);
 DEFINE_DISPATCH(masked_select_serial_stub);
 DEFINE_DISPATCH(masked_select_stub);
 DEFINE_DISPATCH(masked_scatter_stub);
+DEFINE_DISPATCH(nonzero_stub);
 
 DEFINE_DISPATCH(gather_stub);
 DEFINE_DISPATCH(scatter_stub);
@@ -416,6 +418,81 @@ Tensor index_copy(const Tensor & self, int64_t dim, const Tensor & index, const
 }
 
 
+namespace {
+
+// [parallel index accumulation]
+// index_add_ adds source slices into self slices chosen by an index that may
+// contain duplicates, so it cannot simply split the index across threads. We
+// instead sort the positions of the index by destination, keeping the order
+// of positions with the same destination, and split the sorted positions
+// across threads at destination boundaries. Every destination is then
+// accumulated by one thread in the original order, so the result is the
+// same, bit for bit, as the serial loop.
+//
+// Dense indices, with about as many entries as destinations, are sorted with
+// a counting sort in O(numel + dim_size). Sparse ones, e.g. a few rows of a
+// large embedding table, use a stable comparison sort instead so that we
+// don't pay for every destination.
+struct IndexGroups {
+  // positions of the index, sorted by destination
+  std::vector<int64_t> positions;
+  // destinations[i] is the index value at positions[i]
+  std::vector<int64_t> destinations;
+};
+
+constexpr int64_t kDenseIndexFactor = 4;
+
+template <typename index_t>
+IndexGroups group_by_destination(const index_t* index_data, int64_t numel, int64_t dim_size) {
+  for (int64_t i = 0; i < numel; i++) {
+    TORCH_CHECK_INDEX((index_data[i] >= 0) && (index_data[i] < dim_size), "index out of range in self");
+  }
+  IndexGroups groups;
+  groups.positions.resize(numel);
+  groups.destinations.resize(numel);
+  if (dim_size <= kDenseIndexFactor * numel) {
+    std::vector<int64_t> offsets(dim_size + 1, 0);
+    for (int64_t i = 0; i < numel; i++) {
+      offsets[index_data[i] + 1]++;
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    for (int64_t i = 0; i < numel; i++) {
+      groups.positions[offsets[index_data[i]]++] = i;
+    }
+  } else {
+    std::iota(groups.positions.begin(), groups.positions.end(), 0);
+    std::stable_sort(groups.positions.begin(), groups.positions.end(),
+        [index_data](int64_t a, int64_t b) { return index_data[a] < index_data[b]; });
+  }
+  for (int64_t i = 0; i < numel; i++) {
+    groups.destinations[i] = index_data[groups.positions[i]];
+  }
+  return groups;
+}
+
+// Calls f(begin, end) on ranges of groups.positions that hold whole groups
+// of equal destinations, in parallel.
+template <typename F>
+void parallel_for_destinations(const IndexGroups& groups, int64_t grain_size, const F& f) {
+  const int64_t numel = groups.positions.size();
+  const int64_t* dest = groups.destinations.data();
+  at::parallel_for(0, numel, grain_size, [&](int64_t begin, int64_t end) {
+    // A group belongs to the range it starts in.
+    while (begin < end && begin > 0 && dest[begin] == dest[begin - 1]) {
+      begin++;
+    }
+    if (begin == end) {
+      return;
+    }
+    while (end < numel && dest[end] == dest[end - 1]) {
+      end++;
+    }
+    f(begin, end);
+  });
+}
+
+} // namespace
+
 Tensor& index_add_cpu_(Tensor & self, int64_t dim, const Tensor & index, const Tensor & source) {
   dim = maybe_wrap_dim(dim, self.dim());
 
@@ -452,6 +529,32 @@ Tensor& index_add_cpu_(Tensor & self, int64_t dim, const Tensor & index, const T
     auto self_stride_bytes = self.stride(dim) * elementSize(self.scalar_type());
     auto source_stride_bytes = source.stride(dim) * elementSize(source.scalar_type());
     auto self_dim_size = self.size(dim);
+    auto slice_numel = selfSlice.numel();
+
+    // Large slices are already added in parallel by add_stub. Small ones go
+    // through the grouped path, see [parallel index accumulation].
+    if (numel > 1 && at::get_num_threads() > 1 && !at::in_parallel_region() &&
+        slice_numel < internal::GRAIN_SIZE && numel * slice_numel >= internal::GRAIN_SIZE) {
+      AT_DISPATCH_INDEX_TYPES(index.scalar_type(), "index_add_cpu_", [&] () {
+        auto groups = group_by_destination(index_contig.data_ptr<index_t>(), numel, self_dim_size);
+        auto self_base = static_cast<char*>(selfSlice.data_ptr());
+        auto source_base = static_cast<char*>(sourceSlice.data_ptr());
+        parallel_for_destinations(groups, std::max<int64_t>(1, internal::GRAIN_SIZE / slice_numel),
+            [&](int64_t begin, int64_t end) {
+          auto iter = TensorIterator::binary_op(selfSlice, selfSlice, sourceSlice);
+          for (auto i = begin; i < end; i++) {
+            auto self_data = self_base + groups.destinations[i] * self_stride_bytes;
+            auto source_data = source_base + groups.positions[i] * source_stride_bytes;
+            iter.unsafe_replace_operand(0, self_data);
+            iter.unsafe_replace_operand(1, self_data);
+            iter.unsafe_replace_operand(2, source_data);
+            add_stub(iter.device_type(), iter, 1);
+          }
+        });
+      });
+      return self;
+    }
+
     auto iter = TensorIterator::binary_op(selfSlice, selfSlice, sourceSlice);
 
     AT_DISPATCH_INDEX_TYPES(index.scalar_type(), "index_add_cpu_", [&] () {
@@ -505,75 +608,134 @@ static void check_indexarray_range(
     const IndexType* indices,
     int64_t n,
     IndexType indexing_axis_dim) {
-  for (auto i = 0; i < n; ++i) {
+  for (int64_t i = 0; i < n; ++i) {
     auto idx = indices[i];
-    TORCH_CHECK(
+    TORCH_CHECK_INDEX(
         0 <= idx && idx < indexing_axis_dim,
-        "INDICES element is out of DATA bounds, id=",
+        "index out of range in self, id=",
         idx,
         " axis_dim=",
         indexing_axis_dim);
   }
 }
 
-Tensor & index_select_out_cpu_dim1_(
-    Tensor & result_contig, const Tensor & self, const Tensor & index_contig) {
+// Rows gathered by index_select_out_cpu_rows_ are prefetched this many
+// lookups ahead, up to kIndexSelectPrefetchMaxBytes of every row: the hardware
+// prefetcher follows the rest of a longer row once it is being copied.
+constexpr int64_t kIndexSelectPrefetchDistance = 8;
+constexpr int64_t kIndexSelectPrefetchMaxBytes = 512;
+constexpr int64_t kIndexSelectCacheLineSize = 64;
+
+static inline void prefetch_index_select_row(const char* row, int64_t bytes) {
+#if defined(__GNUC__) || defined(__clang__)
+  for (int64_t b = 0; b < bytes; b += kIndexSelectCacheLineSize) {
+    __builtin_prefetch(row + b, /*rw=*/0, /*locality=*/1);
+  }
+#endif
+}
+
+// Copies rows of a size known at compile time, which saves the call to
+// memcpy for the rows of a single element.
+template <int64_t kRowBytes>
+struct IndexSelectFixedRowCopy {
+  void operator()(char* dst, const char* src, int64_t /*row_bytes*/) const {
+    std::memcpy(dst, src, kRowBytes);
+  }
+};
+
+struct IndexSelectRowCopy {
+  void operator()(char* dst, const char* src, int64_t row_bytes) const {
+    std::memcpy(dst, src, row_bytes);
+  }
+};
+
+template <typename index_t, typename Copy>
+static void index_select_rows_kernel(
+    char* out,
+    const char* src,
+    const index_t* idxs,
+    int64_t N,
+    int64_t outer_dims_product,
+    int64_t src_batch_bytesize,
+    int64_t row_bytes,
+    const Copy& copy_row) {
+  const int64_t gathered_batch_bytesize = N * row_bytes;
+  const int64_t prefetch_bytes = std::min(row_bytes, kIndexSelectPrefetchMaxBytes);
+  // at least GRAIN_SIZE bytes per task, the copies being memory bound
+  const int64_t grain_size = std::max(
+      int64_t(1), at::internal::GRAIN_SIZE / std::max(int64_t(1), row_bytes));
+  at::parallel_for(0, outer_dims_product * N, grain_size, [&](int64_t begin, int64_t end) {
+    int64_t batch = begin / N;
+    int64_t i = begin % N;
+    for (int64_t k = begin; k < end; ++k) {
+      const char* src_batch = src + batch * src_batch_bytesize;
+      if (i + kIndexSelectPrefetchDistance < N) {
+        prefetch_index_select_row(
+            src_batch + idxs[i + kIndexSelectPrefetchDistance] * row_bytes,
+            prefetch_bytes);
+      }
+      copy_row(
+          out + batch * gathered_batch_bytesize + i * row_bytes,
+          src_batch + idxs[i] * row_bytes,
+          row_bytes);
+      if (++i == N) {
+        i = 0;
+        ++batch;
+      }
+    }
+  });
+}
+
+// Gathers whole rows when result is contiguous: self is viewed as
+// [outer dims, self.size(dim), inner dims] and every selected row of the
+// inner dims, of any dtype, is copied as one block of bytes, in parallel over
+// the rows.
+Tensor & index_select_out_cpu_rows_(
+    Tensor & result_contig, const Tensor & self, int64_t dim, const Tensor & index_contig) {
 
   auto self_contig = self.contiguous();
-  const caffe2::TypeMeta dataType = self_contig.dtype();
-  size_t item_bytesize = dataType.itemsize();
+  size_t item_bytesize = self_contig.dtype().itemsize();
 
   auto out = static_cast<char*>(result_contig.data_ptr());
-
   auto src_base = static_cast<const char*>(self_contig.data_ptr());
 
   auto self_sizes = self_contig.sizes();
-  auto outer_dims_product = c10::size_to_dim_(1, self_sizes);
-  auto block_size = c10::size_from_dim_(2, self_sizes);
-  auto block_bytesize = block_size * item_bytesize;
+  auto outer_dims_product = c10::size_to_dim_(dim, self_sizes);
+  auto row_bytes = static_cast<int64_t>(c10::size_from_dim_(dim + 1, self_sizes) * item_bytesize);
 
-  auto src_indexing_axis_dim = self_sizes[1];
-  auto src_batch_bytesize = self_sizes[1] * block_bytesize;
+  auto src_indexing_axis_dim = self_sizes[dim];
+  auto src_batch_bytesize = src_indexing_axis_dim * row_bytes;
   auto N = index_contig.numel();
 
-  auto gathered_batch_bytesize = N * block_bytesize;
-
   AT_DISPATCH_INDEX_TYPES(
-    index_contig.scalar_type(), "batch_index_select_compute", [&]() {
-
+    index_contig.scalar_type(), "index_select_out_cpu_rows_", [&]() {
       const auto* idxs = index_contig.data_ptr<index_t>();
       check_indexarray_range<index_t>(idxs, N, src_indexing_axis_dim);
 
-      // Special-case single-float copy for efficiency
-      if (self.scalar_type() == ScalarType::Float && block_size == 1) {
-        for (auto batch = 0; batch < outer_dims_product; ++batch) {
-          const float* src_floats =
-              (const float*)(src_base + batch * src_batch_bytesize);
-          float* dst_floats = (float*)(out + batch * gathered_batch_bytesize);
-
-          for (auto i = 0; i < N; ++i) {
-            auto idx = idxs[i];
-            if (idx < 0) {
-              idx = idx + src_indexing_axis_dim;
-            }
-            dst_floats[i] = src_floats[idx];
-          }
-        }
-      } else {
-        // outer_dims_product specifies how many times we repeat inner dimensions,
-        // so we just iterate over it to cover all outer dimensions.
-        for (auto batch = 0; batch < outer_dims_product; ++batch) {
-          for (auto i = 0; i < N; ++i) {
-            auto idx = idxs[i];
-            if (idx < 0) {
-              idx = idx + src_indexing_axis_dim;
-            }
-
-            auto src = src_base + batch * src_batch_bytesize + idx * block_bytesize;
-            auto dst = out + batch * gathered_batch_bytesize + i * block_bytesize;
-            memcpy(dst, src, block_bytesize);
-          }
-        }
+      switch (row_bytes) {
+        case 1:
+          index_select_rows_kernel(out, src_base, idxs, N, outer_dims_product,
+              src_batch_bytesize, row_bytes, IndexSelectFixedRowCopy<1>());
+          break;
+        case 2:
+          index_select_rows_kernel(out, src_base, idxs, N, outer_dims_product,
+              src_batch_bytesize, row_bytes, IndexSelectFixedRowCopy<2>());
+          break;
+        case 4:
+          index_select_rows_kernel(out, src_base, idxs, N, outer_dims_product,
+              src_batch_bytesize, row_bytes, IndexSelectFixedRowCopy<4>());
+          break;
+        case 8:
+          index_select_rows_kernel(out, src_base, idxs, N, outer_dims_product,
+              src_batch_bytesize, row_bytes, IndexSelectFixedRowCopy<8>());
+          break;
+        case 16:
+          index_select_rows_kernel(out, src_base, idxs, N, outer_dims_product,
+              src_batch_bytesize, row_bytes, IndexSelectFixedRowCopy<16>());
+          break;
+        default:
+          index_select_rows_kernel(out, src_base, idxs, N, outer_dims_product,
+              src_batch_bytesize, row_bytes, IndexSelectRowCopy());
       }
   });
   return result_contig;
@@ -601,14 +763,18 @@ Tensor & index_select_out_cpu_(Tensor & result, const Tensor & self, int64_t dim
 
   auto index_contig = index.contiguous();
 
-  if (self.dim() > 1) {
-    if (numel == 0 || self.numel() == 0) {
+  if (self.dim() > 0 && result.is_contiguous() &&
+      (dim == 1 || self.is_contiguous())) {
+    if (numel == 0 || (self.dim() > 1 && self.numel() == 0)) {
       return result;
     }
+    // fast pass
+    return index_select_out_cpu_rows_(result, self, dim, index_contig);
+  }
 
-    if (dim == 1 && result.is_contiguous()) {
-      // fast pass
-      return index_select_out_cpu_dim1_(result, self, index_contig);
+  if (self.dim() > 1) {
+    if (numel == 0 || self.numel() == 0) {
+      return result;
     }
 
     auto selfSlice = self.select(dim, 0);
@@ -1005,18 +1171,6 @@ static Tensor & masked_select_out_impl_cpu(Tensor & result, const Tensor & self,
   Tensor _mask, _self;
   std::tie(_mask, _self) = expand_outplace(mask, self);
 
-  auto shape = _self.sizes();
-  int64_t numel = _mask.sum().item().toLong();
-  result.resize_({numel});
-  if (numel == 0) {
-    return result;
-  }
-
-  // Create strided view of result before feeding into TensorIterator
-  auto strides = DimVector(shape.size(), 0);
-  auto orig_stride = result.strides()[0];
-  auto result_strided = result.as_strided(shape, strides);
-
   // serial kernel
   // serial kernel requires that src is traversed in its logical order. However, TensorIterator might
   // have reordered dimensions so that src would be traversed in its physical order, producing wrong
@@ -1025,6 +1179,18 @@ static Tensor & masked_select_out_impl_cpu(Tensor & result, const Tensor & self,
   bool use_serial_kernel = (self.numel() < at::internal::GRAIN_SIZE || at::get_num_threads() == 1 ) &&
   _self.is_contiguous() && _mask.is_contiguous();
   if (use_serial_kernel) {
+    auto shape = _self.sizes();
+    int64_t numel = _mask.sum().item().toLong();
+    result.resize_({numel});
+    if (numel == 0) {
+      return result;
+    }
+
+    // Create strided view of result before feeding into TensorIterator
+    auto strides = DimVector(shape.size(), 0);
+    auto orig_stride = result.strides()[0];
+    auto result_strided = result.as_strided(shape, strides);
+
     auto iter = TensorIteratorConfig()
       .set_check_mem_overlap(false)  // result is intenionally zero-strided above
       .check_all_same_dtype(false)
@@ -1038,28 +1204,10 @@ static Tensor & masked_select_out_impl_cpu(Tensor & result, const Tensor & self,
     return result;
   }
 
-  // Use a prefix sum to record the output locations of the masked elements,
-  // so as to parallel with TensorIterator.
-  auto mask_long = at::empty(shape, self.options().dtype(at::kLong)).copy_(_mask);
-  auto mask_prefix_sum = at::empty(shape, self.options().dtype(at::kLong));
-  auto mask_long_data = mask_long.data_ptr<int64_t>();
-  auto mask_prefix_sum_data = mask_prefix_sum.data_ptr<int64_t>();
-  // TODO: Here can only use std::partial_sum for C++14,
-  // use std::exclusive_scan when PyTorch upgrades to C++17, which have better peformance.
-  // std::exclusive_scan(mask_long_data, mask_long_data + mask_long.numel(), mask_prefix_sum_data, 0);
-  std::partial_sum(mask_long_data, mask_long_data + mask_long.numel(), mask_prefix_sum_data);
-
-  auto iter = TensorIteratorConfig()
-    .set_check_mem_overlap(false)  // result is intenionally zero-strided above
-    .check_all_same_dtype(false)
-    .resize_outputs(false)
-    .add_output(result_strided)
-    .add_input(_self)
-    .add_input(_mask)
-    .add_input(mask_prefix_sum)
-    .build();
-
-  masked_select_stub(iter.device_type(), iter, orig_stride);
+  // The parallel kernel counts the selected elements of every chunk of the
+  // inputs, then copies the chunks out at the offsets the counts give, so
+  // neither a prefix sum of the whole mask nor an index tensor is materialized.
+  masked_select_stub(kCPU, result, _self.contiguous(), _mask.contiguous());
   return result;
 }
 
@@ -1073,6 +1221,20 @@ Tensor masked_select_cpu(const Tensor & self, const Tensor & mask) {
   return masked_select_out_cpu(result, self, mask);
 }
 
+Tensor& nonzero_out_cpu(Tensor& result, const Tensor& self) {
+  TORCH_CHECK(result.scalar_type() == at::kLong,
+              "Expected object of scalar type ", at::kLong, " as out, but got ", result.scalar_type());
+  at::assert_no_internal_overlap(result);
+  at::assert_no_overlap(result, self);
+  nonzero_stub(kCPU, result, self);
+  return result;
+}
+
+Tensor nonzero_cpu(const Tensor& self) {
+  Tensor result = at::empty({0}, self.options().dtype(kLong));
+  return nonzero_out_cpu(result, self);
+}
+
 Tensor masked_select_backward(const Tensor& grad, const Tensor& input, const Tensor& mask) {
   // The following could just be written as `zeros_like(input).masked_scatter(mask, grad)`.
   // However, as an optimization, we call the in-place variant of masked_scatter.
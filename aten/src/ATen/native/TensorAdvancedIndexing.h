@@ -19,7 +19,10 @@ using index_put_fn = void(*)(TensorIterator &, IntArrayRef indexed_sizes, IntArr
 using index_put_accum_fn = void(*)(Tensor &, const c10::List<c10::optional<Tensor>> &, const Tensor &, bool unsafe);
 using masked_fill_fn = void(*)(TensorIterator &, Scalar scalar);
 using masked_select_fn = void(*)(TensorIterator &, int64_t orig_stride);
+// result, self, mask; self and mask are contiguous and of the same shape
+using masked_select_parallel_fn = void(*)(Tensor &, const Tensor &, const Tensor &);
 using masked_scatter_fn = void(*)(TensorIterator &, const Tensor &);
+using nonzero_fn = void(*)(Tensor & result, const Tensor & self);
 
 using gather_fn = void (*)(Tensor & result, const Tensor & self, int64_t dim, const Tensor & index);
 using scatter_fn = void(*)(Tensor& self, int64_t dim, const Tensor& index, const Tensor& src);
@@ -36,8 +39,9 @@ DECLARE_DISPATCH(index_put_fn, index_put_stub);
 DECLARE_DISPATCH(index_put_accum_fn, index_put_accum_stub);
 DECLARE_DISPATCH(masked_fill_fn, masked_fill_stub);
 DECLARE_DISPATCH(masked_select_fn, masked_select_serial_stub);
-DECLARE_DISPATCH(masked_select_fn, masked_select_stub);
+DECLARE_DISPATCH(masked_select_parallel_fn, masked_select_stub);
 DECLARE_DISPATCH(masked_scatter_fn, masked_scatter_stub);
+DECLARE_DISPATCH(nonzero_fn, nonzero_stub);
 
 DECLARE_DISPATCH(gather_fn, gather_stub);
 DECLARE_DISPATCH(scatter_fn, scatter_stub);
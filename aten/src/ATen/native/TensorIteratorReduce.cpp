@@ -14,9 +14,15 @@ using loop2d_t = TensorIteratorBase::loop2d_t;
 static bool use_two_pass_reduction(TensorIteratorBase& iter);
 static void two_pass_reduction(TensorIteratorBase& iter, loop2d_t loop);
 static void parallel_dim_reduction(TensorIteratorBase& iter, loop2d_t loop);
+static int find_split_dim(TensorIteratorBase& iter);
 
 void TensorIteratorBase::parallel_reduce(loop2d_t loop) {
   TORCH_CHECK(ntensors() == 2, "parallel_reduce only supports one input and one output");
+  if (find_outer_reduction_dim() >= 0) {
+    TensorIterator iter(*this);
+    iter.reorder_for_outer_reduction();
+    return iter.parallel_reduce(loop);
+  }
   int64_t numel = this->numel();
   if (numel < at::internal::GRAIN_SIZE || at::get_num_threads() == 1 ||
       at::in_parallel_region()) {
@@ -28,8 +34,19 @@ void TensorIteratorBase::parallel_reduce(loop2d_t loop) {
   }
 }
 
+// The two-pass reduction gives each thread its own copy of the output. Besides
+// full reductions, it is worth it when there are too few kept columns to give
+// every thread some, e.g. for x.sum((0, 2, 3)) with few channels, as long as
+// the copies stay small next to the input.
 static bool use_two_pass_reduction(TensorIteratorBase& iter) {
-  return iter.output(0).numel() == 1;
+  const int64_t output_numel = iter.output(0).numel();
+  if (output_numel == 1) {
+    return true;
+  }
+  const int64_t num_threads = at::get_num_threads();
+  constexpr int64_t min_reduced_per_output = 16;
+  return iter.shape()[find_split_dim(iter)] < num_threads &&
+      output_numel * num_threads * min_reduced_per_output <= iter.numel();
 }
 
 static void two_pass_reduction(TensorIteratorBase& iter, loop2d_t loop) {
@@ -50,6 +67,8 @@ static void two_pass_reduction(TensorIteratorBase& iter, loop2d_t loop) {
     slice.copy_(dst);
 
     auto sub_iter = TensorIterator::reduce_op(slice, iter.input(0));
+    // Same order as iter, which parallel_reduce may have reordered
+    sub_iter.reorder_for_outer_reduction();
     sub_iter.serial_for_each(loop, {begin, end});
   });
 
@@ -62,26 +81,32 @@ static void two_pass_reduction(TensorIteratorBase& iter, loop2d_t loop) {
 
   auto unsqueezed = dst.unsqueeze(0);
   auto final_reduce = TensorIterator::reduce_op(unsqueezed, buffer);
-  final_reduce.for_each(loop);
+  // Not for_each, which could split the reduction of one output element
+  // between threads
+  final_reduce.serial_for_each(loop, {0, final_reduce.numel()});
 }
 
-/// Chooses a dimension over which to parallelize. Prefers the outer-most
-/// dimension thats larger than the number of available threads.
+/// Chooses a non-reduced dimension over which to parallelize. Prefers the
+/// outer-most dimension thats larger than the number of available threads.
 static int find_split_dim(TensorIteratorBase& iter) {
   int num_threads = at::get_num_threads();
   auto shape = iter.shape();
 
-  // start with the outer-most dimension
-  int best_dim = iter.ndim() - 1;
-  for (int dim = best_dim; dim >= 0 && !iter.is_dim_reduced(dim); dim--) {
+  // start with the outer-most dimension. The reduced dimensions are usually
+  // first, but reorder_for_outer_reduction moves a kept dimension among them.
+  int best_dim = -1;
+  for (int dim = iter.ndim() - 1; dim >= 0; dim--) {
+    if (iter.is_dim_reduced(dim)) {
+      continue;
+    }
     if (shape[dim] >= num_threads) {
       return dim;
-    } else if (shape[dim] > shape[best_dim]) {
+    } else if (best_dim < 0 || shape[dim] > shape[best_dim]) {
       best_dim = dim;
     }
   }
 
-  AT_ASSERT(!iter.is_dim_reduced(best_dim));
+  AT_ASSERT(best_dim >= 0);
   return best_dim;
 }
 
@@ -118,6 +143,58 @@ static void parallel_dim_reduction(TensorIteratorBase& iter, loop2d_t loop) {
   });
 }
 
+int TensorIteratorBase::find_outer_reduction_dim() const {
+  if (ntensors() != 2 || ndim() < 3 || !is_dim_reduced(0) || !is_dim_reduced(1)) {
+    return -1;
+  }
+  const auto out_strides = strides(0);
+  const auto in_strides = strides(1);
+  if (in_strides[0] == element_size(1)) {
+    // Already contiguous in the innermost reduced dimension
+    return -1;
+  }
+  for (int dim = 2; dim < ndim(); dim++) {
+    if (!is_dim_reduced(dim) && out_strides[dim] == element_size(0) &&
+        in_strides[dim] == element_size(1)) {
+      return dim;
+    }
+  }
+  return -1;
+}
+
+bool TensorIteratorBase::reorder_for_outer_reduction() {
+  const int outer_dim = find_outer_reduction_dim();
+  if (outer_dim < 0) {
+    return false;
+  }
+  // The innermost reduced dimension stays first, so that the inner loops
+  // reduce down columns of outer_dim. The remaining reduced dimensions then
+  // accumulate into the same output columns from the outer loops.
+  DimVector perm;
+  perm.push_back(0);
+  perm.push_back(outer_dim);
+  for (int dim = 1; dim < ndim(); dim++) {
+    if (dim != outer_dim) {
+      perm.push_back(dim);
+    }
+  }
+  auto offsets = view_offsets_;
+  for (int dim = 0; dim < ndim(); dim++) {
+    view_offsets_[dim] = offsets[perm[dim]];
+  }
+  permute_dimensions(perm);
+  return true;
+}
+
+// When there are fewer kept columns than threads, but each output element
+// reduces a lot of input, foreach_reduced_elt goes through the output elements
+// one at a time instead, outside of a parallel region, so that loop can split
+// the reduction of each of them between the threads.
+static bool has_few_large_reductions(TensorIteratorBase& iter) {
+  return iter.shape()[find_split_dim(iter)] < at::get_num_threads() &&
+      iter.numel() / iter.output(0).numel() >= at::internal::GRAIN_SIZE;
+}
+
 void TensorIteratorBase::foreach_reduced_elt(loop_subiter_t loop, bool parallelize) {
   AT_ASSERT(ninputs() == 1);
   AT_ASSERT(noutputs() >= 1);
@@ -130,7 +207,8 @@ void TensorIteratorBase::foreach_reduced_elt(loop_subiter_t loop, bool paralleli
     loop(*this);
   }
   else if (numel() < at::internal::GRAIN_SIZE || at::get_num_threads() == 1 ||
-      at::in_parallel_region() || !parallelize) {
+      at::in_parallel_region() || !parallelize ||
+      has_few_large_reductions(*this)) {
     auto reduce_dims = num_reduce_dims();
 
     auto non_reduced_shape = shape.slice(reduce_dims, shape.size() - reduce_dims);
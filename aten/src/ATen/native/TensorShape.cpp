@@ -28,7 +28,7 @@
 namespace at {
 namespace native {
 
-DEFINE_DISPATCH(cat_serial_stub);
+DEFINE_DISPATCH(cat_contiguous_stub);
 DEFINE_DISPATCH(stack_serial_stub);
 
 Tensor _reshape_from_tensor(const Tensor& self, const Tensor& shape_tensor) {
@@ -122,8 +122,6 @@ Tensor & _cat_out_cpu(Tensor& result, TensorList tensors, int64_t dim) {
   // to be "skipped".  We maintain this behavior for backwards compatibility, but only for this specific
   // size (i.e. other empty sizes are not skipped).
 
-  bool allContiguous = true;
-
   // Inputs cannot alias the output tensor
   for (const auto i : c10::irange(tensors.size())) {
     auto lap = at::get_overlap_status(result, tensors[i]);
@@ -168,17 +166,11 @@ Tensor & _cat_out_cpu(Tensor& result, TensorList tensors, int64_t dim) {
   for (const auto i : c10::irange(tensors.size())) {
     auto const &tensor = tensors[i];
     if (should_skip(tensor)) {
-      // don't use fast path for empty tensor
-      allContiguous = false;
       continue;
     }
     check_cat_shape_except_dim(notSkippedTensor, tensor, dim, i);
     cat_dim_size += tensor.sizes()[dim];
 
-    if (!tensor.is_contiguous(first_tensor_mem_format)) {
-      allContiguous = false;
-    }
-
     if (tensor.sizes() != notSkippedTensor.sizes() ||
         tensor.strides() != notSkippedTensor.strides()) {
       reuse_iterator = false;
@@ -200,12 +192,38 @@ Tensor & _cat_out_cpu(Tensor& result, TensorList tensors, int64_t dim) {
     return result;
   }
 
-  // fast path for single thread when both inputs and result are contiguous and not empty
-  allContiguous = allContiguous && result.is_contiguous(first_tensor_mem_format);
-  bool use_serial_kernel = result.numel() < at::internal::GRAIN_SIZE || at::get_num_threads() == 1;
-  ScalarType dtype = notSkippedTensor.scalar_type();
-  if (use_serial_kernel && allContiguous && no_type_promotion && (dtype == ScalarType::Double || dtype == ScalarType::Float)) {
-    cat_serial_stub(kCPU, result, tensors, dim);
+  // The inputs that have the dtype of the result and are laid out like it are
+  // copied by one parallel kernel, directly into the result. The others go
+  // through a TensorIterator each, which handles their strides and dtypes.
+  std::vector<bool> copied(tensors.size(), false);
+  bool all_copied = false;
+  if (result.is_contiguous(first_tensor_mem_format)) {
+    std::vector<Tensor> inputs;
+    std::vector<int64_t> offsets;
+    int64_t offset = 0;
+    all_copied = true;
+    for (const auto i : c10::irange(tensors.size())) {
+      auto const &tensor = tensors[i];
+      if (should_skip(tensor)) {
+        continue;
+      }
+      if (tensor.dtype() == result.dtype() &&
+          tensor.is_contiguous(first_tensor_mem_format)) {
+        inputs.push_back(tensor);
+        offsets.push_back(offset);
+        copied[i] = true;
+      } else {
+        all_copied = false;
+      }
+      offset += tensor.sizes()[dim];
+    }
+    if (!inputs.empty()) {
+      cat_contiguous_stub(kCPU, result, inputs, offsets, dim, first_tensor_mem_format);
+      // The iterator of the identical inputs below must see all of them.
+      reuse_iterator = false;
+    }
+  }
+  if (all_copied) {
     return result;
   }
 
@@ -239,11 +257,16 @@ Tensor & _cat_out_cpu(Tensor& result, TensorList tensors, int64_t dim) {
       offset += slice_dim_size;
     }
   } else {
-    for (auto const &tensor: tensors) {
+    for (const auto i : c10::irange(tensors.size())) {
+      auto const &tensor = tensors[i];
       if (should_skip(tensor)) {
         continue;
       }
       auto slice_dim_size = tensor.sizes()[dim];
+      if (copied[i]) {
+        offset += slice_dim_size;
+        continue;
+      }
       auto result_slice = result.narrow(dim, offset, slice_dim_size);
 
       auto iter = TensorIteratorConfig()
@@ -994,6 +1017,13 @@ Tensor alias_with_sizes_and_strides(
     impl->set_storage_offset(self.storage_offset());
     impl->set_sizes_and_strides(sizes, strides);
     self_ = Tensor(std::move(impl));
+  } else if (self.is_meta()) {
+    // meta tensors have no storage to share
+    auto impl = c10::make_intrusive<TensorImpl>(
+        self.key_set(), self.dtype(), self.device());
+    impl->set_storage_offset(self.storage_offset());
+    impl->set_sizes_and_strides(sizes, strides);
+    self_ = Tensor(std::move(impl));
   } else {
     auto impl = c10::make_intrusive<TensorImpl>(
         Storage(self.storage()), self.key_set(), self.dtype());
@@ -2,6 +2,8 @@
 
 #include <ATen/ATen.h>
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <c10/util/flat_hash_map.h>
 
 #include <set>
 #include <tuple>
@@ -13,6 +15,127 @@ namespace native{
 
 namespace {
 
+// Integral inputs at least this large are deduplicated with all threads
+constexpr int64_t PARALLEL_UNIQUE_MIN_SIZE = 1 << 16;
+
+// Picks the partition of a hash. std::hash is the identity for integers,
+// so mix the bits before taking the modulo.
+inline int64_t unique_partition(size_t hash, int64_t num_partitions) {
+  return static_cast<int64_t>(
+      ((static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ull) >> 32) %
+      static_cast<uint64_t>(num_partitions));
+}
+
+// Every thread counts the values of its chunk of the input in hash maps,
+// one per partition of the hash space. Partition p of all threads is then
+// merged by one thread, so the merged partitions hold disjoint values and
+// are written to the output side by side. Inverse indices are looked up in
+// the merged partitions, again in parallel.
+template <typename scalar_t>
+std::tuple<Tensor, Tensor, Tensor> unique_cpu_parallel_template(
+    const Tensor& input,
+    const bool sorted,
+    const bool return_inverse,
+    const bool return_counts) {
+  using map_t = ska::flat_hash_map<scalar_t, int64_t>;
+  const scalar_t* input_data = input.data_ptr<scalar_t>();
+  const int64_t numel = input.numel();
+  const int64_t num_threads = at::get_num_threads();
+  const int64_t chunk_size = (numel + num_threads - 1) / num_threads;
+  const int64_t num_chunks = (numel + chunk_size - 1) / chunk_size;
+  const int64_t num_partitions = num_chunks;
+  const std::hash<scalar_t> hasher;
+
+  // partials[c * num_partitions + p] counts the values of chunk c in partition p
+  std::vector<map_t> partials(num_chunks * num_partitions);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t c = begin; c < end; c++) {
+      map_t* chunk_partials = partials.data() + c * num_partitions;
+      const int64_t chunk_end = std::min(numel, (c + 1) * chunk_size);
+      for (int64_t i = c * chunk_size; i < chunk_end; i++) {
+        const scalar_t value = input_data[i];
+        chunk_partials[unique_partition(hasher(value), num_partitions)][value]++;
+      }
+    }
+  });
+
+  std::vector<map_t> merged(num_partitions);
+  at::parallel_for(0, num_partitions, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t p = begin; p < end; p++) {
+      map_t& partition = merged[p];
+      partition = std::move(partials[p]);
+      for (int64_t c = 1; c < num_chunks; c++) {
+        map_t& partial = partials[c * num_partitions + p];
+        for (const auto& entry : partial) {
+          partition[entry.first] += entry.second;
+        }
+        map_t().swap(partial);
+      }
+    }
+  });
+
+  std::vector<int64_t> partition_offsets(num_partitions + 1, 0);
+  for (int64_t p = 0; p < num_partitions; p++) {
+    partition_offsets[p + 1] = partition_offsets[p] + merged[p].size();
+  }
+  const int64_t output_size = partition_offsets[num_partitions];
+  Tensor output = at::empty({output_size}, input.options());
+  Tensor inverse_indices = at::empty({0}, input.options().dtype(kLong));
+  Tensor counts = at::empty({return_counts ? output_size : 0}, input.options().dtype(kLong));
+  scalar_t* output_data = output.data_ptr<scalar_t>();
+  int64_t* counts_data = counts.data_ptr<int64_t>();
+
+  // Write the values out and replace their counts by their output position
+  at::parallel_for(0, num_partitions, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t p = begin; p < end; p++) {
+      int64_t position = partition_offsets[p];
+      for (auto& entry : merged[p]) {
+        output_data[position] = entry.first;
+        if (return_counts) {
+          counts_data[position] = entry.second;
+        }
+        entry.second = position++;
+      }
+    }
+  });
+
+  // rank[position] is the index of the value written at position once the
+  // output is sorted
+  Tensor rank;
+  if (sorted) {
+    Tensor order;
+    std::tie(output, order) = output.sort();
+    if (return_counts) {
+      counts = counts.index_select(0, order);
+    }
+    if (return_inverse) {
+      rank = at::empty({output_size}, order.options());
+      const int64_t* order_data = order.data_ptr<int64_t>();
+      int64_t* rank_data = rank.data_ptr<int64_t>();
+      at::parallel_for(0, output_size, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+          rank_data[order_data[i]] = i;
+        }
+      });
+    }
+  }
+
+  if (return_inverse) {
+    inverse_indices.resize_(input.sizes());
+    int64_t* inverse_indices_data = inverse_indices.data_ptr<int64_t>();
+    const int64_t* rank_data = sorted ? rank.data_ptr<int64_t>() : nullptr;
+    at::parallel_for(0, numel, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; i++) {
+        const scalar_t value = input_data[i];
+        const map_t& partition = merged[unique_partition(hasher(value), num_partitions)];
+        const int64_t position = partition.find(value)->second;
+        inverse_indices_data[i] = sorted ? rank_data[position] : position;
+      }
+    });
+  }
+  return std::make_tuple(output, inverse_indices, counts);
+}
+
 template <typename scalar_t>
 std::tuple<Tensor, Tensor, Tensor> unique_cpu_template(
     const Tensor& self,
@@ -22,6 +145,12 @@ std::tuple<Tensor, Tensor, Tensor> unique_cpu_template(
   const Tensor& input = self.contiguous();
   const scalar_t* input_data = input.data_ptr<scalar_t>();
   int64_t numel = input.numel();
+  // Floating point inputs stay on the serial path, which keeps every NaN
+  if (std::is_integral<scalar_t>::value && numel >= PARALLEL_UNIQUE_MIN_SIZE &&
+      at::get_num_threads() > 1 && !at::in_parallel_region()) {
+    return unique_cpu_parallel_template<scalar_t>(
+        input, sorted, return_inverse, return_counts);
+  }
   Tensor output;
   Tensor inverse_indices = at::empty({0}, self.options().dtype(kLong));
   Tensor counts = at::empty({0}, self.options().dtype(kLong));
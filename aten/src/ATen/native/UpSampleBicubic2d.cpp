@@ -44,6 +44,21 @@ TORCH_META_FUNC(upsample_bicubic2d_backward) (
   set_output(input_size, grad_output.options());
 }
 
+TORCH_META_FUNC(_upsample_bicubic2d_aa) (
+  const Tensor& input, IntArrayRef output_size, bool align_corners, c10::optional<double> scales_h, c10::optional<double> scales_w
+) {
+  auto full_output_size = native::upsample_2d_common_check(input.sizes(), output_size);
+
+  // Allow for empty batch size but not other dimensions
+  TORCH_CHECK(
+      input.numel() != 0 || c10::multiply_integers(input.sizes().begin() + 1, input.sizes().end()),
+      "Non-empty 4D data tensor expected but got a tensor with sizes ",
+      input.sizes());
+
+  // Channels last images stay channels last, so the kernel writes them directly
+  set_output(full_output_size, input.options().memory_format(input.suggest_memory_format()));
+}
+
 } // namespace meta
 namespace native {
 namespace {
@@ -309,6 +324,17 @@ TORCH_IMPL_FUNC(upsample_bicubic2d_backward_out_cpu) (
   upsample_bicubic2d_backward_kernel(grad_input, grad_output, output_size, input_size, align_corners, scales_h, scales_w);
 }
 
+TORCH_IMPL_FUNC(_upsample_bicubic2d_aa_out_cpu) (
+    const Tensor& input,
+    IntArrayRef output_size,
+    bool align_corners,
+    c10::optional<double> scales_h,
+    c10::optional<double> scales_w,
+    const Tensor& output
+) {
+  _upsample_bicubic2d_aa_kernel(kCPU, output, input, align_corners, scales_h, scales_w);
+}
+
 // vec variants
 
 using at::native::upsample::compute_output_size;
@@ -337,5 +363,18 @@ Tensor upsample_bicubic2d_backward(
   return at::upsample_bicubic2d_backward(grad_output, osize, input_size, align_corners, scale_h, scale_w);
 }
 
+Tensor _upsample_bicubic2d_aa(
+    const Tensor& input,
+    c10::optional<IntArrayRef> output_size,
+    bool align_corners,
+    c10::optional<ArrayRef<double>> scale_factors) {
+  auto osize = compute_output_size(input.sizes(), output_size, scale_factors);
+  auto scale_h = get_scale_value(scale_factors, 0);
+  auto scale_w = get_scale_value(scale_factors, 1);
+  return at::_upsample_bicubic2d_aa(input, osize, align_corners, scale_h, scale_w);
+}
+
+DEFINE_DISPATCH(_upsample_bicubic2d_aa_kernel);
+
 } // namespace native
 } // namespace at
@@ -7,12 +7,24 @@ namespace at {
 
 namespace native {
 
+// output, input, weight, bias, running_mean, running_var, eps, fuse_relu
 using batch_norm_fn = void (*)(Tensor&, const Tensor&, const Tensor&,
-    const Tensor&, const Tensor&, const Tensor&, double);
+    const Tensor&, const Tensor&, const Tensor&, double, bool);
+// output, input, weight, bias, save_mean, save_invstd
+using batch_norm_transform_fn = void (*)(Tensor&, const Tensor&, const Tensor&,
+    const Tensor&, const Tensor&, const Tensor&);
+// mean, var_sum, input
+using batch_norm_collect_stats_fn = void (*)(Tensor&, Tensor&, const Tensor&);
+// grad_input, grad_weight, grad_bias, grad_output, input, weight, mean, invstd, train
+using batch_norm_backward_fn = void (*)(Tensor&, Tensor&, Tensor&,
+    const Tensor&, const Tensor&, const Tensor&, const Tensor&, const Tensor&, bool);
 
 DECLARE_DISPATCH(batch_norm_fn, batch_norm_cpu_inference_contiguous_stub);
+DECLARE_DISPATCH(batch_norm_fn, batch_norm_cpu_inference_channels_last_stub);
+DECLARE_DISPATCH(batch_norm_transform_fn, batch_norm_cpu_transform_channels_last_stub);
+DECLARE_DISPATCH(batch_norm_collect_stats_fn, batch_norm_cpu_collect_stats_channels_last_stub);
+DECLARE_DISPATCH(batch_norm_backward_fn, batch_norm_cpu_backward_channels_last_stub);
 
 } // namespace native
 
 } // namespace at
-
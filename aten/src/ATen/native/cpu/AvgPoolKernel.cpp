@@ -0,0 +1,233 @@
+#include <ATen/ATen.h>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/Pool.h>
+#include <ATen/native/cpu/utils.h>
+
+namespace at { namespace native {
+
+namespace {
+
+// Pooling range of one output index in one dim, and its size including the
+// padding
+struct AvgPoolRange {
+  int64_t start;
+  int64_t end;
+  int64_t padded_size;
+};
+
+inline AvgPoolRange avg_pool_range(int64_t o, int64_t k, int64_t d, int64_t pad, int64_t input_size) {
+  int64_t start = o * d - pad;
+  int64_t end = std::min(start + k, input_size + pad);
+  int64_t padded_size = end - start;
+  return {std::max(start, (int64_t) 0), std::min(end, input_size), padded_size};
+}
+
+inline int64_t avg_pool_divide_factor(
+    const AvgPoolRange& t, const AvgPoolRange& h, const AvgPoolRange& w,
+    bool count_include_pad, c10::optional<int64_t> divisor_override) {
+  if (divisor_override.has_value()) {
+    return divisor_override.value();
+  } else if (count_include_pad) {
+    return t.padded_size * h.padded_size * w.padded_size;
+  } else {
+    return (t.end - t.start) * (h.end - h.start) * (w.end - w.start);
+  }
+}
+
+template <typename scalar_t>
+void cpu_avg_pool_channels_last(
+    Tensor& output_,
+    const Tensor& input_,
+    const PoolingWindow3D& w,
+    bool count_include_pad,
+    c10::optional<int64_t> divisor_override) {
+  const int64_t ndim = input_.ndimension();
+  auto memory_format = ndim == 4 ? at::MemoryFormat::ChannelsLast : at::MemoryFormat::ChannelsLast3d;
+  auto input = input_.contiguous(memory_format);
+  auto output = output_.contiguous(memory_format);
+
+  auto input_data = input.data_ptr<scalar_t>();
+  auto output_data = output.data_ptr<scalar_t>();
+
+  int64_t nbatch = input.size(0);
+  int64_t channels = input.size(1);
+  int64_t input_depth = ndim == 5 ? input.size(2) : 1;
+  int64_t input_height = input.size(-2);
+  int64_t input_width = input.size(-1);
+  int64_t output_depth = ndim == 5 ? output.size(2) : 1;
+  int64_t output_height = output.size(-2);
+  int64_t output_width = output.size(-1);
+
+  using Vec = vec256::Vec256<scalar_t>;
+  // parallel on dim N, T, H
+  at::parallel_for(0, nbatch * output_depth * output_height, 0, [&](int64_t begin, int64_t end) {
+    int64_t n = 0;
+    int64_t ot = 0;
+    int64_t oh = 0;
+    data_index_init(begin, n, nbatch, ot, output_depth, oh, output_height);
+
+    for (int64_t i = begin; i < end; i++) {
+      auto t = avg_pool_range(ot, w.kT, w.dT, w.pT, input_depth);
+      auto h = avg_pool_range(oh, w.kH, w.dH, w.pH, input_height);
+      scalar_t* input_ptr = input_data + n * input_depth * input_height * input_width * channels;
+
+      for (int64_t ow = 0; ow < output_width; ow++) {
+        auto wr = avg_pool_range(ow, w.kW, w.dW, w.pW, input_width);
+        scalar_t* out = output_data + (i * output_width + ow) * channels;
+        int64_t size = channels;
+
+        // Pass I: zero the out lane
+        int64_t d1 = 0;
+        for (; d1 < size - (size % Vec::size()); d1 += Vec::size()) {
+          Vec out_vec = Vec(scalar_t(0));
+          out_vec.store(out + d1);
+        }
+        for (; d1 < size; d1++) {
+          out[d1] = scalar_t(0);
+        }
+        if (t.start >= t.end || h.start >= h.end || wr.start >= wr.end) {
+          continue;
+        }
+
+        // Pass II: compute local sum
+        for (int64_t it = t.start; it < t.end; it++) {
+          for (int64_t ih = h.start; ih < h.end; ih++) {
+            for (int64_t iw = wr.start; iw < wr.end; iw++) {
+              scalar_t* in = input_ptr + ((it * input_height + ih) * input_width + iw) * channels;
+
+              int64_t d2 = 0;
+              for (; d2 < size - (size % Vec::size()); d2 += Vec::size()) {
+                Vec out_vec = Vec::loadu(out + d2) + Vec::loadu(in + d2);
+                out_vec.store(out + d2);
+              }
+              for (; d2 < size; d2++) {
+                out[d2] += in[d2];
+              }
+            }
+          }
+        }
+
+        // Pass III: compute local average
+        const scalar_t divide_factor = avg_pool_divide_factor(t, h, wr, count_include_pad, divisor_override);
+        int64_t d3 = 0;
+        for (; d3 < size - (size % Vec::size()); d3 += Vec::size()) {
+          Vec out_vec = Vec::loadu(out + d3) / Vec(divide_factor);
+          out_vec.store(out + d3);
+        }
+        for (; d3 < size; d3++) {
+          out[d3] = out[d3] / divide_factor;
+        }
+      }
+
+      // move on to next output index
+      data_index_step(n, nbatch, ot, output_depth, oh, output_height);
+    }
+  });
+
+  if (!output_.is_contiguous(memory_format)) {
+    output_.copy_(output);
+  }
+}
+
+template <typename scalar_t>
+void cpu_avg_pool_backward_channels_last(
+    Tensor& grad_input_,
+    const Tensor& grad_output_,
+    const PoolingWindow3D& w,
+    bool count_include_pad,
+    c10::optional<int64_t> divisor_override) {
+  const int64_t ndim = grad_output_.ndimension();
+  auto memory_format = ndim == 4 ? at::MemoryFormat::ChannelsLast : at::MemoryFormat::ChannelsLast3d;
+  auto grad_input = grad_input_.contiguous(memory_format);
+  auto grad_output = grad_output_.contiguous(memory_format);
+
+  auto grad_input_data = grad_input.data_ptr<scalar_t>();
+  auto grad_output_data = grad_output.data_ptr<scalar_t>();
+
+  int64_t nbatch = grad_input.size(0);
+  int64_t channels = grad_input.size(1);
+  int64_t input_depth = ndim == 5 ? grad_input.size(2) : 1;
+  int64_t input_height = grad_input.size(-2);
+  int64_t input_width = grad_input.size(-1);
+  int64_t output_depth = ndim == 5 ? grad_output.size(2) : 1;
+  int64_t output_height = grad_output.size(-2);
+  int64_t output_width = grad_output.size(-1);
+
+  using Vec = vec256::Vec256<scalar_t>;
+  // parallel on dim N, as the windows of different outputs overlap
+  at::parallel_for(0, nbatch, 0, [&](int64_t begin, int64_t end) {
+    for (int64_t n = begin; n < end; n++) {
+      scalar_t* grad_input_ptr = grad_input_data + n * input_depth * input_height * input_width * channels;
+      scalar_t* grad_output_ptr = grad_output_data + n * output_depth * output_height * output_width * channels;
+
+      for (int64_t ot = 0; ot < output_depth; ot++) {
+        auto t = avg_pool_range(ot, w.kT, w.dT, w.pT, input_depth);
+        for (int64_t oh = 0; oh < output_height; oh++) {
+          auto h = avg_pool_range(oh, w.kH, w.dH, w.pH, input_height);
+          for (int64_t ow = 0; ow < output_width; ow++) {
+            auto wr = avg_pool_range(ow, w.kW, w.dW, w.pW, input_width);
+            if (t.start >= t.end || h.start >= h.end || wr.start >= wr.end) {
+              continue;
+            }
+            const scalar_t divide_factor = avg_pool_divide_factor(t, h, wr, count_include_pad, divisor_override);
+            scalar_t* gout = grad_output_ptr + ((ot * output_height + oh) * output_width + ow) * channels;
+            int64_t size = channels;
+
+            for (int64_t it = t.start; it < t.end; it++) {
+              for (int64_t ih = h.start; ih < h.end; ih++) {
+                for (int64_t iw = wr.start; iw < wr.end; iw++) {
+                  scalar_t* gin = grad_input_ptr + ((it * input_height + ih) * input_width + iw) * channels;
+
+                  int64_t d = 0;
+                  for (; d < size - (size % Vec::size()); d += Vec::size()) {
+                    Vec gin_vec = Vec::loadu(gin + d) + Vec::loadu(gout + d) / Vec(divide_factor);
+                    gin_vec.store(gin + d);
+                  }
+                  for (; d < size; d++) {
+                    gin[d] += gout[d] / divide_factor;
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  });
+
+  if (!grad_input_.is_contiguous(memory_format)) {
+    grad_input_.copy_(grad_input);
+  }
+}
+
+void avg_pool_channels_last_kernel_impl(
+    Tensor& output,
+    const Tensor& input,
+    const PoolingWindow3D& window,
+    bool count_include_pad,
+    c10::optional<int64_t> divisor_override) {
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "avg_pool_channels_last", [&] {
+    cpu_avg_pool_channels_last<scalar_t>(output, input, window, count_include_pad, divisor_override);
+  });
+}
+
+void avg_pool_channels_last_backward_kernel_impl(
+    Tensor& grad_input,
+    const Tensor& grad_output,
+    const PoolingWindow3D& window,
+    bool count_include_pad,
+    c10::optional<int64_t> divisor_override) {
+  AT_DISPATCH_FLOATING_TYPES(grad_output.scalar_type(), "avg_pool_channels_last_backward", [&] {
+    cpu_avg_pool_backward_channels_last<scalar_t>(grad_input, grad_output, window, count_include_pad, divisor_override);
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(avg_pool_channels_last_kernel, &avg_pool_channels_last_kernel_impl);
+REGISTER_DISPATCH(avg_pool_channels_last_backward_kernel, &avg_pool_channels_last_backward_kernel_impl);
+
+}} // at::native
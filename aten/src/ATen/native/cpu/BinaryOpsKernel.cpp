@@ -51,10 +51,10 @@ void add_kernel(TensorIteratorBase& iter, Scalar alpha_scalar) {
   } else {
     AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND2(kBFloat16, kHalf, iter.dtype(), "add_cpu/sub_cpu", [&]() {
       auto alpha = alpha_scalar.to<scalar_t>();
-      auto alpha_vec = Vec256<scalar_t>(alpha);
+      auto alpha_vec = Vectorized<scalar_t>(alpha);
       cpu_kernel_vec(iter,
         [=](scalar_t a, scalar_t b) __ubsan_ignore_undefined__ -> scalar_t { return a + alpha * b; },
-        [=](Vec256<scalar_t> a, Vec256<scalar_t> b) __ubsan_ignore_undefined__ {
+        [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) __ubsan_ignore_undefined__ {
           return vec256::fmadd(b, alpha_vec, a);
         });
       });
@@ -64,16 +64,16 @@ void add_kernel(TensorIteratorBase& iter, Scalar alpha_scalar) {
 void add_clamp_kernel(TensorIterator& iter, Scalar alpha_scalar, Scalar min_val, Scalar max_val) {
   AT_DISPATCH_ALL_TYPES(iter.dtype(), "add_clamp_cpu", [&]() {
     auto alpha = alpha_scalar.to<scalar_t>();
-    auto alpha_vec = Vec256<scalar_t>(alpha);
+    auto alpha_vec = Vectorized<scalar_t>(alpha);
     auto min_scalar = min_val.to<scalar_t>();
-    auto min_vec = Vec256<scalar_t>(min_scalar);
+    auto min_vec = Vectorized<scalar_t>(min_scalar);
     auto max_scalar = max_val.to<scalar_t>();
-    auto max_vec = Vec256<scalar_t>(max_scalar);
+    auto max_vec = Vectorized<scalar_t>(max_scalar);
     cpu_kernel_vec(iter,
       [=](scalar_t a, scalar_t b) __ubsan_ignore_undefined__ -> scalar_t {
         return std::min(max_scalar, std::max(min_scalar, a + alpha * b));
       },
-      [=](Vec256<scalar_t> a, Vec256<scalar_t> b) __ubsan_ignore_undefined__ {
+      [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) __ubsan_ignore_undefined__ {
         auto add_clamp_res = vec256::fmadd(b, alpha_vec, a);
         add_clamp_res = vec256::clamp_min(add_clamp_res, min_vec);
         add_clamp_res = vec256::clamp_max(add_clamp_res, max_vec);
@@ -87,7 +87,7 @@ void atan2_kernel(TensorIterator& iter) {
     cpu_kernel_vec(iter, [=](scalar_t a, scalar_t b) -> scalar_t {
     return std::atan2(a, b);
   },
-    [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+    [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
       return a.atan2(b);
     });
   });
@@ -106,7 +106,7 @@ void mul_kernel(TensorIterator& iter) {
     AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND2(kBFloat16, kHalf, iter.dtype(), "mul_cpu", [&]() {
       cpu_kernel_vec(iter,
         [=](scalar_t a, scalar_t b) -> scalar_t { return a * b; },
-        [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+        [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
           return a * b;
         });
     });
@@ -119,7 +119,7 @@ void div_true_kernel(TensorIterator& iter) {
       [](scalar_t a, scalar_t b) __ubsan_ignore_float_divide_by_zero__ -> scalar_t {
         return a / b;
       },
-      [](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+      [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
         return a / b;
       });
   });
@@ -142,7 +142,7 @@ void div_trunc_kernel(TensorIterator& iter) {
         [](scalar_t a, scalar_t b) __ubsan_ignore_float_divide_by_zero__ -> scalar_t {
           return std::trunc(a / b);
         },
-        [](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+        [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
           return (a / b).trunc();
         });
     });
@@ -229,11 +229,11 @@ void remainder_kernel(TensorIterator& iter) {
           if ((mod != 0) && ((b < 0) != (mod < 0))) mod += b;
           return mod;
         },
-        [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+        [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
           auto mod = a.fmod(b);
-          const auto zero = Vec256<scalar_t>(0);
+          const auto zero = Vectorized<scalar_t>(0);
           auto mask = (mod != zero) & ((b < zero) ^ (mod < zero));
-          return Vec256<scalar_t>::blendv(mod, mod + b, mask);
+          return Vectorized<scalar_t>::blendv(mod, mod + b, mask);
         });
     });
   }
@@ -253,7 +253,7 @@ void bitwise_and_kernel(TensorIterator& iter) {
           [](scalar_t a, scalar_t b) -> scalar_t {
             return a & b;
           },
-          [](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+          [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
             return a & b;
           });
     });
@@ -274,7 +274,7 @@ void bitwise_or_kernel(TensorIterator& iter) {
           [](scalar_t a, scalar_t b) -> scalar_t {
             return a | b;
           },
-          [](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+          [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
             return a | b;
           });
     });
@@ -297,7 +297,7 @@ void bitwise_xor_kernel(TensorIterator& iter) {
           [](scalar_t a, scalar_t b) -> scalar_t {
             return a ^ b;
           },
-          [](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+          [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
             return a ^ b;
           });
     });
@@ -307,13 +307,13 @@ void bitwise_xor_kernel(TensorIterator& iter) {
 void lshift_kernel(TensorIterator& iter) {
   if (iter.dtype() == ScalarType::Float || iter.dtype() == ScalarType::Double) {
     AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "lshift_cpu", [&]() {
-      auto base_vec = Vec256<scalar_t>((scalar_t)(2));
+      auto base_vec = Vectorized<scalar_t>((scalar_t)(2));
       cpu_kernel_vec(
         iter,
         [=](scalar_t a, scalar_t b) -> scalar_t {
           return a * std::pow((scalar_t)(2), b);
         },
-        [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+        [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
           return a * base_vec.pow(b);
       });
     });
@@ -387,13 +387,13 @@ void logical_xor_kernel(TensorIterator& iter) {
 void rshift_kernel(TensorIterator& iter) {
   if (iter.dtype() == ScalarType::Float || iter.dtype() == ScalarType::Double) {
     AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "rshift_cpu", [&]() {
-      auto base_vec = Vec256<scalar_t>((scalar_t)(2));
+      auto base_vec = Vectorized<scalar_t>((scalar_t)(2));
       cpu_kernel_vec(
         iter,
         [=](scalar_t a, scalar_t b) -> scalar_t {
           return a / std::pow((scalar_t)(2), b);
         },
-        [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+        [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
           return a / base_vec.pow(b);
       });
     });
@@ -423,7 +423,7 @@ void lt_kernel(TensorIterator& iter) {
         [](scalar_t a, scalar_t b) -> scalar_t {
           return a < b;
         },
-        [](Vec256<scalar_t> a, Vec256<scalar_t> b) -> Vec256<scalar_t> {
+        [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) -> Vectorized<scalar_t> {
           return a.lt(b);
         });
     });
@@ -446,7 +446,7 @@ void le_kernel(TensorIterator& iter) {
         [](scalar_t a, scalar_t b) -> scalar_t {
           return a <= b;
         },
-        [](Vec256<scalar_t> a, Vec256<scalar_t> b) -> Vec256<scalar_t> {
+        [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) -> Vectorized<scalar_t> {
           return a.le(b);
         });
     });
@@ -469,7 +469,7 @@ void gt_kernel(TensorIterator& iter) {
         [](scalar_t a, scalar_t b) -> scalar_t {
           return a > b;
         },
-        [](Vec256<scalar_t> a, Vec256<scalar_t> b) -> Vec256<scalar_t> {
+        [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) -> Vectorized<scalar_t> {
           return a.gt(b);
         });
     });
@@ -492,7 +492,7 @@ void ge_kernel(TensorIterator& iter) {
         [](scalar_t a, scalar_t b) -> scalar_t {
           return a >= b;
         },
-        [](Vec256<scalar_t> a, Vec256<scalar_t> b) -> Vec256<scalar_t> {
+        [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) -> Vectorized<scalar_t> {
           return a.ge(b);
         });
     });
@@ -515,7 +515,7 @@ void eq_kernel(TensorIterator& iter) {
         [](scalar_t a, scalar_t b) -> scalar_t {
           return a == b;
         },
-        [](Vec256<scalar_t> a, Vec256<scalar_t> b) -> Vec256<scalar_t> {
+        [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) -> Vectorized<scalar_t> {
           return a.eq(b);
         });
     });
@@ -538,7 +538,7 @@ void ne_kernel(TensorIterator& iter) {
         [](scalar_t a, scalar_t b) -> scalar_t {
           return a != b;
         },
-        [](Vec256<scalar_t> a, Vec256<scalar_t> b) -> Vec256<scalar_t> {
+        [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) -> Vectorized<scalar_t> {
           return a.ne(b);
         });
     });
@@ -555,7 +555,7 @@ void maximum_kernel(TensorIterator& iter) {
     AT_DISPATCH_INTEGRAL_TYPES(iter.dtype(), "maximum_cpu", [&]() {
       cpu_kernel_vec(iter,
         [](scalar_t a, scalar_t b) -> scalar_t { return std::max(a, b); },
-        [](Vec256<scalar_t> a, Vec256<scalar_t> b) { return at::vec256::maximum(a, b); });
+        [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) { return at::vec256::maximum(a, b); });
     });
   } else {
     AT_DISPATCH_FLOATING_TYPES_AND2(at::ScalarType::Half, at::ScalarType::BFloat16, iter.dtype(), "maximum_cpu", [&]() {
@@ -567,7 +567,7 @@ void maximum_kernel(TensorIterator& iter) {
             return std::max(a, b);
           }
         },
-        [](Vec256<scalar_t> a, Vec256<scalar_t> b) { return at::vec256::maximum(a, b); });
+        [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) { return at::vec256::maximum(a, b); });
     });
   }
 }
@@ -582,7 +582,7 @@ void minimum_kernel(TensorIterator& iter) {
     AT_DISPATCH_INTEGRAL_TYPES(iter.dtype(), "minimum_cpu", [&]() {
       cpu_kernel_vec(iter,
         [](scalar_t a, scalar_t b) -> scalar_t { return std::min(a, b); },
-        [](Vec256<scalar_t> a, Vec256<scalar_t> b) { return at::vec256::minimum(a, b); });
+        [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) { return at::vec256::minimum(a, b); });
     });
   } else {
     AT_DISPATCH_FLOATING_TYPES_AND2(at::ScalarType::Half, at::ScalarType::BFloat16, iter.dtype(), "minimum_cpu", [&]() {
@@ -594,7 +594,7 @@ void minimum_kernel(TensorIterator& iter) {
             return std::min(a, b);
           }
         },
-        [](Vec256<scalar_t> a, Vec256<scalar_t> b) { return at::vec256::minimum(a, b); });
+        [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) { return at::vec256::minimum(a, b); });
     });
   }
 }
@@ -628,7 +628,7 @@ void fmin_kernel(TensorIterator& iter) {
 void smooth_l1_kernel(TensorIterator& iter, double beta) {
   AT_DISPATCH_FLOATING_TYPES_AND2(
         kBFloat16, kHalf, iter.dtype(), "smooth_l1_cpu", [&]() {
-        using Vec = Vec256<scalar_t>;
+        using Vec = Vectorized<scalar_t>;
         const scalar_t beta_val(beta);
         const Vec beta_val_vec(beta_val);
         const Vec point_five_vec(static_cast<scalar_t>(0.5));
@@ -650,7 +650,7 @@ void smooth_l1_kernel(TensorIterator& iter, double beta) {
 
 void huber_kernel(TensorIterator& iter, double delta) {
   AT_DISPATCH_FLOATING_TYPES_AND2(kBFloat16, kHalf, iter.dtype(), "huber_cpu", [&]() {
-    using Vec = Vec256<scalar_t>;
+    using Vec = Vectorized<scalar_t>;
     const scalar_t delta_val(delta);
     const Vec delta_val_vec(delta_val);
     const Vec point_five_vec(static_cast<scalar_t>(0.5));
@@ -671,13 +671,33 @@ void huber_kernel(TensorIterator& iter, double delta) {
 }
 
 void sigmoid_backward_kernel(TensorIterator& iter) {
-  AT_DISPATCH_FLOATING_TYPES_AND2(kBFloat16, kHalf, iter.dtype(), "sigmoid_backward_cpu", [&]() {
-    auto one_vec = Vec256<scalar_t>((scalar_t)(1));
+  if (iter.dtype() == kBFloat16) {
+    // Compute in float and round to BFloat16 once, see
+    // Note [BFloat16 functional]
+    auto one_vec = Vec256<float>((float)(1));
+    cpu_kernel_vec(iter,
+      [=](BFloat16 a, BFloat16 b) -> BFloat16 {
+        float a0 = static_cast<float>(a);
+        float b0 = static_cast<float>(b);
+        return a0 * (float(1) - b0) * b0;
+      },
+      [=](Vec256<BFloat16> a, Vec256<BFloat16> b) {
+        Vec256<float> a0, a1, b0, b1;
+        std::tie(a0, a1) = convert_bfloat16_float(a);
+        std::tie(b0, b1) = convert_bfloat16_float(b);
+        a0 = a0 * (one_vec - b0) * b0;
+        a1 = a1 * (one_vec - b1) * b1;
+        return convert_float_bfloat16(a0, a1);
+      });
+    return;
+  }
+  AT_DISPATCH_FLOATING_TYPES_AND(kHalf, iter.dtype(), "sigmoid_backward_cpu", [&]() {
+    auto one_vec = Vectorized<scalar_t>((scalar_t)(1));
     cpu_kernel_vec(iter,
       [=](scalar_t a, scalar_t b) -> scalar_t {
         return a * (scalar_t(1) - b) * b;
       },
-      [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+      [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
         return a * (one_vec - b) * b;
       });
   });
@@ -687,10 +707,10 @@ void logit_backward_kernel(TensorIterator& iter, Scalar eps_scalar) {
   AT_DISPATCH_FLOATING_TYPES_AND(
       kBFloat16, iter.dtype(), "logit_backward_cpu", [&]() {
         const scalar_t eps = eps_scalar.to<scalar_t>();
-        const Vec256<scalar_t> kZeroVec(scalar_t(0));
-        const Vec256<scalar_t> kOneVec(scalar_t(1));
+        const Vectorized<scalar_t> kZeroVec(scalar_t(0));
+        const Vectorized<scalar_t> kOneVec(scalar_t(1));
         if (eps < scalar_t(0)) {
-          const Vec256<scalar_t> kNanVec(
+          const Vectorized<scalar_t> kNanVec(
               std::numeric_limits<scalar_t>::quiet_NaN());
           cpu_kernel_vec(
               iter,
@@ -702,8 +722,8 @@ void logit_backward_kernel(TensorIterator& iter, Scalar eps_scalar) {
                            : (dy / (x * (scalar_t(1) - x))));
               },
               [kZeroVec, kOneVec, kNanVec](
-                  Vec256<scalar_t> dy_vec, Vec256<scalar_t> x_vec) {
-                return Vec256<scalar_t>::blendv(
+                  Vectorized<scalar_t> dy_vec, Vectorized<scalar_t> x_vec) {
+                return Vectorized<scalar_t>::blendv(
                     kNanVec,
                     dy_vec / (x_vec * (kOneVec - x_vec)),
                     (x_vec >= kZeroVec) & (x_vec <= kOneVec));
@@ -711,8 +731,8 @@ void logit_backward_kernel(TensorIterator& iter, Scalar eps_scalar) {
         } else {
           const scalar_t lo = eps;
           const scalar_t hi = scalar_t(1) - eps;
-          const Vec256<scalar_t> lo_vec(lo);
-          const Vec256<scalar_t> hi_vec(hi);
+          const Vectorized<scalar_t> lo_vec(lo);
+          const Vectorized<scalar_t> hi_vec(hi);
           cpu_kernel_vec(
               iter,
               [lo, hi](scalar_t dy, scalar_t x) {
@@ -723,8 +743,8 @@ void logit_backward_kernel(TensorIterator& iter, Scalar eps_scalar) {
                            : dy / (x * (scalar_t(1) - x)));
               },
               [kZeroVec, kOneVec, lo_vec, hi_vec](
-                  Vec256<scalar_t> dy_vec, Vec256<scalar_t> x_vec) {
-                return Vec256<scalar_t>::blendv(
+                  Vectorized<scalar_t> dy_vec, Vectorized<scalar_t> x_vec) {
+                return Vectorized<scalar_t>::blendv(
                     kZeroVec,
                     dy_vec / (x_vec * (kOneVec - x_vec)),
                     (x_vec >= lo_vec) & (x_vec <= hi_vec));
@@ -736,25 +756,25 @@ void logit_backward_kernel(TensorIterator& iter, Scalar eps_scalar) {
 void tanh_backward_kernel(TensorIterator& iter) {
   if (isComplexType(iter.dtype())) {
     AT_DISPATCH_COMPLEX_TYPES(iter.dtype(), "tanh_backward_cpu", [&]() {
-      auto one_vec = Vec256<scalar_t>(scalar_t{1});
+      auto one_vec = Vectorized<scalar_t>(scalar_t{1});
     cpu_kernel_vec(
       iter,
       [=](scalar_t a, scalar_t b) -> scalar_t {
         return a * std::conj(scalar_t{1} - b * b);
       },
-      [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+      [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
         return a * (one_vec - b * b).conj();
       });
   });
   } else {
     AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "tanh_backward_cpu", [&]() {
-      auto one_vec = Vec256<scalar_t>(scalar_t{1});
+      auto one_vec = Vectorized<scalar_t>(scalar_t{1});
       cpu_kernel_vec(
         iter,
         [=](scalar_t a, scalar_t b) -> scalar_t {
           return a * (scalar_t{1} - b * b);
         },
-        [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+        [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
           return a * (one_vec - b * b);
         });
     });
@@ -773,7 +793,7 @@ void mse_kernel(TensorIterator& iter) {
         auto diff = a - b;
         return diff * diff;
       },
-      [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+      [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
       auto diff =  a - b;
       return diff * diff;
       });
@@ -795,7 +815,7 @@ void fmod_kernel(TensorIterator& iter) {
         [](scalar_t x, scalar_t d) -> scalar_t {
           return std::fmod(x, d);
         },
-        [](Vec256<scalar_t> x, Vec256<scalar_t> d) {
+        [](Vectorized<scalar_t> x, Vectorized<scalar_t> d) {
           return x.fmod(d);
         });
     });
@@ -814,11 +834,11 @@ void logaddexp_kernel(TensorIterator& iter) {
             return m + std::log((scalar_t)(1.0) + std::exp(-std::abs(a - b)));
           }
         },
-        [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
-          Vec256<scalar_t> inf(std::numeric_limits<scalar_t>::infinity());
-          Vec256<scalar_t> one(1.0);
-          Vec256<scalar_t> m = maximum(a, b);
-          return Vec256<scalar_t>::blendv(
+        [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
+          Vectorized<scalar_t> inf(std::numeric_limits<scalar_t>::infinity());
+          Vectorized<scalar_t> one(1.0);
+          Vectorized<scalar_t> m = maximum(a, b);
+          return Vectorized<scalar_t>::blendv(
               m + (one + (a - b).abs().neg().exp()).log(),
               a,
               (a == b) & (a.abs() == inf));
@@ -838,12 +858,12 @@ void logaddexp2_kernel(TensorIterator& iter) {
             return m + std::log2((scalar_t)(1.0) + std::pow((scalar_t)(2), -std::abs(a - b)));
           }
         },
-        [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
-          Vec256<scalar_t> inf(std::numeric_limits<scalar_t>::infinity());
-          Vec256<scalar_t> one(1.0);
-          Vec256<scalar_t> two(2.0);
-          Vec256<scalar_t> m = maximum(a, b);
-          return Vec256<scalar_t>::blendv(
+        [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
+          Vectorized<scalar_t> inf(std::numeric_limits<scalar_t>::infinity());
+          Vectorized<scalar_t> one(1.0);
+          Vectorized<scalar_t> two(2.0);
+          Vectorized<scalar_t> m = maximum(a, b);
+          return Vectorized<scalar_t>::blendv(
               m + (one + two.pow((a - b).abs().neg())).log2(),
               a,
               (a == b) & (a.abs() == inf));
@@ -879,7 +899,7 @@ void hypot_kernel(TensorIterator& iter) {
         [=](scalar_t a, scalar_t b) -> scalar_t {
             return std::hypot(a, b);
         },
-        [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+        [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
             return a.hypot(b);
         });
   });
@@ -892,7 +912,7 @@ void igamma_kernel(TensorIterator& iter) {
         [=](scalar_t a, scalar_t b) -> scalar_t {
             return calc_igamma(a, b);
         },
-        [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+        [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
             return a.igamma(b);
         });
   });
@@ -905,7 +925,7 @@ void igammac_kernel(TensorIterator& iter) {
         [=](scalar_t a, scalar_t b) -> scalar_t {
             return calc_igammac(a, b);
         },
-        [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+        [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
             return a.igammac(b);
         });
   });
@@ -918,7 +938,7 @@ void nextafter_kernel(TensorIterator& iter) {
         [=](scalar_t a, scalar_t b) -> scalar_t {
             return std::nextafter(a, b);
         },
-        [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+        [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
             return a.nextafter(b);
         });
   });
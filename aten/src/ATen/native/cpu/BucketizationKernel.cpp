@@ -0,0 +1,127 @@
+#include <ATen/ATen.h>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/BucketizationUtils.h>
+
+namespace at { namespace native {
+
+namespace {
+
+// minimal size for searchsorted_cpu_contiguous to run parallel (multithread)
+constexpr int64_t SEARCHSORTED_GRAIN_SIZE = 200;
+
+// Up to this many 1d boundaries, every value is compared against all of them,
+// a vector of values at a time, instead of being binary searched.
+constexpr int64_t SEARCHSORTED_LINEAR_MAX_BOUNDARIES = 16;
+
+// Number of leading elements of the sorted [data, data + size) that come
+// before val: those that are not >= val for the lower bound, and those val is
+// not < for the upper bound, so that 'nan' values land past the end. The
+// halving loop only depends on size, and the comparison selects the next base
+// without a branch (a conditional move), so it does not mispredict.
+template <typename input_t>
+int64_t searchsorted_branchless(const input_t* data, int64_t size, input_t val, bool right) {
+  if (size == 0) {
+    return 0;
+  }
+  const input_t* base = data;
+  int64_t n = size;
+  if (right) {
+    while (n > 1) {
+      const int64_t half = n / 2;
+      base = !(val < base[half]) ? base + half : base;
+      n -= half;
+    }
+    return (base - data) + !(val < *base);
+  }
+  while (n > 1) {
+    const int64_t half = n / 2;
+    base = !(base[half] >= val) ? base + half : base;
+    n -= half;
+  }
+  return (base - data) + !(*base >= val);
+}
+
+// Counts the boundaries before every value, which for sorted boundaries is the
+// position a binary search finds.
+template <typename input_t, typename output_t>
+void searchsorted_cpu_linear(
+    output_t* data_out, const input_t* data_in, const input_t* data_bd,
+    int64_t numel_in, int64_t idim_bd, bool right) {
+  using Vec = vec256::Vec256<input_t>;
+  at::parallel_for(0, numel_in, SEARCHSORTED_GRAIN_SIZE, [&](int64_t start, int64_t end) {
+    input_t counts[Vec::size()];
+    int64_t i = start;
+    for (; i <= end - Vec::size(); i += Vec::size()) {
+      const Vec val = Vec::loadu(data_in + i);
+      Vec count(input_t(0));
+      if (right) {
+        for (int64_t j = 0; j < idim_bd; ++j) {
+          count = count + Vec(data_bd[j]).le(val);
+        }
+      } else {
+        for (int64_t j = 0; j < idim_bd; ++j) {
+          count = count + Vec(data_bd[j]).lt(val);
+        }
+      }
+      // 'nan' values go past the end, as in the binary search
+      count = Vec::blendv(count, Vec(static_cast<input_t>(idim_bd)), val != val);
+      count.store(counts);
+      for (int64_t k = 0; k < Vec::size(); ++k) {
+        data_out[i + k] = static_cast<output_t>(counts[k]);
+      }
+    }
+    for (; i < end; ++i) {
+      data_out[i] = searchsorted_branchless(data_bd, idim_bd, data_in[i], right);
+    }
+  });
+}
+
+template<typename input_t, typename output_t>
+void searchsorted_cpu_contiguous(Tensor& result, const Tensor& input, const Tensor& boundaries, const bool& right) {
+  int64_t numel_in = input.numel();
+  bool is_scalar_input = input.dim() == 0 && numel_in == 1;
+  // inner most dim size of input and boundaries
+  int64_t idim_in = is_scalar_input ? 1 : input.sizes().back();
+  int64_t idim_bd = boundaries.sizes().back();
+
+  const input_t *data_in = input.data_ptr<input_t>();
+  const input_t *data_bd = boundaries.data_ptr<input_t>();
+  output_t *data_out = result.data_ptr<output_t>();
+
+  bool is_1d_boundaries = boundaries.dim() == 1;
+  if (is_1d_boundaries && idim_bd <= SEARCHSORTED_LINEAR_MAX_BOUNDARIES) {
+    searchsorted_cpu_linear(data_out, data_in, data_bd, numel_in, idim_bd, right);
+    return;
+  }
+
+  at::parallel_for(0, numel_in, SEARCHSORTED_GRAIN_SIZE, [&](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; ++i) {
+      // If boundaries tensor is 1d, we always search the entire boundary tensor
+      int64_t start_bd = is_1d_boundaries ? 0 : i / idim_in * idim_bd;
+      // type conversion might happen here
+      data_out[i] = searchsorted_branchless(data_bd + start_bd, idim_bd, data_in[i], right);
+    }
+  });
+}
+
+void searchsorted_kernel(Tensor& result, const Tensor& input, const Tensor& boundaries, bool right) {
+  if (result.scalar_type() == kLong) {
+    AT_DISPATCH_ALL_TYPES(input.scalar_type(), "searchsorted_out_cpu", [&] {
+      searchsorted_cpu_contiguous<scalar_t, int64_t>(result, input, boundaries, right);
+    });
+  }
+  else {
+    AT_DISPATCH_ALL_TYPES(input.scalar_type(), "searchsorted_out_cpu", [&] {
+      searchsorted_cpu_contiguous<scalar_t, int>(result, input, boundaries, right);
+    });
+  }
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(searchsorted_stub, &searchsorted_kernel);
+
+}} // at::native
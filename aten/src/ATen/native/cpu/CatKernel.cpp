@@ -1,69 +1,119 @@
 #include <ATen/ATen.h>
 
-#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
 #include <ATen/native/cpu/CatKernel.h>
-#include <ATen/cpu/vec256/functional.h>
-#include <ATen/cpu/vec256/vec256.h>
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
 
 namespace at { namespace native {
 
 namespace {
 
-struct InputMeta {
-  void* data_ptr;
-  int64_t inner_size;
-
-  InputMeta(const Tensor& t, int64_t dim, int64_t inner)
-    : data_ptr(t.data_ptr())
-    , inner_size(t.sizes()[dim] * inner) {}
+// The part of every row of the output that an input covers. Along the memory
+// order of the output, the dims before `dim` index the rows, and a row is the
+// concatenation of the blocks of the inputs.
+struct Segment {
+  int64_t start;
+  int64_t length;
+  const char* data;
 };
 
-template <typename scalar_t>
-void cat_serial_kernel_impl(Tensor& result, TensorList tensors, int64_t dim) {
+// The dims of a tensor of the memory format, outermost first
+std::vector<int64_t> memory_order(int64_t ndim, MemoryFormat memory_format) {
+  std::vector<int64_t> order(ndim);
+  std::iota(order.begin(), order.end(), 0);
+  if (memory_format == MemoryFormat::ChannelsLast ||
+      memory_format == MemoryFormat::ChannelsLast3d) {
+    std::rotate(order.begin() + 1, order.begin() + 2, order.end());
+  }
+  return order;
+}
+
+void cat_contiguous_kernel(
+    const Tensor& result,
+    TensorList inputs,
+    IntArrayRef offsets,
+    int64_t dim,
+    MemoryFormat memory_format) {
   TORCH_INTERNAL_ASSERT_DEBUG_ONLY(
-      dim >= 0 && dim < result.dim(), "dim out of range in cat_serial_kernel_impl");
-  int64_t outer = result.numel() / (result.sizes()[dim] * result.strides()[dim]);
-  scalar_t* result_data = result.data_ptr<scalar_t>();
-  int64_t ninputs = tensors.size();
-  std::vector<InputMeta> inputs;
-  inputs.reserve(ninputs);
-  for (auto const &tensor : tensors) {
-    inputs.emplace_back(tensor, dim, result.strides()[dim]);
+      dim >= 0 && dim < result.dim(), "dim out of range in cat_contiguous_kernel");
+  // The sizes, not the strides, give the layout, as the strides of size 1
+  // dims are arbitrary.
+  const auto order = memory_order(result.dim(), memory_format);
+  const auto pos = std::find(order.begin(), order.end(), dim) - order.begin();
+  int64_t outer = 1;
+  int64_t inner = 1;
+  for (int64_t i = 0; i < result.dim(); i++) {
+    if (i < pos) {
+      outer *= result.size(order[i]);
+    } else if (i > pos) {
+      inner *= result.size(order[i]);
+    }
   }
+  const int64_t row = result.size(dim) * inner;
+  const int64_t element_size = result.element_size();
 
-  using Vec = vec256::Vec256<scalar_t>;
-  scalar_t* result_ptr = result_data;
-  for (int64_t i = 0; i < outer; ++i) {
-    for (int64_t j = 0; j < ninputs; j++) {
-      int64_t local_inner = inputs[j].inner_size;
-      scalar_t* input_ptr = (scalar_t*)(inputs[j].data_ptr) + i * local_inner;
-      if (local_inner < Vec::size()) {
-        #if !defined(_MSC_VER) && !defined(COMPILING_FOR_MIN_SIZE)
-        # pragma unroll
-        #endif
-        for (int64_t k = 0; k < local_inner; k++) {
-          result_ptr[k] = input_ptr[k];
-        }
-      } else {
-        vec256::map(
-            [](Vec x) { return x; },
-            result_ptr,
-            input_ptr,
-            local_inner);
-      }
-      result_ptr += local_inner;
+  std::vector<Segment> segments;
+  segments.reserve(inputs.size());
+  for (size_t i = 0; i < inputs.size(); i++) {
+    if (inputs[i].numel() > 0) {
+      segments.push_back({
+          offsets[i] * inner,
+          inputs[i].size(dim) * inner,
+          static_cast<const char*>(inputs[i].data_ptr())});
     }
   }
-}
+  std::sort(segments.begin(), segments.end(), [](const Segment& a, const Segment& b) {
+    return a.start < b.start;
+  });
+  if (segments.empty()) {
+    return;
+  }
+  char* result_data = static_cast<char*>(result.data_ptr());
 
-void cat_serial_kernel(Tensor& result, TensorList tensors, int64_t dim) {
-  AT_DISPATCH_FLOATING_TYPES(result.scalar_type(), "cat_serial_kernel", [&]() {
-    cat_serial_kernel_impl<scalar_t>(result, tensors, dim);
+  // Every chunk of the output, in elements, copies the parts of the segments
+  // it overlaps. The rows of the inputs that aren't given are skipped.
+  at::parallel_for(0, outer * row, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    int64_t r = begin / row;
+    int64_t p = begin % row;
+    size_t s = std::upper_bound(segments.begin(), segments.end(), p,
+        [](int64_t value, const Segment& segment) { return value < segment.start; }) - segments.begin();
+    if (s > 0 && p < segments[s - 1].start + segments[s - 1].length) {
+      s--;
+    }
+    int64_t cur = begin;
+    while (cur < end) {
+      if (s == segments.size()) {
+        r++;
+        p = 0;
+        s = 0;
+        cur = r * row;
+        continue;
+      }
+      const Segment& segment = segments[s];
+      if (p < segment.start) {
+        cur += segment.start - p;
+        p = segment.start;
+        continue;
+      }
+      const int64_t n = std::min(segment.start + segment.length - p, end - cur);
+      std::memcpy(
+          result_data + (r * row + p) * element_size,
+          segment.data + (r * segment.length + p - segment.start) * element_size,
+          n * element_size);
+      cur += n;
+      p += n;
+      if (p == segment.start + segment.length) {
+        s++;
+      }
+    }
   });
 }
 
 } // anonymous namespace
 
-REGISTER_DISPATCH(cat_serial_stub, &cat_serial_kernel);
+REGISTER_DISPATCH(cat_contiguous_stub, &cat_contiguous_kernel);
 
 }} // at::native
@@ -5,7 +5,12 @@
 
 namespace at { namespace native {
 
-using cat_serial_fn = void(*)(Tensor &, TensorList, int64_t);
-DECLARE_DISPATCH(cat_serial_fn, cat_serial_stub);
+// Copies `inputs` into `result`, the input i going to the slice of `result`
+// starting at `offsets[i]` along `dim`. `result` and the inputs must have the
+// same dtype and be contiguous in `memory_format`. The output is split into
+// chunks across threads, so that the copies of both few large inputs and
+// many small ones run in parallel.
+using cat_contiguous_fn = void(*)(const Tensor&, TensorList, IntArrayRef, int64_t, MemoryFormat);
+DECLARE_DISPATCH(cat_contiguous_fn, cat_contiguous_stub);
 
 }}  // namespace at::native
@@ -0,0 +1,126 @@
+#include <ATen/ATen.h>
+
+#include <ATen/Dispatch.h>
+#include <ATen/native/ConvolutionDirect2d.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <algorithm>
+
+namespace at { namespace native {
+
+namespace {
+
+// See Note [direct channels last convolution]
+template <typename scalar_t>
+void cpu_conv2d_channels_last_direct(
+    Tensor& output,
+    const Tensor& input,
+    const Tensor& weight,
+    const Tensor& bias,
+    IntArrayRef stride,
+    IntArrayRef padding) {
+  using Vec = vec256::Vec256<scalar_t>;
+  // Output channels of a block are accumulated in kVecs registers.
+  constexpr int64_t kVecs = 4;
+  constexpr int64_t kBlock = kVecs * Vec::size();
+
+  const int64_t batch = input.size(0);
+  const int64_t input_channels = input.size(1);
+  const int64_t input_height = input.size(2);
+  const int64_t input_width = input.size(3);
+  const int64_t output_channels = output.size(1);
+  const int64_t output_height = output.size(2);
+  const int64_t output_width = output.size(3);
+  const int64_t kernel_height = weight.size(2);
+  const int64_t kernel_width = weight.size(3);
+  const int64_t num_blocks = divup(output_channels, kBlock);
+  const int64_t padded_channels = num_blocks * kBlock;
+
+  // [block][kh][kw][ic][kBlock], with the output channels zero padded to a
+  // whole number of blocks
+  const Tensor packed_weight = at::constant_pad_nd(
+      weight.permute({2, 3, 1, 0}), {0, padded_channels - output_channels})
+      .view({kernel_height, kernel_width, input_channels, num_blocks, kBlock})
+      .permute({3, 0, 1, 2, 4})
+      .contiguous();
+  Tensor padded_bias = at::zeros({padded_channels}, output.options());
+  if (bias.defined()) {
+    padded_bias.narrow(0, 0, output_channels).copy_(bias);
+  }
+
+  const scalar_t* input_data = input.data_ptr<scalar_t>();
+  const scalar_t* weight_data = packed_weight.data_ptr<scalar_t>();
+  const scalar_t* bias_data = padded_bias.data_ptr<scalar_t>();
+  scalar_t* output_data = output.data_ptr<scalar_t>();
+  const int64_t block_size = kernel_height * kernel_width * input_channels * kBlock;
+
+  // parallel on dim of N, H
+  const int64_t row_cost = output_width * padded_channels * kernel_height * kernel_width * input_channels;
+  const int64_t grain_size = std::max<int64_t>(1, at::internal::GRAIN_SIZE / std::max<int64_t>(1, row_cost));
+  at::parallel_for(0, batch * output_height, grain_size, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      const int64_t n = i / output_height;
+      const int64_t oh = i % output_height;
+      const int64_t ih0 = oh * stride[0] - padding[0];
+      const int64_t kh_begin = std::max<int64_t>(0, -ih0);
+      const int64_t kh_end = std::min(kernel_height, input_height - ih0);
+      for (int64_t b = 0; b < num_blocks; b++) {
+        const scalar_t* block_weight = weight_data + b * block_size;
+        for (int64_t ow = 0; ow < output_width; ow++) {
+          const int64_t iw0 = ow * stride[1] - padding[1];
+          const int64_t kw_begin = std::max<int64_t>(0, -iw0);
+          const int64_t kw_end = std::min(kernel_width, input_width - iw0);
+
+          Vec acc[kVecs];
+          for (int64_t j = 0; j < kVecs; j++) {
+            acc[j] = Vec::loadu(bias_data + b * kBlock + j * Vec::size());
+          }
+          for (int64_t kh = kh_begin; kh < kh_end; kh++) {
+            for (int64_t kw = kw_begin; kw < kw_end; kw++) {
+              const scalar_t* in = input_data +
+                  ((n * input_height + ih0 + kh) * input_width + iw0 + kw) * input_channels;
+              const scalar_t* w = block_weight + (kh * kernel_width + kw) * input_channels * kBlock;
+              for (int64_t ic = 0; ic < input_channels; ic++) {
+                const Vec x(in[ic]);
+                for (int64_t j = 0; j < kVecs; j++) {
+                  acc[j] = vec256::fmadd(x, Vec::loadu(w + ic * kBlock + j * Vec::size()), acc[j]);
+                }
+              }
+            }
+          }
+
+          scalar_t* out = output_data +
+              ((n * output_height + oh) * output_width + ow) * output_channels + b * kBlock;
+          for (int64_t j = 0; j < kVecs; j++) {
+            const int64_t count = std::min<int64_t>(
+                Vec::size(), output_channels - b * kBlock - j * Vec::size());
+            if (count == Vec::size()) {
+              acc[j].store(out + j * Vec::size());
+            } else if (count > 0) {
+              acc[j].store(out + j * Vec::size(), count);
+            }
+          }
+        }
+      }
+    }
+  });
+}
+
+void conv2d_channels_last_direct_kernel_impl(
+    Tensor& output,
+    const Tensor& input,
+    const Tensor& weight,
+    const Tensor& bias,
+    IntArrayRef stride,
+    IntArrayRef padding) {
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "conv2d_channels_last_direct", [&] {
+    cpu_conv2d_channels_last_direct<scalar_t>(output, input, weight, bias, stride, padding);
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(conv2d_channels_last_direct_kernel, &conv2d_channels_last_direct_kernel_impl);
+
+}} // at::native
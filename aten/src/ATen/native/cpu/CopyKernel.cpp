@@ -4,13 +4,205 @@
 #include <ATen/native/Copy.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/cpu/Loops.h>
+#include <ATen/cpu/vec256/intrinsics.h>
 #include <c10/util/TypeCast.h>
 
 namespace at {
 namespace native {
 namespace {
 
+// Copies where the input is transposed relative to the output, e.g.
+// x.t().contiguous() or NCHW <-> NHWC, are done in square tiles so that the
+// input rows read by a tile stay in cache while its output rows are written.
+constexpr int64_t kTransposeTile = 32;
+constexpr int64_t kMinTransposeNumel = 60 * 60;
+
+template <typename dest_t, typename src_t>
+inline void transpose_tile_scalar(
+    char* dst,
+    int64_t dst_stride1,
+    const char* src,
+    int64_t src_stride0,
+    int64_t i0,
+    int64_t i1,
+    int64_t j0,
+    int64_t j1) {
+  for (int64_t j = j0; j < j1; ++j) {
+    auto* out = reinterpret_cast<dest_t*>(dst + j * dst_stride1);
+    const char* in = src + j * sizeof(src_t);
+    for (int64_t i = i0; i < i1; ++i) {
+      out[i] = c10::static_cast_with_inter_type<dest_t, src_t>::apply(
+          *reinterpret_cast<const src_t*>(in + i * src_stride0));
+    }
+  }
+}
+
+template <typename dest_t, typename src_t>
+inline void transpose_tile(
+    char* dst,
+    int64_t dst_stride1,
+    const char* src,
+    int64_t src_stride0,
+    int64_t i0,
+    int64_t i1,
+    int64_t j0,
+    int64_t j1) {
+  transpose_tile_scalar<dest_t, src_t>(
+      dst, dst_stride1, src, src_stride0, i0, i1, j0, j1);
+}
+
+#if (defined(CPU_CAPABILITY_AVX) || defined(CPU_CAPABILITY_AVX2)) && !defined(_MSC_VER)
+// Transposes an 8 x 8 block of 32-bit elements in registers. The shuffles
+// only move bits around, so this is used for any 4-byte dtype.
+inline void transpose_8x8_32bit(
+    const char* src,
+    int64_t src_stride,
+    char* dst,
+    int64_t dst_stride) {
+  __m256 r0 = _mm256_loadu_ps(reinterpret_cast<const float*>(src));
+  __m256 r1 = _mm256_loadu_ps(reinterpret_cast<const float*>(src + src_stride));
+  __m256 r2 = _mm256_loadu_ps(reinterpret_cast<const float*>(src + 2 * src_stride));
+  __m256 r3 = _mm256_loadu_ps(reinterpret_cast<const float*>(src + 3 * src_stride));
+  __m256 r4 = _mm256_loadu_ps(reinterpret_cast<const float*>(src + 4 * src_stride));
+  __m256 r5 = _mm256_loadu_ps(reinterpret_cast<const float*>(src + 5 * src_stride));
+  __m256 r6 = _mm256_loadu_ps(reinterpret_cast<const float*>(src + 6 * src_stride));
+  __m256 r7 = _mm256_loadu_ps(reinterpret_cast<const float*>(src + 7 * src_stride));
+
+  // interleave pairs of rows
+  __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+  __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+  __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+  __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+  __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+  __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+  __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+  __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+
+  // 4 x 4 blocks transposed within each 128-bit lane
+  r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+  r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+  r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+  r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+  r4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+  r5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+  r6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+  r7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+  // swap the off-diagonal 128-bit lanes
+  _mm256_storeu_ps(reinterpret_cast<float*>(dst), _mm256_permute2f128_ps(r0, r4, 0x20));
+  _mm256_storeu_ps(reinterpret_cast<float*>(dst + dst_stride), _mm256_permute2f128_ps(r1, r5, 0x20));
+  _mm256_storeu_ps(reinterpret_cast<float*>(dst + 2 * dst_stride), _mm256_permute2f128_ps(r2, r6, 0x20));
+  _mm256_storeu_ps(reinterpret_cast<float*>(dst + 3 * dst_stride), _mm256_permute2f128_ps(r3, r7, 0x20));
+  _mm256_storeu_ps(reinterpret_cast<float*>(dst + 4 * dst_stride), _mm256_permute2f128_ps(r0, r4, 0x31));
+  _mm256_storeu_ps(reinterpret_cast<float*>(dst + 5 * dst_stride), _mm256_permute2f128_ps(r1, r5, 0x31));
+  _mm256_storeu_ps(reinterpret_cast<float*>(dst + 6 * dst_stride), _mm256_permute2f128_ps(r2, r6, 0x31));
+  _mm256_storeu_ps(reinterpret_cast<float*>(dst + 7 * dst_stride), _mm256_permute2f128_ps(r3, r7, 0x31));
+}
+
+template <>
+inline void transpose_tile<uint32_t, uint32_t>(
+    char* dst,
+    int64_t dst_stride1,
+    const char* src,
+    int64_t src_stride0,
+    int64_t i0,
+    int64_t i1,
+    int64_t j0,
+    int64_t j1) {
+  const int64_t i_end = i0 + (i1 - i0) / 8 * 8;
+  const int64_t j_end = j0 + (j1 - j0) / 8 * 8;
+  for (int64_t j = j0; j < j_end; j += 8) {
+    for (int64_t i = i0; i < i_end; i += 8) {
+      transpose_8x8_32bit(
+          src + i * src_stride0 + j * sizeof(uint32_t),
+          src_stride0,
+          dst + j * dst_stride1 + i * sizeof(uint32_t),
+          dst_stride1);
+    }
+  }
+  transpose_tile_scalar<uint32_t, uint32_t>(
+      dst, dst_stride1, src, src_stride0, i_end, i1, j0, j1);
+  transpose_tile_scalar<uint32_t, uint32_t>(
+      dst, dst_stride1, src, src_stride0, i0, i_end, j_end, j1);
+}
+#endif
+
+// Dim 0 of the iterator is contiguous in the output and dim 1 in the input,
+// see transpose_copy
+template <typename dest_t, typename src_t>
+void transpose_copy_loop(TensorIterator& iter) {
+  auto loop = [](char** data, const int64_t* strides, int64_t size0, int64_t size1) {
+    const int64_t src_stride0 = strides[1];
+    const int64_t dst_stride1 = strides[2];
+    for (int64_t j0 = 0; j0 < size1; j0 += kTransposeTile) {
+      const int64_t j1 = std::min(size1, j0 + kTransposeTile);
+      for (int64_t i0 = 0; i0 < size0; i0 += kTransposeTile) {
+        const int64_t i1 = std::min(size0, i0 + kTransposeTile);
+        transpose_tile<dest_t, src_t>(
+            data[0], dst_stride1, data[1], src_stride0, i0, i1, j0, j1);
+      }
+    }
+  };
+  iter.for_each(loop);
+}
+
+// Returns false if the copy isn't a transpose or its dtypes aren't handled.
+// Copies within a dtype only move bytes, so they are done on unsigned
+// integers of the element size; conversions between the floating types are
+// done while a tile is copied.
+bool transpose_copy(TensorIterator& iter) {
+  if (iter.ndim() < 2 || iter.numel() < kMinTransposeNumel ||
+      iter.shape()[0] < 8 || iter.shape()[1] < 8) {
+    return false;
+  }
+  const int64_t dst_size = iter.element_size(0);
+  const int64_t src_size = iter.element_size(1);
+  if (iter.strides(0)[0] != dst_size || iter.strides(1)[1] != src_size ||
+      iter.strides(1)[0] == src_size) {
+    return false;
+  }
+  ScalarType dst_dtype = iter.dtype(0);
+  ScalarType src_dtype = iter.dtype(1);
+  if (dst_dtype == src_dtype) {
+    if (isQIntType(dst_dtype)) {
+      return false;
+    }
+    switch (dst_size) {
+      case 1:
+        transpose_copy_loop<uint8_t, uint8_t>(iter);
+        return true;
+      case 2:
+        transpose_copy_loop<uint16_t, uint16_t>(iter);
+        return true;
+      case 4:
+        transpose_copy_loop<uint32_t, uint32_t>(iter);
+        return true;
+      case 8:
+        transpose_copy_loop<uint64_t, uint64_t>(iter);
+        return true;
+      case 16:
+        transpose_copy_loop<c10::complex<double>, c10::complex<double>>(iter);
+        return true;
+      default:
+        return false;
+    }
+  }
+  if (!isFloatingType(dst_dtype) || !isFloatingType(src_dtype)) {
+    return false;
+  }
+  AT_DISPATCH_FLOATING_TYPES_AND2(kHalf, kBFloat16, dst_dtype, "transpose_copy", [&] {
+    using dest_t = scalar_t;
+    AT_DISPATCH_FLOATING_TYPES_AND2(kHalf, kBFloat16, src_dtype, "transpose_copy", [&] {
+      transpose_copy_loop<dest_t, scalar_t>(iter);
+    });
+  });
+  return true;
+}
+
 static void copy_kernel(TensorIterator& iter, bool non_blocking) {
+  if (transpose_copy(iter)) {
+    return;
+  }
   ScalarType dtype = iter.dtype(0);
   if (dtype == iter.dtype(1)) {
     if (dtype == ScalarType::Half) {
@@ -2,13 +2,15 @@
 
 #include <ATen/Dispatch.h>
 #include <ATen/CPUApplyUtils.h>
+#include <ATen/Parallel.h>
 #include <ATen/core/DistributionsHelper.h>
+#include <ATen/core/PhiloxRNGEngine.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/cpu/Loops.h>
 #include <limits>
 #include <mutex>
 
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
 #include <ATen/native/cpu/avx_mathfun.h>
 #endif
 
@@ -19,6 +21,56 @@ namespace templates {
 namespace cpu {
 namespace {
 
+// ==================================================== Philox ========================================================
+
+// Large contiguous tensors are filled in parallel from a Philox engine seeded
+// with a number drawn from the generator. Element i always takes the random
+// numbers at counter offset i * words of the engine, so every chunk of a
+// parallel_for starts its own engine at its first element, and the result
+// only depends on the seed, not on the number of threads.
+template <typename scalar_t>
+struct philox_words {
+  // as many 32-bit numbers as uniform_real_distribution<scalar_t> uses
+  static constexpr int value = std::is_same<scalar_t, double>::value ? 2 : 1;
+};
+
+inline bool use_philox(const Tensor& self) {
+  return self.is_contiguous() && self.numel() >= at::internal::GRAIN_SIZE;
+}
+
+template<typename RNG>
+uint64_t philox_seed(RNG generator) {
+  // See Note [Acquire lock when using random generators]
+  std::lock_guard<std::mutex> lock(generator->mutex_);
+  return generator->random64();
+}
+
+// Calls f(i, bits) for i in [begin, end), with the 32 or 64 random bits of
+// element i
+template <int words, typename func_t>
+inline void philox_for_each(uint64_t seed, int64_t begin, int64_t end, const func_t& f) {
+  const uint64_t first = static_cast<uint64_t>(begin) * words;
+  at::Philox4_32_10 engine(seed, 0, first / 4);
+  for (uint64_t i = 0; i < first % 4; ++i) {
+    engine();
+  }
+  for (int64_t i = begin; i < end; ++i) {
+    uint64_t bits = engine();
+    if (words == 2) {
+      bits = (bits << 32) | engine();
+    }
+    f(i, bits);
+  }
+}
+
+// Fills out[0, end - begin) with the uniforms of elements [begin, end)
+template <typename scalar_t>
+inline void philox_uniform_fill(uint64_t seed, scalar_t* out, int64_t begin, int64_t end, scalar_t from, scalar_t to) {
+  philox_for_each<philox_words<scalar_t>::value>(seed, begin, end, [=](int64_t i, uint64_t bits) {
+    out[i - begin] = static_cast<scalar_t>(transformation::uniform_real<scalar_t>(bits, from, to));
+  });
+}
+
 // ==================================================== Random ========================================================
 
 template<typename RNG>
@@ -83,7 +135,7 @@ struct RandomKernel {
 
 // ==================================================== Normal ========================================================
 
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
 static void normal_fill_16_AVX2(float *data,
                          const __m256* two_pi,
                          const __m256* one,
@@ -170,11 +222,55 @@ void normal_fill(Tensor& self, const scalar_t mean, const scalar_t std, RNG gene
   }
 }
 
+// Box-Muller on the uniforms in data[0, 16), like normal_fill_16
+template <typename scalar_t>
+inline void normal_fill_16_vec(scalar_t *data, const scalar_t mean, const scalar_t std) {
+  using Vec = vec256::Vec256<scalar_t>;
+  for (int j = 0; j < 8; j += Vec::size()) {
+    const Vec u1 = Vec(1) - Vec::loadu(data + j); // [0, 1) -> (0, 1] for log.
+    const Vec u2 = Vec::loadu(data + j + 8);
+    const Vec radius = (Vec(-2) * u1.log()).sqrt();
+    const Vec theta = Vec(2.0 * c10::pi<double>) * u2;
+    (radius * theta.cos() * Vec(std) + Vec(mean)).store(data + j);
+    (radius * theta.sin() * Vec(std) + Vec(mean)).store(data + j + 8);
+  }
+}
+
+// Fills groups of 16 elements in parallel, each from its own 16 uniforms
+template <typename scalar_t>
+void normal_fill_philox(Tensor& self, const scalar_t mean, const scalar_t std, uint64_t seed) {
+  scalar_t *data = self.data_ptr<scalar_t>();
+  const int64_t size = self.numel();
+  const int64_t groups = (size + 15) / 16;
+  at::parallel_for(0, groups, at::internal::GRAIN_SIZE / 16, [&](int64_t begin, int64_t end) {
+    const int64_t full_end = std::min(end, size / 16);
+    if (begin < full_end) {
+      philox_uniform_fill<scalar_t>(seed, data + begin * 16, begin * 16, full_end * 16, 0, 1);
+      for (int64_t g = begin; g < full_end; ++g) {
+        normal_fill_16_vec<scalar_t>(data + g * 16, mean, std);
+      }
+    }
+    if (full_end < end) {
+      // the last, partial group is filled as if the tensor went on
+      scalar_t buf[16];
+      const int64_t first = full_end * 16;
+      philox_uniform_fill<scalar_t>(seed, buf, first, first + 16, 0, 1);
+      normal_fill_16_vec<scalar_t>(buf, mean, std);
+      std::copy(buf, buf + (size - first), data + first);
+    }
+  });
+}
+
 template<typename RNG>
 void normal_kernel(Tensor& self, double mean, double std, RNG generator) {
   auto size = self.numel();
-  if (self.scalar_type() == ScalarType::Float && size >= 16 && self.is_contiguous()) {
-#ifdef CPU_CAPABILITY_AVX2
+  if ((self.scalar_type() == ScalarType::Float || self.scalar_type() == ScalarType::Double) && use_philox(self)) {
+    const uint64_t seed = philox_seed(generator);
+    AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "normal_kernel_cpu", [&] {
+      normal_fill_philox<scalar_t>(self, static_cast<scalar_t>(mean), static_cast<scalar_t>(std), seed);
+    });
+  } else if (self.scalar_type() == ScalarType::Float && size >= 16 && self.is_contiguous()) {
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
     normal_fill_AVX2(self, static_cast<float>(mean), static_cast<float>(std), generator);
 #else
     normal_fill(self, static_cast<float>(mean), static_cast<float>(std), generator);
@@ -207,9 +303,17 @@ struct NormalKernel {
 template<typename RNG>
 void uniform_kernel(TensorIterator& iter, double from_, double to_, RNG generator) {
   AT_DISPATCH_FLOATING_TYPES_AND2(kHalf, kBFloat16, iter.dtype(), "uniform_kernel_cpu", [&]() {
-    std::lock_guard<std::mutex> lock(generator->mutex_);
     auto from = static_cast<scalar_t>(from_);
     auto to = static_cast<scalar_t>(to_);
+    if (use_philox(iter.tensor(0))) {
+      const uint64_t seed = philox_seed(generator);
+      scalar_t* data = iter.tensor(0).data_ptr<scalar_t>();
+      at::parallel_for(0, iter.numel(), at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+        philox_uniform_fill<scalar_t>(seed, data + begin, begin, end, from, to);
+      });
+      return;
+    }
+    std::lock_guard<std::mutex> lock(generator->mutex_);
     at::uniform_real_distribution<scalar_t> uniform(from, to);
     cpu_serial_kernel(iter, [&uniform, generator]() -> scalar_t {
       return static_cast<scalar_t>(uniform(generator));
@@ -338,6 +442,17 @@ void bernoulli_kernel(Tensor& self, const Tensor& p_, RNG generator) {
 template<typename RNG>
 void bernoulli_kernel(Tensor& self, double p, RNG generator) {
   AT_DISPATCH_ALL_TYPES_AND(at::ScalarType::Bool, self.scalar_type(), "bernoulli_scalar_cpu_", [&] {
+    if (use_philox(self)) {
+      const uint64_t seed = philox_seed(generator);
+      scalar_t* data = self.data_ptr<scalar_t>();
+      at::parallel_for(0, self.numel(), at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+        // same as bernoulli_distribution<double>
+        philox_for_each<2>(seed, begin, end, [=](int64_t i, uint64_t bits) {
+          data[i] = static_cast<scalar_t>(transformation::uniform_real<double>(bits, 0, 1) < p);
+        });
+      });
+      return;
+    }
     // See Note [Acquire lock when using random generators]
     std::lock_guard<std::mutex> lock(generator->mutex_);
     auto iter = TensorIterator::nullary_op(self);
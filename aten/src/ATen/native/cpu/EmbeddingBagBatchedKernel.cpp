@@ -0,0 +1,194 @@
+#include <ATen/ATen.h>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/functional.h>
+#include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/EmbeddingBag.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace at { namespace native {
+
+namespace {
+
+template <typename scalar_t, typename index_t>
+void cpu_embedding_bag_batched(
+    Tensor& output,
+    const Tensor& weight,
+    const Tensor& weight_offsets,
+    const Tensor& indices,
+    const Tensor& offsets,
+    const Tensor& per_sample_weights,
+    bool mean) {
+  const int64_t num_tables = weight_offsets.numel() - 1;
+  const int64_t num_bags = offsets.numel() - 1;
+  const int64_t batch_size = num_bags / num_tables;
+  const int64_t ddim = weight.size(1);
+  const int64_t num_indices = indices.numel();
+
+  const scalar_t* weight_data = weight.data_ptr<scalar_t>();
+  const int64_t* weight_offsets_data = weight_offsets.data_ptr<int64_t>();
+  const index_t* indices_data = indices.data_ptr<index_t>();
+  const index_t* offsets_data = offsets.data_ptr<index_t>();
+  const scalar_t* per_sample_weights_data =
+      per_sample_weights.defined() ? per_sample_weights.data_ptr<scalar_t>() : nullptr;
+  scalar_t* output_data = output.data_ptr<scalar_t>();
+
+  TORCH_CHECK(weight_offsets_data[0] >= 0 && weight_offsets_data[num_tables] <= weight.size(0),
+      "_embedding_bag_batched: expected the tables to lie within the ", weight.size(0),
+      " rows of weight, but weight_offsets spans [", weight_offsets_data[0], ", ",
+      weight_offsets_data[num_tables], ")");
+
+  using Vec = vec256::Vec256<scalar_t>;
+  // parallel on all the bags of all the tables at once
+  at::parallel_for(0, num_bags, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t bag = begin; bag < end; bag++) {
+      const int64_t table = bag / batch_size;
+      const int64_t sample = bag % batch_size;
+      const int64_t row_start = weight_offsets_data[table];
+      const int64_t table_rows = weight_offsets_data[table + 1] - row_start;
+      const int64_t bag_start = offsets_data[bag];
+      const int64_t bag_end = offsets_data[bag + 1];
+      TORCH_CHECK(bag_start >= 0 && bag_start <= bag_end && bag_end <= num_indices,
+          "_embedding_bag_batched: expected offsets to be non-decreasing and within [0, ",
+          num_indices, "], but bag ", bag, " covers [", bag_start, ", ", bag_end, ")");
+
+      scalar_t* out = output_data + (sample * num_tables + table) * ddim;
+      std::fill(out, out + ddim, scalar_t(0));
+      for (int64_t i = bag_start; i < bag_end; i++) {
+        const int64_t index = indices_data[i];
+        TORCH_CHECK(index >= 0 && index < table_rows,
+            "_embedding_bag_batched: index ", index, " is out of range for table ", table,
+            " of ", table_rows, " rows");
+        const scalar_t* row = weight_data + (row_start + index) * ddim;
+        const Vec scale(per_sample_weights_data ? per_sample_weights_data[i] : scalar_t(1));
+        vec256::map2(
+            [scale](Vec acc, Vec w) { return acc + w * scale; },
+            out, out, row, ddim);
+      }
+      // Empty bags return all 0s instead of dividing by 0
+      if (mean && bag_end > bag_start) {
+        const Vec bag_size(static_cast<scalar_t>(bag_end - bag_start));
+        vec256::map([bag_size](Vec acc) { return acc / bag_size; }, out, out, ddim);
+      }
+    }
+  });
+}
+
+template <typename scalar_t>
+void cpu_embedding_bag_batched_backward(
+    Tensor& target,
+    Tensor& momentum,
+    const Tensor& grad,
+    const EmbeddingBagBatchedSegments& segments,
+    const Tensor& offsets,
+    const Tensor& per_sample_weights,
+    bool mean,
+    EmbeddingBagBatchedUpdate update,
+    double lr,
+    double eps) {
+  const int64_t num_segments = segments.rows.numel();
+  const int64_t ddim = target.size(1);
+  const int64_t batch_size = grad.size(0);
+  const int64_t grad_stride = grad.size(1);
+
+  const int64_t* rows_data = segments.rows.data_ptr<int64_t>();
+  const int64_t* segment_offsets_data = segments.segment_offsets.data_ptr<int64_t>();
+  const int64_t* positions_data = segments.positions.data_ptr<int64_t>();
+  const int64_t* bags_data = segments.bags.data_ptr<int64_t>();
+  const int64_t* offsets_data = offsets.data_ptr<int64_t>();
+  const scalar_t* per_sample_weights_data =
+      per_sample_weights.defined() ? per_sample_weights.data_ptr<scalar_t>() : nullptr;
+  const scalar_t* grad_data = grad.data_ptr<scalar_t>();
+  scalar_t* target_data = target.data_ptr<scalar_t>();
+  scalar_t* momentum_data =
+      update == EmbeddingBagBatchedUpdate::RowwiseAdagrad ? momentum.data_ptr<scalar_t>() : nullptr;
+
+  using Vec = vec256::Vec256<scalar_t>;
+  // Every row is reduced and updated by the one thread owning its segment, so
+  // the updates need no atomics and do not depend on the number of threads.
+  at::parallel_for(0, num_segments, 1, [&](int64_t begin, int64_t end) {
+    std::vector<scalar_t> acc(ddim);
+    for (int64_t s = begin; s < end; s++) {
+      std::fill(acc.begin(), acc.end(), scalar_t(0));
+      for (int64_t p = segment_offsets_data[s]; p < segment_offsets_data[s + 1]; p++) {
+        const int64_t position = positions_data[p];
+        const int64_t bag = bags_data[position];
+        const int64_t table = bag / batch_size;
+        const int64_t sample = bag % batch_size;
+        scalar_t scale = per_sample_weights_data ? per_sample_weights_data[position] : scalar_t(1);
+        if (mean) {
+          scale /= static_cast<scalar_t>(offsets_data[bag + 1] - offsets_data[bag]);
+        }
+        const scalar_t* grad_row = grad_data + sample * grad_stride + table * ddim;
+        const Vec scale_vec(scale);
+        vec256::map2(
+            [scale_vec](Vec a, Vec g) { return a + g * scale_vec; },
+            acc.data(), acc.data(), grad_row, ddim);
+      }
+
+      const int64_t row = rows_data[s];
+      scalar_t* dst = target_data + row * ddim;
+      if (update == EmbeddingBagBatchedUpdate::Grad) {
+        std::copy(acc.begin(), acc.end(), dst);
+        continue;
+      }
+      scalar_t step = static_cast<scalar_t>(lr);
+      if (update == EmbeddingBagBatchedUpdate::RowwiseAdagrad) {
+        const scalar_t sum_sq = vec256::map_reduce_all<scalar_t>(
+            [](Vec x) { return x * x; },
+            [](Vec x, Vec y) { return x + y; },
+            acc.data(), ddim);
+        momentum_data[row] += sum_sq / ddim;
+        step = static_cast<scalar_t>(lr / (std::sqrt(momentum_data[row]) + eps));
+      }
+      const Vec step_vec(step);
+      vec256::map2(
+          [step_vec](Vec w, Vec g) { return w - g * step_vec; },
+          dst, dst, acc.data(), ddim);
+    }
+  });
+}
+
+void embedding_bag_batched_kernel_impl(
+    Tensor& output,
+    const Tensor& weight,
+    const Tensor& weight_offsets,
+    const Tensor& indices,
+    const Tensor& offsets,
+    const Tensor& per_sample_weights,
+    bool mean) {
+  AT_DISPATCH_FLOATING_TYPES(weight.scalar_type(), "embedding_bag_batched", [&] {
+    AT_DISPATCH_INDEX_TYPES(indices.scalar_type(), "embedding_bag_batched", [&] {
+      cpu_embedding_bag_batched<scalar_t, index_t>(
+          output, weight, weight_offsets, indices, offsets, per_sample_weights, mean);
+    });
+  });
+}
+
+void embedding_bag_batched_backward_kernel_impl(
+    Tensor& target,
+    Tensor& momentum,
+    const Tensor& grad,
+    const EmbeddingBagBatchedSegments& segments,
+    const Tensor& offsets,
+    const Tensor& per_sample_weights,
+    bool mean,
+    EmbeddingBagBatchedUpdate update,
+    double lr,
+    double eps) {
+  AT_DISPATCH_FLOATING_TYPES(grad.scalar_type(), "embedding_bag_batched_backward", [&] {
+    cpu_embedding_bag_batched_backward<scalar_t>(
+        target, momentum, grad, segments, offsets, per_sample_weights, mean, update, lr, eps);
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(embedding_bag_batched_stub, &embedding_bag_batched_kernel_impl);
+REGISTER_DISPATCH(embedding_bag_batched_backward_stub, &embedding_bag_batched_backward_kernel_impl);
+
+}} // at::native
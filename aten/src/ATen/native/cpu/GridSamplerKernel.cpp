@@ -161,6 +161,12 @@ namespace at { namespace native { namespace {
  *  Now you should be able tp understand everything about the implementation of
  *  2D forward kernel shown at the beginning of this note.
  *
+ *  3D grid sample follows the same pattern: `ApplyGridSample` with
+ *  `spatial_dim = 3` takes x, y and z vectors, and
+ *  `grid_sample_3d_grid_slice_iterator` iterates over a range of D planes of
+ *  a [D x H x W x 3] grid slice, so that the forward kernel can be parallelized
+ *  over the output planes as well as over the batch.
+ *
  **/
 
 
@@ -974,6 +980,316 @@ struct ApplyGridSample<scalar_t, 2, GridSamplerInterpolation::Bicubic,
   }
 };
 
+// Use trilinear interpolation. The 8 corners are indexed by k = 0, ..., 7 in
+// the order tnw, tne, tsw, tse, bnw, bne, bsw, bse, i.e., bit 0 of k selects
+// west/east (W), bit 1 north/south (H) and bit 2 top/bottom (D).
+template<typename scalar_t, GridSamplerPadding padding, bool align_corners>
+struct ApplyGridSample<scalar_t, 3, GridSamplerInterpolation::Bilinear,
+                       padding, align_corners> {
+  using Vec = Vec256<scalar_t>;
+  using integer_t = int_same_size_t<scalar_t>;
+  using iVec = Vec256<integer_t>;
+
+  const int64_t inp_D;
+  const int64_t inp_H;
+  const int64_t inp_W;
+  const int64_t inp_sD;
+  const int64_t inp_sH;
+  const int64_t inp_sW;
+  const int64_t C;
+  const int64_t inp_sC;
+  const ComputeLocation<scalar_t, padding, align_corners> compute_D;
+  const ComputeLocation<scalar_t, padding, align_corners> compute_H;
+  const ComputeLocation<scalar_t, padding, align_corners> compute_W;
+  const bool must_in_bound = padding != GridSamplerPadding::Zeros;
+
+  ApplyGridSample(const TensorAccessor<scalar_t, 5>& input)
+    : inp_D(input.size(2))
+    , inp_H(input.size(3))
+    , inp_W(input.size(4))
+    , inp_sD(input.stride(2))
+    , inp_sH(input.stride(3))
+    , inp_sW(input.stride(4))
+    , C(input.size(1))
+    , inp_sC(input.stride(1))
+    , compute_D(input.size(2))
+    , compute_H(input.size(3))
+    , compute_W(input.size(4)) {}
+
+  // Computes the distances of (x, y, z) to the 6 sides, in the order w, e, n,
+  // s, t, b, the interpolation weights and in_bound masks of the 8 corners,
+  // and the coordinates of the tnw corner.
+  inline void compute_interp_params(
+      const Vec& x, const Vec& y, const Vec& z,
+      Vec (&dists)[6], Vec (&weights)[8], Vec (&masks)[8],
+      iVec& i_z_t, iVec& i_y_n, iVec& i_x_w) const {
+    auto x_w = x.floor();
+    auto y_n = y.floor();
+    auto z_t = z.floor();
+
+    dists[0] = x - x_w;
+    dists[1] = Vec(1) - dists[0];
+    dists[2] = y - y_n;
+    dists[3] = Vec(1) - dists[2];
+    dists[4] = z - z_t;
+    dists[5] = Vec(1) - dists[4];
+
+    // e.g., for the tnw corner, the weight is
+    // `dist_to_east * dist_to_south * dist_to_bottom`.
+    for (int64_t k = 0; k < 8; ++k) {
+      weights[k] = dists[1 - (k & 1)] * dists[3 - ((k >> 1) & 1)] * dists[5 - (k >> 2)];
+    }
+
+    i_x_w = convert_to_int_of_same_size(x_w);
+    i_y_n = convert_to_int_of_same_size(y_n);
+    i_z_t = convert_to_int_of_same_size(z_t);
+    auto i_x_e = i_x_w + iVec(1);
+    auto i_y_s = i_y_n + iVec(1);
+    auto i_z_b = i_z_t + iVec(1);
+
+    // See the 2D bilinear case for why these are integer comparisons.
+    iVec x_masks[2], y_masks[2], z_masks[2];
+    x_masks[0] = must_in_bound ? iVec(-1) : (i_x_w > iVec(-1)) & (i_x_w < iVec(inp_W));
+    y_masks[0] = must_in_bound ? iVec(-1) : (i_y_n > iVec(-1)) & (i_y_n < iVec(inp_H));
+    z_masks[0] = must_in_bound ? iVec(-1) : (i_z_t > iVec(-1)) & (i_z_t < iVec(inp_D));
+    x_masks[1] = must_in_bound ? (i_x_e < iVec(inp_W)) : (i_x_e > iVec(-1)) & (i_x_e < iVec(inp_W));
+    y_masks[1] = must_in_bound ? (i_y_s < iVec(inp_H)) : (i_y_s > iVec(-1)) & (i_y_s < iVec(inp_H));
+    z_masks[1] = must_in_bound ? (i_z_b < iVec(inp_D)) : (i_z_b > iVec(-1)) & (i_z_b < iVec(inp_D));
+    for (int64_t k = 0; k < 8; ++k) {
+      masks[k] = cast<scalar_t>(x_masks[k & 1] & y_masks[(k >> 1) & 1] & z_masks[k >> 2]);
+    }
+  }
+
+  // Offsets of the 8 corners, given the strides of the D, H and W dims
+  static inline void corner_offsets(iVec (&offsets)[8], const iVec& i_z_t,
+                                    const iVec& i_y_n, const iVec& i_x_w,
+                                    int64_t sD, int64_t sH, int64_t sW) {
+    offsets[0] = i_z_t * iVec(sD) + i_y_n * iVec(sH) + i_x_w * iVec(sW);
+    offsets[1] = offsets[0] + iVec(sW);
+    offsets[2] = offsets[0] + iVec(sH);
+    offsets[3] = offsets[2] + iVec(sW);
+    for (int64_t k = 4; k < 8; ++k) {
+      offsets[k] = offsets[k - 4] + iVec(sD);
+    }
+  }
+
+  inline void forward(TensorAccessor<scalar_t, 4>& out_slice,
+                      const TensorAccessor<scalar_t, 4>& inp_slice,
+                      int64_t offset, const Vec& grid_x, const Vec& grid_y,
+                      const Vec& grid_z, int64_t len) const {
+    auto x = compute_W.apply(grid_x);
+    auto y = compute_H.apply(grid_y);
+    auto z = compute_D.apply(grid_z);
+
+    Vec dists[6], weights[8], masks[8];
+    iVec i_z_t, i_y_n, i_x_w;
+    compute_interp_params(x, y, z, dists, weights, masks, i_z_t, i_y_n, i_x_w);
+
+    iVec i_offsets[8];
+    corner_offsets(i_offsets, i_z_t, i_y_n, i_x_w, inp_sD, inp_sH, inp_sW);
+
+    #if !defined(_MSC_VER) && !defined(COMPILING_FOR_MIN_SIZE)
+    # pragma unroll
+    #endif
+    for (int64_t c = 0; c < C; ++c) {
+      auto inp_slice_C_ptr = inp_slice[c].data();
+
+      auto interpolated = Vec(0);
+      for (int64_t k = 0; k < 8; ++k) {
+        // mask_gather zeros out the mask, so we need to make a copy
+        Vec mask_copy = masks[k];
+        auto val = mask_gather<sizeof(scalar_t)>(Vec(0), inp_slice_C_ptr, i_offsets[k], mask_copy);
+        interpolated = interpolated + val * weights[k];
+      }
+      interpolated.store(out_slice[c].data() + offset, len);
+    }
+  }
+
+  inline void backward(TensorAccessor<scalar_t, 4>& gInp_slice,
+                       TensorAccessor<scalar_t, 4>& gGrid_slice,
+                       const TensorAccessor<scalar_t, 4>& gOut_slice,
+                       const TensorAccessor<scalar_t, 4>& inp_slice,
+                       int64_t offset, const Vec& grid_x, const Vec& grid_y,
+                       const Vec& grid_z, int64_t len) const {
+    Vec x, y, z, gx_mult, gy_mult, gz_mult;
+    std::tie(x, gx_mult) = compute_W.apply_get_grad(grid_x);
+    std::tie(y, gy_mult) = compute_H.apply_get_grad(grid_y);
+    std::tie(z, gz_mult) = compute_D.apply_get_grad(grid_z);
+
+    Vec dists[6], weights[8], masks[8];
+    iVec i_z_t, i_y_n, i_x_w;
+    compute_interp_params(x, y, z, dists, weights, masks, i_z_t, i_y_n, i_x_w);
+    const Vec& w = dists[0];
+    const Vec& e = dists[1];
+    const Vec& n = dists[2];
+    const Vec& s = dists[3];
+    const Vec& t = dists[4];
+    const Vec& b = dists[5];
+
+    iVec i_offsets[8];
+    corner_offsets(i_offsets, i_z_t, i_y_n, i_x_w, inp_sD, inp_sH, inp_sW);
+
+    // gInp is contiguous. See the 2D bilinear case for why the offsets and
+    // masks are stored to temporary arrays.
+    iVec i_gInp_offsets[8];
+    corner_offsets(i_gInp_offsets, i_z_t, i_y_n, i_x_w, inp_H * inp_W, inp_W, 1);
+    integer_t i_gInp_offset_arr[8][iVec::size()];
+    integer_t i_mask_arr[8][iVec::size()];
+    for (int64_t k = 0; k < 8; ++k) {
+      i_gInp_offsets[k].store(i_gInp_offset_arr[k]);
+      masks[k].store(i_mask_arr[k]);
+    }
+
+    scalar_t gInp_corner_arr[Vec::size()];
+
+    auto gx = Vec(0), gy = Vec(0), gz = Vec(0);
+    #if !defined(_MSC_VER) && !defined(COMPILING_FOR_MIN_SIZE)
+    # pragma unroll
+    #endif
+    for (int64_t c = 0; c < C; ++c) {
+      auto inp_slice_C_ptr = inp_slice[c].data();
+      auto gInp_slice_C_ptr = gInp_slice[c].data();
+      auto gOut = Vec::loadu(gOut_slice[c].data() + offset, len);
+
+      Vec vals[8];
+      for (int64_t k = 0; k < 8; ++k) {
+        (weights[k] * gOut).store(gInp_corner_arr);
+        mask_scatter_add(gInp_corner_arr, gInp_slice_C_ptr, i_gInp_offset_arr[k], i_mask_arr[k], len);
+
+        // mask_gather zeros out the mask, so we need to make a copy
+        Vec mask_copy = masks[k];
+        vals[k] = mask_gather<sizeof(scalar_t)>(Vec(0), inp_slice_C_ptr, i_offsets[k], mask_copy);
+      }
+
+      gx = gx + (((vals[1] - vals[0]) * s + (vals[3] - vals[2]) * n) * b +
+                 ((vals[5] - vals[4]) * s + (vals[7] - vals[6]) * n) * t) * gOut;
+      gy = gy + (((vals[2] - vals[0]) * e + (vals[3] - vals[1]) * w) * b +
+                 ((vals[6] - vals[4]) * e + (vals[7] - vals[5]) * w) * t) * gOut;
+      gz = gz + (((vals[4] - vals[0]) * e + (vals[5] - vals[1]) * w) * s +
+                 ((vals[6] - vals[2]) * e + (vals[7] - vals[3]) * w) * n) * gOut;
+    }
+
+    gx = gx * gx_mult;
+    gy = gy * gy_mult;
+    gz = gz * gz_mult;
+
+    scalar_t gx_arr[Vec::size()], gy_arr[Vec::size()], gz_arr[Vec::size()];
+    gx.store(gx_arr);
+    gy.store(gy_arr);
+    gz.store(gz_arr);
+    auto gGrid_ptr = gGrid_slice.data() + offset * 3;
+    for (int64_t i = 0; i < len; ++i) {
+      gGrid_ptr[i * 3] = gx_arr[i];
+      gGrid_ptr[i * 3 + 1] = gy_arr[i];
+      gGrid_ptr[i * 3 + 2] = gz_arr[i];
+    }
+  }
+};
+
+template<typename scalar_t, GridSamplerPadding padding, bool align_corners>
+struct ApplyGridSample<scalar_t, 3, GridSamplerInterpolation::Nearest,
+                       padding, align_corners> {
+  using Vec = Vec256<scalar_t>;
+  using integer_t = int_same_size_t<scalar_t>;
+  using iVec = Vec256<integer_t>;
+
+  const int64_t inp_D;
+  const int64_t inp_H;
+  const int64_t inp_W;
+  const int64_t inp_sD;
+  const int64_t inp_sH;
+  const int64_t inp_sW;
+  const int64_t C;
+  const int64_t inp_sC;
+  const ComputeLocation<scalar_t, padding, align_corners> compute_D;
+  const ComputeLocation<scalar_t, padding, align_corners> compute_H;
+  const ComputeLocation<scalar_t, padding, align_corners> compute_W;
+  const bool must_in_bound = padding != GridSamplerPadding::Zeros;
+
+  ApplyGridSample(const TensorAccessor<scalar_t, 5>& input)
+    : inp_D(input.size(2))
+    , inp_H(input.size(3))
+    , inp_W(input.size(4))
+    , inp_sD(input.stride(2))
+    , inp_sH(input.stride(3))
+    , inp_sW(input.stride(4))
+    , C(input.size(1))
+    , inp_sC(input.stride(1))
+    , compute_D(input.size(2))
+    , compute_H(input.size(3))
+    , compute_W(input.size(4)) {}
+
+  inline std::tuple<iVec, iVec, iVec, iVec>
+  compute_nearest(const Vec& grid_x, const Vec& grid_y, const Vec& grid_z) const {
+    auto i_x_nearest = convert_to_int_of_same_size(compute_W.apply(grid_x).round());
+    auto i_y_nearest = convert_to_int_of_same_size(compute_H.apply(grid_y).round());
+    auto i_z_nearest = convert_to_int_of_same_size(compute_D.apply(grid_z).round());
+
+    auto i_mask = must_in_bound ? iVec(-1)
+                                : (i_x_nearest > iVec(-1)) & (i_x_nearest < iVec(inp_W)) &
+                                  (i_y_nearest > iVec(-1)) & (i_y_nearest < iVec(inp_H)) &
+                                  (i_z_nearest > iVec(-1)) & (i_z_nearest < iVec(inp_D));
+    return std::make_tuple(i_z_nearest, i_y_nearest, i_x_nearest, i_mask);
+  }
+
+  inline void forward(TensorAccessor<scalar_t, 4>& out_slice,
+                      const TensorAccessor<scalar_t, 4>& inp_slice,
+                      int64_t offset, const Vec& grid_x, const Vec& grid_y,
+                      const Vec& grid_z, int64_t len) const {
+    iVec i_z_nearest, i_y_nearest, i_x_nearest, i_mask;
+    std::tie(i_z_nearest, i_y_nearest, i_x_nearest, i_mask) =
+      compute_nearest(grid_x, grid_y, grid_z);
+    auto mask = cast<scalar_t>(i_mask);
+
+    auto i_offset = i_z_nearest * iVec(inp_sD) + i_y_nearest * iVec(inp_sH) +
+                    i_x_nearest * iVec(inp_sW);
+
+    auto out_ptr = out_slice.data() + offset;
+    auto out_sC = out_slice.stride(0);
+    auto inp_slice_ptr = inp_slice.data();
+    #if !defined(_MSC_VER) && !defined(COMPILING_FOR_MIN_SIZE)
+    # pragma unroll
+    #endif
+    for (int64_t c = 0; c < C; ++c, out_ptr += out_sC, inp_slice_ptr += inp_sC) {
+      // mask_gather zeros out the mask, so we need to make a copy
+      auto mask_copy = mask;
+      auto inp_val = mask_gather<sizeof(scalar_t)>(Vec(0), inp_slice_ptr, i_offset, mask_copy);
+      inp_val.store(static_cast<void*>(out_ptr), len);
+    }
+  }
+
+  inline void backward(TensorAccessor<scalar_t, 4>& gInp_slice,
+                       TensorAccessor<scalar_t, 4>& gGrid_slice,
+                       const TensorAccessor<scalar_t, 4>& gOut_slice,
+                       const TensorAccessor<scalar_t, 4>& inp_slice,
+                       int64_t offset, const Vec& grid_x, const Vec& grid_y,
+                       const Vec& grid_z, int64_t len) const {
+    iVec i_z_nearest, i_y_nearest, i_x_nearest, i_mask;
+    std::tie(i_z_nearest, i_y_nearest, i_x_nearest, i_mask) =
+      compute_nearest(grid_x, grid_y, grid_z);
+
+    // gInp is contiguous
+    auto i_gInp_offset = (i_z_nearest * iVec(inp_H) + i_y_nearest) * iVec(inp_W) + i_x_nearest;
+
+    integer_t mask_arr[iVec::size()];
+    i_mask.store(mask_arr);
+    integer_t gInp_offset_arr[iVec::size()];
+    i_gInp_offset.store(gInp_offset_arr);
+
+    #if !defined(_MSC_VER) && !defined(COMPILING_FOR_MIN_SIZE)
+    # pragma unroll
+    #endif
+    for (int64_t c = 0; c < C; ++c) {
+      mask_scatter_add(gOut_slice[c].data() + offset, gInp_slice[c].data(),
+                       gInp_offset_arr, mask_arr, len);
+    }
+
+    // grid has zero 0 gradient in Nearest mode
+    auto gGrid_ptr = gGrid_slice.data() + offset * 3;
+    std::memset(gGrid_ptr, 0, sizeof(scalar_t) * len * 3);
+  }
+};
+
 // ~~~~~~~~~~~~~~~~~~ grid_sample_2d_grid_slice_iterator ~~~~~~~~~~~~~~~~~~~~~~
 // Function to apply a vectorized function on a grid slice tensor (without batch
 // dimension).
@@ -1096,6 +1412,86 @@ static inline void grid_sample_2d_grid_slice_iterator(
   }
 }
 
+// ~~~~~~~~~~~~~~~~~~ grid_sample_3d_grid_slice_iterator ~~~~~~~~~~~~~~~~~~~~~~
+// Function to apply a vectorized function on the D planes [d_begin, d_end) of
+// a 3D grid slice tensor (without batch dimension). `apply_fn` is called as
+//    apply_fn(grid_x, grid_y, grid_z, spatial_offset, len);
+// where `spatial_offset` is the offset in the flattened D x H x W output.
+// See NOTE [ Grid Sample CPU Kernels ] for details.
+
+template<typename scalar_t, typename ApplyFn>
+static inline void grid_sample_3d_grid_slice_iterator(
+    const TensorAccessor<scalar_t, 4>& grid_slice, int64_t d_begin,
+    int64_t d_end, const ApplyFn &apply_fn) {
+  int64_t out_H = grid_slice.size(1);
+  int64_t out_W = grid_slice.size(2);
+  int64_t grid_sD = grid_slice.stride(0);
+  int64_t grid_sH = grid_slice.stride(1);
+  int64_t grid_sW = grid_slice.stride(2);
+  int64_t grid_sCoor = grid_slice.stride(3);
+  auto grid_ptr = grid_slice.data();
+
+  using Vec = Vec256<scalar_t>;
+  using iVec = Vec256<int_same_size_t<scalar_t>>;
+  constexpr int64_t step = Vec::size();
+
+  // There is no 3-way deinterleave, so unlike the 2D case the grid values are
+  // loaded along lines of locations that are `grid_sW` apart: with plain
+  // loads if the coordinates are in separate planes (e.g., grid of shape
+  // [N, 3, D, H, W] permuted), and with at::vec256::gather otherwise (e.g., a
+  // contiguous [N, D, H, W, 3] grid). The lines are made as long as the
+  // strides allow, i.e., the whole range of planes if D, H and W collapse.
+  auto line_fn = [&](const scalar_t *grid_ptr_x, int64_t out_base_offset,
+                     int64_t total_size) {
+    auto grid_ptr_y = grid_ptr_x + grid_sCoor;
+    auto grid_ptr_z = grid_ptr_y + grid_sCoor;
+    auto i_offsets = iVec::arange(0, grid_sW);
+    for (int64_t i = 0; i < total_size; i += step) {
+      auto len = std::min(step, total_size - i);
+      Vec x, y, z;
+      if (grid_sW == 1) {
+        x = Vec::loadu(grid_ptr_x + i, len);
+        y = Vec::loadu(grid_ptr_y + i, len);
+        z = Vec::loadu(grid_ptr_z + i, len);
+      } else {
+        if (len < step) {
+          // prevents illegal memory access, sets the exceeding offsets to zero
+          i_offsets = iVec::set(iVec(0), i_offsets, len);
+        }
+        x = vec256::gather<sizeof(scalar_t)>(grid_ptr_x + i * grid_sW, i_offsets);
+        y = vec256::gather<sizeof(scalar_t)>(grid_ptr_y + i * grid_sW, i_offsets);
+        z = vec256::gather<sizeof(scalar_t)>(grid_ptr_z + i * grid_sW, i_offsets);
+      }
+      // make sure that x, y and z are valid grid sample locations
+      if (len < step) {
+        x = Vec::set(Vec(0), x, len);
+        y = Vec::set(Vec(0), y, len);
+        z = Vec::set(Vec(0), z, len);
+      }
+      apply_fn(x, y, z, out_base_offset + i, len);
+    }
+  };
+
+  const int64_t plane_size = out_H * out_W;
+  const bool hw_collapse = out_H == 1 || grid_sH == out_W * grid_sW;
+  const bool dhw_collapse = hw_collapse &&
+    (d_end - d_begin == 1 || grid_sD == plane_size * grid_sW);
+  if (dhw_collapse) {
+    line_fn(grid_ptr + d_begin * grid_sD, d_begin * plane_size,
+            (d_end - d_begin) * plane_size);
+  } else if (hw_collapse) {
+    for (int64_t d = d_begin; d < d_end; d++) {
+      line_fn(grid_ptr + d * grid_sD, d * plane_size, plane_size);
+    }
+  } else {
+    for (int64_t d = d_begin; d < d_end; d++) {
+      for (int64_t h = 0; h < out_H; h++) {
+        line_fn(grid_ptr + d * grid_sD + h * grid_sH, d * plane_size + h * out_W, out_W);
+      }
+    }
+  }
+}
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~ Grid Sample Kernels ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // Use the structs & functions defined above to calculate grid sample forward
 // and backward.
@@ -1242,10 +1638,168 @@ grid_sampler_2d_backward_cpu_kernel_impl(const Tensor& grad_output_,
   return std::make_tuple(grad_input, grad_grid);
 }
 
+Tensor grid_sampler_3d_cpu_kernel_impl(const Tensor& input, const Tensor& grid,
+                                       int64_t interpolation_mode,
+                                       int64_t padding_mode, bool align_corners) {
+  auto N = input.size(0);
+  auto D = grid.size(1);
+  auto H = grid.size(2);
+  auto W = grid.size(3);
+  auto output = at::empty({N, input.size(1), D, H, W}, input.options());
+  // Parallelize over the output D planes of all the samples, so that a single
+  // large volume still uses all the threads.
+  auto planes = N * D;
+  auto plane_size = H * W;
+  auto grain_size = plane_size == 0 ? (planes + 1)
+                                    : at::divup(at::internal::GRAIN_SIZE, plane_size * 6 /* 3d * 2 tensors*/);
+
+#define HANDLE_CASE(interp, padding, align_corners)                            \
+  case padding: {                                                              \
+    ApplyGridSample<scalar_t, 3, interp, padding, align_corners>               \
+    grid_sample(inp_acc);                                                      \
+    parallel_for(0, planes, grain_size, [&](int64_t begin, int64_t end) {      \
+      for (int64_t n = begin / D; n * D < end; n++) {                          \
+        auto out_slice = out_acc[n];                                           \
+        auto inp_slice = inp_acc[n];                                           \
+        grid_sample_3d_grid_slice_iterator(                                    \
+          grid_acc[n],                                                         \
+          std::max(begin - n * D, int64_t(0)),                                 \
+          std::min(end - n * D, D),                                            \
+          [&](const Vec256<scalar_t>& grid_x, const Vec256<scalar_t>& grid_y,  \
+              const Vec256<scalar_t>& grid_z,                                  \
+              int64_t spatial_offset, int64_t len) {                           \
+            grid_sample.forward(out_slice, inp_slice, spatial_offset,          \
+                                grid_x, grid_y, grid_z, len);                  \
+          });                                                                  \
+        }                                                                      \
+      });                                                                      \
+    return;                                                                    \
+  }
+
+#define HANDLE_INTERP(interp, align_corners)                                   \
+  case interp: {                                                               \
+    switch (static_cast<GridSamplerPadding>(padding_mode)) {                   \
+      HANDLE_CASE(interp, GridSamplerPadding::Zeros, align_corners);           \
+      HANDLE_CASE(interp, GridSamplerPadding::Border, align_corners);          \
+      HANDLE_CASE(interp, GridSamplerPadding::Reflection, align_corners);      \
+    }                                                                          \
+    return;                                                                    \
+  }
+
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "grid_sampler_3d_cpu_kernel_impl", [&] {
+    auto out_acc = output.accessor<scalar_t, 5>();
+    auto inp_acc = input.accessor<scalar_t, 5>();
+    auto grid_acc = grid.accessor<scalar_t, 5>();
+    if (align_corners) {
+      switch (static_cast<GridSamplerInterpolation>(interpolation_mode)) {
+        HANDLE_INTERP(GridSamplerInterpolation::Bilinear, true);
+        HANDLE_INTERP(GridSamplerInterpolation::Nearest, true);
+        default:
+          TORCH_CHECK(false, "grid_sampler_3d_cpu: unsupported interpolation mode ", interpolation_mode);
+      }
+    } else {
+      switch (static_cast<GridSamplerInterpolation>(interpolation_mode)) {
+        HANDLE_INTERP(GridSamplerInterpolation::Bilinear, false);
+        HANDLE_INTERP(GridSamplerInterpolation::Nearest, false);
+        default:
+          TORCH_CHECK(false, "grid_sampler_3d_cpu: unsupported interpolation mode ", interpolation_mode);
+      }
+    }
+  });
+#undef HANDLE_CASE
+#undef HANDLE_INTERP
+
+  return output;
+}
+
+std::tuple<Tensor, Tensor>
+grid_sampler_3d_backward_cpu_kernel_impl(const Tensor& grad_output_,
+                                         const Tensor& input,
+                                         const Tensor& grid,
+                                         int64_t interpolation_mode,
+                                         int64_t padding_mode,
+                                         bool align_corners) {
+  // grad_output should be contiguous most of time. Ensuring that it is
+  // contiguous can greatly simplify this code.
+  auto grad_output = grad_output_.contiguous();
+
+  auto grad_input = at::zeros_like(input, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  auto grad_grid = at::empty_like(grid, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  auto N = input.size(0);
+  auto D = grid.size(1);
+  auto spatial_size = D * grid.size(2) * grid.size(3);
+  // Unlike the forward, this is only parallelized over the batch, as the
+  // output locations of a sample scatter into the same grad_input.
+  auto grain_size = spatial_size == 0 ? (N + 1)
+                                      : at::divup(at::internal::GRAIN_SIZE, spatial_size * 15 /* 3d * 5 tensors*/);
+
+#define HANDLE_CASE(interp, padding, align_corners)                              \
+  case padding: {                                                                \
+    ApplyGridSample<scalar_t, 3, interp, padding, align_corners>                 \
+    grid_sample(inp_acc);                                                        \
+    parallel_for(0, N, grain_size, [&](int64_t begin, int64_t end) {             \
+      for (int64_t n = begin; n < end; n++) {                                    \
+        auto gInp_slice = gInp_acc[n];                                           \
+        auto gGrid_slice = gGrid_acc[n];                                         \
+        auto gOut_slice = gOut_acc[n];                                           \
+        auto inp_slice = inp_acc[n];                                             \
+        grid_sample_3d_grid_slice_iterator(                                      \
+          grid_acc[n], 0, D,                                                     \
+          [&](const Vec256<scalar_t>& grid_x, const Vec256<scalar_t>& grid_y,    \
+              const Vec256<scalar_t>& grid_z,                                    \
+              int64_t spatial_offset, int64_t len) {                             \
+            grid_sample.backward(gInp_slice, gGrid_slice, gOut_slice, inp_slice, \
+                                 spatial_offset, grid_x, grid_y, grid_z, len);   \
+          });                                                                    \
+      }                                                                          \
+    });                                                                          \
+    return;                                                                      \
+  }
+
+#define HANDLE_INTERP(interp, align_corners)                                \
+  case interp: {                                                            \
+    switch (static_cast<GridSamplerPadding>(padding_mode)) {                \
+      HANDLE_CASE(interp, GridSamplerPadding::Zeros, align_corners);        \
+      HANDLE_CASE(interp, GridSamplerPadding::Border, align_corners);       \
+      HANDLE_CASE(interp, GridSamplerPadding::Reflection, align_corners);   \
+    }                                                                       \
+    return;                                                                 \
+  }
+
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "grid_sampler_3d_backward_cpu_kernel_impl", [&] {
+    auto gInp_acc = grad_input.accessor<scalar_t, 5>();
+    auto gGrid_acc = grad_grid.accessor<scalar_t, 5>();
+    auto inp_acc = input.accessor<scalar_t, 5>();
+    auto grid_acc = grid.accessor<scalar_t, 5>();
+    auto gOut_acc = grad_output.accessor<scalar_t, 5>();
+    if (align_corners) {
+      switch (static_cast<GridSamplerInterpolation>(interpolation_mode)) {
+        HANDLE_INTERP(GridSamplerInterpolation::Bilinear, true);
+        HANDLE_INTERP(GridSamplerInterpolation::Nearest, true);
+        default:
+          TORCH_CHECK(false, "grid_sampler_3d_backward_cpu: unsupported interpolation mode ", interpolation_mode);
+      }
+    } else {
+      switch (static_cast<GridSamplerInterpolation>(interpolation_mode)) {
+        HANDLE_INTERP(GridSamplerInterpolation::Bilinear, false);
+        HANDLE_INTERP(GridSamplerInterpolation::Nearest, false);
+        default:
+          TORCH_CHECK(false, "grid_sampler_3d_backward_cpu: unsupported interpolation mode ", interpolation_mode);
+      }
+    }
+  });
+#undef HANDLE_CASE
+#undef HANDLE_INTERP
+
+  return std::make_tuple(grad_input, grad_grid);
+}
+
 }
 
 REGISTER_DISPATCH(grid_sampler_2d_cpu_kernel, &grid_sampler_2d_cpu_kernel_impl);
 REGISTER_DISPATCH(grid_sampler_2d_backward_cpu_kernel, &grid_sampler_2d_backward_cpu_kernel_impl);
+REGISTER_DISPATCH(grid_sampler_3d_cpu_kernel, &grid_sampler_3d_cpu_kernel_impl);
+REGISTER_DISPATCH(grid_sampler_3d_backward_cpu_kernel, &grid_sampler_3d_backward_cpu_kernel_impl);
 
 
 }}  // namespace at::native
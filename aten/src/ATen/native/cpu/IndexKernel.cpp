@@ -2,6 +2,8 @@
 
 #include <cmath>
 #include <iostream>
+#include <numeric>
+#include <vector>
 #include <ATen/Dispatch.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/Parallel.h>
@@ -311,45 +313,143 @@ void masked_select_serial_kernel(TensorIterator& iter, int64_t result_stride) {
     });
 }
 
-template <typename scalar_t, typename mask_t, typename func_t>
-void cpu_masked_select_kernel(TensorIterator& iter, const func_t& f) {
+// nonzero and masked_select compact the elements they select in two passes:
+// [0, numel) is split into one chunk per thread, the elements selected by
+// every chunk are counted in parallel, and an exclusive scan of the counts
+// gives the output position of every chunk, which are then written out in
+// parallel. Returns the num_chunks + 1 chunk boundaries and fills offsets
+// with the num_chunks + 1 output positions, the last one being the total.
+template <typename count_t>
+std::vector<int64_t> count_selected_chunks(int64_t numel, std::vector<int64_t>& offsets, const count_t& count) {
+  const int64_t num_chunks = std::max<int64_t>(1,
+      std::min<int64_t>(at::get_num_threads(), at::divup(numel, at::internal::GRAIN_SIZE)));
+  std::vector<int64_t> bounds(num_chunks + 1);
+  for (int64_t c = 0; c <= num_chunks; c++) {
+    bounds[c] = numel * c / num_chunks;
+  }
+  offsets.assign(num_chunks + 1, 0);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t c = begin; c < end; c++) {
+      offsets[c + 1] = count(bounds[c], bounds[c + 1]);
+    }
+  });
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  return bounds;
+}
+
+template <typename scalar_t, typename mask_t>
+void cpu_masked_select_kernel(Tensor& result, const Tensor& self, const Tensor& mask) {
   auto is_mask_bool = std::is_same<mask_t, bool>::value;
-  auto loop = [&](char** data, const int64_t* strides, int64_t n) {
-    char* dst = data[0];
-    char* src = data[1];
-    char* mask = data[2];
-    char* mask_prefix_sum = data[3];
-    for (int64_t i = 0; i < n; i++) {
-      mask_t mask_value = *(mask_t*)(mask + strides[2] * i);
-      if (!is_mask_bool) {
+  const scalar_t* self_data = self.data_ptr<scalar_t>();
+  const mask_t* mask_data = mask.data_ptr<mask_t>();
+
+  std::vector<int64_t> offsets;
+  const auto bounds = count_selected_chunks(self.numel(), offsets, [&](int64_t begin, int64_t end) {
+    int64_t count = 0;
+    if (is_mask_bool) {
+      // a loop the compiler vectorizes
+      for (int64_t i = begin; i < end; i++) {
+        count += static_cast<int64_t>(mask_data[i]);
+      }
+    } else {
+      for (int64_t i = begin; i < end; i++) {
+        mask_t mask_value = mask_data[i];
         TORCH_CHECK(mask_value == 0 || mask_value == 1, "Mask tensor can take 0 and 1 values only");
+        count += mask_value;
       }
-      if (mask_value) {
-        int64_t offset = *(int64_t*)(mask_prefix_sum + strides[3] * i);
-        int64_t offset_bytes = (offset - 1) * sizeof(scalar_t);
-        f(dst, src + strides[1] * i, offset_bytes);
+    }
+    return count;
+  });
+
+  result.resize_({offsets.back()});
+  if (offsets.back() == 0) {
+    return;
+  }
+  const int64_t result_stride = result.stride(0);
+  scalar_t* result_data = result.data_ptr<scalar_t>();
+  at::parallel_for(0, bounds.size() - 1, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t c = begin; c < end; c++) {
+      scalar_t* out = result_data + offsets[c] * result_stride;
+      for (int64_t i = bounds[c]; i < bounds[c + 1]; i++) {
+        if (mask_data[i]) {
+          *out = self_data[i];
+          out += result_stride;
+        }
       }
     }
-  };
-  iter.for_each(loop);
+  });
 }
 
-void masked_select_kernel(TensorIterator& iter, int64_t result_stride) {
+void masked_select_kernel(Tensor& result, const Tensor& self, const Tensor& mask) {
   AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND3(ScalarType::Bool, ScalarType::BFloat16, ScalarType::Half,
-    iter.dtype(), "masked_select", [&] {
-      auto mask_dtype = iter.input_dtype(1);
-      if (mask_dtype == ScalarType::Bool) {
-        cpu_masked_select_kernel<scalar_t, bool>(iter, [result_stride](char* dst, char* src, int64_t offset) {
-          *(scalar_t*)(dst + offset*result_stride) = *(scalar_t*)src;
-        });
+    self.scalar_type(), "masked_select", [&] {
+      if (mask.scalar_type() == ScalarType::Bool) {
+        cpu_masked_select_kernel<scalar_t, bool>(result, self, mask);
       } else {
-        cpu_masked_select_kernel<scalar_t, unsigned char>(iter, [result_stride](char* dst, char* src, int64_t offset) {
-          *(scalar_t*)(dst + offset*result_stride) = *(scalar_t*)src;
-        });
+        cpu_masked_select_kernel<scalar_t, unsigned char>(result, self, mask);
       }
     });
 }
 
+template <typename scalar_t>
+void cpu_nonzero_kernel(Tensor& result, const Tensor& self) {
+  const Tensor input = self.contiguous();
+  const int64_t ndim = input.dim();
+  const scalar_t* data = input.data_ptr<scalar_t>();
+
+  std::vector<int64_t> offsets;
+  const auto bounds = count_selected_chunks(input.numel(), offsets, [data](int64_t begin, int64_t end) {
+    // a loop the compiler vectorizes
+    int64_t count = 0;
+    for (int64_t i = begin; i < end; i++) {
+      count += static_cast<int64_t>(data[i] != scalar_t(0));
+    }
+    return count;
+  });
+
+  result.resize_({offsets.back(), ndim});
+  if (offsets.back() == 0 || ndim == 0) {
+    return;
+  }
+  const auto sizes = input.sizes();
+  const int64_t result_stride_0 = result.stride(0);
+  const int64_t result_stride_1 = result.stride(1);
+  int64_t* result_data = result.data_ptr<int64_t>();
+  at::parallel_for(0, bounds.size() - 1, 1, [&](int64_t begin, int64_t end) {
+    DimVector index(ndim);
+    for (int64_t c = begin; c < end; c++) {
+      // the subscript of the first element of the chunk
+      int64_t linear_index = bounds[c];
+      for (int64_t d = ndim - 1; d >= 0; d--) {
+        index[d] = linear_index % sizes[d];
+        linear_index /= sizes[d];
+      }
+      int64_t* out = result_data + offsets[c] * result_stride_0;
+      for (int64_t i = bounds[c]; i < bounds[c + 1]; i++) {
+        if (data[i] != scalar_t(0)) {
+          for (int64_t d = 0; d < ndim; d++) {
+            out[d * result_stride_1] = index[d];
+          }
+          out += result_stride_0;
+        }
+        for (int64_t d = ndim - 1; d >= 0; d--) {
+          if (++index[d] < sizes[d]) {
+            break;
+          }
+          index[d] = 0;
+        }
+      }
+    }
+  });
+}
+
+void nonzero_kernel(Tensor& result, const Tensor& self) {
+  AT_DISPATCH_ALL_TYPES_AND3(ScalarType::Bool, ScalarType::BFloat16, ScalarType::Half,
+    self.scalar_type(), "nonzero_cpu", [&] {
+      cpu_nonzero_kernel<scalar_t>(result, self);
+    });
+}
+
 } // anonymous namespace
 
 REGISTER_DISPATCH(index_stub, &index_kernel);
@@ -359,5 +459,6 @@ REGISTER_DISPATCH(masked_fill_stub, &masked_fill_kernel);
 REGISTER_DISPATCH(masked_select_serial_stub, &masked_select_serial_kernel);
 REGISTER_DISPATCH(masked_select_stub, &masked_select_kernel);
 REGISTER_DISPATCH(masked_scatter_stub, &masked_scatter_kernel);
+REGISTER_DISPATCH(nonzero_stub, &nonzero_kernel);
 
 }} // namespace at::native
@@ -131,12 +131,16 @@ basic_loop(char* C10_RESTRICT data[], const int64_t* strides_, int64_t i, int64_
 // the same type and contiguous with one exception: a single input may be
 // a scalar (stride 0). It's position is indicated by the argument `S`. If `S`
 // is 0, then there are no scalar inputs.
+//
+// The vector width is taken from `vop`: it is Vec256 for lambdas taking
+// Vec256 arguments, and Vec512 in AVX512 builds for lambdas written against
+// Vectorized<scalar_t>.
 template <typename func_t, typename vec_func_t>
 static inline void
 vectorized_loop(char** C10_RESTRICT data_, int64_t n, int64_t S, func_t&& op, vec_func_t&& vop) {
   using traits = function_traits<vec_func_t>;
   using scalar_t = typename function_traits<func_t>::result_type;
-  using Vec = Vec256<scalar_t>;
+  using Vec = typename traits::result_type;
   constexpr int ntensors = traits::arity + 1;
 
   char* C10_RESTRICT data[ntensors];
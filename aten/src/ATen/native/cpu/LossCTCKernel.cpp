@@ -0,0 +1,282 @@
+// Copyright (c) 2018 MathInf GmbH, Thomas Viehmann
+// Licensed under the BSD-3-Clause license
+// These are the CPU kernels of the Connectionist Temporal Loss, see LossCTC.cpp.
+// 1. Graves et al: http://www.cs.toronto.edu/~graves/icml_2006.pdf
+
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/functional.h>
+#include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/LossCTC.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace at {
+namespace native {
+
+namespace {
+
+// this ad-hoc converts from targets (l in [1]) to augmented targets (l' in [1]) note that no bound-checking is done
+template<typename target_t>
+inline int64_t get_target_prime(target_t* target, int64_t offset, int64_t stride, int64_t idx, int64_t BLANK) {
+  if (idx % 2 == 0) {
+    return BLANK;
+  } else {
+    return target[offset + stride * (idx / 2)];
+  }
+}
+
+// Computes out[s] = log(exp(a[s]) + exp(b[s]) + exp(c[s] + c_mask[s])) + emit[s], the logsumexp of the three
+// summands of the alpha and beta recursions, eq (6) and (10), vectorized over the augmented target positions s.
+// c_mask is 0 where the third summand is allowed and -inf where it is not.
+template<typename scalar_t>
+inline void log_add_exp3(scalar_t* out, const scalar_t* a, const scalar_t* b, const scalar_t* c,
+                         const scalar_t* c_mask, const scalar_t* emit, int64_t size) {
+  using Vec = vec256::Vec256<scalar_t>;
+  const Vec neginf(-std::numeric_limits<scalar_t>::infinity());
+  const Vec zero(0);
+  for (int64_t s = 0; s < size; s += Vec::size()) {
+    const int64_t count = std::min<int64_t>(Vec::size(), size - s);
+    const Vec va = Vec::loadu(a + s, count);
+    const Vec vb = Vec::loadu(b + s, count);
+    const Vec vc = Vec::loadu(c + s, count) + Vec::loadu(c_mask + s, count);
+    Vec vmax = vec256::maximum(vec256::maximum(va, vb), vc);
+    vmax = Vec::blendv(vmax, zero, vmax == neginf); // cannot do neginf-neginf
+    const Vec res = ((va - vmax).exp() + (vb - vmax).exp() + (vc - vmax).exp()).log() + vmax + Vec::loadu(emit + s, count);
+    res.store(out + s, count);
+  }
+}
+
+// The alpha calculation in the forward backward algorithm (section 4.1), see ctc_loss_cpu.
+template<typename scalar_t, typename target_t>
+void ctc_loss_kernel_impl(Tensor& neg_log_likelihood, Tensor& log_alpha, const Tensor& log_probs, const Tensor& targets,
+                          IntArrayRef input_lengths, IntArrayRef target_lengths, IntArrayRef tg_batch_offsets,
+                          int64_t tg_target_stride, int64_t BLANK) {
+  constexpr scalar_t neginf = -std::numeric_limits<scalar_t>::infinity();
+  int64_t batch_size = log_probs.size(1);
+
+  auto lpp  = log_probs.permute({1,0,2});
+  auto log_probs_a_global = lpp.accessor<scalar_t, 3>();
+  auto log_alpha_a_global = log_alpha.accessor<scalar_t, 3>();
+  auto targets_data = targets.data_ptr<target_t>();
+  auto neg_log_likelihood_a = neg_log_likelihood.accessor<scalar_t, 1>();
+
+  // alpha calculation for the first row, the three equations for alpha_1 above eq (6)
+  // first the default
+  log_alpha.narrow(1, 0, 1).fill_(neginf);
+  at::parallel_for(0, batch_size, 0, [&](int64_t start, int64_t end) {
+    std::vector<int64_t> target_primes;
+    std::vector<scalar_t> skip_mask, prev, emit;
+    for (int64_t b = start; b < end; b++) {
+      int64_t input_length = input_lengths[b];
+      int64_t target_length = target_lengths[b];
+      auto log_probs_a = log_probs_a_global[b];
+      auto log_alpha_a = log_alpha_a_global[b];
+      int64_t tg_batch_offset = tg_batch_offsets[b];
+
+      // the first two items of alpha_t above eq (6)
+      log_alpha_a[0][0] = log_probs_a[0][BLANK];
+      if (target_length > 0)
+        log_alpha_a[0][1] = log_probs_a[0][get_target_prime(targets_data, tg_batch_offset, tg_target_stride, 1, BLANK)];
+
+      // The augmented targets of this batch item, and the mask of the third summand of eq (6), which is allowed
+      // when s > 1 and l'(s-2) != l'(s)
+      const int64_t num_states = 2*target_length+1;
+      target_primes.resize(num_states);
+      skip_mask.resize(num_states);
+      for (int64_t s=0; s<num_states; s++) {
+        target_primes[s] = get_target_prime(targets_data, tg_batch_offset, tg_target_stride, s, BLANK);
+        skip_mask[s] = (s > 1 && target_primes[s-2] != target_primes[s]) ? 0 : neginf;
+      }
+      // prev holds the previous row of alpha preceded by two neginf, so that the summands for s-1 and s-2 in
+      // eq (6) are shifted loads from it
+      prev.assign(num_states + 2, neginf);
+      std::copy(log_alpha_a[0].data(), log_alpha_a[0].data() + num_states, prev.begin() + 2);
+      emit.resize(num_states);
+
+      // now the loop over the inputs
+      for (int64_t t=1; t<input_length; t++) {
+        for (int64_t s=0; s<num_states; s++) {
+          emit[s] = log_probs_a[t][target_primes[s]];
+        }
+        // this is the assignment of eq (6)
+        scalar_t* log_alpha_t = log_alpha_a[t].data();
+        log_add_exp3(log_alpha_t, prev.data() + 2, prev.data() + 1, prev.data(), skip_mask.data(), emit.data(), num_states);
+        std::copy(log_alpha_t, log_alpha_t + num_states, prev.begin() + 2);
+      }
+      // the likelihood is the the sum of the last two alphas, eq (8), the loss is the negative log likelihood
+      if (target_length == 0) {
+        // if the target is empty then there is no preceding BLANK state and hence there is no path to merge
+        neg_log_likelihood_a[b] = -log_alpha_a[input_length-1][0];
+      } else {
+        scalar_t l1 = log_alpha_a[input_length-1][target_length*2];
+        scalar_t l2 = log_alpha_a[input_length-1][target_length*2-1];
+        scalar_t m = std::max(l1, l2);
+        m = ((m == neginf) ? 0 : m);
+        scalar_t log_likelihood = std::log(std::exp(l1-m)+std::exp(l2-m))+m;
+        neg_log_likelihood_a[b] = -log_likelihood;
+      }
+    }
+  });
+
+}
+
+// The beta calculation and the collection of the gradient, see ctc_loss_backward_cpu.
+template<typename scalar_t, typename target_t>
+void ctc_loss_backward_kernel_impl(Tensor& grad, const Tensor& grad_out, const Tensor& log_probs, const Tensor& targets,
+                                   IntArrayRef input_lengths, IntArrayRef target_lengths, IntArrayRef tg_batch_offsets,
+                                   int64_t tg_target_stride, const Tensor& neg_log_likelihood, const Tensor& log_alpha,
+                                   int64_t BLANK, bool zero_infinity) {
+  constexpr scalar_t neginf = -std::numeric_limits<scalar_t>::infinity();
+  int64_t max_input_length = log_probs.size(0);
+  int64_t batch_size = log_probs.size(1);
+  int64_t num_labels = log_probs.size(2);
+
+  // Only two rows of beta are needed at a time, as the products of alpha and beta are collected into the
+  // gradient as soon as a row of beta is computed, so no full log_beta is allocated.
+  auto lpp  = log_probs.permute({1,0,2});
+  auto log_probs_a_global = lpp.accessor<scalar_t, 3>();
+  auto log_alpha_a_global = log_alpha.accessor<scalar_t, 3>();
+  auto gp = grad.permute({1,0,2});
+  auto grad_a_global = gp.accessor<scalar_t, 3>();
+  auto targets_data = targets.data_ptr<target_t>();
+
+  at::parallel_for(0, batch_size, 0, [&](int64_t start, int64_t end) {
+    std::vector<int64_t> target_primes;
+    std::vector<scalar_t> skip_mask, next, log_beta_t, emit;
+    for (int64_t b = start; b < end; b++) {
+      scalar_t nll = neg_log_likelihood.accessor<scalar_t, 1>()[b];
+      if (zero_infinity &&  nll == std::numeric_limits<scalar_t>::infinity()) {
+        grad.narrow(1, b, 1).zero_();
+        continue;
+      }
+
+      auto log_probs_a = log_probs_a_global[b];
+      auto log_alpha_a = log_alpha_a_global[b];
+      auto grad_a = grad_a_global[b];
+      int64_t input_length = input_lengths[b];
+      int64_t target_length = target_lengths[b];
+      int64_t tg_batch_offset = tg_batch_offsets[b];
+
+      // The augmented targets of this batch item, and the mask of the third summand of eq (10), which is
+      // allowed when s < 2*target_length-1 and l'(s+2) != l'(s)
+      const int64_t num_states = 2*target_length+1;
+      target_primes.resize(num_states);
+      skip_mask.resize(num_states);
+      for (int64_t s=0; s<num_states; s++) {
+        target_primes[s] = get_target_prime(targets_data, tg_batch_offset, tg_target_stride, s, BLANK);
+      }
+      for (int64_t s=0; s<num_states; s++) {
+        skip_mask[s] = (s < 2*target_length-1 && target_primes[s+2] != target_primes[s]) ? 0 : neginf;
+      }
+      // next holds the row t+1 of beta followed by two neginf, so that the summands for s+1 and s+2 in
+      // eq (10) are shifted loads from it
+      next.assign(num_states + 2, neginf);
+      log_beta_t.resize(num_states);
+      emit.resize(num_states);
+
+      // the initialization of beta before eq (10)
+      if (input_length > 0) {
+        next[2*target_length] = log_probs_a[input_length-1][BLANK];
+        grad_a[input_length-1][BLANK] = log_alpha_a[input_length-1][2*target_length] + next[2*target_length];
+
+        if (target_length > 0) {
+          auto current_target_prime = target_primes[2*target_length-1];
+          next[2*target_length-1] = log_probs_a[input_length-1][current_target_prime];
+
+          // the first two are a blank and a non-blank, so we know they are different and we don't need to do log+
+          grad_a[input_length-1][current_target_prime] = log_alpha_a[input_length-1][2*target_length-1] + next[2*target_length-1];
+        }
+      }
+
+      // now loop applying eq (10) / (11)
+      for (int64_t t=input_length-2; t>=0; t--) {
+        for (int64_t s=0; s<num_states; s++) {
+          emit[s] = log_probs_a[t][target_primes[s]];
+        }
+        log_add_exp3(log_beta_t.data(), next.data(), next.data() + 1, next.data() + 2, skip_mask.data(), emit.data(), num_states);
+        // now that we have beta, we fill in the sum of alpha*beta in eq (16)
+        // in contrast to the cuda implementation, we only parallelize over the batch, so we don't have a concurrency
+        // issue (several s can map to the same target character)
+        // collected[b, t, target'[s]] "log+=" log_alpha[t, s]+log_beta[t, s]
+        for (int64_t s=num_states-1; s>=0; s--) {
+          scalar_t log_alpha_beta =  log_alpha_a[t][s] + log_beta_t[s];
+          scalar_t &lcab = grad_a[t][target_primes[s]];
+          if (lcab == neginf) {
+            lcab = log_alpha_beta;
+          } else {
+            scalar_t max = std::max(lcab, log_alpha_beta);
+            lcab = std::log(std::exp(lcab-max)+std::exp(log_alpha_beta-max))+max;
+          }
+        }
+        std::copy(log_beta_t.begin(), log_beta_t.end(), next.begin());
+      }
+
+      // now grad has the sum of eq (16)
+      // now we wrap up the calculation by adding in the remaining items of eq (16)
+      // grad is the output gradient, nll is the loss. Note that the likelihood -nll is the Z of eq (16)
+      scalar_t gr =  grad_out.accessor<scalar_t, 1>()[b];
+      for (int64_t t = 0; t < input_length; t++) { // or go for the full thing?
+        if (log_probs_a.stride(1) == 1 && grad_a.stride(1) == 1) {
+          using Vec = vec256::Vec256<scalar_t>;
+          const Vec nll_vec(nll);
+          const Vec gr_vec(gr);
+          vec256::map2(
+              [=](Vec res, Vec lp) { return (lp.exp() - (res + nll_vec - lp).exp()) * gr_vec; },
+              grad_a[t].data(), grad_a[t].data(), log_probs_a[t].data(), num_labels);
+        } else {
+          for (int64_t c = 0; c < num_labels; c++) {
+            scalar_t& res = grad_a[t][c];
+            scalar_t lp = log_probs_a[t][c];
+            res = (std::exp(lp)-std::exp(res + nll - lp)) * gr;
+          }
+        }
+      }
+      // zero the remainder
+      if (input_length < max_input_length) {
+        grad.narrow(0, input_length, max_input_length - input_length).narrow(1, b, 1).zero_();
+      }
+    }
+  });
+}
+
+void ctc_loss_kernel(Tensor& neg_log_likelihood, Tensor& log_alpha, const Tensor& log_probs, const Tensor& targets,
+                     IntArrayRef input_lengths, IntArrayRef target_lengths, IntArrayRef tg_batch_offsets,
+                     int64_t tg_target_stride, int64_t BLANK) {
+  AT_DISPATCH_FLOATING_TYPES(log_probs.scalar_type(), "ctc_loss_cpu", [&] {
+    if (targets.scalar_type() == kLong) {
+      ctc_loss_kernel_impl<scalar_t, int64_t>(neg_log_likelihood, log_alpha, log_probs, targets, input_lengths,
+                                              target_lengths, tg_batch_offsets, tg_target_stride, BLANK);
+    } else {
+      ctc_loss_kernel_impl<scalar_t, int>(neg_log_likelihood, log_alpha, log_probs, targets, input_lengths,
+                                          target_lengths, tg_batch_offsets, tg_target_stride, BLANK);
+    }
+  });
+}
+
+void ctc_loss_backward_kernel(Tensor& grad, const Tensor& grad_out, const Tensor& log_probs, const Tensor& targets,
+                              IntArrayRef input_lengths, IntArrayRef target_lengths, IntArrayRef tg_batch_offsets,
+                              int64_t tg_target_stride, const Tensor& neg_log_likelihood, const Tensor& log_alpha,
+                              int64_t BLANK, bool zero_infinity) {
+  AT_DISPATCH_FLOATING_TYPES(log_probs.scalar_type(), "ctc_loss_backward_cpu", [&] {
+    if (targets.scalar_type() == kLong) {
+      ctc_loss_backward_kernel_impl<scalar_t, int64_t>(grad, grad_out, log_probs, targets, input_lengths, target_lengths,
+                                                       tg_batch_offsets, tg_target_stride, neg_log_likelihood, log_alpha,
+                                                       BLANK, zero_infinity);
+    } else {
+      ctc_loss_backward_kernel_impl<scalar_t, int>(grad, grad_out, log_probs, targets, input_lengths, target_lengths,
+                                                   tg_batch_offsets, tg_target_stride, neg_log_likelihood, log_alpha,
+                                                   BLANK, zero_infinity);
+    }
+  });
+}
+
+} // namespace
+
+REGISTER_DISPATCH(ctc_loss_stub, &ctc_loss_kernel);
+REGISTER_DISPATCH(ctc_loss_backward_stub, &ctc_loss_backward_kernel);
+
+} } // at::native
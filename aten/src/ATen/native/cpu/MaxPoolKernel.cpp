@@ -0,0 +1,205 @@
+#include <ATen/ATen.h>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/Pool.h>
+#include <ATen/native/cpu/utils.h>
+#include <c10/util/accumulate.h>
+
+namespace at { namespace native {
+
+namespace {
+
+template <typename scalar_t>
+void cpu_max_pool_channels_last(
+    Tensor& output_,
+    Tensor& indices_,
+    const Tensor& input_,
+    const PoolingWindow3D& w) {
+  const int64_t ndim = input_.ndimension();
+  auto memory_format = ndim == 4 ? at::MemoryFormat::ChannelsLast : at::MemoryFormat::ChannelsLast3d;
+  auto input = input_.contiguous(memory_format);
+  auto output = output_.contiguous(memory_format);
+  auto indices = indices_.contiguous(memory_format);
+
+  auto input_data = input.data_ptr<scalar_t>();
+  auto output_data = output.data_ptr<scalar_t>();
+  auto indices_data = indices.data_ptr<int64_t>();
+
+  int64_t nbatch = input.size(0);
+  int64_t channels = input.size(1);
+  int64_t input_depth = ndim == 5 ? input.size(2) : 1;
+  int64_t input_height = input.size(-2);
+  int64_t input_width = input.size(-1);
+  int64_t output_depth = ndim == 5 ? output.size(2) : 1;
+  int64_t output_height = output.size(-2);
+  int64_t output_width = output.size(-1);
+
+  using Vec = vec256::Vec256<scalar_t>;
+  using integer_t = vec256::int_same_size_t<scalar_t>;
+  using iVec = vec256::Vec256<integer_t>;
+  // the indices of a lane are tracked in integers of the size of scalar_t, so
+  // planes too large for them take the scalar loop
+  const int64_t input_plane = input_depth * input_height * input_width;
+  const int64_t vec_end = input_plane <= std::numeric_limits<integer_t>::max()
+      ? channels - (channels % Vec::size()) : 0;
+
+  // parallel on dim N, T, H
+  at::parallel_for(0, nbatch * output_depth * output_height, 0, [&](int64_t begin, int64_t end) {
+    int64_t n = 0;
+    int64_t ot = 0;
+    int64_t oh = 0;
+    data_index_init(begin, n, nbatch, ot, output_depth, oh, output_height);
+
+    for (int64_t i = begin; i < end; i++) {
+      int64_t it0 = ot * w.dT - w.pT;
+      int64_t ih0 = oh * w.dH - w.pH;
+      int64_t it1 = std::min(it0 + (w.kT - 1) * w.dilationT + 1, input_depth);
+      int64_t ih1 = std::min(ih0 + (w.kH - 1) * w.dilationH + 1, input_height);
+      while (it0 < 0) {
+        it0 += w.dilationT;
+      }
+      while (ih0 < 0) {
+        ih0 += w.dilationH;
+      }
+      scalar_t* input_ptr = input_data + n * input_plane * channels;
+
+      for (int64_t ow = 0; ow < output_width; ow++) {
+        int64_t iw0 = ow * w.dW - w.pW;
+        int64_t iw1 = std::min(iw0 + (w.kW - 1) * w.dilationW + 1, input_width);
+        while (iw0 < 0) {
+          iw0 += w.dilationW;
+        }
+        const int64_t index0 = it0 * input_height * input_width + ih0 * input_width + iw0;
+
+        scalar_t* out = output_data + (i * output_width + ow) * channels;
+        int64_t* ind = indices_data + (i * output_width + ow) * channels;
+
+        int64_t d = 0;
+        for (; d < vec_end; d += Vec::size()) {
+          Vec maxval_vec = Vec(-std::numeric_limits<scalar_t>::infinity());
+          iVec maxindex_vec = iVec(static_cast<integer_t>(index0));
+          for (int64_t it = it0; it < it1; it += w.dilationT) {
+            for (int64_t ih = ih0; ih < ih1; ih += w.dilationH) {
+              for (int64_t iw = iw0; iw < iw1; iw += w.dilationW) {
+                int64_t index = it * input_height * input_width + ih * input_width + iw;
+                Vec val_vec = Vec::loadu(input_ptr + index * channels + d);
+                // nan propagates, as in the contiguous kernels
+                Vec mask = (val_vec > maxval_vec) | (val_vec != val_vec);
+                maxval_vec = Vec::blendv(maxval_vec, val_vec, mask);
+                maxindex_vec = iVec::blendv(maxindex_vec, iVec(static_cast<integer_t>(index)),
+                                            vec256::cast<integer_t>(mask));
+              }
+            }
+          }
+          maxval_vec.store(out + d);
+          integer_t maxindex[iVec::size()];
+          maxindex_vec.store(maxindex);
+          for (int64_t j = 0; j < iVec::size(); j++) {
+            ind[d + j] = maxindex[j];
+          }
+        }
+        for (; d < channels; d++) {
+          scalar_t maxval = -std::numeric_limits<scalar_t>::infinity();
+          int64_t maxindex = index0;
+          for (int64_t it = it0; it < it1; it += w.dilationT) {
+            for (int64_t ih = ih0; ih < ih1; ih += w.dilationH) {
+              for (int64_t iw = iw0; iw < iw1; iw += w.dilationW) {
+                int64_t index = it * input_height * input_width + ih * input_width + iw;
+                scalar_t val = input_ptr[index * channels + d];
+                if ((val > maxval) || std::isnan(val)) {
+                  maxval = val;
+                  maxindex = index;
+                }
+              }
+            }
+          }
+          out[d] = maxval;
+          ind[d] = maxindex;
+        }
+      }
+
+      // move on to next output index
+      data_index_step(n, nbatch, ot, output_depth, oh, output_height);
+    }
+  });
+
+  if (!output_.is_contiguous(memory_format)) {
+    output_.copy_(output);
+  }
+  if (!indices_.is_contiguous(memory_format)) {
+    indices_.copy_(indices);
+  }
+}
+
+template <typename scalar_t>
+void cpu_max_pool_backward_channels_last(
+    Tensor& grad_input_,
+    const Tensor& grad_output_,
+    const Tensor& indices_) {
+  const int64_t ndim = grad_output_.ndimension();
+  auto memory_format = ndim == 4 ? at::MemoryFormat::ChannelsLast : at::MemoryFormat::ChannelsLast3d;
+  auto grad_input = grad_input_.contiguous(memory_format);
+  auto grad_output = grad_output_.contiguous(memory_format);
+  auto indices = indices_.contiguous(memory_format);
+
+  auto grad_input_data = grad_input.data_ptr<scalar_t>();
+  auto grad_output_data = grad_output.data_ptr<scalar_t>();
+  auto indices_data = indices.data_ptr<int64_t>();
+
+  int64_t nbatch = grad_input.size(0);
+  int64_t channels = grad_input.size(1);
+  int64_t input_plane = c10::multiply_integers(grad_input.sizes().slice(2));
+  int64_t output_plane = c10::multiply_integers(grad_output.sizes().slice(2));
+
+  // parallel on dim N, as the windows of different outputs overlap
+  at::parallel_for(0, nbatch, 0, [&](int64_t begin, int64_t end) {
+    for (int64_t n = begin; n < end; n++) {
+      scalar_t* grad_input_ptr = grad_input_data + n * input_plane * channels;
+      scalar_t* grad_output_ptr = grad_output_data + n * output_plane * channels;
+      int64_t* indices_ptr = indices_data + n * output_plane * channels;
+
+      for (int64_t o = 0; o < output_plane; o++) {
+        scalar_t* gout = grad_output_ptr + o * channels;
+        int64_t* ind = indices_ptr + o * channels;
+        for (int64_t d = 0; d < channels; d++) {
+          int64_t maxindex = ind[d];
+          if (maxindex != -1) {
+            grad_input_ptr[maxindex * channels + d] += gout[d];
+          }
+        }
+      }
+    }
+  });
+
+  if (!grad_input_.is_contiguous(memory_format)) {
+    grad_input_.copy_(grad_input);
+  }
+}
+
+void max_pool_channels_last_kernel_impl(
+    Tensor& output,
+    Tensor& indices,
+    const Tensor& input,
+    const PoolingWindow3D& window) {
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "max_pool_channels_last", [&] {
+    cpu_max_pool_channels_last<scalar_t>(output, indices, input, window);
+  });
+}
+
+void max_pool_channels_last_backward_kernel_impl(
+    Tensor& grad_input,
+    const Tensor& grad_output,
+    const Tensor& indices) {
+  AT_DISPATCH_FLOATING_TYPES(grad_output.scalar_type(), "max_pool_channels_last_backward", [&] {
+    cpu_max_pool_backward_channels_last<scalar_t>(grad_input, grad_output, indices);
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(max_pool_channels_last_kernel, &max_pool_channels_last_kernel_impl);
+REGISTER_DISPATCH(max_pool_channels_last_backward_kernel, &max_pool_channels_last_backward_kernel_impl);
+
+}} // at::native
@@ -115,10 +115,48 @@ static void multinomial_with_replacement_kernel_impl(
     multinomial_with_replacement_apply<scalar_t>(result, self, n_sample, gen);
   });
 }
+
+template <typename scalar_t>
+void multinomial_alias_draw_apply(
+    Tensor& result,
+    const Tensor& J,
+    const Tensor& q,
+    c10::optional<Generator> generator) {
+  auto gen = get_generator_or_default<CPUGeneratorImpl>(generator, detail::getDefaultCPUGenerator());
+  // See Note [Acquire lock when using random generators]
+  std::lock_guard<std::mutex> lock(gen->mutex_);
+
+  const int64_t n_categories = q.numel();
+  const int64_t n_sample = result.numel();
+  const int64_t* const J_ptr = J.data_ptr<int64_t>();
+  const scalar_t* const q_ptr = q.data_ptr<scalar_t>();
+  int64_t* const result_ptr = result.data_ptr<int64_t>();
+
+  for (int64_t i = 0; i < n_sample; i++) {
+    /* pick a category uniformly, then keep it or take its alias */
+    at::uniform_real_distribution<double> uniform(0, 1);
+    const int64_t k = std::min<int64_t>(
+        static_cast<int64_t>(uniform(gen) * n_categories), n_categories - 1);
+    result_ptr[i] = uniform(gen) < static_cast<double>(q_ptr[k]) ? k : J_ptr[k];
+  }
+}
+
+static void multinomial_alias_draw_kernel_impl(
+    Tensor& result,
+    const Tensor& J,
+    const Tensor& q,
+    c10::optional<Generator> gen) {
+  AT_DISPATCH_FLOATING_TYPES_AND_HALF(q.scalar_type(), "multinomial_alias_draw", [&] {
+    multinomial_alias_draw_apply<scalar_t>(result, J, q, gen);
+  });
+}
 }
 
 REGISTER_DISPATCH(
     multinomial_with_replacement_stub,
     &multinomial_with_replacement_kernel_impl);
+REGISTER_DISPATCH(
+    multinomial_alias_draw_stub,
+    &multinomial_alias_draw_kernel_impl);
 }
 }
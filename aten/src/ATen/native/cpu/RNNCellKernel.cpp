@@ -0,0 +1,103 @@
+#include <ATen/ATen.h>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/RNN.h>
+
+namespace at { namespace native {
+
+namespace {
+
+template <typename Vec>
+inline Vec sigmoid(const Vec& x) {
+  const Vec one(1);
+  return one / (one + x.neg().exp());
+}
+
+// gates holds the input, forget, cell and output gate pre-activations of the
+// batch, each of size hidden_size, as computed by the two LSTM GEMMs
+template <typename scalar_t>
+void lstm_cell_kernel_impl(Tensor& hy, Tensor& cy, const Tensor& gates, const Tensor& cx) {
+  using Vec = vec256::Vec256<scalar_t>;
+  const int64_t batch_size = cx.size(0);
+  const int64_t hidden_size = cx.size(1);
+  const scalar_t* gates_data = gates.data_ptr<scalar_t>();
+  const scalar_t* cx_data = cx.data_ptr<scalar_t>();
+  scalar_t* hy_data = hy.data_ptr<scalar_t>();
+  scalar_t* cy_data = cy.data_ptr<scalar_t>();
+
+  const int64_t grain_size = std::max<int64_t>(1, internal::GRAIN_SIZE / (4 * hidden_size));
+  at::parallel_for(0, batch_size, grain_size, [&](int64_t begin, int64_t end) {
+    for (int64_t b = begin; b < end; b++) {
+      const scalar_t* ingate = gates_data + b * 4 * hidden_size;
+      const scalar_t* forgetgate = ingate + hidden_size;
+      const scalar_t* cellgate = ingate + 2 * hidden_size;
+      const scalar_t* outgate = ingate + 3 * hidden_size;
+      const scalar_t* c = cx_data + b * hidden_size;
+      scalar_t* h_out = hy_data + b * hidden_size;
+      scalar_t* c_out = cy_data + b * hidden_size;
+      for (int64_t d = 0; d < hidden_size; d += Vec::size()) {
+        const int64_t count = std::min<int64_t>(Vec::size(), hidden_size - d);
+        const Vec i = sigmoid(Vec::loadu(ingate + d, count));
+        const Vec f = sigmoid(Vec::loadu(forgetgate + d, count));
+        const Vec g = Vec::loadu(cellgate + d, count).tanh();
+        const Vec o = sigmoid(Vec::loadu(outgate + d, count));
+        const Vec c_new = f * Vec::loadu(c + d, count) + i * g;
+        c_new.store(c_out + d, count);
+        (o * c_new.tanh()).store(h_out + d, count);
+      }
+    }
+  });
+}
+
+// igates and hgates hold the reset, update and new gate pre-activations of
+// the input and of the hidden state respectively, biases included
+template <typename scalar_t>
+void gru_cell_kernel_impl(Tensor& hy, const Tensor& igates, const Tensor& hgates, const Tensor& hx) {
+  using Vec = vec256::Vec256<scalar_t>;
+  const int64_t batch_size = hx.size(0);
+  const int64_t hidden_size = hx.size(1);
+  const scalar_t* igates_data = igates.data_ptr<scalar_t>();
+  const scalar_t* hgates_data = hgates.data_ptr<scalar_t>();
+  const scalar_t* hx_data = hx.data_ptr<scalar_t>();
+  scalar_t* hy_data = hy.data_ptr<scalar_t>();
+
+  const int64_t grain_size = std::max<int64_t>(1, internal::GRAIN_SIZE / (6 * hidden_size));
+  at::parallel_for(0, batch_size, grain_size, [&](int64_t begin, int64_t end) {
+    for (int64_t b = begin; b < end; b++) {
+      const scalar_t* ig = igates_data + b * 3 * hidden_size;
+      const scalar_t* hg = hgates_data + b * 3 * hidden_size;
+      const scalar_t* h = hx_data + b * hidden_size;
+      scalar_t* h_out = hy_data + b * hidden_size;
+      for (int64_t d = 0; d < hidden_size; d += Vec::size()) {
+        const int64_t count = std::min<int64_t>(Vec::size(), hidden_size - d);
+        const Vec r = sigmoid(Vec::loadu(ig + d, count) + Vec::loadu(hg + d, count));
+        const Vec z = sigmoid(Vec::loadu(ig + hidden_size + d, count) +
+                              Vec::loadu(hg + hidden_size + d, count));
+        const Vec n = (Vec::loadu(ig + 2 * hidden_size + d, count) +
+                       r * Vec::loadu(hg + 2 * hidden_size + d, count)).tanh();
+        (n + z * (Vec::loadu(h + d, count) - n)).store(h_out + d, count);
+      }
+    }
+  });
+}
+
+void lstm_cell_kernel(Tensor& hy, Tensor& cy, const Tensor& gates, const Tensor& cx) {
+  AT_DISPATCH_FLOATING_TYPES(gates.scalar_type(), "lstm_cell_cpu", [&] {
+    lstm_cell_kernel_impl<scalar_t>(hy, cy, gates, cx);
+  });
+}
+
+void gru_cell_kernel(Tensor& hy, const Tensor& igates, const Tensor& hgates, const Tensor& hx) {
+  AT_DISPATCH_FLOATING_TYPES(hx.scalar_type(), "gru_cell_cpu", [&] {
+    gru_cell_kernel_impl<scalar_t>(hy, igates, hgates, hx);
+  });
+}
+
+} // namespace
+
+REGISTER_DISPATCH(lstm_cell_cpu_stub, &lstm_cell_kernel);
+REGISTER_DISPATCH(gru_cell_cpu_stub, &gru_cell_kernel);
+
+}} // namespace at::native
@@ -2,6 +2,8 @@
 #include <ATen/native/DispatchStub.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/TensorAdvancedIndexing.h>
+#include <ATen/native/cpu/AtomicAddFloat.h>
+#include <ATen/Context.h>
 #include <ATen/Parallel.h>
 
 namespace at { namespace native {
@@ -31,6 +33,20 @@ public:
 };
 static ReduceAdd reduce_add;
 
+// Only used for float, see scatter_add_cpu_kernel.
+class ReduceAddAtomicFloat {
+public:
+  template <typename scalar_t>
+  void operator() (scalar_t * self_data, scalar_t * src_data) const {
+    *self_data += *src_data;
+  }
+
+  void operator() (float * self_data, float * src_data) const {
+    cpu_atomic_add_float(self_data, *src_data);
+  }
+};
+static ReduceAddAtomicFloat reduce_add_atomic_float;
+
 class TensorAssign {
 public:
   template <typename scalar_t>
@@ -316,7 +332,58 @@ void scatter_fill_cpu_kernel(Tensor& self, int64_t dim, const Tensor& index, Sca
     self, dim, index, value, "scatter_fill_cpu_", tensor_assign);
 }
 
+// Returns true if index holds the same value for every position outside dim,
+// as it does when expanded from a vector, e.g. for GNN message passing.
+bool index_is_expanded_vector(const Tensor& index, int64_t dim) {
+  for (int64_t d = 0; d < index.dim(); d++) {
+    if (d != dim && index.size(d) > 1 && index.stride(d) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void scatter_add_cpu_kernel(Tensor& self, int64_t dim, const Tensor& index, const Tensor& src) {
+  // The dim loop of cpu_scatter_gather_base_kernel is serial, and it is
+  // only parallelized over the other dimensions. When those are small, use
+  // one of the parallel paths below instead.
+  dim = maybe_wrap_dim(dim, self.dim());
+  const auto index_dim_size = ensure_nonempty_size(index, dim);
+  const bool parallelize_dim = index.numel() >= internal::GRAIN_SIZE &&
+      index_dim_size > 1 && index.numel() / index_dim_size < internal::GRAIN_SIZE &&
+      at::get_num_threads() > 1 && !at::in_parallel_region();
+
+  if (parallelize_dim && self.dim() > 1 && index_is_expanded_vector(index, dim)) {
+    // Equivalent to index_add_ of the index vector, which accumulates
+    // in parallel without changing the order of additions.
+    scatter_gather_dtype_check("scatter_add_", self, index, src);
+    scatter_shape_check(self, dim, index, src);
+    auto self_view = self;
+    auto src_view = src;
+    for (int64_t d = 0; d < index.dim(); d++) {
+      if (d != dim) {
+        self_view = self_view.narrow(d, 0, index.size(d));
+      }
+      src_view = src_view.narrow(d, 0, index.size(d));
+    }
+    auto index_vector = index.as_strided({index_dim_size}, {index.stride(dim)});
+    self_view.index_add_(dim, index_vector, src_view);
+    return;
+  }
+
+  // See Note [Enabling Deterministic Operations]
+  // Atomic accumulation is nondeterministic.
+  if (parallelize_dim && self.scalar_type() == ScalarType::Float &&
+      !at::globalContext().deterministicAlgorithms()) {
+    at::parallel_for(0, index_dim_size, internal::GRAIN_SIZE / (index.numel() / index_dim_size),
+        [&](int64_t begin, int64_t end) {
+      cpu_scatter_gather_base_kernel<>()(
+        self, dim, index.narrow(dim, begin, end - begin), src.narrow(dim, begin, end - begin),
+        "scatter_add_", reduce_add_atomic_float);
+    });
+    return;
+  }
+
   cpu_scatter_gather_base_kernel<>()(
     self, dim, index, src,
     "scatter_add_", reduce_add);
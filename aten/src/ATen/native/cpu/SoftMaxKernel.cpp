@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <iterator>
 #include <numeric>
+#include <type_traits>
 
 #include <ATen/Dispatch.h>
 #include <ATen/Parallel.h>
@@ -28,7 +29,10 @@ inline void _vec_log_softmax_lastdim(
     scalar_t* output_data_base,
     int64_t outer_size,
     int64_t dim_size) {
-  using Vec = vec256::Vec256<scalar_t>;
+  // BFloat16 is computed and accumulated in float, see
+  // Note [BFloat16 functional]
+  using acc_t = vec256::vec_scalar_t<scalar_t>;
+  using Vec = vec256::Vec256<acc_t>;
   static constexpr int64_t CHUNK_SIZE = (128 / sizeof(scalar_t)) * Vec::size();
   int64_t grain_size = internal::GRAIN_SIZE / (16 * dim_size * CHUNK_SIZE);
   if (grain_size < CHUNK_SIZE)
@@ -40,8 +44,8 @@ inline void _vec_log_softmax_lastdim(
       grain_size,
       [&](int64_t begin, int64_t end) {
         for (int64_t ii = begin; ii < end; ii += CHUNK_SIZE) {
-          scalar_t tmp_sum_scalar[CHUNK_SIZE];
-          scalar_t max_input_arr[CHUNK_SIZE];
+          acc_t tmp_sum_scalar[CHUNK_SIZE];
+          acc_t max_input_arr[CHUNK_SIZE];
           int64_t loop_end = CHUNK_SIZE;
           if (ii + CHUNK_SIZE > end)
             loop_end = end - ii;
@@ -56,7 +60,7 @@ inline void _vec_log_softmax_lastdim(
           for (int64_t j = 0; j < loop_end; j++) {
             int64_t i = ii + j;
             scalar_t* input_data = input_data_base + i * dim_size;
-            scalar_t max_input = max_input_arr[j];
+            acc_t max_input = max_input_arr[j];
             tmp_sum_scalar[j] = vec256::map_reduce_all<scalar_t>(
                 [max_input](Vec x) { return (x - Vec(max_input)).exp(); },
                 [](Vec x, Vec y) { return x + y; },
@@ -74,15 +78,15 @@ inline void _vec_log_softmax_lastdim(
             int64_t i = ii + j;
             scalar_t* input_data = input_data_base + i * dim_size;
             scalar_t* output_data = output_data_base + i * dim_size;
-            scalar_t tmp_sum = tmp_sum_scalar[j];
-            scalar_t max_input = max_input_arr[j];
+            acc_t tmp_sum = tmp_sum_scalar[j];
+            acc_t max_input = max_input_arr[j];
 
             // It's necessary to keep the order of the operations below.
             // In some cases that input is large digits and the difference
             // is small, if we compute `max_input` plus `tmp_sum` before,
             // there would be a numerical problem. See an example in
             // https://github.com/pytorch/pytorch/issues/11752#issuecomment-422883379
-            vec256::map(
+            vec256::map<scalar_t>(
                 [tmp_sum, max_input](Vec x) { return x - Vec(max_input) - Vec(tmp_sum); },
                 output_data,
                 input_data,
@@ -98,6 +102,189 @@ inline void _vec_softmax_lastdim(
     scalar_t* output_data_base,
     int64_t outer_size,
     int64_t dim_size) {
+  using acc_t = vec256::vec_scalar_t<scalar_t>;
+  using Vec = vec256::Vec256<acc_t>;
+  int64_t grain_size = internal::GRAIN_SIZE / (16 * dim_size);
+  if (grain_size < 1)
+    grain_size = 1;
+
+  parallel_for(
+      0,
+      outer_size,
+      grain_size,
+      [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+          scalar_t* input_data = input_data_base + i * dim_size;
+          scalar_t* output_data = output_data_base + i * dim_size;
+          acc_t max_input = vec256::reduce_all<scalar_t>(
+              [](Vec& x, Vec& y) { return vec256::maximum(x, y); },
+              input_data,
+              dim_size);
+          if (std::is_same<scalar_t, acc_t>::value) {
+            vec256::map<scalar_t>(
+                [max_input](Vec x) { return (x - Vec(max_input)).exp(); },
+                output_data,
+                input_data,
+                dim_size);
+            acc_t tmp_sum = vec256::reduce_all<scalar_t>(
+                [](Vec x, Vec y) { return x + y; }, output_data, dim_size);
+            tmp_sum = 1 / tmp_sum;
+            vec256::map<scalar_t>(
+                [tmp_sum](Vec x) { return x * Vec(tmp_sum); },
+                output_data,
+                output_data,
+                dim_size);
+          } else {
+            // Summing the exponentials after rounding them to scalar_t would
+            // lose precision, compute them twice instead
+            acc_t tmp_sum = vec256::map_reduce_all<scalar_t>(
+                [max_input](Vec x) { return (x - Vec(max_input)).exp(); },
+                [](Vec x, Vec y) { return x + y; },
+                input_data,
+                dim_size);
+            tmp_sum = 1 / tmp_sum;
+            vec256::map<scalar_t>(
+                [max_input, tmp_sum](Vec x) {
+                  return (x - Vec(max_input)).exp() * Vec(tmp_sum);
+                },
+                output_data,
+                input_data,
+                dim_size);
+          }
+        }
+      });
+}
+
+// Softmax over a dim that is not the innermost one. The input is viewed as
+// [outer_size, dim_size, inner_size] and each task reduces a
+// [dim_size, chunk_size] tile of one outer slice, so all loads and stores are
+// contiguous along the inner dim. chunk_size is picked to keep the tile in L1
+// across the three passes (max, sum of exponentials, normalization).
+template <typename scalar_t, bool LogSoftMax>
+inline void _vec_softmax(
+    scalar_t* input_data_base,
+    scalar_t* output_data_base,
+    int64_t outer_size,
+    int64_t inner_size,
+    int64_t dim_size) {
+  using Vec = vec256::Vec256<scalar_t>;
+  static constexpr int64_t MAX_CHUNK_SIZE = 16 * Vec::size();
+  static constexpr int64_t L1_TILE_BYTES = 16 * 1024;
+  int64_t chunk_size =
+      L1_TILE_BYTES / (dim_size * sizeof(scalar_t)) / Vec::size() * Vec::size();
+  chunk_size = std::max<int64_t>(chunk_size, Vec::size());
+  chunk_size = std::min<int64_t>(chunk_size, MAX_CHUNK_SIZE);
+  chunk_size = std::min<int64_t>(chunk_size, inner_size);
+  const int64_t num_chunks = (inner_size + chunk_size - 1) / chunk_size;
+  const int64_t outer_stride = dim_size * inner_size;
+  int64_t grain_size = internal::GRAIN_SIZE / (16 * dim_size * chunk_size);
+  if (grain_size < 1)
+    grain_size = 1;
+
+  parallel_for(
+      0,
+      outer_size * num_chunks,
+      grain_size,
+      [&](int64_t begin, int64_t end) {
+        scalar_t max_input_arr[MAX_CHUNK_SIZE];
+        scalar_t tmp_sum_arr[MAX_CHUNK_SIZE];
+        for (int64_t i = begin; i < end; i++) {
+          int64_t outer_idx = i / num_chunks;
+          int64_t inner_idx = (i % num_chunks) * chunk_size;
+          int64_t size = std::min(chunk_size, inner_size - inner_idx);
+          scalar_t* input_data =
+              input_data_base + outer_idx * outer_stride + inner_idx;
+          scalar_t* output_data =
+              output_data_base + outer_idx * outer_stride + inner_idx;
+
+          std::copy(input_data, input_data + size, max_input_arr);
+          for (int64_t d = 1; d < dim_size; d++) {
+            vec256::map2(
+                [](Vec x, Vec y) { return vec256::maximum(x, y); },
+                max_input_arr,
+                max_input_arr,
+                input_data + d * inner_size,
+                size);
+          }
+
+          std::fill(tmp_sum_arr, tmp_sum_arr + size, scalar_t(0));
+          for (int64_t d = 0; d < dim_size; d++) {
+            if (LogSoftMax) {
+              vec256::map3(
+                  [](Vec sum, Vec x, Vec max_input) {
+                    return sum + (x - max_input).exp();
+                  },
+                  tmp_sum_arr,
+                  tmp_sum_arr,
+                  input_data + d * inner_size,
+                  max_input_arr,
+                  size);
+            } else {
+              vec256::map2(
+                  [](Vec x, Vec max_input) { return (x - max_input).exp(); },
+                  output_data + d * inner_size,
+                  input_data + d * inner_size,
+                  max_input_arr,
+                  size);
+              vec256::map2(
+                  [](Vec sum, Vec z) { return sum + z; },
+                  tmp_sum_arr,
+                  tmp_sum_arr,
+                  output_data + d * inner_size,
+                  size);
+            }
+          }
+
+          // See [Note AVX-SSE transitions] for why this should call the
+          // vectorized version (aside from perf improvements).
+          if (LogSoftMax) {
+            vec256::map(
+                [](Vec x) { return x.log(); }, tmp_sum_arr, tmp_sum_arr, size);
+          } else {
+            vec256::map(
+                [](Vec x) { return x.reciprocal(); },
+                tmp_sum_arr,
+                tmp_sum_arr,
+                size);
+          }
+
+          for (int64_t d = 0; d < dim_size; d++) {
+            if (LogSoftMax) {
+              // Same order of operations as _vec_log_softmax_lastdim
+              vec256::map3(
+                  [](Vec x, Vec max_input, Vec tmp_sum) {
+                    return x - max_input - tmp_sum;
+                  },
+                  output_data + d * inner_size,
+                  input_data + d * inner_size,
+                  max_input_arr,
+                  tmp_sum_arr,
+                  size);
+            } else {
+              vec256::map2(
+                  [](Vec z, Vec tmp_sum) { return z * tmp_sum; },
+                  output_data + d * inner_size,
+                  output_data + d * inner_size,
+                  tmp_sum_arr,
+                  size);
+            }
+          }
+        }
+      });
+}
+
+// softmax(input * scale + mask) over the last dim in one pass over input and
+// mask. mask_offset maps a row of input to the start of its row in mask,
+// which lets broadcast masks (e.g. [batch, 1, 1, seq]) be read in place.
+template <typename scalar_t, typename offset_func_t>
+inline void _vec_scaled_masked_softmax_lastdim(
+    scalar_t* input_data_base,
+    scalar_t* mask_data_base,
+    scalar_t* output_data_base,
+    const scalar_t scale,
+    int64_t outer_size,
+    int64_t dim_size,
+    const offset_func_t& mask_offset) {
   using Vec = vec256::Vec256<scalar_t>;
   int64_t grain_size = internal::GRAIN_SIZE / (16 * dim_size);
   if (grain_size < 1)
@@ -110,15 +297,22 @@ inline void _vec_softmax_lastdim(
       [&](int64_t begin, int64_t end) {
         for (int64_t i = begin; i < end; i++) {
           scalar_t* input_data = input_data_base + i * dim_size;
+          scalar_t* mask_data = mask_data_base + mask_offset(i);
           scalar_t* output_data = output_data_base + i * dim_size;
+          vec256::map2(
+              [scale](Vec x, Vec mask) { return x * Vec(scale) + mask; },
+              output_data,
+              input_data,
+              mask_data,
+              dim_size);
           scalar_t max_input = vec256::reduce_all<scalar_t>(
               [](Vec& x, Vec& y) { return vec256::maximum(x, y); },
-              input_data,
+              output_data,
               dim_size);
           vec256::map(
               [max_input](Vec x) { return (x - Vec(max_input)).exp(); },
               output_data,
-              input_data,
+              output_data,
               dim_size);
           scalar_t tmp_sum = vec256::reduce_all<scalar_t>(
               [](Vec x, Vec y) { return x + y; }, output_data, dim_size);
@@ -139,7 +333,8 @@ inline void _vec_host_softmax_backward_lastdim(
     scalar_t* output_data_base,
     int64_t outer_size,
     int64_t dim_size) {
-  using Vec = vec256::Vec256<scalar_t>;
+  using acc_t = vec256::vec_scalar_t<scalar_t>;
+  using Vec = vec256::Vec256<acc_t>;
   int64_t grain_size = internal::GRAIN_SIZE / (16 * dim_size);
   if (grain_size < 1)
     grain_size = 1;
@@ -153,7 +348,7 @@ inline void _vec_host_softmax_backward_lastdim(
           scalar_t* grad_input_data = grad_input_data_base + i * dim_size;
           scalar_t* grad_data = grad_data_base + i * dim_size;
           scalar_t* output_data = output_data_base + i * dim_size;
-          scalar_t sum;
+          acc_t sum;
           if (log_softmax) {
             sum = vec256::reduce_all<scalar_t>(
                 [](Vec& x, Vec& y) { return x + y; }, grad_data, dim_size);
@@ -166,14 +361,14 @@ inline void _vec_host_softmax_backward_lastdim(
                 dim_size);
           }
           if (log_softmax) {
-            vec256::map2(
+            vec256::map2<scalar_t>(
                 [sum](Vec x, Vec y) { return x - ((y.exp()) * Vec(sum)); },
                 grad_input_data,
                 grad_data,
                 output_data,
                 dim_size);
           } else {
-            vec256::map2(
+            vec256::map2<scalar_t>(
                 [sum](Vec x, Vec y) { return (x - Vec(sum)) * y; },
                 grad_input_data,
                 grad_data,
@@ -203,6 +398,23 @@ struct vec_host_softmax_lastdim {
   }
 };
 
+template <typename scalar_t, bool LogSoftMax>
+struct vec_host_softmax {
+  static void apply(Tensor& output, const Tensor& input, int64_t dim) {
+    int64_t outer_size = 1;
+    int64_t dim_size = input.size(dim);
+    int64_t inner_size = 1;
+    for (int64_t i = 0; i < dim; ++i)
+      outer_size *= input.size(i);
+    for (int64_t i = dim + 1; i < input.ndimension(); ++i)
+      inner_size *= input.size(i);
+    scalar_t* input_data_base = input.data_ptr<scalar_t>();
+    scalar_t* output_data_base = output.data_ptr<scalar_t>();
+    _vec_softmax<scalar_t, LogSoftMax>(
+        input_data_base, output_data_base, outer_size, inner_size, dim_size);
+  }
+};
+
 template <typename scalar_t, bool LogSoftMax>
 struct vec_host_softmax_backward_lastdim {
   static void
@@ -224,9 +436,10 @@ struct vec_host_softmax_backward_lastdim {
 };
 
 static void softmax_lastdim_kernel_impl(Tensor& result, const Tensor& self) {
-  AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "softmax_lastdim_kernel_impl", [&] {
-    vec_host_softmax_lastdim<scalar_t, false>::apply(result, self);
-  });
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      at::ScalarType::BFloat16, self.scalar_type(),
+      "softmax_lastdim_kernel_impl",
+      [&] { vec_host_softmax_lastdim<scalar_t, false>::apply(result, self); });
 }
 
 static void log_softmax_lastdim_kernel_impl(
@@ -238,12 +451,60 @@ static void log_softmax_lastdim_kernel_impl(
       [&] { vec_host_softmax_lastdim<scalar_t, true>::apply(result, self); });
 }
 
+static void softmax_kernel_impl(Tensor& result, const Tensor& self, int64_t dim) {
+  AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "softmax_kernel_impl", [&] {
+    vec_host_softmax<scalar_t, false>::apply(result, self, dim);
+  });
+}
+
+static void log_softmax_kernel_impl(Tensor& result, const Tensor& self, int64_t dim) {
+  AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "log_softmax_kernel_impl", [&] {
+    vec_host_softmax<scalar_t, true>::apply(result, self, dim);
+  });
+}
+
+static void scaled_masked_softmax_lastdim_kernel_impl(
+    Tensor& result,
+    const Tensor& self,
+    const Tensor& mask,
+    double scale) {
+  TORCH_INTERNAL_ASSERT(mask.sizes() == self.sizes());
+  TORCH_INTERNAL_ASSERT(mask.stride(-1) == 1);
+  const int64_t ndim = self.dim();
+  int64_t outer_size = 1;
+  for (int64_t i = 0; i < ndim - 1; ++i)
+    outer_size *= self.size(i);
+  const int64_t dim_size = self.size(ndim - 1);
+  const auto sizes = self.sizes().vec();
+  const auto mask_strides = mask.strides().vec();
+  auto mask_offset = [&](int64_t row) {
+    int64_t offset = 0;
+    for (int64_t d = ndim - 2; d >= 0; --d) {
+      offset += (row % sizes[d]) * mask_strides[d];
+      row /= sizes[d];
+    }
+    return offset;
+  };
+  AT_DISPATCH_FLOATING_TYPES(
+      self.scalar_type(), "scaled_masked_softmax_lastdim_kernel_impl", [&] {
+        _vec_scaled_masked_softmax_lastdim(
+            self.data_ptr<scalar_t>(),
+            mask.data_ptr<scalar_t>(),
+            result.data_ptr<scalar_t>(),
+            static_cast<scalar_t>(scale),
+            outer_size,
+            dim_size,
+            mask_offset);
+      });
+}
+
 static void softmax_backward_lastdim_kernel_impl(
     Tensor& grad_input,
     const Tensor& grad,
     const Tensor& output) {
-  AT_DISPATCH_FLOATING_TYPES(
-      grad.scalar_type(), "softmax_backward_lastdim_kernel_impl", [&] {
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      at::ScalarType::BFloat16, grad.scalar_type(),
+      "softmax_backward_lastdim_kernel_impl", [&] {
         vec_host_softmax_backward_lastdim<scalar_t, false>::apply(
             grad_input, grad, output);
       });
@@ -271,5 +532,10 @@ REGISTER_DISPATCH(
 REGISTER_DISPATCH(
     log_softmax_backward_lastdim_kernel,
     &log_softmax_backward_lastdim_kernel_impl);
+REGISTER_DISPATCH(softmax_kernel, &softmax_kernel_impl);
+REGISTER_DISPATCH(log_softmax_kernel, &log_softmax_kernel_impl);
+REGISTER_DISPATCH(
+    scaled_masked_softmax_lastdim_kernel,
+    &scaled_masked_softmax_lastdim_kernel_impl);
 
 }} // namespace at::native
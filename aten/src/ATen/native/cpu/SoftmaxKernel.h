@@ -14,5 +14,17 @@ DECLARE_DISPATCH(forward_fn, log_softmax_lastdim_kernel);
 DECLARE_DISPATCH(backward_fn, softmax_backward_lastdim_kernel);
 DECLARE_DISPATCH(backward_fn, log_softmax_backward_lastdim_kernel);
 
+using forward_fn_with_dim = void(*)(Tensor &, const Tensor &, const int64_t);
+
+DECLARE_DISPATCH(forward_fn_with_dim, softmax_kernel);
+DECLARE_DISPATCH(forward_fn_with_dim, log_softmax_kernel);
+
+// output = softmax(input * scale + mask) over the last dim. mask has the
+// sizes of input (usually an expanded view) and a unit last-dim stride.
+using scaled_masked_forward_fn =
+    void(*)(Tensor &, const Tensor &, const Tensor &, double);
+
+DECLARE_DISPATCH(scaled_masked_forward_fn, scaled_masked_softmax_lastdim_kernel);
+
 }
 }
@@ -8,6 +8,13 @@
 #include <ATen/native/Sorting.h>
 #include <ATen/native/SortingUtils.h>
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
 namespace at { namespace native {
 
 namespace {
@@ -29,7 +36,8 @@ void _dim_apply(
     Tensor& indices,
     int64_t dim,
     const std::string& method_name,
-    const func_t& f) {
+    const func_t& f,
+    bool parallel_over_slices = true) {
   dim = maybe_wrap_dim(dim, values.dim());
   TORCH_CHECK(
     dim >= 0 && dim < values.dim(),
@@ -69,7 +77,11 @@ void _dim_apply(
         }
       };
 
-      iter.for_each(loop);
+      if (parallel_over_slices) {
+        iter.for_each(loop);
+      } else {
+        iter.serial_for_each(loop, {0, iter.numel()});
+      }
     }
   );
 }
@@ -92,6 +104,296 @@ struct KeyValueCompDesc {
   }
 };
 
+template <typename scalar_t>
+struct ValueCompAsc {
+  constexpr bool operator()(scalar_t lhs, scalar_t rhs) const {
+    return (!_isnan<scalar_t>(lhs) && _isnan<scalar_t>(rhs)) || (lhs < rhs);
+  }
+};
+
+template <typename scalar_t>
+struct ValueCompDesc {
+  constexpr bool operator()(scalar_t lhs, scalar_t rhs) const {
+    return (_isnan<scalar_t>(lhs) && !_isnan<scalar_t>(rhs)) || (lhs > rhs);
+  }
+};
+
+// Slices at least this long are sorted with the parallel algorithms below
+// when there are too few of them to keep every thread busy.
+constexpr int64_t PARALLEL_SLICE_MIN_SIZE = 1 << 16;
+
+bool use_parallel_slice_algorithm(int64_t num_slices, int64_t slice_size) {
+  return slice_size >= PARALLEL_SLICE_MIN_SIZE &&
+      num_slices < at::get_num_threads() && !at::in_parallel_region();
+}
+
+// Key types for the radix sort: integers and floating point numbers, mapped
+// to unsigned integers with the same order. NaNs all map to the largest key.
+template <typename scalar_t, typename = void>
+struct RadixKey {
+  static constexpr bool supported = false;
+  using key_t = uint8_t;
+  static key_t encode(scalar_t /*value*/) { return 0; }
+};
+
+template <typename scalar_t>
+struct RadixKey<
+    scalar_t,
+    typename std::enable_if<std::is_integral<scalar_t>::value &&
+                            !std::is_same<scalar_t, bool>::value>::type> {
+  static constexpr bool supported = true;
+  using key_t = typename std::make_unsigned<scalar_t>::type;
+  static key_t encode(scalar_t value) {
+    constexpr key_t sign_bit = std::is_signed<scalar_t>::value
+        ? key_t(1) << (sizeof(key_t) * 8 - 1) : 0;
+    return static_cast<key_t>(value) ^ sign_bit;
+  }
+};
+
+template <typename scalar_t>
+struct RadixKey<
+    scalar_t,
+    typename std::enable_if<std::is_floating_point<scalar_t>::value>::type> {
+  static constexpr bool supported = true;
+  using key_t = typename std::conditional<
+      sizeof(scalar_t) == 4, uint32_t, uint64_t>::type;
+  static key_t encode(scalar_t value) {
+    constexpr key_t sign_bit = key_t(1) << (sizeof(key_t) * 8 - 1);
+    if (_isnan<scalar_t>(value)) {
+      return ~key_t(0);
+    }
+    key_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & sign_bit) ? ~bits : (bits | sign_bit);
+  }
+};
+
+// LSD radix sort of keys, with values following their keys, one byte per
+// pass. Every pass builds per-thread histograms, turns them into per-thread
+// output offsets and scatters in parallel. Passes where all keys share the
+// same byte are skipped. keys_tmp and values_tmp are scratch space of the
+// same size, the result is always returned in keys and values.
+template <typename key_t>
+void parallel_radix_sort(
+    key_t* keys,
+    int64_t* values,
+    key_t* keys_tmp,
+    int64_t* values_tmp,
+    int64_t n) {
+  constexpr int64_t NUM_BUCKETS = 256;
+  const int64_t chunk_size =
+      std::max<int64_t>((n + at::get_num_threads() - 1) / at::get_num_threads(), 1);
+  const int64_t num_chunks = (n + chunk_size - 1) / chunk_size;
+  std::vector<int64_t> offsets(num_chunks * NUM_BUCKETS);
+  key_t* src_keys = keys;
+  int64_t* src_values = values;
+  key_t* dst_keys = keys_tmp;
+  int64_t* dst_values = values_tmp;
+
+  for (int64_t shift = 0; shift < static_cast<int64_t>(sizeof(key_t) * 8); shift += 8) {
+    std::fill(offsets.begin(), offsets.end(), 0);
+    at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t c = begin; c < end; c++) {
+        int64_t* histogram = offsets.data() + c * NUM_BUCKETS;
+        const int64_t chunk_end = std::min(n, (c + 1) * chunk_size);
+        for (int64_t i = c * chunk_size; i < chunk_end; i++) {
+          histogram[(src_keys[i] >> shift) & 0xff]++;
+        }
+      }
+    });
+
+    // Exclusive scan in (bucket, chunk) order gives every chunk the place
+    // of its elements of each bucket in the output
+    bool single_bucket = false;
+    int64_t offset = 0;
+    for (int64_t b = 0; b < NUM_BUCKETS; b++) {
+      const int64_t bucket_begin = offset;
+      for (int64_t c = 0; c < num_chunks; c++) {
+        const int64_t count = offsets[c * NUM_BUCKETS + b];
+        offsets[c * NUM_BUCKETS + b] = offset;
+        offset += count;
+      }
+      single_bucket = single_bucket || (offset - bucket_begin == n);
+    }
+    if (single_bucket) {
+      continue;
+    }
+
+    at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t c = begin; c < end; c++) {
+        int64_t* chunk_offsets = offsets.data() + c * NUM_BUCKETS;
+        const int64_t chunk_end = std::min(n, (c + 1) * chunk_size);
+        for (int64_t i = c * chunk_size; i < chunk_end; i++) {
+          const int64_t pos = chunk_offsets[(src_keys[i] >> shift) & 0xff]++;
+          dst_keys[pos] = src_keys[i];
+          dst_values[pos] = src_values[i];
+        }
+      }
+    });
+    std::swap(src_keys, dst_keys);
+    std::swap(src_values, dst_values);
+  }
+
+  if (src_keys != keys) {
+    std::copy(src_keys, src_keys + n, keys);
+    std::copy(src_values, src_values + n, values);
+  }
+}
+
+// Number of elements taken from a in the first k elements of the stable merge
+// of a and b, found by binary search along the merge path
+template <typename scalar_t, typename comp_t>
+int64_t merge_path_split(
+    const scalar_t* a, int64_t a_size,
+    const scalar_t* b, int64_t b_size,
+    int64_t k, const comp_t& comp) {
+  int64_t lo = std::max<int64_t>(0, k - b_size);
+  int64_t hi = std::min(k, a_size);
+  while (lo < hi) {
+    const int64_t i = lo + (hi - lo) / 2;
+    const int64_t j = k - i;
+    // b[j - 1] precedes a[i] in the output only if it is strictly smaller
+    if (j > 0 && !comp(b[j - 1], a[i])) {
+      lo = i + 1;
+    } else {
+      hi = i;
+    }
+  }
+  return lo;
+}
+
+// Stable merge sort of keys, with values following their keys. Runs of
+// n / num_threads elements are sorted in parallel, then merged pairwise.
+// Every merge round is split along the merge path into pieces of about the
+// run size, so all threads stay busy until the last round.
+template <typename scalar_t, typename comp_t>
+void parallel_merge_sort(
+    scalar_t* keys,
+    int64_t* values,
+    scalar_t* keys_tmp,
+    int64_t* values_tmp,
+    int64_t n,
+    const comp_t& comp) {
+  const int64_t run_size =
+      std::max<int64_t>((n + at::get_num_threads() - 1) / at::get_num_threads(), 1);
+  const int64_t num_runs = (n + run_size - 1) / run_size;
+  at::parallel_for(0, num_runs, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t r = begin; r < end; r++) {
+      const int64_t run_begin = r * run_size;
+      const int64_t run_end = std::min(n, run_begin + run_size);
+      auto accessor = CompositeRandomAccessorCPU<
+        StridedRandomAccessor<scalar_t>, StridedRandomAccessor<int64_t>>(
+          StridedRandomAccessor<scalar_t>(keys + run_begin, 1),
+          StridedRandomAccessor<int64_t>(values + run_begin, 1));
+      std::stable_sort(accessor, accessor + (run_end - run_begin),
+        [&comp](auto lhs, auto rhs) { return comp(get<0>(lhs), get<0>(rhs)); });
+    }
+  });
+
+  scalar_t* src_keys = keys;
+  int64_t* src_values = values;
+  scalar_t* dst_keys = keys_tmp;
+  int64_t* dst_values = values_tmp;
+  for (int64_t width = run_size; width < n; width *= 2) {
+    const int64_t pieces_per_merge = (2 * width + run_size - 1) / run_size;
+    const int64_t num_merges = (n + 2 * width - 1) / (2 * width);
+    at::parallel_for(0, num_merges * pieces_per_merge, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t t = begin; t < end; t++) {
+        const int64_t lo = (t / pieces_per_merge) * 2 * width;
+        const int64_t mid = std::min(n, lo + width);
+        const int64_t hi = std::min(n, lo + 2 * width);
+        const int64_t k_begin = std::min(hi - lo, (t % pieces_per_merge) * run_size);
+        const int64_t k_end = std::min(hi - lo, k_begin + run_size);
+        if (k_begin == k_end) {
+          continue;
+        }
+        const scalar_t* a = src_keys + lo;
+        const scalar_t* b = src_keys + mid;
+        const int64_t a_size = mid - lo;
+        const int64_t b_size = hi - mid;
+        int64_t i = merge_path_split(a, a_size, b, b_size, k_begin, comp);
+        int64_t j = k_begin - i;
+        const int64_t i_end = merge_path_split(a, a_size, b, b_size, k_end, comp);
+        const int64_t j_end = k_end - i_end;
+        for (int64_t out = lo + k_begin; out < lo + k_end; out++) {
+          if (j < j_end && (i == i_end || comp(b[j], a[i]))) {
+            dst_keys[out] = b[j];
+            dst_values[out] = src_values[mid + j];
+            j++;
+          } else {
+            dst_keys[out] = a[i];
+            dst_values[out] = src_values[lo + i];
+            i++;
+          }
+        }
+      }
+    });
+    std::swap(src_keys, dst_keys);
+    std::swap(src_values, dst_values);
+  }
+
+  if (src_keys != keys) {
+    std::copy(src_keys, src_keys + n, keys);
+    std::copy(src_values, src_values + n, values);
+  }
+}
+
+// Sorts a single long slice with all threads: a radix sort for integer and
+// floating point keys and a merge sort for stable sorts and other types.
+template <typename scalar_t>
+void parallel_sort_slice(
+    scalar_t* values, int64_t values_dim_stride,
+    int64_t* indices, int64_t indices_dim_stride,
+    int64_t dim_size, bool descending, bool stable) {
+  // not std::vector, which packs bools into bits
+  std::unique_ptr<scalar_t[]> keys(new scalar_t[dim_size]);
+  std::vector<int64_t> order(dim_size);
+  std::vector<int64_t> order_tmp(dim_size);
+  at::parallel_for(0, dim_size, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      keys[i] = values[i * values_dim_stride];
+      order[i] = i;
+    }
+  });
+
+  using radix_key = RadixKey<scalar_t>;
+  const bool use_radix_sort = !stable && radix_key::supported;
+  if (use_radix_sort) {
+    using key_t = typename radix_key::key_t;
+    std::vector<key_t> radix_keys(dim_size);
+    std::vector<key_t> radix_keys_tmp(dim_size);
+    at::parallel_for(0, dim_size, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; i++) {
+        // NaNs come last in ascending and first in descending order
+        const key_t key = radix_key::encode(keys[i]);
+        radix_keys[i] = descending ? static_cast<key_t>(~key) : key;
+      }
+    });
+    parallel_radix_sort(
+        radix_keys.data(), order.data(),
+        radix_keys_tmp.data(), order_tmp.data(), dim_size);
+  } else {
+    std::unique_ptr<scalar_t[]> keys_tmp(new scalar_t[dim_size]);
+    if (descending) {
+      parallel_merge_sort(
+          keys.get(), order.data(), keys_tmp.get(), order_tmp.data(),
+          dim_size, ValueCompDesc<scalar_t>());
+    } else {
+      parallel_merge_sort(
+          keys.get(), order.data(), keys_tmp.get(), order_tmp.data(),
+          dim_size, ValueCompAsc<scalar_t>());
+    }
+  }
+
+  at::parallel_for(0, dim_size, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      // the radix sort only permutes order, the merge sort also sorts keys
+      values[i * values_dim_stride] = use_radix_sort ? keys[order[i]] : keys[i];
+      indices[i * indices_dim_stride] = order[i];
+    }
+  });
+}
+
 static void sort_kernel(
     Tensor& values,
     Tensor& indices,
@@ -99,7 +401,12 @@ static void sort_kernel(
     bool descending,
     bool stable) {
   dim = maybe_wrap_dim(dim, values.dim());
-  _fill_indices(indices, dim);
+  const int64_t slice_size = values.dim() == 0 ? 1 : values.size(dim);
+  const bool parallel_slices = use_parallel_slice_algorithm(
+      values.numel() / std::max<int64_t>(slice_size, 1), slice_size);
+  if (!parallel_slices) {
+    _fill_indices(indices, dim);
+  }
   _dim_apply(
     values, indices, dim,
     "sort_cpu", [&](
@@ -108,6 +415,12 @@ static void sort_kernel(
       int64_t dim_size
     ) {
       using scalar_t = typename std::remove_pointer<decltype(values)>::type;
+      if (parallel_slices) {
+        parallel_sort_slice(
+          values, values_dim_stride, indices, indices_dim_stride,
+          dim_size, descending, stable);
+        return;
+      }
       auto values_accessor = StridedRandomAccessor<scalar_t>(
         values, values_dim_stride);
       auto indices_accessor = StridedRandomAccessor<int64_t>(
@@ -136,10 +449,92 @@ static void sort_kernel(
             KeyValueCompAsc<scalar_t>());
         }
       }
-    }
+    },
+    /*parallel_over_slices=*/!parallel_slices
   );
 }
 
+// Top k of one long row with all threads: every thread selects the top k of
+// its chunk, then the top k of the candidates is selected serially.
+template <typename scalar_t, typename comp_t>
+void parallel_topk_slice(
+    const scalar_t* self_data,
+    int64_t n,
+    int64_t k,
+    bool sorted,
+    scalar_t* values_data,
+    int64_t* indices_data,
+    const comp_t& comp) {
+  using elem_t = std::pair<scalar_t, int64_t>;
+  auto elem_comp = [&comp](const elem_t& x, const elem_t& y) -> bool {
+    return comp(x.first, y.first);
+  };
+  const int64_t chunk_size =
+      std::max((n + at::get_num_threads() - 1) / at::get_num_threads(), k);
+  const int64_t num_chunks = (n + chunk_size - 1) / chunk_size;
+  std::vector<elem_t> candidates(num_chunks * k);
+  std::vector<int64_t> num_candidates(num_chunks);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    std::vector<elem_t> queue;
+    for (int64_t c = begin; c < end; c++) {
+      const int64_t chunk_begin = c * chunk_size;
+      const int64_t chunk_end = std::min(n, chunk_begin + chunk_size);
+      queue.resize(chunk_end - chunk_begin);
+      for (int64_t j = chunk_begin; j < chunk_end; j++) {
+        queue[j - chunk_begin] = elem_t(self_data[j], j);
+      }
+      const int64_t chunk_k = std::min<int64_t>(k, queue.size());
+      std::nth_element(queue.begin(), queue.begin() + chunk_k - 1, queue.end(), elem_comp);
+      std::copy(queue.begin(), queue.begin() + chunk_k, candidates.begin() + c * k);
+      num_candidates[c] = chunk_k;
+    }
+  });
+
+  // Only the last chunk can be shorter than k
+  candidates.resize((num_chunks - 1) * k + num_candidates[num_chunks - 1]);
+  std::nth_element(candidates.begin(), candidates.begin() + k - 1, candidates.end(), elem_comp);
+  if (sorted) {
+    std::sort(candidates.begin(), candidates.begin() + k - 1, elem_comp);
+  }
+  for (int64_t j = 0; j < k; j++) {
+    values_data[j] = candidates[j].first;
+    indices_data[j] = candidates[j].second;
+  }
+}
+
+void parallel_topk(
+    Tensor& values,
+    Tensor& indices,
+    const Tensor& self,
+    int64_t k,
+    int64_t dim,
+    bool largest,
+    bool sorted) {
+  const int64_t n = self.size(dim);
+  auto rows = self.transpose(dim, -1).contiguous().view({-1, n});
+  auto rows_values = at::empty({rows.size(0), k}, values.options());
+  auto rows_indices = at::empty({rows.size(0), k}, indices.options());
+  AT_DISPATCH_ALL_TYPES(self.scalar_type(), "topk_cpu", [&] {
+    for (int64_t i = 0; i < rows.size(0); i++) {
+      const scalar_t* self_data = rows.data_ptr<scalar_t>() + i * n;
+      scalar_t* values_data = rows_values.data_ptr<scalar_t>() + i * k;
+      int64_t* indices_data = rows_indices.data_ptr<int64_t>() + i * k;
+      // we want NaN to be sorted as top for numpy compatibility
+      if (largest) {
+        parallel_topk_slice(self_data, n, k, sorted, values_data, indices_data,
+                            ValueCompDesc<scalar_t>());
+      } else {
+        parallel_topk_slice(self_data, n, k, sorted, values_data, indices_data,
+                            ValueCompAsc<scalar_t>());
+      }
+    }
+  });
+  auto values_view = values.transpose(dim, -1);
+  auto indices_view = indices.transpose(dim, -1);
+  values_view.copy_(rows_values.view(values_view.sizes()));
+  indices_view.copy_(rows_indices.view(indices_view.sizes()));
+}
+
 static void topk_kernel(
     Tensor& values,
     Tensor& indices,
@@ -148,6 +543,14 @@ static void topk_kernel(
     int64_t dim,
     bool largest,
     bool sorted) {
+  if (self.dim() > 0 && k > 0) {
+    const int64_t n = self.size(dim);
+    if (use_parallel_slice_algorithm(self.numel() / n, n) &&
+        k * 4 * at::get_num_threads() <= n) {
+      parallel_topk(values, indices, self, k, dim, largest, sorted);
+      return;
+    }
+  }
   AT_DISPATCH_ALL_TYPES(self.scalar_type(), "topk_cpu", [&] {
     dim_apply(
         {self, values, indices},
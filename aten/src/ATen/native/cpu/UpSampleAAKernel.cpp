@@ -0,0 +1,303 @@
+#include <ATen/ATen.h>
+
+#include <ATen/Dispatch.h>
+#include <ATen/native/UpSample.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+namespace at {
+namespace native {
+namespace {
+
+// Antialiased resize, following the resampling of PIL's Image.resize.
+//
+// Every output pixel is a weighted sum of the input pixels covered by a filter
+// centered on it. When downsampling, the filter is stretched by the scale so
+// that every input pixel contributes to the output, which is what removes the
+// aliasing of plain bilinear and bicubic interpolation. Filter taps falling
+// outside of the image are dropped and the remaining weights renormalized.
+//
+// The filter is separable, so the resize is a horizontal pass followed by a
+// vertical pass. The weights of a pass only depend on the output index, so they
+// are computed once per pass rather than once per pixel.
+
+// uint8 images are accumulated in float, and rounded and clamped on output
+template <typename scalar_t>
+using aa_opmath_t = typename std::conditional<
+    std::is_same<scalar_t, double>::value, double, float>::type;
+
+template <typename scalar_t>
+static inline scalar_t aa_filter_bilinear(scalar_t x) {
+  x = std::abs(x);
+  return x < 1 ? 1 - x : scalar_t(0);
+}
+
+template <typename scalar_t>
+static inline scalar_t aa_filter_bicubic(scalar_t x) {
+  // PIL uses a = -0.5, where upsample_bicubic2d uses -0.75
+  const scalar_t a = -0.5;
+  x = std::abs(x);
+  if (x < 1) {
+    return cubic_convolution1<scalar_t>(x, a);
+  }
+  if (x < 2) {
+    return cubic_convolution2<scalar_t>(x, a);
+  }
+  return 0;
+}
+
+template <typename opmath_t>
+struct AAWeights {
+  // output index i reads input indices [start[i], start[i] + size[i])
+  std::vector<int64_t> start;
+  std::vector<int64_t> size;
+  // max_size weights per output index, zero padded
+  std::vector<opmath_t> weights;
+  int64_t max_size;
+  bool identity;
+};
+
+template <typename opmath_t, typename filter_t>
+AAWeights<opmath_t> compute_aa_weights(
+    int64_t input_size,
+    int64_t output_size,
+    bool align_corners,
+    c10::optional<double> opt_scale,
+    int64_t interp_size,
+    filter_t filter) {
+  // area_pixel_compute_scale is 0 for a single output pixel, which would not
+  // average over the whole input
+  const opmath_t scale = align_corners
+      ? area_pixel_compute_scale<opmath_t>(input_size, output_size, align_corners, opt_scale)
+      : compute_scales_value<opmath_t>(opt_scale, input_size, output_size);
+  const opmath_t support =
+      (interp_size / 2) * (scale >= 1 ? scale : opmath_t(1));
+  const opmath_t invscale = scale >= 1 ? 1 / scale : opmath_t(1);
+
+  AAWeights<opmath_t> w;
+  w.max_size = static_cast<int64_t>(std::ceil(support)) * 2 + 1;
+  w.identity = input_size == output_size && scale == 1;
+  w.start.resize(output_size);
+  w.size.resize(output_size);
+  w.weights.assign(output_size * w.max_size, 0);
+
+  for (int64_t i = 0; i < output_size; i++) {
+    // see Note [area_pixel_compute_scale], pixel centers are at idx + 0.5
+    const opmath_t center = align_corners
+        ? scale * i + opmath_t(0.5)
+        : scale * (i + opmath_t(0.5));
+    const int64_t xmin = std::max(
+        static_cast<int64_t>(center - support + opmath_t(0.5)), int64_t(0));
+    const int64_t xmax = std::min(
+        static_cast<int64_t>(center + support + opmath_t(0.5)), input_size);
+    const int64_t xsize = std::max(xmax - xmin, int64_t(0));
+
+    opmath_t* wi = w.weights.data() + i * w.max_size;
+    opmath_t total = 0;
+    for (int64_t j = 0; j < xsize; j++) {
+      wi[j] = filter((j + xmin - center + opmath_t(0.5)) * invscale);
+      total += wi[j];
+    }
+    if (total != 0) {
+      for (int64_t j = 0; j < xsize; j++) {
+        wi[j] /= total;
+      }
+    }
+    w.start[i] = xmin;
+    w.size[i] = xsize;
+  }
+  return w;
+}
+
+template <typename dst_t, typename opmath_t>
+static inline dst_t aa_cast(opmath_t value) {
+  return static_cast<dst_t>(value);
+}
+
+template <>
+inline uint8_t aa_cast<uint8_t, float>(float value) {
+  return static_cast<uint8_t>(
+      std::min(std::max(std::nearbyint(value), 0.f), 255.f));
+}
+
+// acc[j] = sum_k w[k] * src[k * inner + j]
+template <typename src_t, typename opmath_t>
+static inline void aa_weighted_sum(
+    opmath_t* acc,
+    const src_t* src,
+    const opmath_t* w,
+    int64_t size,
+    int64_t inner) {
+  std::fill(acc, acc + inner, opmath_t(0));
+  for (int64_t k = 0; k < size; k++) {
+    const opmath_t wk = w[k];
+    const src_t* src_k = src + k * inner;
+    for (int64_t j = 0; j < inner; j++) {
+      acc[j] += wk * static_cast<opmath_t>(src_k[j]);
+    }
+  }
+}
+
+// Same, for a source that is already in opmath_t: keep one vector of
+// accumulators in registers for all the taps.
+template <typename scalar_t>
+static inline void aa_weighted_sum(
+    scalar_t* acc,
+    const scalar_t* src,
+    const scalar_t* w,
+    int64_t size,
+    int64_t inner) {
+  using Vec = vec256::Vec256<scalar_t>;
+  int64_t j = 0;
+  for (; j < inner - (inner % Vec::size()); j += Vec::size()) {
+    Vec sum(scalar_t(0));
+    for (int64_t k = 0; k < size; k++) {
+      sum = vec256::fmadd(Vec(w[k]), Vec::loadu(src + k * inner + j), sum);
+    }
+    sum.store(acc + j);
+  }
+  for (; j < inner; j++) {
+    scalar_t sum = 0;
+    for (int64_t k = 0; k < size; k++) {
+      sum += w[k] * src[k * inner + j];
+    }
+    acc[j] = sum;
+  }
+}
+
+// Resamples the middle dimension of a contiguous (outer, input_size, inner)
+// buffer into a contiguous (outer, output_size, inner) one. inner is 1 for the
+// horizontal pass over NCHW images, and the row (or pixel) length otherwise.
+template <typename src_t, typename dst_t, typename opmath_t>
+void aa_resample_pass(
+    dst_t* dst,
+    const src_t* src,
+    int64_t outer,
+    int64_t input_size,
+    int64_t inner,
+    const AAWeights<opmath_t>& w) {
+  const int64_t output_size = w.start.size();
+  const int64_t grain_size =
+      std::max(at::internal::GRAIN_SIZE / (inner * w.max_size), int64_t(1));
+  at::parallel_for(0, outer * output_size, grain_size, [&](int64_t begin, int64_t end) {
+    std::vector<opmath_t> acc(inner > 1 ? inner : 0);
+    for (int64_t idx = begin; idx < end; idx++) {
+      const int64_t o = idx / output_size;
+      const int64_t i = idx % output_size;
+      const src_t* src_ptr = src + (o * input_size + w.start[i]) * inner;
+      const opmath_t* wi = w.weights.data() + i * w.max_size;
+      const int64_t size = w.size[i];
+      dst_t* dst_ptr = dst + idx * inner;
+      if (inner == 1) {
+        opmath_t sum = 0;
+        for (int64_t k = 0; k < size; k++) {
+          sum += wi[k] * static_cast<opmath_t>(src_ptr[k]);
+        }
+        *dst_ptr = aa_cast<dst_t>(sum);
+      } else {
+        aa_weighted_sum(acc.data(), src_ptr, wi, size, inner);
+        for (int64_t j = 0; j < inner; j++) {
+          dst_ptr[j] = aa_cast<dst_t>(acc[j]);
+        }
+      }
+    }
+  });
+}
+
+template <typename scalar_t, typename filter_t>
+void cpu_upsample_aa(
+    const Tensor& output_,
+    const Tensor& input_,
+    bool align_corners,
+    c10::optional<double> scales_h,
+    c10::optional<double> scales_w,
+    int64_t interp_size,
+    filter_t filter) {
+  TORCH_CHECK(input_.dtype() == output_.dtype(), "expected dtype ", input_.dtype(),
+              " for `output` but got dtype ", output_.dtype());
+  using opmath_t = aa_opmath_t<scalar_t>;
+
+  const bool channels_last = input_.is_contiguous(at::MemoryFormat::ChannelsLast);
+  const auto memory_format =
+      channels_last ? at::MemoryFormat::ChannelsLast : at::MemoryFormat::Contiguous;
+  auto input = input_.contiguous(memory_format);
+  auto output = output_.contiguous(memory_format);
+
+  int64_t nbatch = input.size(0);
+  int64_t channels = input.size(1);
+  int64_t input_height = input.size(2);
+  int64_t input_width = input.size(3);
+  int64_t output_height = output.size(2);
+  int64_t output_width = output.size(3);
+
+  auto weights_w = compute_aa_weights<opmath_t>(
+      input_width, output_width, align_corners, scales_w, interp_size, filter);
+  auto weights_h = compute_aa_weights<opmath_t>(
+      input_height, output_height, align_corners, scales_h, interp_size, filter);
+
+  // NCHW images are N * C planes of H x W pixels, channels last images are
+  // N planes of H x W pixels of C values each
+  const int64_t planes = channels_last ? nbatch : nbatch * channels;
+  const int64_t pixel_size = channels_last ? channels : 1;
+
+  const scalar_t* input_data = input.data_ptr<scalar_t>();
+  scalar_t* output_data = output.data_ptr<scalar_t>();
+  if (!weights_w.identity && !weights_h.identity) {
+    std::vector<opmath_t> buffer(planes * input_height * output_width * pixel_size);
+    aa_resample_pass(
+        buffer.data(), input_data, planes * input_height, input_width, pixel_size, weights_w);
+    aa_resample_pass(
+        output_data, buffer.data(), planes, input_height, output_width * pixel_size, weights_h);
+  } else if (!weights_w.identity) {
+    aa_resample_pass(
+        output_data, input_data, planes * input_height, input_width, pixel_size, weights_w);
+  } else if (!weights_h.identity) {
+    aa_resample_pass(
+        output_data, input_data, planes, input_height, input_width * pixel_size, weights_h);
+  } else {
+    output.copy_(input);
+  }
+
+  if (!output_.is_contiguous(memory_format)) {
+    output_.copy_(output);
+  }
+}
+
+void _upsample_bilinear2d_aa_kernel_impl(
+    const Tensor& output,
+    const Tensor& input,
+    bool align_corners,
+    c10::optional<double> scales_h,
+    c10::optional<double> scales_w) {
+  AT_DISPATCH_FLOATING_TYPES_AND(at::ScalarType::Byte, input.scalar_type(), "upsample_bilinear2d_aa", [&] {
+    cpu_upsample_aa<scalar_t>(
+        output, input, align_corners, scales_h, scales_w,
+        /*interp_size=*/2, aa_filter_bilinear<aa_opmath_t<scalar_t>>);
+  });
+}
+
+void _upsample_bicubic2d_aa_kernel_impl(
+    const Tensor& output,
+    const Tensor& input,
+    bool align_corners,
+    c10::optional<double> scales_h,
+    c10::optional<double> scales_w) {
+  AT_DISPATCH_FLOATING_TYPES_AND(at::ScalarType::Byte, input.scalar_type(), "upsample_bicubic2d_aa", [&] {
+    cpu_upsample_aa<scalar_t>(
+        output, input, align_corners, scales_h, scales_w,
+        /*interp_size=*/4, aa_filter_bicubic<aa_opmath_t<scalar_t>>);
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(_upsample_bilinear2d_aa_kernel, &_upsample_bilinear2d_aa_kernel_impl);
+REGISTER_DISPATCH(_upsample_bicubic2d_aa_kernel, &_upsample_bicubic2d_aa_kernel_impl);
+
+} // namespace native
+} // namespace at
@@ -3,6 +3,9 @@
 #include <ATen/ATen.h>
 #include <ATen/CPUApplyUtils.h>
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/functional.h>
+#include <ATen/cpu/vec256/vec256.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/cpu/Loops.h>
 
@@ -13,7 +16,7 @@ using namespace vec256;
 
 template<typename scalar_t>
 void batch_norm_cpu_inference_collect_linear_and_constant_terms(
-    TensorAccessor<scalar_t, 1> alpha, TensorAccessor<scalar_t, 1> beta, int64_t n_channel,
+    scalar_t* alpha, scalar_t* beta, int64_t n_channel,
     const Tensor& weight /* optional */, const Tensor& bias /* optional */,
     const Tensor& mean, const Tensor& variance, double eps) {
 
@@ -42,8 +45,16 @@ void batch_norm_cpu_inference_collect_linear_and_constant_terms(
   }
 }
 
+// output = input * alpha + beta, followed by a relu when it is fused
+template <bool fuse_relu, typename scalar_t>
+inline Vec256<scalar_t> batch_norm_apply(
+    const Vec256<scalar_t>& data_vec, const Vec256<scalar_t>& alpha_vec, const Vec256<scalar_t>& beta_vec) {
+  Vec256<scalar_t> output_vec = data_vec * alpha_vec + beta_vec;
+  return fuse_relu ? maximum(output_vec, Vec256<scalar_t>(0)) : output_vec;
+}
+
 /// A fast path for CPU inference when all tensors are contiguous.
-template<typename scalar_t>
+template<typename scalar_t, bool fuse_relu>
 void batch_norm_cpu_inference_contiguous_impl(Tensor& output,
     const Tensor& input, const Tensor& weight, const Tensor& bias,
     const Tensor& mean, const Tensor& variance, double eps) {
@@ -55,8 +66,8 @@ void batch_norm_cpu_inference_contiguous_impl(Tensor& output,
 
   Tensor alpha = at::empty_like(mean, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
   Tensor beta = at::empty_like(mean, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
-  auto alpha_data = alpha.accessor<scalar_t, 1>();
-  auto beta_data = beta.accessor<scalar_t, 1>();
+  scalar_t* alpha_data = alpha.data_ptr<scalar_t>();
+  scalar_t* beta_data = beta.data_ptr<scalar_t>();
 
   batch_norm_cpu_inference_collect_linear_and_constant_terms<scalar_t>(
      alpha_data, beta_data, n_channel, weight, bias, mean, variance, eps);
@@ -79,36 +90,317 @@ void batch_norm_cpu_inference_contiguous_impl(Tensor& output,
         int64_t d = 0;
         for (; d < loop_size; d += Vec::size()) {
           Vec data_vec = Vec::loadu(input_data + offset + d);
-          Vec output_vec = data_vec * alpha_vec + beta_vec;
+          Vec output_vec = batch_norm_apply<fuse_relu>(data_vec, alpha_vec, beta_vec);
           output_vec.store(output_data + offset + d);
         }
         if (image_size - d > 0) {
           Vec data_vec = Vec::loadu(input_data + offset + d, image_size - d);
-          Vec output_vec = data_vec * alpha_vec + beta_vec;
+          Vec output_vec = batch_norm_apply<fuse_relu>(data_vec, alpha_vec, beta_vec);
           output_vec.store(output_data + offset + d, image_size - d);
         }
       }
     }
   } else {
-    // image_size == 1
+    // image_size == 1, which is channels last too
     for (int64_t n = 0; n < n_batch; ++n) {
-      for (int64_t c = 0; c < n_channel; ++c) {
-        int64_t offset = n * n_channel + c;
-        output_data[offset] = input_data[offset] * alpha_data[c] + beta_data[c];
+      int64_t offset = n * n_channel;
+      map3<scalar_t>(
+          [](Vec data_vec, Vec alpha_vec, Vec beta_vec) {
+            return batch_norm_apply<fuse_relu>(data_vec, alpha_vec, beta_vec);
+          },
+          output_data + offset, input_data + offset, alpha_data, beta_data, n_channel);
+    }
+  }
+}
+
+// output = input * alpha + beta for channels last tensors, which are
+// (N, HxW, C): alpha and beta are loaded as vectors along C
+template<typename scalar_t, bool fuse_relu>
+void batch_norm_cpu_channels_last_apply(Tensor& output, const Tensor& input,
+    const scalar_t* alpha_data, const scalar_t* beta_data) {
+  using Vec = Vec256<scalar_t>;
+  int64_t n_channel = input.size(1);
+  int64_t loop_size = input.numel() / n_channel;
+
+  scalar_t* output_data = output.data_ptr<scalar_t>();
+  const scalar_t* input_data = input.data_ptr<scalar_t>();
+
+  const int64_t grain_size = std::max<int64_t>(internal::GRAIN_SIZE / n_channel, 1);
+  at::parallel_for(0, loop_size, grain_size, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      int64_t offset = i * n_channel;
+      map3<scalar_t>(
+          [](Vec data_vec, Vec alpha_vec, Vec beta_vec) {
+            return batch_norm_apply<fuse_relu>(data_vec, alpha_vec, beta_vec);
+          },
+          output_data + offset, input_data + offset, alpha_data, beta_data, n_channel);
+    }
+  });
+}
+
+/// A fast path for CPU inference when the input is channels last contiguous.
+template<typename scalar_t, bool fuse_relu>
+void batch_norm_cpu_inference_channels_last_impl(Tensor& output,
+    const Tensor& input, const Tensor& weight, const Tensor& bias,
+    const Tensor& mean, const Tensor& variance, double eps) {
+
+  int64_t n_channel = input.size(1);
+  Tensor alpha = at::empty_like(mean, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  Tensor beta = at::empty_like(mean, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  scalar_t* alpha_data = alpha.data_ptr<scalar_t>();
+  scalar_t* beta_data = beta.data_ptr<scalar_t>();
+
+  batch_norm_cpu_inference_collect_linear_and_constant_terms<scalar_t>(
+     alpha_data, beta_data, n_channel, weight, bias, mean, variance, eps);
+
+  batch_norm_cpu_channels_last_apply<scalar_t, fuse_relu>(output, input, alpha_data, beta_data);
+}
+
+/// Training mode output of channels last input, from the saved statistics.
+template<typename scalar_t>
+void batch_norm_cpu_transform_channels_last_impl(Tensor& output,
+    const Tensor& input, const Tensor& weight, const Tensor& bias,
+    const Tensor& save_mean, const Tensor& save_invstd) {
+
+  int64_t n_channel = input.size(1);
+  const scalar_t* weight_data = weight.defined() ? weight.data_ptr<scalar_t>() : nullptr;
+  const scalar_t* bias_data = bias.defined() ? bias.data_ptr<scalar_t>() : nullptr;
+  const scalar_t* mean_data = save_mean.data_ptr<scalar_t>();
+  const scalar_t* invstd_data = save_invstd.data_ptr<scalar_t>();
+
+  Tensor alpha = at::empty({n_channel}, input.options());
+  Tensor beta = at::empty({n_channel}, input.options());
+  scalar_t* alpha_data = alpha.data_ptr<scalar_t>();
+  scalar_t* beta_data = beta.data_ptr<scalar_t>();
+  for (int64_t c = 0; c < n_channel; c++) {
+    scalar_t weight_v = weight_data ? weight_data[c] : 1;
+    scalar_t bias_v = bias_data ? bias_data[c] : 0;
+    alpha_data[c] = invstd_data[c] * weight_v;
+    beta_data[c] = bias_v - mean_data[c] * alpha_data[c];
+  }
+
+  batch_norm_cpu_channels_last_apply<scalar_t, false>(output, input, alpha_data, beta_data);
+}
+
+// Per channel sums over the rows of a channels last tensor, (N, HxW, C).
+// Each thread adds its rows into its own row of a {num_threads, C} buffer,
+// and the buffer is reduced along the threads afterwards.
+template <typename scalar_t, typename RowOp>
+void batch_norm_cpu_channels_last_reduce(
+    scalar_t* result, int64_t loop_size, int64_t n_channel,
+    const TensorOptions& options, const RowOp& row_op) {
+  using Vec = Vec256<scalar_t>;
+  int num_threads = at::get_num_threads();
+  Tensor buffer = at::zeros({num_threads, n_channel}, options);
+  scalar_t* buffer_data = buffer.data_ptr<scalar_t>();
+
+  const int64_t grain_size = std::max<int64_t>(internal::GRAIN_SIZE / n_channel, 1);
+  at::parallel_for(0, loop_size, grain_size, [&](int64_t begin, int64_t end) {
+    int tid = at::get_thread_num();
+    TORCH_CHECK(tid < num_threads,
+                "expect thread id smaller than ", num_threads, ", got thread id ", tid);
+    scalar_t* buffer_ptr = buffer_data + tid * n_channel;
+    for (int64_t i = begin; i < end; i++) {
+      row_op(buffer_ptr, i);
+    }
+  });
+
+  int64_t d = 0;
+  for (; d < n_channel - (n_channel % Vec::size()); d += Vec::size()) {
+    Vec sum_vec = Vec::loadu(buffer_data + d);
+    for (int64_t t = 1; t < num_threads; t++) {
+      sum_vec = sum_vec + Vec::loadu(buffer_data + t * n_channel + d);
+    }
+    sum_vec.store(result + d);
+  }
+  for (; d < n_channel; d++) {
+    scalar_t sum_val = buffer_data[d];
+    for (int64_t t = 1; t < num_threads; t++) {
+      sum_val += buffer_data[t * n_channel + d];
+    }
+    result[d] = sum_val;
+  }
+}
+
+template <typename scalar_t>
+void batch_norm_cpu_collect_stats_channels_last_impl(
+    Tensor& mean, Tensor& var_sum, const Tensor& input) {
+  using Vec = Vec256<scalar_t>;
+  int64_t n_channel = input.size(1);
+  int64_t loop_size = input.numel() / n_channel;
+  const scalar_t* input_data = input.data_ptr<scalar_t>();
+  scalar_t* mean_data = mean.data_ptr<scalar_t>();
+  scalar_t* var_sum_data = var_sum.data_ptr<scalar_t>();
+
+  // compute mean per input
+  batch_norm_cpu_channels_last_reduce<scalar_t>(
+      mean_data, loop_size, n_channel, input.options(), [&](scalar_t* buffer, int64_t i) {
+        map2<scalar_t>(
+            [](Vec sum_vec, Vec x_vec) { return sum_vec + x_vec; },
+            buffer, buffer, input_data + i * n_channel, n_channel);
+      });
+  for (int64_t c = 0; c < n_channel; c++) {
+    mean_data[c] /= loop_size;
+  }
+
+  // compute variance per input
+  batch_norm_cpu_channels_last_reduce<scalar_t>(
+      var_sum_data, loop_size, n_channel, input.options(), [&](scalar_t* buffer, int64_t i) {
+        map3<scalar_t>(
+            [](Vec sum_vec, Vec x_vec, Vec mean_vec) {
+              Vec diff_vec = x_vec - mean_vec;
+              return sum_vec + diff_vec * diff_vec;
+            },
+            buffer, buffer, input_data + i * n_channel, mean_data, n_channel);
+      });
+}
+
+template <typename scalar_t>
+void batch_norm_cpu_backward_channels_last_impl(
+    Tensor& grad_input, Tensor& grad_weight, Tensor& grad_bias,
+    const Tensor& grad_output, const Tensor& input, const Tensor& weight,
+    const Tensor& mean, const Tensor& invstd, bool train) {
+  using Vec = Vec256<scalar_t>;
+  int64_t n_channel = input.size(1);
+  int64_t loop_size = input.numel() / n_channel;
+  const scalar_t* input_data = input.data_ptr<scalar_t>();
+  const scalar_t* grad_output_data = grad_output.data_ptr<scalar_t>();
+  const scalar_t* weight_data = weight.defined() ? weight.data_ptr<scalar_t>() : nullptr;
+  const scalar_t* mean_data = mean.data_ptr<scalar_t>();
+  const scalar_t* invstd_data = invstd.data_ptr<scalar_t>();
+
+  // sum over all gradOutput in feature plane, and dot product of the Q(X)
+  // and gradOuput
+  Tensor sum = at::empty({n_channel}, input.options());
+  Tensor dotp = at::empty({n_channel}, input.options());
+  scalar_t* sum_data = sum.data_ptr<scalar_t>();
+  scalar_t* dotp_data = dotp.data_ptr<scalar_t>();
+  batch_norm_cpu_channels_last_reduce<scalar_t>(
+      sum_data, loop_size, n_channel, input.options(), [&](scalar_t* buffer, int64_t i) {
+        map2<scalar_t>(
+            [](Vec sum_vec, Vec dy_vec) { return sum_vec + dy_vec; },
+            buffer, buffer, grad_output_data + i * n_channel, n_channel);
+      });
+  batch_norm_cpu_channels_last_reduce<scalar_t>(
+      dotp_data, loop_size, n_channel, input.options(), [&](scalar_t* buffer, int64_t i) {
+        int64_t offset = i * n_channel;
+        for (int64_t d = 0; d < n_channel; d += Vec::size()) {
+          int64_t count = std::min<int64_t>(Vec::size(), n_channel - d);
+          Vec x_vec = Vec::loadu(input_data + offset + d, count);
+          Vec dy_vec = Vec::loadu(grad_output_data + offset + d, count);
+          Vec dotp_vec = Vec::loadu(buffer + d, count) + (x_vec - Vec::loadu(mean_data + d, count)) * dy_vec;
+          dotp_vec.store(buffer + d, count);
+        }
+      });
+
+  if (grad_input.defined()) {
+    // Per channel terms of
+    //   train: dL/dX = (dL/dY - grad_mean - (X - mean) * k) * invstd * w
+    //   eval:  dL/dX = dL/dY * invstd * w
+    Tensor k = at::zeros({n_channel}, input.options());
+    Tensor grad_mean = at::zeros({n_channel}, input.options());
+    Tensor w_invstd = at::empty({n_channel}, input.options());
+    scalar_t* k_data = k.data_ptr<scalar_t>();
+    scalar_t* grad_mean_data = grad_mean.data_ptr<scalar_t>();
+    scalar_t* w_invstd_data = w_invstd.data_ptr<scalar_t>();
+    for (int64_t c = 0; c < n_channel; c++) {
+      scalar_t w = weight_data ? weight_data[c] : 1;
+      w_invstd_data[c] = invstd_data[c] * w;
+      if (train) {
+        k_data[c] = dotp_data[c] * invstd_data[c] * invstd_data[c] / loop_size;
+        grad_mean_data[c] = sum_data[c] / loop_size;
       }
     }
+
+    scalar_t* grad_input_data = grad_input.data_ptr<scalar_t>();
+    const int64_t grain_size = std::max<int64_t>(internal::GRAIN_SIZE / n_channel, 1);
+    at::parallel_for(0, loop_size, grain_size, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; i++) {
+        int64_t offset = i * n_channel;
+        if (train) {
+          for (int64_t d = 0; d < n_channel; d += Vec::size()) {
+            int64_t count = std::min<int64_t>(Vec::size(), n_channel - d);
+            Vec x_vec = Vec::loadu(input_data + offset + d, count);
+            Vec dy_vec = Vec::loadu(grad_output_data + offset + d, count);
+            Vec dx_vec = (dy_vec - Vec::loadu(grad_mean_data + d, count)
+                - (x_vec - Vec::loadu(mean_data + d, count)) * Vec::loadu(k_data + d, count))
+                * Vec::loadu(w_invstd_data + d, count);
+            dx_vec.store(grad_input_data + offset + d, count);
+          }
+        } else {
+          map2<scalar_t>(
+              [](Vec dy_vec, Vec w_invstd_vec) { return dy_vec * w_invstd_vec; },
+              grad_input_data + offset, grad_output_data + offset, w_invstd_data, n_channel);
+        }
+      }
+    });
+  }
+
+  if (grad_weight.defined()) {
+    scalar_t* grad_weight_data = grad_weight.data_ptr<scalar_t>();
+    for (int64_t c = 0; c < n_channel; c++) {
+      grad_weight_data[c] = dotp_data[c] * invstd_data[c];
+    }
+  }
+  if (grad_bias.defined()) {
+    grad_bias.copy_(sum);
   }
 }
 
 void batch_norm_cpu_inference_contiguous_kernel(Tensor& output, const Tensor& input,
-    const Tensor& weight, const Tensor& bias, const Tensor& mean, const Tensor& variance, double eps) {
+    const Tensor& weight, const Tensor& bias, const Tensor& mean, const Tensor& variance, double eps,
+    bool fuse_relu) {
   AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "batch_norm_cpu_inference_contiguous", [&] {
-    batch_norm_cpu_inference_contiguous_impl<scalar_t>(output, input, weight, bias, mean, variance, eps);
+    if (fuse_relu) {
+      batch_norm_cpu_inference_contiguous_impl<scalar_t, true>(output, input, weight, bias, mean, variance, eps);
+    } else {
+      batch_norm_cpu_inference_contiguous_impl<scalar_t, false>(output, input, weight, bias, mean, variance, eps);
+    }
+  });
+}
+
+void batch_norm_cpu_inference_channels_last_kernel(Tensor& output, const Tensor& input,
+    const Tensor& weight, const Tensor& bias, const Tensor& mean, const Tensor& variance, double eps,
+    bool fuse_relu) {
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "batch_norm_cpu_inference_channels_last", [&] {
+    if (fuse_relu) {
+      batch_norm_cpu_inference_channels_last_impl<scalar_t, true>(output, input, weight, bias, mean, variance, eps);
+    } else {
+      batch_norm_cpu_inference_channels_last_impl<scalar_t, false>(output, input, weight, bias, mean, variance, eps);
+    }
+  });
+}
+
+void batch_norm_cpu_transform_channels_last_kernel(Tensor& output, const Tensor& input,
+    const Tensor& weight, const Tensor& bias, const Tensor& save_mean, const Tensor& save_invstd) {
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "batch_norm_cpu_transform_channels_last", [&] {
+    batch_norm_cpu_transform_channels_last_impl<scalar_t>(output, input, weight, bias, save_mean, save_invstd);
+  });
+}
+
+void batch_norm_cpu_collect_stats_channels_last_kernel(
+    Tensor& mean, Tensor& var_sum, const Tensor& input) {
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "batch_norm_cpu_collect_stats_channels_last", [&] {
+    batch_norm_cpu_collect_stats_channels_last_impl<scalar_t>(mean, var_sum, input);
+  });
+}
+
+void batch_norm_cpu_backward_channels_last_kernel(
+    Tensor& grad_input, Tensor& grad_weight, Tensor& grad_bias,
+    const Tensor& grad_output, const Tensor& input, const Tensor& weight,
+    const Tensor& mean, const Tensor& invstd, bool train) {
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "batch_norm_cpu_backward_channels_last", [&] {
+    batch_norm_cpu_backward_channels_last_impl<scalar_t>(
+        grad_input, grad_weight, grad_bias, grad_output, input, weight, mean, invstd, train);
   });
 }
 
 }// anonymous namespace
 
 REGISTER_DISPATCH(batch_norm_cpu_inference_contiguous_stub, &batch_norm_cpu_inference_contiguous_kernel);
+REGISTER_DISPATCH(batch_norm_cpu_inference_channels_last_stub, &batch_norm_cpu_inference_channels_last_kernel);
+REGISTER_DISPATCH(batch_norm_cpu_transform_channels_last_stub, &batch_norm_cpu_transform_channels_last_kernel);
+REGISTER_DISPATCH(batch_norm_cpu_collect_stats_channels_last_stub, &batch_norm_cpu_collect_stats_channels_last_kernel);
+REGISTER_DISPATCH(batch_norm_cpu_backward_channels_last_stub, &batch_norm_cpu_backward_channels_last_kernel);
 
 }} // namespace at::native
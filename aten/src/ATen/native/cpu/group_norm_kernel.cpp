@@ -3,10 +3,12 @@
 #include <algorithm>
 #include <array>
 #include <numeric>
+#include <vector>
 
 #include <ATen/ATen.h>
 #include <ATen/CPUApplyUtils.h>
 #include <ATen/Dispatch.h>
+#include <ATen/cpu/vec256/functional.h>
 #include <ATen/cpu/vec256/vec256.h>
 
 namespace at {
@@ -85,6 +87,85 @@ void GroupNormKernelImplInternal(
   });
 }
 
+// X and Y are channels last, i.e. (N, HxW, C): the D channels of a group are
+// contiguous in every pixel, and the statistics of the group are accumulated
+// over them pixel by pixel.
+template <typename T>
+void GroupNormKernelImplChannelsLastInternal(
+    const Tensor& X,
+    const Tensor& gamma,
+    const Tensor& beta,
+    int64_t N,
+    int64_t C,
+    int64_t HxW,
+    int64_t group,
+    T eps,
+    Tensor& Y,
+    Tensor& mean,
+    Tensor& rstd) {
+  TORCH_CHECK(X.numel() == N * C * HxW);
+  TORCH_CHECK(!gamma.defined() || gamma.numel() == C);
+  TORCH_CHECK(!beta.defined() || beta.numel() == C);
+  using Vec = vec256::Vec256<T>;
+  const int64_t G = group;
+  const int64_t D = C / G;
+  const T* X_data = X.data_ptr<T>();
+  const T* gamma_data = gamma.defined() ? gamma.data_ptr<T>() : nullptr;
+  const T* beta_data = beta.defined() ? beta.data_ptr<T>() : nullptr;
+  T* Y_data = Y.data_ptr<T>();
+  T* mean_data = mean.data_ptr<T>();
+  T* rstd_data = rstd.data_ptr<T>();
+  const T s = T(1) / static_cast<T>(D * HxW);
+  const bool gamma_null = (gamma_data == nullptr);
+  const bool beta_null = beta_data == nullptr;
+
+  at::parallel_for(0, N * G, 1, [&](int64_t start, int64_t end) {
+    constexpr int64_t K = Vec::size();
+    std::array<T, K> mean_arr;
+    std::array<T, K> rstd_arr;
+    std::vector<T> scale(D);
+    std::vector<T> bias(D);
+    for (int64_t i = start; i < end; ++i) {
+      const int64_t n = i / G;
+      const int64_t g = i % G;
+      const T* X_ptr = X_data + n * HxW * C + g * D;
+      T* Y_ptr = Y_data + n * HxW * C + g * D;
+      Vec mean_vec(0);
+      Vec rstd_vec(0);
+      for (int64_t m = 0; m < HxW; ++m) {
+        for (int64_t j = 0; j < D; j += K) {
+          const Vec x_vec = Vec::loadu(X_ptr + m * C + j, std::min(K, D - j));
+          mean_vec = mean_vec + x_vec;
+          rstd_vec = rstd_vec + x_vec * x_vec;
+        }
+      }
+      mean_vec.store(mean_arr.data());
+      rstd_vec.store(rstd_arr.data());
+      T mean_val = std::accumulate(mean_arr.cbegin(), mean_arr.cend(), T(0));
+      T rstd_val = std::accumulate(rstd_arr.cbegin(), rstd_arr.cend(), T(0));
+      mean_val *= s;
+      rstd_val = std::max(rstd_val * s - mean_val * mean_val, T(0));
+      rstd_val = T(1) / std::sqrt(rstd_val + eps);
+
+      for (int64_t j = 0; j < D; ++j) {
+        const int64_t c = g * D + j;
+        scale[j] = rstd_val * (gamma_null ? T(1) : gamma_data[c]);
+        bias[j] = -scale[j] * mean_val + (beta_null ? T(0) : beta_data[c]);
+      }
+      for (int64_t m = 0; m < HxW; ++m) {
+        for (int64_t j = 0; j < D; j += K) {
+          const int64_t count = std::min(K, D - j);
+          const Vec x_vec = Vec::loadu(X_ptr + m * C + j, count);
+          const Vec y_vec = Vec::loadu(scale.data() + j, count) * x_vec + Vec::loadu(bias.data() + j, count);
+          y_vec.store(Y_ptr + m * C + j, count);
+        }
+      }
+      mean_data[i] = mean_val;
+      rstd_data[i] = rstd_val;
+    }
+  });
+}
+
 void GroupNormKernelImpl(
     const Tensor& X,
     const Tensor& gamma,
@@ -97,6 +178,24 @@ void GroupNormKernelImpl(
     Tensor& Y,
     Tensor& mean,
     Tensor& rstd) {
+  const auto memory_format = X.suggest_memory_format();
+  if (memory_format == at::MemoryFormat::ChannelsLast || memory_format == at::MemoryFormat::ChannelsLast3d) {
+    AT_DISPATCH_FLOATING_TYPES(X.scalar_type(), "GroupNormKernelImpl", [&]() {
+      GroupNormKernelImplChannelsLastInternal<scalar_t>(
+          X,
+          gamma,
+          beta,
+          N,
+          C,
+          HxW,
+          group,
+          static_cast<scalar_t>(eps),
+          Y,
+          mean,
+          rstd);
+    });
+    return;
+  }
   AT_DISPATCH_FLOATING_TYPES(X.scalar_type(), "GroupNormKernelImpl", [&]() {
     GroupNormKernelImplInternal<scalar_t>(
         X,
@@ -214,6 +313,118 @@ void GroupNormInputBackward(
   });
 }
 
+// ds and db of channels last inputs, (N, HxW, C). Every task sums the rows
+// of one batch for a block of channels, so that small batches still run in
+// parallel.
+template <typename T>
+void ComputeInternalGradientsChannelsLast(
+    int64_t N,
+    int64_t C,
+    int64_t HxW,
+    const T* dY,
+    const T* X,
+    T* ds,
+    T* db) {
+  using Vec = vec256::Vec256<T>;
+  constexpr int64_t kChannelBlock = 16 * Vec::size();
+  const int64_t num_blocks = (C + kChannelBlock - 1) / kChannelBlock;
+  at::parallel_for(0, N * num_blocks, 1, [=](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; ++i) {
+      const int64_t n = i / num_blocks;
+      const int64_t c0 = (i % num_blocks) * kChannelBlock;
+      const int64_t size = std::min(kChannelBlock, C - c0);
+      T* ds_ptr = ds + n * C + c0;
+      T* db_ptr = db + n * C + c0;
+      std::fill_n(ds_ptr, size, T(0));
+      std::fill_n(db_ptr, size, T(0));
+      for (int64_t m = 0; m < HxW; ++m) {
+        const T* dY_ptr = dY + (n * HxW + m) * C + c0;
+        const T* X_ptr = X + (n * HxW + m) * C + c0;
+        vec256::map3<T>(
+            [](Vec ds_vec, Vec dy_vec, Vec x_vec) { return ds_vec + dy_vec * x_vec; },
+            ds_ptr,
+            ds_ptr,
+            dY_ptr,
+            X_ptr,
+            size);
+        vec256::map2<T>(
+            [](Vec db_vec, Vec dy_vec) { return db_vec + dy_vec; },
+            db_ptr,
+            db_ptr,
+            dY_ptr,
+            size);
+      }
+    }
+  });
+}
+
+// dX of channels last inputs, (N, HxW, C). The coefficients of
+//   dX = c1 * dY + c2 * X + c3
+// are computed per (n, c) first, and then applied row by row.
+template <typename T>
+void GroupNormInputBackwardChannelsLast(
+    int64_t N,
+    int64_t C,
+    int64_t HxW,
+    int64_t group,
+    const T* dY,
+    const T* X,
+    const T* mean,
+    const T* rstd,
+    const T* gamma,
+    const T* ds,
+    const T* db,
+    T* dX) {
+  using Vec = vec256::Vec256<T>;
+  const int64_t G = group;
+  const int64_t D = C / G;
+  const T s = T(1) / static_cast<T>(D * HxW);
+  const bool gamma_null = (gamma == nullptr);
+  std::vector<T> coef(3 * N * C);
+  T* c1 = coef.data();
+  T* c2 = c1 + N * C;
+  T* c3 = c2 + N * C;
+  at::parallel_for(0, N * G, 1, [=](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; ++i) {
+      const int64_t g = i % G;
+      T ds_val = 0;
+      T db_val = 0;
+      for (int64_t j = 0; j < D; ++j) {
+        const T gamma_v = gamma_null ? T(1) : gamma[g * D + j];
+        ds_val += ds[i * D + j] * gamma_v;
+        db_val += db[i * D + j] * gamma_v;
+      }
+      const T c2_val =
+          (db_val * mean[i] - ds_val) * rstd[i] * rstd[i] * rstd[i] * s;
+      const T c3_val = -c2_val * mean[i] - db_val * rstd[i] * s;
+      for (int64_t j = 0; j < D; ++j) {
+        c1[i * D + j] = rstd[i] * (gamma_null ? T(1) : gamma[g * D + j]);
+        c2[i * D + j] = c2_val;
+        c3[i * D + j] = c3_val;
+      }
+    }
+  });
+  const int64_t grain_size =
+      std::max<int64_t>(at::internal::GRAIN_SIZE / C, 1);
+  at::parallel_for(0, N * HxW, grain_size, [=](int64_t start, int64_t end) {
+    constexpr int64_t K = Vec::size();
+    for (int64_t i = start; i < end; ++i) {
+      const int64_t n = i / HxW;
+      const T* dY_ptr = dY + i * C;
+      const T* X_ptr = X + i * C;
+      T* dX_ptr = dX + i * C;
+      for (int64_t j = 0; j < C; j += K) {
+        const int64_t count = std::min(K, C - j);
+        const Vec dx_vec =
+            Vec::loadu(c1 + n * C + j, count) * Vec::loadu(dY_ptr + j, count) +
+            Vec::loadu(c2 + n * C + j, count) * Vec::loadu(X_ptr + j, count) +
+            Vec::loadu(c3 + n * C + j, count);
+        dx_vec.store(dX_ptr + j, count);
+      }
+    }
+  });
+}
+
 template <typename T>
 void GammaBackward(
     int64_t N,
@@ -268,6 +479,7 @@ void GroupNormBackwardKernelImplInternal(
     int64_t C,
     int64_t HxW,
     int64_t group,
+    bool channels_last,
     Tensor& dX,
     Tensor& dgamma,
     Tensor& dbeta) {
@@ -290,9 +502,28 @@ void GroupNormBackwardKernelImplInternal(
   T* ds_data = ds.data_ptr<T>();
   T* db_data = db.data_ptr<T>();
 
-  ComputeInternalGradients<T>(N, C, HxW, dY_data, X_data, ds_data, db_data);
+  if (channels_last) {
+    ComputeInternalGradientsChannelsLast<T>(
+        N, C, HxW, dY_data, X_data, ds_data, db_data);
+  } else {
+    ComputeInternalGradients<T>(N, C, HxW, dY_data, X_data, ds_data, db_data);
+  }
 
-  if (dX_data != nullptr) {
+  if (dX_data != nullptr && channels_last) {
+    GroupNormInputBackwardChannelsLast<T>(
+        N,
+        C,
+        HxW,
+        group,
+        dY_data,
+        X_data,
+        mean_data,
+        rstd_data,
+        gamma_data,
+        ds_data,
+        db_data,
+        dX_data);
+  } else if (dX_data != nullptr) {
     GroupNormInputBackward<T>(
         N,
         C,
@@ -329,10 +560,26 @@ void GroupNormBackwardKernelImpl(
     Tensor& dX,
     Tensor& dgamma,
     Tensor& dbeta) {
+  // X and dY are both channels last, or both contiguous
+  const auto memory_format = X.suggest_memory_format();
+  const bool channels_last = memory_format == at::MemoryFormat::ChannelsLast ||
+      memory_format == at::MemoryFormat::ChannelsLast3d;
   AT_DISPATCH_FLOATING_TYPES(
       X.scalar_type(), "GroupNormBackwardKernelImpl", [&]() {
         GroupNormBackwardKernelImplInternal<scalar_t>(
-            dY, X, mean, rstd, gamma, N, C, HxW, group, dX, dgamma, dbeta);
+            dY,
+            X,
+            mean,
+            rstd,
+            gamma,
+            N,
+            C,
+            HxW,
+            group,
+            channels_last,
+            dX,
+            dgamma,
+            dbeta);
       });
 }
 
@@ -21,11 +21,13 @@ void LayerNormKernelImplInternal(
     const Tensor& beta,
     int64_t M,
     int64_t N,
-    T eps,
+    vec256::vec_scalar_t<T> eps,
     Tensor* Y,
     Tensor* mean,
     Tensor* rstd) {
-  using Vec = vec256::Vec256<T>;
+  // BFloat16 inputs are normalized in float, see Note [BFloat16 functional]
+  using T_ACC = vec256::vec_scalar_t<T>;
+  using Vec = vec256::Vec256<T_ACC>;
   DCHECK_EQ(X.numel(), M * N);
   DCHECK(!gamma.defined() || gamma.numel() == N);
   DCHECK(!beta.defined() || beta.numel() == N);
@@ -35,32 +37,32 @@ void LayerNormKernelImplInternal(
   T* Y_data = Y->data_ptr<T>();
   T* mean_data = mean->data_ptr<T>();
   T* rstd_data = rstd->data_ptr<T>();
-  const T c = T(1) / static_cast<T>(N);
+  const T_ACC c = T_ACC(1) / static_cast<T_ACC>(N);
   const bool gamma_null = gamma_data == nullptr;
   const bool beta_null = beta_data == nullptr;
   at::parallel_for(0, M, 1, [&](int64_t start, int64_t end) {
     for (int64_t i = start; i < end; ++i) {
       T* X_ptr = X_data + i * N;
       T* Y_ptr = Y_data + i * N;
-      T mean_val = vec256::reduce_all<T>(
+      T_ACC mean_val = vec256::reduce_all<T>(
           [](Vec& x, Vec& y) { return x + y; },
           X_ptr,
           N);
-      T rstd_val = vec256::map_reduce_all<T>(
+      T_ACC rstd_val = vec256::map_reduce_all<T>(
           [](Vec x) { return x * x; },
           [](Vec x, Vec y) { return x + y; },
           X_ptr,
           N);
       mean_val *= c;
-      rstd_val = std::max(rstd_val * c - mean_val * mean_val, T(0));
-      rstd_val = T(1) / std::sqrt(rstd_val + eps);
-      const T scale = rstd_val;
-      const T bias = -rstd_val * mean_val;
+      rstd_val = std::max(rstd_val * c - mean_val * mean_val, T_ACC(0));
+      rstd_val = T_ACC(1) / std::sqrt(rstd_val + eps);
+      const T_ACC scale = rstd_val;
+      const T_ACC bias = -rstd_val * mean_val;
       if (gamma_null || beta_null) {
         for (int64_t j = 0; j < N; ++j) {
-          const T gamma_v = gamma_null ? T(1) : gamma_data[j];
-          const T beta_v = beta_null ? T(0) : beta_data[j];
-          Y_ptr[j] = (X_ptr[j] * scale + bias) * gamma_v + beta_v;
+          const T_ACC gamma_v = gamma_null ? T_ACC(1) : T_ACC(gamma_data[j]);
+          const T_ACC beta_v = beta_null ? T_ACC(0) : T_ACC(beta_data[j]);
+          Y_ptr[j] = (T_ACC(X_ptr[j]) * scale + bias) * gamma_v + beta_v;
         }
       } else {
         vec256::map3<T>(
@@ -89,10 +91,12 @@ void LayerNormKernelImpl(
     Tensor* Y,
     Tensor* mean,
     Tensor* rstd) {
-  AT_DISPATCH_FLOATING_TYPES(X.scalar_type(), "LayerNormKernelImpl", [&]() {
-    LayerNormKernelImplInternal<scalar_t>(
-        X, gamma, beta, M, N, static_cast<scalar_t>(eps), Y, mean, rstd);
-  });
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      kBFloat16, X.scalar_type(), "LayerNormKernelImpl", [&]() {
+        using acc_t = vec256::vec_scalar_t<scalar_t>;
+        LayerNormKernelImplInternal<scalar_t>(
+            X, gamma, beta, M, N, static_cast<acc_t>(eps), Y, mean, rstd);
+      });
 }
 
 template <typename T>
@@ -107,7 +111,8 @@ void LayerNormBackwardKernelImplInternal(
     Tensor* dX,
     Tensor* dgamma,
     Tensor* dbeta) {
-  using Vec = vec256::Vec256<T>;
+  using T_ACC = vec256::vec_scalar_t<T>;
+  using Vec = vec256::Vec256<T_ACC>;
   DCHECK_EQ(dY.numel(), M * N);
   DCHECK_EQ(X.numel(), M * N);
   DCHECK_EQ(mean.numel(), M);
@@ -121,7 +126,7 @@ void LayerNormBackwardKernelImplInternal(
   T* dX_data = dX->defined() ? dX->template data_ptr<T>() : nullptr;
   T* dgamma_data = dgamma->defined() ? dgamma->template data_ptr<T>() : nullptr;
   T* dbeta_data = dbeta->defined() ? dbeta->template data_ptr<T>() : nullptr;
-  const T scale = T(1) / static_cast<T>(N);
+  const T_ACC scale = T_ACC(1) / static_cast<T_ACC>(N);
   const bool gamma_null = gamma_data == nullptr;
   const bool dX_null = dX_data == nullptr;
   const bool dgamma_null = dgamma_data == nullptr;
@@ -135,13 +140,17 @@ void LayerNormBackwardKernelImplInternal(
   //
   // 2. Fuse first path of dgamma/dbeta with dX to reuse X[i] and dY[i] in L1 cache.
   //
+  // 3. For BFloat16 the buffer is float, so the partial sums are not rounded
+  //    to BFloat16 after every row.
+  //
   int num_threads = at::get_num_threads();
-  Tensor buffer = at::empty({0}, X.options());
-  T* buffer_data = nullptr;
+  Tensor buffer = at::empty(
+      {0}, X.options().dtype(c10::CppTypeToScalarType<T_ACC>::value));
+  T_ACC* buffer_data = nullptr;
   if (!dgamma_null || !dbeta_null) {
     // zero the immediate buffer and skip zero dgamma and dbeta
     buffer.resize_({2, num_threads, N}).zero_();
-    buffer_data = buffer.template data_ptr<T>();
+    buffer_data = buffer.template data_ptr<T_ACC>();
   }
 
   // First path of dgamma/dbeta and dX
@@ -149,14 +158,14 @@ void LayerNormBackwardKernelImplInternal(
     int tid = at::get_thread_num();
     TORCH_CHECK(tid < num_threads,
                 "expect thread id smaller than ", num_threads, ", got thread id ", tid);
-    T* dgamma_buffer_ptr = dgamma_null ? nullptr : buffer_data + tid * N;
-    T* dbeta_buffer_ptr = dbeta_null ? nullptr : buffer_data + num_threads * N + tid * N;
+    T_ACC* dgamma_buffer_ptr = dgamma_null ? nullptr : buffer_data + tid * N;
+    T_ACC* dbeta_buffer_ptr = dbeta_null ? nullptr : buffer_data + num_threads * N + tid * N;
     for (int64_t i = start; i < end; ++i) {
       const T* dY_ptr = dY_data + i * N;
       const T* X_ptr = X_data + i * N;
       if (!dgamma_null) {
-        const T a = rstd_data[i];
-        const T b = -a * mean_data[i];
+        const T_ACC a = rstd_data[i];
+        const T_ACC b = -a * T_ACC(mean_data[i]);
         // Scalar math:
         // for (int64_t j = 0; j < N; ++j) {
         //   dgamma_data[j] += dY_ptr[j] * (a * X_ptr[j] + b);
@@ -183,8 +192,8 @@ void LayerNormBackwardKernelImplInternal(
       }
       if (!dX_null) {
         T* dX_ptr = dX_data + i * N;
-        T ds = T(0);
-        T db = T(0);
+        T_ACC ds = T_ACC(0);
+        T_ACC db = T_ACC(0);
         // Scalar math:
         // for (int64_t j = 0; j < N; ++j) {
         //   const T gamma_v = gamma_null ? T(1) : gamma_data[j];
@@ -217,9 +226,10 @@ void LayerNormBackwardKernelImplInternal(
               gamma_data,
               N);
         }
-        const T a = rstd_data[i];
-        const T b = (db * mean_data[i] - ds) * a * a * a * scale;
-        const T c = -b * mean_data[i] - db * a * scale;
+        const T_ACC a = rstd_data[i];
+        const T_ACC mean_val = mean_data[i];
+        const T_ACC b = (db * mean_val - ds) * a * a * a * scale;
+        const T_ACC c = -b * mean_val - db * a * scale;
         // Scalar math:
         // for (int64_t j = 0; j < N; ++j) {
         //   const T gamma_v = gamma_null ? T(1) : gamma_data[j];
@@ -249,8 +259,8 @@ void LayerNormBackwardKernelImplInternal(
   if (buffer_data != nullptr) {
     parallel_for(0, N, 1, [&](int64_t start, int64_t end) {
       for (int64_t j = start; j < end; ++j) {
-        T dgamma_v = T(0);
-        T dbeta_v = T(0);
+        T_ACC dgamma_v = T_ACC(0);
+        T_ACC dbeta_v = T_ACC(0);
         for (int64_t i = 0; i < num_threads; ++i) {
           dgamma_v += buffer_data[i * N + j];
           dbeta_v += buffer_data[num_threads * N + i * N + j];
@@ -277,8 +287,8 @@ void LayerNormBackwardKernelImpl(
     Tensor* dX,
     Tensor* dgamma,
     Tensor* dbeta) {
-  AT_DISPATCH_FLOATING_TYPES(
-      X.scalar_type(), "LayerNormBackwardKernelImpl", [&]() {
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      kBFloat16, X.scalar_type(), "LayerNormBackwardKernelImpl", [&]() {
         LayerNormBackwardKernelImplInternal<scalar_t>(
             dY, X, mean, rstd, gamma, M, N, dX, dgamma, dbeta);
       });
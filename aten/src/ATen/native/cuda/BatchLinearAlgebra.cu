@@ -2142,6 +2142,13 @@ AT_ERROR("symeig: MAGMA library not found in "
 }
 
 std::tuple<Tensor, Tensor> _symeig_helper_cuda(const Tensor& self, bool eigenvectors, bool upper) {
+#ifdef USE_CUSOLVER
+  // heuristic for using `syevjBatched` over the loop of `magmaSymeig` calls,
+  // which synchronizes with the host for every matrix
+  if (self.numel() > 0 && self.size(-1) <= 32 && batchCount(self) > 1) {
+    return _symeig_helper_cuda_lib(self, eigenvectors, upper);
+  }
+#endif
   std::vector<int64_t> infos(batchCount(self), 0);
 
   auto self_sizes = self.sizes().vec();
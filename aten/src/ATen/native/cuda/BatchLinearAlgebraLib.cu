@@ -297,6 +297,61 @@ std::tuple<Tensor, Tensor, Tensor> _svd_helper_cuda_lib(const Tensor& self, bool
   return std::make_tuple(U_working_copy, S_working_copy, VT_working_copy);
 }
 
+// call cusolver syevjBatched function to calculate the eigendecomposition of a batch of
+// symmetric (Hermitian) matrices, without synchronizing with the host
+template<typename scalar_t>
+inline static void _apply_symeig_lib_syevjBatched(Tensor& self, Tensor& eigvals, Tensor& infos, bool eigenvectors, bool upper) {
+  using value_t = typename c10::scalar_value_type<scalar_t>::type;
+  auto self_data = self.data_ptr<scalar_t>();
+  auto eigvals_data = eigvals.data_ptr<value_t>();
+
+  int batchsize = cuda_int_cast(batchCount(self), "batch size");
+  int n = cuda_int_cast(self.size(-1), "n");
+  int lda = std::max<int>(1, n);
+
+  TORCH_INTERNAL_ASSERT(n <= 32, "syevjBatched requires the matrix size not greater than 32, but got n = ", n);
+
+  // syevj_params controls the numerical accuracy of cusolver syevj iterations on GPU
+  syevjInfo_t syevj_params;
+  TORCH_CUSOLVER_CHECK(cusolverDnCreateSyevjInfo(&syevj_params));
+
+  auto handle = at::cuda::getCurrentCUDASolverDnHandle();
+  auto jobz = eigenvectors ? CUSOLVER_EIG_MODE_VECTOR : CUSOLVER_EIG_MODE_NOVECTOR;
+  auto uplo = upper ? CUBLAS_FILL_MODE_UPPER : CUBLAS_FILL_MODE_LOWER;
+  at::cuda::solver::syevjBatched<scalar_t>(
+    handle, jobz, uplo, n, self_data, lda, eigvals_data,
+    infos.data_ptr<int>(), syevj_params, batchsize
+  );
+
+  TORCH_CUSOLVER_CHECK(cusolverDnDestroySyevjInfo(syevj_params));
+}
+
+// entrance of calculations of `symeig` using cusolver syevjBatched
+std::tuple<Tensor, Tensor> _symeig_helper_cuda_lib(const Tensor& self, bool eigenvectors, bool upper) {
+  const int64_t batch_size = batchCount(self);
+  at::Tensor infos = at::zeros({batch_size}, self.options().dtype(at::kInt));
+
+  auto self_sizes = self.sizes().vec();
+  self_sizes.pop_back();
+  ScalarType dtype = toValueType(self.scalar_type());
+  // unlike magmaSymeig, the eigenvalues are computed directly on the device
+  Tensor eigvals_working_copy = at::empty(self_sizes, self.options().dtype(dtype));
+  Tensor self_working_copy = cloneBatchedColumnMajor(self);
+
+  AT_DISPATCH_FLOATING_AND_COMPLEX_TYPES(self.scalar_type(), "symeig_cuda_syevjBatched", [&] {
+    _apply_symeig_lib_syevjBatched<scalar_t>(self_working_copy, eigvals_working_copy, infos, eigenvectors, upper);
+  });
+
+  // A device-host sync will be performed.
+  batchCheckErrors(infos, "symeig_cuda");
+
+  if (eigenvectors) {
+    return std::make_tuple(eigvals_working_copy, self_working_copy);
+  } else {
+    return std::make_tuple(eigvals_working_copy, at::empty({0}, self.options()));
+  }
+}
+
 }} // namespace at::native
 
 #endif  // USE_CUSOLVER
@@ -24,6 +24,9 @@ Tensor& _linalg_inv_out_helper_cuda_lib(Tensor& result, Tensor& infos_getrf, Ten
 // entrance of calculations of `svd` using cusolver gesvdj and gesvdjBatched
 std::tuple<Tensor, Tensor, Tensor> _svd_helper_cuda_lib(const Tensor& self, bool some, bool compute_uv);
 
+// entrance of calculations of `symeig` using cusolver syevjBatched
+std::tuple<Tensor, Tensor> _symeig_helper_cuda_lib(const Tensor& self, bool eigenvectors, bool upper);
+
 }}  // namespace at::native
 
 #endif  // USE_CUSOLVER
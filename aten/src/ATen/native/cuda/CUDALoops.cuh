@@ -89,6 +89,23 @@ __global__ void unrolled_elementwise_kernel(int N, func_t f, array_t data,
   elementwise_kernel_helper(f, policy);
 }
 
+template<int vec_size, typename func_t, typename array_t, typename inp_calc_t, typename out_calc_t>
+C10_LAUNCH_BOUNDS_1(num_threads)
+__global__ void vectorized_inner_elementwise_kernel(int N, func_t f, array_t data, inp_calc_t ic, out_calc_t oc) {
+  int remaining = N - block_work_size * blockIdx.x;
+
+  if (remaining < block_work_size) {  // if this block handles the reminder, just do a naive unrolled loop
+    auto loader = memory::LoadWithoutCast();
+    auto storer = memory::StoreWithoutCast();
+    auto policy = memory::policies::unroll<array_t, inp_calc_t, out_calc_t,
+                                           memory::LoadWithoutCast, memory::StoreWithoutCast>(
+      data, remaining, ic, oc, loader, storer);
+    elementwise_kernel_helper(f, policy);
+  } else {  // vectorized memory access along the innermost dimension
+    elementwise_kernel_helper(f, memory::policies::vectorized_inner<vec_size, array_t, inp_calc_t, out_calc_t>(data, ic, oc));
+  }
+}
+
 // this function assume trivial 1d and no dynamic casting
 template<typename func_t, typename array_t>
 static inline void launch_vectorized_kernel(int64_t N, const func_t& f, array_t data) {
@@ -121,6 +138,55 @@ static inline void launch_vectorized_kernel(int64_t N, const func_t& f, array_t
   }
 }
 
+// Returns the size of the vectors that can be loaded and stored along the
+// innermost dimension of a non-contiguous iterator without dynamic casting.
+// This is the case of sliced or broadcasted tensors whose innermost dimension
+// is contiguous, e.g. x[:, :64] or x + bias.
+template<typename func_t, typename array_t>
+static inline int can_vectorize_inner_up_to(const TensorIteratorBase& iter, array_t data) {
+  if (iter.ndim() < 2) {
+    return 1;
+  }
+  int vec_size = memory::can_vectorize_up_to<func_t>(data);
+  for (; vec_size > 1; vec_size /= 2) {
+    bool can_vectorize = iter.shape()[0] % vec_size == 0;
+    for (int arg = 0; arg < iter.ntensors() && can_vectorize; arg++) {
+      auto strides = iter.strides(arg);
+      int64_t element_size = iter.element_size(arg);
+      can_vectorize = strides[0] == element_size;
+      for (int dim = 1; dim < iter.ndim() && can_vectorize; dim++) {
+        can_vectorize = strides[dim] % (element_size * vec_size) == 0;
+      }
+    }
+    if (can_vectorize) {
+      break;
+    }
+  }
+  return vec_size;
+}
+
+template<typename func_t, typename array_t, typename inp_calc_t, typename out_calc_t>
+static inline void launch_vectorized_inner_kernel(int64_t N, int vec_size, const func_t& f, array_t data,
+                                                  inp_calc_t ic, out_calc_t oc)
+{
+  TORCH_INTERNAL_ASSERT(N > 0 && N <= std::numeric_limits<int32_t>::max());
+  int64_t grid = (N + block_work_size - 1) / block_work_size;
+  auto stream = at::cuda::getCurrentCUDAStream();
+
+  switch (vec_size) {
+  case 4:
+    vectorized_inner_elementwise_kernel<4, func_t, array_t><<<grid, num_threads, 0, stream>>>(N, f, data, ic, oc);
+    C10_CUDA_KERNEL_LAUNCH_CHECK();
+    break;
+  case 2:
+    vectorized_inner_elementwise_kernel<2, func_t, array_t><<<grid, num_threads, 0, stream>>>(N, f, data, ic, oc);
+    C10_CUDA_KERNEL_LAUNCH_CHECK();
+    break;
+  default:
+    TORCH_INTERNAL_ASSERT(false, "Unexpected vectorization size");
+  }
+}
+
 template<typename func_t, typename array_t, typename inp_calc_t, typename out_calc_t, typename loader_t, typename storer_t>
 static inline void launch_unrolled_kernel(int64_t N, const func_t& f, array_t data,
                                           inp_calc_t ic, out_calc_t oc, loader_t l, storer_t s)
@@ -158,9 +224,14 @@ void gpu_kernel_impl(TensorIteratorBase& iter, const func_t& f) {
     } else {
       auto input_offset_calculator = make_input_offset_calculator<traits::arity>(iter);
       auto output_offset_calculator = make_output_offset_calculator(iter);
-      auto loader = memory::LoadWithoutCast();
-      auto storer = memory::StoreWithoutCast();
-      launch_unrolled_kernel(numel, f, data, input_offset_calculator, output_offset_calculator, loader, storer);
+      int vec_size = can_vectorize_inner_up_to<func_t>(iter, data);
+      if (vec_size > 1) {
+        launch_vectorized_inner_kernel(numel, vec_size, f, data, input_offset_calculator, output_offset_calculator);
+      } else {
+        auto loader = memory::LoadWithoutCast();
+        auto storer = memory::StoreWithoutCast();
+        launch_unrolled_kernel(numel, f, data, input_offset_calculator, output_offset_calculator, loader, storer);
+      }
     }
   } else {
     at::detail::Array<ScalarType, traits::arity> dtypes;
@@ -192,6 +192,62 @@ void masked_scale_kernel(at::Tensor& ret, const at::Tensor src, const at::Tensor
        });
 }
 
+// Each iteration fills one byte of the packed mask from the 8 uniforms of
+// subsequence `byte`, so the mask doesn't depend on the launch configuration
+template <typename scalar_t, typename accscalar_t>
+#if __CUDA_ARCH__ >= 350
+C10_LAUNCH_BOUNDS_2(256, 4)
+#elif defined (__HIP_PLATFORM_HCC__)
+C10_LAUNCH_BOUNDS_2(256, 4)
+#endif
+__global__ void
+fused_dropout_packed_kernel(const scalar_t* a, scalar_t* b, uint8_t* c,
+                            int64_t totalElements, accscalar_t p,
+                            PhiloxCudaState philox_args) {
+  auto seeds = at::cuda::philox::unpack(philox_args);
+  accscalar_t pinv = accscalar_t(1)/p;
+  const int64_t nbytes = (totalElements + 7) / 8;
+  for (int64_t byte = blockIdx.x * blockDim.x + threadIdx.x;
+       byte < nbytes;
+       byte += gridDim.x * blockDim.x) {
+    curandStatePhilox4_32_10_t state;
+    curand_init(std::get<0>(seeds), byte, std::get<1>(seeds), &state);
+    float4 rand4[2];
+    rand4[0] = curand_uniform4(&state);
+    rand4[1] = curand_uniform4(&state);
+    const float* rand = &rand4[0].x;
+    uint8_t bits = 0;
+    #pragma unroll
+    for (int ii = 0; ii < 8; ii++) {
+      const int64_t li = byte * 8 + ii;
+      if (li < totalElements) {
+        const bool keep = rand[ii] < p;
+        b[li] = keep ? static_cast<scalar_t>(a[li] * pinv) : scalar_t(0);
+        bits |= static_cast<uint8_t>(keep) << ii;
+      }
+    }
+    c[byte] = bits;
+  }
+}
+
+template <typename scalar_t, typename accscalar_t>
+__global__ void
+masked_scale_packed_kernel(const scalar_t* a, scalar_t* b, const uint8_t* c,
+                           int64_t totalElements, accscalar_t scale) {
+  for (int64_t li = blockIdx.x * blockDim.x + threadIdx.x;
+       li < totalElements;
+       li += gridDim.x * blockDim.x) {
+    b[li] = (c[li >> 3] >> (li & 7)) & 1 ? static_cast<scalar_t>(a[li] * scale) : scalar_t(0);
+  }
+}
+
+dim3 packed_grid(int64_t n, int64_t block_size) {
+  unsigned int blocks_per_sm = at::cuda::getCurrentDeviceProperties()->maxThreadsPerMultiProcessor/block_size;
+  dim3 grid((n + block_size - 1)/block_size);
+  grid.x = std::min((unsigned int)at::cuda::getCurrentDeviceProperties()->multiProcessorCount * blocks_per_sm, grid.x);
+  return grid;
+}
+
 template <typename scalar_t>
 int get_vector_size(at::Tensor self, at::Tensor ret, at::Tensor mask) {
   int vec_size = 4;
@@ -368,5 +424,66 @@ Tensor masked_scale_cuda(const Tensor& self, const Tensor& mask, double scale){
   return ret;
 }
 
+// Like fused_dropout_cuda, but keeps one bit per element of the mask: element
+// i is kept if bit i % 8 of mask[i / 8] is set
+std::tuple<Tensor,Tensor>
+fused_dropout_packed_cuda(const Tensor& self, double p, c10::optional<Generator> gen_){
+  TORCH_CHECK(p > 0 && p <= 1, "_fused_dropout_packed: keep probability has to be in (0, 1], but got ", p);
+  auto gen = get_generator_or_default<CUDAGeneratorImpl>(gen_, cuda::detail::getDefaultCUDAGenerator());
+  auto input = self.contiguous();
+  Tensor ret = at::empty_like(input, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  const int64_t nelem = input.numel();
+  Tensor mask = at::empty({(nelem + 7) / 8}, self.options().dtype(kByte));
+  if (nelem == 0) return std::tuple<Tensor,Tensor>(ret, mask);
+  PhiloxCudaState rng_engine_inputs;
+  {
+    // See Note [Acquire lock when using random generators]
+    std::lock_guard<std::mutex> lock(gen->mutex_);
+    // two curand_uniform4 per subsequence
+    rng_engine_inputs = gen->philox_cuda_state(2);
+  }
+  const int64_t block_size = 256;
+  dim3 grid = packed_grid(mask.numel(), block_size);
+  AT_DISPATCH_FLOATING_TYPES_AND2(at::ScalarType::Half, at::ScalarType::BFloat16, ret.scalar_type(), "fused_dropout_packed", [&] {
+    using accscalar_t = acc_type<scalar_t, true>;
+    fused_dropout_packed_kernel<scalar_t, accscalar_t>
+        <<<grid, block_size, 0, at::cuda::getCurrentCUDAStream()>>>(
+            input.data_ptr<scalar_t>(),
+            ret.data_ptr<scalar_t>(),
+            mask.data_ptr<uint8_t>(),
+            nelem,
+            (accscalar_t)(p),
+            rng_engine_inputs);
+    C10_CUDA_KERNEL_LAUNCH_CHECK();
+  });
+  return std::tuple<Tensor,Tensor>(ret, mask);
+}
+
+Tensor masked_scale_packed_cuda(const Tensor& self, const Tensor& mask, double scale){
+  TORCH_CHECK(mask.scalar_type() == at::ScalarType::Byte, "mask should be torch.uint8 dtype");
+  TORCH_CHECK(mask.numel() == (self.numel() + 7) / 8,
+      "_masked_scale_packed: expected a mask of ", (self.numel() + 7) / 8, " bytes for ",
+      self.numel(), " elements, but got ", mask.numel());
+  auto input = self.contiguous();
+  auto mask_ = mask.contiguous();
+  Tensor ret = at::empty_like(input, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  const int64_t nelem = input.numel();
+  if (nelem == 0) return ret;
+  const int64_t block_size = 256;
+  dim3 grid = packed_grid(nelem, block_size);
+  AT_DISPATCH_FLOATING_TYPES_AND2(at::ScalarType::Half, at::ScalarType::BFloat16, ret.scalar_type(), "masked_scale_packed", [&] {
+    using accscalar_t = acc_type<scalar_t, true>;
+    masked_scale_packed_kernel<scalar_t, accscalar_t>
+        <<<grid, block_size, 0, at::cuda::getCurrentCUDAStream()>>>(
+            input.data_ptr<scalar_t>(),
+            ret.data_ptr<scalar_t>(),
+            mask_.data_ptr<uint8_t>(),
+            nelem,
+            (accscalar_t)(scale));
+    C10_CUDA_KERNEL_LAUNCH_CHECK();
+  });
+  return ret;
+}
+
 }
 }
@@ -5,6 +5,7 @@
 #include <c10/util/Exception.h>
 #include <c10/macros/Macros.h>
 
+#include <THC/THCAtomics.cuh>
 #include <THC/THCDeviceUtils.cuh>
 #include <THC/THCTensorMathReduce.cuh>
 #include <THC/THCTensorSort.cuh>
@@ -27,17 +28,23 @@ static const int BLOCKDIMY = 16;
 static const int BLOCKDIMY = 32;
 #endif
 
+// Each block accumulates rows [blockIdx.y * rows_per_block, ...) of grad into
+// grad_weight, for the features of blockIdx.x. With a single block along y,
+// the result is deterministic. With more (atomic = true), each block adds its
+// partial sums with atomics, which doesn't need the indices to be sorted.
 template
   <typename scalar_t,
    typename accscalar_t,
-   typename index_t>
+   typename index_t,
+   bool atomic>
 __global__ void embedding_backward_feature_kernel
   (index_t* indices,
    const scalar_t* __restrict__ grad,
    scalar_t* __restrict__ grad_weight,
    int n, // OK to pass as int, we don't expect 2 billion+ samples in one shot
    int64_t stride,
-   int padding_idx)
+   int padding_idx,
+   int rows_per_block)
 {
   extern __shared__ char buf[];
   accscalar_t* smem = (accscalar_t*)buf;
@@ -48,15 +55,18 @@ __global__ void embedding_backward_feature_kernel
 
   const int f = threadIdx.x + blockIdx.x*blockDim.x; // feature_dim
 
-  for(int batch_start = 0; batch_start < n; batch_start += blockDim.x*blockDim.y)
+  const int rows_begin = blockIdx.y*rows_per_block;
+  const int rows_end = n - rows_begin < rows_per_block ? n : rows_begin + rows_per_block;
+
+  for(int batch_start = rows_begin; batch_start < rows_end; batch_start += blockDim.x*blockDim.y)
   {
     // Entire block cooperates to load a batch of 1024 indices to process
     int tid = threadIdx.x + threadIdx.y*blockDim.x;
-    if(batch_start + tid < n)
+    if(batch_start + tid < rows_end)
       indices_batch[tid] = (int)indices[batch_start + tid];
 
-    int batch_end = batch_start + blockDim.x*blockDim.y < n ?
-                    batch_start + blockDim.x*blockDim.y : n;
+    int batch_end = batch_start + blockDim.x*blockDim.y < rows_end ?
+                    batch_start + blockDim.x*blockDim.y : rows_end;
 
     // Loop over the batch of <= 1024 loaded indices in chunks of blockDim.y = 32
     for(int chunk_start = batch_start; chunk_start < batch_end; chunk_start += blockDim.y)
@@ -72,7 +82,7 @@ __global__ void embedding_backward_feature_kernel
       int dst_row = indices_batch[src_row - batch_start]; // This warp's target row in grad_weight
 
       // All warps load their smem segments with incoming grad data
-      if(src_row < n && f < s && dst_row != padding_idx)
+      if(src_row < batch_end && f < s && dst_row != padding_idx)
         my_s[threadIdx.x] = static_cast<accscalar_t>(grad[src_row*stride + f]);
 
       __syncthreads();
@@ -82,7 +92,7 @@ __global__ void embedding_backward_feature_kernel
       // If so, we elect the first warp in each matching group as the leader.
       // Each leader warp serializes the accumulates targeting dst_row in shared memory,
       // then finishes by adding the accumulated buffer to dst_row in grad_weight.
-      if(dst_row != padding_idx && src_row < n) // Per-warp exit condition, safe with ballot_sync
+      if(dst_row != padding_idx && src_row < batch_end) // Per-warp exit condition, safe with ballot_sync
       {
         int match_found_this_thread =
           (dst_row == indices_batch[chunk_start - batch_start + threadIdx.x]);
@@ -109,8 +119,13 @@ __global__ void embedding_backward_feature_kernel
             my_s[threadIdx.x] += smem[threadIdx.x + C10_WARP_SIZE*first_remaining_peer];
             matchmask ^= (1 << first_remaining_peer);
           }
-          if(f < s)
-            grad_weight[dst_row*stride + f] += static_cast<scalar_t>(my_s[threadIdx.x]);
+          if(f < s) {
+            if (atomic) {
+              gpuAtomicAdd(&grad_weight[dst_row*stride + f], static_cast<scalar_t>(my_s[threadIdx.x]));
+            } else {
+              grad_weight[dst_row*stride + f] += static_cast<scalar_t>(my_s[threadIdx.x]);
+            }
+          }
         }
       }
     }
@@ -236,11 +251,26 @@ Tensor embedding_dense_backward_cuda(const Tensor & grad_, const Tensor & indice
   auto grad = grad_.contiguous().view({num_indices, grad_.size(-1)});
   cudaStream_t stream = at::cuda::getCurrentCUDAStream();
 
-  if (num_indices <= 768 && !scale_grad_by_freq) {
+  // Without sorting, each block accumulates a slice of the indices and the
+  // slices are combined with atomics. This saves the sort and its scratch
+  // buffers, which dominate for large batches, and atomics rarely collide
+  // when few indices repeat. Half and BFloat16 atomics would round every
+  // partial sum, so these go through the sort.
+  const bool use_atomics = num_indices > 768 && !scale_grad_by_freq &&
+      !globalContext().deterministicAlgorithms() &&
+      (grad.scalar_type() == kFloat || grad.scalar_type() == kDouble);
+
+  if ((num_indices <= 768 && !scale_grad_by_freq) || use_atomics) {
     auto indices_contig = indices.contiguous();
     auto grad_weight = at::zeros({num_weights, grad_.size(-1)}, grad_.options());
     int64_t stride = grad_weight.stride(0);
-    dim3 grid(THCCeilDiv(stride, (int64_t)C10_WARP_SIZE));
+    // A block goes through its rows in batches of 1024
+    const int64_t batch_size = C10_WARP_SIZE * BLOCKDIMY;
+    const int64_t num_batches = THCCeilDiv(num_indices, batch_size);
+    const int64_t max_blocks_y = use_atomics ? 65535 : 1;
+    const int rows_per_block = THCCeilDiv(num_batches, max_blocks_y) * batch_size;
+    dim3 grid(THCCeilDiv(stride, (int64_t)C10_WARP_SIZE),
+              THCCeilDiv(num_indices, (int64_t)rows_per_block));
     dim3 block(C10_WARP_SIZE, BLOCKDIMY);
 
     AT_DISPATCH_FLOATING_TYPES_AND2(
@@ -251,7 +281,10 @@ Tensor embedding_dense_backward_cuda(const Tensor & grad_, const Tensor & indice
        {
           using accscalar_t = acc_type<scalar_t, true>;
           AT_DISPATCH_INDEX_TYPES(indices.scalar_type(), "embedding_dense_backward_cuda", [&] () {
-          embedding_backward_feature_kernel<scalar_t, accscalar_t, index_t>
+          auto kernel = use_atomics
+              ? embedding_backward_feature_kernel<scalar_t, accscalar_t, index_t, true>
+              : embedding_backward_feature_kernel<scalar_t, accscalar_t, index_t, false>;
+          kernel
             <<<grid,
                 block,
                 sizeof(accscalar_t)*C10_WARP_SIZE*BLOCKDIMY + sizeof(int)*C10_WARP_SIZE*BLOCKDIMY,
@@ -261,7 +294,8 @@ Tensor embedding_dense_backward_cuda(const Tensor & grad_, const Tensor & indice
               grad_weight.data_ptr<scalar_t>(),
               static_cast<int>(num_indices),
               static_cast<int64_t>(stride),
-              static_cast<int>(padding_idx));
+              static_cast<int>(padding_idx),
+              rows_per_block);
           C10_CUDA_KERNEL_LAUNCH_CHECK();
           });
        });
@@ -16,6 +16,7 @@
 #include <thrust/iterator/constant_iterator.h>
 #include <thrust/device_vector.h>
 
+#include <ATen/native/EmbeddingBag.h>
 #include <ATen/native/cuda/EmbeddingBackwardKernel.cuh>
 
 #include <c10/macros/Macros.h>
@@ -480,5 +481,203 @@ Tensor _embedding_bag_per_sample_weights_backward_cuda(
   return output;
 }
 
+
+namespace {
+
+// Same strategy as EmbeddingBag_updateOutputKernel: each bag x feature of all
+// the tables is handled by a single thread.
+template <typename scalar_t, typename index_t>
+__global__ void EmbeddingBagBatched_updateOutputKernel(
+    const scalar_t* weight, const int64_t* weight_offsets,
+    const index_t* indices, const index_t* offsets,
+    const scalar_t* per_sample_weights, scalar_t* output,
+    int64_t numTables, int64_t batchSize, int64_t featureSize, bool mean) {
+  using accscalar_t = acc_type<scalar_t, true>;
+  int64_t numBags = numTables * batchSize;
+  int64_t chunksPerBag = THCCeilDiv(featureSize, (int64_t)blockDim.x);
+  int64_t numChunks = numBags * chunksPerBag;
+  int64_t chunkOffset = blockIdx.x * blockDim.y + threadIdx.y;
+  int64_t chunkStride = gridDim.x * blockDim.y;
+
+  for (int64_t chunk = chunkOffset; chunk < numChunks; chunk += chunkStride) {
+    int64_t featureDim = (chunk % chunksPerBag) * blockDim.x + threadIdx.x;
+    if (featureDim < featureSize) {
+      int64_t bag = chunk / chunksPerBag;
+      int64_t table = bag / batchSize;
+      int64_t sample = bag % batchSize;
+      int64_t rowStart = weight_offsets[table];
+      int64_t tableRows = weight_offsets[table + 1] - rowStart;
+      int64_t begin = offsets[bag];
+      int64_t end = offsets[bag + 1];
+      CUDA_KERNEL_ASSERT(end >= begin);
+
+      accscalar_t weightFeatSum = 0;
+      for (int64_t emb = begin; emb < end; emb++) {
+        int64_t index = indices[emb];
+        CUDA_KERNEL_ASSERT(index >= 0 && index < tableRows);
+        accscalar_t weightValue = static_cast<accscalar_t>(
+            weight[(rowStart + index) * featureSize + featureDim]);
+        if (per_sample_weights) {
+          weightValue *= static_cast<accscalar_t>(per_sample_weights[emb]);
+        }
+        weightFeatSum += weightValue;
+      }
+      // Empty bags return all 0s instead of dividing by 0
+      if (mean && end > begin) {
+        weightFeatSum /= static_cast<accscalar_t>(end - begin);
+      }
+      output[(sample * numTables + table) * featureSize + featureDim] =
+          static_cast<scalar_t>(weightFeatSum);
+    }
+  }
+}
+
+// Gradient of one feature of the row of a segment, summed over all the
+// lookups of the row.
+template <typename scalar_t, typename accscalar_t>
+__device__ __forceinline__ accscalar_t EmbeddingBagBatched_segmentGrad(
+    const scalar_t* grad, const int64_t* positions, const int64_t* bags,
+    const int64_t* offsets, const scalar_t* per_sample_weights,
+    int64_t begin, int64_t end, int64_t batchSize, int64_t gradStride,
+    int64_t featureSize, int64_t featureDim, bool mean) {
+  accscalar_t sum = 0;
+  for (int64_t p = begin; p < end; p++) {
+    int64_t position = positions[p];
+    int64_t bag = bags[position];
+    int64_t table = bag / batchSize;
+    int64_t sample = bag % batchSize;
+    accscalar_t scale = per_sample_weights
+        ? static_cast<accscalar_t>(per_sample_weights[position]) : accscalar_t(1);
+    if (mean) {
+      scale /= static_cast<accscalar_t>(offsets[bag + 1] - offsets[bag]);
+    }
+    sum += static_cast<accscalar_t>(
+        grad[sample * gradStride + table * featureSize + featureDim]) * scale;
+  }
+  return sum;
+}
+
+// Each warp reduces and updates the row of one segment at a time, so no two
+// threads write the same element and no atomics are needed. Rowwise Adagrad
+// reads the gradients of the row twice: once for the squared norm that scales
+// the step, and once to apply it.
+template <typename scalar_t>
+__global__ void EmbeddingBagBatched_accGradParametersKernel(
+    scalar_t* target, acc_type<scalar_t, true>* momentum, const scalar_t* grad,
+    const int64_t* rows, const int64_t* segment_offsets, const int64_t* positions,
+    const int64_t* bags, const int64_t* offsets, const scalar_t* per_sample_weights,
+    int64_t numSegments, int64_t batchSize, int64_t gradStride, int64_t featureSize,
+    bool mean, EmbeddingBagBatchedUpdate update, double lr, double eps) {
+  using accscalar_t = acc_type<scalar_t, true>;
+  int64_t segmentStride = gridDim.x * blockDim.y;
+
+  for (int64_t segment = blockIdx.x * blockDim.y + threadIdx.y; segment < numSegments;
+       segment += segmentStride) {
+    int64_t begin = segment_offsets[segment];
+    int64_t end = segment_offsets[segment + 1];
+    int64_t row = rows[segment];
+    scalar_t* targetRow = target + row * featureSize;
+
+    accscalar_t step = static_cast<accscalar_t>(lr);
+    if (update == EmbeddingBagBatchedUpdate::RowwiseAdagrad) {
+      accscalar_t sumSquares = 0;
+      for (int64_t featureDim = threadIdx.x; featureDim < featureSize; featureDim += blockDim.x) {
+        accscalar_t g = EmbeddingBagBatched_segmentGrad<scalar_t, accscalar_t>(
+            grad, positions, bags, offsets, per_sample_weights, begin, end,
+            batchSize, gradStride, featureSize, featureDim, mean);
+        sumSquares += g * g;
+      }
+      sumSquares = WARP_SHFL(warpReduceSum<accscalar_t>(sumSquares), 0);
+      accscalar_t rowMomentum = momentum[row] + sumSquares / static_cast<accscalar_t>(featureSize);
+      step = static_cast<accscalar_t>(lr) /
+          (::sqrt(rowMomentum) + static_cast<accscalar_t>(eps));
+      if (threadIdx.x == 0) {
+        momentum[row] = rowMomentum;
+      }
+    }
+
+    for (int64_t featureDim = threadIdx.x; featureDim < featureSize; featureDim += blockDim.x) {
+      accscalar_t g = EmbeddingBagBatched_segmentGrad<scalar_t, accscalar_t>(
+          grad, positions, bags, offsets, per_sample_weights, begin, end,
+          batchSize, gradStride, featureSize, featureDim, mean);
+      if (update == EmbeddingBagBatchedUpdate::Grad) {
+        targetRow[featureDim] = static_cast<scalar_t>(g);
+      } else {
+        targetRow[featureDim] = static_cast<scalar_t>(
+            static_cast<accscalar_t>(targetRow[featureDim]) - step * g);
+      }
+    }
+  }
+}
+
+void embedding_bag_batched_kernel_cuda(
+    Tensor& output,
+    const Tensor& weight,
+    const Tensor& weight_offsets,
+    const Tensor& indices,
+    const Tensor& offsets,
+    const Tensor& per_sample_weights,
+    bool mean) {
+  int64_t numTables = weight_offsets.numel() - 1;
+  int64_t batchSize = (offsets.numel() - 1) / numTables;
+  int64_t featureSize = weight.size(1);
+
+  cudaStream_t stream = at::cuda::getCurrentCUDAStream();
+#ifdef __HIP_PLATFORM_HCC__
+  dim3 block = dim3(64, 4);
+#else
+  dim3 block = dim3(32, 8);
+#endif
+  int grid = 1024;
+  AT_DISPATCH_FLOATING_TYPES_AND_HALF(weight.scalar_type(), "embedding_bag_batched_cuda", [&] {
+    AT_DISPATCH_INDEX_TYPES(indices.scalar_type(), "embedding_bag_batched_cuda", [&] () {
+      EmbeddingBagBatched_updateOutputKernel<scalar_t, index_t><<<grid, block, 0, stream>>>(
+          weight.data_ptr<scalar_t>(), weight_offsets.data_ptr<int64_t>(),
+          indices.data_ptr<index_t>(), offsets.data_ptr<index_t>(),
+          per_sample_weights.defined() ? per_sample_weights.data_ptr<scalar_t>() : NULL,
+          output.data_ptr<scalar_t>(), numTables, batchSize, featureSize, mean);
+      C10_CUDA_KERNEL_LAUNCH_CHECK();
+    });
+  });
+}
+
+void embedding_bag_batched_backward_kernel_cuda(
+    Tensor& target,
+    Tensor& momentum,
+    const Tensor& grad,
+    const EmbeddingBagBatchedSegments& segments,
+    const Tensor& offsets,
+    const Tensor& per_sample_weights,
+    bool mean,
+    EmbeddingBagBatchedUpdate update,
+    double lr,
+    double eps) {
+  int64_t numSegments = segments.rows.numel();
+  int64_t featureSize = target.size(1);
+
+  cudaStream_t stream = at::cuda::getCurrentCUDAStream();
+  // one warp per segment
+  dim3 block = dim3(C10_WARP_SIZE, 256 / C10_WARP_SIZE);
+  int grid = 1024;
+  AT_DISPATCH_FLOATING_TYPES_AND_HALF(grad.scalar_type(), "embedding_bag_batched_backward_cuda", [&] {
+    using accscalar_t = acc_type<scalar_t, true>;
+    EmbeddingBagBatched_accGradParametersKernel<scalar_t><<<grid, block, 0, stream>>>(
+        target.data_ptr<scalar_t>(),
+        update == EmbeddingBagBatchedUpdate::RowwiseAdagrad ? momentum.data_ptr<accscalar_t>() : NULL,
+        grad.data_ptr<scalar_t>(),
+        segments.rows.data_ptr<int64_t>(), segments.segment_offsets.data_ptr<int64_t>(),
+        segments.positions.data_ptr<int64_t>(), segments.bags.data_ptr<int64_t>(),
+        offsets.data_ptr<int64_t>(),
+        per_sample_weights.defined() ? per_sample_weights.data_ptr<scalar_t>() : NULL,
+        numSegments, grad.size(0), grad.size(1), featureSize, mean, update, lr, eps);
+    C10_CUDA_KERNEL_LAUNCH_CHECK();
+  });
+}
+
+} // namespace
+
+REGISTER_DISPATCH(embedding_bag_batched_stub, &embedding_bag_batched_kernel_cuda);
+REGISTER_DISPATCH(embedding_bag_batched_backward_stub, &embedding_bag_batched_backward_kernel_cuda);
+
 }
 }
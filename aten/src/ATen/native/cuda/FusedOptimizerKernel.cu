@@ -0,0 +1,219 @@
+#include <ATen/DeviceGuard.h>
+#include <ATen/Dispatch.h>
+#include <ATen/native/FusedOptimizer.h>
+#include <ATen/native/cuda/ForeachFunctors.cuh>
+
+namespace at { namespace native {
+
+namespace {
+
+// One launch updates a whole chunk of parameters, see multi_tensor_apply. Each element is loaded
+// once, updated in registers in opmath_t, and stored back, in the order of the unfused ops.
+
+template<typename T, int depth>
+struct FusedAdamFunctor {
+    using opmath_t = typename get_opmath_t<T>::opmath_t;
+    __device__ __forceinline__ void operator() (
+        int chunk_size,
+        TensorListMetadata<depth>& tl,
+        opmath_t lr,
+        opmath_t beta1,
+        opmath_t beta2,
+        opmath_t weight_decay,
+        opmath_t eps,
+        opmath_t bias_correction1,
+        opmath_t bias_correction2_sqrt,
+        bool decoupled_weight_decay) {
+            int tensor_loc = tl.block_to_tensor[blockIdx.x];
+            int chunk_idx = tl.block_to_chunk[blockIdx.x];
+            int n = tl.numel_for_tensor[tensor_loc];
+
+            T* args[depth];
+            init_args<depth>(args, tl, chunk_idx, chunk_size, tensor_loc);
+            n -= chunk_idx * chunk_size;
+            T r_args[depth][kILP];
+
+            // params, grads, exp_avgs, exp_avg_sqs and, with amsgrad, max_exp_avg_sqs. The last list is
+            // indexed as depth - 1 so that the amsgrad branch still compiles for depth 4.
+            for(int i_start = 0; i_start < n && i_start < chunk_size; i_start += blockDim.x * kILP) {
+                load_args<depth>(r_args, args, i_start, chunk_size, n);
+#pragma unroll
+                for(int ii = 0; ii < kILP; ii++) {
+                    opmath_t param = static_cast<opmath_t>(r_args[0][ii]);
+                    opmath_t grad = static_cast<opmath_t>(r_args[1][ii]);
+                    if (weight_decay != 0) {
+                        if (decoupled_weight_decay) {
+                            param *= 1 - lr * weight_decay;
+                        } else {
+                            grad += param * weight_decay;
+                        }
+                    }
+                    opmath_t exp_avg = static_cast<opmath_t>(r_args[2][ii]) * beta1 + grad * (1 - beta1);
+                    opmath_t exp_avg_sq = static_cast<opmath_t>(r_args[3][ii]) * beta2 + grad * grad * (1 - beta2);
+                    opmath_t denom_sq = exp_avg_sq;
+                    if (depth == 5) {
+                        denom_sq = ::max(static_cast<opmath_t>(r_args[depth - 1][ii]), exp_avg_sq);
+                        r_args[depth - 1][ii] = static_cast<T>(denom_sq);
+                    }
+                    opmath_t denom = ::sqrt(denom_sq) / bias_correction2_sqrt + eps;
+                    param -= (lr / bias_correction1) * (exp_avg / denom);
+                    r_args[0][ii] = static_cast<T>(param);
+                    r_args[2][ii] = static_cast<T>(exp_avg);
+                    r_args[3][ii] = static_cast<T>(exp_avg_sq);
+                }
+                store_args(args[0], r_args[0], i_start, chunk_size, n);
+                store_args(args[2], r_args[2], i_start, chunk_size, n);
+                store_args(args[3], r_args[3], i_start, chunk_size, n);
+                if (depth == 5) {
+                    store_args(args[depth - 1], r_args[depth - 1], i_start, chunk_size, n);
+                }
+            }
+        }
+};
+
+template<typename T, int depth>
+struct FusedSgdFunctor {
+    using opmath_t = typename get_opmath_t<T>::opmath_t;
+    __device__ __forceinline__ void operator() (
+        int chunk_size,
+        TensorListMetadata<depth>& tl,
+        opmath_t lr,
+        opmath_t momentum,
+        opmath_t dampening,
+        opmath_t weight_decay,
+        bool nesterov,
+        bool is_first_step) {
+            int tensor_loc = tl.block_to_tensor[blockIdx.x];
+            int chunk_idx = tl.block_to_chunk[blockIdx.x];
+            int n = tl.numel_for_tensor[tensor_loc];
+
+            T* args[depth];
+            init_args<depth>(args, tl, chunk_idx, chunk_size, tensor_loc);
+            n -= chunk_idx * chunk_size;
+            T r_args[depth][kILP];
+
+            // params, grads and, with momentum, momentum_buffers (indexed as depth - 1, see above)
+            for(int i_start = 0; i_start < n && i_start < chunk_size; i_start += blockDim.x * kILP) {
+                load_args<depth>(r_args, args, i_start, chunk_size, n);
+#pragma unroll
+                for(int ii = 0; ii < kILP; ii++) {
+                    opmath_t param = static_cast<opmath_t>(r_args[0][ii]);
+                    opmath_t d_p = static_cast<opmath_t>(r_args[1][ii]);
+                    if (weight_decay != 0) {
+                        d_p += param * weight_decay;
+                    }
+                    if (depth == 3) {
+                        opmath_t buf = is_first_step
+                            ? d_p
+                            : static_cast<opmath_t>(r_args[depth - 1][ii]) * momentum + d_p * (1 - dampening);
+                        r_args[depth - 1][ii] = static_cast<T>(buf);
+                        d_p = nesterov ? d_p + buf * momentum : buf;
+                    }
+                    r_args[0][ii] = static_cast<T>(param - lr * d_p);
+                }
+                store_args(args[0], r_args[0], i_start, chunk_size, n);
+                if (depth == 3) {
+                    store_args(args[depth - 1], r_args[depth - 1], i_start, chunk_size, n);
+                }
+            }
+        }
+};
+
+// multi_tensor_apply launches the last kernel when it reaches the last chunk of the last tensor,
+// which an empty tensor does not have, so empty parameters are dropped beforehand.
+std::vector<std::vector<Tensor>> non_empty_tensor_lists(std::initializer_list<TensorList> lists) {
+    std::vector<std::vector<Tensor>> tensor_lists(lists.size());
+    const auto& params = *lists.begin();
+    for (size_t i = 0; i < params.size(); i++) {
+        if (params[i].numel() == 0) {
+            continue;
+        }
+        size_t d = 0;
+        for (const auto& list : lists) {
+            tensor_lists[d++].push_back(list[i]);
+        }
+    }
+    return tensor_lists;
+}
+
+template<int depth>
+void fused_adam_cuda_impl(std::vector<std::vector<Tensor>>& tensor_lists, double lr, double beta1, double beta2,
+                          double weight_decay, double eps, double bias_correction1, double bias_correction2,
+                          bool decoupled_weight_decay) {
+    AT_DISPATCH_FLOATING_TYPES_AND2(kHalf, kBFloat16, tensor_lists[0][0].scalar_type(), "fused_adam_cuda", [&]() {
+        using opmath_t = get_opmath_t<scalar_t>::opmath_t;
+        multi_tensor_apply<depth>(tensor_lists,
+                                  FusedAdamFunctor<scalar_t, depth>(),
+                                  static_cast<opmath_t>(lr),
+                                  static_cast<opmath_t>(beta1),
+                                  static_cast<opmath_t>(beta2),
+                                  static_cast<opmath_t>(weight_decay),
+                                  static_cast<opmath_t>(eps),
+                                  static_cast<opmath_t>(bias_correction1),
+                                  static_cast<opmath_t>(std::sqrt(bias_correction2)),
+                                  decoupled_weight_decay);
+    });
+}
+
+void fused_adam_kernel_cuda(TensorList params, TensorList grads, TensorList exp_avgs, TensorList exp_avg_sqs,
+                            TensorList max_exp_avg_sqs, double lr, double beta1, double beta2, double weight_decay,
+                            double eps, double bias_correction1, double bias_correction2, bool decoupled_weight_decay) {
+    const OptionalDeviceGuard device_guard(device_of(params));
+    if (max_exp_avg_sqs.empty()) {
+        auto tensor_lists = non_empty_tensor_lists({params, grads, exp_avgs, exp_avg_sqs});
+        if (tensor_lists[0].empty()) {
+            return;
+        }
+        fused_adam_cuda_impl<4>(tensor_lists, lr, beta1, beta2, weight_decay, eps,
+                                bias_correction1, bias_correction2, decoupled_weight_decay);
+    } else {
+        auto tensor_lists = non_empty_tensor_lists({params, grads, exp_avgs, exp_avg_sqs, max_exp_avg_sqs});
+        if (tensor_lists[0].empty()) {
+            return;
+        }
+        fused_adam_cuda_impl<5>(tensor_lists, lr, beta1, beta2, weight_decay, eps,
+                                bias_correction1, bias_correction2, decoupled_weight_decay);
+    }
+}
+
+template<int depth>
+void fused_sgd_cuda_impl(std::vector<std::vector<Tensor>>& tensor_lists, double lr, double momentum,
+                         double dampening, double weight_decay, bool nesterov, bool is_first_step) {
+    AT_DISPATCH_FLOATING_TYPES_AND2(kHalf, kBFloat16, tensor_lists[0][0].scalar_type(), "fused_sgd_cuda", [&]() {
+        using opmath_t = get_opmath_t<scalar_t>::opmath_t;
+        multi_tensor_apply<depth>(tensor_lists,
+                                  FusedSgdFunctor<scalar_t, depth>(),
+                                  static_cast<opmath_t>(lr),
+                                  static_cast<opmath_t>(momentum),
+                                  static_cast<opmath_t>(dampening),
+                                  static_cast<opmath_t>(weight_decay),
+                                  nesterov,
+                                  is_first_step);
+    });
+}
+
+void fused_sgd_kernel_cuda(TensorList params, TensorList grads, TensorList momentum_buffers, double lr,
+                           double momentum, double dampening, double weight_decay, bool nesterov,
+                           bool is_first_step) {
+    const OptionalDeviceGuard device_guard(device_of(params));
+    if (momentum_buffers.empty()) {
+        auto tensor_lists = non_empty_tensor_lists({params, grads});
+        if (tensor_lists[0].empty()) {
+            return;
+        }
+        fused_sgd_cuda_impl<2>(tensor_lists, lr, momentum, dampening, weight_decay, nesterov, is_first_step);
+    } else {
+        auto tensor_lists = non_empty_tensor_lists({params, grads, momentum_buffers});
+        if (tensor_lists[0].empty()) {
+            return;
+        }
+        fused_sgd_cuda_impl<3>(tensor_lists, lr, momentum, dampening, weight_decay, nesterov, is_first_step);
+    }
+}
+
+} // namespace
+
+REGISTER_DISPATCH(fused_adam_stub, &fused_adam_kernel_cuda);
+REGISTER_DISPATCH(fused_sgd_stub, &fused_sgd_kernel_cuda);
+
+}} // namespace at::native
@@ -76,6 +76,24 @@ struct unroll_load_helper {
   }
 };
 
+template<int arg_index>
+struct vectorized_inner_load_helper {
+  template <typename args_t, typename policy_t, typename offset_t>
+  static __device__ void apply(policy_t &self, args_t *args, offset_t offset, int i) {
+    using arg_t = std::tuple_element_t<arg_index, args_t>;
+    constexpr int vec_size = policy_t::vector_size;
+    using vec_t = aligned_vector<arg_t, vec_size>;
+    // `data` hold the data_ptr for tensors [output, input0, input1, ...], so we
+    // need a +1 offset to get the input
+    auto ptr = reinterpret_cast<arg_t *>(self.data[arg_index + 1]) + offset[arg_index];
+    vec_t v = *reinterpret_cast<vec_t *>(ptr);
+    #pragma unroll
+    for (int j = 0; j < vec_size; j++) {
+      std::get<arg_index>(args[vec_size * i + j]) = v.val[j];
+    }
+  }
+};
+
 template <int current>
 struct multi_outputs_store_helper {
   template<int ntensors, int num_outputs, typename ...Args>
@@ -259,6 +277,60 @@ struct vectorized {
   }
 };
 
+// Assumption:
+// the innermost dimension is contiguous for all tensors, its size is a multiple
+// of vec_size, and its first element is aligned to vec_size elements in every
+// row, so that a vector never spans two rows. The offset calculators are then
+// only evaluated once per vector.
+// Note:
+// Like the vectorized policy, this does not do boundary check.
+template <int vec_size, typename data_t, typename inp_calc_t, typename out_calc_t>  // vec_size: number of scalars, can be 2 or 4.
+struct vectorized_inner {
+
+  static_assert(thread_work_size % vec_size == 0, "The workload per thread must be a multiple of vec_size");
+  static constexpr int loop_size = thread_work_size / vec_size;
+  static constexpr int vector_size = vec_size;
+
+  data_t data;
+  inp_calc_t input_offset_calculator;
+  out_calc_t output_offset_calculator;
+
+  __device__ vectorized_inner(data_t data, inp_calc_t ic, out_calc_t oc):
+    data(data), input_offset_calculator(ic), output_offset_calculator(oc) {}
+
+  __device__ inline constexpr bool check_inbounds(int thread_work_elem) {
+    return true;
+  }
+
+  template<typename args_t>
+  __device__ inline void load(args_t *args, int idx) {
+    constexpr int arity = std::tuple_size<args_t>::value;
+    int thread_idx = threadIdx.x;
+    #pragma unroll
+    for (int i = 0; i < loop_size; i++) {
+      int linear_idx = block_work_size * idx + vec_size * (thread_idx + i * num_threads);
+      auto offset = input_offset_calculator.get(linear_idx);
+      detail::static_unroll<detail::vectorized_inner_load_helper, arity>::with_args(*this, args, offset, i);
+    }
+  }
+
+  template<typename scalar_t>
+  __device__ inline void store(scalar_t *from, int idx) {
+    using vec_t = aligned_vector<scalar_t, vec_size>;
+    int thread_idx = threadIdx.x;
+    #pragma unroll
+    for (int i = 0; i < loop_size; i++) {
+      int linear_idx = block_work_size * idx + vec_size * (thread_idx + i * num_threads);
+      int offset = output_offset_calculator.get(linear_idx)[0];
+      vec_t v;
+      for (int j = 0; j < vec_size; j++) {
+        v.val[j] = from[vec_size * i + j];
+      }
+      *reinterpret_cast<vec_t *>(reinterpret_cast<scalar_t *>(data[0]) + offset) = v;
+    }
+  }
+};
+
 template <typename data_t, typename inp_calc_t, typename out_calc_t, int num_outputs>
 struct multi_outputs_unroll {
   //multi_outputs_unroll struct members and check_inbounds and load methods are copypasted from unroll struct
@@ -162,6 +162,37 @@ sampleMultinomialWithReplacement(PhiloxCudaState philox_args,
   }
 }
 
+// Each thread draws the samples of a grid-stride loop, one per
+// curand_uniform4 call: x picks the category and y decides between it and
+// its alias
+template <typename scalar_t>
+__global__ void
+sampleMultinomialAlias(PhiloxCudaState philox_args,
+                       int64_t totalSamples,
+                       int64_t* dest,
+                       int64_t categories,
+                       const int64_t* J,
+                       const scalar_t* q) {
+  using accscalar_t = at::acc_type<scalar_t, true>;
+  auto seeds = at::cuda::philox::unpack(philox_args);
+  int64_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+  curandStatePhilox4_32_10_t state;
+  curand_init(std::get<0>(seeds),
+              idx,
+              std::get<1>(seeds),
+              &state);
+
+  for (int64_t sample = idx; sample < totalSamples;
+       sample += blockDim.x * gridDim.x) {
+    // curand_uniform4 draws from (0, 1]
+    auto rand = curand_uniform4(&state);
+    int64_t k = static_cast<int64_t>((1.0f - rand.x) * categories);
+    k = k < categories ? k : categories - 1;
+    dest[sample] = static_cast<accscalar_t>(rand.y) <= static_cast<accscalar_t>(q[k]) ? k : J[k];
+  }
+}
+
 template <typename scalar_t, typename accscalar_t>
 #ifdef __HIP_PLATFORM_HCC__
 C10_LAUNCH_BOUNDS_1(1024)
@@ -412,9 +443,47 @@ void multinomial_with_replacement_kernel_impl(
     result.resize_({n_sample});
   }
 }
+
+void multinomial_alias_draw_kernel_impl(
+    Tensor& result,
+    const Tensor& J,
+    const Tensor& q,
+    c10::optional<Generator> generator) {
+  auto gen = get_generator_or_default<CUDAGeneratorImpl>(generator, cuda::detail::getDefaultCUDAGenerator());
+  const int64_t n_sample = result.numel();
+  auto props = at::cuda::getCurrentDeviceProperties();
+  const int block = 256;
+  const int64_t grid = std::min<int64_t>(
+      (n_sample + block - 1) / block,
+      props->multiProcessorCount * (props->maxThreadsPerMultiProcessor / block));
+
+  PhiloxCudaState rng_engine_inputs;
+  {
+    // See Note [Acquire lock when using random generators]
+    std::lock_guard<std::mutex> lock(gen->mutex_);
+    // each thread calls curand_uniform4 once per sample it draws
+    auto offset = ((n_sample - 1) / (block * grid) + 1) * 4;
+    rng_engine_inputs = gen->philox_cuda_state(offset);
+  }
+
+  AT_DISPATCH_FLOATING_TYPES_AND_HALF(q.scalar_type(), "multinomial_alias_draw_cuda", [&] {
+    sampleMultinomialAlias<scalar_t>
+        <<<grid, block, 0, at::cuda::getCurrentCUDAStream()>>>(
+            rng_engine_inputs,
+            n_sample,
+            result.data_ptr<int64_t>(),
+            q.numel(),
+            J.data_ptr<int64_t>(),
+            q.data_ptr<scalar_t>());
+    C10_CUDA_KERNEL_LAUNCH_CHECK();
+  });
+}
 }
 
 REGISTER_DISPATCH(
     multinomial_with_replacement_stub,
     &multinomial_with_replacement_kernel_impl);
+REGISTER_DISPATCH(
+    multinomial_alias_draw_stub,
+    &multinomial_alias_draw_kernel_impl);
 }}
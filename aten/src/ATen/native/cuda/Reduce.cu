@@ -41,6 +41,7 @@ std::ostream& operator<<(std::ostream& out, const ReduceConfig& config) {
   out << "], ";
   out << "vectorize_input=" << config.vectorize_input << ", ";
   out << "output_vec_size=" << config.output_vec_size << ", ";
+  out << "two_pass=" << config.two_pass << ", ";
   out << "block_width=" << config.block_width << ", ";
   out << "block_height=" << config.block_height << ", ";
   out << "num_threads=" << config.num_threads << ", ";
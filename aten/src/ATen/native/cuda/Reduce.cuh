@@ -84,6 +84,10 @@ struct ReduceConfig {
 
   bool vectorize_input = false;
   int output_vec_size = 1;
+  // For global reductions: the blocks only write their partial results to
+  // the staging buffer, and a second kernel combines them, instead of the
+  // last block to finish
+  bool two_pass = false;
 
   void set_block_dimension(int64_t dim0, int64_t dim1) {
     const int max_num_threads = MAX_NUM_THREADS / output_vec_size;
@@ -162,7 +166,7 @@ struct ReduceConfig {
   }
 
   C10_DEVICE int staging_memory_offset(int cta2) const {
-    int offset = cta2 + blockIdx.x * gridDim.y;
+    int offset = cta2 + blockIdx.x * ctas_per_output;
     if (!should_block_x_reduce()) {
       offset = threadIdx.x + offset * blockDim.x;
     }
@@ -190,7 +194,7 @@ struct ReduceConfig {
   }
 
   int semaphore_size() const {
-    if (!should_global_reduce()) {
+    if (!should_global_reduce() || two_pass) {
       return 0;
     }
     return sizeof(int) * grid().x;
@@ -209,6 +213,12 @@ __global__ void reduce_kernel(R reduction) {
   reduction.template run<output_vec_size>();
 }
 
+template<int nt, int output_vec_size, typename R>
+C10_LAUNCH_BOUNDS_2(nt, 4)
+__global__ void reduce_staged_kernel(R reduction) {
+  reduction.template run_staged<output_vec_size>();
+}
+
 template <typename index_t>
 static OffsetCalculator<2, index_t> make_output_calculator(const TensorIterator& iter) {
   int num_reduce_dims = iter.num_reduce_dims();
@@ -713,6 +723,52 @@ struct ReduceOp {
   template <int output_vec_size>
   C10_DEVICE at::detail::Array<arg_t, output_vec_size> global_reduce(at::detail::Array<arg_t, output_vec_size> value, at::detail::Array<arg_t, output_vec_size> *acc, char* shared_memory) const {
     using arg_vec_t = at::detail::Array<arg_t, output_vec_size>;
+
+    arg_vec_t* reduce_buffer = (arg_vec_t*)cta_buf;
+    index_t output_idx = config.output_idx<output_vec_size>();
+    if (config.should_store(output_idx)) {
+      index_t offset = config.staging_memory_offset(blockIdx.y);
+      reduce_buffer[offset] = value;
+    }
+
+    if (config.two_pass) {
+      // reduce_staged_kernel finishes the reduction
+      return value;
+    }
+
+    __threadfence(); // make sure writes are globally visible
+    __syncthreads(); // if multiple warps in this block wrote to staging, make sure they're all done
+    bool is_last_block_done = mark_block_finished();
+
+    if (is_last_block_done) {
+      value = reduce_staged<output_vec_size>(acc, shared_memory);
+    }
+
+    return value;
+  }
+
+  // Second pass of a two-pass global reduction, run by block (blockIdx.x, 0)
+  // of the first pass
+  template <int output_vec_size>
+  C10_DEVICE void run_staged() const {
+    extern __shared__ char shared_memory[];
+    using arg_vec_t = at::detail::Array<arg_t, output_vec_size>;
+    index_t output_idx = config.output_idx<output_vec_size>();
+
+    arg_vec_t* acc = nullptr;
+    if (acc_buf != nullptr) {
+      size_t numerator = sizeof(arg_t);
+      size_t denominator = sizeof(out_scalar_t);
+      reduce_fraction(numerator, denominator);
+      acc = (arg_vec_t*)((char*)acc_buf + (output_calc.get(output_idx)[0] * numerator / denominator));
+    }
+    reduce_staged<output_vec_size>(acc, shared_memory);
+  }
+
+  // Combines the partial results of the blocks of an output and stores them
+  template <int output_vec_size>
+  C10_DEVICE at::detail::Array<arg_t, output_vec_size> reduce_staged(at::detail::Array<arg_t, output_vec_size> *acc, char* shared_memory) const {
+    using arg_vec_t = at::detail::Array<arg_t, output_vec_size>;
     using out_ptr_vec_t = at::detail::Array<out_scalar_t*, output_vec_size>;
     using offset_vec_t = at::detail::Array<index_t, output_vec_size>;
 
@@ -728,76 +784,65 @@ struct ReduceOp {
     }
 
     bool should_store = config.should_store(output_idx);
-    if (should_store) {
-      index_t offset = config.staging_memory_offset(blockIdx.y);
-      reduce_buffer[offset] = value;
+    arg_vec_t value = ident;
+    if (config.should_block_x_reduce()) {
+      index_t input_offset = threadIdx.x + threadIdx.y * blockDim.x;
+      index_t step = blockDim.x * blockDim.y;
+      for (; input_offset < config.ctas_per_output; input_offset += step) {
+        index_t idx = config.staging_memory_offset(input_offset);
+        arg_vec_t next = reduce_buffer[idx];
+        #pragma unroll
+        for (int i = 0; i < output_vec_size; i++) {
+          value[i] = ops.combine(value[i], next[i]);
+        }
+      }
+    } else {
+      index_t input_offset = threadIdx.y;
+      index_t step = blockDim.y;
+      for (; input_offset < config.ctas_per_output; input_offset += step) {
+        index_t idx = config.staging_memory_offset(input_offset);
+        arg_vec_t next = reduce_buffer[idx];
+        #pragma unroll
+        for (int i = 0; i < output_vec_size; i++) {
+          value[i] = ops.combine(value[i], next[i]);
+        }
+      }
     }
+    value = block_y_reduce(value, shared_memory);
+    if (config.should_block_x_reduce()) {
+      value = block_x_reduce<output_vec_size>(value, shared_memory);
+    }
+    if (should_store) {
+      if (accumulate) {
+        #pragma unroll
+        for (int i = 0; i < output_vec_size; i++) {
+          value[i] = ops.translate_idx(value[i], base_idx);
+        }
+      }
 
-    __threadfence(); // make sure writes are globally visible
-    __syncthreads(); // if multiple warps in this block wrote to staging, make sure they're all done
-    bool is_last_block_done = mark_block_finished();
-
-    if (is_last_block_done) {
-      value = ident;
-      if (config.should_block_x_reduce()) {
-        index_t input_offset = threadIdx.x + threadIdx.y * blockDim.x;
-        index_t step = blockDim.x * blockDim.y;
-        for (; input_offset < config.ctas_per_output; input_offset += step) {
-          index_t idx = config.staging_memory_offset(input_offset);
-          arg_vec_t next = reduce_buffer[idx];
-          #pragma unroll
-          for (int i = 0; i < output_vec_size; i++) {
-            value[i] = ops.combine(value[i], next[i]);
-          }
+      if (acc == nullptr) {
+        if (accumulate) {
+          value = accumulate_in_output<output_vec_size, can_accumulate_in_output>(out, value);
         }
-      } else {
-        index_t input_offset = threadIdx.y;
-        index_t step = blockDim.y;
-        for (; input_offset < config.ctas_per_output; input_offset += step) {
-          index_t idx = config.staging_memory_offset(input_offset);
-          arg_vec_t next = reduce_buffer[idx];
+        if (final_output) {
+          set_results_to_output<output_vec_size>(value, base_offsets);
+        } else {
           #pragma unroll
           for (int i = 0; i < output_vec_size; i++) {
-            value[i] = ops.combine(value[i], next[i]);
+            *(out[i]) = get_accumulated_output<can_accumulate_in_output>(out[i], value[i]);
           }
         }
-      }
-      value = block_y_reduce(value, shared_memory);
-      if (config.should_block_x_reduce()) {
-        value = block_x_reduce<output_vec_size>(value, shared_memory);
-      }
-      if (should_store) {
+      } else {
         if (accumulate) {
           #pragma unroll
           for (int i = 0; i < output_vec_size; i++) {
-            value[i] = ops.translate_idx(value[i], base_idx);
+            value[i] = ops.combine((*acc)[i], value[i]);
           }
         }
-
-        if (acc == nullptr) {
-          if (accumulate) {
-            value = accumulate_in_output<output_vec_size, can_accumulate_in_output>(out, value);
-          }
-          if (final_output) {
-            set_results_to_output<output_vec_size>(value, base_offsets);
-          } else {
-            #pragma unroll
-            for (int i = 0; i < output_vec_size; i++) {
-              *(out[i]) = get_accumulated_output<can_accumulate_in_output>(out[i], value[i]);
-            }
-          }
+        if (final_output) {
+          set_results_to_output<output_vec_size>(value, base_offsets);
         } else {
-          if (accumulate) {
-            #pragma unroll
-            for (int i = 0; i < output_vec_size; i++) {
-              value[i] = ops.combine((*acc)[i], value[i]);
-            }
-          }
-          if (final_output) {
-            set_results_to_output<output_vec_size>(value, base_offsets);
-          } else {
-            *acc = value;
-          }
+          *acc = value;
         }
       }
     }
@@ -827,6 +872,24 @@ static void launch_reduce_kernel(const ReduceConfig& config, const R& reduction)
     reduce_kernel<max_threads / 1, 1, R><<<grid, block, shared_memory, stream>>>(reduction);
     C10_CUDA_KERNEL_LAUNCH_CHECK();
   }
+
+  if (config.two_pass) {
+    // One block per column of the grid combines the partial results
+    dim3 staged_grid(grid.x);
+    switch(config.output_vec_size) {
+    case 4:
+      reduce_staged_kernel<max_threads / 4, 4, R><<<staged_grid, block, shared_memory, stream>>>(reduction);
+      C10_CUDA_KERNEL_LAUNCH_CHECK();
+      break;
+    case 2:
+      reduce_staged_kernel<max_threads / 2, 2, R><<<staged_grid, block, shared_memory, stream>>>(reduction);
+      C10_CUDA_KERNEL_LAUNCH_CHECK();
+      break;
+    default:
+      reduce_staged_kernel<max_threads / 1, 1, R><<<staged_grid, block, shared_memory, stream>>>(reduction);
+      C10_CUDA_KERNEL_LAUNCH_CHECK();
+    }
+  }
 }
 
 class AccumulationBuffer {
@@ -1074,15 +1137,26 @@ inline void gpu_reduce_kernel(TensorIterator& iter, const ops_t& ops, ident_t id
     }
   }
 
+  if (config.should_global_reduce() && !reduction_on_fastest_striding_dimension) {
+    // Tall and skinny inputs reduced along a strided dimension, e.g. the
+    // column sums of a [10M, 64] matrix, are split across many blocks for
+    // few outputs. Their partial results are combined by a second kernel,
+    // which spares the semaphores, their memset and the fences of the last
+    // block approach. The order of the combination is fixed either way.
+    config.two_pass = true;
+  }
+
   at::DataPtr buffer;
   at::DataPtr semaphores;
   if (config.should_global_reduce()) {
     auto& allocator = *c10::cuda::CUDACachingAllocator::get();
     buffer = allocator.allocate(config.global_memory_size());
-    semaphores = allocator.allocate(config.semaphore_size());
+    if (!config.two_pass) {
+      semaphores = allocator.allocate(config.semaphore_size());
 
-    auto stream = at::cuda::getCurrentCUDAStream();
-    AT_CUDA_CHECK(cudaMemsetAsync(semaphores.get(), 0, config.semaphore_size(), stream));
+      auto stream = at::cuda::getCurrentCUDAStream();
+      AT_CUDA_CHECK(cudaMemsetAsync(semaphores.get(), 0, config.semaphore_size(), stream));
+    }
   }
 
   AT_ASSERT(can_use_32bit_indexing);
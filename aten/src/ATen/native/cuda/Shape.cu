@@ -8,6 +8,11 @@
 #include <c10/util/Optional.h>
 
 #include <THC/THC.h>
+#include <THC/THCDeviceUtils.cuh>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
 
 namespace at {
 namespace native {
@@ -171,6 +176,45 @@ __global__ void CatArrayBatchedCopy(
     }
 }
 
+// Describes an input of CatArrayRowsCopy. Viewed in memory order, an input
+// made of rows of rowSize elements goes into the rows of the output at
+// offset.
+template <typename T, typename IndexType>
+struct CatArrRowsInput {
+  const T* input;
+  IndexType offset;
+  IndexType rowSize;
+  IndexType nElements;
+};
+
+/**
+  * Kernel used to concatenate any number of dense inputs in a single launch.
+  * Their descriptors live in device memory, so unlike CatArrayBatchedCopy
+  * the number of inputs isn't limited by the size of the kernel arguments.
+  * Input blockIdx.y is copied with a grid-stride loop along x.
+  *
+  * T is an opaque type of 1 to 16 bytes: as the copy doesn't look at the
+  * values, it moves the widest units that all the pointers, offsets and row
+  * sizes are aligned to.
+  */
+template <typename T, typename IndexType>
+C10_LAUNCH_BOUNDS_1(512)
+__global__ void CatArrayRowsCopy(
+    T* output,
+    const CatArrRowsInput<T, IndexType>* inputs,
+    IndexType outRowSize) {
+  const CatArrRowsInput<T, IndexType> in = inputs[blockIdx.y];
+  IndexType tid = blockIdx.x * blockDim.x + threadIdx.x;
+  IndexType stride = gridDim.x * blockDim.x;
+
+  while (tid < in.nElements) {
+    IndexType row = tid / in.rowSize;
+    IndexType col = tid - row * in.rowSize;
+    output[row * outRowSize + in.offset + col] = in.input[tid];
+    tid += stride;
+  }
+}
+
 void check_shape_except_dim(const Tensor &first, const Tensor &second,
                             int dimension, int index)
 {
@@ -314,6 +358,106 @@ void hip_parallel_cat(Tensor &out, const TensorList &inputs, int64_t dimension,
   }
 }
 
+#ifndef __HIP_PLATFORM_HCC__
+// Concatenates inputs that are dense in memory_format, like the output,
+// with CatArrayRowsCopy. In memory order, every input is a sequence of rows
+// holding its slice of dimension and the dimensions after it. The output
+// must have less than 2^31 bytes.
+void rows_cat(Tensor &out, const TensorList &inputs, int64_t dimension,
+              c10::MemoryFormat memory_format) {
+  // Dimensions from outermost to innermost in memory
+  std::vector<int64_t> order(out.dim());
+  std::iota(order.begin(), order.end(), 0);
+  if (memory_format != c10::MemoryFormat::Contiguous) {
+    std::rotate(order.begin() + 1, order.begin() + 2, order.end());
+  }
+  int64_t inner = 1;
+  for (auto it = order.rbegin(); *it != dimension; ++it) {
+    inner *= out.size(*it);
+  }
+
+  // Pick the widest unit that divides everything the kernel indexes with
+  const int64_t element_size = out.element_size();
+  auto uintptr = [](const void* ptr) {
+    return reinterpret_cast<uintptr_t>(ptr);
+  };
+  uintptr_t alignment = uintptr(out.data_ptr()) | (out.size(dimension) * inner * element_size);
+  int64_t offset = 0;
+  for (const Tensor& t : inputs) {
+    if (t.numel() == 0) {
+      continue;
+    }
+    alignment |= uintptr(t.data_ptr()) | (offset * inner * element_size) |
+        (t.size(dimension) * inner * element_size);
+    offset += t.size(dimension);
+  }
+  int unit = 16;
+  while (alignment % unit != 0) {
+    unit /= 2;
+  }
+
+  auto descriptors_storage = at::empty(
+      {static_cast<int64_t>(inputs.size() * sizeof(CatArrRowsInput<char, unsigned int>))},
+      out.options().dtype(at::kByte).device(at::kCPU).pinned_memory(true));
+  auto descriptors =
+      static_cast<CatArrRowsInput<char, unsigned int>*>(descriptors_storage.data_ptr());
+  unsigned int maxElements = 0;
+  offset = 0;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    const Tensor& t = inputs[i];
+    // There is a legacy case where a 1-D empty tensor can be concat with
+    // high-dimensional tensor
+    const int64_t dimSize = t.numel() > 0 ? t.size(dimension) : 0;
+    descriptors[i].input = static_cast<const char*>(t.data_ptr());
+    descriptors[i].offset = offset * inner * element_size / unit;
+    descriptors[i].rowSize = std::max<int64_t>(dimSize * inner * element_size / unit, 1);
+    descriptors[i].nElements = t.nbytes() / unit;
+    maxElements = std::max(maxElements, descriptors[i].nElements);
+    offset += dimSize;
+  }
+  auto d_descriptors_storage = at::empty_like(descriptors_storage, out.options().dtype(at::kByte));
+  at::native::copy_(d_descriptors_storage, descriptors_storage, /* non_blocking= */ true);
+  auto d_descriptors = d_descriptors_storage.data_ptr();
+  const unsigned int outRowSize = out.size(dimension) * inner * element_size / unit;
+
+  at::cuda::CUDAStream stream = at::cuda::getCurrentCUDAStream();
+  dim3 applyBlock = dim3(32*16);
+  const int numSM = at::cuda::getCurrentDeviceProperties()->multiProcessorCount;
+  // Small inputs don't need the 2 blocks per SM of getCatGrid
+  const unsigned int gridX = std::min<int64_t>(
+      2LL * numSM, std::max<int64_t>(THCCeilDiv<int64_t>(maxElements, applyBlock.x), 1));
+  const int64_t maxGridY = at::cuda::getCurrentDeviceProperties()->maxGridSize[1];
+
+  for (int64_t i = 0; i < inputs.size(); i += maxGridY) {
+    dim3 catGrid(gridX, std::min<int64_t>(inputs.size() - i, maxGridY));
+#define HANDLE_CASE(T) \
+    CatArrayRowsCopy<T, unsigned int><<<catGrid, applyBlock, 0, stream.stream()>>>( \
+        static_cast<T*>(out.data_ptr()), \
+        static_cast<const CatArrRowsInput<T, unsigned int>*>(d_descriptors) + i, \
+        outRowSize); \
+    C10_CUDA_KERNEL_LAUNCH_CHECK();
+    switch (unit) {
+      case 16:
+        HANDLE_CASE(uint4);
+        break;
+      case 8:
+        HANDLE_CASE(uint2);
+        break;
+      case 4:
+        HANDLE_CASE(uint32_t);
+        break;
+      case 2:
+        HANDLE_CASE(uint16_t);
+        break;
+      default:
+        HANDLE_CASE(uint8_t);
+        break;
+    }
+#undef HANDLE_CASE
+  }
+}
+#endif
+
 template <typename scalar_t, int batch_size, int stride_size>
 void parallel_cat(Tensor &out, const TensorList &inputs, int64_t dimension,
                   int nDims, c10::MemoryFormat memory_format) {
@@ -572,7 +716,22 @@ Tensor& cat_out_cuda(Tensor& out, TensorList inputs, int64_t dimension) {
   // memory. Therefore, we could pass more inputs to cuda threads.
   // For non-contiguous, we reduce the number of inputs passed to cuda kernel due to the limitation
   // of constant memory.
+  // Many inputs would take several launches of CatArrayBatchedCopy, which
+  // passes the descriptors of its inputs as kernel arguments, and more than
+  // 4 dimensions would take a copy per input. When the inputs and the output
+  // are dense in the same memory format, they are copied in one launch.
+  const bool allDense = out.is_contiguous(memory_format) &&
+    std::all_of(inputs.begin(), inputs.end(),
+      [&](const Tensor& t) {
+        return should_skip(t) || t.is_contiguous(memory_format);
+      });
   if (inputs.size() > 1 &&
+      (inputs.size() > CAT_ARRAY_BATCH_SIZE || out.dim() > CAT_ARRAY_MAX_INPUT_DIMS) &&
+      out.nbytes() <= std::numeric_limits<int32_t>::max() &&
+      allDense &&
+      allSameType) {
+    rows_cat(out, inputs, dimension, memory_format);
+  } else if (inputs.size() > 1 &&
       out.dim() <= CAT_ARRAY_MAX_INPUT_DIMS &&
       at::cuda::detail::canUse32BitIndexMath(out) &&
       allContiguous &&
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/cuda/CUDAContext.h>
+#include <ATen/native/cuda/SortingRadixSelect.cuh>
+#include <c10/cuda/CUDACachingAllocator.h>
+#include <c10/cuda/CUDAException.h>
+
+#include <cub/cub.cuh>
+
+#include <limits>
+
+namespace at {
+namespace native {
+
+namespace {
+
+// Offset of the first element of a row
+struct SegmentOffsetOp {
+  __host__ __device__ __forceinline__ int operator()(int row) const {
+    return row * rowSize;
+  }
+  int rowSize;
+};
+
+// Converts the values to radix keys that sort like them, NaNs last, and
+// fills the indices within each row
+template <typename scalar_t, typename RadixType>
+__global__ void segmentedSortPrepare(
+    const scalar_t* __restrict__ values,
+    RadixType* __restrict__ keys,
+    int64_t* __restrict__ indices,
+    int numel,
+    int rowSize) {
+  for (int i = blockIdx.x * blockDim.x + threadIdx.x; i < numel;
+       i += blockDim.x * gridDim.x) {
+    keys[i] = TopKTypeConfig<scalar_t>::convert(values[i]);
+    indices[i] = i % rowSize;
+  }
+}
+
+template <typename scalar_t>
+__global__ void segmentedSortGather(
+    const scalar_t* __restrict__ values,
+    const int64_t* __restrict__ indices,
+    scalar_t* __restrict__ sorted,
+    int numel,
+    int rowSize) {
+  for (int i = blockIdx.x * blockDim.x + threadIdx.x; i < numel;
+       i += blockDim.x * gridDim.x) {
+    sorted[i] = values[i - i % rowSize + indices[i]];
+  }
+}
+
+} // namespace
+
+// Sorts each row of the contiguous 2-D tensor self with a segmented radix
+// sort, which handles any row length and many rows in one pass over the
+// data, unlike the bitonic sort of a row per block. Ties keep their order.
+// sorted and indices must be contiguous with the same size as self, which
+// must have less than 2^31 elements.
+template <typename scalar_t>
+void segmentedSort(
+    const Tensor& self,
+    const Tensor& sorted,
+    const Tensor& indices,
+    bool descending) {
+  using RadixType = typename TopKTypeConfig<scalar_t>::RadixType;
+  TORCH_INTERNAL_ASSERT(self.dim() == 2 && self.is_contiguous());
+  TORCH_INTERNAL_ASSERT(self.numel() <= std::numeric_limits<int>::max());
+  const int numel = self.numel();
+  if (numel == 0) {
+    return;
+  }
+  const int numRows = self.size(0);
+  const int rowSize = self.size(1);
+
+  cudaStream_t stream = at::cuda::getCurrentCUDAStream();
+  auto& allocator = *c10::cuda::CUDACachingAllocator::get();
+  auto keys = allocator.allocate(2 * numel * sizeof(RadixType));
+  auto keysIn = static_cast<RadixType*>(keys.get());
+  auto keysOut = keysIn + numel;
+  auto indicesIn = at::empty_like(indices);
+
+  const int block = 512;
+  const int grid = std::min<int64_t>(
+      (numel + block - 1) / block,
+      at::cuda::getCurrentDeviceProperties()->multiProcessorCount * 4);
+  segmentedSortPrepare<scalar_t, RadixType><<<grid, block, 0, stream>>>(
+      self.data_ptr<scalar_t>(), keysIn, indicesIn.data_ptr<int64_t>(),
+      numel, rowSize);
+  C10_CUDA_KERNEL_LAUNCH_CHECK();
+
+  cub::CountingInputIterator<int> rows(0);
+  cub::TransformInputIterator<int, SegmentOffsetOp, cub::CountingInputIterator<int>>
+      offsets(rows, SegmentOffsetOp{rowSize});
+  // The keys of the narrower types fit in their low bits
+  const int endBit = std::min(sizeof(scalar_t), sizeof(RadixType)) * 8;
+
+  size_t tempBytes = 0;
+  auto run = [&](void* temp) {
+    if (descending) {
+      AT_CUDA_CHECK(cub::DeviceSegmentedRadixSort::SortPairsDescending(
+          temp, tempBytes, keysIn, keysOut,
+          indicesIn.data_ptr<int64_t>(), indices.data_ptr<int64_t>(),
+          numel, numRows, offsets, offsets + 1, 0, endBit, stream));
+    } else {
+      AT_CUDA_CHECK(cub::DeviceSegmentedRadixSort::SortPairs(
+          temp, tempBytes, keysIn, keysOut,
+          indicesIn.data_ptr<int64_t>(), indices.data_ptr<int64_t>(),
+          numel, numRows, offsets, offsets + 1, 0, endBit, stream));
+    }
+  };
+  run(nullptr);
+  auto temp = allocator.allocate(tempBytes);
+  run(temp.get());
+
+  // Gathers rather than converts back the keys, which would lose the
+  // payload of NaNs
+  segmentedSortGather<scalar_t><<<grid, block, 0, stream>>>(
+      self.data_ptr<scalar_t>(), indices.data_ptr<int64_t>(),
+      sorted.data_ptr<scalar_t>(), numel, rowSize);
+  C10_CUDA_KERNEL_LAUNCH_CHECK();
+}
+
+} // namespace native
+} // namespace at
@@ -22,6 +22,9 @@
 #include <cufftXt.h>
 
 #include <cmath>
+#include <map>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 
@@ -228,6 +231,41 @@ static void exec_cufft_plan(
 // tensors being contiguous, and that the strides at the innermost signal
 // dimension being unit (1) w.r.t. the corresponding data type.
 
+// cuFFT workspaces
+// Plans are created without auto allocation, so they don't hold a workspace.
+// Instead, every stream has one workspace, grown to the largest size needed
+// by a plan executed on it, which all plans share. Plans executed on the
+// same stream can't run concurrently, and the workspace is only replaced by
+// a larger one in stream order, so sharing it is safe. This keeps the memory
+// used by workspaces independent of the size of the plan cache, and avoids
+// an allocation per transform.
+// Leaked, so that the workspaces aren't freed after the allocator at exit.
+static auto& cufft_workspaces = *new std::map<std::pair<DeviceIndex, StreamId>, Tensor>();
+static std::mutex cufft_workspaces_mutex;
+
+static Tensor cufft_get_workspace(int64_t size) {
+  const auto stream = at::cuda::getCurrentCUDAStream();
+  std::lock_guard<std::mutex> guard(cufft_workspaces_mutex);
+  Tensor& workspace = cufft_workspaces[{stream.device_index(), stream.id()}];
+  if (!workspace.defined() || workspace.numel() < size) {
+    // Release the old workspace first, so that the allocator can reuse it.
+    workspace.reset();
+    workspace = at::empty({size}, at::device(stream.device()).dtype(at::kByte));
+  }
+  return workspace;
+}
+
+static void cufft_release_workspaces(int64_t device_index) {
+  std::lock_guard<std::mutex> guard(cufft_workspaces_mutex);
+  for (auto it = cufft_workspaces.begin(); it != cufft_workspaces.end();) {
+    if (it->first.first == device_index) {
+      it = cufft_workspaces.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 static inline Tensor _run_cufft(
     const CuFFTConfig &config, Tensor& input, int64_t signal_ndim,
     bool complex_input, bool complex_output, bool inverse,
@@ -247,7 +285,7 @@ static inline Tensor _run_cufft(
   // set to current stream
   CUFFT_CHECK(cufftSetStream(plan, at::cuda::getCurrentCUDAStream()));
 
-  auto ws = at::empty({ config.workspace_size() }, at::device(at::kCUDA).dtype(at::kByte));
+  auto ws = cufft_get_workspace(config.workspace_size());
   CUFFT_CHECK(cufftSetWorkArea(plan, ws.data_ptr()));
 
   // run
@@ -330,12 +368,33 @@ int64_t cufft_get_plan_cache_size_impl(int64_t device_index) {
   return cufft_get_plan_cache(device_index).size();
 }
 
+int64_t cufft_get_plan_cache_hits_impl(int64_t device_index) {
+  TORCH_CHECK(0 <= device_index && device_index < at::detail::getCUDAHooks().getNumGPUs(),
+    "cufft_get_plan_cache_hits: expected 0 <= device_index < ",
+    at::detail::getCUDAHooks().getNumGPUs(), "], but got device_index=",
+    device_index);
+  auto& plan_cache = cufft_get_plan_cache(device_index);
+  std::lock_guard<std::mutex> guard(plan_cache.mutex);
+  return plan_cache.hits();
+}
+
+int64_t cufft_get_plan_cache_misses_impl(int64_t device_index) {
+  TORCH_CHECK(0 <= device_index && device_index < at::detail::getCUDAHooks().getNumGPUs(),
+    "cufft_get_plan_cache_misses: expected 0 <= device_index < ",
+    at::detail::getCUDAHooks().getNumGPUs(), "], but got device_index=",
+    device_index);
+  auto& plan_cache = cufft_get_plan_cache(device_index);
+  std::lock_guard<std::mutex> guard(plan_cache.mutex);
+  return plan_cache.misses();
+}
+
 void cufft_clear_plan_cache_impl(int64_t device_index) {
   TORCH_CHECK(0 <= device_index && device_index < at::detail::getCUDAHooks().getNumGPUs(),
     "cufft_clear_plan_cache: expected 0 <= device_index < ",
     at::detail::getCUDAHooks().getNumGPUs(), "], but got device_index=",
     device_index);
-  return cufft_get_plan_cache(device_index).clear();
+  cufft_get_plan_cache(device_index).clear();
+  cufft_release_workspaces(device_index);
 }
 
 } // namespace at::native::detail
@@ -422,7 +481,7 @@ static Tensor& _exec_fft(Tensor& out, const Tensor& self, IntArrayRef out_sizes,
 
   // prepare cufft for execution
   CUFFT_CHECK(cufftSetStream(plan, at::cuda::getCurrentCUDAStream()));
-  auto workspace = at::empty({ config->workspace_size() }, at::device(at::kCUDA).dtype(at::kByte));
+  auto workspace = cufft_get_workspace(config->workspace_size());
   CUFFT_CHECK(cufftSetWorkArea(plan, workspace.data_ptr()));
 
   // execute transform plan
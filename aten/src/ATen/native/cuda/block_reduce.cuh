@@ -17,6 +17,16 @@ __inline__ __device__ T WarpReduceSum(T val) {
   return val;
 }
 
+// Sums val over the warp, leaving the result in all of its lanes
+template <typename T>
+__inline__ __device__ T WarpAllReduceSum(T val) {
+#pragma unroll
+  for (int offset = (C10_WARP_SIZE >> 1); offset > 0; offset >>= 1) {
+    val += WARP_SHFL_XOR(val, offset);
+  }
+  return val;
+}
+
 template <typename T>
 __inline__ __device__ T BlockReduceSum(T val, T* shared) {
   const int lid = threadIdx.x % C10_WARP_SIZE;
@@ -2,15 +2,19 @@
 
 #include <ATen/ATen.h>
 #include <ATen/AccumulateType.h>
+#include <ATen/CUDAGeneratorImpl.h>
 #include <ATen/Dispatch.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/cuda/CUDAApplyUtils.cuh>
+#include <ATen/cuda/CUDAGraphsUtils.cuh>
 #include <ATen/cuda/detail/IndexUtils.cuh>
 #include <ATen/native/cuda/block_reduce.cuh>
 #include <THC/THCDeviceUtils.cuh>
 
 #include <c10/cuda/CUDAMathCompat.h>
 
+#include <curand_kernel.h>
+
 namespace at {
 namespace native {
 
@@ -19,6 +23,226 @@ namespace {
 constexpr int kCUDANumThreads = 256;
 constexpr int kColwiseReduceTileSize = 32;
 
+// Rows of up to kFusedMaxColsPerThread * C10_WARP_SIZE elements are handled
+// by a warp each, and rows whose accumulation values fit in
+// kFusedBlockRowMaxBytes by a block each. The row is kept in registers or
+// shared memory, so that it is read once instead of once per pass.
+constexpr int kFusedMaxColsPerThread = 32;
+constexpr int kFusedRowsPerBlock = 4;
+constexpr int64_t kFusedBlockRowMaxBytes = 32 * 1024;
+
+template <typename T>
+struct FusedLayerNormParams {
+  using T_ACC = acc_type<T, true>;
+  int64_t M = 0;
+  int64_t N = 0;
+  T_ACC eps = 0;
+  const T* X = nullptr;
+  // Added to X after the dropout, if not null
+  const T* residual = nullptr;
+  const T* gamma = nullptr;
+  const T* beta = nullptr;
+  // The dropout is applied when mask is not null, with keep probability p
+  uint8_t* mask = nullptr;
+  T_ACC p = 1;
+  PhiloxCudaState philox_args;
+  // The input of the normalization, dropout(X) + residual, if not null
+  T* H = nullptr;
+  T* Y = nullptr;
+  T* mean = nullptr;
+  T* rstd = nullptr;
+};
+
+template <typename T>
+__device__ __forceinline__ acc_type<T, true> FusedLayerNormLoad(
+    const FusedLayerNormParams<T>& params,
+    int64_t index,
+    curandStatePhilox4_32_10_t* state) {
+  using T_ACC = acc_type<T, true>;
+  T_ACC x = static_cast<T_ACC>(params.X[index]);
+  if (params.mask != nullptr) {
+    const bool keep = curand_uniform(state) < params.p;
+    params.mask[index] = keep;
+    x = keep ? x / params.p : T_ACC(0);
+  }
+  if (params.residual != nullptr) {
+    x += static_cast<T_ACC>(params.residual[index]);
+  }
+  if (params.H != nullptr) {
+    // Normalizes the values that are stored, which the backward sees
+    const T h = static_cast<T>(x);
+    params.H[index] = h;
+    x = static_cast<T_ACC>(h);
+  }
+  return x;
+}
+
+template <typename T>
+__device__ __forceinline__ void FusedLayerNormStore(
+    const FusedLayerNormParams<T>& params,
+    int64_t i,
+    int64_t j,
+    acc_type<T, true> x,
+    acc_type<T, true> mean,
+    acc_type<T, true> rstd) {
+  using T_ACC = acc_type<T, true>;
+  const T_ACC gamma_v =
+      params.gamma == nullptr ? T_ACC(1) : static_cast<T_ACC>(params.gamma[j]);
+  const T_ACC beta_v =
+      params.beta == nullptr ? T_ACC(0) : static_cast<T_ACC>(params.beta[j]);
+  params.Y[i * params.N + j] = (x - mean) * rstd * gamma_v + beta_v;
+}
+
+// One warp per row, blockDim = (C10_WARP_SIZE, kFusedRowsPerBlock).
+// The variance is computed from the deviations to the mean, which the row
+// in registers makes free.
+template <typename T, int kColsPerThread>
+__global__ void FusedLayerNormWarpCUDAKernel(FusedLayerNormParams<T> params) {
+  using T_ACC = acc_type<T, true>;
+  const int64_t i = blockIdx.x * blockDim.y + threadIdx.y;
+  if (i >= params.M) {
+    return;
+  }
+  const int64_t N = params.N;
+  curandStatePhilox4_32_10_t state;
+  if (params.mask != nullptr) {
+    auto seeds = at::cuda::philox::unpack(params.philox_args);
+    curand_init(
+        std::get<0>(seeds),
+        i * C10_WARP_SIZE + threadIdx.x,
+        std::get<1>(seeds),
+        &state);
+  }
+  T_ACC vals[kColsPerThread];
+  T_ACC sum = 0;
+#pragma unroll
+  for (int k = 0; k < kColsPerThread; ++k) {
+    const int64_t j = threadIdx.x + k * C10_WARP_SIZE;
+    vals[k] = j < N ? FusedLayerNormLoad(params, i * N + j, &state) : T_ACC(0);
+    sum += vals[k];
+  }
+  const T_ACC mean =
+      cuda_utils::WarpAllReduceSum(sum) / static_cast<T_ACC>(N);
+  T_ACC sum_sq = 0;
+#pragma unroll
+  for (int k = 0; k < kColsPerThread; ++k) {
+    const int64_t j = threadIdx.x + k * C10_WARP_SIZE;
+    if (j < N) {
+      sum_sq += (vals[k] - mean) * (vals[k] - mean);
+    }
+  }
+  const T_ACC rstd = c10::cuda::compat::rsqrt(
+      cuda_utils::WarpAllReduceSum(sum_sq) / static_cast<T_ACC>(N) +
+      params.eps);
+  if (threadIdx.x == 0) {
+    params.mean[i] = mean;
+    params.rstd[i] = rstd;
+  }
+#pragma unroll
+  for (int k = 0; k < kColsPerThread; ++k) {
+    const int64_t j = threadIdx.x + k * C10_WARP_SIZE;
+    if (j < N) {
+      FusedLayerNormStore(params, i, j, vals[k], mean, rstd);
+    }
+  }
+}
+
+// One block per row, which is kept in N accumulation values of dynamic
+// shared memory
+template <typename T>
+__global__ void FusedLayerNormBlockCUDAKernel(FusedLayerNormParams<T> params) {
+  using T_ACC = acc_type<T, true>;
+  extern __shared__ char row_shared[];
+  __shared__ T_ACC reduce_shared[C10_WARP_SIZE];
+  __shared__ T_ACC stat_shared;
+  T_ACC* row = reinterpret_cast<T_ACC*>(row_shared);
+  const int64_t i = blockIdx.x;
+  const int64_t N = params.N;
+  curandStatePhilox4_32_10_t state;
+  if (params.mask != nullptr) {
+    auto seeds = at::cuda::philox::unpack(params.philox_args);
+    curand_init(
+        std::get<0>(seeds),
+        i * blockDim.x + threadIdx.x,
+        std::get<1>(seeds),
+        &state);
+  }
+  T_ACC sum = 0;
+  for (int64_t j = threadIdx.x; j < N; j += blockDim.x) {
+    row[j] = FusedLayerNormLoad(params, i * N + j, &state);
+    sum += row[j];
+  }
+  sum = cuda_utils::BlockReduceSum<T_ACC>(sum, reduce_shared);
+  if (threadIdx.x == 0) {
+    stat_shared = sum / static_cast<T_ACC>(N);
+  }
+  __syncthreads();
+  const T_ACC mean = stat_shared;
+  // Each thread reads back the values it wrote
+  T_ACC sum_sq = 0;
+  for (int64_t j = threadIdx.x; j < N; j += blockDim.x) {
+    sum_sq += (row[j] - mean) * (row[j] - mean);
+  }
+  sum_sq = cuda_utils::BlockReduceSum<T_ACC>(sum_sq, reduce_shared);
+  if (threadIdx.x == 0) {
+    const T_ACC rstd = c10::cuda::compat::rsqrt(
+        sum_sq / static_cast<T_ACC>(N) + params.eps);
+    stat_shared = rstd;
+    params.mean[i] = mean;
+    params.rstd[i] = rstd;
+  }
+  __syncthreads();
+  const T_ACC rstd = stat_shared;
+  for (int64_t j = threadIdx.x; j < N; j += blockDim.x) {
+    FusedLayerNormStore(params, i, j, row[j], mean, rstd);
+  }
+}
+
+template <typename T>
+bool CanUseFusedLayerNorm(int64_t N) {
+  return N <= kFusedMaxColsPerThread * C10_WARP_SIZE ||
+      N * static_cast<int64_t>(sizeof(acc_type<T, true>)) <=
+      kFusedBlockRowMaxBytes;
+}
+
+// Number of elements of a row that each thread of the fused kernels handles
+inline int64_t FusedLayerNormColsPerThread(int64_t N) {
+  const int64_t num_threads = N <= kFusedMaxColsPerThread * C10_WARP_SIZE
+      ? C10_WARP_SIZE
+      : kCUDANumThreads;
+  return (N + num_threads - 1) / num_threads;
+}
+
+template <typename T>
+void LaunchFusedLayerNorm(const FusedLayerNormParams<T>& params) {
+  using T_ACC = acc_type<T, true>;
+  const int64_t N = params.N;
+  cudaStream_t cuda_stream = at::cuda::getCurrentCUDAStream();
+  if (N <= kFusedMaxColsPerThread * C10_WARP_SIZE) {
+    const int64_t B = (params.M + kFusedRowsPerBlock - 1) / kFusedRowsPerBlock;
+    const dim3 threads(C10_WARP_SIZE, kFusedRowsPerBlock);
+    if (N <= 4 * C10_WARP_SIZE) {
+      FusedLayerNormWarpCUDAKernel<T, 4>
+          <<<B, threads, 0, cuda_stream>>>(params);
+    } else if (N <= 8 * C10_WARP_SIZE) {
+      FusedLayerNormWarpCUDAKernel<T, 8>
+          <<<B, threads, 0, cuda_stream>>>(params);
+    } else if (N <= 16 * C10_WARP_SIZE) {
+      FusedLayerNormWarpCUDAKernel<T, 16>
+          <<<B, threads, 0, cuda_stream>>>(params);
+    } else {
+      FusedLayerNormWarpCUDAKernel<T, kFusedMaxColsPerThread>
+          <<<B, threads, 0, cuda_stream>>>(params);
+    }
+    C10_CUDA_KERNEL_LAUNCH_CHECK();
+  } else {
+    FusedLayerNormBlockCUDAKernel<T>
+        <<<params.M, kCUDANumThreads, N * sizeof(T_ACC), cuda_stream>>>(
+            params);
+    C10_CUDA_KERNEL_LAUNCH_CHECK();
+  }
+}
+
 template <typename T>
 __global__ void RowwiseMomentsCUDAKernel(
     int64_t N,
@@ -147,6 +371,87 @@ __global__ void LayerNormBackwardCUDAKenrel(
   }
 }
 
+// dX of rows of up to kFusedMaxColsPerThread * C10_WARP_SIZE elements, one
+// warp per row, which computes the row sums of ComputeInternalGradients and
+// then dX from the values it kept in registers
+template <typename T, int kColsPerThread>
+__global__ void FusedLayerNormBackwardWarpCUDAKernel(
+    int64_t M,
+    int64_t N,
+    const T* dY,
+    const T* X,
+    const T* mean,
+    const T* rstd,
+    const T* gamma,
+    T* dX) {
+  using T_ACC = acc_type<T, true>;
+  const int64_t i = blockIdx.x * blockDim.y + threadIdx.y;
+  if (i >= M) {
+    return;
+  }
+  T_ACC dy_gamma[kColsPerThread];
+  T_ACC x[kColsPerThread];
+  T_ACC ds = 0;
+  T_ACC db = 0;
+#pragma unroll
+  for (int k = 0; k < kColsPerThread; ++k) {
+    const int64_t j = threadIdx.x + k * C10_WARP_SIZE;
+    dy_gamma[k] = 0;
+    x[k] = 0;
+    if (j < N) {
+      const T_ACC gamma_v =
+          gamma == nullptr ? T_ACC(1) : static_cast<T_ACC>(gamma[j]);
+      dy_gamma[k] = static_cast<T_ACC>(dY[i * N + j]) * gamma_v;
+      x[k] = static_cast<T_ACC>(X[i * N + j]);
+    }
+    ds += dy_gamma[k] * x[k];
+    db += dy_gamma[k];
+  }
+  ds = cuda_utils::WarpAllReduceSum(ds);
+  db = cuda_utils::WarpAllReduceSum(db);
+  const T_ACC mean_v = static_cast<T_ACC>(mean[i]);
+  const T_ACC rstd_v = static_cast<T_ACC>(rstd[i]);
+  const T_ACC s = T_ACC(1) / static_cast<T_ACC>(N);
+  const T_ACC b = (db * mean_v - ds) * rstd_v * rstd_v * rstd_v * s;
+  const T_ACC c = -(b * mean_v + db * rstd_v * s);
+#pragma unroll
+  for (int k = 0; k < kColsPerThread; ++k) {
+    const int64_t j = threadIdx.x + k * C10_WARP_SIZE;
+    if (j < N) {
+      dX[i * N + j] = rstd_v * dy_gamma[k] + b * x[k] + c;
+    }
+  }
+}
+
+template <typename T>
+void LaunchFusedLayerNormBackward(
+    int64_t M,
+    int64_t N,
+    const T* dY,
+    const T* X,
+    const T* mean,
+    const T* rstd,
+    const T* gamma,
+    T* dX) {
+  cudaStream_t cuda_stream = at::cuda::getCurrentCUDAStream();
+  const int64_t B = (M + kFusedRowsPerBlock - 1) / kFusedRowsPerBlock;
+  const dim3 threads(C10_WARP_SIZE, kFusedRowsPerBlock);
+  if (N <= 4 * C10_WARP_SIZE) {
+    FusedLayerNormBackwardWarpCUDAKernel<T, 4>
+        <<<B, threads, 0, cuda_stream>>>(M, N, dY, X, mean, rstd, gamma, dX);
+  } else if (N <= 8 * C10_WARP_SIZE) {
+    FusedLayerNormBackwardWarpCUDAKernel<T, 8>
+        <<<B, threads, 0, cuda_stream>>>(M, N, dY, X, mean, rstd, gamma, dX);
+  } else if (N <= 16 * C10_WARP_SIZE) {
+    FusedLayerNormBackwardWarpCUDAKernel<T, 16>
+        <<<B, threads, 0, cuda_stream>>>(M, N, dY, X, mean, rstd, gamma, dX);
+  } else {
+    FusedLayerNormBackwardWarpCUDAKernel<T, kFusedMaxColsPerThread>
+        <<<B, threads, 0, cuda_stream>>>(M, N, dY, X, mean, rstd, gamma, dX);
+  }
+  C10_CUDA_KERNEL_LAUNCH_CHECK();
+}
+
 template <typename T>
 __global__ void GammaBetaBackwardSimpleCUDAKernel(
     int64_t M,
@@ -274,6 +579,20 @@ void LayerNormKernelImplInternal(
   T* Y_data = Y->data_ptr<T>();
   T* mean_data = mean->data_ptr<T>();
   T* rstd_data = rstd->data_ptr<T>();
+  if (CanUseFusedLayerNorm<T>(N)) {
+    FusedLayerNormParams<T> params;
+    params.M = M;
+    params.N = N;
+    params.eps = eps;
+    params.X = X_data;
+    params.gamma = gamma_data;
+    params.beta = beta_data;
+    params.Y = Y_data;
+    params.mean = mean_data;
+    params.rstd = rstd_data;
+    LaunchFusedLayerNorm<T>(params);
+    return;
+  }
   cudaStream_t cuda_stream = at::cuda::getCurrentCUDAStream();
   RowwiseMomentsCUDAKernel<T>
       <<<M, cuda_utils::kCUDABlockReduceNumThreads, 0, cuda_stream>>>(
@@ -327,7 +646,10 @@ void LayerNormBackwardKernelImplInternal(
       gamma.defined() ? gamma.template data_ptr<T>() : nullptr;
   T* dX_data = dX->defined() ? dX->template data_ptr<T>() : nullptr;
   cudaStream_t cuda_stream = at::cuda::getCurrentCUDAStream();
-  if (dX_data != nullptr) {
+  if (dX_data != nullptr && N <= kFusedMaxColsPerThread * C10_WARP_SIZE) {
+    LaunchFusedLayerNormBackward<T>(
+        M, N, dY_data, X_data, mean_data, rstd_data, gamma_data, dX_data);
+  } else if (dX_data != nullptr) {
     const auto kAccType = (X.scalar_type() == kHalf || X.scalar_type() == kBFloat16) ? kFloat : X.scalar_type();
     Tensor ds = at::empty({M}, X.options().dtype(kAccType));
     Tensor db = at::empty({M}, X.options().dtype(kAccType));
@@ -420,6 +742,23 @@ void LayerNormBackwardKernelImpl(
       });
 }
 
+// Shape of the mean and rstd outputs, which keep the dimensions of input
+std::vector<int64_t> layer_norm_stat_shape(
+    const Tensor& input,
+    IntArrayRef normalized_shape) {
+  const auto input_shape = input.sizes();
+  const size_t axis = input.dim() - normalized_shape.size();
+
+  std::vector<int64_t> stat_shape;
+  for (size_t idx = 0; idx < axis; ++idx) {
+    stat_shape.push_back(input_shape[idx]);
+  }
+  for (size_t idx = axis; idx < input.dim(); ++idx) {
+    stat_shape.push_back(1);
+  }
+  return stat_shape;
+}
+
 } // namespace
 
 std::tuple<Tensor, Tensor, Tensor> layer_norm_cuda(
@@ -442,23 +781,100 @@ std::tuple<Tensor, Tensor, Tensor> layer_norm_cuda(
   if (M > 0) {
     LayerNormKernelImpl(X, gamma, beta, M, N, eps, &Y, &mean, &rstd);
 
-    const auto input_shape = input.sizes();
-    const size_t axis = input.dim() - normalized_shape.size();
-
-    std::vector<int64_t> stat_shape;
-    for (size_t idx = 0; idx < axis; ++idx) {
-      stat_shape.push_back(input_shape[idx]);
-    }
-    for (size_t idx = axis; idx < input.dim(); ++idx) {
-      stat_shape.push_back(1);
-    }
-
+    const auto stat_shape = layer_norm_stat_shape(input, normalized_shape);
     mean = mean.view(stat_shape);
     rstd = rstd.view(stat_shape);
   }
   return std::make_tuple(std::move(Y), std::move(mean), std::move(rstd));
 }
 
+std::tuple<Tensor, Tensor, Tensor, Tensor, Tensor> fused_dropout_add_layer_norm_cuda(
+    const Tensor& input,
+    const c10::optional<Tensor>& residual_opt,
+    IntArrayRef normalized_shape,
+    const c10::optional<Tensor>& weight_opt,
+    const c10::optional<Tensor>& bias_opt,
+    double p,
+    double eps,
+    c10::optional<Generator> gen_) {
+  const Tensor& residual = c10::value_or_else(residual_opt, [] {return Tensor();});
+  const Tensor& weight = c10::value_or_else(weight_opt, [] {return Tensor();});
+  const Tensor& bias = c10::value_or_else(bias_opt, [] {return Tensor();});
+  TORCH_CHECK(
+      p > 0 && p <= 1,
+      "_fused_dropout_add_layer_norm: expected a keep probability p in (0, 1], but got ",
+      p);
+  TORCH_CHECK(
+      !residual.defined() ||
+          (residual.sizes().equals(input.sizes()) &&
+           residual.scalar_type() == input.scalar_type()),
+      "_fused_dropout_add_layer_norm: expected residual of the same size and dtype as input, but got ",
+      "residual of size ", residual.sizes(), " and input of size ", input.sizes());
+
+  auto inputs = _prepare_layer_norm_inputs(input, normalized_shape, weight, bias);
+  auto X = std::get<0>(inputs);
+  auto gamma = std::get<1>(inputs);
+  auto beta = std::get<2>(inputs);
+  auto M = std::get<3>(inputs);
+  auto N = std::get<4>(inputs);
+  const Tensor R = residual.defined() ? residual.contiguous() : residual;
+
+  Tensor Y = at::native::empty_like(X, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  Tensor H = at::native::empty_like(X, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  Tensor mask = at::empty_like(X, X.options().dtype(kByte), LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  Tensor mean = at::empty({M}, X.options());
+  Tensor rstd = at::empty({M}, X.options());
+  if (M == 0) {
+    return std::make_tuple(std::move(Y), std::move(H), std::move(mask), std::move(mean), std::move(rstd));
+  }
+
+  auto gen = get_generator_or_default<CUDAGeneratorImpl>(gen_, cuda::detail::getDefaultCUDAGenerator());
+  bool fused = false;
+  AT_DISPATCH_FLOATING_TYPES_AND2(at::ScalarType::Half, at::ScalarType::BFloat16,
+      X.scalar_type(), "fused_dropout_add_layer_norm_cuda", [&]() {
+        using T_ACC = acc_type<scalar_t, true>;
+        fused = CanUseFusedLayerNorm<scalar_t>(N);
+        if (!fused) {
+          return;
+        }
+        FusedLayerNormParams<scalar_t> params;
+        params.M = M;
+        params.N = N;
+        params.eps = static_cast<T_ACC>(eps);
+        params.X = X.data_ptr<scalar_t>();
+        params.residual = R.defined() ? R.data_ptr<scalar_t>() : nullptr;
+        params.gamma = gamma.defined() ? gamma.data_ptr<scalar_t>() : nullptr;
+        params.beta = beta.defined() ? beta.data_ptr<scalar_t>() : nullptr;
+        params.mask = mask.data_ptr<uint8_t>();
+        params.p = static_cast<T_ACC>(p);
+        params.H = H.data_ptr<scalar_t>();
+        params.Y = Y.data_ptr<scalar_t>();
+        params.mean = mean.data_ptr<scalar_t>();
+        params.rstd = rstd.data_ptr<scalar_t>();
+        // Each thread draws one number per element it handles, 4 at a time
+        const int64_t counter_offset =
+            (FusedLayerNormColsPerThread(N) + 3) / 4 * 4;
+        {
+          // See Note [Acquire lock when using random generators]
+          std::lock_guard<std::mutex> lock(gen->mutex_);
+          params.philox_args = gen->philox_cuda_state(counter_offset);
+        }
+        LaunchFusedLayerNorm<scalar_t>(params);
+      });
+  if (!fused) {
+    // The rows are too long to be kept on chip
+    auto dropout = at::_fused_dropout(X, p, gen_);
+    H = R.defined() ? std::get<0>(dropout).add_(R) : std::get<0>(dropout);
+    mask = std::get<1>(dropout);
+    LayerNormKernelImpl(H, gamma, beta, M, N, eps, &Y, &mean, &rstd);
+  }
+
+  const auto stat_shape = layer_norm_stat_shape(input, normalized_shape);
+  mean = mean.view(stat_shape);
+  rstd = rstd.view(stat_shape);
+  return std::make_tuple(std::move(Y), std::move(H), std::move(mask), std::move(mean), std::move(rstd));
+}
+
 std::tuple<Tensor, Tensor, Tensor> layer_norm_backward_cuda(
     const Tensor& dY,
     const Tensor& input,
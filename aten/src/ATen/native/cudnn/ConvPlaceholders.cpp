@@ -93,6 +93,14 @@ void raw_cudnn_convolution_backward_weight_out(
   AT_ERROR("raw_cudnn_convolution_backward_weight_out: ATen not compiled with cuDNN support");
 }
 
+void cudnn_save_benchmark_cache(const std::string& path) {
+  AT_ERROR("cudnn_save_benchmark_cache: ATen not compiled with cuDNN support");
+}
+
+int64_t cudnn_load_benchmark_cache(const std::string& path) {
+  AT_ERROR("cudnn_load_benchmark_cache: ATen not compiled with cuDNN support");
+}
+
 #endif  // AT_CUDNN_ENABLED
 
 // ---------------------------------------------------------------------
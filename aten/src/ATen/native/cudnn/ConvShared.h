@@ -71,4 +71,17 @@ void raw_cudnn_convolution_backward_weight_out(
     IntArrayRef padding, IntArrayRef stride, IntArrayRef dilation, int64_t groups,
     bool benchmark, bool deterministic, bool allow_tf32);
 
+// ---------------------------------------------------------------------
+//
+// Benchmark cache
+//
+// ---------------------------------------------------------------------
+
+// cudnn_save_benchmark_cache writes the algorithms picked for convolutions so
+// far to path. cudnn_load_benchmark_cache adds those saved in path that were
+// not picked yet, and returns how many it added.
+// See Note [persistent cuDNN benchmark cache] in Conv_v7.cpp
+TORCH_CUDA_CPP_API void cudnn_save_benchmark_cache(const std::string& path);
+TORCH_CUDA_CPP_API int64_t cudnn_load_benchmark_cache(const std::string& path);
+
 }}
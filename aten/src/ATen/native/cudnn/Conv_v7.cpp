@@ -9,6 +9,7 @@
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/Config.h>
+#include <ATen/cuda/CUDAContext.h>
 #include <ATen/cuda/Exceptions.h>
 #include <ATen/native/cudnn/ConvShared.h>
 
@@ -23,10 +24,16 @@
 #include <iterator>
 #include <sstream>
 #include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <memory>
 #include <mutex>
 #include <stdint.h>
+#include <string>
 #include <unordered_map>
+#include <utility>
 
 // Note [behavior of cudnnFind and cudnnGet]
 // You'll notice that by default, in the ConvolutionDescriptor, we do the following:
@@ -115,12 +122,183 @@ struct BenchmarkCache {
     std::lock_guard<std::mutex> guard(mutex);
     map[params] = results;
   }
+
+  // Returns the number of entries that were not cached yet.
+  int64_t insert_missing(const std::vector<std::pair<ConvolutionParams, T>>& entries) {
+    std::lock_guard<std::mutex> guard(mutex);
+    int64_t inserted = 0;
+    for (const auto& entry : entries) {
+      inserted += map.emplace(entry.first, entry.second).second;
+    }
+    return inserted;
+  }
+
+  std::vector<std::pair<ConvolutionParams, T>> entries() {
+    std::lock_guard<std::mutex> guard(mutex);
+    return std::vector<std::pair<ConvolutionParams, T>>(map.begin(), map.end());
+  }
 };
 
 BenchmarkCache<cudnnConvolutionFwdAlgoPerf_t> fwd_algos;
 BenchmarkCache<cudnnConvolutionBwdDataAlgoPerf_t> bwd_data_algos;
 BenchmarkCache<cudnnConvolutionBwdFilterAlgoPerf_t> bwd_filter_algos;
 
+// Note [persistent cuDNN benchmark cache]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Finding the fastest algorithms for a model with cudnn.benchmark can take
+// seconds, and is repeated by every process, which may not all pick the same
+// algorithms. cudnn_save_benchmark_cache writes the three caches above to a
+// file, and cudnn_load_benchmark_cache adds the entries of such a file to
+// them, so that a profiling run can pick the algorithms once for all the
+// processes that load its file. If TORCH_CUDNN_BENCHMARK_CACHE is set, the
+// file it names is loaded before the first convolution.
+//
+// ConvolutionParams and the perf structs are plain data, and
+// setConvolutionParams zeroes their padding, so entries are stored as raw
+// bytes. The algorithms depend on the GPU and the cuDNN version, so the file
+// records both, and it is not loaded on other GPUs or cuDNN versions. The
+// layout of the structs depends on the build, so their sizes are checked too.
+
+namespace {
+
+constexpr char kBenchmarkCacheMagic[] = "TCUDNNBC";
+constexpr size_t kBenchmarkCacheMagicSize = sizeof(kBenchmarkCacheMagic) - 1;
+constexpr uint32_t kBenchmarkCacheFormatVersion = 1;
+
+std::string benchmarkCacheKey() {
+  const cudaDeviceProp* prop = at::cuda::getCurrentDeviceProperties();
+  std::ostringstream key;
+  key << prop->name << " (sm_" << prop->major << prop->minor << "), cuDNN " << cudnnGetVersion();
+  return key.str();
+}
+
+template <typename T>
+void writeRaw(std::ostream& out, const T& value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T readRaw(std::istream& in, const std::string& path) {
+  T value;
+  in.read(reinterpret_cast<char*>(&value), sizeof(T));
+  TORCH_CHECK(in, path, " is not a cuDNN benchmark cache: unexpected end of file");
+  return value;
+}
+
+bool isValidAlgo(cudnnConvolutionFwdAlgo_t algo) {
+  return algo >= 0 && algo < CUDNN_CONVOLUTION_FWD_ALGO_COUNT;
+}
+bool isValidAlgo(cudnnConvolutionBwdDataAlgo_t algo) {
+  return algo >= 0 && algo < CUDNN_CONVOLUTION_BWD_DATA_ALGO_COUNT;
+}
+bool isValidAlgo(cudnnConvolutionBwdFilterAlgo_t algo) {
+  return algo >= 0 && algo < CUDNN_CONVOLUTION_BWD_FILTER_ALGO_COUNT;
+}
+
+template <typename perf_t>
+void writeBenchmarkCache(std::ostream& out, BenchmarkCache<perf_t>& cache) {
+  const auto entries = cache.entries();
+  writeRaw<uint64_t>(out, sizeof(perf_t));
+  writeRaw<uint64_t>(out, entries.size());
+  for (const auto& entry : entries) {
+    writeRaw(out, entry.first);
+    writeRaw(out, entry.second);
+  }
+}
+
+template <typename perf_t>
+std::vector<std::pair<ConvolutionParams, perf_t>> readBenchmarkCache(std::istream& in, const std::string& path) {
+  TORCH_CHECK(readRaw<uint64_t>(in, path) == sizeof(perf_t),
+      path, " was written by a build of PyTorch with a different cuDNN");
+  const auto count = readRaw<uint64_t>(in, path);
+  std::vector<std::pair<ConvolutionParams, perf_t>> entries;
+  for (uint64_t i = 0; i < count; i++) {
+    auto params = readRaw<ConvolutionParams>(in, path);
+    auto perf = readRaw<perf_t>(in, path);
+    TORCH_CHECK(perf.status == CUDNN_STATUS_SUCCESS && isValidAlgo(perf.algo),
+        path, " is corrupt: entry ", i, " has an invalid algorithm");
+    entries.emplace_back(params, perf);
+  }
+  return entries;
+}
+
+void loadBenchmarkCacheFromEnv() {
+  static std::once_flag once;
+  std::call_once(once, [] {
+    const char* path = std::getenv("TORCH_CUDNN_BENCHMARK_CACHE");
+    if (path == nullptr || path[0] == '\0') {
+      return;
+    }
+    try {
+      cudnn_load_benchmark_cache(path);
+    } catch (const c10::Error& e) {
+      TORCH_WARN("Could not load the cuDNN benchmark cache in TORCH_CUDNN_BENCHMARK_CACHE: ", e.what_without_backtrace());
+    }
+  });
+}
+
+} // namespace
+
+void cudnn_save_benchmark_cache(const std::string& path) {
+  // Written next to path and moved over it, so that processes loading path
+  // don't see a partial file.
+  const std::string tmp_path = path + ".tmp";
+  {
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    TORCH_CHECK(out, "Could not open ", tmp_path, " for writing");
+    const std::string key = benchmarkCacheKey();
+    out.write(kBenchmarkCacheMagic, kBenchmarkCacheMagicSize);
+    writeRaw<uint32_t>(out, kBenchmarkCacheFormatVersion);
+    writeRaw<uint64_t>(out, key.size());
+    out.write(key.data(), key.size());
+    writeRaw<uint64_t>(out, sizeof(ConvolutionParams));
+    writeBenchmarkCache(out, fwd_algos);
+    writeBenchmarkCache(out, bwd_data_algos);
+    writeBenchmarkCache(out, bwd_filter_algos);
+    out.close();
+    TORCH_CHECK(out, "Could not write ", tmp_path);
+  }
+#ifdef _WIN32
+  // rename does not replace existing files on Windows
+  std::remove(path.c_str());
+#endif
+  TORCH_CHECK(std::rename(tmp_path.c_str(), path.c_str()) == 0,
+      "Could not move ", tmp_path, " to ", path);
+}
+
+int64_t cudnn_load_benchmark_cache(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  TORCH_CHECK(in, "Could not open ", path);
+  char magic[kBenchmarkCacheMagicSize];
+  in.read(magic, kBenchmarkCacheMagicSize);
+  TORCH_CHECK(in && std::memcmp(magic, kBenchmarkCacheMagic, kBenchmarkCacheMagicSize) == 0,
+      path, " is not a cuDNN benchmark cache");
+  const auto version = readRaw<uint32_t>(in, path);
+  TORCH_CHECK(version == kBenchmarkCacheFormatVersion,
+      path, " has unsupported format version ", version);
+  const auto key_size = readRaw<uint64_t>(in, path);
+  TORCH_CHECK(key_size <= 1024, path, " is corrupt: invalid key");
+  std::string key(key_size, '\0');
+  in.read(&key[0], key_size);
+  TORCH_CHECK(in, path, " is not a cuDNN benchmark cache: unexpected end of file");
+  const std::string expected_key = benchmarkCacheKey();
+  if (key != expected_key) {
+    TORCH_WARN("Not loading the cuDNN benchmark cache ", path, ": it was saved on ", key,
+               ", but this process runs on ", expected_key);
+    return 0;
+  }
+  TORCH_CHECK(readRaw<uint64_t>(in, path) == sizeof(ConvolutionParams),
+      path, " was written by a different build of PyTorch");
+  // Everything is read before anything is inserted, so that a corrupt file
+  // leaves the caches unchanged.
+  auto fwd = readBenchmarkCache<cudnnConvolutionFwdAlgoPerf_t>(in, path);
+  auto bwd_data = readBenchmarkCache<cudnnConvolutionBwdDataAlgoPerf_t>(in, path);
+  auto bwd_filter = readBenchmarkCache<cudnnConvolutionBwdFilterAlgoPerf_t>(in, path);
+  return fwd_algos.insert_missing(fwd) +
+      bwd_data_algos.insert_missing(bwd_data) +
+      bwd_filter_algos.insert_missing(bwd_filter);
+}
+
 // TODO: Stop manually allocating CUDA memory; allocate an ATen byte
 // tensor instead.
 struct Workspace {
@@ -494,6 +672,7 @@ public:
   void try_all(std::function<void (const perf_t &perf)> f) {
     bool only_use_default = args.params.deterministic && !benchmark;
 
+    loadBenchmarkCacheFromEnv();
     auto& cache = search::cache();
     perf_t algoPerf;
     if (!only_use_default && cache.find(args.params, &algoPerf)) {
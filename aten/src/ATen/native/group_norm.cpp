@@ -26,7 +26,11 @@ std::tuple<Tensor, Tensor, Tensor> native_group_norm(
     int64_t HxW,
     int64_t group,
     double eps) {
-  Tensor Y = at::native::empty_like(X, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  // The CPU kernel also runs on channels last inputs, and keeps their format
+  const auto memory_format = X.device().is_cpu()
+      ? X.suggest_memory_format()
+      : LEGACY_CONTIGUOUS_MEMORY_FORMAT;
+  Tensor Y = at::native::empty_like(X, memory_format);
   Tensor mean = at::empty({N, group}, X.options());
   Tensor rstd = at::empty({N, group}, X.options());
   GroupNormKernel(
@@ -45,11 +49,15 @@ std::tuple<Tensor, Tensor, Tensor> native_group_norm_backward(
     int64_t HxW,
     int64_t group,
     std::array<bool, 3> grad_input_mask) {
+  // The CPU kernel also runs on channels last inputs, and keeps their format
+  const auto memory_format = X.device().is_cpu()
+      ? X.suggest_memory_format()
+      : LEGACY_CONTIGUOUS_MEMORY_FORMAT;
   Tensor dX;
   Tensor dgamma;
   Tensor dbeta;
   if (grad_input_mask[0]) {
-    dX = at::native::empty_like(X, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+    dX = at::native::empty_like(X, memory_format);
   }
   if (grad_input_mask[1]) {
     dgamma = at::native::empty_like(gamma, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
@@ -59,8 +67,8 @@ std::tuple<Tensor, Tensor, Tensor> native_group_norm_backward(
   }
   GroupNormBackwardKernel(
       X.device().type(),
-      dY,
-      X,
+      dY.contiguous(memory_format),
+      X.contiguous(memory_format),
       mean,
       rstd,
       gamma,
@@ -111,7 +119,12 @@ Tensor group_norm(
       c10::multiply_integers(input_shape.cbegin() + 2, input_shape.cend());
 
   const Tensor kEmpty;
-  const auto& X = input.is_contiguous() ? input : input.contiguous();
+  const auto memory_format = input.device().is_cpu()
+      ? input.suggest_memory_format()
+      : at::MemoryFormat::Contiguous;
+  const auto& X = input.is_contiguous(memory_format)
+      ? input
+      : input.contiguous(memory_format);
   const auto& gamma = weight.defined() ? weight.contiguous() : kEmpty;
   const auto& beta = bias.defined() ? bias.contiguous() : kEmpty;
   TORCH_CHECK(!gamma.defined() || gamma.numel() == C);
@@ -69,6 +69,9 @@ TORCH_LIBRARY(metal_prepack, m) {
   m.def(
       "conv2d_run(Tensor X, "
       "__torch__.torch.classes.metal.Conv2dOpContext W_prepack) -> Tensor Y");
+  m.def(
+      "conv2d_sigmoid_run(Tensor X, "
+      "__torch__.torch.classes.metal.Conv2dOpContext W_prepack) -> Tensor Y");
 }
 
 c10::intrusive_ptr<Conv2dOpContext> conv2d_prepack(
@@ -103,6 +106,18 @@ Tensor conv2d_prepack_run(
 #endif
 }
 
+Tensor conv2d_sigmoid_prepack_run(
+    const Tensor& input,
+    const c10::intrusive_ptr<Conv2dOpContext>& op_context) {
+#if (C10_IOS || TARGET_OS_MAC)
+  return mpscnn::conv2d(input, *op_context, NeuronType::Sigmoid);
+#else
+  TORCH_CHECK(
+      false, "conv2d_sigmoid_prepack_run can only be invoked on iOS and MacOS");
+  return input;
+#endif
+}
+
 Tensor copy_to_host(const Tensor& input) {
 #if (C10_IOS || TARGET_OS_MAC)
   return mpscnn::copy_to_host(input);
@@ -118,6 +133,7 @@ TORCH_LIBRARY_IMPL(metal_prepack, CPU, m) {
 
 TORCH_LIBRARY_IMPL(metal_prepack, Metal, m) {
   m.impl("conv2d_run", conv2d_prepack_run);
+  m.impl("conv2d_sigmoid_run", conv2d_sigmoid_prepack_run);
 }
 
 TORCH_LIBRARY_IMPL(metal, Metal, m) {
@@ -18,6 +18,9 @@ Tensor conv2d(
 // conv2d with prepacked weights
 Tensor conv2d(const Tensor& input, Conv2dOpContext& context);
 
+// conv2d with prepacked weights, followed by the neuron t
+Tensor conv2d(const Tensor& input, Conv2dOpContext& context, NeuronType t);
+
 Tensor max_pool2d(
     const Tensor& input,
     IntArrayRef kernel_size,
@@ -82,6 +82,19 @@ Tensor conv2d(
 
 API_AVAILABLE(ios(10.0), macos(10.13))
 Tensor conv2d(const Tensor& input, Conv2dOpContext& context) {
+  return conv2d(input, context, neuronType(context));
+}
+
+API_AVAILABLE(ios(10.0), macos(10.13))
+Tensor conv2d(
+    const Tensor& input,
+    Conv2dOpContext& context,
+    NeuronType nt) {
+  // The neuron is baked into the cached convolution kernel, and any clamping
+  // of the context is applied on top of it.
+  TORCH_CHECK(
+      nt == neuronType(context) || neuronType(context) == NeuronType::None,
+      "The neuron can't be combined with the output range of the context.");
   MPSImage* X = imageFromTensor(input);
   Conv2DParams params{input.sizes(),
                       context.weight.sizes(),
@@ -90,7 +103,6 @@ Tensor conv2d(const Tensor& input, Conv2dOpContext& context) {
                       context.dilation,
                       context.groups};
   MPSCNNConvOp* op = (__bridge MPSCNNConvOp*)(context.conv2dOp);
-  NeuronType nt = neuronType(context);
   if (!op) {
     float* w = context.weight.data_ptr<float>();
     float* b = context.bias.has_value() ? ((*context.bias).data_ptr<float>())
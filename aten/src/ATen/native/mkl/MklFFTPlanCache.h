@@ -0,0 +1,173 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/mkl/Descriptors.h>
+#include <ATen/native/utils/ParamsHash.h>
+
+#include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace at { namespace native { namespace detail {
+
+// Transforms of more signal dimensions than this are planned every time
+constexpr int64_t mkl_fft_max_rank = 3;
+
+// This struct is used to let us easily compute hashes of the
+// parameters.
+// It will be the **key** to the plan cache.
+struct MklFFTParams
+{
+  int64_t signal_ndim_; // between 1 and mkl_fft_max_rank
+  // These include additional batch dimension as well.
+  int64_t sizes_[mkl_fft_max_rank + 1];
+  int64_t input_strides_[mkl_fft_max_rank + 1];
+  int64_t output_strides_[mkl_fft_max_rank + 1];
+  int64_t normalization_;
+  // The plan is only allowed this many threads, so a change of
+  // at::set_num_threads gets a new plan
+  int64_t num_threads_;
+  ScalarType value_type_;
+  bool complex_input_;
+  bool complex_output_;
+  bool forward_;
+
+  MklFFTParams() = default;
+
+  MklFFTParams(IntArrayRef in_strides, IntArrayRef out_strides, IntArrayRef signal_sizes,
+      bool complex_input, bool complex_output, int64_t normalization, bool forward,
+      ScalarType value_type, int64_t num_threads) {
+    // Padding bits must be zeroed for hashing
+    memset(this, 0, sizeof(*this));
+    signal_ndim_ = signal_sizes.size() - 1;
+    normalization_ = normalization;
+    num_threads_ = num_threads;
+    value_type_ = value_type;
+    complex_input_ = complex_input;
+    complex_output_ = complex_output;
+    forward_ = forward;
+
+    TORCH_INTERNAL_ASSERT(in_strides.size() == signal_sizes.size());
+    TORCH_INTERNAL_ASSERT(out_strides.size() == signal_sizes.size());
+    TORCH_INTERNAL_ASSERT(1 <= signal_ndim_ && signal_ndim_ <= mkl_fft_max_rank);
+
+    std::copy(signal_sizes.cbegin(), signal_sizes.cend(), sizes_);
+    std::copy(in_strides.cbegin(), in_strides.cend(), input_strides_);
+    std::copy(out_strides.cbegin(), out_strides.cend(), output_strides_);
+  }
+};
+
+static_assert(std::is_trivial<MklFFTParams>::value, "");
+
+// The default max cache size is arbitrary. Every committed descriptor holds
+// its twiddle factors, so this is smaller than the cuFFT default. Users can
+// always configure it via torch.backends.mkl.fft_plan_cache.max_size.
+constexpr int64_t MKL_FFT_DEFAULT_CACHE_SIZE = 256;
+
+// Like CuFFTParamsLRUCache, but the values are committed MKL descriptors.
+// This is **NOT** thread-safe. Please use a mutex when using it.
+// A committed descriptor can be executed by several threads at once, so the
+// descriptors are handed out as shared pointers and the mutex only needs to be
+// held while looking them up; a descriptor evicted meanwhile lives until its
+// last transform is done.
+// The contract of using this cache is that lookup should only be used when
+// the max_size is positive.
+class MklFFTParamsLRUCache {
+public:
+  using plan_t = std::shared_ptr<const DftiDescriptor>;
+  using kv_t = typename std::pair<MklFFTParams, plan_t>;
+  using map_t = typename std::unordered_map<std::reference_wrapper<MklFFTParams>,
+                                            typename std::list<kv_t>::iterator,
+                                            ParamsHash<MklFFTParams>,
+                                            ParamsEqual<MklFFTParams>>;
+  using map_kkv_iter_t = typename map_t::iterator;
+
+  MklFFTParamsLRUCache() : MklFFTParamsLRUCache(MKL_FFT_DEFAULT_CACHE_SIZE) {}
+
+  MklFFTParamsLRUCache(int64_t max_size) {
+    _set_max_size(max_size);
+  }
+
+  // If key is in this cache, return the cached descriptor. Otherwise, create
+  // it with make_plan(), emplace it in this cache and return it.
+  template <typename MakePlan>
+  plan_t lookup(MklFFTParams params, MakePlan make_plan) {
+    AT_ASSERT(_max_size > 0);
+
+    map_kkv_iter_t map_it = _cache_map.find(params);
+    // Hit, put to list front
+    if (map_it != _cache_map.end()) {
+      _hits++;
+      _usage_list.splice(_usage_list.begin(), _usage_list, map_it->second);
+      return map_it->second->second;
+    }
+
+    // Miss
+    _misses++;
+    plan_t plan = std::make_shared<const DftiDescriptor>(make_plan());
+    // remove if needed
+    if (_usage_list.size() >= _max_size) {
+      auto last = _usage_list.end();
+      last--;
+      _cache_map.erase(last->first);
+      _usage_list.pop_back();
+    }
+
+    // insert the new plan at list front, then into _cache_map
+    _usage_list.emplace_front(params, plan);
+    auto kv_it = _usage_list.begin();
+    _cache_map.emplace(std::piecewise_construct,
+                std::forward_as_tuple(kv_it->first),
+                std::forward_as_tuple(kv_it));
+    return plan;
+  }
+
+  void clear() {
+    _cache_map.clear();
+    _usage_list.clear();
+    _hits = 0;
+    _misses = 0;
+  }
+
+  void resize(int64_t new_size) {
+    _set_max_size(new_size);
+    auto cur_size = _usage_list.size();
+    if (cur_size > _max_size) {
+      auto delete_it = _usage_list.end();
+      for (size_t i = 0; i < cur_size - _max_size; i++) {
+        delete_it--;
+        _cache_map.erase(delete_it->first);
+      }
+      _usage_list.erase(delete_it, _usage_list.end());
+    }
+  }
+
+  size_t size() const { return _cache_map.size(); }
+
+  size_t max_size() const noexcept { return _max_size; }
+
+  // Number of lookups that found their plan in the cache, and that had to
+  // create it, since the cache was created or cleared.
+  int64_t hits() const noexcept { return _hits; }
+  int64_t misses() const noexcept { return _misses; }
+
+  std::mutex mutex;
+
+private:
+  // Only sets size and does value check. Does not resize the data structures.
+  void _set_max_size(int64_t new_size) {
+    TORCH_CHECK(new_size >= 0,
+             "MKL FFT plan cache size must be non-negative, but got ", new_size);
+    _max_size = static_cast<size_t>(new_size);
+  }
+
+  std::list<kv_t> _usage_list;
+  map_t _cache_map;
+  size_t _max_size;
+  int64_t _hits = 0;
+  int64_t _misses = 0;
+};
+
+}}} // namespace at::native::detail
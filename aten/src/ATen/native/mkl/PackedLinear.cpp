@@ -0,0 +1,88 @@
+#include <ATen/native/mkl/PackedLinear.h>
+
+#include <ATen/Config.h>
+#include <ATen/core/grad_mode.h>
+
+#if !AT_MKL_ENABLED()
+
+namespace at { namespace native {
+
+bool use_mkl_packed_linear(const Tensor& input, const Tensor& weight, const Tensor& bias) {
+  return false;
+}
+
+MklPackedLinearWeight mkl_pack_linear_weight(const Tensor& weight, int64_t rows) {
+  AT_ERROR("mkl_pack_linear_weight: ATen not compiled with MKL support");
+}
+
+Tensor mkl_packed_linear(const Tensor& input, const MklPackedLinearWeight& weight, const Tensor& bias) {
+  AT_ERROR("mkl_packed_linear: ATen not compiled with MKL support");
+}
+
+}}
+
+#else // AT_MKL_ENABLED
+
+#include <mkl.h>
+
+#include <limits>
+
+namespace at { namespace native {
+
+namespace {
+
+bool is_float_cpu_matrix(const Tensor& t) {
+  return t.device().is_cpu() && t.layout() == kStrided && t.scalar_type() == kFloat &&
+      t.dim() == 2 && t.is_contiguous() &&
+      t.size(0) <= std::numeric_limits<MKL_INT>::max() &&
+      t.size(1) <= std::numeric_limits<MKL_INT>::max();
+}
+
+} // namespace
+
+bool use_mkl_packed_linear(const Tensor& input, const Tensor& weight, const Tensor& bias) {
+  if (GradMode::is_enabled() &&
+      (input.requires_grad() || weight.requires_grad() || (bias.defined() && bias.requires_grad()))) {
+    return false;
+  }
+  if (bias.defined() && !(bias.device().is_cpu() && bias.scalar_type() == kFloat &&
+                          bias.dim() == 1 && bias.size(0) == weight.size(0))) {
+    return false;
+  }
+  return is_float_cpu_matrix(input) && is_float_cpu_matrix(weight) &&
+      input.size(0) > 0 && input.size(1) == weight.size(1) && weight.numel() > 0;
+}
+
+MklPackedLinearWeight mkl_pack_linear_weight(const Tensor& weight, int64_t rows) {
+  const auto m = static_cast<MKL_INT>(rows);
+  const auto n = static_cast<MKL_INT>(weight.size(0));
+  const auto k = static_cast<MKL_INT>(weight.size(1));
+  const size_t size = cblas_sgemm_pack_get_size(CblasBMatrix, m, n, k);
+  Tensor packed = at::empty({static_cast<int64_t>(size)}, weight.options().dtype(kByte));
+  // linear multiplies with the transposed weight
+  cblas_sgemm_pack(CblasRowMajor, CblasBMatrix, CblasTrans, m, n, k, 1.0f,
+                   weight.data_ptr<float>(), k, reinterpret_cast<float*>(packed.data_ptr<uint8_t>()));
+  return {packed, rows, weight.size(0), weight.size(1)};
+}
+
+Tensor mkl_packed_linear(const Tensor& input, const MklPackedLinearWeight& weight, const Tensor& bias) {
+  TORCH_CHECK(input.size(0) == weight.rows && input.size(1) == weight.in_features,
+              "mkl_packed_linear: expected an input of size [", weight.rows, ", ", weight.in_features,
+              "], but got ", input.sizes());
+  const auto m = static_cast<MKL_INT>(weight.rows);
+  const auto n = static_cast<MKL_INT>(weight.out_features);
+  const auto k = static_cast<MKL_INT>(weight.in_features);
+  // the bias is accumulated into by the GEMM, beta = 0 does not read the output
+  Tensor output = bias.defined()
+      ? bias.expand({weight.rows, weight.out_features}).contiguous()
+      : at::empty({weight.rows, weight.out_features}, input.options());
+  cblas_sgemm_compute(CblasRowMajor, CblasNoTrans, CblasPacked, m, n, k,
+                      input.data_ptr<float>(), k,
+                      reinterpret_cast<const float*>(weight.packed.data_ptr<uint8_t>()), k,
+                      bias.defined() ? 1.0f : 0.0f, output.data_ptr<float>(), n);
+  return output;
+}
+
+}} // namespace at::native
+
+#endif // AT_MKL_ENABLED
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <ATen/ATen.h>
+
+namespace at { namespace native {
+
+// A linear layer weight packed by MKL for repeated products with inputs that
+// have a fixed number of rows, such as the recurrent weight of an RNN layer
+// that is multiplied with the hidden state at every time step. Packing copies
+// the weight once into the blocked layout read by the GEMM micro-kernel,
+// which an unpacked sgemm call redoes on every call.
+struct MklPackedLinearWeight {
+  Tensor packed; // byte buffer holding the packed weight
+  int64_t rows = 0; // number of input rows the weight was packed for
+  int64_t out_features = 0;
+  int64_t in_features = 0;
+};
+
+// Whether at::linear(input, weight, bias) can be computed with a packed
+// weight: ATen is built with MKL, input and weight are contiguous float
+// matrices on the CPU, and no gradient is required, as the packed product
+// is not differentiable.
+TORCH_API bool use_mkl_packed_linear(const Tensor& input, const Tensor& weight, const Tensor& bias);
+
+// Packs 'weight' of size [out_features, in_features] for inputs with 'rows' rows.
+TORCH_API MklPackedLinearWeight mkl_pack_linear_weight(const Tensor& weight, int64_t rows);
+
+// Computes at::linear(input, weight, bias) with the weight packed by mkl_pack_linear_weight.
+TORCH_API Tensor mkl_packed_linear(const Tensor& input, const MklPackedLinearWeight& weight, const Tensor& bias);
+
+}} // namespace at::native
@@ -38,6 +38,30 @@ Tensor& _fft_c2c_mkl_out(Tensor& out, const Tensor& self, IntArrayRef dim, int64
   AT_ERROR("fft: ATen not compiled with MKL support");
 }
 
+int64_t _mkl_fft_get_plan_cache_max_size() {
+  AT_ERROR("fft: ATen not compiled with MKL support");
+}
+
+void _mkl_fft_set_plan_cache_max_size(int64_t max_size) {
+  AT_ERROR("fft: ATen not compiled with MKL support");
+}
+
+int64_t _mkl_fft_get_plan_cache_size() {
+  AT_ERROR("fft: ATen not compiled with MKL support");
+}
+
+int64_t _mkl_fft_get_plan_cache_hits() {
+  AT_ERROR("fft: ATen not compiled with MKL support");
+}
+
+int64_t _mkl_fft_get_plan_cache_misses() {
+  AT_ERROR("fft: ATen not compiled with MKL support");
+}
+
+void _mkl_fft_clear_plan_cache() {
+  AT_ERROR("fft: ATen not compiled with MKL support");
+}
+
 }}
 
 #else // AT_MKL_ENABLED
@@ -55,11 +79,13 @@ Tensor& _fft_c2c_mkl_out(Tensor& out, const Tensor& self, IntArrayRef dim, int64
 #include <vector>
 #include <numeric>
 #include <cmath>
+#include <mutex>
 
 #include <mkl_dfti.h>
 #include <ATen/mkl/Exceptions.h>
 #include <ATen/mkl/Descriptors.h>
 #include <ATen/mkl/Limits.h>
+#include <ATen/native/mkl/MklFFTPlanCache.h>
 
 
 namespace at { namespace native {
@@ -209,10 +235,11 @@ REGISTER_AVX2_DISPATCH(fft_fill_with_conjugate_symmetry_stub, &_fft_fill_with_co
 // Constructs an mkl-fft plan descriptor representing the desired transform
 // For complex types, strides are in units of 2 * element_size(dtype)
 // sizes are for the full signal, including batch size and always two-sided
+// The transform runs on at most num_threads threads
 static DftiDescriptor _plan_mkl_fft(
     IntArrayRef in_strides, IntArrayRef out_strides, IntArrayRef sizes,
     bool complex_input, bool complex_output,
-    int64_t normalization, bool forward, ScalarType dtype) {
+    int64_t normalization, bool forward, ScalarType dtype, int64_t num_threads) {
   const int64_t signal_ndim = sizes.size() - 1;
   TORCH_INTERNAL_ASSERT(in_strides.size() == sizes.size());
   TORCH_INTERNAL_ASSERT(out_strides.size() == sizes.size());
@@ -283,12 +310,21 @@ static DftiDescriptor _plan_mkl_fft(
                 "MKL FFT: input signal numel exceeds allowed range [1, ", MKL_LONG_MAX, "]");
   }
 
+  // follow the intra-op thread setting rather than MKL's own default
+  MKL_DFTI_CHECK(DftiSetValue(descriptor.get(), DFTI_THREAD_LIMIT, static_cast<MKL_LONG>(num_threads)));
+
   // finalize
   MKL_DFTI_CHECK(DftiCommitDescriptor(descriptor.get()));
 
   return descriptor;
 }
 
+static detail::MklFFTParamsLRUCache& mkl_fft_get_plan_cache() {
+  // Never destroyed, so no descriptor is freed after MKL is unloaded at exit
+  static auto* plan_cache = new detail::MklFFTParamsLRUCache();
+  return *plan_cache;
+}
+
 // Execute a general fft operation (can be c2c, onesided r2c or onesided c2r)
 static Tensor& _exec_fft(Tensor& out, const Tensor& self, IntArrayRef out_sizes,
                          IntArrayRef dim, int64_t normalization, bool forward) {
@@ -341,15 +377,36 @@ static Tensor& _exec_fft(Tensor& out, const Tensor& self, IntArrayRef out_sizes,
   const auto value_type = c10::toValueType(input.scalar_type());
   out.resize_(batched_out_sizes, MemoryFormat::Contiguous);
 
-  auto descriptor = _plan_mkl_fft(
-      input.strides(), out.strides(), signal_size, input.is_complex(),
-      out.is_complex(), normalization, forward, value_type);
+  // Transforms called from within a parallel region must not spawn threads
+  const int64_t num_threads = at::in_parallel_region() ? 1 : at::get_num_threads();
+  auto make_plan = [&] {
+    return _plan_mkl_fft(
+        input.strides(), out.strides(), signal_size, input.is_complex(),
+        out.is_complex(), normalization, forward, value_type, num_threads);
+  };
+
+  // Creating and committing a descriptor often costs more than running a
+  // small transform, so reuse the cached plan of an identical transform
+  detail::MklFFTParamsLRUCache::plan_t descriptor;
+  if (signal_ndim <= detail::mkl_fft_max_rank) {
+    auto& plan_cache = mkl_fft_get_plan_cache();
+    std::lock_guard<std::mutex> guard(plan_cache.mutex);
+    if (plan_cache.max_size() > 0) {
+      detail::MklFFTParams params(
+          input.strides(), out.strides(), signal_size, input.is_complex(),
+          out.is_complex(), normalization, forward, value_type, num_threads);
+      descriptor = plan_cache.lookup(params, make_plan);
+    }
+  }
+  if (!descriptor) {
+    descriptor = std::make_shared<const DftiDescriptor>(make_plan());
+  }
 
   // run the FFT
   if (forward) {
-    MKL_DFTI_CHECK(DftiComputeForward(descriptor.get(), input.data_ptr(), out.data_ptr()));
+    MKL_DFTI_CHECK(DftiComputeForward(descriptor->get(), input.data_ptr(), out.data_ptr()));
   } else {
-    MKL_DFTI_CHECK(DftiComputeBackward(descriptor.get(), input.data_ptr(), out.data_ptr()));
+    MKL_DFTI_CHECK(DftiComputeBackward(descriptor->get(), input.data_ptr(), out.data_ptr()));
   }
 
   // Inplace reshaping to original batch shape and inverting the dimension permutation
@@ -459,6 +516,41 @@ Tensor& _fft_c2c_mkl_out(Tensor& out, const Tensor& self, IntArrayRef dim, int64
   return out.copy_(result);
 }
 
+// See native/mkl/MklFFTPlanCache.h and torch.backends.mkl.fft_plan_cache
+int64_t _mkl_fft_get_plan_cache_max_size() {
+  return mkl_fft_get_plan_cache().max_size();
+}
+
+void _mkl_fft_set_plan_cache_max_size(int64_t max_size) {
+  auto& plan_cache = mkl_fft_get_plan_cache();
+  std::lock_guard<std::mutex> guard(plan_cache.mutex);
+  plan_cache.resize(max_size);
+}
+
+int64_t _mkl_fft_get_plan_cache_size() {
+  auto& plan_cache = mkl_fft_get_plan_cache();
+  std::lock_guard<std::mutex> guard(plan_cache.mutex);
+  return plan_cache.size();
+}
+
+int64_t _mkl_fft_get_plan_cache_hits() {
+  auto& plan_cache = mkl_fft_get_plan_cache();
+  std::lock_guard<std::mutex> guard(plan_cache.mutex);
+  return plan_cache.hits();
+}
+
+int64_t _mkl_fft_get_plan_cache_misses() {
+  auto& plan_cache = mkl_fft_get_plan_cache();
+  std::lock_guard<std::mutex> guard(plan_cache.mutex);
+  return plan_cache.misses();
+}
+
+void _mkl_fft_clear_plan_cache() {
+  auto& plan_cache = mkl_fft_get_plan_cache();
+  std::lock_guard<std::mutex> guard(plan_cache.mutex);
+  plan_cache.clear();
+}
+
 }} // namespace at::native
 
 #endif
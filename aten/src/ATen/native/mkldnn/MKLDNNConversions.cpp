@@ -75,7 +75,8 @@ Tensor mkldnn_reorder_conv2d_weight(
     IntArrayRef padding,
     IntArrayRef stride,
     IntArrayRef dilation,
-    int64_t groups) {
+    int64_t groups,
+    c10::optional<IntArrayRef> input_size) {
   if (self.scalar_type() == ScalarType::BFloat16) {
     TORCH_CHECK(mkldnn_bf16_device_check(),
         "mkldnn_reorder_conv2d_weight: bf16 path needs the cpu support avx512bw, avx512vl and avx512dq");
@@ -93,6 +94,12 @@ Tensor mkldnn_reorder_conv2d_weight(
     w.reshape({wdims[0] * wdims[1], wdims[2], wdims[3], wdims[4]});
   }
 
+  // With the input size, the weights are reordered into exactly the format
+  // the convolution will pick for it, so it does not reorder them again.
+  ideep::dims src_dims;
+  if (input_size.has_value()) {
+    src_dims = {input_size->begin(), input_size->end()};
+  }
   auto desc =
       ideep::convolution_forward::expected_weights_desc(
           w.get_dims(),
@@ -102,7 +109,10 @@ Tensor mkldnn_reorder_conv2d_weight(
           {padding.begin(), padding.end()},
           {dilation.begin(), dilation.end()},
           groups,
-          ideep::algorithm::convolution_direct);
+          ideep::algorithm::convolution_direct,
+          ideep::prop_kind::forward,
+          w.get_data_type(),
+          src_dims);
   ideep::tensor result;
   result.init(desc);
   result.feed_from(w);
@@ -116,7 +126,8 @@ Tensor mkldnn_reorder_conv3d_weight(
     IntArrayRef padding,
     IntArrayRef stride,
     IntArrayRef dilation,
-    int64_t groups) {
+    int64_t groups,
+    c10::optional<IntArrayRef> input_size) {
   if (self.scalar_type() == ScalarType::BFloat16) {
     TORCH_CHECK(mkldnn_bf16_device_check(),
         "mkldnn_reorder_conv3d_weight: bf16 path needs the cpu support avx512bw, avx512vl and avx512dq");
@@ -124,6 +135,10 @@ Tensor mkldnn_reorder_conv3d_weight(
 
   auto w = itensor_from_mkldnn(self);
 
+  ideep::dims src_dims;
+  if (input_size.has_value()) {
+    src_dims = {input_size->begin(), input_size->end()};
+  }
   auto desc =
       ideep::convolution_forward::expected_weights_desc(
           w.get_dims(),
@@ -133,7 +148,41 @@ Tensor mkldnn_reorder_conv3d_weight(
           {padding.begin(), padding.end()},
           {dilation.begin(), dilation.end()},
           groups,
-          ideep::algorithm::convolution_direct);
+          ideep::algorithm::convolution_direct,
+          ideep::prop_kind::forward,
+          w.get_data_type(),
+          src_dims);
+  ideep::tensor result;
+  result.init(desc);
+  result.feed_from(w);
+
+  return new_with_itensor_mkldnn(std::move(result), optTypeMetaToScalarType(self.options().dtype_opt()), self.options().device_opt());
+}
+
+// Like conv weights, linear weights are reordered into the format the inner
+// product primitive expects, which depends on the batch size if known.
+Tensor mkldnn_reorder_linear_weight(
+    const Tensor& self,
+    c10::optional<int64_t> batch_size) {
+  TORCH_CHECK(self.dim() == 2,
+      "mkldnn_reorder_linear_weight: weight needs to be 2-d, got ", self.dim(), "-d");
+  if (self.scalar_type() == ScalarType::BFloat16) {
+    TORCH_CHECK(mkldnn_bf16_device_check(),
+        "mkldnn_reorder_linear_weight: bf16 path needs the cpu support avx512bw, avx512vl and avx512dq");
+  }
+
+  auto w = itensor_from_mkldnn(self);
+  auto out_features = w.get_dim(0);
+  auto in_features = w.get_dim(1);
+  ideep::dims src_dims;
+  if (batch_size.has_value()) {
+    src_dims = {batch_size.value(), in_features};
+  }
+  auto desc = ideep::inner_product_forward::expected_weights_desc(
+      {out_features, in_features},
+      src_dims,
+      w.get_data_type(),
+      w.get_data_type());
   ideep::tensor result;
   result.init(desc);
   result.feed_from(w);
@@ -156,7 +205,8 @@ Tensor mkldnn_reorder_conv2d_weight(
     IntArrayRef padding,
     IntArrayRef stride,
     IntArrayRef dilation,
-    int64_t groups) {
+    int64_t groups,
+    c10::optional<IntArrayRef> input_size) {
   TORCH_CHECK(false, "mkldnn_reorder_conv2d_weight: MKL-DNN build is disabled");
 }
 
@@ -165,10 +215,17 @@ Tensor mkldnn_reorder_conv3d_weight(
     IntArrayRef padding,
     IntArrayRef stride,
     IntArrayRef dilation,
-    int64_t groups) {
+    int64_t groups,
+    c10::optional<IntArrayRef> input_size) {
   TORCH_CHECK(false, "mkldnn_reorder_conv3d_weight: MKL-DNN build is disabled");
 }
 
+Tensor mkldnn_reorder_linear_weight(
+    const Tensor& self,
+    c10::optional<int64_t> batch_size) {
+  TORCH_CHECK(false, "mkldnn_reorder_linear_weight: MKL-DNN build is disabled");
+}
+
 #endif // AT_MKLDNN_ENABLED()
 
 }}
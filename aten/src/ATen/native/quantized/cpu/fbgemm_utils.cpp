@@ -238,6 +238,23 @@ Tensor TransposeConvTensorUnpackConversion<2>(const Tensor& src, int groups) {
   return fused_tensor.permute({1, 0, 2, 3});
 }
 
+template <int kSpatialDim>
+bool UseDirectDepthwiseConv(const fbgemm::conv_param_t<kSpatialDim>& conv_p) {
+  if (conv_p.transposed || conv_p.G != conv_p.IC || conv_p.G != conv_p.OC) {
+    return false;
+  }
+  bool fbgemm_fast_path = conv_p.G % 8 == 0;
+  for (int i = 0; i < kSpatialDim; ++i) {
+    fbgemm_fast_path = fbgemm_fast_path && conv_p.K[i] == 3 &&
+        conv_p.stride[i] <= 2 && conv_p.dilation[i] == 1 &&
+        conv_p.pad[i] == 1 && conv_p.pad[i + kSpatialDim] == 1;
+  }
+  return !fbgemm_fast_path;
+}
+
+template bool UseDirectDepthwiseConv<2>(const fbgemm::conv_param_t<2>& conv_p);
+template bool UseDirectDepthwiseConv<3>(const fbgemm::conv_param_t<3>& conv_p);
+
 template fbgemm::conv_param_t<1> MakeFbgemmConvParam<1>(
     int N,
     int C,
@@ -53,6 +53,15 @@ struct TORCH_API PackedLinearWeight : public LinearPackedParamsBase {
   at::Tensor apply_dynamic(at::Tensor input, bool reduce_range=false) override;
   at::Tensor apply_dynamic_relu(at::Tensor input, bool reduce_range=false) override;
 
+  at::Tensor& apply_dynamic_out(
+      const at::Tensor& input,
+      at::Tensor& output,
+      bool reduce_range = false) override;
+  at::Tensor& apply_dynamic_relu_out(
+      const at::Tensor& input,
+      at::Tensor& output,
+      bool reduce_range = false) override;
+
   std::tuple<at::Tensor, c10::optional<at::Tensor>> unpack() override;
 
   c10::optional<at::Tensor> bias() override {
@@ -71,7 +80,10 @@ struct TORCH_API PackedLinearWeight : public LinearPackedParamsBase {
       int64_t output_zero_point);
 
   template <bool ReluFused>
-  at::Tensor apply_dynamic_impl(at::Tensor input, bool reduce_range=false);
+  at::Tensor& apply_dynamic_impl(
+      const at::Tensor& input,
+      at::Tensor& output,
+      bool reduce_range = false);
 };
 
 struct TORCH_API PackedLinearWeightFp16 : public LinearPackedParamsBase {
@@ -99,6 +111,15 @@ struct TORCH_API PackedLinearWeightFp16 : public LinearPackedParamsBase {
   at::Tensor apply_dynamic(at::Tensor input, bool reduce_range=false) override;
   at::Tensor apply_dynamic_relu(at::Tensor input, bool reduce_range=false) override;
 
+  at::Tensor& apply_dynamic_out(
+      const at::Tensor& input,
+      at::Tensor& output,
+      bool reduce_range = false) override;
+  at::Tensor& apply_dynamic_relu_out(
+      const at::Tensor& input,
+      at::Tensor& output,
+      bool reduce_range = false) override;
+
   std::tuple<at::Tensor, c10::optional<at::Tensor>> unpack() override;
 
   c10::optional<at::Tensor> bias() override {
@@ -113,7 +134,7 @@ struct TORCH_API PackedLinearWeightFp16 : public LinearPackedParamsBase {
 
  private:
   template <bool ReluFused>
-  at::Tensor apply_dynamic_impl(at::Tensor input);
+  at::Tensor& apply_dynamic_impl(const at::Tensor& input, at::Tensor& output);
 };
 
 template <int kSpatialDim = 2>
@@ -131,7 +152,8 @@ struct TORCH_API PackedConvWeight : public ConvPackedParamsBase<kSpatialDim> {
       std::vector<int64_t> kernel,
       std::vector<float> w_scale,
       std::vector<int32_t> w_zp,
-      c10::QScheme q_scheme)
+      c10::QScheme q_scheme,
+      std::vector<int8_t> depthwise_w = {})
     : w(std::move(w)),
     bias(std::move(bias)),
     stride_(std::move(stride)),
@@ -144,7 +166,8 @@ struct TORCH_API PackedConvWeight : public ConvPackedParamsBase<kSpatialDim> {
     kernel(std::move(kernel)),
     w_scale(std::move(w_scale)),
     w_zp(std::move(w_zp)),
-    q_scheme(q_scheme) {}
+    q_scheme(q_scheme),
+    depthwise_w(std::move(depthwise_w)) {}
 
   std::unique_ptr<fbgemm::PackWeightsForConv<kSpatialDim>> w;
   c10::optional<at::Tensor> bias;
@@ -159,6 +182,9 @@ struct TORCH_API PackedConvWeight : public ConvPackedParamsBase<kSpatialDim> {
   std::vector<float> w_scale;
   std::vector<int32_t> w_zp;
   c10::QScheme q_scheme;
+  // Depthwise weights laid out as {kD, kH, kW, C} for the direct depthwise
+  // kernel. Empty unless UseDirectDepthwiseConv() holds for this conv.
+  std::vector<int8_t> depthwise_w;
 
   at::Tensor apply(
       const at::Tensor& input,
@@ -261,6 +287,14 @@ fbgemm::conv_param_t<kSpatialDim> MakeFbgemmConvParam(
     const std::vector<int>& output_padding = std::vector<int>(kSpatialDim, 0),
     bool transposed = false);
 
+// fbgemmConv only has specialized depthwise kernels for 3x3 (3x3x3) filters
+// with unit dilation and padding; other depthwise shapes go through im2col
+// plus one tiny GEMM per group. Returns true for depthwise convs (one input
+// and one output channel per group) that miss that fast path and should use
+// the direct depthwise kernel instead.
+template <int kSpatialDim = 2>
+bool UseDirectDepthwiseConv(const fbgemm::conv_param_t<kSpatialDim>& conv_p);
+
 // TODO: Remove functions below when ChannelsLast3d is ready.
 Tensor MakeStridedQTensorCPU(
     const IntArrayRef& sizes,
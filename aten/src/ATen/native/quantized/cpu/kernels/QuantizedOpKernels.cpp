@@ -9,6 +9,8 @@
 #include <ATen/native/quantized/cpu/quantized_ops.h>
 
 #include <cmath>
+#include <numeric>
+#include <vector>
 #ifdef USE_FBGEMM
 #include <fbgemm/QuantUtils.h>
 #endif
@@ -173,7 +175,7 @@ int64_t hsum(const uint8_t* A, int len) {
   int64_t row_sum = 0;
   int i = 0;
 
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
   __m256i sum_v = _mm256_setzero_si256();
   __m256i one_epi16_v = _mm256_set1_epi16(1);
   __m256i one_epi8_v = _mm256_set1_epi8(1);
@@ -209,7 +211,7 @@ int64_t hsum(const int8_t* A, int len) {
   int64_t row_sum = 0;
   int i = 0;
 
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
   __m256i sum_v = _mm256_setzero_si256();
   __m256i one_epi16_v = _mm256_set1_epi16(1);
   __m256i one_epi8_v = _mm256_set1_epi8(1);
@@ -245,7 +247,7 @@ int64_t hsum(const int32_t* A, int len) {
   int64_t row_sum = 0;
   int i = 0;
 
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
   __m256i sum_epi64 = _mm256_setzero_si256();
   // vectorized
   for (; i < len / 8 * 8; i += 8) {
@@ -280,7 +282,7 @@ int64_t hsum_sq(const uint8_t* A, int len) {
   int64_t row_sum = 0;
   int i = 0;
 
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
   __m256i sum_v_epu32 = _mm256_setzero_si256();
   // vectorized
   for (; i < len / 16 * 16; i += 16) {
@@ -321,7 +323,7 @@ int64_t hsum_sq(const int8_t* A, int len) {
   int64_t row_sum = 0;
   int i = 0;
 
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
   __m256i sum_v_epi32 = _mm256_setzero_si256();
   // vectorized
   for (; i < len / 16 * 16; i += 16) {
@@ -363,7 +365,7 @@ float hsum_sq(const int32_t* A, int len) {
   float row_sum = 0;
   int i = 0;
 
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
   __m256 sum_ps = _mm256_setzero_ps();
   // vectorized
   for (; i < len / 8 * 8; i += 8) {
@@ -1214,7 +1216,7 @@ void do_avg_pool_nhwc_on_AVX2(
     int hsize,
     int wsize,
     int csize) {
-#if defined(CPU_CAPABILITY_AVX2) && !defined(_MSC_VER)
+#if (defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)) && !defined(_MSC_VER)
   // buffer for channel accumulator, used to interchange channel-loop
   // to inner-most, so that memory access of the input tensor data is
   // continuous.
@@ -1284,7 +1286,7 @@ void do_avg_pool_on_AVX2(
     int64_t stride_D,
     int64_t stride_H,
     int64_t stride_W) {
-#if defined(CPU_CAPABILITY_AVX2) && !defined(_MSC_VER)
+#if (defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)) && !defined(_MSC_VER)
   constexpr auto vec_width = Vec256<T>::size() / 4;
   if (vec_width == 8) {
     for (; c + vec_width <= channel_size; c += vec_width) {
@@ -1720,7 +1722,7 @@ int64_t do_quantized_bilinear_on_AVX2(
     const int64_t h1p,
     const int64_t w1p) {
   int64_t c = 0;
-#if defined(CPU_CAPABILITY_AVX2) && !defined(_MSC_VER)
+#if (defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)) && !defined(_MSC_VER)
   constexpr auto vec_width = Vec256<T>::size() / 4;
   if (vec_width == 8) {
     for (; c + vec_width <= channels; c += vec_width) {
@@ -2088,7 +2090,11 @@ void fake_quantize_tensor_cachemask_kernel(
 }
 
 void fake_quantize_learnable_tensor_grad_kernel_cpu(
-    TensorIterator& iter,
+    Tensor& dX,
+    Tensor& dScale,
+    Tensor& dZeroPoint,
+    const Tensor& X,
+    const Tensor& dY,
     float scale,
     float inv_scale,
     int64_t zero_point,
@@ -2097,28 +2103,27 @@ void fake_quantize_learnable_tensor_grad_kernel_cpu(
     float grad_factor) {
   float dscale_small = quant_min - zero_point;
   float dscale_big = quant_max - zero_point;
+  auto iter = TensorIteratorConfig()
+    .add_output(dX)
+    .add_input(X)
+    .add_input(dY)
+    .build();
+
+  // The scale and zero point gradients are summed by every thread into its
+  // own partial sums, which are added up at the end.
+  const int64_t num_threads = at::get_num_threads();
+  std::vector<double> dscale_partials(num_threads, 0);
+  std::vector<double> dzero_point_partials(num_threads, 0);
   iter.for_each([&](char** data, const int64_t* strides, int64_t n) {
-    /*  When a for_each call is made on a TensorIterator with multiple inputs and outputs,
-        the order they are accessed follows the order they are built within the iterator.
-        For example, if an iterator is built in the following order:
-        auto iter = TensorIteratorConfig().
-          .add_output(firstOutput)
-          .add_output(secondOutput)
-          .add_input(firstInput)
-          .add_input(secondInput)
-          .build()
-        data will contain 4 pointers to pointers to values in the following order:
-        firstOutput, secondOutput, firstInput, secondInput.
-        Proper pointer referencing and dereferencing, along with the usage of strides
-        (to move onto different elements), can allow accessing of the input and assignment
-        to the right output.
-    */
+    const int64_t tid = at::get_thread_num();
+    TORCH_CHECK(tid < num_threads,
+                "expect thread id smaller than ", num_threads, ", got thread id ", tid);
+    double dscale_sum = 0;
+    double dzero_point_sum = 0;
     for (int64_t i = 0; i < n; i++) {
       float* dXOutput = (float*)(data[0] + i * strides[0]);
-      float* dScaleOutput = (float*)(data[1] + i * strides[1]);
-      float* dZeroPointOutput = (float*)(data[2] + i * strides[2]);
-      float* XInput = (float*)(data[3] + i * strides[3]);
-      float* dYInput = (float*)(data[4] + i * strides[4]);
+      float* XInput = (float*)(data[1] + i * strides[1]);
+      float* dYInput = (float*)(data[2] + i * strides[2]);
       // Calculate gradients for X.
       int64_t xqi = std::nearbyint(zero_point + (*XInput) * inv_scale);
       *dXOutput = (*dYInput) * (xqi >= quant_min && xqi <= quant_max);
@@ -2126,14 +2131,18 @@ void fake_quantize_learnable_tensor_grad_kernel_cpu(
       float xfqi = static_cast<float>((std::max(std::min(xqi, quant_max), quant_min) - zero_point) * scale);
       // Calculate gradients according to the gradient of the clamp function.
       if (xqi < quant_min || xqi > quant_max) {
-        *dZeroPointOutput = (*dYInput) * (-1) * scale * grad_factor;
-        *dScaleOutput = ((xqi < quant_min) ? ((*dYInput) * dscale_small) : ((*dYInput) * dscale_big)) * grad_factor;
+        dzero_point_sum += (*dYInput) * (-1) * scale * grad_factor;
+        dscale_sum += ((xqi < quant_min) ? ((*dYInput) * dscale_small) : ((*dYInput) * dscale_big)) * grad_factor;
       } else {
-        *dZeroPointOutput = 0;
-        *dScaleOutput = (*dYInput) * (xfqi - (*XInput)) * inv_scale * grad_factor;
+        dscale_sum += (*dYInput) * (xfqi - (*XInput)) * inv_scale * grad_factor;
       }
     }
+    dscale_partials[tid] += dscale_sum;
+    dzero_point_partials[tid] += dzero_point_sum;
   });
+
+  dScale.fill_(std::accumulate(dscale_partials.begin(), dscale_partials.end(), 0.0));
+  dZeroPoint.fill_(std::accumulate(dzero_point_partials.begin(), dzero_point_partials.end(), 0.0));
 }
 
 void fake_quant_per_channel_cachemask_cpu(
@@ -15,6 +15,27 @@ struct LinearPackedParamsBase : public torch::jit::CustomClassHolder {
   virtual at::Tensor apply_dynamic(at::Tensor input, bool reduce_range=false) = 0;
   virtual at::Tensor apply_dynamic_relu(at::Tensor input, bool reduce_range=false) = 0;
 
+  // Out variants of apply_dynamic/apply_dynamic_relu. `output` is resized to
+  // the result shape and written in place, so callers such as Static Runtime
+  // can keep reusing one output buffer across calls. Backends without a
+  // dedicated implementation compute out of place and copy.
+  virtual at::Tensor& apply_dynamic_out(
+      const at::Tensor& input,
+      at::Tensor& output,
+      bool reduce_range = false) {
+    auto result = apply_dynamic(input, reduce_range);
+    output.resize_(result.sizes());
+    return output.copy_(result);
+  }
+  virtual at::Tensor& apply_dynamic_relu_out(
+      const at::Tensor& input,
+      at::Tensor& output,
+      bool reduce_range = false) {
+    auto result = apply_dynamic_relu(input, reduce_range);
+    output.resize_(result.sizes());
+    return output.copy_(result);
+  }
+
   virtual std::tuple<at::Tensor, c10::optional<at::Tensor>> unpack() = 0;
 
   virtual c10::optional<at::Tensor> bias() = 0;
@@ -1,5 +1,7 @@
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <limits>
 #include <vector>
 
 #include <ATen/ATen.h>
@@ -203,6 +205,91 @@ at::SmallVector<int64_t, 5> MakeConvOutputShape<3>(
 #endif // USE_PYTORCH_QNNPACK
 
 #ifdef USE_FBGEMM
+namespace {
+
+// Direct depthwise convolution over channels-last uint8 activations, for the
+// depthwise shapes fbgemmConv has no specialized kernel for (see
+// fbgemm_utils::UseDirectDepthwiseConv). 2D convs are passed with a unit
+// depth. Weights are laid out as {kD, kH, kW, C}, so the innermost loop runs
+// over contiguous channels of both the activations and the weights. Weight
+// zero points, scales and bias hold one entry per channel.
+template <bool kReluFused>
+void DepthwiseConvDirect(
+    const uint8_t* act_data,
+    int N,
+    int C,
+    const std::array<int, 3>& in_dim,
+    const std::array<int, 3>& out_dim,
+    const std::array<int, 3>& kernel,
+    const std::array<int, 3>& stride,
+    const std::array<int, 3>& padding,
+    const std::array<int, 3>& dilation,
+    int32_t act_zero_point,
+    const int8_t* w_data,
+    const int32_t* w_zp,
+    const float* act_times_w_scale,
+    const float* bias_data,
+    float output_scale,
+    int32_t output_zero_point,
+    uint8_t* out_data) {
+  const float inv_output_scale = 1.0f / output_scale;
+  const int32_t out_min = kReluFused ? output_zero_point : 0;
+  const int32_t out_max = std::numeric_limits<uint8_t>::max();
+  // Each task computes whole output rows (all of W and C).
+  const int64_t num_rows = static_cast<int64_t>(N) * out_dim[0] * out_dim[1];
+  at::parallel_for(0, num_rows, 1, [&](int64_t begin, int64_t end) {
+    std::vector<int32_t> acc(C);
+    for (int64_t row = begin; row < end; ++row) {
+      const int oh = row % out_dim[1];
+      const int od = (row / out_dim[1]) % out_dim[0];
+      const int64_t n = row / (out_dim[1] * out_dim[0]);
+      for (int ow = 0; ow < out_dim[2]; ++ow) {
+        std::fill(acc.begin(), acc.end(), 0);
+        for (int kd = 0; kd < kernel[0]; ++kd) {
+          const int id = od * stride[0] - padding[0] + kd * dilation[0];
+          if (id < 0 || id >= in_dim[0]) {
+            continue;
+          }
+          for (int kh = 0; kh < kernel[1]; ++kh) {
+            const int ih = oh * stride[1] - padding[1] + kh * dilation[1];
+            if (ih < 0 || ih >= in_dim[1]) {
+              continue;
+            }
+            for (int kw = 0; kw < kernel[2]; ++kw) {
+              const int iw = ow * stride[2] - padding[2] + kw * dilation[2];
+              if (iw < 0 || iw >= in_dim[2]) {
+                continue;
+              }
+              const uint8_t* x = act_data +
+                  (((n * in_dim[0] + id) * in_dim[1] + ih) * in_dim[2] + iw) *
+                      C;
+              const int8_t* w =
+                  w_data + ((kd * kernel[1] + kh) * kernel[2] + kw) * C;
+              for (int c = 0; c < C; ++c) {
+                acc[c] += (static_cast<int32_t>(x[c]) - act_zero_point) *
+                    (static_cast<int32_t>(w[c]) - w_zp[c]);
+              }
+            }
+          }
+        }
+        uint8_t* y = out_data + (row * out_dim[2] + ow) * C;
+        for (int c = 0; c < C; ++c) {
+          float val = acc[c] * act_times_w_scale[c];
+          if (bias_data != nullptr) {
+            val += bias_data[c];
+          }
+          const int32_t q =
+              static_cast<int32_t>(std::nearbyint(val * inv_output_scale)) +
+              output_zero_point;
+          y[c] = static_cast<uint8_t>(std::min(out_max, std::max(out_min, q)));
+        }
+      }
+    }
+  });
+}
+
+} // namespace
+
 template <int kSpatialDim>
 const float* PackedConvWeight<kSpatialDim>::GetBiasData(at::Tensor* bias_ptr) {
   const float* bias_data = nullptr;
@@ -448,6 +535,46 @@ at::Tensor PackedConvWeight<kSpatialDim>::apply_impl(
             device(c10::kCPU).dtype(c10::kQUInt8),
             output_scale,
             output_zero_point);
+  if (!depthwise_w.empty()) {
+    std::array<int, 3> in_dim{1, 1, 1}, out_dim{1, 1, 1}, kernel_dim{1, 1, 1},
+        stride_dim{1, 1, 1}, padding_dim{0, 0, 0}, dilation_dim{1, 1, 1};
+    for (int i = 0; i < kSpatialDim; ++i) {
+      const int j = 3 - kSpatialDim + i;
+      in_dim[j] = conv_p.IN_DIM[i];
+      out_dim[j] = conv_p.OUT_DIM[i];
+      kernel_dim[j] = conv_p.K[i];
+      stride_dim[j] = conv_p.stride[i];
+      padding_dim[j] = conv_p.pad[i];
+      dilation_dim[j] = conv_p.dilation[i];
+    }
+    const bool per_channel = q_scheme == c10::kPerChannelAffine;
+    std::vector<int32_t> w_zp_per_channel(M);
+    std::vector<float> act_times_w_scale_per_channel(M);
+    for (int c = 0; c < M; ++c) {
+      w_zp_per_channel[c] = w_zp[per_channel ? c : 0];
+      act_times_w_scale_per_channel[c] = act_times_w_scale[per_channel ? c : 0];
+    }
+    DepthwiseConvDirect<kReluFused>(
+        act_data,
+        N,
+        C,
+        in_dim,
+        out_dim,
+        kernel_dim,
+        stride_dim,
+        padding_dim,
+        dilation_dim,
+        act_zero_point,
+        depthwise_w.data(),
+        w_zp_per_channel.data(),
+        act_times_w_scale_per_channel.data(),
+        bias_data,
+        output_scale,
+        output_zero_point,
+        reinterpret_cast<uint8_t*>(output.data_ptr<c10::quint8>()));
+    return output;
+  }
+
   at::Tensor buffer =
       at::empty(output.sizes(), output.options().dtype(c10::kInt));
   const int num_tasks = at::get_num_threads();
@@ -129,6 +129,20 @@ c10::intrusive_ptr<ConvPackedParamsBase<kSpatialDim>> PackedConvWeight<
     }
   }
 
+  // Weights of depthwise convs that FBGEMM has no direct kernel for are also
+  // kept as {kD, kH, kW, C} (channels innermost) for the direct kernel.
+  std::vector<int8_t> depthwise_w;
+  if (at::native::fbgemm_utils::UseDirectDepthwiseConv<kSpatialDim>(conv_p)) {
+    const int kernel_size = kernel_d * kernel_h * kernel_w;
+    depthwise_w.resize(kernel_size * output_channels);
+    for (int c = 0; c < output_channels; ++c) {
+      for (int k = 0; k < kernel_size; ++k) {
+        depthwise_w[k * output_channels + c] =
+            weight_data_int8[c * kernel_size + k];
+      }
+    }
+  }
+
   std::vector<float> scales;
   if (qtype == c10::kPerTensorAffine) {
     scales = {static_cast<float>(weight.q_scale())};
@@ -165,7 +179,8 @@ c10::intrusive_ptr<ConvPackedParamsBase<kSpatialDim>> PackedConvWeight<
                            : std::vector<int64_t>{kernel_d, kernel_h, kernel_w},
           scales,
           zero_points,
-          qtype});
+          qtype,
+          std::move(depthwise_w)});
 
   return ret_ptr;
 }
@@ -15,6 +15,8 @@ torch::class_<EmbeddingPackedParamsBase> register_embedding_params();
 namespace {
 
 // Fallback implementation when FBGEMM is not available.
+// `offsets_data` holds output_size + 1 entries, bags are reduced in parallel
+// and each row is dequantized one packed byte at a time.
 template <
     typename IndexType,
     typename OffsetType,
@@ -23,100 +25,107 @@ template <
 at::Tensor& embedding_lookup_fallback_impl(
     const at::Tensor& weight,
     const at::Tensor& indices,
-    const at::Tensor& offsets,
+    const OffsetType* offsets_data,
     const c10::optional<at::Tensor>& per_sample_weights_,
     const c10::optional<at::Tensor>& compressed_indices_mapping,
     at::Tensor& output,
     const int64_t block_size,
     const int64_t output_size,
-    bool include_last_offset,
     bool pruned) {
   auto* output_data = output.data_ptr<float>();
   const auto weight_data = weight.data_ptr<uint8_t>();
   const auto indices_data = indices.data_ptr<IndexType>();
-  int32_t* compressed_indices_mapping_data = nullptr;
   const auto weight_sizes = weight.sizes();
   const int64_t N = weight_sizes[0];
   const int64_t weight_size = weight_sizes[1];
   const int index_size = indices.numel();
 
-  auto accessor = offsets.accessor<OffsetType, 1>();
-  std::vector<OffsetType> lengths_data;
-
-  int64_t lower = accessor[0];
-  for (int64_t i = 1; i < offsets.numel(); ++i) {
-    lengths_data.push_back(accessor[i] - lower);
-    lower = accessor[i];
-  }
-  if (!include_last_offset) {
-    lengths_data.push_back(indices.numel() - lower);
-  }
+  TORCH_CHECK(
+      output_size == 0 || offsets_data[output_size] <= index_size,
+      "Expect the lengths data to be less than indices size");
 
-  int64_t current = 0;
-  float* per_sample_weights_data;
-  if (per_sample_weights_.has_value()) {
-    per_sample_weights_data = per_sample_weights_.value().data_ptr<float>();
+  int32_t* compressed_indices_mapping_data = nullptr;
+  int64_t compressed_index_size = 0;
+  if (pruned) {
+    compressed_index_size = compressed_indices_mapping.value().numel();
+    compressed_indices_mapping_data =
+        compressed_indices_mapping.value().data_ptr<int32_t>();
   }
-  for (int m = 0; m < output_size; ++m) {
-    memset(output_data, 0, block_size * sizeof(float));
-    TORCH_CHECK(
-        current + lengths_data[m] <= index_size,
-        "Expect the lengths data to be less than indices size");
-
-    for (int i = 0; i < lengths_data[m]; ++i, ++current) {
-      int64_t idx;
-      if (!pruned) {
-        idx = indices_data[current];
-        TORCH_CHECK((idx >= 0 && idx < N), "Invalid indices data");
-      } else {
-        int64_t uncompressed_idx = indices_data[current];
-        int compressed_index_size = compressed_indices_mapping.value().numel();
-        compressed_indices_mapping_data =
-            compressed_indices_mapping.value().data_ptr<int32_t>();
-        TORCH_CHECK(
-            uncompressed_idx >= 0 && uncompressed_idx < compressed_index_size,
-            "Invalid indices data for Sparse Op.")
-        idx = compressed_indices_mapping_data[uncompressed_idx];
-        if (idx == -1) {
-          continue;
-        }
-      }
-
-      float weight_val = 1.0f;
-      if (per_sample_weights_.has_value()) {
-        weight_val = per_sample_weights_data[current];
-      }
-      float scale, bias;
-      if (BIT_RATE == 8) {
-        const uint8_t* scale_bias =
-            weight_data + (idx + 1) * weight_size - 2 * sizeof(float);
-        scale = weight_val * reinterpret_cast<const float*>(scale_bias)[0];
-        bias = weight_val * reinterpret_cast<const float*>(scale_bias)[1];
-      } else {
-        const at::Half* scale_bias = reinterpret_cast<const at::Half*>(
-            weight_data + (idx + 1) * weight_size - 2 * sizeof(at::Half));
-        scale = weight_val * (scale_bias)[0];
-        bias = weight_val * (scale_bias)[1];
-      }
-
-      for (int j = 0; j < block_size; ++j) {
-        uint8_t quantized =
-            weight_data[idx * weight_size + j / NUM_ELEM_PER_BYTE];
-        quantized >>= (j % NUM_ELEM_PER_BYTE) * BIT_RATE;
-        quantized &= (1 << BIT_RATE) - 1;
-
-        output_data[j] = fma(scale, quantized, output_data[j] + bias);
-      }
-    } // for each i
-    output_data += block_size;
-  } // for each m
+  const float* per_sample_weights_data = per_sample_weights_.has_value()
+      ? per_sample_weights_.value().data_ptr<float>()
+      : nullptr;
+  constexpr uint8_t mask = (1 << BIT_RATE) - 1;
+  const int64_t num_full_bytes = block_size / NUM_ELEM_PER_BYTE;
+
+  at::parallel_for(
+      0, output_size, 1, [&](int64_t start_idx, int64_t end_idx) {
+        for (int64_t m = start_idx; m < end_idx; ++m) {
+          float* output_row = output_data + m * block_size;
+          memset(output_row, 0, block_size * sizeof(float));
+
+          for (int64_t current = offsets_data[m]; current < offsets_data[m + 1];
+               ++current) {
+            int64_t idx;
+            if (!pruned) {
+              idx = indices_data[current];
+              TORCH_CHECK((idx >= 0 && idx < N), "Invalid indices data");
+            } else {
+              int64_t uncompressed_idx = indices_data[current];
+              TORCH_CHECK(
+                  uncompressed_idx >= 0 &&
+                      uncompressed_idx < compressed_index_size,
+                  "Invalid indices data for Sparse Op.")
+              idx = compressed_indices_mapping_data[uncompressed_idx];
+              if (idx == -1) {
+                continue;
+              }
+            }
+
+            float weight_val = per_sample_weights_data
+                ? per_sample_weights_data[current]
+                : 1.0f;
+            const uint8_t* input_row = weight_data + idx * weight_size;
+            float scale, bias;
+            if (BIT_RATE == 8) {
+              const float* scale_bias = reinterpret_cast<const float*>(
+                  input_row + weight_size - 2 * sizeof(float));
+              scale = weight_val * scale_bias[0];
+              bias = weight_val * scale_bias[1];
+            } else {
+              const at::Half* scale_bias = reinterpret_cast<const at::Half*>(
+                  input_row + weight_size - 2 * sizeof(at::Half));
+              scale = weight_val * scale_bias[0];
+              bias = weight_val * scale_bias[1];
+            }
+
+            // Index 0 of a byte is packed in its lowest BIT_RATE bits.
+            for (int64_t byte = 0; byte < num_full_bytes; ++byte) {
+              const uint8_t packed = input_row[byte];
+              float* out = output_row + byte * NUM_ELEM_PER_BYTE;
+              for (int k = 0; k < NUM_ELEM_PER_BYTE; ++k) {
+                const uint8_t quantized = (packed >> (k * BIT_RATE)) & mask;
+                out[k] = fma(scale, quantized, out[k] + bias);
+              }
+            }
+            for (int64_t j = num_full_bytes * NUM_ELEM_PER_BYTE; j < block_size;
+                 ++j) {
+              const uint8_t quantized =
+                  (input_row[j / NUM_ELEM_PER_BYTE] >>
+                   ((j % NUM_ELEM_PER_BYTE) * BIT_RATE)) &
+                  mask;
+              output_row[j] = fma(scale, quantized, output_row[j] + bias);
+            }
+          } // for each index of the bag
+        } // for each bag
+      });
   return output;
 }
 
 template <typename IndexType, typename OffsetType>
-at::Tensor& embedding_bag_4bit_impl(
+at::Tensor& embedding_bag_nbit_impl(
     at::Tensor& output,
     const at::Tensor& weight,
+    const int bit_width,
     const at::Tensor& indices,
     const at::Tensor& offsets,
     bool pruned_weights,
@@ -125,6 +134,10 @@ at::Tensor& embedding_bag_4bit_impl(
     bool include_last_offset) {
   TORCH_CHECK(weight.dim() == 2);
   TORCH_CHECK(offsets.dim() == 1);
+  TORCH_CHECK(
+      bit_width == 4 || bit_width == 2,
+      "nbit embedding_bag only supports 4-bit and 2-bit rowwise weights, got ",
+      bit_width);
 
   const auto weight_data = weight.data_ptr<uint8_t>();
   const auto indices_data = indices.data_ptr<IndexType>();
@@ -150,8 +163,10 @@ at::Tensor& embedding_bag_4bit_impl(
   const auto weight_sizes = weight.sizes();
   const int64_t N = weight_sizes[0];
   const int64_t weight_size = weight_sizes[1];
+  const int NUM_ELEM_PER_BYTE = 8 / bit_width;
   const int64_t D =
-      (weight_size - 4) * 2; // NB: 2-byte fp16 scale and 2-byte zero_offset
+      (weight_size - 2 * sizeof(at::Half)) *
+      NUM_ELEM_PER_BYTE; // NB: 2-byte fp16 scale and 2-byte zero_offset
   const int64_t M = offsets.sizes()[0];
 
   int64_t output_size = M - 1;
@@ -176,14 +191,16 @@ at::Tensor& embedding_bag_4bit_impl(
   auto* output_data = output.data_ptr<float>();
 
   const int64_t block_size = D;
-  const int index_size = indices.numel();
   constexpr int prefetch_distance = 16;
+  const float* per_sample_weights_data = per_sample_weights_.has_value()
+      ? per_sample_weights_.value().data_ptr<float>()
+      : nullptr;
 
 #ifdef USE_FBGEMM
   if (!pruned_weights || fallback_to_no_sparse) {
     // Generate the fbgemm kernel
     auto kernel = fbgemm::GenerateEmbeddingSpMDMNBit<IndexType, OffsetType>(
-        /*bit rate=*/4,
+        /*bit rate=*/bit_width,
         /*block size=*/block_size,
         /*has weights=*/per_sample_weights_.has_value(),
         /*normalize_by_lengths=*/false,
@@ -191,61 +208,84 @@ at::Tensor& embedding_bag_4bit_impl(
         /*is_weight_positional=*/false,
         /*use_offsets=*/true);
 
-    bool success = kernel(
-        /*output_size=*/output_size,
-        /*index_size=*/index_size,
-        /*data_size=*/N,
-        /*input=*/weight_data,
-        /*indices=*/indices_data,
-        /*offsets=*/offsets_data,
-        /*weights=*/
-        per_sample_weights_.has_value()
-            ? per_sample_weights_.value().data_ptr<float>()
-            : nullptr,
-        /*output=*/output_data);
+    at::parallel_for(
+        0, output_size, 1, [&](int64_t start_idx, int64_t end_idx) {
+          bool success = kernel(
+              /*output_size=*/end_idx - start_idx,
+              /*index_size=*/offsets_data[end_idx] - offsets_data[start_idx],
+              /*data_size=*/N,
+              /*input=*/weight_data,
+              /*indices=*/indices_data + offsets_data[start_idx],
+              /*offsets=*/offsets_data + start_idx,
+              /*weights=*/
+              per_sample_weights_data
+                  ? per_sample_weights_data + offsets_data[start_idx]
+                  : nullptr,
+              /*output=*/output_data + start_idx * block_size);
 
-    TORCH_CHECK(
-        success,
-        "FBGEMM GenerateEmbeddingSpMDMNBit kernel failed for 4-bit input");
+          TORCH_CHECK(
+              success,
+              "FBGEMM GenerateEmbeddingSpMDMNBit kernel failed for ",
+              bit_width,
+              "-bit input");
+        });
   } else {
     auto kernel =
         fbgemm::GenerateEmbeddingSpMDMNBitRowWiseSparse<IndexType, OffsetType>(
-            /*bit rate=*/4,
+            /*bit rate=*/bit_width,
             /*block_size=*/block_size,
             /*has weights=*/per_sample_weights_.has_value(),
             /*normalize_by_lengths=*/false,
             /*prefetch distance*/ prefetch_distance,
             /*is_weight_positional*/ false,
             /*use_offsets*/ true);
-    bool success = kernel(
-        /*output_size=*/output_size,
-        /*index_size=*/index_size,
-        /*data_size=*/compressed_index_size,
-        /*input=*/weight_data,
-        /*indices=*/indices_data,
-        /*offsets=*/offsets_data,
-        /*weights=*/
-        per_sample_weights_.has_value()
-            ? per_sample_weights_.value().data_ptr<float>()
-            : nullptr,
-        /*output=*/output_data,
-        /*compressed_indices_table=*/compressed_indices_mapping_data);
-    TORCH_CHECK(
-        success,
-        "FBGEMM GenerateEmbeddingSpMDMNBitRowWiseSparse kernel failed for 4-bit input");
+
+    at::parallel_for(
+        0, output_size, 1, [&](int64_t start_idx, int64_t end_idx) {
+          bool success = kernel(
+              /*output_size=*/end_idx - start_idx,
+              /*index_size=*/offsets_data[end_idx] - offsets_data[start_idx],
+              /*data_size=*/compressed_index_size,
+              /*input=*/weight_data,
+              /*indices=*/indices_data + offsets_data[start_idx],
+              /*offsets=*/offsets_data + start_idx,
+              /*weights=*/
+              per_sample_weights_data
+                  ? per_sample_weights_data + offsets_data[start_idx]
+                  : nullptr,
+              /*output=*/output_data + start_idx * block_size,
+              /*compressed_indices_table=*/compressed_indices_mapping_data);
+
+          TORCH_CHECK(
+              success,
+              "FBGEMM GenerateEmbeddingSpMDMNBitRowWiseSparse kernel failed for ",
+              bit_width,
+              "-bit input");
+        });
   }
   return output;
 #else
-  return embedding_lookup_fallback_impl<IndexType, OffsetType, 4, 2>(
+  if (bit_width == 4) {
+    return embedding_lookup_fallback_impl<IndexType, OffsetType, 4, 2>(
+        weight,
+        indices,
+        offsets_data,
+        per_sample_weights_,
+        compressed_indices_mapping,
+        output,
+        D,
+        output_size,
+        (pruned_weights && !fallback_to_no_sparse));
+  }
+  return embedding_lookup_fallback_impl<IndexType, OffsetType, 2, 4>(
       weight,
       indices,
-      offsets,
+      offsets_data,
       per_sample_weights_,
       compressed_indices_mapping,
       output,
       D,
       output_size,
-      include_last_offset,
       (pruned_weights && !fallback_to_no_sparse));
 #endif
 }
@@ -317,7 +357,6 @@ at::Tensor& embedding_bag_byte_impl(
   at::native::resize_(output, shape, c10::nullopt);
   auto* output_data = output.data_ptr<float>();
 
-  const int index_size = indices.numel();
 #ifdef USE_FBGEMM
   if (!pruned_weights || fallback_to_no_sparse) {
     auto kernel_i8 =
@@ -360,35 +399,39 @@ at::Tensor& embedding_bag_byte_impl(
             /*is_weight_positional=*/false,
             /*use_offsets=*/true);
 
-    auto success = kernel_i8_sparse(
-        /*output_size=*/output_size,
-        /*index_size=*/index_size,
-        /*data_size=*/compressed_index_size,
-        /*input=*/weight_data,
-        /*indices=*/indices_data,
-        /*offsets=*/offsets_data,
-        /*weights=*/
-        per_sample_weights_.has_value()
-            ? per_sample_weights_.value().data_ptr<float>()
-            : nullptr,
-        /*output=*/output_data,
-        /*compressed_indices_table=*/compressed_indices_mapping_data);
-    TORCH_CHECK(
-        success,
-        "FBGEMM GenerateEmbeddingSpMDMRowWiseSparse kernel failed for 8-bit input");
+    at::parallel_for(
+        0, output_size, 1, [&](int64_t start_idx, int64_t end_idx) {
+          auto success = kernel_i8_sparse(
+              /*output_size=*/end_idx - start_idx,
+              /*index_size=*/offsets_data[end_idx] - offsets_data[start_idx],
+              /*data_size=*/compressed_index_size,
+              /*input=*/weight_data,
+              /*indices=*/indices_data + offsets_data[start_idx],
+              /*offsets=*/offsets_data + start_idx,
+              /*weights=*/
+              per_sample_weights_
+                  ? per_sample_weights_.value().data_ptr<float>() +
+                      offsets_data[start_idx]
+                  : nullptr,
+              /*output=*/output_data + start_idx * D,
+              /*compressed_indices_table=*/compressed_indices_mapping_data);
+
+          TORCH_CHECK(
+              success,
+              "FBGEMM GenerateEmbeddingSpMDMRowWiseSparse kernel failed for 8-bit input");
+        });
   }
   return output;
 #else
   return embedding_lookup_fallback_impl<IndexType, OffsetType, 8, 1>(
       weight,
       indices,
-      offsets,
+      offsets_data,
       per_sample_weights_,
       compressed_indices_mapping,
       output,
       D,
       output_size,
-      include_last_offset,
       (pruned_weights && !fallback_to_no_sparse));
 #endif
 }
@@ -491,9 +534,10 @@ at::Tensor& embedding_bag_byte_helper(
       is_embedding_op);
 }
 
-at::Tensor& embedding_bag_4bit_helper(
+at::Tensor& embedding_bag_nbit_helper(
     at::Tensor& output,
     const at::Tensor& weight,
+    const int bit_width,
     const at::Tensor& indices,
     const c10::optional<at::Tensor>& offsets_in,
     bool pruned_weights,
@@ -511,14 +555,18 @@ at::Tensor& embedding_bag_4bit_helper(
   if (indices.dim() == 2) {
     TORCH_CHECK(
         !offsets_in.has_value(),
-        "embedding_bag_4bit operator: input is 2D, then offsets has to be None, as input is treated is a mini-batch of fixed length sequences.");
+        "embedding_bag_",
+        bit_width,
+        "bit operator: input is 2D, then offsets has to be None, as input is treated is a mini-batch of fixed length sequences.");
 
     offsets = at::arange(
         0, indices.numel(), indices.sizes()[1], indices.scalar_type());
   } else {
     TORCH_CHECK(
         offsets_in.has_value(),
-        "embedding_bag_4bit operator expects offsets to be set for 1D indices.");
+        "embedding_bag_",
+        bit_width,
+        "bit operator expects offsets to be set for 1D indices.");
     offsets = offsets_in.value();
   }
 
@@ -540,9 +588,10 @@ at::Tensor& embedding_bag_4bit_helper(
   // Using helper function to support different type combination without the
   // need to cast, which can be additional performance overhead
   if (indices.scalar_type() == at::kInt && offsets.scalar_type() == at::kInt) {
-    return embedding_bag_4bit_impl<int, int>(
+    return embedding_bag_nbit_impl<int, int>(
         output,
         weight,
+        bit_width,
         indices,
         offsets,
         pruned_weights,
@@ -551,9 +600,10 @@ at::Tensor& embedding_bag_4bit_helper(
         include_last_offset);
   } else if (
       indices.scalar_type() == at::kInt && offsets.scalar_type() == at::kLong) {
-    return embedding_bag_4bit_impl<int, int64_t>(
+    return embedding_bag_nbit_impl<int, int64_t>(
         output,
         weight,
+        bit_width,
         indices,
         offsets,
         pruned_weights,
@@ -562,9 +612,10 @@ at::Tensor& embedding_bag_4bit_helper(
         include_last_offset);
   } else if (
       indices.scalar_type() == at::kLong && offsets.scalar_type() == at::kInt) {
-    return embedding_bag_4bit_impl<int64_t, int>(
+    return embedding_bag_nbit_impl<int64_t, int>(
         output,
         weight,
+        bit_width,
         indices,
         offsets,
         pruned_weights,
@@ -572,9 +623,10 @@ at::Tensor& embedding_bag_4bit_helper(
         compressed_indices_mapping,
         include_last_offset);
   }
-  return embedding_bag_4bit_impl<int64_t, int64_t>(
+  return embedding_bag_nbit_impl<int64_t, int64_t>(
       output,
       weight,
+      bit_width,
       indices,
       offsets,
       pruned_weights,
@@ -622,9 +674,10 @@ at::Tensor PackedEmbeddingBagWeight::embeddingbag_4bit(
   }
 
   auto output = at::empty({0}, packed_w.options().dtype(at::kFloat));
-  return embedding_bag_4bit_helper(
+  return embedding_bag_nbit_helper(
     output,
     packed_w,
+    4 /* bit_width */,
     indices,
     offsets_in,
     pruned_weights,
@@ -688,18 +741,16 @@ Tensor embedding_bag_byte_rowwise_offsets(
   return output;
 }
 
-Tensor& embedding_bag_4bit_rowwise_offsets_out(
+Tensor& embedding_bag_nbit_rowwise_offsets_out(
     Tensor& output,
     const Tensor& weight,
+    const int bit_width,
     const Tensor& indices,
     const c10::optional<Tensor>& offsets_in,
-    const bool /* scale_grad_by_freq */,
-    const int64_t /* mode */,
     bool pruned_weights,
     const c10::optional<Tensor>& per_sample_weights_,
     const c10::optional<Tensor>& compressed_indices_mapping,
     bool include_last_offset) {
-
   if (per_sample_weights_.has_value()) {
     TORCH_CHECK(
         (per_sample_weights_.value().scalar_type() == at::kFloat ||
@@ -708,9 +759,10 @@ Tensor& embedding_bag_4bit_rowwise_offsets_out(
         per_sample_weights_.value().scalar_type(),
         " instead")
   }
-  return embedding_bag_4bit_helper(
+  return embedding_bag_nbit_helper(
       output,
       weight,
+      bit_width,
       indices,
       offsets_in,
       pruned_weights,
@@ -721,6 +773,29 @@ Tensor& embedding_bag_4bit_rowwise_offsets_out(
       include_last_offset);
 }
 
+Tensor& embedding_bag_4bit_rowwise_offsets_out(
+    Tensor& output,
+    const Tensor& weight,
+    const Tensor& indices,
+    const c10::optional<Tensor>& offsets_in,
+    const bool /* scale_grad_by_freq */,
+    const int64_t /* mode */,
+    bool pruned_weights,
+    const c10::optional<Tensor>& per_sample_weights_,
+    const c10::optional<Tensor>& compressed_indices_mapping,
+    bool include_last_offset) {
+  return embedding_bag_nbit_rowwise_offsets_out(
+      output,
+      weight,
+      4 /* bit_width */,
+      indices,
+      offsets_in,
+      pruned_weights,
+      per_sample_weights_,
+      compressed_indices_mapping,
+      include_last_offset);
+}
+
 Tensor embedding_bag_4bit_rowwise_offsets(
     const Tensor& weight,
     const Tensor& indices,
@@ -748,6 +823,34 @@ Tensor embedding_bag_4bit_rowwise_offsets(
   return output;
 }
 
+// Same as embedding_bag_4bit_rowwise_offsets, over rows packed by
+// embedding_bag_2bit_prepack (four 2-bit values per byte).
+Tensor embedding_bag_2bit_rowwise_offsets(
+    const Tensor& weight,
+    const Tensor& indices,
+    const c10::optional<Tensor>& offsets_in,
+    const bool /* scale_grad_by_freq */,
+    const int64_t /* mode */,
+    bool pruned_weights,
+    const c10::optional<Tensor>& per_sample_weights_,
+    const c10::optional<Tensor>& compressed_indices_mapping,
+    bool include_last_offset) {
+
+  auto output = at::empty({0}, weight.options().dtype(at::kFloat));
+  embedding_bag_nbit_rowwise_offsets_out(
+    output,
+    weight,
+    2 /* bit_width */,
+    indices,
+    offsets_in,
+    pruned_weights,
+    per_sample_weights_,
+    compressed_indices_mapping,
+    include_last_offset
+  );
+  return output;
+}
+
 template <int bit_rate>
 class QEmbeddingBag final {
  public:
@@ -833,6 +936,9 @@ TORCH_LIBRARY_IMPL(quantized, CPU, m) {
   m.impl(
       TORCH_SELECTIVE_NAME("quantized::embedding_bag_4bit_rowwise_offsets"),
       embedding_bag_4bit_rowwise_offsets);
+  m.impl(
+      TORCH_SELECTIVE_NAME("quantized::embedding_bag_2bit_rowwise_offsets"),
+      embedding_bag_2bit_rowwise_offsets);
 }
 } // namespace
 } // namespace native
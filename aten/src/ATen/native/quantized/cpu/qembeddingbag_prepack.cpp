@@ -315,7 +315,6 @@ Tensor qembeddingbag_4bit_prepack(
 // To later de-quantize values, the scale (range / 3) and zero_point
 // are stored alongside the data. More precisely, each row first has quantized
 // values, and then 2-byte fp16 scale and 2-byte zero_offset.
-// TODO() - Add 2Bit Embedding Lookup operator.
 Tensor qembeddingbag_2bit_prepack(
     const Tensor& weight,
     bool optimized_qparams) {
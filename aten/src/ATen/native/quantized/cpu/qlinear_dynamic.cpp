@@ -17,7 +17,10 @@ torch::class_<LinearPackedParamsBase> register_linear_params();
 
 #ifdef USE_FBGEMM
 template <bool ReluFused>
-at::Tensor PackedLinearWeight::apply_dynamic_impl(at::Tensor input, bool reduce_range) {
+at::Tensor& PackedLinearWeight::apply_dynamic_impl(
+    const at::Tensor& input,
+    at::Tensor& output,
+    bool reduce_range) {
   using at::Tensor;
   // fp32 * int8 -> fp32 (with quantization on activation, and dequantization
   // on the result).
@@ -80,15 +83,15 @@ at::Tensor PackedLinearWeight::apply_dynamic_impl(at::Tensor input, bool reduce_
   // ReQuantizeForFloat won't index past 0.
 
   const float* bias_ptr = nullptr;
-  at::Tensor bias_vec;
+  at::Tensor bias_contig;
   if (bias_.has_value()) {
-    bias_vec = bias_.value();
+    const at::Tensor& bias_vec = bias_.value();
     TORCH_CHECK(bias_vec.dim() == 1, "bias should be a vector (1D Tensor)");
     TORCH_CHECK(
         bias_vec.size(0) == N,
         "bias should have N elements: " + std::to_string(N));
     // TODO: contiguous is called for further jit optimizations.
-    auto bias_contig = bias_vec.contiguous();
+    bias_contig = bias_vec.contiguous();
     bias_ptr = bias_contig.data_ptr<float>();
   }
   // The resulting matrix here is 2-D, let's view it with the original
@@ -97,12 +100,17 @@ at::Tensor PackedLinearWeight::apply_dynamic_impl(at::Tensor input, bool reduce_
   // 2. If the input tensor is {b, M, K}, the output tensor is {b, M, N}.
   std::vector<int64_t> out_sizes = input.sizes().vec();
   out_sizes.back() = N;
-  // Allocate output Tensor and a buffer for fbgemmPacked to use
-  auto output = at::empty(out_sizes, input.options().dtype(at::kFloat));
-  auto buffer = at::empty_like(
-      output,
-      output.options().dtype(at::kInt),
-      LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  TORCH_CHECK(
+      output.scalar_type() == at::kFloat,
+      "dynamic quantized linear expects a float output, got ",
+      output.scalar_type());
+  at::native::resize_(output, out_sizes, c10::nullopt);
+  TORCH_CHECK(output.is_contiguous(), "output should be contiguous");
+  float* output_ptr = output.data_ptr<float>();
+  // fbgemmPacked supports accumulating the int32 tiles in the output itself
+  // (C_buffer aliasing C) and dequantizing them in place, so no separate
+  // int32 buffer is allocated per call.
+  int32_t* buffer_ptr = reinterpret_cast<int32_t*>(output_ptr);
 
   int num_tasks = at::get_num_threads();
   at::parallel_for(0, num_tasks, 1, [&](int64_t begin, int64_t end) {
@@ -160,8 +168,8 @@ at::Tensor PackedLinearWeight::apply_dynamic_impl(at::Tensor input, bool reduce_
         fbgemm::fbgemmPacked(
             /*packA=*/packA,
             /*packB=*/*packB,
-            /*C=*/output.data_ptr<float>(),
-            /*C_buffer=*/buffer.data_ptr<int32_t>(),
+            /*C=*/output_ptr,
+            /*C_buffer=*/buffer_ptr,
             /*ldc=*/N,
             /*outProcess=*/outputProcObj,
             /*thread_id=*/task_id,
@@ -194,8 +202,8 @@ at::Tensor PackedLinearWeight::apply_dynamic_impl(at::Tensor input, bool reduce_
         fbgemm::fbgemmPacked(
             /*packA=*/packA,
             /*packB=*/*packB,
-            /*C=*/output.data_ptr<float>(),
-            /*C_buffer=*/buffer.data_ptr<int32_t>(),
+            /*C=*/output_ptr,
+            /*C_buffer=*/buffer_ptr,
             /*ldc=*/N,
             /*outProcess=*/outputProcObj,
             /*thread_id=*/task_id,
@@ -208,11 +216,27 @@ at::Tensor PackedLinearWeight::apply_dynamic_impl(at::Tensor input, bool reduce_
 }
 
 at::Tensor PackedLinearWeight::apply_dynamic(at::Tensor input, bool reduce_range) {
-  return apply_dynamic_impl</*ReluFused=*/false>(std::move(input), reduce_range);
+  auto output = at::empty({0}, input.options().dtype(at::kFloat));
+  return apply_dynamic_impl</*ReluFused=*/false>(input, output, reduce_range);
 }
 
 at::Tensor PackedLinearWeight::apply_dynamic_relu(at::Tensor input, bool reduce_range) {
-  return apply_dynamic_impl</*ReluFused=*/true>(std::move(input), reduce_range);
+  auto output = at::empty({0}, input.options().dtype(at::kFloat));
+  return apply_dynamic_impl</*ReluFused=*/true>(input, output, reduce_range);
+}
+
+at::Tensor& PackedLinearWeight::apply_dynamic_out(
+    const at::Tensor& input,
+    at::Tensor& output,
+    bool reduce_range) {
+  return apply_dynamic_impl</*ReluFused=*/false>(input, output, reduce_range);
+}
+
+at::Tensor& PackedLinearWeight::apply_dynamic_relu_out(
+    const at::Tensor& input,
+    at::Tensor& output,
+    bool reduce_range) {
+  return apply_dynamic_impl</*ReluFused=*/true>(input, output, reduce_range);
 }
 
 #endif // USE_FBGEMM
@@ -357,7 +381,9 @@ at::Tensor PackedLinearWeightsQnnp::apply_dynamic_relu(at::Tensor input, bool re
 #ifdef USE_FBGEMM
 
 template <bool ReluFused>
-at::Tensor PackedLinearWeightFp16::apply_dynamic_impl(at::Tensor input) {
+at::Tensor& PackedLinearWeightFp16::apply_dynamic_impl(
+    const at::Tensor& input,
+    at::Tensor& output) {
   const at::Tensor input_contig = input.contiguous();
   const float* input_ptr = input_contig.data_ptr<float>();
 
@@ -370,7 +396,21 @@ at::Tensor PackedLinearWeightFp16::apply_dynamic_impl(at::Tensor input) {
   const int64_t N = packed_weight_fp16.numCols();
   std::vector<int64_t> output_size = input.sizes().vec();
   output_size.back() = N;
-  at::Tensor output = at::empty(output_size, input.options().dtype(at::kFloat));
+  TORCH_CHECK(
+      output.scalar_type() == at::kFloat,
+      "dynamic fp16 linear expects a float output, got ",
+      output.scalar_type());
+  at::native::resize_(output, output_size, c10::nullopt);
+  TORCH_CHECK(output.is_contiguous(), "output should be contiguous");
+
+  // The bias is broadcast into the output, which the gemm then accumulates
+  // into (beta = 1), instead of being added in another pass over the output.
+  float beta = 0.0f;
+  if (bias_.has_value() && bias_->defined()) {
+    TORCH_CHECK(bias_->dim() == 1);
+    output.copy_(bias_->expand(output.sizes()));
+    beta = 1.0f;
+  }
 
   // Call the fp16 gemm interface
   fbgemm::cblas_gemm_compute(
@@ -378,24 +418,38 @@ at::Tensor PackedLinearWeightFp16::apply_dynamic_impl(at::Tensor input) {
       M,
       input_ptr,
       packed_weight_fp16,
-      0.0f,
+      beta,
       output.data_ptr<float>());
 
-  // Add bias term
-  if (bias_.has_value()) {
-    TORCH_CHECK(bias_->dim() == 1);
-    output.add_(*bias_);
+  if (ReluFused) {
+    output.relu_();
   }
 
   return output;
 }
 
 at::Tensor PackedLinearWeightFp16::apply_dynamic(at::Tensor input, bool reduce_range) {
-  return apply_dynamic_impl</*ReluFused=*/false>(std::move(input));
+  auto output = at::empty({0}, input.options().dtype(at::kFloat));
+  return apply_dynamic_impl</*ReluFused=*/false>(input, output);
 }
 
 at::Tensor PackedLinearWeightFp16::apply_dynamic_relu(at::Tensor input, bool reduce_range) {
-  return apply_dynamic_impl</*ReluFused=*/true>(std::move(input));
+  auto output = at::empty({0}, input.options().dtype(at::kFloat));
+  return apply_dynamic_impl</*ReluFused=*/true>(input, output);
+}
+
+at::Tensor& PackedLinearWeightFp16::apply_dynamic_out(
+    const at::Tensor& input,
+    at::Tensor& output,
+    bool /* reduce_range */) {
+  return apply_dynamic_impl</*ReluFused=*/false>(input, output);
+}
+
+at::Tensor& PackedLinearWeightFp16::apply_dynamic_relu_out(
+    const at::Tensor& input,
+    at::Tensor& output,
+    bool /* reduce_range */) {
+  return apply_dynamic_impl</*ReluFused=*/true>(input, output);
 }
 
 void PackedLinearWeightFp16::set_bias(c10::optional<at::Tensor> bias) {
@@ -438,8 +492,11 @@ class QLinearDynamicFp16 final {
     TORCH_CHECK(
         fbgemm::fbgemmSupportedCPU(), "Your CPU doesn't support FBGEMM.");
 
-    TORCH_INTERNAL_ASSERT(!ReluFused);
-    return packed_weight->apply_dynamic(std::move(input));
+    if (ReluFused) {
+      return packed_weight->apply_dynamic_relu(std::move(input));
+    } else {
+      return packed_weight->apply_dynamic(std::move(input));
+    }
   }
 #else // USE_FBGEMM
   static at::Tensor run(
@@ -458,6 +515,7 @@ TORCH_LIBRARY_IMPL(quantized, CPU, m) {
   m.impl(TORCH_SELECTIVE_NAME("quantized::linear_dynamic"), TORCH_FN(QLinearDynamicInt8<false>::run));
   m.impl(TORCH_SELECTIVE_NAME("quantized::linear_relu_dynamic"), TORCH_FN(QLinearDynamicInt8<true>::run));
   m.impl(TORCH_SELECTIVE_NAME("quantized::linear_dynamic_fp16"), TORCH_FN(QLinearDynamicFp16<false>::run));
+  m.impl(TORCH_SELECTIVE_NAME("quantized::linear_relu_dynamic_fp16"), TORCH_FN(QLinearDynamicFp16<true>::run));
 }
 
 TORCH_LIBRARY_IMPL(_quantized, CPU, m) {
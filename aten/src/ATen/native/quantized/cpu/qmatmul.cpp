@@ -0,0 +1,154 @@
+#include <ATen/ATen.h>
+#include <ATen/ExpandUtils.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/Parallel.h>
+#include <ATen/quantized/Quantizer.h>
+#include <c10/util/accumulate.h>
+#include <torch/library.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace at {
+namespace native {
+
+namespace {
+
+// Computes qc[b] = requant(sum_k (qa[b, m, k] - za) * (qb[b, k, n] - zb))
+// with int32 accumulation. qb is centered once into int16 so that the inner
+// loop is a plain multiply-add over contiguous columns.
+template <typename underlying_t>
+void qmatmul_kernel(
+    const underlying_t* a_data,
+    const underlying_t* b_data,
+    underlying_t* c_data,
+    int64_t batches,
+    int64_t M,
+    int64_t K,
+    int64_t N,
+    int32_t a_zero_point,
+    int32_t b_zero_point,
+    float multiplier,
+    int32_t output_zero_point) {
+  std::vector<int16_t> b_centered(batches * K * N);
+  at::parallel_for(
+      0,
+      batches * K,
+      std::max<int64_t>(1, at::internal::GRAIN_SIZE / std::max<int64_t>(N, 1)),
+      [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin * N; i < end * N; ++i) {
+          b_centered[i] =
+              static_cast<int16_t>(static_cast<int32_t>(b_data[i]) - b_zero_point);
+        }
+      });
+
+  constexpr int32_t qmin = std::numeric_limits<underlying_t>::min();
+  constexpr int32_t qmax = std::numeric_limits<underlying_t>::max();
+  const int64_t grain_size =
+      std::max<int64_t>(1, at::internal::GRAIN_SIZE / std::max<int64_t>(K * N, 1));
+  at::parallel_for(0, batches * M, grain_size, [&](int64_t begin, int64_t end) {
+    std::vector<int32_t> acc(N);
+    for (int64_t row = begin; row < end; ++row) {
+      const int64_t b = row / M;
+      const underlying_t* a_row = a_data + row * K;
+      const int16_t* b_mat = b_centered.data() + b * K * N;
+      std::fill(acc.begin(), acc.end(), 0);
+      for (int64_t k = 0; k < K; ++k) {
+        const int32_t a_val = static_cast<int32_t>(a_row[k]) - a_zero_point;
+        const int16_t* b_row = b_mat + k * N;
+        for (int64_t n = 0; n < N; ++n) {
+          acc[n] += a_val * static_cast<int32_t>(b_row[n]);
+        }
+      }
+      underlying_t* c_row = c_data + row * N;
+      for (int64_t n = 0; n < N; ++n) {
+        const int32_t q =
+            static_cast<int32_t>(std::nearbyint(acc[n] * multiplier)) +
+            output_zero_point;
+        c_row[n] = static_cast<underlying_t>(std::min(qmax, std::max(qmin, q)));
+      }
+    }
+  });
+}
+
+Tensor qmatmul(
+    Tensor qa,
+    Tensor qb,
+    double output_scale,
+    int64_t output_zero_point) {
+  TORCH_CHECK(
+      qa.dim() >= 2 && qb.dim() >= 2,
+      "quantized::matmul: expected both inputs to be at least 2D, got ",
+      qa.dim(), "D and ", qb.dim(), "D");
+  TORCH_CHECK(
+      qa.qscheme() == kPerTensorAffine && qb.qscheme() == kPerTensorAffine,
+      "quantized::matmul only supports per tensor quantization.");
+  TORCH_CHECK(
+      qa.scalar_type() == qb.scalar_type(),
+      "quantized::matmul: both inputs should have the same dtype, got ",
+      qa.scalar_type(), " and ", qb.scalar_type());
+  TORCH_CHECK(
+      qa.scalar_type() == kQUInt8 || qa.scalar_type() == kQInt8,
+      "quantized::matmul only supports quint8 and qint8 inputs, got ",
+      qa.scalar_type());
+
+  const int64_t M = qa.size(-2);
+  const int64_t K = qa.size(-1);
+  const int64_t N = qb.size(-1);
+  TORCH_CHECK(
+      qb.size(-2) == K,
+      "quantized::matmul: size mismatch, got ", qa.sizes(), " and ",
+      qb.sizes());
+
+  // Broadcast the leading (batch) dimensions like at::matmul does.
+  const std::vector<int64_t> batch_shape = infer_size(
+      qa.sizes().slice(0, qa.dim() - 2), qb.sizes().slice(0, qb.dim() - 2));
+  const int64_t batches = c10::multiply_integers(batch_shape);
+  std::vector<int64_t> a_shape(batch_shape);
+  a_shape.insert(a_shape.end(), {M, K});
+  std::vector<int64_t> b_shape(batch_shape);
+  b_shape.insert(b_shape.end(), {K, N});
+  std::vector<int64_t> c_shape(batch_shape);
+  c_shape.insert(c_shape.end(), {M, N});
+
+  const Tensor a_contig = qa.sizes().equals(a_shape)
+      ? qa.contiguous()
+      : qa.expand(a_shape).contiguous();
+  const Tensor b_contig = qb.sizes().equals(b_shape)
+      ? qb.contiguous()
+      : qb.expand(b_shape).contiguous();
+
+  Tensor qc = at::_empty_affine_quantized(
+      c_shape, qa.options(), output_scale, output_zero_point);
+  if (qc.numel() == 0) {
+    return qc;
+  }
+
+  const float multiplier = static_cast<float>(
+      qa.q_scale() * qb.q_scale() / output_scale);
+  AT_DISPATCH_QINT_TYPES(qa.scalar_type(), "qmatmul", [&]() {
+    qmatmul_kernel<underlying_t>(
+        reinterpret_cast<const underlying_t*>(a_contig.data_ptr<scalar_t>()),
+        reinterpret_cast<const underlying_t*>(b_contig.data_ptr<scalar_t>()),
+        reinterpret_cast<underlying_t*>(qc.data_ptr<scalar_t>()),
+        batches,
+        M,
+        K,
+        N,
+        static_cast<int32_t>(qa.q_zero_point()),
+        static_cast<int32_t>(qb.q_zero_point()),
+        multiplier,
+        static_cast<int32_t>(output_zero_point));
+  });
+  return qc;
+}
+
+TORCH_LIBRARY_IMPL(quantized, QuantizedCPU, m) {
+  m.impl(TORCH_SELECTIVE_NAME("quantized::matmul"), TORCH_FN(qmatmul));
+}
+
+} // namespace
+
+}} // namespace at::native
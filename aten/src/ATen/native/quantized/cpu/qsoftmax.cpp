@@ -0,0 +1,133 @@
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/Parallel.h>
+#include <ATen/WrapDimUtils.h>
+#include <ATen/quantized/Quantizer.h>
+#include <torch/library.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace at {
+namespace native {
+
+namespace {
+
+// With per tensor quantization x = s * (q - zp), so along a softmax slice
+//   exp(x - max(x)) = exp(-s * (max(q) - q)),
+// and max(q) - q only takes 256 values for 8-bit inputs. The exponentials are
+// looked up in a table instead of being computed per element.
+constexpr int kLutSize = 256;
+
+template <typename underlying_t>
+void qsoftmax_kernel(
+    const underlying_t* x_data,
+    underlying_t* y_data,
+    int64_t outer_size,
+    int64_t dim_size,
+    int64_t inner_size,
+    const std::array<float, kLutSize>& lut,
+    float inv_output_scale,
+    int32_t output_zero_point) {
+  constexpr int32_t qmin = std::numeric_limits<underlying_t>::min();
+  constexpr int32_t qmax = std::numeric_limits<underlying_t>::max();
+  const int64_t grain_size = std::max<int64_t>(
+      1, at::internal::GRAIN_SIZE / std::max<int64_t>(dim_size * inner_size, 1));
+  at::parallel_for(0, outer_size, grain_size, [&](int64_t begin, int64_t end) {
+    // Reduced over dim for each of the inner_size positions of a slice.
+    std::vector<int32_t> max_q(inner_size);
+    std::vector<float> sum(inner_size);
+    for (int64_t o = begin; o < end; ++o) {
+      const underlying_t* x = x_data + o * dim_size * inner_size;
+      underlying_t* y = y_data + o * dim_size * inner_size;
+      std::fill(max_q.begin(), max_q.end(), qmin);
+      for (int64_t d = 0; d < dim_size; ++d) {
+        for (int64_t i = 0; i < inner_size; ++i) {
+          max_q[i] = std::max(max_q[i], static_cast<int32_t>(x[d * inner_size + i]));
+        }
+      }
+      std::fill(sum.begin(), sum.end(), 0.f);
+      for (int64_t d = 0; d < dim_size; ++d) {
+        for (int64_t i = 0; i < inner_size; ++i) {
+          sum[i] += lut[max_q[i] - static_cast<int32_t>(x[d * inner_size + i])];
+        }
+      }
+      for (int64_t i = 0; i < inner_size; ++i) {
+        sum[i] = inv_output_scale / sum[i];
+      }
+      for (int64_t d = 0; d < dim_size; ++d) {
+        for (int64_t i = 0; i < inner_size; ++i) {
+          const float val =
+              lut[max_q[i] - static_cast<int32_t>(x[d * inner_size + i])] * sum[i];
+          const int32_t q =
+              static_cast<int32_t>(std::nearbyint(val)) + output_zero_point;
+          y[d * inner_size + i] =
+              static_cast<underlying_t>(std::min(qmax, std::max(qmin, q)));
+        }
+      }
+    }
+  });
+}
+
+Tensor qsoftmax(
+    const Tensor& qx,
+    int64_t dim,
+    double output_scale,
+    int64_t output_zero_point) {
+  TORCH_CHECK(
+      qx.qscheme() == kPerTensorAffine,
+      "quantized::softmax only supports per tensor quantization.");
+  TORCH_CHECK(
+      qx.scalar_type() == kQUInt8 || qx.scalar_type() == kQInt8,
+      "quantized::softmax only supports quint8 and qint8 inputs, got ",
+      qx.scalar_type());
+  const int64_t ndim = std::max<int64_t>(qx.dim(), 1);
+  dim = maybe_wrap_dim(dim, ndim);
+
+  const Tensor qx_contig = qx.contiguous();
+  Tensor qy = at::_empty_affine_quantized(
+      qx_contig.sizes(), qx.options(), output_scale, output_zero_point);
+  if (qy.numel() == 0) {
+    return qy;
+  }
+
+  int64_t outer_size = 1;
+  int64_t inner_size = 1;
+  const int64_t dim_size = qx.dim() > 0 ? qx.size(dim) : 1;
+  for (int64_t i = 0; i < dim; ++i) {
+    outer_size *= qx.size(i);
+  }
+  for (int64_t i = dim + 1; i < qx.dim(); ++i) {
+    inner_size *= qx.size(i);
+  }
+
+  std::array<float, kLutSize> lut;
+  const double input_scale = qx.q_scale();
+  for (int i = 0; i < kLutSize; ++i) {
+    lut[i] = static_cast<float>(std::exp(-input_scale * i));
+  }
+
+  AT_DISPATCH_QINT_TYPES(qx.scalar_type(), "qsoftmax", [&]() {
+    qsoftmax_kernel<underlying_t>(
+        reinterpret_cast<const underlying_t*>(qx_contig.data_ptr<scalar_t>()),
+        reinterpret_cast<underlying_t*>(qy.data_ptr<scalar_t>()),
+        outer_size,
+        dim_size,
+        inner_size,
+        lut,
+        static_cast<float>(1.0 / output_scale),
+        static_cast<int32_t>(output_zero_point));
+  });
+  return qy;
+}
+
+TORCH_LIBRARY_IMPL(quantized, QuantizedCPU, m) {
+  m.impl(TORCH_SELECTIVE_NAME("quantized::softmax"), TORCH_FN(qsoftmax));
+}
+
+} // namespace
+
+}} // namespace at::native
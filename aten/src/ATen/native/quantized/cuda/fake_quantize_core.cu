@@ -53,7 +53,11 @@ void fake_quantize_tensor_cachemask_kernel_cuda(
 }
 
 void _fake_quantize_grad_learnable_tensor_kernel_cuda(
-    TensorIterator& iter,
+    Tensor& dX,
+    Tensor& dScale,
+    Tensor& dZeroPoint,
+    const Tensor& X,
+    const Tensor& dY,
     float scale,
     float inv_scale,
     int64_t zero_point,
@@ -62,6 +66,15 @@ void _fake_quantize_grad_learnable_tensor_kernel_cuda(
     float grad_factor) {
   float dscale_small = quant_min - zero_point;
   float dscale_big = quant_max - zero_point;
+  auto dScale_vec = at::empty_like(X, X.options(), MemoryFormat::Preserve);
+  auto dZeroPoint_vec = at::empty_like(X, X.options(), MemoryFormat::Preserve);
+  auto iter = TensorIteratorConfig()
+    .add_output(dX)
+    .add_output(dScale_vec)
+    .add_output(dZeroPoint_vec)
+    .add_input(X)
+    .add_input(dY)
+    .build();
   gpu_kernel_multiple_outputs(
     iter, [=] GPU_LAMBDA (float XInput, float dYInput) -> thrust::tuple<float, float, float> {
       float dXOutput, dZeroPointOutput, dScaleOutput;
@@ -77,6 +90,8 @@ void _fake_quantize_grad_learnable_tensor_kernel_cuda(
       }
       return {dXOutput, dScaleOutput, dZeroPointOutput};
   });
+  at::sum_out(dScale, dScale_vec.reshape(-1), 0, /*keepdim=*/true);
+  at::sum_out(dZeroPoint, dZeroPoint_vec.reshape(-1), 0, /*keepdim=*/true);
 }
 
 REGISTER_DISPATCH(fake_quant_tensor_cachemask_stub, &fake_quantize_tensor_cachemask_kernel_cuda);
@@ -18,8 +18,14 @@ using fake_quant_tensor_cachemask_fn = void (*)(
     int64_t quant_min,
     int64_t quant_max);
 
+// Writes dX and reduces the scale and zero point gradients into the
+// one element dScale and dZeroPoint, reading X and dY once.
 using fake_quant_learnable_grad_tensor_fn = void (*)(
-    TensorIterator& iter,
+    Tensor& dX,
+    Tensor& dScale,
+    Tensor& dZeroPoint,
+    const Tensor& X,
+    const Tensor& dY,
     float scale,
     float inv_scale,
     int64_t zero_point,
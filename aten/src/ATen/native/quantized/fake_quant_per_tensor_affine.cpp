@@ -172,23 +172,17 @@ std::tuple<Tensor, Tensor, Tensor> _fake_quantize_learnable_per_tensor_affine_ba
   }
 
   auto dX = at::empty_like(X, X.options(), MemoryFormat::Preserve);
-  auto dScale_vec = at::empty_like(X, X.options(), MemoryFormat::Preserve);
-  auto dZeroPoint_vec = at::empty_like(X, X.options(), MemoryFormat::Preserve);
-
-  auto iter = TensorIteratorConfig()
-    .add_output(dX)
-    .add_output(dScale_vec)
-    .add_output(dZeroPoint_vec)
-    .add_input(X)
-    .add_input(dY)
-    .build();
+  auto dScale = at::empty({1}, X.options());
+  auto dZeroPoint = at::empty({1}, X.options());
 
+  // The scale and zero point gradients are summed over X by the kernel,
+  // instead of being written out per element and summed afterwards.
   fake_quant_grad_learnable_tensor_stub(
-    X.device().type(), iter, scale_val, inv_scale_val, zero_point_val, quant_min, quant_max, grad_factor);
+    X.device().type(), dX, dScale, dZeroPoint, X, dY, scale_val, inv_scale_val, zero_point_val,
+    quant_min, quant_max, grad_factor);
 
-  // The total sums over the scale and zero point gradient vectors are what will be returned in the end.
-  auto dScale = dScale_vec.sum().unsqueeze(0).to(scale.device());
-  auto dZeroPoint = dZeroPoint_vec.sum().unsqueeze(0).to(zero_point.device());
+  dScale = dScale.to(scale.device());
+  dZeroPoint = dZeroPoint.to(zero_point.device());
 
   return std::make_tuple(dX, dScale, dZeroPoint);
 }
@@ -0,0 +1,164 @@
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+
+#include <limits>
+#include <tuple>
+
+// Moving average min/max observer fused with the FakeQuantize op, for the
+// PerTensorAffine and PerChannelAffine quantization schemes.
+namespace at {
+namespace native {
+
+namespace {
+
+/* Moves running_min and running_max towards the min and max of x, like
+MovingAverageMinMaxObserver and MovingAveragePerChannelMinMaxObserver do.
+The first observation, of inf and -inf per tensor or of empty tensors per
+channel, is taken as is.
+*/
+void update_moving_average_min_max(
+    const Tensor& x,
+    Tensor& running_min,
+    Tensor& running_max,
+    double averaging_const,
+    int64_t ch_axis,
+    bool per_row_fake_quant) {
+  Tensor x_min, x_max;
+  if (per_row_fake_quant) {
+    // channels first, all the other dimensions flattened
+    std::tie(x_min, x_max) = at::_aminmax(x.transpose(0, ch_axis).flatten(1), 1);
+    if (running_min.numel() == 0 || running_max.numel() == 0) {
+      running_min.resize_(x_min.sizes()).copy_(x_min);
+      running_max.resize_(x_max.sizes()).copy_(x_max);
+      return;
+    }
+  } else {
+    std::tie(x_min, x_max) = at::_aminmax(x);
+  }
+  // Selected without reading the running values back, as they may live on
+  // the GPU; the moving average of the first observation is nan.
+  const auto first = running_min.eq(std::numeric_limits<float>::infinity())
+      .logical_and_(running_max.eq(-std::numeric_limits<float>::infinity()));
+  running_min.copy_(at::where(first, x_min, running_min + averaging_const * (x_min - running_min)));
+  running_max.copy_(at::where(first, x_max, running_max + averaging_const * (x_max - running_max)));
+}
+
+/* Computes scale and zero_point for the running range, like
+_ObserverBase._calculate_qparams does for the affine and symmetric schemes.
+The symmetric zero point is 0 for signed and the midpoint for unsigned ranges.
+*/
+void calculate_moving_average_qparams(
+    const Tensor& running_min,
+    const Tensor& running_max,
+    Tensor& scale,
+    Tensor& zero_point,
+    int64_t quant_min,
+    int64_t quant_max,
+    bool symmetric_quant) {
+  const float eps = std::numeric_limits<float>::epsilon();
+  const auto min_val_neg = at::clamp_max(running_min, 0);
+  auto max_val_pos = at::clamp_min(running_max, 0);
+  Tensor new_scale, new_zero_point;
+  if (symmetric_quant) {
+    max_val_pos = at::maximum(min_val_neg.neg(), max_val_pos);
+    new_scale = (max_val_pos / (static_cast<double>(quant_max - quant_min) / 2)).clamp_min_(eps);
+    const int64_t midpoint = quant_min < 0 ? 0 : (quant_min + quant_max + 1) / 2;
+    new_zero_point = at::full_like(new_scale, midpoint, new_scale.options().dtype(kLong));
+  } else {
+    new_scale = ((max_val_pos - min_val_neg) / static_cast<double>(quant_max - quant_min)).clamp_min_(eps);
+    new_zero_point = (quant_min - at::round(min_val_neg / new_scale))
+        .clamp_(quant_min, quant_max).to(kLong);
+  }
+  // per tensor scale and zero point are kept of shape [1], like in FakeQuantize
+  new_scale = new_scale.reshape(-1);
+  new_zero_point = new_zero_point.reshape(-1);
+  scale.resize_(new_scale.sizes()).copy_(new_scale);
+  zero_point.resize_(new_zero_point.sizes()).copy_(new_zero_point);
+}
+
+} // namespace
+
+/* Observes the 'inputs' tensor and fake-quantizes it with the updated
+quantization parameters, in place of a moving average min/max observer
+followed by FakeQuantize, saving a mask for the backward pass.
+
+Args:
+  self: Forward input tensor.
+  observer_on: whether to update the running range and the qparams.
+  fake_quant_on: whether to fake-quantize, or return a copy of the input.
+  running_min, running_max: the observed range, updated in place.
+  scale, zero_point: the quantization parameters, updated in place.
+  averaging_const: the weight of the new observation in the running range.
+  quant_min: minimum quantized value
+  quant_max: maximum quantized value
+  ch_axis: the channel axis, with per_row_fake_quant.
+  per_row_fake_quant: PerChannelAffine rather than PerTensorAffine.
+  symmetric_quant: symmetric rather than affine qparams.
+
+Returns:
+  Fake quantized tensor (float dtype).
+  Mask (bool dtype).
+*/
+std::tuple<Tensor, Tensor> _fused_moving_avg_obs_fq_helper(
+    const Tensor& self,
+    const Tensor& observer_on,
+    const Tensor& fake_quant_on,
+    Tensor& running_min,
+    Tensor& running_max,
+    Tensor& scale,
+    Tensor& zero_point,
+    double averaging_const,
+    int64_t quant_min,
+    int64_t quant_max,
+    int64_t ch_axis,
+    bool per_row_fake_quant,
+    bool symmetric_quant) {
+  TORCH_CHECK(self.scalar_type() == ScalarType::Float,
+              "fused_moving_avg_obs_fake_quant: expected a Float input, found ", self.scalar_type());
+  TORCH_CHECK(
+      quant_min <= quant_max,
+      "`quant_min` should be less than or \
+        equal to `quant_max`.");
+  if (per_row_fake_quant) {
+    ch_axis = maybe_wrap_dim(ch_axis, self.dim());
+  }
+
+  if (observer_on.item().toLong() != 0 && self.numel() > 0) {
+    const auto x = self.detach();
+    update_moving_average_min_max(x, running_min, running_max, averaging_const, ch_axis, per_row_fake_quant);
+    calculate_moving_average_qparams(
+        running_min, running_max, scale, zero_point, quant_min, quant_max, symmetric_quant);
+  }
+
+  if (fake_quant_on.item().toLong() == 0) {
+    return std::make_tuple(self.clone(), at::ones_like(self, at::kBool));
+  }
+  if (per_row_fake_quant) {
+    return at::fake_quantize_per_channel_affine_cachemask(
+        self, scale, zero_point, ch_axis, quant_min, quant_max);
+  }
+  return at::fake_quantize_per_tensor_affine_cachemask(
+      self, scale.item<float>(), zero_point.item<int64_t>(), quant_min, quant_max);
+}
+
+Tensor fused_moving_avg_obs_fake_quant(
+    const Tensor& self,
+    const Tensor& observer_on,
+    const Tensor& fake_quant_on,
+    Tensor& running_min,
+    Tensor& running_max,
+    Tensor& scale,
+    Tensor& zero_point,
+    double averaging_const,
+    int64_t quant_min,
+    int64_t quant_max,
+    int64_t ch_axis,
+    bool per_row_fake_quant,
+    bool symmetric_quant) {
+  return std::get<0>(at::_fused_moving_avg_obs_fq_helper(
+      self, observer_on, fake_quant_on, running_min, running_max, scale, zero_point,
+      averaging_const, quant_min, quant_max, ch_axis, per_row_fake_quant, symmetric_quant));
+}
+
+} // namespace native
+} // namespace at
@@ -5,6 +5,9 @@
 #include <ATen/Parallel.h>
 #include <ATen/NamedTensorUtils.h>
 #include <ATen/native/sparse/ParamUtils.h>
+#include <ATen/cpu/vec256/functional.h>
+#include <ATen/cpu/vec256/vec256.h>
+#include <algorithm>
 #include <map>
 
 namespace at {
@@ -88,7 +91,13 @@ std::vector<int64_t> get_offsets(const Tensor& indices, const IntArrayRef& sizes
   return offsets;
 }
 
-std::vector<std::vector<int64_t>> get_pools(const Tensor& indices, const IntArrayRef& sizes, const int64_t dim) {
+struct Pools {
+  // The values indices of pool p are members[offsets[p]:offsets[p + 1]]
+  Tensor members;
+  std::vector<int64_t> offsets;
+};
+
+Pools get_pools(const Tensor& indices, const IntArrayRef& sizes, const int64_t dim) {
   /*
     Return pools of indices that align with the given dimension.
 
@@ -98,7 +107,8 @@ std::vector<std::vector<int64_t>> get_pools(const Tensor& indices, const IntArra
       `dim`     - given dimension
 
     Returns:
-      `pools`   - a ragged array of indices
+      `pools`   - the indices of all pools, grouped by pool, and the
+                  offsets of the pools in them
 
     A pool is defined as a list of indices (of sparse tensor values)
     that participate in the same softmax computation:
@@ -107,36 +117,28 @@ std::vector<std::vector<int64_t>> get_pools(const Tensor& indices, const IntArra
     - union of all pools is set(range(nnz))
     - X.values[k], k in pools[i], does not affect the result of softmax(X)[n], n in pools[j], iff i != j
 
+    The entries are keyed by their indices in all dimensions but `dim`,
+    and sorted by key, so that every pool is a run of equal keys. Only
+    the non-empty pools are returned.
   */
-  std::vector<std::vector<int64_t>> pools;
-
-  auto ndim = indices.size(0);
-  auto nnz = indices.size(1);
-  std::vector<int64_t> strides(ndim, 1);
-  auto indices_accessor = indices.accessor<int64_t, 2>();
-
-  if (ndim > 1) {
-    for (int64_t i=ndim - 2; i >= 0; i--) {
-      strides[i] = strides[i + 1] * (i + 1 == dim? 1 : sizes[i + 1]);
+  std::vector<int64_t> pool_dims;
+  for (int64_t d = 0; d < indices.size(0); d++) {
+    if (d != dim) {
+      pool_dims.push_back(d);
     }
   }
+  auto pool_keys = at::sparse::flatten_indices_by_dims(indices, sizes, pool_dims);
 
-  for (int64_t i=0; i < nnz; i++) {
-    int64_t pool_index = 0;
-    for (int64_t j=0; j < ndim; j++) {
-      if (j != dim) {
-        auto indices_row = indices_accessor[j];
-        auto stride = strides[j];
-        pool_index += stride * indices_row[i];
-      }
-    }
-    while (pool_index >= pools.size()) {
-      pools.emplace_back();  // create empty pool
-    }
-    pools[pool_index].push_back(i);
-  }
+  Tensor sorted_keys, members;
+  std::tie(sorted_keys, members) = at::sparse::sort_flattened_indices(pool_keys);
+  return {members.contiguous(), at::sparse::find_run_starts(sorted_keys.contiguous())};
+}
 
-  return pools;
+int64_t get_pools_grain_size(int64_t nnz, int64_t nvalues, int64_t npools) {
+  // About GRAIN_SIZE computations per task, counting an exp as 16 like the
+  // dense softmax kernels do
+  const int64_t pool_work = 16 * std::max<int64_t>(1, nnz * nvalues / std::max<int64_t>(1, npools));
+  return std::max<int64_t>(1, internal::GRAIN_SIZE / pool_work);
 }
 
 template <typename scalar_t, bool LogSoftMax>
@@ -304,48 +306,94 @@ void cpu_sparse_coo_softmax(Tensor output, const Tensor& input, const int64_t di
   auto sizes = input.sizes();
   auto nvalues = get_nvalues(sizes, sparse_dim);
 
-  /* Prepare accessors */
-  auto values_2 = values.view({nnz, nvalues});
-  auto values_accessor = values_2.accessor<scalar_t, 2>();
-
-  auto out_values_2 = out_values.view({nnz, nvalues});
-  auto out_values_accessor = out_values_2.accessor<scalar_t, 2>();
+  const scalar_t* values_data = values.data_ptr<scalar_t>();
+  scalar_t* out_values_data = out_values.data_ptr<scalar_t>();
 
   /* Compute independent pools of indices */
   auto pools = get_pools(indices, sizes, dim);
+  const int64_t* pool_members = pools.members.data_ptr<int64_t>();
+  const int64_t npools = pools.offsets.size() - 1;
 
-  int64_t grain_size = 1;
-  parallel_for(0, pools.size(), grain_size, [&](int64_t begin, int64_t end) {
-      for (auto p = begin; p < end; p++) {
-        auto pool_indices = pools[p];
+  using Vec = vec256::Vec256<scalar_t>;
+  int64_t grain_size = get_pools_grain_size(nnz, nvalues, npools);
+  parallel_for(0, npools, grain_size, [&](int64_t begin, int64_t end) {
+      /* Prepare scratch space, shared by the pools of the task */
+      std::vector<scalar_t> mx_row(nvalues);
+      std::vector<scalar_t> exp_sums_row(nvalues);
+      std::vector<scalar_t> pool_values;
 
-        // Skip empty pools
-        if (pool_indices.size() == 0)
+      for (auto p = begin; p < end; p++) {
+        const int64_t* pool_indices = pool_members + pools.offsets[p];
+        const int64_t pool_size = pools.offsets[p + 1] - pools.offsets[p];
+
+        if (nvalues == 1) {
+          /* Gather the values of the pool, so that max, exp and sum are vectorized */
+          pool_values.resize(pool_size);
+          for (int64_t k=0; k < pool_size; k++) {
+            pool_values[k] = values_data[pool_indices[k]];
+          }
+          scalar_t mx = vec256::reduce_all<scalar_t>(
+              [](Vec& x, Vec& y) { return vec256::maximum(x, y); },
+              pool_values.data(),
+              pool_size);
+          if (LogSoftMax) {
+            scalar_t exp_sum = vec256::map_reduce_all<scalar_t>(
+                [mx](Vec x) { return (x - Vec(mx)).exp(); },
+                [](Vec x, Vec y) { return x + y; },
+                pool_values.data(),
+                pool_size);
+            mx += std::log(exp_sum);
+            for (int64_t k=0; k < pool_size; k++) {
+              out_values_data[pool_indices[k]] = pool_values[k] - mx;
+            }
+          } else {
+            vec256::map(
+                [mx](Vec x) { return (x - Vec(mx)).exp(); },
+                pool_values.data(),
+                pool_values.data(),
+                pool_size);
+            scalar_t exp_sum = vec256::reduce_all<scalar_t>(
+                [](Vec& x, Vec& y) { return x + y; },
+                pool_values.data(),
+                pool_size);
+            scalar_t inv_exp_sum = 1.0 / exp_sum;
+            for (int64_t k=0; k < pool_size; k++) {
+              out_values_data[pool_indices[k]] = pool_values[k] * inv_exp_sum;
+            }
+          }
           continue;
+        }
 
-        /* Prepare scratch space */
-        std::vector<scalar_t> mx_row(nvalues, -std::numeric_limits<scalar_t>::infinity());
-        std::vector<scalar_t> exp_sums_row(nvalues, 0);
+        std::fill(mx_row.begin(), mx_row.end(), -std::numeric_limits<scalar_t>::infinity());
+        std::fill(exp_sums_row.begin(), exp_sums_row.end(), 0);
 
         /* Compute mx */
-        for (int64_t i : pool_indices) {
-          auto values_row = values_accessor[i];
-          for (int64_t j=0; j < nvalues; j++) {
-            mx_row[j] = std::max(mx_row[j], values_row[j]);
-          }
+        for (int64_t k=0; k < pool_size; k++) {
+          const scalar_t* values_row = values_data + pool_indices[k] * nvalues;
+          vec256::map2(
+              [](Vec x, Vec y) { return vec256::maximum(x, y); },
+              mx_row.data(),
+              mx_row.data(),
+              values_row,
+              nvalues);
         }
 
         /* Apply exp to (v - mx) and sum the results */
-        for (int64_t i : pool_indices) {
-          auto values_row = values_accessor[i];
-          auto out_values_row = out_values_accessor[i];
-          for (int64_t j=0; j < nvalues; j++) {
-            auto v = std::exp(values_row[j] - mx_row[j]);
-            if (!LogSoftMax) {
-              out_values_row[j] = v;
-            }
-            exp_sums_row[j] += v;
-          }
+        for (int64_t k=0; k < pool_size; k++) {
+          const scalar_t* values_row = values_data + pool_indices[k] * nvalues;
+          scalar_t* out_values_row = out_values_data + pool_indices[k] * nvalues;
+          vec256::map2(
+              [](Vec x, Vec y) { return (x - y).exp(); },
+              out_values_row,
+              values_row,
+              mx_row.data(),
+              nvalues);
+          vec256::map2(
+              [](Vec x, Vec y) { return x + y; },
+              exp_sums_row.data(),
+              exp_sums_row.data(),
+              out_values_row,
+              nvalues);
         }
 
         for (int64_t j=0; j < nvalues; j++) {
@@ -357,15 +405,23 @@ void cpu_sparse_coo_softmax(Tensor output, const Tensor& input, const int64_t di
         }
 
         /* Normalize with the sum of exponents */
-        for (int64_t i : pool_indices) {
-          auto values_row = values_accessor[i];
-          auto out_values_row = out_values_accessor[i];
-          for (int64_t j=0; j < nvalues; j++) {
-            if (LogSoftMax) {
-              out_values_row[j] = values_row[j] - mx_row[j];
-            } else {
-              out_values_row[j] *= exp_sums_row[j];
-            }
+        for (int64_t k=0; k < pool_size; k++) {
+          const scalar_t* values_row = values_data + pool_indices[k] * nvalues;
+          scalar_t* out_values_row = out_values_data + pool_indices[k] * nvalues;
+          if (LogSoftMax) {
+            vec256::map2(
+                [](Vec x, Vec y) { return x - y; },
+                out_values_row,
+                values_row,
+                mx_row.data(),
+                nvalues);
+          } else {
+            vec256::map2(
+                [](Vec x, Vec y) { return x * y; },
+                out_values_row,
+                out_values_row,
+                exp_sums_row.data(),
+                nvalues);
           }
         }
       }
@@ -442,38 +498,47 @@ void cpu_sparse_coo_softmax_backward(Tensor& grad_input, const Tensor& grad, con
   auto nnz = values.size(0);
   auto nvalues = get_nvalues(sizes, sparse_dim);
 
-  auto values_2 = values.view({nnz, nvalues});
-  auto values_accessor = values_2.accessor<scalar_t, 2>();
-
-  auto out_values_2 = out_values.view({out_nnz, nvalues});
-  auto out_values_accessor = out_values_2.accessor<scalar_t, 2>();
-
-  auto grad_values_2 = grad_values.view({grad_nnz, nvalues});
-  auto grad_values_accessor = grad_values_2.accessor<scalar_t, 2>();
+  scalar_t* values_data = values.data_ptr<scalar_t>();
+  const scalar_t* out_values_data = out_values.data_ptr<scalar_t>();
+  const scalar_t* grad_values_data = grad_values.data_ptr<scalar_t>();
+
+  /* Find the grad entry of every output entry, or -1 if it has none */
+  std::vector<int64_t> grad_positions(out_nnz);
+  const bool same_indices = out_offsets == grad_offsets;
+  parallel_for(0, out_nnz, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+      for (auto i = begin; i < end; i++) {
+        if (same_indices) {
+          grad_positions[i] = i;
+          continue;
+        }
+        auto low = std::lower_bound(grad_offsets.begin(), grad_offsets.end(), out_offsets[i]);
+        auto j = low - grad_offsets.begin();
+        grad_positions[i] = (j < grad_nnz && out_offsets[i] == grad_offsets[j]) ? j : -1;
+      }
+    });
 
   /* Compute independent pools of indices */
   auto pools = get_pools(out_indices, sizes, dim);
+  const int64_t* pool_members = pools.members.data_ptr<int64_t>();
+  const int64_t npools = pools.offsets.size() - 1;
 
-  int64_t grain_size = 1;
-  parallel_for(0, pools.size(), grain_size, [&](int64_t begin, int64_t end) {
-      for (auto p = begin; p < end; p++) {
-        auto pool_indices = pools[p];
+  int64_t grain_size = get_pools_grain_size(nnz, nvalues, npools);
+  parallel_for(0, npools, grain_size, [&](int64_t begin, int64_t end) {
+      std::vector<scalar_t> tmp_row(nvalues);
 
-        // Skip empty pools
-        if (pool_indices.size() == 0)
-          continue;
+      for (auto p = begin; p < end; p++) {
+        const int64_t* pool_indices = pool_members + pools.offsets[p];
+        const int64_t pool_size = pools.offsets[p + 1] - pools.offsets[p];
 
-        std::vector<scalar_t> tmp_row(nvalues, 0);
+        std::fill(tmp_row.begin(), tmp_row.end(), 0);
 
         /* Compute tmp = - sum_j output_j * grad_j */
-        for (int64_t i : pool_indices) {
-          auto out_values_row = out_values_accessor[i];
-          auto values_row = values_accessor[i];
-          auto low = std::lower_bound(grad_offsets.begin(), grad_offsets.end(), out_offsets[i]);
-          auto j = low - grad_offsets.begin();
-
-          if (j < grad_nnz && (out_offsets[i] == grad_offsets[j])) {
-            auto grad_values_row = grad_values_accessor[j];
+        for (int64_t n=0; n < pool_size; n++) {
+          auto i = pool_indices[n];
+          auto j = grad_positions[i];
+          if (j >= 0) {
+            const scalar_t* out_values_row = out_values_data + i * nvalues;
+            const scalar_t* grad_values_row = grad_values_data + j * nvalues;
             for (int64_t k=0; k<nvalues; k++) {
               if (LogSoftMax) {
                 tmp_row[k] -= grad_values_row[k];
@@ -485,14 +550,13 @@ void cpu_sparse_coo_softmax_backward(Tensor& grad_input, const Tensor& grad, con
         }
 
         /* Compute grad_input = output * (grad + tmp)*/
-        for (int64_t i : pool_indices) {
-          auto out_values_row = out_values_accessor[i];
-          auto values_row = values_accessor[i];
-          auto low = std::lower_bound(grad_offsets.begin(), grad_offsets.end(), out_offsets[i]);
-          auto j = low - grad_offsets.begin();
-
-          if (j < grad_nnz && (out_offsets[i] == grad_offsets[j])) {
-            auto grad_values_row = grad_values_accessor[j];
+        for (int64_t n=0; n < pool_size; n++) {
+          auto i = pool_indices[n];
+          auto j = grad_positions[i];
+          const scalar_t* out_values_row = out_values_data + i * nvalues;
+          scalar_t* values_row = values_data + i * nvalues;
+          if (j >= 0) {
+            const scalar_t* grad_values_row = grad_values_data + j * nvalues;
             for (int64_t k=0; k<nvalues; k++) {
               if (LogSoftMax) {
                 values_row[k] = grad_values_row[k] + std::exp(out_values_row[k]) * tmp_row[k];
@@ -11,6 +11,10 @@
 
 #include <ATen/native/CPUBlas.h>
 
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
 namespace at { namespace native {
 
 using namespace at::sparse;
@@ -394,42 +398,43 @@ SparseTensor coalesce_sparse_cpu(const SparseTensor& self) {
 
   Tensor indicesBuffer;
   Tensor indicesPermutation;
-  std::tie(indicesBuffer, indicesPermutation) = indices_scalar.sort(0);
+  std::tie(indicesBuffer, indicesPermutation) = sort_flattened_indices(indices_scalar);
   // NB: The accessor accesses here rely on self._nnz() > 0 (tested earlier in this function)
   auto newIndicesAccessor = newIndices.accessor<int64_t, 2>();
   auto indicesAccessor = indices.accessor<int64_t, 2>();
   auto indicesPermutationAccessor = indicesPermutation.accessor<int64_t, 1>();
-  auto indicesBufferAccessor = indicesBuffer.accessor<int64_t, 1>();
 
-  int64_t i = -1;
+  // Each run of equal indices becomes one element of the result, so the runs
+  // are found first and then merged in parallel.
+  const std::vector<int64_t> segmentStarts = find_run_starts(indicesBuffer.contiguous());
+  const int64_t numSegments = segmentStarts.size() - 1;
+
   AT_DISPATCH_ALL_TYPES(
       values.scalar_type(), "coalesce", [&] {
-        int64_t prev = -1;
         int64_t blockSize = values.stride(0);
         scalar_t* values_ptr = values.data_ptr<scalar_t>();
         scalar_t* newValues_ptr = newValues.data_ptr<scalar_t>();
-        for (int64_t j = 0; j < nnz; j++) {
-          int64_t pos = indicesPermutationAccessor[j];
-          int64_t curr = indicesBufferAccessor[j];
-          if (curr == prev) {
-            if (values.numel() > 0) {  // if values is an empty tensor, there are no elements to copy
-              at::native::cpublas::axpy<scalar_t>(blockSize, 1, values_ptr + pos * blockSize, 1, newValues_ptr + i * blockSize, 1);
-            }
-          } else {
-            ++i;
+        const int64_t grainSize = std::max<int64_t>(1, at::internal::GRAIN_SIZE / std::max<int64_t>(1, blockSize));
+        at::parallel_for(0, numSegments, grainSize, [&](int64_t start, int64_t end) {
+          for (int64_t i = start; i < end; i++) {
+            int64_t first = indicesPermutationAccessor[segmentStarts[i]];
             for (int64_t d = 0; d < sparse_dim; d++) {
-              newIndicesAccessor[d][i] = indicesAccessor[d][pos];
+              newIndicesAccessor[d][i] = indicesAccessor[d][first];
+            }
+            if (values.numel() == 0) {  // if values is an empty tensor, there are no elements to copy
+              continue;
             }
-            if (values.numel() > 0) {  // if values is an empty tensor, there are no elements to copy
-              at::native::cpublas::copy<scalar_t>(blockSize, values_ptr + pos * blockSize, 1, newValues_ptr + i * blockSize, 1);
+            at::native::cpublas::copy<scalar_t>(blockSize, values_ptr + first * blockSize, 1, newValues_ptr + i * blockSize, 1);
+            for (int64_t j = segmentStarts[i] + 1; j < segmentStarts[i + 1]; j++) {
+              int64_t pos = indicesPermutationAccessor[j];
+              at::native::cpublas::axpy<scalar_t>(blockSize, 1, values_ptr + pos * blockSize, 1, newValues_ptr + i * blockSize, 1);
             }
           }
-          prev = curr;
-        }
+        });
     });
 
   dst._coalesced_(true);
-  get_sparse_impl(dst)->set_nnz_and_narrow(i + 1);
+  get_sparse_impl(dst)->set_nnz_and_narrow(numSegments);
 
   return dst;
 }
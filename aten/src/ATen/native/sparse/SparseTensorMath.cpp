@@ -813,7 +813,7 @@ SparseTensor& mul_out_sparse_cpu(SparseTensor& r, const Tensor& t_, const Tensor
 // --------------------------------------------------------------------
 
 template <typename scalar_t>
-void s_addmm_out_sparse_dense_worker(int64_t nnz, int64_t dim_i, int64_t dim_j, int64_t dim_k, Tensor& r, Scalar beta, const Tensor& t, Scalar alpha, const Tensor& indices, const Tensor& values, const Tensor& dense) {
+void s_addmm_out_sparse_dense_worker(int64_t nnz, int64_t dim_i, int64_t dim_j, int64_t dim_k, Tensor& r, Scalar beta, const Tensor& t, Scalar alpha, const Tensor& indices, const Tensor& values, const Tensor& dense, const Tensor& row_pointers) {
   int64_t i;
 
   // r_ = alpha * sparse * dense
@@ -839,6 +839,29 @@ void s_addmm_out_sparse_dense_worker(int64_t nnz, int64_t dim_i, int64_t dim_j,
   int64_t dense_stride1 = dense.stride(1);
   int64_t r_stride0 = r.stride(0);
   int64_t r_stride1 = r.stride(1);
+
+  if (row_pointers.defined()) {
+    // Coalesced input: every row of r is only written by the nonzeros of the
+    // same row of sparse, so the rows are computed in parallel.
+    const int64_t* row_pointers_ptr = row_pointers.data_ptr<int64_t>();
+    const int64_t grain_size = std::max<int64_t>(1, at::internal::GRAIN_SIZE / std::max<int64_t>(1, nnz / dim_i * dim_k));
+    at::parallel_for(0, dim_i, grain_size, [&](int64_t start, int64_t end) {
+      for (int64_t row = start; row < end; row++) {
+        for (int64_t k = row_pointers_ptr[row]; k < row_pointers_ptr[row + 1]; k++) {
+          int64_t col = indices_accessor[1][k];
+          if (col < 0 || col >= dim_j) {
+            AT_ERROR("addmm: index out of column bound: ", col, " not between 1 and ", dim_j);
+          }
+          at::native::cpublas::axpy<scalar_t>(dim_k,
+                cast_alpha * values_accessor[k],
+                dense_ptr + col * dense_stride0, dense_stride1,
+                r_ptr + row * r_stride0, r_stride1);
+        }
+      }
+    });
+    return;
+  }
+
   for (i = 0; i < nnz; i++) {
     scalar_t val = values_accessor[i];
     int64_t row = indices_accessor[0][i];
@@ -900,9 +923,20 @@ Tensor& s_addmm_out_sparse_dense_cpu(
   Tensor indices = sparse_._indices();
   Tensor values      = sparse_._values();
 
+  // The rows of a coalesced matrix are sorted, so checking the first and the
+  // last one bounds all of them.
+  Tensor row_pointers;
+  if (sparse_.is_coalesced()) {
+    int64_t first_row = indices[0][0].item<int64_t>();
+    int64_t last_row = indices[0][nnz - 1].item<int64_t>();
+    TORCH_CHECK(first_row >= 0, "addmm: index out of row bound: ", first_row, " not between 1 and ", dim_i);
+    TORCH_CHECK(last_row < dim_i, "addmm: index out of row bound: ", last_row, " not between 1 and ", dim_i);
+    row_pointers = get_sparse_impl(sparse_)->csr_row_pointers();
+  }
+
   AT_DISPATCH_ALL_TYPES(
       values.scalar_type(), "addmm_sparse_dense", [&] {
-        s_addmm_out_sparse_dense_worker<scalar_t>(nnz, dim_i, dim_j, dim_k, r, beta, t, alpha, indices, values, dense);
+        s_addmm_out_sparse_dense_worker<scalar_t>(nnz, dim_i, dim_j, dim_k, r, beta, t, alpha, indices, values, dense, row_pointers);
       }
   );
 
@@ -1216,14 +1250,25 @@ Tensor sspaddmm(const Tensor& self, const Tensor& mat1, const Tensor& mat2,
 // sparse dims. Ideally in the future there should be unified reduction function
 // for ops like sum, max, and min.
 // --------------------------------------------------------------------
+
+// The values to sum all entries of the input. Duplicate indices don't change
+// the total, so they are summed as they are unless the gradient is needed,
+// which only values() of a coalesced tensor has.
+static Tensor values_to_sum(const SparseTensor& input) {
+  if (GradMode::is_enabled() && input.requires_grad()) {
+    return input.coalesce().values();
+  }
+  return input._values();
+}
+
 Tensor _sparse_sum(const SparseTensor& input) {
-  return input.coalesce().values().sum();
+  return values_to_sum(input).sum();
 }
 
 Tensor _sparse_sum(const SparseTensor& input, ScalarType dtype) {
   // don't have to do a conversion to the correct dtype first
   // just need to setup the accumulator correctly
-  return input.coalesce().values().sum(dtype);
+  return values_to_sum(input).sum(dtype);
 }
 
 Tensor _sparse_sum(const SparseTensor& input, IntArrayRef dims_to_sum, ScalarType dtype) {
@@ -1606,7 +1651,8 @@ Tensor& bmm_out_sparse_cpu(Tensor& result, const SparseTensor& self, const Tenso
             result_matrix,
             beta, t_dummy, alpha,
             sparse_indices, sparse_values,
-            dense_matrix
+            dense_matrix,
+            /*row_pointers=*/Tensor()
           );
           mat_el_begin_idx = mat_el_end_idx;
 
@@ -397,8 +397,12 @@ void Descriptor::Pool::purge() {
       "This descriptor pool is in an invalid state! "
       "Potential reason: This descriptor pool is moved from.");
 
-  VK_CHECK(vkResetDescriptorPool(device_, descriptor_pool_.get(), 0u));
-  set_.layouts.clear();
+  // The GPU is done with all descriptor sets by now.  Rather than returning
+  // them to the descriptor pool only to allocate them again on the next run,
+  // rewind and rewrite them as they are handed back out.
+  for (auto& layout : set_.layouts) {
+    layout.second.in_use = 0u;
+  }
 }
 
 void Descriptor::Pool::invalidate() {
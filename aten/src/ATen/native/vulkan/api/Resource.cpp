@@ -61,6 +61,16 @@ VmaAllocationCreateInfo create_allocation_create_info(
   };
 }
 
+bool is_compatible(
+    const Resource::Buffer::Descriptor& lhs,
+    const Resource::Buffer::Descriptor& rhs) {
+  return (lhs.size == rhs.size) &&
+         (lhs.usage.buffer == rhs.usage.buffer) &&
+         (lhs.usage.memory.usage == rhs.usage.memory.usage) &&
+         (lhs.usage.memory.required == rhs.usage.memory.required) &&
+         (lhs.usage.memory.preferred == rhs.usage.memory.preferred);
+}
+
 void release_buffer(const Resource::Buffer& buffer) {
   // Safe to pass null as buffer or allocation.
   vmaDestroyBuffer(
@@ -432,6 +442,16 @@ Resource::Buffer Resource::Pool::buffer(
       "This resource pool is in an invalid state! ",
       "Potential reason: This resource pool is moved from.");
 
+  for (auto iterator = buffer_.free.begin();
+       iterator != buffer_.free.end();
+       ++iterator) {
+    if (is_compatible(iterator->descriptor, descriptor)) {
+      buffer_.pool.push_back(std::move(*iterator));
+      buffer_.free.erase(iterator);
+      return buffer_.pool.back().handle.get();
+    }
+  }
+
   const VkBufferCreateInfo buffer_create_info{
     VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
     nullptr,
@@ -487,21 +507,25 @@ Resource::Buffer Resource::Pool::buffer(
       allocation,
       buffer));
 
-  buffer_.pool.emplace_back(
-      Buffer{
-        Buffer::Object{
-          buffer,
-          0u,
-          descriptor.size,
-        },
-        Memory{
-          allocator_.get(),
-          allocation,
+  buffer_.pool.push_back({
+      descriptor,
+      {
+        Buffer{
+          Buffer::Object{
+            buffer,
+            0u,
+            descriptor.size,
+          },
+          Memory{
+            allocator_.get(),
+            allocation,
+          },
         },
+        &release_buffer,
       },
-      &release_buffer);
+  });
 
-  return buffer_.pool.back().get();
+  return buffer_.pool.back().handle.get();
 }
 
 Resource::Image Resource::Pool::image(
@@ -681,7 +705,12 @@ void Resource::Pool::purge() {
 
   fence_.in_use = 0u;
   image_.pool.clear();
+
+  // Everything is idle at this point.  Keep this run's buffers around for the
+  // next one, and release those the previous run left unclaimed.
+  buffer_.free = std::move(buffer_.pool);
   buffer_.pool.clear();
+  buffer_.pool.reserve(Configuration::kReserve);
 }
 
 void Resource::Pool::invalidate() {
@@ -318,7 +318,18 @@ struct Resource final {
     } memory_;
 
     struct {
-      std::vector<Handle<Buffer, void(*)(const Buffer&)>> pool;
+      struct Entry final {
+        Buffer::Descriptor descriptor;
+        Handle<Buffer, void(*)(const Buffer&)> handle;
+      };
+
+      std::vector<Entry> pool;
+
+      // Buffers released by the last purge.  Inference runs tend to request
+      // the same buffers in the same order every time, so we hand these back
+      // out instead of going through the allocator again.  Whatever is not
+      // claimed by the next purge is released for good.
+      std::vector<Entry> free;
     } buffer_;
 
     struct {
@@ -12,28 +12,37 @@ XNNPackLinearOpContext::create_context(
     at::Tensor&& weight,
     c10::optional<at::Tensor>&& bias,
     const c10::optional<Scalar> output_min,
-    const c10::optional<Scalar> output_max) {
+    const c10::optional<Scalar> output_max,
+    const bool prepack) {
   auto linear_op_context =
       c10::make_intrusive<XNNPackLinearOpContext>(
           std::move(weight),
           std::move(bias),
           output_min,
           output_max,
-          xnnpack::internal::linear::create(
-              weight,
-              bias,
-              output_min ? output_min->to<float>()
-                         : xnnpack::ContextLinear::kMin,
-              output_max ? output_max->to<float>()
-                         : xnnpack::ContextLinear::kMax)
-          );
-  if (at::globalContext().releaseWeightsWhenPrepacking()) {
-    linear_op_context->free_orig_weight_and_bias();
+          c10::nullopt);
+
+  if (prepack) {
+    linear_op_context->pack();
   }
 
   return linear_op_context;
 }
 
+void XNNPackLinearOpContext::pack() {
+  op_context_ = xnnpack::internal::linear::create(
+      orig_weight_,
+      orig_bias_,
+      output_min_ ? output_min_->to<float>()
+                  : xnnpack::ContextLinear::kMin,
+      output_max_ ? output_max_->to<float>()
+                  : xnnpack::ContextLinear::kMax);
+
+  if (at::globalContext().releaseWeightsWhenPrepacking()) {
+    free_orig_weight_and_bias();
+  }
+}
+
 void XNNPackLinearOpContext::free_orig_weight_and_bias() {
   orig_weight_and_bias_freed_ = true;
   orig_weight_.reset();
@@ -41,7 +50,11 @@ void XNNPackLinearOpContext::free_orig_weight_and_bias() {
 }
 
 Tensor XNNPackLinearOpContext::run(const Tensor& input) {
-  return xnnpack::internal::linear::run(op_context_, input);
+  if (!op_context_) {
+    pack();
+  }
+
+  return xnnpack::internal::linear::run(*op_context_, input);
 }
 
 c10::intrusive_ptr<Conv2dOpContext>
@@ -52,22 +65,8 @@ XNNPackConv2dOpContext::create_context(at::Tensor&& weight,
     std::vector<int64_t>&& dilation,
     int64_t groups,
     const c10::optional<Scalar> output_min,
-    const c10::optional<Scalar> output_max) {
-  auto op_context =
-      xnnpack::internal::convolution2d::create(
-          weight,
-          bias,
-          padding,
-          {0, 0}, // output_padding
-          stride,
-          dilation,
-          groups,
-          false,  // transposed
-          output_min ? output_min->to<float>()
-                     : xnnpack::ContextConv2D::kMin,
-          output_max ? output_max->to<float>()
-                     : xnnpack::ContextConv2D::kMax);
-
+    const c10::optional<Scalar> output_max,
+    const bool prepack) {
   auto conv2d_op_context =
       c10::make_intrusive<XNNPackConv2dOpContext>(
           std::move(weight),
@@ -78,15 +77,36 @@ XNNPackConv2dOpContext::create_context(at::Tensor&& weight,
           groups,
           output_min,
           output_max,
-          std::move(op_context));
+          c10::nullopt);
 
-  if (at::globalContext().releaseWeightsWhenPrepacking()) {
-    conv2d_op_context->free_orig_weight_and_bias();
+  if (prepack) {
+    conv2d_op_context->pack();
   }
 
   return conv2d_op_context;
 }
 
+void XNNPackConv2dOpContext::pack() {
+  op_context_ =
+      xnnpack::internal::convolution2d::create(
+          orig_weight_,
+          orig_bias_,
+          padding_,
+          {0, 0}, // output_padding
+          stride_,
+          dilation_,
+          groups_,
+          false,  // transposed
+          output_min_ ? output_min_->to<float>()
+                      : xnnpack::ContextConv2D::kMin,
+          output_max_ ? output_max_->to<float>()
+                      : xnnpack::ContextConv2D::kMax);
+
+  if (at::globalContext().releaseWeightsWhenPrepacking()) {
+    free_orig_weight_and_bias();
+  }
+}
+
 c10::intrusive_ptr<TransposeConv2dOpContext>
 XNNPackTransposeConv2dOpContext::create_context(at::Tensor&& weight,
     c10::optional<at::Tensor>&& bias,
@@ -96,22 +116,8 @@ XNNPackTransposeConv2dOpContext::create_context(at::Tensor&& weight,
     std::vector<int64_t>&& dilation,
     int64_t groups,
     const c10::optional<Scalar> output_min,
-    const c10::optional<Scalar> output_max) {
-  auto op_context =
-      xnnpack::internal::convolution2d::create(
-          weight,
-          bias,
-          padding,
-          output_padding,
-          stride,
-          dilation,
-          groups,
-          true, // transposed
-          output_min ? output_min->to<float>()
-                     : xnnpack::ContextConv2D::kMin,
-          output_max ? output_max->to<float>()
-                     : xnnpack::ContextConv2D::kMax);
-
+    const c10::optional<Scalar> output_max,
+    const bool prepack) {
   auto conv2d_op_context =
       c10::make_intrusive<XNNPackTransposeConv2dOpContext>(
           std::move(weight),
@@ -123,21 +129,50 @@ XNNPackTransposeConv2dOpContext::create_context(at::Tensor&& weight,
           groups,
           output_min,
           output_max,
-          std::move(op_context));
+          c10::nullopt);
 
-  if (at::globalContext().releaseWeightsWhenPrepacking()) {
-    conv2d_op_context->free_orig_weight_and_bias();
+  if (prepack) {
+    conv2d_op_context->pack();
   }
 
   return conv2d_op_context;
 }
 
+void XNNPackTransposeConv2dOpContext::pack() {
+  op_context_ =
+      xnnpack::internal::convolution2d::create(
+          orig_weight_,
+          orig_bias_,
+          padding_,
+          output_padding_,
+          stride_,
+          dilation_,
+          groups_,
+          true, // transposed
+          output_min_ ? output_min_->to<float>()
+                      : xnnpack::ContextConv2D::kMin,
+          output_max_ ? output_max_->to<float>()
+                      : xnnpack::ContextConv2D::kMax);
+
+  if (at::globalContext().releaseWeightsWhenPrepacking()) {
+    free_orig_weight_and_bias();
+  }
+}
+
 Tensor XNNPackConv2dOpContext::run(const Tensor& input) {
-  return xnnpack::internal::convolution2d::run(op_context_, input);
+  if (!op_context_) {
+    pack();
+  }
+
+  return xnnpack::internal::convolution2d::run(*op_context_, input);
 }
 
 Tensor XNNPackTransposeConv2dOpContext::run(const Tensor& input) {
-  return xnnpack::internal::convolution2d::run(op_context_, input);
+  if (!op_context_) {
+    pack();
+  }
+
+  return xnnpack::internal::convolution2d::run(*op_context_, input);
 }
 
 void XNNPackConv2dOpContext::free_orig_weight_and_bias() {
@@ -57,7 +57,8 @@ class LinearOpContext : public torch::jit::CustomClassHolder {
 
 class XNNPackLinearOpContext final : public LinearOpContext {
  private:
-  ContextLinear op_context_;
+  // Empty until the weights are packed.  See create_context().
+  c10::optional<ContextLinear> op_context_;
 
  public:
   XNNPackLinearOpContext(
@@ -65,7 +66,7 @@ class XNNPackLinearOpContext final : public LinearOpContext {
       c10::optional<Tensor>&& bias,
       c10::optional<Scalar> min,
       c10::optional<Scalar> max,
-      ContextLinear&& op_context)
+      c10::optional<ContextLinear>&& op_context)
       : op_context_(std::move(op_context)) {
     orig_weight_ = std::move(weight);
     orig_bias_ = std::move(bias);
@@ -77,11 +78,18 @@ class XNNPackLinearOpContext final : public LinearOpContext {
   Tensor run(const Tensor& input) override;
   void free_orig_weight_and_bias() override;
 
+  // With prepack set to false, packing is deferred to the first run().
+  // Deserialization uses this so that loading a model does not pay for
+  // packing the weights of every layer upfront.
   static c10::intrusive_ptr<LinearOpContext> create_context(
       Tensor&& weight,
       c10::optional<Tensor>&& bias,
       const c10::optional<Scalar> output_min,
-      const c10::optional<Scalar> output_max);
+      const c10::optional<Scalar> output_max,
+      bool prepack = true);
+
+ private:
+  void pack();
 };
 
 class Conv2dOpContext : public torch::jit::CustomClassHolder {
@@ -148,7 +156,8 @@ class TransposeConv2dOpContext : public torch::jit::CustomClassHolder {
 
 class XNNPackConv2dOpContext final : public Conv2dOpContext {
  private:
-  ContextConv2D op_context_;
+  // Empty until the weights are packed.  See create_context().
+  c10::optional<ContextConv2D> op_context_;
 
  public:
   XNNPackConv2dOpContext(
@@ -160,7 +169,7 @@ class XNNPackConv2dOpContext final : public Conv2dOpContext {
       uint64_t groups,
       c10::optional<Scalar> min,
       c10::optional<Scalar> max,
-      ContextConv2D&& op_context)
+      c10::optional<ContextConv2D>&& op_context)
       : op_context_(std::move(op_context)) {
     orig_weight_ = std::move(weight);
     orig_bias_ = std::move(bias);
@@ -176,6 +185,7 @@ class XNNPackConv2dOpContext final : public Conv2dOpContext {
   Tensor run(const Tensor& input) override;
   void free_orig_weight_and_bias() override;
 
+  // See XNNPackLinearOpContext::create_context().
   static c10::intrusive_ptr<Conv2dOpContext> create_context(
       Tensor&& weight,
       c10::optional<Tensor>&& bias,
@@ -184,12 +194,17 @@ class XNNPackConv2dOpContext final : public Conv2dOpContext {
       std::vector<int64_t>&& dilation,
       int64_t groups,
       const c10::optional<Scalar> output_min,
-      const c10::optional<Scalar> output_max);
+      const c10::optional<Scalar> output_max,
+      bool prepack = true);
+
+ private:
+  void pack();
 };
 
 class XNNPackTransposeConv2dOpContext final : public TransposeConv2dOpContext {
  private:
-  ContextConv2D op_context_;
+  // Empty until the weights are packed.  See create_context().
+  c10::optional<ContextConv2D> op_context_;
 
  public:
   XNNPackTransposeConv2dOpContext(
@@ -202,7 +217,7 @@ class XNNPackTransposeConv2dOpContext final : public TransposeConv2dOpContext {
       uint64_t groups,
       c10::optional<Scalar> min,
       c10::optional<Scalar> max,
-      ContextConv2D&& op_context)
+      c10::optional<ContextConv2D>&& op_context)
       : op_context_(std::move(op_context)) {
     orig_weight_ = std::move(weight);
     orig_bias_ = std::move(bias);
@@ -219,6 +234,7 @@ class XNNPackTransposeConv2dOpContext final : public TransposeConv2dOpContext {
   Tensor run(const Tensor& input) override;
   void free_orig_weight_and_bias() override;
 
+  // See XNNPackLinearOpContext::create_context().
   static c10::intrusive_ptr<TransposeConv2dOpContext> create_context(
       Tensor&& weight,
       c10::optional<Tensor>&& bias,
@@ -228,7 +244,11 @@ class XNNPackTransposeConv2dOpContext final : public TransposeConv2dOpContext {
       std::vector<int64_t>&& dilation,
       int64_t groups,
       const c10::optional<Scalar> output_min,
-      const c10::optional<Scalar> output_max);
+      const c10::optional<Scalar> output_max,
+      bool prepack = true);
+
+ private:
+  void pack();
 };
 
 } // namespace xnnpack
@@ -24,11 +24,14 @@ TORCH_LIBRARY(xnnpack, m) {
         },
         [](SerializationTypeLinearPrePack state)
             -> c10::intrusive_ptr<LinearOpContext> { // __setstate__
-          return createLinearClampPrePackOpContext(
+          // Packing is deferred to the first run so that loading a model
+          // stays cheap.  Layers that never run are never packed.
+          return XNNPackLinearOpContext::create_context(
               std::move(std::get<0>(state)),
               std::move(std::get<1>(state)),
-              std::move(std::get<2>(state)),
-              std::move(std::get<3>(state)));
+              std::get<2>(state),
+              std::get<3>(state),
+              false); // prepack
         });
 
   m.class_<Conv2dOpContext>("Conv2dOpContext")
@@ -39,15 +42,16 @@ TORCH_LIBRARY(xnnpack, m) {
         },
         [](SerializationTypeConv2dPrePack state)
             -> c10::intrusive_ptr<Conv2dOpContext> { // __setstate__
-          return createConv2dClampPrePackOpContext(
+          return XNNPackConv2dOpContext::create_context(
               std::move(std::get<0>(state)),
               std::move(std::get<1>(state)),
-              std::move(std::get<2>(state)),
               std::move(std::get<3>(state)),
+              std::move(std::get<2>(state)),
               std::move(std::get<4>(state)),
-              std::move(std::get<5>(state)),
-              std::move(std::get<6>(state)),
-              std::move(std::get<7>(state)));
+              std::get<5>(state),
+              std::get<6>(state),
+              std::get<7>(state),
+              false); // prepack
         });
 
   m.class_<TransposeConv2dOpContext>("TransposeConv2dOpContext")
@@ -58,16 +62,17 @@ TORCH_LIBRARY(xnnpack, m) {
         },
         [](SerializationTypeTransposeConv2dPrePack state)
             -> c10::intrusive_ptr<TransposeConv2dOpContext> { // __setstate__
-          return createConv2dTransposeClampPrePackOpContext(
+          return XNNPackTransposeConv2dOpContext::create_context(
               std::move(std::get<0>(state)),
               std::move(std::get<1>(state)),
-              std::move(std::get<2>(state)),
               std::move(std::get<3>(state)),
               std::move(std::get<4>(state)),
+              std::move(std::get<2>(state)),
               std::move(std::get<5>(state)),
-              std::move(std::get<6>(state)),
-              std::move(std::get<7>(state)),
-              std::move(std::get<8>(state)));
+              std::get<6>(state),
+              std::get<7>(state),
+              std::get<8>(state),
+              false); // prepack
         });
 
 }
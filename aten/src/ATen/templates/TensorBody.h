@@ -364,6 +364,14 @@ class TORCH_API Tensor {
   /// Returns if a `Tensor` is mkldnn tensor.
   bool is_mkldnn() const;
 
+  /// Returns if a `Tensor` is a NestedTensor.
+  bool is_nested() const;
+
+  /// Returns if a `Tensor` is an inference tensor, see c10::InferenceMode.
+  bool is_inference() const {
+    return impl_->is_inference();
+  }
+
   /// Returns if a `Tensor` is mlc tensor.
   bool is_mlc() const;
 
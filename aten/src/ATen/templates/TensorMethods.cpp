@@ -145,6 +145,11 @@ bool is_mkldnn(Tensor self) {
   return self.is_mkldnn();
 }
 
+bool Tensor::is_nested() const {
+  // NB: this is not a native function to avoid dispatching overhead.
+  return impl_->is_nested();
+}
+
 bool Tensor::is_mlc() const {
   // NB: this is not a native function to avoid dispatching overhead.
   return impl_->is_mlc();
@@ -184,6 +184,28 @@ TEST(IValueTest, Tuple) {
       std::get<1>(t_).item().to<float>(), std::get<1>(t).item().to<float>());
 }
 
+TEST(IValueTest, TupleToStdTuple) {
+  auto t = at::randn({1});
+  IValue iv = c10::ivalue::Tuple::create(t, int64_t(3));
+  EXPECT_EQ(t.use_count(), 2);
+
+  // Elements of a tuple that something else refers to are copied
+  IValue shared = iv;
+  auto copied = shared.to<std::tuple<at::Tensor, int64_t>>();
+  EXPECT_TRUE(std::get<0>(copied).is_same(t));
+  EXPECT_EQ(std::get<1>(copied), 3);
+  ASSERT_TRUE(iv.toTuple()->elements()[0].isTensor());
+  EXPECT_TRUE(iv.toTuple()->elements()[0].toTensor().is_same(t));
+  EXPECT_EQ(t.use_count(), 3);
+
+  // and the ones of a tuple that nothing else refers to are moved
+  shared = IValue();
+  auto moved = std::move(iv).to<std::tuple<at::Tensor, int64_t>>();
+  EXPECT_TRUE(std::get<0>(moved).is_same(t));
+  EXPECT_EQ(std::get<1>(moved), 3);
+  EXPECT_EQ(t.use_count(), 3);
+}
+
 TEST(IValueTest, unsafeRemoveAttr) {
   auto cu = std::make_shared<CompilationUnit>();
   auto cls = ClassType::create("foo.bar", cu);
@@ -210,3 +210,67 @@ TEST(TensorIteratorTest, FailNonPromotingBinaryOp) {
   config.add_input(at::ones({1,1}, at::dtype(at::kInt)));
   ASSERT_ANY_THROW(config.build());
 }
+
+TEST(TensorIteratorTest, PlanCache) {
+  auto a = at::randn({16, 8});
+  auto b = at::randn({16, 8});
+  auto c = at::randn({16, 8});
+  auto transposed = at::randn({8, 16}).t();
+  auto a_int = a.to(at::kInt);
+  auto b_int = b.to(at::kInt);
+  auto given = at::empty({16, 8});
+
+  auto add = [](const Tensor& x, const Tensor& y) {
+    Tensor out;
+    auto iter = TensorIterator::binary_op(out, x, y);
+    at::native::cpu_serial_kernel(iter, [](float p, float q) -> float { return p + q; });
+    return iter.output();
+  };
+
+  // only the iterators built below may touch the cache, the expected values
+  // are computed after it is disabled again
+  at::set_tensor_iterator_plan_cache_enabled(true);
+  at::clear_tensor_iterator_plan_cache();
+  at::reset_tensor_iterator_plan_cache_stats();
+
+  auto first = add(a, b);
+  auto stats = at::tensor_iterator_plan_cache_stats();
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.hits, 0);
+
+  // same metadata, new data
+  auto second = add(b, c);
+  stats = at::tensor_iterator_plan_cache_stats();
+  EXPECT_EQ(stats.hits, 1);
+
+  // different strides miss
+  auto third = add(transposed, c);
+  stats = at::tensor_iterator_plan_cache_stats();
+  EXPECT_EQ(stats.misses, 2);
+
+  // different dtypes miss
+  Tensor out;
+  auto int_iter = TensorIterator::binary_op(out, a_int, b_int);
+  stats = at::tensor_iterator_plan_cache_stats();
+  EXPECT_EQ(stats.misses, 3);
+  EXPECT_EQ(int_iter.dtype(), at::kInt);
+
+  // a given output is bound, not allocated
+  auto given_iter = TensorIterator::binary_op(given, b, c);
+  given_iter = TensorIterator::binary_op(given, b, c);
+  stats = at::tensor_iterator_plan_cache_stats();
+  EXPECT_EQ(stats.misses, 4);
+  EXPECT_EQ(stats.hits, 2);
+  EXPECT_TRUE(given_iter.output().is_same(given));
+  EXPECT_EQ(given_iter.data_ptr(0), given.data_ptr());
+  EXPECT_EQ(given_iter.data_ptr(1), b.data_ptr());
+  EXPECT_EQ(given_iter.data_ptr(2), c.data_ptr());
+
+  at::set_tensor_iterator_plan_cache_enabled(false);
+  at::clear_tensor_iterator_plan_cache();
+
+  ASSERT_TRUE(first.equal(a + b));
+  ASSERT_TRUE(second.equal(b + c));
+  ASSERT_TRUE(third.equal(transposed + c));
+  EXPECT_EQ(second.strides(), first.strides());
+}
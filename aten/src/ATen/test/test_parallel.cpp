@@ -52,6 +52,21 @@ TEST(TestParallel, Exceptions) {
     std::runtime_error);
 }
 
+TEST(TestParallel, NUMAAwareParallelFor) {
+  // falls back to the regular pool on hosts and builds without NUMA, the
+  // results have to be the same either way
+  at::set_numa_aware_parallelism(true);
+  std::vector<int64_t> visited(1000, 0);
+  at::parallel_for(0, visited.size(), 1, [&](int64_t begin, int64_t end) {
+    for (auto i = begin; i < end; ++i) {
+      visited[i]++;
+    }
+  });
+  for (auto v : visited) {
+    ASSERT_EQ(v, 1);
+  }
+}
+
 TEST(TestParallel, IntraOpLaunchFuture) {
   int v1 = 0;
   int v2 = 0;
@@ -69,3 +84,35 @@ TEST(TestParallel, IntraOpLaunchFuture) {
 
   ASSERT_TRUE(v1 == 1 && v2 == 2);
 }
+
+TEST(TestParallel, InteropTaskBudget) {
+  const int budget = at::get_thread_budget();
+  ASSERT_GT(budget, 0);
+  ASSERT_EQ(at::internal::intraop_width_limit(), 0);
+  {
+    at::internal::InteropTaskBudgetGuard outer;
+    const int outer_width = at::internal::intraop_width_limit();
+    ASSERT_GE(outer_width, 1);
+    ASSERT_LE(outer_width, budget);
+    ASSERT_LE(at::get_num_threads(), outer_width);
+    {
+      // a task run while waiting on others gets a narrower share
+      at::internal::InteropTaskBudgetGuard inner;
+      ASSERT_LE(at::internal::intraop_width_limit(), outer_width);
+      ASSERT_LE(at::get_num_threads(), at::internal::intraop_width_limit());
+    }
+    ASSERT_EQ(at::internal::intraop_width_limit(), outer_width);
+
+    // parallel primitives still cover the whole range with a reduced width
+    std::vector<int64_t> visited(1000, 0);
+    at::parallel_for(0, visited.size(), 1, [&](int64_t begin, int64_t end) {
+      for (auto i = begin; i < end; ++i) {
+        visited[i]++;
+      }
+    });
+    for (auto v : visited) {
+      ASSERT_EQ(v, 1);
+    }
+  }
+  ASSERT_EQ(at::internal::intraop_width_limit(), 0);
+}
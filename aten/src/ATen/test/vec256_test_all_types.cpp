@@ -55,12 +55,20 @@ namespace {
     class ComplexTests : public ::testing::Test {};
     template <typename T>
     class QuantizationTests : public ::testing::Test {};
+#if defined(CPU_CAPABILITY_AVX512) && !defined(_MSC_VER)
+    using RealFloatTestedTypes = ::testing::Types<vfloat, vdouble, vwfloat, vwdouble>;
+    using FloatTestedTypes = ::testing::Types<vfloat, vdouble, vcomplex, vcomplexDbl, vwfloat, vwdouble>;
+    using ALLTestedTypes = ::testing::Types<vfloat, vdouble, vcomplex, vlong, vint, vshort, vqint8, vquint8, vqint, vwfloat, vwdouble>;
+    using RealFloatIntTestedTypes = ::testing::Types<vfloat, vdouble, vlong, vint, vshort, vwfloat, vwdouble>;
+    using FloatIntTestedTypes = ::testing::Types<vfloat, vdouble, vcomplex, vcomplexDbl, vlong, vint, vshort, vwfloat, vwdouble>;
+#else
     using RealFloatTestedTypes = ::testing::Types<vfloat, vdouble>;
     using FloatTestedTypes = ::testing::Types<vfloat, vdouble, vcomplex, vcomplexDbl>;
     using ALLTestedTypes = ::testing::Types<vfloat, vdouble, vcomplex, vlong, vint, vshort, vqint8, vquint8, vqint>;
-    using QuantTestedTypes = ::testing::Types<vqint8, vquint8, vqint>;
     using RealFloatIntTestedTypes = ::testing::Types<vfloat, vdouble, vlong, vint, vshort>;
     using FloatIntTestedTypes = ::testing::Types<vfloat, vdouble, vcomplex, vcomplexDbl, vlong, vint, vshort>;
+#endif
+    using QuantTestedTypes = ::testing::Types<vqint8, vquint8, vqint>;
     using ComplexTypes = ::testing::Types<vcomplex, vcomplexDbl>;
     TYPED_TEST_CASE(Memory, ALLTestedTypes);
     TYPED_TEST_CASE(Arithmetics, FloatIntTestedTypes);
@@ -1156,6 +1164,117 @@ namespace {
             test_case);
     }
 
+    TEST(BFloat16Conversions, ConvertFloat) {
+        using bvec = at::vec256::Vec256<c10::BFloat16>;
+        using fvec = at::vec256::Vec256<float>;
+        TestSeed seed;
+        std::mt19937 gen(seed.getSeed());
+        std::uniform_real_distribution<float> dist(-100.f, 100.f);
+        CACHE_ALIGN float floats[bvec::size()];
+        CACHE_ALIGN c10::BFloat16 bfloats[bvec::size()];
+        CACHE_ALIGN float actual_floats[bvec::size()];
+        CACHE_ALIGN c10::BFloat16 actual_bfloats[bvec::size()];
+        for (int trial = 0; trial < 100; trial++) {
+            for (int i = 0; i < bvec::size(); i++) {
+                floats[i] = dist(gen);
+                bfloats[i] = c10::BFloat16(floats[i]);
+            }
+            fvec lo, hi;
+            std::tie(lo, hi) = at::vec256::convert_bfloat16_float(bvec::loadu(bfloats));
+            lo.store(actual_floats);
+            hi.store(actual_floats + fvec::size());
+            for (int i = 0; i < bvec::size(); i++) {
+                ASSERT_EQ(actual_floats[i], static_cast<float>(bfloats[i]));
+            }
+            at::vec256::convert_float_bfloat16(fvec::loadu(floats), fvec::loadu(floats + fvec::size()))
+                .store(actual_bfloats);
+            for (int i = 0; i < bvec::size(); i++) {
+                ASSERT_EQ(actual_bfloats[i].x, bfloats[i].x) << floats[i];
+            }
+            at::vec256::load_fp32_from_bf16(bfloats, lo);
+            lo.store(actual_floats);
+            for (int i = 0; i < fvec::size(); i++) {
+                ASSERT_EQ(actual_floats[i], static_cast<float>(bfloats[i]));
+            }
+            bvec::loadu(bfloats).abs().store(actual_bfloats);
+            for (int i = 0; i < bvec::size(); i++) {
+                ASSERT_EQ(static_cast<float>(actual_bfloats[i]), std::abs(static_cast<float>(bfloats[i])));
+            }
+            bvec::loadu(bfloats).neg().store(actual_bfloats);
+            for (int i = 0; i < bvec::size(); i++) {
+                ASSERT_EQ(static_cast<float>(actual_bfloats[i]), -static_cast<float>(bfloats[i]));
+            }
+        }
+    }
+    TEST(BFloat16Functional, MapAndReduce) {
+        using fvec = at::vec256::Vec256<float>;
+        TestSeed seed;
+        std::mt19937 gen(seed.getSeed());
+        std::uniform_real_distribution<float> dist(-2.f, 2.f);
+        // covers sizes below, equal to and between multiples of the vector size
+        for (int64_t size = 1; size <= 70; size++) {
+            std::vector<c10::BFloat16> a(size), b(size), c(size), out(size);
+            std::vector<float> acc(size), acc_out(size);
+            for (int64_t i = 0; i < size; i++) {
+                a[i] = c10::BFloat16(dist(gen));
+                b[i] = c10::BFloat16(dist(gen));
+                c[i] = c10::BFloat16(dist(gen));
+                acc[i] = dist(gen);
+            }
+            auto fa = [&](int64_t i) { return static_cast<float>(a[i]); };
+            auto fb = [&](int64_t i) { return static_cast<float>(b[i]); };
+            auto fc = [&](int64_t i) { return static_cast<float>(c[i]); };
+            float sum = 0, sum_sq = 0, dot = 0, dot3 = 0, max_val = fa(0);
+            for (int64_t i = 0; i < size; i++) {
+                sum += fa(i);
+                sum_sq += fa(i) * fa(i);
+                dot += fa(i) * fb(i);
+                dot3 += fa(i) * fb(i) * fc(i);
+                max_val = std::max(max_val, fa(i));
+            }
+            const float tol = 1e-4f * size;
+            auto add = [](fvec x, fvec y) { return x + y; };
+            ASSERT_NEAR(at::vec256::reduce_all<c10::BFloat16>(add, a.data(), size), sum, tol);
+            ASSERT_EQ(at::vec256::reduce_all<c10::BFloat16>(
+                [](fvec& x, fvec& y) { return at::vec256::maximum(x, y); }, a.data(), size), max_val);
+            ASSERT_NEAR(at::vec256::map_reduce_all<c10::BFloat16>(
+                [](fvec x) { return x * x; }, add, a.data(), size), sum_sq, tol);
+            ASSERT_NEAR(at::vec256::map2_reduce_all<c10::BFloat16>(
+                [](fvec x, fvec y) { return x * y; }, add, a.data(), b.data(), size), dot, tol);
+            ASSERT_NEAR(at::vec256::map3_reduce_all<c10::BFloat16>(
+                [](fvec x, fvec y, fvec z) { return x * y * z; }, add, a.data(), b.data(), c.data(), size), dot3, tol);
+
+            // a single rounding to BFloat16 at the end
+            at::vec256::map<c10::BFloat16>(
+                [](fvec x) { return (x + fvec(1.f)) * fvec(3.f); }, out.data(), a.data(), size);
+            for (int64_t i = 0; i < size; i++) {
+                ASSERT_EQ(out[i].x, c10::BFloat16((fa(i) + 1.f) * 3.f).x);
+            }
+            at::vec256::map2<c10::BFloat16>(
+                [](fvec x, fvec y) { return (x - y) * y; }, out.data(), a.data(), b.data(), size);
+            for (int64_t i = 0; i < size; i++) {
+                ASSERT_EQ(out[i].x, c10::BFloat16((fa(i) - fb(i)) * fb(i)).x);
+            }
+            at::vec256::map3<c10::BFloat16>(
+                [](fvec x, fvec y, fvec z) { return (x + y) * z; }, out.data(), a.data(), b.data(), c.data(), size);
+            for (int64_t i = 0; i < size; i++) {
+                ASSERT_EQ(out[i].x, c10::BFloat16((fa(i) + fb(i)) * fc(i)).x);
+            }
+
+            // float accumulators
+            at::vec256::map2<c10::BFloat16>(
+                [](fvec x, fvec y) { return x + y; }, acc_out.data(), acc.data(), a.data(), size);
+            for (int64_t i = 0; i < size; i++) {
+                ASSERT_EQ(acc_out[i], acc[i] + fa(i));
+            }
+            at::vec256::map3<c10::BFloat16>(
+                [](fvec x, fvec y, fvec z) { return x + y * z; }, acc_out.data(), acc.data(), a.data(), b.data(), size);
+            for (int64_t i = 0; i < size; i++) {
+                ASSERT_NEAR(acc_out[i], acc[i] + fa(i) * fb(i), 1e-6f);
+            }
+        }
+    }
+
 #else
 #error GTEST does not have TYPED_TEST
 #endif
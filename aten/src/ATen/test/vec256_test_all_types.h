@@ -1,5 +1,6 @@
 #pragma once
 #include <ATen/cpu/vec256/vec256.h>
+#include <ATen/cpu/vec256/functional.h>
 #include <gtest/gtest.h>
 #include <chrono>
 #include <exception>
@@ -25,7 +26,7 @@ CACHE_ALIGN #define
 #endif
 #if defined(CPU_CAPABILITY_DEFAULT) || defined(_MSC_VER)
 #define TEST_AGAINST_DEFAULT 1
-#elif !defined(CPU_CAPABILITY_AVX) &&  !defined(CPU_CAPABILITY_AVX2) && !defined(CPU_CAPABILITY_VSX)
+#elif !defined(CPU_CAPABILITY_AVX) &&  !defined(CPU_CAPABILITY_AVX2) && !defined(CPU_CAPABILITY_AVX512) && !defined(CPU_CAPABILITY_VSX)
 #define TEST_AGAINST_DEFAULT 1
 #else
 #undef TEST_AGAINST_DEFAULT
@@ -40,10 +41,10 @@ CACHE_ALIGN #define
     return __VA_ARGS__(std::forward<decltype(args)>(args)...); \
   }
 
-#if defined(CPU_CAPABILITY_VSX) || defined(CPU_CAPABILITY_AVX2) && (defined(__GNUC__) || defined(__GNUG__))
+#if defined(CPU_CAPABILITY_VSX) || (defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)) && (defined(__GNUC__) || defined(__GNUG__))
 #undef CHECK_DEQUANT_WITH_LOW_PRECISION
 #define CHECK_WITH_FMA 1
-#elif !defined(CPU_CAPABILITY_VSX) && !defined(CPU_CAPABILITY_AVX2)
+#elif !defined(CPU_CAPABILITY_VSX) && !defined(CPU_CAPABILITY_AVX2) && !defined(CPU_CAPABILITY_AVX512)
 #undef CHECK_DEQUANT_WITH_LOW_PRECISION
 #undef CHECK_WITH_FMA
 #else
@@ -67,6 +68,9 @@ using vshort = VecType<int16_t>;
 using vqint8 = VecType<c10::qint8>;
 using vquint8 = VecType<c10::quint8>;
 using vqint = VecType<c10::qint32>;
+// Vec512 in AVX512 builds, the same as vfloat and vdouble otherwise
+using vwfloat = at::vec256::Vectorized<float>;
+using vwdouble = at::vec256::Vectorized<double>;
 
 template <typename T>
 using ValueType = typename T::value_type;
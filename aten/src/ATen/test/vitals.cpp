@@ -2,7 +2,9 @@
 
 #include <ATen/ATen.h>
 #include <ATen/core/Vitals.h>
+#include <algorithm>
 #include <cstdlib>
+#include <thread>
 
 using namespace at::vitals;
 
@@ -89,3 +91,77 @@ TEST(Vitals, OnAndOff) {
     }
   }
 }
+
+TEST(Vitals, Counter) {
+  auto& c = counter("test.counter");
+  ASSERT_EQ(&c, &counter("test.counter"));
+  c.reset();
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < 4; ++i) {
+    threads.emplace_back([&c]() {
+      for (auto j = 0; j < 1000; ++j) {
+        c.add();
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  c.add(5);
+  ASSERT_EQ(c.value(), 4005);
+  c.reset();
+  ASSERT_EQ(c.value(), 0);
+}
+
+TEST(Vitals, Gauge) {
+  auto& g = gauge("test.gauge");
+  g.set(3);
+  g.add(-5);
+  ASSERT_EQ(g.value(), -2);
+  ASSERT_THROW(counter("test.gauge"), c10::Error);
+}
+
+TEST(Vitals, Histogram) {
+  auto& h = histogram("test.histogram", {1, 10});
+  h.reset();
+  for (double v : {0.5, 1.0, 2.0, 10.0, 11.0, 100.0}) {
+    h.observe(v);
+  }
+  ASSERT_EQ(h.counts(), std::vector<int64_t>({2, 2, 2}));
+  ASSERT_EQ(h.count(), 6);
+  ASSERT_DOUBLE_EQ(h.sum(), 124.5);
+  ASSERT_EQ(&h, &histogram("test.histogram", {1, 10}));
+  ASSERT_THROW(histogram("test.histogram", {1, 100}), c10::Error);
+  ASSERT_THROW(histogram("test.unsorted", {10, 1}), c10::Error);
+}
+
+TEST(Vitals, Snapshot) {
+  counter("test.snapshot.counter").add(2);
+  gauge("test.snapshot.gauge").set(7);
+  histogram("test.snapshot.histogram", {1}).observe(3);
+
+  auto snapshots = snapshotMetrics();
+  ASSERT_TRUE(std::is_sorted(
+      snapshots.begin(),
+      snapshots.end(),
+      [](const MetricSnapshot& a, const MetricSnapshot& b) {
+        return a.name < b.name;
+      }));
+  auto find = [&snapshots](const std::string& name) {
+    return *std::find_if(
+        snapshots.begin(),
+        snapshots.end(),
+        [&name](const MetricSnapshot& s) { return s.name == name; });
+  };
+  ASSERT_EQ(find("test.snapshot.counter").kind, MetricKind::Counter);
+  ASSERT_GE(find("test.snapshot.counter").value, 2);
+  ASSERT_EQ(find("test.snapshot.gauge").value, 7);
+  auto h = find("test.snapshot.histogram");
+  ASSERT_EQ(h.kind, MetricKind::Histogram);
+  ASSERT_EQ(h.counts, std::vector<int64_t>({0, 1}));
+
+  resetMetrics();
+  ASSERT_EQ(counter("test.snapshot.counter").value(), 0);
+  ASSERT_EQ(gauge("test.snapshot.gauge").value(), 7);
+  ASSERT_EQ(histogram("test.snapshot.histogram", {1}).count(), 0);
+}
@@ -14,6 +14,9 @@
 #if CUDA_VERSION >= 7000 || defined(__HIP_PLATFORM_HCC__)
 #include <thrust/system/cuda/execution_policy.h>
 #endif
+#if !defined(__HIP_PLATFORM_HCC__)
+#include <ATen/native/cuda/SortingSegmented.cuh>
+#endif
 
 template <typename T, bool handleNaN = false>
 struct ThrustGTOp {
@@ -276,6 +276,34 @@ void THCTensor_(sortViaThrust)(THCState* state,
   THCudaLongTensor_freeCopyTo(state, trContigIndices, indices);
 }
 
+#if !defined(__HIP_PLATFORM_HCC__)
+// Sorts slices of any size with a segmented radix sort, one segment per
+// slice. Unlike sortViaThrust, it doesn't compare across slices, so its
+// cost grows linearly with the number of elements.
+void THCTensor_(sortViaSegmentedRadixSort)(THCState* state,
+                                           THCTensor* sorted,
+                                           THCudaLongTensor* indices,
+                                           THCTensor* input,
+                                           int dim, bool dir) {
+  // The segments are the rows of the input with dim moved innermost
+  at::Tensor self = THTensor_wrap(input);
+  if (self.dim() == 0) {
+    self = self.view({1});
+  }
+  self = self.transpose(dim, -1).contiguous();
+  int64_t sliceSize = self.size(-1);
+  at::Tensor rows = self.view({-1, sliceSize});
+  at::Tensor sortedRows = at::empty_like(rows);
+  at::Tensor indicesRows = at::empty_like(rows, rows.options().dtype(at::kLong));
+  at::native::segmentedSort<scalar_t>(rows, sortedRows, indicesRows, dir);
+
+  at::Tensor sorted_wrap = THTensor_wrap(sorted);
+  at::Tensor indices_wrap = THTensor_wrap(indices);
+  sorted_wrap.copy_(sortedRows.view(self.sizes()).transpose(dim, -1).view(sorted_wrap.sizes()));
+  indices_wrap.copy_(indicesRows.view(self.sizes()).transpose(dim, -1).view(indices_wrap.sizes()));
+}
+#endif
+
 void THCTensor_(sort)(THCState* state,
                       THCTensor *sorted,
                       THCudaLongTensor *indices,
@@ -324,6 +352,13 @@ void THCTensor_(sort)(THCState* state,
     // layout
     THCTensor_(sortKeyValueInplace)(state, sorted, indices, dim, order);
   } else {
+#if !defined(__HIP_PLATFORM_HCC__)
+    if (THCTensor_(nElement)(state, input) <= INT_MAX) {
+      THCTensor_(sortViaSegmentedRadixSort)(state, sorted, indices, input, dim, (bool) order);
+      THCudaCheck(cudaGetLastError());
+      return;
+    }
+#endif
     // Otherwise, fall back upon Thrust, which handles all other cases
     // (potentially slowly, with extra copies/memory allocations)
     THCTensor_(sortViaThrust)(state, sorted, indices, input, dim, (bool) order);
@@ -34,6 +34,24 @@ void THCTensor_(topk)(THCState* state,
   THCTensor_(resize)(state, topK, topKSize, {});
   THCudaLongTensor_resize(state, indices, topKSize, {});
 
+#if !defined(__HIP_PLATFORM_HCC__)
+  // When most of the slice is selected and has to be sorted, sorting the
+  // whole slices with the segmented radix sort of THCTensor_(sort) beats
+  // selecting first, then sorting the selection.
+  if (sorted && k > 2048 && 2 * k >= sliceSize &&
+      THCTensor_(nElement)(state, input) <= INT_MAX) {
+    THCTensor* sortedInput = THCTensor_(new)(state);
+    THCudaLongTensor* sortedIndices = THCudaLongTensor_new(state);
+    THCTensor_(sort)(state, sortedInput, sortedIndices, input, dim, dir);
+    THCTensor_(narrow)(state, sortedInput, NULL, dim, 0, k);
+    THCudaLongTensor_narrow(state, sortedIndices, NULL, dim, 0, k);
+    THCTensor_(freeCopyTo)(state, sortedInput, topK);
+    THCudaLongTensor_freeCopyTo(state, sortedIndices, indices);
+    THCTensor_(free)(state, input);
+    return;
+  }
+#endif
+
   // static_cast is required to ensure that the correct type (INDEX_T)
   // is provided to the kernel for the arguments.
 
@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+#include <torch/torch.h>
+
+#include <numeric>
+
+using namespace torch::data;
+
+namespace {
+
+// Reads chunks of consecutive integers, so that the benchmark measures the
+// batch buffer rather than the reader.
+class IotaChunkReader : public datasets::ChunkDataReader<int64_t> {
+ public:
+  using BatchType = datasets::ChunkDataReader<int64_t>::ChunkType;
+
+  IotaChunkReader(size_t chunk_count, size_t chunk_size)
+      : chunk_count_(chunk_count), chunk_size_(chunk_size) {}
+
+  BatchType read_chunk(size_t chunk_index) override {
+    BatchType chunk(chunk_size_);
+    std::iota(chunk.begin(), chunk.end(), chunk_index * chunk_size_);
+    return chunk;
+  }
+
+  size_t chunk_count() override {
+    return chunk_count_;
+  }
+
+  void reset() override {}
+
+ private:
+  size_t chunk_count_;
+  size_t chunk_size_;
+};
+
+} // namespace
+
+// Arguments: preloader count, batch size.
+static void BM_ChunkDatasetThroughput(benchmark::State& state) {
+  const size_t kChunkCount = 64;
+  const size_t kChunkSize = 4096;
+  const size_t preloader_count = state.range(0);
+  const size_t batch_size = state.range(1);
+
+  datasets::ChunkDataset<
+      IotaChunkReader,
+      samplers::SequentialSampler,
+      samplers::RandomSampler>
+      dataset(
+          IotaChunkReader(kChunkCount, kChunkSize),
+          samplers::SequentialSampler(0),
+          samplers::RandomSampler(0),
+          datasets::ChunkDatasetOptions(
+              preloader_count, batch_size, /*cache_size=*/16 * kChunkSize));
+
+  int64_t examples = 0;
+  for (auto _ : state) {
+    dataset.reset();
+    while (auto batch = dataset.get_batch()) {
+      examples += batch->size();
+      benchmark::DoNotOptimize(batch->data());
+    }
+  }
+  state.SetItemsProcessed(examples);
+}
+
+BENCHMARK(BM_ChunkDatasetThroughput)
+    ->Args({1, 32})
+    ->Args({4, 32})
+    ->Args({8, 32})
+    ->Args({4, 256})
+    ->Args({8, 256})
+    ->UseRealTime();
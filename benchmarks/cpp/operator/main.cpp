@@ -0,0 +1,339 @@
+// Times one ATen operator called through the dispatcher, without Python in
+// the way, for every combination of the given shapes, dtypes and memory
+// formats. Prints JSON that compare-fastrnn-results.py can diff:
+//
+//   {"<op>": {"<config>": seconds per call},
+//    "<op>:cycles": {"<config>": cycles per call}, ...}
+//
+// Example:
+//   operator_bench --op=add.Tensor --shapes="64,64;64,64|1024,1024;1024,1024"
+//       --dtypes=float,double --args=alpha=2 > base.json
+
+#include <ATen/ATen.h>
+#include <ATen/core/dispatch/Dispatcher.h>
+#include <c10/util/Flags.h>
+#include <torch/csrc/autograd/grad_mode.h>
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "perf_counters.h"
+
+C10_DEFINE_string(
+    op,
+    "",
+    "The operator to benchmark, as named in native_functions.yaml, e.g. "
+    "add.Tensor.");
+C10_DEFINE_string(
+    shapes,
+    "",
+    "Comma separated sizes of each tensor argument, separated by semicolons. "
+    "Separate several configurations with |.");
+C10_DEFINE_string(dtypes, "float", "Comma separated dtypes of the tensors.");
+C10_DEFINE_string(
+    memory_formats,
+    "contiguous",
+    "Comma separated memory formats of the tensors (contiguous, "
+    "channels_last, channels_last_3d). Tensors of other ranks stay "
+    "contiguous.");
+C10_DEFINE_string(
+    args,
+    "",
+    "Comma separated name=value of the other arguments, for those without a "
+    "default. List values are separated by colons, e.g. dim=0:1.");
+C10_DEFINE_int(warmup, 10, "The number of calls to warm up.");
+C10_DEFINE_int(iter, 100, "The number of calls to measure.");
+C10_DEFINE_int(threads, 0, "The number of intra-op threads, 0 for default.");
+C10_DEFINE_bool(counters, true, "Whether to read the hardware counters.");
+C10_DEFINE_string(output, "", "File to write the JSON to, stdout by default.");
+
+namespace {
+
+std::vector<std::string> split(char separator, const std::string& string) {
+  std::vector<std::string> pieces;
+  std::stringstream ss(string);
+  std::string item;
+  while (getline(ss, item, separator)) {
+    if (!item.empty()) {
+      pieces.push_back(std::move(item));
+    }
+  }
+  return pieces;
+}
+
+at::ScalarType parseDtype(const std::string& name) {
+  static const std::map<std::string, at::ScalarType> dtypes = {
+      {"float", at::kFloat},
+      {"double", at::kDouble},
+      {"half", at::kHalf},
+      {"bfloat16", at::kBFloat16},
+      {"int8", at::kChar},
+      {"uint8", at::kByte},
+      {"int32", at::kInt},
+      {"int64", at::kLong},
+      {"bool", at::kBool},
+  };
+  auto it = dtypes.find(name);
+  TORCH_CHECK(it != dtypes.end(), "Unsupported dtype: ", name);
+  return it->second;
+}
+
+at::MemoryFormat parseMemoryFormat(const std::string& name) {
+  if (name == "contiguous") {
+    return at::MemoryFormat::Contiguous;
+  } else if (name == "channels_last") {
+    return at::MemoryFormat::ChannelsLast;
+  } else if (name == "channels_last_3d") {
+    return at::MemoryFormat::ChannelsLast3d;
+  }
+  TORCH_CHECK(false, "Unsupported memory format: ", name);
+}
+
+at::Tensor makeTensor(
+    const std::vector<int64_t>& sizes,
+    at::ScalarType dtype,
+    at::MemoryFormat format) {
+  if ((format == at::MemoryFormat::ChannelsLast && sizes.size() != 4) ||
+      (format == at::MemoryFormat::ChannelsLast3d && sizes.size() != 5)) {
+    format = at::MemoryFormat::Contiguous;
+  }
+  auto options = at::TensorOptions(dtype).memory_format(format);
+  if (at::isFloatingType(dtype)) {
+    return at::rand(sizes, options);
+  }
+  if (dtype == at::kBool) {
+    return at::randint(2, sizes, options);
+  }
+  return at::randint(1, 100, sizes, options);
+}
+
+c10::IValue parseArgument(const c10::Argument& arg, const std::string& value) {
+  auto type = arg.type();
+  if (auto optional = type->cast<c10::OptionalType>()) {
+    type = optional->getElementType();
+  }
+  switch (type->kind()) {
+    case c10::TypeKind::IntType:
+      return static_cast<int64_t>(c10::stoll(value));
+    case c10::TypeKind::FloatType:
+      return c10::stod(value);
+    case c10::TypeKind::BoolType:
+      return value == "true" || value == "1";
+    case c10::TypeKind::NumberType:
+      if (value.find_first_of(".e") != std::string::npos) {
+        return c10::stod(value);
+      }
+      return static_cast<int64_t>(c10::stoll(value));
+    case c10::TypeKind::StringType:
+      return value;
+    case c10::TypeKind::ListType: {
+      std::vector<int64_t> ints;
+      for (const auto& item : split(':', value)) {
+        ints.push_back(c10::stoll(item));
+      }
+      return ints;
+    }
+    default:
+      TORCH_CHECK(
+          false, "Can't parse argument ", arg.name(), " of type ", *arg.type());
+  }
+}
+
+// Builds the arguments of one call. Tensors take the shapes in order, the
+// other arguments come from --args or their defaults.
+std::vector<c10::IValue> makeStack(
+    const c10::FunctionSchema& schema,
+    const std::vector<std::vector<int64_t>>& shapes,
+    const std::map<std::string, std::string>& args,
+    at::ScalarType dtype,
+    at::MemoryFormat format) {
+  std::vector<c10::IValue> stack;
+  size_t next_shape = 0;
+  for (const auto& arg : schema.arguments()) {
+    auto it = args.find(arg.name());
+    if (it != args.end()) {
+      stack.push_back(parseArgument(arg, it->second));
+      continue;
+    }
+    const bool is_tensor = arg.type()->isSubtypeOf(c10::TensorType::get());
+    const bool is_optional_tensor =
+        arg.type()->isSubtypeOf(c10::OptionalType::ofTensor());
+    if ((is_tensor || is_optional_tensor) && next_shape < shapes.size()) {
+      stack.push_back(makeTensor(shapes[next_shape++], dtype, format));
+    } else if (arg.default_value()) {
+      stack.push_back(*arg.default_value());
+    } else {
+      TORCH_CHECK(
+          false,
+          "No value for argument ",
+          arg.name(),
+          " of ",
+          schema.name(),
+          ", give one with --shapes or --args");
+    }
+  }
+  TORCH_CHECK(
+      next_shape == shapes.size(),
+      schema.name(),
+      " has fewer tensor arguments than shapes");
+  return stack;
+}
+
+struct Result {
+  double seconds;
+  torch::benchmarks::PerfCounters::Values counters;
+};
+
+Result run(
+    const c10::OperatorHandle& op,
+    const std::vector<c10::IValue>& inputs,
+    torch::benchmarks::PerfCounters& counters) {
+  std::vector<c10::IValue> stack;
+  for (int i = 0; i < FLAGS_warmup; ++i) {
+    stack = inputs;
+    op.callBoxed(&stack);
+  }
+
+  // Copying the arguments only copies the references to the tensors, so it is
+  // left in the measurement rather than timing each call separately
+  Result result;
+  counters.start();
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < FLAGS_iter; ++i) {
+    stack = inputs;
+    op.callBoxed(&stack);
+  }
+  const auto end = std::chrono::steady_clock::now();
+  result.counters = counters.stop();
+  result.seconds =
+      std::chrono::duration<double>(end - start).count() / FLAGS_iter;
+  return result;
+}
+
+// e.g. 64x64_64x64
+std::string shapesName(const std::vector<std::vector<int64_t>>& shapes) {
+  std::stringstream ss;
+  for (size_t i = 0; i < shapes.size(); ++i) {
+    ss << (i ? "_" : "");
+    for (size_t j = 0; j < shapes[i].size(); ++j) {
+      ss << (j ? "x" : "") << shapes[i][j];
+    }
+  }
+  return ss.str();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  c10::SetUsageMessage(
+      "\nRuns an ATen operator through the dispatcher and prints its timings "
+      "as JSON. Example usage:\n"
+      "./operator_bench --op=add.Tensor --shapes=\"64,64;64,64\" "
+      "[--dtypes=float,double] [--memory_formats=contiguous,channels_last] "
+      "[--args=alpha=2] [--output=<json_file>]");
+  if (!c10::ParseCommandLineFlags(&argc, &argv)) {
+    std::cerr << "Failed to parse command line flags!" << std::endl;
+    std::cout << c10::UsageMessage() << std::endl;
+    return 1;
+  }
+  TORCH_CHECK(!FLAGS_op.empty(), c10::UsageMessage());
+  TORCH_CHECK(FLAGS_iter > 0, "--iter must be positive");
+
+  std::string name = FLAGS_op;
+  if (name.find("::") == std::string::npos) {
+    name = "aten::" + name;
+  }
+  const auto dot = name.find('.');
+  const std::string overload =
+      dot == std::string::npos ? "" : name.substr(dot + 1);
+  name = name.substr(0, dot);
+  const auto op = c10::Dispatcher::singleton().findSchemaOrThrow(
+      name.c_str(), overload.c_str());
+
+  if (FLAGS_threads > 0) {
+    at::set_num_threads(FLAGS_threads);
+  }
+  at::NoGradGuard no_grad;
+
+  std::map<std::string, std::string> args;
+  for (const auto& item : split(',', FLAGS_args)) {
+    const auto eq = item.find('=');
+    TORCH_CHECK(eq != std::string::npos, "Expected name=value: ", item);
+    args[item.substr(0, eq)] = item.substr(eq + 1);
+  }
+
+  torch::benchmarks::PerfCounters counters;
+  if (FLAGS_counters && !counters.available()) {
+    std::cerr << "Hardware counters are not available, "
+              << "check /proc/sys/kernel/perf_event_paranoid" << std::endl;
+  }
+  const bool report_counters = FLAGS_counters && counters.available();
+
+  // suite -> config -> value, in the layout of the fastrnns JSON
+  std::map<std::string, std::map<std::string, double>> results;
+  const auto configs = FLAGS_shapes.empty()
+      ? std::vector<std::string>{""}
+      : split('|', FLAGS_shapes);
+  for (const auto& config : configs) {
+    std::vector<std::vector<int64_t>> shapes;
+    for (const auto& shape : split(';', config)) {
+      std::vector<int64_t> sizes;
+      for (const auto& size : split(',', shape)) {
+        sizes.push_back(c10::stoll(size));
+      }
+      shapes.push_back(std::move(sizes));
+    }
+    for (const auto& dtype : split(',', FLAGS_dtypes)) {
+      for (const auto& format : split(',', FLAGS_memory_formats)) {
+        const auto inputs = makeStack(
+            op.schema(),
+            shapes,
+            args,
+            parseDtype(dtype),
+            parseMemoryFormat(format));
+        const auto result = run(op, inputs, counters);
+        std::string test_name = dtype + "_" + format;
+        if (!shapes.empty()) {
+          test_name = shapesName(shapes) + "_" + test_name;
+        }
+        results[FLAGS_op][test_name] = result.seconds;
+        if (report_counters) {
+          for (int i = 0; i < torch::benchmarks::PerfCounters::kNumCounters;
+               ++i) {
+            const auto counter =
+                static_cast<torch::benchmarks::PerfCounters::Counter>(i);
+            results[FLAGS_op + ":" + counters.name(counter)][test_name] =
+                static_cast<double>(result.counters[i]) / FLAGS_iter;
+          }
+        }
+      }
+    }
+  }
+
+  std::stringstream json;
+  json << std::setprecision(9) << "{";
+  for (auto suite = results.begin(); suite != results.end(); ++suite) {
+    json << (suite == results.begin() ? "" : ", ") << "\"" << suite->first
+         << "\": {";
+    for (auto test = suite->second.begin(); test != suite->second.end();
+         ++test) {
+      json << (test == suite->second.begin() ? "" : ", ") << "\""
+           << test->first << "\": " << test->second;
+    }
+    json << "}";
+  }
+  json << "}\n";
+
+  if (FLAGS_output.empty()) {
+    std::cout << json.str();
+  } else {
+    std::ofstream(FLAGS_output) << json.str();
+  }
+  return 0;
+}
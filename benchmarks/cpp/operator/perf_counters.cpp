@@ -0,0 +1,113 @@
+#include "perf_counters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <cstring>
+
+namespace torch {
+namespace benchmarks {
+
+#ifdef __linux__
+namespace {
+
+int openCounter(uint64_t config, int group_fd) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = config;
+  attr.disabled = group_fd == -1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+  return static_cast<int>(syscall(
+      __NR_perf_event_open, &attr, /*pid=*/0, /*cpu=*/-1, group_fd, 0));
+}
+
+} // namespace
+
+PerfCounters::PerfCounters() {
+  fds_.fill(-1);
+  const uint64_t configs[kNumCounters] = {
+      PERF_COUNT_HW_CPU_CYCLES,
+      PERF_COUNT_HW_INSTRUCTIONS,
+      PERF_COUNT_HW_CACHE_MISSES};
+  for (int i = 0; i < kNumCounters; ++i) {
+    fds_[i] = openCounter(configs[i], fds_[kCycles]);
+    if (fds_[i] < 0) {
+      // All or nothing, so that the group can be read at once
+      for (int j = 0; j < i; ++j) {
+        close(fds_[j]);
+      }
+      fds_.fill(-1);
+      return;
+    }
+  }
+}
+
+PerfCounters::~PerfCounters() {
+  for (int fd : fds_) {
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+}
+
+void PerfCounters::start() {
+  if (!available()) {
+    return;
+  }
+  ioctl(fds_[kCycles], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(fds_[kCycles], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+PerfCounters::Values PerfCounters::stop() {
+  Values values{};
+  if (!available()) {
+    return values;
+  }
+  ioctl(fds_[kCycles], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+  // PERF_FORMAT_GROUP reads the number of counters, then their values
+  uint64_t buffer[1 + kNumCounters];
+  if (read(fds_[kCycles], buffer, sizeof(buffer)) ==
+      static_cast<ssize_t>(sizeof(buffer))) {
+    for (int i = 0; i < kNumCounters; ++i) {
+      values[i] = buffer[1 + i];
+    }
+  }
+  return values;
+}
+#else
+PerfCounters::PerfCounters() {
+  fds_.fill(-1);
+}
+
+PerfCounters::~PerfCounters() = default;
+
+void PerfCounters::start() {}
+
+PerfCounters::Values PerfCounters::stop() {
+  return Values{};
+}
+#endif
+
+const char* PerfCounters::name(Counter counter) {
+  switch (counter) {
+    case kCycles:
+      return "cycles";
+    case kInstructions:
+      return "instructions";
+    case kCacheMisses:
+      return "cache_misses";
+    default:
+      return "unknown";
+  }
+}
+
+} // namespace benchmarks
+} // namespace torch
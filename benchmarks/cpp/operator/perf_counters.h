@@ -0,0 +1,38 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace torch {
+namespace benchmarks {
+
+// Counts the cycles, instructions and cache misses of the calling thread
+// between start() and stop() with the Linux perf_event_open interface.
+// available() is false on other platforms, and when the kernel doesn't allow
+// the process to open the events (see /proc/sys/kernel/perf_event_paranoid),
+// in which case start() and stop() do nothing.
+class PerfCounters {
+ public:
+  enum Counter { kCycles = 0, kInstructions, kCacheMisses, kNumCounters };
+  using Values = std::array<uint64_t, kNumCounters>;
+
+  PerfCounters();
+  ~PerfCounters();
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  bool available() const {
+    return fds_[kCycles] >= 0;
+  }
+  void start();
+  // Values counted since the last start()
+  Values stop();
+
+  static const char* name(Counter counter);
+
+ private:
+  std::array<int, kNumCounters> fds_;
+};
+
+} // namespace benchmarks
+} // namespace torch
@@ -1,5 +1,7 @@
 #include <benchmark/benchmark.h>
 #include <torch/csrc/jit/codegen/fuser/interface.h>
+#include <torch/csrc/jit/passes/cuda_graph_fuser.h>
+#include <torch/csrc/jit/passes/tensorexpr_fuser.h>
 #include <torch/torch.h>
 
 using namespace torch::jit;
@@ -53,5 +55,61 @@ static void UnfusedOverhead(benchmark::State& state) {
   }
 }
 
+// The CPU time of a small nvFuser kernel, which doesn't wait for the kernels
+// to complete. Compare with CudaUnfusedOverhead, which launches one kernel per
+// add.
+static void NvFuserOverhead(benchmark::State& state) {
+  if (!torch::cuda::is_available()) {
+    state.SkipWithError("CUDA is not available");
+    return;
+  }
+  torch::NoGradGuard ng;
+  torch::AutoNonVariableTypeMode nv;
+  const bool old_texpr_fuser = tensorExprFuserEnabled();
+  setTensorExprFuserEnabled(false);
+  const bool old_nvfuser = RegisterCudaFuseGraph::registerPass(true);
+
+  Module m("m");
+  m.define(two_adds);
+
+  auto x = torch::ones({1}, torch::kCUDA);
+  auto y = torch::ones({1}, torch::kCUDA);
+  auto z = torch::ones({1}, torch::kCUDA);
+
+  // Warmup.
+  for (int i = 0; i < 8; i++) {
+    m.run_method("two_adds", x, y, z);
+  }
+  torch::cuda::synchronize();
+
+  for (auto _ : state) {
+    m.run_method("two_adds", x, y, z);
+  }
+  torch::cuda::synchronize();
+
+  RegisterCudaFuseGraph::registerPass(old_nvfuser);
+  setTensorExprFuserEnabled(old_texpr_fuser);
+}
+
+static void CudaUnfusedOverhead(benchmark::State& state) {
+  if (!torch::cuda::is_available()) {
+    state.SkipWithError("CUDA is not available");
+    return;
+  }
+  torch::NoGradGuard ng;
+  torch::AutoNonVariableTypeMode nv;
+
+  auto x = torch::ones({1}, torch::kCUDA);
+  auto y = torch::ones({1}, torch::kCUDA);
+  auto z = torch::ones({1}, torch::kCUDA);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(x + y + z);
+  }
+  torch::cuda::synchronize();
+}
+
 BENCHMARK(FusedOverhead);
 BENCHMARK(UnfusedOverhead);
+BENCHMARK(NvFuserOverhead);
+BENCHMARK(CudaUnfusedOverhead);
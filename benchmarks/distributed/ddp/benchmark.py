@@ -203,8 +203,16 @@ def main():
     parser.add_argument("--master-port", type=str, required=True)
     parser.add_argument("--model", type=str)
     parser.add_argument("--json", type=str, metavar="PATH", help="Write file with benchmark results")
+    parser.add_argument(
+        "--nccl-priority-allreduce",
+        action="store_true",
+        help="Reduce gradient buckets on their own high priority NCCL streams")
     args = parser.parse_args()
 
+    # Read by every ProcessGroupNCCL created by the benchmarks
+    if args.nccl_priority_allreduce:
+        os.environ["TORCH_NCCL_PRIORITY_ALLREDUCE"] = "1"
+
     num_gpus_per_node = torch.cuda.device_count()
     assert num_gpus_per_node == 8, "Expected 8 GPUs per machine"
 
@@ -231,6 +239,7 @@ def main():
         print("* CUDA version: {}".format(torch.version.cuda))
         print("* Distributed backend: {}".format(args.distributed_backend))
         print("* Maximum bucket size: {}MB".format(args.bucket_size))
+        print("* NCCL priority allreduce: {}".format(args.nccl_priority_allreduce))
         print("")
         print("--- nvidia-smi topo -m ---")
         print("")
@@ -276,6 +285,7 @@ def main():
             "cuda_version": torch.version.cuda,
             "distributed_backend": args.distributed_backend,
             "bucket_size": args.bucket_size,
+            "nccl_priority_allreduce": args.nccl_priority_allreduce,
             "benchmark_results": benchmark_results,
         }
         with open(args.json, 'w') as f:
@@ -7,6 +7,14 @@ def add_tensors_loop(x, y):
         z = torch.add(z, x)
     return z
 
+def overloaded_calls_loop(x, y):
+    # add, sum and to have several overloads each, so that every call has to
+    # pick one of them
+    z = x.add(y)
+    for i in range(NUM_LOOP_ITERS):
+        z = z.add(x).add(1).sum(0, keepdim=True).to(torch.float)
+    return z
+
 class SimpleAddModule(torch.nn.Module):
     def __init__(self, add_op):
         super(SimpleAddModule, self).__init__()
@@ -2,12 +2,13 @@ from utils import ms_to_us, benchmark_module, BenchmarkConfig, ModuleConfig
 import argparse
 from C2Module import C2SimpleNet
 
-from SimpleAddModule import SimpleAddModule, add_tensors_loop
+from SimpleAddModule import SimpleAddModule, add_tensors_loop, overloaded_calls_loop
 from pt_wrapper_module import WrapperModule
 
 """ Framework overhead benchmark script.
 Benchmark framework overhead.
-Currently supported ops: add.
+Currently supported ops: add, overloaded (calls of methods with several
+overloads, which measures the cost of parsing their arguments).
 As of now runs only forward pass.
 Supports both graph mode and eager mode. In graph mode the module is traced via JIT tracing.
 Debug option prints the traced graph is graph_mode is enabled.
@@ -23,7 +24,7 @@ buck run @mode/opt <path-to-framework_overhead_benchmark>:framework_overhead_ben
  --add_op --benchmark_c2_net
 """
 
-SUPPORTED_OPS = {"add_op"}
+SUPPORTED_OPS = {"add_op", "overloaded_op"}
 
 def parse_op_args(op):
     op_list = ops.split(",")
@@ -93,6 +94,10 @@ def main():
         else:
             module_config = ModuleConfig(add_tensors_loop, None, num_params, graph_mode)
         benchmark_simple_fn(args, config, module_config, SimpleAddModule, result)
+    elif args.op == "overloaded_op":
+        assert not args.benchmark_c2_net, "overloaded_op has no C2 equivalent"
+        module_config = ModuleConfig(overloaded_calls_loop, None, 2, graph_mode)
+        benchmark_simple_fn(args, config, module_config, SimpleAddModule, result)
     print_results(result)
 
 if __name__ == "__main__":
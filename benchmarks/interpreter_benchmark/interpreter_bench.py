@@ -0,0 +1,89 @@
+import argparse
+import sys
+from typing import List
+
+import torch
+import torch.utils.benchmark as benchmark_utils
+
+
+def make_scalar_loop():
+    def scalar_loop(n: int):
+        total = 0
+        for i in range(n):
+            if i % 3 == 0:
+                total = total + i * 2
+            elif i % 3 == 1:
+                total = total - i
+            else:
+                total = total ^ i
+        return total
+    return torch.jit.script(scalar_loop), (1000,)
+
+
+def make_beam_search():
+    def beam_search(scores: torch.Tensor, beam: int, steps: int):
+        hyps: List[List[int]] = [[] for _ in range(beam)]
+        for _ in range(steps):
+            values, indices = scores.topk(beam)
+            for b in range(beam):
+                token = int(indices[b])
+                if float(values[b]) > 0.0:
+                    hyps[b].append(token)
+                else:
+                    hyps[b].append(-token)
+        return hyps
+    return torch.jit.script(beam_search), (torch.randn(64), 4, 32)
+
+
+BENCHMARKS = {
+    'scalar_loop': make_scalar_loop,
+    'beam_search': make_beam_search,
+}
+
+
+def run_bench(benchmark_names, bench_args):
+    results = []
+    for name in benchmark_names:
+        for superinstructions in [False, True]:
+            # Code is compiled once per executor, so script a fresh function
+            # after changing the setting
+            old_state = torch._C._jit_set_interpreter_superinstructions(superinstructions)
+            fn, inputs = BENCHMARKS[name]()
+            print("Running {} superinstructions ...".format(
+                "with" if superinstructions else "without"), end=" ")
+            sys.stdout.flush()
+            for _ in range(bench_args.warmup):
+                fn(*inputs)
+            timer = benchmark_utils.Timer(
+                stmt="fn(*inputs)",
+                globals={"fn": fn, "inputs": inputs},
+                description=name,
+                label="Interpreter superinstructions",
+                sub_label=f"with{'' if superinstructions else 'out'}_superinstructions")
+            result = timer.blocked_autorange(min_run_time=bench_args.timer_min_run_time)
+            torch._C._jit_set_interpreter_superinstructions(old_state)
+            print("finished")
+            print(result)
+            sys.stdout.flush()
+            results.append(result)
+
+    comparison = benchmark_utils.Compare(results)
+    comparison.trim_significant_figures()
+    comparison.highlight_warnings()
+    comparison.print()
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(
+        description='Benchmark the TorchScript interpreter with and without superinstructions')
+
+    parser.add_argument('--benchmarks', nargs='*', default=list(BENCHMARKS.keys()),
+                        help='What benchmark to run: ' + str(BENCHMARKS.keys()))
+    parser.add_argument('--warmup', default='5', type=int)
+    parser.add_argument('--timer_min_run_time', default=10, type=int)
+
+    args = parser.parse_args()
+
+    for benchmark in args.benchmarks:
+        assert benchmark in BENCHMARKS
+    run_bench(args.benchmarks, args)
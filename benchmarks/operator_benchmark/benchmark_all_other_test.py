@@ -5,7 +5,7 @@ from pt import ( # noqa
     fill_test, gather_test, linear_test, matmul_test, nan_to_num_test, pool_test,  # noqa
     softmax_test, hardsigmoid_test, hardswish_test, layernorm_test,  # noqa
     groupnorm_test, interpolate_test, instancenorm_test, remainder_test, softmax_test,  # noqa
-    split_test, sum_test, tensor_to_test  # noqa
+    sort_test, split_test, sum_test, tensor_to_test, topk_test  # noqa
 )
 
 if __name__ == "__main__":
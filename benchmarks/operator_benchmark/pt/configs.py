@@ -62,6 +62,25 @@ conv_2d_configs_long = op_bench.cross_product_configs(
     tags=["long"]
 )
 
+# Configs for depthwise Conv2d (one input and output channel per group),
+# shared by the fp32 and quantized benchmarks
+conv_2d_depthwise_configs = op_bench.config_list(
+    attr_names=[
+        'C', 'kernel', 'stride', 'dilation', 'N', 'H', 'W',
+    ],
+    attrs=[
+        [128, 3, 1, 1, 4, 56, 56],
+        [128, 3, 2, 1, 4, 56, 56],
+        [128, 3, 1, 2, 4, 56, 56],
+        [256, 5, 1, 1, 4, 28, 28],
+        [256, 7, 2, 1, 4, 28, 28],
+    ],
+    cross_product_configs={
+        'device': ['cpu'],
+    },
+    tags=['short']
+)
+
 # Configs for Conv3d and ConvTranspose3d
 conv_3d_configs_short = op_bench.config_list(
     attr_names=[
@@ -76,6 +95,23 @@ conv_3d_configs_short = op_bench.config_list(
     tags=['short']
 )
 
+# Configs for depthwise Conv3d
+conv_3d_depthwise_configs = op_bench.config_list(
+    attr_names=[
+        'C', 'kernel', 'stride', 'dilation', 'N', 'D', 'H', 'W',
+    ],
+    attrs=[
+        [64, 3, 1, 1, 2, 8, 28, 28],
+        [64, 3, 2, 1, 2, 8, 28, 28],
+        [64, 3, 1, 2, 2, 8, 28, 28],
+        [64, 5, 1, 1, 2, 8, 28, 28],
+    ],
+    cross_product_configs={
+        'device': ['cpu'],
+    },
+    tags=['short']
+)
+
 linear_configs_short = op_bench.config_list(
     attr_names=["N", "IN", "OUT"],
     attrs=[
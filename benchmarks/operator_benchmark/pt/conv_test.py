@@ -76,6 +76,25 @@ op_bench.generate_pt_test(configs.conv_2d_configs_short + configs.conv_2d_config
                           ConvTranspose2dBenchmark)
 
 
+
+class DepthwiseConv2dBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, C, kernel, stride, dilation, N, H, W, device):
+        self.inputs = {
+            "input": torch.rand(N, C, H, W, device=device)
+        }
+        self.conv2d = nn.Conv2d(
+            C, C, kernel, stride=stride, padding=dilation * (kernel // 2),
+            dilation=dilation, groups=C).to(device=device)
+        self.set_module_name('DepthwiseConv2d')
+
+    def forward(self, input):
+        return self.conv2d(input)
+
+
+op_bench.generate_pt_test(configs.conv_2d_depthwise_configs,
+                          DepthwiseConv2dBenchmark)
+
+
 """
 Microbenchmarks for Conv3d and ConvTranspose3d operators.
 """
@@ -109,5 +128,23 @@ op_bench.generate_pt_test(configs.conv_3d_configs_short,
                           ConvTranspose3dBenchmark)
 
 
+class DepthwiseConv3dBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, C, kernel, stride, dilation, N, D, H, W, device):
+        self.inputs = {
+            "input": torch.rand(N, C, D, H, W, device=device)
+        }
+        self.conv3d = nn.Conv3d(
+            C, C, kernel, stride=stride, padding=dilation * (kernel // 2),
+            dilation=dilation, groups=C).to(device=device)
+        self.set_module_name('DepthwiseConv3d')
+
+    def forward(self, input):
+        return self.conv3d(input)
+
+
+op_bench.generate_pt_test(configs.conv_3d_depthwise_configs,
+                          DepthwiseConv3dBenchmark)
+
+
 if __name__ == "__main__":
     op_bench.benchmark_runner.main()
@@ -0,0 +1,50 @@
+import operator_benchmark as op_bench
+import torch
+import torch.nn.functional as F
+
+
+"""Microbenchmarks for ctc_loss operator."""
+
+# Configs for PT ctc_loss operator. T is the input length, N the batch size,
+# C the number of labels including the blank and S the target length. The long
+# configs are in the range of character and word piece ASR models.
+ctc_loss_configs_short = op_bench.cross_product_configs(
+    T=[50],
+    N=[4],
+    C=[32],
+    S=[10],
+    device=['cpu'],
+    tags=['short']
+)
+
+ctc_loss_configs_long = op_bench.cross_product_configs(
+    T=[200, 800],
+    N=[32],
+    C=[32, 1000],
+    S=[50, 150],
+    device=['cpu'],
+    tags=['long']
+)
+
+
+class CTCLossBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, T, N, C, S, device):
+        log_probs = torch.randn(T, N, C, device=device).log_softmax(2)
+        self.inputs = {
+            "log_probs": log_probs.detach().requires_grad_(self.auto_set()),
+            "targets": torch.randint(1, C, (N, S), dtype=torch.long, device=device),
+            "input_lengths": torch.full((N,), T, dtype=torch.long),
+            "target_lengths": torch.full((N,), S, dtype=torch.long)
+        }
+        self.set_module_name("ctc_loss")
+
+    def forward(self, log_probs, targets, input_lengths, target_lengths):
+        return F.ctc_loss(log_probs, targets, input_lengths, target_lengths, reduction='sum')
+
+
+op_bench.generate_pt_test(ctc_loss_configs_short + ctc_loss_configs_long, CTCLossBenchmark)
+op_bench.generate_pt_gradient_test(ctc_loss_configs_short + ctc_loss_configs_long, CTCLossBenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
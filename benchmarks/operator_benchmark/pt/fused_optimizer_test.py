@@ -0,0 +1,60 @@
+import operator_benchmark as op_bench
+import torch
+
+
+"""Microbenchmarks for the fused optimizer steps."""
+
+# Configs for the PT fused optimizer operators. num_params parameters of numel
+# elements each are updated by one call.
+fused_optimizer_configs_short = op_bench.cross_product_configs(
+    num_params=[10],
+    numel=[1000],
+    device=['cpu'],
+    tags=['short']
+)
+
+fused_optimizer_configs_long = op_bench.cross_product_configs(
+    num_params=[10, 100],
+    numel=[1000, 1000000],
+    device=['cpu', 'cuda'],
+    tags=['long']
+)
+
+
+class FusedAdamBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, num_params, numel, device):
+        self.inputs = {
+            "params": [torch.randn(numel, device=device) for _ in range(num_params)],
+            "grads": [torch.randn(numel, device=device) for _ in range(num_params)],
+            "exp_avgs": [torch.zeros(numel, device=device) for _ in range(num_params)],
+            "exp_avg_sqs": [torch.zeros(numel, device=device) for _ in range(num_params)]
+        }
+        self.set_module_name("fused_adam_")
+
+    def forward(self, params, grads, exp_avgs, exp_avg_sqs):
+        torch._fused_adam_(params, grads, exp_avgs, exp_avg_sqs, [], step=1, lr=1e-3, beta1=0.9,
+                           beta2=0.999, weight_decay=1e-2, eps=1e-8, decoupled_weight_decay=True)
+        return params
+
+
+class FusedSgdBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, num_params, numel, device):
+        self.inputs = {
+            "params": [torch.randn(numel, device=device) for _ in range(num_params)],
+            "grads": [torch.randn(numel, device=device) for _ in range(num_params)],
+            "momentum_buffers": [torch.zeros(numel, device=device) for _ in range(num_params)]
+        }
+        self.set_module_name("fused_sgd_")
+
+    def forward(self, params, grads, momentum_buffers):
+        torch._fused_sgd_(params, grads, momentum_buffers, lr=0.1, momentum=0.9, dampening=0.,
+                          weight_decay=1e-4, nesterov=False, is_first_step=False)
+        return params
+
+
+op_bench.generate_pt_test(fused_optimizer_configs_short + fused_optimizer_configs_long, FusedAdamBenchmark)
+op_bench.generate_pt_test(fused_optimizer_configs_short + fused_optimizer_configs_long, FusedSgdBenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
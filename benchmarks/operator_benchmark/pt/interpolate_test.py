@@ -5,9 +5,9 @@ import torch
 
 
 class InterpolateBenchmark(op_bench.TorchBenchmarkBase):
-    def init(self, input_size, output_size, channels_last=False, mode='linear'):
+    def init(self, input_size, output_size, channels_last=False, mode='linear', antialias=False, dtype=torch.float):
 
-        input_image = torch.randint(0, 256, size=input_size, dtype=torch.float, device='cpu',
+        input_image = torch.randint(0, 256, size=input_size, dtype=dtype, device='cpu',
                                     requires_grad=self.auto_set())
         if channels_last:
             if input_image.ndim == 4:
@@ -34,13 +34,14 @@ class InterpolateBenchmark(op_bench.TorchBenchmarkBase):
             "output_size": output_size,
             "mode": mode,
             "align_corners": align_corners,
+            "antialias": antialias,
         }
 
         self.set_module_name("interpolate")
 
-    def forward(self, input_image, output_size, mode, align_corners):
+    def forward(self, input_image, output_size, mode, align_corners, antialias):
         return torch.nn.functional.interpolate(input_image, size=output_size, mode=mode,
-                                               align_corners=align_corners)
+                                               align_corners=align_corners, antialias=antialias)
 
 
 config_short = op_bench.config_list(
@@ -104,7 +105,25 @@ config_5d = op_bench.config_list(
 )
 
 
-for config in (config_short, config_long, config_3d, config_5d):
+config_antialias = op_bench.config_list(
+    # image preprocessing sizes
+    attr_names=["input_size", "output_size"],
+    attrs=[
+        [(1, 3, 906, 438), (224, 224)],
+        [(1, 3, 320, 320), (256, 256)],
+        [(1, 3, 256, 256), (512, 512)],
+    ],
+    cross_product_configs={
+        'channels_last': [True, False],
+        'mode': ["linear", "bicubic"],
+        'antialias': [True],
+        'dtype': [torch.uint8, torch.float],
+    },
+    tags=["short"],
+)
+
+
+for config in (config_short, config_long, config_3d, config_5d, config_antialias):
     op_bench.generate_pt_test(config, InterpolateBenchmark)
 
 
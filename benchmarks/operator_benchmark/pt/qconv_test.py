@@ -67,8 +67,52 @@ class QConv2dBenchmark(op_bench.TorchBenchmarkBase):
         return self.qconv2d(input)
 
 
+class QDepthwiseConvBenchmark(op_bench.TorchBenchmarkBase):
+    def _init(self, qconv_module, C, kernel, stride, dilation, input_shape):
+        self.scale = 1.0 / 255
+        self.zero_point = 0
+        X = torch.randn(*input_shape, dtype=torch.float32)
+        qX = torch.quantize_per_tensor(
+            X, scale=self.scale, zero_point=self.zero_point, dtype=torch.quint8
+        )
+        W = torch.randn(C, 1, *([kernel] * (len(input_shape) - 2)), dtype=torch.float32)
+        # Depthwise weights are usually quantized per channel
+        W_scales = torch.rand(C, dtype=torch.double) / 128 + 1.0 / 255
+        self.qW = torch.quantize_per_channel(
+            W, scales=W_scales, zero_points=torch.zeros(C, dtype=torch.long), axis=0,
+            dtype=torch.qint8)
+
+        self.inputs = {
+            "input": qX
+        }
+
+        self.qconv = qconv_module(
+            C, C, kernel, stride=stride, padding=dilation * (kernel // 2),
+            dilation=dilation, groups=C)
+        self.qconv.set_weight_bias(self.qW, None)
+        self.qconv.scale = torch.tensor(self.scale, dtype=torch.double)
+        self.qconv.zero_point = torch.tensor(self.zero_point, dtype=torch.int)
+
+    def forward(self, input):
+        return self.qconv(input)
+
+
+class QDepthwiseConv2dBenchmark(QDepthwiseConvBenchmark):
+    def init(self, C, kernel, stride, dilation, N, H, W, device):
+        self._init(nnq.Conv2d, C, kernel, stride, dilation, (N, C, H, W))
+        self.set_module_name("QDepthwiseConv2d")
+
+
+class QDepthwiseConv3dBenchmark(QDepthwiseConvBenchmark):
+    def init(self, C, kernel, stride, dilation, N, D, H, W, device):
+        self._init(nnq.Conv3d, C, kernel, stride, dilation, (N, C, D, H, W))
+        self.set_module_name("QDepthwiseConv3d")
+
+
 op_bench.generate_pt_test(configs.remove_cuda(configs.conv_1d_configs_short + configs.conv_1d_configs_long), QConv1dBenchmark)
 op_bench.generate_pt_test(configs.remove_cuda(configs.conv_2d_configs_short + configs.conv_2d_configs_long), QConv2dBenchmark)
+op_bench.generate_pt_test(configs.conv_2d_depthwise_configs, QDepthwiseConv2dBenchmark)
+op_bench.generate_pt_test(configs.conv_3d_depthwise_configs, QDepthwiseConv3dBenchmark)
 
 
 if __name__ == "__main__":
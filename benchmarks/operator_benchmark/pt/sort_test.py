@@ -0,0 +1,60 @@
+import operator_benchmark as op_bench
+import torch
+
+
+"""Microbenchmarks for sort operator."""
+
+# Configs for PT sort operator. Small batches of long rows exercise the
+# parallel radix and merge sorts, large batches the per-row sort.
+sort_configs_short = op_bench.cross_product_configs(
+    B=[1, 256],
+    N=[1024, 1 << 18],
+    dtype=[torch.float, torch.int64],
+    stable=[False, True],
+    device=['cpu'],
+    tags=['short']
+)
+
+sort_configs_long = op_bench.cross_product_configs(
+    B=[1, 4],
+    N=[1 << 22, 1 << 24],
+    dtype=[torch.float, torch.double, torch.int32, torch.int64],
+    stable=[False, True],
+    device=['cpu'],
+    tags=['long']
+)
+
+# On CUDA, rows of up to 2048 elements (1024 for 8-byte types) are sorted by
+# a bitonic sort per block, longer ones by a segmented radix sort. These
+# configs cover both sides of the crossover, with many rows.
+sort_configs_segmented = op_bench.cross_product_configs(
+    B=[100, 10000],
+    N=[1024, 2048, 2049, 4096, 10000],
+    dtype=[torch.float, torch.int64],
+    stable=[False],
+    device=['cuda'],
+    tags=['segmented']
+)
+
+
+class SortBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, B, N, dtype, stable, device):
+        if dtype.is_floating_point:
+            input = torch.randn(B, N, device=device, dtype=dtype)
+        else:
+            input = torch.randint(-N, N, (B, N), device=device, dtype=dtype)
+        self.inputs = {
+            "input": input,
+            "stable": stable
+        }
+        self.set_module_name("sort")
+
+    def forward(self, input, stable: bool):
+        return torch.sort(input, dim=-1, stable=stable)
+
+
+op_bench.generate_pt_test(sort_configs_short + sort_configs_long + sort_configs_segmented, SortBenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
@@ -18,6 +18,20 @@ sum_configs = op_bench.cross_product_configs(
     contiguous=[True, False],
     device=['cpu', 'cuda'],
     tags=['long']
+) + op_bench.config_list(
+    # Tall and skinny inputs reduced along their strided dimension
+    attr_names=['R', 'V'],
+    attrs=[
+        [1000000, 4],
+        [1000000, 64],
+        [100000, 1024],
+    ],
+    cross_product_configs={
+        'dim': [0],
+        'contiguous': [True],
+        'device': ['cuda'],
+    },
+    tags=['tall']
 )
 
 
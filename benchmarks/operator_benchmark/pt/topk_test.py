@@ -0,0 +1,69 @@
+import operator_benchmark as op_bench
+import torch
+
+
+"""Microbenchmarks for topk operator."""
+
+# Configs for PT topk operator. Small batches of long rows are split across
+# threads, large batches run one row per task.
+topk_configs_short = op_bench.cross_product_configs(
+    B=[1, 256],
+    N=[1024, 1 << 18],
+    K=[1, 100],
+    dtype=[torch.float],
+    device=['cpu'],
+    tags=['short']
+)
+
+topk_configs_long = op_bench.cross_product_configs(
+    B=[1, 4],
+    N=[1 << 22, 1 << 24],
+    K=[10, 1000],
+    dtype=[torch.float, torch.int64],
+    device=['cpu'],
+    tags=['long']
+)
+
+# On CUDA, topk selects then sorts the selection, or sorts whole rows with the
+# segmented radix sort when k is above 2048 and at least half of the row.
+# These configs cover both sides of the crossover, with many rows.
+topk_configs_segmented = op_bench.config_list(
+    attr_names=['B', 'N', 'K'],
+    attrs=[
+        [10000, 1000, 100],
+        [10000, 10000, 100],
+        [10000, 10000, 1000],
+        [1000, 10000, 2048],
+        [1000, 10000, 4999],
+        [1000, 10000, 5000],
+        [1000, 10000, 10000],
+    ],
+    cross_product_configs={
+        'dtype': [torch.float],
+        'device': ['cuda'],
+    },
+    tags=['segmented'],
+)
+
+
+class TopkBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, B, N, K, dtype, device):
+        if dtype.is_floating_point:
+            input = torch.randn(B, N, device=device, dtype=dtype)
+        else:
+            input = torch.randint(-N, N, (B, N), device=device, dtype=dtype)
+        self.inputs = {
+            "input": input,
+            "k": K
+        }
+        self.set_module_name("topk")
+
+    def forward(self, input, k: int):
+        return torch.topk(input, k, dim=-1)
+
+
+op_bench.generate_pt_test(topk_configs_short + topk_configs_long + topk_configs_segmented, TopkBenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
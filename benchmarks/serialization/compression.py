@@ -0,0 +1,36 @@
+import io
+
+import torch
+from pyarkbench import Benchmark, Timer, default_args
+
+# Checkpoint-like tensors: weights that compress poorly and sparse masks or
+# buffers that compress well
+state = {
+    'weights': [torch.randn(1024, 1024) for i in range(16)],
+    'masks': [(torch.rand(1024, 1024) > 0.9).float() for i in range(16)],
+}
+num_bytes = sum(t.numel() * t.element_size() for ts in state.values() for t in ts)
+
+class Compression(Benchmark):
+    def benchmark(self):
+        results = {}
+        for use_compression in (False, True):
+            name = 'Compressed' if use_compression else 'Uncompressed'
+            buffer = io.BytesIO()
+            with Timer() as save:
+                torch.save(state, buffer, _use_compression=use_compression)
+
+            buffer.seek(0)
+            with Timer() as load:
+                torch.load(buffer)
+
+            results[name + ' Save MB/s'] = num_bytes / 1e3 / save.ms_duration
+            results[name + ' Load MB/s'] = num_bytes / 1e3 / load.ms_duration
+            results[name + ' Size MB'] = len(buffer.getvalue()) / 1e6
+        return results
+
+if __name__ == '__main__':
+    bench = Compression(*default_args.bench())
+    print("Threads:", torch.get_num_threads())
+    results = bench.run()
+    bench.print_stats(results, stats=['mean', 'median'])
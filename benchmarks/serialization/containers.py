@@ -0,0 +1,45 @@
+import io
+from typing import Dict, List
+
+import torch
+from pyarkbench import Benchmark, Timer, default_args
+
+
+class Containers(torch.nn.Module):
+    ints: List[int]
+    floats: List[float]
+    weights: Dict[str, torch.Tensor]
+    tensors: List[torch.Tensor]
+
+    def __init__(self, size):
+        super(Containers, self).__init__()
+        self.ints = list(range(size))
+        self.floats = [i / 3.0 for i in range(size)]
+        self.weights = {"weight_{}".format(i): torch.ones(2) for i in range(size // 10)}
+        self.tensors = [torch.ones(2) for i in range(size // 10)]
+
+    def forward(self):
+        return len(self.ints) + len(self.floats) + len(self.weights) + len(self.tensors)
+
+
+class Basic(Benchmark):
+    def benchmark(self):
+        m = torch.jit.script(Containers(1000000))
+
+        with Timer() as save:
+            buffer = io.BytesIO()
+            torch.jit.save(m, buffer)
+
+        buffer.seek(0)
+        with Timer() as load:
+            torch.jit.load(buffer)
+
+        return {
+            "Large Containers Save": save.ms_duration,
+            "Large Containers Load": load.ms_duration,
+        }
+
+if __name__ == '__main__':
+    bench = Basic(*default_args.bench())
+    results = bench.run()
+    bench.print_stats(results, stats=['mean', 'median'])
@@ -5,6 +5,7 @@
 # torch.sparse.mm(sparse, sparse)` with different backends (CPU/CUDA)
 # and with other frameworks such as scipy.
 
+import pickle
 import sys
 from scipy import sparse
 import numpy as np
@@ -41,6 +42,14 @@ def scipy_coo_matmul(mat1, mat2):
                                    result.shape)
 
 
+def duplicate_entries(x):
+    # An uncoalesced copy of x in which every entry appears twice.
+    x = x.coalesce()
+    indices = torch.cat([x._indices(), x._indices()], dim=1)
+    values = torch.cat([x._values(), x._values()])
+    return torch.sparse_coo_tensor(indices, values, x.shape)
+
+
 def to_coo_scipy(x):
     indices_1 = x._indices().numpy()
     values_1 = x._values().numpy()
@@ -99,7 +108,7 @@ if __name__ == '__main__':
                         default='random_pruning')
     parser.add_argument('--operation',
                         type=str,
-                        help='matmul or backward',
+                        help='matmul, spmm, coalesce or backward',
                         default='matmul')
     parser.add_argument('--output',
                         type=str,
@@ -127,6 +136,19 @@ if __name__ == '__main__':
             ("matmul", "cuda", "torch.sparse",
              "torch.sparse.mm(tx_cuda, ty_cuda)"),
         ]
+    elif args.operation == 'spmm':
+        tasks = [
+            ("spmm", "cpu", "torch", "torch.mm(dense_x, dense_y)"),
+            ("spmm", "cpu", "torch.sparse",
+             "torch.sparse.mm(coalesced_x, dense_y)"),
+            ("spmm", "cpu", "scipy", "scipy_varx.dot(dense_y_numpy)"),
+        ]
+    elif args.operation == 'coalesce':
+        tasks = [
+            ("coalesce", "cpu", "torch.sparse", "uncoalesced_x.coalesce()"),
+            ("coalesce", "cuda", "torch.sparse",
+             "uncoalesced_cuda_x.coalesce()"),
+        ]
     else:
         tasks = [
             ("backward", "cpu", "torch", "torch_backward(dense_x, dense_y)"),
@@ -149,6 +171,10 @@ if __name__ == '__main__':
                 "scipy_varx": to_coo_scipy(x),
                 "scipy_vary": to_coo_scipy(y),
                 "tx": x,
+                "coalesced_x": x.coalesce(),
+                "uncoalesced_x": duplicate_entries(x),
+                "uncoalesced_cuda_x": duplicate_entries(x).cuda(),
+                "dense_y_numpy": y.to_dense().numpy(),
                 "ty": y,
                 "tx_cuda": x.cuda(),
                 "ty_cuda": y.cuda(),
@@ -9,6 +9,10 @@ echo "!! SPARSE SPMS TIME BENCHMARK!! "
 
 python matmul_dlmc_bench.py --path $DATASET_ROOT_DIR/dlmc/rn50 --dataset random_pruning --operation matmul --output /tmp/matmul_bench.pkl
 python matmul_dlmc_bench.py --path $DATASET_ROOT_DIR/dlmc/rn50 --dataset random_pruning --operation backward --output /tmp/backward_bench.pkl
+python matmul_dlmc_bench.py --path $DATASET_ROOT_DIR/dlmc/rn50 --dataset random_pruning --operation spmm --output /tmp/spmm_bench.pkl
+python matmul_dlmc_bench.py --path $DATASET_ROOT_DIR/dlmc/rn50 --dataset random_pruning --operation coalesce --output /tmp/coalesce_bench.pkl
 
 python plot_results.py -i /tmp/matmul_bench.pkl
 python plot_results.py -i /tmp/backward_bench.pkl
+python plot_results.py -i /tmp/spmm_bench.pkl
+python plot_results.py -i /tmp/coalesce_bench.pkl
@@ -90,6 +90,25 @@ static void BM_deep_wide_static(benchmark::State& state) {
   }
 }
 
+static void BM_deep_wide_static_inter_op(benchmark::State& state) {
+  auto mod = getDeepAndWideSciptModel();
+  torch::jit::StaticModuleOptions opts;
+  opts.enable_inter_op_parallelism = true;
+  torch::jit::StaticModule smod(mod, opts);
+
+  const int batch_size = state.range(0);
+  auto ad_emb_packed = torch::randn({batch_size, 1, embedding_size});
+  auto user_emb = torch::randn({batch_size, 1, embedding_size});
+  auto wide = torch::randn({batch_size, num_features});
+
+  std::vector<at::Tensor> inputs({ad_emb_packed, user_emb, wide});
+
+  smod(inputs);
+  for (auto _ : state) {
+    smod(inputs);
+  }
+}
+
 torch::jit::StaticRuntime getStaticRuntime() {
   static auto smod = std::make_shared<torch::jit::StaticModule>(getDeepAndWideSciptModel());
   return torch::jit::StaticRuntime(*smod);
@@ -174,6 +193,9 @@ BENCHMARK(BM_deep_wide_jit_profiling_executor)
 
 BENCHMARK(BM_deep_wide_static)->RangeMultiplier(8)->Ranges({{1, 20}});
 BENCHMARK(BM_deep_wide_static_threaded)->Threads(8);
+BENCHMARK(BM_deep_wide_static_inter_op)
+    ->RangeMultiplier(8)
+    ->Ranges({{1, 20}});
 
 BENCHMARK(BM_long_static_memory_optimization)
   ->Args({2<<0, 0})
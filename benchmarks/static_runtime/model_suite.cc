@@ -0,0 +1,345 @@
+#include "model_suite.h"
+
+#include <c10/util/StringUtil.h>
+#include <torch/csrc/jit/frontend/resolver.h>
+
+#include <cmath>
+#include <sstream>
+
+namespace {
+
+// Activations are quantized with one scale, with a zero point of 0 after a
+// relu and in the middle of the range otherwise
+const double activation_scale = 0.05;
+const int64_t activation_zero_point = 128;
+
+// Resolves `quantized.<op>` to the operators of the quantized namespace,
+// besides the `torch.<op>` of the native resolver
+struct QuantizedResolver : public torch::jit::Resolver {
+  std::shared_ptr<torch::jit::SugaredValue> resolveValue(
+      const std::string& name,
+      torch::jit::Function& m,
+      const torch::jit::SourceRange& loc) override {
+    if (name == "quantized") {
+      return std::make_shared<torch::jit::BuiltinModule>("quantized");
+    }
+    return torch::jit::nativeResolver()->resolveValue(name, m, loc);
+  }
+};
+
+const std::string quantized_prepack_methods = R"JIT(
+  def _conv2d_prepack(self, weight: Tensor, bias: Tensor, stride: int, padding: int, groups: int):
+      return quantized.conv2d_prepack(weight, bias, [stride, stride], [padding, padding], [1, 1], groups)
+
+  def _linear_prepack(self, weight: Tensor, bias: Tensor):
+      return quantized.linear_prepack(weight, bias)
+)JIT";
+
+// Builds the forward of a module statement by statement. The layers register
+// their weights on the module and return the expression applying them.
+class ForwardBuilder {
+ public:
+  explicit ForwardBuilder(torch::jit::Module& module) : module_(module) {}
+
+  void emit(const std::string& statement) {
+    body_ << "      " << statement << "\n";
+  }
+
+  void define(const std::string& inputs) {
+    module_.define(
+        c10::str("\n  def forward(self, ", inputs, "):\n", body_.str()),
+        std::make_shared<QuantizedResolver>());
+  }
+
+  std::string linear(
+      const std::string& input,
+      int in_features,
+      int out_features) {
+    const auto weight = param(
+        torch::randn({out_features, in_features}) / std::sqrt(in_features));
+    const auto bias = param(torch::zeros({out_features}));
+    return c10::str("torch.linear(", input, ", ", weight, ", ", bias, ")");
+  }
+
+  std::string layerNorm(const std::string& input, int normalized_size) {
+    const auto weight = param(torch::ones({normalized_size}));
+    const auto bias = param(torch::zeros({normalized_size}));
+    return c10::str(
+        "torch.layer_norm(",
+        input,
+        ", [",
+        normalized_size,
+        "], ",
+        weight,
+        ", ",
+        bias,
+        ", 1e-05)");
+  }
+
+  std::string conv2d(
+      const std::string& input,
+      int in_channels,
+      int out_channels,
+      int kernel_size,
+      int stride,
+      int groups = 1) {
+    const auto weight = param(convWeight(
+        in_channels, out_channels, kernel_size, groups));
+    const auto bias = param(torch::zeros({out_channels}));
+    const int padding = kernel_size / 2;
+    return c10::str(
+        "torch.conv2d(",
+        input,
+        ", ",
+        weight,
+        ", ",
+        bias,
+        ", [",
+        stride,
+        ", ",
+        stride,
+        "], [",
+        padding,
+        ", ",
+        padding,
+        "], [1, 1], ",
+        groups,
+        ")");
+  }
+
+  // Needs the methods of quantized_prepack_methods on the module
+  std::string quantizedConv2d(
+      const std::string& input,
+      int in_channels,
+      int out_channels,
+      int kernel_size,
+      int stride,
+      int groups,
+      bool relu) {
+    const auto packed = attr(module_.run_method(
+        "_conv2d_prepack",
+        quantizeWeight(
+            convWeight(in_channels, out_channels, kernel_size, groups)),
+        torch::zeros({out_channels}),
+        stride,
+        kernel_size / 2,
+        groups));
+    return c10::str(
+        relu ? "quantized.conv2d_relu("
+             : "quantized.conv2d(",
+        input,
+        ", ",
+        packed,
+        ", ",
+        activation_scale,
+        ", ",
+        relu ? 0 : activation_zero_point,
+        ")");
+  }
+
+  // Needs the methods of quantized_prepack_methods on the module
+  std::string quantizedLinear(
+      const std::string& input,
+      int in_features,
+      int out_features) {
+    const auto packed = attr(module_.run_method(
+        "_linear_prepack",
+        quantizeWeight(
+            torch::randn({out_features, in_features}) /
+            std::sqrt(in_features)),
+        torch::zeros({out_features})));
+    return c10::str(
+        "quantized.linear(",
+        input,
+        ", ",
+        packed,
+        ", ",
+        activation_scale,
+        ", ",
+        activation_zero_point,
+        ")");
+  }
+
+ private:
+  std::string param(const at::Tensor& value) {
+    const auto name = c10::str("_w", num_weights_++);
+    module_.register_parameter(name, value, /*is_buffer=*/false);
+    return "self." + name;
+  }
+
+  std::string attr(const c10::IValue& value) {
+    const auto name = c10::str("_w", num_weights_++);
+    module_.register_attribute(name, value.type(), value);
+    return "self." + name;
+  }
+
+  static at::Tensor convWeight(
+      int in_channels,
+      int out_channels,
+      int kernel_size,
+      int groups) {
+    const int fan_in = in_channels / groups * kernel_size * kernel_size;
+    return torch::randn(
+               {out_channels, in_channels / groups, kernel_size, kernel_size}) *
+        std::sqrt(2.0 / fan_in);
+  }
+
+  static at::Tensor quantizeWeight(const at::Tensor& weight) {
+    return torch::quantize_per_tensor(
+        weight, weight.abs().max().item<double>() / 127, 0, torch::kQInt8);
+  }
+
+  torch::jit::Module& module_;
+  std::ostringstream body_;
+  int num_weights_ = 0;
+};
+
+} // namespace
+
+torch::jit::Module getTransformerEncoderScriptModel(
+    int num_layers,
+    int d_model,
+    int num_heads,
+    int dim_feedforward) {
+  TORCH_CHECK(
+      d_model % num_heads == 0, "d_model must be divisible by num_heads");
+  const int head_dim = d_model / num_heads;
+  torch::jit::Module module("transformer_encoder");
+  ForwardBuilder builder(module);
+  builder.emit("b = x.size(0)");
+  builder.emit("s = x.size(1)");
+  for (int i = 0; i < num_layers; i++) {
+    for (const char* name : {"q", "k", "v"}) {
+      builder.emit(c10::str(
+          name,
+          " = ",
+          builder.linear("x", d_model, d_model),
+          ".view(b, s, ",
+          num_heads,
+          ", ",
+          head_dim,
+          ").transpose(1, 2)"));
+    }
+    builder.emit(c10::str(
+        "attn = torch.softmax(torch.matmul(q, k.transpose(-2, -1)) * ",
+        1.0 / std::sqrt(head_dim),
+        ", -1)"));
+    builder.emit(c10::str(
+        "a = torch.matmul(attn, v).transpose(1, 2).reshape(b, s, ",
+        d_model,
+        ")"));
+    builder.emit(c10::str(
+        "x = ",
+        builder.layerNorm(
+            "x + " + builder.linear("a", d_model, d_model), d_model)));
+    builder.emit(c10::str(
+        "h = torch.relu(", builder.linear("x", d_model, dim_feedforward), ")"));
+    builder.emit(c10::str(
+        "x = ",
+        builder.layerNorm(
+            "x + " + builder.linear("h", dim_feedforward, d_model), d_model)));
+  }
+  builder.emit("return x");
+  builder.define("x");
+  return module;
+}
+
+torch::jit::Module getResNet50ScriptModel(int num_classes) {
+  torch::jit::Module module("resnet50");
+  ForwardBuilder builder(module);
+  builder.emit(c10::str("x = torch.relu(", builder.conv2d("x", 3, 64, 7, 2), ")"));
+  builder.emit("x = torch.max_pool2d(x, [3, 3], [2, 2], [1, 1])");
+  int in_channels = 64;
+  const int num_blocks[] = {3, 4, 6, 3};
+  for (int stage = 0; stage < 4; stage++) {
+    const int width = 64 << stage;
+    const int out_channels = width * 4;
+    for (int block = 0; block < num_blocks[stage]; block++) {
+      const int stride = stage > 0 && block == 0 ? 2 : 1;
+      builder.emit(c10::str(
+          "out = torch.relu(", builder.conv2d("x", in_channels, width, 1, 1), ")"));
+      builder.emit(c10::str(
+          "out = torch.relu(", builder.conv2d("out", width, width, 3, stride), ")"));
+      builder.emit(
+          "out = " + builder.conv2d("out", width, out_channels, 1, 1));
+      const auto identity = stride != 1 || in_channels != out_channels
+          ? builder.conv2d("x", in_channels, out_channels, 1, stride)
+          : std::string("x");
+      builder.emit("x = torch.relu(out + " + identity + ")");
+      in_channels = out_channels;
+    }
+  }
+  builder.emit("x = torch.flatten(torch.adaptive_avg_pool2d(x, [1, 1]), 1)");
+  builder.emit("return " + builder.linear("x", in_channels, num_classes));
+  builder.define("x");
+  return module;
+}
+
+torch::jit::Module getQuantizedMobileNetV2ScriptModel(int num_classes) {
+  torch::jit::Module module("quantized_mobilenet_v2");
+  module.define(
+      quantized_prepack_methods, std::make_shared<QuantizedResolver>());
+  ForwardBuilder builder(module);
+  builder.emit(c10::str(
+      "x = torch.quantize_per_tensor(x, ",
+      activation_scale,
+      ", ",
+      activation_zero_point,
+      ", ",
+      static_cast<int>(torch::kQUInt8),
+      ")"));
+  // The relu6 of the float model is a relu here, the quantization clamping
+  // the activations to about the same range
+  builder.emit("x = " + builder.quantizedConv2d("x", 3, 32, 3, 2, 1, true));
+  int in_channels = 32;
+  // The expansion factor, output channels, number of blocks and stride of
+  // each stage of inverted residual blocks
+  const int stages[][4] = {
+      {1, 16, 1, 1},
+      {6, 24, 2, 2},
+      {6, 32, 3, 2},
+      {6, 64, 4, 2},
+      {6, 96, 3, 1},
+      {6, 160, 3, 2},
+      {6, 320, 1, 1}};
+  for (const auto& stage : stages) {
+    const int out_channels = stage[1];
+    for (int block = 0; block < stage[2]; block++) {
+      const int stride = block == 0 ? stage[3] : 1;
+      const int hidden = in_channels * stage[0];
+      std::string out = "x";
+      if (hidden != in_channels) {
+        builder.emit(
+            "out = " +
+            builder.quantizedConv2d(out, in_channels, hidden, 1, 1, 1, true));
+        out = "out";
+      }
+      builder.emit(
+          "out = " +
+          builder.quantizedConv2d(out, hidden, hidden, 3, stride, hidden, true));
+      builder.emit(
+          "out = " +
+          builder.quantizedConv2d(
+              "out", hidden, out_channels, 1, 1, 1, false));
+      if (stride == 1 && in_channels == out_channels) {
+        builder.emit(c10::str(
+            "x = quantized.add(x, out, ",
+            activation_scale,
+            ", ",
+            activation_zero_point,
+            ")"));
+      } else {
+        builder.emit("x = out");
+      }
+      in_channels = out_channels;
+    }
+  }
+  builder.emit(
+      "x = " + builder.quantizedConv2d("x", in_channels, 1280, 1, 1, 1, true));
+  builder.emit("x = torch.flatten(torch.adaptive_avg_pool2d(x, [1, 1]), 1)");
+  builder.emit(
+      "return torch.dequantize(" +
+      builder.quantizedLinear("x", 1280, num_classes) + ")");
+  builder.define("x");
+  return module;
+}
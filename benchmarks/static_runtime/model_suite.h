@@ -0,0 +1,24 @@
+#pragma once
+
+#include <torch/script.h>
+
+// Scripted equivalents of representative inference models, with random
+// weights, for comparing the runtimes on end-to-end workloads. The batch norms
+// of the convolutional models are folded into the biases of their
+// convolutions, as they are after freezing for inference.
+
+// A stack of post-norm encoder layers, as torch.nn.TransformerEncoder. Takes
+// an input of shape [batch, sequence, d_model].
+torch::jit::Module getTransformerEncoderScriptModel(
+    int num_layers = 6,
+    int d_model = 512,
+    int num_heads = 8,
+    int dim_feedforward = 2048);
+
+// ResNet-50. Takes an input of shape [batch, 3, 224, 224].
+torch::jit::Module getResNet50ScriptModel(int num_classes = 1000);
+
+// MobileNetV2 with quantized convolutions and classifier. Takes a float input
+// of shape [batch, 3, 224, 224], which it quantizes. Throws if no quantized
+// engine is available in this build.
+torch::jit::Module getQuantizedMobileNetV2ScriptModel(int num_classes = 1000);
@@ -0,0 +1,261 @@
+#include <benchmark/benchmark.h>
+#include <ATen/Parallel.h>
+#include <c10/core/Allocator.h>
+#include <c10/util/ThreadLocalDebugInfo.h>
+#include <torch/csrc/jit/runtime/graph_executor.h>
+#include <torch/csrc/jit/runtime/static/impl.h>
+#include "deep_wide_pt.h"
+#include "model_suite.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+// End-to-end latency, throughput and peak memory of representative models
+// under each runtime. The benchmarks take the batch size and the number of
+// intra-op threads as arguments, e.g.
+//   static_runtime_bench --benchmark_filter=BM_model_suite/resnet50
+// Each reports the p50/p90/p99 latencies of the iterations, the throughput in
+// samples per second as items_per_second, and the peak CPU memory allocated
+// by one inference.
+
+using namespace torch;
+
+namespace {
+
+enum class Model {
+  kDeepAndWide,
+  kTransformerEncoder,
+  kResNet50,
+  kQuantizedMobileNetV2,
+};
+
+enum class Runtime {
+  // The graph is run op by op, without the optimizations of the executors
+  kEager,
+  // The legacy graph executor
+  kGraphExecutor,
+  kProfilingExecutor,
+  kStatic,
+};
+
+// Selects the executor that runs the modules created in its scope
+class ExecutorGuard {
+ public:
+  explicit ExecutorGuard(Runtime runtime)
+      : old_executor_mode_(jit::getExecutorMode()),
+        old_profiling_mode_(jit::getProfilingMode()),
+        optimizer_guard_(runtime != Runtime::kEager) {
+    jit::getExecutorMode() = runtime == Runtime::kProfilingExecutor;
+    jit::getProfilingMode() = runtime == Runtime::kProfilingExecutor;
+  }
+
+  ~ExecutorGuard() {
+    jit::getExecutorMode() = old_executor_mode_;
+    jit::getProfilingMode() = old_profiling_mode_;
+  }
+
+ private:
+  bool old_executor_mode_;
+  bool old_profiling_mode_;
+  jit::GraphOptimizerEnabledGuard optimizer_guard_;
+};
+
+// Tracks the peak of the CPU memory allocated while it is the memory reporter
+// of the thread. Memory allocated before is not counted when it is freed, and
+// neither are the allocations of the intra-op threads, which don't inherit
+// the reporter.
+class PeakMemoryReporter : public c10::MemoryReportingInfoBase {
+ public:
+  void reportMemoryUsage(void* ptr, int64_t alloc_size, c10::Device device)
+      override {
+    if (device.type() != c10::DeviceType::CPU) {
+      return;
+    }
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (alloc_size > 0) {
+      sizes_[ptr] = alloc_size;
+      current_ += alloc_size;
+      peak_ = std::max(peak_, current_);
+    } else {
+      auto it = sizes_.find(ptr);
+      if (it != sizes_.end()) {
+        current_ -= it->second;
+        sizes_.erase(it);
+      }
+    }
+  }
+
+  bool memoryProfilingEnabled() const override {
+    return true;
+  }
+
+  int64_t peak() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return peak_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<void*, int64_t> sizes_;
+  int64_t current_ = 0;
+  int64_t peak_ = 0;
+};
+
+const int embedding_size = 32;
+const int num_features = 50;
+const int sequence_length = 128;
+const int d_model = 512;
+
+jit::Module getModel(Model model) {
+  switch (model) {
+    case Model::kDeepAndWide:
+      return getDeepAndWideSciptModel(num_features);
+    case Model::kTransformerEncoder:
+      return getTransformerEncoderScriptModel(6, d_model);
+    case Model::kResNet50:
+      return getResNet50ScriptModel();
+    case Model::kQuantizedMobileNetV2:
+      return getQuantizedMobileNetV2ScriptModel();
+  }
+  TORCH_INTERNAL_ASSERT(false, "Unknown model");
+}
+
+std::vector<IValue> getInputs(Model model, int batch_size) {
+  switch (model) {
+    case Model::kDeepAndWide:
+      return {
+          torch::randn({batch_size, 1, embedding_size}),
+          torch::randn({batch_size, 1, embedding_size}),
+          torch::randn({batch_size, num_features})};
+    case Model::kTransformerEncoder:
+      return {torch::randn({batch_size, sequence_length, d_model})};
+    case Model::kResNet50:
+    case Model::kQuantizedMobileNetV2:
+      return {torch::randn({batch_size, 3, 224, 224})};
+  }
+  TORCH_INTERNAL_ASSERT(false, "Unknown model");
+}
+
+double percentile(const std::vector<double>& sorted, int p) {
+  const size_t rank = (sorted.size() * p + 99) / 100;
+  return sorted[std::max<size_t>(rank, 1) - 1];
+}
+
+} // namespace
+
+static void BM_model_suite(
+    benchmark::State& state,
+    Model model,
+    Runtime runtime) {
+  const int batch_size = state.range(0);
+  at::set_num_threads(state.range(1));
+  torch::NoGradGuard no_grad;
+  ExecutorGuard executor_guard(runtime);
+
+  std::function<void()> run;
+  try {
+    auto mod = getModel(model);
+    auto inputs = getInputs(model, batch_size);
+    if (runtime == Runtime::kStatic) {
+      auto smod = std::make_shared<jit::StaticModule>(mod);
+      run = [smod, inputs]() { (*smod)(inputs, {}); };
+    } else {
+      run = [mod, inputs]() mutable { mod.forward(inputs); };
+    }
+    // Enough runs for the profiling executor to profile the graph and to
+    // optimize it
+    for (size_t i = 0; i < jit::getNumProfiledRuns() + 2; i++) {
+      run();
+    }
+  } catch (const c10::Error& e) {
+    state.SkipWithError(e.what_without_backtrace());
+    return;
+  }
+
+  std::vector<double> latencies;
+  for (auto _ : state) {
+    const auto start = std::chrono::steady_clock::now();
+    run();
+    latencies.push_back(std::chrono::duration<double, std::micro>(
+                            std::chrono::steady_clock::now() - start)
+                            .count());
+  }
+
+  // Measured on a run of its own, as reporting the allocations slows them
+  auto reporter = std::make_shared<PeakMemoryReporter>();
+  {
+    c10::DebugInfoGuard guard(c10::DebugInfoKind::PROFILER_STATE, reporter);
+    run();
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+  if (!latencies.empty()) {
+    state.counters["p50_us"] = percentile(latencies, 50);
+    state.counters["p90_us"] = percentile(latencies, 90);
+    state.counters["p99_us"] = percentile(latencies, 99);
+  }
+  state.counters["peak_mem_bytes"] = reporter->peak();
+  // set_num_threads can't change the number of threads of some backends once
+  // they started
+  state.counters["num_threads"] = at::get_num_threads();
+  state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+static void SmallModelArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"batch", "threads"});
+  for (int threads : {1, 4}) {
+    for (int batch_size : {1, 8, 32}) {
+      b->Args({batch_size, threads});
+    }
+  }
+  b->UseRealTime();
+}
+
+static void ConvNetArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"batch", "threads"});
+  for (int threads : {1, 4}) {
+    for (int batch_size : {1, 8}) {
+      b->Args({batch_size, threads});
+    }
+  }
+  b->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_CAPTURE(BM_model_suite, deep_wide_eager, Model::kDeepAndWide, Runtime::kEager)
+    ->Apply(SmallModelArgs);
+BENCHMARK_CAPTURE(BM_model_suite, deep_wide_graph_executor, Model::kDeepAndWide, Runtime::kGraphExecutor)
+    ->Apply(SmallModelArgs);
+BENCHMARK_CAPTURE(BM_model_suite, deep_wide_profiling_executor, Model::kDeepAndWide, Runtime::kProfilingExecutor)
+    ->Apply(SmallModelArgs);
+BENCHMARK_CAPTURE(BM_model_suite, deep_wide_static, Model::kDeepAndWide, Runtime::kStatic)
+    ->Apply(SmallModelArgs);
+
+BENCHMARK_CAPTURE(BM_model_suite, transformer_encoder_eager, Model::kTransformerEncoder, Runtime::kEager)
+    ->Apply(SmallModelArgs);
+BENCHMARK_CAPTURE(BM_model_suite, transformer_encoder_graph_executor, Model::kTransformerEncoder, Runtime::kGraphExecutor)
+    ->Apply(SmallModelArgs);
+BENCHMARK_CAPTURE(BM_model_suite, transformer_encoder_profiling_executor, Model::kTransformerEncoder, Runtime::kProfilingExecutor)
+    ->Apply(SmallModelArgs);
+BENCHMARK_CAPTURE(BM_model_suite, transformer_encoder_static, Model::kTransformerEncoder, Runtime::kStatic)
+    ->Apply(SmallModelArgs);
+
+BENCHMARK_CAPTURE(BM_model_suite, resnet50_eager, Model::kResNet50, Runtime::kEager)
+    ->Apply(ConvNetArgs);
+BENCHMARK_CAPTURE(BM_model_suite, resnet50_graph_executor, Model::kResNet50, Runtime::kGraphExecutor)
+    ->Apply(ConvNetArgs);
+BENCHMARK_CAPTURE(BM_model_suite, resnet50_profiling_executor, Model::kResNet50, Runtime::kProfilingExecutor)
+    ->Apply(ConvNetArgs);
+BENCHMARK_CAPTURE(BM_model_suite, resnet50_static, Model::kResNet50, Runtime::kStatic)
+    ->Apply(ConvNetArgs);
+
+BENCHMARK_CAPTURE(BM_model_suite, quantized_mobilenet_v2_eager, Model::kQuantizedMobileNetV2, Runtime::kEager)
+    ->Apply(ConvNetArgs);
+BENCHMARK_CAPTURE(BM_model_suite, quantized_mobilenet_v2_graph_executor, Model::kQuantizedMobileNetV2, Runtime::kGraphExecutor)
+    ->Apply(ConvNetArgs);
+BENCHMARK_CAPTURE(BM_model_suite, quantized_mobilenet_v2_profiling_executor, Model::kQuantizedMobileNetV2, Runtime::kProfilingExecutor)
+    ->Apply(ConvNetArgs);
+BENCHMARK_CAPTURE(BM_model_suite, quantized_mobilenet_v2_static, Model::kQuantizedMobileNetV2, Runtime::kStatic)
+    ->Apply(ConvNetArgs);
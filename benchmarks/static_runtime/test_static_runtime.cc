@@ -1,9 +1,14 @@
 #include <gtest/gtest.h>
+#include <torch/csrc/jit/runtime/static/batching.h>
 #include <torch/csrc/jit/runtime/static/fusion.h>
 #include <torch/csrc/jit/runtime/static/impl.h>
+#include <torch/csrc/jit/runtime/static/pool.h>
 #include "deep_wide_pt.h"
+#include "model_suite.h"
 #include "test_scripts.h"
 
+#include <thread>
+
 using namespace caffe2;
 using namespace torch;
 using namespace torch::jit;
@@ -252,6 +257,27 @@ TEST(StaticRuntime, DeepWide) {
   }
 }
 
+TEST(StaticRuntime, ModelSuite) {
+  std::vector<std::pair<torch::jit::Module, at::Tensor>> models;
+  models.emplace_back(
+      getTransformerEncoderScriptModel(2, 64, 4, 128), torch::randn({2, 16, 64}));
+  models.emplace_back(getResNet50ScriptModel(10), torch::randn({1, 3, 64, 64}));
+
+  for (auto& model : models) {
+    torch::jit::StaticModule smod(model.first);
+    std::vector<at::IValue> inputs({model.second});
+    for (int i = 0; i < 2; ++i) {
+      // run jit graph executor
+      at::Tensor output_1 = getTensor(model.first.forward(inputs));
+
+      // run static runtime
+      at::Tensor output_2 = getTensor(smod(inputs, {}));
+      smod.runtime().check_for_memory_leak();
+      EXPECT_TRUE(torch::allclose(output_1, output_2, 1e-4, 1e-4));
+    }
+  }
+}
+
 TEST(StaticRuntime, KWargsAPI_1) {
   const int embedding_size = 32;
   const int num_features = 50;
@@ -369,6 +395,81 @@ TEST(StaticRuntime, CleanUpMemory) {
   }
 }
 
+TEST(StaticRuntime, LifetimeMemoryPlanning) {
+  const int embedding_size = 32;
+  const int num_features = 50;
+  torch::jit::Module mod = getDeepAndWideSciptModel();
+
+  torch::jit::StaticModuleOptions opts;
+  opts.optimize_memory_by_lifetime = true;
+  torch::jit::StaticModule smod(mod, opts);
+
+  for (int batch_size : {1, 8, 32}) {
+    for (int i = 0; i < 2; ++i) {
+      auto ad_emb_packed = torch::randn({batch_size, 1, embedding_size});
+      auto user_emb = torch::randn({batch_size, 1, embedding_size});
+      auto wide = torch::randn({batch_size, num_features});
+
+      // run jit graph executor
+      std::vector<at::IValue> inputs({ad_emb_packed, user_emb, wide});
+      auto output_1 = getTensor(mod.forward(inputs));
+
+      // run static runtime
+      std::vector<at::Tensor> input_tensors({ad_emb_packed, user_emb, wide});
+      at::Tensor output_2 = smod(input_tensors)[0];
+      smod.runtime().check_for_memory_leak();
+      EXPECT_TRUE(torch::allclose(output_1, output_2, 1e-6));
+    }
+  }
+
+  // the long model has a chain of intermediates that can't all be alive at
+  // the same time
+  torch::jit::Module long_mod = getLongScriptModel();
+  torch::jit::StaticModule long_smod(long_mod, opts);
+  auto a = torch::randn({8, 8});
+  auto b = torch::randn({8, 8});
+  auto c = torch::randn({8, 8});
+  std::vector<at::IValue> long_inputs({a, b, c});
+  auto expect = getTensor(long_mod.forward(long_inputs));
+  std::vector<at::Tensor> long_input_tensors({a, b, c});
+  for (int i = 0; i < 3; ++i) {
+    auto actual = long_smod(long_input_tensors)[0];
+    long_smod.runtime().check_for_memory_leak();
+    EXPECT_TRUE(torch::allclose(expect, actual, 1e-6));
+  }
+}
+
+TEST(StaticRuntime, InterOpParallelism) {
+  const int embedding_size = 32;
+  const int num_features = 50;
+  torch::jit::Module mod = getDeepAndWideSciptModel();
+
+  for (auto cleanup_memory : {true, false}) {
+    torch::jit::StaticModuleOptions opts;
+    opts.cleanup_activations = cleanup_memory;
+    opts.enable_inter_op_parallelism = true;
+    torch::jit::StaticModule smod(mod, opts);
+
+    for (int batch_size : {1, 8, 32}) {
+      for (int i = 0; i < 2; ++i) {
+        auto ad_emb_packed = torch::randn({batch_size, 1, embedding_size});
+        auto user_emb = torch::randn({batch_size, 1, embedding_size});
+        auto wide = torch::randn({batch_size, num_features});
+
+        // run jit graph executor
+        std::vector<at::IValue> inputs({ad_emb_packed, user_emb, wide});
+        auto output_1 = getTensor(mod.forward(inputs));
+
+        // run static runtime
+        std::vector<at::Tensor> input_tensors({ad_emb_packed, user_emb, wide});
+        at::Tensor output_2 = smod(input_tensors)[0];
+        smod.runtime().check_for_memory_leak();
+        EXPECT_TRUE(torch::allclose(output_1, output_2, 1e-6));
+      }
+    }
+  }
+}
+
 TEST(StaticRuntime, FusionPass) {
   const int embedding_size = 32;
   const int num_features = 50;
@@ -398,3 +499,125 @@ TEST(StaticRuntime, FusionPass) {
     }
   }
 }
+
+TEST(StaticRuntime, TensorExprFusion) {
+  const auto src = R"JIT(
+    def forward(self, a, b):
+        c = (a + b) * b
+        d = torch.sigmoid(c).clamp(0.25, 0.75)
+        return d.clone()
+  )JIT";
+  script::Module module("module");
+  module.define(src);
+
+  torch::jit::StaticModuleOptions opts;
+  opts.enable_tensorexpr_fusion = true;
+  torch::jit::StaticModule smod(module, opts);
+  bool hit = false;
+  for (const auto& n : smod.graph().nodes()) {
+    if (n->kind() == torch::jit::prim::TensorExprGroup) {
+      hit = true;
+    }
+  }
+  EXPECT_TRUE(hit);
+
+  for (int batch_size : {4, 4, 16, 1}) {
+    auto a = torch::randn({batch_size, 8});
+    auto b = torch::randn({batch_size, 8});
+    std::vector<at::IValue> inputs({a, b});
+    auto expect = module.forward(inputs).toTensor();
+
+    std::vector<at::Tensor> input_tensors({a, b});
+    auto actual = smod(input_tensors)[0];
+    smod.runtime().check_for_memory_leak();
+    EXPECT_TRUE(torch::allclose(expect, actual, 1e-6));
+  }
+}
+
+TEST(StaticRuntime, BatchingRuntime) {
+  const auto src = R"JIT(
+    def forward(self, a, b):
+        return (torch.relu(a * b) + a,)
+  )JIT";
+  script::Module module("module");
+  module.define(src);
+
+  torch::jit::StaticBatchingOptions opts;
+  opts.max_batch_size = 8;
+  opts.max_latency = std::chrono::milliseconds(100);
+  torch::jit::StaticBatchingRuntime runtime(
+      std::make_shared<torch::jit::StaticModule>(module), opts);
+
+  constexpr int kNumThreads = 8;
+  std::vector<std::vector<at::Tensor>> inputs(kNumThreads);
+  std::vector<std::vector<at::Tensor>> outputs(kNumThreads);
+  for (int i = 0; i < kNumThreads; ++i) {
+    inputs[i] = {torch::randn({i % 3 + 1, 4}), torch::randn({i % 3 + 1, 4})};
+  }
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&, i]() { outputs[i] = runtime(inputs[i]); });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  EXPECT_LT(runtime.num_batches(), kNumThreads);
+  for (int i = 0; i < kNumThreads; ++i) {
+    auto expect = getTensor(module.forward({inputs[i][0], inputs[i][1]}));
+    ASSERT_EQ(outputs[i].size(), 1);
+    EXPECT_TRUE(torch::allclose(expect, outputs[i][0], 1e-6));
+  }
+}
+
+TEST(StaticRuntime, RuntimePool) {
+  const int embedding_size = 32;
+  const int num_features = 50;
+  torch::jit::Module mod = getDeepAndWideSciptModel();
+  torch::jit::StaticRuntimePool pool(
+      std::make_shared<torch::jit::StaticModule>(mod));
+
+  constexpr int kNumThreads = 8;
+  constexpr int kNumRuns = 4;
+  std::vector<std::thread> threads;
+  std::vector<int> matches(kNumThreads * kNumRuns, 0);
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < kNumRuns; ++i) {
+        const int batch_size = 1 << (i % 3);
+        auto ad_emb_packed = torch::randn({batch_size, 1, embedding_size});
+        auto user_emb = torch::randn({batch_size, 1, embedding_size});
+        auto wide = torch::randn({batch_size, num_features});
+        auto expect = getTensor(mod.forward({ad_emb_packed, user_emb, wide}));
+        std::vector<at::Tensor> input_tensors({ad_emb_packed, user_emb, wide});
+        auto runtime = pool.acquire();
+        auto actual = (*runtime)(input_tensors)[0];
+        runtime->check_for_memory_leak();
+        matches[t * kNumRuns + i] = torch::allclose(expect, actual, 1e-6);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  for (int match : matches) {
+    EXPECT_TRUE(match);
+  }
+
+  // every runtime is back, and the arena holds no more buffers than runtimes
+  EXPECT_LE(pool.num_runtimes(), kNumThreads);
+  EXPECT_EQ(pool.num_idle_runtimes(), pool.num_runtimes());
+  EXPECT_GT(pool.idle_arena_bytes(), 0);
+
+  // idle memory goes away, and the pool keeps working after that
+  pool.shrink();
+  EXPECT_EQ(pool.num_runtimes(), 0);
+  EXPECT_EQ(pool.idle_arena_bytes(), 0);
+  auto ad_emb_packed = torch::randn({2, 1, embedding_size});
+  auto user_emb = torch::randn({2, 1, embedding_size});
+  auto wide = torch::randn({2, num_features});
+  auto expect = getTensor(mod.forward({ad_emb_packed, user_emb, wide}));
+  std::vector<at::Tensor> input_tensors({ad_emb_packed, user_emb, wide});
+  EXPECT_TRUE(torch::allclose(expect, pool(input_tensors)[0], 1e-6));
+  EXPECT_EQ(pool.num_runtimes(), 1);
+}
@@ -0,0 +1,171 @@
+#include "benchmark/benchmark.h"
+
+#include <ATen/core/dispatch/Dispatcher.h>
+#include <torch/library.h>
+#include <torch/torch.h>
+
+// Tracks the overhead of calling operators through the dispatcher. The
+// dispatcher_benchmark ops have trivial kernels, so their numbers are
+// dominated by computing the DispatchKeySet, looking up the kernel and
+// calling it; BM_DirectCall is the cost of the kernel alone. The aten ops
+// run on one element tensors, the way small tensor eager mode code does.
+
+#if defined(__GNUC__)
+#define NOINLINE __attribute__((noinline))
+#else
+#define NOINLINE
+#endif
+
+namespace {
+
+NOINLINE at::Tensor noop(const at::Tensor& self) {
+  return self;
+}
+
+at::Tensor noop_autograd(const at::Tensor& self);
+
+// Leaves its argument on the stack as the result
+NOINLINE void noop_boxed(const c10::OperatorHandle&, torch::jit::Stack*) {}
+
+TORCH_LIBRARY(dispatcher_benchmark, m) {
+  m.def("noop(Tensor self) -> Tensor");
+  m.def("noop_with_autograd(Tensor self) -> Tensor");
+  m.def("noop_catch_all(Tensor self) -> Tensor", noop);
+  m.def("noop_boxed(Tensor self) -> Tensor");
+}
+
+TORCH_LIBRARY_IMPL(dispatcher_benchmark, CPU, m) {
+  m.impl("noop", noop);
+  m.impl("noop_with_autograd", noop);
+  m.impl(
+      "noop_boxed", torch::CppFunction::makeFromBoxedFunction<&noop_boxed>());
+}
+
+TORCH_LIBRARY_IMPL(dispatcher_benchmark, Autograd, m) {
+  m.impl("noop_with_autograd", noop_autograd);
+}
+
+c10::TypedOperatorHandle<at::Tensor(const at::Tensor&)> getOp(
+    const char* name) {
+  return c10::Dispatcher::singleton()
+      .findSchemaOrThrow(name, "")
+      .typed<at::Tensor(const at::Tensor&)>();
+}
+
+at::Tensor noop_autograd(const at::Tensor& self) {
+  static auto op = getOp("dispatcher_benchmark::noop_with_autograd");
+  at::AutoNonVariableTypeMode guard;
+  return op.call(self);
+}
+
+// Key sets the dispatcher_benchmark ops are called with, selected by the
+// benchmark argument
+enum class KeySet : int64_t {
+  // plain CPU tensor, the Autograd fallthrough is masked out
+  CPU = 0,
+  // CPU tensor that requires grad
+  CPURequiresGrad = 1,
+  // Autograd excluded through TLS, as in inference code
+  NonVariableTypeMode = 2,
+};
+
+const char* keySetName(KeySet key_set) {
+  switch (key_set) {
+    case KeySet::CPU:
+      return "CPU";
+    case KeySet::CPURequiresGrad:
+      return "CPU requires_grad";
+    case KeySet::NonVariableTypeMode:
+      return "CPU NonVariableTypeMode";
+  }
+  return "";
+}
+
+template <class Func>
+void runWithKeySet(benchmark::State& state, Func func) {
+  auto key_set = static_cast<KeySet>(state.range(0));
+  state.SetLabel(keySetName(key_set));
+  auto x = torch::ones({1});
+  if (key_set == KeySet::CPURequiresGrad) {
+    x.requires_grad_();
+  }
+  c10::optional<at::AutoNonVariableTypeMode> guard;
+  if (key_set == KeySet::NonVariableTypeMode) {
+    guard.emplace();
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(func(x));
+  }
+}
+
+void KeySetArgs(benchmark::internal::Benchmark* b) {
+  for (auto key_set :
+       {KeySet::CPU, KeySet::CPURequiresGrad, KeySet::NonVariableTypeMode}) {
+    b->Arg(static_cast<int64_t>(key_set));
+  }
+}
+
+} // namespace
+
+static void BM_DirectCall(benchmark::State& state) {
+  runWithKeySet(state, [](const at::Tensor& x) { return noop(x); });
+}
+BENCHMARK(BM_DirectCall)->Arg(static_cast<int64_t>(KeySet::CPU));
+
+static void BM_UnboxedCall(benchmark::State& state) {
+  auto op = getOp("dispatcher_benchmark::noop");
+  runWithKeySet(state, [&](const at::Tensor& x) { return op.call(x); });
+}
+BENCHMARK(BM_UnboxedCall)->Apply(KeySetArgs);
+
+static void BM_UnboxedCallCatchAll(benchmark::State& state) {
+  auto op = getOp("dispatcher_benchmark::noop_catch_all");
+  runWithKeySet(state, [&](const at::Tensor& x) { return op.call(x); });
+}
+BENCHMARK(BM_UnboxedCallCatchAll)->Apply(KeySetArgs);
+
+// Goes through the Autograd kernel and dispatches a second time to the CPU
+// kernel unless autograd is already excluded
+static void BM_UnboxedCallWithAutograd(benchmark::State& state) {
+  auto op = getOp("dispatcher_benchmark::noop_with_autograd");
+  runWithKeySet(state, [&](const at::Tensor& x) { return op.call(x); });
+}
+BENCHMARK(BM_UnboxedCallWithAutograd)->Apply(KeySetArgs);
+
+static void BM_BoxedCall(benchmark::State& state) {
+  auto op = getOp("dispatcher_benchmark::noop");
+  torch::jit::Stack stack;
+  runWithKeySet(state, [&](const at::Tensor& x) {
+    stack.emplace_back(x);
+    op.callBoxed(&stack);
+    auto result = std::move(stack.back());
+    stack.clear();
+    return result;
+  });
+}
+BENCHMARK(BM_BoxedCall)->Apply(KeySetArgs);
+
+// Boxes the arguments onto a stack for a kernel that only has a boxed version
+static void BM_UnboxedCallBoxedKernel(benchmark::State& state) {
+  auto op = getOp("dispatcher_benchmark::noop_boxed");
+  runWithKeySet(state, [&](const at::Tensor& x) { return op.call(x); });
+}
+BENCHMARK(BM_UnboxedCallBoxedKernel)->Apply(KeySetArgs);
+
+static void BM_AtenAdd(benchmark::State& state) {
+  runWithKeySet(state, [](const at::Tensor& x) { return at::add(x, x); });
+}
+BENCHMARK(BM_AtenAdd)->Apply(KeySetArgs);
+
+static void BM_AtenView(benchmark::State& state) {
+  runWithKeySet(state, [](const at::Tensor& x) { return x.view({-1}); });
+}
+BENCHMARK(BM_AtenView)->Apply(KeySetArgs);
+
+static void BM_AtenEmpty(benchmark::State& state) {
+  runWithKeySet(
+      state, [](const at::Tensor& x) { return at::empty({1}, x.options()); });
+}
+BENCHMARK(BM_AtenEmpty)->Apply(KeySetArgs);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,231 @@
+#include <ATen/ATen.h>
+#include <ATen/record_function.h>
+#include <torch/csrc/autograd/grad_mode.h>
+#include <torch/csrc/jit/ir/irparser.h>
+#include <torch/csrc/jit/runtime/interpreter.h>
+#include <torch/csrc/jit/runtime/static/impl.h>
+
+#include "c10/util/Flags.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Measures the fixed costs of the framework, each on its own, so that a
+// regression in one of them shows up as a change of one line of the output:
+//
+//   empty tensor creation
+//   dispatcher call of a trivial op, per dispatch key set
+//   autograd graph construction, per op
+//   TorchScript interpreter, per instruction
+//   Static Runtime, per node
+//   RecordFunction with observers off and on
+//
+// Each line is the median over --repeat runs, in nanoseconds, in a fixed
+// order and format. --json also writes them as {"name": ns} for tools that
+// track them across releases.
+
+C10_DEFINE_int(iter, 100000, "Number of calls per run");
+C10_DEFINE_int(repeat, 5, "Number of runs; the median is reported");
+C10_DEFINE_int(
+    graph_size,
+    100,
+    "Number of instructions or nodes of the TorchScript graphs");
+C10_DEFINE_string(json, "", "File to also write the results to, as JSON");
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+  std::string name;
+  double ns;
+};
+
+std::vector<Result> results;
+
+// Runs fn(iter) --repeat times after one warm up run, and records the median
+// nanoseconds per unit, where one run does units_per_call * iter units
+void measure(
+    const std::string& name,
+    const std::function<void(int)>& fn,
+    double units_per_call = 1) {
+  fn(std::max(FLAGS_iter / 10, 1));
+  std::vector<double> runs;
+  for (int r = 0; r < FLAGS_repeat; ++r) {
+    const auto start = Clock::now();
+    fn(FLAGS_iter);
+    const std::chrono::duration<double, std::nano> elapsed =
+        Clock::now() - start;
+    runs.push_back(elapsed.count() / (FLAGS_iter * units_per_call));
+  }
+  std::sort(runs.begin(), runs.end());
+  results.push_back({name, runs[runs.size() / 2]});
+  printf("%-48s %12.2f ns\n", name.c_str(), results.back().ns);
+  fflush(stdout);
+}
+
+void benchmarkEmpty() {
+  measure("empty_tensor", [](int iter) {
+    for (int i = 0; i < iter; ++i) {
+      at::empty({1});
+    }
+  });
+  measure("empty_tensor_strided", [](int iter) {
+    for (int i = 0; i < iter; ++i) {
+      at::empty_strided({2, 2}, {1, 2});
+    }
+  });
+}
+
+// view does no work on the data, so this is dominated by the dispatch
+void benchmarkDispatch() {
+  auto x = at::ones({1});
+  measure("dispatch_view_cpu", [&](int iter) {
+    for (int i = 0; i < iter; ++i) {
+      x.view({-1});
+    }
+  });
+
+  auto y = at::ones({1}).requires_grad_();
+  measure("dispatch_view_cpu_requires_grad", [&](int iter) {
+    for (int i = 0; i < iter; ++i) {
+      y.view({-1});
+    }
+  });
+
+  measure("dispatch_view_cpu_non_variable_type_mode", [&](int iter) {
+    at::AutoNonVariableTypeMode guard;
+    for (int i = 0; i < iter; ++i) {
+      x.view({-1});
+    }
+  });
+}
+
+// The difference between the two is the cost of recording the op
+void benchmarkAutograd() {
+  auto x = at::ones({1}).requires_grad_();
+  measure("autograd_mul_no_grad", [&](int iter) {
+    torch::autograd::AutoGradMode guard(false);
+    for (int i = 0; i < iter; ++i) {
+      x.mul(x);
+    }
+  });
+  measure("autograd_mul_record_graph", [&](int iter) {
+    for (int i = 0; i < iter; ++i) {
+      x.mul(x);
+    }
+  });
+}
+
+// Straight line graph of graph_size int additions, so that almost every
+// instruction is the same
+std::shared_ptr<torch::jit::Graph> intAddGraph() {
+  std::stringstream ir;
+  ir << "graph(%a : int, %b : int):\n";
+  ir << "  %v0 : int = aten::add(%a, %b)\n";
+  for (int i = 1; i < FLAGS_graph_size; ++i) {
+    ir << "  %v" << i << " : int = aten::add(%v" << i - 1 << ", %b)\n";
+  }
+  ir << "  return (%v" << FLAGS_graph_size - 1 << ")\n";
+  auto graph = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(ir.str(), graph.get());
+  return graph;
+}
+
+void benchmarkInterpreter() {
+  torch::jit::Code code(intAddGraph(), "int_add");
+  measure(
+      "interpreter_per_instruction",
+      [&](int iter) {
+        torch::jit::Stack stack;
+        for (int i = 0; i < iter; ++i) {
+          stack = {1, 2};
+          torch::jit::InterpreterState(code).run(stack);
+        }
+      },
+      code.instructions().size());
+}
+
+// Chain of graph_size muls of one element tensors, which Static Runtime runs
+// out of place into the memory it planned
+void benchmarkStaticRuntime() {
+  std::stringstream ir;
+  ir << "graph(%a : Tensor, %b : Tensor):\n";
+  ir << "  %v0 : Tensor = aten::mul(%a, %b)\n";
+  for (int i = 1; i < FLAGS_graph_size; ++i) {
+    ir << "  %v" << i << " : Tensor = aten::mul(%v" << i - 1 << ", %b)\n";
+  }
+  ir << "  return (%v" << FLAGS_graph_size - 1 << ")\n";
+  auto graph = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(ir.str(), graph.get());
+
+  torch::jit::StaticModule module(graph);
+  const std::vector<at::Tensor> inputs = {at::ones({1}), at::ones({1})};
+  measure(
+      "static_runtime_per_node",
+      [&](int iter) {
+        for (int i = 0; i < iter; ++i) {
+          module(inputs);
+        }
+      },
+      module.nodes().size());
+}
+
+void benchmarkRecordFunction() {
+  auto x = at::ones({1});
+  auto run = [&](int iter) {
+    for (int i = 0; i < iter; ++i) {
+      at::add(x, x);
+    }
+  };
+  measure("record_function_add_no_observers", run);
+
+  auto handle = at::addGlobalCallback(
+      at::RecordFunctionCallback(
+          [](const at::RecordFunction&)
+              -> std::unique_ptr<at::ObserverContext> { return nullptr; },
+          [](const at::RecordFunction&, at::ObserverContext*) {})
+          .needsInputs(false));
+  measure("record_function_add_observer", run);
+  at::removeCallback(handle);
+}
+
+void writeJson() {
+  std::ofstream out(FLAGS_json);
+  out << "{";
+  for (size_t i = 0; i < results.size(); ++i) {
+    out << (i ? ", " : "") << "\"" << results[i].name
+        << "\": " << results[i].ns;
+  }
+  out << "}\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  if (!c10::ParseCommandLineFlags(&argc, &argv)) {
+    std::cout << "Failed to parse command line flags" << std::endl;
+    return -1;
+  }
+  at::init_num_threads();
+  at::set_num_threads(1);
+
+  benchmarkEmpty();
+  benchmarkDispatch();
+  benchmarkAutograd();
+  benchmarkInterpreter();
+  benchmarkStaticRuntime();
+  benchmarkRecordFunction();
+
+  if (!FLAGS_json.empty()) {
+    writeJson();
+  }
+  return 0;
+}
@@ -141,6 +141,10 @@ int main(int argc, char** argv) {
             << FLAGS_sub_iter << " subtasks each, using "
             << at::get_num_interop_threads() << " inter-op threads and "
             << at::get_num_threads() << " intra-op threads, "
+#if AT_PARALLEL_NATIVE
+            // choose with ATEN_INTRAOP_POOL=work_stealing|default
+            << at::internal::intraop_pool_backend() << " intra-op pool, "
+#endif
             << "tensor dim: " << FLAGS_tensor_dim
             << ", task type: " << FLAGS_task_type << std::endl;
 
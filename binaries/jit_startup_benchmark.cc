@@ -0,0 +1,113 @@
+#include <torch/csrc/jit/runtime/operator.h>
+#include <torch/jit.h>
+#include <torch/script.h>
+
+#include "c10/util/Flags.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+// Tracks what a short-lived process pays before and right after main: the
+// static initialization of the libraries (which registers all the operators),
+// and the first operator lookups, script compilation and model load, which
+// parse the schemas of the operators they use. Run it in a fresh process for
+// every measurement, e.g.
+//   for i in $(seq 10); do ./jit_startup_benchmark --model=model.pt; done
+
+C10_DEFINE_string(model, "", "Optional TorchScript model to load.");
+C10_DEFINE_bool(
+    all_operators,
+    false,
+    "Also time the parsing of the schemas of all the registered operators.");
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double msSince(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+// Time since the start of the process, from /proc, with the resolution of
+// the clock ticks (usually 10ms); negative if it is not available.
+double processUptimeMs() {
+#if defined(__linux__)
+  std::ifstream stat("/proc/self/stat");
+  std::string stat_line;
+  std::getline(stat, stat_line);
+  // The command name in parentheses may contain spaces, the fields after it
+  // do not. starttime is field 22, the 20th after the command name.
+  const auto pos = stat_line.rfind(')');
+  if (pos == std::string::npos) {
+    return -1;
+  }
+  std::istringstream fields(stat_line.substr(pos + 2));
+  std::string field;
+  for (int i = 0; i < 20; i++) {
+    fields >> field;
+  }
+  unsigned long long start_ticks = 0;
+  fields >> start_ticks;
+
+  std::ifstream uptime_file("/proc/uptime");
+  double uptime_s = 0;
+  uptime_file >> uptime_s;
+  if (!fields || !uptime_file) {
+    return -1;
+  }
+  return (uptime_s - double(start_ticks) / sysconf(_SC_CLK_TCK)) * 1000;
+#else
+  return -1;
+#endif
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const double startup_ms = processUptimeMs();
+  if (!c10::ParseCommandLineFlags(&argc, &argv)) {
+    std::cerr << "Failed to parse command line flags" << std::endl;
+    return 1;
+  }
+  if (startup_ms >= 0) {
+    std::cout << "Process start to main: " << startup_ms << " ms" << std::endl;
+  }
+
+  auto start = Clock::now();
+  const auto& ops = torch::jit::getAllOperatorsFor(
+      c10::Symbol::fromQualString("aten::add"));
+  std::cout << "First lookup (" << ops.size()
+            << " aten::add overloads): " << msSince(start) << " ms"
+            << std::endl;
+
+  start = Clock::now();
+  auto cu = torch::jit::compile(R"JIT(
+    def forward(x, y):
+        z = torch.relu(torch.matmul(x, y) + 1)
+        return torch.softmax(z, dim=1).sum()
+  )JIT");
+  std::cout << "First script compilation: " << msSince(start) << " ms"
+            << std::endl;
+
+  if (!FLAGS_model.empty()) {
+    start = Clock::now();
+    auto module = torch::jit::load(FLAGS_model);
+    std::cout << "Model load: " << msSince(start) << " ms" << std::endl;
+  }
+
+  if (FLAGS_all_operators) {
+    start = Clock::now();
+    const auto all_ops = torch::jit::getAllOperators();
+    std::cout << "Parsing all " << all_ops.size()
+              << " operators: " << msSince(start) << " ms" << std::endl;
+  }
+  return 0;
+}
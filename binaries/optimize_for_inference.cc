@@ -0,0 +1,339 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <ATen/ATen.h>
+#include <caffe2/core/timer.h>
+#include <torch/csrc/autograd/grad_mode.h>
+#include <torch/csrc/jit/passes/batch_mm.h>
+#include <torch/csrc/jit/passes/freeze_module.h>
+#include <torch/csrc/jit/passes/frozen_conv_folding.h>
+#include <torch/csrc/jit/passes/frozen_ops_to_mkldnn.h>
+#include <torch/csrc/jit/passes/fuse_linear.h>
+#include <torch/csrc/jit/passes/tensorexpr_fuser.h>
+#include <torch/csrc/jit/serialization/import.h>
+#include <torch/csrc/jit/serialization/pickle.h>
+#include <torch/script.h>
+
+C10_DEFINE_string(model, "", "The torch script model to optimize.");
+C10_DEFINE_string(
+    output,
+    "",
+    "Name of the output model to be saved, <model>_optimized.pt by default.");
+C10_DEFINE_string(
+    report,
+    "",
+    "File to write the report to, in addition to the standard output.");
+C10_DEFINE_string(
+    input_file,
+    "",
+    "File with the sample inputs, saved in Python with "
+    "torch.save((input0, input1, ...), file).");
+C10_DEFINE_string(
+    input_dims,
+    "",
+    "Alternate to input_file, if all inputs are simple "
+    "float TensorCPUs, specify the dimension using comma "
+    "separated numbers. If multiple input needed, use "
+    "semicolon to separate the dimension of different "
+    "tensors.");
+C10_DEFINE_string(input_type, "", "Input type (uint8_t/float/int64)");
+C10_DEFINE_string(
+    passes,
+    "conv_bn,conv_add,conv_mul,linear,mkldnn,batch_mm",
+    "Comma separated passes to try, in order.");
+C10_DEFINE_bool(
+    try_tensorexpr_fuser,
+    true,
+    "Whether to also measure the optimized model with the NNC fuser on.");
+C10_DEFINE_int(warmup, 10, "The number of iterations to warm up.");
+C10_DEFINE_int(iter, 50, "The number of iterations to measure.");
+C10_DEFINE_double(
+    min_speedup,
+    1.02,
+    "How much faster a pass must make the model to be kept.");
+C10_DEFINE_double(tolerance, 1e-4, "Relative tolerance of the outputs.");
+
+namespace {
+
+std::vector<std::string> split(
+    char separator,
+    const std::string& string,
+    bool ignore_empty = true) {
+  std::vector<std::string> pieces;
+  std::stringstream ss(string);
+  std::string item;
+  while (getline(ss, item, separator)) {
+    if (!ignore_empty || !item.empty()) {
+      pieces.push_back(std::move(item));
+    }
+  }
+  return pieces;
+}
+
+std::vector<c10::IValue> create_inputs() {
+  if (!FLAGS_input_file.empty()) {
+    std::ifstream file(FLAGS_input_file, std::ios::binary);
+    CAFFE_ENFORCE(file, "Can't open input file: ", FLAGS_input_file);
+    std::vector<char> data(
+        (std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>());
+    auto ivalue = torch::jit::pickle_load(data);
+    if (ivalue.isTuple()) {
+      return ivalue.toTuple()->elements();
+    }
+    if (ivalue.isList()) {
+      return ivalue.toList().vec();
+    }
+    return {ivalue};
+  }
+
+  std::vector<std::string> input_dims_list = split(';', FLAGS_input_dims);
+  std::vector<std::string> input_type_list = split(';', FLAGS_input_type);
+  CAFFE_ENFORCE_EQ(
+      input_dims_list.size(),
+      input_type_list.size(),
+      "Input dims and type should have the same number of items.");
+
+  std::vector<c10::IValue> inputs;
+  for (size_t i = 0; i < input_dims_list.size(); ++i) {
+    std::vector<int64_t> input_dims;
+    for (const auto& s : split(',', input_dims_list[i])) {
+      input_dims.push_back(c10::stoi(s));
+    }
+    at::ScalarType input_type;
+    if (input_type_list[i] == "float") {
+      input_type = at::ScalarType::Float;
+    } else if (input_type_list[i] == "uint8_t") {
+      input_type = at::ScalarType::Byte;
+    } else if (input_type_list[i] == "int64") {
+      input_type = at::ScalarType::Long;
+    } else {
+      CAFFE_THROW("Unsupported input type: ", input_type_list[i]);
+    }
+    inputs.push_back(torch::rand(input_dims, at::TensorOptions(input_type)));
+  }
+  return inputs;
+}
+
+void flattenTensors(const c10::IValue& value, std::vector<at::Tensor>& out) {
+  if (value.isTensor()) {
+    out.push_back(value.toTensor());
+  } else if (value.isTuple()) {
+    for (const auto& element : value.toTuple()->elements()) {
+      flattenTensors(element, out);
+    }
+  } else if (value.isList()) {
+    for (const auto& element : value.toList()) {
+      flattenTensors(element, out);
+    }
+  } else if (value.isGenericDict()) {
+    for (const auto& entry : value.toGenericDict()) {
+      flattenTensors(entry.value(), out);
+    }
+  }
+}
+
+bool almostEqual(const c10::IValue& a, const c10::IValue& b) {
+  std::vector<at::Tensor> a_tensors, b_tensors;
+  flattenTensors(a, a_tensors);
+  flattenTensors(b, b_tensors);
+  if (a_tensors.size() != b_tensors.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a_tensors.size(); ++i) {
+    // MKLDNN outputs need to be converted back first
+    auto x = a_tensors[i].is_mkldnn() ? a_tensors[i].to_dense() : a_tensors[i];
+    auto y = b_tensors[i].is_mkldnn() ? b_tensors[i].to_dense() : b_tensors[i];
+    if (x.sizes() != y.sizes() ||
+        !at::allclose(x, y, FLAGS_tolerance, FLAGS_tolerance)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Mean milliseconds per run of forward, after warming up the executor
+double benchmark(
+    torch::jit::Module& module,
+    const std::vector<c10::IValue>& inputs,
+    c10::IValue* output) {
+  for (int i = 0; i < FLAGS_warmup; ++i) {
+    module.forward(inputs);
+  }
+  caffe2::Timer timer;
+  for (int i = 0; i < FLAGS_iter; ++i) {
+    *output = module.forward(inputs);
+  }
+  return timer.MilliSeconds() / std::max(FLAGS_iter, 1);
+}
+
+// Whether the module survives a round trip through serialization
+bool canSave(const torch::jit::Module& module) {
+  try {
+    std::stringstream ss;
+    module.save(ss);
+    torch::jit::load(ss);
+    return true;
+  } catch (const std::exception&) {
+    return false;
+  }
+}
+
+using GraphPass = std::function<void(std::shared_ptr<torch::jit::Graph>&)>;
+
+const std::vector<std::pair<std::string, GraphPass>>& candidatePasses() {
+  static const std::vector<std::pair<std::string, GraphPass>> passes = {
+      {"conv_bn", torch::jit::FoldFrozenConvBatchnorm},
+      {"conv_add", torch::jit::FoldFrozenConvAddOrSub},
+      {"conv_mul", torch::jit::FoldFrozenConvMulOrDiv},
+      {"linear", torch::jit::FuseLinear},
+      {"mkldnn", torch::jit::ConvertFrozenOpsToMKLDNN},
+      {"batch_mm", torch::jit::BatchMM},
+  };
+  return passes;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  c10::SetUsageMessage(
+      "\nFreezes a pytorch model and applies the optimization passes that\n"
+      "make it faster on the given inputs, one at a time. Example usage:\n"
+      "./optimize_for_inference"
+      " --model=<model_file>"
+      " --input_file=<inputs_file> | --input_dims=<dims> --input_type=<type>"
+      " [--output=<output_file_name>]"
+      " [--report=<report_file_name>]"
+      " [--passes=<pass,...>]");
+  if (!c10::ParseCommandLineFlags(&argc, &argv)) {
+    std::cerr << "Failed to parse command line flags!" << std::endl;
+    std::cout << c10::UsageMessage() << std::endl;
+    return 1;
+  }
+  CAFFE_ENFORCE(FLAGS_model != "", c10::UsageMessage());
+  CAFFE_ENFORCE(
+      FLAGS_input_file != "" || FLAGS_input_dims != "",
+      "Sample inputs must be given with --input_file or --input_dims.");
+
+  std::string output_model_name = FLAGS_output;
+  if (output_model_name.empty()) {
+    output_model_name =
+        FLAGS_model.substr(0, FLAGS_model.find('.')) + "_optimized.pt";
+  }
+
+  torch::autograd::AutoGradMode guard(false);
+  auto module = torch::jit::load(FLAGS_model);
+  module.eval();
+  auto inputs = create_inputs();
+
+  std::stringstream report;
+  report << std::fixed << std::setprecision(3);
+  auto record = [&](const std::string& name,
+                    double ms,
+                    double speedup,
+                    const std::string& verdict) {
+    report << std::left << std::setw(16) << name << std::right << std::setw(12)
+           << ms << " ms" << std::setw(10) << speedup << "x  " << verdict
+           << "\n";
+  };
+
+  c10::IValue reference;
+  const double eager_ms = benchmark(module, inputs, &reference);
+  record("original", eager_ms, 1.0, "");
+
+  auto best = torch::jit::freeze_module(module);
+  c10::IValue output;
+  double best_ms = benchmark(best, inputs, &output);
+  record("freeze", best_ms, eager_ms / best_ms, "kept");
+
+  std::vector<std::string> kept;
+  for (const auto& name : split(',', FLAGS_passes)) {
+    const auto& passes = candidatePasses();
+    auto it = std::find_if(passes.begin(), passes.end(), [&](const auto& p) {
+      return p.first == name;
+    });
+    CAFFE_ENFORCE(it != passes.end(), "Unknown pass: ", name);
+
+    auto candidate = best.clone();
+    double ms = 0;
+    std::string verdict;
+    try {
+      auto graph = candidate.get_method("forward").graph();
+      it->second(graph);
+      ms = benchmark(candidate, inputs, &output);
+      if (!almostEqual(output, reference)) {
+        verdict = "rejected, outputs differ";
+      } else if (best_ms / ms < FLAGS_min_speedup) {
+        verdict = "rejected, not faster";
+      } else if (!canSave(candidate)) {
+        verdict = "rejected, can't be saved";
+      } else {
+        verdict = "kept";
+      }
+    } catch (const std::exception& e) {
+      verdict = std::string("rejected, failed: ") + e.what();
+    }
+    record(name, ms, ms > 0 ? best_ms / ms : 0, verdict);
+    if (verdict == "kept") {
+      best = candidate;
+      best_ms = ms;
+      kept.push_back(name);
+    }
+  }
+
+  // The fuser is a setting of the executor rather than a rewrite that can be
+  // saved with the model, so it is only recommended
+  if (FLAGS_try_tensorexpr_fuser && !torch::jit::tensorExprFuserEnabled()) {
+    torch::jit::setTensorExprFuserEnabled(true);
+    auto candidate = best.clone();
+    double ms = benchmark(candidate, inputs, &output);
+    const bool faster = almostEqual(output, reference) &&
+        best_ms / ms >= FLAGS_min_speedup;
+    record(
+        "tensorexpr",
+        ms,
+        best_ms / ms,
+        faster ? "recommended, enable the fuser at run time"
+               : "not recommended");
+    torch::jit::setTensorExprFuserEnabled(false);
+  }
+
+  report << "\nKept passes:";
+  for (const auto& name : kept) {
+    report << " " << name;
+  }
+  report << "\nSpeedup over the original model: " << eager_ms / best_ms
+         << "x\n";
+
+  best.save(output_model_name);
+  report << "The optimized model was saved to " << output_model_name << "\n";
+
+  std::cout << report.str();
+  if (!FLAGS_report.empty()) {
+    std::ofstream report_file(FLAGS_report);
+    report_file << report.str();
+  }
+  return 0;
+}
@@ -0,0 +1,56 @@
+#include "benchmark/benchmark.h"
+
+#include "caffe2/core/context.h"
+#include "caffe2/queue/rebatching_queue.h"
+
+namespace {
+
+constexpr size_t kCapacity = 1024;
+constexpr int64_t kBatchSize = 64;
+
+// Every thread both enqueues and dequeues, so that producers and consumers
+// contend on the same queue. Each thread dequeues as many rows as it
+// enqueues, so the queue never fills up and always ends up empty.
+static void BM_RebatchingQueueOne(benchmark::State& state) {
+  static caffe2::RebatchingQueue queue(kCapacity, 1);
+  caffe2::CPUContext context;
+  caffe2::TensorCPU row({state.range(0)}, caffe2::CPU);
+  row.mutable_data<float>();
+  caffe2::TensorCPU output(caffe2::CPU);
+  const std::vector<const caffe2::TensorCPU*> inputs{&row};
+  const std::vector<caffe2::TensorCPU*> outputs{&output};
+  while (state.KeepRunning()) {
+    queue.enqueueOne(context, inputs);
+    queue.dequeue(context, 1, outputs);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RebatchingQueueOne)
+    ->Arg(16)
+    ->Arg(1024)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+static void BM_RebatchingQueueMany(benchmark::State& state) {
+  static caffe2::RebatchingQueue queue(kCapacity, 1);
+  caffe2::CPUContext context;
+  caffe2::TensorCPU batch({kBatchSize, state.range(0)}, caffe2::CPU);
+  batch.mutable_data<float>();
+  caffe2::TensorCPU output(caffe2::CPU);
+  const std::vector<const caffe2::TensorCPU*> inputs{&batch};
+  const std::vector<caffe2::TensorCPU*> outputs{&output};
+  while (state.KeepRunning()) {
+    queue.enqueueMany(context, inputs);
+    queue.dequeue(context, kBatchSize, outputs);
+  }
+  state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+BENCHMARK(BM_RebatchingQueueMany)
+    ->Arg(16)
+    ->Arg(1024)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+} // namespace
+
+BENCHMARK_MAIN();
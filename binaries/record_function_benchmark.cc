@@ -1,4 +1,5 @@
 #include <torch/torch.h>
+#include <ATen/OperatorStatsObserver.h>
 #include <ATen/record_function.h>
 
 #include "c10/util/Flags.h"
@@ -105,6 +106,11 @@ int main(int argc, char** argv) {
   runBenchmark();
   at::clearCallbacks();
 
+  at::enableOperatorStatsObserver();
+  std::cout << "Running with the operator stats observer" << std::endl;
+  runBenchmark();
+  at::disableOperatorStatsObserver();
+
   std::cout << "Checking number of sampled observer invocations" << std::endl;
   static int cb_count = 0;
   addTestCallback(
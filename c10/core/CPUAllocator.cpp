@@ -3,6 +3,14 @@
 #include <c10/mobile/CPUCachingAllocator.h>
 #include <c10/mobile/CPUProfilingAllocator.h>
 
+#if defined(__linux__) && !defined(__ANDROID__) && !defined(C10_MOBILE)
+#define C10_CPU_HUGE_PAGES
+#include <sys/mman.h>
+#include <atomic>
+#include <cinttypes>
+#include <fstream>
+#endif
+
 // TODO: rename flags to C10
 C10_DEFINE_bool(
     caffe2_report_cpu_memory_usage,
@@ -19,6 +27,19 @@ C10_DEFINE_bool(
     false,
     "If set, fill memory with deterministic junk when allocating on CPU");
 
+C10_DEFINE_int64(
+    caffe2_cpu_allocator_huge_page_threshold,
+    0,
+    "If positive, CPU allocations of at least this many bytes are backed by "
+    "huge pages (Linux only)");
+
+C10_DEFINE_bool(
+    caffe2_cpu_allocator_use_hugetlbfs,
+    false,
+    "If set, huge page backed CPU allocations use explicit hugetlbfs pages "
+    "(MAP_HUGETLB) instead of transparent huge pages, falling back to the "
+    "latter when no huge pages are reserved");
+
 namespace c10 {
 
 void memset_junk(void* data, size_t num) {
@@ -38,6 +59,138 @@ void memset_junk(void* data, size_t num) {
   }
 }
 
+#ifdef C10_CPU_HUGE_PAGES
+namespace {
+
+constexpr size_t kTransparentHugePageSize = 2 * 1024 * 1024;
+
+size_t round_up(size_t n, size_t multiple) {
+  return (n + multiple - 1) / multiple * multiple;
+}
+
+// Default hugetlbfs page size, as reported by /proc/meminfo
+size_t hugetlb_page_size() {
+  static size_t page_size = []() {
+    std::ifstream meminfo("/proc/meminfo");
+    std::string line;
+    while (std::getline(meminfo, line)) {
+      size_t kb = 0;
+      if (sscanf(line.c_str(), "Hugepagesize: %zu kB", &kb) == 1 && kb > 0) {
+        return kb * 1024;
+      }
+    }
+    return kTransparentHugePageSize;
+  }();
+  return page_size;
+}
+
+struct HugePageMapping {
+  size_t size;
+  bool hugetlbfs;
+};
+
+// free_cpu has to tell mmap-ed huge page allocations from posix_memalign-ed
+// ones. The table is leaked so that it outlives static destructors that
+// free memory.
+struct HugePageTable {
+  std::mutex mutex;
+  std::unordered_map<void*, HugePageMapping> mappings;
+  std::atomic<size_t> size{0};
+};
+
+HugePageTable& huge_page_table() {
+  static HugePageTable* table = new HugePageTable();
+  return *table;
+}
+
+void record_huge_pages(void* data, size_t size, bool hugetlbfs) {
+  auto& table = huge_page_table();
+  std::lock_guard<std::mutex> guard(table.mutex);
+  table.mappings[data] = {size, hugetlbfs};
+  table.size++;
+}
+
+// Returns nullptr if the allocation should take the regular path
+void* alloc_huge_pages(size_t nbytes) {
+  const int64_t threshold = FLAGS_caffe2_cpu_allocator_huge_page_threshold;
+  if (threshold <= 0 || nbytes < (size_t)threshold) {
+    return nullptr;
+  }
+  if (FLAGS_caffe2_cpu_allocator_use_hugetlbfs) {
+    const size_t size = round_up(nbytes, hugetlb_page_size());
+    void* data = mmap(
+        nullptr,
+        size,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+        -1,
+        0);
+    if (data != MAP_FAILED) {
+      record_huge_pages(data, size, /* hugetlbfs */ true);
+      return data;
+    }
+    C10_LOG_EVERY_MS(WARNING, 10000)
+        << "alloc_cpu: can't map " << size << " bytes of hugetlbfs pages ("
+        << strerror(errno) << "), using transparent huge pages instead";
+  }
+  // Over-reserve so that the mapping can be trimmed to a huge page boundary,
+  // otherwise the kernel can only use huge pages for the aligned middle part
+  const size_t size = round_up(nbytes, kTransparentHugePageSize);
+  const size_t reserved = size + kTransparentHugePageSize;
+  void* mapping = mmap(
+      nullptr,
+      reserved,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      -1,
+      0);
+  if (mapping == MAP_FAILED) {
+    return nullptr;
+  }
+  const uintptr_t begin = reinterpret_cast<uintptr_t>(mapping);
+  const uintptr_t aligned = round_up(begin, kTransparentHugePageSize);
+  if (aligned != begin) {
+    munmap(mapping, aligned - begin);
+  }
+  const size_t tail = begin + reserved - (aligned + size);
+  if (tail > 0) {
+    munmap(reinterpret_cast<void*>(aligned + size), tail);
+  }
+  void* data = reinterpret_cast<void*>(aligned);
+  if (madvise(data, size, MADV_HUGEPAGE) != 0) {
+    // e.g. transparent huge pages are disabled, the mapping still works
+    C10_LOG_EVERY_MS(WARNING, 10000)
+        << "alloc_cpu: madvise(MADV_HUGEPAGE) failed (" << strerror(errno)
+        << ")";
+  }
+  record_huge_pages(data, size, /* hugetlbfs */ false);
+  return data;
+}
+
+// Returns false if data wasn't allocated by alloc_huge_pages
+bool free_huge_pages(void* data) {
+  auto& table = huge_page_table();
+  if (table.size.load() == 0) {
+    return false;
+  }
+  size_t size = 0;
+  {
+    std::lock_guard<std::mutex> guard(table.mutex);
+    auto it = table.mappings.find(data);
+    if (it == table.mappings.end()) {
+      return false;
+    }
+    size = it->second.size;
+    table.mappings.erase(it);
+    table.size--;
+  }
+  munmap(data, size);
+  return true;
+}
+
+} // namespace
+#endif
+
 void* alloc_cpu(size_t nbytes) {
   if (nbytes == 0) {
     return nullptr;
@@ -49,24 +202,29 @@ void* alloc_cpu(size_t nbytes) {
       "alloc_cpu() seems to have been called with negative number: ",
       nbytes);
 
-  void* data;
+  void* data = nullptr;
+#ifdef C10_CPU_HUGE_PAGES
+  data = alloc_huge_pages(nbytes);
+#endif
+  if (!data) {
 #ifdef __ANDROID__
-  data = memalign(gAlignment, nbytes);
+    data = memalign(gAlignment, nbytes);
 #elif defined(_MSC_VER)
-  data = _aligned_malloc(nbytes, gAlignment);
+    data = _aligned_malloc(nbytes, gAlignment);
 #else
-  int err = posix_memalign(&data, gAlignment, nbytes);
-  if (err != 0) {
-    CAFFE_THROW(
-        "DefaultCPUAllocator: can't allocate memory: you tried to allocate ",
-        nbytes,
-        " bytes. Error code ",
-        err,
-        " (",
-        strerror(err),
-        ")");
-  }
+    int err = posix_memalign(&data, gAlignment, nbytes);
+    if (err != 0) {
+      CAFFE_THROW(
+          "DefaultCPUAllocator: can't allocate memory: you tried to allocate ",
+          nbytes,
+          " bytes. Error code ",
+          err,
+          " (",
+          strerror(err),
+          ")");
+    }
 #endif
+  }
 
   CAFFE_ENFORCE(
       data,
@@ -90,6 +248,11 @@ void* alloc_cpu(size_t nbytes) {
 }
 
 void free_cpu(void* data) {
+#ifdef C10_CPU_HUGE_PAGES
+  if (free_huge_pages(data)) {
+    return;
+  }
+#endif
 #ifdef _MSC_VER
   _aligned_free(data);
 #else
@@ -97,12 +260,68 @@ void free_cpu(void* data) {
 #endif
 }
 
+std::vector<HugePageAllocation> getHugePageAllocations() {
+  std::vector<HugePageAllocation> allocations;
+#ifdef C10_CPU_HUGE_PAGES
+  {
+    auto& table = huge_page_table();
+    std::lock_guard<std::mutex> guard(table.mutex);
+    for (const auto& it : table.mappings) {
+      allocations.push_back(
+          {it.first,
+           it.second.size,
+           it.second.hugetlbfs,
+           it.second.hugetlbfs ? it.second.size : 0});
+    }
+  }
+  // Transparent huge pages are only known once they are faulted in: add up
+  // AnonHugePages of the mappings that overlap each allocation. Adjacent
+  // allocations can share a mapping, so this is an upper bound per allocation.
+  std::ifstream smaps("/proc/self/smaps");
+  std::string line;
+  uintptr_t vma_begin = 0;
+  uintptr_t vma_end = 0;
+  while (std::getline(smaps, line)) {
+    uintptr_t begin = 0;
+    uintptr_t end = 0;
+    size_t kb = 0;
+    if (sscanf(line.c_str(), "%" SCNxPTR "-%" SCNxPTR, &begin, &end) == 2) {
+      vma_begin = begin;
+      vma_end = end;
+    } else if (
+        sscanf(line.c_str(), "AnonHugePages: %zu kB", &kb) == 1 && kb > 0) {
+      for (auto& allocation : allocations) {
+        const uintptr_t data = reinterpret_cast<uintptr_t>(allocation.data);
+        const uintptr_t overlap_begin = std::max(data, vma_begin);
+        const uintptr_t overlap_end =
+            std::min(data + allocation.nbytes, vma_end);
+        if (!allocation.hugetlbfs && overlap_begin < overlap_end) {
+          allocation.huge_page_bytes = std::min(
+              allocation.nbytes,
+              allocation.huge_page_bytes +
+                  std::min<size_t>(kb * 1024, overlap_end - overlap_begin));
+        }
+      }
+    }
+  }
+#endif
+  return allocations;
+}
+
 struct C10_API DefaultCPUAllocator final : at::Allocator {
   DefaultCPUAllocator() {}
   ~DefaultCPUAllocator() override {}
   at::DataPtr allocate(size_t nbytes) const override {
+    auto profiling_allocator_ptr = GetThreadLocalProfilingAllocator();
+    if (C10_UNLIKELY(profiling_allocator_ptr != nullptr) && nbytes > 0) {
+      return profiling_allocator_ptr->allocate_data_ptr(nbytes);
+    }
     void* data = alloc_cpu(nbytes);
     profiledCPUMemoryReporter().New(data, nbytes);
+    auto allocation_planner = GetThreadLocalAllocationPlanner();
+    if (C10_UNLIKELY(allocation_planner != nullptr) && data != nullptr) {
+      allocation_planner->record_allocation(nbytes, data);
+    }
     return {data, data, &ReportAndDelete, at::Device(at::DeviceType::CPU)};
   }
 
@@ -111,6 +330,10 @@ struct C10_API DefaultCPUAllocator final : at::Allocator {
       return;
     }
     profiledCPUMemoryReporter().Delete(ptr);
+    auto allocation_planner = GetThreadLocalAllocationPlanner();
+    if (C10_UNLIKELY(allocation_planner != nullptr)) {
+      allocation_planner->record_free(ptr);
+    }
     free_cpu(ptr);
   }
 
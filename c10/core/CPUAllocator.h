@@ -2,6 +2,7 @@
 
 #include <cstring>
 #include <unordered_map>
+#include <vector>
 
 #include <c10/core/Allocator.h>
 #include <c10/util/Logging.h>
@@ -11,6 +12,8 @@
 C10_DECLARE_bool(caffe2_report_cpu_memory_usage);
 C10_DECLARE_bool(caffe2_cpu_allocator_do_zero_fill);
 C10_DECLARE_bool(caffe2_cpu_allocator_do_junk_fill);
+C10_DECLARE_int64(caffe2_cpu_allocator_huge_page_threshold);
+C10_DECLARE_bool(caffe2_cpu_allocator_use_hugetlbfs);
 
 namespace c10 {
 
@@ -37,6 +40,24 @@ C10_API void memset_junk(void* data, size_t num);
 C10_API void* alloc_cpu(size_t nbytes);
 C10_API void free_cpu(void* data);
 
+// An allocation of alloc_cpu that is backed by huge pages, see
+// FLAGS_caffe2_cpu_allocator_huge_page_threshold
+struct HugePageAllocation {
+  void* data;
+  // size of the mapping, rounded up to the huge page size
+  size_t nbytes;
+  // explicit hugetlbfs pages rather than transparent huge pages
+  bool hugetlbfs;
+  // bytes currently backed by huge pages
+  size_t huge_page_bytes;
+};
+
+// Lists the live huge page backed allocations. Transparent huge pages are
+// counted from /proc/self/smaps, so pages that haven't been touched yet or
+// that the kernel couldn't back with huge pages don't show up in
+// huge_page_bytes. Always empty on platforms other than Linux.
+C10_API std::vector<HugePageAllocation> getHugePageAllocations();
+
 // A simple struct that is used to report C10's memory allocation and
 // deallocation status to the profiler
 class C10_API ProfiledCPUMemoryReporter {
@@ -102,6 +102,8 @@ const char* toString(DispatchKey t) {
     case DispatchKey::Tracer:
       return "Tracer";
 
+    case DispatchKey::AutocastCPU:
+      return "AutocastCPU";
     case DispatchKey::Autocast:
       return "Autocast";
 
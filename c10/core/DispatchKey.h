@@ -193,6 +193,9 @@ enum class DispatchKey : uint8_t {
 
   // Autocasting precedes VariableTypeId, to ensure casts are autograd-exposed
   // and inputs are saved for backward in the post-autocast type.
+  // AutocastCPU casts CPU tensors (to bfloat16 by default), Autocast casts
+  // CUDA tensors to float16. Both are enabled through the TLS included set.
+  AutocastCPU,
   Autocast,
 
   // ~~~~~~~~~~~~~~~~~~~~~~~~~~~ WRAPPERS ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
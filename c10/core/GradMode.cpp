@@ -1,11 +1,11 @@
-#include <ATen/core/grad_mode.h>
+#include <c10/core/GradMode.h>
 
 #include <stdexcept>
 
-namespace at {
+namespace c10 {
 
 /// thread_local is a feature that is not enabled by Caffe2 mobile
-/// build (e.g. iOS). Therefore, we only provide `at::GradMode`
+/// build (e.g. iOS). Therefore, we only provide `c10::GradMode`
 /// when we are not in mobile build or when FEATURE_TORCH_MOBILE
 /// is on.
 #if !defined(C10_MOBILE) || defined(FEATURE_TORCH_MOBILE)
@@ -32,4 +32,4 @@ void GradMode::set_enabled(bool enabled) {
 
 #endif
 
-} // namespace at
+} // namespace c10
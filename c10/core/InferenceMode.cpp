@@ -0,0 +1,46 @@
+#include <c10/core/InferenceMode.h>
+
+namespace c10 {
+
+namespace {
+thread_local bool InferenceMode_enabled = false;
+} // namespace
+
+bool InferenceMode::is_enabled() {
+  return InferenceMode_enabled;
+}
+
+void InferenceMode::_set_enabled(bool enabled) {
+  InferenceMode_enabled = enabled;
+}
+
+// Snapshots the whole local dispatch key set rather than only the autograd
+// keys, so that InferenceMode(false) nested in InferenceMode also restores
+// the exclusion when it goes out of scope
+InferenceMode::InferenceMode(bool enabled)
+    : prev_mode_(InferenceMode_enabled),
+      prev_grad_mode_(GradMode::is_enabled()),
+      prev_keyset_(impl::tls_local_dispatch_key_set()) {
+  InferenceMode_enabled = enabled;
+  impl::LocalDispatchKeySet keyset = prev_keyset_;
+  if (enabled) {
+    // GradMode can't be set on mobile, where it is always disabled
+    if (prev_grad_mode_) {
+      GradMode::set_enabled(false);
+    }
+    keyset.excluded_ = keyset.excluded_ | autograd_dispatch_keyset;
+  } else {
+    keyset.excluded_ = keyset.excluded_ - autograd_dispatch_keyset;
+  }
+  impl::_force_tls_local_dispatch_key_set(keyset);
+}
+
+InferenceMode::~InferenceMode() {
+  InferenceMode_enabled = prev_mode_;
+  if (GradMode::is_enabled() != prev_grad_mode_) {
+    GradMode::set_enabled(prev_grad_mode_);
+  }
+  impl::_force_tls_local_dispatch_key_set(prev_keyset_);
+}
+
+} // namespace c10
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <c10/core/GradMode.h>
+#include <c10/core/impl/LocalDispatchKeySet.h>
+#include <c10/macros/Macros.h>
+
+namespace c10 {
+
+// A RAII, thread local (!) guard for pure inference code, which skips the
+// work autograd does for every op, even under NoGradGuard:
+//
+// - GradMode is disabled.
+// - The autograd dispatch keys are excluded, so ops go straight to their
+//   backend kernels without checking requires_grad or recording views.
+// - Tensors created in InferenceMode are "inference tensors": they don't
+//   allocate a version counter (see VariableVersion), and in-place updates
+//   of them are only allowed in InferenceMode. Outside of it they can be used
+//   as inputs of functional ops, which create normal tensors, but they can't
+//   require grad or be saved for backward.
+//
+// Unlike AutoNonVariableTypeMode, this is meant for user code. Views of
+// normal tensors and in-place updates of normal tensors in InferenceMode
+// don't bump the version counter of the normal tensor either, so don't
+// mutate tensors that are saved for backward outside of InferenceMode.
+//
+// InferenceMode(false) restores the normal behavior inside of InferenceMode.
+struct C10_API InferenceMode {
+  explicit InferenceMode(bool enabled = true);
+  ~InferenceMode();
+
+  InferenceMode(const InferenceMode&) = delete;
+  InferenceMode& operator=(const InferenceMode&) = delete;
+
+  static bool is_enabled();
+  // Internal, use the guard. For ThreadLocalState, which restores the
+  // dispatch keys on its own.
+  static void _set_enabled(bool enabled);
+
+ private:
+  bool prev_mode_;
+  bool prev_grad_mode_;
+  impl::LocalDispatchKeySet prev_keyset_;
+};
+
+} // namespace c10
@@ -0,0 +1,432 @@
+#include <c10/core/SizeClassCPUAllocator.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include <c10/core/CPUAllocator.h>
+#include <c10/util/llvmMathExtras.h>
+
+C10_DEFINE_int64(
+    caffe2_cpu_caching_allocator_max_cached_bytes,
+    0,
+    "Upper bound on the bytes kept in the global free lists of the size "
+    "class CPU allocator, 0 means no limit");
+
+namespace c10 {
+namespace SizeClassCPUAllocator {
+
+namespace {
+
+constexpr size_t log2_constexpr(size_t n) {
+  size_t result = 0;
+  while (n > 1) {
+    n >>= 1;
+    ++result;
+  }
+  return result;
+}
+
+constexpr size_t kMinShift = log2_constexpr(gAlignment);
+constexpr size_t kMaxShift = log2_constexpr(kMaxCachedSize);
+// one class for gAlignment, then four per power of two up to kMaxCachedSize
+constexpr size_t kNumSizeClasses = (kMaxShift - kMinShift) * 4 + 1;
+// size_class value of blocks that don't belong to any class
+constexpr size_t kUncached = kNumSizeClasses;
+
+// Classes up to this size are also cached per thread
+constexpr size_t kMaxThreadCachedSize = 256 * 1024;
+// Bytes a thread keeps at most in the free list of a single class
+constexpr size_t kThreadCacheBytesPerClass = 256 * 1024;
+constexpr size_t kMaxThreadCachedBlocksPerClass = 64;
+
+static_assert(
+    (size_t(1) << kMinShift) == gAlignment &&
+        (size_t(1) << kMaxShift) == kMaxCachedSize,
+    "size classes expect power of two bounds");
+
+// Every block starts with a header so that the deleter, which only gets the
+// data pointer, can find the size class. The header takes gAlignment bytes to
+// keep the data aligned.
+struct BlockHeader {
+  size_t size_class;
+  size_t size;
+};
+constexpr size_t kHeaderSize = gAlignment;
+static_assert(sizeof(BlockHeader) <= kHeaderSize, "header doesn't fit");
+
+size_t size_class_index(size_t nbytes) {
+  if (nbytes <= gAlignment) {
+    return 0;
+  }
+  // 2^k <= nbytes - 1 < 2^(k + 1), the four classes for this k are
+  // 5, 6, 7 and 8 times 2^(k - 2)
+  const size_t k = llvm::Log2_64(nbytes - 1);
+  const size_t q = (nbytes - 1) >> (k - 2);
+  return (k - kMinShift) * 4 + (q - 4) + 1;
+}
+
+size_t class_size(size_t index) {
+  if (index == 0) {
+    return gAlignment;
+  }
+  const size_t k = kMinShift + (index - 1) / 4;
+  const size_t m = (index - 1) % 4 + 5;
+  return m << (k - 2);
+}
+
+size_t thread_cache_limit(size_t size) {
+  if (size > kMaxThreadCachedSize) {
+    return 0;
+  }
+  return std::min(
+      kMaxThreadCachedBlocksPerClass,
+      std::max<size_t>(1, kThreadCacheBytesPerClass / size));
+}
+
+struct AtomicStat {
+  std::atomic<int64_t> current{0};
+  std::atomic<int64_t> peak{0};
+  std::atomic<int64_t> allocated{0};
+  std::atomic<int64_t> freed{0};
+
+  void increase(int64_t amount) {
+    const int64_t now =
+        current.fetch_add(amount, std::memory_order_relaxed) + amount;
+    int64_t prev_peak = peak.load(std::memory_order_relaxed);
+    while (now > prev_peak &&
+           !peak.compare_exchange_weak(
+               prev_peak, now, std::memory_order_relaxed)) {
+    }
+    allocated.fetch_add(amount, std::memory_order_relaxed);
+  }
+
+  void decrease(int64_t amount) {
+    current.fetch_sub(amount, std::memory_order_relaxed);
+    freed.fetch_add(amount, std::memory_order_relaxed);
+  }
+
+  Stat get() const {
+    Stat stat;
+    stat.current = current.load(std::memory_order_relaxed);
+    stat.peak = peak.load(std::memory_order_relaxed);
+    stat.allocated = allocated.load(std::memory_order_relaxed);
+    stat.freed = freed.load(std::memory_order_relaxed);
+    return stat;
+  }
+
+  void reset_accumulated() {
+    allocated.store(0, std::memory_order_relaxed);
+    freed.store(0, std::memory_order_relaxed);
+  }
+
+  void reset_peak() {
+    peak.store(
+        current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+};
+
+struct FreeList {
+  std::mutex mutex;
+  std::vector<void*> blocks;
+};
+
+// Global state, leaked on purpose so that blocks freed from thread local
+// destructors or during static destruction still have somewhere to go.
+struct Pool {
+  FreeList free_lists[kNumSizeClasses];
+  std::atomic<int64_t> cached_bytes{0};
+
+  AtomicStat allocation;
+  AtomicStat segment;
+  AtomicStat allocated_bytes;
+  AtomicStat reserved_bytes;
+  std::atomic<int64_t> num_cache_hits{0};
+  std::atomic<int64_t> num_cache_misses{0};
+  std::atomic<int64_t> num_uncached_allocs{0};
+
+  void* new_block(size_t size_class, size_t size) {
+    void* base = alloc_cpu(size + kHeaderSize);
+    auto* header = static_cast<BlockHeader*>(base);
+    header->size_class = size_class;
+    header->size = size;
+    segment.increase(1);
+    reserved_bytes.increase(size);
+    return base;
+  }
+
+  void release_block(void* base) {
+    segment.decrease(1);
+    reserved_bytes.decrease(static_cast<BlockHeader*>(base)->size);
+    free_cpu(base);
+  }
+
+  // Moves up to max_blocks blocks of the class into out, returns the number
+  // of blocks moved.
+  size_t pop(size_t size_class, size_t max_blocks, std::vector<void*>& out) {
+    auto& free_list = free_lists[size_class];
+    std::lock_guard<std::mutex> guard(free_list.mutex);
+    const size_t n = std::min(max_blocks, free_list.blocks.size());
+    out.insert(out.end(), free_list.blocks.end() - n, free_list.blocks.end());
+    free_list.blocks.resize(free_list.blocks.size() - n);
+    cached_bytes.fetch_sub(
+        n * class_size(size_class), std::memory_order_relaxed);
+    return n;
+  }
+
+  // Caches the first (least recently freed) n blocks of in and removes them
+  // from it
+  void push(size_t size_class, std::vector<void*>& in, size_t n) {
+    const int64_t size = class_size(size_class);
+    const int64_t max_cached =
+        FLAGS_caffe2_cpu_caching_allocator_max_cached_bytes;
+    auto& free_list = free_lists[size_class];
+    size_t cached = n;
+    {
+      std::lock_guard<std::mutex> guard(free_list.mutex);
+      if (max_cached > 0) {
+        const int64_t room =
+            max_cached - cached_bytes.load(std::memory_order_relaxed);
+        cached = std::min<size_t>(n, std::max<int64_t>(0, room / size));
+      }
+      free_list.blocks.insert(
+          free_list.blocks.end(), in.begin(), in.begin() + cached);
+      cached_bytes.fetch_add(cached * size, std::memory_order_relaxed);
+    }
+    // over the limit, give the rest back to the system
+    for (size_t i = cached; i < n; ++i) {
+      release_block(in[i]);
+    }
+    in.erase(in.begin(), in.begin() + n);
+  }
+
+  void empty_cache() {
+    for (size_t i = 0; i < kNumSizeClasses; ++i) {
+      std::vector<void*> blocks;
+      {
+        std::lock_guard<std::mutex> guard(free_lists[i].mutex);
+        blocks.swap(free_lists[i].blocks);
+      }
+      cached_bytes.fetch_sub(
+          blocks.size() * class_size(i), std::memory_order_relaxed);
+      for (void* base : blocks) {
+        release_block(base);
+      }
+    }
+  }
+};
+
+Pool& pool() {
+  static Pool* pool_ = new Pool();
+  return *pool_;
+}
+
+struct ThreadCache {
+  std::vector<void*> free_lists[kNumSizeClasses];
+
+  ~ThreadCache();
+};
+
+// Lets deallocations that happen after the thread cache is destroyed (e.g.
+// from other thread local destructors) go to the global free lists.
+enum class ThreadCacheState : uint8_t { UNINITIALIZED, ALIVE, DESTROYED };
+thread_local ThreadCacheState thread_cache_state =
+    ThreadCacheState::UNINITIALIZED;
+
+ThreadCache::~ThreadCache() {
+  thread_cache_state = ThreadCacheState::DESTROYED;
+  for (size_t i = 0; i < kNumSizeClasses; ++i) {
+    pool().push(i, free_lists[i], free_lists[i].size());
+  }
+}
+
+ThreadCache* thread_cache() {
+  if (thread_cache_state == ThreadCacheState::DESTROYED) {
+    return nullptr;
+  }
+  thread_local ThreadCache cache;
+  thread_cache_state = ThreadCacheState::ALIVE;
+  return &cache;
+}
+
+void fill(void* data, size_t nbytes) {
+  if (FLAGS_caffe2_cpu_allocator_do_zero_fill) {
+    memset(data, 0, nbytes);
+  } else if (FLAGS_caffe2_cpu_allocator_do_junk_fill) {
+    memset_junk(data, nbytes);
+  }
+}
+
+void* allocate_block(size_t nbytes) {
+  CAFFE_ENFORCE(
+      ((ptrdiff_t)nbytes) >= 0,
+      "SizeClassCPUAllocator: allocate() seems to have been called with "
+      "negative number: ",
+      nbytes);
+  auto& p = pool();
+  void* base = nullptr;
+  size_t size = nbytes;
+  if (nbytes > kMaxCachedSize) {
+    base = p.new_block(kUncached, nbytes);
+    p.num_uncached_allocs.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    const size_t size_class = size_class_index(nbytes);
+    size = class_size(size_class);
+    const size_t limit = thread_cache_limit(size);
+    ThreadCache* cache = limit > 0 ? thread_cache() : nullptr;
+    if (cache) {
+      auto& free_list = cache->free_lists[size_class];
+      // refill half of the thread cache with one lock
+      if (free_list.empty()) {
+        p.pop(size_class, std::max<size_t>(1, limit / 2), free_list);
+      }
+      if (!free_list.empty()) {
+        base = free_list.back();
+        free_list.pop_back();
+      }
+    } else {
+      std::vector<void*> blocks;
+      if (p.pop(size_class, 1, blocks) == 1) {
+        base = blocks.back();
+      }
+    }
+    if (base) {
+      p.num_cache_hits.fetch_add(1, std::memory_order_relaxed);
+      fill(static_cast<char*>(base) + kHeaderSize, nbytes);
+    } else {
+      p.num_cache_misses.fetch_add(1, std::memory_order_relaxed);
+      base = p.new_block(size_class, size);
+    }
+  }
+  p.allocation.increase(1);
+  p.allocated_bytes.increase(size);
+  return static_cast<char*>(base) + kHeaderSize;
+}
+
+void free_block(void* data) {
+  auto& p = pool();
+  void* base = static_cast<char*>(data) - kHeaderSize;
+  const auto* header = static_cast<BlockHeader*>(base);
+  const size_t size_class = header->size_class;
+  p.allocation.decrease(1);
+  p.allocated_bytes.decrease(header->size);
+  if (size_class == kUncached) {
+    p.release_block(base);
+    return;
+  }
+  const size_t limit = thread_cache_limit(header->size);
+  ThreadCache* cache = limit > 0 ? thread_cache() : nullptr;
+  if (cache) {
+    auto& free_list = cache->free_lists[size_class];
+    free_list.push_back(base);
+    // hand half of the blocks to other threads with one lock
+    if (free_list.size() > limit) {
+      p.push(size_class, free_list, free_list.size() - limit / 2);
+    }
+  } else {
+    std::vector<void*> blocks{base};
+    p.push(size_class, blocks, 1);
+  }
+}
+
+struct SizeClassCPUAllocatorImpl final : at::Allocator {
+  at::DataPtr allocate(size_t nbytes) const override {
+    if (nbytes == 0) {
+      return {nullptr, nullptr, &ReportAndDelete, at::Device(DeviceType::CPU)};
+    }
+    void* data = allocate_block(nbytes);
+    profiledCPUMemoryReporter().New(data, nbytes);
+    return {data, data, &ReportAndDelete, at::Device(DeviceType::CPU)};
+  }
+
+  static void ReportAndDelete(void* ptr) {
+    if (!ptr) {
+      return;
+    }
+    profiledCPUMemoryReporter().Delete(ptr);
+    free_block(ptr);
+  }
+
+  at::DeleterFnPtr raw_deleter() const override {
+    return &ReportAndDelete;
+  }
+};
+
+SizeClassCPUAllocatorImpl allocator;
+
+// Registered with a higher priority than DefaultCPUAllocator so that the
+// order of static initialization doesn't matter
+struct RegisterFromEnv {
+  RegisterFromEnv() {
+    const char* env = std::getenv("PYTORCH_CPU_ALLOCATOR");
+    if (env && strcmp(env, "caching") == 0) {
+      SetCPUAllocator(&allocator, /* priority */ 1);
+    }
+  }
+};
+RegisterFromEnv register_from_env;
+
+} // namespace
+
+at::Allocator* get() {
+  return &allocator;
+}
+
+size_t roundSize(size_t nbytes) {
+  if (nbytes > kMaxCachedSize) {
+    return nbytes;
+  }
+  return class_size(size_class_index(nbytes));
+}
+
+void emptyCache() {
+  ThreadCache* cache = thread_cache();
+  if (cache) {
+    for (auto& free_list : cache->free_lists) {
+      for (void* base : free_list) {
+        pool().release_block(base);
+      }
+      free_list.clear();
+    }
+  }
+  pool().empty_cache();
+}
+
+CPUAllocatorStats getStats() {
+  auto& p = pool();
+  CPUAllocatorStats stats;
+  stats.allocation = p.allocation.get();
+  stats.segment = p.segment.get();
+  stats.allocated_bytes = p.allocated_bytes.get();
+  stats.reserved_bytes = p.reserved_bytes.get();
+  stats.num_cache_hits = p.num_cache_hits.load(std::memory_order_relaxed);
+  stats.num_cache_misses = p.num_cache_misses.load(std::memory_order_relaxed);
+  stats.num_uncached_allocs =
+      p.num_uncached_allocs.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void resetAccumulatedStats() {
+  auto& p = pool();
+  p.allocation.reset_accumulated();
+  p.segment.reset_accumulated();
+  p.allocated_bytes.reset_accumulated();
+  p.reserved_bytes.reset_accumulated();
+  p.num_cache_hits.store(0, std::memory_order_relaxed);
+  p.num_cache_misses.store(0, std::memory_order_relaxed);
+  p.num_uncached_allocs.store(0, std::memory_order_relaxed);
+}
+
+void resetPeakStats() {
+  auto& p = pool();
+  p.allocation.reset_peak();
+  p.segment.reset_peak();
+  p.allocated_bytes.reset_peak();
+  p.reserved_bytes.reset_peak();
+}
+
+} // namespace SizeClassCPUAllocator
+} // namespace c10
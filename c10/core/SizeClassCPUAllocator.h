@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <c10/core/Allocator.h>
+#include <c10/macros/Export.h>
+#include <c10/util/Flags.h>
+
+C10_DECLARE_int64(caffe2_cpu_caching_allocator_max_cached_bytes);
+
+namespace c10 {
+
+// Caching CPU allocator for server workloads.
+//
+// Requests are rounded up to a size class (four classes per power of two,
+// from gAlignment bytes up to kMaxCachedSize) and freed blocks are kept for
+// reuse instead of going back to the system through free_cpu. Each thread
+// keeps a small free list per size class, so steady state allocation and
+// deallocation from the same thread doesn't take a lock; blocks that don't
+// fit in the thread cache, or are freed by another thread, go to a global
+// free list per size class. Requests above kMaxCachedSize go straight to
+// alloc_cpu / free_cpu.
+//
+// Unlike the mobile CPUCachingAllocator no guard is needed. The allocator is
+// not used unless it is registered with
+//
+//   c10::SetCPUAllocator(c10::SizeClassCPUAllocator::get(), /*priority*/ 1);
+//
+// or the process is started with PYTORCH_CPU_ALLOCATOR=caching.
+namespace SizeClassCPUAllocator {
+
+// Largest request served from the cache
+constexpr size_t kMaxCachedSize = 64 * 1024 * 1024;
+
+// Mirrors c10::cuda::CUDACachingAllocator::Stat
+struct Stat {
+  int64_t current = 0;
+  int64_t peak = 0;
+  int64_t allocated = 0;
+  int64_t freed = 0;
+};
+
+struct CPUAllocatorStats {
+  // COUNT: allocations requested by client code
+  Stat allocation;
+  // COUNT: number of blocks obtained from alloc_cpu()
+  Stat segment;
+
+  // SUM: bytes handed out to client code, rounded up to the size class
+  Stat allocated_bytes;
+  // SUM: bytes obtained from alloc_cpu(), both cached and in use
+  Stat reserved_bytes;
+
+  // COUNT: allocations served from a thread or global free list
+  int64_t num_cache_hits = 0;
+  // COUNT: cacheable allocations that had to go to alloc_cpu()
+  int64_t num_cache_misses = 0;
+  // COUNT: allocations above kMaxCachedSize
+  int64_t num_uncached_allocs = 0;
+};
+
+C10_API at::Allocator* get();
+
+// Rounds nbytes up to its size class, returns nbytes unchanged above
+// kMaxCachedSize
+C10_API size_t roundSize(size_t nbytes);
+
+// Returns the cached blocks of the global free lists and of the calling
+// thread's free lists to the system. Blocks cached by other threads are only
+// returned when those threads exit.
+C10_API void emptyCache();
+
+C10_API CPUAllocatorStats getStats();
+C10_API void resetAccumulatedStats();
+C10_API void resetPeakStats();
+
+} // namespace SizeClassCPUAllocator
+} // namespace c10
@@ -8,6 +8,7 @@
 #include <c10/core/Backend.h>
 #include <c10/core/CopyBytes.h>
 #include <c10/core/DispatchKeySet.h>
+#include <c10/core/InferenceMode.h>
 #include <c10/core/impl/LocalDispatchKeySet.h>
 #include <c10/core/impl/SizesAndStrides.h>
 #include <c10/core/MemoryFormat.h>
@@ -184,6 +185,21 @@ struct C10_API NamedTensorMetaInterface {
   };
 };
 
+// Fields of TensorImpl that most tensors never use. They live in a block that
+// is only allocated when one of them is set, so that they don't take space in
+// every TensorImpl (see Note [TensorImpl size constraints]).
+struct C10_API ExtraMeta {
+  std::unique_ptr<c10::NamedTensorMetaInterface> named_tensor_meta_ = nullptr;
+
+  std::unique_ptr<ExtraMeta> clone() const {
+    auto extra_meta = std::make_unique<ExtraMeta>();
+    if (named_tensor_meta_) {
+      extra_meta->named_tensor_meta_ = named_tensor_meta_->clone();
+    }
+    return extra_meta;
+  }
+};
+
 // NOTE [ Version Counter Sharing ]
 //
 // Every Tensor has a version counter. Version counters are incremented whenever the
@@ -228,20 +244,39 @@ struct C10_API VariableVersion {
   c10::intrusive_ptr<VersionCounter> version_counter_;
 
  public:
+  // Inference tensors (see InferenceMode) don't allocate a counter at all
+  enum Disabled { DISABLED };
+
+  // A disabled counter is not shared with anything
   bool unique() const {
-    return 1 == version_counter_.use_count();
+    return !enabled() || 1 == version_counter_.use_count();
   }
   // NOTE: As of C++11 and 14, default-constructing a std::atomic variable
   // leaves it in a persistently undefined state. See
   // https://cplusplus.github.io/LWG/issue2334.
   VariableVersion(uint32_t version = 0)
       : version_counter_(c10::make_intrusive<VersionCounter>(version)) {}
+  VariableVersion(Disabled) {}
+
+  bool enabled() const {
+    return version_counter_.defined();
+  }
 
-  void bump() noexcept {
+  void bump() {
+    if (C10_UNLIKELY(!enabled())) {
+      TORCH_CHECK(
+          InferenceMode::is_enabled(),
+          "Inplace update to inference tensor outside InferenceMode is not "
+          "allowed. You can make a clone to get a normal tensor before "
+          "doing inplace update.");
+      return;
+    }
     ++version_counter_->version_;
   }
 
-  uint32_t current_version() const noexcept {
+  uint32_t current_version() const {
+    TORCH_CHECK(
+        enabled(), "Inference tensors do not track version counter.");
     return version_counter_->version_;
   }
 };
@@ -535,6 +570,10 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
     return key_set_.has(DispatchKey::MkldnnCPU);
   }
 
+  bool is_nested() const {
+    return key_set_.has(DispatchKey::NestedTensor);
+  }
+
   bool is_vulkan() const {
     return key_set_.has(DispatchKey::Vulkan);
   }
@@ -958,10 +997,16 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
       TORCH_INTERNAL_ASSERT(named_tensor_meta->slow_dim() == dim());
     }
 #endif
-    named_tensor_meta_ = std::move(named_tensor_meta);
-    if (named_tensor_meta_ == nullptr) {
+    if (named_tensor_meta == nullptr) {
+      if (extra_meta_) {
+        extra_meta_->named_tensor_meta_ = nullptr;
+      }
       key_set_ = key_set_.remove(DispatchKey::Named);
     } else {
+      if (!extra_meta_) {
+        extra_meta_ = std::make_unique<c10::ExtraMeta>();
+      }
+      extra_meta_->named_tensor_meta_ = std::move(named_tensor_meta);
       key_set_ = key_set_.add(DispatchKey::Named);
     }
   }
@@ -970,15 +1015,15 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
    * Return the pointer to named tensor metadata.
    */
   const c10::NamedTensorMetaInterface* named_tensor_meta() const {
-    return named_tensor_meta_.get();
+    return extra_meta_ ? extra_meta_->named_tensor_meta_.get() : nullptr;
   }
 
   c10::NamedTensorMetaInterface* named_tensor_meta() {
-    return named_tensor_meta_.get();
+    return extra_meta_ ? extra_meta_->named_tensor_meta_.get() : nullptr;
   }
 
   bool has_named_tensor_meta() const {
-    return named_tensor_meta_ != nullptr;
+    return named_tensor_meta() != nullptr;
   }
 
 
@@ -1079,10 +1124,18 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
     return version_counter_;
   }
 
-  void bump_version() noexcept {
+  void bump_version() {
     version_counter_.bump();
   }
 
+  /**
+   * Whether the tensor was created in InferenceMode, or is a view of such a
+   * tensor. Inference tensors have no version counter.
+   */
+  bool is_inference() const {
+    return !version_counter_.enabled();
+  }
+
   inline void set_pyobj(PyObject* pyobj) noexcept {
     pyobj_ = pyobj;
   }
@@ -1739,7 +1792,8 @@ private:
   std::unique_ptr<c10::AutogradMetaInterface> autograd_meta_ = nullptr;
 
 protected:
-  std::unique_ptr<c10::NamedTensorMetaInterface> named_tensor_meta_ = nullptr;
+  // Rarely used fields, nullptr until one of them is set (see ExtraMeta)
+  std::unique_ptr<c10::ExtraMeta> extra_meta_ = nullptr;
 
   c10::VariableVersion version_counter_;
 
@@ -1856,7 +1910,7 @@ protected:
   // does NOT include Autograd (historically, it did, but
   // not anymore!)
   //
-  // INVARIANT: named_tensor_meta_ != nullptr  <==>  key_set_.has(DispatchKey::Named)
+  // INVARIANT: named_tensor_meta() != nullptr  <==>  key_set_.has(DispatchKey::Named)
   DispatchKeySet key_set_;
 };
 
@@ -1886,11 +1940,10 @@ protected:
 // Current breakdown:
 //
 //    vtable pointer
-//    strong refcount           TODO: pack these into one word
-//    weak refcount
+//    strong refcount, weak refcount (32 bits each)
 //    storage pointer
 //    autograd metadata pointer
-//    named tensor metadata pointer
+//    extra metadata pointer (named tensor metadata)
 //    version counter pointer
 //    PyObject pointer
 //    SizesAndStrides size/pointer
@@ -1910,7 +1963,7 @@ protected:
 //    DispatchKeySet
 //
 static_assert(sizeof(void*) != sizeof(int64_t) || // if 64-bit...
-              sizeof(TensorImpl) == sizeof(int64_t) * 23,
+              sizeof(TensorImpl) == sizeof(int64_t) * 22,
               "You changed the size of TensorImpl on 64-bit arch."
               "See Note [TensorImpl size constraints] on how to proceed.");
 } // namespace c10
@@ -40,6 +40,9 @@ public:
   Stream getDefaultStream(Device d) const override {
     return impl_->getDefaultStream(d);
   }
+  Stream getStreamFromGlobalPool(Device d, bool isHighPriority = false) const override {
+    return impl_->getStreamFromGlobalPool(d, isHighPriority);
+  }
   Stream exchangeStream(Stream s) const noexcept override {
     return impl_->exchangeStream(s);
   }
@@ -31,6 +31,16 @@ class C10_API TaskThreadPoolBase {
    */
   virtual bool inThreadPool() const = 0;
 
+  /**
+   * Run one queued task on the calling thread, if there is one, and return
+   * whether a task was run. Lets a thread that waits on the tasks of the
+   * pool help with them rather than block. Pools that can't hand out their
+   * tasks return false.
+   */
+  virtual bool runPendingTask() {
+    return false;
+  }
+
   virtual ~TaskThreadPoolBase() noexcept {}
 
   static size_t defaultNumThreads() {
@@ -0,0 +1,169 @@
+#include <c10/core/work_stealing_thread_pool.h>
+
+#include <c10/util/Logging.h>
+
+namespace c10 {
+
+namespace {
+// pool and queue index of the current thread, if it is a worker of a
+// WorkStealingThreadPool
+thread_local const WorkStealingThreadPool* current_pool_ = nullptr;
+thread_local size_t current_queue_ = 0;
+} // namespace
+
+constexpr size_t WorkStealingThreadPool::kQueueCapacity;
+
+WorkStealingThreadPool::WorkStealingThreadPool(
+    int pool_size,
+    int numa_node_id,
+    std::function<void()> init_thread)
+    : threads_(pool_size < 0 ? defaultNumThreads() : pool_size),
+      running_(true),
+      numa_node_id_(numa_node_id) {
+  queues_.reserve(threads_.size());
+  for (size_t i = 0; i < threads_.size(); ++i) {
+    queues_.emplace_back(
+        std::make_unique<detail::BoundedTaskQueue>(kQueueCapacity));
+  }
+  for (size_t i = 0; i < threads_.size(); ++i) {
+    threads_[i] = std::thread([this, i, init_thread]() {
+      if (init_thread) {
+        init_thread();
+      }
+      this->main_loop(i);
+    });
+  }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+  // Set running flag to false then notify all threads.
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    running_ = false;
+    condition_.notify_all();
+  }
+
+  for (auto& t : threads_) {
+    try {
+      t.join();
+    } catch (const std::exception&) {
+    }
+  }
+}
+
+size_t WorkStealingThreadPool::size() const {
+  return threads_.size();
+}
+
+size_t WorkStealingThreadPool::numAvailable() const {
+  return threads_.size() - active_.load();
+}
+
+bool WorkStealingThreadPool::inThreadPool() const {
+  return current_pool_ == this;
+}
+
+void WorkStealingThreadPool::run(std::function<void()> func) {
+  if (threads_.size() == 0) {
+    throw std::runtime_error("No threads to run a task");
+  }
+  // Count the task before it becomes visible, so that a worker dequeuing it
+  // never observes pending_ going below zero.
+  pending_.fetch_add(1);
+
+  const size_t num_queues = queues_.size();
+  const size_t first = current_pool_ == this
+      ? current_queue_
+      : next_queue_.fetch_add(1, std::memory_order_relaxed) % num_queues;
+  bool pushed = false;
+  for (size_t i = 0; i < num_queues && !pushed; ++i) {
+    pushed = queues_[(first + i) % num_queues]->try_push(func);
+  }
+  if (!pushed) {
+    std::lock_guard<std::mutex> guard(overflow_mutex_);
+    overflow_.push(std::move(func));
+    overflow_size_.fetch_add(1);
+  }
+
+  // Workers increment idle_ before checking pending_ under mutex_, so either
+  // they see the new task or we see them idle and wake one up.
+  if (idle_.load() > 0) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    condition_.notify_one();
+  }
+}
+
+bool WorkStealingThreadPool::try_pop(
+    size_t index,
+    std::function<void()>& task) {
+  const size_t num_queues = queues_.size();
+  for (size_t i = 0; i < num_queues; ++i) {
+    if (queues_[(index + i) % num_queues]->try_pop(task)) {
+      pending_.fetch_sub(1);
+      return true;
+    }
+  }
+  if (overflow_size_.load() > 0) {
+    std::lock_guard<std::mutex> guard(overflow_mutex_);
+    if (!overflow_.empty()) {
+      task = std::move(overflow_.front());
+      overflow_.pop();
+      overflow_size_.fetch_sub(1);
+      pending_.fetch_sub(1);
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingThreadPool::run_task(std::function<void()>& task) {
+  try {
+    task();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "Exception in thread pool task: " << e.what();
+  } catch (...) {
+    LOG(ERROR) << "Exception in thread pool task: unknown";
+  }
+  // Destruct the task right away, it might hold shared_ptr arguments
+  // bound via bind.
+  task = nullptr;
+}
+
+bool WorkStealingThreadPool::runPendingTask() {
+  std::function<void()> task;
+  const size_t index = current_pool_ == this ? current_queue_ : 0;
+  if (!try_pop(index, task)) {
+    return false;
+  }
+  run_task(task);
+  return true;
+}
+
+void WorkStealingThreadPool::main_loop(size_t index) {
+  current_pool_ = this;
+  current_queue_ = index;
+
+  std::function<void()> task;
+  while (running_) {
+    if (!try_pop(index, task)) {
+      // A submitter may have counted a task that isn't visible yet; give it
+      // a chance to finish before going to sleep.
+      std::this_thread::yield();
+      if (!try_pop(index, task)) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ++idle_;
+        while (pending_.load() == 0 && running_) {
+          condition_.wait(lock);
+        }
+        --idle_;
+        continue;
+      }
+    }
+
+    ++active_;
+    run_task(task);
+    --active_;
+  }
+}
+
+} // namespace c10
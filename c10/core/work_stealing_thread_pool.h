@@ -0,0 +1,173 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include <c10/core/thread_pool.h>
+#include <c10/util/Exception.h>
+
+namespace c10 {
+
+namespace detail {
+
+// Bounded multi-producer multi-consumer queue of tasks (D. Vyukov's bounded
+// MPMC queue). Every slot carries a sequence number that tells producers and
+// consumers whether it is free or filled, so both ends only need a CAS on
+// their position counter and never take a lock.
+class BoundedTaskQueue {
+ public:
+  // capacity must be a power of two
+  explicit BoundedTaskQueue(size_t capacity)
+      : cells_(new Cell[capacity]), mask_(capacity - 1) {
+    TORCH_INTERNAL_ASSERT(
+        capacity >= 2 && (capacity & (capacity - 1)) == 0,
+        "BoundedTaskQueue capacity must be a power of two");
+    for (size_t i = 0; i < capacity; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  BoundedTaskQueue(const BoundedTaskQueue&) = delete;
+  BoundedTaskQueue& operator=(const BoundedTaskQueue&) = delete;
+
+  // Moves from task and returns true on success, leaves task untouched and
+  // returns false if the queue is full.
+  bool try_push(std::function<void()>& task) {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+      cell = &cells_[pos & mask_];
+      const size_t seq = cell->sequence.load(std::memory_order_acquire);
+      const intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+      if (dif == 0) {
+        if (enqueue_pos_.compare_exchange_weak(
+                pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (dif < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->task = std::move(task);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool try_pop(std::function<void()>& task) {
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+      cell = &cells_[pos & mask_];
+      const size_t seq = cell->sequence.load(std::memory_order_acquire);
+      const intptr_t dif = (intptr_t)seq - (intptr_t)(pos + 1);
+      if (dif == 0) {
+        if (dequeue_pos_.compare_exchange_weak(
+                pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (dif < 0) {
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    task = std::move(cell->task);
+    cell->task = nullptr;
+    cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    std::function<void()> task;
+  };
+
+  std::unique_ptr<Cell[]> cells_;
+  const size_t mask_;
+  // keep the producer and consumer positions on separate cache lines
+  std::atomic<size_t> enqueue_pos_{0};
+  char padding_[64 - sizeof(std::atomic<size_t>)];
+  std::atomic<size_t> dequeue_pos_{0};
+};
+
+} // namespace detail
+
+// Thread pool in which every worker owns a lock-free task queue. Tasks
+// submitted from outside the pool are spread over the worker queues round
+// robin, tasks submitted from a worker go to its own queue, and a worker whose
+// queue is empty steals from the queues of the other workers before it goes
+// to sleep. Unlike ThreadPool, submitting and dequeuing a task doesn't go
+// through a single mutex, which matters when many threads run parallel
+// primitives at the same time. A mutex guarded overflow queue is only used
+// once every worker queue is full.
+class C10_API WorkStealingThreadPool : public c10::TaskThreadPoolBase {
+ public:
+  // Capacity of each worker queue
+  static constexpr size_t kQueueCapacity = 1024;
+
+  WorkStealingThreadPool() = delete;
+
+  explicit WorkStealingThreadPool(
+      int pool_size,
+      int numa_node_id = -1,
+      std::function<void()> init_thread = nullptr);
+
+  ~WorkStealingThreadPool();
+
+  size_t size() const override;
+
+  size_t numAvailable() const override;
+
+  bool inThreadPool() const override;
+
+  void run(std::function<void()> func) override;
+
+  // Takes from the queue of the calling worker first, if it is one. The
+  // task doesn't count towards numAvailable(), as a worker helping from
+  // within a task is busy already.
+  bool runPendingTask() override;
+
+ private:
+  // Pops from the queue of worker `index` first, then steals from the other
+  // workers, then falls back to the overflow queue.
+  bool try_pop(size_t index, std::function<void()>& task);
+
+  // Runs a dequeued task, logging the exceptions it throws
+  void run_task(std::function<void()>& task);
+
+  // @brief Entry point for pool threads.
+  void main_loop(size_t index);
+
+  std::vector<std::unique_ptr<detail::BoundedTaskQueue>> queues_;
+  std::vector<std::thread> threads_;
+
+  std::mutex overflow_mutex_;
+  std::queue<std::function<void()>> overflow_;
+  std::atomic<size_t> overflow_size_{0};
+
+  // round robin position for tasks submitted from outside the pool
+  std::atomic<size_t> next_queue_{0};
+  // tasks submitted but not dequeued yet
+  std::atomic<size_t> pending_{0};
+  // workers running a task
+  std::atomic<size_t> active_{0};
+  // workers sleeping, or about to sleep, on condition_
+  std::atomic<size_t> idle_{0};
+  std::atomic_bool running_;
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  int numa_node_id_;
+};
+
+} // namespace c10
@@ -3,21 +3,39 @@
 #include <c10/cuda/CUDAGuard.h>
 #include <c10/cuda/CUDAException.h>
 #include <c10/cuda/CUDAFunctions.h>
+#include <c10/util/Backtrace.h>
+#include <c10/util/Optional.h>
 #include <c10/util/UniqueVoidPtr.h>
+#include <c10/util/hash.h>
 
 #include <cuda_runtime_api.h>
 #include <algorithm>
+#include <atomic>
 #include <bitset>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <deque>
+#include <fstream>
+#include <iostream>
 #include <iterator>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+// The virtual memory management entry points of the driver are looked up
+// through cudaGetDriverEntryPoint, which appeared in CUDA 11.3.
+#if !defined(__HIP_PLATFORM_HCC__) && defined(CUDART_VERSION) && \
+    CUDART_VERSION >= 11030
+#define C10_CUDA_HAS_EXPANDABLE_SEGMENTS
+#include <cuda.h>
+#endif
+
 namespace c10 {
 
 C10_DEFINE_REGISTRY(FreeCudaMemoryCallbacksRegistry, FreeMemoryCallback);
@@ -51,6 +69,52 @@ namespace CUDACachingAllocator {
 // ensure that the block is not reused before each recorded stream completes
 // work.
 //
+// Expandable segments (PYTORCH_CUDA_EXPANDABLE_SEGMENTS=1):
+//
+// With variable-sized requests the fixed-size cudaMalloc segments above can
+// fragment badly: freed memory is split across segments and no single free
+// block can hold the next request. In this mode, the allocator instead
+// reserves a virtual address range as large as the device for each stream
+// and pool, and backs it with physical pages (cuMemCreate/cuMemMap) only as
+// it grows. New pages are mapped right after the free block at the end of
+// what is already in use, so that blocks coalesce across what would have
+// been segment boundaries. emptyCache() and the OOM retry unmap the whole
+// pages covered by free blocks instead of freeing whole segments, so memory
+// is returned even when a segment is still partly in use.
+//
+// Unmapped parts of a segment are kept as Blocks with mapped == false in a
+// separate set of their pool, so that the usual split/merge logic applies to
+// them too.
+// Memory from expandable segments cannot be shared through CUDA IPC.
+//
+// Private pools:
+//
+// Streams can be routed to a private pool with beginAllocateToPool(). Their
+// allocations are then served from, and returned to, that pool's own large
+// and small block pools, which the rest of the process never reuses. This
+// gives latency-critical streams a reserve that other streams cannot
+// fragment, and keeps the memory of a captured CUDA graph out of reach of
+// later allocations. A pool lives until its last reference is released;
+// routing a stream holds a reference. Its cached memory is kept until then,
+// even across emptyCache(), and is returned by the next emptyCache() or OOM
+// retry once the pool is released and all its blocks are free.
+//
+// While a routed stream is being captured, the allocator neither queries
+// events nor returns memory to the driver, both of which are illegal during
+// capture. End-of-life events of blocks freed meanwhile are recorded once
+// the capture ends.
+//
+// Allocation traces:
+//
+// recordHistory() makes each device allocator keep its most recent
+// allocations, frees and segment (un)mappings in a fixed-size ring buffer.
+// An entry stores only sizes, the stream and a 32-bit id of its call stack:
+// stacks are captured as raw return addresses, interned once in a
+// process-wide table and symbolized only when they are read, so recording
+// stays cheap enough to leave enabled in production. When an allocation
+// fails with history enabled, the buffer is written to the configured file
+// (or to stderr) before the out of memory error is raised.
+//
 
 
 namespace {
@@ -97,9 +161,78 @@ void update_stat_array(StatArray& stat_array, int64_t amount, const StatTypes& s
   }
 }
 
+// Interns raw call stacks of trace entries; ids start at 1, 0 means none.
+class StackTable {
+ public:
+  // Bounds the memory held by stacks that are never released.
+  static constexpr size_t kMaxStacks = 65536;
+
+  uint32_t intern(std::vector<void*> frames) {
+    if (frames.empty()) {
+      return 0;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = ids_.find(frames);
+    if (it != ids_.end()) {
+      return it->second;
+    }
+    if (stacks_.size() >= kMaxStacks) {
+      return 0;
+    }
+    stacks_.push_back(frames);
+    const uint32_t id = static_cast<uint32_t>(stacks_.size());
+    ids_.emplace(std::move(frames), id);
+    return id;
+  }
+
+  std::vector<void*> get(uint32_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (id == 0 || id > stacks_.size()) {
+      return {};
+    }
+    return stacks_[id - 1];
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<std::vector<void*>> stacks_;
+  std::unordered_map<std::vector<void*>, uint32_t, c10::hash<std::vector<void*>>> ids_;
+};
+
+StackTable& stackTable() {
+  static StackTable table;
+  return table;
+}
+
+const char* traceActionName(TraceEntry::Action action) {
+  switch (action) {
+    case TraceEntry::ALLOC: return "alloc";
+    case TraceEntry::FREE: return "free";
+    case TraceEntry::SEGMENT_ALLOC: return "segment_alloc";
+    case TraceEntry::SEGMENT_FREE: return "segment_free";
+    case TraceEntry::SEGMENT_MAP: return "segment_map";
+    case TraceEntry::SEGMENT_UNMAP: return "segment_unmap";
+    case TraceEntry::OOM: return "oom";
+  }
+  return "unknown";
+}
+
 struct Block;
+struct PrivatePool;
 typedef bool (*Comparison)(const Block*, const Block*);
-typedef std::set<Block*, Comparison> BlockPool;
+
+struct BlockPool {
+  BlockPool(Comparison comparator, bool small, PrivatePool* private_pool = nullptr) :
+    blocks(comparator), unmapped(comparator), is_small(small),
+    owner_PrivatePool(private_pool) { }
+
+  std::set<Block*, Comparison> blocks;   // free, mapped blocks
+  std::set<Block*, Comparison> unmapped; // unmapped parts of expandable segments
+  const bool is_small;
+  PrivatePool* owner_PrivatePool;        // nullptr for the default pools
+};
+
+class ExpandableSegment;
 
 struct Block {
   int           device;      // gpu
@@ -112,15 +245,19 @@ struct Block {
   Block*        prev;        // prev block if split from a larger allocation
   Block*        next;        // next block if split from a larger allocation
   int           event_count; // number of outstanding CUDA events
+  bool          mapped;      // false for unbacked parts of expandable segments
+  ExpandableSegment* expandable_segment; // owning segment, if expandable
 
   Block(int device, cudaStream_t stream, size_t size, BlockPool* pool, void* ptr) :
     device(device), stream(stream), stream_uses(), size(size), pool(pool),
-    ptr(ptr), allocated(0), prev(nullptr), next(nullptr), event_count(0) { }
+    ptr(ptr), allocated(0), prev(nullptr), next(nullptr), event_count(0),
+    mapped(true), expandable_segment(nullptr) { }
 
   // constructor for search key
   Block(int device, cudaStream_t stream, size_t size) :
     device(device), stream(stream), stream_uses(), size(size), pool(nullptr),
-    ptr(nullptr), allocated(0), prev(nullptr), next(nullptr), event_count(0) { }
+    ptr(nullptr), allocated(0), prev(nullptr), next(nullptr), event_count(0),
+    mapped(true), expandable_segment(nullptr) { }
 
   bool is_split() const {
     return (prev != nullptr) || (next != nullptr);
@@ -157,6 +294,250 @@ static std::string format_size(uint64_t size) {
   return os.str();
 }
 
+static size_t round_up(size_t size, size_t multiple) {
+  return multiple * ((size + multiple - 1) / multiple);
+}
+
+// Returns whether PYTORCH_CUDA_EXPANDABLE_SEGMENTS asks for expandable
+// segments. They are only used on devices that support virtual memory
+// management; see expandableSegmentPageSize.
+bool expandableSegmentsRequested() {
+  static bool requested = [] {
+    const char* env = getenv("PYTORCH_CUDA_EXPANDABLE_SEGMENTS");
+    return env != nullptr && strcmp(env, "0") != 0;
+  }();
+  return requested;
+}
+
+#ifdef C10_CUDA_HAS_EXPANDABLE_SEGMENTS
+
+// Driver entry points used by expandable segments. They are resolved through
+// the runtime so that c10_cuda does not need to link against libcuda.
+struct DriverAPI {
+  decltype(&cuGetErrorString) getErrorString;
+  decltype(&cuDeviceGetAttribute) deviceGetAttribute;
+  decltype(&cuMemGetAllocationGranularity) memGetAllocationGranularity;
+  decltype(&cuMemAddressReserve) memAddressReserve;
+  decltype(&cuMemAddressFree) memAddressFree;
+  decltype(&cuMemCreate) memCreate;
+  decltype(&cuMemRelease) memRelease;
+  decltype(&cuMemMap) memMap;
+  decltype(&cuMemUnmap) memUnmap;
+  decltype(&cuMemSetAccess) memSetAccess;
+};
+
+// Returns nullptr if the driver does not provide the entry points.
+const DriverAPI* getDriverAPI() {
+  static DriverAPI api;
+  static bool available = [] {
+    auto lookup = [](const char* name, auto& fn) {
+      void* ptr = nullptr;
+      if (cudaGetDriverEntryPoint(name, &ptr, cudaEnableDefault) !=
+              cudaSuccess ||
+          ptr == nullptr) {
+        cudaGetLastError();
+        return false;
+      }
+      fn = reinterpret_cast<std::remove_reference_t<decltype(fn)>>(ptr);
+      return true;
+    };
+    return lookup("cuGetErrorString", api.getErrorString) &&
+        lookup("cuDeviceGetAttribute", api.deviceGetAttribute) &&
+        lookup(
+               "cuMemGetAllocationGranularity",
+               api.memGetAllocationGranularity) &&
+        lookup("cuMemAddressReserve", api.memAddressReserve) &&
+        lookup("cuMemAddressFree", api.memAddressFree) &&
+        lookup("cuMemCreate", api.memCreate) &&
+        lookup("cuMemRelease", api.memRelease) &&
+        lookup("cuMemMap", api.memMap) &&
+        lookup("cuMemUnmap", api.memUnmap) &&
+        lookup("cuMemSetAccess", api.memSetAccess);
+  }();
+  return available ? &api : nullptr;
+}
+
+#define C10_CUDA_DRIVER_CHECK(EXPR)                                   \
+  do {                                                                \
+    CUresult __err = EXPR;                                            \
+    if (__err != CUDA_SUCCESS) {                                      \
+      const char* __err_str = nullptr;                                \
+      getDriverAPI()->getErrorString(__err, &__err_str);              \
+      TORCH_CHECK(                                                    \
+          false,                                                      \
+          "CUDA driver error: ",                                      \
+          __err_str ? __err_str : "unknown error");                   \
+    }                                                                 \
+  } while (0)
+
+CUmemAllocationProp pinnedDeviceProp(int device) {
+  CUmemAllocationProp prop = {};
+  prop.type = CU_MEM_ALLOCATION_TYPE_PINNED;
+  prop.location.type = CU_MEM_LOCATION_TYPE_DEVICE;
+  prop.location.id = device;
+  return prop;
+}
+
+#endif // C10_CUDA_HAS_EXPANDABLE_SEGMENTS
+
+// Returns the page size expandable segments use on device, or 0 if the
+// device or driver does not support virtual memory management.
+size_t expandableSegmentPageSize(int device) {
+#ifdef C10_CUDA_HAS_EXPANDABLE_SEGMENTS
+  const DriverAPI* driver = getDriverAPI();
+  if (!driver) {
+    return 0;
+  }
+  int supported = 0;
+  if (driver->deviceGetAttribute(
+          &supported,
+          CU_DEVICE_ATTRIBUTE_VIRTUAL_ADDRESS_MANAGEMENT_SUPPORTED,
+          device) != CUDA_SUCCESS ||
+      !supported) {
+    return 0;
+  }
+  const CUmemAllocationProp prop = pinnedDeviceProp(device);
+  size_t granularity = 0;
+  C10_CUDA_DRIVER_CHECK(driver->memGetAllocationGranularity(
+      &granularity, &prop, CU_MEM_ALLOC_GRANULARITY_RECOMMENDED));
+  return round_up(kSmallBuffer, granularity);
+#else
+  return 0;
+#endif
+}
+
+// A virtual address range reserved up front whose pages are backed with
+// physical memory on demand. Offsets and sizes passed to map and unmap must
+// be multiples of the page size.
+class ExpandableSegment {
+ public:
+  ExpandableSegment(
+      int device,
+      cudaStream_t stream,
+      size_t size,
+      size_t page_size)
+      : device_(device),
+        stream_(stream),
+        page_size_(page_size),
+        pages_(size / page_size) {
+#ifdef C10_CUDA_HAS_EXPANDABLE_SEGMENTS
+    C10_CUDA_DRIVER_CHECK(getDriverAPI()->memAddressReserve(
+        &base_, pages_.size() * page_size_, page_size_, 0, 0));
+#else
+    TORCH_INTERNAL_ASSERT(false, "expandable segments are not supported");
+#endif
+  }
+
+  // Segments are only released once all of their pages are unmapped.
+  ~ExpandableSegment() {
+#ifdef C10_CUDA_HAS_EXPANDABLE_SEGMENTS
+    if (getDriverAPI()->memAddressFree(base_, size()) != CUDA_SUCCESS) {
+      TORCH_WARN("Failed to free the address range of an expandable segment");
+    }
+#endif
+  }
+
+  char* ptr() const {
+    return reinterpret_cast<char*>(base_);
+  }
+
+  size_t size() const {
+    return pages_.size() * page_size_;
+  }
+
+  size_t page_size() const {
+    return page_size_;
+  }
+
+  // Backs [offset, offset + size) with physical memory. Returns
+  // cudaErrorMemoryAllocation, leaving the range unbacked, if the device is
+  // out of memory; throws on any other error.
+  cudaError_t map(size_t offset, size_t size) {
+#ifdef C10_CUDA_HAS_EXPANDABLE_SEGMENTS
+    const DriverAPI* driver = getDriverAPI();
+    const CUmemAllocationProp prop = pinnedDeviceProp(device_);
+    const size_t begin = offset / page_size_;
+    const size_t end = (offset + size) / page_size_;
+    for (size_t i = begin; i < end; ++i) {
+      TORCH_INTERNAL_ASSERT(!pages_[i]);
+      CUmemGenericAllocationHandle handle;
+      CUresult status = driver->memCreate(&handle, page_size_, &prop, 0);
+      if (status == CUDA_ERROR_OUT_OF_MEMORY) {
+        for (size_t j = begin; j < i; ++j) {
+          C10_CUDA_DRIVER_CHECK(driver->memRelease(*pages_[j]));
+          pages_[j] = c10::nullopt;
+        }
+        return cudaErrorMemoryAllocation;
+      }
+      C10_CUDA_DRIVER_CHECK(status);
+      pages_[i] = handle;
+    }
+    for (size_t i = begin; i < end; ++i) {
+      C10_CUDA_DRIVER_CHECK(driver->memMap(
+          base_ + i * page_size_, page_size_, 0, *pages_[i], 0));
+    }
+    CUmemAccessDesc desc = {};
+    desc.location = prop.location;
+    desc.flags = CU_MEM_ACCESS_FLAGS_PROT_READWRITE;
+    C10_CUDA_DRIVER_CHECK(
+        driver->memSetAccess(base_ + offset, size, &desc, 1));
+    return cudaSuccess;
+#else
+    return cudaErrorNotSupported;
+#endif
+  }
+
+  // Returns the physical memory behind [offset, offset + size) to the
+  // device, once the segment's stream is done with it.
+  void unmap(size_t offset, size_t size) {
+#ifdef C10_CUDA_HAS_EXPANDABLE_SEGMENTS
+    const DriverAPI* driver = getDriverAPI();
+    CUDAGuard device_guard(device_);
+    C10_CUDA_CHECK(cudaStreamSynchronize(stream_));
+    const size_t end = (offset + size) / page_size_;
+    for (size_t i = offset / page_size_; i < end; ++i) {
+      if (pages_[i]) {
+        C10_CUDA_DRIVER_CHECK(
+            driver->memUnmap(base_ + i * page_size_, page_size_));
+        C10_CUDA_DRIVER_CHECK(driver->memRelease(*pages_[i]));
+        pages_[i] = c10::nullopt;
+      }
+    }
+#endif
+  }
+
+ private:
+  int device_;
+  cudaStream_t stream_;
+  size_t page_size_;
+#ifdef C10_CUDA_HAS_EXPANDABLE_SEGMENTS
+  CUdeviceptr base_ = 0;
+  std::vector<c10::optional<CUmemGenericAllocationHandle>> pages_;
+#else
+  uintptr_t base_ = 0;
+  std::vector<c10::optional<uint64_t>> pages_;
+#endif
+};
+
+// Large and small block pools of a private pool; see the note on top.
+struct PrivatePool {
+  PrivatePool() :
+    use_count(1),
+    segment_count(0),
+    large_blocks(BlockComparator, false, this),
+    small_blocks(BlockComparator, true, this) { }
+  PrivatePool(const PrivatePool&) = delete;
+  PrivatePool& operator=(const PrivatePool&) = delete;
+
+  // number of references: pool handles, CUDA graphs and routed streams
+  int use_count;
+  // number of live segments; the pool is destroyed once it is released and
+  // this drops to zero
+  int segment_count;
+  BlockPool large_blocks;
+  BlockPool small_blocks;
+};
+
 struct AllocParams {
   AllocParams(int device, size_t size, cudaStream_t stream, BlockPool* pool, size_t alloc_size,
               DeviceStats& stats) :
@@ -196,6 +577,26 @@ class DeviceCachingAllocator {
   // unallocated cached blocks 1 MB or smaller
   BlockPool small_blocks;
 
+  // private pools by id
+  std::map<MempoolId_t, std::unique_ptr<PrivatePool>> private_pools;
+
+  // released private pools whose memory can be returned to the driver
+  std::map<MempoolId_t, PrivatePool*> private_pools_freeable;
+
+  // streams routed to a private pool
+  struct PoolRouting {
+    MempoolId_t mempool_id;
+    PrivatePool* pool;
+    bool capturing;
+  };
+  std::unordered_map<cudaStream_t, PoolRouting> routed_streams;
+
+  // number of routed streams that are being captured into a CUDA graph
+  int captures_underway = 0;
+
+  // blocks freed during capture whose end-of-life events are not recorded yet
+  std::vector<Block*> needs_events_deferred_until_no_capture;
+
   // allocated or in use by a stream
   std::unordered_set<Block*> active_blocks;
 
@@ -209,11 +610,28 @@ class DeviceCachingAllocator {
 
   bool set_fraction = false;
 
+  // whether the first allocation checked for expandable segments support
+  bool expandable_segments_checked = false;
+
+  // page size of expandable segments, or 0 if they are not used
+  size_t expandable_page_size = 0;
+
+  // virtual address range reserved by each expandable segment
+  size_t expandable_reserve_size = 0;
+
+  // ring buffer of recent allocator events; see the note on top
+  bool record_history = false;
+  std::vector<TraceEntry> trace;
+  size_t trace_next = 0;
+  size_t trace_max_entries = 0;
+  size_t trace_stack_depth = 0;
+  std::string trace_oom_dump_path;
+
  public:
 
   DeviceCachingAllocator() :
-      large_blocks(BlockComparator),
-      small_blocks(BlockComparator) {}
+      large_blocks(BlockComparator, false),
+      small_blocks(BlockComparator, true) {}
 
   // All public methods (except the above) acquire the allocator mutex.
   // Thus, do not call a public method from another public method.
@@ -222,11 +640,13 @@ class DeviceCachingAllocator {
   {
     std::unique_lock<std::recursive_mutex> lock(mutex);
 
-    // process outstanding cudaEvents
-    process_events();
+    // process outstanding cudaEvents; querying them is illegal during capture
+    if (captures_underway == 0) {
+      process_events();
+    }
 
     size = round_size(size);
-    auto& pool = get_pool(size);
+    auto& pool = get_pool(size, stream);
     const size_t alloc_size = get_allocation_size(size);
     AllocParams params(device, size, stream, &pool, alloc_size, stats);
     params.stat_types[static_cast<size_t>(StatType::AGGREGATE)] = true;
@@ -240,7 +660,7 @@ class DeviceCachingAllocator {
       // Attempt allocate
       || alloc_block(params, false)
       // Free all non-split cached blocks and retry alloc.
-      || (free_cached_blocks() && alloc_block(params, true));
+      || (captures_underway == 0 && free_cached_blocks() && alloc_block(params, true));
 
     if (!block_found) {
       // For any error code other than cudaErrorMemoryAllocation,
@@ -258,6 +678,11 @@ class DeviceCachingAllocator {
 
       stats.num_ooms += 1;
 
+      if (record_history) {
+        record_trace(TraceEntry::OOM, device, nullptr, alloc_size, stream);
+        dump_trace(device);
+      }
+
       // "total capacity": total global memory on GPU
       // "allowed": memory is allowed to use, which set by fraction.
       // "already allocated": memory allocated by the program using the
@@ -299,6 +724,7 @@ class DeviceCachingAllocator {
       remaining = block;
 
       block = new Block(device, stream, size, &pool, block->ptr);
+      block->expandable_segment = remaining->expandable_segment;
       block->prev = remaining->prev;
       if (block->prev) {
         block->prev->next = block;
@@ -308,7 +734,7 @@ class DeviceCachingAllocator {
       remaining->prev = block;
       remaining->ptr = static_cast<char*>(remaining->ptr) + size;
       remaining->size -= size;
-      pool.insert(remaining);
+      pool.blocks.insert(remaining);
 
       if (already_split) {
         // An already-split inactive block is being shrunk by size bytes.
@@ -336,6 +762,7 @@ class DeviceCachingAllocator {
     update_stat_array(stats.active, 1, params.stat_types);
     update_stat_array(stats.active_bytes, block->size, params.stat_types);
 
+    record_trace(TraceEntry::ALLOC, device, block->ptr, block->size, stream);
     return block;
   }
 
@@ -344,6 +771,7 @@ class DeviceCachingAllocator {
     std::lock_guard<std::recursive_mutex> lock(mutex);
 
     block->allocated = false;
+    record_trace(TraceEntry::FREE, block->device, block->ptr, block->size, block->stream);
 
     c10::reportMemoryUsageToProfiler(
         block, -block->size, c10::Device(c10::DeviceType::CUDA, block->device));
@@ -355,7 +783,13 @@ class DeviceCachingAllocator {
     update_stat_array(stats.allocated_bytes, -block->size, {stat_types});
 
     if (!block->stream_uses.empty()) {
-      insert_events(block);
+      if (captures_underway > 0) {
+        // Recording the end-of-life events now would capture them into the
+        // graph, and they could not be queried until the capture ends.
+        needs_events_deferred_until_no_capture.push_back(block);
+      } else {
+        insert_events(block);
+      }
     } else {
       free_block(block);
     }
@@ -400,9 +834,55 @@ class DeviceCachingAllocator {
   /** returns cached blocks to the system allocator **/
   void emptyCache() {
     std::lock_guard<std::recursive_mutex> lock(mutex);
+    TORCH_CHECK(captures_underway == 0,
+                "emptyCache() cannot be called while a CUDA graph is being captured");
     free_cached_blocks();
   }
 
+  /** takes a reference to a private pool, creating it if needed **/
+  void retainPool(MempoolId_t mempool_id) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    retain_pool(mempool_id);
+  }
+
+  /** drops a reference to a private pool **/
+  void releasePool(MempoolId_t mempool_id) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    release_pool(mempool_id);
+  }
+
+  /** routes the allocations made on stream to a private pool **/
+  void beginAllocateToPool(MempoolId_t mempool_id, cudaStream_t stream) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    TORCH_CHECK(routed_streams.find(stream) == routed_streams.end(),
+                "beginAllocateToPool: the stream already allocates to a private pool");
+    PrivatePool* pool = retain_pool(mempool_id);
+    bool capturing = false;
+#ifndef __HIP_PLATFORM_HCC__
+    cudaStreamCaptureStatus status;
+    C10_CUDA_CHECK(cudaStreamIsCapturing(stream, &status));
+    capturing = (status == cudaStreamCaptureStatusActive);
+#endif
+    routed_streams.emplace(stream, PoolRouting{mempool_id, pool, capturing});
+    if (capturing) {
+      captures_underway++;
+    }
+  }
+
+  /** routes the allocations made on stream back to the default pools **/
+  void endAllocateToPool(cudaStream_t stream) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    auto it = routed_streams.find(stream);
+    TORCH_CHECK(it != routed_streams.end(),
+                "endAllocateToPool: the stream does not allocate to a private pool");
+    const PoolRouting routing = it->second;
+    routed_streams.erase(it);
+    if (routing.capturing) {
+      captures_underway--;
+    }
+    release_pool(routing.mempool_id);
+  }
+
   /** Retrieves info (total size + largest block) of the memory cache **/
   void cacheInfo(size_t* total, size_t* largest)
   {
@@ -412,8 +892,8 @@ class DeviceCachingAllocator {
       cudaMemGetInfo(largest,  // Use free memory as an optimistic initial guess of *largest
                      &tmp_bytes);
     }
-    cache_info_aux(large_blocks, total, largest);
-    cache_info_aux(small_blocks, total, largest);
+    cache_info_aux(large_blocks.blocks, total, largest);
+    cache_info_aux(small_blocks.blocks, total, largest);
   }
 
   /** Returns a copy of the memory allocator stats **/
@@ -457,6 +937,25 @@ class DeviceCachingAllocator {
     }
   }
 
+  /** starts or stops recording allocator events; clears the recorded ones **/
+  void recordHistory(bool enabled, size_t max_entries, size_t stack_depth,
+                     const std::string& oom_dump_path) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    record_history = enabled && max_entries > 0;
+    trace.clear();
+    trace.shrink_to_fit();
+    trace_next = 0;
+    trace_max_entries = record_history ? max_entries : 0;
+    trace_stack_depth = stack_depth;
+    trace_oom_dump_path = oom_dump_path;
+  }
+
+  /** Returns the recorded allocator events, oldest first **/
+  std::vector<TraceEntry> getTrace() const {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    return ordered_trace();
+  }
+
   /** Dump a complete snapshot of the memory held by the allocator. Potentially VERY expensive. **/
   std::vector<SegmentInfo> snapshot() const {
     std::lock_guard<std::recursive_mutex> lock(mutex);
@@ -472,10 +971,15 @@ class DeviceCachingAllocator {
       SegmentInfo& segment_info = result.back();
       segment_info.device = head_block->device;
       segment_info.address = reinterpret_cast<int64_t>(head_block->ptr);
-      segment_info.is_large = (head_block->pool == &large_blocks);
+      segment_info.is_large = !head_block->pool->is_small;
+      segment_info.is_expandable = (head_block->expandable_segment != nullptr);
 
       const Block* block = head_block;
       while (block != nullptr) {
+        if (!block->mapped) {
+          block = block->next;
+          continue;
+        }
         segment_info.blocks.emplace_back();
         BlockInfo& block_info = segment_info.blocks.back();
 
@@ -514,14 +1018,106 @@ class DeviceCachingAllocator {
 
   // All private methods do not acquire the allocator mutex.
 
+  void record_trace(TraceEntry::Action action, int device, void* addr,
+                    size_t size, cudaStream_t stream) {
+    if (!record_history) {
+      return;
+    }
+    TraceEntry entry;
+    entry.action = action;
+    entry.device = device;
+    entry.addr = reinterpret_cast<int64_t>(addr);
+    entry.size = static_cast<int64_t>(size);
+    entry.stream = stream;
+    entry.time_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    // Skip this frame; the caller is the allocator entry point.
+    entry.stack_id = trace_stack_depth > 0
+        ? stackTable().intern(get_raw_backtrace(1, trace_stack_depth))
+        : 0;
+    if (trace.size() < trace_max_entries) {
+      trace.push_back(entry);
+    } else {
+      trace[trace_next] = entry;
+    }
+    trace_next = (trace_next + 1) % trace_max_entries;
+  }
+
+  std::vector<TraceEntry> ordered_trace() const {
+    if (trace.size() < trace_max_entries) {
+      return trace;
+    }
+    std::vector<TraceEntry> result(trace.begin() + trace_next, trace.end());
+    result.insert(result.end(), trace.begin(), trace.begin() + trace_next);
+    return result;
+  }
+
+  /** writes the recorded events and their stacks for an out of memory error */
+  void dump_trace(int device) const {
+    std::ofstream file;
+    if (!trace_oom_dump_path.empty()) {
+      file.open(trace_oom_dump_path);
+      if (!file) {
+        TORCH_WARN("Could not open ", trace_oom_dump_path,
+                   " to dump the CUDA allocator trace; writing it to stderr.");
+      }
+    }
+    std::ostream& out = file.is_open() ? static_cast<std::ostream&>(file) : std::cerr;
+
+    std::set<uint32_t> stack_ids;
+    out << "CUDA caching allocator trace of device " << device << ", oldest first:\n";
+    for (const TraceEntry& entry : ordered_trace()) {
+      out << traceActionName(entry.action) << " addr=" << reinterpret_cast<void*>(entry.addr)
+          << " size=" << entry.size << " stream=" << entry.stream
+          << " time_us=" << entry.time_us;
+      if (entry.stack_id != 0) {
+        out << " stack=" << entry.stack_id;
+        stack_ids.insert(entry.stack_id);
+      }
+      out << "\n";
+    }
+    for (uint32_t id : stack_ids) {
+      out << "stack " << id << ":\n" << getTraceStack(id);
+    }
+    out.flush();
+  }
+
   std::vector<const Block*> get_all_blocks() const {
     std::vector<const Block*> blocks;
-    blocks.insert(blocks.end(), small_blocks.begin(), small_blocks.end());
-    blocks.insert(blocks.end(), large_blocks.begin(), large_blocks.end());
+    const auto add_pool = [&blocks](const BlockPool& pool) {
+      blocks.insert(blocks.end(), pool.blocks.begin(), pool.blocks.end());
+      blocks.insert(blocks.end(), pool.unmapped.begin(), pool.unmapped.end());
+    };
+    add_pool(small_blocks);
+    add_pool(large_blocks);
+    for (const auto& entry : private_pools) {
+      add_pool(entry.second->small_blocks);
+      add_pool(entry.second->large_blocks);
+    }
     blocks.insert(blocks.end(), active_blocks.begin(), active_blocks.end());
     return blocks;
   }
 
+  PrivatePool* retain_pool(MempoolId_t mempool_id) {
+    TORCH_CHECK(mempool_id != 0, "invalid private pool id");
+    auto it = private_pools.find(mempool_id);
+    if (it == private_pools.end()) {
+      it = private_pools.emplace(mempool_id, std::make_unique<PrivatePool>()).first;
+    } else if (it->second->use_count++ == 0) {
+      private_pools_freeable.erase(mempool_id);
+    }
+    return it->second.get();
+  }
+
+  void release_pool(MempoolId_t mempool_id) {
+    auto it = private_pools.find(mempool_id);
+    TORCH_CHECK(it != private_pools.end() && it->second->use_count > 0,
+                "releasePool: unknown private pool ", mempool_id);
+    if (--it->second->use_count == 0) {
+      private_pools_freeable.emplace(mempool_id, it->second.get());
+    }
+  }
+
   /** moves a block into a pool of cached free blocks */
   void free_block(Block* block)
   {
@@ -543,7 +1139,7 @@ class DeviceCachingAllocator {
     }
 
     active_blocks.erase(block);
-    pool.insert(block);
+    pool.blocks.insert(block);
 
     if (block->is_split()) {
       net_change_inactive_split_blocks += 1;
@@ -562,7 +1158,7 @@ class DeviceCachingAllocator {
   /** combine previously split blocks. returns the size of the subsumed block, or 0 on failure. */
   size_t try_merge_blocks(Block* dst, Block* src, BlockPool& pool)
   {
-    if (!src || src->allocated || src->event_count > 0) {
+    if (!src || src->allocated || src->event_count > 0 || src->mapped != dst->mapped) {
       return 0;
     }
 
@@ -583,13 +1179,20 @@ class DeviceCachingAllocator {
 
     const size_t subsumed_size = src->size;
     dst->size += subsumed_size;
-    pool.erase(src);
+    (src->mapped ? pool.blocks : pool.unmapped).erase(src);
     delete src;
 
     return subsumed_size;
   }
 
-  BlockPool& get_pool(size_t size) {
+  BlockPool& get_pool(size_t size, cudaStream_t stream) {
+    if (!routed_streams.empty()) {
+      auto it = routed_streams.find(stream);
+      if (it != routed_streams.end()) {
+        PrivatePool* pool = it->second.pool;
+        return size <= kSmallSize ? pool->small_blocks : pool->large_blocks;
+      }
+    }
     if (size <= kSmallSize) {
       return small_blocks;
     } else {
@@ -598,23 +1201,15 @@ class DeviceCachingAllocator {
   }
 
   StatType get_stat_type_for_pool(const BlockPool& pool) {
-    if (&pool == &small_blocks) {
-      return StatType::SMALL_POOL;
-    } else if (&pool == &large_blocks) {
-      return StatType::LARGE_POOL;
-    } else {
-      TORCH_CHECK(false, "get_stat_type_for_pool: invalid pool");
-    }
+    return pool.is_small ? StatType::SMALL_POOL : StatType::LARGE_POOL;
   }
 
   bool should_split(const Block* block, size_t size) {
     size_t remaining = block->size - size;
-    if (block->pool == &small_blocks) {
+    if (block->pool->is_small) {
       return remaining >= kMinBlockSize;
-    } else if (block->pool == &large_blocks) {
-      return remaining > kSmallSize;
     } else {
-      TORCH_CHECK(false, "should_split: invalid pool");
+      return remaining > kSmallSize;
     }
   }
 
@@ -629,12 +1224,12 @@ class DeviceCachingAllocator {
   }
 
   bool get_free_block(AllocParams& p) {
-    BlockPool& pool = *p.pool;
-    auto it = pool.lower_bound(&p.search_key);
-    if (it == pool.end() || (*it)->stream != p.stream())
+    auto& blocks = p.pool->blocks;
+    auto it = blocks.lower_bound(&p.search_key);
+    if (it == blocks.end() || (*it)->stream != p.stream())
       return false;
     p.block = *it;
-    pool.erase(it);
+    blocks.erase(it);
     return true;
   }
 
@@ -658,6 +1253,10 @@ class DeviceCachingAllocator {
       stats.num_alloc_retries += 1;
     }
 
+    if (use_expandable_segments(p.device())) {
+      return alloc_expandable_block(p);
+    }
+
     if (set_fraction && total_allocated_memory + size > allowed_memory_maximum) {
       p.err = cudaErrorMemoryAllocation;
       return false;
@@ -681,7 +1280,11 @@ class DeviceCachingAllocator {
     }
 
     total_allocated_memory += size;
+    record_trace(TraceEntry::SEGMENT_ALLOC, p.device(), ptr, size, p.stream());
     p.block = new Block(p.device(), p.stream(), size, p.pool, (char*)ptr);
+    if (p.pool->owner_PrivatePool) {
+      p.pool->owner_PrivatePool->segment_count++;
+    }
     update_stat_array(stats.segment, 1, p.stat_types);
     update_stat_array(stats.reserved_bytes, size, p.stat_types);
 
@@ -690,6 +1293,126 @@ class DeviceCachingAllocator {
     return true;
   }
 
+  bool use_expandable_segments(int device) {
+    if (!expandable_segments_checked) {
+      expandable_segments_checked = true;
+      if (expandableSegmentsRequested()) {
+        expandable_page_size = expandableSegmentPageSize(device);
+        if (expandable_page_size == 0) {
+          TORCH_WARN_ONCE(
+              "PYTORCH_CUDA_EXPANDABLE_SEGMENTS is set, but device ", device,
+              " or its driver does not support virtual memory management. "
+              "Falling back to cudaMalloc segments.");
+        } else {
+          size_t device_free;
+          size_t device_total;
+          C10_CUDA_CHECK(cudaMemGetInfo(&device_free, &device_total));
+          expandable_reserve_size = round_up(device_total, expandable_page_size);
+        }
+      }
+    }
+    return expandable_page_size != 0;
+  }
+
+  /** maps enough of an expandable segment to satisfy p; see the note on top */
+  bool alloc_expandable_block(AllocParams& p) {
+    BlockPool& pool = *p.pool;
+    auto& unmapped = pool.unmapped;
+
+    // Look for an unmapped range of this stream which, together with the
+    // free block right before it, can hold the request. get_free_block has
+    // already failed, so the free block alone is too small.
+    Block* candidate = nullptr;
+    size_t map_size = round_up(p.size(), expandable_page_size);
+    Block key(p.device(), p.stream(), 0);
+    for (auto it = unmapped.lower_bound(&key);
+         it != unmapped.end() && (*it)->stream == p.stream(); ++it) {
+      Block* block = *it;
+      Block* prev = block->prev;
+      const size_t free_before =
+          (prev && prev->mapped && !prev->allocated && prev->event_count == 0)
+          ? prev->size : 0;
+      const size_t needed =
+          round_up(p.size() - std::min(free_before, p.size()), expandable_page_size);
+      if (needed > 0 && needed <= block->size) {
+        candidate = block;
+        map_size = needed;
+        break;
+      }
+    }
+
+    if (set_fraction && total_allocated_memory + map_size > allowed_memory_maximum) {
+      p.err = cudaErrorMemoryAllocation;
+      return false;
+    }
+
+    if (!candidate) {
+      auto segment = new ExpandableSegment(
+          p.device(), p.stream(),
+          std::max(expandable_reserve_size, map_size), expandable_page_size);
+      candidate = new Block(p.device(), p.stream(), segment->size(), p.pool, segment->ptr());
+      candidate->mapped = false;
+      candidate->expandable_segment = segment;
+      unmapped.insert(candidate);
+      if (pool.owner_PrivatePool) {
+        pool.owner_PrivatePool->segment_count++;
+      }
+      update_stat_array(stats.segment, 1, p.stat_types);
+    }
+
+    ExpandableSegment* segment = candidate->expandable_segment;
+    const size_t offset = static_cast<char*>(candidate->ptr) - segment->ptr();
+    p.err = segment->map(offset, map_size);
+    if (p.err != cudaSuccess) {
+      cudaGetLastError();
+      release_expandable_segment_if_unused(candidate);
+      return false;
+    }
+
+    unmapped.erase(candidate);
+    Block* block = candidate;
+    if (map_size < candidate->size) {
+      block = new Block(p.device(), p.stream(), map_size, p.pool, candidate->ptr);
+      block->expandable_segment = segment;
+      block->prev = candidate->prev;
+      if (block->prev) {
+        block->prev->next = block;
+      }
+      block->next = candidate;
+      candidate->prev = block;
+      candidate->ptr = static_cast<char*>(candidate->ptr) + map_size;
+      candidate->size -= map_size;
+      unmapped.insert(candidate);
+    }
+    block->mapped = true;
+
+    total_allocated_memory += map_size;
+    record_trace(TraceEntry::SEGMENT_MAP, p.device(), block->ptr, map_size, p.stream());
+    update_stat_array(stats.reserved_bytes, map_size, p.stat_types);
+
+    // Merge the new pages with the free blocks around them and hand the
+    // result to the usual pool search.
+    int64_t net_change_inactive_split_blocks = 0;
+    int64_t net_change_inactive_split_size = 0;
+    const std::array<Block*, 2> merge_candidates = {block->prev, block->next};
+    for (Block* merge_candidate : merge_candidates) {
+      const int64_t subsumed_size = try_merge_blocks(block, merge_candidate, pool);
+      if (subsumed_size > 0) {
+        net_change_inactive_split_blocks -= 1;
+        net_change_inactive_split_size -= subsumed_size;
+      }
+    }
+    pool.blocks.insert(block);
+    if (block->is_split()) {
+      net_change_inactive_split_blocks += 1;
+      net_change_inactive_split_size += block->size;
+    }
+    update_stat_array(stats.inactive_split, net_change_inactive_split_blocks, p.stat_types);
+    update_stat_array(stats.inactive_split_bytes, net_change_inactive_split_size, p.stat_types);
+
+    return get_free_block(p);
+  }
+
   bool free_cached_blocks()
   {
     // First ensure that all blocks that can't currently be allocated due to
@@ -699,18 +1422,44 @@ class DeviceCachingAllocator {
     // Free all non-split cached blocks
     free_blocks(large_blocks);
     free_blocks(small_blocks);
+
+    // Unmap the free pages of expandable segments
+    unmap_blocks(large_blocks);
+    unmap_blocks(small_blocks);
+
+    // Free the memory of released private pools, and the pools themselves
+    // once none of their blocks is in use anymore.
+    for (auto it = private_pools_freeable.begin(); it != private_pools_freeable.end();) {
+      PrivatePool* pool = it->second;
+      TORCH_INTERNAL_ASSERT(pool->use_count == 0);
+      free_blocks(pool->large_blocks);
+      free_blocks(pool->small_blocks);
+      unmap_blocks(pool->large_blocks);
+      unmap_blocks(pool->small_blocks);
+      if (pool->segment_count == 0) {
+        private_pools.erase(it->first);
+        it = private_pools_freeable.erase(it);
+      } else {
+        ++it;
+      }
+    }
     return true;
   }
 
-  void free_blocks(BlockPool& blocks)
+  void free_blocks(BlockPool& pool)
   {
     // Frees all non-split blocks
+    auto& blocks = pool.blocks;
     auto it = blocks.begin();
     while (it != blocks.end()) {
       Block* block = *it;
-      if (!block->prev && !block->next) {
+      if (!block->prev && !block->next && !block->expandable_segment) {
+        record_trace(TraceEntry::SEGMENT_FREE, block->device, block->ptr, block->size, block->stream);
         C10_CUDA_CHECK(cudaFree((void*)block->ptr));
         total_allocated_memory -= block->size;
+        if (pool.owner_PrivatePool) {
+          pool.owner_PrivatePool->segment_count--;
+        }
 
         StatTypes stat_types;
         stat_types[static_cast<size_t>(StatType::AGGREGATE)] = true;
@@ -728,6 +1477,112 @@ class DeviceCachingAllocator {
     }
   }
 
+  void unmap_blocks(BlockPool& pool)
+  {
+    // Unmaps the whole pages covered by free blocks of expandable segments
+    std::vector<Block*> to_unmap;
+    for (Block* block : pool.blocks) {
+      if (block->expandable_segment) {
+        to_unmap.push_back(block);
+      }
+    }
+    for (Block* block : to_unmap) {
+      unmap_block(block);
+    }
+  }
+
+  void unmap_block(Block* block)
+  {
+    ExpandableSegment* segment = block->expandable_segment;
+    const size_t page_size = segment->page_size();
+    char* const begin = segment->ptr() +
+        round_up(static_cast<char*>(block->ptr) - segment->ptr(), page_size);
+    char* const end = segment->ptr() +
+        (static_cast<char*>(block->ptr) + block->size - segment->ptr()) / page_size * page_size;
+    if (begin >= end) {
+      return;
+    }
+
+    auto& pool = *block->pool;
+    StatTypes stat_types;
+    stat_types[static_cast<size_t>(StatType::AGGREGATE)] = true;
+    stat_types[static_cast<size_t>(get_stat_type_for_pool(pool))] = true;
+    int64_t net_change_inactive_split_blocks = 0;
+    int64_t net_change_inactive_split_size = 0;
+    if (block->is_split()) {
+      net_change_inactive_split_blocks -= 1;
+      net_change_inactive_split_size -= block->size;
+    }
+    pool.blocks.erase(block);
+
+    // Partially covered pages at either end stay mapped as free blocks.
+    const size_t head_size = begin - static_cast<char*>(block->ptr);
+    if (head_size > 0) {
+      Block* head = new Block(block->device, block->stream, head_size, &pool, block->ptr);
+      head->expandable_segment = segment;
+      head->prev = block->prev;
+      if (head->prev) {
+        head->prev->next = head;
+      }
+      head->next = block;
+      block->prev = head;
+      block->ptr = begin;
+      block->size -= head_size;
+      pool.blocks.insert(head);
+      net_change_inactive_split_blocks += 1;
+      net_change_inactive_split_size += head_size;
+    }
+    const size_t tail_size = block->size - (end - begin);
+    if (tail_size > 0) {
+      Block* tail = new Block(block->device, block->stream, tail_size, &pool, end);
+      tail->expandable_segment = segment;
+      tail->next = block->next;
+      if (tail->next) {
+        tail->next->prev = tail;
+      }
+      tail->prev = block;
+      block->next = tail;
+      block->size -= tail_size;
+      pool.blocks.insert(tail);
+      net_change_inactive_split_blocks += 1;
+      net_change_inactive_split_size += tail_size;
+    }
+
+    record_trace(TraceEntry::SEGMENT_UNMAP, block->device, block->ptr, block->size, block->stream);
+    segment->unmap(begin - segment->ptr(), block->size);
+    block->mapped = false;
+    total_allocated_memory -= block->size;
+    update_stat_array(stats.reserved_bytes, -block->size, stat_types);
+    update_stat_array(stats.inactive_split, net_change_inactive_split_blocks, stat_types);
+    update_stat_array(stats.inactive_split_bytes, net_change_inactive_split_size, stat_types);
+
+    const std::array<Block*, 2> merge_candidates = {block->prev, block->next};
+    for (Block* merge_candidate : merge_candidates) {
+      try_merge_blocks(block, merge_candidate, pool);
+    }
+    pool.unmapped.insert(block);
+    release_expandable_segment_if_unused(block);
+  }
+
+  /** releases the segment of an unmapped block if the block spans all of it */
+  void release_expandable_segment_if_unused(Block* block)
+  {
+    if (block->prev || block->next) {
+      return;
+    }
+    StatTypes stat_types;
+    stat_types[static_cast<size_t>(StatType::AGGREGATE)] = true;
+    stat_types[static_cast<size_t>(get_stat_type_for_pool(*(block->pool)))] = true;
+    update_stat_array(stats.segment, -1, stat_types);
+    if (block->pool->owner_PrivatePool) {
+      block->pool->owner_PrivatePool->segment_count--;
+    }
+
+    block->pool->unmapped.erase(block);
+    delete block->expandable_segment;
+    delete block;
+  }
+
   cudaEvent_t create_event_internal() {
     cudaEvent_t event;
     C10_CUDA_CHECK(cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
@@ -740,6 +1595,7 @@ class DeviceCachingAllocator {
 
   void synchronize_and_free_events() {
     // Synchronize on outstanding events and then free associated blocks.
+    insert_events_deferred_until_no_capture();
 
     for (auto& e : cuda_events) {
       cudaEvent_t event = e.first;
@@ -777,8 +1633,19 @@ class DeviceCachingAllocator {
     C10_CUDA_CHECK(cudaSetDevice(prev_device));
   }
 
+  void insert_events_deferred_until_no_capture()
+  {
+    for (Block* block : needs_events_deferred_until_no_capture) {
+      TORCH_INTERNAL_ASSERT(!block->stream_uses.empty());
+      insert_events(block);
+    }
+    needs_events_deferred_until_no_capture.clear();
+  }
+
   void process_events()
   {
+    insert_events_deferred_until_no_capture();
+
     // Process outstanding cudaEvents. Events that are completed are removed
     // from the queue, and the 'event_count' for the corresponding allocation
     // is decremented. Stops at the first event which has not been completed.
@@ -809,7 +1676,7 @@ class DeviceCachingAllocator {
   }
 
   // Accumulates sizes of all memory blocks for given device in given pool
-  void cache_info_aux(BlockPool& blocks, size_t* total, size_t* largest)
+  void cache_info_aux(const std::set<Block*, Comparison>& blocks, size_t* total, size_t* largest)
   {
     for (const auto& block : blocks) {
       size_t blocksize = block->size;
@@ -947,6 +1814,13 @@ class THCCachingAllocator {
     device_allocator[block->device]->recordStream(block, stream);
   }
 
+  void recordHistory(bool enabled, size_t max_entries, size_t stack_depth,
+                     const std::string& oom_dump_path) {
+    int count = device_allocator.size();
+    for (int i = 0; i < count; i++)
+      device_allocator[i]->recordHistory(enabled, max_entries, stack_depth, oom_dump_path);
+  }
+
   std::vector<SegmentInfo> snapshot() {
     std::vector<SegmentInfo> result;
     int count = device_allocator.size();
@@ -1058,6 +1932,45 @@ std::vector<SegmentInfo> snapshot() {
   return caching_allocator.snapshot();
 }
 
+void recordHistory(bool enabled, size_t max_entries, size_t stack_depth,
+                   const std::string& oom_dump_path) {
+  caching_allocator.recordHistory(enabled, max_entries, stack_depth, oom_dump_path);
+}
+
+std::vector<TraceEntry> getTrace(int device) {
+  assertValidDevice(device);
+  return caching_allocator.device_allocator[device]->getTrace();
+}
+
+std::string getTraceStack(uint32_t stack_id) {
+  return symbolize_backtrace(stackTable().get(stack_id));
+}
+
+MempoolId_t createPoolId() {
+  static std::atomic<MempoolId_t> next_id{1};
+  return next_id++;
+}
+
+void retainPool(int device, MempoolId_t mempool_id) {
+  assertValidDevice(device);
+  caching_allocator.device_allocator[device]->retainPool(mempool_id);
+}
+
+void releasePool(int device, MempoolId_t mempool_id) {
+  assertValidDevice(device);
+  caching_allocator.device_allocator[device]->releasePool(mempool_id);
+}
+
+void beginAllocateToPool(int device, MempoolId_t mempool_id, cudaStream_t stream) {
+  assertValidDevice(device);
+  caching_allocator.device_allocator[device]->beginAllocateToPool(mempool_id, stream);
+}
+
+void endAllocateToPool(int device, cudaStream_t stream) {
+  assertValidDevice(device);
+  caching_allocator.device_allocator[device]->endAllocateToPool(stream);
+}
+
 //
 // In CUDA IPC, sender sends a tensor to receiver, getIpcDevPtr
 // is called by the receiving process to map the CUDA memory from the sending
@@ -1074,18 +1987,63 @@ std::vector<SegmentInfo> snapshot() {
 // will be used to reconstruct all storages in this CudaMalloc allocation.
 // And it will deleted in cudaIpcCloseMemHandle when its reference count is 0.
 //
+// Opening a handle is expensive, and a producer that keeps sending tensors
+// from its cached blocks sends the same few handles over and over. With
+// PYTORCH_CUDA_IPC_CACHED_HANDLES=N the N most recently received handles are
+// kept open after their last storage is freed, so that tensors received later
+// in the same blocks only add their offset. This keeps the producer's memory
+// mapped even if the producer frees it, until the handle is evicted or
+// releaseCachedIpcDevPtrs (torch.cuda.ipc_collect) is called.
+//
 namespace {
   std::mutex IpcMutex;
   std::unordered_map<std::string, std::weak_ptr<void>> ipcMemHandle_to_devptr;
+  // Most recently used first. Leaked so that the handles are not closed
+  // during static destruction, when CUDA may already be unloaded.
+  auto& cachedIpcDevPtrs = *new std::deque<std::shared_ptr<void>>();
+
+  size_t ipcCachedHandles() {
+    static size_t cached_handles = [] {
+      const char* env = getenv("PYTORCH_CUDA_IPC_CACHED_HANDLES");
+      return env != nullptr ? static_cast<size_t>(atoi(env)) : 0;
+    }();
+    return cached_handles;
+  }
+
+  // Moves devptr to the front of cachedIpcDevPtrs and returns the pointers
+  // evicted from it, to be released after unlocking IpcMutex since closing
+  // the handle locks it again.
+  std::vector<std::shared_ptr<void>> retainIpcDevPtr(
+      const std::shared_ptr<void>& devptr) {
+    std::vector<std::shared_ptr<void>> evicted;
+    if (ipcCachedHandles() == 0) {
+      return evicted;
+    }
+    auto it =
+        std::find(cachedIpcDevPtrs.begin(), cachedIpcDevPtrs.end(), devptr);
+    if (it != cachedIpcDevPtrs.end()) {
+      cachedIpcDevPtrs.erase(it);
+    }
+    cachedIpcDevPtrs.push_front(devptr);
+    while (cachedIpcDevPtrs.size() > ipcCachedHandles()) {
+      evicted.push_back(std::move(cachedIpcDevPtrs.back()));
+      cachedIpcDevPtrs.pop_back();
+    }
+    return evicted;
+  }
 }
 
 std::shared_ptr<void> getIpcDevPtr(std::string handle) {
+  std::vector<std::shared_ptr<void>> evicted;
   std::lock_guard<std::mutex> lock(IpcMutex);
 
   auto iter = ipcMemHandle_to_devptr.find(handle);
   if (iter != ipcMemHandle_to_devptr.end()) {
     auto devptr = iter->second.lock();
-    if (devptr) return devptr;
+    if (devptr) {
+      evicted = retainIpcDevPtr(devptr);
+      return devptr;
+    }
   }
   // This ipcMemHandle hasn't been opened, or already expired, open it to
   // enable IPC access to that mem block.
@@ -1108,10 +2066,17 @@ std::shared_ptr<void> getIpcDevPtr(std::string handle) {
   // But in the deleter for sp we erased the entry,
   // this should be safe to do now.
   ipcMemHandle_to_devptr.insert(iter, {handle, wp});
+  evicted = retainIpcDevPtr(sp);
 
   return sp;
 }
 
+void releaseCachedIpcDevPtrs() {
+  std::deque<std::shared_ptr<void>> released;
+  std::lock_guard<std::mutex> lock(IpcMutex);
+  released.swap(cachedIpcDevPtrs);
+}
+
 void* raw_alloc(size_t nbytes) {
   if (nbytes == 0) {
     return nullptr;
@@ -102,9 +102,35 @@ struct SegmentInfo {
   int64_t allocated_size = 0;
   int64_t active_size = 0;
   bool is_large = false;
+  bool is_expandable = false;
   std::vector<BlockInfo> blocks;
 };
 
+// An allocator event recorded by recordHistory. See the note on allocation
+// traces in CUDACachingAllocator.cpp.
+struct TraceEntry {
+  enum Action {
+    ALLOC,         // a block was handed out
+    FREE,          // a block was returned
+    SEGMENT_ALLOC, // cudaMalloc
+    SEGMENT_FREE,  // cudaFree
+    SEGMENT_MAP,   // pages of an expandable segment were mapped
+    SEGMENT_UNMAP, // pages of an expandable segment were unmapped
+    OOM            // an allocation of size bytes failed
+  };
+  Action action = ALLOC;
+  int device = 0;
+  int64_t addr = 0;
+  int64_t size = 0;
+  cudaStream_t stream = nullptr;
+  int64_t time_us = 0;  // microseconds since the epoch
+  uint32_t stack_id = 0; // 0 if no stack was recorded; see getTraceStack
+};
+
+// Identifies a private memory pool; 0 is never a valid id. See the note on
+// private pools in CUDACachingAllocator.cpp.
+using MempoolId_t = uint64_t;
+
 C10_CUDA_API void* raw_alloc(size_t nbytes);
 C10_CUDA_API void* raw_alloc_with_stream(size_t nbytes, cudaStream_t stream);
 C10_CUDA_API void raw_delete(void* ptr);
@@ -121,9 +147,39 @@ C10_CUDA_API void resetAccumulatedStats(int device);
 C10_CUDA_API void resetPeakStats(int device);
 C10_CUDA_API std::vector<SegmentInfo> snapshot();
 
+// Keeps the last max_entries allocator events of each device, with up to
+// stack_depth frames of their call stacks. Out of memory errors write the
+// events to oom_dump_path, or to stderr if it is empty. Clears the events
+// recorded so far.
+C10_CUDA_API void recordHistory(
+    bool enabled,
+    size_t max_entries,
+    size_t stack_depth,
+    const std::string& oom_dump_path);
+// Returns the recorded events of a device, oldest first.
+C10_CUDA_API std::vector<TraceEntry> getTrace(int device);
+// Symbolizes the call stack of trace entries with the given stack id.
+C10_CUDA_API std::string getTraceStack(uint32_t stack_id);
+
 C10_CUDA_API std::mutex* getFreeMutex();
 
+// Returns a new private pool id. The pool itself is created on a device by
+// the first retainPool or beginAllocateToPool call for it.
+C10_CUDA_API MempoolId_t createPoolId();
+C10_CUDA_API void retainPool(int device, MempoolId_t mempool_id);
+C10_CUDA_API void releasePool(int device, MempoolId_t mempool_id);
+// Serves the allocations made on stream from the private pool until
+// endAllocateToPool. The routing holds a reference to the pool.
+C10_CUDA_API void beginAllocateToPool(
+    int device,
+    MempoolId_t mempool_id,
+    cudaStream_t stream);
+C10_CUDA_API void endAllocateToPool(int device, cudaStream_t stream);
+
 C10_CUDA_API std::shared_ptr<void> getIpcDevPtr(std::string handle);
+// Closes the IPC mem handles kept open by PYTORCH_CUDA_IPC_CACHED_HANDLES that
+// no received storage uses anymore.
+C10_CUDA_API void releaseCachedIpcDevPtrs();
 } // namespace CUDACachingAllocator
 
 }} // namespace c10::cuda
@@ -8,6 +8,12 @@ namespace {
 thread_local AllocationPlanner* allocation_planner{nullptr};
 thread_local CPUProfilingAllocator* profiling_allocator{nullptr};
 
+// Context of the DataPtrs of allocations made in the blob
+struct BlobAllocation {
+  std::shared_ptr<void> blob;
+  void* data;
+};
+
 struct MemBlock {
   uint64_t start_offset, end_offset;
   MemBlock(uint64_t s, uint64_t e) : start_offset(s), end_offset(e) {}
@@ -235,6 +241,45 @@ void AllocationPlan::clear() {
   allocation_offsets.clear();
 }
 
+std::vector<uint64_t> AllocationPlan::serialize() const {
+  std::vector<uint64_t> data;
+  data.reserve(3 * allocation_sizes.size() + 2);
+  data.push_back(allocation_sizes.size());
+  data.insert(data.end(), allocation_sizes.begin(), allocation_sizes.end());
+  data.insert(
+      data.end(), allocation_lifetimes.begin(), allocation_lifetimes.end());
+  data.insert(data.end(), allocation_offsets.begin(), allocation_offsets.end());
+  data.push_back(total_size);
+  return data;
+}
+
+bool AllocationPlan::deserialize(const std::vector<uint64_t>& data) {
+  clear();
+  total_size = 0;
+  if (data.empty() || data[0] > data.size() ||
+      data.size() != 3 * data[0] + 2) {
+    return false;
+  }
+  const uint64_t n = data[0];
+  auto begin = data.begin() + 1;
+  allocation_sizes.assign(begin, begin + n);
+  allocation_lifetimes.assign(begin + n, begin + 2 * n);
+  allocation_offsets.assign(begin + 2 * n, begin + 3 * n);
+  total_size = data.back();
+  for (uint64_t i = 0; i < n; ++i) {
+    if (allocation_lifetimes[i] == std::numeric_limits<uint64_t>::max()) {
+      continue;
+    }
+    if (allocation_lifetimes[i] <= i ||
+        allocation_offsets[i] + allocation_sizes[i] > total_size) {
+      clear();
+      total_size = 0;
+      return false;
+    }
+  }
+  return true;
+}
+
 void AllocationPlanner::record_allocation(
     const uint64_t size, const void* ptr) {
   if (validation_mode_) {
@@ -266,8 +311,16 @@ void AllocationPlanner::record_free(const void* ptr) {
 
 bool AllocationPlanner::validate_allocation(
     const uint64_t size, const void* ptr) {
-  if (allocation_id_ >= allocation_plan_->allocation_sizes.size() ||
-      allocation_plan_->allocation_sizes[allocation_id_] != size) {
+  if (allocation_id_ >= allocation_plan_->allocation_sizes.size()) {
+    TORCH_WARN(
+        "Allocation request does not match plan:",
+        "Allocation id:",
+        allocation_id_,
+        ", Number of recorded allocations:",
+        allocation_plan_->allocation_sizes.size());
+    return false;
+  }
+  if (allocation_plan_->allocation_sizes[allocation_id_] != size) {
     TORCH_WARN(
         "Allocation request does not match plan:",
         "Allocation id:",
@@ -324,10 +377,25 @@ void CPUProfilingAllocator::set_plan(const AllocationPlan* plan) {
   plan_ = plan;
   allocation_id_ = 0;
   allocation_ptr_to_id_.clear();
-  if (current_size_ < plan->total_size) {
+  mismatched_ = false;
+  if (fallback_on_mismatch_) {
+    const auto n = plan->allocation_sizes.size();
+    allocation_live_.assign(n, false);
+    allocations_freed_before_.assign(n, {});
+    for (uint64_t i = 0; i < n; ++i) {
+      const auto lifetime = plan->allocation_lifetimes[i];
+      if (lifetime < n) {
+        allocations_freed_before_[lifetime].push_back(i);
+      }
+    }
+  }
+  // Memory still referenced by an allocation of a previous plan can't be
+  // handed out again.
+  if (current_size_ < plan->total_size || blob_.use_count() > 1) {
     // Free existing memory and reallocate for larger size.
-    c10::free_cpu(blob_);
-    blob_ = c10::alloc_cpu(plan->total_size);
+    blob_.reset();
+    blob_ = std::shared_ptr<void>(
+        c10::alloc_cpu(plan->total_size), &c10::free_cpu);
     current_size_ = plan->total_size;
   }
 }
@@ -338,7 +406,39 @@ void CPUProfilingAllocator::unset_plan() {
   plan_ = nullptr;
 }
 
+void CPUProfilingAllocator::set_fallback_on_mismatch(bool fallback) {
+  fallback_on_mismatch_ = fallback;
+}
+
+bool CPUProfilingAllocator::mismatched() const {
+  return mismatched_;
+}
+
+bool CPUProfilingAllocator::matches_plan(const size_t bytes) const {
+  if (mismatched_ || allocation_id_ >= plan_->allocation_sizes.size() ||
+      bytes != plan_->allocation_sizes[allocation_id_]) {
+    return false;
+  }
+  // This allocation may reuse the memory of the ones planned to be freed
+  // before it, so they must not be live anymore.
+  for (auto id : allocations_freed_before_[allocation_id_]) {
+    if (allocation_live_[id]) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void* CPUProfilingAllocator::allocate(const size_t bytes) {
+  if (fallback_on_mismatch_) {
+    if (!matches_plan(bytes)) {
+      mismatched_ = true;
+      return c10::alloc_cpu(bytes);
+    }
+    allocation_live_[allocation_id_] =
+        plan_->allocation_lifetimes[allocation_id_] !=
+        std::numeric_limits<uint64_t>::max();
+  }
   TORCH_CHECK(bytes == plan_->allocation_sizes[allocation_id_],
       "Got allocation request that does not match with the plan.");
   if (plan_->allocation_lifetimes[allocation_id_] ==
@@ -348,7 +448,7 @@ void* CPUProfilingAllocator::allocate(const size_t bytes) {
     return c10::alloc_cpu(bytes);
   }
   void* ptr =
-    reinterpret_cast<uint8_t*>(blob_) +
+    reinterpret_cast<uint8_t*>(blob_.get()) +
     plan_->allocation_offsets[allocation_id_];
   allocation_ptr_to_id_[ptr] = allocation_id_;
   allocation_id_++;
@@ -371,12 +471,21 @@ void CPUProfilingAllocator::free(void* const ptr) {
     //      }
     //      out is used..
     //    }
-    c10::free_cpu(ptr);
+    // Memory of the blob is never freed on its own.
+    if (!in_blob(ptr)) {
+      c10::free_cpu(ptr);
+    }
     return;
   }
   auto id = it->second;
   TORCH_CHECK(id < plan_->allocation_lifetimes.size(),
       "Freeing allocation that is not accordingly to the plan.");
+  if (fallback_on_mismatch_) {
+    // Frees that come later than planned are caught by matches_plan() when
+    // the next allocation is made, earlier ones are harmless.
+    allocation_live_[id] = false;
+    return;
+  }
   auto lifetime_id = plan_->allocation_lifetimes[id];
   TORCH_CHECK(
       lifetime_id == allocation_id_,
@@ -388,8 +497,31 @@ void CPUProfilingAllocator::free(void* const ptr) {
       allocation_id_);
 }
 
-CPUProfilingAllocator::~CPUProfilingAllocator() {
-  c10::free_cpu(blob_);
+bool CPUProfilingAllocator::in_blob(const void* ptr) const {
+  const auto* begin = reinterpret_cast<const uint8_t*>(blob_.get());
+  const auto* p = reinterpret_cast<const uint8_t*>(ptr);
+  return begin != nullptr && p >= begin && p < begin + current_size_;
+}
+
+DataPtr CPUProfilingAllocator::allocate_data_ptr(const size_t bytes) {
+  void* ptr = allocate(bytes);
+  if (!in_blob(ptr)) {
+    return {ptr, ptr, &c10::free_cpu, Device(DeviceType::CPU)};
+  }
+  auto* ctx = new BlobAllocation{blob_, ptr};
+  return {ptr, ctx, &delete_blob_allocation, Device(DeviceType::CPU)};
+}
+
+void CPUProfilingAllocator::delete_blob_allocation(void* ctx) {
+  auto* allocation = static_cast<BlobAllocation*>(ctx);
+  // The allocation holds on to its blob, so no other blob can be at the
+  // same address.
+  auto* allocator = GetThreadLocalProfilingAllocator();
+  if (allocator != nullptr && allocator->plan_ != nullptr &&
+      allocator->blob_ == allocation->blob) {
+    allocator->free(allocation->data);
+  }
+  delete allocation;
 }
 
 WithProfileAllocationsGuard::WithProfileAllocationsGuard(
@@ -39,6 +39,14 @@ class C10_API AllocationPlan {
     void clear();
     friend class AllocationPlanner;
     friend class CPUProfilingAllocator;
+  public:
+    // Flattens the plan into
+    // [n, n sizes, n lifetimes, n offsets, total size]
+    // so that it can be stored alongside a model.
+    std::vector<uint64_t> serialize() const;
+    // Restores a plan flattened by serialize(). Returns false, and leaves the
+    // plan empty, if data is malformed.
+    bool deserialize(const std::vector<uint64_t>& data);
 };
 
 /*
@@ -75,14 +83,38 @@ class C10_API CPUProfilingAllocator {
     const AllocationPlan* plan_{nullptr};
     uint64_t allocation_id_{0};
     uint64_t current_size_{0};
-    void* blob_{nullptr};
+    // Shared with the DataPtrs handed out by allocate_data_ptr(), so that
+    // the memory of an allocation outliving the plan stays valid.
+    std::shared_ptr<void> blob_;
     ska::flat_hash_map<const void*, uint64_t> allocation_ptr_to_id_;
+    bool fallback_on_mismatch_{false};
+    bool mismatched_{false};
+    // Only maintained with fallback_on_mismatch_: whether each allocation
+    // of the plan is live, and the allocations each one expects to have been
+    // freed before it is made.
+    std::vector<bool> allocation_live_;
+    std::vector<std::vector<uint64_t>> allocations_freed_before_;
+    bool matches_plan(const size_t bytes) const;
+    bool in_blob(const void* ptr) const;
+    static void delete_blob_allocation(void* ctx);
   public:
-    ~CPUProfilingAllocator();
     void set_plan(const AllocationPlan* plan);
     void unset_plan();
     void* allocate(const size_t bytes);
     void free(void* const ptr);
+    // Like allocate(), but the returned DataPtr owns its memory: it can be
+    // freed on any thread, after unset_plan() or after the allocator is
+    // destroyed. Memory of the blob is only given back to the plan when it
+    // is freed while this allocator is the thread local one.
+    DataPtr allocate_data_ptr(const size_t bytes);
+    // By default an allocation that does not match the plan is an error.
+    // With fallback_on_mismatch, that allocation and all the later ones are
+    // served by the regular CPU allocator instead, and mismatched() is set
+    // until the next set_plan(). An allocation made while an allocation
+    // planned to be freed before it is still live counts as a mismatch, so
+    // that memory of the blob is never handed out twice.
+    void set_fallback_on_mismatch(bool fallback);
+    bool mismatched() const;
 };
 
 /*
@@ -123,7 +155,7 @@ class C10_API WithValidateAllocationPlanGuard {
     bool* success_;
 };
 
-AllocationPlanner* GetThreadLocalAllocationPlanner();
+C10_API AllocationPlanner* GetThreadLocalAllocationPlanner();
 
 /*
  * Usage: Allocate tensors accordingly to allocation plan
@@ -144,6 +176,6 @@ class C10_API WithProfilingAllocatorGuard {
     ~WithProfilingAllocatorGuard();
 };
 
-CPUProfilingAllocator* GetThreadLocalProfilingAllocator();
+C10_API CPUProfilingAllocator* GetThreadLocalProfilingAllocator();
 
 } // namespace c10
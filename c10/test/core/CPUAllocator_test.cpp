@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include <c10/core/CPUAllocator.h>
+
+using namespace c10;
+
+TEST(CPUAllocatorTest, HugePageAllocations) {
+  const size_t kMB = 1024 * 1024;
+  FLAGS_caffe2_cpu_allocator_huge_page_threshold = 4 * kMB;
+
+  void* small = alloc_cpu(kMB);
+  void* large = alloc_cpu(9 * kMB);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(large) % gAlignment, 0);
+  memset(large, 1, 9 * kMB);
+
+  auto allocations = getHugePageAllocations();
+#ifdef __linux__
+  ASSERT_EQ(allocations.size(), 1);
+  EXPECT_EQ(allocations[0].data, large);
+  EXPECT_GE(allocations[0].nbytes, 9 * kMB);
+  // whether pages come back huge depends on the kernel configuration
+  EXPECT_LE(allocations[0].huge_page_bytes, allocations[0].nbytes);
+#else
+  EXPECT_TRUE(allocations.empty());
+#endif
+
+  free_cpu(large);
+  free_cpu(small);
+  EXPECT_TRUE(getHugePageAllocations().empty());
+
+  FLAGS_caffe2_cpu_allocator_huge_page_threshold = 0;
+}
+
+TEST(CPUAllocatorTest, HugetlbfsFallback) {
+  const size_t kMB = 1024 * 1024;
+  FLAGS_caffe2_cpu_allocator_huge_page_threshold = kMB;
+  FLAGS_caffe2_cpu_allocator_use_hugetlbfs = true;
+
+  // falls back to transparent huge pages when no hugetlbfs pages are reserved
+  void* data = alloc_cpu(3 * kMB);
+  ASSERT_NE(data, nullptr);
+  memset(data, 1, 3 * kMB);
+  free_cpu(data);
+  EXPECT_TRUE(getHugePageAllocations().empty());
+
+  FLAGS_caffe2_cpu_allocator_use_hugetlbfs = false;
+  FLAGS_caffe2_cpu_allocator_huge_page_threshold = 0;
+}
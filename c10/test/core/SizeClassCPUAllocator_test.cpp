@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include <c10/core/CPUAllocator.h>
+#include <c10/core/SizeClassCPUAllocator.h>
+
+using namespace c10;
+
+TEST(SizeClassCPUAllocatorTest, RoundSize) {
+  EXPECT_EQ(SizeClassCPUAllocator::roundSize(1), gAlignment);
+  EXPECT_EQ(SizeClassCPUAllocator::roundSize(gAlignment), gAlignment);
+  EXPECT_EQ(SizeClassCPUAllocator::roundSize(1000), 1024);
+  EXPECT_EQ(SizeClassCPUAllocator::roundSize(1025), 1280);
+  EXPECT_EQ(SizeClassCPUAllocator::roundSize(1281), 1536);
+  EXPECT_EQ(SizeClassCPUAllocator::roundSize(1537), 1792);
+  EXPECT_EQ(SizeClassCPUAllocator::roundSize(1793), 2048);
+  const size_t max_size = SizeClassCPUAllocator::kMaxCachedSize;
+  EXPECT_EQ(SizeClassCPUAllocator::roundSize(max_size), max_size);
+  EXPECT_EQ(SizeClassCPUAllocator::roundSize(max_size + 1), max_size + 1);
+  for (size_t n = 1; n < 100000; n += 7) {
+    const size_t rounded = SizeClassCPUAllocator::roundSize(n);
+    ASSERT_GE(rounded, n);
+    // size classes waste at most a quarter of the request
+    ASSERT_LE(rounded, std::max<size_t>(gAlignment, n + n / 4 + 1));
+  }
+}
+
+TEST(SizeClassCPUAllocatorTest, ReusesFreedBlocks) {
+  auto* allocator = SizeClassCPUAllocator::get();
+  void* first = nullptr;
+  {
+    auto data = allocator->allocate(3000);
+    first = data.get();
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(first) % gAlignment, 0);
+  }
+  auto hits = SizeClassCPUAllocator::getStats().num_cache_hits;
+  // same size class
+  auto data = allocator->allocate(2900);
+  EXPECT_EQ(data.get(), first);
+  EXPECT_EQ(SizeClassCPUAllocator::getStats().num_cache_hits, hits + 1);
+}
+
+TEST(SizeClassCPUAllocatorTest, Stats) {
+  auto* allocator = SizeClassCPUAllocator::get();
+  SizeClassCPUAllocator::emptyCache();
+  SizeClassCPUAllocator::resetAccumulatedStats();
+  auto before = SizeClassCPUAllocator::getStats();
+  {
+    auto a = allocator->allocate(100);
+    auto b = allocator->allocate(SizeClassCPUAllocator::kMaxCachedSize + 1);
+    auto stats = SizeClassCPUAllocator::getStats();
+    EXPECT_EQ(stats.allocation.current, before.allocation.current + 2);
+    EXPECT_EQ(stats.allocation.allocated, 2);
+    EXPECT_EQ(
+        stats.allocated_bytes.current,
+        before.allocated_bytes.current +
+            SizeClassCPUAllocator::roundSize(100) +
+            SizeClassCPUAllocator::kMaxCachedSize + 1);
+    EXPECT_EQ(stats.num_cache_misses, 1);
+    EXPECT_EQ(stats.num_uncached_allocs, 1);
+  }
+  auto stats = SizeClassCPUAllocator::getStats();
+  EXPECT_EQ(stats.allocation.current, before.allocation.current);
+  EXPECT_EQ(stats.allocation.freed, 2);
+  EXPECT_GE(stats.allocated_bytes.peak, SizeClassCPUAllocator::kMaxCachedSize);
+  // the small block stays cached, the large one is returned right away
+  EXPECT_EQ(
+      stats.reserved_bytes.current,
+      before.reserved_bytes.current + SizeClassCPUAllocator::roundSize(100));
+
+  SizeClassCPUAllocator::emptyCache();
+  SizeClassCPUAllocator::resetPeakStats();
+  stats = SizeClassCPUAllocator::getStats();
+  EXPECT_EQ(stats.reserved_bytes.current, before.reserved_bytes.current);
+  EXPECT_EQ(stats.allocated_bytes.peak, stats.allocated_bytes.current);
+}
+
+TEST(SizeClassCPUAllocatorTest, FreeOnOtherThread) {
+  auto* allocator = SizeClassCPUAllocator::get();
+  const int kThreads = 4;
+  const int kAllocsPerThread = 1000;
+  std::vector<std::vector<DataPtr>> data(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < kAllocsPerThread; ++i) {
+        data[t].push_back(allocator->allocate((i % 64 + 1) * 100));
+        memset(data[t].back().get(), t, (i % 64 + 1) * 100);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  threads.clear();
+  // every thread frees the blocks allocated by the next one
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t]() { data[(t + 1) % kThreads].clear(); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  SizeClassCPUAllocator::emptyCache();
+  auto stats = SizeClassCPUAllocator::getStats();
+  EXPECT_EQ(stats.allocation.current, 0);
+  EXPECT_EQ(stats.reserved_bytes.current, 0);
+}
+
+TEST(SizeClassCPUAllocatorTest, SetCPUAllocator) {
+  auto* previous = GetCPUAllocator();
+  SetCPUAllocator(SizeClassCPUAllocator::get(), /* priority */ 1);
+  EXPECT_EQ(GetCPUAllocator(), SizeClassCPUAllocator::get());
+  auto data = GetCPUAllocator()->raw_allocate(128);
+  GetCPUAllocator()->raw_deallocate(data);
+  SetCPUAllocator(previous, /* priority */ 1);
+}
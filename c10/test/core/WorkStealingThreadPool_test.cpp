@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include <c10/core/work_stealing_thread_pool.h>
+
+using namespace c10;
+
+namespace {
+
+// Blocks until `count` reaches `expected`
+void waitFor(
+    std::atomic<int>& count,
+    int expected,
+    std::mutex& mutex,
+    std::condition_variable& cv) {
+  std::unique_lock<std::mutex> lock(mutex);
+  cv.wait(lock, [&]() { return count.load() == expected; });
+}
+
+} // namespace
+
+TEST(WorkStealingThreadPoolTest, RunsAllTasks) {
+  WorkStealingThreadPool pool(4);
+  ASSERT_EQ(pool.size(), 4);
+  ASSERT_FALSE(pool.inThreadPool());
+
+  // more tasks than fit into the worker queues, so the overflow queue is used
+  const int num_tasks =
+      static_cast<int>(4 * WorkStealingThreadPool::kQueueCapacity + 100);
+  std::atomic<int> count{0};
+  std::mutex mutex;
+  std::condition_variable cv;
+  for (int i = 0; i < num_tasks; ++i) {
+    pool.run([&]() {
+      if (++count == num_tasks) {
+        std::lock_guard<std::mutex> guard(mutex);
+        cv.notify_all();
+      }
+    });
+  }
+  waitFor(count, num_tasks, mutex, cv);
+  ASSERT_EQ(count.load(), num_tasks);
+}
+
+TEST(WorkStealingThreadPoolTest, NestedTasks) {
+  WorkStealingThreadPool pool(3);
+  const int num_outer = 64;
+  const int num_inner = 16;
+  std::atomic<int> count{0};
+  std::atomic<int> in_pool{0};
+  std::mutex mutex;
+  std::condition_variable cv;
+  auto done = [&]() {
+    if (++count == num_outer * num_inner) {
+      std::lock_guard<std::mutex> guard(mutex);
+      cv.notify_all();
+    }
+  };
+  for (int i = 0; i < num_outer; ++i) {
+    pool.run([&]() {
+      if (pool.inThreadPool()) {
+        ++in_pool;
+      }
+      // tasks submitted from a worker go to its own queue and get stolen by
+      // idle workers
+      for (int j = 0; j < num_inner; ++j) {
+        pool.run(done);
+      }
+    });
+  }
+  waitFor(count, num_outer * num_inner, mutex, cv);
+  ASSERT_EQ(in_pool.load(), num_outer);
+}
+
+TEST(WorkStealingThreadPoolTest, ExceptionsDontKillWorkers) {
+  WorkStealingThreadPool pool(1);
+  std::atomic<int> count{0};
+  std::mutex mutex;
+  std::condition_variable cv;
+  pool.run([]() { throw std::runtime_error("test"); });
+  pool.run([&]() {
+    ++count;
+    std::lock_guard<std::mutex> guard(mutex);
+    cv.notify_all();
+  });
+  waitFor(count, 1, mutex, cv);
+  ASSERT_EQ(count.load(), 1);
+}
+
+TEST(WorkStealingThreadPoolTest, WorkerRunsPendingTasks) {
+  WorkStealingThreadPool pool(1);
+  std::atomic<int> count{0};
+  std::atomic<bool> inner_done{false};
+  std::mutex mutex;
+  std::condition_variable cv;
+  pool.run([&]() {
+    pool.run([&]() { inner_done = true; });
+    // the only worker would wait forever for the task queued behind it
+    while (!inner_done && pool.runPendingTask()) {
+    }
+    ++count;
+    std::lock_guard<std::mutex> guard(mutex);
+    cv.notify_all();
+  });
+  waitFor(count, 1, mutex, cv);
+  ASSERT_TRUE(inner_done.load());
+  ASSERT_FALSE(pool.runPendingTask());
+}
+
+TEST(WorkStealingThreadPoolTest, NoThreads) {
+  WorkStealingThreadPool pool(0);
+  ASSERT_THROW(pool.run([]() {}), std::runtime_error);
+}
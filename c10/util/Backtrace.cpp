@@ -2,6 +2,7 @@
 #include <c10/util/Optional.h>
 #include <c10/util/Type.h>
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <sstream>
@@ -163,12 +164,10 @@ class SymbolHelper {
 } // anonymous namespace
 #endif // SUPPORTS_BACKTRACE
 
-std::string get_backtrace(
+std::vector<void*> get_raw_backtrace(
     size_t frames_to_skip,
-    size_t maximum_number_of_frames,
-    bool skip_python_frames) {
+    size_t maximum_number_of_frames) {
 #if SUPPORTS_BACKTRACE
-
   // We always skip this frame (backtrace).
   frames_to_skip += 1;
 
@@ -177,21 +176,22 @@ std::string get_backtrace(
   // backtrace() gives us a list of return addresses in the current call stack.
   // NOTE: As per man (3) backtrace it can never fail
   // (http://man7.org/linux/man-pages/man3/backtrace.3.html).
-  auto number_of_frames =
-      ::backtrace(callstack.data(), static_cast<int>(callstack.size()));
-
-  // Skip as many frames as requested. This is not efficient, but the sizes here
-  // are small and it makes the code nicer and safer.
-  for (; frames_to_skip > 0 && number_of_frames > 0;
-       --frames_to_skip, --number_of_frames) {
-    callstack.erase(callstack.begin());
-  }
-
-  // `number_of_frames` is strictly less than the current capacity of
-  // `callstack`, so this is just a pointer subtraction and makes the subsequent
-  // code safer.
-  callstack.resize(static_cast<size_t>(number_of_frames));
+  const auto number_of_frames = static_cast<size_t>(
+      ::backtrace(callstack.data(), static_cast<int>(callstack.size())));
+
+  // Skip as many frames as requested.
+  const size_t skipped = std::min(frames_to_skip, number_of_frames);
+  return std::vector<void*>(
+      callstack.begin() + skipped, callstack.begin() + number_of_frames);
+#else // !SUPPORTS_BACKTRACE
+  return {};
+#endif // SUPPORTS_BACKTRACE
+}
 
+std::string symbolize_backtrace(
+    const std::vector<void*>& callstack,
+    bool skip_python_frames) {
+#if SUPPORTS_BACKTRACE
   // `backtrace_symbols` takes the return addresses obtained from `backtrace()`
   // and fetches string representations of each stack. Unfortunately it doesn't
   // return a struct of individual pieces of information but a concatenated
@@ -238,6 +238,20 @@ std::string get_backtrace(
   }
 
   return stream.str();
+#else // !SUPPORTS_BACKTRACE
+  return "(no backtrace available)";
+#endif // SUPPORTS_BACKTRACE
+}
+
+std::string get_backtrace(
+    size_t frames_to_skip,
+    size_t maximum_number_of_frames,
+    bool skip_python_frames) {
+#if SUPPORTS_BACKTRACE
+  // We always skip this frame (backtrace).
+  return symbolize_backtrace(
+      get_raw_backtrace(frames_to_skip + 1, maximum_number_of_frames),
+      skip_python_frames);
 #elif defined(_MSC_VER) // !SUPPORTS_BACKTRACE
   // This backtrace retrieval is implemented on Windows via the Windows
   // API using `CaptureStackBackTrace`, `SymFromAddr` and `SymGetLineFromAddr64`.
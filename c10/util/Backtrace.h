@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <string>
 #include <typeinfo>
+#include <vector>
 
 #include <c10/macros/Macros.h>
 
@@ -12,6 +13,18 @@ C10_API std::string get_backtrace(
     size_t frames_to_skip = 0,
     size_t maximum_number_of_frames = 64,
     bool skip_python_frames = true);
+
+// Returns the return addresses of the current call stack without symbolizing
+// them, which is cheap enough for hot paths. Returns an empty vector where
+// backtraces are not supported.
+C10_API std::vector<void*> get_raw_backtrace(
+    size_t frames_to_skip = 0,
+    size_t maximum_number_of_frames = 64);
+
+// Formats return addresses from get_raw_backtrace like get_backtrace does.
+C10_API std::string symbolize_backtrace(
+    const std::vector<void*>& callstack,
+    bool skip_python_frames = true);
 } // namespace c10
 
 #endif // C10_UTIL_BACKTRACE_H_
@@ -394,6 +394,9 @@ struct DDPLoggingData {
   // Rebuild buckets stats after 1st iteration
   bool has_rebuilt_buckets = false;
   std::vector<int> rebuilt_bucket_sizes = std::vector<int>();
+  // The bucket size cap locked in by bucket size autotuning, -1 if
+  // autotuning is not enabled or has not finished.
+  float autotuned_bucket_cap_mb = -1.0;
   // Average performance stats for the number of sampling iterations
   // when time is recorded (ns).
   // e.g., training loop has ran "DDPLoggingData::iteration=1000" iterations,
@@ -436,6 +439,7 @@ struct DDPLoggingData {
       ddp_logging_data.broadcast_buffers, ", bucket_cap_mb: ", ddp_logging_data.bucket_cap_mb,
       ", find_unused_parameters: ", ddp_logging_data.find_unused_parameters,
       ", gradient_as_bucket_view: ", ddp_logging_data.gradient_as_bucket_view,
+      ", autotuned_bucket_cap_mb: ", ddp_logging_data.autotuned_bucket_cap_mb,
       "\n"
     );
     std::string backendInfo = " Backend Info: ";
@@ -72,8 +72,12 @@ class C10_API intrusive_ptr_target {
   //    atomically increment the use count, if it is greater than 0.
   //    If it is not, you must report that the storage is dead.
   //
-  mutable std::atomic<size_t> refcount_;
-  mutable std::atomic<size_t> weakcount_;
+  //  - Both counts are 32 bits, so that they fit in one word together. This
+  //    matters for objects with millions of instances, like TensorImpl (see
+  //    Note [TensorImpl size constraints]).
+  //
+  mutable std::atomic<uint32_t> refcount_;
+  mutable std::atomic<uint32_t> weakcount_;
 
   template <typename T, typename NullType>
   friend class intrusive_ptr;
@@ -162,23 +166,23 @@ TTarget* assign_ptr_(TTarget* rhs) {
 
 // Increment needs to be acquire-release to make use_count() and
 // unique() reliable.
-inline size_t atomic_refcount_increment(std::atomic<size_t>& refcount) {
+inline uint32_t atomic_refcount_increment(std::atomic<uint32_t>& refcount) {
   return refcount.fetch_add(1, std::memory_order_acq_rel) + 1;
 }
 
 // weak_use_count() is only used for testing, so we don't need it to
 // be reliable. Relaxed should be fine.
-inline size_t atomic_weakcount_increment(std::atomic<size_t>& weakcount) {
+inline uint32_t atomic_weakcount_increment(std::atomic<uint32_t>& weakcount) {
   return weakcount.fetch_add(1, std::memory_order_relaxed) + 1;
 }
 
 // Both decrements need to be acquire-release for correctness. See
 // e.g. std::shared_ptr implementation.
-inline size_t atomic_refcount_decrement(std::atomic<size_t>& refcount) {
+inline uint32_t atomic_refcount_decrement(std::atomic<uint32_t>& refcount) {
   return refcount.fetch_sub(1, std::memory_order_acq_rel) - 1;
 }
 
-inline size_t atomic_weakcount_decrement(std::atomic<size_t>& weakcount) {
+inline uint32_t atomic_weakcount_decrement(std::atomic<uint32_t>& weakcount) {
   return weakcount.fetch_sub(1, std::memory_order_acq_rel) - 1;
 }
 
@@ -5,6 +5,12 @@
 #include "caffe2/core/blob_serialization.h"
 #include "caffe2/core/logging.h"
 
+C10_DEFINE_int(
+    caffe2_db_prefetch_records,
+    0,
+    "If positive, the cursors of the dbs opened for reading by CreateDB read "
+    "this many records ahead on a background thread.");
+
 namespace caffe2 {
 
 CAFFE_KNOWN_TYPE(db::DBReader);
@@ -173,6 +179,166 @@ class MiniDB : public DB {
 REGISTER_CAFFE2_DB(MiniDB, MiniDB);
 REGISTER_CAFFE2_DB(minidb, MiniDB);
 
+PrefetchingCursor::PrefetchingCursor(DB* db, size_t capacity)
+    : records_(capacity) {
+  CAFFE_ENFORCE_GT(capacity, 0);
+  thread_ = std::thread([this, db]() { Prefetch(db); });
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this]() { return started_; });
+  if (error_) {
+    // The wrapped cursor couldn't be created, the thread has exited.
+    lock.unlock();
+    thread_.join();
+    std::rethrow_exception(error_);
+  }
+}
+
+PrefetchingCursor::~PrefetchingCursor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  thread_.join();
+}
+
+void PrefetchingCursor::Prefetch(DB* db) {
+  std::unique_ptr<Cursor> cursor;
+  try {
+    cursor = db->NewCursor();
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    error_ = std::current_exception();
+    started_ = true;
+    cv_.notify_all();
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  supports_seek_ = cursor->SupportsSeek();
+  started_ = true;
+  cv_.notify_all();
+  uint64_t generation = generation_;
+  while (true) {
+    cv_.wait(lock, [&]() {
+      return stop_ || generation != generation_ ||
+          (!end_ && !error_ && count_ < records_.size());
+    });
+    if (stop_) {
+      break;
+    }
+    const bool reposition = generation != generation_;
+    generation = generation_;
+    const bool to_first = seek_to_first_;
+    const string key = reposition && !to_first ? seek_key_ : string();
+    // Only this thread writes the slot past the last record, and the consumer
+    // doesn't read it before it is published below.
+    Record& record = records_[(head_ + count_) % records_.size()];
+    lock.unlock();
+
+    bool valid = false;
+    std::exception_ptr error;
+    try {
+      if (reposition) {
+        if (to_first) {
+          cursor->SeekToFirst();
+        } else {
+          cursor->Seek(key);
+        }
+      }
+      valid = cursor->Valid();
+      if (valid) {
+        // Assigning keeps the capacity of the buffers of the slot.
+        record.key = cursor->key();
+        record.value = cursor->value();
+        cursor->Next();
+      }
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    lock.lock();
+    if (generation != generation_) {
+      // The consumer seeked while the record was read, drop it.
+      continue;
+    }
+    if (error) {
+      error_ = error;
+    } else if (valid) {
+      ++count_;
+    } else {
+      end_ = true;
+    }
+    cv_.notify_all();
+  }
+  lock.unlock();
+  // The wrapped cursor is destroyed on the thread that created it.
+  cursor.reset();
+}
+
+void PrefetchingCursor::WaitForRecord(std::unique_lock<std::mutex>& lock) {
+  cv_.wait(lock, [this]() { return count_ > 0 || end_ || error_; });
+  if (count_ == 0 && error_) {
+    std::rethrow_exception(error_);
+  }
+}
+
+void PrefetchingCursor::Reposition(bool to_first, const string& key) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++generation_;
+    seek_to_first_ = to_first;
+    seek_key_ = key;
+    head_ = 0;
+    count_ = 0;
+    end_ = false;
+    error_ = nullptr;
+  }
+  cv_.notify_all();
+}
+
+void PrefetchingCursor::Seek(const string& key) {
+  Reposition(false, key);
+}
+
+void PrefetchingCursor::SeekToFirst() {
+  Reposition(true, string());
+}
+
+void PrefetchingCursor::Next() {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    WaitForRecord(lock);
+    if (count_ == 0) {
+      // Already at the end.
+      return;
+    }
+    head_ = (head_ + 1) % records_.size();
+    --count_;
+  }
+  cv_.notify_all();
+}
+
+string PrefetchingCursor::key() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  WaitForRecord(lock);
+  CAFFE_ENFORCE(count_ > 0, "Cursor is at invalid location!");
+  return records_[head_].key;
+}
+
+string PrefetchingCursor::value() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  WaitForRecord(lock);
+  CAFFE_ENFORCE(count_ > 0, "Cursor is at invalid location!");
+  return records_[head_].value;
+}
+
+bool PrefetchingCursor::Valid() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  WaitForRecord(lock);
+  return count_ > 0;
+}
+
 void DBReaderSerializer::Serialize(
     const void* pointer,
     TypeMeta typeMeta,
@@ -1,12 +1,18 @@
 #ifndef CAFFE2_CORE_DB_H_
 #define CAFFE2_CORE_DB_H_
 
+#include <condition_variable>
+#include <exception>
 #include <mutex>
+#include <thread>
 
+#include "c10/util/Flags.h"
 #include "c10/util/Registry.h"
 #include "caffe2/core/blob_serialization.h"
 #include "caffe2/proto/caffe2_pb.h"
 
+C10_DECLARE_int(caffe2_db_prefetch_records);
+
 namespace caffe2 {
 namespace db {
 
@@ -104,6 +110,91 @@ class TORCH_API DB {
   C10_DISABLE_COPY_AND_ASSIGN(DB);
 };
 
+/**
+ * A cursor that reads ahead of its consumer. The records are read from a
+ * cursor of the wrapped db on a background thread into a bounded ring of
+ * `capacity` records, whose buffers are reused from one record to the next,
+ * so that Next() only waits for I/O when the consumer is faster than the db.
+ *
+ * The wrapped cursor is created, used and destroyed on the background thread
+ * only, as the cursors of some dbs are bound to the thread that created them.
+ * Seek() and SeekToFirst() drop the records read ahead. The db must outlive
+ * the cursor.
+ */
+class TORCH_API PrefetchingCursor : public Cursor {
+ public:
+  PrefetchingCursor(DB* db, size_t capacity);
+  ~PrefetchingCursor() override;
+
+  void Seek(const string& key) override;
+  bool SupportsSeek() override {
+    return supports_seek_;
+  }
+  void SeekToFirst() override;
+  void Next() override;
+  string key() override;
+  string value() override;
+  bool Valid() override;
+
+ private:
+  struct Record {
+    string key;
+    string value;
+  };
+
+  // Body of the background thread.
+  void Prefetch(DB* db);
+  // Waits until the first record is read or the end of the db is reached,
+  // and rethrows the errors of the background thread.
+  void WaitForRecord(std::unique_lock<std::mutex>& lock);
+  // Drops the records read ahead and has the background thread seek.
+  void Reposition(bool to_first, const string& key);
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  vector<Record> records_;
+  size_t head_{0};
+  size_t count_{0};
+  // Whether the background thread reached the end of the db.
+  bool end_{false};
+  // Incremented by every seek, the records read before it are dropped.
+  uint64_t generation_{0};
+  bool seek_to_first_{false};
+  string seek_key_;
+  bool started_{false};
+  bool stop_{false};
+  bool supports_seek_{false};
+  std::exception_ptr error_;
+  std::thread thread_;
+};
+
+/**
+ * A db whose cursors are PrefetchingCursors over the cursors of a wrapped db.
+ * Transactions are passed through.
+ */
+class TORCH_API PrefetchingDB : public DB {
+ public:
+  PrefetchingDB(std::unique_ptr<DB> db, size_t capacity)
+      : DB("<prefetching>", READ), db_(std::move(db)), capacity_(capacity) {
+    CAFFE_ENFORCE(db_, "Passed null db");
+    CAFFE_ENFORCE_GT(capacity_, 0);
+  }
+
+  void Close() override {
+    db_->Close();
+  }
+  std::unique_ptr<Cursor> NewCursor() override {
+    return make_unique<PrefetchingCursor>(db_.get(), capacity_);
+  }
+  std::unique_ptr<Transaction> NewTransaction() override {
+    return db_->NewTransaction();
+  }
+
+ private:
+  std::unique_ptr<DB> db_;
+  size_t capacity_;
+};
+
 // Database classes are registered by their names so we can do optional
 // dependencies.
 C10_DECLARE_REGISTRY(Caffe2DBRegistry, DB, const string&, Mode);
@@ -115,11 +206,18 @@ C10_DECLARE_REGISTRY(Caffe2DBRegistry, DB, const string&, Mode);
  * caller takes the ownership of the pointer. If the database type is not
  * supported, a nullptr is returned. The caller is responsible for examining the
  * validity of the pointer.
+ *
+ * If --caffe2_db_prefetch_records is positive, the cursors of the databases
+ * opened for reading read that many records ahead, see PrefetchingCursor.
  */
 inline unique_ptr<DB>
 CreateDB(const string& db_type, const string& source, Mode mode) {
   auto result = Caffe2DBRegistry()->Create(db_type, source, mode);
   VLOG(1) << ((!result) ? "not found db " : "found db ") << db_type;
+  if (result && mode == READ && FLAGS_caffe2_db_prefetch_records > 0) {
+    result = make_unique<PrefetchingDB>(
+        std::move(result), FLAGS_caffe2_db_prefetch_records);
+  }
   return result;
 }
 
@@ -56,6 +56,12 @@ C10_DEFINE_bool(
     false,
     "Run root tasks in current thread instread of scheduling to threadpool");
 
+C10_DEFINE_bool(
+    caffe2_net_async_priority_scheduling,
+    false,
+    "Run ready tasks in order of their critical path length and run a task's "
+    "successor on the same worker when possible");
+
 namespace caffe2 {
 
 std::vector<int>& AsyncNetBase::getStreamCounters() {
@@ -588,6 +594,7 @@ ExecutionOptions::ExecutionOptions(
   }
 
   use_dfs_scheduling_ = false;
+  use_priority_scheduling_ = FLAGS_caffe2_net_async_priority_scheduling;
 
   for (int arg_idx = 0; arg_idx < net_def->arg_size(); ++arg_idx) {
     auto& arg = net_def->arg(arg_idx);
@@ -599,6 +606,10 @@ ExecutionOptions::ExecutionOptions(
       CAFFE_ENFORCE(arg.has_i(), "deferrable_mode should be an int");
       use_dfs_scheduling_ = arg.i() == 1; // corr. to DFS scheduling
     }
+    if (arg.has_name() && arg.name() == "priority_scheduling") {
+      CAFFE_ENFORCE(arg.has_i(), "priority_scheduling should be an int");
+      use_priority_scheduling_ = arg.i() == 1;
+    }
   }
 
   if (FLAGS_caffe2_net_async_profile_operators) {
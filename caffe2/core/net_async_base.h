@@ -23,6 +23,7 @@ C10_DECLARE_bool(caffe2_net_async_check_stream_status);
 C10_DECLARE_bool(caffe2_net_async_use_single_pool);
 C10_DECLARE_bool(caffe2_net_async_use_per_net_pools);
 C10_DECLARE_bool(caffe2_net_async_run_root_tasks_inline);
+C10_DECLARE_bool(caffe2_net_async_priority_scheduling);
 C10_DECLARE_bool(caffe2_net_async_profile_operators);
 
 namespace caffe2 {
@@ -53,6 +54,9 @@ struct ExecutionOptions {
   bool report_stats_ = false;
   // immediately run children tasks inline whenever possible
   bool use_dfs_scheduling_ = false;
+  // run ready tasks with the longest critical path first, and a task's
+  // successor inline on the same worker
+  bool use_priority_scheduling_ = false;
   // run net's root tasks in RunAsync thread instead of in thread pool
   bool run_root_tasks_inline_ = false;
 };
@@ -1,5 +1,7 @@
 #include "caffe2/core/net_async_scheduling.h"
 
+#include <algorithm>
+
 #include "caffe2/core/net_async_tracing.h"
 
 namespace caffe2 {
@@ -7,7 +9,13 @@ namespace caffe2 {
 AsyncSchedulingNet::AsyncSchedulingNet(
     const std::shared_ptr<const NetDef>& net_def,
     Workspace* ws)
-    : AsyncNetBase(net_def, ws), running_(false) {}
+    : AsyncNetBase(net_def, ws), running_(false) {
+  if (options_.use_priority_scheduling_) {
+    task_priorities_ =
+        dag_utils::computeChainPriorities(chain_nodes_, chains_);
+    ready_task_funcs_.resize(tasksNum());
+  }
+}
 
 void AsyncSchedulingNet::reset() {
   AsyncNetBase::reset();
@@ -25,6 +33,10 @@ bool AsyncSchedulingNet::isInlineTask(int parent_id, int child_id) const {
   if (!options_.use_dfs_scheduling_) {
     return false;
   }
+  return isSameDeviceTask(parent_id, child_id);
+}
+
+bool AsyncSchedulingNet::isSameDeviceTask(int parent_id, int child_id) const {
   const auto* last_parent_op = lastTaskOp(parent_id);
   const auto* first_child_op = firstTaskOp(child_id);
   // check that we do not cross device boundary
@@ -72,6 +84,17 @@ void AsyncSchedulingNet::schedule(int task_id, bool run_inline) noexcept {
         }
       }
 
+      // with priority scheduling, the children that are ready are scheduled
+      // together once we know all of them
+      std::vector<int> ready_children;
+      auto schedule_child = [this, task_id, &ready_children](int child_id) {
+        if (options_.use_priority_scheduling_) {
+          ready_children.push_back(child_id);
+        } else {
+          schedule(child_id, isInlineTask(task_id, child_id));
+        }
+      };
+
       for (auto child_id : children(task_id)) {
         int parent_count = updateParentCount(child_id);
         if (parent_count == 0) {
@@ -85,7 +108,7 @@ void AsyncSchedulingNet::schedule(int task_id, bool run_inline) noexcept {
               options_.finish_chain_ || canSchedule(child_id)) {
             // if DFS scheduling is enabled, run children inline,
             // ignore DFS scheduling in callbacks
-            schedule(child_id, isInlineTask(task_id, child_id));
+            schedule_child(child_id);
           } else {
             bool parent_failed = false;
             bool parent_needs_polling = false;
@@ -123,7 +146,7 @@ void AsyncSchedulingNet::schedule(int task_id, bool run_inline) noexcept {
             if (parent_failed) {
               // one of parents failed, set failure flag and wrap up execution
               success_ = false;
-              schedule(child_id, isInlineTask(task_id, child_id));
+              schedule_child(child_id);
             } else if (parent_needs_polling) {
               // some parents are blocking us from scheduling a child and don't
               // support callbacks, using polling
@@ -141,12 +164,16 @@ void AsyncSchedulingNet::schedule(int task_id, bool run_inline) noexcept {
               }
             } else {
               // we're ready to schedule a child
-              schedule(child_id, isInlineTask(task_id, child_id));
+              schedule_child(child_id);
             }
           }
         }
       }
 
+      if (!ready_children.empty()) {
+        scheduleReadyChildren(task_id, ready_children);
+      }
+
       // In case of net's failure, make sure all pending tasks are finished
       if (!success_) {
         CancelAndFinishAsyncTasks();
@@ -172,12 +199,66 @@ void AsyncSchedulingNet::schedule(int task_id, bool run_inline) noexcept {
 
   if (run_inline) {
     schedule_func();
+  } else if (options_.use_priority_scheduling_) {
+    enqueueReadyTask(task_id, std::move(schedule_func));
   } else {
     const auto& device_option = event(task_id).GetDeviceOption();
     pool(device_option)->run(schedule_func);
   }
 }
 
+void AsyncSchedulingNet::scheduleReadyChildren(
+    int parent_id,
+    std::vector<int>& child_ids) {
+  std::stable_sort(
+      child_ids.begin(), child_ids.end(), [this](int lhs, int rhs) {
+        return task_priorities_[lhs] > task_priorities_[rhs];
+      });
+  // The most critical child on the parent's device runs inline, on the worker
+  // that just produced its inputs; the others are queued first, so that idle
+  // workers can pick them up in the meantime
+  int inline_child_id = -1;
+  for (auto child_id : child_ids) {
+    if (inline_child_id < 0 && isSameDeviceTask(parent_id, child_id)) {
+      inline_child_id = child_id;
+    } else {
+      schedule(child_id);
+    }
+  }
+  if (inline_child_id >= 0) {
+    schedule(inline_child_id, /* run_inline */ true);
+  }
+}
+
+void AsyncSchedulingNet::enqueueReadyTask(
+    int task_id,
+    std::function<void()> task_func) {
+  auto* task_pool = pool(event(task_id).GetDeviceOption());
+  {
+    std::unique_lock<std::mutex> lock(ready_tasks_mutex_);
+    ready_task_funcs_[task_id] = std::move(task_func);
+    ready_tasks_[task_pool].emplace(task_priorities_[task_id], -task_id);
+  }
+  // one job per ready task, each job runs the most critical task that is
+  // ready on the pool by the time a worker gets to it
+  task_pool->run(
+      std::bind(&AsyncSchedulingNet::runReadyTask, this, task_pool));
+}
+
+void AsyncSchedulingNet::runReadyTask(TaskThreadPoolBase* task_pool) {
+  std::function<void()> task_func;
+  {
+    std::unique_lock<std::mutex> lock(ready_tasks_mutex_);
+    auto& tasks = ready_tasks_[task_pool];
+    CAFFE_ENFORCE(!tasks.empty(), "No ready task for the pool");
+    auto task_id = -tasks.top().second;
+    tasks.pop();
+    task_func = std::move(ready_task_funcs_[task_id]);
+    ready_task_funcs_[task_id] = nullptr;
+  }
+  task_func();
+}
+
 void AsyncSchedulingNet::parentCallback(int parent_id) {
   if (event(parent_id).Query() != EventStatus::EVENT_SUCCESS) {
     success_ = false;
@@ -1,6 +1,8 @@
 #ifndef CAFFE2_CORE_NET_ASYNC_SCHEDULING_H_
 #define CAFFE2_CORE_NET_ASYNC_SCHEDULING_H_
 
+#include <queue>
+
 #include "caffe2/core/net_async_base.h"
 
 namespace caffe2 {
@@ -25,6 +27,10 @@ class TORCH_API AsyncSchedulingNet : public AsyncNetBase {
   virtual void finishRun();
   void parentCallback(int parent_id);
   bool isInlineTask(int parent_id, int child_id) const;
+  bool isSameDeviceTask(int parent_id, int child_id) const;
+  void scheduleReadyChildren(int parent_id, std::vector<int>& child_ids);
+  void enqueueReadyTask(int task_id, std::function<void()> task_func);
+  void runReadyTask(TaskThreadPoolBase* task_pool);
 
   void CancelAndFinishAsyncTasks();
 
@@ -34,6 +40,16 @@ class TORCH_API AsyncSchedulingNet : public AsyncNetBase {
 
   std::atomic<int> processed_tasks_num_;
 
+  // priority scheduling: critical path priority of each task, and the tasks
+  // that are ready to run on each pool as (priority, -task_id)
+  std::vector<int> task_priorities_;
+  std::mutex ready_tasks_mutex_;
+  std::unordered_map<
+      TaskThreadPoolBase*,
+      std::priority_queue<std::pair<int, int>>>
+      ready_tasks_;
+  std::vector<std::function<void()>> ready_task_funcs_;
+
   C10_DISABLE_COPY_AND_ASSIGN(AsyncSchedulingNet);
 };
 
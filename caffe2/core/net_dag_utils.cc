@@ -1,5 +1,6 @@
 #include "caffe2/core/net_dag_utils.h"
 
+#include <queue>
 #include <set>
 #include <stack>
 #include <unordered_map>
@@ -512,5 +513,42 @@ std::vector<OpGraphNode> prepareChainGraphNodes(
   return chain_nodes;
 }
 
+std::vector<int> computeChainPriorities(
+    const std::vector<OpGraphNode>& chain_nodes,
+    const std::vector<std::vector<int>>& execution_chains) {
+  CAFFE_ENFORCE_EQ(chain_nodes.size(), execution_chains.size());
+  const int num_chains = chain_nodes.size();
+  std::vector<int> priorities(num_chains, 0);
+  // Visit the chains from the sinks up, a chain is visited once all of its
+  // children have been
+  std::vector<int> pending_children(num_chains);
+  std::queue<int> ready;
+  for (int chain_idx = 0; chain_idx < num_chains; ++chain_idx) {
+    pending_children[chain_idx] = chain_nodes[chain_idx].children_.size();
+    if (pending_children[chain_idx] == 0) {
+      ready.push(chain_idx);
+    }
+  }
+  int num_visited = 0;
+  while (!ready.empty()) {
+    auto chain_idx = ready.front();
+    ready.pop();
+    ++num_visited;
+    int max_child_priority = 0;
+    for (auto child_idx : chain_nodes[chain_idx].children_) {
+      max_child_priority = std::max(max_child_priority, priorities[child_idx]);
+    }
+    priorities[chain_idx] =
+        execution_chains[chain_idx].size() + max_child_priority;
+    for (auto parent_idx : chain_nodes[chain_idx].parents_) {
+      if (--pending_children[parent_idx] == 0) {
+        ready.push(parent_idx);
+      }
+    }
+  }
+  CAFFE_ENFORCE_EQ(num_visited, num_chains, "Chain graph has a cycle");
+  return priorities;
+}
+
 } // namespace dag_utils
 } // namespace caffe2
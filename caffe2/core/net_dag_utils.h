@@ -63,6 +63,13 @@ std::vector<OpGraphNode> prepareChainGraphNodes(
     const std::vector<dag_utils::OperatorNode>& operator_nodes,
     const std::vector<std::vector<int>>& execution_chains);
 
+// Critical path priority of each chain: the number of ops on the longest path
+// from the start of the chain to the end of the net. Running the chains with
+// the highest priority first shortens the tail of the execution.
+std::vector<int> computeChainPriorities(
+    const std::vector<OpGraphNode>& chain_nodes,
+    const std::vector<std::vector<int>>& execution_chains);
+
 } // namespace dag_utils
 } // namespace caffe2
 
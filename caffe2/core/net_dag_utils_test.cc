@@ -293,4 +293,19 @@ TEST(DagUtilTest, Mixed2) {
       {0, {0}}, {1, {1}}, {3, {3, 6}}, {4, {4, 2, 5}}, {7, {7}}, {8, {8}}};
   EXPECT_EQ(chains, expected);
 }
+
+// Chains 0 -> {1, 2} -> 3, with chain 2 on the longer path
+TEST(DagUtilTest, ChainPriorities) {
+  std::vector<dag_utils::OpGraphNode> chain_nodes(4);
+  chain_nodes[0].children_ = {1, 2};
+  chain_nodes[1].parents_ = {0};
+  chain_nodes[1].children_ = {3};
+  chain_nodes[2].parents_ = {0};
+  chain_nodes[2].children_ = {3};
+  chain_nodes[3].parents_ = {1, 2};
+  std::vector<std::vector<int>> chains{{0}, {1}, {2, 3, 4}, {5, 6}};
+  auto priorities = dag_utils::computeChainPriorities(chain_nodes, chains);
+  std::vector<int> expected{6, 3, 5, 2};
+  EXPECT_EQ(priorities, expected);
+}
 } // namespace caffe2
@@ -1111,4 +1111,55 @@ TEST(NetTest, ProfDAGNetErrorTest) {
   testProfDAGNetErrorCase(/*test_error=*/true);
 }
 
+TEST(NetTest, PrioritySchedulingNet) {
+  const auto spec = R"DOC(
+        name: "priority_scheduling_test_net"
+        type: "async_scheduling"
+        external_input: "in"
+        arg {
+          name: "priority_scheduling"
+          i: 1
+        }
+        op {
+          input: "in"
+          output: "a"
+          type: "NetTestDummy"
+        }
+        op {
+          input: "a"
+          output: "b"
+          type: "NetTestDummy"
+        }
+        op {
+          input: "a"
+          output: "c"
+          type: "NetTestDummy"
+        }
+        op {
+          input: "c"
+          output: "d"
+          type: "NetTestDummy"
+        }
+        op {
+          input: "b"
+          input: "d"
+          output: "out"
+          type: "NetTestDummy"
+        }
+  )DOC";
+
+  NetDef net_def;
+  CAFFE_ENFORCE(TextFormat::ParseFromString(spec, &net_def));
+  net_def.set_num_workers(kTestPoolSize);
+
+  Workspace ws;
+  ws.CreateBlob("in");
+  auto net = CreateNet(net_def, &ws);
+  for (auto num_runs = 0; num_runs < 10; ++num_runs) {
+    counter.exchange(0);
+    ASSERT_TRUE(net->Run());
+    ASSERT_EQ(counter.load(), net_def.op_size());
+  }
+}
+
 } // namespace caffe2
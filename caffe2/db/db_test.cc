@@ -89,6 +89,34 @@ TEST(DBSeekTest, LMDB) {
   DBSeekTestWrapper("lmdb");
 }
 
+TEST(DBSeekTest, PrefetchingLevelDB) {
+  std::string name = std::tmpnam(nullptr);
+  CreateAndFill("leveldb", name);
+  // Fewer slots than records, so the reads wait for the background thread.
+  PrefetchingDB db(CreateDB("leveldb", name, READ), 3);
+  std::unique_ptr<Cursor> cursor(db.NewCursor());
+  EXPECT_TRUE(cursor->SupportsSeek());
+  TestCursor(cursor.get());
+}
+
+TEST(DBReaderTest, PrefetchingReader) {
+  std::string name = std::tmpnam(nullptr);
+  CreateAndFill("minidb", name);
+  FLAGS_caffe2_db_prefetch_records = 4;
+  std::unique_ptr<DBReader> reader(new DBReader("minidb", name));
+  FLAGS_caffe2_db_prefetch_records = 0;
+  string key;
+  string value;
+  // Read past the end, the reader goes back to the first record.
+  for (int i = 0; i < 2 * kMaxItems + 1; ++i) {
+    std::stringstream ss;
+    ss << std::setw(2) << std::setfill('0') << i % kMaxItems;
+    reader->Read(&key, &value);
+    EXPECT_EQ(key, ss.str());
+    EXPECT_EQ(value, ss.str());
+  }
+}
+
 TEST(DBReaderTest, Reader) {
   std::string name = std::tmpnam(nullptr);
   CreateAndFill("leveldb", name);
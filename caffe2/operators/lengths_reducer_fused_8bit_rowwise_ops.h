@@ -6,6 +6,7 @@
 #include "caffe2/core/operator.h"
 #include "caffe2/operators/fused_rowwise_8bit_conversion_ops.h"
 #include "caffe2/operators/reducer_functors.h"
+#include "caffe2/perfkernels/embedding_lookup_prefetch.h"
 #include "caffe2/perfkernels/fused_8bit_rowwise_embedding_lookup.h"
 #include "caffe2/utils/math.h"
 #ifdef USE_FBGEMM
@@ -22,7 +23,12 @@ class SparseLengthsFused8BitRowwiseOp : public Operator<Context> {
       "Cannot have with_weights and is_mean a the same time");
 
   USE_OPERATOR_CONTEXT_FUNCTIONS;
-  USE_SIMPLE_CTOR_DTOR(SparseLengthsFused8BitRowwiseOp)
+  template <class... Args>
+  explicit SparseLengthsFused8BitRowwiseOp(Args&&... args)
+      : Operator<Context>(std::forward<Args>(args)...) {
+    MaybeTuneEmbeddingLookupPrefetchDistance();
+  }
+  virtual ~SparseLengthsFused8BitRowwiseOp() noexcept {}
 
   bool RunOnDevice() override {
     return DispatchHelper<TensorTypes<int32_t, int64_t>>::call(
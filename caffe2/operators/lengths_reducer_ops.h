@@ -2,6 +2,7 @@
 #include "caffe2/core/context.h"
 #include "caffe2/core/operator.h"
 #include "caffe2/perfkernels/embedding_lookup.h"
+#include "caffe2/perfkernels/embedding_lookup_prefetch.h"
 #ifdef USE_FBGEMM
 #include "fbgemm/Fbgemm.h"
 #endif
@@ -28,6 +29,7 @@ class CPUSparseLengthsReductionOp : public Operator<CPUContext> {
       : Operator<CPUContext>(std::forward<Args>(args)...) {
     static_assert(
         !(USE_WEIGHT & USE_MEAN), "Cannot both specify weight and mean.");
+    MaybeTuneEmbeddingLookupPrefetchDistance();
   }
 
   ~CPUSparseLengthsReductionOp() {}
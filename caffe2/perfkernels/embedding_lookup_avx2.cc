@@ -7,6 +7,7 @@
 
 #include <c10/util/Half.h>
 #include <immintrin.h>
+#include "caffe2/perfkernels/embedding_lookup_prefetch.h"
 namespace caffe2 {
 
 template <bool IS_WEIGHT_POSITIONAL>
@@ -22,7 +23,7 @@ static bool EmbeddingLookup_int32_t_float_float__avx2_fma(
     const float* scale_bias,
     bool normalize_by_lengths,
     float* out) {
-  const int prefdist_T0 = 16;
+  const int prefdist_T0 = GetEmbeddingLookupPrefetchDistance();
   const int fused_block_size = block_size + 0;
   int dataInd = 0;
   if (block_size == 128) {
@@ -449,7 +450,7 @@ static bool EmbeddingLookup_int64_t_float_float__avx2_fma(
     const float* scale_bias,
     bool normalize_by_lengths,
     float* out) {
-  const int64_t prefdist_T0 = 16;
+  const int64_t prefdist_T0 = GetEmbeddingLookupPrefetchDistance();
   const int64_t fused_block_size = block_size + 0;
   int64_t dataInd = 0;
   if (block_size == 128) {
@@ -876,7 +877,7 @@ static bool EmbeddingLookup_int32_t_half_float__avx2_fma(
     const float* scale_bias,
     bool normalize_by_lengths,
     float* out) {
-  const int prefdist_T0 = 16;
+  const int prefdist_T0 = GetEmbeddingLookupPrefetchDistance();
   const int fused_block_size = block_size + 0;
   int dataInd = 0;
   if (block_size == 128) {
@@ -1423,7 +1424,7 @@ static bool EmbeddingLookup_int64_t_half_float__avx2_fma(
     const float* scale_bias,
     bool normalize_by_lengths,
     float* out) {
-  const int64_t prefdist_T0 = 16;
+  const int64_t prefdist_T0 = GetEmbeddingLookupPrefetchDistance();
   const int64_t fused_block_size = block_size + 0;
   int64_t dataInd = 0;
   if (block_size == 128) {
@@ -1970,7 +1971,7 @@ static bool EmbeddingLookup_int32_t_uint8_t_float__avx2_fma(
     const float* scale_bias,
     bool normalize_by_lengths,
     float* out) {
-  const int prefdist_T0 = 16;
+  const int prefdist_T0 = GetEmbeddingLookupPrefetchDistance();
   const int fused_block_size = block_size + 0;
   int dataInd = 0;
   if (block_size == 128) {
@@ -2530,7 +2531,7 @@ static bool EmbeddingLookup_int64_t_uint8_t_float__avx2_fma(
     const float* scale_bias,
     bool normalize_by_lengths,
     float* out) {
-  const int64_t prefdist_T0 = 16;
+  const int64_t prefdist_T0 = GetEmbeddingLookupPrefetchDistance();
   const int64_t fused_block_size = block_size + 0;
   int64_t dataInd = 0;
   if (block_size == 128) {
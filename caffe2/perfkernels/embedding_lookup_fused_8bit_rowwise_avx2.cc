@@ -7,6 +7,7 @@
 
 #include <c10/util/Half.h>
 #include <immintrin.h>
+#include "caffe2/perfkernels/embedding_lookup_prefetch.h"
 namespace caffe2 {
 
 template <bool IS_WEIGHT_POSITIONAL>
@@ -21,7 +22,7 @@ static bool Fused8BitRowwiseEmbeddingLookup_int32_t_float_float__avx2_fma(
     const float* weights,
     bool normalize_by_lengths,
     float* out) {
-  const int prefdist_T0 = 16;
+  const int prefdist_T0 = GetEmbeddingLookupPrefetchDistance();
   const int fused_block_size = block_size + 2;
   int dataInd = 0;
   if (block_size == 128) {
@@ -443,7 +444,7 @@ static bool Fused8BitRowwiseEmbeddingLookup_int64_t_float_float__avx2_fma(
     const float* weights,
     bool normalize_by_lengths,
     float* out) {
-  const int64_t prefdist_T0 = 16;
+  const int64_t prefdist_T0 = GetEmbeddingLookupPrefetchDistance();
   const int64_t fused_block_size = block_size + 2;
   int64_t dataInd = 0;
   if (block_size == 128) {
@@ -865,7 +866,7 @@ static bool Fused8BitRowwiseEmbeddingLookup_int32_t_half_float__avx2_fma(
     const float* weights,
     bool normalize_by_lengths,
     float* out) {
-  const int prefdist_T0 = 16;
+  const int prefdist_T0 = GetEmbeddingLookupPrefetchDistance();
   const int fused_block_size = block_size + 4;
   int dataInd = 0;
   if (block_size == 128) {
@@ -1407,7 +1408,7 @@ static bool Fused8BitRowwiseEmbeddingLookup_int64_t_half_float__avx2_fma(
     const float* weights,
     bool normalize_by_lengths,
     float* out) {
-  const int64_t prefdist_T0 = 16;
+  const int64_t prefdist_T0 = GetEmbeddingLookupPrefetchDistance();
   const int64_t fused_block_size = block_size + 4;
   int64_t dataInd = 0;
   if (block_size == 128) {
@@ -1949,7 +1950,7 @@ static bool Fused8BitRowwiseEmbeddingLookup_int32_t_uint8_t_float__avx2_fma(
     const float* weights,
     bool normalize_by_lengths,
     float* out) {
-  const int prefdist_T0 = 16;
+  const int prefdist_T0 = GetEmbeddingLookupPrefetchDistance();
   const int fused_block_size = block_size + 8;
   int dataInd = 0;
   if (block_size == 128) {
@@ -2514,7 +2515,7 @@ static bool Fused8BitRowwiseEmbeddingLookup_int64_t_uint8_t_float__avx2_fma(
     const float* weights,
     bool normalize_by_lengths,
     float* out) {
-  const int64_t prefdist_T0 = 16;
+  const int64_t prefdist_T0 = GetEmbeddingLookupPrefetchDistance();
   const int64_t fused_block_size = block_size + 8;
   int64_t dataInd = 0;
   if (block_size == 128) {
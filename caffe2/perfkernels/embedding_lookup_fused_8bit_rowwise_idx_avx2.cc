@@ -7,6 +7,7 @@
 
 #include <c10/util/Half.h>
 #include <immintrin.h>
+#include "caffe2/perfkernels/embedding_lookup_prefetch.h"
 namespace caffe2 {
 
 template <bool IS_WEIGHT_POSITIONAL>
@@ -21,7 +22,7 @@ static bool Fused8BitRowwiseEmbeddingLookupIdx_int32_t_float_float__avx2_fma(
     const float* weights,
     bool normalize_by_lengths,
     float* out) {
-  const int prefdist_T0 = 16;
+  const int prefdist_T0 = GetEmbeddingLookupPrefetchDistance();
   const int fused_block_size = block_size + 2;
   int64_t dataInd = 0;
   if (block_size == 128) {
@@ -454,7 +455,7 @@ static bool Fused8BitRowwiseEmbeddingLookupIdx_int64_t_float_float__avx2_fma(
     const float* weights,
     bool normalize_by_lengths,
     float* out) {
-  const int64_t prefdist_T0 = 16;
+  const int64_t prefdist_T0 = GetEmbeddingLookupPrefetchDistance();
   const int64_t fused_block_size = block_size + 2;
   int64_t dataInd = 0;
   if (block_size == 128) {
@@ -887,7 +888,7 @@ static bool Fused8BitRowwiseEmbeddingLookupIdx_int32_t_half_float__avx2_fma(
     const float* weights,
     bool normalize_by_lengths,
     float* out) {
-  const int prefdist_T0 = 16;
+  const int prefdist_T0 = GetEmbeddingLookupPrefetchDistance();
   const int fused_block_size = block_size + 4;
   int64_t dataInd = 0;
   if (block_size == 128) {
@@ -1439,7 +1440,7 @@ static bool Fused8BitRowwiseEmbeddingLookupIdx_int64_t_half_float__avx2_fma(
     const float* weights,
     bool normalize_by_lengths,
     float* out) {
-  const int64_t prefdist_T0 = 16;
+  const int64_t prefdist_T0 = GetEmbeddingLookupPrefetchDistance();
   const int64_t fused_block_size = block_size + 4;
   int64_t dataInd = 0;
   if (block_size == 128) {
@@ -1991,7 +1992,7 @@ static bool Fused8BitRowwiseEmbeddingLookupIdx_int32_t_uint8_t_float__avx2_fma(
     const float* weights,
     bool normalize_by_lengths,
     float* out) {
-  const int prefdist_T0 = 16;
+  const int prefdist_T0 = GetEmbeddingLookupPrefetchDistance();
   const int fused_block_size = block_size + 8;
   int64_t dataInd = 0;
   if (block_size == 128) {
@@ -2568,7 +2569,7 @@ static bool Fused8BitRowwiseEmbeddingLookupIdx_int64_t_uint8_t_float__avx2_fma(
     const float* weights,
     bool normalize_by_lengths,
     float* out) {
-  const int64_t prefdist_T0 = 16;
+  const int64_t prefdist_T0 = GetEmbeddingLookupPrefetchDistance();
   const int64_t fused_block_size = block_size + 8;
   int64_t dataInd = 0;
   if (block_size == 128) {
@@ -0,0 +1,109 @@
+#include "caffe2/perfkernels/embedding_lookup_prefetch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <c10/util/Flags.h>
+#include "caffe2/core/logging.h"
+#include "caffe2/perfkernels/embedding_lookup_idx.h"
+
+C10_DEFINE_int(
+    caffe2_embedding_lookup_prefetch_distance,
+    16,
+    "How many indices ahead the embedding lookup kernels prefetch rows");
+C10_DEFINE_bool(
+    caffe2_embedding_lookup_tune_prefetch,
+    false,
+    "Choose the prefetch distance of the embedding lookup kernels with a "
+    "microbenchmark when the first embedding lookup operator is created");
+
+namespace caffe2 {
+
+namespace {
+
+std::atomic<int>& prefetchDistance() {
+  static std::atomic<int> distance{
+      FLAGS_caffe2_embedding_lookup_prefetch_distance};
+  return distance;
+}
+
+} // namespace
+
+int GetEmbeddingLookupPrefetchDistance() {
+  return prefetchDistance().load(std::memory_order_relaxed);
+}
+
+void SetEmbeddingLookupPrefetchDistance(int distance) {
+  CAFFE_ENFORCE_GE(distance, 0, "Prefetch distance must be non-negative");
+  prefetchDistance().store(distance, std::memory_order_relaxed);
+}
+
+int TuneEmbeddingLookupPrefetchDistance() {
+  static const int tuned = []() {
+    // 32 MB of rows, so that most lookups miss the last level cache as they
+    // do with real embedding tables
+    constexpr int64_t kBlockSize = 64;
+    constexpr int64_t kNumRows = 1 << 17;
+    constexpr int64_t kNumBags = 1024;
+    constexpr int64_t kBagSize = 64;
+    constexpr int kNumRuns = 3;
+
+    std::vector<float> table(kNumRows * kBlockSize, 1.0f);
+    std::vector<int64_t> indices(kNumBags * kBagSize);
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<int64_t> row(0, kNumRows - 1);
+    for (auto& index : indices) {
+      index = row(generator);
+    }
+    std::vector<int64_t> offsets(kNumBags + 1);
+    for (int64_t i = 0; i <= kNumBags; ++i) {
+      offsets[i] = i * kBagSize;
+    }
+    std::vector<float> out(kNumBags * kBlockSize);
+
+    int best_distance = GetEmbeddingLookupPrefetchDistance();
+    double best_time = std::numeric_limits<double>::infinity();
+    for (int distance : {2, 4, 8, 16, 32, 64}) {
+      SetEmbeddingLookupPrefetchDistance(distance);
+      double time = std::numeric_limits<double>::infinity();
+      for (int run = 0; run < kNumRuns; ++run) {
+        const auto start = std::chrono::steady_clock::now();
+        EmbeddingLookupIdx<int64_t, float, float>(
+            kBlockSize,
+            kNumBags,
+            indices.size(),
+            kNumRows,
+            table.data(),
+            indices.data(),
+            offsets.data(),
+            /*weights=*/nullptr,
+            /*scale_bias=*/nullptr,
+            /*normalize_by_lengths=*/false,
+            out.data());
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        time = std::min(time, elapsed.count());
+      }
+      if (time < best_time) {
+        best_time = time;
+        best_distance = distance;
+      }
+    }
+    SetEmbeddingLookupPrefetchDistance(best_distance);
+    VLOG(1) << "Embedding lookup prefetch distance tuned to " << best_distance;
+    return best_distance;
+  }();
+  return tuned;
+}
+
+void MaybeTuneEmbeddingLookupPrefetchDistance() {
+  if (FLAGS_caffe2_embedding_lookup_tune_prefetch) {
+    TuneEmbeddingLookupPrefetchDistance();
+  }
+}
+
+} // namespace caffe2
@@ -0,0 +1,23 @@
+#pragma once
+
+// Included by the generated embedding lookup kernels, which are compiled with
+// platform dependent compiler options: keep this free of other includes, see
+// common.h.
+
+namespace caffe2 {
+
+// How many indices ahead the embedding lookup kernels prefetch the rows they
+// are about to read. Defaults to --caffe2_embedding_lookup_prefetch_distance.
+int GetEmbeddingLookupPrefetchDistance();
+void SetEmbeddingLookupPrefetchDistance(int distance);
+
+// Times the fp32 embedding lookup with a few prefetch distances, on a table
+// larger than the last level cache, and sets the fastest one. It only runs
+// once per process, and returns the distance it chose.
+int TuneEmbeddingLookupPrefetchDistance();
+
+// Called by the embedding lookup operators when they are created: tunes the
+// prefetch distance if --caffe2_embedding_lookup_tune_prefetch is set.
+void MaybeTuneEmbeddingLookupPrefetchDistance();
+
+} // namespace caffe2
@@ -6,31 +6,61 @@ import sys
 
 sizeof = {"float": 4, "at::Half": 2, "uint8_t": 1}
 
+# Per instruction set: the number of floats in a register, the prefix of the
+# intrinsics on such registers, and the loads of that many at::Half and
+# uint8_t values.
+isa_info = {
+    "avx2": {
+        "vlen": 8,
+        "vtype": "__m256",
+        "mm": "_mm256",
+        "half_load": "_mm_loadu_si128",
+        "half_itype": "__m128i",
+        "uint8_load": "_mm_loadl_epi64",
+        "suffix": "__avx2_fma",
+    },
+    "avx512": {
+        "vlen": 16,
+        "vtype": "__m512",
+        "mm": "_mm512",
+        "half_load": "_mm256_loadu_si256",
+        "half_itype": "__m256i",
+        "uint8_load": "_mm_loadu_si128",
+        "suffix": "__avx512",
+    },
+}
+
 
 def unroll(uf, IndexType, InType, OutType, use_weights, isa, fused, use_offsets):
+    info = isa_info[isa]
+    vlen = info["vlen"]
+    mm = info["mm"]
+
     def compute(regid, InType, use_weights, isa, prefetch):
         code = []
 
         if InType == "float":
             code.append(
-                "        vop%d = _mm256_fmadd_ps(vwgt, _mm256_loadu_ps(ip + (%d)), vop%d);"  # noqa
-                % (regid, regid, regid)
+                "        vop%d = %s_fmadd_ps(vwgt, %s_loadu_ps(ip + (%d)), vop%d);"  # noqa
+                % (regid, mm, mm, regid, regid)
             )
         elif InType == "at::Half":
             code.append(
-                "        vop%d = _mm256_fmadd_ps(\n"
+                "        vop%d = %s_fmadd_ps(\n"
                 "            vwgt,\n"
-                "            _mm256_cvtph_ps(\n"
-                "                _mm_loadu_si128(reinterpret_cast<const __m128i*>(ip + (%d)))),\n"  # noqa
-                "            vop%d);" % (regid, regid, regid)
+                "            %s_cvtph_ps(\n"
+                "                %s(reinterpret_cast<const %s*>(ip + (%d)))),\n"  # noqa
+                "            vop%d);"
+                % (regid, mm, mm, info["half_load"], info["half_itype"], regid, regid)
             )
         elif InType == "uint8_t":
             code.append(
-                "        vop%d = _mm256_fmadd_ps(\n"
+                "        vop%d = %s_fmadd_ps(\n"
                 "            vwgt,\n"
-                "            _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(\n"
-                "                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(ip + (%d))))),\n"  # noqa
-                "            _mm256_add_ps(vop%d, vbio));" % (regid, regid, regid)
+                "            %s_cvtepi32_ps(%s_cvtepu8_epi32(\n"
+                "                %s(reinterpret_cast<const __m128i*>(ip + (%d))))),\n"  # noqa
+                "            %s_add_ps(vop%d, vbio));"
+                % (regid, mm, mm, mm, info["uint8_load"], regid, mm, regid)
             )
         else:
             assert False
@@ -66,8 +96,10 @@ def unroll(uf, IndexType, InType, OutType, use_weights, isa, fused, use_offsets)
 
     code.append("      " + OutType + "* op = &out[rangeIndex * block_size];")
     for i in range(0, uf):
-        j = 8 * i
-        code.append("      __m256 vop" + str(j) + " = _mm256_setzero_ps();")
+        j = vlen * i
+        code.append(
+            "      " + info["vtype"] + " vop" + str(j) + " = " + mm + "_setzero_ps();"
+        )
 
     # inner loop
     if use_offsets:
@@ -120,7 +152,7 @@ def unroll(uf, IndexType, InType, OutType, use_weights, isa, fused, use_offsets)
         else:
             code.append("        bio = wgt * scale_bias[2 * idx + 1];")
             code.append("        wgt = wgt * scale_bias[2 * idx];")
-        code.append("        __m256 vbio = _mm256_set1_ps(bio);")
+        code.append("        " + info["vtype"] + " vbio = " + mm + "_set1_ps(bio);")
     else:
         code.append("        " + OutType + " wgt = 1.f;")
         code.append("        if (weights) {")
@@ -128,7 +160,7 @@ def unroll(uf, IndexType, InType, OutType, use_weights, isa, fused, use_offsets)
             "          wgt = weights[IS_WEIGHT_POSITIONAL ? (dataInd - start) : dataInd];"  # noqa
         )
         code.append("        }")
-    code.append("        __m256 vwgt = _mm256_set1_ps(wgt);")
+    code.append("        " + info["vtype"] + " vwgt = " + mm + "_set1_ps(wgt);")
 
     code.append("        const {}* ip = &input[idx * fused_block_size];".format(InType))
     code.append(
@@ -150,7 +182,7 @@ def unroll(uf, IndexType, InType, OutType, use_weights, isa, fused, use_offsets)
     )
 
     for i in range(0, uf):
-        j = 8 * i
+        j = vlen * i
         cachelinesize = 64
         byteoffset = sizeof[InType] * j
         prefetch = (byteoffset % cachelinesize) == 0
@@ -162,20 +194,27 @@ def unroll(uf, IndexType, InType, OutType, use_weights, isa, fused, use_offsets)
     else:
         code.append("      if (!normalize_by_lengths || lengths[rangeIndex] == 0) {")
     for i in range(0, uf):
-        j = 8 * i
-        code.append("        _mm256_storeu_ps(&op[" + str(j) + "], vop" + str(j) + ");")
+        j = vlen * i
+        code.append(
+            "        " + mm + "_storeu_ps(&op[" + str(j) + "], vop" + str(j) + ");"
+        )
     code.append("      } else {")
     # inv of length
     if use_offsets:
-        code.append("        __m256 vlen_inv = _mm256_set1_ps(1.0f / length);")
+        code.append(
+            "        " + info["vtype"] + " vlen_inv = " + mm + "_set1_ps(1.0f / length);"
+        )
     else:
-        code.append("        __m256 vlen_inv = _mm256_set1_ps(1.0f / lengths[rangeIndex]);")
+        code.append(
+            "        " + info["vtype"] + " vlen_inv = "
+            + mm + "_set1_ps(1.0f / lengths[rangeIndex]);"
+        )
     for i in range(0, uf):
-        j = 8 * i
+        j = vlen * i
         code.append(
-            "        _mm256_storeu_ps(&op["
+            "        " + mm + "_storeu_ps(&op["
             + str(j)
-            + "], _mm256_mul_ps("
+            + "], " + mm + "_mul_ps("
             + "vop"
             + str(j)
             + ", vlen_inv));"
@@ -187,34 +226,41 @@ def unroll(uf, IndexType, InType, OutType, use_weights, isa, fused, use_offsets)
 
 
 def generic(IndexType, InType, OutType, use_weights, isa, fused, use_offsets):
+    info = isa_info[isa]
+    vlen = info["vlen"]
+    mm = info["mm"]
+
     def compute(InType, use_weights, isa):
         code = []
         if InType == "float":
             code.append(
-                "          _mm256_storeu_ps(\n"
+                "          %s_storeu_ps(\n"
                 "              &op[j],\n"
-                "              _mm256_fmadd_ps(\n"
-                "                  vwgt, _mm256_loadu_ps(&ip[j]), _mm256_loadu_ps(&op[j])));"  # noqa
+                "              %s_fmadd_ps(\n"
+                "                  vwgt, %s_loadu_ps(&ip[j]), %s_loadu_ps(&op[j])));"  # noqa
+                % (mm, mm, mm, mm)
             )
         elif InType == "at::Half":
             code.append(
-                "          _mm256_storeu_ps(\n"
+                "          %s_storeu_ps(\n"
                 "              &op[j],\n"
-                "              _mm256_fmadd_ps(\n"
+                "              %s_fmadd_ps(\n"
                 "                  vwgt,\n"
-                "                  _mm256_cvtph_ps(_mm_loadu_si128(\n"
-                "                      reinterpret_cast<const __m128i*>(&ip[j]))),\n"
-                "                  _mm256_loadu_ps(&op[j])));"
+                "                  %s_cvtph_ps(%s(\n"
+                "                      reinterpret_cast<const %s*>(&ip[j]))),\n"
+                "                  %s_loadu_ps(&op[j])));"
+                % (mm, mm, mm, info["half_load"], info["half_itype"], mm)
             )
         elif InType == "uint8_t":
             code.append(
-                "          _mm256_storeu_ps(\n"
+                "          %s_storeu_ps(\n"
                 "              &op[j],\n"
-                "              _mm256_fmadd_ps(\n"
+                "              %s_fmadd_ps(\n"
                 "                  vwgt,\n"
-                "                  _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(\n"  # noqa
+                "                  %s_cvtepi32_ps(%s_cvtepu8_epi32(%s(\n"  # noqa
                 "                      reinterpret_cast<const __m128i*>(&ip[j])))),\n"
-                "                  _mm256_add_ps(_mm256_loadu_ps(&op[j]), vbio)));"
+                "                  %s_add_ps(%s_loadu_ps(&op[j]), vbio)));"
+                % (mm, mm, mm, mm, info["uint8_load"], mm, mm)
             )
         else:
             assert False
@@ -249,8 +295,10 @@ def generic(IndexType, InType, OutType, use_weights, isa, fused, use_offsets):
 
     # initialize to 0
     code.append("      int64_t j = 0;")
-    code.append("      for (; j + 8 <= block_size; j += 8) {")
-    code.append("        _mm256_storeu_ps(op + j, _mm256_setzero_ps());")
+    code.append(
+        "      for (; j + {} <= block_size; j += {}) {{".format(vlen, vlen)
+    )
+    code.append("        " + mm + "_storeu_ps(op + j, " + mm + "_setzero_ps());")
     code.append("      }")
     code.append("      for (; j < block_size; j++) {")
     code.append("        op[j] = 0.0f;")
@@ -307,7 +355,7 @@ def generic(IndexType, InType, OutType, use_weights, isa, fused, use_offsets):
         else:
             code.append("        bio = wgt * scale_bias[2 * idx + 1];")
             code.append("        wgt = wgt * scale_bias[2 * idx];")
-        code.append("        __m256 vbio = _mm256_set1_ps(bio);")
+        code.append("        " + info["vtype"] + " vbio = " + mm + "_set1_ps(bio);")
     else:
         code.append("        " + OutType + " wgt = 1.f;")
         code.append("        if (weights) {")
@@ -315,7 +363,7 @@ def generic(IndexType, InType, OutType, use_weights, isa, fused, use_offsets):
             "          wgt = weights[IS_WEIGHT_POSITIONAL ? (dataInd - start) : dataInd];"  # noqa
         )
         code.append("        }")
-    code.append("        __m256 vwgt = _mm256_set1_ps(wgt);")
+    code.append("        " + info["vtype"] + " vwgt = " + mm + "_set1_ps(wgt);")
 
     code.append("        const {}* ip = &input[idx * fused_block_size];".format(InType))
     code.append(
@@ -337,7 +385,9 @@ def generic(IndexType, InType, OutType, use_weights, isa, fused, use_offsets):
 
     # compute and store main loop
     code.append("        j = 0;")
-    code.append("        for (; j + 8 <= block_size; j += 8) {")
+    code.append(
+        "        for (; j + {} <= block_size; j += {}) {{".format(vlen, vlen)
+    )
     code.extend(compute(InType, use_weights, isa))
     code.append("        }")
     # leftover
@@ -366,12 +416,17 @@ def generic(IndexType, InType, OutType, use_weights, isa, fused, use_offsets):
     else:
         code.append("      if (normalize_by_lengths && lengths[rangeIndex]) {")
         code.append("        float len_inv = 1.0f / lengths[rangeIndex];")
-    code.append("        __m256 vlen_inv = _mm256_set1_ps(len_inv);")
+    code.append(
+        "        " + info["vtype"] + " vlen_inv = " + mm + "_set1_ps(len_inv);"
+    )
     code.append("        j = 0;")
-    code.append("        for (; j + 8 <= block_size; j += 8) {")
     code.append(
-        "          _mm256_storeu_ps(\n"
-        "              &op[j], _mm256_mul_ps(_mm256_loadu_ps(&op[j]), vlen_inv));"
+        "        for (; j + {} <= block_size; j += {}) {{".format(vlen, vlen)
+    )
+    code.append(
+        "          %s_storeu_ps(\n"
+        "              &op[j], %s_mul_ps(%s_loadu_ps(&op[j]), vlen_inv));"
+        % (mm, mm, mm)
     )
     code.append("        }")
     code.append("        for (; j < block_size; j++) {")
@@ -389,19 +444,20 @@ parser = argparse.ArgumentParser()
 parser.add_argument("-f", "--filename", help="file name")
 parser.add_argument("--fused", action="store_true")
 parser.add_argument("--use-offsets", action="store_true")
+parser.add_argument("--isa", choices=sorted(isa_info.keys()), default="avx2")
 opts = parser.parse_args()
 if opts.filename:
     filename = opts.filename
 elif opts.fused:
     if opts.use_offsets:
-        filename = "embedding_lookup_fused_8bit_rowwise_idx_avx2.cc"
+        filename = "embedding_lookup_fused_8bit_rowwise_idx_{}.cc".format(opts.isa)
     else:
-        filename = "embedding_lookup_fused_8bit_rowwise_avx2.cc"
+        filename = "embedding_lookup_fused_8bit_rowwise_{}.cc".format(opts.isa)
 else:
     if opts.use_offsets:
-        filename = "embedding_lookup_idx_avx2.cc"
+        filename = "embedding_lookup_idx_{}.cc".format(opts.isa)
     else:
-        filename = "embedding_lookup_avx2.cc"
+        filename = "embedding_lookup_{}.cc".format(opts.isa)
 
 options = [
     ["int32_t", "int", "float", "float", "float", "float"],
@@ -423,6 +479,7 @@ code.append("//// --------------------------\n")
 
 code.append("#include <c10/util/Half.h>")
 code.append("#include <immintrin.h>")
+code.append('#include "caffe2/perfkernels/embedding_lookup_prefetch.h"')
 
 code.append("namespace caffe2 {\n")
 for o in options:
@@ -438,7 +495,7 @@ for o in options:
         fn_base = "{}EmbeddingLookup_{}_{}_{}".format(
             prefix, IndexTypeName, InTypeName, OutTypeName
         )
-    suffix = "__avx2_fma"
+    suffix = isa_info[opts.isa]["suffix"]
     fn = "static bool " + fn_base + suffix
     code.append(fn + "(")
 
@@ -460,7 +517,9 @@ for o in options:
     args.append("    " + OutType + "* out) {")
     code += args
 
-    code.append("  const " + IndexType + " prefdist_T0 = 16;")
+    code.append(
+        "  const " + IndexType + " prefdist_T0 = GetEmbeddingLookupPrefetchDistance();"
+    )
     # block_size is the number of elements and fused_block_size is the size of
     # an entire row, including scale and bias.
     offset = (8 // sizeof[InType]) if opts.fused else 0
@@ -474,17 +533,19 @@ for o in options:
 
     # code.append("printf(\"calling " + fn + "\\n\");");
 
-    code.append("  if (block_size == 128) {")
-    code += unroll(16, IndexType, InType, OutType, True, "AVX2", opts.fused, opts.use_offsets)
-    code.append("  } else if (block_size == 64) {")
-    code += unroll(8, IndexType, InType, OutType, True, "AVX2", opts.fused, opts.use_offsets)
-    code.append("  } else if (block_size == 32) {")
-    code += unroll(4, IndexType, InType, OutType, True, "AVX2", opts.fused, opts.use_offsets)
-    code.append("  } else if (block_size == 16) {")
-    code += unroll(2, IndexType, InType, OutType, True, "AVX2", opts.fused, opts.use_offsets)
+    # Fully unroll the common block sizes, one register per vlen floats
+    vlen = isa_info[opts.isa]["vlen"]
+    for i, block_size in enumerate([128, 64, 32, 16]):
+        code.append(
+            "  {}if (block_size == {}) {{".format("} else " if i else "", block_size)
+        )
+        code += unroll(
+            block_size // vlen, IndexType, InType, OutType, True, opts.isa,
+            opts.fused, opts.use_offsets
+        )
     code.append("  } else {")
     code.append("    // generic code")
-    code += generic(IndexType, InType, OutType, True, "AVX2", opts.fused, opts.use_offsets)
+    code += generic(IndexType, InType, OutType, True, opts.isa, opts.fused, opts.use_offsets)
     code.append("  }")
     code.append("  return dataInd == index_size;")
 
@@ -0,0 +1,230 @@
+#include "caffe2/predictor/pooled_predictor.h"
+
+#include <algorithm>
+#include <set>
+
+#include "caffe2/core/memonger.h"
+
+namespace caffe2 {
+
+namespace {
+
+using NamedInputs =
+    std::vector<std::pair<const std::string*, const TensorCPU*>>;
+
+NamedInputs namedInputs(
+    const Predictor::TensorMap& inputs,
+    const std::vector<std::string>& input_names) {
+  if (!input_names.empty()) {
+    CAFFE_ENFORCE_EQ(inputs.size(), input_names.size());
+  }
+  NamedInputs named_inputs;
+  named_inputs.reserve(inputs.size());
+  for (const auto& input : inputs) {
+    if (!input_names.empty()) {
+      CAFFE_ENFORCE(
+          std::find(input_names.begin(), input_names.end(), input.first) !=
+              input_names.end(),
+          "Input can't be found: ",
+          input.first);
+    }
+    named_inputs.emplace_back(&input.first, &input.second);
+  }
+  return named_inputs;
+}
+
+std::pair<const void*, size_t> blobMemory(const Blob* blob) {
+  if (!BlobIsTensorType(*blob, CPU)) {
+    return {nullptr, 0};
+  }
+  const auto& storage = blob->Get<Tensor>().storage();
+  return {storage.data(), storage.nbytes()};
+}
+
+void copyOutput(Workspace* ws, const std::string& name, TensorCPU* output) {
+  auto* blob = ws->GetBlob(name);
+  CAFFE_ENFORCE(blob, "Blob: ", name, " does not exist");
+  CAFFE_ENFORCE(
+      BlobIsTensorType(*blob, CPU), "Blob is not a CPU Tensor: ", name);
+  if (!output->defined()) {
+    *output = TensorCPU(CPU);
+  }
+  output->CopyFrom(blob->Get<Tensor>());
+}
+
+} // namespace
+
+PooledPredictor::PooledPredictor(
+    PredictorConfig config,
+    int num_workspaces,
+    bool share_blobs)
+    : config_(std::move(config)) {
+  const auto& parameters = config_.ws->Blobs();
+  parameters_.insert(parameters.begin(), parameters.end());
+
+  if (share_blobs) {
+    std::set<std::string> static_blobs(parameters.begin(), parameters.end());
+    const auto& net = *config_.predict_net;
+    static_blobs.insert(
+        net.external_input().begin(), net.external_input().end());
+    static_blobs.insert(
+        net.external_output().begin(), net.external_output().end());
+    static_blobs.insert(
+        config_.input_names.begin(), config_.input_names.end());
+    static_blobs.insert(
+        config_.output_names.begin(), config_.output_names.end());
+    config_.predict_net = std::make_shared<NetDef>(
+        memonger::optimize_inference_net(net, static_blobs));
+  }
+
+  for (int i = 0; i < num_workspaces; ++i) {
+    releaseWorkspace(createWorkspace());
+    ++num_workspaces_;
+  }
+}
+
+std::unique_ptr<PooledPredictor::PooledWorkspace>
+PooledPredictor::createWorkspace() const {
+  auto pooled = std::make_unique<PooledWorkspace>();
+  pooled->ws = std::make_unique<Workspace>(config_.ws.get());
+  auto* ws = pooled->ws.get();
+  // Inputs are local to each workspace, parameters are shared
+  for (const auto& name : config_.predict_net->external_input()) {
+    if (!parameters_.count(name)) {
+      BlobGetMutableTensor(ws->CreateLocalBlob(name), CPU);
+    }
+  }
+  CAFFE_ENFORCE(ws->CreateNet(config_.predict_net));
+  for (const auto& name : ws->LocalBlobs()) {
+    pooled->blobs.push_back(ws->GetBlob(name));
+  }
+  pooled->memory.resize(pooled->blobs.size());
+  return pooled;
+}
+
+std::unique_ptr<PooledPredictor::PooledWorkspace>
+PooledPredictor::acquireWorkspace() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!free_workspaces_.empty()) {
+      // The workspace that was released last is the most likely to still be
+      // in cache
+      auto pooled = std::move(free_workspaces_.back());
+      free_workspaces_.pop_back();
+      return pooled;
+    }
+  }
+  auto pooled = createWorkspace();
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++num_workspaces_;
+  return pooled;
+}
+
+void PooledPredictor::releaseWorkspace(
+    std::unique_ptr<PooledWorkspace> pooled) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  free_workspaces_.push_back(std::move(pooled));
+}
+
+size_t PooledPredictor::num_workspaces() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_workspaces_;
+}
+
+bool PooledPredictor::run(
+    PooledWorkspace* pooled,
+    const NamedInputs& inputs,
+    RequestStats* stats) {
+  auto* ws = pooled->ws.get();
+  for (const auto& input : inputs) {
+    const auto& name = *input.first;
+    CAFFE_ENFORCE(
+        !parameters_.count(name),
+        "Input can't be a parameter of a PooledPredictor: ",
+        name);
+    auto* blob = ws->GetBlob(name);
+    CAFFE_ENFORCE(blob, "Input can't be found: ", name);
+    // This is evil and shares the same underlying tensor
+    BlobSetTensor(blob, input.second->UnsafeSharedInstance());
+  }
+
+  if (stats) {
+    for (size_t i = 0; i < pooled->blobs.size(); ++i) {
+      pooled->memory[i] = blobMemory(pooled->blobs[i]);
+    }
+  }
+  bool success = ws->RunNet(config_.predict_net->name());
+  if (stats) {
+    *stats = RequestStats();
+    for (size_t i = 0; i < pooled->blobs.size(); ++i) {
+      auto memory = blobMemory(pooled->blobs[i]);
+      if (memory.first && memory != pooled->memory[i]) {
+        ++stats->allocations;
+        stats->allocated_bytes += memory.second;
+      }
+    }
+  }
+  return success;
+}
+
+bool PooledPredictor::operator()(
+    const TensorList& inputs,
+    TensorList* outputs,
+    RequestStats* stats) {
+  const auto& net = *config_.predict_net;
+  CAFFE_ENFORCE(
+      inputs.size() <= static_cast<unsigned>(net.external_input_size()));
+  NamedInputs named_inputs;
+  named_inputs.reserve(inputs.size());
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    named_inputs.emplace_back(&net.external_input(i), &inputs[i]);
+  }
+
+  auto pooled = acquireWorkspace();
+  if (!run(pooled.get(), named_inputs, stats)) {
+    releaseWorkspace(std::move(pooled));
+    return false;
+  }
+  outputs->resize(net.external_output_size());
+  for (size_t i = 0; i < outputs->size(); ++i) {
+    copyOutput(pooled->ws.get(), net.external_output(i), &(*outputs)[i]);
+  }
+  releaseWorkspace(std::move(pooled));
+  return true;
+}
+
+bool PooledPredictor::operator()(
+    const TensorMap& inputs,
+    TensorMap* outputs,
+    RequestStats* stats) {
+  const auto named_inputs = namedInputs(inputs, input_names());
+  auto pooled = acquireWorkspace();
+  if (!run(pooled.get(), named_inputs, stats)) {
+    releaseWorkspace(std::move(pooled));
+    return false;
+  }
+  for (const auto& name : output_names()) {
+    copyOutput(pooled->ws.get(), name, &(*outputs)[name]);
+  }
+  releaseWorkspace(std::move(pooled));
+  return true;
+}
+
+bool PooledPredictor::warmup(const TensorMap& inputs) {
+  const auto named_inputs = namedInputs(inputs, input_names());
+  std::vector<std::unique_ptr<PooledWorkspace>> workspaces;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    workspaces.swap(free_workspaces_);
+  }
+  bool success = true;
+  for (auto& pooled : workspaces) {
+    success = run(pooled.get(), named_inputs, nullptr) && success;
+  }
+  for (auto& pooled : workspaces) {
+    releaseWorkspace(std::move(pooled));
+  }
+  return success;
+}
+
+} // namespace caffe2
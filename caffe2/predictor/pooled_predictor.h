@@ -0,0 +1,105 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include "caffe2/predictor/predictor.h"
+
+namespace caffe2 {
+
+/**
+ * A predictor that serves requests from any number of threads without
+ * allocating blob memory in steady state.
+ *
+ * Each request runs in a workspace taken from a pool. All of them are children
+ * of the workspace that holds the parameters. Blobs keep the memory of the
+ * largest request their workspace has served (see caffe2_keep_on_shrink). At
+ * load time, memonger makes the intermediate blobs of the net share memory.
+ * Once the pooled workspaces have seen the largest inputs, e.g. through
+ * warmup(), requests run without allocating blob memory.
+ */
+class TORCH_API PooledPredictor {
+ public:
+  using TensorList = Predictor::TensorList;
+  using TensorMap = Predictor::TensorMap;
+
+  // Blob memory allocated while serving a request
+  struct RequestStats {
+    // Number of blobs whose memory was allocated or reallocated
+    int64_t allocations = 0;
+    // Bytes held by these blobs after the request
+    int64_t allocated_bytes = 0;
+  };
+
+  // Creates `num_workspaces` workspaces upfront. More are created when a
+  // request comes in while all of them are in use. If `share_blobs` is set,
+  // the predict net is rewritten by memonger::optimize_inference_net.
+  explicit PooledPredictor(
+      PredictorConfig config,
+      int num_workspaces = 1,
+      bool share_blobs = true);
+
+  // Executes `predict_net` on the inputs, as Predictor does. The workspace
+  // goes back to the pool once the request is done, so the outputs are
+  // copied into `outputs`. Copies reuse the memory of the tensors that
+  // `outputs` already holds.
+  bool operator()(
+      const TensorList& inputs,
+      TensorList* outputs,
+      RequestStats* stats = nullptr);
+
+  bool operator()(
+      const TensorMap& inputs,
+      TensorMap* outputs,
+      RequestStats* stats = nullptr);
+
+  // Runs `inputs` once in each pooled workspace. Use the largest inputs
+  // expected when serving, so that the blobs reach their final sizes before
+  // the first request comes in.
+  bool warmup(const TensorMap& inputs);
+
+  const NetDef& def() const {
+    return *config_.predict_net;
+  }
+
+  const std::vector<std::string>& input_names() const {
+    return config_.input_names;
+  }
+
+  const std::vector<std::string>& output_names() const {
+    return config_.output_names;
+  }
+
+  // Number of workspaces created so far
+  size_t num_workspaces() const;
+
+ private:
+  struct PooledWorkspace {
+    std::unique_ptr<Workspace> ws;
+    // Blobs local to ws and the memory they held before the current request,
+    // to compute its RequestStats
+    std::vector<Blob*> blobs;
+    std::vector<std::pair<const void*, size_t>> memory;
+  };
+
+  std::unique_ptr<PooledWorkspace> createWorkspace() const;
+  std::unique_ptr<PooledWorkspace> acquireWorkspace();
+  void releaseWorkspace(std::unique_ptr<PooledWorkspace> pooled);
+
+  // Sets the inputs, which are (name, tensor) pairs, and runs the net
+  bool run(
+      PooledWorkspace* pooled,
+      const std::vector<std::pair<const std::string*, const TensorCPU*>>&
+          inputs,
+      RequestStats* stats);
+
+  PredictorConfig config_;
+  // Blobs of the parameter workspace, which child workspaces share
+  std::unordered_set<std::string> parameters_;
+
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<PooledWorkspace>> free_workspaces_;
+  size_t num_workspaces_ = 0;
+};
+
+} // namespace caffe2
@@ -0,0 +1,164 @@
+#include "caffe2/core/context.h"
+#include "caffe2/core/operator.h"
+#include "caffe2/core/tensor.h"
+#include "caffe2/predictor/pooled_predictor.h"
+#include "caffe2/utils/math.h"
+
+#include <gtest/gtest.h>
+
+namespace caffe2 {
+
+namespace {
+
+const char* predictSpec = R"DOC(
+        name: "predict"
+        type: "simple"
+        external_input: "data"
+        external_input: "W"
+        external_input: "b"
+        external_output: "y"
+        op {
+          input: "data"
+          input: "W"
+          input: "b"
+          output: "hidden"
+          type: "FC"
+        }
+        op {
+          input: "hidden"
+          output: "y"
+          type: "Relu"
+        }
+)DOC";
+
+const char* initSpec = R"DOC(
+        name: "init"
+        type: "simple"
+        op {
+          type: "ConstantFill"
+          output: "W"
+          arg {
+            name: "shape"
+            ints: 4
+            ints: 4
+          }
+          arg {
+            name: "value"
+            f: 0.5
+          }
+        }
+        op {
+          type: "ConstantFill"
+          output: "b"
+          arg {
+            name: "shape"
+            ints: 4
+          }
+          arg {
+            name: "value"
+            f: -1.0
+          }
+        }
+)DOC";
+
+NetDef parseNetDef(const std::string& value) {
+  NetDef def;
+  CAFFE_ENFORCE(
+      TextFormat::ParseFromString(value, &def),
+      "Failed to parse NetDef with value: ",
+      value);
+  return def;
+}
+
+TensorCPU randomTensor(const std::vector<int64_t>& dims, CPUContext* ctx) {
+  TensorCPU t(dims, CPU);
+  math::RandUniform<float, CPUContext>(
+      t.numel(), -1.0, 1.0, t.template mutable_data<float>(), ctx);
+  return t;
+}
+
+} // namespace
+
+class PooledPredictorTest : public testing::Test {
+ public:
+  void SetUp() override {
+    DeviceOption op;
+    op.set_random_seed(1701);
+    ctx_ = std::make_unique<CPUContext>(op);
+  }
+
+  PredictorConfig makeConfig() {
+    return makePredictorConfig(
+        parseNetDef(initSpec), parseNetDef(predictSpec));
+  }
+
+  std::unique_ptr<CPUContext> ctx_;
+};
+
+TEST_F(PooledPredictorTest, MatchesPredictor) {
+  Predictor p(makeConfig());
+  PooledPredictor pooled(makeConfig(), /* num_workspaces */ 2);
+  EXPECT_EQ(pooled.num_workspaces(), 2);
+
+  Predictor::TensorList input;
+  input.emplace_back(randomTensor({3, 4}, ctx_.get()));
+  Predictor::TensorList expected, output;
+  ASSERT_TRUE(p(input, &expected));
+  ASSERT_TRUE(pooled(input, &output));
+  ASSERT_EQ(output.size(), 1);
+  ASSERT_EQ(output[0].sizes(), expected[0].sizes());
+  for (int64_t i = 0; i < output[0].numel(); ++i) {
+    EXPECT_FLOAT_EQ(output[0].data<float>()[i], expected[0].data<float>()[i]);
+  }
+}
+
+TEST_F(PooledPredictorTest, NoAllocationsInSteadyState) {
+  PooledPredictor pooled(makeConfig());
+  Predictor::TensorList output;
+  PooledPredictor::RequestStats stats;
+
+  Predictor::TensorList large_input;
+  large_input.emplace_back(randomTensor({8, 4}, ctx_.get()));
+  ASSERT_TRUE(pooled(large_input, &output, &stats));
+  EXPECT_GT(stats.allocations, 0);
+  EXPECT_GT(stats.allocated_bytes, 0);
+  const void* output_data = output[0].raw_data();
+
+  // Smaller batches reuse the memory of the largest one, and so does the
+  // output the caller passes back in
+  for (int64_t batch_size : {8, 2, 5}) {
+    Predictor::TensorList input;
+    input.emplace_back(randomTensor({batch_size, 4}, ctx_.get()));
+    ASSERT_TRUE(pooled(input, &output, &stats));
+    EXPECT_EQ(stats.allocations, 0);
+    EXPECT_EQ(stats.allocated_bytes, 0);
+    EXPECT_EQ(output[0].size(0), batch_size);
+    EXPECT_EQ(output[0].raw_data(), output_data);
+  }
+  EXPECT_EQ(pooled.num_workspaces(), 1);
+}
+
+TEST_F(PooledPredictorTest, Warmup) {
+  PooledPredictor pooled(makeConfig(), /* num_workspaces */ 3);
+  Predictor::TensorMap warmup_input;
+  warmup_input.emplace("data", randomTensor({16, 4}, ctx_.get()));
+  ASSERT_TRUE(pooled.warmup(warmup_input));
+
+  Predictor::TensorMap input;
+  input.emplace("data", randomTensor({4, 4}, ctx_.get()));
+  Predictor::TensorMap output;
+  PooledPredictor::RequestStats stats;
+  ASSERT_TRUE(pooled(input, &output, &stats));
+  EXPECT_EQ(stats.allocations, 0);
+  EXPECT_EQ(pooled.num_workspaces(), 3);
+}
+
+TEST_F(PooledPredictorTest, RejectsParameterInputs) {
+  PooledPredictor pooled(makeConfig());
+  Predictor::TensorMap input;
+  input.emplace("W", randomTensor({4, 4}, ctx_.get()));
+  Predictor::TensorMap output;
+  EXPECT_THROW(pooled(input, &output), EnforceNotMet);
+}
+
+} // namespace caffe2
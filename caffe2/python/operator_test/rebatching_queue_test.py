@@ -117,6 +117,33 @@ class TestReBatchingQueue(TestCase):
         with self.assertRaises(RuntimeError):
             workspace.RunNetOnce(net)
 
+    def test_rebatching_queue_partial_batch_on_close(self):
+        net = core.Net('net')
+        workspace.FeedBlob(
+            "tensors", np.array([[x, -x] for x in range(7)], np.float32)
+        )
+
+        queue = net.CreateRebatchingQueue([], 1, capacity=10, num_blobs=1)
+
+        net.EnqueueRebatchingQueue([queue, "tensors"], 0, enqueue_batch=True)
+
+        net.CloseRebatchingQueue([queue], 0)
+
+        results = [
+            net.DequeueRebatchingQueue([queue], 1, num_elements=5),
+            net.DequeueRebatchingQueue([queue], 1, num_elements=5),
+        ]
+
+        workspace.RunNetOnce(net)
+
+        npt.assert_array_equal(
+            workspace.FetchBlob(results[0]), workspace.FetchBlob("tensors")[:5]
+        )
+        # Only 2 rows were left when the queue got closed
+        npt.assert_array_equal(
+            workspace.FetchBlob(results[1]), workspace.FetchBlob("tensors")[5:]
+        )
+
     def test_rebatching_queue_multiple_components(self):
         NUM_BLOBS = 4
         NUM_ELEMENTS = 10
@@ -1,209 +1,289 @@
 #include "rebatching_queue.h"
-#include "caffe2/utils/smart_tensor_printer.h"
+#include "caffe2/core/scope_guard.h"
 
 namespace caffe2 {
 
 namespace {
 
-// This concat function will always create a new first dimension to concat
-void concat(
+// Copies numItems items of the given type from src into dst, resized to dims
+void copyInto(
     CPUContext& context,
-    const std::vector<std::vector<TensorCPU>>& inputs,
-    const std::vector<TensorCPU*>& outputs) {
-  CAFFE_ENFORCE(!inputs.empty());
-
-  const auto& inputZero = inputs[0];
-  const auto numTensors = inputZero.size();
-  const auto numRows = inputs.size();
+    const TypeMeta& meta,
+    const std::vector<int64_t>& dims,
+    size_t numItems,
+    const void* src,
+    TensorCPU* dst) {
+  dst->Resize(dims);
+  auto* destination = dst->raw_mutable_data(meta);
+  // Skip empty tensors
+  if (numItems == 0) {
+    return;
+  }
+  context.CopyItemsToCPU(meta, numItems, src, destination);
+}
 
-  // Precompute the output sizes to avoid resizing
-  std::vector<std::vector<int64_t>> outputDims(numTensors);
+} // anonymous namespace
 
-  for (size_t i = 0; i < numTensors; ++i) {
-    SmartTensorPrinter::PrintTensor(inputZero.at(i));
-    outputDims[i] = inputZero.at(i).sizes().vec();
-    outputDims[i].insert(outputDims[i].begin(), numRows);
+RebatchingQueue::RebatchingQueue(size_t capacity, size_t numBlobs)
+    : capacity_(capacity), numBlobs_(numBlobs), slots_(new Slot[capacity]) {
+  CAFFE_ENFORCE_GT(capacity, 0);
+  for (size_t i = 0; i < capacity; ++i) {
+    slots_[i].sequence.store(i, std::memory_order_relaxed);
+    slots_[i].tensors.reserve(numBlobs);
+    for (size_t j = 0; j < numBlobs; ++j) {
+      slots_[i].tensors.emplace_back(CPU);
+    }
   }
+}
 
-  // Resize to the final output size
-  std::vector<void*> destinations(numTensors);
-  for (size_t i = 0; i < numTensors; ++i) {
-    outputs[i]->Resize(outputDims[i]);
-    destinations[i] = outputs[i]->raw_mutable_data(inputZero[i].meta());
-  }
+RebatchingQueue::~RebatchingQueue() {
+  close();
+}
 
-  for (size_t i = 0; i < numRows; ++i) {
-    CAFFE_ENFORCE_EQ(inputs[i].size(), numTensors);
+bool RebatchingQueue::canRead() const {
+  auto pos = tail_.load(std::memory_order_relaxed);
+  auto seq = slots_[pos % capacity_].sequence.load(std::memory_order_acquire);
+  return static_cast<int64_t>(seq - (pos + 1)) >= 0;
+}
 
-    for (int j = 0; j < numTensors; ++j) {
-      const auto& input = inputs[i][j];
+bool RebatchingQueue::canWrite() const {
+  auto pos = head_.load(std::memory_order_relaxed);
+  auto seq = slots_[pos % capacity_].sequence.load(std::memory_order_acquire);
+  return static_cast<int64_t>(seq - pos) >= 0;
+}
 
-      CAFFE_ENFORCE(inputZero[j].meta() == input.dtype());
-      CAFFE_ENFORCE_EQ(inputZero[j].itemsize(), input.itemsize());
-      CAFFE_ENFORCE_EQ(inputZero[j].ndim(), input.dim());
-      for (int k = 0; k < input.dim(); ++k) {
-        CAFFE_ENFORCE_EQ(input.sizes()[k], inputZero[j].size(k));
+RebatchingQueue::Slot* RebatchingQueue::tryClaimWrite(uint64_t* pos) {
+  auto claimed = head_.load(std::memory_order_relaxed);
+  for (;;) {
+    auto* slot = &slots_[claimed % capacity_];
+    auto seq = slot->sequence.load(std::memory_order_acquire);
+    auto diff = static_cast<int64_t>(seq - claimed);
+    if (diff == 0) {
+      if (head_.compare_exchange_weak(
+              claimed, claimed + 1, std::memory_order_relaxed)) {
+        *pos = claimed;
+        return slot;
       }
+    } else if (diff < 0) {
+      // The slot still holds the row written a lap ago
+      return nullptr;
+    } else {
+      claimed = head_.load(std::memory_order_relaxed);
+    }
+  }
+}
 
-      // Skip empty tensors
-      if (input.numel() == 0) {
-        continue;
+RebatchingQueue::Slot* RebatchingQueue::tryClaimRead(uint64_t* pos) {
+  auto claimed = tail_.load(std::memory_order_relaxed);
+  for (;;) {
+    auto* slot = &slots_[claimed % capacity_];
+    auto seq = slot->sequence.load(std::memory_order_acquire);
+    auto diff = static_cast<int64_t>(seq - (claimed + 1));
+    if (diff == 0) {
+      if (tail_.compare_exchange_weak(
+              claimed, claimed + 1, std::memory_order_relaxed)) {
+        *pos = claimed;
+        return slot;
       }
-
-      context.CopyItemsToCPU(
-          input.dtype(),
-          input.numel(),
-          input.raw_data() /* src */,
-          destinations[j] /* dst */
-      );
-
-      destinations[j] =
-          (char*)destinations[j] + input.numel() * input.itemsize();
+    } else if (diff < 0) {
+      // The row of this slot hasn't been published yet
+      return nullptr;
+    } else {
+      claimed = tail_.load(std::memory_order_relaxed);
     }
   }
 }
 
-std::vector<std::vector<TensorCPU>> split(
-    CPUContext& context,
-    const std::vector<const TensorCPU*>& inputs) {
-  CAFFE_ENFORCE(!inputs.empty());
-
-  const auto outputSize = inputs[0]->sizes().at(0);
-  std::vector<std::vector<TensorCPU>> outputs(outputSize);
-
-  for (const auto* inputPtr : inputs) {
-    CAFFE_ENFORCE(inputPtr);
-
-    const auto& input = *inputPtr;
-    const auto innerSize = input.size_from_dim(1);
-    const auto itemSize = input.dtype().itemsize();
-
-    auto outputDims = input.sizes().vec();
-    CAFFE_ENFORCE(!outputDims.empty());
-    outputDims.erase(outputDims.begin());
-    CAFFE_ENFORCE_EQ(input.sizes().at(0), outputSize);
-
-    for (int i = 0; i < outputSize; ++i) {
-      outputs[i].push_back(Tensor(outputDims, CPU));
-      context.CopyItemsToCPU(
-          input.dtype(),
-          innerSize,
-          (char*)input.raw_data() + i * innerSize * itemSize /* src */,
-          outputs[i].back().raw_mutable_data(input.dtype()) /* dst */);
+RebatchingQueue::Slot* RebatchingQueue::claimWrite(uint64_t* pos) {
+  for (;;) {
+    if (isClosed_) {
+      return nullptr;
+    }
+    if (auto* slot = tryClaimWrite(pos)) {
+      return slot;
     }
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++numWaiting_;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    cvOverflow_.wait(lock, [this] { return canWrite() || isClosed_; });
+    --numWaiting_;
   }
+}
 
-  return outputs;
+RebatchingQueue::Slot* RebatchingQueue::claimRead(uint64_t* pos) {
+  for (;;) {
+    if (auto* slot = tryClaimRead(pos)) {
+      return slot;
+    }
+    // We only want to stop reading if the queue is empty and closed
+    if (isClosed_) {
+      return tryClaimRead(pos);
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++numWaiting_;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    cvEmpty_.wait(lock, [this] { return canRead() || isClosed_; });
+    --numWaiting_;
+  }
 }
-} // anonymous namespace
 
-RebatchingQueue::RebatchingQueue(size_t capacity, size_t numBlobs)
-    : capacity_(capacity), numBlobs_(numBlobs), queue_(capacity) {}
+void RebatchingQueue::publishWrite(Slot* slot, uint64_t pos) {
+  slot->sequence.store(pos + 1, std::memory_order_release);
+  wakeUp(cvEmpty_);
+}
 
-RebatchingQueue::~RebatchingQueue() {
-  close();
+void RebatchingQueue::publishRead(Slot* slot, uint64_t pos) {
+  slot->sequence.store(pos + capacity_, std::memory_order_release);
+  wakeUp(cvOverflow_);
 }
 
-bool RebatchingQueue::canRead() const {
-  return tail_ < head_;
+void RebatchingQueue::wakeUp(std::condition_variable& cv) {
+  // Pairs with the fence in claimRead/claimWrite: either the waiter sees the
+  // published slot, or we see the waiter
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (numWaiting_.load(std::memory_order_relaxed) > 0) {
+    // The waiter holds the mutex until it sleeps, so that it can't miss the
+    // notification
+    { std::lock_guard<std::mutex> g(mutex_); }
+    cv.notify_all();
+  }
 }
 
 bool RebatchingQueue::dequeue(
     CPUContext& context,
     size_t numElements,
     const std::vector<TensorCPU*>& outputs) {
-  std::vector<std::vector<TensorCPU>> results;
-  results.reserve(numElements);
+  CAFFE_ENFORCE_EQ(outputs.size(), numBlobs_);
 
-  for (;;) {
-    if (results.size() == numElements) {
+  std::vector<std::vector<int64_t>> rowDims(numBlobs_);
+  std::vector<int64_t> rowNumel(numBlobs_);
+  std::vector<char*> destinations(numBlobs_);
+
+  size_t numRows = 0;
+  for (; numRows < numElements; ++numRows) {
+    uint64_t pos;
+    auto* slot = claimRead(&pos);
+    if (!slot) {
       break;
     }
-
-    {
-      std::unique_lock<std::mutex> lock(mutex_);
-
-      cvEmpty_.wait(lock, [this] { return canRead() || isClosed_; });
-
-      // We only want to stop reading if the queue is empty and closed
-      if (!canRead() && isClosed_) {
-        break;
+    // Release the slot even if the row doesn't match the previous ones
+    auto guard = MakeGuard([&] { publishRead(slot, pos); });
+
+    const auto& row = slot->tensors;
+    if (numRows == 0) {
+      // The first row gives the output sizes, this will always create a new
+      // first dimension to concat
+      for (size_t i = 0; i < numBlobs_; ++i) {
+        rowDims[i] = row[i].sizes().vec();
+        rowNumel[i] = row[i].numel();
+        auto outputDims = rowDims[i];
+        outputDims.insert(outputDims.begin(), numElements);
+        outputs[i]->Resize(outputDims);
+        destinations[i] =
+            static_cast<char*>(outputs[i]->raw_mutable_data(row[i].dtype()));
       }
-
-      do {
-        results.push_back(std::move(queue_[tail_++ % capacity()]));
-      } while (canRead() && results.size() < numElements);
     }
 
-    if (numElements == 1) {
-      cvOverflow_.notify_one();
-    } else {
-      cvOverflow_.notify_all();
+    for (size_t i = 0; i < numBlobs_; ++i) {
+      const auto& input = row[i];
+      CAFFE_ENFORCE(outputs[i]->dtype() == input.dtype());
+      CAFFE_ENFORCE(input.sizes() == at::IntArrayRef(rowDims[i]));
+      // Skip empty tensors
+      if (input.numel() == 0) {
+        continue;
+      }
+      context.CopyItemsToCPU(
+          input.dtype(),
+          input.numel(),
+          input.raw_data() /* src */,
+          destinations[i] +
+              numRows * rowNumel[i] * input.itemsize() /* dst */);
     }
   }
 
-  if (results.empty()) {
+  if (numRows == 0) {
     return false;
   }
 
-  concat(context, results, outputs);
+  if (numRows < numElements) {
+    // The queue got closed before numElements rows came in
+    for (size_t i = 0; i < numBlobs_; ++i) {
+      auto outputDims = rowDims[i];
+      outputDims.insert(outputDims.begin(), numRows);
+      TensorCPU shrunk(CPU);
+      copyInto(
+          context,
+          outputs[i]->dtype(),
+          outputDims,
+          numRows * rowNumel[i],
+          outputs[i]->raw_data(),
+          &shrunk);
+      *outputs[i] = std::move(shrunk);
+    }
+  }
 
   return true;
 }
 
-bool RebatchingQueue::canWrite() const {
-  return tail_ + capacity() > head_;
-}
-
 bool RebatchingQueue::enqueueOne(
-    CPUContext& /*context*/,
+    CPUContext& context,
     const std::vector<const TensorCPU*>& inputs) {
-  std::vector<std::vector<TensorCPU>> splittedInputs;
-  splittedInputs.emplace_back();
-  auto& tensorVector = splittedInputs.back();
-  tensorVector.reserve(inputs.size());
-  for (const auto* tensorPtr : inputs) {
-    tensorVector.push_back(tensorPtr->Clone());
-  }
+  CAFFE_ENFORCE_EQ(numBlobs_, inputs.size());
 
-  return enqueue(std::move(splittedInputs));
+  uint64_t pos;
+  auto* slot = claimWrite(&pos);
+  if (!slot) {
+    return false;
+  }
+  auto guard = MakeGuard([&] { publishWrite(slot, pos); });
+  for (size_t i = 0; i < numBlobs_; ++i) {
+    const auto& input = *inputs[i];
+    copyInto(
+        context,
+        input.dtype(),
+        input.sizes().vec(),
+        input.numel(),
+        input.raw_data(),
+        &slot->tensors[i]);
+  }
+  return true;
 }
 
 bool RebatchingQueue::enqueueMany(
     CPUContext& context,
     const std::vector<const TensorCPU*>& inputs) {
   CAFFE_ENFORCE_EQ(numBlobs_, inputs.size());
+  CAFFE_ENFORCE(!inputs.empty());
 
-  std::vector<std::vector<TensorCPU>> splittedInputs;
-  splittedInputs = split(context, inputs);
-  return enqueue(std::move(splittedInputs));
-}
+  const auto numRows = inputs[0]->sizes().at(0);
+  std::vector<std::vector<int64_t>> rowDims(numBlobs_);
+  for (size_t i = 0; i < numBlobs_; ++i) {
+    const auto& input = *inputs[i];
+    CAFFE_ENFORCE_EQ(input.sizes().at(0), numRows);
+    rowDims[i] = input.sizes().slice(1).vec();
+  }
 
-bool RebatchingQueue::enqueue(
-    std::vector<std::vector<TensorCPU>> splittedInputs) {
-  int idx = 0;
-  for (;;) {
-    if (idx >= splittedInputs.size()) {
-      break;
+  for (int64_t row = 0; row < numRows; ++row) {
+    uint64_t pos;
+    auto* slot = claimWrite(&pos);
+    if (!slot) {
+      // If we are here it means that we didn't apply the entire batch and if
+      // we get closed in the middle of enquing we treat it as a non-success.
+      return false;
     }
-
-    {
-      std::unique_lock<std::mutex> lock(mutex_);
-
-      cvOverflow_.wait(lock, [this] { return canWrite() || isClosed_; });
-
-      if (isClosed_) {
-        // If we are here it means that we didn't apply the entire batch and if
-        // we get closed in the middle of enquing we treat it as a non-success.
-        return false;
-      }
-
-      do {
-        queue_[head_++ % capacity()] = std::move(splittedInputs[idx++]);
-      } while (canWrite() && idx < splittedInputs.size());
+    auto guard = MakeGuard([&] { publishWrite(slot, pos); });
+    for (size_t i = 0; i < numBlobs_; ++i) {
+      const auto& input = *inputs[i];
+      const auto innerSize = input.size_from_dim(1);
+      copyInto(
+          context,
+          input.dtype(),
+          rowDims[i],
+          innerSize,
+          static_cast<const char*>(input.raw_data()) +
+              row * innerSize * input.itemsize(),
+          &slot->tensors[i]);
     }
-
-    cvEmpty_.notify_all();
   }
 
   return true;
@@ -218,14 +298,13 @@ size_t RebatchingQueue::numBlobs() const {
 }
 
 bool RebatchingQueue::isClosed() const {
-  std::lock_guard<std::mutex> g(mutex_);
   return isClosed_;
 }
 
 void RebatchingQueue::close() {
+  isClosed_ = true;
   {
     std::lock_guard<std::mutex> g(mutex_);
-    isClosed_ = true;
   }
 
   cvEmpty_.notify_all();
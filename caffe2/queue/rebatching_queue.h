@@ -13,9 +13,11 @@
 
 namespace caffe2 {
 
-// TODO: This is a very naive implementation with a single mutex. We can do the
-// atomic index + circular queue optimizations or pull something more
-// heavy-weight later
+// Bounded multi-producer multi-consumer queue of rows of tensors. Producers
+// and consumers claim slots of a ring buffer with atomic sequence numbers, as
+// in Dmitry Vyukov's bounded MPMC queue, and copy rows straight in and out of
+// the tensors of the slots, which keep their memory from one use to the next.
+// The mutex is only taken to sleep while the queue is full or empty.
 
 class RebatchingQueue {
  public:
@@ -31,6 +33,9 @@ class RebatchingQueue {
       CPUContext& context,
       const std::vector<const TensorCPU*>& inputs);
 
+  // Copies up to numElements rows into outputs, which are resized to
+  // numElements rows upfront and shrunk if the queue gets closed before
+  // that many rows come in
   bool dequeue(
       CPUContext& context,
       size_t numElements,
@@ -45,7 +50,26 @@ class RebatchingQueue {
   void close();
 
  private:
-  bool enqueue(std::vector<std::vector<TensorCPU>> splittedInputs);
+  struct Slot {
+    // Position of the next write into this slot if it is free, and that
+    // position + 1 once the write has been published
+    std::atomic<uint64_t> sequence{0};
+    std::vector<TensorCPU> tensors;
+  };
+
+  // Return nullptr if the queue is full (resp. empty)
+  Slot* tryClaimWrite(uint64_t* pos);
+  Slot* tryClaimRead(uint64_t* pos);
+
+  // Block until a slot can be claimed, return nullptr if the queue is closed
+  // (resp. closed and empty)
+  Slot* claimWrite(uint64_t* pos);
+  Slot* claimRead(uint64_t* pos);
+
+  void publishWrite(Slot* slot, uint64_t pos);
+  void publishRead(Slot* slot, uint64_t pos);
+
+  void wakeUp(std::condition_variable& cv);
 
   bool canWrite() const;
   bool canRead() const;
@@ -53,16 +77,19 @@ class RebatchingQueue {
   const size_t capacity_;
   const size_t numBlobs_;
 
-  mutable std::mutex mutex_;
+  std::unique_ptr<Slot[]> slots_;
+
+  // Keep the positions of producers and consumers on separate cache lines
+  std::atomic<uint64_t> head_{0};
+  char padding_[64 - sizeof(std::atomic<uint64_t>)];
+  std::atomic<uint64_t> tail_{0};
 
-  bool isClosed_{false};
+  std::atomic<bool> isClosed_{false};
 
-  uint64_t head_{0};
-  uint64_t tail_{0};
+  std::mutex mutex_;
+  std::atomic<int> numWaiting_{0};
 
   std::condition_variable cvEmpty_;
   std::condition_variable cvOverflow_;
-
-  std::vector<std::vector<TensorCPU>> queue_;
 };
 } // caffe2
@@ -5,7 +5,9 @@
 #include <ostream>
 #include <fstream>
 #include <algorithm>
+#include <limits>
 
+#include <ATen/Parallel.h>
 #include <c10/core/Allocator.h>
 #include <c10/core/CPUAllocator.h>
 #include <c10/core/Backend.h>
@@ -19,6 +21,9 @@
 
 #include "miniz.h"
 
+// Defined in crc_alt.h, which is compiled in crc.cc
+uint32_t crc32_combine(uint32_t crcA, uint32_t crcB, size_t lengthB);
+
 namespace caffe2 {
 namespace serialize {
 
@@ -236,13 +241,225 @@ size_t PyTorchStreamReader::getRecordID(const std::string& name) {
   return result;
 }
 
+static int64_t read_le_16(uint8_t* buf) {
+  return buf[0] + (buf[1] << 8);
+}
+
+static uint64_t read_le_64(const uint8_t* buf) {
+  uint64_t value = 0;
+  for (int i = 7; i >= 0; --i) {
+    value = (value << 8) | buf[i];
+  }
+  return value;
+}
+
+static void write_le_64(std::string& buf, uint64_t value) {
+  for (int i = 0; i < 8; ++i) {
+    buf.push_back(static_cast<char>(value >> (8 * i)));
+  }
+}
+
+// Extra data field listing the chunks of a compressed record: the
+// uncompressed chunk size followed by the compressed size of each chunk
+constexpr char kChunksFieldId[] = {'P', 'C'};
+
+// Reads the chunks field from the local header at local_header_ofs, returns
+// false if the record has none
+static bool getCompressedChunks(
+    const ReadAdapterInterface& in,
+    uint64_t local_header_ofs,
+    uint64_t& chunk_size,
+    std::vector<uint64_t>& compressed_sizes) {
+  uint8_t local_header[MZ_ZIP_LOCAL_DIR_HEADER_SIZE];
+  in.read(
+      local_header_ofs,
+      local_header,
+      MZ_ZIP_LOCAL_DIR_HEADER_SIZE,
+      "reading file header");
+  size_t filename_len = read_le_16(local_header + MZ_ZIP_LDH_FILENAME_LEN_OFS);
+  size_t extra_len = read_le_16(local_header + MZ_ZIP_LDH_EXTRA_LEN_OFS);
+  std::vector<uint8_t> extra(extra_len);
+  in.read(
+      local_header_ofs + MZ_ZIP_LOCAL_DIR_HEADER_SIZE + filename_len,
+      extra.data(),
+      extra_len,
+      "reading file header");
+  size_t pos = 0;
+  while (pos + 4 <= extra_len) {
+    size_t field_len = read_le_16(&extra[pos + 2]);
+    if (pos + 4 + field_len > extra_len) {
+      return false;
+    }
+    if (extra[pos] == kChunksFieldId[0] && extra[pos + 1] == kChunksFieldId[1] &&
+        field_len >= 16 && field_len % 8 == 0) {
+      const uint8_t* field = &extra[pos + 4];
+      chunk_size = read_le_64(field);
+      compressed_sizes.clear();
+      for (size_t i = 8; i < field_len; i += 8) {
+        compressed_sizes.push_back(read_le_64(field + i));
+      }
+      return chunk_size > 0;
+    }
+    pos += 4 + field_len;
+  }
+  return false;
+}
+
+// offset of the data of the file whose local header is at local_header_ofs
+static size_t getDataOffset(
+    const ReadAdapterInterface& in,
+    uint64_t local_header_ofs) {
+  uint8_t local_header[MZ_ZIP_LOCAL_DIR_HEADER_SIZE];
+  in.read(
+      local_header_ofs,
+      local_header,
+      MZ_ZIP_LOCAL_DIR_HEADER_SIZE,
+      "reading file header");
+  size_t filename_len = read_le_16(local_header + MZ_ZIP_LDH_FILENAME_LEN_OFS);
+  size_t extra_len = read_le_16(local_header + MZ_ZIP_LDH_EXTRA_LEN_OFS);
+  return local_header_ofs + MZ_ZIP_LOCAL_DIR_HEADER_SIZE + filename_len + extra_len;
+}
+
+// Inflates the chunks of a compressed record in parallel, unlocks guard once
+// the compressed data is read
+static at::DataPtr inflateChunks(
+    const std::string& name,
+    const ReadAdapterInterface& in,
+    size_t offset,
+    const mz_zip_archive_file_stat& stat,
+    uint64_t chunk_size,
+    const std::vector<uint64_t>& compressed_sizes,
+    std::unique_lock<std::mutex>& guard) {
+  std::vector<uint8_t> compressed(stat.m_comp_size);
+  size_t read =
+      in.read(offset, compressed.data(), stat.m_comp_size, "reading file");
+  guard.unlock();
+  if (read != stat.m_comp_size) {
+    CAFFE_THROW(
+        "PytorchStreamReader failed reading file ",
+        name,
+        ": unexpected end of archive");
+  }
+
+  const size_t num_chunks = compressed_sizes.size();
+  std::vector<uint64_t> compressed_offsets(num_chunks, 0);
+  for (size_t i = 1; i < num_chunks; ++i) {
+    compressed_offsets[i] = compressed_offsets[i - 1] + compressed_sizes[i - 1];
+  }
+  std::vector<uint32_t> crcs(num_chunks);
+  at::DataPtr retval = c10::GetCPUAllocator()->allocate(stat.m_uncomp_size);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    std::unique_ptr<tinfl_decompressor> inflator(new tinfl_decompressor);
+    for (int64_t i = begin; i < end; ++i) {
+      const bool last = static_cast<size_t>(i) == num_chunks - 1;
+      mz_uint8* out = static_cast<mz_uint8*>(retval.get()) + i * chunk_size;
+      const size_t expected =
+          last ? stat.m_uncomp_size - i * chunk_size : chunk_size;
+      size_t in_size = compressed_sizes[i];
+      size_t out_size = expected;
+      tinfl_init(inflator.get());
+      // every chunk but the last ends with a flush, not with the final block
+      tinfl_status status = tinfl_decompress(
+          inflator.get(),
+          compressed.data() + compressed_offsets[i],
+          &in_size,
+          out,
+          out,
+          &out_size,
+          TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF |
+              (last ? 0 : TINFL_FLAG_HAS_MORE_INPUT));
+      const tinfl_status expected_status =
+          last ? TINFL_STATUS_DONE : TINFL_STATUS_NEEDS_MORE_INPUT;
+      if (status != expected_status || out_size != expected) {
+        CAFFE_THROW(
+            "PytorchStreamReader failed reading file ",
+            name,
+            ": decompression failed");
+      }
+      crcs[i] = static_cast<uint32_t>(mz_crc32(MZ_CRC32_INIT, out, out_size));
+    }
+  });
+
+  uint32_t crc = crcs[0];
+  for (size_t i = 1; i < num_chunks; ++i) {
+    const bool last = i == num_chunks - 1;
+    crc = crc32_combine(
+        crc, crcs[i], last ? stat.m_uncomp_size - i * chunk_size : chunk_size);
+  }
+  if (crc != stat.m_crc32) {
+    CAFFE_THROW(
+        "PytorchStreamReader failed reading file ",
+        name,
+        ": CRC-32 check failed");
+  }
+  return retval;
+}
+
 // return dataptr, size
 std::tuple<at::DataPtr, size_t> PyTorchStreamReader::getRecord(const std::string& name) {
-  std::lock_guard<std::mutex> guard(reader_lock_);
+  std::unique_lock<std::mutex> guard(reader_lock_);
   size_t key = getRecordID(name);
   mz_zip_archive_file_stat stat;
   mz_zip_reader_file_stat(ar_.get(), key, &stat);
   valid("retrieving file meta-data for ", name.c_str());
+  if (stat.m_method == 0 && stat.m_comp_size == stat.m_uncomp_size) {
+    size_t offset = getDataOffset(*in_, stat.m_local_header_ofs);
+    // records that are stored uncompressed and aligned can be handed out
+    // without a copy if the adapter shares its memory, e.g. MmapFileAdapter
+    if (offset % detail::kFieldAlignment == 0) {
+      at::DataPtr data_ptr = in_->getDataPtr(offset, stat.m_uncomp_size);
+      if (data_ptr) {
+        return std::make_tuple(std::move(data_ptr), stat.m_uncomp_size);
+      }
+    }
+    // the adapter isn't thread safe, but the CRC check doesn't need the lock,
+    // so getRecord calls from several threads overlap their checks
+    at::DataPtr retval = c10::GetCPUAllocator()->allocate(stat.m_uncomp_size);
+    size_t read = in_->read(
+        offset, retval.get(), stat.m_uncomp_size, "reading file");
+    guard.unlock();
+    if (read != stat.m_uncomp_size) {
+      CAFFE_THROW(
+          "PytorchStreamReader failed reading file ",
+          name,
+          ": unexpected end of archive");
+    }
+    mz_ulong crc = mz_crc32(
+        MZ_CRC32_INIT,
+        static_cast<const mz_uint8*>(retval.get()),
+        stat.m_uncomp_size);
+    if (crc != stat.m_crc32) {
+      CAFFE_THROW(
+          "PytorchStreamReader failed reading file ",
+          name,
+          ": CRC-32 check failed");
+    }
+    return std::make_tuple(std::move(retval), stat.m_uncomp_size);
+  }
+  uint64_t chunk_size = 0;
+  std::vector<uint64_t> compressed_sizes;
+  if (stat.m_method == MZ_DEFLATED &&
+      getCompressedChunks(
+          *in_, stat.m_local_header_ofs, chunk_size, compressed_sizes)) {
+    uint64_t compressed_size = 0;
+    for (auto size : compressed_sizes) {
+      compressed_size += size;
+    }
+    const size_t num_chunks = compressed_sizes.size();
+    if (compressed_size == stat.m_comp_size &&
+        (stat.m_uncomp_size + chunk_size - 1) / chunk_size == num_chunks) {
+      return std::make_tuple(
+          inflateChunks(
+              name,
+              *in_,
+              getDataOffset(*in_, stat.m_local_header_ofs),
+              stat,
+              chunk_size,
+              compressed_sizes,
+              guard),
+          stat.m_uncomp_size);
+    }
+  }
   at::DataPtr retval = c10::GetCPUAllocator()->allocate(stat.m_uncomp_size);
   mz_zip_reader_extract_to_mem(ar_.get(), key, retval.get(), stat.m_uncomp_size, 0);
   valid("reading file ", name.c_str());
@@ -250,27 +467,31 @@ std::tuple<at::DataPtr, size_t> PyTorchStreamReader::getRecord(const std::string
   return std::make_tuple(std::move(retval), stat.m_uncomp_size);
 }
 
-static int64_t read_le_16(uint8_t* buf) {
-  return buf[0] + (buf[1] << 8);
-}
-
 size_t PyTorchStreamReader::getRecordOffset(const std::string& name) {
   std::lock_guard<std::mutex> guard(reader_lock_);
   mz_zip_archive_file_stat stat;
   mz_zip_reader_file_stat(ar_.get(), getRecordID(name), &stat);
   valid("retrieving file meta-data for ", name.c_str());
-  uint8_t local_header[MZ_ZIP_LOCAL_DIR_HEADER_SIZE];
-  in_->read(
-      stat.m_local_header_ofs,
-      local_header,
-      MZ_ZIP_LOCAL_DIR_HEADER_SIZE,
-      "reading file header");
-  size_t filename_len = read_le_16(local_header + MZ_ZIP_LDH_FILENAME_LEN_OFS);
-  size_t extra_len = read_le_16(local_header + MZ_ZIP_LDH_EXTRA_LEN_OFS);
-  return stat.m_local_header_ofs + MZ_ZIP_LOCAL_DIR_HEADER_SIZE + filename_len + extra_len;
+  return getDataOffset(*in_, stat.m_local_header_ofs);
 }
 
 
+void PyTorchStreamReader::prefetchRecords(
+    const std::vector<std::string>& names) {
+  std::lock_guard<std::mutex> guard(reader_lock_);
+  for (const auto& name : names) {
+    mz_zip_archive_file_stat stat;
+    mz_zip_reader_file_stat(ar_.get(), getRecordID(name), &stat);
+    valid("retrieving file meta-data for ", name.c_str());
+    // the central directory doesn't have the size of the local extra data,
+    // which is at most 64KB
+    in_->prefetch(
+        stat.m_local_header_ofs,
+        MZ_ZIP_LOCAL_DIR_HEADER_SIZE + strlen(stat.m_filename) +
+            std::numeric_limits<uint16_t>::max() + stat.m_comp_size);
+  }
+}
+
 PyTorchStreamReader::~PyTorchStreamReader() {
   mz_zip_clear_last_error(ar_.get());
   mz_zip_reader_end(ar_.get());
@@ -337,17 +558,80 @@ void PyTorchStreamWriter::setMinVersion(const uint64_t version) {
   version_ = std::max(version, version_);
 }
 
+void PyTorchStreamWriter::enableAsyncWrites(size_t max_pending_bytes) {
+  AT_ASSERT(!finalized_);
+  TORCH_CHECK(
+      files_written.empty(),
+      "PyTorchStreamWriter: async writes have to be enabled before the first "
+      "record is written");
+  if (async_) {
+    return;
+  }
+  async_ = true;
+  max_pending_bytes_ = max_pending_bytes;
+  async_writer_ = std::thread([this]() { asyncWriterLoop(); });
+}
+
+void PyTorchStreamWriter::enableCompression(int level, size_t chunk_size) {
+  TORCH_CHECK(
+      level >= 1 && level <= MZ_BEST_COMPRESSION,
+      "PyTorchStreamWriter: compression level must be between 1 and ",
+      MZ_BEST_COMPRESSION,
+      ", got ",
+      level);
+  TORCH_CHECK(chunk_size > 0, "PyTorchStreamWriter: chunk size must be positive");
+  compression_level_ = level;
+  compression_chunk_size_ = chunk_size;
+}
+
 void PyTorchStreamWriter::writeRecord(
     const std::string& name,
     const void* data,
     size_t size,
     bool compress) {
+  if (async_) {
+    // snapshot, the caller is free to change data once this returns
+    at::DataPtr copy = c10::GetCPUAllocator()->allocate(size);
+    if (size > 0) {
+      memcpy(copy.get(), data, size);
+    }
+    writeRecord(name, std::move(copy), size, compress);
+    return;
+  }
   AT_ASSERT(!finalized_);
+  writeRecordToArchive(name, data, size, compress);
+  files_written.push_back(name);
+}
+
+void PyTorchStreamWriter::writeRecord(
+    const std::string& name,
+    at::DataPtr data,
+    size_t size,
+    bool compress) {
+  if (!async_) {
+    writeRecord(name, data.get(), size, compress);
+    return;
+  }
+  AT_ASSERT(!finalized_ && !end_of_file_queued_);
+  queueRecord({name, std::move(data), size, compress, /*end_of_file=*/false});
+  files_written.push_back(name);
+}
+
+void PyTorchStreamWriter::writeRecordToArchive(
+    const std::string& name,
+    const void* data,
+    size_t size,
+    bool compress) {
   AT_ASSERT(!archive_name_plus_slash_.empty());
   std::string full_name = archive_name_plus_slash_ + name;
+  const int level = compress ? MZ_BEST_COMPRESSION : compression_level_;
+  if (level > 0 && size > 0 &&
+      writeCompressedRecord(full_name, data, size, level)) {
+    valid("writing file ", name.c_str());
+    return;
+  }
   size_t padding_size =
       detail::getPadding(ar_->m_archive_size, full_name.size(), size, padding_);
-  uint32_t flags = compress ? MZ_BEST_COMPRESSION : 0;
   mz_zip_writer_add_mem_ex_v2(
       ar_.get(),
       full_name.c_str(),
@@ -355,7 +639,7 @@ void PyTorchStreamWriter::writeRecord(
       size,
       nullptr,
       0,
-      flags,
+      0,
       0,
       0,
       nullptr,
@@ -364,7 +648,101 @@ void PyTorchStreamWriter::writeRecord(
       nullptr,
       0);
   valid("writing file ", name.c_str());
-  files_written.push_back(name);
+}
+
+static mz_bool appendToString(const void* buf, int len, void* user) {
+  static_cast<std::string*>(user)->append(static_cast<const char*>(buf), len);
+  return MZ_TRUE;
+}
+
+bool PyTorchStreamWriter::writeCompressedRecord(
+    const std::string& full_name,
+    const void* data,
+    size_t size,
+    int level) {
+  size_t chunk_size = std::max(
+      compression_chunk_size_,
+      (size + detail::kMaxCompressionChunks - 1) /
+          detail::kMaxCompressionChunks);
+  const size_t num_chunks = (size + chunk_size - 1) / chunk_size;
+  const mz_uint flags = tdefl_create_comp_flags_from_zip_params(
+      level, -MZ_DEFAULT_WINDOW_BITS, MZ_DEFAULT_STRATEGY);
+
+  std::vector<std::string> chunks(num_chunks);
+  std::vector<uint32_t> crcs(num_chunks);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    std::unique_ptr<tdefl_compressor> deflator(new tdefl_compressor);
+    for (int64_t i = begin; i < end; ++i) {
+      const bool last = static_cast<size_t>(i) == num_chunks - 1;
+      const size_t chunk_begin = i * chunk_size;
+      const size_t chunk_len = last ? size - chunk_begin : chunk_size;
+      const auto* in = static_cast<const mz_uint8*>(data) + chunk_begin;
+      crcs[i] = static_cast<uint32_t>(mz_crc32(MZ_CRC32_INIT, in, chunk_len));
+      tdefl_init(deflator.get(), appendToString, &chunks[i], flags);
+      // a full flush ends the chunk on a byte boundary without ending the
+      // stream, so the chunks can be concatenated
+      tdefl_status status = tdefl_compress_buffer(
+          deflator.get(),
+          in,
+          chunk_len,
+          last ? TDEFL_FINISH : TDEFL_FULL_FLUSH);
+      TORCH_CHECK(
+          status == (last ? TDEFL_STATUS_DONE : TDEFL_STATUS_OKAY),
+          "PytorchStreamWriter failed compressing file ",
+          full_name);
+    }
+  });
+
+  size_t compressed_size = 0;
+  for (const auto& chunk : chunks) {
+    compressed_size += chunk.size();
+  }
+  if (compressed_size >= size) {
+    return false;
+  }
+
+  std::string extra;
+  if (num_chunks > 1) {
+    const size_t field_len = 8 * (num_chunks + 1);
+    extra.push_back(kChunksFieldId[0]);
+    extra.push_back(kChunksFieldId[1]);
+    extra.push_back(static_cast<char>(field_len));
+    extra.push_back(static_cast<char>(field_len >> 8));
+    write_le_64(extra, chunk_size);
+    for (const auto& chunk : chunks) {
+      write_le_64(extra, chunk.size());
+    }
+  }
+
+  std::string compressed;
+  compressed.reserve(compressed_size);
+  uint32_t crc = crcs[0];
+  for (size_t i = 0; i < num_chunks; ++i) {
+    compressed += chunks[i];
+    std::string().swap(chunks[i]);
+    if (i > 0) {
+      const bool last = i == num_chunks - 1;
+      crc = crc32_combine(
+          crc, crcs[i], last ? size - i * chunk_size : chunk_size);
+    }
+  }
+
+  mz_zip_writer_add_mem_ex_v2(
+      ar_.get(),
+      full_name.c_str(),
+      compressed.data(),
+      compressed.size(),
+      nullptr,
+      0,
+      level | MZ_ZIP_FLAG_COMPRESSED_DATA,
+      size,
+      crc,
+      nullptr,
+      extra.data(),
+      extra.size(),
+      nullptr,
+      0);
+  return true;
 }
 
 void PyTorchStreamWriter::writeEndOfFile() {
@@ -378,8 +756,17 @@ void PyTorchStreamWriter::writeEndOfFile() {
   }
 
   AT_ASSERT(!finalized_);
+  if (async_) {
+    AT_ASSERT(!end_of_file_queued_);
+    end_of_file_queued_ = true;
+    queueRecord({"", at::DataPtr(), 0, false, /*end_of_file=*/true});
+    return;
+  }
   finalized_ = true;
+  finalizeArchive();
+}
 
+void PyTorchStreamWriter::finalizeArchive() {
   mz_zip_writer_finalize_archive(ar_.get());
   mz_zip_writer_end(ar_.get());
   valid("writing central directory for archive ", archive_name_.c_str());
@@ -388,6 +775,86 @@ void PyTorchStreamWriter::writeEndOfFile() {
   }
 }
 
+void PyTorchStreamWriter::queueRecord(PendingRecord record) {
+  std::unique_lock<std::mutex> lock(async_mutex_);
+  // a record larger than the limit is queued once nothing else is pending
+  async_cv_.wait(lock, [&]() {
+    return async_error_ || pending_bytes_ == 0 ||
+        pending_bytes_ + record.size <= max_pending_bytes_;
+  });
+  if (async_error_) {
+    std::rethrow_exception(async_error_);
+  }
+  pending_bytes_ += record.size;
+  pending_records_.push_back(std::move(record));
+  async_cv_.notify_all();
+}
+
+void PyTorchStreamWriter::asyncWriterLoop() {
+  while (true) {
+    PendingRecord record;
+    {
+      std::unique_lock<std::mutex> lock(async_mutex_);
+      async_cv_.wait(
+          lock, [&]() { return !pending_records_.empty() || async_stop_; });
+      if (pending_records_.empty()) {
+        return;
+      }
+      record = std::move(pending_records_.front());
+      pending_records_.pop_front();
+    }
+    bool failed = false;
+    {
+      std::lock_guard<std::mutex> lock(async_mutex_);
+      failed = static_cast<bool>(async_error_);
+    }
+    // after an error the remaining records are dropped
+    if (!failed) {
+      try {
+        if (record.end_of_file) {
+          finalizeArchive();
+        } else {
+          writeRecordToArchive(
+              record.name, record.data.get(), record.size, record.compress);
+        }
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(async_mutex_);
+        async_error_ = std::current_exception();
+      }
+    }
+    const bool end_of_file = record.end_of_file;
+    // free the snapshot before more records are let in
+    record.data.clear();
+    {
+      std::lock_guard<std::mutex> lock(async_mutex_);
+      pending_bytes_ -= record.size;
+    }
+    async_cv_.notify_all();
+    if (end_of_file) {
+      return;
+    }
+  }
+}
+
+void PyTorchStreamWriter::waitForWrites() {
+  if (!async_) {
+    return;
+  }
+  {
+    std::unique_lock<std::mutex> lock(async_mutex_);
+    async_cv_.wait(lock, [&]() {
+      return pending_records_.empty() && pending_bytes_ == 0;
+    });
+    if (async_error_) {
+      std::rethrow_exception(async_error_);
+    }
+  }
+  if (end_of_file_queued_ && async_writer_.joinable()) {
+    async_writer_.join();
+    finalized_ = true;
+  }
+}
+
 void PyTorchStreamWriter::valid(const char* what, const char* info) {
   auto err = mz_zip_get_last_error(ar_.get());
   if (err != MZ_ZIP_NO_ERROR) {
@@ -404,6 +871,26 @@ void PyTorchStreamWriter::valid(const char* what, const char* info) {
 }
 
 PyTorchStreamWriter::~PyTorchStreamWriter() {
+  if (async_) {
+    try {
+      if (!end_of_file_queued_) {
+        writeEndOfFile();
+      }
+      waitForWrites();
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "PyTorchStreamWriter failed writing archive "
+                 << archive_name_ << ": " << e.what();
+    }
+    {
+      std::lock_guard<std::mutex> lock(async_mutex_);
+      async_stop_ = true;
+    }
+    async_cv_.notify_all();
+    if (async_writer_.joinable()) {
+      async_writer_.join();
+    }
+    return;
+  }
   if (!finalized_) {
     writeEndOfFile();
   }
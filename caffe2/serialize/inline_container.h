@@ -1,12 +1,16 @@
 #pragma once
 
 #include <cerrno>
+#include <condition_variable>
 #include <cstdio>
 #include <cstring>
+#include <deque>
+#include <exception>
 #include <fstream>
 #include <istream>
 #include <mutex>
 #include <ostream>
+#include <thread>
 
 #include <c10/core/Allocator.h>
 #include <c10/core/Backend.h>
@@ -41,11 +45,17 @@ typedef struct mz_zip_archive mz_zip_archive;
 //
 // The PyTorchStreamWriter also ensures additional useful properties for these
 // files
-// 1. All files are stored uncompressed.
-// 2. All files in the archive are aligned to 64 byte boundaries such that
-//    it is possible to mmap the entire file and get an aligned pointer to
-//    tensor data.
+// 1. All files are stored uncompressed, unless compression is asked for (see
+//    PyTorchStreamWriter::enableCompression).
+// 2. All uncompressed files in the archive are aligned to 64 byte boundaries
+//    such that it is possible to mmap the entire file and get an aligned
+//    pointer to tensor data.
 // 3. We universally write in ZIP64 format for consistency.
+// 4. Compressed files are deflated in independent chunks, each but the last
+//    ending with a full flush, so that their concatenation is a regular
+//    deflate stream. The sizes of the chunks are listed in a "PC" field of the
+//    local header's extra data, which lets the reader inflate them in
+//    parallel. Other zip tools ignore the field.
 
 // The PyTorchStreamReader also provides additional properties:
 // 1. It can read zip files that are created with common
@@ -99,8 +109,16 @@ class TORCH_API PyTorchStreamReader final {
   explicit PyTorchStreamReader(std::shared_ptr<ReadAdapterInterface> in);
 
   // return dataptr, size
+  // If the adapter supports ReadAdapterInterface::getDataPtr (e.g.
+  // MmapFileAdapter) and the record is stored uncompressed at an offset that
+  // is a multiple of detail::kFieldAlignment, the DataPtr points into the
+  // adapter's memory instead of a copy and its CRC isn't checked.
   std::tuple<at::DataPtr, size_t> getRecord(const std::string& name);
   size_t getRecordOffset(const std::string& name);
+  // Passes the ranges of the given records to ReadAdapterInterface::prefetch,
+  // in the order given, so an adapter like RangeReadAdapter fetches them in
+  // the background while the first ones are read
+  void prefetchRecords(const std::vector<std::string>& names);
   bool hasRecord(const std::string& name);
   std::vector<std::string> getAllRecords();
 
@@ -133,15 +151,51 @@ class TORCH_API PyTorchStreamWriter final {
 
   void setMinVersion(const uint64_t version);
 
+  // Switches the writer to asynchronous writes, must be called before the
+  // first record is written. From then on writeRecord only snapshots the
+  // record into a host buffer (or takes over the given DataPtr) and queues
+  // it, and a background thread writes the queued records to the archive.
+  // writeRecord blocks while more than max_pending_bytes are queued, so
+  // snapshotting the next record overlaps with writing the previous ones
+  // without holding the whole archive in memory. writeEndOfFile only queues
+  // the end of the archive; waitForWrites blocks until everything is written
+  // and rethrows the first write error. The destructor waits as well, so if
+  // writer_func needs a lock the caller holds (e.g. the GIL) call
+  // waitForWrites without that lock first.
+  void enableAsyncWrites(size_t max_pending_bytes = kDefaultMaxPendingBytes);
+
+  // Deflates the records written from now on at the given level (1 to 9), in
+  // chunks of chunk_size bytes that are compressed in parallel. Records that
+  // don't get smaller are still stored uncompressed and aligned. The archive
+  // stays readable by any zip reader, PyTorchStreamReader inflates the chunks
+  // in parallel.
+  void enableCompression(
+      int level = kDefaultCompressionLevel,
+      size_t chunk_size = kDefaultCompressionChunkSize);
+
   void writeRecord(
       const std::string& name,
       const void* data,
       size_t size,
       bool compress = false);
+  // Takes ownership of data, which avoids the snapshot copy in async mode
+  void writeRecord(
+      const std::string& name,
+      at::DataPtr data,
+      size_t size,
+      bool compress = false);
   void writeEndOfFile();
 
+  // Blocks until all queued records are written, finishes the archive if
+  // writeEndOfFile was called. No-op for synchronous writers.
+  void waitForWrites();
+
   const std::vector<std::string>& getAllWrittenRecords();
 
+  static constexpr size_t kDefaultMaxPendingBytes = 256 * 1024 * 1024;
+  static constexpr int kDefaultCompressionLevel = 1;
+  static constexpr size_t kDefaultCompressionChunkSize = 4 * 1024 * 1024;
+
   bool finalized() const {
     return finalized_;
   }
@@ -153,8 +207,31 @@ class TORCH_API PyTorchStreamWriter final {
   ~PyTorchStreamWriter();
 
  private:
+  struct PendingRecord {
+    std::string name;
+    at::DataPtr data;
+    size_t size;
+    bool compress;
+    // finishes the archive instead of writing a record
+    bool end_of_file;
+  };
+
   void setup(const std::string& file_name);
   void valid(const char* what, const char* info = "");
+  void writeRecordToArchive(
+      const std::string& name,
+      const void* data,
+      size_t size,
+      bool compress);
+  // Returns false without writing anything if the record doesn't compress
+  bool writeCompressedRecord(
+      const std::string& full_name,
+      const void* data,
+      size_t size,
+      int level);
+  void finalizeArchive();
+  void queueRecord(PendingRecord record);
+  void asyncWriterLoop();
   size_t current_pos_ = 0;
   std::vector<std::string> files_written;
   std::unique_ptr<mz_zip_archive> ar_;
@@ -166,6 +243,21 @@ class TORCH_API PyTorchStreamWriter final {
   uint64_t version_ = kProducedFileFormatVersion;
   bool finalized_ = false;
   bool err_seen_ = false;
+  // 0 if records are only compressed when writeRecord is asked to
+  int compression_level_ = 0;
+  size_t compression_chunk_size_ = kDefaultCompressionChunkSize;
+
+  // async mode, see enableAsyncWrites
+  bool async_ = false;
+  bool end_of_file_queued_ = false;
+  bool async_stop_ = false;
+  size_t max_pending_bytes_ = 0;
+  size_t pending_bytes_ = 0;
+  std::deque<PendingRecord> pending_records_;
+  std::exception_ptr async_error_;
+  std::mutex async_mutex_;
+  std::condition_variable async_cv_;
+  std::thread async_writer_;
   friend size_t ostream_write_func(
       void* pOpaque,
       uint64_t file_ofs,
@@ -176,6 +268,9 @@ class TORCH_API PyTorchStreamWriter final {
 namespace detail {
 // Writer-specific constants
 constexpr uint64_t kFieldAlignment = 64;
+// At most this many chunks per compressed record, larger records get larger
+// chunks so that the chunk sizes fit in the local header
+constexpr size_t kMaxCompressionChunks = 4096;
 
 // Returns a record to be appended to the local user extra data entry in order
 // to make data beginning aligned at kFieldAlignment bytes boundary.
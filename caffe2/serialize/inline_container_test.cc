@@ -1,10 +1,14 @@
 #include <cstdio>
 #include <string>
 #include <array>
+#include <vector>
 
 #include <gtest/gtest.h>
 
+#include <c10/core/CPUAllocator.h>
+
 #include "caffe2/serialize/inline_container.h"
+#include "caffe2/serialize/mmap_file_adapter.h"
 
 namespace caffe2 {
 namespace serialize {
@@ -68,6 +72,163 @@ TEST(PyTorchStreamWriterAndReader, SaveAndLoad) {
   ASSERT_EQ(memcmp(the_file.c_str() + off2, data2.data(), data2.size()), 0);
 }
 
+TEST(PyTorchStreamWriterAndReader, AsyncWrites) {
+  std::ostringstream oss;
+  PyTorchStreamWriter writer([&](const void* b, size_t n) -> size_t {
+    oss.write(static_cast<const char*>(b), n);
+    return oss ? n : 0;
+  });
+  // smaller than two records, so writeRecord has to wait for the writer
+  writer.enableAsyncWrites(/*max_pending_bytes=*/300);
+
+  std::vector<char> data(256);
+  for (int i = 0; i < 10; ++i) {
+    std::fill(data.begin(), data.end(), static_cast<char>(i));
+    writer.writeRecord("key" + c10::to_string(i), data.data(), data.size());
+  }
+  // written without a snapshot copy
+  at::DataPtr owned = c10::GetCPUAllocator()->allocate(128);
+  memset(owned.get(), 42, 128);
+  writer.writeRecord("owned", std::move(owned), 128);
+  writer.writeEndOfFile();
+  writer.waitForWrites();
+  ASSERT_TRUE(writer.finalized());
+
+  std::istringstream iss(oss.str());
+  PyTorchStreamReader reader(&iss);
+  for (int i = 0; i < 10; ++i) {
+    at::DataPtr data_ptr;
+    int64_t size;
+    std::tie(data_ptr, size) = reader.getRecord("key" + c10::to_string(i));
+    ASSERT_EQ(size, data.size());
+    std::vector<char> expected(data.size(), static_cast<char>(i));
+    ASSERT_EQ(memcmp(data_ptr.get(), expected.data(), expected.size()), 0);
+  }
+  at::DataPtr data_ptr = std::get<0>(reader.getRecord("owned"));
+  ASSERT_EQ(static_cast<char*>(data_ptr.get())[127], 42);
+}
+
+TEST(PyTorchStreamWriterAndReader, AsyncWriteError) {
+  size_t written = 0;
+  PyTorchStreamWriter writer([&](const void* b, size_t n) -> size_t {
+    if (written > 1000) {
+      return 0;
+    }
+    written += n;
+    return n;
+  });
+  writer.enableAsyncWrites();
+  std::vector<char> data(512);
+  for (int i = 0; i < 10; ++i) {
+    try {
+      writer.writeRecord("key" + c10::to_string(i), data.data(), data.size());
+    } catch (const std::exception&) {
+      // the error may already be reported here
+      break;
+    }
+  }
+  ASSERT_ANY_THROW(writer.waitForWrites());
+}
+
+TEST(PyTorchStreamWriterAndReader, CorruptedRecord) {
+  std::ostringstream oss;
+  PyTorchStreamWriter writer([&](const void* b, size_t n) -> size_t {
+    oss.write(static_cast<const char*>(b), n);
+    return oss ? n : 0;
+  });
+  std::array<char, 127> data1;
+  for (int i = 0; i < data1.size(); ++i) {
+    data1[i] = data1.size() - i;
+  }
+  writer.writeRecord("key1", data1.data(), data1.size());
+  writer.writeEndOfFile();
+
+  std::string the_file = oss.str();
+  size_t off1;
+  {
+    std::istringstream iss(the_file);
+    PyTorchStreamReader reader(&iss);
+    off1 = reader.getRecordOffset("key1");
+  }
+  the_file[off1] ^= 1;
+  std::istringstream iss(the_file);
+  PyTorchStreamReader reader(&iss);
+  ASSERT_ANY_THROW(reader.getRecord("key1"));
+}
+
+TEST(PyTorchStreamWriterAndReader, Compression) {
+  std::ostringstream oss;
+  PyTorchStreamWriter writer([&](const void* b, size_t n) -> size_t {
+    oss.write(static_cast<const char*>(b), n);
+    return oss ? n : 0;
+  });
+  // several chunks, the last one shorter
+  writer.enableCompression(/*level=*/1, /*chunk_size=*/1000);
+  std::vector<char> compressible(4567);
+  for (size_t i = 0; i < compressible.size(); ++i) {
+    compressible[i] = static_cast<char>(i % 13);
+  }
+  writer.writeRecord("compressible", compressible.data(), compressible.size());
+  std::vector<char> incompressible(3000);
+  uint32_t state = 1;
+  for (auto& c : incompressible) {
+    state = state * 1664525 + 1013904223;
+    c = static_cast<char>(state >> 24);
+  }
+  writer.writeRecord(
+      "incompressible", incompressible.data(), incompressible.size());
+  writer.writeEndOfFile();
+
+  std::string the_file = oss.str();
+  ASSERT_LT(the_file.size(), compressible.size() + incompressible.size());
+  std::istringstream iss(the_file);
+  PyTorchStreamReader reader(&iss);
+  at::DataPtr data_ptr;
+  int64_t size;
+  std::tie(data_ptr, size) = reader.getRecord("compressible");
+  ASSERT_EQ(size, compressible.size());
+  ASSERT_EQ(memcmp(data_ptr.get(), compressible.data(), size), 0);
+  // stored as is, so still aligned
+  std::tie(data_ptr, size) = reader.getRecord("incompressible");
+  ASSERT_EQ(size, incompressible.size());
+  ASSERT_EQ(memcmp(data_ptr.get(), incompressible.data(), size), 0);
+  ASSERT_EQ(reader.getRecordOffset("incompressible") % detail::kFieldAlignment, 0);
+}
+
+#ifndef _WIN32
+TEST(PyTorchStreamWriterAndReader, MmapZeroCopy) {
+  const std::string file_name = "output_mmap.zip";
+  std::array<char, 127> data1;
+  for (int i = 0; i < data1.size(); ++i) {
+    data1[i] = data1.size() - i;
+  }
+  {
+    PyTorchStreamWriter writer(file_name);
+    writer.writeRecord("key1", data1.data(), data1.size());
+    writer.writeEndOfFile();
+  }
+
+  {
+    PyTorchStreamReader reader(std::make_shared<MmapFileAdapter>(file_name));
+    at::DataPtr data_ptr;
+    int64_t size;
+    std::tie(data_ptr, size) = reader.getRecord("key1");
+    ASSERT_EQ(size, data1.size());
+    ASSERT_EQ(memcmp(data_ptr.get(), data1.data(), data1.size()), 0);
+    // both point into the mapping rather than into copies
+    at::DataPtr other_ptr = std::get<0>(reader.getRecord("key1"));
+    ASSERT_EQ(data_ptr.get(), other_ptr.get());
+    // copy-on-write, the file is left untouched
+    static_cast<char*>(data_ptr.get())[0] = 0;
+  }
+
+  PyTorchStreamReader reader(std::make_shared<MmapFileAdapter>(file_name));
+  at::DataPtr data_ptr = std::get<0>(reader.getRecord("key1"));
+  ASSERT_EQ(memcmp(data_ptr.get(), data1.data(), data1.size()), 0);
+  std::remove(file_name.c_str());
+}
+#endif
+
 } // namespace
 } // namespace serialize
 } // namespace caffe2
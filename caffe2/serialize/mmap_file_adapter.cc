@@ -0,0 +1,113 @@
+#include "caffe2/serialize/mmap_file_adapter.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <c10/util/Exception.h>
+#include "caffe2/core/common.h"
+
+namespace caffe2 {
+namespace serialize {
+
+struct MmapFileAdapter::Mapping {
+  void* data = nullptr;
+  size_t size = 0;
+
+  ~Mapping() {
+#ifndef _WIN32
+    if (data) {
+      munmap(data, size);
+    }
+#endif
+  }
+};
+
+namespace {
+
+void deleteMapping(void* ctx) {
+  delete static_cast<std::shared_ptr<void>*>(ctx);
+}
+
+} // namespace
+
+MmapFileAdapter::MmapFileAdapter(const std::string& file_name)
+    : mapping_(std::make_shared<Mapping>()) {
+#ifdef _WIN32
+  AT_ERROR("memory mapped loading is not supported on Windows, file path: ",
+           file_name);
+#else
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    AT_ERROR("open file failed, file path: ", file_name, ", ", strerror(errno));
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    int err = errno;
+    close(fd);
+    AT_ERROR("fstat failed, file path: ", file_name, ", ", strerror(err));
+  }
+  mapping_->size = st.st_size;
+  if (mapping_->size > 0) {
+    // MAP_PRIVATE with PROT_WRITE: pages are shared with the page cache
+    // until somebody writes to them
+    void* data = mmap(
+        nullptr,
+        mapping_->size,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE,
+        fd,
+        0);
+    if (data == MAP_FAILED) {
+      int err = errno;
+      close(fd);
+      AT_ERROR("mmap failed, file path: ", file_name, ", ", strerror(err));
+    }
+    mapping_->data = data;
+  }
+  // the mapping keeps its own reference to the file
+  close(fd);
+#endif
+}
+
+size_t MmapFileAdapter::size() const {
+  return mapping_->size;
+}
+
+size_t MmapFileAdapter::read(uint64_t pos, void* buf, size_t n, const char* what)
+    const {
+  if (pos >= mapping_->size) {
+    return 0;
+  }
+  n = std::min<size_t>(n, mapping_->size - pos);
+  memcpy(buf, static_cast<const char*>(mapping_->data) + pos, n);
+  return n;
+}
+
+at::DataPtr MmapFileAdapter::getDataPtr(uint64_t pos, size_t n) const {
+  TORCH_CHECK(
+      pos <= mapping_->size && n <= mapping_->size - pos,
+      "record at ",
+      pos,
+      " of size ",
+      n,
+      " is out of bounds of the mapped file of size ",
+      mapping_->size);
+  return {
+      static_cast<char*>(mapping_->data) + pos,
+      new std::shared_ptr<void>(mapping_),
+      &deleteMapping,
+      at::Device(at::DeviceType::CPU)};
+}
+
+MmapFileAdapter::~MmapFileAdapter() {}
+
+} // namespace serialize
+} // namespace caffe2
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "c10/macros/Macros.h"
+#include "caffe2/serialize/read_adapter_interface.h"
+
+namespace caffe2 {
+namespace serialize {
+
+// Maps the whole file into memory privately (copy-on-write) instead of
+// reading it through a stream. PyTorchStreamReader returns records that are
+// stored uncompressed and suitably aligned as DataPtrs that point straight
+// into the mapping, so loading a model doesn't copy its weights and
+// processes that load the same file share them through the page cache.
+// Writing to such a record only changes the calling process's copy of the
+// page. The mapping stays alive as long as any of these DataPtrs does.
+class TORCH_API MmapFileAdapter final : public ReadAdapterInterface {
+ public:
+  C10_DISABLE_COPY_AND_ASSIGN(MmapFileAdapter);
+  explicit MmapFileAdapter(const std::string& file_name);
+  size_t size() const override;
+  size_t read(uint64_t pos, void* buf, size_t n, const char* what = "")
+      const override;
+  at::DataPtr getDataPtr(uint64_t pos, size_t n) const override;
+  ~MmapFileAdapter();
+
+ private:
+  struct Mapping;
+  std::shared_ptr<Mapping> mapping_;
+};
+
+} // namespace serialize
+} // namespace caffe2
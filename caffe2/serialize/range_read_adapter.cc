@@ -0,0 +1,246 @@
+#include "caffe2/serialize/range_read_adapter.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <c10/util/Exception.h>
+
+namespace caffe2 {
+namespace serialize {
+
+namespace {
+
+struct Chunk {
+  bool ready = false;
+  // only chunks that have been read are evicted
+  bool used = false;
+  uint64_t last_use = 0;
+  std::exception_ptr error;
+  std::vector<char> data;
+};
+
+} // namespace
+
+struct RangeReadAdapter::Impl {
+  Impl(size_t size, RangeReader range_reader, Options options)
+      : size(size),
+        range_reader(std::move(range_reader)),
+        options(options) {
+    TORCH_CHECK(
+        options.chunk_size > 0, "RangeReadAdapter: chunk size must be positive");
+    for (size_t i = 0; i < options.num_threads; ++i) {
+      workers.emplace_back([this]() { workerLoop(); });
+    }
+  }
+
+  ~Impl() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stop = true;
+    }
+    cv.notify_all();
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  }
+
+  size_t numChunks() const {
+    return (size + options.chunk_size - 1) / options.chunk_size;
+  }
+
+  // Requests the chunk without the lock, stores it with the lock
+  void fetch(
+      size_t index,
+      const std::shared_ptr<Chunk>& chunk,
+      std::unique_lock<std::mutex>& lock) {
+    lock.unlock();
+    const uint64_t begin = index * options.chunk_size;
+    const size_t length =
+        std::min<uint64_t>(options.chunk_size, size - begin);
+    std::vector<char> data(length);
+    std::exception_ptr error;
+    try {
+      size_t n = range_reader(begin, data.data(), length);
+      TORCH_CHECK(
+          n == length,
+          "RangeReadAdapter: expected ",
+          length,
+          " bytes at ",
+          begin,
+          ", got ",
+          n);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    lock.lock();
+    chunk->data = std::move(data);
+    chunk->error = error;
+    chunk->ready = true;
+    cv.notify_all();
+  }
+
+  // Returns the chunk once it is fetched, fetching it on this thread if
+  // nobody else is
+  std::shared_ptr<Chunk> getChunk(
+      size_t index,
+      std::unique_lock<std::mutex>& lock) {
+    std::shared_ptr<Chunk> chunk;
+    auto it = chunks.find(index);
+    if (it == chunks.end()) {
+      chunk = std::make_shared<Chunk>();
+      chunks.emplace(index, chunk);
+      fetch(index, chunk, lock);
+    } else {
+      chunk = it->second;
+      cv.wait(lock, [&]() { return chunk->ready; });
+    }
+    if (chunk->error) {
+      // dropped so that the next read tries again
+      it = chunks.find(index);
+      if (it != chunks.end() && it->second == chunk) {
+        chunks.erase(it);
+      }
+      std::rethrow_exception(chunk->error);
+    }
+    chunk->used = true;
+    chunk->last_use = ++clock;
+    while (chunks.size() > options.max_cached_chunks && evictOne()) {
+    }
+    // prefetching may wait for chunks to be read
+    cv.notify_all();
+    return chunk;
+  }
+
+  void enqueue(size_t index) {
+    if (index < numChunks() && chunks.count(index) == 0 &&
+        queued.insert(index).second) {
+      queue.push_back(index);
+    }
+  }
+
+  // Evicts the least recently read chunk, returns false if no chunk has been
+  // read since it was fetched
+  bool evictOne() {
+    auto victim = chunks.end();
+    for (auto it = chunks.begin(); it != chunks.end(); ++it) {
+      if (it->second->ready && it->second->used &&
+          (victim == chunks.end() ||
+           it->second->last_use < victim->second->last_use)) {
+        victim = it;
+      }
+    }
+    if (victim == chunks.end()) {
+      return false;
+    }
+    chunks.erase(victim);
+    return true;
+  }
+
+  void workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stop) {
+      if (queue.empty() ||
+          (chunks.size() >= options.max_cached_chunks && !evictOne())) {
+        cv.wait(lock);
+        continue;
+      }
+      const size_t index = queue.front();
+      queue.pop_front();
+      queued.erase(index);
+      if (chunks.count(index) != 0) {
+        continue;
+      }
+      auto chunk = std::make_shared<Chunk>();
+      chunks.emplace(index, chunk);
+      fetch(index, chunk, lock);
+    }
+  }
+
+  const size_t size;
+  const RangeReader range_reader;
+  const Options options;
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::unordered_map<size_t, std::shared_ptr<Chunk>> chunks;
+  // chunks to prefetch, in order
+  std::deque<size_t> queue;
+  std::unordered_set<size_t> queued;
+  uint64_t clock = 0;
+  bool stop = false;
+  std::vector<std::thread> workers;
+};
+
+RangeReadAdapter::RangeReadAdapter(size_t size, RangeReader range_reader)
+    : RangeReadAdapter(size, std::move(range_reader), Options()) {}
+
+RangeReadAdapter::RangeReadAdapter(
+    size_t size,
+    RangeReader range_reader,
+    Options options)
+    : impl_(std::make_unique<Impl>(size, std::move(range_reader), options)) {}
+
+size_t RangeReadAdapter::size() const {
+  return impl_->size;
+}
+
+size_t RangeReadAdapter::read(uint64_t pos, void* buf, size_t n, const char* what)
+    const {
+  if (pos >= impl_->size || n == 0) {
+    return 0;
+  }
+  n = std::min<uint64_t>(n, impl_->size - pos);
+  const size_t chunk_size = impl_->options.chunk_size;
+  const size_t first = pos / chunk_size;
+  const size_t last = (pos + n - 1) / chunk_size;
+
+  std::unique_lock<std::mutex> lock(impl_->mutex);
+  // the rest of this read and the readahead are fetched concurrently while
+  // this thread fetches the first chunk
+  for (size_t i = first + 1; i <= last + impl_->options.readahead_chunks;
+       ++i) {
+    impl_->enqueue(i);
+  }
+  impl_->cv.notify_all();
+
+  for (size_t i = first; i <= last; ++i) {
+    auto chunk = impl_->getChunk(i, lock);
+    const uint64_t chunk_begin = i * chunk_size;
+    const uint64_t begin = std::max<uint64_t>(pos, chunk_begin);
+    const uint64_t end = std::min<uint64_t>(pos + n, chunk_begin + chunk_size);
+    // the data of a fetched chunk doesn't change
+    lock.unlock();
+    memcpy(
+        static_cast<char*>(buf) + (begin - pos),
+        chunk->data.data() + (begin - chunk_begin),
+        end - begin);
+    lock.lock();
+  }
+  return n;
+}
+
+void RangeReadAdapter::prefetch(uint64_t pos, size_t n) const {
+  if (pos >= impl_->size || n == 0) {
+    return;
+  }
+  n = std::min<uint64_t>(n, impl_->size - pos);
+  const size_t chunk_size = impl_->options.chunk_size;
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  for (size_t i = pos / chunk_size; i <= (pos + n - 1) / chunk_size; ++i) {
+    impl_->enqueue(i);
+  }
+  impl_->cv.notify_all();
+}
+
+RangeReadAdapter::~RangeReadAdapter() {}
+
+} // namespace serialize
+} // namespace caffe2
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include "c10/macros/Macros.h"
+#include "caffe2/serialize/read_adapter_interface.h"
+
+namespace caffe2 {
+namespace serialize {
+
+// Reads an archive through range requests, e.g. from an object store, instead
+// of downloading it first. The archive is fetched in fixed size chunks that
+// are cached, so the many small reads PyTorchStreamReader does for the zip
+// headers cost one request per chunk. Chunks are fetched on a pool of
+// threads ahead of time, both for the ranges passed to prefetch (see
+// PyTorchStreamReader::prefetchRecords) and for the chunks that follow the
+// last one read, so reading a record mostly waits for chunks that are
+// already being downloaded.
+//
+// At most max_cached_chunks chunks are kept. Prefetched chunks stay cached
+// until they have been read; once the cache is full of them, prefetching
+// waits for reads to catch up.
+class TORCH_API RangeReadAdapter final : public ReadAdapterInterface {
+ public:
+  // Reads n bytes at pos of the archive into buf and returns the number of
+  // bytes read. Called concurrently from several threads.
+  using RangeReader =
+      std::function<size_t(uint64_t pos, void* buf, size_t n)>;
+
+  struct Options {
+    size_t chunk_size = 4 * 1024 * 1024;
+    size_t max_cached_chunks = 64;
+    // chunks fetched ahead of the last one read
+    size_t readahead_chunks = 4;
+    // concurrent range requests for prefetching
+    size_t num_threads = 8;
+  };
+
+  C10_DISABLE_COPY_AND_ASSIGN(RangeReadAdapter);
+  RangeReadAdapter(size_t size, RangeReader range_reader);
+  RangeReadAdapter(size_t size, RangeReader range_reader, Options options);
+  size_t size() const override;
+  size_t read(uint64_t pos, void* buf, size_t n, const char* what = "")
+      const override;
+  void prefetch(uint64_t pos, size_t n) const override;
+  ~RangeReadAdapter();
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+} // namespace serialize
+} // namespace caffe2
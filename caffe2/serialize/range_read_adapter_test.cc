@@ -0,0 +1,97 @@
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "caffe2/serialize/inline_container.h"
+#include "caffe2/serialize/range_read_adapter.h"
+
+namespace caffe2 {
+namespace serialize {
+namespace {
+
+std::string writeArchive(int num_records, size_t record_size) {
+  std::ostringstream oss;
+  PyTorchStreamWriter writer([&](const void* b, size_t n) -> size_t {
+    oss.write(static_cast<const char*>(b), n);
+    return oss ? n : 0;
+  });
+  std::vector<char> data(record_size);
+  for (int i = 0; i < num_records; ++i) {
+    std::fill(data.begin(), data.end(), static_cast<char>(i));
+    writer.writeRecord("key" + c10::to_string(i), data.data(), data.size());
+  }
+  writer.writeEndOfFile();
+  return oss.str();
+}
+
+TEST(RangeReadAdapter, ReadRecords) {
+  const std::string archive = writeArchive(10, 1000);
+  std::atomic<size_t> requests{0};
+  RangeReadAdapter::Options options;
+  options.chunk_size = 256;
+  options.max_cached_chunks = 8;
+  options.readahead_chunks = 2;
+  options.num_threads = 3;
+  auto adapter = std::make_shared<RangeReadAdapter>(
+      archive.size(),
+      [&](uint64_t pos, void* buf, size_t n) {
+        ++requests;
+        memcpy(buf, archive.data() + pos, n);
+        return n;
+      },
+      options);
+
+  PyTorchStreamReader reader(adapter);
+  std::vector<std::string> names;
+  for (int i = 0; i < 10; ++i) {
+    names.push_back("key" + c10::to_string(i));
+  }
+  reader.prefetchRecords(names);
+  for (int i = 0; i < 10; ++i) {
+    at::DataPtr data_ptr;
+    int64_t size;
+    std::tie(data_ptr, size) = reader.getRecord(names[i]);
+    ASSERT_EQ(size, 1000);
+    std::vector<char> expected(1000, static_cast<char>(i));
+    ASSERT_EQ(memcmp(data_ptr.get(), expected.data(), expected.size()), 0);
+  }
+  // the cache is smaller than the archive, but chunks aren't fetched for
+  // every small read of the headers
+  ASSERT_LT(requests.load(), 4 * archive.size() / options.chunk_size);
+
+  // reads past the end are cut short
+  std::vector<char> tail(100);
+  ASSERT_EQ(adapter->read(archive.size() - 10, tail.data(), tail.size()), 10);
+  ASSERT_EQ(memcmp(tail.data(), archive.data() + archive.size() - 10, 10), 0);
+}
+
+TEST(RangeReadAdapter, RequestError) {
+  const std::string archive = writeArchive(2, 100);
+  bool fail = true;
+  RangeReadAdapter::Options options;
+  options.chunk_size = 64;
+  options.num_threads = 0;
+  RangeReadAdapter adapter(
+      archive.size(),
+      [&](uint64_t pos, void* buf, size_t n) -> size_t {
+        if (fail) {
+          return 0;
+        }
+        memcpy(buf, archive.data() + pos, n);
+        return n;
+      },
+      options);
+  std::vector<char> buf(100);
+  ASSERT_ANY_THROW(adapter.read(0, buf.data(), buf.size()));
+  // the failed chunks are requested again
+  fail = false;
+  ASSERT_EQ(adapter.read(0, buf.data(), buf.size()), buf.size());
+  ASSERT_EQ(memcmp(buf.data(), archive.data(), buf.size()), 0);
+}
+
+} // namespace
+} // namespace serialize
+} // namespace caffe2
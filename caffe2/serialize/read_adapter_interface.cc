@@ -3,6 +3,12 @@
 namespace caffe2 {
 namespace serialize {
 
+at::DataPtr ReadAdapterInterface::getDataPtr(uint64_t pos, size_t n) const {
+  return {};
+}
+
+void ReadAdapterInterface::prefetch(uint64_t pos, size_t n) const {}
+
 ReadAdapterInterface::~ReadAdapterInterface() {}
 
 } // namespace serialize
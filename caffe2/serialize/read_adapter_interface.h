@@ -3,6 +3,7 @@
 #include <cstddef>
 #include <cstdint>
 
+#include "c10/core/Allocator.h"
 #include "c10/macros/Macros.h"
 
 namespace caffe2 {
@@ -16,6 +17,14 @@ class TORCH_API ReadAdapterInterface {
   virtual size_t size() const = 0;
   virtual size_t read(uint64_t pos, void* buf, size_t n, const char* what = "")
       const = 0;
+  // Returns a DataPtr that points straight at bytes [pos, pos + n) and keeps
+  // them alive, or an empty DataPtr if the adapter can't share its memory
+  // (the default). PyTorchStreamReader uses it to avoid copying records.
+  virtual at::DataPtr getDataPtr(uint64_t pos, size_t n) const;
+  // Hints that bytes [pos, pos + n) will be read soon, so that adapters with
+  // slow reads (e.g. RangeReadAdapter) can start fetching them in the
+  // background. No-op by default.
+  virtual void prefetch(uint64_t pos, size_t n) const;
   virtual ~ReadAdapterInterface();
 };
 
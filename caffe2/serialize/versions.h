@@ -6,7 +6,7 @@ namespace caffe2 {
 namespace serialize {
 
 constexpr uint64_t kMinSupportedFileFormatVersion = 0x1L;
-constexpr uint64_t kMaxSupportedFileFormatVersion = 0x6L;
+constexpr uint64_t kMaxSupportedFileFormatVersion = 0x7L;
 
 // Versions (i.e. why was the version number bumped?)
 
@@ -47,8 +47,19 @@ constexpr uint64_t kMaxSupportedFileFormatVersion = 0x6L;
 // 5. (Dynamic) Stops torch.full inferring a floating point dtype
 //      when given bool or integer fill values.
 // 6. Write version string to `./data/version` instead of `version`.
+// 7. (Dynamic) Large int, float and bool lists in the data pickle are
+//      written as a single byte string (see Pickler::pushPackedList)
+//
+// Records compressed by PyTorchStreamWriter::enableCompression are regular
+// deflated zip entries, which every version can read, so they don't bump the
+// version: the chunk sizes that let newer readers inflate them in parallel
+// are in an extra field that older readers skip.
 constexpr uint64_t kProducedFileFormatVersion = 0x3L;
 
+// The version written by torch.jit.save when the data pickle contains
+// packed lists
+constexpr uint64_t kMinVersionForPackedLists = 0x7L;
+
 // The version we write when the archive contains bytecode.
 // It must be higher or eq to kProducedFileFormatVersion.
 // Because torchscript changes is likely introduce bytecode change.
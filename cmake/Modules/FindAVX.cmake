@@ -25,6 +25,23 @@ SET(AVX2_CODE "
   }
 ")
 
+SET(AVX512_CODE "
+  #include <immintrin.h>
+
+  int main()
+  {
+    __m512i a = _mm512_set1_epi16(0);
+    a = _mm512_abs_epi16(a); // AVX512BW
+    __m512 b = _mm512_set1_ps(0);
+    __mmask16 m = _mm512_cmp_ps_mask(b, b, _CMP_EQ_OQ);
+    b = _mm512_mask_blend_ps(m, b, b);
+    __m256 c = _mm512_extractf32x8_ps(b, 1); // AVX512DQ
+    __m256i d = _mm256_maskz_mov_epi32(0xFF, _mm256_castps_si256(c)); // AVX512VL
+    (void)d;
+    return 0;
+  }
+")
+
 MACRO(CHECK_SSE lang type flags)
   SET(__FLAG_I 1)
   SET(CMAKE_REQUIRED_FLAGS_SAVE ${CMAKE_REQUIRED_FLAGS})
@@ -56,6 +73,8 @@ ENDMACRO()
 
 CHECK_SSE(C "AVX" " ;-mavx;/arch:AVX")
 CHECK_SSE(C "AVX2" " ;-mavx2 -mfma;/arch:AVX2")
+CHECK_SSE(C "AVX512" " ;-mavx512f -mavx512bw -mavx512vl -mavx512dq -mfma;/arch:AVX512")
 
 CHECK_SSE(CXX "AVX" " ;-mavx;/arch:AVX")
 CHECK_SSE(CXX "AVX2" " ;-mavx2 -mfma;/arch:AVX2")
+CHECK_SSE(CXX "AVX512" " ;-mavx512f -mavx512bw -mavx512vl -mavx512dq -mfma;/arch:AVX512")
@@ -167,7 +167,12 @@
 #     possible values:
 #       OMP - use OpenMP for intra-op and native backend for inter-op tasks
 #       NATIVE - use native thread pool for both intra- and inter-op tasks
+#       NATIVE_WORK_STEALING - same as NATIVE, but the intra-op pool uses
+#         per-worker lock-free queues with work stealing (can also be chosen
+#         at run time with ATEN_INTRAOP_POOL=work_stealing)
 #       TBB - using TBB for intra- and native thread pool for inter-op parallelism
+#     the inter-op pool uses work stealing regardless, unless
+#     ATEN_INTEROP_POOL=default is set at run time
 #
 #   USE_TBB
 #      enable TBB support
@@ -239,6 +239,22 @@ TEST(CustomAutogradTest, CustomFunction) {
   ASSERT_VARIABLE_EQ(y.grad(), x + torch::ones({5,5})*2);
 }
 
+TEST(AutogradAPITests, NodePoolReusesFreedNodes) {
+  Variable x = torch::randn({2}, torch::requires_grad());
+  Node* first = nullptr;
+  {
+    Variable y = x * 2;
+    first = y.grad_fn().get();
+  }
+  // The graph is freed with y, and the next node of the same type on this
+  // thread gets its memory back from the pool
+  ASSERT_GT(node_pool::cached_blocks(), 0);
+  Variable y = x * 2;
+  ASSERT_EQ(y.grad_fn().get(), first);
+  y.sum().backward();
+  ASSERT_VARIABLE_EQ(x.grad(), torch::full({2}, 2.));
+}
+
 TEST(CustomAutogradTest, FunctionReturnsInput) {
   struct MyFunction : public Function<MyFunction> {
     static Variable forward(AutogradContext *ctx, Variable var1) {
@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <fstream>
 #include <future>
 #include <iostream>
 #include <iterator>
@@ -485,6 +486,45 @@ TEST(DataTest, StackTransformWorksForTensorExample) {
   ASSERT_TRUE(second.data.allclose(torch::eye(4).slice(/*dim=*/0, 2, 4)));
 }
 
+TEST(DataTest, StackTransformWritesIntoPreallocatedBatches) {
+  struct D : public datasets::Dataset<D> {
+    Example<> get(size_t index) override {
+      ++get_calls;
+      return {tensor[index], 1 + tensor[index]};
+    }
+
+    bool get_batch_into(Example<>& out, ArrayRef<size_t> indices) override {
+      for (size_t i = 0; i < indices.size(); ++i) {
+        out.data[i].copy_(tensor[indices[i]]);
+        out.target[i].copy_(1 + tensor[indices[i]]);
+      }
+      return true;
+    }
+
+    torch::optional<size_t> size() const override {
+      return tensor.size(0);
+    }
+
+    torch::Tensor tensor{torch::eye(4)};
+    size_t get_calls = 0;
+  };
+
+  auto d = D().map(transforms::Stack<Example<>>());
+
+  // The first batch reveals the layout of the examples...
+  Example<> batch = d.get_batch({0, 1});
+  ASSERT_EQ(d.dataset().get_calls, 2);
+  ASSERT_TRUE(batch.data.allclose(torch::eye(4).slice(/*dim=*/0, 0, 2)));
+
+  // ...so that the next ones are written straight into the batch tensors.
+  Example<> second = d.get_batch({3, 2, 1});
+  ASSERT_EQ(d.dataset().get_calls, 2);
+  ASSERT_TRUE(second.data.allclose(torch::eye(4).index_select(
+      /*dim=*/0, torch::tensor({3, 2, 1}))));
+  ASSERT_TRUE(second.target.allclose(1 + torch::eye(4).index_select(
+      /*dim=*/0, torch::tensor({3, 2, 1}))));
+}
+
 // Template classes cannot be nested in functions.
 template <typename Target>
 struct T : transforms::TensorTransform<Target> {
@@ -1429,6 +1469,47 @@ TEST(DataLoaderTest, Reset) {
   ASSERT_EQ(++iterator, end);
 }
 
+TEST(DataLoaderTest, PinsMemory_CUDA) {
+  auto dataset = datasets::TensorDataset(torch::arange(12).view({6, 2}))
+                     .map(transforms::Stack<TensorExample>());
+  for (size_t workers : {0, 2}) {
+    auto data_loader = torch::data::make_data_loader<samplers::SequentialSampler>(
+        dataset, DataLoaderOptions(2).workers(workers).pin_memory(true));
+    size_t batches = 0;
+    for (auto& batch : *data_loader) {
+      ASSERT_TRUE(batch.data.is_pinned());
+      ++batches;
+    }
+    ASSERT_EQ(batches, 3);
+  }
+}
+
+TEST(DataLoaderTest, TransfersBatchesToDevice_CUDA) {
+  const auto data = torch::arange(40).view({20, 2});
+  auto dataset = datasets::TensorDataset(data).map(
+      transforms::Stack<TensorExample>());
+  for (size_t prefetch_factor : {0, 2, 10}) {
+    auto data_loader = torch::data::make_data_loader<samplers::SequentialSampler>(
+        dataset,
+        DataLoaderOptions(4)
+            .workers(2)
+            .pin_memory(true)
+            .device(torch::kCUDA)
+            .prefetch_factor(prefetch_factor));
+    // A second pass starts from a clean pipeline.
+    for (size_t pass = 0; pass < 2; ++pass) {
+      int64_t offset = 0;
+      for (auto& batch : *data_loader) {
+        ASSERT_TRUE(batch.data.is_cuda());
+        ASSERT_TRUE(torch::equal(
+            batch.data.cpu(), data.slice(/*dim=*/0, offset, offset + 4)));
+        offset += 4;
+      }
+      ASSERT_EQ(offset, 20);
+    }
+  }
+}
+
 TEST(DataLoaderTest, TestExceptionsArePropagatedFromWorkers) {
   struct D : datasets::Dataset<DummyDataset, int> {
     int get(size_t index) override {
@@ -1690,6 +1771,50 @@ TEST(DataLoaderTest, ChunkDataSetGetBatch) {
   }
 }
 
+// Preloaders complete each other's partial batches, so that only the last
+// batch of an epoch can be smaller than the batch size.
+TEST(DataLoaderTest, ChunkDataSetOnlyLastBatchIsPartial) {
+  const size_t total_example_count = 35;
+  const size_t batch_size = 4;
+  DummyChunkDataReader data_reader;
+  samplers::SequentialSampler sampler(0);
+
+  for (size_t preloader_count : {1, 3}) {
+    datasets::SharedBatchDataset<datasets::ChunkDataset<
+        DummyChunkDataReader,
+        samplers::SequentialSampler,
+        samplers::SequentialSampler>>
+        dataset = datasets::make_shared_dataset<datasets::ChunkDataset<
+            DummyChunkDataReader,
+            samplers::SequentialSampler,
+            samplers::SequentialSampler>>(
+            data_reader,
+            sampler,
+            sampler,
+            datasets::ChunkDatasetOptions(preloader_count, batch_size));
+
+    auto data_loader = torch::data::make_data_loader(
+        dataset, DataLoaderOptions(batch_size).workers(0));
+
+    std::vector<size_t> batch_sizes;
+    std::vector<int> examples;
+    for (auto& batch : *data_loader) {
+      batch_sizes.push_back(batch.size());
+      examples.insert(examples.end(), batch.begin(), batch.end());
+    }
+
+    std::vector<size_t> expected_batch_sizes(
+        total_example_count / batch_size, batch_size);
+    expected_batch_sizes.push_back(total_example_count % batch_size);
+    ASSERT_EQ(batch_sizes, expected_batch_sizes);
+
+    std::sort(examples.begin(), examples.end());
+    std::vector<int> expected_examples(total_example_count);
+    std::iota(expected_examples.begin(), expected_examples.end(), 0);
+    ASSERT_EQ(examples, expected_examples);
+  }
+}
+
 TEST(DataLoaderTest, ChunkDataSetWithBatchSizeMismatch) {
   const size_t prefetch_count = 1;
   const size_t batch_size = 5;
@@ -2302,4 +2427,63 @@ TEST(DataLoaderTest, CustomPreprocessPolicy) {
       }
     }
   }
-}
\ No newline at end of file
+}
+#ifndef _WIN32
+TEST(DataTest, RecordDatasetReadsShardsInOrder) {
+  auto first = c10::make_tempfile();
+  auto empty = c10::make_tempfile();
+  auto second = c10::make_tempfile();
+  {
+    datasets::RecordFileWriter writer(first.name);
+    writer.write(torch::arange(3, torch::kUInt8));
+    writer.write(torch::arange(5, torch::kUInt8));
+  }
+  datasets::RecordFileWriter(empty.name).finish();
+  {
+    datasets::RecordFileWriter writer(second.name);
+    const std::string text = "record";
+    writer.write(text.data(), text.size());
+    writer.finish();
+  }
+
+  datasets::RecordDataset dataset({first.name, empty.name, second.name});
+  ASSERT_EQ(dataset.size().value(), 3);
+  ASSERT_TRUE(dataset.get(0).data.equal(torch::arange(3, torch::kUInt8)));
+  ASSERT_TRUE(dataset.get(1).data.equal(torch::arange(5, torch::kUInt8)));
+  const auto record = dataset.get(2).data;
+  ASSERT_EQ(
+      std::string(
+          static_cast<const char*>(record.data_ptr()), record.numel()),
+      "record");
+  ASSERT_THROWS_WITH(dataset.get(3), "out of range");
+
+  auto data_loader = torch::data::make_data_loader(
+      datasets::make_shared_dataset<datasets::ChunkDataset<
+          datasets::RecordChunkReader,
+          samplers::SequentialSampler,
+          samplers::SequentialSampler>>(
+          datasets::RecordChunkReader({first.name, empty.name, second.name}),
+          samplers::SequentialSampler(0),
+          samplers::SequentialSampler(0),
+          datasets::ChunkDatasetOptions(
+              /*preloader_count=*/1, /*batch_size=*/3)),
+      DataLoaderOptions(3).workers(0));
+  std::vector<int64_t> sizes;
+  for (auto& batch : *data_loader) {
+    for (auto& tensor : batch) {
+      sizes.push_back(tensor.numel());
+    }
+  }
+  ASSERT_EQ(sizes, std::vector<int64_t>({3, 5, 6}));
+}
+
+TEST(DataTest, RecordFileRejectsOtherFiles) {
+  auto tempfile = c10::make_tempfile();
+  {
+    std::ofstream stream(tempfile.name, std::ios::binary);
+    stream << "this is not a record file at all";
+  }
+  ASSERT_THROWS_WITH(
+      datasets::RecordFile(tempfile.name), "is not a record file");
+}
+#endif // _WIN32
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include <c10/core/InferenceMode.h>
+#include <torch/torch.h>
+
+#include <test/cpp/api/support.h>
+
+TEST(InferenceModeTest, TensorsCreatedInInferenceModeAreInferenceTensors) {
+  auto normal = torch::ones({2, 3});
+  ASSERT_FALSE(normal.is_inference());
+  {
+    c10::InferenceMode guard;
+    ASSERT_TRUE(c10::InferenceMode::is_enabled());
+    ASSERT_FALSE(torch::GradMode::is_enabled());
+    auto inference = torch::ones({2, 3});
+    ASSERT_TRUE(inference.is_inference());
+    // Functional ops on normal tensors create inference tensors too
+    ASSERT_TRUE(normal.mul(2).is_inference());
+    ASSERT_TRUE(normal.view({-1}).is_inference());
+    // and inplace updates of inference tensors are allowed
+    inference.add_(1);
+    ASSERT_TRUE(inference.equal(torch::full({2, 3}, 2.)));
+  }
+  ASSERT_FALSE(c10::InferenceMode::is_enabled());
+  ASSERT_TRUE(torch::GradMode::is_enabled());
+}
+
+TEST(InferenceModeTest, RequiresGradInputsDontRecordGraph) {
+  auto x = torch::ones({2, 3}, torch::requires_grad());
+  c10::InferenceMode guard;
+  auto y = x * x;
+  ASSERT_FALSE(y.requires_grad());
+  ASSERT_FALSE(y.grad_fn());
+  ASSERT_TRUE(y.is_inference());
+}
+
+TEST(InferenceModeTest, InferenceTensorsOutsideInferenceMode) {
+  torch::Tensor inference;
+  {
+    c10::InferenceMode guard;
+    inference = torch::ones({2, 3});
+  }
+  // Functional ops create normal tensors
+  auto out = inference.mul(2);
+  ASSERT_FALSE(out.is_inference());
+  // Views are still inference tensors
+  ASSERT_TRUE(inference.view({-1}).is_inference());
+
+  ASSERT_THROWS_WITH(
+      inference.add_(1),
+      "Inplace update to inference tensor outside InferenceMode");
+  ASSERT_THROWS_WITH(
+      inference.requires_grad_(),
+      "Setting requires_grad=True on inference tensor outside InferenceMode");
+  ASSERT_THROWS_WITH(
+      inference._version(), "Inference tensors do not track version counter");
+
+  auto w = torch::ones({2, 3}, torch::requires_grad());
+  ASSERT_THROWS_WITH(
+      w.mul(inference), "Inference tensors cannot be saved for backward");
+  // A clone is a normal tensor
+  auto loss = w.mul(inference.clone()).sum();
+  loss.backward();
+  ASSERT_TRUE(w.grad().equal(torch::ones({2, 3})));
+}
+
+TEST(InferenceModeTest, NestedDisable) {
+  c10::InferenceMode guard;
+  {
+    c10::InferenceMode disable(false);
+    ASSERT_FALSE(c10::InferenceMode::is_enabled());
+    auto x = torch::ones({2, 3}, torch::requires_grad());
+    ASSERT_FALSE(x.is_inference());
+  }
+  ASSERT_TRUE(c10::InferenceMode::is_enabled());
+  ASSERT_TRUE(torch::ones({1}).is_inference());
+}
@@ -6382,6 +6382,64 @@ TEST(NVFuserTest, FusionSmemDynamicPersistentBatchNorm_CUDA) {
       at_norm_gamma_beta.sub(outputs[0]).abs().max());
 }
 
+TEST(NVFuserTest, FusionNormalizationScheduler_CUDA) {
+  // Short rows are cached in shared memory, long rows are read from global
+  // memory by both reduction passes.
+  std::vector<std::pair<int, bool>> shapes = {{1024, true}, {32768, false}};
+
+  for (const auto& shape : shapes) {
+    const int dimx = 64;
+    const int dimy = shape.first;
+    const float kEps = 1e-5;
+
+    Fusion fusion;
+    FusionGuard fg(&fusion);
+
+    auto x = makeDummyTensor(2);
+    auto residual = makeDummyTensor(2);
+    fusion.addInput(x);
+    fusion.addInput(residual);
+
+    Val* N = x->getRootDomain()[1]->extent();
+    auto x_sum = sum(x, {-1}); // (M, R)
+    auto x_sum_bcast = broadcast(x_sum, {false, true}); // (M, B)
+    auto x_mean = div(x_sum_bcast, N); // (M, B)
+    auto x_mean_sub = sub(x, x_mean); // (M, N)
+    auto x_mean_sub_pow = mul(x_mean_sub, x_mean_sub); // (M, N)
+    auto var_sum = sum(x_mean_sub_pow, {-1}); // (M, R)
+    auto var_sum_bcast = broadcast(var_sum, {false, true}); // (M, B)
+    auto var = div(var_sum_bcast, N); // (M, B)
+    auto var_eps = add(var, new Float(kEps)); // (M, B)
+    auto rvar = unaryOp(UnaryOpType::Rsqrt, var_eps); // (M, B)
+    auto norm = mul(sub(x, x_mean), rvar); // (M, N)
+    auto out = add(norm, residual); // (M, N)
+    fusion.addOutput(out);
+
+    TORCH_CHECK(isNormalizationFusion(&fusion));
+
+    auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+    at::Tensor t0 = at::randn({dimx, dimy}, options);
+    at::Tensor t1 = at::randn({dimx, dimy}, options);
+
+    std::vector<TensorView*> reduction_tvs({x_sum, var_sum});
+    auto reduction_params =
+        getNormalizationHeuristics(&fusion, {t0, t1}, reduction_tvs);
+    TORCH_CHECK(reduction_params, "Normalization schedule was not generated!");
+    TORCH_CHECK(reduction_params.value().persistent_kernel == shape.second);
+    scheduleNormalization(&fusion, reduction_params.value(), reduction_tvs);
+
+    FusionExecutor fe;
+    fe.compileFusion(&fusion);
+    auto outputs = fe.runFusion({t0, t1}, reduction_params.value().lparams);
+
+    auto at_out = at::add(at::layer_norm(t0, {dimy}, {}, {}, kEps), t1);
+    TORCH_CHECK(
+        at_out.allclose(outputs[0], 1e-3, 1e-3),
+        "Error of: ",
+        at_out.sub(outputs[0]).abs().max());
+  }
+}
+
 TEST(NVFuserTest, FusionSmemDynamicReductionSymbolic_CUDA) {
   Fusion fusion;
   FusionGuard fg(&fusion);
@@ -7532,6 +7590,41 @@ TEST(NVFuserTest, FusionInputsIdLookup_CUDA) {
   auto id_1_relook = inputs_id_lookup.lookupId({t0, t1});
   TORCH_CHECK(id_1_relook.id == id_1.id);
   TORCH_CHECK(id_1_relook.eviction == false);
+
+  // same sizes with different strides or dtype are different input sets
+  auto id_3 = inputs_id_lookup.lookupId({t0.transpose(1, 2), t1});
+  TORCH_CHECK(id_3.id != id_1.id);
+  auto id_4 = inputs_id_lookup.lookupId({t0.to(at::kHalf), t1});
+  TORCH_CHECK(id_4.id != id_1.id && id_4.id != id_3.id);
+}
+
+TEST(NVFuserTest, FusionExecutorRebindArguments_CUDA) {
+  Fusion fusion;
+  FusionGuard fg(&fusion);
+
+  TensorView* tv0 = makeContigTensor(1);
+  fusion.addInput(tv0);
+  Float* f0 = new Float();
+  fusion.addInput(f0);
+
+  TensorView* tv1 = mul(tv0, f0);
+  fusion.addOutput(tv1);
+
+  tv1->split(0, 128);
+  tv1->axis(0)->parallelize(ParallelType::BIDx);
+  tv1->axis(1)->parallelize(ParallelType::TIDx);
+
+  FusionExecutor fe;
+  fe.compileFusion(&fusion);
+
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCUDA, 0);
+  // the second run rebinds the arguments recorded by the first one, with
+  // other tensors and scalars
+  for (double scale : {2.0, 3.0}) {
+    at::Tensor input = at::randn({1000}, options);
+    auto outputs = fe.runFusion({input, scale}, LaunchParams(), 1);
+    TORCH_CHECK(outputs[0].allclose(input * scale));
+  }
 }
 
 TEST(NVFuserTest, FusionGroupGuardSimpleTensor_CUDA) {
@@ -67,5 +67,43 @@ TEST(GraphExecutorTest, runAsync_executor) {
   ASSERT_TRUE(asyncCounter > 0);
 }
 
+TEST(GraphExecutorTest, MemoryPlan) {
+  // MKLDNN allocations can't be planned
+  const bool mkldnn_enabled = at::globalContext().userEnabledMkldnn();
+  at::globalContext().setUserEnabledMkldnn(false);
+
+  MemoryPlan memory_plan;
+  const void* intermediate_ptr = nullptr;
+  at::Tensor output;
+  auto run = [&](const at::Tensor& input) {
+    memory_plan.run([&] {
+      auto intermediate = input * 2;
+      intermediate_ptr = intermediate.data_ptr();
+      output = intermediate + 1;
+    });
+  };
+
+  auto a = at::rand({16, 16});
+  // Profiles, then validates the plan
+  run(a);
+  EXPECT_FALSE(memory_plan.active());
+  run(a);
+  EXPECT_TRUE(memory_plan.active());
+
+  run(a);
+  const void* planned_ptr = intermediate_ptr;
+  run(a);
+  EXPECT_EQ(intermediate_ptr, planned_ptr);
+  ASSERT_TRUE(output.equal(a * 2 + 1));
+
+  // Falls back to the regular allocator for other shapes and plans again
+  auto b = at::rand({8, 8});
+  run(b);
+  ASSERT_TRUE(output.equal(b * 2 + 1));
+  EXPECT_FALSE(memory_plan.active());
+
+  at::globalContext().setUserEnabledMkldnn(mkldnn_enabled);
+}
+
 } // namespace jit
 } // namespace torch
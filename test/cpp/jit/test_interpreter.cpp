@@ -2,6 +2,7 @@
 
 #include <ATen/Parallel.h>
 #include "test/cpp/jit/test_utils.h"
+#include "torch/csrc/jit/runtime/instruction.h"
 #include "torch/jit.h"
 #include "torch/script.h"
 #include "torch/torch.h"
@@ -178,5 +179,40 @@ TEST(InterpreterTest, runAsyncBasicTest) {
   interp.runAsync(stack)->wait();
   ASSERT_TRUE(asyncCounter > 0);
 }
+
+TEST(InterpreterTest, Superinstructions) {
+  auto graph = jit::compile(R"JIT(
+  def fn(x: int, n: int):
+      total = 0
+      for i in range(n):
+          if i % 2 == 0:
+              total = total + x * i
+          else:
+              total = total - i
+      return total
+  )JIT")
+                   ->get_function("fn")
+                   .graph();
+
+  Code fused(graph, "");
+  Code unfused(graph, "", 0, /*emit_superinstructions=*/false);
+  ASSERT_LT(fused.instructions().size(), unfused.instructions().size());
+  for (const Instruction& inst : unfused.instructions()) {
+    ASSERT_NE(inst.op, LOADS);
+    ASSERT_NE(inst.op, OP_STORE);
+    ASSERT_NE(inst.op, OP_JF);
+  }
+
+  int64_t expected = 0;
+  for (int64_t i = 0; i < 11; ++i) {
+    expected += i % 2 == 0 ? 3 * i : -i;
+  }
+  for (Code* code : {&fused, &unfused}) {
+    InterpreterState interp(*code);
+    Stack stack({3, 11});
+    interp.run(stack);
+    ASSERT_EQ(stack.back().toInt(), expected);
+  }
+}
 } // namespace jit
 } // namespace torch
@@ -42,6 +42,65 @@ TEST(LiteInterpreterTest, UpsampleNearest2d) {
   ASSERT_TRUE(resd.equal(refd));
 }
 
+TEST(LiteInterpreterTest, UnboxedOperators) {
+  Module m("m");
+  m.define(R"(
+    def forward(self, x: Tensor, y: Tensor):
+      z = torch.add(x, y, alpha=2) * y
+      return torch.relu(torch.matmul(z, y)) + torch.sigmoid(z).tanh()
+  )");
+
+  std::vector<IValue> inputs;
+  inputs.emplace_back(torch::rand({4, 4}));
+  inputs.emplace_back(torch::rand({4, 4}));
+  auto ref = m.forward(inputs);
+
+  std::stringstream ss;
+  m._save_for_mobile(ss);
+  // load twice, the second load reuses the operators resolved by the first
+  for (int i = 0; i < 2; ++i) {
+    ss.seekg(0);
+    mobile::Module bc = _load_for_mobile(ss);
+    auto res = bc.forward(inputs);
+    ASSERT_TRUE(res.toTensor().equal(ref.toTensor()));
+  }
+}
+
+TEST(LiteInterpreterTest, MemoryPlanning) {
+  Module m("m");
+  m.define(R"(
+    def forward(self, x: Tensor):
+      y = torch.relu(x * 2)
+      return y + x.sigmoid()
+  )");
+
+  std::vector<IValue> inputs;
+  inputs.emplace_back(torch::rand({8, 8}));
+  auto ref = m.forward(inputs).toTensor();
+
+  std::stringstream ss;
+  m._save_for_mobile(ss);
+  mobile::Module bc = _load_for_mobile(ss);
+  bc.get_method("forward").function().enable_memory_planning();
+  // profile, validate, then run with the plan
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(bc.forward(inputs).toTensor().equal(ref));
+  }
+  auto plans = bc._allocation_plans();
+  ASSERT_FALSE(plans.empty());
+
+  // a model saved with its plans starts from them
+  ExtraFilesMap extra_files;
+  extra_files["mobile_allocation_plans"] = plans;
+  std::stringstream ss_with_plans;
+  m._save_for_mobile(ss_with_plans, extra_files);
+  mobile::Module bc_with_plans = _load_for_mobile(ss_with_plans);
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(bc_with_plans.forward(inputs).toTensor().equal(ref));
+  }
+  ASSERT_EQ(bc_with_plans._allocation_plans(), plans);
+}
+
 TEST(LiteInterpreterTest, CheckAttrAccess) {
   Module m("m");
   m.register_attribute("mobile_optimized", BoolType::get(), true);
@@ -885,6 +944,70 @@ TEST(LiteInterpreterTest, ExtraFiles) {
   ASSERT_EQ(loaded_extra_files["mobile_info.json"], "{\"key\": 23}");
 }
 
+TEST(LiteInterpreterTest, FlatBytecode) {
+  Module m("m");
+  m.register_parameter("foo", torch::ones({2}), false);
+  m.define(R"(
+    def add_all(self, x: Tensor, ys: List[int] = [1, 2], s: str = "a") -> Tuple[Tensor, str]:
+      for y in ys:
+        x = x + y * self.foo
+      return x, s + "b"
+
+    def forward(self, x: Tensor, scale: Optional[float] = None):
+      if scale is not None:
+        x = x * scale
+      return self.add_all(x)
+  )");
+
+  std::vector<IValue> inputs{torch::rand({2}), 2.0};
+  auto ref = m.forward(inputs).toTuple()->elements();
+
+  std::stringstream ss;
+  m._save_for_mobile(ss);
+  std::string with_flat = ss.str();
+  std::istringstream iss(with_flat);
+  caffe2::serialize::PyTorchStreamReader reader(&iss);
+  ASSERT_TRUE(reader.hasRecord("bytecode.flat"));
+
+  // the same file without bytecode.flat is loaded from bytecode.pkl
+  std::ostringstream without_flat;
+  {
+    caffe2::serialize::PyTorchStreamWriter writer(
+        [&](const void* buf, size_t nbytes) -> size_t {
+          without_flat.write(static_cast<const char*>(buf), nbytes);
+          return !without_flat ? 0 : nbytes;
+        });
+    for (const auto& name : reader.getAllRecords()) {
+      if (name == "bytecode.flat" || name == "version") {
+        continue;
+      }
+      at::DataPtr data;
+      size_t size = 0;
+      std::tie(data, size) = reader.getRecord(name);
+      writer.writeRecord(name, data.get(), size);
+    }
+    writer.writeEndOfFile();
+  }
+
+  for (const auto& file : {with_flat, without_flat.str()}) {
+    std::istringstream in(file);
+    mobile::Module bc = _load_for_mobile(in);
+    auto res = bc.forward(inputs).toTuple()->elements();
+    ASSERT_TRUE(res[0].toTensor().equal(ref[0].toTensor()));
+    ASSERT_EQ(res[1].toStringRef(), "ab");
+
+    const auto& schema =
+        bc.get_method("add_all").function().getSchema().value();
+    ASSERT_EQ(schema.arguments().size(), 4);
+    ASSERT_EQ(schema.arguments()[2].type()->annotation_str(), "List[int]");
+    ASSERT_EQ(
+        schema.arguments()[2].default_value()->toIntVector(),
+        std::vector<int64_t>({1, 2}));
+    ASSERT_EQ(
+        schema.returns()[0].type()->annotation_str(), "Tuple[Tensor, str]");
+  }
+}
+
 TEST(LiteInterpreterTest, OpNameExportFetchRootOperators) {
   torch::jit::Module m("m");
   m.register_parameter("weight", torch::ones({20, 1, 5, 5}), false);
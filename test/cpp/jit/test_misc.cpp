@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <ATen/ATen.h>
+#include <ATen/OperatorStatsObserver.h>
 #include <ATen/Parallel.h>
 #include <ATen/core/interned_strings.h>
 #include <ATen/core/ivalue.h>
@@ -62,9 +63,11 @@
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <numeric>
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <unordered_set>
 #include <utility>
@@ -137,6 +140,35 @@ TEST(FromQualStringTest, Basic) {
   }
 }
 
+TEST(InternedStringsTest, ConcurrentInterning) {
+  // Every thread interns the same new symbols, in a different order, while
+  // the others look up the ones interned so far.
+  constexpr int num_threads = 8;
+  constexpr int num_symbols = 1000;
+  std::vector<std::vector<Symbol>> results(
+      num_threads, std::vector<Symbol>(num_symbols));
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&results, t] {
+      for (int i = 0; i < num_symbols; i++) {
+        const int k = (i * 7 + t * 131) % num_symbols;
+        const std::string ns = "concurrent_ns" + std::to_string(k % 5);
+        const std::string name = ns + "::s" + std::to_string(k);
+        auto sym = Symbol::fromQualString(name);
+        EXPECT_EQ(sym.toQualString(), name);
+        EXPECT_EQ(sym.ns().toUnqualString(), ns);
+        results[t][k] = sym;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (int t = 1; t < num_threads; t++) {
+    ASSERT_EQ(results[t], results[0]);
+  }
+}
+
 TEST(THNNConvTest, Basic) {
   std::vector<int64_t> input_size = {4, 3, 15, 17}; // B x C x H x W
   std::vector<int64_t> kernel_size = {3, 5};
@@ -492,6 +524,42 @@ TEST(ControlFlowTest, Basic) {
   ASSERT_EQ(256, run_binary("while_test", 2, 0));
 }
 
+TEST(ShapeAnalysisTest, ChannelsLast) {
+  auto graph = std::make_shared<Graph>();
+  parseIR(
+      R"IR(
+graph(%x : Tensor):
+  %kernel : int[] = prim::Constant[value=[2, 2]]()
+  %pad : int[] = prim::Constant[value=[0, 0]]()
+  %dilation : int[] = prim::Constant[value=[1, 1]]()
+  %ceil : bool = prim::Constant[value=0]()
+  %r : Tensor = aten::relu(%x)
+  %p : Tensor = aten::max_pool2d(%r, %kernel, %kernel, %pad, %dilation, %ceil)
+  %s : Tensor = aten::sum(%p)
+  return (%p, %s))IR",
+      &*graph);
+  auto x = at::randn({2, 3, 4, 4}).contiguous(at::MemoryFormat::ChannelsLast);
+  graph->inputs()[0]->setType(TensorType::create(x));
+  PropagateInputShapes(graph);
+
+  // The sizes of the outputs are unknown, but their stride order is the one
+  // of x, i.e. channels last
+  const auto& x_strides = TensorType::create(x)->stride_properties();
+  for (auto node : graph->nodes()) {
+    if (node->kind() != aten::relu && node->kind() != aten::max_pool2d) {
+      continue;
+    }
+    auto type = node->output()->type()->expect<TensorType>();
+    ASSERT_EQ(*type->dim(), 4);
+    ASSERT_FALSE(type->sizes().concrete_sizes());
+    for (size_t i = 0; i < 4; i++) {
+      ASSERT_EQ(
+          type->stride_properties()[i]->stride_index_,
+          x_strides[i]->stride_index_);
+    }
+  }
+}
+
 TEST(ProtoTest, Basic) {
   ::ONNX_NAMESPACE::ModelProto proto;
   proto.set_producer_name("foo");
@@ -924,6 +992,48 @@ TEST(RecordFunctionTest, SampledCallbacks) {
   clearCallbacks();
 }
 
+TEST(RecordFunctionTest, OperatorStatsObserver) {
+  enableOperatorStatsObserver(/* sampling_prob */ 1.0, /* record_shapes */ true);
+  ASSERT_TRUE(isOperatorStatsObserverEnabled());
+  getOperatorStats(/* reset */ true);
+
+  auto t = torch::randn({1, 2, 3}, at::kCPU);
+  for (auto k = 0; k < 100; k++) {
+    invokeTestRecordFunction(t);
+  }
+  std::thread thread([&]() {
+    for (auto k = 0; k < 50; k++) {
+      invokeTestRecordFunction(t);
+    }
+  });
+  thread.join();
+  disableOperatorStatsObserver();
+
+  auto stats = getOperatorStats(/* reset */ true);
+  auto it = std::find_if(stats.begin(), stats.end(), [](const OperatorStats& s) {
+    return s.name == "test";
+  });
+  ASSERT_TRUE(it != stats.end());
+  // includes the calls of the thread that exited
+  ASSERT_EQ(it->sampled_calls, 150);
+  ASSERT_EQ(it->estimated_calls, 150);
+  ASSERT_EQ(
+      std::accumulate(
+          it->latency_histogram.begin(), it->latency_histogram.end(), 0),
+      150);
+  // every call has one 6 element input
+  ASSERT_EQ(it->shape_histogram[3], 150);
+
+  // pow is dispatched inside of "test"
+  ASSERT_TRUE(
+      std::any_of(stats.begin(), stats.end(), [](const OperatorStats& s) {
+        return s.name == "aten::pow";
+      }));
+
+  invokeTestRecordFunction(t);
+  ASSERT_TRUE(getOperatorStats().empty());
+}
+
 TEST(RecordFunctionTest, RecordFunctionGuard) {
   // disabling the inlining of method calls
   GraphOptimizerEnabledGuard opt_guard(false);
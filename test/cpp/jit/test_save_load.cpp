@@ -6,8 +6,10 @@
 #include <torch/csrc/jit/serialization/export.h>
 #include <torch/csrc/jit/serialization/import.h>
 #include <torch/csrc/jit/serialization/import_source.h>
+#include <torch/csrc/jit/serialization/pickle.h>
 #include <torch/torch.h>
 
+#include "caffe2/serialize/inline_container.h"
 #include "caffe2/serialize/istream_adapter.h"
 
 namespace torch {
@@ -120,6 +122,57 @@ TEST(SerializationTest, TypeTags) {
   }
 }
 
+TEST(SerializationTest, PackedLists) {
+  const int64_t n = Pickler::kMinPackedListSize;
+  c10::List<int64_t> ints;
+  c10::List<double> doubles;
+  c10::List<bool> bools;
+  for (int64_t i = 0; i < n; i++) {
+    ints.push_back(i * (int64_t(1) << 40) - 7);
+    doubles.push_back(i / 3.0);
+    bools.push_back(i % 3 == 0);
+  }
+  // too small to be packed
+  auto small_ints = c10::List<int64_t>({1, 2, 3});
+  auto tuple = c10::ivalue::Tuple::create({ints, doubles, bools, small_ints});
+
+  std::vector<char> data;
+  Pickler pickler([&](const char* buf, size_t size) {
+    data.insert(data.end(), buf, buf + size);
+  });
+  pickler.setPackPrimitiveLists(true);
+  pickler.protocol();
+  pickler.pushIValue(tuple);
+  pickler.stop();
+  ASSERT_TRUE(pickler.wrotePackedLists());
+  // one byte per bool and 8 bytes per int and float
+  ASSERT_LT(data.size(), 18 * n);
+
+  auto loaded = unpickle(data.data(), data.size()).toTuple()->elements();
+  ASSERT_EQ(loaded.size(), 4);
+  ASSERT_EQ(loaded[0].toIntVector(), ints.vec());
+  ASSERT_EQ(loaded[1].toDoubleVector(), doubles.vec());
+  ASSERT_EQ(loaded[2].toBoolList().vec(), bools.vec());
+  ASSERT_EQ(loaded[3].toIntVector(), small_ints.vec());
+}
+
+TEST(SerializationTest, PackedListsVersion) {
+  std::vector<int64_t> values(Pickler::kMinPackedListSize, 42);
+  Module m("m");
+  m.register_attribute(
+      "values", ListType::ofInts(), c10::List<int64_t>(values));
+  std::stringstream ss;
+  m.save(ss);
+
+  std::istringstream iss(ss.str());
+  caffe2::serialize::PyTorchStreamReader reader(&iss);
+  ASSERT_EQ(reader.version(), caffe2::serialize::kMinVersionForPackedLists);
+
+  ss.seekg(0);
+  auto loaded = torch::jit::load(ss);
+  ASSERT_EQ(loaded.attr("values").toIntVector(), values);
+}
+
 TEST(SerializationTest, TestJitStream_CUDA) {
   torch::jit::Module model;
   std::vector<torch::jit::IValue> inputs;
@@ -162,3 +162,35 @@ TEST(TensorpipeSerialize, NoDeleterTensors) {
           t2.storage().data(),
           sendingTpMessage.tensors[1].buffer.cpu.length) == 0);
 }
+
+TEST(TensorpipeSerialize, CpuBufferPool) {
+  using torch::distributed::rpc::TensorpipeCpuBufferPool;
+  constexpr size_t kBufferBytes = TensorpipeCpuBufferPool::kMinPooledBytes;
+  TensorpipeCpuBufferPool pool(/* maxCachedBytes */ 2 * kBufferBytes);
+
+  void* ptr;
+  {
+    c10::DataPtr buffer = pool.allocate(kBufferBytes);
+    ptr = buffer.get();
+    EXPECT_EQ(pool.cachedBytes(), 0);
+  }
+  // The freed buffer is cached and handed out again for the same size.
+  EXPECT_EQ(pool.cachedBytes(), kBufferBytes);
+  {
+    c10::DataPtr buffer = pool.allocate(kBufferBytes);
+    EXPECT_EQ(buffer.get(), ptr);
+    EXPECT_EQ(pool.cachedBytes(), 0);
+  }
+
+  // Buffers beyond the cache limit, or too small to be pooled, are freed.
+  {
+    c10::DataPtr buffer1 = pool.allocate(kBufferBytes);
+    c10::DataPtr buffer2 = pool.allocate(kBufferBytes);
+    c10::DataPtr buffer3 = pool.allocate(kBufferBytes);
+    c10::DataPtr small = pool.allocate(kBufferBytes - 1);
+  }
+  EXPECT_EQ(pool.cachedBytes(), 2 * kBufferBytes);
+
+  pool.emptyCache();
+  EXPECT_EQ(pool.cachedBytes(), 0);
+}
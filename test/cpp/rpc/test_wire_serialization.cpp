@@ -93,6 +93,47 @@ TEST(WireSerialize, Errors) {
       "failed bounds");
 }
 
+TEST(WireSerialize, BatchedRequests) {
+  using torch::distributed::rpc::Message;
+  using torch::distributed::rpc::MessageType;
+  std::vector<Message> requests;
+  requests.emplace_back(
+      std::vector<char>{'a', 'b', 'c'},
+      std::vector<at::Tensor>{torch::randn({2, 3})},
+      MessageType::SCRIPT_CALL,
+      7);
+  requests.emplace_back(
+      std::vector<char>{},
+      std::vector<at::Tensor>{},
+      MessageType::RREF_USER_DELETE,
+      8);
+  requests.emplace_back(
+      std::vector<char>{'d'},
+      std::vector<at::Tensor>{torch::randn({4}), torch::randn({1, 1})},
+      MessageType::PYTHON_CALL,
+      9);
+  std::vector<Message> expected = requests;
+
+  Message batch =
+      torch::distributed::rpc::createBatchedRequestsMessage(std::move(requests));
+  EXPECT_EQ(batch.type(), MessageType::BATCHED_REQUESTS);
+  EXPECT_EQ(batch.id(), 7);
+  EXPECT_EQ(batch.tensors().size(), 3);
+
+  auto split =
+      torch::distributed::rpc::splitBatchedRequestsMessage(std::move(batch));
+  ASSERT_EQ(split.size(), expected.size());
+  for (size_t i = 0; i < split.size(); ++i) {
+    EXPECT_EQ(split[i].type(), expected[i].type());
+    EXPECT_EQ(split[i].id(), expected[i].id());
+    EXPECT_EQ(split[i].payload(), expected[i].payload());
+    ASSERT_EQ(split[i].tensors().size(), expected[i].tensors().size());
+    for (size_t j = 0; j < split[i].tensors().size(); ++j) {
+      EXPECT_TRUE(torch::equal(split[i].tensors()[j], expected[i].tensors()[j]));
+    }
+  }
+}
+
 // Enable this once JIT Pickler supports sparse tensors.
 TEST(WireSerialize, DISABLED_Sparse) {
   at::Tensor main = at::empty({2, 3}, at::dtype<float>().layout(at::kSparse));
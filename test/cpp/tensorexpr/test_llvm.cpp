@@ -1441,6 +1441,42 @@ TEST(LLVM, DynamicShape2D) {
   testWithSize(37, 11);
 }
 
+TEST(LLVM, ParallelLoop) {
+  KernelScope kernel_scope;
+  auto testWithSize = [](int32_t M, int32_t N) {
+    VarHandle m("m", kInt);
+    VarHandle n("n", kInt);
+    Placeholder a(BufHandle("a", {m, n}, kFloat));
+    Placeholder b(BufHandle("b", {n}, kFloat));
+    Tensor* c = Compute(
+        "c", {{m, "m"}, {n, "n"}}, [&](const VarHandle& i, const VarHandle& j) {
+          return a.load(i, j) + b.load(j);
+        });
+    LoopNest l({c});
+    std::vector<For*> loops = l.getLoopStmtsFor(c);
+    loops[0]->set_parallel();
+    ASSERT_TRUE(loops[0]->loop_options().is_parallel());
+    l.prepareForCodegen();
+    l.vectorizeInnerLoops();
+    Stmt* s = l.root_stmt();
+    LLVMCodeGen cg(s, {a, b, c, m, n});
+    std::vector<float> aData(M * N);
+    std::iota(aData.begin(), aData.end(), 0);
+    std::vector<float> bData(N);
+    std::iota(bData.begin(), bData.end(), 0);
+    std::vector<float> cData(M * N, 0.0f);
+    cg.call({aData, bData, cData, M, N});
+    for (int i = 0; i < M; i++) {
+      for (int j = 0; j < N; j++) {
+        ASSERT_EQ(cData[i * N + j], aData[i * N + j] + bData[j]);
+      }
+    }
+  };
+  testWithSize(1, 8);
+  testWithSize(64, 37);
+  testWithSize(257, 128);
+}
+
 TEST(LLVM, EmptyStmt) {
   KernelScope kernel_scope;
   Stmt* s = new Block({});
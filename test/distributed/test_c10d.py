@@ -342,6 +342,19 @@ class TCPStoreTest(TestCase, StoreTestBase):
     def test_numkeys_delkeys(self):
         self._test_numkeys_delkeys(self._create_store())
 
+    def test_multi_get_multi_set(self):
+        store = self._create_store()
+        store.multi_set(["key0", "key1"], ["value0", "value1"])
+        self.assertEqual(b"value1", store.get("key1"))
+        store.set("key2", "value2")
+        self.assertEqual(
+            [b"value2", b"value0", b"value1"],
+            store.multi_get(["key2", "key0", "key1"]),
+        )
+        store.set_timeout(timedelta(seconds=2))
+        with self.assertRaises(RuntimeError):
+            store.multi_get(["key0", "bad_key"])
+
     def test_compare_set(self):
         store = self._create_store()
         missing_key_result = store.compare_set("key0", "wrong_old_value", "new_value0")
@@ -760,6 +773,31 @@ class ProcessGroupGlooTest(MultiProcessTestCase):
         for work in [pg.allreduce(torch.ones(i + 1)) for i in range(4)]:
             work.wait()
 
+    def test_pipelined_allreduce(self):
+        store = c10d.FileStore(self.file_name, self.world_size)
+        opts = self.opts()
+        opts.devices = [
+            create_device(interface=LOOPBACK),
+            create_device(interface=LOOPBACK),
+        ]
+        opts.pipelined_allreduce_min_bytes = 1024
+        opts.pipelined_allreduce_chunk_bytes = 96
+        pg = c10d.ProcessGroupGloo(store, self.rank, self.world_size, opts)
+
+        # 1000 float elements make 42 chunks of 24 elements, the last one
+        # partial, split over both devices.
+        tensor = torch.arange(1000, dtype=torch.float) + self.rank
+        pg.allreduce(tensor).wait()
+        expected = torch.arange(1000, dtype=torch.float) * self.world_size + sum(
+            range(self.world_size)
+        )
+        self.assertEqual(expected, tensor)
+
+        # Collectives after the pipelined allreduce still match up.
+        tensor = torch.ones(10)
+        pg.allreduce(tensor).wait()
+        self.assertEqual(torch.full([10], float(self.world_size)), tensor)
+
     def test_empty_tensors(self):
         store = c10d.FileStore(self.file_name, self.world_size)
         pg = c10d.ProcessGroupGloo(store, self.rank, self.world_size, self.opts())
@@ -1217,6 +1255,24 @@ class ProcessGroupGlooTest(MultiProcessTestCase):
     def test_scatter_basics_cuda(self):
         self._test_scatter_basics(lambda t: t.clone().cuda())
 
+    def test_reduce_scatter_uneven_basics(self):
+        store = c10d.FileStore(self.file_name, self.world_size)
+        pg = c10d.ProcessGroupGloo(store, self.rank, self.world_size, self.opts())
+
+        # The i'th input has i + 1 elements, so the output of every rank has a
+        # different size.
+        inputs = [
+            torch.full((i + 1,), float(self.rank + i)) for i in range(self.world_size)
+        ]
+        output = torch.empty(self.rank + 1)
+        pg.reduce_scatter([output], [inputs]).wait()
+
+        expected = sum(float(r + self.rank) for r in range(self.world_size))
+        self.assertEqual(torch.full((self.rank + 1,), expected), output)
+
+        with self.assertRaisesRegex(ValueError, "as many elements as the output"):
+            pg.reduce_scatter([torch.empty(self.rank + 2)], [inputs])
+
     def _test_scatter_stress(self, inputs, fn):
         store = c10d.FileStore(self.file_name, self.world_size)
         pg = c10d.ProcessGroupGloo(
@@ -1913,6 +1969,75 @@ class ProcessGroupNCCLTest(TestCase):
             ):
                 allreduce(tensors, op)
 
+    @requires_nccl()
+    def test_allreduce_hierarchical_option(self):
+        store = c10d.FileStore(self.file.name, self.world_size)
+        options = c10d.ProcessGroupNCCL.Options()
+        options.hierarchical_allreduce = True
+        pg = c10d.ProcessGroupNCCL(store, self.rank, self.world_size, options)
+
+        # A single node cannot benefit from hierarchical allreduce, so this
+        # verifies that the option falls back to flat allreduce, for both the
+        # single-device and the multi-device cases.
+        tensors = [torch.arange(7, dtype=torch.float).cuda(0)]
+        pg.allreduce(tensors).wait()
+        self.assertEqual(torch.arange(7, dtype=torch.float), tensors[0].cpu())
+
+        tensors = [torch.tensor([i + 1.0]).cuda(i) for i in range(self.num_gpus)]
+        pg.allreduce(tensors).wait()
+        for i in range(self.num_gpus):
+            self.assertEqual(
+                torch.tensor([float(self.num_gpus * (self.num_gpus + 1) / 2)]),
+                tensors[i].cpu(),
+            )
+
+    @requires_nccl()
+    def test_allreduce_priority_option(self):
+        store = c10d.FileStore(self.file.name, self.world_size)
+        options = c10d.ProcessGroupNCCL.Options()
+        options.priority_allreduce = True
+        pg = c10d.ProcessGroupNCCL(store, self.rank, self.world_size, options)
+
+        # Interleave high priority allreduces, which run on their own
+        # communicator, with the other collectives of the group.
+        high_priority = c10d.AllreduceOptions()
+        high_priority.high_priority = True
+        for i in range(3):
+            tensors = [torch.tensor([i + 1.0]).cuda(0)]
+            pg.allreduce(tensors, high_priority).wait()
+            self.assertEqual(torch.tensor([i + 1.0]), tensors[0].cpu())
+
+            tensors = [torch.tensor([i + 2.0]).cuda(0)]
+            pg.allreduce(tensors).wait()
+            self.assertEqual(torch.tensor([i + 2.0]), tensors[0].cpu())
+
+    @requires_nccl()
+    def test_allreduce_stripes_option(self):
+        store = c10d.FileStore(self.file.name, self.world_size)
+        options = c10d.ProcessGroupNCCL.Options()
+        options.allreduce_stripes = 3
+        options.allreduce_stripe_min_bytes = 1024
+        pg = c10d.ProcessGroupNCCL(store, self.rank, self.world_size, options)
+
+        # A size that doesn't divide into the stripes, one too small to be
+        # striped, and one whose last stripe is shortened by the alignment.
+        for numel in (100003, 256, 300):
+            tensors = [torch.arange(numel, dtype=torch.float).cuda(0) * (self.rank + 1)]
+            pg.allreduce(tensors).wait()
+            expected = torch.arange(numel, dtype=torch.float) * (
+                self.world_size * (self.world_size + 1) / 2
+            )
+            self.assertEqual(expected, tensors[0].cpu())
+
+        # Multi-device allreduce isn't striped
+        tensors = [torch.full((1024,), i + 1.0).cuda(i) for i in range(self.num_gpus)]
+        pg.allreduce(tensors).wait()
+        for i in range(self.num_gpus):
+            self.assertEqual(
+                torch.full((1024,), float(self.world_size * self.num_gpus * (self.num_gpus + 1) / 2)),
+                tensors[i].cpu(),
+            )
+
     @requires_nccl()
     def test_reduce_ops(self):
         store = c10d.FileStore(self.file.name, self.world_size)
@@ -3702,7 +3827,7 @@ class DistributedDataParallelTest(MultiProcessTestCase):
         return gpu_model
 
     def _gpu_model_with_builtin_ddp_comm_hook(
-        self, process_group, hook=None, gradient_as_bucket_view=False
+        self, process_group, hook=None, gradient_as_bucket_view=False, **options
     ):
         device_id = gpus_for_rank(self.world_size)[self.rank][0]
         gpu_model = DistributedDataParallel(
@@ -3714,7 +3839,7 @@ class DistributedDataParallelTest(MultiProcessTestCase):
 
         # Register a built-in DDP communication hook if defined
         if hook is not None:
-            gpu_model._register_builtin_comm_hook(hook)
+            gpu_model._register_builtin_comm_hook(hook, **options)
 
         return gpu_model
 
@@ -3861,6 +3986,36 @@ class DistributedDataParallelTest(MultiProcessTestCase):
             # check whether the grads are equal to what DDP without hook would return.
             self._run_and_verify_hook(gpu_model, 8, 0.25 * torch.ones(2, 2))
 
+    def _test_builtin_compression_ddp_comm_hooks_nccl(self, gradient_as_bucket_view=False):
+        """
+        This unit test verifies whether built-in C++ DDP communication hooks POWER_SGD and
+        TOPK_COMPRESS give the same result with the case of no hook registered, when the
+        hyperparameters make the compression lossless.
+        """
+        store = c10d.FileStore(self.file_name, self.world_size)
+        process_group = c10d.ProcessGroupNCCL(store, self.rank, self.world_size)
+
+        for comm_hook_type, options in [
+            # A 2x2 matrix is not worth compressing, so it is allreduced as is.
+            (
+                dist.BuiltinCommHookType.POWER_SGD,
+                dict(start_powerSGD_iter=2, matrix_approximation_rank=1),
+            ),
+            (dist.BuiltinCommHookType.TOPK_COMPRESS, dict(compress_ratio=1.0)),
+        ]:
+            gpu_model = self._gpu_model_with_builtin_ddp_comm_hook(
+                process_group, comm_hook_type, gradient_as_bucket_view, **options
+            )
+            for _ in range(3):
+                gpu_model.zero_grad()
+                self._run_and_verify_hook(gpu_model, 8, 0.25 * torch.ones(2, 2))
+
+        gpu_model = self._gpu_model_with_builtin_ddp_comm_hook(process_group)
+        with self.assertRaisesRegex(ValueError, "Unknown built-in comm hook option"):
+            gpu_model._register_builtin_comm_hook(
+                dist.BuiltinCommHookType.TOPK_COMPRESS, ratio=0.1
+            )
+
     @requires_nccl()
     @skip_if_lt_x_gpu(2)
     def test_ddp_comm_hook_allreduce_hook_nccl(self):
@@ -3876,6 +4031,11 @@ class DistributedDataParallelTest(MultiProcessTestCase):
     def test_builtin_ddp_comm_hooks_nccl(self):
         self._test_builtin_ddp_comm_hooks_nccl()
 
+    @requires_nccl()
+    @skip_if_lt_x_gpu(2)
+    def test_builtin_compression_ddp_comm_hooks_nccl(self):
+        self._test_builtin_compression_ddp_comm_hooks_nccl()
+
     @requires_nccl()
     @skip_if_lt_x_gpu(2)
     def test_powerSGD_ddp_comm_hook_nccl(self):
@@ -4204,6 +4364,30 @@ class ReducerTest(TestCase):
         # is considered being globally unused, it will be kept untouched as None.
         self.assertEqual(None, model.fc3.weight.grad)
 
+    def test_forward_backward_unused_parameters_static_graph(self):
+        batch_size = 10
+        model = self._create_mixed_precision_model()
+        reducer = self._create_reducer_for_models([model], find_unused_parameters=True)
+        reducer._set_static_graph()
+        loss = nn.CrossEntropyLoss()
+        for i in range(3):
+            # The buckets are rebuilt once after the first iteration, in spite
+            # of find_unused_parameters=True.
+            self.assertEqual(i == 1, reducer._rebuild_buckets())
+            reducer.prepare_for_forward()
+            input = torch.rand([batch_size, 2], dtype=torch.double)
+            target = torch.LongTensor([random.randrange(4) for _ in range(batch_size)])
+            output = loss(model(input, use_fc3=False), target)
+            # Only the first iteration traverses the graph, later ones reuse
+            # the unused parameters found there.
+            reducer.prepare_for_backward(output if i == 0 else [])
+            output.backward()
+            self.assertEqual(None, model.fc3.weight.grad)
+            self.assertIsNotNone(model.fc1.weight.grad)
+
+        with self.assertRaisesRegex(RuntimeError, "before the first iteration"):
+            reducer._set_static_graph()
+
     def test_forward_backward_optimizer(self):
         batch_size = 10
         model = self._create_mixed_precision_model()
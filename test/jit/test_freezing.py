@@ -1569,6 +1569,103 @@ class TestFrozenOptimizations(JitTestCase):
         output_f = frozen_mod.forward(input)
         self.assertEqual(output_s, output_f)
 
+    def test_concat_linear(self):
+        class Heads(nn.Module):
+            def __init__(self):
+                super().__init__()
+                self.q = nn.Linear(16, 8)
+                self.k = nn.Linear(16, 4)
+                self.v = nn.Linear(16, 8, bias=False)
+                self.w = torch.rand(16, 6)
+
+            def forward(self, x):
+                return self.q(x), self.k(x), self.v(x), x @ self.w
+
+        mod = Heads().eval()
+        frozen_mod = torch.jit.freeze(torch.jit.script(mod), optimize=False)
+        self.run_pass("inline", frozen_mod.graph)
+        self.assertTrue(torch._C._jit_pass_concat_frozen_linear(frozen_mod.graph))
+        # q and k are concatenated; v has no bias so it stays on its own
+        FileCheck().check_count("aten::linear", 2, exactly=True) \
+                   .check_count("aten::matmul", 1, exactly=True).run(frozen_mod.graph)
+        FileCheck().check_count("aten::slice", 2, exactly=True).run(frozen_mod.graph)
+
+        inp = torch.rand([3, 16])
+        self.assertEqual(frozen_mod(inp), mod(inp))
+        # a single matmul is not rewritten again
+        self.assertFalse(torch._C._jit_pass_concat_frozen_linear(frozen_mod.graph))
+
+    def test_concat_linear_mutated_input(self):
+        class Mod(nn.Module):
+            def __init__(self):
+                super().__init__()
+                self.a = nn.Linear(16, 8)
+                self.b = nn.Linear(16, 8)
+
+            def forward(self, x):
+                y = self.a(x)
+                x.add_(1)
+                return y, self.b(x)
+
+        mod = Mod().eval()
+        frozen_mod = torch.jit.freeze(torch.jit.script(mod), optimize=False)
+        self.run_pass("inline", frozen_mod.graph)
+        self.assertFalse(torch._C._jit_pass_concat_frozen_linear(frozen_mod.graph))
+        FileCheck().check_count("aten::linear", 2, exactly=True).run(frozen_mod.graph)
+
+    def test_fuse_batch_norm_relu(self):
+        class Mod(nn.Module):
+            def __init__(self):
+                super().__init__()
+                self.linear = nn.Linear(8, 8)
+                self.bn = nn.BatchNorm1d(8)
+                self.bn2 = nn.BatchNorm1d(8)
+
+            def forward(self, x):
+                y = self.bn(self.linear(x))
+                # the batch norm has a second use, so it stays on its own
+                z = self.bn2(x)
+                return torch.relu(y), torch.relu(z), z
+
+        mod = Mod()
+        mod.bn.running_mean.uniform_()
+        mod.bn.running_var.uniform_(1, 2)
+        mod.eval()
+        frozen_mod = torch.jit.freeze(torch.jit.script(mod), optimize=False)
+        self.run_pass("inline", frozen_mod.graph)
+        self.assertTrue(torch._C._jit_pass_fuse_frozen_batch_norm_relu(frozen_mod.graph))
+        FileCheck().check_count("aten::_batch_norm_relu_inference", 1, exactly=True).run(frozen_mod.graph)
+        FileCheck().check_count("aten::batch_norm", 1, exactly=True).run(frozen_mod.graph)
+
+        inp = torch.rand([3, 8])
+        self.assertEqual(frozen_mod(inp), mod(inp))
+        self.assertFalse(torch._C._jit_pass_fuse_frozen_batch_norm_relu(frozen_mod.graph))
+
+    def test_fuse_linear_activation(self):
+        class Mod(nn.Module):
+            def __init__(self):
+                super().__init__()
+                self.lin1 = nn.Linear(8, 8)
+                self.lin2 = nn.Linear(8, 8)
+                self.lin3 = nn.Linear(8, 8)
+
+            def forward(self, x):
+                y = torch.relu(self.lin1(x))
+                z = torch.nn.functional.gelu(self.lin2(y))
+                # the linear output has a second use, so it stays on its own
+                w = self.lin3(z)
+                return torch.relu(w), w
+
+        mod = Mod().eval()
+        frozen_mod = torch.jit.freeze(torch.jit.script(mod), optimize=False)
+        self.run_pass("inline", frozen_mod.graph)
+        self.run_pass("fuse_linear_activation", frozen_mod.graph)
+        FileCheck().check_count("aten::_linear_activation", 2, exactly=True).run(frozen_mod.graph)
+        FileCheck().check_count("aten::linear", 1, exactly=True).run(frozen_mod.graph)
+
+        inp = torch.rand([3, 8])
+        self.assertEqual(frozen_mod(inp), mod(inp))
+
     @unittest.skipIf(not torch._C.has_mkldnn, "MKL-DNN build is disabled")
     def test_conv_to_mkldnn(self):
         with set_default_dtype(torch.float):
@@ -1662,6 +1759,45 @@ class TestFrozenOptimizations(JitTestCase):
             # tensor of unknown dtype (getAttr node here) not supported
             test_unsupported(nn.Sequential(lin, Add(torch.tensor([20]))), ['1'])
 
+    @unittest.skipIf(not torch._C.has_mkldnn, "MKL-DNN build is disabled")
+    def test_collapse_conversions_across_blocks(self):
+        class Mod(nn.Module):
+            def __init__(self):
+                super().__init__()
+                self.lin1 = nn.Linear(20, 20)
+                self.lin2 = nn.Linear(20, 20)
+
+            def forward(self, x, cond: bool):
+                y = self.lin1(x)
+                if cond:
+                    y = self.lin2(y)
+                return y
+
+        with set_default_dtype(torch.float):
+            mod = Mod().eval()
+            scripted_mod = torch.jit.freeze(torch.jit.script(mod))
+            self.run_pass("convert_frozen_ops_to_mkldnn", scripted_mod.graph)
+            FileCheck().check_count("to_mkldnn", 1, exactly=True).run(scripted_mod.graph)
+
+            inp = torch.rand([20, 20])
+            for cond in [True, False]:
+                self.assertEqual(scripted_mod(inp, cond), mod(inp, cond))
+
+    @unittest.skipIf(not torch._C.has_mkldnn, "MKL-DNN build is disabled")
+    def test_mkldnn_weights_reordered_for_known_sizes(self):
+        with set_default_dtype(torch.float):
+            mod = nn.Sequential(
+                nn.Conv2d(3, 32, kernel_size=3), nn.ReLU(), nn.Flatten(), nn.Linear(32 * 6 * 6, 10)).eval()
+            inp = torch.rand([4, 3, 8, 8])
+            traced_mod = torch.jit.freeze(torch.jit.trace(mod, (inp,)))
+            self.run_pass("convert_frozen_ops_to_mkldnn", traced_mod.graph)
+            FileCheck().check("prim::ConstantMKLDNNTensor").check("aten::conv2d").run(traced_mod.graph)
+
+            self.assertEqual(traced_mod(inp), mod(inp))
+            # weights laid out for the traced sizes still work for other sizes
+            other_inp = torch.rand([1, 3, 8, 8])
+            self.assertEqual(traced_mod(other_inp), mod(other_inp))
+
     @unittest.skipIf(not torch._C.has_mkldnn, "MKL-DNN build is disabled")
     def test_mkldnn_fuser_broadcasting(self):
         class Add(nn.Module):
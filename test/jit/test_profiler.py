@@ -250,3 +250,33 @@ class TestProfiler(JitTestCase):
 
         g = torch.jit.last_executed_optimized_graph()
         self.assertEqual(len(list(g.findAllNodes("prim::TensorExprGroup"))), 2)
+
+    def test_specializations(self):
+        old_num_specializations = torch._C._jit_set_num_specializations(2)
+        try:
+            @torch.jit.script
+            def foo(a, b):
+                return a * b + a
+
+            torch._C._jit_reset_profiling_executor_stats()
+            x = torch.ones(4)
+            foo(x, x)
+            foo(x, x)
+
+            # a second signature gets profiled and optimized on its own
+            y = torch.ones(4, dtype=torch.float)
+            for _ in range(3):
+                self.assertEqual(foo(y, y), y * y + y)
+            stats = torch._C._jit_get_profiling_executor_stats()
+            self.assertEqual(stats["specializations"], 1)
+            self.assertEqual(stats["specialization_hits"], 1)
+
+            # out of specializations, the first plan falls back
+            z = torch.arange(4)
+            self.assertEqual(foo(z, z), z * z + z)
+            stats = torch._C._jit_get_profiling_executor_stats()
+            self.assertEqual(stats["specializations"], 1)
+            self.assertGreaterEqual(stats["guard_failures"], 3)
+            self.assertGreater(stats["fallback_executions"], 0)
+        finally:
+            torch._C._jit_set_num_specializations(old_num_specializations)
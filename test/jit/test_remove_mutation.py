@@ -154,6 +154,59 @@ class TestRemoveMutation(JitTestCase):
         self.run_pass('remove_mutation', graph)
         FileCheck().check('aten::fill_').run(graph)
 
+    def test_functionalize_intermediary_use(self):
+        def fn():
+            x = torch.tensor([2, 2])
+            x.add_(1)
+            y = x + 4
+            x.add_(3)
+            x.copy_(x * 2)
+            return x, y
+
+        script = torch.jit.script(fn)
+        graph = script.graph
+        self.run_pass('functionalize_tensor_mutation', graph)
+        FileCheck().check_not("aten::add_").check_not("aten::copy_").run(graph)
+        self.assertEqual(fn(), script())
+
+    def test_functionalize_graph_input(self):
+        def fn(x):
+            x.mul_(2)
+            y = x.sigmoid()
+            x.add_(y)
+            return y
+
+        script = torch.jit.script(fn)
+        graph = script.graph
+        self.run_pass('functionalize_tensor_mutation', graph)
+        # the mutation of the input is written back once, at the end
+        FileCheck().check_not("aten::mul_").check_not("aten::add_") \
+            .check_count("aten::copy_", 1, exactly=True).check("return").run(graph)
+        x, x_script = torch.rand(3), torch.rand(3)
+        x_script.copy_(x)
+        self.assertEqual(fn(x), script(x_script))
+        self.assertEqual(x, x_script)
+
+    def test_functionalize_aliased_input(self):
+        def view_mutation(x):
+            y = x[0]
+            x.add_(1)
+            return y
+
+        def aliased_inputs(x, z):
+            x.add_(1)
+            return x + z
+
+        for fn in (view_mutation, aliased_inputs):
+            script = torch.jit.script(fn)
+            graph = script.graph
+            self.run_pass('functionalize_tensor_mutation', graph)
+            FileCheck().check("aten::add_").run(graph)
+
+        x, x_script = torch.rand(3), torch.rand(3)
+        x_script.copy_(x)
+        self.assertEqual(aliased_inputs(x, x), script(x_script, x_script))
+
     def test_lists_append(self):
         def successful_remove():
             return [i for i in range(5)]  # noqa: C416
@@ -1934,6 +1934,36 @@ class TestTracer(JitTestCase):
         FileCheck().check("first_arg").check_next("second_arg") \
             .run(str(traced_module.graph))
 
+    def test_trace_without_debug_info(self):
+        class Inner(nn.Module):
+            def forward(self, x):
+                return (x * 2).relu()
+
+        class Outer(nn.Module):
+            def __init__(self):
+                super(Outer, self).__init__()
+                self.inner = Inner()
+                self.linear = nn.Linear(4, 4)
+
+            def forward(self, x):
+                return self.linear(self.inner(x)) + 1
+
+        m = Outer()
+        x = torch.randn(3, 4)
+        filename = os.path.basename(__file__)
+
+        traced = torch.jit.trace(m, x)
+        FileCheck().check("prim::CallMethod").run(str(traced.graph))
+        self.assertIn(filename, str(traced.inlined_graph))
+
+        # Without the scopes, the submodules are traced into the top-level
+        # forward, and the nodes have no source ranges
+        traced = torch.jit.trace(m, x, _record_debug_info=False)
+        FileCheck().check_not("prim::CallMethod").check("aten::mul").check("aten::linear") \
+            .run(str(traced.graph))
+        self.assertNotIn(filename, str(traced.graph))
+        self.assertEqual(traced(x), m(x))
+
 
 class TestMixTracingScripting(JitTestCase):
     def test_trace_script(self):
@@ -117,3 +117,37 @@ class TestFusionPasses(QuantizationTestCase):
                    .run(scripted_m.graph)
         output = scripted_m(qA, 3., qC)
         self.assertEqual(ref_output, output)
+
+    def test_maximize_quantized_regions(self):
+        class M(torch.nn.Module):
+            def forward(self, x, y):
+                a = x.dequantize().reshape([-1])
+                b = y.dequantize().reshape([-1])
+                return torch.quantize_per_tensor(a + b, 0.5, 10, torch.quint8)
+
+        qA = torch.quantize_per_tensor(torch.randn(4, 8), scale=0.1,
+                                       zero_point=5, dtype=torch.quint8)
+        qB = torch.quantize_per_tensor(torch.randn(4, 8), scale=0.2,
+                                       zero_point=3, dtype=torch.quint8)
+        scripted_m = torch.jit.script(M())
+        ref_output = scripted_m(qA, qB)
+
+        torch._C._jit_pass_inline(scripted_m.graph)
+        islands = torch._C._jit_pass_quant_find_islands(scripted_m.graph)
+        self.assertEqual(len(islands), 1)
+        nodes, dequantizes, quantizes = islands[0]
+        self.assertEqual(sorted(n.kind() for n in nodes),
+                         ["aten::add", "aten::reshape", "aten::reshape"])
+        self.assertEqual(len(dequantizes), 2)
+        self.assertEqual(len(quantizes), 1)
+
+        # The reshapes run on the quantized values, which lets the add be
+        # swapped for quantized::add
+        torch._C._jit_pass_maximize_quantized_regions(scripted_m.graph)
+        FileCheck().check_not("aten::dequantize") \
+                   .check("quantized::add") \
+                   .run(scripted_m.graph)
+        self.assertEqual(
+            len(torch._C._jit_pass_quant_find_islands(scripted_m.graph)), 0)
+        output = scripted_m(qA, qB)
+        self.assertEqual(ref_output, output)
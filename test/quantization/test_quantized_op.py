@@ -415,6 +415,60 @@ class TestQuantizedOps(TestCase):
                          msg="F.celu failed ({} vs {})".format(qY, qY_hat))
 
 
+    """Tests the correctness of the quantized::matmul op."""
+    def test_qmatmul(self):
+        # (shape of a, shape of b), including broadcast batch dimensions
+        shapes = (((5, 7), (7, 3)),
+                  ((2, 4, 16), (2, 16, 8)),
+                  ((3, 2, 6, 9), (1, 9, 4)),
+                  ((6, 1), (1, 6)))
+        for (a_shape, b_shape), dtype in itertools.product(
+                shapes, (torch.quint8, torch.qint8)):
+            zero_point = 10 if dtype == torch.quint8 else -3
+            A = torch.randn(*a_shape)
+            B = torch.randn(*b_shape)
+            qA = torch.quantize_per_tensor(A, 0.05, zero_point, dtype)
+            qB = torch.quantize_per_tensor(B, 0.03, zero_point, dtype)
+            Y_scale, Y_zero_point = 0.1, zero_point
+
+            Y_ref = torch.matmul(qA.dequantize(), qB.dequantize())
+            qY_ref = torch.quantize_per_tensor(
+                Y_ref, Y_scale, Y_zero_point, dtype)
+            qY = torch.ops.quantized.matmul(qA, qB, Y_scale, Y_zero_point)
+            self.assertEqual(qY.shape, Y_ref.shape)
+            # Allow off-by-one differences from rounding
+            np.testing.assert_array_almost_equal(
+                qY_ref.int_repr().numpy(), qY.int_repr().numpy(), decimal=0)
+
+        with self.assertRaisesRegex(RuntimeError, "same dtype"):
+            torch.ops.quantized.matmul(
+                torch.quantize_per_tensor(torch.randn(2, 2), 0.1, 0, torch.quint8),
+                torch.quantize_per_tensor(torch.randn(2, 2), 0.1, 0, torch.qint8),
+                0.1, 0)
+
+    """Tests the correctness of the quantized::softmax op."""
+    @given(X=hu.tensor(shapes=hu.array_shapes(1, 4, 1, 8),
+                       elements=hu.floats(-1e2, 1e2, allow_nan=False, allow_infinity=False),
+                       qparams=hu.qparams(dtypes=[torch.quint8, torch.qint8])),
+           output_scale=st.sampled_from([1.0 / 256, 1.0 / 128]),
+           dim=st.integers(-4, 3))
+    def test_qsoftmax(self, X, output_scale, dim):
+        X, (scale, zero_point, torch_type) = X
+        assume(-X.ndim <= dim < X.ndim)
+        output_zero_point = 0 if torch_type == torch.quint8 else -128
+
+        X = torch.from_numpy(X)
+        qX = torch.quantize_per_tensor(X, scale=scale, zero_point=zero_point,
+                                       dtype=torch_type)
+        dqY_hat = torch.softmax(qX.dequantize(), dim)
+        qY_hat = torch.quantize_per_tensor(dqY_hat, scale=output_scale,
+                                           zero_point=output_zero_point,
+                                           dtype=torch_type)
+        qY = torch.ops.quantized.softmax(qX, dim, output_scale, output_zero_point)
+        # Allow off-by-one differences from rounding
+        np.testing.assert_array_almost_equal(
+            qY_hat.int_repr().numpy(), qY.int_repr().numpy(), decimal=0)
+
     """Tests the correctness of the quantized::qlayer_norm op."""
     @skipIfNoFBGEMM
     def test_qlayer_norm(self):
@@ -2697,6 +2751,34 @@ class TestDynamicQuantizedLinear(TestCase):
         self.assertEqual(Y_fp32, Y_fp32_ref,
                          msg="torch.ops.quantized.fbgemm_linear_dynamic results are off")
 
+    @skipIfNoFBGEMM
+    @given(
+        batch_size=st.integers(1, 4),
+        input_channels=st.integers(16, 32),
+        output_channels=st.integers(4, 8),
+        use_bias=st.booleans(),
+        use_relu=st.booleans(),
+        use_multi_dim_input=st.booleans())
+    def test_qlinear_dynamic_fp16(self, batch_size, input_channels, output_channels,
+                                  use_bias, use_relu, use_multi_dim_input):
+        with override_quantized_engine('fbgemm'):
+            X = torch.randn(batch_size, input_channels)
+            if use_multi_dim_input:
+                X = torch.randn(3, batch_size, input_channels)
+            W = torch.randn(output_channels, input_channels)
+            b = torch.randn(output_channels) if use_bias else None
+
+            W_prepack = torch.ops.quantized.linear_prepack_fp16(W, b)
+            qlinear_dynamic = torch.ops.quantized.linear_relu_dynamic_fp16 if use_relu \
+                else torch.ops.quantized.linear_dynamic_fp16
+            Y = qlinear_dynamic(X, W_prepack)
+
+            # The weight is rounded to fp16 when packed
+            Y_ref = F.linear(X, W.half().float(), b)
+            if use_relu:
+                Y_ref = F.relu(Y_ref)
+            self.assertEqual(Y, Y_ref, atol=1e-3, rtol=1e-3)
+
 
 class TestDynamicQuantizedRNNOp(TestCase):
     """Tests the correctness of the dynamic quantized lstm/gru."""
@@ -3214,6 +3296,9 @@ class TestQuantizedEmbeddingOps(TestCase):
         if bit_rate == 4:
             pt_op = torch.ops.quantized.embedding_bag_4bit_rowwise_offsets
             pt_prepack_op = torch.ops.quantized.embedding_bag_4bit_prepack
+        elif bit_rate == 2:
+            pt_op = torch.ops.quantized.embedding_bag_2bit_rowwise_offsets
+            pt_prepack_op = torch.ops.quantized.embedding_bag_2bit_prepack
 
         weights = torch.from_numpy((np.random.random_sample((
             num_embeddings, embedding_dim)) + 1).astype(np.float32))
@@ -3380,6 +3465,33 @@ class TestQuantizedEmbeddingOps(TestCase):
                                                sparsity=sparsity,
                                                atol=0.1, rtol=1e-2)
 
+    """ Tests the correctness of the embedding_bag_2bit quantized operator """
+    @given(num_embeddings=st.integers(10, 100),
+           embedding_dim=st.integers(5, 50).filter(lambda x: x % 4 == 0),
+           num_offsets=st.integers(1, 20),
+           use_32bit_indices=st.booleans(),
+           use_32bit_offsets=st.booleans(),
+           enable_per_sample_weights=st.booleans(),
+           include_last_offset=st.booleans(),
+           fallback_to_no_sparse=st.booleans(),
+           sparsity=st.sampled_from([0.0, 0.5, 0.7]))
+    def test_embedding_bag_2bit(self, num_embeddings,
+                                embedding_dim, num_offsets,
+                                use_32bit_indices,
+                                use_32bit_offsets,
+                                enable_per_sample_weights,
+                                include_last_offset,
+                                fallback_to_no_sparse,
+                                sparsity):
+        self.embedding_bag_rowwise_offsets_run(2, num_embeddings,
+                                               embedding_dim, num_offsets,
+                                               use_32bit_indices, use_32bit_offsets,
+                                               enable_per_sample_weights,
+                                               include_last_offset,
+                                               fallback_to_no_sparse,
+                                               sparsity=sparsity,
+                                               atol=1.0, rtol=1e-1)
+
     """ Tests the correctness of the quantized embedding lookup operator """
     @given(num_embeddings=st.integers(10, 100),
            embedding_dim=st.integers(5, 50).filter(lambda x: x % 4 == 0))
@@ -4295,6 +4407,76 @@ class TestQuantizedConv(TestCase):
                 X_zero_point, W_scale, W_zero_point, Y_scale, Y_zero_point,
                 use_bias, use_relu, use_channelwise, use_transpose=False)
 
+    """Tests the correctness of quantized depthwise convolution, including the
+    kernel shapes, strides and dilations the specialized kernels don't cover."""
+    @given(batch_size=st.integers(1, 3),
+           groups=st.sampled_from([3, 8, 16, 19]),
+           spatial_dim=st.sampled_from([2, 3]),
+           feature_map=st.integers(5, 9),
+           kernel=st.integers(1, 5),
+           stride=st.integers(1, 2),
+           pad=st.integers(0, 2),
+           dilation=st.integers(1, 2),
+           X_scale=st.floats(1.2, 1.6),
+           X_zero_point=st.integers(0, 4),
+           W_scale=st.lists(st.floats(0.2, 1.6), min_size=1, max_size=2),
+           W_zero_point=st.lists(st.integers(-5, 5), min_size=1, max_size=2),
+           Y_scale=st.floats(4.2, 5.6),
+           Y_zero_point=st.integers(0, 4),
+           use_bias=st.booleans(),
+           use_relu=st.booleans(),
+           use_channelwise=st.booleans(),
+           qengine=st.sampled_from(("fbgemm",)))
+    def test_qconv_depthwise(
+        self,
+        batch_size,
+        groups,
+        spatial_dim,
+        feature_map,
+        kernel,
+        stride,
+        pad,
+        dilation,
+        X_scale,
+        X_zero_point,
+        W_scale,
+        W_zero_point,
+        Y_scale,
+        Y_zero_point,
+        use_bias,
+        use_relu,
+        use_channelwise,
+        qengine
+    ):
+        if qengine not in supported_qengines:
+            return
+        assume(feature_map + 2 * pad >= dilation * (kernel - 1) + 1)
+
+        kernels = (kernel,) * spatial_dim
+        strides = (stride,) * spatial_dim
+        pads = (pad,) * spatial_dim
+        dilations = (dilation,) * spatial_dim
+
+        with override_quantized_engine(qengine):
+            if spatial_dim == 2:
+                qconv = torch.ops.quantized.conv2d_relu if use_relu \
+                    else torch.ops.quantized.conv2d
+                qconv_prepack = torch.ops.quantized.conv2d_prepack
+                conv_module = torch.nn.Conv2d
+            else:
+                qconv = torch.ops.quantized.conv3d_relu if use_relu \
+                    else torch.ops.quantized.conv3d
+                qconv_prepack = torch.ops.quantized.conv3d_prepack
+                conv_module = torch.nn.Conv3d
+            conv_op = conv_module(
+                groups, groups, kernels, strides, pads, dilations, groups)
+            self._test_qconv_impl(
+                qconv, qconv_prepack, conv_op, batch_size, 1,
+                (feature_map,) * spatial_dim, 1, groups, kernels, strides,
+                pads, None, dilations, X_scale, X_zero_point, W_scale,
+                W_zero_point, Y_scale, Y_zero_point, use_bias, use_relu,
+                use_channelwise, use_transpose=False)
+
     """Tests the correctness of the quantized::qconv3d_unpack op."""
     @given(
         inputs=hu.tensor_conv(
@@ -11,6 +11,7 @@ from torch.quantization import (
     NoopObserver,
     FakeQuantize,
     FixedQParamsFakeQuantize,
+    FusedMovingAvgObsFakeQuantize,
     default_debug_qconfig,
     default_observer,
     default_histogram_observer,
@@ -1537,6 +1538,42 @@ class TestFakeQuantize(TestCase):
         for key in state_dict:
             self.assertEqual(state_dict[key], loaded_dict[key])
 
+    def test_fused_obs_fq_module(self):
+        devices = ['cpu', 'cuda'] if torch.cuda.is_available() else ['cpu']
+        configs = [
+            (MovingAverageMinMaxObserver, 0, 255, dict(dtype=torch.quint8, qscheme=torch.per_tensor_affine)),
+            (MovingAverageMinMaxObserver, -128, 127, dict(dtype=torch.qint8, qscheme=torch.per_tensor_symmetric)),
+            (MovingAverageMinMaxObserver, 0, 255, dict(dtype=torch.quint8, qscheme=torch.per_tensor_symmetric)),
+            (MovingAveragePerChannelMinMaxObserver, -128, 127,
+             dict(dtype=torch.qint8, qscheme=torch.per_channel_symmetric, ch_axis=1)),
+            (MovingAveragePerChannelMinMaxObserver, 0, 255,
+             dict(dtype=torch.quint8, qscheme=torch.per_channel_affine, ch_axis=0)),
+        ]
+        for device, (observer, quant_min, quant_max, kwargs) in itertools.product(devices, configs):
+            torch.manual_seed(0)
+            fq_module = FakeQuantize(observer, quant_min, quant_max, **kwargs).to(device)
+            fused_module = FusedMovingAvgObsFakeQuantize(observer, quant_min, quant_max, **kwargs).to(device)
+            for i in range(4):
+                if i == 2:
+                    fq_module.disable_observer()
+                    fused_module.disable_observer()
+                if i == 3:
+                    fq_module.disable_fake_quant()
+                    fused_module.disable_fake_quant()
+                X = torch.randn(4, 3, 5, device=device) * (i + 1)
+                X_fq = X.clone().requires_grad_()
+                X_fused = X.clone().requires_grad_()
+                Y = fq_module(X_fq)
+                Y_fused = fused_module(X_fused)
+                self.assertEqual(Y, Y_fused)
+                self.assertEqual(fq_module.scale, fused_module.scale)
+                self.assertEqual(fq_module.zero_point, fused_module.zero_point)
+
+                dout = torch.rand_like(X)
+                Y.backward(dout)
+                Y_fused.backward(dout)
+                self.assertEqual(X_fq.grad, X_fused.grad)
+
 def _get_buffer_ids(module):
     """
     Object addresses stay constant if and only if all modifications are in-place
@@ -30,6 +30,7 @@ TESTS = [
     'test_public_bindings',
     'test_type_hints',
     'test_autograd',
+    'test_autocast',
     'benchmark_utils/test_benchmark_utils',
     'test_binary_ufuncs',
     'test_bundled_inputs',
@@ -96,6 +97,7 @@ TESTS = [
     'test_jit_fuser_legacy',
     'test_tensorboard',
     'test_namedtensor',
+    'test_nestedtensor',
     'test_reductions',
     'test_type_promotion',
     'test_jit_disabled',
@@ -0,0 +1,81 @@
+import torch
+import torch.nn.functional as F
+from torch.testing._internal.common_utils import TestCase, run_tests
+
+
+class TestAutocastCPU(TestCase):
+    def _run_autocast(self, op, args, out_type, dtype=torch.bfloat16):
+        with torch.cpu.amp.autocast(dtype=dtype):
+            out = op(*args)
+            self.assertEqual(out.dtype, out_type)
+            # the result matches the op run on manually cast inputs
+            if out_type != torch.float32:
+                control = op(*[a.to(out_type) if isinstance(a, torch.Tensor) and a.is_floating_point() else a
+                               for a in args])
+                self.assertEqual(out, control)
+        return out
+
+    def test_autocast_lower_precision_ops(self):
+        mat = torch.randn(8, 8)
+        batch = torch.randn(2, 8, 8)
+        for op, args in [(torch.mm, (mat, mat)),
+                         (torch.matmul, (mat, mat)),
+                         (torch.bmm, (batch, batch)),
+                         (torch.addmm, (mat, mat, mat)),
+                         (torch.baddbmm, (batch, batch, batch)),
+                         (F.linear, (mat, mat, torch.randn(8))),
+                         (F.conv2d, (torch.randn(2, 3, 8, 8), torch.randn(4, 3, 3, 3)))]:
+            self._run_autocast(op, args, torch.bfloat16)
+
+    def test_autocast_fp32_ops(self):
+        x = torch.randn(4, 8).bfloat16()
+        for op, args in [(torch.sum, (x,)),
+                         (torch.mean, (x,)),
+                         (lambda t: torch.softmax(t, 1), (x,)),
+                         (lambda t: F.layer_norm(t, (8,)), (x,)),
+                         (lambda t: torch.norm(t), (x,)),
+                         (F.mse_loss, (x, torch.randn(4, 8)))]:
+            self._run_autocast(op, args, torch.float32)
+
+    def test_autocast_promote(self):
+        a = torch.randn(4, 8)
+        b = torch.randn(4, 8).bfloat16()
+        self._run_autocast(lambda x, y: torch.cat((x, y)), (a, b), torch.float32)
+        self._run_autocast(lambda x, y: torch.stack((x, y)), (b, b), torch.bfloat16)
+
+    def test_autocast_ineligible(self):
+        # double and integer tensors are not cast
+        mat = torch.randn(8, 8, dtype=torch.double)
+        self._run_autocast(torch.mm, (mat, mat), torch.double)
+        imat = torch.randint(0, 4, (8, 8))
+        self._run_autocast(torch.mm, (imat, imat), torch.int64)
+
+    def test_autocast_disabled(self):
+        mat = torch.randn(8, 8)
+        with torch.cpu.amp.autocast():
+            self.assertTrue(torch.is_autocast_cpu_enabled())
+            self.assertEqual(torch.get_autocast_cpu_dtype(), torch.bfloat16)
+            with torch.cpu.amp.autocast(enabled=False):
+                self.assertEqual(torch.mm(mat, mat).dtype, torch.float32)
+            self.assertEqual(torch.mm(mat, mat).dtype, torch.bfloat16)
+        self.assertFalse(torch.is_autocast_cpu_enabled())
+        self.assertEqual(torch.mm(mat, mat).dtype, torch.float32)
+
+    def test_autocast_weight_cache(self):
+        model = torch.nn.Linear(8, 8)
+        x = torch.randn(4, 8)
+        with torch.cpu.amp.autocast():
+            out = model(x)
+            self.assertEqual(out.dtype, torch.bfloat16)
+            out.float().sum().backward()
+        self.assertEqual(model.weight.grad.dtype, torch.float32)
+        self.assertEqual(model.bias.grad.dtype, torch.float32)
+
+    def test_autocast_unsupported_dtype(self):
+        with self.assertRaisesRegex(RuntimeError, "only supports Bfloat16"):
+            with torch.cpu.amp.autocast(dtype=torch.float16):
+                pass
+
+
+if __name__ == '__main__':
+    run_tests()
@@ -1100,6 +1100,40 @@ class TestAutograd(TestCase):
             loss += s
         loss.backward()
 
+    def test_inference_mode(self):
+        x = torch.ones(5, 5, requires_grad=True)
+        with torch.inference_mode():
+            self.assertTrue(torch.is_inference_mode_enabled())
+            self.assertFalse(torch.is_grad_enabled())
+            y = x * 2
+            y.add_(1)
+            with torch.inference_mode(False):
+                self.assertFalse(torch.is_inference_mode_enabled())
+                self.assertFalse(torch.ones(1).is_inference())
+        self.assertFalse(torch.is_inference_mode_enabled())
+        self.assertTrue(torch.is_grad_enabled())
+        self.assertTrue(y.is_inference())
+        self.assertFalse(y.requires_grad)
+        self.assertIsNone(y.grad_fn)
+
+        # Outside of inference mode, inference tensors are read only inputs
+        z = y * 2
+        self.assertFalse(z.is_inference())
+        with self.assertRaisesRegex(RuntimeError, "Inplace update to inference tensor"):
+            y.add_(1)
+        with self.assertRaisesRegex(RuntimeError, "Setting requires_grad=True on inference tensor"):
+            y.requires_grad_()
+        with self.assertRaisesRegex(RuntimeError, "Inference tensors cannot be saved for backward"):
+            x * y
+        (x * y.clone()).sum().backward()
+        self.assertEqual(x.grad, torch.full((5, 5), 3.))
+
+        @torch.inference_mode()
+        def func(x):
+            return x * x
+
+        self.assertTrue(func(x).is_inference())
+
     def test_no_grad(self):
         x = torch.ones(5, 5, requires_grad=True)
         y = torch.ones(5, 5) * 4
@@ -1699,6 +1733,113 @@ class TestAutograd(TestCase):
         c.backward(torch.tensor([1, 1, 1], dtype=torch.double), retain_graph=True)
         c.backward(torch.tensor([1, 1, 1], dtype=torch.double))
 
+    def test_saved_tensors_hooks(self):
+        packed = []
+
+        def pack(x):
+            packed.append(x)
+            return ("packed", x.clone())
+
+        def unpack(p):
+            self.assertEqual(p[0], "packed")
+            return p[1]
+
+        a = torch.randn(5, requires_grad=True, dtype=torch.double)
+        b = torch.randn(5, requires_grad=True, dtype=torch.double)
+        with torch.autograd.graph.saved_tensors_hooks(pack, unpack):
+            y = a * b
+        self.assertEqual(len(packed), 2)
+        # Tensors saved outside of the context are not packed
+        z = (a * b).sum()
+        self.assertEqual(len(packed), 2)
+        y.sum().backward(retain_graph=True)
+        self.assertEqual(a.grad, b)
+        self.assertEqual(b.grad, a)
+        # The unpack hook can be called again when the graph is retained
+        y.sum().backward()
+        self.assertEqual(a.grad, 2 * b)
+        self.assertRaisesRegex(RuntimeError, 'Specify retain_graph=True',
+                               lambda: y.sum().backward())
+        z.backward()
+
+        # Nested contexts use the innermost hooks
+        calls = []
+        with torch.autograd.graph.saved_tensors_hooks(lambda x: calls.append("outer") or x, lambda x: x):
+            with torch.autograd.graph.saved_tensors_hooks(lambda x: calls.append("inner") or x, lambda x: x):
+                a.exp()
+            a.exp()
+        self.assertEqual(calls, ["inner", "outer"])
+
+        # Inplace modifications of the saved tensor are still detected
+        c = torch.randn(5, requires_grad=True, dtype=torch.double).clone()
+        with torch.autograd.graph.saved_tensors_hooks(lambda x: x, lambda x: x):
+            d = c.sin()
+        c.add_(1)
+        with self.assertRaisesRegex(RuntimeError, "modified by an inplace operation"):
+            d.sum().backward()
+
+        with torch.autograd.graph.saved_tensors_hooks(lambda x: x, lambda x: 1):
+            y = a.exp()
+        with self.assertRaisesRegex(TypeError, "expected to be a Tensor"):
+            y.sum().backward()
+
+    def test_saved_tensors_policies(self):
+        a = torch.randn(4, 5, requires_grad=True)
+        with torch.autograd.graph.save_on_cpu():
+            y = a.sigmoid().mm(a.t()).sum()
+        y.backward()
+        grad, = torch.autograd.grad(a.sigmoid().mm(a.t()).sum(), a)
+        self.assertEqual(a.grad, grad)
+
+        a.grad = None
+        with torch.autograd.graph.save_in_dtype(torch.bfloat16):
+            y = a.exp().sum()
+        y.backward()
+        self.assertEqual(a.grad.dtype, torch.float)
+        self.assertEqual(a.grad, a.exp().bfloat16().float())
+        self.assertRaises(ValueError, lambda: torch.autograd.graph.save_in_dtype(torch.int8))
+
+    @unittest.skipIf(not TEST_CUDA, "test requires CUDA")
+    def test_save_on_cpu_cuda(self):
+        for pin_memory in (False, True):
+            a = torch.randn(4, 5, device="cuda", requires_grad=True)
+            with torch.autograd.graph.save_on_cpu(pin_memory=pin_memory):
+                y = a.sigmoid().mm(a.t()).sum()
+            torch.cuda.synchronize()
+            y.backward()
+            grad, = torch.autograd.grad(a.sigmoid().mm(a.t()).sum(), a)
+            self.assertEqual(a.grad, grad)
+
+    def test_fuse_accumulate_grad(self):
+        def run(fused):
+            torch.manual_seed(0)
+            params = [torch.randn(3, requires_grad=True) for _ in range(20)]
+            params.append(torch.randn(4, 3, requires_grad=True, dtype=torch.double))
+            sparse = torch.randn(10, 3, requires_grad=True)
+            hooked = torch.randn(3, requires_grad=True)
+            hooked.register_hook(lambda g: g * 2)
+            prev = torch._C._autograd._get_fuse_accumulate_grad()
+            torch._C._autograd._set_fuse_accumulate_grad(fused)
+            try:
+                for i in range(3):
+                    out = sum((p * (i + 1)).sin().sum() for p in params[:-1])
+                    out = out + params[-1].sum() + hooked.exp().sum()
+                    out = out + torch.nn.functional.embedding(
+                        torch.tensor([1, 2]), sparse, sparse=True).sum()
+                    if i == 1:
+                        # grads that get replaced mid way still accumulate
+                        params[0].grad = None
+                    out.backward()
+                # autograd.grad doesn't touch .grad
+                grads = torch.autograd.grad(params[1].sum(), params[1])
+                self.assertEqual(grads[0], torch.ones(3))
+            finally:
+                torch._C._autograd._set_fuse_accumulate_grad(prev)
+            return [p.grad for p in params + [hooked, sparse]]
+
+        for fused, ref in zip(run(True), run(False)):
+            self.assertEqual(fused, ref)
+
     def test_next_functions(self):
         x = torch.randn(5, 5, requires_grad=True)
         y = torch.randn(5, 5, requires_grad=True)
@@ -3010,6 +3151,35 @@ class TestAutograd(TestCase):
             with io.open(fname, 'r') as f:
                 json.load(f)
 
+    def test_backward_timing(self):
+        backward_timing = torch.autograd.profiler.backward_timing
+        backward_timing.reset()
+        x = torch.randn(10, requires_grad=True)
+        (x * 2).exp().sum().backward()
+        self.assertEqual(backward_timing.summary(), [])
+
+        with backward_timing():
+            self.assertTrue(torch._C._autograd._is_backward_timing_enabled())
+            for _ in range(3):
+                y = (x * 2).exp()
+                y.sum().backward()
+        self.assertFalse(torch._C._autograd._is_backward_timing_enabled())
+
+        stats = {s.name.split('::')[-1]: s for s in backward_timing.summary()}
+        exp_stats = [s for name, s in stats.items() if name.startswith('ExpBackward')]
+        self.assertEqual(len(exp_stats), 1)
+        self.assertEqual(exp_stats[0].count, 3)
+        self.assertGreaterEqual(exp_stats[0].total_us, exp_stats[0].max_us)
+        self.assertEqual(stats['AccumulateGrad'].count, 3)
+
+        events = backward_timing.events()
+        self.assertEqual(len(events), 3 * len(stats))
+        self.assertEqual([e.sequence_nr for e in events], sorted(e.sequence_nr for e in events))
+
+        backward_timing.reset()
+        self.assertEqual(backward_timing.summary(), [])
+        self.assertEqual(backward_timing.events(), [])
+
     def test_profiler(self):
         x = torch.randn(10, 10)
 
@@ -6684,6 +6854,36 @@ class TestAutogradForwardMode(TestCase):
             del dual
             self.assertIsNone(tangent_ref())
 
+    def test_batched_tangents(self):
+        from torch._vmap_internals import _vmap
+        primal = torch.rand(3, 4)
+        tangents = torch.rand(5, 3, 4)
+
+        def jvp(tangent):
+            with fwAD.dual_level():
+                dual = fwAD.make_dual(primal, tangent)
+                # The primal is not batched, only its tangent is
+                self.assertEqual(fwAD.unpack_dual(dual)[0], primal)
+                out = torch.zeros(3, 4)
+                out.copy_(dual)
+                return fwAD.unpack_dual(out.detach())[1]
+
+        self.assertEqual(_vmap(jvp)(tangents), tangents)
+
+        def make_dual_of_batched(p):
+            with fwAD.dual_level():
+                return fwAD.make_dual(p, torch.rand(3, 4))
+
+        with self.assertRaisesRegex(RuntimeError, "only supported when the tangent is vmapped over"):
+            _vmap(make_dual_of_batched)(tangents)
+
+        def wrong_size(tangent):
+            with fwAD.dual_level():
+                return fwAD.make_dual(primal, tangent.t())
+
+        with self.assertRaisesRegex(RuntimeError, "batched forward gradient of size"):
+            _vmap(wrong_size)(tangents)
+
 # Generic device type autograd tests.
 class TestAutogradDeviceType(TestCase):
 
@@ -7897,6 +8097,58 @@ class TestMultithreadAutograd(TestCase):
         self.assertEqual(grad, grad1)
         self.assertEqual(grad, grad2)
 
+    def test_parallel_cpu_backward(self):
+        # Independent branches may run on several CPU threads. Results, errors
+        # and reentrant backwards (checkpoint) should not be affected.
+        prev_num_threads = torch._C._autograd._get_backward_cpu_threads()
+        self.assertEqual(prev_num_threads, 1)
+        with self.assertRaisesRegex(RuntimeError, "to be positive"):
+            torch._C._autograd._set_backward_cpu_threads(0)
+
+        def towers(x, ws):
+            return sum(((x @ w).tanh() @ w.t()).sigmoid().sum() for w in ws)
+
+        x = torch.randn(16, 8, requires_grad=True)
+        ws = [torch.randn(8, 32, requires_grad=True) for _ in range(8)]
+        towers(x, ws).backward()
+        ref_grads = [x.grad.clone()] + [w.grad.clone() for w in ws]
+        ref_autograd_grads = torch.autograd.grad(towers(x, ws), [x] + ws)
+
+        class Raise(Function):
+            @staticmethod
+            def forward(ctx, input):
+                return input.clone()
+
+            @staticmethod
+            def backward(ctx, grad):
+                raise RuntimeError("Simulate error on branch")
+
+        try:
+            torch._C._autograd._set_backward_cpu_threads(4)
+            for _ in range(3):
+                x.grad = None
+                for w in ws:
+                    w.grad = None
+                towers(x, ws).backward()
+                self.assertEqual([x.grad] + [w.grad for w in ws], ref_grads)
+                autograd_grads = torch.autograd.grad(towers(x, ws), [x] + ws)
+                self.assertEqual(autograd_grads, ref_autograd_grads)
+
+            # Reentrant backward from one of the branches
+            a = torch.randn(4, 4, requires_grad=True)
+            out = sum(checkpoint(lambda t, k=k: (t * k).exp(), a).sum() for k in range(4))
+            out.backward()
+            self.assertEqual(a.grad, sum(k * (a * k).exp() for k in range(4)))
+
+            with self.assertRaisesRegex(RuntimeError, "Simulate error on branch"):
+                (towers(x, ws) + Raise.apply(x).sum()).backward()
+            # The engine is still usable after the error
+            x.grad = None
+            towers(x, ws).backward()
+            self.assertEqual(x.grad, ref_grads[0])
+        finally:
+            torch._C._autograd._set_backward_cpu_threads(prev_num_threads)
+
     def test_preserve_backtrace(self):
         class Foo(torch.autograd.Function):
             @staticmethod
@@ -103,6 +103,29 @@ class TestBinaryUfuncs(TestCase):
                          torch.randn(0, 7, 0, 6, 5, 0, 1, device=device) + torch.randn(1, 1, 5, 1, 7, device=device))
         self.assertRaises(RuntimeError, lambda: torch.randn(7, 0, device=device) + torch.randn(2, 1, device=device))
 
+    @onlyCUDA
+    @dtypes(torch.half, torch.float, torch.double, torch.uint8, torch.int64)
+    def test_add_inner_contiguous(self, device, dtype):
+        # Inputs whose innermost dimension is contiguous are loaded in vectors
+        # along it, including in the last, partial block
+        for rows, cols, start in product((1, 3, 1000), (2, 4, 8, 64, 66), (0, 1, 2, 4)):
+            x = make_tensor((rows, cols + 8), 'cpu', dtype)
+            y = make_tensor((rows, cols + 8), 'cpu', dtype)
+            bias = make_tensor((cols,), 'cpu', dtype)
+            x_slice = x[:, start:start + cols]
+            y_slice = y[:, start:start + cols]
+            x_cuda, y_cuda = x.to(device), y.to(device)
+            x_cuda_slice = x_cuda[:, start:start + cols]
+            y_cuda_slice = y_cuda[:, start:start + cols]
+            self.assertEqual(x_cuda_slice + y_cuda_slice, x_slice + y_slice)
+            self.assertEqual(x_cuda_slice + bias.to(device), x_slice + bias)
+
+            out = torch.zeros(rows, cols + 8, dtype=dtype)
+            out_cuda = out.to(device)
+            torch.add(x_slice, y_slice, out=out[:, start:start + cols])
+            torch.add(x_cuda_slice, y_cuda_slice, out=out_cuda[:, start:start + cols])
+            self.assertEqual(out_cuda, out)
+
     def test_addcmul_scalars_as_floats(self, device):
         # zero-dim variables that don't require grad should bind to scalar arguments
         x = torch.tensor(2.)
@@ -1378,6 +1378,88 @@ class TestCuda(TestCase):
         # cached blocks in case it affects future tests.
         torch.cuda.empty_cache()
 
+    @unittest.skipIf(IS_SANDCASTLE or IS_REMOTE_GPU, "Does not work on Sandcastle")
+    def test_caching_allocator_expandable_segments(self):
+        # Runs in a fresh process, since the mode is fixed at the first allocation.
+        import subprocess
+        env = dict(os.environ, PYTORCH_CUDA_EXPANDABLE_SEGMENTS="1")
+        out = subprocess.check_output([sys.executable, '-c', """\
+import torch
+
+keep = []
+for i in range(1, 20):
+    x = torch.full((i * 1024 * 1024 + 17,), float(i), device='cuda')
+    assert x.sum().item() == float(i) * x.numel()
+    if i % 3 == 0:
+        keep.append(x)
+    del x
+
+large = [s for s in torch.cuda.memory_snapshot() if s['segment_type'] == 'large']
+if all(s['is_expandable'] for s in large):
+    # a single growing segment instead of one per large request
+    assert len(large) == 1, large
+    reserved = torch.cuda.memory_reserved()
+    torch.cuda.empty_cache()
+    assert torch.cuda.memory_reserved() < reserved
+    assert torch.cuda.memory_reserved() >= torch.cuda.memory_allocated()
+for i, x in enumerate(keep):
+    assert (x == float(3 * (i + 1))).all().item()
+print('OK')
+"""], env=env)
+        self.assertIn(b'OK', out)
+
+    def test_memory_history(self):
+        torch.cuda.record_memory_history(max_entries=4, stack_depth=8)
+        try:
+            x = torch.empty(1024 * 1024, device='cuda')
+            ptr = x.data_ptr()
+            del x
+            trace = torch.cuda.memory_trace()
+            self.assertEqual(trace[-2]['action'], 'alloc')
+            self.assertEqual(trace[-1]['action'], 'free')
+            self.assertEqual(trace[-1]['addr'], ptr)
+            self.assertEqual(trace[-1]['size'], 4 * 1024 * 1024)
+            self.assertEqual(trace[-1]['stream'], torch.cuda.current_stream().cuda_stream)
+            self.assertIsInstance(trace[-1]['frames'], str)
+
+            # only the most recent events are kept
+            for _ in range(5):
+                torch.empty(1024, device='cuda')
+            trace = torch.cuda.memory_trace()
+            self.assertEqual(len(trace), 4)
+            self.assertEqual([e['action'] for e in trace], ['alloc', 'free'] * 2)
+            self.assertTrue(all(a['time_us'] <= b['time_us'] for a, b in zip(trace, trace[1:])))
+        finally:
+            torch.cuda.record_memory_history(False)
+        self.assertEqual(torch.cuda.memory_trace(), [])
+
+    def test_mem_pool(self):
+        pool = torch.cuda.MemPool()
+        with torch.cuda.use_mem_pool(pool):
+            x = torch.empty(1024 * 1024, device='cuda')
+        ptr = x.data_ptr()
+        del x
+
+        # freed pool memory is not handed out to other allocations...
+        y = torch.empty(1024 * 1024, device='cuda')
+        self.assertNotEqual(y.data_ptr(), ptr)
+        # ...but is reused by the pool, and survives empty_cache
+        torch.cuda.empty_cache()
+        with torch.cuda.use_mem_pool(pool):
+            z = torch.empty(1024 * 1024, device='cuda')
+        self.assertEqual(z.data_ptr(), ptr)
+
+        with torch.cuda.use_mem_pool(pool):
+            with self.assertRaisesRegex(RuntimeError, "already allocates to a private pool"):
+                with torch.cuda.use_mem_pool(pool):
+                    pass
+
+        reserved = torch.cuda.memory_reserved()
+        del z
+        pool.release()
+        torch.cuda.empty_cache()
+        self.assertLess(torch.cuda.memory_reserved(), reserved)
+
     # Tests for historic illegal memory access, see #17040.
     def test_reduction_gpu_memory_accessing(self):
         x = torch.ones(512, 8, dtype=torch.float32, device='cuda')
@@ -2950,6 +3032,103 @@ torch.cuda.synchronize()
 
         self.assertTrue(a.sum().item() == 3000.)
 
+    @unittest.skipIf((not TEST_CUDA) or
+                     TEST_WITH_ROCM or
+                     int(torch.version.cuda.split(".")[0]) < 11, "CUDA >= 11.0 required for graphs")
+    def test_graph_memory_pool(self):
+        s1 = torch.cuda.Stream()
+
+        with torch.cuda.stream(s1):
+            a = torch.ones((1000,), device="cuda")
+            g = torch.cuda._Graph()
+            g.capture_begin()
+            tmp = a * 2
+            tmp_ptr = tmp.data_ptr()
+            b = tmp + 1
+            del tmp
+            g.capture_end()
+
+            # The temporary's memory belongs to the graph's pool, so it is not
+            # handed out to allocations made after capture.
+            c = torch.empty((1000,), device="cuda")
+            self.assertNotEqual(c.data_ptr(), tmp_ptr)
+
+            # A graph captured into the same pool may reuse it.
+            g2 = torch.cuda._Graph()
+            g2.capture_begin(pool=g.pool())
+            tmp2 = a * 3
+            self.assertEqual(tmp2.data_ptr(), tmp_ptr)
+            g2.capture_end()
+        torch.cuda.current_stream().wait_stream(s1)
+
+        g.replay()
+        self.assertEqual(b.sum().item(), 3000.)
+
+    @unittest.skipIf((not TEST_CUDA) or
+                     TEST_WITH_ROCM or
+                     int(torch.version.cuda.split(".")[0]) < 11, "CUDA >= 11.0 required for graphs")
+    def test_graph_context_manager(self):
+        static_input = torch.ones((1000,), device="cuda")
+        self.assertFalse(torch.cuda.is_current_stream_capturing())
+
+        g = torch.cuda.CUDAGraph()
+        with torch.cuda.graph(g):
+            self.assertTrue(torch.cuda.is_current_stream_capturing())
+            static_output = static_input * 2
+            dropped = torch.nn.functional.dropout(static_input, p=0.5)
+        self.assertFalse(torch.cuda.is_current_stream_capturing())
+
+        static_input.fill_(3.)
+        g.replay()
+        torch.cuda.synchronize()
+        self.assertEqual(static_output.sum().item(), 6000.)
+
+        # each replay draws fresh random numbers
+        first = dropped.clone()
+        g.replay()
+        torch.cuda.synchronize()
+        self.assertNotEqual(first, dropped)
+
+    @unittest.skipIf((not TEST_CUDA) or
+                     TEST_WITH_ROCM or
+                     int(torch.version.cuda.split(".")[0]) < 11, "CUDA >= 11.0 required for graphs")
+    def test_graph_make_graphed_callables(self):
+        torch.manual_seed(5)
+        torch.cuda.manual_seed(5)
+
+        def make_model():
+            return torch.nn.Sequential(torch.nn.Linear(16, 32),
+                                       torch.nn.ReLU(),
+                                       torch.nn.Linear(32, 8)).cuda()
+
+        model_graphed = make_model()
+        model_control = make_model()
+        model_control.load_state_dict(model_graphed.state_dict())
+
+        x = torch.randn(4, 16, device="cuda", requires_grad=True)
+        model_graphed = torch.cuda.make_graphed_callables(model_graphed, (x,))
+
+        for _ in range(3):
+            data = torch.randn(4, 16, device="cuda", requires_grad=True)
+            data_control = data.detach().clone().requires_grad_()
+            out = model_graphed(data)
+            out_control = model_control(data_control)
+            self.assertEqual(out, out_control)
+
+            out.sum().backward()
+            out_control.sum().backward()
+            self.assertEqual(data.grad, data_control.grad)
+            for p, p_control in zip(model_graphed.parameters(), model_control.parameters()):
+                self.assertEqual(p.grad, p_control.grad)
+                p.grad = None
+                p_control.grad = None
+
+        # eval mode falls back to the original forward
+        model_graphed.eval()
+        model_control.eval()
+        data = torch.randn(2, 16, device="cuda")
+        self.assertEqual(model_graphed(data), model_control(data))
+
     @unittest.skipIf((not TEST_CUDA) or
                      TEST_WITH_ROCM or
                      int(torch.version.cuda.split(".")[0]) < 11, "CUDA >= 11.0 required for graphs")
@@ -660,6 +660,33 @@ class TestIndexing(TestCase):
         self.assertEqual(v[:, None, None].shape, (5, 1, 1, 7, 3))
         self.assertEqual(v[..., None].shape, (5, 7, 3, 1))
 
+    def test_basic_indexing_view_geometry(self, device):
+        # tuples of ints, slices, None and Ellipsis compute the view directly,
+        # tensors that require grad still go through select, slice and unsqueeze
+        v = torch.randn(5, 7, 3, device=device)[1:, ::2]
+        ref = v.detach().requires_grad_()
+        indices = [(), (0,), (-1, 2), (1, None, -1), (..., 0), (None, ..., None),
+                   (slice(None), 0), (slice(-3, None), slice(1, 3), 1),
+                   (slice(1, 100, 2), ..., slice(2, 0)), (0, slice(2, None, 3), None, 2),
+                   (slice(10, None), None), (slice(-100, -1), 3, slice(None, None, 2))]
+        for index in indices:
+            result, expected = v[index], ref[index]
+            self.assertEqual(result.shape, expected.shape)
+            self.assertEqual(result.stride(), expected.stride())
+            self.assertEqual(result.storage_offset(), expected.storage_offset())
+            self.assertEqual(result, expected.detach())
+            self.assertIs(result._base, v._base)
+
+        w = v[1, :, None]
+        w.fill_(2)
+        self.assertEqual(v[1], torch.full_like(v[1], 2))
+        with self.assertRaisesRegex(IndexError, "out of bounds for dimension 1"):
+            v[0, 4]
+        with self.assertRaisesRegex(IndexError, "too many indices"):
+            v[0, 0, 0, 0]
+        with self.assertRaisesRegex(ValueError, "step must be greater than zero"):
+            v[0, ::-1]
+
     def test_step(self, device):
         v = torch.arange(10, device=device)
         self.assertEqual(v[::1], v)
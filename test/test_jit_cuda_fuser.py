@@ -1,5 +1,6 @@
 import unittest
 import os
+import tempfile
 
 import torch
 
@@ -807,6 +808,49 @@ class TestCudaFuser(JitTestCase):
         # have been optimized away
         self.assertGraphContainsExactly(t_jit.graph_for(x, y), FUSION_GUARD, 0)
 
+    @unittest.skipIf(not RUN_CUDA, "requires CUDA")
+    @unittest.skipIf(GRAPH_EXECUTOR != ProfilingMode.PROFILING,
+                     "Requires fusion optimization pass to be effective")
+    def test_layer_norm(self):
+        def t(x: torch.Tensor, r: torch.Tensor, w: torch.Tensor, b: torch.Tensor):
+            o = torch.layer_norm(x, [1024], w, b, 1e-5, True)
+            o = o + r
+            o = torch.relu(o)
+            return o
+
+        # rows of this size don't fit in shared memory and take the multi-pass
+        # schedule
+        def t_long_rows(x: torch.Tensor, r: torch.Tensor, w: torch.Tensor, b: torch.Tensor):
+            o = torch.layer_norm(x, [32768], w, b, 1e-5, True)
+            o = o + r
+            return o
+
+        def t_no_affine(x: torch.Tensor, r: torch.Tensor):
+            o = torch.layer_norm(x, [64, 32])
+            o = o * 2.0 + r
+            return o
+
+        for fn, shape in [(t, (4, 16, 1024)), (t_long_rows, (2, 3, 32768))]:
+            x = torch.randn(shape, dtype=torch.float, device="cuda")
+            r = torch.randn(shape, dtype=torch.float, device="cuda")
+            w = torch.randn(shape[-1], dtype=torch.float, device="cuda")
+            b = torch.randn(shape[-1], dtype=torch.float, device="cuda")
+            fn_jit = torch.jit.script(fn)
+            jit_o = fn_jit(x, r, w, b)
+            jit_o = fn_jit(x, r, w, b)
+            o = fn(x, r, w, b)
+            self.assertEqual(o, jit_o, atol=1e-4, rtol=1e-4)
+            self.assertGraphContains(fn_jit.graph_for(x, r, w, b), FUSION_GUARD)
+
+        x = torch.randn(8, 64, 32, dtype=torch.float, device="cuda")
+        r = torch.randn(8, 64, 32, dtype=torch.float, device="cuda")
+        t_no_affine_jit = torch.jit.script(t_no_affine)
+        jit_o = t_no_affine_jit(x, r)
+        jit_o = t_no_affine_jit(x, r)
+        o = t_no_affine(x, r)
+        self.assertEqual(o, jit_o, atol=1e-4, rtol=1e-4)
+        self.assertGraphContains(t_no_affine_jit.graph_for(x, r), FUSION_GUARD)
+
 class TestPassManagerCudaFuser(JitTestCase):
 
     @unittest.skipIf(not RUN_CUDA, "requires CUDA")
@@ -854,6 +898,34 @@ class TestPassManagerCudaFuser(JitTestCase):
         self.assertTrue(torch._C._jit_set_nvfuser_enabled(False))
         self.assertFalse(torch._C._jit_nvfuser_enabled())
 
+    @unittest.skipIf(not RUN_CUDA, "requires CUDA")
+    @unittest.skipIf(GRAPH_EXECUTOR != ProfilingMode.PROFILING,
+                     "Requires fusion optimization pass to be effective")
+    def test_kernel_cache_dir(self):
+        def t(x, y):
+            o = x * y
+            o = o - 5.0
+            return o
+
+        x = torch.randn(4, 8, dtype=torch.float, device="cuda")
+        y = torch.randn(4, 8, dtype=torch.float, device="cuda")
+        with tempfile.TemporaryDirectory() as cache_dir:
+            os.environ['PYTORCH_CUDA_FUSER_CACHE_DIR'] = cache_dir
+            try:
+                # The second script function compiles the same kernel in a
+                # fresh executor, which has to be served from the disk cache.
+                for _ in range(2):
+                    t_jit = torch.jit.script(t)
+                    jit_o = t_jit(x, y)
+                    jit_o = t_jit(x, y)
+                    self.assertEqual(t(x, y), jit_o)
+                    self.assertGraphContains(t_jit.graph_for(x, y), FUSION_GUARD)
+                    entries = os.listdir(cache_dir)
+                    self.assertEqual(len(entries), 1)
+                    self.assertTrue(entries[0].endswith('.bin'))
+            finally:
+                del os.environ['PYTORCH_CUDA_FUSER_CACHE_DIR']
+
 
 if __name__ == '__main__':
     run_tests()
@@ -51,6 +51,22 @@ def texpr_reductions_enabled():
     finally:
         torch._C._jit_set_texpr_reductions_enabled(old)
 
+@contextlib.contextmanager
+def texpr_external_calls_enabled():
+    old = torch._C._jit_set_texpr_external_calls_enabled(True)
+    try:
+        yield
+    finally:
+        torch._C._jit_set_texpr_external_calls_enabled(old)
+
+@contextlib.contextmanager
+def texpr_dynamic_shapes_enabled():
+    old = torch._C._jit_set_texpr_dynamic_shapes_enabled(True)
+    try:
+        yield
+    finally:
+        torch._C._jit_set_texpr_dynamic_shapes_enabled(old)
+
 class TestTEFuser(JitTestCase):
     def setUp(self):
         self.old_cpu_fuser_state = torch._C._jit_can_fuse_on_cpu()
@@ -179,6 +195,60 @@ class TestTEFuser(JitTestCase):
             self.checkScript(func, (a,))
             self.assertLastGraphAllFused()
 
+    def test_mean_amax(self):
+        def func_mean(x):
+            return (x * 2).mean((1, )) + 1
+
+        def func_mean_all(x):
+            return (x * 2).mean() + 1
+
+        def func_amax(x):
+            return (x * 2).amax((0, ), keepdim=True) + 1
+
+        with texpr_reductions_enabled():
+            a = torch.rand(5, 3, dtype=torch.float, device='cpu')
+            for func in (func_mean, func_mean_all, func_amax):
+                self.checkScript(func, (a,))
+                self.assertLastGraphAllFused()
+
+    def test_matmul_epilogue(self):
+        def func_matmul(x, y):
+            return torch.relu(torch.matmul(x, y) * 2)
+
+        def func_linear(x, w, b):
+            return torch.sigmoid(torch.nn.functional.linear(x, w, b) + 1)
+
+        with texpr_external_calls_enabled():
+            x = torch.rand(4, 8, dtype=torch.float, device='cpu')
+            y = torch.rand(8, 5, dtype=torch.float, device='cpu')
+            w = torch.rand(5, 8, dtype=torch.float, device='cpu')
+            b = torch.rand(5, dtype=torch.float, device='cpu')
+            self.checkScript(func_matmul, (x, y))
+            self.assertLastGraphAllFused()
+            self.checkScript(func_linear, (x, w, b))
+            self.assertLastGraphAllFused()
+
+    def test_dynamic_shapes(self):
+        def func(x, y):
+            return (x + y) * torch.sigmoid(x)
+
+        with texpr_dynamic_shapes_enabled():
+            x = torch.rand(4, 8, dtype=torch.float, device='cpu')
+            y = torch.rand(4, 8, dtype=torch.float, device='cpu')
+            scripted = torch.jit.script(func)
+            warmup_forward(scripted, x, y)
+            self.assertAllFused(scripted.graph_for(x, y))
+
+            torch._C._jit_reset_te_kernel_stats()
+            for size in ((7, 8), (4, 3), (7, 8), (4, 8)):
+                x = torch.rand(*size, dtype=torch.float, device='cpu')
+                y = torch.rand(*size, dtype=torch.float, device='cpu')
+                self.assertEqual(scripted(x, y), func(x, y))
+            stats = torch._C._jit_get_te_kernel_stats()
+            self.assertEqual(stats["specialization_misses"], 2)
+            self.assertEqual(stats["specialization_hits"], 1)
+            self.assertEqual(stats["compiles"], 2)
+
     def test_abs_cpu(self):
         self._test_fused_abs()
 
@@ -549,7 +549,8 @@ class TestLinalg(TestCase):
             self.assertEqual(ans_w, actual_w)
             self.assertEqual(abs(ans_v), abs(actual_v))
 
-        shapes = (0, 3, 5)
+        # on CUDA batches of matrices of size up to 32 use cusolver's syevjBatched
+        shapes = (0, 3, 5, 33)
         batches = ((), (3, ), (2, 2))
         uplos = ["U", "L"]
         for shape, batch, uplo in itertools.product(shapes, batches, uplos):
@@ -2626,6 +2627,39 @@ class TestLinalg(TestCase):
         expected = np.linalg.solve(A.cpu().numpy(), b.cpu().numpy())
         self.assertEqual(actual, expected)
 
+    @onlyCPU
+    @skipCPUIfNoLapack
+    @dtypes(torch.float32, torch.float64)
+    @precisionOverride({torch.float32: 1e-3})
+    def test_small_matrices_batched(self, device, dtype):
+        # matrices of size up to 8 use unrolled kernels over a parallel batch loop
+        from torch.testing._internal.common_utils import (random_fullrank_matrix_distinct_singular_value,
+                                                          random_hermitian_pd_matrix)
+        batch = 1000
+        for n in range(1, 9):
+            A = random_fullrank_matrix_distinct_singular_value(n, batch, dtype=dtype).to(device)
+            b = torch.randn(batch, n, 3, dtype=dtype, device=device)
+            A_np, b_np = A.numpy(), b.numpy()
+            self.assertEqual(torch.linalg.solve(A, b), np.linalg.solve(A_np, b_np))
+            self.assertEqual(torch.inverse(A), np.linalg.inv(A_np))
+
+            LU_data, LU_pivots = torch.lu(A)
+            self.assertEqual(torch.lu_solve(b, LU_data, LU_pivots), np.linalg.solve(A_np, b_np))
+            P, L, U = torch.lu_unpack(LU_data, LU_pivots)
+            self.assertEqual(P.matmul(L).matmul(U), A)
+
+            H = random_hermitian_pd_matrix(n, batch, dtype=dtype, device=device)
+            self.assertEqual(torch.cholesky(H), np.linalg.cholesky(H.numpy()))
+            self.assertEqual(torch.cholesky(H, upper=True), np.linalg.cholesky(H.numpy()).swapaxes(-2, -1))
+
+            # errors report the first failing batch like LAPACK
+            A[7, :, -1] = 0
+            with self.assertRaisesRegex(RuntimeError, rf'For batch 7: U\({n},{n}\) is zero'):
+                torch.linalg.solve(A, b)
+            H[5, -1, -1] = -1
+            with self.assertRaisesRegex(RuntimeError, rf'For batch 5: U\({n},{n}\) is zero'):
+                torch.cholesky(H)
+
     @skipCUDAIfNoMagma
     @skipCPUIfNoLapack
     @dtypes(torch.float32, torch.float64, torch.complex64, torch.complex128)
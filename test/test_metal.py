@@ -155,5 +155,41 @@ class TestMetalRewritePass(TestCase):
             prepack_removal=True,
             fuse_clamping_ops=True)
 
+        class Conv2DSigmoid(torch.nn.Module):
+            def __init__(self):
+                super(Conv2DSigmoid, self).__init__()
+                self.weight = torch.nn.Parameter(torch.Tensor(torch.rand(conv_weight_shape)), requires_grad=False)
+                self.bias = torch.nn.Parameter(torch.Tensor(torch.rand(conv_bias_shape)), requires_grad=False)
+                self.strides = strides
+                self.paddings = paddings
+                self.dilations = dilations
+                self.groups = groups
+
+            def forward(self, x):
+                o = F.conv2d(x, self.weight, self.bias,
+                             self.strides, self.paddings, self.dilations, self.groups)
+                o = torch.sigmoid(o)
+                return o
+
+        data_shape = (batch_size, input_channels, height, width)
+        pattern_count_map = {"Tensor = aten::conv2d": -1,
+                             "metal_prepack::conv2d_prepack": -1,
+                             "metal_prepack::conv2d_run": 1,
+                             "aten::sigmoid": 1}
+        TestMetalRewritePass.validate_transformed_module(
+            Conv2DSigmoid(),
+            pattern_count_map,
+            data_shape,
+            prepack_removal=True)
+        pattern_count_map["aten::sigmoid"] = -1
+        pattern_count_map["metal_prepack::conv2d_run"] = -1
+        pattern_count_map["metal_prepack::conv2d_sigmoid_run"] = 1
+        TestMetalRewritePass.validate_transformed_module(
+            Conv2DSigmoid(),
+            pattern_count_map,
+            data_shape,
+            prepack_removal=True,
+            fuse_clamping_ops=True)
+
 if __name__ == "__main__":
     run_tests()
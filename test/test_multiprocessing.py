@@ -334,6 +334,35 @@ class TestMultiprocessing(TestCase):
     def test_fd_pool(self):
         self._test_pool(repeat=TEST_REPEATS)
 
+    @unittest.skipIf(IS_WINDOWS or platform == 'darwin',
+                     "file descriptor strategy is not supported on Windows and macOS")
+    def test_fd_shared_memory_pool(self):
+        mp._set_shared_memory_pool_size(4)
+        try:
+            storage = torch.FloatStorage._new_using_fd(16)
+            self.assertTrue(storage.is_shared())
+            fd, size, pooled = storage._share_fd_()
+            self.assertTrue(pooled)
+            self.assertEqual(size, 16)
+            inode = os.fstat(fd).st_ino
+
+            # The received storage holds a reference on the segment
+            storage._shared_incref()
+            received = torch.FloatStorage._new_shared_fd(fd, size, True)
+            received.fill_(3)
+            self.assertEqual(storage.tolist(), [3] * 16)
+            del storage
+            other = torch.FloatStorage._new_using_fd(16)
+            self.assertNotEqual(os.fstat(other._get_shared_fd()).st_ino, inode)
+
+            # Freed by both sides, the segment is reused
+            del received
+            reused = torch.FloatStorage._new_using_fd(12)
+            self.assertEqual(os.fstat(reused._get_shared_fd()).st_ino, inode)
+            self.assertEqual(reused.tolist(), [3] * 12)
+        finally:
+            mp._set_shared_memory_pool_size(0)
+
     @unittest.skipIf(TEST_WITH_ASAN,
                      "seems to hang with ASAN, see https://github.com/pytorch/pytorch/issues/5326")
     def test_fs_sharing(self):
@@ -0,0 +1,128 @@
+import torch
+import torch.nn.functional as F
+from torch.testing._internal.common_utils import TestCase, run_tests
+
+
+def random_components(lengths, *inner_size):
+    return [torch.randn(length, *inner_size) for length in lengths]
+
+
+def padded(components, padding=0.):
+    max_length = max(c.size(0) for c in components)
+    result = torch.full((len(components), max_length) + components[0].shape[1:], padding)
+    for i, c in enumerate(components):
+        result[i, :c.size(0)] = c
+    return result
+
+
+class TestNestedTensor(TestCase):
+    def assertComponentsEqual(self, nt, components):
+        self.assertTrue(nt.is_nested)
+        actual = nt.unbind()
+        self.assertEqual(len(actual), len(components))
+        for a, c in zip(actual, components):
+            self.assertFalse(a.is_nested)
+            self.assertEqual(a, c)
+
+    def test_construction(self):
+        components = random_components([2, 5, 0, 3], 4)
+        nt = torch.nested.nested_tensor(components)
+        self.assertTrue(nt.is_nested)
+        self.assertFalse(components[0].is_nested)
+        self.assertEqual(nt.size(), (4, 5, 4))
+        self.assertEqual(nt.dim(), 3)
+        self.assertEqual(nt.numel(), 10 * 4)
+        self.assertEqual(nt.dtype, torch.float)
+        self.assertComponentsEqual(nt, components)
+
+        with self.assertRaisesRegex(RuntimeError, "only differ in the size of their first dimension"):
+            torch.nested.nested_tensor([torch.randn(2, 4), torch.randn(2, 3)])
+        with self.assertRaisesRegex(RuntimeError, "non-empty list"):
+            torch.nested.nested_tensor([])
+        with self.assertRaisesRegex(RuntimeError, "strides"):
+            nt.stride()
+
+    def test_padded_round_trip(self):
+        components = random_components([3, 1, 4], 2, 3)
+        nt = torch.nested.nested_tensor(components)
+        self.assertEqual(nt.to_padded_tensor(), padded(components))
+        self.assertEqual(torch.to_padded_tensor(nt, -1.), padded(components, -1.))
+
+        back = torch.nested.from_padded(padded(components), [3, 1, 4])
+        self.assertComponentsEqual(back, components)
+        with self.assertRaisesRegex(RuntimeError, "lengths between 0 and 4"):
+            torch.nested.from_padded(padded(components), [3, 1, 5])
+
+    def test_unary(self):
+        components = random_components([2, 4, 1], 3)
+        nt = torch.nested.nested_tensor(components)
+        for op in (torch.relu, F.gelu, torch.tanh, torch.sigmoid, torch.neg, torch.exp, torch.abs):
+            self.assertComponentsEqual(op(nt), [op(c) for c in components])
+
+        nt.relu_()
+        self.assertComponentsEqual(nt, [c.relu() for c in components])
+
+    def test_binary(self):
+        components = random_components([2, 4, 1], 3)
+        others = random_components([2, 4, 1], 3)
+        nt = torch.nested.nested_tensor(components)
+        other = torch.nested.nested_tensor(others)
+        bias = torch.randn(3)
+
+        self.assertComponentsEqual(nt + other, [c + o for c, o in zip(components, others)])
+        self.assertComponentsEqual(nt - other, [c - o for c, o in zip(components, others)])
+        self.assertComponentsEqual(nt * other, [c * o for c, o in zip(components, others)])
+        self.assertComponentsEqual(nt / bias, [c / bias for c in components])
+        self.assertComponentsEqual(2 * nt, [2 * c for c in components])
+        self.assertComponentsEqual(nt + 1, [c + 1 for c in components])
+        self.assertComponentsEqual(bias - nt, [bias - c for c in components])
+        self.assertComponentsEqual(nt + bias.view(1, 1, 3), [c + bias for c in components])
+
+        with self.assertRaisesRegex(RuntimeError, "same component lengths"):
+            nt + torch.nested.nested_tensor(random_components([4, 2, 1], 3))
+        with self.assertRaisesRegex(RuntimeError, "inner dimensions"):
+            nt + torch.randn(4, 3)
+
+        nt.add_(other).mul_(bias)
+        self.assertComponentsEqual(nt, [(c + o) * bias for c, o in zip(components, others)])
+
+    def test_linear_layer_norm(self):
+        components = random_components([3, 7, 2], 8)
+        nt = torch.nested.nested_tensor(components)
+        linear = torch.nn.Linear(8, 5)
+        layer_norm = torch.nn.LayerNorm(5)
+        with torch.no_grad():
+            out = layer_norm(F.relu(linear(nt)))
+            self.assertComponentsEqual(out, [layer_norm(F.relu(linear(c))) for c in components])
+
+        with self.assertRaisesRegex(RuntimeError, "inner dimensions"):
+            F.layer_norm(nt, (7, 8))
+
+    def test_softmax(self):
+        components = random_components([3, 5, 1], 4)
+        nt = torch.nested.nested_tensor(components)
+        self.assertComponentsEqual(nt.softmax(-1), [c.softmax(-1) for c in components])
+        # Over the ragged dimension, the padding doesn't take part
+        self.assertComponentsEqual(nt.softmax(1), [c.softmax(0) for c in components])
+        with self.assertRaisesRegex(RuntimeError, "batch dimension"):
+            nt.softmax(0)
+
+    def test_clone(self):
+        components = random_components([2, 3], 4)
+        nt = torch.nested.nested_tensor(components)
+        cloned = nt.clone()
+        nt.mul_(0)
+        self.assertComponentsEqual(cloned, components)
+        with self.assertRaisesRegex(RuntimeError, "unbound along their batch dimension"):
+            nt.unbind(1)
+
+    def test_repr(self):
+        nt = torch.nested.nested_tensor([torch.zeros(1, 2), torch.ones(2, 2)])
+        self.assertExpectedInline(repr(nt), """\
+nested_tensor([tensor([[0., 0.]]),
+               tensor([[1., 1.],
+                       [1., 1.]])])""")
+
+
+if __name__ == '__main__':
+    run_tests()
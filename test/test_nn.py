@@ -37,7 +37,7 @@ from torch.testing import get_all_fp_dtypes
 from torch.testing._internal.common_utils import freeze_rng_state, run_tests, TestCase, skipIfNoLapack, skipIfRocm, \
     TEST_NUMPY, TEST_SCIPY, TEST_WITH_ROCM, download_file, \
     get_function_arglist, load_tests, repeat_test_for_types, ALL_TENSORTYPES, \
-    ALL_TENSORTYPES2, suppress_warnings, TemporaryFileName, TEST_WITH_UBSAN, IS_PPC
+    ALL_TENSORTYPES2, suppress_warnings, TemporaryFileName, TEST_WITH_UBSAN, IS_PPC, DeterministicGuard
 from torch.testing._internal.common_cuda import TEST_CUDA, TEST_MULTIGPU, TEST_CUDNN, TEST_CUDNN_VERSION
 from torch.testing._internal.common_nn import NNTestCase, NewModuleTest, CriterionTest, \
     module_tests, criterion_tests, loss_reference_fns, \
@@ -5277,6 +5277,27 @@ class TestNN(NNTestCase):
         self.assertEqual(res_cpu, res_gpu, atol=1e-4, rtol=0)
         self.assertEqual(grad_cpu, grad_gpu, atol=1e-4, rtol=0)
 
+    def test_CTCLoss_repeated_labels_cpu(self):
+        # repeated labels disable the skip transition of the alpha and beta recursions, and the
+        # lengths are not multiples of the vector width
+        target_lengths = [13, 7, 2]
+        input_lengths = [41, 30, 17]
+        targets = torch.tensor([1, 1, 2, 2, 2, 3, 1, 1, 4, 4, 4, 4, 2,
+                                5, 5, 1, 5, 5, 3, 3, 2, 2], dtype=torch.long)
+        for transposed in (False, True):
+            if transposed:
+                # non-contiguous log_probs
+                log_probs = torch.randn(41, 3, 6, dtype=torch.double).transpose(0, 1).contiguous().transpose(0, 1)
+            else:
+                log_probs = torch.randn(41, 3, 6, dtype=torch.double)
+            log_probs = log_probs.log_softmax(2).requires_grad_()
+            res = torch.nn.functional.ctc_loss(log_probs, targets, input_lengths, target_lengths, reduction='sum')
+            expected = ctcloss_reference(log_probs, targets, input_lengths, target_lengths, reduction='sum')
+            self.assertEqual(res, expected)
+            grad, = torch.autograd.grad(res, log_probs)
+            expected_grad, = torch.autograd.grad(expected, log_probs)
+            self.assertEqual(grad, expected_grad)
+
     @unittest.skipIf(not TEST_CUDA, 'CUDA not available')
     def test_CTCLoss_zero_infinity(self):
         target_lengths = [60, 25, 20]
@@ -5540,6 +5561,20 @@ class TestNN(NNTestCase):
 
             (hx + cx).sum().backward()
 
+    def test_RNN_cpu_inference(self):
+        # without autograd, CPU LSTMs and GRUs use fused cell kernels and a packed
+        # recurrent weight; compare against the differentiable path
+        for dtype, module, bidirectional, packed in product((torch.float, torch.double), (nn.LSTM, nn.GRU),
+                                                            (False, True), (False, True)):
+            rnn = module(10, 19, num_layers=2, bidirectional=bidirectional).to(dtype)
+            input = torch.randn(7, 5, 10, dtype=dtype)
+            if packed:
+                input = rnn_utils.pack_padded_sequence(input, [7, 7, 5, 3, 1])
+            expected = rnn(input)
+            with torch.no_grad():
+                actual = rnn(input)
+            self.assertEqual(actual, expected)
+
     @unittest.skipIf(not TEST_CUDA, 'CUDA not available')
     def test_pack_sequence_batch_sizes_throw(self):
         with self.assertRaisesRegex(ValueError, r"batch_sizes should always be on CPU"):
@@ -7518,6 +7553,40 @@ class TestNN(NNTestCase):
         test_pixel_shuffle_unshuffle_4D()
         test_pixel_shuffle_unshuffle_5D()
 
+    def test_channels_last_preserved_cpu(self):
+        # Ops whose CPU kernels keep channels last inputs in channels last, and
+        # agree with their NCHW results
+        ops = [
+            ('relu', F.relu),
+            ('hardtanh', F.hardtanh),
+            ('batch_norm', lambda x: F.batch_norm(x, torch.zeros(8), torch.ones(8))),
+            ('group_norm', lambda x: F.group_norm(x, 4, torch.randn(8), torch.randn(8))),
+            ('group_norm_no_affine', lambda x: F.group_norm(x, 2)),
+            ('max_pool2d', lambda x: F.max_pool2d(x, 2)),
+            ('avg_pool2d', lambda x: F.avg_pool2d(x, 2)),
+            ('adaptive_avg_pool2d', lambda x: F.adaptive_avg_pool2d(x, 3)),
+            ('upsample_nearest2d', lambda x: F.interpolate(x, scale_factor=2, mode='nearest')),
+            ('upsample_bilinear2d', lambda x: F.interpolate(x, scale_factor=2, mode='bilinear', align_corners=False)),
+            ('pixel_shuffle', lambda x: F.pixel_shuffle(x, 2)),
+            ('pixel_unshuffle', lambda x: F.pixel_unshuffle(x, 2)),
+        ]
+        input = torch.randn(2, 8, 6, 10)
+        input_cl = input.contiguous(memory_format=torch.channels_last)
+        for name, op in ops:
+            torch.manual_seed(0)
+            expected = op(input)
+            torch.manual_seed(0)
+            out = op(input_cl)
+            self.assertTrue(out.is_contiguous(memory_format=torch.channels_last),
+                            msg='{} does not keep channels last'.format(name))
+            self.assertEqual(out, expected, msg=name)
+
+        input = torch.randn(2, 6, 3, 4, 5)
+        input_cl = input.contiguous(memory_format=torch.channels_last_3d)
+        out = F.group_norm(input_cl, 3)
+        self.assertTrue(out.is_contiguous(memory_format=torch.channels_last_3d))
+        self.assertEqual(out, F.group_norm(input, 3))
+
     def test_elu_inplace_view(self):
         v = torch.tensor([1.0, -1.0, 1.0, -1.0], requires_grad=True)
 
@@ -7842,6 +7911,59 @@ class TestNN(NNTestCase):
         grad = grad.permute(0, 2, 1, 3)
         run_test(input, grad)
 
+    def test_batchnorm_nhwc_cpu(self):
+        def run_test(module, input, training):
+            c = input.size(1)
+            mod = module(c).double()
+            mod.weight.data.uniform_()
+            mod.bias.data.uniform_()
+            mod.running_mean.uniform_()
+            mod.running_var.uniform_(1, 2)
+            ref_mod = module(c).double()
+            ref_mod.load_state_dict(mod.state_dict())
+            mod.train(training)
+            ref_mod.train(training)
+
+            input = input.detach().requires_grad_()
+            ref_input = input.detach().clone().contiguous().requires_grad_(True)
+            grad = torch.randn_like(ref_input)
+            out = mod(input)
+            out.backward(grad)
+            ref_out = ref_mod(ref_input)
+            ref_out.backward(grad)
+
+            self.assertTrue(out.is_contiguous(memory_format=torch.channels_last) or
+                            out.is_contiguous(memory_format=torch.channels_last_3d))
+            self.assertEqual(out, ref_out)
+            self.assertEqual(mod.running_mean, ref_mod.running_mean)
+            self.assertEqual(mod.running_var, ref_mod.running_var)
+            self.assertEqual(mod.weight.grad, ref_mod.weight.grad)
+            self.assertEqual(mod.bias.grad, ref_mod.bias.grad)
+            self.assertEqual(input.grad, ref_input.grad)
+
+        for training in (True, False):
+            for c in (3, 8, 21):
+                input = torch.randn(4, c, 5, 6, dtype=torch.double)
+                run_test(nn.BatchNorm2d, input.contiguous(memory_format=torch.channels_last), training)
+                input = torch.randn(2, c, 3, 4, 5, dtype=torch.double)
+                run_test(nn.BatchNorm3d, input.contiguous(memory_format=torch.channels_last_3d), training)
+
+    def test_batch_norm_relu_inference(self):
+        for dtype in (torch.float, torch.double):
+            c = 19
+            weight = torch.randn(c, dtype=dtype)
+            bias = torch.randn(c, dtype=dtype)
+            running_mean = torch.randn(c, dtype=dtype)
+            running_var = torch.rand(c, dtype=dtype) + 1
+            for input in (torch.randn(4, c, dtype=dtype),
+                          torch.randn(4, c, 5, 6, dtype=dtype),
+                          torch.randn(4, c, 5, 6, dtype=dtype).contiguous(memory_format=torch.channels_last),
+                          torch.randn(4, c, 6, 5, dtype=dtype).transpose(2, 3)):
+                for w, b in ((weight, bias), (None, None)):
+                    out = torch._batch_norm_relu_inference(input, w, b, running_mean, running_var, 1e-5)
+                    ref_out = F.relu(F.batch_norm(input, running_mean, running_var, w, b, False, 0., 1e-5))
+                    self.assertEqual(out, ref_out)
+
     @unittest.skipIf(not TEST_CUDA, "CUDA unavailable")
     def test_batchnorm_cudnn_half(self):
         # THNN
@@ -8790,6 +8912,36 @@ class TestNN(NNTestCase):
 
                     test(N, C, D, H, W, mode, padding_mode, align_corners)
 
+    def test_grid_sample_3d_matches_2d(self):
+        # With a single input plane and align_corners=True, every z samples
+        # that plane, so 3D sampling reduces to 2D sampling. The outputs are
+        # large enough for the 3D kernel to split the planes across threads.
+        for mode, padding_mode in itertools.product(('bilinear', 'nearest'), ('zeros', 'border', 'reflection')):
+            input = torch.randn(2, 3, 20, 24)
+            for layout in ('contiguous', 'planar', 'strided'):
+                if layout == 'contiguous':
+                    grid = torch.rand(2, 16, 40, 30, 3) * 2.4 - 1.2
+                elif layout == 'planar':
+                    grid = (torch.rand(2, 3, 16, 40, 30) * 2.4 - 1.2).permute(0, 2, 3, 4, 1)
+                else:
+                    grid = (torch.rand(2, 16, 40, 61, 3) * 2.4 - 1.2)[:, :, :, ::2]
+                input_2d = input.clone().requires_grad_()
+                grid_2d = grid[..., :2].reshape(2, 16 * 40, 30, 2).detach().requires_grad_()
+                out_2d = F.grid_sample(input_2d, grid_2d, mode=mode, padding_mode=padding_mode, align_corners=True)
+                out_2d = out_2d.view(2, 3, 16, 40, 30)
+
+                input_3d = input.unsqueeze(2).requires_grad_()
+                grid_3d = grid.detach().requires_grad_()
+                out_3d = F.grid_sample(input_3d, grid_3d, mode=mode, padding_mode=padding_mode, align_corners=True)
+                self.assertEqual(out_3d, out_2d)
+
+                gradients = torch.randn_like(out_3d)
+                out_2d.backward(gradients)
+                out_3d.backward(gradients)
+                self.assertEqual(input_3d.grad.squeeze(2), input_2d.grad)
+                self.assertEqual(grid_3d.grad[..., :2].reshape_as(grid_2d), grid_2d.grad)
+                self.assertEqual(grid_3d.grad[..., 2], torch.zeros(2, 16, 40, 30))
+
     def test_affine_grid(self):
         # test known input on CPU
         input = torch.arange(1., 7).view(1, 2, 3)
@@ -9095,6 +9247,46 @@ class TestNN(NNTestCase):
                     input = torch.randn(2, 2, 2, 2, requires_grad=True)
                     gradcheck(lambda x: F.interpolate(x, out_size, **kwargs), [input])
 
+    def test_upsampling_antialias(self):
+        # upsampling does not alias, the result matches plain bilinear interpolation
+        in_t = torch.randn(2, 3, 7, 5)
+        out_t = F.interpolate(in_t, size=(17, 12), mode='bilinear', align_corners=False, antialias=True)
+        expected_out_t = F.interpolate(in_t, size=(17, 12), mode='bilinear', align_corners=False)
+        self.assertEqual(out_t, expected_out_t)
+
+        # downsampling a checkerboard averages it out instead of picking every other pixel
+        in_t = (torch.arange(16).view(1, 1, 1, 16) % 2).float().expand(1, 1, 16, 16)
+        out_t = F.interpolate(in_t, size=(8, 8), mode='bilinear', align_corners=False, antialias=True)
+        self.assertEqual(out_t[..., 1:-1], torch.full((1, 1, 8, 6), 0.5))
+
+        for mode in ['bilinear', 'bicubic']:
+            kwargs = dict(mode=mode, align_corners=False, antialias=True)
+            for size in [(4, 6), (9, 3), (23, 23), (1, 1)]:
+                in_t = torch.randn(2, 3, 11, 13, dtype=torch.double)
+                # constant images stay constant
+                out_t = F.interpolate(torch.ones_like(in_t), size=size, **kwargs)
+                self.assertEqual(out_t, torch.ones(2, 3, *size, dtype=torch.double))
+
+                out_t = F.interpolate(in_t, size=size, **kwargs)
+                out_float_t = F.interpolate(in_t.float(), size=size, **kwargs)
+                self.assertEqual(out_float_t, out_t, atol=1e-5, rtol=0, exact_dtype=False)
+
+                in_cl_t = in_t.contiguous(memory_format=torch.channels_last)
+                out_cl_t = F.interpolate(in_cl_t, size=size, **kwargs)
+                self.assertTrue(out_cl_t.is_contiguous(memory_format=torch.channels_last))
+                self.assertEqual(out_cl_t, out_t)
+
+                in_uint8_t = torch.randint(0, 256, (2, 3, 11, 13), dtype=torch.uint8)
+                expected_out_t = F.interpolate(in_uint8_t.double(), size=size, **kwargs)
+                expected_out_t = expected_out_t.round().clamp(0, 255)
+                for memory_format in [torch.contiguous_format, torch.channels_last]:
+                    out_t = F.interpolate(in_uint8_t.contiguous(memory_format=memory_format), size=size, **kwargs)
+                    self.assertEqual(out_t.dtype, torch.uint8)
+                    self.assertEqual(out_t, expected_out_t, atol=1, rtol=0, exact_dtype=False)
+
+        with self.assertRaisesRegex(ValueError, "Anti-alias option is only supported"):
+            F.interpolate(torch.randn(1, 1, 4), size=2, mode='linear', align_corners=False, antialias=True)
+
     def test_upsampling_not_recompute_scale_factor(self):
         # test output against known input: result must match opencv
         in_t = torch.arange(8.).view(1, 2, 2, 2)
@@ -9274,6 +9466,26 @@ class TestNN(NNTestCase):
         expected = m(inp.view(6, 5)).view(2, 3, 8)
         self.assertEqual(expected, m(inp))
 
+    def test_linear_activation(self):
+        weight = torch.randn(40, 30)
+        bias = torch.randn(40)
+        # the last input is large enough to take several row blocks
+        for inp in (torch.randn(7, 30), torch.randn(2, 3, 30), torch.randn(30, 7).t(), torch.randn(3000, 30)):
+            for b in (bias, None):
+                for activation, fn in (("relu", F.relu), ("gelu", F.gelu)):
+                    out = torch._linear_activation(inp, weight, b, activation)
+                    self.assertEqual(out, fn(F.linear(inp, weight, b)))
+
+        # autograd takes the unfused path
+        inp = torch.randn(7, 30, requires_grad=True)
+        torch._linear_activation(inp, weight, bias, "gelu").sum().backward()
+        ref_inp = inp.detach().requires_grad_()
+        F.gelu(F.linear(ref_inp, weight, bias)).sum().backward()
+        self.assertEqual(inp.grad, ref_inp.grad)
+
+        with self.assertRaisesRegex(RuntimeError, "activation"):
+            torch._linear_activation(inp, weight, bias, "tanh")
+
     def test_bilinear(self):
         module = nn.Bilinear(10, 10, 8)
         input1 = torch.randn(4, 10, requires_grad=True)
@@ -9688,6 +9900,35 @@ class TestNN(NNTestCase):
         self.assertEqual(input.grad.dtype, dtype)
         self.assertEqual(input.grad, inputf.grad.to(dtype), atol=0.1, rtol=0)
 
+    def test_softmax_non_last_dim_cpu(self):
+        # inner sizes below, at and above the vector width, with tails
+        for shape, dim in [((2, 3, 5), 1), ((4, 7, 13, 1), 1), ((3, 300, 33), 1),
+                           ((2, 5, 129), 0), ((1, 2, 1000), 1)]:
+            x = torch.randn(*shape, dtype=torch.double)
+            for dtype in [torch.float, torch.double]:
+                for fn in [F.softmax, F.log_softmax]:
+                    out = fn(x.to(dtype), dim=dim)
+                    expected = fn(x.transpose(dim, -1), dim=-1).transpose(dim, -1)
+                    self.assertEqual(out, expected.to(dtype))
+
+    def test_scaled_masked_softmax(self):
+        x = torch.randn(2, 3, 5, 7, dtype=torch.double)
+        for mask_shape in [(2, 3, 5, 7), (2, 1, 1, 7), (5, 7), (7,), (2, 3, 5, 1)]:
+            mask = torch.randn(*mask_shape, dtype=torch.double)
+            for dim in [-1, 1]:
+                for dtype in [torch.float, torch.double]:
+                    out = torch._scaled_masked_softmax(x.to(dtype), mask.to(dtype), 0.125, dim)
+                    expected = F.softmax(x * 0.125 + mask, dim=dim)
+                    self.assertEqual(out, expected.to(dtype))
+
+        mask = torch.randn(2, 1, 1, 7, dtype=torch.double, requires_grad=True)
+        x.requires_grad_()
+        gradcheck(lambda x, mask: torch._scaled_masked_softmax(x, mask, 0.5, -1), (x, mask))
+        gradgradcheck(lambda x, mask: torch._scaled_masked_softmax(x, mask, 0.5, -1), (x, mask))
+
+        with self.assertRaisesRegex(RuntimeError, "not broadcastable"):
+            torch._scaled_masked_softmax(torch.randn(2, 7), torch.randn(3, 7), 1.0, -1)
+
     def test_adaptive_log_softmax(self):
         # args validation
         with self.assertRaises(ValueError):
@@ -11414,12 +11655,103 @@ class TestNNDeviceType(NNTestCase):
     def test_LayerNorm_general(self, device):
         self._test_LayerNorm_general(device)
 
-        if self.device_type == 'cuda':
+        if self.device_type in ['cpu', 'cuda']:
             self._test_LayerNorm_general(device, dtype=torch.bfloat16)
 
         if self.device_type == 'cuda':
             self._test_LayerNorm_cuda_half(device)
 
+    @onlyCUDA
+    @dtypes(torch.float, torch.double)
+    def test_LayerNorm_row_sizes(self, device, dtype):
+        # Rows are normalized by a warp, a block or the unfused kernels
+        # depending on their size
+        for N in (1, 33, 1024, 1025, 4096, 8192, 8193):
+            x = torch.randn(7, N, dtype=dtype, requires_grad=True)
+            weight = torch.randn(N, dtype=dtype, requires_grad=True)
+            bias = torch.randn(N, dtype=dtype, requires_grad=True)
+            x_cuda, weight_cuda, bias_cuda = (
+                t.detach().to(device).requires_grad_() for t in (x, weight, bias))
+            out = F.layer_norm(x, (N,), weight, bias)
+            out_cuda = F.layer_norm(x_cuda, (N,), weight_cuda, bias_cuda)
+            self.assertEqual(out_cuda, out)
+            grad = torch.randn_like(out)
+            out.backward(grad)
+            out_cuda.backward(grad.to(device))
+            self.assertEqual(x_cuda.grad, x.grad)
+            self.assertEqual(weight_cuda.grad, weight.grad)
+            self.assertEqual(bias_cuda.grad, bias.grad)
+
+    @onlyCUDA
+    @dtypes(torch.half, torch.float, torch.double)
+    def test_fused_dropout_add_layer_norm(self, device, dtype):
+        p = 0.8
+        for N, with_residual in itertools.product((64, 1000, 4096, 10000), (False, True)):
+            x = torch.randn(16, 3, N, device=device, dtype=dtype, requires_grad=True)
+            residual = torch.randn(16, 3, N, device=device, dtype=dtype,
+                                   requires_grad=True) if with_residual else None
+            weight = torch.randn(N, device=device, dtype=dtype, requires_grad=True)
+            bias = torch.randn(N, device=device, dtype=dtype, requires_grad=True)
+            out, pre_norm, mask, mean, rstd = torch._fused_dropout_add_layer_norm(
+                x, residual, (N,), weight, bias, p, 1e-5)
+            self.assertEqual(mask.dtype, torch.uint8)
+            self.assertEqual(mean.shape, (16, 3, 1))
+            self.assertEqual(mask.double().mean().item(), p, atol=0.05, rtol=0)
+
+            inputs = [x, weight, bias] + ([residual] if with_residual else [])
+            inputs_ref = [t.detach().double().requires_grad_() for t in inputs]
+            pre_norm_ref = inputs_ref[0] * mask.double() / p
+            if with_residual:
+                pre_norm_ref = pre_norm_ref + inputs_ref[3]
+            out_ref = F.layer_norm(pre_norm_ref, (N,), inputs_ref[1], inputs_ref[2])
+            atol, rtol = (1e-2, 1e-2) if dtype == torch.half else (None, None)
+            self.assertEqual(pre_norm, pre_norm_ref, atol=atol, rtol=rtol, exact_dtype=False)
+            self.assertEqual(out, out_ref, atol=atol, rtol=rtol, exact_dtype=False)
+
+            grad_out = torch.randn_like(out)
+            grad_pre_norm = torch.randn_like(pre_norm)
+            torch.autograd.backward([out, pre_norm], [grad_out, grad_pre_norm])
+            torch.autograd.backward([out_ref, pre_norm_ref], [grad_out.double(), grad_pre_norm.double()])
+            atol, rtol = (5e-2, 1e-2) if dtype == torch.half else (None, None)
+            for t, t_ref in zip(inputs, inputs_ref):
+                self.assertEqual(t.grad, t_ref.grad, atol=atol, rtol=rtol, exact_dtype=False)
+
+    @onlyOnCPUAndCUDA
+    @dtypes(torch.float, torch.double)
+    def test_fused_dropout_packed(self, device, dtype):
+        p = 0.7
+        for shape in ((1,), (13,), (64, 1000), (3, 1001, 7)):
+            x = torch.randn(shape, device=device, dtype=dtype, requires_grad=True)
+            out, mask = torch._fused_dropout_packed(x, p)
+            numel = x.numel()
+            self.assertEqual(mask.dtype, torch.uint8)
+            self.assertEqual(mask.shape, ((numel + 7) // 8,))
+            bits = torch.arange(8, device=device, dtype=torch.uint8)
+            keep = (mask.unsqueeze(-1) >> bits) & 1
+            keep = keep.flatten()[:numel].view(shape).to(dtype)
+            self.assertEqual(out, x * keep / p)
+            if numel > 1000:
+                self.assertEqual(keep.mean().item(), p, atol=0.02, rtol=0)
+
+            grad = torch.randn_like(out)
+            out.backward(grad)
+            self.assertEqual(x.grad, grad * keep / p)
+
+        x = torch.randn(5, 4, device=device, dtype=torch.double, requires_grad=True)
+        mask = torch.full((3,), 0xa5, device=device, dtype=torch.uint8)
+        _assertGradAndGradgradChecks(self, lambda x: torch._masked_scale_packed(x, mask, 2.), (x,))
+        if self.device_type == 'cpu':
+            # the mask only depends on the seed, not on the number of threads
+            x = torch.randn(100000, device=device, dtype=dtype)
+            num_threads = torch.get_num_threads()
+            masks = []
+            for threads in (1, 4):
+                torch.set_num_threads(threads)
+                torch.manual_seed(0)
+                masks.append(torch._fused_dropout_packed(x, p)[1])
+            torch.set_num_threads(num_threads)
+            self.assertEqual(masks[0], masks[1])
+
     @onlyOnCPUAndCUDA
     def test_GroupNorm_general(self, device):
         self._test_GroupNorm_general(device)
@@ -11427,6 +11759,39 @@ class TestNNDeviceType(NNTestCase):
         if self.device_type == 'cuda':
             self._test_GroupNorm_cuda_half()
 
+    @onlyCPU
+    @dtypes(torch.float, torch.double)
+    def test_GroupNorm_nhwc(self, device, dtype):
+        def helper(input, groups):
+            c = input.size(1)
+            mod = torch.nn.GroupNorm(groups, c).to(device=device, dtype=dtype)
+            mod.weight.data.uniform_()
+            mod.bias.data.uniform_()
+            ref_mod = torch.nn.GroupNorm(groups, c).to(device=device, dtype=dtype)
+            ref_mod.load_state_dict(mod.state_dict())
+
+            input = input.detach().requires_grad_()
+            ref_input = input.detach().clone().contiguous().requires_grad_(True)
+            grad = torch.randn_like(ref_input)
+            out = mod(input)
+            out.backward(grad)
+            ref_out = ref_mod(ref_input)
+            ref_out.backward(grad)
+
+            self.assertEqual(out, ref_out)
+            self.assertEqual(mod.weight.grad, ref_mod.weight.grad)
+            self.assertEqual(mod.bias.grad, ref_mod.bias.grad)
+            self.assertTrue(input.grad.is_contiguous(memory_format=torch.channels_last) or
+                            input.grad.is_contiguous(memory_format=torch.channels_last_3d))
+            self.assertEqual(input.grad, ref_input.grad)
+
+        input = torch.randn(2, 12, 5, 6, dtype=dtype, device=device)
+        helper(input.contiguous(memory_format=torch.channels_last), 3)
+        input = torch.randn(1, 200, 4, 4, dtype=dtype, device=device)
+        helper(input.contiguous(memory_format=torch.channels_last), 8)
+        input = torch.randn(2, 12, 3, 4, 5, dtype=dtype, device=device)
+        helper(input.contiguous(memory_format=torch.channels_last_3d), 4)
+
     def test_GroupNorm_raises_error_if_one_value_per_group(self, device):
         x = torch.rand(10)[None, :, None]
         with self.assertRaises(ValueError):
@@ -12088,8 +12453,8 @@ class TestNNDeviceType(NNTestCase):
                 with self.assertRaisesRegex(RuntimeError, "not implemented"):
                     output = module(input)
 
-    @onlyCUDA
     @dtypesIfCUDA(torch.half, torch.float, torch.double)
+    @dtypes(torch.float, torch.double)
     def test_avg_pool2d_nhwc(self, device, dtype):
         def helper(n, c, h, w, kernel_size, stride=None,
                    count_include_pad=True, divisor_override=None, padding=0):
@@ -12215,8 +12580,8 @@ class TestNNDeviceType(NNTestCase):
         helper(1, 100000, 32, 32, ks=4)
         helper(1, 100000, 1, 4, ks=(1, 4))  # test for max_pool1d
 
-    @onlyCUDA
     @dtypesIfCUDA(torch.half, torch.float, torch.double)
+    @dtypes(torch.float, torch.double)
     def test_max_pool2d_nhwc(self, device, dtype):
         def helper(n, c, h, w, kernel_size, stride=None):
             if stride is None:
@@ -12247,6 +12612,35 @@ class TestNNDeviceType(NNTestCase):
         helper(10, 512, 31, 31, 3, stride=2)
         helper(1, 129, 8, 8, 3, stride=2)
 
+    @onlyCPU
+    @dtypes(torch.float, torch.double)
+    def test_pool3d_ndhwc(self, device, dtype):
+        def helper(pool, ref_pool, n, c, d, h, w):
+            input = torch.randn(n, c, d, h, w, dtype=dtype, device=device)
+            input = input.contiguous(memory_format=torch.channels_last_3d).requires_grad_()
+            ref_input = input.detach().clone().contiguous().requires_grad_(True)
+
+            out = pool(input)
+            ref_out = ref_pool(ref_input)
+            grad = torch.randn_like(ref_out)
+            out.backward(grad)
+            ref_out.backward(grad)
+
+            self.assertTrue(out.is_contiguous(memory_format=torch.channels_last_3d))
+            self.assertTrue(ref_out.is_contiguous())
+            self.assertEqual(out, ref_out)
+            self.assertEqual(input.grad, ref_input.grad)
+
+        for c in (3, 8, 129):
+            helper(torch.nn.MaxPool3d(2), torch.nn.MaxPool3d(2), 2, c, 6, 6, 6)
+            helper(torch.nn.MaxPool3d(3, 2, padding=1, dilation=2), torch.nn.MaxPool3d(3, 2, padding=1, dilation=2),
+                   2, c, 7, 8, 9)
+            helper(torch.nn.AvgPool3d(3, 2, padding=1), torch.nn.AvgPool3d(3, 2, padding=1), 2, c, 7, 8, 9)
+            helper(torch.nn.AvgPool3d(3, 2, padding=1, count_include_pad=False),
+                   torch.nn.AvgPool3d(3, 2, padding=1, count_include_pad=False), 2, c, 7, 8, 9)
+            helper(torch.nn.AvgPool3d(2, divisor_override=3), torch.nn.AvgPool3d(2, divisor_override=3),
+                   2, c, 6, 6, 6)
+
     @onlyCUDA
     def test_max_pool2d_indices(self, device):
         def helper(n, c, h, w, ks):
@@ -12294,6 +12688,26 @@ class TestNNDeviceType(NNTestCase):
         fn = fn_wrapper(device)
         _assertGradAndGradgradChecks(self, fn, (weight, ))
 
+    @onlyCUDA
+    @dtypes(torch.float, torch.double, torch.half)
+    def test_embedding_dense_grad_many_indices(self, device, dtype):
+        # More than 768 indices, which go through the sort, or are accumulated
+        # with atomics outside of deterministic mode
+        num_weights = 1000
+        indices = torch.randint(num_weights, (64, 50), device=device)
+        indices[0, :20] = 3
+        weight = torch.randn(num_weights, 37, device=device, dtype=dtype, requires_grad=True)
+        grad = torch.randn(64, 50, 37, device=device, dtype=dtype)
+
+        expected_weight = weight.detach().cpu().double().requires_grad_()
+        F.embedding(indices.cpu(), expected_weight, padding_idx=5).backward(grad.cpu().double())
+        for deterministic in (False, True):
+            with DeterministicGuard(deterministic):
+                weight.grad = None
+                F.embedding(indices, weight, padding_idx=5).backward(grad)
+                self.assertEqual(weight.grad.double(), expected_weight.grad,
+                                 atol=5e-2 if dtype == torch.half else 1e-5, rtol=1e-2)
+
     def test_embedding_scalar_weight_error(self, device):
         indices = torch.rand(2, 2, device=device).long()
         weight = torch.tensor(1.0, device=device)
@@ -13562,6 +13976,114 @@ class TestNNDeviceType(NNTestCase):
         self._test_EmbeddingBag(device, 'sum', True, wdtype=torch.bfloat16, dtype=dtype, test_backward=True)
         self._test_EmbeddingBag(device, 'mean', True, wdtype=torch.bfloat16, dtype=dtype, test_backward=True)
 
+    @onlyCPU
+    @dtypes(torch.half, torch.bfloat16)
+    def test_embedding_bag_reduced_precision_forward(self, device, dtype):
+        # Reduced precision tables are reduced in float, so they should match
+        # a float table holding the same values up to the final rounding.
+        prec = 1e-3 if dtype == torch.half else 1e-2
+        weight = torch.randn(50, 19, device=device).to(dtype)
+        weight_non_contig = torch.randn(50, 38, device=device).to(dtype)[:, ::2]
+        weight_non_contig.copy_(weight)
+        indices = torch.randint(50, (40,), device=device)
+        offsets = torch.tensor([0, 0, 3, 11, 11, 25, 40], device=device)
+        per_sample_weights = torch.randn(40, device=device).to(dtype)
+        for w, mode, include_last_offset in itertools.product(
+                (weight, weight_non_contig), ('sum', 'mean', 'max'), (True, False)):
+            offs = offsets if include_last_offset else offsets[:-1]
+            out = F.embedding_bag(indices, w, offs, mode=mode, include_last_offset=include_last_offset)
+            expected = F.embedding_bag(indices, w.float(), offs, mode=mode,
+                                       include_last_offset=include_last_offset)
+            self.assertEqual(out.dtype, dtype)
+            self.assertEqual(out, expected.to(dtype), atol=prec, rtol=prec)
+            if mode == 'sum':
+                out = F.embedding_bag(indices, w, offs, mode=mode, per_sample_weights=per_sample_weights,
+                                      include_last_offset=include_last_offset)
+                expected = F.embedding_bag(indices, w.float(), offs, mode=mode,
+                                           per_sample_weights=per_sample_weights.float(),
+                                           include_last_offset=include_last_offset)
+                self.assertEqual(out, expected.to(dtype), atol=prec, rtol=prec)
+
+    @onlyCPU
+    def test_embedding_bag_max_many_bags(self, device):
+        # Bags are reduced in parallel; check max mode and its argmax bookkeeping
+        # against a per-bag reference, including empty bags.
+        weight = torch.randn(1000, 33, device=device, requires_grad=True)
+        indices = torch.randint(1000, (5000,), device=device)
+        offsets = torch.sort(torch.randint(5000, (600,), device=device))[0]
+        offsets[0] = 0
+        out = F.embedding_bag(indices, weight, offsets, mode='max')
+        bounds = offsets.tolist() + [indices.numel()]
+        for b in range(offsets.numel()):
+            rows = weight[indices[bounds[b]:bounds[b + 1]]]
+            expected = rows.max(0)[0] if rows.numel() else torch.zeros(33, device=device)
+            self.assertEqual(out[b], expected)
+        # Every feature of a non-empty bag routes its gradient to exactly one row
+        out.sum().backward()
+        num_nonempty = sum(1 for b in range(offsets.numel()) if bounds[b + 1] > bounds[b])
+        self.assertEqual(weight.grad.sum().item(), num_nonempty * 33)
+
+    @dtypes(torch.float, torch.double)
+    def test_embedding_bag_batched(self, device, dtype):
+        # The tables are stacked in one weight, compare against one
+        # embedding_bag per table.
+        table_rows = [7, 1, 30]
+        num_tables, D, B = len(table_rows), 5, 4
+        weight_offsets = torch.tensor([0, 7, 8, 38], device=device)
+        weight = torch.randn(38, D, device=device, dtype=dtype)
+        for index_dtype, mode, use_weights in itertools.product(
+                (torch.int, torch.long), ('sum', 'mean'), (False, True)):
+            if mode == 'mean' and use_weights:
+                continue
+            # bags of up to 3 lookups, some of them empty
+            lengths = torch.randint(0, 4, (num_tables, B))
+            indices = torch.cat([torch.randint(rows, (int(lengths[t].sum()),))
+                                 for t, rows in enumerate(table_rows)]).to(device, index_dtype)
+            offsets = torch.cat([torch.zeros(1, dtype=torch.long), lengths.flatten().cumsum(0)]).to(device, index_dtype)
+            per_sample_weights = torch.randn(indices.numel(), device=device, dtype=dtype) if use_weights else None
+            mode_int = 0 if mode == 'sum' else 1
+
+            w = weight.clone().requires_grad_()
+            out = torch._embedding_bag_batched(w, weight_offsets, indices, offsets, mode_int, per_sample_weights)
+            ref_w = weight.clone().requires_grad_()
+            ref = []
+            for t in range(num_tables):
+                table = ref_w[weight_offsets[t]:weight_offsets[t + 1]]
+                bag_offsets = offsets[t * B:(t + 1) * B + 1].long()
+                start, end = bag_offsets[0], bag_offsets[-1]
+                ref.append(F.embedding_bag(indices[start:end].long(), table, bag_offsets[:-1] - start, mode=mode,
+                                           per_sample_weights=per_sample_weights[start:end] if use_weights else None))
+            ref = torch.cat(ref, 1)
+            self.assertEqual(out, ref)
+
+            grad = torch.randn_like(out)
+            out.backward(grad)
+            ref.backward(grad)
+            self.assertEqual(w.grad, ref_w.grad)
+
+            # the fused optimizer steps match the same steps on the dense gradient
+            lr, eps = 0.1, 1e-8
+            sgd_weight = weight.clone()
+            torch._embedding_bag_batched_sgd_update(
+                sgd_weight, weight_offsets, indices, offsets, grad, mode_int, per_sample_weights, lr)
+            self.assertEqual(sgd_weight, weight - lr * ref_w.grad)
+
+            adagrad_weight = weight.clone()
+            momentum = torch.full((38,), 0.5, device=device, dtype=dtype)
+            torch._embedding_bag_batched_rowwise_adagrad_update(
+                adagrad_weight, momentum, weight_offsets, indices, offsets, grad, mode_int,
+                per_sample_weights, lr, eps)
+            expected_momentum = 0.5 + ref_w.grad.pow(2).mean(1)
+            self.assertEqual(momentum, expected_momentum)
+            self.assertEqual(adagrad_weight, weight - lr * ref_w.grad / (expected_momentum.sqrt() + eps).unsqueeze(1))
+
+        indices = torch.zeros(num_tables * B, dtype=torch.long, device=device)
+        offsets = torch.arange(num_tables * B + 1, device=device)
+        with self.assertRaisesRegex(RuntimeError, "only mode='sum' and mode='mean'"):
+            torch._embedding_bag_batched(weight, weight_offsets, indices, offsets, 2)
+        with self.assertRaisesRegex(RuntimeError, "num_tables \\* batch_size \\+ 1"):
+            torch._embedding_bag_batched(weight, weight_offsets, indices, offsets[:-1])
+
 
     @onlyCUDA
     @dtypes(torch.half, torch.float, torch.double)
@@ -14220,7 +14742,7 @@ class TestNNDeviceType(NNTestCase):
         self._test_bfloat16_ops(torch.nn.AdaptiveAvgPool2d((3, 5)), device, inp_dims=(8, 4, 16, 16), prec=0.05)
         self._test_bfloat16_ops(torch.nn.AdaptiveAvgPool3d((3, 5, 7)), device, inp_dims=(8, 4, 16, 16, 16), prec=0.05)
 
-    @onlyCUDA
+    @onlyOnCPUAndCUDA
     def test_softmax_bfloat16(self, device):
         self._test_bfloat16_ops(torch.nn.Softmax(dim=1), device, inp_dims=(16, 32), prec=1e-2)
 
@@ -14266,6 +14788,42 @@ class TestNNDeviceType(NNTestCase):
         helper(1, 16, 56, 56, out_channels=16, kernel_size=3, groups=1)
         helper(1, 16, 56, 56, out_channels=16, kernel_size=3, groups=16)
 
+    @onlyCPU
+    @dtypes(torch.float, torch.double)
+    def test_conv_direct_nhwc(self, device, dtype):
+        def helper(n, c, h, w, out_channels, kernel_size, stride, padding):
+            input = torch.randn(n, c, h, w, dtype=dtype, device=device)\
+                .to(memory_format=torch.channels_last).requires_grad_()
+            conv = nn.Conv2d(c, out_channels, kernel_size, stride=stride, padding=padding)\
+                .to(device=device, dtype=dtype, memory_format=torch.channels_last)
+
+            # use FP64 channels-first conv as reference
+            ref_input = input.detach().clone().contiguous().double().requires_grad_()
+            ref_conv = nn.Conv2d(c, out_channels, kernel_size, stride=stride, padding=padding)
+            ref_conv.load_state_dict(conv.state_dict())
+            ref_conv = ref_conv.to(device=device, dtype=torch.double, memory_format=torch.contiguous_format)
+
+            with torch.backends.mkldnn.flags(enabled=False):
+                out = conv(input)
+            ref_out = ref_conv(ref_input)
+            grad = torch.randn_like(out)
+            out.backward(grad)
+            ref_out.backward(grad.double().contiguous())
+
+            self.assertTrue(out.is_contiguous(memory_format=torch.channels_last))
+            self.assertEqual(out, ref_out, exact_dtype=False)
+            self.assertEqual(conv.weight.grad, ref_conv.weight.grad, exact_dtype=False)
+            self.assertEqual(conv.bias.grad, ref_conv.bias.grad, exact_dtype=False)
+            self.assertEqual(input.grad, ref_input.grad, exact_dtype=False)
+
+        # stem layer
+        helper(2, 3, 32, 32, out_channels=64, kernel_size=7, stride=2, padding=3)
+        # output channels that are not a multiple of the vector width
+        helper(1, 3, 9, 11, out_channels=5, kernel_size=3, stride=1, padding=1)
+        helper(2, 16, 8, 8, out_channels=37, kernel_size=(3, 2), stride=(2, 1), padding=(0, 1))
+        # padding larger than the kernel
+        helper(1, 1, 4, 4, out_channels=3, kernel_size=1, stride=1, padding=2)
+
     def _run_conv(self, layer, device, inp, grad, ref_conv, ref_input, ref_out,
                   input_format, weight_format, grad_format, output_format):
         conv = layer(inp.size(1), grad.size(1),
@@ -14331,6 +14889,30 @@ class TestNNDeviceType(NNTestCase):
             self._test_conv_cudnn_nhwc_nchw(nn.Conv2d, n, c, h, w, k, filter_size, device)
             self._test_conv_cudnn_nhwc_nchw(nn.ConvTranspose2d, n, c, h, w, k, filter_size, device)
 
+    @onlyCUDA
+    @skipCUDAIfNoCudnn
+    @skipCUDAIfRocm
+    def test_cudnn_benchmark_cache(self, device):
+        input = torch.randn(2, 3, 17, 19, device=device, requires_grad=True)
+        conv = nn.Conv2d(3, 5, 3).to(device)
+        with cudnn.flags(enabled=True, benchmark=True):
+            conv(input).sum().backward()
+
+        with TemporaryFileName() as path:
+            cudnn.save_benchmark_cache(path)
+            # every saved algorithm was already picked by this process
+            self.assertEqual(cudnn.load_benchmark_cache(path), 0)
+
+            with open(path, 'r+b') as f:
+                f.truncate(f.seek(0, 2) - 1)
+            with self.assertRaisesRegex(RuntimeError, "unexpected end of file"):
+                cudnn.load_benchmark_cache(path)
+
+            with open(path, 'wb') as f:
+                f.write(b'not a cache')
+            with self.assertRaisesRegex(RuntimeError, "not a cuDNN benchmark cache"):
+                cudnn.load_benchmark_cache(path)
+
     # torch.half is erroring out on Windows with CUDA 10.1 + cuDNN 7.6.4
     # returning CUDNN_STATUS_BAD_PARAM
     # Disabling that specific test for now [see issue # 33918]
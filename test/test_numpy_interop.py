@@ -225,6 +225,60 @@ class TestNumPyInterop(TestCase):
         x.strides = (3,)
         self.assertRaises(ValueError, lambda: torch.from_numpy(x))
 
+    @onlyCPU
+    def test_numpy_negative_strides(self, device) -> None:
+        x = np.arange(24, dtype=np.float32).reshape(2, 3, 4)
+        flipped = x[::-1, :, ::-2]
+        expected = torch.arange(24, dtype=torch.float32).view(2, 3, 4).flip(0).flip(2)[:, :, ::2]
+        self.assertEqual(torch.tensor(flipped), expected)
+        self.assertEqual(torch.as_tensor(flipped), expected)
+        self.assertEqual(torch.as_tensor(x[:, ::-1][:, :1]), torch.from_numpy(x[:, 2:]))
+        # from_numpy has to share the memory of the array, which it can't do
+        with self.assertRaisesRegex(ValueError, "negative"):
+            torch.from_numpy(flipped)
+
+    @onlyCPU
+    def test_numpy_unaligned(self, device) -> None:
+        x = np.frombuffer(bytearray(17), dtype=np.float64, count=2, offset=1)
+        self.assertFalse(x.flags.aligned)
+        t = torch.from_numpy(x)
+        t.fill_(1.5)
+        self.assertEqual(x, np.array([1.5, 1.5]))
+        self.assertFalse(t.numpy().flags.aligned)
+        self.assertTrue(torch.zeros(2).numpy().flags.aligned)
+
+    @onlyCPU
+    def test_buffer_protocol(self, device) -> None:
+        for dtype in [torch.float64, torch.float32, torch.float16, torch.complex64,
+                      torch.complex128, torch.int64, torch.int32, torch.int16,
+                      torch.int8, torch.uint8, torch.bool]:
+            t = torch.ones(2, 3, dtype=dtype)
+            view = memoryview(t)
+            self.assertEqual(view.shape, (2, 3))
+            self.assertEqual(view.strides, (3 * t.element_size(), t.element_size()))
+            self.assertEqual(view.itemsize, t.element_size())
+            self.assertFalse(view.readonly)
+            array = np.asarray(view)
+            self.assertEqual(array.dtype, t.numpy().dtype)
+            self.assertEqual(torch.from_numpy(array), t)
+
+        # the buffer shares the memory of the tensor, and keeps it alive
+        t = torch.zeros(4, 5)[1:, ::2]
+        view = memoryview(t)
+        self.assertEqual(view.strides, (20, 8))
+        t[0, 1] = 3
+        self.assertEqual(view[0, 1], 3)
+        del t
+        self.assertEqual(view.tolist()[0], [0, 3, 0])
+        self.assertEqual(bytes(memoryview(torch.tensor([1, 2], dtype=torch.uint8))), b'\x01\x02')
+
+        with self.assertRaisesRegex(BufferError, "not contiguous"):
+            np.frombuffer(torch.zeros(4, 5).t(), dtype=np.float32)
+        with self.assertRaisesRegex(BufferError, "requires grad"):
+            memoryview(torch.zeros(2, requires_grad=True))
+        with self.assertRaisesRegex(BufferError, "BFloat16"):
+            memoryview(torch.zeros(2, dtype=torch.bfloat16))
+
     @onlyCPU
     def test_ctor_with_numpy_scalar_ctor(self, device) -> None:
         dtypes = [
@@ -3,6 +3,7 @@ import math
 import unittest
 import functools
 from copy import deepcopy
+from itertools import product
 import torch
 from torch._six import inf
 import torch.optim as optim
@@ -378,6 +379,61 @@ class TestOptim(TestCase):
             for p1, p2 in zip(res[0], res[1]):
                 self.assertEqual(p1, p2)
 
+    def _test_fused_optimizer_ops(self, device):
+        def make_params(dtype):
+            # a transposed (non-contiguous) parameter and an empty one go through
+            # the per-tensor path and the fused kernel respectively
+            return [torch.randn(1000, device=device, dtype=dtype),
+                    torch.randn(7, 5, device=device, dtype=dtype).t(),
+                    torch.randn(0, device=device, dtype=dtype),
+                    torch.randn(2, 3, device=device, dtype=dtype)]
+
+        kIterations = 3
+        dtypes = [torch.float, torch.double]
+        for dtype in dtypes:
+            for (weight_decay, amsgrad, adamw) in product([0., 0.1], [False, True], [False, True]):
+                params = make_params(dtype)
+                grads = [[torch.randn_like(p) for p in params] for _ in range(kIterations)]
+                ref_params = [p.clone().requires_grad_() for p in params]
+                opt_cls = optim.AdamW if adamw else optim.Adam
+                opt = opt_cls(ref_params, lr=0.01, weight_decay=weight_decay, amsgrad=amsgrad)
+                exp_avgs = [torch.zeros_like(p) for p in params]
+                exp_avg_sqs = [torch.zeros_like(p) for p in params]
+                max_exp_avg_sqs = [torch.zeros_like(p) for p in params] if amsgrad else []
+                for step in range(kIterations):
+                    for p, g in zip(ref_params, grads[step]):
+                        p.grad = g.clone()
+                    opt.step()
+                    torch._fused_adam_(params, grads[step], exp_avgs, exp_avg_sqs, max_exp_avg_sqs,
+                                       step=step + 1, lr=0.01, beta1=0.9, beta2=0.999,
+                                       weight_decay=weight_decay, eps=1e-8, decoupled_weight_decay=adamw)
+                for p, ref in zip(params, ref_params):
+                    self.assertEqual(p, ref.detach())
+
+            for (weight_decay, momentum, dampening, nesterov) in product([0., 0.1], [0., 0.9], [0., 0.5], [False, True]):
+                if nesterov and (momentum == 0 or dampening != 0):
+                    continue
+                params = make_params(dtype)
+                grads = [[torch.randn_like(p) for p in params] for _ in range(kIterations)]
+                ref_params = [p.clone().requires_grad_() for p in params]
+                opt = optim.SGD(ref_params, lr=0.1, momentum=momentum, dampening=dampening,
+                                weight_decay=weight_decay, nesterov=nesterov)
+                momentum_buffers = [torch.empty_like(p) for p in params] if momentum != 0 else []
+                for step in range(kIterations):
+                    for p, g in zip(ref_params, grads[step]):
+                        p.grad = g.clone()
+                    opt.step()
+                    torch._fused_sgd_(params, grads[step], momentum_buffers, lr=0.1, momentum=momentum,
+                                      dampening=dampening, weight_decay=weight_decay, nesterov=nesterov,
+                                      is_first_step=step == 0)
+                for p, ref in zip(params, ref_params):
+                    self.assertEqual(p, ref.detach())
+
+    def test_fused_optimizer_ops(self):
+        self._test_fused_optimizer_ops('cpu')
+        if torch.cuda.is_available():
+            self._test_fused_optimizer_ops('cuda')
+
     def test_adam(self):
         for optimizer in [optim.Adam, optim_mt.Adam]:
             self._test_basic_cases(
@@ -533,6 +533,33 @@ class TestTorchFunctionOverride(TestCase):
         with self.assertRaises(TypeError):
             sn1 + s2
 
+    def test_override_added_and_removed(self):
+        """Whether a type has __torch_function__ is cached per type, make
+        sure that changing the type, or one of its bases, is seen"""
+        class Base:
+            pass
+
+        class Derived(Base):
+            pass
+
+        b = Derived()
+        self.assertFalse(torch._C._has_torch_function_unary(b))
+
+        def __torch_function__(cls, func, types, args=(), kwargs=None):
+            return -1
+
+        Base.__torch_function__ = classmethod(__torch_function__)
+        self.assertTrue(torch._C._has_torch_function_unary(b))
+        self.assertEqual(torch.add(b, 1), -1)
+
+        Derived.__torch_function__ = torch._C._disabled_torch_function_impl
+        self.assertFalse(torch._C._has_torch_function_unary(b))
+
+        del Derived.__torch_function__
+        self.assertTrue(torch._C._has_torch_function_unary(b))
+        del Base.__torch_function__
+        self.assertFalse(torch._C._has_torch_function_unary(b))
+
 
 def generate_tensor_like_override_tests(cls):
     from torch.testing._internal.generated.annotated_fn_args import annotated_args
@@ -14,7 +14,7 @@ from torch.testing._internal.common_utils import (
     TemporaryFileName, TemporaryDirectoryName)
 from torch.autograd.profiler import profile as _profile
 from torch.profiler import (
-    kineto_available, profile, record_function, DeviceType, ProfilerActivity
+    kineto_available, profile, record_function, DeviceType, ProfilerAction, ProfilerActivity
 )
 
 try:
@@ -292,6 +292,37 @@ class TestProfiler(TestCase):
                 ]
             )
 
+    def test_memory_timeline(self):
+        def run(use_kineto):
+            with _profile(profile_memory=True, use_kineto=use_kineto) as prof:
+                with record_function("outer"):
+                    with record_function("big"):
+                        big = torch.empty(1024 * 1024, dtype=torch.uint8)
+                    with record_function("small"):
+                        small = torch.empty(1024, dtype=torch.uint8)
+                        del small
+                del big
+
+            timeline = prof.memory_timeline()
+            peak_time_us, peak_bytes = timeline.peak("cpu")
+            self.assertGreaterEqual(peak_bytes, 1024 * 1024)
+            # everything allocated in the run is freed
+            self.assertEqual(timeline.timeline("cpu")[-1][1], 0)
+            breakdown = timeline.peak_breakdown("cpu")
+            stack, nbytes = breakdown[0]
+            self.assertEqual(stack[:2], ("outer", "big"))
+            self.assertGreaterEqual(nbytes, 1024 * 1024)
+            self.assertEqual(timeline.peak_breakdown("cpu", stack_depth=1)[0][0], ("outer",))
+            self.assertIn("outer > big", timeline.table("cpu"))
+            with TemporaryFileName(mode="w+") as fname:
+                timeline.export_chrome_trace(fname)
+                with io.open(fname, 'r') as f:
+                    self.assertIn("Memory (CPU)", f.read())
+
+        run(use_kineto=False)
+        if kineto_available():
+            run(use_kineto=True)
+
     def test_high_level_trace(self):
         """Checks that python side high level events are recorded.
         """
@@ -514,6 +545,42 @@ class TestProfiler(TestCase):
                 file_num += 1
             self.assertEqual(file_num, 3)
 
+    def test_on_demand_schedule(self):
+        with TemporaryDirectoryName() as dname:
+            trigger_file = os.path.join(dname, "trigger")
+            schedule = torch.profiler.on_demand_schedule(
+                trigger_file=trigger_file, warmup=1, active=2)
+            actions = [schedule(step) for step in range(3)]
+            open(trigger_file, "w").close()
+            actions += [schedule(step) for step in range(3, 9)]
+            self.assertFalse(os.path.exists(trigger_file))
+            A = ProfilerAction
+            self.assertEqual(actions, [
+                A.NONE, A.NONE, A.NONE,
+                A.WARMUP, A.RECORD, A.RECORD_AND_SAVE,
+                A.NONE, A.NONE, A.NONE])
+
+    @unittest.skipIf(not kineto_available(), "Kineto is required")
+    def test_kineto_on_demand_sampling(self):
+        with TemporaryDirectoryName() as dname:
+            trigger_file = os.path.join(dname, "trigger")
+            trace_dir = os.path.join(dname, "traces")
+            with profile(
+                activities=[torch.profiler.ProfilerActivity.CPU],
+                schedule=torch.profiler.on_demand_schedule(
+                    trigger_file=trigger_file, warmup=1, active=2),
+                on_trace_ready=torch.profiler.tensorboard_trace_handler(trace_dir),
+                sampling_prob=0.0,
+            ) as p:
+                for idx in range(10):
+                    if idx in [2, 6]:
+                        open(trigger_file, "w").close()
+                    self.payload()
+                    p.step()
+                # ops were sampled out, only the step markers remain
+                self.assertFalse(any(e.name.startswith("aten::") for e in p.events()))
+            self.assertEqual(len(os.listdir(trace_dir)), 2)
+
 
 if __name__ == '__main__':
     run_tests()
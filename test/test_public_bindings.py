@@ -153,6 +153,7 @@ class TestPublicBindings(unittest.TestCase):
             "dtype",
             "finfo",
             "fork",
+            "get_autocast_cpu_dtype",
             "get_default_dtype",
             "get_num_interop_threads",
             "get_num_threads",
@@ -168,6 +169,7 @@ class TestPublicBindings(unittest.TestCase):
             "import_ir_module_from_buffer",
             "init_num_threads",
             "is_anomaly_enabled",
+            "is_autocast_cpu_enabled",
             "is_autocast_enabled",
             "is_grad_enabled",
             "layout",
@@ -178,6 +180,8 @@ class TestPublicBindings(unittest.TestCase):
             "parse_type_comment",
             "qscheme",
             "set_anomaly_enabled",
+            "set_autocast_cpu_dtype",
+            "set_autocast_cpu_enabled",
             "set_autocast_enabled",
             "set_flush_denormal",
             "set_num_interop_threads",
@@ -144,6 +144,22 @@ class TestReductions(TestCase):
         _run_test([1, 32 * 8 * 32 * 8])
         _run_test([1, 32770])
 
+    @onlyCPU
+    def test_reduce_noncontig_dims(self, device):
+        # Reductions over several non-adjacent dims, including ones where the
+        # input is only contiguous in a kept dim, and small outputs of large
+        # reductions, which use the parallel branches
+        nv = np.random.randn(16, 3, 64, 37)
+        for memory_format in (torch.contiguous_format, torch.channels_last):
+            tv = torch.from_numpy(nv).contiguous(memory_format=memory_format)
+            for dims in ((0, 2), (0, 3), (0, 2, 3), (1, 3), (0, 1, 2)):
+                self.assertEqual(tv.sum(dims), torch.from_numpy(nv.sum(dims)))
+                self.assertEqual(tv.mean(dims), torch.from_numpy(nv.mean(dims)))
+                self.assertEqual(tv.var(dims), torch.from_numpy(nv.var(dims, ddof=1)))
+                self.assertEqual(tv.norm(dim=dims), torch.from_numpy(np.sqrt((nv ** 2).sum(dims))))
+                self.assertEqual(tv.amax(dims), torch.from_numpy(nv.max(dims)))
+                self.assertEqual((1 + tv / 100).prod(dims), torch.from_numpy((1 + nv / 100).prod(dims)))
+
     # TODO: kill map2_ (and similar) uses and update to compare with NumPy
     # only works on CPU since this uses map2_, which is only supported on CPU
     def _testCSelection(self, torchfn, mathfn):
@@ -896,6 +912,16 @@ class TestReductions(TestCase):
         expected_result = torch.tensor([2, 4, 3, 4], device=device)
         self.assertEqual(torch.searchsorted(boundaries, values_nan, right=True), expected_result)
 
+        # large 1d input, against both few and many boundaries
+        values_large = torch.randn(1000, device=device, dtype=torch.float64)
+        for num_boundaries in (10, 100):
+            boundaries = torch.randn(num_boundaries, device=device, dtype=torch.float64).sort()[0]
+            for right in (False, True):
+                side = 'right' if right else 'left'
+                expected_result = torch.from_numpy(
+                    np.searchsorted(boundaries.cpu().numpy(), values_large.cpu().numpy(), side=side))
+                self.assertEqual(torch.searchsorted(boundaries, values_large, right=right), expected_result)
+
         # type promotion and non contiguous tensors
         values_3d_permute = values_3d.permute(2, 1, 0).to(torch.int32)
         boundaries_permute = values_3d.permute(2, 1, 0).to(torch.float64)
@@ -1571,6 +1597,19 @@ class TestReductions(TestCase):
         expect = input_[0] + input_[1] + input_[2] + input_[3] + input_[4]
         self.assertEqual(result, expect)
 
+    @onlyCUDA
+    @dtypes(torch.float, torch.double)
+    def test_reduction_tall_skinny(self, device, dtype):
+        # Tall and skinny inputs reduced along dim 0 are split across blocks
+        # whose partial results are combined by a second kernel
+        for shape in ((1000000, 4), (200000, 33), (50000, 1024)):
+            x = torch.randn(shape, dtype=dtype)
+            x_cuda = x.to(device)
+            self.assertEqual(x_cuda.sum(0), x.sum(0))
+            self.assertEqual(x_cuda.amax(0), x.amax(0))
+            self.assertEqual(x_cuda.argmin(0), x.argmin(0))
+            self.assertEqual(x_cuda.t().sum(1), x.t().sum(1))
+
     @onlyCUDA
     @dtypes(torch.half, torch.float, torch.double)
     def test_reduction_vectorize_along_input_corner(self, device, dtype):
@@ -2180,6 +2219,9 @@ class TestReductions(TestCase):
         expanded = torch.randn(1, 5, 1, 2, device=device).expand(3, 5, 7, 2)
         test_against_np(expanded)
 
+        # large enough to be counted in parallel
+        test_against_np(torch.randn(100000, device=device), bins=30)
+
     def test_reduction_empty(self, device):
         fns_to_test = [
             # name, function, identity
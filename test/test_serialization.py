@@ -718,6 +718,21 @@ class TestSerialization(TestCase, SerializationMixin):
 
         test(io.BytesIO())
 
+    def test_serialization_zipfile_compression(self):
+        # larger than a chunk, so that it is compressed in parallel
+        data = [torch.zeros(2 * 1024 * 1024), torch.arange(1000.), torch.randn(100)]
+        buffer = io.BytesIO()
+        torch.save(data, buffer, _use_compression=True)
+        self.assertLess(len(buffer.getvalue()), 2 * 1024 * 1024)
+
+        # readable as a regular zip file
+        buffer.seek(0)
+        with zipfile.ZipFile(buffer) as archive:
+            self.assertIsNone(archive.testzip())
+
+        buffer.seek(0)
+        self.assertEqual(torch.load(buffer), data)
+
     def test_serialization_zipfile_actually_jit(self):
         with tempfile.NamedTemporaryFile() as f:
             torch.jit.save(torch.jit.script(torch.nn.Linear(3, 4)), f)
@@ -607,6 +607,13 @@ class TestShapeOps(TestCase):
         self.assertEqual(dst1, dst4, atol=0, rtol=0)
         self.assertEqual(strides, dst4.stride())
 
+    def test_nonzero_large(self, device):
+        # large enough to be counted and written out in several chunks
+        tensor = torch.rand(3, 100, 1000, device=device) < 0.2
+        for t in (tensor, tensor.transpose(0, 2), tensor[:, ::3]):
+            np_result = torch.from_numpy(np.stack(t.cpu().numpy().nonzero())).t()
+            self.assertEqual(t.nonzero().cpu(), np_result, atol=0, rtol=0)
+
     def test_nonzero_non_diff(self, device):
         x = torch.randn(10, requires_grad=True)
         nz = x.nonzero()
@@ -191,6 +191,84 @@ class TestSortAndSelect(TestCase):
             idx_numpy = np.argsort(sample_numpy, axis=dim, kind='stable')
             self.assertEqual(idx_torch, idx_numpy)
 
+    @onlyCPU
+    @dtypes(torch.bool, torch.uint8, torch.int8, torch.int32, torch.int64, torch.half, torch.float, torch.double)
+    def test_sort_large_slice(self, device, dtype):
+        # Long slices are sorted with all threads when there are fewer slices
+        # than threads, compare with the serial sort of a single thread
+        n = 100003
+        if dtype == torch.bool:
+            x = torch.randint(2, (n,), device=device).to(dtype)
+        elif dtype.is_floating_point:
+            x = (torch.randint(-500, 500, (n,), device=device) / 4).to(dtype)
+            x[torch.randint(n, (100,))] = float('nan')
+            x[torch.randint(n, (100,))] = -0.0
+            x[torch.randint(n, (100,))] = float('-inf')
+        else:
+            x = make_tensor((n,), device, dtype)
+        x = torch.stack([x, x.flip(0)], dim=1)
+
+        num_threads = torch.get_num_threads()
+        try:
+            for descending, stable in product([False, True], [False, True]):
+                torch.set_num_threads(1)
+                expected_values, expected_indices = x.sort(dim=0, descending=descending, stable=stable)
+                torch.set_num_threads(4)
+                values, indices = x.sort(dim=0, descending=descending, stable=stable)
+                self.assertEqual(values, expected_values, atol=0, rtol=0)
+                self.assertEqual(x.gather(0, indices), values, atol=0, rtol=0)
+                if stable:
+                    self.assertEqual(indices, expected_indices)
+        finally:
+            torch.set_num_threads(num_threads)
+
+    @onlyCPU
+    @dtypes(torch.int32, torch.float, torch.double)
+    def test_topk_large_slice(self, device, dtype):
+        n = 100003
+        x = torch.randperm(n, device=device).to(dtype)
+        if dtype.is_floating_point:
+            x[123] = float('nan')
+
+        num_threads = torch.get_num_threads()
+        try:
+            torch.set_num_threads(4)
+            for k, largest in product([1, 7, 1000], [False, True]):
+                values, indices = x.topk(k, largest=largest)
+                expected = x.sort(descending=largest)[0][:k]
+                self.assertEqual(values, expected)
+                self.assertEqual(x[indices], values)
+        finally:
+            torch.set_num_threads(num_threads)
+
+    @onlyCUDA
+    @dtypes(torch.uint8, torch.int8, torch.int16, torch.int64, torch.half, torch.float, torch.double)
+    def test_sort_many_long_slices(self, device, dtype):
+        # Slices longer than 2048 go through the segmented radix sort
+        if dtype.is_floating_point:
+            x = (torch.randint(-500, 500, (64, 3001)) / 4).to(dtype)
+            x.view(-1)[torch.randint(x.numel(), (100,))] = float('nan')
+            x.view(-1)[torch.randint(x.numel(), (100,))] = -0.0
+            x.view(-1)[torch.randint(x.numel(), (100,))] = float('-inf')
+        else:
+            x = make_tensor((64, 3001), 'cpu', dtype)
+
+        for dim, descending in product([0, 1], [False, True]):
+            # Along dim 0, the slices are strided
+            x_dim = x.t().contiguous() if dim == 0 else x
+            expected_values, expected_indices = x_dim.sort(dim=dim, descending=descending, stable=True)
+            values, indices = x_dim.to(device).sort(dim=dim, descending=descending)
+            self.assertEqual(values, expected_values, atol=0, rtol=0)
+            # The radix sort is stable
+            self.assertEqual(indices, expected_indices)
+
+        k = 2500
+        for largest in (False, True):
+            values, indices = x.to(device).topk(k, largest=largest)
+            expected = x.sort(descending=largest)[0][:, :k]
+            self.assertEqual(values, expected, atol=0, rtol=0)
+            self.assertEqual(x.to(device).gather(1, indices), values, atol=0, rtol=0)
+
     @dtypes(*(torch.testing.get_all_int_dtypes() + torch.testing.get_all_fp_dtypes(include_bfloat16=False)))
     def test_msort(self, device, dtype):
         def test(shape):
@@ -642,6 +720,29 @@ class TestSortAndSelect(TestCase):
                                     count += 1
                             self.assertEqual(j, count)
 
+    @onlyCPU
+    @dtypes(torch.bool, torch.uint8, torch.int32, torch.int64)
+    def test_unique_large_input(self, device, dtype):
+        # integral inputs this large are deduplicated with all threads
+        high = 2 if dtype == torch.bool else 100
+        x = torch.randint(high, (3, 70001), device=device).to(dtype) * 7
+        expected_unique, expected_counts = np.unique(x.numpy(), return_counts=True)
+        num_threads = torch.get_num_threads()
+        try:
+            torch.set_num_threads(4)
+            for sorted in [True, False]:
+                unique, inverse, counts = torch.unique(
+                    x, sorted=sorted, return_inverse=True, return_counts=True)
+                self.assertEqual(unique[inverse], x)
+                if not sorted:
+                    unique, order = unique.sort()
+                    counts = counts[order]
+                self.assertEqual(unique, expected_unique)
+                self.assertEqual(counts, expected_counts)
+                self.assertEqual(torch.unique(x, sorted=sorted).sort()[0], expected_unique)
+        finally:
+            torch.set_num_threads(num_threads)
+
     @dtypes(*set(torch.testing.get_all_dtypes()) - {torch.bfloat16, torch.complex64, torch.complex128})
     def test_unique_consecutive(self, device, dtype):
         if dtype is torch.half and self.device_type == 'cpu':
@@ -974,6 +974,32 @@ class TestSparse(TestCase):
         test_shape(10, 100, 0, 0)
         test_shape(10, 100, 0, 20)
 
+    @cpu_only
+    def test_coalesce_mm_large(self):
+        # large enough to coalesce with the parallel radix sort
+        n, nnz = 300, 100000
+        indices = torch.randint(0, n, (2, nnz))
+        values = torch.randn(nnz, dtype=torch.double)
+        x = torch.sparse_coo_tensor(indices, values, (n, n))
+        expected = torch.zeros(n, n, dtype=torch.double).index_put_(tuple(indices), values, accumulate=True)
+
+        xc = x.coalesce()
+        self.assertTrue(xc.is_coalesced())
+        flat = xc._indices()[0] * n + xc._indices()[1]
+        self.assertTrue((flat[1:] > flat[:-1]).all())
+        self.assertEqual(xc.to_dense(), expected)
+
+        # repeated products reuse the row pointers of xc
+        y = torch.randn(n, 8, dtype=torch.double)
+        self.assertEqual(torch.mm(xc, y), expected.mm(y))
+        self.assertEqual(torch.mm(xc, y), expected.mm(y))
+
+        # modifying the indices in place invalidates them; the rows stay sorted
+        xc._indices()[0].clamp_(max=n // 2)
+        rows, cols = xc._indices()
+        expected_mm = torch.zeros(n, 8, dtype=torch.double).index_add_(0, rows, xc._values()[:, None] * y[cols])
+        self.assertEqual(torch.mm(xc, y), expected_mm)
+
     @unittest.skipIf(
         IS_WINDOWS and TEST_CUDA,
         "bmm sparse-dense CUDA is not yet supported in Windows, at least up to CUDA 10.1"
@@ -3020,6 +3046,28 @@ class TestSparse(TestCase):
         test_op(3, 100, [3, 4, 2, 3, 5, 2])
         test_op(4, 100, [3, 4, 2, 3, 5, 2])
 
+    def test_softmax_large(self):
+        # enough entries for the radix sorted pools, with duplicate indices
+        # and a dense dim, against the dense softmax with -inf fill
+        nnz = 50000
+        size = [40, 30, 20, 2]
+        i = torch.stack([torch.randint(0, s, (nnz,), device=self.device) for s in size[:3]])
+        v = torch.randn(nnz, size[3], dtype=torch.double, device=self.device)
+        x = self.sparse_tensor(i, v, size).coalesce()
+        dense = torch.full(size, float('-inf'), dtype=torch.double, device=self.device)
+        dense[tuple(x._indices())] = x._values()
+        mask = dense != float('-inf')
+        for dim in range(len(size)):
+            expected = torch.softmax(dense, dim).masked_fill(~mask, 0)
+            self.assertEqual(torch.sparse.softmax(x, dim).to_dense(), expected)
+            expected = torch.log_softmax(dense, dim).masked_fill(~mask, 0)
+            self.assertEqual(torch.sparse.log_softmax(x, dim).to_dense(), expected)
+
+        # the sum of all entries doesn't need the duplicates coalesced
+        y = self.sparse_tensor(i, v, size)
+        self.assertEqual(torch.sparse.sum(y), v.sum())
+        self.assertEqual(torch.sparse.sum(y, dtype=torch.float), v.sum(dtype=torch.float))
+
     def test_sparse_matmul(self):
         """
         This function test `torch.sparse.mm` when both the mat1 and mat2 are sparse tensors.
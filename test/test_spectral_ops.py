@@ -9,7 +9,7 @@ from torch.testing._internal.common_utils import \
     (TestCase, run_tests, TEST_NUMPY, TEST_LIBROSA, TEST_MKL)
 from torch.testing._internal.common_device_type import \
     (instantiate_device_type_tests, ops, dtypes, onlyOnCPUAndCUDA,
-     skipCPUIfNoMkl, skipCUDAIfRocm, deviceCountAtLeast, onlyCUDA, OpDTypes,
+     skipCPUIfNoMkl, skipCUDAIfRocm, deviceCountAtLeast, onlyCPU, onlyCUDA, OpDTypes,
      skipIf)
 from torch.testing._internal.common_methods_invocations import spectral_funcs
 
@@ -633,12 +633,25 @@ class TestFFT(TestCase):
         with plan_cache_max_size(devices[0], 10):
             self._test_fft_ifft_rfft_irfft(devices[0], dtype)
 
+        torch.backends.cuda.cufft_plan_cache.clear()
+        self.assertEqual(torch.backends.cuda.cufft_plan_cache.hits, 0)
+        self.assertEqual(torch.backends.cuda.cufft_plan_cache.misses, 0)
+        with plan_cache_max_size(devices[0], 10):
+            x = torch.randn(4, 64, device=devices[0], dtype=dtype)
+            for _ in range(3):
+                self.assertEqual(torch.fft.fft(x), torch.fft.fft(x.cpu()))
+        self.assertEqual(torch.backends.cuda.cufft_plan_cache.misses, 1)
+        self.assertEqual(torch.backends.cuda.cufft_plan_cache.hits, 2)
+
         with self.assertRaisesRegex(RuntimeError, r"must be non-negative"):
             torch.backends.cuda.cufft_plan_cache.max_size = -1
 
         with self.assertRaisesRegex(RuntimeError, r"read-only property"):
             torch.backends.cuda.cufft_plan_cache.size = -1
 
+        with self.assertRaisesRegex(RuntimeError, r"read-only property"):
+            torch.backends.cuda.cufft_plan_cache.hits = 0
+
         with self.assertRaisesRegex(RuntimeError, r"but got device with index"):
             torch.backends.cuda.cufft_plan_cache[torch.cuda.device_count() + 10]
 
@@ -678,6 +691,58 @@ class TestFFT(TestCase):
                             self.assertEqual(torch.backends.cuda.cufft_plan_cache.max_size, 10)  # default is cuda:0
                         self.assertEqual(torch.backends.cuda.cufft_plan_cache.max_size, 11)  # default is cuda:1
 
+    @skipCPUIfNoMkl
+    @onlyCPU
+    @dtypes(torch.double)
+    def test_mkl_fft_plan_cache(self, device, dtype):
+        plan_cache = torch.backends.mkl.fft_plan_cache
+
+        @contextmanager
+        def plan_cache_max_size(n):
+            original = plan_cache.max_size
+            plan_cache.max_size = n
+            yield
+            plan_cache.max_size = original
+
+        with plan_cache_max_size(max(1, plan_cache.size - 10)):
+            self._test_fft_ifft_rfft_irfft(device, dtype)
+
+        with plan_cache_max_size(0):
+            self._test_fft_ifft_rfft_irfft(device, dtype)
+            self.assertEqual(plan_cache.size, 0)
+
+        plan_cache.clear()
+        self.assertEqual(plan_cache.hits, 0)
+        self.assertEqual(plan_cache.misses, 0)
+        with plan_cache_max_size(10):
+            x = torch.randn(4, 64, device=device, dtype=dtype)
+            expected = torch.fft.fft(x)
+            for _ in range(2):
+                self.assertEqual(torch.fft.fft(x), expected)
+            self.assertEqual(plan_cache.misses, 1)
+            self.assertEqual(plan_cache.hits, 2)
+
+            # the plan is limited to the current number of threads
+            num_threads = torch.get_num_threads()
+            try:
+                torch.set_num_threads(1)
+                self.assertEqual(torch.fft.fft(x), expected)
+                self.assertEqual(plan_cache.misses, 1 if num_threads == 1 else 2)
+            finally:
+                torch.set_num_threads(num_threads)
+
+            # all the frames of an stft share one plan
+            plan_cache.clear()
+            signal = torch.randn(2, 4000, device=device, dtype=dtype)
+            window = torch.hann_window(400, device=device, dtype=dtype)
+            for _ in range(3):
+                torch.stft(signal, 400, hop_length=160, window=window, return_complex=True)
+            self.assertEqual(plan_cache.misses, 1)
+            self.assertEqual(plan_cache.hits, 2)
+
+        with self.assertRaisesRegex(RuntimeError, r"must be non-negative"):
+            plan_cache.max_size = -1
+
     # passes on ROCm w/ python 2.7, fails w/ python 3.6
     @skipCPUIfNoMkl
     @dtypes(torch.double)
@@ -1,3 +1,5 @@
+import json
+
 import numpy as np
 import torch
 from torch import nn
@@ -172,6 +174,22 @@ class TestStaticModule(TestCase):
             [src, src, src, src_mask], {}, 2, 2
         )
 
+        self.assertEqual(metrics.total_nodes_count, len(metrics.time_per_node))
+        self.assertEqual(len(metrics.alloc_bytes_per_node), metrics.total_nodes_count)
+        self.assertLessEqual(
+            metrics.out_nodes_count + metrics.native_nodes_count,
+            metrics.total_nodes_count,
+        )
+        report = json.loads(metrics.to_json())
+        self.assertEqual(
+            sum(t["instances"] for t in report["node_types"]),
+            metrics.total_nodes_count,
+        )
+        for t in report["node_types"]:
+            self.assertEqual(
+                t["out_variant"] + t["native"] + t["fallback"], t["instances"]
+            )
+
     def test_mlp(self):
         # Arguments taken from benchmark script, ./bench/dlrm_s_benchmark.sh
         ln_bot = [512, 512, 64]
@@ -11,7 +11,7 @@ import random
 from torch.testing._internal.common_utils import (
     TestCase, run_tests, do_test_empty_full, TEST_WITH_ROCM, suppress_warnings,
     torch_to_numpy_dtype_dict, slowTest, TEST_SCIPY, IS_MACOS, IS_PPC,
-    IS_WINDOWS)
+    IS_WINDOWS, make_tensor)
 from torch.testing._internal.common_device_type import (
     instantiate_device_type_tests, deviceCountAtLeast, onlyOnCPUAndCUDA,
     onlyCPU, largeTensorTest, precisionOverride, dtypes,
@@ -677,6 +677,44 @@ class TestTensorCreation(TestCase):
             self.assertTrue(res2.is_contiguous(memory_format=torch.channels_last))
             self.assertEqual(res1, res2)
 
+    @onlyCPU
+    @dtypes(torch.float, torch.double, torch.int64, torch.bool, torch.bfloat16)
+    def test_cat_mixed_layouts(self, device, dtype):
+        # Contiguous, strided, channels last and promoted inputs in one call,
+        # large enough for the copies to be split across threads
+        def check(inputs, dim, memory_format=torch.contiguous_format):
+            result = torch.cat(inputs, dim)
+            self.assertTrue(result.is_contiguous(memory_format=memory_format))
+            offset = 0
+            for t in inputs:
+                if t.dim() == 1 and t.numel() == 0:
+                    continue
+                size = t.size(dim)
+                self.assertEqual(result.narrow(dim, offset, size), t.to(result.dtype), atol=0, rtol=0)
+                offset += size
+
+        for dim in range(4):
+            shape = [4, 6, 32, 32]
+            inputs = []
+            for size in (1, 5, 16, 3, 40):
+                shape[dim] = size
+                inputs.append(make_tensor(shape, device, dtype))
+            check(inputs, dim)
+            inputs[1] = inputs[1].transpose(2, 3).contiguous().transpose(2, 3)
+            inputs[3] = inputs[3].contiguous(memory_format=torch.channels_last)
+            check(inputs, dim)
+            check([t.contiguous(memory_format=torch.channels_last) for t in inputs], dim, torch.channels_last)
+            if dtype != torch.bool:
+                inputs[2] = inputs[2].to(torch.int8 if dtype.is_floating_point else torch.uint8)
+                check(inputs, dim)
+
+        inputs = [make_tensor((300, 8), device, dtype) for _ in range(100)]
+        expected = torch.empty((300, 100, 8), device=device, dtype=dtype)
+        for i, t in enumerate(inputs):
+            expected[:, i] = t
+        self.assertEqual(torch.stack(inputs, 1), expected, atol=0, rtol=0)
+        check(inputs[:50] + [torch.empty(0, device=device, dtype=dtype)] + inputs[50:], 0)
+
     @onlyCUDA
     def test_cat_preserve_channels_last(self, device):
         x = torch.randn((4, 3, 8, 8), device=device)
@@ -686,6 +724,39 @@ class TestTensorCreation(TestCase):
         self.assertEqual(res1, res2)
         self.assertTrue(res2.is_contiguous(memory_format=torch.channels_last))
 
+    @onlyCUDA
+    @dtypes(torch.half, torch.float, torch.complex128, torch.bool, torch.uint8)
+    def test_cat_many_inputs(self, device, dtype):
+        # More inputs than fit in the arguments of a kernel, of heterogeneous
+        # sizes along the cat dimension, so that units of various widths are
+        # copied
+        def check(inputs, dim):
+            expected = torch.cat([t.cpu() for t in inputs], dim)
+            result = torch.cat(inputs, dim)
+            self.assertEqual(result, expected, atol=0, rtol=0)
+            return result
+
+        sizes = [1, 2, 3, 4, 8, 16, 17]
+        for dim in range(3):
+            inputs = []
+            for i in range(300):
+                shape = [5, 6, 7]
+                shape[dim] = sizes[i % len(sizes)]
+                inputs.append(make_tensor(shape, device, dtype))
+            check(inputs, dim)
+            # Inputs that don't start at an aligned address
+            check([t.view(-1)[1:].view(-1, 1, 1) for t in inputs], 0)
+
+        inputs = [make_tensor((2, sizes[i % len(sizes)], 3, 4), device, dtype).contiguous(memory_format=torch.channels_last)
+                  for i in range(200)]
+        result = check(inputs, 1)
+        self.assertTrue(result.is_contiguous(memory_format=torch.channels_last))
+
+        # More than 4 dimensions, and the legacy empty inputs
+        inputs = [make_tensor((2, 3, 2, size, 2), device, dtype) for size in sizes]
+        inputs.insert(2, torch.empty(0, device=device, dtype=dtype))
+        check(inputs, 3)
+
     @onlyCUDA
     @deviceCountAtLeast(2)
     def test_cat_different_devices(self, devices):
@@ -1,3 +1,4 @@
+import io
 import numpy as np
 import torch
 import torch.nn.functional as F
@@ -149,6 +150,21 @@ class TestTensorExprFuser(BaseTestClass):
         assert cuda_cg_executed.elapsed_value() >= 1
         assert cuda_cg_created.elapsed_value() >= 1
 
+    @unittest.skipIf(not torch.cuda.is_available(), "requires CUDA")
+    def test_vectorized_cuda(self):
+        def test(x, y):
+            return torch.add(x, y).mul(2.0)
+
+        for dtype, size in [(torch.float, 1 << 17), (torch.half, 1 << 17), (torch.float, 1022)]:
+            a = torch.rand(size + 1, device="cuda", dtype=dtype)
+            b = torch.rand(size, device="cuda", dtype=dtype)
+            traced = torch.jit.trace(test, (b, b))
+            x = warmup_and_run_forward(traced, a[:size], b)
+            self.assertLastGraphAllFused()
+            self.assertEqual(x, test(a[:size], b))
+            # misaligned by one element
+            self.assertEqual(traced(a[1:], b), test(a[1:], b))
+
     def test_broadcast_cuda(self):
         if not torch.cuda.is_available():
             return
@@ -1306,6 +1322,24 @@ class TestTensorExprFuser(BaseTestClass):
             x = warmup_and_run_forward(traced, a, b)
             self.assertLastGraphAllFused()
 
+    @unittest.skipIf(not torch._C._llvm_enabled(), "requires LLVM")
+    def test_reduced_precision_cpu(self):
+        def bias_gelu(bias, y):
+            x = bias + y
+            return x * 0.5 * (1.0 + torch.erf(x / 1.41421))
+
+        for dtype in [torch.half, torch.bfloat16]:
+            # odd size for the vector tails, and nans
+            a = torch.rand(1027, dtype=dtype)
+            b = torch.rand(1027, dtype=dtype)
+            a[7] = float("nan")
+            traced = torch.jit.trace(bias_gelu, (a, b))
+            x = warmup_and_run_forward(traced, a, b)
+            self.assertLastGraphAllFused()
+            self.assertEqual(x.dtype, dtype)
+            ref = bias_gelu(a.float(), b.float()).to(dtype)
+            self.assertEqual(x, ref, atol=1e-2, rtol=1e-2)
+
     def test_exp_pow(self):
         devices = ["cuda", "cpu"] if torch.cuda.is_available() else ["cpu"]
 
@@ -1351,6 +1385,35 @@ class TestTensorExprFuser(BaseTestClass):
         # FIXME: interp.elapsed_value() also increments due to simplifier
         assert llvm.elapsed_value() == 1 or interp.elapsed_value() > 1
 
+    @unittest.skipIf(not torch._C._llvm_enabled(), "requires LLVM")
+    def test_aot_kernels(self):
+        class M(torch.nn.Module):
+            def forward(self, x, y):
+                return torch.sigmoid(x + y) * 2
+
+        torch._C._jit_set_te_must_use_llvm_cpu(True)
+        torch._C._te.clear_aot_kernels()
+        torch._C._te.set_aot_recording(True)
+        try:
+            x, y = torch.rand(8, 16), torch.rand(8, 16)
+            m = torch.jit.script(M())
+            ref = warmup_and_run_forward(m, x, y)
+            self.assertLastGraphAllFused()
+            keys = torch._C._te.aot_kernel_keys()
+            self.assertGreater(len(keys), 0)
+            buffer = io.BytesIO()
+            torch.jit.save(m, buffer)
+        finally:
+            torch._C._te.set_aot_recording(False)
+
+        torch._C._te.clear_aot_kernels()
+        buffer.seek(0)
+        loaded = torch.jit.load(buffer)
+        self.assertEqual(sorted(torch._C._te.aot_kernel_keys()), sorted(keys))
+        res = warmup_and_run_forward(loaded, x, y)
+        np.testing.assert_allclose(ref.numpy(), res.numpy())
+        torch._C._te.clear_aot_kernels()
+
     @unittest.skipIf(not torch.cuda.is_available(), "requires CUDA")
     @unittest.skip("dynamic shapes are not quite there yet")
     def test_dynamic_shape(self):
@@ -1,4 +1,7 @@
 
+import sys
+import unittest
+
 import torch
 from torch.utils import ThroughputBenchmark
 from torch.testing import assert_allclose
@@ -33,7 +36,7 @@ class TwoLayerNetModule(torch.nn.Module):
         return y_pred
 
 class TestThroughputBenchmark(TestCase):
-    def linear_test(self, Module, profiler_output_path=""):
+    def linear_test(self, Module, profiler_output_path="", **kwargs):
         D_in = 10
         H = 5
         D_out = 15
@@ -63,9 +66,16 @@ class TestThroughputBenchmark(TestCase):
             num_warmup_iters=100,
             num_iters=1000,
             profiler_output_path=profiler_output_path,
+            **kwargs
         )
 
         print(stats)
+        self.assertEqual(stats.num_iters, 1000)
+        self.assertGreater(stats.latency_p50_ms, 0)
+        self.assertLessEqual(stats.latency_p50_ms, stats.latency_p90_ms)
+        self.assertLessEqual(stats.latency_p90_ms, stats.latency_p99_ms)
+        self.assertLessEqual(stats.latency_p99_ms, stats.latency_p999_ms)
+        return stats
 
 
     def test_script_module(self):
@@ -78,6 +88,16 @@ class TestThroughputBenchmark(TestCase):
         with TemporaryFileName() as fname:
             self.linear_test(TwoLayerNetModule, profiler_output_path=fname)
 
+    def test_open_loop(self):
+        stats = self.linear_test(TwoLayerNet, target_qps=2000)
+        # 1000 requests arriving at 2000 per second can't finish much earlier
+        # than the last arrival
+        self.assertGreater(stats.total_time_seconds, 0.25)
+
+    @unittest.skipIf(not sys.platform.startswith('linux'), "Pinning is only supported on Linux")
+    def test_cpu_affinity(self):
+        self.linear_test(TwoLayerNet, cpu_affinity=[0])
+
 
 if __name__ == '__main__':
     run_tests()
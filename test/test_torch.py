@@ -304,6 +304,22 @@ class AbstractTestCases:
             self.assertEqual(y[:, 0], range(100))
             self.assertEqual(y[:, 40], range(4000, 4100))
 
+        def test_copy_transpose_tiled(self):
+            # sizes that aren't multiples of the tiles, element sizes of
+            # 1 to 16 bytes and conversions between floating types
+            for dtype in (torch.uint8, torch.half, torch.float, torch.double, torch.cdouble):
+                x = torch.arange(67 * 130).reshape(67, 130).to(dtype)
+                self.assertEqual(x.t().contiguous(), x.t().tolist())
+                y = torch.arange(2 * 3 * 37 * 41).reshape(2, 3, 37, 41).to(dtype)
+                nhwc = y.contiguous(memory_format=torch.channels_last)
+                self.assertEqual(nhwc, y)
+                self.assertEqual(nhwc.contiguous(), y)
+            x = torch.randn(100, 75, dtype=torch.double)
+            for dtype in (torch.half, torch.bfloat16, torch.float):
+                y = torch.empty(75, 100, dtype=dtype)
+                y.copy_(x.t())
+                self.assertEqual(y, x.t().to(dtype), atol=0, rtol=0)
+
         def test_device(self):
             cpu = torch.device('cpu')
             self.assertEqual('cpu', str(cpu))
@@ -1706,6 +1722,24 @@ class AbstractTestCases:
                                    "missing 1 required positional arguments",
                                    lambda: torch.tensor().new_zeros((5, 5), 0))
 
+        def test_parsing_cached_overloads(self):
+            # the overload that matched is cached by argument types, make sure
+            # that arguments of the same types still pick overloads by value
+            x = torch.randn(2, 3, names=('N', 'C'))
+            y = torch.randn(2, 3)
+            for _ in range(3):
+                self.assertEqual(x.sum((0, 1)), x.rename(None).sum())
+                self.assertEqual(x.sum(('N',)).names, ('C',))
+                self.assertEqual(y.sum(0), y.sum(torch.tensor(0)))
+                self.assertRaises(TypeError, lambda: y.sum(torch.tensor(0.)))
+                self.assertEqual(y.add(1), y + 1)
+                self.assertEqual(y.add(torch.tensor(1.)), y + 1)
+                self.assertEqual(y.add(y), y * 2)
+                self.assertEqual(y.view(6).shape, (6,))
+                self.assertEqual(y.view(torch.int32).dtype, torch.int32)
+                self.assertEqual(y.to(torch.float64).dtype, torch.float64)
+                self.assertEqual(y.to(torch.ones(1, dtype=torch.int64)).dtype, torch.int64)
+
         def test_half_tensor(self):
             devices = ["cpu"]
             if torch.cuda.is_available():
@@ -2606,6 +2640,41 @@ tensor([[[1.+1.j, 1.+1.j, 1.+1.j,  ..., 1.+1.j, 1.+1.j, 1.+1.j],
             self.assertEqual(z.size(), (2 * 10 ** 8, 3, 4 * 10 ** 8))
             self.assertRaises(RuntimeError, lambda: z[0][0][0].item())
 
+        def test_inference_ops_meta(self):
+            # Running a model on meta tensors only computes the shapes, so
+            # compare them with the ones of a CPU run
+            F = torch.nn.functional
+
+            def model(x, conv_w, conv_b, bn_mean, bn_var, fc_w, fc_b):
+                y = F.conv2d(x, conv_w, conv_b, stride=2, padding=1)
+                y = F.batch_norm(y, bn_mean, bn_var)
+                y = F.relu(y)
+                y = F.max_pool2d(y, 3, stride=2, padding=1)
+                y = torch.cat([y, F.avg_pool2d(y, 1)], dim=1)
+                z = F.adaptive_avg_pool2d(y, (2, 2))
+                y = F.adaptive_avg_pool2d(y, 1).flatten(1)
+                y = F.linear(y, fc_w, fc_b)
+                a = torch.matmul(y.unsqueeze(0).expand(3, -1, -1), fc_w)
+                return (F.softmax(y, dim=1), F.log_softmax(y, dim=1), torch.tanh(y),
+                        torch.sigmoid(a), F.gelu(a), F.hardtanh(a), z.sum((2, 3)),
+                        z.mean(1, keepdim=True), z.amax(0), z.amin((0, 1)), z.sum(),
+                        y.t().contiguous(), y.view(-1), y.reshape(2, -1), a.clone())
+
+            args = [torch.randn(4, 3, 32, 32), torch.randn(8, 3, 3, 3), torch.randn(8),
+                    torch.randn(8), torch.rand(8), torch.randn(10, 16), torch.randn(10)]
+            expected = model(*args)
+            actual = model(*[torch.empty(a.size(), device='meta') for a in args])
+            for e, a in zip(expected, actual):
+                self.assertEqual(a.device.type, 'meta')
+                self.assertEqual(a.size(), e.size())
+                self.assertEqual(a.dtype, e.dtype)
+
+            # the non-structured operators check their arguments too
+            x = torch.empty(4, 3, device='meta')
+            self.assertRaises(RuntimeError, lambda: torch.mm(x, x))
+            self.assertRaises(RuntimeError, lambda: torch.cat([x, x.t()], dim=0))
+            self.assertRaises(RuntimeError, lambda: x.view(5))
+
         def test_normal_shape(self):
             warned = False
             for device in torch.testing.get_all_device_types():
@@ -3734,6 +3803,32 @@ class TestTorchDeviceType(TestCase):
                 res = stats.kstest(t.cpu().to(torch.double), 'norm', args=(mean, std))
                 self.assertTrue(res.statistic < 0.1)
 
+    @skipIfNoSciPy
+    @onlyCPU
+    @dtypes(torch.float, torch.double)
+    def test_parallel_random_kstest(self, device, dtype):
+        # large tensors are filled in parallel, with results that don't
+        # depend on the number of threads
+        from scipy import stats
+        size = 100003
+        num_threads = torch.get_num_threads()
+        results = []
+        try:
+            for threads in [1, 4]:
+                torch.set_num_threads(threads)
+                gen = torch.Generator().manual_seed(123)
+                u = torch.empty(size, dtype=dtype).uniform_(-2, 3, generator=gen)
+                n = torch.empty(size, dtype=dtype).normal_(4, 2, generator=gen)
+                b = torch.empty(size, dtype=dtype).bernoulli_(0.3, generator=gen)
+                results.append((u, n, b))
+        finally:
+            torch.set_num_threads(num_threads)
+        self.assertEqual(results[0], results[1], atol=0, rtol=0)
+        u, n, b = results[0]
+        self.assertTrue(stats.kstest(u.double(), 'uniform', args=(-2, 5)).statistic < 0.01)
+        self.assertTrue(stats.kstest(n.double(), 'norm', args=(4, 2)).statistic < 0.01)
+        self.assertEqual(b.mean().item(), 0.3, atol=0.01, rtol=0)
+
     @skipIfNoSciPy
     @dtypes(*torch.testing.get_all_fp_dtypes())
     def test_lognormal_kstest(self, device, dtype):
@@ -3898,6 +3993,21 @@ class TestTorchDeviceType(TestCase):
             expected = self._brute_cdist(x, y, p=2)
             self.assertEqual(expected, actual)
 
+    @tf32_on_and_off(0.005)
+    def test_cdist_topk(self, device):
+        for r1, r2, k in ((0, 10, 3), (5, 10, 0), (7, 10, 10), (1500, 9000, 5)):
+            x = torch.randn(r1, 16, device=device)
+            y = torch.randn(r2, 16, device=device)
+            values, indices = torch._cdist_topk(x, y, k)
+            self.assertEqual(values.shape, (r1, k))
+            self.assertEqual(indices.dtype, torch.long)
+            dist = torch.cdist(x, y)
+            self.assertEqual(values, dist.topk(k, largest=False)[0], atol=1e-4, rtol=0)
+            self.assertEqual(values, dist.gather(1, indices), atol=1e-4, rtol=0)
+
+        with self.assertRaisesRegex(RuntimeError, "k .* must be in"):
+            torch._cdist_topk(torch.randn(2, 3, device=device), torch.randn(4, 3, device=device), 5)
+
     @slowTest
     @tf32_on_and_off(0.01)
     def test_cdist_large_batch(self, device):
@@ -4524,6 +4634,20 @@ class TestTorchDeviceType(TestCase):
             for i in range(idx.size(0)):
                 self.assertEqual(dest[i], src[idx[i]])
 
+            # Rows of every size, along every dim, more of them than are
+            # prefetched ahead, compared against advanced indexing
+            idx = torch.randint(0, 7, (50,), dtype=dtype, device=device)
+            for src_dtype in [torch.uint8, torch.int16, torch.float, torch.double, torch.complex128]:
+                for shape in [(7,), (7, 1), (7, 3), (2, 7, 5), (2, 3, 7)]:
+                    src = torch.arange(torch.Size(shape).numel(), device=device).view(shape).to(src_dtype)
+                    dim = shape.index(7)
+                    dest = torch.index_select(src, dim, idx)
+                    self.assertEqual(dest, src[(slice(None),) * dim + (idx.long(),)])
+            if torch.device(device).type == 'cpu':
+                with self.assertRaises(IndexError):
+                    torch.index_select(torch.randn(7, 3, device=device), 0,
+                                       torch.tensor([0, 7], dtype=dtype, device=device))
+
     def test_take_empty(self, device):
         for input_shape in [(0,), (0, 1, 2, 0), (1, 2, 3)]:
             for indices_shape in [(0,), (0, 1, 2, 0)]:
@@ -4686,6 +4810,29 @@ class TestTorchDeviceType(TestCase):
                                             [False, True, False, True, False],
                                             [True, False, True, False, True]], device=device))
 
+    def test_scatter_add_index_add_many_duplicates(self, device):
+        # Large enough for the parallel accumulation paths of the CPU kernels,
+        # with a dense and a sparse set of destinations.
+        num_src, features = 20000, 4
+        for num_dest in [100, 200000]:
+            idx = torch.randint(0, num_dest, (num_src,), device=device)
+            src = torch.randn(num_src, features, dtype=torch.double, device=device)
+            expected = torch.zeros(num_dest, features, dtype=torch.double, device=device)
+            expected.index_put_((idx,), src, accumulate=True)
+
+            res = torch.zeros(num_dest, features, dtype=torch.double, device=device)
+            self.assertEqual(res.index_add_(0, idx, src), expected)
+            res = torch.zeros(num_dest, features, dtype=torch.double, device=device)
+            self.assertEqual(res.scatter_add_(0, idx.unsqueeze(1).expand_as(src), src), expected)
+
+            # every column has its own index
+            idx2d = torch.randint(0, num_dest, (num_src, features), device=device)
+            cols = torch.arange(features, device=device).expand_as(idx2d)
+            expected = torch.zeros(num_dest, features, dtype=torch.double, device=device)
+            expected.index_put_((idx2d, cols), src, accumulate=True)
+            res = torch.zeros(num_dest, features, device=device)
+            self.assertEqual(res.scatter_add_(0, idx2d, src.float()), expected.float())
+
     @onlyOnCPUAndCUDA
     @dtypes(*torch.testing.get_all_dtypes())
     def test_masked_scatter(self, device, dtype):
@@ -4808,6 +4955,15 @@ class TestTorchDeviceType(TestCase):
                 torch.masked_select(v, m, out=out_dc)
                 self.assertEqual(out_dc, expected, atol=0, rtol=0)
 
+    def test_masked_select_large(self, device):
+        # large enough to be counted and copied out in several chunks
+        vals = torch.rand(300, 1000, device=device)
+        mask = torch.rand(300, 1000, device=device) < 0.3
+        for v, m in ((vals, mask), (vals.t(), mask.t()), (vals, mask[0])):
+            expected = torch.from_numpy(v.cpu().numpy()[np.broadcast_to(m.cpu().numpy(), v.shape)])
+            self.assertEqual(torch.masked_select(v, m).cpu(), expected, atol=0, rtol=0)
+            self.assertEqual(torch.masked_select(v, m.byte()).cpu(), expected, atol=0, rtol=0)
+
     @dtypes(*product(torch.testing.get_all_dtypes(), (torch.uint8, torch.bool)))
     def test_masked_fill(self, device, dtypes):
         dtype = dtypes[0]
@@ -5831,6 +5987,44 @@ class TestTorchDeviceType(TestCase):
         z = from_dlpack(to_dlpack(x))
         self.assertEqual(z, x)
 
+    def test_dlpack_protocol(self, device):
+        x = torch.randn(2, 3, 4, device=device)[:, :, ::2]
+        z = from_dlpack(x)
+        self.assertEqual(z, x)
+        self.assertEqual(z.data_ptr(), x.data_ptr())
+        self.assertEqual(z.stride(), x.stride())
+
+        device_type, index = x.__dlpack_device__()
+        if x.is_cuda:
+            self.assertIn(device_type, (2, 10))
+            self.assertEqual(index, x.device.index)
+        else:
+            self.assertEqual((device_type, index), (1, 0))
+
+        with self.assertRaisesRegex(RuntimeError, "require gradient"):
+            x.clone().requires_grad_().__dlpack__()
+        with self.assertRaisesRegex(TypeError, "stream must be"):
+            x.__dlpack__(stream=1.5)
+
+    @onlyCUDA
+    def test_dlpack_protocol_stream(self, device):
+        # The consumer stream waits for the work of the producer stream,
+        # without synchronizing the device
+        producer = torch.cuda.Stream(device)
+        consumer = torch.cuda.Stream(device)
+        with torch.cuda.stream(producer):
+            torch.cuda._sleep(100000000)
+            x = torch.ones(1000, device=device)
+            x.mul_(2)
+        with torch.cuda.stream(consumer):
+            z = from_dlpack(x)
+            self.assertFalse(consumer.query())
+            self.assertEqual(z.sum().item(), 2000)
+
+        x = torch.zeros(10, device=device)
+        for stream in (None, -1, 1, 2, producer.cuda_stream):
+            self.assertEqual(from_dlpack(x.__dlpack__(stream=stream)), x)
+
     @onlyCUDA
     @unittest.skipIf(PYTORCH_CUDA_MEMCHECK, "is_pinned uses failure to detect pointer property")
     def test_pin_memory_from_constructor(self, device):
@@ -5960,6 +6154,39 @@ class TestTorchDeviceType(TestCase):
             self.assertEqual(prob_dist.dim(), 1, msg="wrong number of prob_dist dimensions")
             self.assertEqual(sample_indices.size(0), n_sample, msg="wrong number of samples")
 
+    @dtypes(torch.float, torch.double)
+    def test_multinomial_alias(self, device, dtype):
+        probs = torch.tensor([0.1, 0, 3, 0.4, 0.5, 6, 0, 2], device=device, dtype=dtype)
+        J, q = torch._multinomial_alias_setup(probs)
+        self.assertEqual(J.dtype, torch.long)
+        self.assertEqual(q.dtype, dtype)
+        self.assertEqual(J.device, probs.device)
+
+        # Category k keeps q[k] of its slot and gives the rest to J[k]
+        n_categories = probs.numel()
+        expected = probs.double().cpu() / probs.sum().item()
+        reconstructed = q.double().cpu().clone()
+        reconstructed.index_add_(0, J.cpu(), 1 - q.double().cpu())
+        self.assertEqual(reconstructed / n_categories, expected)
+
+        n_sample = 100000
+        samples = torch._multinomial_alias_draw(J, q, n_sample)
+        self.assertEqual(samples.shape, (n_sample,))
+        self.assertEqual(samples.device, probs.device)
+        freqs = torch.bincount(samples, minlength=n_categories).double().cpu() / n_sample
+        self.assertEqual(freqs[probs.cpu() == 0].sum().item(), 0)
+        self.assertEqual(freqs, expected, atol=0.01, rtol=0)
+
+        gen = torch.Generator(device=device)
+        gen.manual_seed(1)
+        samples1 = torch._multinomial_alias_draw(J, q, 100, generator=gen)
+        gen.manual_seed(1)
+        samples2 = torch._multinomial_alias_draw(J, q, 100, generator=gen)
+        self.assertEqual(samples1, samples2)
+
+        with self.assertRaisesRegex(RuntimeError, "invalid multinomial distribution"):
+            torch._multinomial_alias_setup(torch.tensor([1., -1.], device=device))
+
     @slowTest
     @dtypes(torch.float)
     def test_multinomial_rng_state_advance(self, device, dtype):
@@ -669,6 +669,37 @@ class TestAssert(TestCase):
             ms(torch.tensor([False], dtype=torch.bool))
 
 
+class TestVitals(TestCase):
+    def test_metrics(self):
+        import torch.utils.vitals as vitals
+        vitals.reset()
+        vitals.counter("test.requests").add()
+        vitals.counter("test.requests").add(2)
+        vitals.gauge("test.queue_depth").set(4)
+        latency = vitals.histogram("test.latency_ms", [1., 10.])
+        latency.observe(0.5)
+        latency.observe(20.)
+
+        snapshot = vitals.snapshot()
+        self.assertEqual(snapshot["test.requests"], 3)
+        self.assertEqual(snapshot["test.queue_depth"], 4)
+        self.assertEqual(snapshot["test.latency_ms"],
+                         {'bounds': [1., 10.], 'counts': [1, 0, 1], 'count': 2, 'sum': 20.5})
+        with self.assertRaisesRegex(RuntimeError, "already registered as a counter"):
+            vitals.gauge("test.requests")
+
+        vitals.reset()
+        self.assertEqual(vitals.counter("test.requests").value(), 0)
+        self.assertEqual(vitals.gauge("test.queue_depth").value(), 4)
+
+    def test_builtin_metrics(self):
+        import torch.utils.vitals as vitals
+        before = vitals.counter("autograd.backward_calls").value()
+        torch.randn(2, requires_grad=True).sum().backward()
+        self.assertEqual(vitals.counter("autograd.backward_calls").value(), before + 1)
+        self.assertEqual(vitals.gauge("dataloader.tasks_outstanding").value(), 0)
+
+
 @unittest.skipIf(IS_SANDCASTLE, "cpp_extension is OSS only")
 class TestStandaloneCPPJIT(TestCase):
     def test_load_standalone(self):
@@ -1398,6 +1398,44 @@ class TestVmapOperators(Namespace.TestVmapBase):
             number = getter([]).item()
             self._test_unary(lambda t: op(t, number), getter, 'cpu', check_propagates_grad=False)
 
+    def test_conv2d(self):
+        op = F.conv2d
+        test = self._vmap_test
+        B0, B1 = 7, 11
+
+        # shape mismatch
+        msg = "Shape mismatch"
+        with self.assertRaisesRegex(RuntimeError, msg):
+            vmap(op, in_dims=(0, None))(torch.randn(B0, 3, 5, 5), torch.randn(4, 3, 3, 3))
+
+        # input is vmapped
+        test(op, (torch.rand(B0, 2, 3, 5, 5), torch.rand(4, 3, 3, 3)), in_dims=(0, None))
+        test(op, (torch.rand(2, 3, B0, 5, 5), torch.rand(4, 3, 3, 3), torch.rand(4)),
+             in_dims=(2, None, None))
+
+        # weight is vmapped
+        test(op, (torch.rand(2, 3, 5, 5), torch.rand(B0, 4, 3, 3, 3)), in_dims=(None, 0))
+        test(op, (torch.rand(2, 3, 5, 5), torch.rand(4, 3, B0, 3, 3), torch.rand(4)),
+             in_dims=(None, 2, None))
+
+        # bias is vmapped
+        test(op, (torch.rand(2, 3, 5, 5), torch.rand(4, 3, 3, 3), torch.rand(B0, 4)),
+             in_dims=(None, None, 0))
+
+        # input and weight are vmapped, with and without groups
+        test(op, (torch.rand(B0, 2, 3, 5, 5), torch.rand(B0, 4, 3, 3, 3)))
+        test(lambda x, w: op(x, w, stride=2, padding=1, groups=2),
+             (torch.rand(B0, 2, 4, 5, 5), torch.rand(B0, 6, 2, 3, 3)))
+        test(vmap(op, in_dims=(0, None)),
+             (torch.rand(B1, B0, 2, 3, 5, 5), torch.rand(B0, 4, 3, 3, 3)), in_dims=(1, 0))
+
+        # transposed convolution
+        op = F.conv_transpose2d
+        test(op, (torch.rand(B0, 2, 4, 5, 5), torch.rand(4, 3, 3, 3)), in_dims=(0, None))
+        test(op, (torch.rand(2, 4, 5, 5), torch.rand(B0, 4, 3, 3, 3)), in_dims=(None, 0))
+        test(lambda x, w: op(x, w, groups=2),
+             (torch.rand(B0, 2, 4, 5, 5), torch.rand(B0, 4, 3, 3, 3)))
+
     def test_diagonal(self):
         tensor = torch.randn(3, 5, 7, 11, 13)
         test = self._vmap_view_test
@@ -1583,6 +1621,39 @@ class TestVmapOperators(Namespace.TestVmapBase):
         self.assertEqual(vmap(foo)(ctensor), torch.tensor([1, 1, 1]))
         self.assertEqual(vmap(foo)(tensor), torch.tensor([0, 0, 0]))
 
+    def test_gather(self):
+        op = torch.gather
+        test = self._vmap_test
+        B0, B1 = 7, 11
+
+        # self is vmapped
+        test(op, (torch.rand(B0, 3, 5), 1, torch.randint(5, (3, 2))), in_dims=(0, None, None))
+        # index is vmapped
+        test(op, (torch.rand(3, 5), 1, torch.randint(5, (B0, 3, 2))), in_dims=(None, None, 0))
+        # both are vmapped
+        test(op, (torch.rand(3, B0, 5), 0, torch.randint(3, (2, 5, B0))), in_dims=(1, None, 2))
+        test(vmap(op, in_dims=(0, None, 0)),
+             (torch.rand(B1, B0, 3, 5), -1, torch.randint(5, (B1, 3, 2))),
+             in_dims=(1, None, None))
+
+    def test_index_select(self):
+        op = torch.index_select
+        test = self._vmap_test
+        B0, B1 = 7, 11
+        index = torch.tensor([0, 2, 2])
+
+        # self is vmapped
+        test(op, (torch.rand(B0, 3, 5), 0, index), in_dims=(0, None, None))
+        test(op, (torch.rand(3, B0, 5), -1, index), in_dims=(1, None, None))
+        # index is vmapped
+        test(op, (torch.rand(3, 5), 0, torch.randint(3, (B0, 4))), in_dims=(None, None, 0))
+        # both are vmapped
+        test(op, (torch.rand(B0, 3, 5), 1, torch.randint(5, (4, B0))), in_dims=(0, None, 1))
+        test(op, (torch.rand(B0), 0, torch.zeros(B0, 1, dtype=torch.long)), in_dims=(0, None, 0))
+        test(vmap(op, in_dims=(0, None, 0)),
+             (torch.rand(B1, B0, 3, 5), 0, torch.randint(3, (B1, 4))),
+             in_dims=(1, None, None))
+
     def test_is_contiguous(self):
         def foo(x):
             if x.is_contiguous():
@@ -1639,6 +1710,35 @@ class TestVmapOperators(Namespace.TestVmapBase):
         with self.assertRaisesRegex(RuntimeError, msg):
             vmap(functools.partial(baz, memory_format=torch.channels_last_3d))(tensor)
 
+    def test_linalg_ops(self):
+        test = self._vmap_test
+        B0, B1 = 7, 11
+
+        def get_spd(*batch_shape):
+            a = torch.rand(*batch_shape, 3, 3, dtype=torch.double)
+            return a @ a.transpose(-1, -2) + 3 * torch.eye(3, dtype=torch.double)
+
+        # shape mismatch
+        msg = "Expected a tensor with 2 or more dimensions"
+        with self.assertRaisesRegex(RuntimeError, msg):
+            vmap(torch.inverse)(torch.rand(B0, 3))
+
+        ops = [
+            torch.inverse, torch.det, torch.logdet, torch.matrix_exp,
+            torch.cholesky, lambda x: torch.cholesky(x, upper=True),
+            torch.linalg.inv, torch.linalg.det, torch.linalg.cholesky,
+            torch.linalg.eigvalsh, lambda x: torch.linalg.eigvalsh(x, UPLO='U'),
+        ]
+        for op in ops:
+            test(op, (get_spd(B0),))
+            test(op, (get_spd(2, B0).movedim(1, 0),), in_dims=1)
+            test(vmap(op), (get_spd(B1, B0),), in_dims=1)
+
+        # The sign returned by slogdet does not require grad.
+        for op in [torch.slogdet, torch.linalg.slogdet]:
+            test(op, (get_spd(B0),), check_propagates_grad=False)
+            test(vmap(op), (get_spd(B1, B0),), in_dims=1, check_propagates_grad=False)
+
     def test_movedim(self):
         op = torch.movedim
         test = self._vmap_view_test
@@ -1659,6 +1759,35 @@ class TestVmapOperators(Namespace.TestVmapBase):
         test(vmap(vmap(op, in_dims=(2, None, None)), in_dims=(0, None, None)),
              (torch.rand(B1, 2, B0, 5, B2), [0, 1], [1, 0]), in_dims=(2, None, None))
 
+    def test_matmul(self):
+        op = torch.matmul
+        test = self._vmap_test
+        B0, B1 = 7, 11
+
+        # shape mismatch
+        msg = "Shape mismatch"
+        with self.assertRaisesRegex(RuntimeError, msg):
+            vmap(op)(torch.randn(B0), torch.randn(B0, 2))
+
+        shapes = [
+            ((5,), (5,)), ((2, 5), (5,)), ((5,), (5, 2)), ((2, 5), (5, 2)),
+            ((3, 2, 5), (5,)), ((5,), (3, 5, 2)), ((3, 2, 5), (5, 2)),
+            ((2, 5), (3, 5, 2)), ((3, 2, 5), (3, 5, 2)), ((4, 1, 2, 5), (3, 5, 2)),
+        ]
+        for self_shape, other_shape in shapes:
+            # left arg is vmapped
+            test(op, (torch.rand(B0, *self_shape), torch.rand(*other_shape)), in_dims=(0, None))
+            # right arg is vmapped
+            test(op, (torch.rand(*self_shape), torch.rand(B0, *other_shape)), in_dims=(None, 0))
+            # both args are vmapped
+            test(op, (torch.rand(B0, *self_shape), torch.rand(B0, *other_shape)))
+
+        test(vmap(op, in_dims=(0, None)), (torch.rand(B1, B0, 2, 5), torch.rand(5, 2)),
+             in_dims=(1, None))
+        test(vmap(op), (torch.rand(B1, B0, 2, 5), torch.rand(B0, B1, 5)), in_dims=(1, 0))
+        test(vmap(op, in_dims=(0, None)),
+             (torch.rand(B1, 5), torch.rand(B0, 3, 5, 2)), in_dims=(None, 0))
+
     def test_mm(self):
         op = torch.mm
         test = self._vmap_test
@@ -1797,6 +1926,37 @@ class TestVmapOperators(Namespace.TestVmapBase):
         test(lambda x: op(x, []), (torch.rand(B0),))
         test(vmap(lambda x: op(x, 3, 5)), (torch.rand(B0, B1),))
 
+    def test_scatter(self):
+        test = self._vmap_test
+        B0, B1 = 7, 11
+
+        def get_index(*shape):
+            # rows of unique indices into a dim of size 5 so that scatter is deterministic
+            return torch.stack([torch.randperm(5)[:shape[-1]]
+                                for _ in range(functools.reduce(lambda x, y: x * y, shape[:-1]))]
+                               ).view(shape)
+
+        for op in [torch.scatter, torch.scatter_add]:
+            # self is vmapped
+            test(op, (torch.rand(B0, 3, 5), 1, get_index(3, 2), torch.rand(3, 2)),
+                 in_dims=(0, None, None, None))
+            # index and src are vmapped
+            test(op, (torch.rand(3, 5), 1, get_index(B0, 3, 2), torch.rand(B0, 3, 2)),
+                 in_dims=(None, None, 0, 0))
+            # src is vmapped
+            test(op, (torch.rand(3, 5), -1, get_index(3, 2), torch.rand(3, B0, 2)),
+                 in_dims=(None, None, None, 1))
+            # everything is vmapped
+            test(op, (torch.rand(B0, 3, 5), 1, get_index(B0, 3, 2), torch.rand(B0, 3, 2)),
+                 in_dims=(0, None, 0, 0))
+            test(vmap(op, in_dims=(0, None, None, 0)),
+                 (torch.rand(B1, B0, 3, 5), 1, get_index(B0, 3, 2), torch.rand(B1, 3, 2)),
+                 in_dims=(1, None, 0, None))
+
+        op = torch.scatter
+        test(op, (torch.rand(B0, 3, 5), 1, get_index(3, 2), 1.5), in_dims=(0, None, None, None))
+        test(op, (torch.rand(3, 5), 1, get_index(B0, 3, 2), 1.5), in_dims=(None, None, 0, None))
+
     def test_select(self):
         op = torch.select
         test = self._vmap_view_test
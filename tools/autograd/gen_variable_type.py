@@ -230,7 +230,7 @@ if (compute_requires_grad( ${args_to_check} )) {
 """)
 
 ASSIGN_GRAD_FN = CodeTemplate("""\
-grad_fn = std::shared_ptr<${op}>(new ${op}(${op_ctor}), deleteNode);
+grad_fn = std::shared_ptr<${op}>(new ${op}(${op_ctor}), deleteNode, NodePoolAllocator<${op}>());
 grad_fn->set_next_edges(collect_next_edges( ${args_with_derivatives} ));
 """)
 
@@ -67,6 +67,21 @@ static PyObject * THPVariable__is_view(PyObject *self, PyObject* args)
   END_HANDLE_TH_ERRORS
 }
 
+static PyObject * THPVariable_is_inference(PyObject *self, PyObject* args)
+{
+  HANDLE_TH_ERRORS
+  if (check_has_torch_function(self)) {
+    return handle_torch_function(self, "is_inference", args);
+  }
+  auto& self_ = reinterpret_cast<THPVariable*>(self)->cdata;
+  if (self_.is_inference()) {
+    Py_RETURN_TRUE;
+  } else {
+    Py_RETURN_FALSE;
+  }
+  END_HANDLE_TH_ERRORS
+}
+
 // implemented on the python object bc no support for first-class functions in native_functions.yaml
 // See: ATen/native/README.md for more context
 static PyObject * THPVariable_apply_(PyObject* self, PyObject* arg)
@@ -1185,6 +1200,7 @@ PyMethodDef variable_methods[] = {
   {"half", castPyCFunctionWithKeywords(THPVariable_half), METH_VARARGS | METH_KEYWORDS, NULL},
   {"int", castPyCFunctionWithKeywords(THPVariable_int), METH_VARARGS | METH_KEYWORDS, NULL},
   {"is_contiguous", castPyCFunctionWithKeywords(THPVariable_is_contiguous), METH_VARARGS | METH_KEYWORDS, NULL},
+  {"is_inference", THPVariable_is_inference, METH_NOARGS, NULL},
   {"item", THPVariable_item, METH_NOARGS, NULL},
   {"long", castPyCFunctionWithKeywords(THPVariable_long), METH_VARARGS | METH_KEYWORDS, NULL},
   {"map_", castPyCFunctionWithKeywords(THPVariable_map_), METH_VARARGS | METH_KEYWORDS, NULL},
@@ -107,10 +107,12 @@ libtorch_sources_common = core_sources_common
 core_trainer_sources = [
     "torch/csrc/autograd/anomaly_mode.cpp",
     "torch/csrc/autograd/autograd.cpp",
+    "torch/csrc/autograd/backward_timing.cpp",
     "torch/csrc/autograd/cpp_hook.cpp",
     "torch/csrc/autograd/custom_function.cpp",
     "torch/csrc/autograd/engine.cpp",
     "torch/csrc/autograd/function.cpp",
+    "torch/csrc/autograd/node_pool.cpp",
     "torch/csrc/autograd/function_hook.cpp",
     "torch/csrc/autograd/functions/accumulate_grad.cpp",
     "torch/csrc/autograd/functions/basic_ops.cpp",
@@ -204,6 +206,8 @@ core_sources_full_mobile = [
     "torch/csrc/jit/passes/remove_mutation.cpp",
     "torch/csrc/jit/passes/prepack_folding.cpp",
     "torch/csrc/jit/passes/fold_conv_bn.cpp",
+    "torch/csrc/jit/passes/frozen_batch_norm_relu.cpp",
+    "torch/csrc/jit/passes/frozen_concat_linear.cpp",
     "torch/csrc/jit/passes/frozen_conv_folding.cpp",
     "torch/csrc/jit/passes/frozen_ops_to_mkldnn.cpp",
     "torch/csrc/jit/passes/frozen_graph_optimizations.cpp",
@@ -227,12 +231,14 @@ core_sources_full_mobile = [
     "torch/csrc/jit/passes/quantization/dedup_module_uses.cpp",
     "torch/csrc/jit/passes/quantization/finalize.cpp",
     "torch/csrc/jit/passes/quantization/fusion_passes.cpp",
+    "torch/csrc/jit/passes/quantization/quantized_regions.cpp",
     "torch/csrc/jit/python/update_graph_executor_opt.cpp",
     "torch/csrc/jit/runtime/argument_spec.cpp",
     "torch/csrc/jit/runtime/autodiff.cpp",
     "torch/csrc/jit/runtime/graph_executor.cpp",
     "torch/csrc/jit/runtime/interpreter.cpp",
     "torch/csrc/jit/runtime/logging.cpp",
+    "torch/csrc/jit/runtime/memory_plan.cpp",
     "torch/csrc/jit/runtime/profiling_graph_executor_impl.cpp",
     "torch/csrc/jit/runtime/profiling_record.cpp",
     "torch/csrc/jit/runtime/symbolic_script.cpp",
@@ -243,6 +249,7 @@ core_sources_full_mobile = [
     "torch/csrc/jit/serialization/python_print.cpp",
     "torch/csrc/jit/serialization/source_range_serialization.cpp",
     "torch/csrc/jit/tensorexpr/analysis.cpp",
+    "torch/csrc/jit/tensorexpr/aot_cache.cpp",
     "torch/csrc/jit/tensorexpr/block_codegen.cpp",
     "torch/csrc/jit/tensorexpr/bounds_inference.cpp",
     "torch/csrc/jit/tensorexpr/bounds_overlap.cpp",
@@ -277,10 +284,12 @@ core_sources_full_mobile = [
 ]
 
 core_sources_full = core_sources_full_mobile + [
+    "torch/csrc/jit/runtime/static/batching.cpp",
     "torch/csrc/jit/runtime/static/fusion.cpp",
     "torch/csrc/jit/runtime/static/impl.cpp",
     "torch/csrc/jit/runtime/static/ops.cpp",
     "torch/csrc/jit/runtime/static/passes.cpp",
+    "torch/csrc/jit/runtime/static/pool.cpp",
     "torch/csrc/jit/tensorexpr/external_functions.cpp",
 ]
 
@@ -322,6 +331,7 @@ libtorch_distributed_sources = [
     "torch/csrc/distributed/rpc/torchscript_functions.cpp",
     "torch/csrc/distributed/rpc/types.cpp",
     "torch/csrc/distributed/rpc/utils.cpp",
+    "torch/csrc/distributed/rpc/metrics/DefaultRpcMetricsHandler.cpp",
     "torch/csrc/distributed/rpc/metrics/registry.cpp",
 ]
 
@@ -442,6 +452,7 @@ libtorch_cuda_sources = libtorch_cuda_core_sources + [
 torch_cpp_srcs = [
     "torch/csrc/api/src/cuda.cpp",  # this just forwards stuff, no real CUDA
     "torch/csrc/api/src/data/datasets/mnist.cpp",
+    "torch/csrc/api/src/data/datasets/record_file.cpp",
     "torch/csrc/api/src/data/samplers/distributed.cpp",
     "torch/csrc/api/src/data/samplers/random.cpp",
     "torch/csrc/api/src/data/samplers/sequential.cpp",
@@ -540,6 +551,7 @@ libtorch_python_core_sources = [
     "torch/csrc/autograd/python_engine.cpp",
     "torch/csrc/autograd/python_function.cpp",
     "torch/csrc/autograd/python_hook.cpp",
+    "torch/csrc/autograd/python_saved_variable_hooks.cpp",
     "torch/csrc/autograd/python_legacy_variable.cpp",
     "torch/csrc/autograd/python_variable.cpp",
     "torch/csrc/autograd/python_variable_indexing.cpp",
@@ -575,6 +587,7 @@ libtorch_python_core_sources = [
     "torch/csrc/jit/runtime/static/init.cpp",
     "torch/csrc/jit/tensorexpr/tensorexpr_init.cpp",
     "torch/csrc/multiprocessing/init.cpp",
+    "torch/csrc/multiprocessing/shared_memory_pool.cpp",
     "torch/csrc/onnx/init.cpp",
     "torch/csrc/serialization.cpp",
     "torch/csrc/tensor/python_tensor.cpp",
@@ -650,6 +663,8 @@ aten_cpu_source_list = [
     "aten/src/ATen/ExpandUtils.cpp",
     "aten/src/ATen/MemoryOverlap.cpp",
     "aten/src/ATen/NamedTensorUtils.cpp",
+    "aten/src/ATen/NestedTensorImpl.cpp",
+    "aten/src/ATen/OperatorStatsObserver.cpp",
     "aten/src/ATen/ParallelCommon.cpp",
     "aten/src/ATen/ParallelNative.cpp",
     "aten/src/ATen/ParallelNativeTBB.cpp",
@@ -687,7 +702,6 @@ aten_cpu_source_list = [
     "aten/src/ATen/core/dispatch/Dispatcher.cpp",
     "aten/src/ATen/core/dispatch/ObservedOperators.cpp",
     "aten/src/ATen/core/dispatch/OperatorEntry.cpp",
-    "aten/src/ATen/core/grad_mode.cpp",
     "aten/src/ATen/core/interned_strings.cpp",
     "aten/src/ATen/core/ivalue.cpp",
     "aten/src/ATen/core/library.cpp",
@@ -707,6 +721,7 @@ aten_cpu_source_list = [
     "aten/src/ATen/native/UpSample.cpp",
     "aten/src/ATen/native/cpu/AdaptiveAvgPoolKernel.cpp",
     "aten/src/ATen/native/mkl/LinearAlgebra.cpp",
+    "aten/src/ATen/native/mkl/PackedLinear.cpp",
     "aten/src/ATen/native/mkl/SpectralOps.cpp",
     "aten/src/ATen/native/mkldnn/BinaryOps.cpp",
     "aten/src/ATen/native/mkldnn/Conv.cpp",
@@ -755,12 +770,14 @@ aten_native_source_list = [
     "aten/src/ATen/native/quantized/cpu/qlinear_dynamic.cpp",
     "aten/src/ATen/native/quantized/cpu/qlinear_prepack.cpp",
     "aten/src/ATen/native/quantized/cpu/qlinear_unpack.cpp",
+    "aten/src/ATen/native/quantized/cpu/qmatmul.cpp",
     "aten/src/ATen/native/quantized/cpu/qmul.cpp",
     "aten/src/ATen/native/quantized/cpu/qnormalization.cpp",
     "aten/src/ATen/native/quantized/cpu/qpool.cpp",
     "aten/src/ATen/native/quantized/cpu/qreduction.cpp",
     "aten/src/ATen/native/quantized/cpu/qrelu.cpp",
     "aten/src/ATen/native/quantized/cpu/qsigmoid.cpp",
+    "aten/src/ATen/native/quantized/cpu/qsoftmax.cpp",
     "aten/src/ATen/native/quantized/cpu/qsort.cpp",
     "aten/src/ATen/native/quantized/cpu/qtanh.cpp",
     "aten/src/ATen/native/quantized/cpu/qthreshold.cpp",
@@ -776,6 +793,7 @@ aten_native_source_list = [
     "aten/src/ATen/native/quantized/affine_quantizer_base.cpp",
     "aten/src/ATen/native/quantized/fake_quant_per_channel_affine.cpp",
     "aten/src/ATen/native/quantized/fake_quant_per_tensor_affine.cpp",
+    "aten/src/ATen/native/quantized/fused_obs_fake_quant.cpp",
     "aten/src/ATen/native/quantized/library.cpp",
     "aten/src/ATen/quantized/QTensorImpl.cpp",
     "aten/src/ATen/quantized/Quantizer.cpp",
@@ -798,6 +816,7 @@ aten_native_source_list = [
     "aten/src/ATen/native/Col2Im.cpp",
     "aten/src/ATen/native/ConstantPadNd.cpp",
     "aten/src/ATen/native/Convolution.cpp",
+    "aten/src/ATen/native/ConvolutionDirect2d.cpp",
     "aten/src/ATen/native/ConvolutionMM2d.cpp",
     "aten/src/ATen/native/ConvolutionMM3d.cpp",
     "aten/src/ATen/native/ConvolutionTBC.cpp",
@@ -818,6 +837,7 @@ aten_native_source_list = [
     "aten/src/ATen/native/FractionalMaxPool2d.cpp",
     "aten/src/ATen/native/FractionalMaxPool3d.cpp",
     "aten/src/ATen/native/FunctionOfAMatrixUtils.cpp",
+    "aten/src/ATen/native/FusedOptimizer.cpp",
     "aten/src/ATen/native/GatedLinearUnit.cpp",
     "aten/src/ATen/native/GridSampler.cpp",
     "aten/src/ATen/native/Im2Col.cpp",
@@ -844,6 +864,7 @@ aten_native_source_list = [
     "aten/src/ATen/native/NaiveConvolutionTranspose3d.cpp",
     "aten/src/ATen/native/NaiveDilatedConvolution.cpp",
     "aten/src/ATen/native/NamedTensor.cpp",
+    "aten/src/ATen/native/NestedTensorMath.cpp",
     "aten/src/ATen/native/Normalization.cpp",
     "aten/src/ATen/native/Onehot.cpp",
     "aten/src/ATen/native/PackedSequence.cpp",
@@ -900,22 +921,28 @@ aten_native_source_list = [
     "aten/src/ATen/native/cpu/Activation.cpp",
     "aten/src/ATen/native/cpu/BinaryOpsKernel.cpp",
     "aten/src/ATen/native/cpu/BlasKernel.cpp",
+    "aten/src/ATen/native/cpu/BucketizationKernel.cpp",
     "aten/src/ATen/native/cpu/CatKernel.cpp",
     "aten/src/ATen/native/cpu/ComplexKernel.cpp",
+    "aten/src/ATen/native/cpu/ConvolutionDirect2dKernel.cpp",
     "aten/src/ATen/native/cpu/CopyKernel.cpp",
     "aten/src/ATen/native/cpu/CrossKernel.cpp",
     "aten/src/ATen/native/cpu/DepthwiseConvKernel.cpp",
     "aten/src/ATen/native/cpu/DistanceOpsKernel.cpp",
+    "aten/src/ATen/native/cpu/EmbeddingBagBatchedKernel.cpp",
     "aten/src/ATen/native/cpu/FillKernel.cpp",
     "aten/src/ATen/native/cpu/FunctionOfAMatrixUtilsKernel.cpp",
+    "aten/src/ATen/native/cpu/FusedOptimizerKernel.cpp",
     "aten/src/ATen/native/cpu/GridSamplerKernel.cpp",
     "aten/src/ATen/native/cpu/IndexKernel.cpp",
     "aten/src/ATen/native/cpu/LerpKernel.cpp",
     "aten/src/ATen/native/cpu/LinearAlgebraKernel.cpp",
+    "aten/src/ATen/native/cpu/LossCTCKernel.cpp",
     "aten/src/ATen/native/cpu/MaxPooling.cpp",
     "aten/src/ATen/native/cpu/MultinomialKernel.cpp",
     "aten/src/ATen/native/cpu/PointwiseOpsKernel.cpp",
     "aten/src/ATen/native/cpu/PowKernel.cpp",
+    "aten/src/ATen/native/cpu/RNNCellKernel.cpp",
     "aten/src/ATen/native/cpu/RangeFactoriesKernel.cpp",
     "aten/src/ATen/native/cpu/ReduceAllOpsKernel.cpp",
     "aten/src/ATen/native/cpu/ReduceOpsKernel.cpp",
@@ -928,6 +955,7 @@ aten_native_source_list = [
     "aten/src/ATen/native/cpu/UnaryOpsKernel.cpp",
     "aten/src/ATen/native/cpu/Unfold2d.cpp",
     "aten/src/ATen/native/cpu/UnfoldBackwardKernel.cpp",
+    "aten/src/ATen/native/cpu/UpSampleAAKernel.cpp",
     "aten/src/ATen/native/cpu/UpSampleKernel.cpp",
     "aten/src/ATen/native/cpu/UpSampleMoreKernel.cpp",
     "aten/src/ATen/native/cpu/batch_norm_kernel.cpp",
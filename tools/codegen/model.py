@@ -97,6 +97,7 @@ class DispatchKey(Enum):
     AutogradPrivateUse2 = auto()
     AutogradPrivateUse3 = auto()
     Tracer = auto()
+    AutocastCPU = auto()
     Autocast = auto()
     Batched = auto()
     VmapMode = auto()
@@ -623,7 +624,9 @@ class FunctionSchema:
                     '_foreach_addcdiv_.Scalar',
                     '_foreach_addcmul_.ScalarList',
                     '_foreach_addcdiv_.ScalarList',
-                    '_foreach_zero_']:
+                    '_foreach_zero_',
+                    '_fused_adam_',
+                    '_fused_sgd_']:
                 assert len(self.returns) == 1
 
     def is_out_fn(self) -> bool:
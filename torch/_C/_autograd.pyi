@@ -1,4 +1,4 @@
-from typing import List, Set
+from typing import Callable, List, Set, Tuple
 from enum import Enum
 
 # Defined in tools/autograd/init.cpp
@@ -26,7 +26,8 @@ class ProfilerConfig:
         report_input_shapes: bool,
         profile_memory: bool,
         with_stack: bool,
-        with_flops: bool
+        with_flops: bool,
+        sampling_prob: float = ...
     ) -> None: ...
     ...
 
@@ -35,6 +36,7 @@ class ProfilerEvent:
     def cpu_memory_usage(self) -> int: ...
     def cuda_elapsed_us(self, other: ProfilerEvent) -> float: ...
     def cuda_memory_usage(self) -> int: ...
+    def memory_addr(self) -> int: ...
     def device(self) -> int: ...
     def handle(self) -> int: ...
     def has_cuda(self) -> bool: ...
@@ -67,6 +69,18 @@ def _profiler_enabled() -> bool: ...
 def kineto_available() -> bool: ...
 def _enable_record_function(enable: bool) -> None: ...
 def _set_empty_test_observer(is_global: bool, sampling_prob: float) -> None: ...
+def _set_backward_cpu_threads(num_threads: int) -> None: ...
+def _get_backward_cpu_threads() -> int: ...
+def _set_fuse_accumulate_grad(enabled: bool) -> None: ...
+def _get_fuse_accumulate_grad() -> bool: ...
+def _set_backward_timing_enabled(enabled: bool) -> None: ...
+def _is_backward_timing_enabled() -> bool: ...
+def _backward_timing_summary() -> List[Tuple[str, int, int, int]]: ...
+def _backward_timing_events() -> List[Tuple[str, int, int]]: ...
+def _backward_timing_dropped() -> int: ...
+def _reset_backward_timing() -> None: ...
+def _push_saved_tensors_default_hooks(pack_hook: Callable, unpack_hook: Callable) -> None: ...
+def _pop_saved_tensors_default_hooks() -> None: ...
 
 def _enable_profiler_legacy(config: ProfilerConfig) -> None: ...
 def _disable_profiler_legacy() -> List[List[ProfilerEvent]]: ...
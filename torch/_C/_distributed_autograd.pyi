@@ -8,6 +8,7 @@ class DistAutogradContext:
     def _recv_functions(self) -> Dict[int, Any]: ...
     def _send_functions(self) -> Dict[int, Any]: ...
     def _known_worker_ids(self) -> Set[int]: ...
+    def _num_gradient_rpcs(self) -> int: ...
 
 def _new_context() -> DistAutogradContext: ...
 def _release_context(context_id: int) -> None: ...
@@ -11,9 +11,25 @@ _DEFAULT_NO_TIMEOUT: timedelta
 class BuiltinCommHookType(Enum):
     ALLREDUCE = ...
     FP16_COMPRESS = ...
+    POWER_SGD = ...
+    TOPK_COMPRESS = ...
+
+class BuiltinCommHookOptions:
+    matrix_approximation_rank: int
+    start_powerSGD_iter: int
+    min_compression_rate: float
+    use_error_feedback: bool
+    warm_start: bool
+    random_seed: int
+    compress_ratio: float
+    def __init__(self): ...
 
 def _register_comm_hook(reducer: Reducer, state: Any, comm_hook: Any): ...
-def _register_builtin_comm_hook(reducer: Reducer, comm_hook_type: BuiltinCommHookType): ...
+def _register_builtin_comm_hook(
+    reducer: Reducer,
+    comm_hook_type: BuiltinCommHookType,
+    options: BuiltinCommHookOptions = ...,
+): ...
 
 class GradBucket:
     def __init__(self, tensors: List[Tensor]): ...
@@ -138,6 +154,8 @@ class TCPStore(Store):
         is_master: bool,
         timeout: timedelta,
     ): ...
+    def multi_get(self, keys: List[str]) -> List[bytes]: ...
+    def multi_set(self, keys: List[str], values: List[str]): ...
 
 class PrefixStore(Store):
     def __init__(
@@ -96,6 +96,7 @@ class ProcessGroupAgent(RpcAgent):
 class _TensorPipeRpcBackendOptionsBase(RpcBackendOptions):
     num_worker_threads: int
     device_maps: Dict[str, Dict[int, int]]
+    _max_batch_size: int
     def __init__(
         self,
         num_worker_threads: int,
@@ -126,6 +127,8 @@ class TensorPipeAgent(RpcAgent):
     def get_worker_info(self, id: int) -> WorkerInfo: ...
     def get_worker_infos(self) -> List[WorkerInfo]: ...
     def _set_reverse_device_maps(self, reverseDeviceMaps: Dict[str, Dict[int, int]]): ...
+    def _get_metrics_snapshot(self) -> Dict[str, Dict[str, Any]]: ...
+    def _reset_metrics(self): ...
 
 def _is_current_rpc_agent_set() -> bool: ...
 def _get_current_rpc_agent()-> RpcAgent: ...
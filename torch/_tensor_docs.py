@@ -3929,6 +3929,13 @@ Example::
             [ 0,  0,  0]])
 """)
 
+add_docstr_all('to_padded_tensor',
+               r"""
+to_padded_tensor(padding=0) -> Tensor
+
+See :func:`torch.to_padded_tensor`
+""")
+
 add_docstr_all('to_sparse',
                r"""
 to_sparse(sparseDims) -> Tensor
@@ -4621,6 +4628,12 @@ add_docstr_all('is_sparse',
 Is ``True`` if the Tensor uses sparse storage layout, ``False`` otherwise.
 """)
 
+add_docstr_all('is_nested',
+               r"""
+Is ``True`` if the Tensor is a nested tensor, ``False`` otherwise.  See
+:mod:`torch.nested`.
+""")
+
 add_docstr_all('device',
                r"""
 Is the :class:`torch.device` where this Tensor is.
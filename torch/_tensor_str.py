@@ -275,6 +275,15 @@ def get_summarized_data(self):
     else:
         return torch.stack([get_summarized_data(x) for x in self])
 
+def _nested_str_intern(self):
+    # The components are printed like regular tensors, one per line
+    prefix = 'nested_tensor('
+    indent = len(prefix) + 1
+    components = [_str_intern(component).replace('\n', '\n' + ' ' * indent)
+                  for component in self.unbind()]
+    separator = ',\n' + ' ' * indent
+    return prefix + '[' + separator.join(components) + '])'
+
 def _str_intern(inp):
     prefix = 'tensor('
     indent = len(prefix)
@@ -380,4 +389,6 @@ def _str_intern(inp):
 
 def _str(self):
     with torch.no_grad():
+        if self.is_nested:
+            return _nested_str_intern(self)
         return _str_intern(self)
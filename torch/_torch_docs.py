@@ -8921,6 +8921,31 @@ Example::
     torch.return_types.topk(values=tensor([5., 4., 3.]), indices=tensor([4, 3, 2]))
 """.format(**common_args))
 
+add_docstr(torch.to_padded_tensor,
+           r"""
+to_padded_tensor(input, padding=0) -> Tensor
+
+Returns the padded form of the nested tensor :attr:`input`, a regular tensor of
+size ``input.size()`` where each component is followed by :attr:`padding` up to
+the length of the longest one. See :mod:`torch.nested`.
+
+Args:
+    {input} must be a nested tensor.
+    padding (float, optional): the value of the padding. Default: 0.
+
+Example::
+
+    >>> nt = torch.nested.nested_tensor([torch.ones(1, 2), torch.ones(3, 2)])
+    >>> torch.to_padded_tensor(nt)
+    tensor([[[1., 1.],
+             [0., 0.],
+             [0., 0.]],
+
+            [[1., 1.],
+             [1., 1.],
+             [1., 1.]]])
+""".format(**common_args))
+
 add_docstr(torch.trace,
            r"""
 trace(input) -> Tensor
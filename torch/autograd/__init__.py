@@ -15,11 +15,12 @@ from typing import Any, Callable, List, Optional, Sequence, Tuple, Union
 from .variable import Variable
 from .function import Function, NestedIOFunction
 from .gradcheck import gradcheck, gradgradcheck
-from .grad_mode import no_grad, enable_grad, set_grad_enabled
+from .grad_mode import no_grad, enable_grad, set_grad_enabled, inference_mode
 from .anomaly_mode import detect_anomaly, set_detect_anomaly
 from ..overrides import has_torch_function, handle_torch_function
 from . import functional
 from . import forward_ad
+from . import graph
 
 __all__ = ['Variable', 'Function', 'backward', 'grad_mode']
 
@@ -5,7 +5,7 @@ import inspect
 from typing import Any, Callable, TypeVar, cast
 
 
-__all__ = ['no_grad', 'enable_grad', 'set_grad_enabled']
+__all__ = ['no_grad', 'enable_grad', 'set_grad_enabled', 'inference_mode']
 
 
 # Used for annotating the decorator usage of 'no_grad' and 'enable_grad'.
@@ -206,3 +206,46 @@ class set_grad_enabled(object):
 
     def __exit__(self, exc_type: Any, exc_value: Any, traceback: Any) -> None:
         torch._C._set_grad_enabled(self.prev)
+
+
+class inference_mode(_DecoratorContextManager):
+    r"""Context-manager that enables or disables inference mode.
+
+    InferenceMode is like :class:`~no_grad`, but it also skips the work
+    autograd does for every op even when no gradient is computed, such as
+    tracking views and bumping version counters, which makes small ops
+    noticeably faster. Tensors created in this mode are inference tensors
+    (see :meth:`Tensor.is_inference`): outside of it they can be used as
+    inputs of other ops, but they can't be updated in-place, require grad or
+    be saved for backward. Make a clone to get a normal tensor.
+
+    This context manager is thread local; it will not affect computation
+    in other threads.
+
+    Also functions as a decorator. (Make sure to instantiate with parenthesis.)
+
+    Args:
+        mode (bool): Flag whether to enable or disable inference mode
+
+    Example::
+
+        >>> x = torch.ones(1, 2, 3, requires_grad=True)
+        >>> with torch.inference_mode():
+        ...   y = x * x
+        >>> y.requires_grad
+        False
+        >>> y.is_inference()
+        True
+        >>> y.add_(1)
+        RuntimeError: Inplace update to inference tensor outside InferenceMode is not allowed...
+    """
+    def __init__(self, mode=True):
+        if not torch._jit_internal.is_scripting():
+            super().__init__()
+        self.mode = mode
+
+    def __enter__(self):
+        self._inference_mode_raii_guard = torch._C._InferenceMode(self.mode)
+
+    def __exit__(self, exc_type: Any, exc_value: Any, traceback: Any) -> None:
+        del self._inference_mode_raii_guard
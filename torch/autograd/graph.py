@@ -0,0 +1,161 @@
+import torch
+
+from typing import Any, Callable, Tuple
+
+__all__ = ['saved_tensors_hooks', 'save_on_cpu', 'save_in_dtype']
+
+
+class saved_tensors_hooks(object):
+    r"""Context-manager that sets a pair of pack / unpack hooks for saved tensors.
+
+    Use this context-manager to define how the intermediary results of an
+    operation should be packed before saving, and unpacked on retrieval.
+
+    In that context, the ``pack_hook`` function will be called every time an
+    operation saves a tensor for backward (this includes intermediary results
+    saved using :func:`~torch.autograd.function._ContextMethodMixin.save_for_backward`
+    but also those recorded by a PyTorch-defined operation). The output of
+    ``pack_hook`` is then stored in the computation graph instead of the
+    original tensor.
+
+    The ``unpack_hook`` is called when the saved tensor needs to be accessed,
+    namely when executing :func:`torch.Tensor.backward()` or
+    :func:`torch.autograd.grad()`. It takes as argument the *packed* object
+    returned by ``pack_hook`` and should return a tensor which has the same
+    content as the original tensor (passed as input to the corresponding
+    ``pack_hook``).
+
+    The hooks should have the following signatures:
+
+        pack_hook(tensor: Tensor) -> Any
+
+        unpack_hook(Any) -> Tensor
+
+    where the return value of ``pack_hook`` is a valid input to ``unpack_hook``.
+
+    .. warning ::
+        Performing an inplace operation on the input to either hook may lead
+        to undefined behavior.
+
+    .. note ::
+        The hooks are only applied to tensors saved on the thread that entered
+        the context-manager. Nesting is allowed: the innermost pair is used.
+
+    Example::
+
+        >>> def pack_hook(x):
+        ...     print("Packing", x)
+        ...     return x
+        >>>
+        >>> def unpack_hook(x):
+        ...     print("Unpacking", x)
+        ...     return x
+        >>>
+        >>> a = torch.ones(5, requires_grad=True)
+        >>> b = torch.ones(5, requires_grad=True) * 2
+        >>> with torch.autograd.graph.saved_tensors_hooks(pack_hook, unpack_hook):
+        ...     y = a * b
+        Packing tensor([1., 1., 1., 1., 1.])
+        Packing tensor([2., 2., 2., 2., 2.])
+        >>> y.sum().backward()
+        Unpacking tensor([1., 1., 1., 1., 1.])
+        Unpacking tensor([2., 2., 2., 2., 2.])
+    """
+
+    def __init__(self, pack_hook: Callable[[torch.Tensor], Any], unpack_hook: Callable[[Any], torch.Tensor]) -> None:
+        self.pack_hook = pack_hook
+        self.unpack_hook = unpack_hook
+
+    def __enter__(self) -> None:
+        torch._C._autograd._push_saved_tensors_default_hooks(self.pack_hook, self.unpack_hook)
+
+    def __exit__(self, *args: Any) -> None:
+        torch._C._autograd._pop_saved_tensors_default_hooks()
+
+
+class save_on_cpu(saved_tensors_hooks):
+    r"""Context-manager under which tensors saved by the forward pass will be
+    stored on cpu, then copied back for backward.
+
+    This trades device memory for host to device copies: each saved tensor is
+    moved to the cpu when it is saved and moved back to its original device
+    when the backward pass needs it.
+
+    If ``pin_memory`` is ``True``, tensors are saved to pinned host memory so
+    that the copies in both directions are asynchronous with respect to the
+    host.
+
+    Args:
+        pin_memory (bool): If ``True`` saved tensors will be copied to pinned
+            memory during packing and copied to the device asynchronously
+            during unpacking. Defaults to ``False``.
+
+    Example::
+
+        >>> a = torch.randn(5, requires_grad=True, device="cuda")
+        >>> b = torch.randn(5, requires_grad=True, device="cuda")
+        >>>
+        >>> with torch.autograd.graph.save_on_cpu(pin_memory=True):
+        ...     y = (a * b).sin()  # a, b and a * b are saved on the cpu
+        >>> y.sum().backward()  # and copied back to the device here
+    """
+
+    def __init__(self, pin_memory: bool = False) -> None:
+        def pack_to_cpu(tensor: torch.Tensor) -> Tuple[torch.device, torch.Tensor]:
+            if tensor.device.type == 'cpu':
+                return (tensor.device, tensor)
+            if not pin_memory or tensor.is_sparse:
+                return (tensor.device, tensor.cpu())
+            packed = torch.empty(tensor.size(), dtype=tensor.dtype, layout=tensor.layout, pin_memory=True)
+            # The copy is ordered on the current stream, so the caching
+            # allocator won't hand out the source memory before it is done.
+            packed.copy_(tensor, non_blocking=True)
+            return (tensor.device, packed)
+
+        def unpack_from_cpu(packed: Tuple[torch.device, torch.Tensor]) -> torch.Tensor:
+            device, tensor = packed
+            return tensor.to(device, non_blocking=pin_memory)
+
+        super().__init__(pack_to_cpu, unpack_from_cpu)
+
+
+class save_in_dtype(saved_tensors_hooks):
+    r"""Context-manager under which floating point tensors saved by the
+    forward pass are stored in a lower precision ``dtype``, then cast back to
+    their original dtype for backward.
+
+    Only tensors whose dtype is a floating point type wider than ``dtype`` are
+    converted; every other saved tensor is kept as is.
+
+    .. warning ::
+        This is a lossy compression: the backward pass sees the rounded values,
+        so the computed gradients are only approximations of the exact ones.
+
+    Args:
+        dtype (torch.dtype): The dtype saved tensors are stored in. Either
+            ``torch.float16`` or ``torch.bfloat16``. Defaults to
+            ``torch.float16``.
+
+    Example::
+
+        >>> a = torch.randn(5, requires_grad=True)
+        >>> with torch.autograd.graph.save_in_dtype(torch.bfloat16):
+        ...     y = a.exp()  # the result of exp is saved as bfloat16
+        >>> y.sum().backward()
+    """
+
+    def __init__(self, dtype: torch.dtype = torch.float16) -> None:
+        if dtype not in (torch.float16, torch.bfloat16):
+            raise ValueError("save_in_dtype expects torch.float16 or torch.bfloat16, got {}".format(dtype))
+        bits = torch.finfo(dtype).bits
+
+        def pack_in_dtype(tensor: torch.Tensor) -> Tuple[torch.dtype, torch.Tensor]:
+            if tensor.is_floating_point() and torch.finfo(tensor.dtype).bits > bits:
+                return (tensor.dtype, tensor.to(dtype))
+            return (tensor.dtype, tensor)
+
+        def unpack_from_dtype(packed: Tuple[torch.dtype, torch.Tensor]) -> torch.Tensor:
+            original_dtype, tensor = packed
+            return tensor.to(original_dtype)
+
+        super().__init__(pack_in_dtype, unpack_from_dtype)
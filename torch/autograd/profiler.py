@@ -369,6 +369,7 @@ class profile(object):
             this option only works for the matrix multiplication and 2D convolution operators.
 
         profile_memory (bool, optional): track tensor memory allocation/deallocation.
+            See also ``memory_timeline()`` for the live memory over time and its breakdown at the peak.
 
         with_stack (bool, optional): record source information (file and line number) for the ops.
 
@@ -377,6 +378,10 @@ class profile(object):
         use_cpu (bool, optional): profile CPU events; setting to ``False`` requires
             ``use_kineto=True`` and can be used to lower the overhead for GPU-only profiling.
 
+        sampling_prob (float, optional): probability to record any given CPU op; ops that
+            are not sampled skip the profiler callbacks, which lowers the overhead and the
+            size of the trace of long runs. Values below 1 require ``use_kineto=True``.
+
     .. warning:
         Enabling memory profiling or source attribution incurs additional profiler
         overhead
@@ -420,7 +425,8 @@ class profile(object):
             profile_memory=False,
             with_stack=False,
             use_kineto=False,
-            use_cpu=True):
+            use_cpu=True,
+            sampling_prob=1.0):
         self.enabled: bool = enabled
         if not self.enabled:
             return
@@ -433,10 +439,16 @@ class profile(object):
         self.profile_memory = profile_memory
         self.with_stack = with_stack
         self.use_cpu = use_cpu
+        self.sampling_prob = sampling_prob
         self.kineto_results = None
+        self.memory_events = None
         if not self.use_cpu:
             assert use_kineto, \
                 "Device-only events supported only with Kineto (use_kineto=True)"
+        assert 0.0 <= sampling_prob <= 1.0, "Invalid sampling probability"
+        if sampling_prob < 1.0:
+            assert use_kineto, \
+                "Sampling of CPU ops is supported only with Kineto (use_kineto=True)"
 
         self.profiler_kind = None
         self.kineto_activities = set()
@@ -469,7 +481,8 @@ class profile(object):
             self.record_shapes,
             self.profile_memory,
             self.with_stack,
-            self.with_flops)
+            self.with_flops,
+            self.sampling_prob)
 
     def __enter__(self):
         if not self.enabled:
@@ -499,9 +512,13 @@ class profile(object):
         if self.kineto_activities:
             self.kineto_results = torch.autograd._disable_profiler()
             parsed_results = parse_kineto_results(self.kineto_results)
+            if self.profile_memory:
+                self.memory_events = parse_kineto_memory_records(self.kineto_results, parsed_results)
         else:
             records = torch.autograd._disable_profiler_legacy()
             parsed_results = parse_legacy_records(records)
+            if self.profile_memory:
+                self.memory_events = parse_legacy_memory_records(records)
         self.function_events = EventList(
             parsed_results,
             use_cuda=self.use_cuda,
@@ -569,6 +586,15 @@ class profile(object):
         assert self.function_events is not None
         return self.function_events.self_cpu_time_total
 
+    def memory_timeline(self):
+        """Returns a MemoryTimeline of the tensor allocations of the run, each attributed
+        to the profiled ranges (ops, ``record_function`` labels) that were open on
+        its thread, to find what owns the memory at the peak.
+        """
+        self._check_finish()
+        assert self.profile_memory, "memory_timeline() requires profile_memory=True"
+        return MemoryTimeline(self.memory_events)
+
 
 class record_function(ContextDecorator):
     """Context manager/function decorator that adds a label to a block of
@@ -769,6 +795,67 @@ def load_nvprof(path):
     return EventList(parse_nvprof_trace(path))
 
 
+################################################################################
+# Backward timing
+
+BackwardNodeStats = namedtuple('BackwardNodeStats', ['name', 'count', 'total_us', 'max_us'])
+BackwardNodeEvent = namedtuple('BackwardNodeEvent', ['name', 'sequence_nr', 'duration_us'])
+
+
+class backward_timing(object):
+    """Context manager that turns on the engine's lightweight backward timing.
+
+    Unlike :class:`profile`, this doesn't trace individual operators: the
+    engine only adds the wall time of every autograd node it runs to fixed
+    size per thread counters, which makes it cheap enough to leave on during
+    training. Timings accumulate across backward passes until
+    :meth:`reset` is called, and can be read at any time, also from other
+    threads, with :meth:`summary` and :meth:`events`.
+
+    Args:
+        enabled (bool, optional): Setting this to False makes this context
+            manager a no-op. Default: ``True``.
+
+    Example:
+        >>> x = torch.randn(10, requires_grad=True)
+        >>> with torch.autograd.profiler.backward_timing():
+        ...     for _ in range(10):
+        ...         (x * 2).exp().sum().backward()
+        >>> torch.autograd.profiler.backward_timing.summary()[0]
+        BackwardNodeStats(name='torch::autograd::generated::ExpBackward', count=10, ...)
+    """
+    def __init__(self, enabled=True):
+        self.enabled = enabled
+
+    def __enter__(self):
+        self.prev = torch._C._autograd._is_backward_timing_enabled()
+        torch._C._autograd._set_backward_timing_enabled(self.enabled)
+        return self
+
+    def __exit__(self, exc_type, exc_val, exc_tb):
+        torch._C._autograd._set_backward_timing_enabled(self.prev)
+        return False
+
+    @staticmethod
+    def summary() -> List[BackwardNodeStats]:
+        """Returns the time spent per autograd node type over all threads,
+        sorted by decreasing total time."""
+        return [BackwardNodeStats(name, count, total_ns / 1000.0, max_ns / 1000.0)
+                for name, count, total_ns, max_ns in torch._C._autograd._backward_timing_summary()]
+
+    @staticmethod
+    def events() -> List[BackwardNodeEvent]:
+        """Returns the most recent nodes run by each thread with their
+        sequence number, sorted by sequence number."""
+        return [BackwardNodeEvent(name, sequence_nr, duration_ns / 1000.0)
+                for name, sequence_nr, duration_ns in torch._C._autograd._backward_timing_events()]
+
+    @staticmethod
+    def reset() -> None:
+        """Clears all recorded timings."""
+        torch._C._autograd._reset_backward_timing()
+
+
 ################################################################################
 # FunctionEvent
 
@@ -1069,6 +1156,99 @@ class FunctionEventAvg(FormattedTimesMixin):
         )
 
 
+# A tensor memory allocation (nbytes > 0) or deallocation (nbytes < 0) and the
+# stack of profiled ranges (outermost first) that were open on its thread
+MemoryEvent = namedtuple('MemoryEvent', ['time_us', 'thread', 'addr', 'device', 'nbytes', 'stack'])
+
+
+class MemoryTimeline(object):
+    """Live tensor memory over the course of a profiling run, per device type
+    ("cpu" or "cuda", summed over all CUDA devices).
+
+    Only blocks allocated while profiling are accounted for; freeing a block
+    that was allocated before the profiler was enabled is ignored.
+    """
+    def __init__(self, memory_events):
+        self.memory_events = sorted(memory_events, key=lambda evt: evt.time_us)
+
+    def _replay(self, device):
+        # yields (event, live allocations by address, live bytes) after each event
+        live: Dict[int, MemoryEvent] = {}
+        live_bytes = 0
+        for evt in self.memory_events:
+            if evt.device != device:
+                continue
+            if evt.nbytes > 0:
+                live[evt.addr] = evt
+                live_bytes += evt.nbytes
+            else:
+                alloc = live.pop(evt.addr, None)
+                if alloc is None:
+                    continue
+                live_bytes -= alloc.nbytes
+            yield evt, live, live_bytes
+
+    def timeline(self, device="cpu"):
+        """Returns a list of (time in us, live bytes) after each allocation and deallocation."""
+        return [(evt.time_us, live_bytes) for evt, _, live_bytes in self._replay(device)]
+
+    def peak(self, device="cpu"):
+        """Returns (time in us, live bytes) at the highest memory usage."""
+        peak_time_us, peak_bytes = 0.0, 0
+        for evt, _, live_bytes in self._replay(device):
+            if live_bytes > peak_bytes:
+                peak_time_us, peak_bytes = evt.time_us, live_bytes
+        return peak_time_us, peak_bytes
+
+    def peak_breakdown(self, device="cpu", stack_depth=None):
+        """Returns the memory live at the peak as a list of (stack, bytes), largest first,
+        where stack is the tuple of profiled ranges that allocated it, outermost first.
+
+        Args:
+            stack_depth (int, optional): group allocations by the outermost ``stack_depth``
+                ranges only, e.g. 1 to attribute memory to top level modules wrapped in
+                ``record_function``.
+        """
+        peak_bytes = 0
+        peak_allocs: List[MemoryEvent] = []
+        for _, live, live_bytes in self._replay(device):
+            if live_bytes > peak_bytes:
+                peak_bytes = live_bytes
+                peak_allocs = list(live.values())
+        breakdown: Dict[Tuple[str, ...], int] = defaultdict(int)
+        for alloc in peak_allocs:
+            stack = alloc.stack if stack_depth is None else alloc.stack[:stack_depth]
+            breakdown[stack] += alloc.nbytes
+        return sorted(breakdown.items(), key=lambda item: item[1], reverse=True)
+
+    def table(self, device="cpu", stack_depth=None, row_limit=100):
+        """Prints the peak breakdown as a table."""
+        peak_time_us, peak_bytes = self.peak(device)
+        breakdown = self.peak_breakdown(device, stack_depth)
+        if row_limit >= 0:
+            breakdown = breakdown[:row_limit]
+        lines = ["Peak {} memory: {} at {}".format(
+            device.upper(), format_memory(peak_bytes), format_time(peak_time_us))]
+        for stack, nbytes in breakdown:
+            lines.append("{:>12}  {}".format(
+                format_memory(nbytes), " > ".join(stack) if stack else "[no profiled range]"))
+        return "\n".join(lines)
+
+    def export_chrome_trace(self, path):
+        """Exports live memory as counter tracks in Chrome JSON format."""
+        with open(path, "w") as f:
+            f.write("[")
+            next_entry = ""
+            for device in ["cpu", "cuda"]:
+                for time_us, live_bytes in self.timeline(device):
+                    f.write(next_entry)
+                    f.write('{"name": "Memory (%s)", "ph": "C", "ts": %s, "pid": 0, '
+                            '"args": {"bytes": %s}}' % (device.upper(), time_us, live_bytes))
+                    next_entry = ", "
+            f.write("]")
+
+
+
 ################################################################################
 # Utilities
 
@@ -1382,6 +1562,82 @@ def parse_legacy_records(thread_records):
     return functions
 
 
+def _memory_event(record, time_us, stack):
+    if record.cuda_memory_usage() != 0:
+        device, nbytes = "cuda", record.cuda_memory_usage()
+    else:
+        device, nbytes = "cpu", record.cpu_memory_usage()
+    return MemoryEvent(
+        time_us=time_us,
+        thread=record.thread_id(),
+        addr=record.memory_addr(),
+        device=device,
+        nbytes=nbytes,
+        stack=tuple(stack))
+
+
+def parse_kineto_memory_records(result, function_events):
+    """Attributes the memory allocation records of a Kineto profiler result to the
+    CPU ops (as returned by parse_kineto_results) enclosing them on their thread.
+    """
+    start_record = None
+    mem_records = []
+    for record in itertools.chain(*result.legacy_events()):
+        if record.kind() == 'mark' and record.name() == '__start_profile':
+            start_record = record
+        if record.kind() == 'memory_alloc':
+            mem_records.append(record)
+    assert start_record is not None, "Invalid profiler output, __start_profile is missing"
+
+    ops_per_thread: Dict[int, List[FunctionEvent]] = defaultdict(list)
+    for evt in function_events:
+        if evt.device_type == DeviceType.CPU and not evt.is_async and evt.trace_name is not None:
+            ops_per_thread[evt.thread].append(evt)
+
+    memory_events = []
+    for record in mem_records:
+        time_us = record.start_us() - start_record.start_us()
+        # function_events are sorted by start time, outermost first
+        stack = [
+            evt.name for evt in ops_per_thread[record.thread_id()]
+            if evt.time_range.start <= time_us <= evt.time_range.end]
+        memory_events.append(_memory_event(record, time_us, stack))
+    return memory_events
+
+
+def parse_legacy_memory_records(thread_records):
+    """Attributes the memory allocation records of the legacy profiler to the ranges
+    open on their thread when they were recorded.
+    """
+    start_record = None
+    for record in itertools.chain(*thread_records):
+        if record.name() == '__start_profile':
+            start_record = record
+            break
+    assert start_record is not None
+
+    memory_events = []
+    for thread_record_list in thread_records:
+        # open ranges in the order they were pushed
+        range_names: Dict[Tuple[int, int], str] = {}
+        for record in thread_record_list:
+            record_key = (record.handle(), record.node_id())
+            if record.kind() == 'push':
+                name = rewrite_name(name=record.name(), with_wildcard=True)
+                open_names = list(range_names.values())
+                # same workaround for the double logging of operator wrappers
+                # as in parse_legacy_records
+                duplicate = len(open_names) > 0 and open_names[-1] == name
+                if not filter_name(record.name()) and not duplicate:
+                    range_names[record_key] = name
+            elif record.kind() == 'pop':
+                range_names.pop(record_key, None)
+            elif record.kind() == 'memory_alloc':
+                memory_events.append(_memory_event(
+                    record, start_record.cpu_elapsed_us(record), range_names.values()))
+    return memory_events
+
+
 ################################################################################
 # CUDA checkpoints
 
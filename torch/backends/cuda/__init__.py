@@ -29,8 +29,8 @@ class cuFFTPlanCacheAttrContextProp(object):
 class cuFFTPlanCache(object):
     r"""
     Represents a specific plan cache for a specific `device_index`. The
-    attributes `size` and `max_size`, and method `clear`, can fetch and/ or
-    change properties of the C++ cuFFT plan cache.
+    attributes `size`, `max_size`, `hits` and `misses`, and method `clear`,
+    can fetch and/ or change properties of the C++ cuFFT plan cache.
     """
     def __init__(self, device_index):
         self.device_index = device_index
@@ -43,6 +43,16 @@ class cuFFTPlanCache(object):
     max_size = cuFFTPlanCacheAttrContextProp(torch._cufft_get_plan_cache_max_size,
                                              torch._cufft_set_plan_cache_max_size)
 
+    hits = cuFFTPlanCacheAttrContextProp(
+        torch._cufft_get_plan_cache_hits,
+        '.hits is a read-only property showing the number of transforms that found '
+        'their plan in the cache since it was last cleared.')
+
+    misses = cuFFTPlanCacheAttrContextProp(
+        torch._cufft_get_plan_cache_misses,
+        '.misses is a read-only property showing the number of transforms that had '
+        'to create their plan since the cache was last cleared.')
+
     def clear(self):
         return torch._cufft_clear_plan_cache(self.device_index)
 
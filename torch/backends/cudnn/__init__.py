@@ -1,3 +1,4 @@
+import os
 import sys
 import torch
 import warnings
@@ -84,6 +85,36 @@ def is_acceptable(tensor):
     return True
 
 
+def _check_benchmark_cache_available():
+    if not _init() or not hasattr(_cudnn, '_save_benchmark_cache'):
+        raise RuntimeError('The cuDNN benchmark cache requires PyTorch built with cuDNN')
+
+
+def save_benchmark_cache(path):
+    r"""Saves the convolution algorithms picked by cuDNN so far to the file
+    at :attr:`path`, so that other processes on the same GPU model and cuDNN
+    version can skip the search of :attr:`torch.backends.cudnn.benchmark` by
+    loading it with :func:`load_benchmark_cache`. Run a representative
+    workload with ``benchmark = True`` before saving.
+    """
+    _check_benchmark_cache_available()
+    _cudnn._save_benchmark_cache(os.fspath(path))
+
+
+def load_benchmark_cache(path):
+    r"""Loads convolution algorithms saved by :func:`save_benchmark_cache`.
+    Algorithms already picked by this process are kept. Files saved on a
+    different GPU model or cuDNN version are ignored with a warning.
+
+    The file named by the ``TORCH_CUDNN_BENCHMARK_CACHE`` environment variable
+    is loaded automatically before the first convolution.
+
+    Returns the number of loaded algorithms.
+    """
+    _check_benchmark_cache_available()
+    return _cudnn._load_benchmark_cache(os.fspath(path))
+
+
 def set_flags(_enabled=None, _benchmark=None, _deterministic=None, _allow_tf32=None):
     orig_flags = (torch._C._get_cudnn_enabled(),
                   torch._C._get_cudnn_benchmark(),
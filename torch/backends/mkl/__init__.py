@@ -4,3 +4,43 @@ import torch
 def is_available():
     r"""Returns whether PyTorch is built with MKL support."""
     return torch._C.has_mkl
+
+
+class MklFFTPlanCache(object):
+    r"""
+    Represents the plan cache of the MKL FFT, shared by all CPU transforms.
+    The attributes `size`, `max_size`, `hits` and `misses`, and method
+    `clear`, can fetch and/ or change properties of the C++ MKL FFT plan
+    cache, like :attr:`torch.backends.cuda.cufft_plan_cache` does for cuFFT.
+    """
+    @property
+    def size(self):
+        r"""The number of plans currently in the cache (read-only)."""
+        return torch._mkl_fft_get_plan_cache_size()
+
+    @property
+    def max_size(self):
+        r"""The capacity of the cache. Setting it to 0 disables caching."""
+        return torch._mkl_fft_get_plan_cache_max_size()
+
+    @max_size.setter
+    def max_size(self, value):
+        torch._mkl_fft_set_plan_cache_max_size(value)
+
+    @property
+    def hits(self):
+        r"""The number of transforms that found their plan in the cache since
+        it was last cleared (read-only)."""
+        return torch._mkl_fft_get_plan_cache_hits()
+
+    @property
+    def misses(self):
+        r"""The number of transforms that had to create their plan since the
+        cache was last cleared (read-only)."""
+        return torch._mkl_fft_get_plan_cache_misses()
+
+    def clear(self):
+        return torch._mkl_fft_clear_plan_cache()
+
+
+fft_plan_cache = MklFFTPlanCache()
@@ -0,0 +1,5 @@
+r"""
+This package contains the CPU counterparts of the device specific
+:mod:`torch.cuda` utilities, currently :mod:`torch.cpu.amp`.
+"""
+from . import amp  # noqa: F401
@@ -0,0 +1,68 @@
+import torch
+import functools
+
+
+class autocast(object):
+    r"""
+    Instances of :class:`autocast` serve as context managers or decorators that
+    allow regions of your script to run in mixed precision on CPU.
+
+    In these regions, CPU ops run in an op-specific dtype chosen by autocast:
+    convolutions and matrix multiplications (``conv*``, ``linear``, ``matmul``,
+    ``mm``, ``bmm`` and friends) run in ``dtype``, which is ``torch.bfloat16``,
+    while norms, losses and reductions run in ``float32``.  Casts of ``float32``
+    model weights to ``dtype`` are cached for the duration of the region, as for
+    :class:`torch.cuda.amp.autocast`.
+
+    Example::
+
+        # Creates model and optimizer in default precision
+        model = Net()
+        optimizer = optim.SGD(model.parameters(), ...)
+
+        for input, target in data:
+            optimizer.zero_grad()
+
+            # Enables CPU autocasting for the forward pass (model + loss)
+            with torch.cpu.amp.autocast():
+                output = model(input)
+                loss = loss_fn(output, target)
+
+            loss.backward()
+            optimizer.step()
+
+    Convolutions use the oneDNN (mkldnn) ``bfloat16`` kernels on CPUs that support
+    avx512bw, avx512vl and avx512dq.
+
+    The autocast state is thread-local and independent of the CUDA autocast state.
+
+    Args:
+        enabled(bool, optional, default=True):  Whether autocasting should be enabled in the region.
+        dtype(torch.dtype, optional, default=torch.bfloat16):  The lower precision type.
+            Only ``torch.bfloat16`` is currently supported.
+    """
+    def __init__(self, enabled=True, dtype=torch.bfloat16):
+        self._enabled = enabled
+        self._dtype = dtype
+
+    def __enter__(self):
+        self.prev = torch.is_autocast_cpu_enabled()
+        self.prev_dtype = torch.get_autocast_cpu_dtype()
+        torch.set_autocast_cpu_dtype(self._dtype)
+        torch.set_autocast_cpu_enabled(self._enabled)
+        torch.autocast_increment_nesting()
+
+    def __exit__(self, *args):
+        # Drop the cache when we exit to a nesting level that's outside any instance of autocast.
+        if torch.autocast_decrement_nesting() == 0:
+            torch.clear_autocast_cache()
+        torch.set_autocast_cpu_enabled(self.prev)
+        torch.set_autocast_cpu_dtype(self.prev_dtype)
+        return False
+
+    def __call__(self, func):
+        @functools.wraps(func)
+        def decorate_autocast(*args, **kwargs):
+            with self:
+                return func(*args, **kwargs)
+        return decorate_autocast
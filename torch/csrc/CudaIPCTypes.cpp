@@ -3,6 +3,8 @@
 #include <map>
 #include <mutex>
 #include <random>
+#include <unordered_map>
+#include <vector>
 
 #ifdef _MSC_VER
 #include <c10/util/win32-headers.h>
@@ -26,7 +28,16 @@ void warnProducerTerminatedBeforeSharedTensorsReleased() {
 
 struct CudaIPCGlobalEntities {
   std::mutex ref_counters_mutex_;
+  // Number of interprocess events created, including the ones in
+  // free_events_.
   std::atomic<int64_t> sync_events_used_;
+  // Interprocess events no longer used by any sent block, per device. Creating
+  // a new event for each sent tensor is costly, so they are recorded again for
+  // the next tensors rather than destroyed. The consumer only waits on an
+  // event when it receives the tensor, and a block is only released after all
+  // its consumers are done with it, so re-recording can't delay them.
+  std::mutex free_events_mutex_;
+  std::unordered_map<c10::DeviceIndex, std::vector<cudaEvent_t>> free_events_;
   std::map<std::string, std::shared_ptr<CudaIPCRefCountersFile>>
       ref_counters_files_;
   std::shared_ptr<CudaIPCRefCountersFile> next_available_ref_counters_file_;
@@ -140,16 +151,32 @@ CudaIPCSentData::CudaIPCSentData(
   //  [i.record() for i in a]
   //  ```
   //
-  if (cuda_ipc_global_entities.sync_events_used_.load() < CUDA_IPC_MAXIMUM_EVENTS_TO_USE) {
-    // TODO: More efficient would be to create event inside of main thread (at
-    // the moment of the queue.put). The reason this is more efficient is
-    // because the main thread may have queued extra work on the stream, which
-    // this event will consequently wait for (uselessly).
+  bool have_event = false;
+  {
+    std::lock_guard<std::mutex> lock(
+        cuda_ipc_global_entities.free_events_mutex_);
+    auto& free_events = cuda_ipc_global_entities.free_events_[device.index()];
+    if (!free_events.empty()) {
+      event_ = free_events.back();
+      free_events.pop_back();
+      have_event = true;
+    }
+  }
+  if (!have_event &&
+      cuda_ipc_global_entities.sync_events_used_.load() <
+          CUDA_IPC_MAXIMUM_EVENTS_TO_USE) {
     cuda_ipc_global_entities.sync_events_used_ ++;
     C10_CUDA_CHECK(cudaEventCreateWithFlags(
         &event_,
         cudaEventDisableTiming | cudaEventInterprocess |
             cudaEventBlockingSync));
+    have_event = true;
+  }
+  if (have_event) {
+    // TODO: More efficient would be to create event inside of main thread (at
+    // the moment of the queue.put). The reason this is more efficient is
+    // because the main thread may have queued extra work on the stream, which
+    // this event will consequently wait for (uselessly).
     C10_CUDA_CHECK(cudaEventRecord(
         event_, c10::cuda::getCurrentCUDAStream(device.index())));
     event_sync_required_ = true;
@@ -172,9 +199,10 @@ CudaIPCSentData::~CudaIPCSentData() {
 #ifndef __HIP_PLATFORM_HCC__
   try {
     if (event_sync_required_) {
-      at::cuda::CUDAGuard device_guard(device_.index());
-      cudaEventDestroy(event_);
-      cuda_ipc_global_entities.sync_events_used_ --;
+      // Keep the event for the next sent tensor on this device
+      std::lock_guard<std::mutex> lock(
+          cuda_ipc_global_entities.free_events_mutex_);
+      cuda_ipc_global_entities.free_events_[device_.index()].push_back(event_);
     }
   } catch (...) { /* No throw */
   }
@@ -227,6 +255,45 @@ at::DataPtr GetNewRefCountedSentData(void* data, at::Device device) {
   return at::DataPtr(data, sent_data, CudaIPCSentDataDelete, device);
 }
 
+std::shared_ptr<int64_t> GetReceivedRefCounters(const std::string& handle) {
+  static std::mutex mutex;
+  static std::unordered_map<std::string, std::weak_ptr<int64_t>> files;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = files.find(handle);
+  if (it != files.end()) {
+    if (auto counters = it->second.lock()) {
+      return counters;
+    }
+  }
+
+  int flags = TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_NOCREATE;
+  at::DataPtr data_ptr;
+  try {
+    data_ptr = THRefcountedMapAllocator::makeDataPtr(
+        handle.c_str(),
+        flags,
+        sizeof(int64_t) * CUDA_IPC_REF_COUNTER_FILE_SIZE,
+        nullptr);
+  } catch (c10::Error& err) {
+    // Already warned inside of producer process
+    return nullptr;
+  }
+  auto counters_ptr = static_cast<int64_t*>(data_ptr.get());
+  std::shared_ptr<int64_t> counters(
+      std::make_shared<at::DataPtr>(std::move(data_ptr)), counters_ptr);
+
+  // Files are never mapped again once unmapped, forget about them
+  for (auto file = files.begin(); file != files.end();) {
+    if (file->second.expired()) {
+      file = files.erase(file);
+    } else {
+      ++file;
+    }
+  }
+  files[handle] = counters;
+  return counters;
+}
+
 bool CudaIPCCollect() {
   bool freed_memory = cuda_ipc_global_entities.CudaIPCSentDataLimbo_.collect();
   if (cuda_ipc_global_entities.CudaIPCSentDataLimbo_.size() == 0) {
@@ -49,6 +49,13 @@ struct CudaIPCSentData final {
 
 TORCH_CUDA_CU_API at::DataPtr GetNewRefCountedSentData(void* data, at::Device device);
 
+// Maps the reference counters file with the given handle in the consumer. The
+// mapping is shared by all the storages received with a counter in this file
+// and unmapped with the last of them. Returns nullptr if the file doesn't exist
+// anymore, e.g. because the producer has been terminated.
+TORCH_CUDA_CU_API std::shared_ptr<int64_t> GetReceivedRefCounters(
+    const std::string& handle);
+
 namespace {
 
 constexpr int64_t CUDA_IPC_REF_COUNTER_FILE_SIZE = 10000;
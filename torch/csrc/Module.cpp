@@ -205,6 +205,20 @@ static PyObject * THPModule_setNumInteropThreads(PyObject *module, PyObject *arg
   Py_RETURN_NONE;
 }
 
+static PyObject * THPModule_getNumaAwareParallelism(PyObject *module, PyObject *noargs)
+{
+  if (at::get_numa_aware_parallelism()) Py_RETURN_TRUE;
+  else Py_RETURN_FALSE;
+}
+
+static PyObject * THPModule_setNumaAwareParallelism(PyObject *module, PyObject *arg)
+{
+  THPUtils_assert(PyBool_Check(arg), "set_numa_aware_parallelism expects a bool, "
+          "but got %s", THPUtils_typename(arg));
+  at::set_numa_aware_parallelism(arg == Py_True);
+  Py_RETURN_NONE;
+}
+
 PyObject * THPModule_setDefaultTensorType(PyObject *_unused, PyObject *type)
 {
   HANDLE_TH_ERRORS
@@ -666,6 +680,8 @@ static PyMethodDef TorchMethods[] = {
   {"set_num_threads", THPModule_setNumThreads,     METH_O,       nullptr},
   {"get_num_interop_threads", THPModule_getNumInteropThreads,     METH_NOARGS,  nullptr},
   {"set_num_interop_threads", THPModule_setNumInteropThreads,     METH_O,       nullptr},
+  {"_get_numa_aware_parallelism", THPModule_getNumaAwareParallelism, METH_NOARGS, nullptr},
+  {"_set_numa_aware_parallelism", THPModule_setNumaAwareParallelism, METH_O,      nullptr},
   {"_get_cudnn_enabled", THPModule_userEnabledCuDNN, METH_NOARGS,     nullptr},
   {"_set_cudnn_enabled", THPModule_setUserEnabledCuDNN, METH_O,  nullptr},
   {"_get_mkldnn_enabled", THPModule_userEnabledMkldnn, METH_NOARGS,     nullptr},
@@ -829,6 +845,7 @@ PyObject* initModule() {
   torch::jit::initJITBindings(module);
   torch::impl::dispatch::initDispatchBindings(module);
   torch::throughput_benchmark::initThroughputBenchmarkBindings(module);
+  torch::vitals::initVitalsBindings(module);
   torch::autograd::initNNFunctions(module);
   torch::autograd::initFFTFunctions(module);
   torch::autograd::initLinalgFunctions(module);
@@ -2,6 +2,7 @@
 
 #include <torch/data/dataloader_options.h>
 #include <torch/data/detail/data_shuttle.h>
+#include <torch/data/detail/device_transfer.h>
 #include <torch/data/detail/sequencers.h>
 #include <torch/data/iterator.h>
 #include <torch/data/samplers/random.h>
@@ -14,6 +15,7 @@
 #include <c10/util/Exception.h>
 
 #include <cstddef>
+#include <deque>
 #include <exception>
 #include <memory>
 #include <thread>
@@ -37,7 +39,11 @@ class DataLoaderBase {
       std::unique_ptr<Dataset> main_thread_dataset = nullptr)
       : options_(std::move(options)),
         main_thread_dataset_(std::move(main_thread_dataset)),
-        sequencer_(new_sequencer()) {}
+        sequencer_(new_sequencer()) {
+    if (options_.device && !options_.device->is_cpu()) {
+      transfer_ = torch::make_unique<detail::DeviceTransfer>(*options_.device);
+    }
+  }
 
   virtual ~DataLoaderBase() {
     join();
@@ -136,6 +142,7 @@ class DataLoaderBase {
   /// Resets the internal state of the DataLoader, optionally pre-fetching
   /// new jobs.
   virtual void reset() {
+    pending_transfers_.clear();
     shuttle_.drain();
     sequence_number_ = 0;
     sequencer_ = new_sequencer();
@@ -163,6 +170,29 @@ class DataLoaderBase {
   /// is exhausted. This operation will block until a batch is available if one
   /// is still expected.
   optional<BatchType> next() {
+    if (!transfer_) {
+      return next_host_batch();
+    }
+    // Keep the copies of `prefetch_factor` batches in flight behind the one
+    // that is returned.
+    while (pending_transfers_.size() <= options_.prefetch_factor) {
+      optional<BatchType> batch = next_host_batch();
+      if (!batch) {
+        break;
+      }
+      pending_transfers_.push_back(transfer_->start(std::move(*batch)));
+    }
+    if (pending_transfers_.empty()) {
+      return nullopt;
+    }
+    auto pending = std::move(pending_transfers_.front());
+    pending_transfers_.pop_front();
+    return transfer_->finish(std::move(pending));
+  }
+
+  /// Returns the next batch of data in host memory, or an empty `optional` if
+  /// the DataLoader is exhausted.
+  optional<BatchType> next_host_batch() {
     if (options_.workers > 0) {
       while (optional<Result> result = this->pop_result()) {
         if (result->exception) {
@@ -173,11 +203,24 @@ class DataLoaderBase {
         }
       }
     } else if (auto batch_request = get_batch_request()) {
-      return this->main_thread_dataset_->get_batch(std::move(*batch_request));
+      return pin(optional<BatchType>(this->main_thread_dataset_->get_batch(
+          std::move(*batch_request))));
     }
     return nullopt;
   }
 
+  /// Copies the tensors of `batch` into pinned memory if the `pin_memory`
+  /// option is set.
+  template <typename T>
+  T pin(T batch) const {
+    if (!options_.pin_memory) {
+      return batch;
+    }
+    return detail::map_tensors(std::move(batch), [](const Tensor& tensor) {
+      return tensor.is_pinned() ? tensor : tensor.pin_memory();
+    });
+  }
+
   /// The function that worker threads run.
   void worker_thread(Dataset& dataset) {
     while (true) {
@@ -186,7 +229,7 @@ class DataLoaderBase {
         break;
       }
       try {
-        auto batch = dataset.get_batch(std::move(*job.batch_request));
+        auto batch = pin(dataset.get_batch(std::move(*job.batch_request)));
         shuttle_.push_result({std::move(batch), job.sequence_number});
       } catch (...) {
         shuttle_.push_result({std::current_exception(), job.sequence_number});
@@ -241,6 +284,12 @@ class DataLoaderBase {
 
   /// True if the DataLoader has joined its worker threads.
   bool joined_ = false;
+
+  /// Copies batches to `options_.device`, if it is set to a non-CPU device.
+  std::unique_ptr<detail::DeviceTransfer> transfer_;
+
+  /// Batches whose copy to the device has been issued, in order.
+  std::deque<detail::DeviceTransfer::Pending<BatchType>> pending_transfers_;
 };
 } // namespace data
 } // namespace torch
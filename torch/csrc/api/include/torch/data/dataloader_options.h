@@ -37,6 +37,23 @@ struct DataLoaderOptions {
   /// Whether to omit the last batch if it contains less than `batch_size`
   /// examples.
   TORCH_ARG(bool, drop_last) = false;
+
+  /// Whether to copy the tensors of each batch into pinned (page-locked) host
+  /// memory as soon as it is loaded, on the worker threads if there are any.
+  /// Copies from pinned memory to a device can be asynchronous. The pinned
+  /// buffers come from the CUDA caching host allocator, which recycles them
+  /// once the copies reading them have completed.
+  TORCH_ARG(bool, pin_memory) = false;
+
+  /// If set, batches are copied to this device on a dedicated stream, and
+  /// returned once the current stream of the device has been made to wait
+  /// for their copy. Combine with `pin_memory` to overlap the copies with
+  /// computation.
+  TORCH_ARG(optional<Device>, device);
+
+  /// The number of batches whose copy to `device` is issued ahead of the
+  /// batch being returned.
+  TORCH_ARG(size_t, prefetch_factor) = 2;
 };
 
 /// Like `DataLoaderOptions`, but without any unconfigured state.
@@ -52,7 +69,10 @@ struct FullDataLoaderOptions {
         max_jobs(options.max_jobs().value_or(2 * workers)),
         timeout(options.timeout()),
         enforce_ordering(options.enforce_ordering()),
-        drop_last(options.drop_last()) {}
+        drop_last(options.drop_last()),
+        pin_memory(options.pin_memory()),
+        device(options.device()),
+        prefetch_factor(options.prefetch_factor()) {}
 
   size_t batch_size;
   size_t workers;
@@ -60,6 +80,9 @@ struct FullDataLoaderOptions {
   optional<std::chrono::milliseconds> timeout;
   bool enforce_ordering;
   bool drop_last;
+  bool pin_memory;
+  optional<Device> device;
+  size_t prefetch_factor;
 };
 } // namespace data
 } // namespace torch
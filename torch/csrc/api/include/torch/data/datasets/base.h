@@ -30,6 +30,16 @@ template <typename T>
 struct is_optional : std::false_type {};
 template <typename T>
 struct is_optional<optional<T>> : std::true_type {};
+
+/// Returns the given indices as a `kLong` tensor, e.g. for `index_select`.
+inline Tensor make_index_tensor(ArrayRef<size_t> indices) {
+  auto index = torch::empty({static_cast<int64_t>(indices.size())}, kLong);
+  auto* data = index.data_ptr<int64_t>();
+  for (size_t i = 0; i < indices.size(); ++i) {
+    data[i] = static_cast<int64_t>(indices[i]);
+  }
+  return index;
+}
 } // namespace detail
 
 /// A dataset that can yield data only in batches.
@@ -91,6 +101,17 @@ class Dataset : public BatchDataset<Self, std::vector<SingleExample>> {
     }
     return batch;
   }
+
+  /// Writes the examples at `indices` into consecutive rows of `out`, whose
+  /// tensors the caller has preallocated with the batch as first dimension,
+  /// and returns true. Collations like `Stack` use this to avoid allocating
+  /// and copying every example. The default implementation returns false,
+  /// leaving `out` untouched, to make them fall back to `get_batch()`.
+  virtual bool get_batch_into(
+      ExampleType& /*out*/,
+      ArrayRef<size_t> /*indices*/) {
+    return false;
+  }
 };
 
 /// A `StreamDataset` represents a dataset that is a potentially infinite stream.
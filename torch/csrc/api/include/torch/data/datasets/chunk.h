@@ -6,6 +6,7 @@
 #include <torch/data/samplers.h>
 #include <queue>
 #include <thread>
+#include <vector>
 
 #include <torch/serialize.h>
 
@@ -43,6 +44,11 @@ namespace detail {
 /// queue. When get_batch is called from data loader, it pops cached batches and
 /// return. If the cache is empty, it either waits to load more chunks or return
 /// null if all chunks are loaded.
+///
+/// Preloader threads assemble the batches of a chunk without holding the queue
+/// lock, which they only take to push finished batches. Examples left over
+/// from a chunk are kept in a partial batch that the next chunk completes, and
+/// that is queued once loading stops.
 template <
     typename UnwrappedBatch,
     typename ExampleSampler = samplers::RandomSampler>
@@ -65,11 +71,9 @@ class BatchDataBuffer {
   BatchType get_batch() {
     std::unique_lock<std::mutex> lock(queue_mutex_);
     cv_read_.wait(lock, [this] {
-      // wait till there is available data in the queue or if all chunks are
-      // loaded (i.e. the dataset is exhausted for this epoch)
-      return (
-          this->total_example_count_in_queue_ >= batch_size_ ||
-          this->stop_);
+      // wait till there is a batch in the queue or if all chunks are loaded
+      // (i.e. the dataset is exhausted for this epoch)
+      return !this->batch_queue_.empty() || this->stop_;
     });
     if (batch_queue_.empty()) {
       AT_ASSERT(stop_);
@@ -79,101 +83,100 @@ class BatchDataBuffer {
 
     UnwrappedBatchData batch = std::move(batch_queue_.front());
     batch_queue_.pop();
-    if (batch.exception) {
-      throw WorkerException(batch.exception);
-    }
-
     total_example_count_in_queue_ -= batch.batch_data.size();
     lock.unlock();
     cv_write_.notify_all();
 
-    return batch.batch_data;
+    if (batch.exception) {
+      throw WorkerException(batch.exception);
+    }
+    return std::move(batch.batch_data);
   }
 
   /// Push preloaded chunks to batch queue. Called from the ChunkDataset worker
   /// threads.
   void add_chunk_data(UnwrappedBatchType data) {
-    std::unique_lock<std::mutex> lock(queue_mutex_);
-    cv_write_.wait(lock, [this] {
-      // stop loading if we have preloaded enough data.
-      return this->total_example_count_in_queue_ < this->queue_capacity_ ||
-          this->stop_;
-    });
-    if (stop_) {
+    if (!wait_for_capacity()) {
       // When stop_ is true, it means no further chunk loading is necessary.
       // Return without any further processing.
       return;
     }
 
-    auto data_size = data.size();
-    auto remaining_size = data_size;
-    example_sampler_.reset(data_size);
+    const auto data_size = data.size();
 
-    auto fill_batch = [&](size_t example_count, UnwrappedBatchType& batch) {
-      auto batch_example_indices = this->example_sampler_.next(example_count);
+    // Sampling the example order and taking over the partial batch left by
+    // the previous chunk are the only steps serialized among preloaders.
+    BatchRequestType indices;
+    UnwrappedBatchType batch;
+    {
+      std::lock_guard<std::mutex> lock(partial_batch_mutex_);
+      example_sampler_.reset(data_size);
+      auto sampled_indices = example_sampler_.next(data_size);
       AT_ASSERT(
-          batch_example_indices &&
-          batch_example_indices.value().size() == example_count);
-      BatchRequestType& indices = batch_example_indices.value();
-      for (size_t i : indices) {
-        TORCH_CHECK(i < data_size, "Index out of range");
-        batch.emplace_back(std::move(data[i]));
-      }
-      remaining_size -= example_count;
-    };
-
-    if (!batch_queue_.empty()) {
-      // if the queue has existing data, and the last batch doesn't have enough
-      // examples to fill a batch_size batch, add more example to this batch first.
-      auto& batch = batch_queue_.back();
-      size_t current_count = batch.batch_data.size();
-      if (current_count < batch_size_) {
-        auto example_count =
-            std::min(remaining_size, batch_size_ - current_count);
-        fill_batch(example_count, batch.batch_data);
-      }
+          sampled_indices && sampled_indices.value().size() == data_size);
+      indices = std::move(sampled_indices.value());
+      batch = std::move(partial_batch_);
+      partial_batch_ = UnwrappedBatchType();
     }
 
-    // If we still have data remaining after filling the last pushed batch, add
-    // them to the queue too.
-    while (remaining_size > 0) {
-      UnwrappedBatchType current_batch;
-
-      // Allocate the batch memory ahead of time.
-      current_batch.reserve(batch_size_);
+    std::vector<UnwrappedBatchType> batches;
+    batches.reserve(data_size / batch_size_ + 1);
+    // Allocate the batch memory ahead of time.
+    batch.reserve(batch_size_);
+    for (size_t i : indices) {
+      TORCH_CHECK(i < data_size, "Index out of range");
+      batch.emplace_back(std::move(data[i]));
+      if (batch.size() == batch_size_) {
+        batches.push_back(std::move(batch));
+        batch = UnwrappedBatchType();
+        batch.reserve(batch_size_);
+      }
+    }
 
-      auto example_count = std::min(remaining_size, batch_size_);
-      fill_batch(example_count, current_batch);
-      batch_queue_.emplace(std::move(current_batch));
+    if (!batch.empty()) {
+      // Another preloader may have left a partial batch meanwhile; complete
+      // it with the leftover examples.
+      std::lock_guard<std::mutex> lock(partial_batch_mutex_);
+      for (auto& example : batch) {
+        partial_batch_.emplace_back(std::move(example));
+        if (partial_batch_.size() == batch_size_) {
+          batches.push_back(std::move(partial_batch_));
+          partial_batch_ = UnwrappedBatchType();
+        }
+      }
     }
-    total_example_count_in_queue_ += data_size;
-    lock.unlock();
-    cv_read_.notify_all();
+
+    push_batches(std::move(batches));
   }
 
   /// Push exceptions thrown during preloading into batch queue. Called from
   /// the ChunkDataset worker threads.
   void add_chunk_data(std::exception_ptr e_ptr) {
-    std::unique_lock<std::mutex> lock(queue_mutex_);
-    cv_write_.wait(lock, [this] {
-      // stop loading if we have preloaded enough data.
-      return (
-        this->total_example_count_in_queue_ < this->queue_capacity_ ||
-        this->stop_);
-    });
-    if (stop_){
+    if (!wait_for_capacity()) {
       // When stop_ is true, it means this current thread needs to be tore down,
       // the batch buffer will be discarded, so no need to enqueue any new
       // exceptions.
       return;
     }
-
-    batch_queue_.emplace(e_ptr);
-    lock.unlock();
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      if (stop_) {
+        return;
+      }
+      batch_queue_.emplace(e_ptr);
+    }
     cv_read_.notify_all();
   }
 
   void stop(){
+    // Queue the examples left over from the last chunk, so that the reader
+    // gets them before the end of the epoch.
+    UnwrappedBatchType partial_batch;
+    {
+      std::lock_guard<std::mutex> lock(partial_batch_mutex_);
+      partial_batch = std::move(partial_batch_);
+      partial_batch_ = UnwrappedBatchType();
+    }
     {
       // Hold the lock before changing stop_ to prevent a race condition which can
       // cause a deadlock.
@@ -187,6 +190,10 @@ class BatchDataBuffer {
       // By taking a lock before changing predicate stop_, it is ensured updating
       // and evaluating stop_ always happen in a synchronized way
       std::lock_guard<std::mutex> lock(queue_mutex_);
+      if (!stop_ && !partial_batch.empty()) {
+        total_example_count_in_queue_ += partial_batch.size();
+        batch_queue_.emplace(std::move(partial_batch));
+      }
       stop_ = true;
     }
 
@@ -195,6 +202,37 @@ class BatchDataBuffer {
     // notify all readers too.
     cv_read_.notify_all();
   }
+
+  /// Blocks until the queue has room for more examples. Returns false if the
+  /// buffer was stopped meanwhile.
+  bool wait_for_capacity() {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    cv_write_.wait(lock, [this] {
+      // stop loading if we have preloaded enough data.
+      return this->total_example_count_in_queue_ < this->queue_capacity_ ||
+          this->stop_;
+    });
+    return !stop_;
+  }
+
+  /// Appends finished batches to the queue in a single critical section.
+  void push_batches(std::vector<UnwrappedBatchType> batches) {
+    if (batches.empty()) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      if (stop_) {
+        return;
+      }
+      for (auto& batch : batches) {
+        total_example_count_in_queue_ += batch.size();
+        batch_queue_.emplace(std::move(batch));
+      }
+    }
+    cv_read_.notify_all();
+  }
+
   /// The batch size is needed to create batches from the chunk data. Similar to
   /// regular dataloader where the batches are created with prefetches,
   /// BatchDataBuffer perform the batch creation using the provided batch size.
@@ -230,6 +268,13 @@ class BatchDataBuffer {
 
   ExampleSampler& example_sampler_;
 
+  // examples left over from the chunks loaded so far, fewer than batch_size_.
+  UnwrappedBatchType partial_batch_;
+
+  // sync example_sampler_ and partial_batch_ update. Never held together with
+  // queue_mutex_.
+  std::mutex partial_batch_mutex_;
+
   // configurable maximun number of elements the queue can hold at one time.
   size_t queue_capacity_;
 
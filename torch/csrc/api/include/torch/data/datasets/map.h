@@ -72,6 +72,23 @@ class MapDataset : public BatchDataset<
       typename D = SourceDataset,
       typename = torch::disable_if_t<D::is_stateful>>
   OutputBatchType get_batch_impl(BatchRequestType indices) {
+    return collate_or_apply(std::move(indices), /*prefer_collate=*/0);
+  }
+
+  /// Lets transforms that can collate straight from the source dataset, like
+  /// `Stack`, do so.
+  template <typename T = AppliedTransform>
+  auto collate_or_apply(BatchRequestType indices, int /*prefer_collate*/)
+      -> decltype(std::declval<T&>().collate_from(
+          std::declval<SourceDataset&>(),
+          std::declval<BatchRequestType>())) {
+    return transform_.collate_from(dataset_, std::move(indices));
+  }
+
+  /// Applies the transform to the output of `get_batch()` from the dataset.
+  OutputBatchType collate_or_apply(
+      BatchRequestType indices,
+      long /*prefer_collate*/) {
     return transform_.apply_batch(dataset_.get_batch(std::move(indices)));
   }
 
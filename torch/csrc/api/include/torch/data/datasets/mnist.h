@@ -27,6 +27,9 @@ class TORCH_API MNIST : public Dataset<MNIST> {
   /// Returns the `Example` at the given `index`.
   Example<> get(size_t index) override;
 
+  /// Gathers the images and targets at `indices` straight into `out`.
+  bool get_batch_into(Example<>& out, ArrayRef<size_t> indices) override;
+
   /// Returns the size of the dataset.
   optional<size_t> size() const override;
 
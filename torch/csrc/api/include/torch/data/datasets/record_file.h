@@ -0,0 +1,141 @@
+#pragma once
+
+#include <torch/data/datasets/base.h>
+#include <torch/data/datasets/chunk.h>
+#include <torch/data/example.h>
+#include <torch/types.h>
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace caffe2 {
+namespace serialize {
+class MmapFileAdapter;
+} // namespace serialize
+} // namespace caffe2
+
+namespace torch {
+namespace data {
+namespace datasets {
+
+/// A record file is one shard of a dataset stored as a sequence of opaque
+/// byte records. It consists of an 8-byte magic string, the records, each
+/// padded to 8 bytes, an index holding the offset and size of every record as
+/// two `uint64_t`s, and a footer holding the offset of the index, the number
+/// of records and the magic string again. Integers are stored in the byte
+/// order of the machine that wrote the file.
+///
+/// Record files are memory mapped, so that records are read straight from the
+/// page cache. They are not supported on Windows.
+class TORCH_API RecordFile {
+ public:
+  /// Maps the record file at `path` and validates its index.
+  explicit RecordFile(const std::string& path);
+
+  /// Returns the number of records in the file.
+  size_t size() const noexcept {
+    return size_;
+  }
+
+  /// Returns the record at `index` as a one-dimensional `kUInt8` tensor that
+  /// points into the mapped file, and keeps it mapped. Writing to the tensor
+  /// only changes this process's copy of the record.
+  Tensor get(size_t index) const;
+
+ private:
+  std::shared_ptr<caffe2::serialize::MmapFileAdapter> file_;
+  char* data_ = nullptr;
+  const uint64_t* index_ = nullptr;
+  size_t size_ = 0;
+};
+
+/// Writes a record file; see `RecordFile` for the format.
+class TORCH_API RecordFileWriter {
+ public:
+  explicit RecordFileWriter(const std::string& path);
+
+  /// Finishes the file if `finish()` was not called.
+  ~RecordFileWriter();
+
+  /// Appends a record holding `size` bytes at `data`.
+  void write(const void* data, size_t size);
+
+  /// Appends a record holding the bytes of a CPU tensor.
+  void write(const Tensor& tensor);
+
+  /// Writes the index and footer, and closes the file.
+  void finish();
+
+ private:
+  void write_bytes(const void* data, size_t size);
+
+  std::string path_;
+  std::ofstream stream_;
+  uint64_t position_ = 0;
+  std::vector<uint64_t> index_;
+  bool finished_ = false;
+};
+
+/// A `ChunkDataReader` whose chunks are whole record files, for streaming
+/// through a `ChunkDataset`. Records are returned without being copied. Use
+/// `samplers::DistributedRandomSampler` as chunk sampler to shuffle the
+/// shards consistently across processes:
+///
+/// \rst
+/// .. code-block:: cpp
+///
+///   auto dataset = datasets::make_shared_dataset<datasets::ChunkDataset<
+///       datasets::RecordChunkReader,
+///       samplers::DistributedRandomSampler,
+///       samplers::RandomSampler>>(
+///       datasets::RecordChunkReader(shard_paths),
+///       samplers::DistributedRandomSampler(shard_paths.size(), world_size, rank),
+///       samplers::RandomSampler(0),
+///       datasets::ChunkDatasetOptions(/*preloader_count=*/4, /*batch_size=*/256));
+/// \endrst
+class TORCH_API RecordChunkReader : public ChunkDataReader<Tensor> {
+ public:
+  using BatchType = ChunkType;
+  using DataType = ExampleType;
+
+  explicit RecordChunkReader(std::vector<std::string> paths);
+
+  /// Returns all records of the record file at `chunk_index`.
+  BatchType read_chunk(size_t chunk_index) override;
+
+  /// Returns the number of record files.
+  size_t chunk_count() override;
+
+  void reset() override;
+
+ private:
+  std::vector<std::string> paths_;
+};
+
+/// A random access dataset over all records of a set of record files, in
+/// order. Each `get()` looks up its file by binary search and its record in
+/// O(1) through the file's index.
+class TORCH_API RecordDataset : public Dataset<RecordDataset, TensorExample> {
+ public:
+  explicit RecordDataset(const std::vector<std::string>& paths);
+
+  /// Returns the record at `index` as a `kUInt8` tensor.
+  TensorExample get(size_t index) override;
+
+  /// Returns the total number of records.
+  optional<size_t> size() const override;
+
+ private:
+  std::vector<std::shared_ptr<RecordFile>> files_;
+  /// The index of the first record of each file, followed by the total.
+  std::vector<size_t> first_record_;
+};
+} // namespace datasets
+} // namespace data
+} // namespace torch
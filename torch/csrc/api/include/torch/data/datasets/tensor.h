@@ -25,6 +25,13 @@ struct TensorDataset : public Dataset<TensorDataset, TensorExample> {
     return tensor[index];
   }
 
+  /// Gathers the rows at `indices` straight into `out`.
+  bool get_batch_into(TensorExample& out, ArrayRef<size_t> indices) override {
+    torch::index_select_out(
+        out.data, tensor, /*dim=*/0, detail::make_index_tensor(indices));
+    return true;
+  }
+
   /// Returns the number of tensors in the dataset.
   optional<size_t> size() const override {
     return tensor.size(0);
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <torch/data/example.h>
+#include <torch/types.h>
+
+#include <c10/core/Event.h>
+#include <c10/core/StreamGuard.h>
+#include <c10/core/impl/VirtualGuardImpl.h>
+
+#include <utility>
+#include <vector>
+
+namespace torch {
+namespace data {
+namespace detail {
+
+/// Returns `batch` with `function` applied to each of its tensors. Batches may
+/// be tensors, `Example`s, and vectors or optionals of these. Batches of any
+/// other type are returned unchanged.
+template <typename Function>
+Tensor map_tensors(Tensor tensor, const Function& function);
+template <typename Data, typename Function>
+Example<Data, example::NoTarget> map_tensors(
+    Example<Data, example::NoTarget> example,
+    const Function& function);
+template <typename Data, typename Target, typename Function>
+Example<Data, Target> map_tensors(
+    Example<Data, Target> example,
+    const Function& function);
+template <typename T, typename Function>
+std::vector<T> map_tensors(std::vector<T> values, const Function& function);
+template <typename T, typename Function>
+optional<T> map_tensors(optional<T> value, const Function& function);
+template <typename T, typename Function>
+T map_tensors(T value, const Function& function);
+
+template <typename Function>
+Tensor map_tensors(Tensor tensor, const Function& function) {
+  return tensor.defined() ? function(tensor) : tensor;
+}
+
+template <typename Data, typename Function>
+Example<Data, example::NoTarget> map_tensors(
+    Example<Data, example::NoTarget> example,
+    const Function& function) {
+  example.data = map_tensors(std::move(example.data), function);
+  return example;
+}
+
+template <typename Data, typename Target, typename Function>
+Example<Data, Target> map_tensors(
+    Example<Data, Target> example,
+    const Function& function) {
+  example.data = map_tensors(std::move(example.data), function);
+  example.target = map_tensors(std::move(example.target), function);
+  return example;
+}
+
+template <typename T, typename Function>
+std::vector<T> map_tensors(std::vector<T> values, const Function& function) {
+  for (auto& value : values) {
+    value = map_tensors(std::move(value), function);
+  }
+  return values;
+}
+
+template <typename T, typename Function>
+optional<T> map_tensors(optional<T> value, const Function& function) {
+  if (value) {
+    value = map_tensors(std::move(*value), function);
+  }
+  return value;
+}
+
+template <typename T, typename Function>
+T map_tensors(T value, const Function& /*function*/) {
+  return value;
+}
+
+/// Copies batches to a device on a dedicated stream, so that the copies
+/// overlap with the work queued on the device's current stream. Copies are
+/// only asynchronous for batches in pinned memory.
+class DeviceTransfer {
+ public:
+  /// A batch whose copy has been issued, and the event that completes it.
+  template <typename Batch>
+  struct Pending {
+    Batch batch;
+    c10::Event copied;
+  };
+
+  explicit DeviceTransfer(Device device)
+      : guard_impl_(device.type()),
+        device_(device.has_index() ? device : guard_impl_.getDevice()),
+        stream_(guard_impl_.getStreamFromGlobalPool(device_)) {}
+
+  /// Issues the copy of `batch` to the device.
+  template <typename Batch>
+  Pending<Batch> start(Batch batch) {
+    c10::StreamGuard guard(stream_);
+    Pending<Batch> pending{
+        map_tensors(
+            std::move(batch),
+            [this](const Tensor& tensor) {
+              return tensor.to(device_, /*non_blocking=*/true);
+            }),
+        c10::Event(device_.type())};
+    pending.copied.record(stream_);
+    return pending;
+  }
+
+  /// Makes the current stream of the device wait for the copy, and returns
+  /// the batch for use on that stream.
+  template <typename Batch>
+  Batch finish(Pending<Batch> pending) const {
+    const c10::Stream current = guard_impl_.getStream(device_);
+    pending.copied.block(current);
+    // The tensors were allocated on the transfer stream; their memory must
+    // not be reused before the current stream is done with them.
+    return map_tensors(std::move(pending.batch), [&current](Tensor tensor) {
+      tensor.record_stream(current);
+      return tensor;
+    });
+  }
+
+ private:
+  c10::impl::VirtualGuardImpl guard_impl_;
+  Device device_;
+  c10::Stream stream_;
+};
+
+} // namespace detail
+} // namespace data
+} // namespace torch
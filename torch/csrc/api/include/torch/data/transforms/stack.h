@@ -4,18 +4,46 @@
 #include <torch/data/transforms/collate.h>
 #include <torch/types.h>
 
+#include <c10/util/ArrayRef.h>
+
+#include <cstdint>
 #include <utility>
 #include <vector>
 
 namespace torch {
 namespace data {
 namespace transforms {
+namespace detail {
+/// The sizes and options of the tensors of one example, as seen in the last
+/// stacked batch. Used to preallocate the next batch.
+struct StackedLayout {
+  void record(const Tensor& batch) {
+    example_sizes = batch.sizes().slice(1).vec();
+    options = batch.options();
+    known = true;
+  }
+
+  Tensor allocate(size_t batch_size) const {
+    std::vector<int64_t> sizes = example_sizes;
+    sizes.insert(sizes.begin(), static_cast<int64_t>(batch_size));
+    return torch::empty(sizes, options);
+  }
+
+  std::vector<int64_t> example_sizes;
+  TensorOptions options;
+  bool known = false;
+};
+} // namespace detail
 
 template <typename T = Example<>>
 struct Stack;
 
 /// A `Collation` for `Example<Tensor, Tensor>` types that stacks all data
 /// tensors into one tensor, and all target (label) tensors into one tensor.
+///
+/// When mapped over a dataset that implements `get_batch_into()`, batches
+/// after the first are allocated upfront, from the layout of the previous
+/// batch, and filled by the dataset directly.
 template <>
 struct Stack<Example<>> : public Collation<Example<>> {
   Example<> apply_batch(std::vector<Example<>> examples) override {
@@ -26,12 +54,42 @@ struct Stack<Example<>> : public Collation<Example<>> {
       data.push_back(std::move(example.data));
       targets.push_back(std::move(example.target));
     }
-    return {torch::stack(data), torch::stack(targets)};
+    Example<> batch{torch::stack(data), torch::stack(targets)};
+    data_layout_.record(batch.data);
+    target_layout_.record(batch.target);
+    return batch;
+  }
+
+  /// Collates the examples of `dataset` at `indices`, writing them into a
+  /// preallocated batch if the dataset supports it.
+  template <typename Dataset>
+  auto collate_from(Dataset& dataset, ArrayRef<size_t> indices)
+      -> decltype(
+          dataset.get_batch_into(std::declval<Example<>&>(), indices),
+          Example<>()) {
+    if (write_into_ && data_layout_.known) {
+      Example<> batch{
+          data_layout_.allocate(indices.size()),
+          target_layout_.allocate(indices.size())};
+      if (dataset.get_batch_into(batch, indices)) {
+        return batch;
+      }
+      write_into_ = false;
+    }
+    return apply_batch(dataset.get_batch(indices));
   }
+
+ private:
+  detail::StackedLayout data_layout_;
+  detail::StackedLayout target_layout_;
+  bool write_into_ = true;
 };
 
 /// A `Collation` for `Example<Tensor, NoTarget>` types that stacks all data
 /// tensors into one tensor.
+///
+/// Like `Stack<Example<>>`, writes batches after the first straight into a
+/// preallocated tensor when the dataset implements `get_batch_into()`.
 template <>
 struct Stack<TensorExample>
     : public Collation<Example<Tensor, example::NoTarget>> {
@@ -41,8 +99,31 @@ struct Stack<TensorExample>
     for (auto& example : examples) {
       data.push_back(std::move(example.data));
     }
-    return torch::stack(data);
+    TensorExample batch = torch::stack(data);
+    data_layout_.record(batch.data);
+    return batch;
   }
+
+  /// Collates the examples of `dataset` at `indices`, writing them into a
+  /// preallocated batch if the dataset supports it.
+  template <typename Dataset>
+  auto collate_from(Dataset& dataset, ArrayRef<size_t> indices)
+      -> decltype(
+          dataset.get_batch_into(std::declval<TensorExample&>(), indices),
+          TensorExample()) {
+    if (write_into_ && data_layout_.known) {
+      TensorExample batch = data_layout_.allocate(indices.size());
+      if (dataset.get_batch_into(batch, indices)) {
+        return batch;
+      }
+      write_into_ = false;
+    }
+    return apply_batch(dataset.get_batch(indices));
+  }
+
+ private:
+  detail::StackedLayout data_layout_;
+  bool write_into_ = true;
 };
 } // namespace transforms
 } // namespace data
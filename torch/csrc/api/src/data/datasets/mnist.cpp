@@ -104,6 +104,13 @@ Example<> MNIST::get(size_t index) {
   return {images_[index], targets_[index]};
 }
 
+bool MNIST::get_batch_into(Example<>& out, ArrayRef<size_t> indices) {
+  const auto index = detail::make_index_tensor(indices);
+  torch::index_select_out(out.data, images_, /*dim=*/0, index);
+  torch::index_select_out(out.target, targets_, /*dim=*/0, index);
+  return true;
+}
+
 optional<size_t> MNIST::size() const {
   return images_.size(0);
 }
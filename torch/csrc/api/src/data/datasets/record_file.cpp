@@ -0,0 +1,207 @@
+#include <torch/data/datasets/record_file.h>
+
+#include <torch/types.h>
+
+#include <c10/util/Exception.h>
+#include <caffe2/serialize/mmap_file_adapter.h>
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace torch {
+namespace data {
+namespace datasets {
+namespace {
+constexpr char kMagic[] = "TRECORD1";
+constexpr size_t kMagicSize = sizeof(kMagic) - 1;
+constexpr size_t kAlignment = 8;
+// index offset, record count, magic
+constexpr size_t kFooterSize = 2 * sizeof(uint64_t) + kMagicSize;
+// offset and size of a record
+constexpr size_t kIndexEntrySize = 2 * sizeof(uint64_t);
+} // namespace
+
+RecordFile::RecordFile(const std::string& path)
+    : file_(std::make_shared<caffe2::serialize::MmapFileAdapter>(path)) {
+  const size_t file_size = file_->size();
+  TORCH_CHECK(
+      file_size >= kMagicSize + kFooterSize,
+      path,
+      " is not a record file: it is too small");
+  data_ = static_cast<char*>(file_->getDataPtr(0, file_size).get());
+  TORCH_CHECK(
+      std::memcmp(data_, kMagic, kMagicSize) == 0 &&
+          std::memcmp(data_ + file_size - kMagicSize, kMagic, kMagicSize) ==
+              0,
+      path,
+      " is not a record file: wrong magic string");
+
+  uint64_t index_offset = 0;
+  uint64_t count = 0;
+  const char* footer = data_ + file_size - kFooterSize;
+  std::memcpy(&index_offset, footer, sizeof(uint64_t));
+  std::memcpy(&count, footer + sizeof(uint64_t), sizeof(uint64_t));
+  const uint64_t index_end = file_size - kFooterSize;
+  TORCH_CHECK(
+      index_offset >= kMagicSize && index_offset % kAlignment == 0 &&
+          index_offset <= index_end &&
+          count == (index_end - index_offset) / kIndexEntrySize &&
+          (index_end - index_offset) % kIndexEntrySize == 0,
+      path,
+      " is corrupt: invalid index location");
+  index_ = reinterpret_cast<const uint64_t*>(data_ + index_offset);
+  for (uint64_t i = 0; i < count; ++i) {
+    const uint64_t offset = index_[2 * i];
+    const uint64_t size = index_[2 * i + 1];
+    TORCH_CHECK(
+        offset >= kMagicSize && offset <= index_offset &&
+            size <= index_offset - offset,
+        path,
+        " is corrupt: record ",
+        i,
+        " is out of bounds");
+  }
+  size_ = count;
+}
+
+Tensor RecordFile::get(size_t index) const {
+  TORCH_CHECK(
+      index < size_,
+      "Record index ",
+      index,
+      " is out of range for a record file with ",
+      size_,
+      " records");
+  const uint64_t offset = index_[2 * index];
+  const uint64_t size = index_[2 * index + 1];
+  auto file = file_;
+  return torch::from_blob(
+      data_ + offset,
+      {static_cast<int64_t>(size)},
+      [file](void*) {},
+      torch::kUInt8);
+}
+
+RecordFileWriter::RecordFileWriter(const std::string& path)
+    : path_(path), stream_(path, std::ios::binary | std::ios::trunc) {
+  TORCH_CHECK(stream_, "Could not open ", path, " for writing");
+  write_bytes(kMagic, kMagicSize);
+}
+
+RecordFileWriter::~RecordFileWriter() {
+  if (!finished_) {
+    try {
+      finish();
+    } catch (const std::exception& e) {
+      TORCH_WARN("Failed to finish record file ", path_, ": ", e.what());
+    }
+  }
+}
+
+void RecordFileWriter::write(const void* data, size_t size) {
+  TORCH_CHECK(!finished_, "Cannot write to finished record file ", path_);
+  index_.push_back(position_);
+  index_.push_back(size);
+  write_bytes(data, size);
+  static const char padding[kAlignment] = {};
+  write_bytes(padding, (kAlignment - position_ % kAlignment) % kAlignment);
+}
+
+void RecordFileWriter::write(const Tensor& tensor) {
+  TORCH_CHECK(
+      tensor.device().is_cpu(),
+      "Only CPU tensors can be written to a record file, got a tensor on ",
+      tensor.device());
+  const Tensor contiguous = tensor.contiguous();
+  write(contiguous.data_ptr(), contiguous.nbytes());
+}
+
+void RecordFileWriter::finish() {
+  if (finished_) {
+    return;
+  }
+  finished_ = true;
+  const uint64_t index_offset = position_;
+  const uint64_t count = index_.size() / 2;
+  write_bytes(index_.data(), index_.size() * sizeof(uint64_t));
+  write_bytes(&index_offset, sizeof(index_offset));
+  write_bytes(&count, sizeof(count));
+  write_bytes(kMagic, kMagicSize);
+  stream_.close();
+  TORCH_CHECK(stream_, "Could not write record file ", path_);
+}
+
+void RecordFileWriter::write_bytes(const void* data, size_t size) {
+  if (size == 0) {
+    return;
+  }
+  stream_.write(static_cast<const char*>(data), size);
+  TORCH_CHECK(stream_, "Could not write to record file ", path_);
+  position_ += size;
+}
+
+RecordChunkReader::RecordChunkReader(std::vector<std::string> paths)
+    : paths_(std::move(paths)) {}
+
+RecordChunkReader::BatchType RecordChunkReader::read_chunk(
+    size_t chunk_index) {
+  TORCH_CHECK(
+      chunk_index < paths_.size(),
+      "Chunk index ",
+      chunk_index,
+      " is out of range for ",
+      paths_.size(),
+      " record files");
+  const RecordFile file(paths_[chunk_index]);
+  BatchType records;
+  records.reserve(file.size());
+  for (size_t i = 0; i < file.size(); ++i) {
+    records.push_back(file.get(i));
+  }
+  return records;
+}
+
+size_t RecordChunkReader::chunk_count() {
+  return paths_.size();
+}
+
+void RecordChunkReader::reset() {}
+
+RecordDataset::RecordDataset(const std::vector<std::string>& paths) {
+  files_.reserve(paths.size());
+  first_record_.reserve(paths.size() + 1);
+  size_t total = 0;
+  for (const auto& path : paths) {
+    files_.push_back(std::make_shared<RecordFile>(path));
+    first_record_.push_back(total);
+    total += files_.back()->size();
+  }
+  first_record_.push_back(total);
+}
+
+TensorExample RecordDataset::get(size_t index) {
+  TORCH_CHECK(
+      index < first_record_.back(),
+      "Record index ",
+      index,
+      " is out of range for a dataset with ",
+      first_record_.back(),
+      " records");
+  // The last file whose first record is at or before index; empty files are
+  // skipped because their successor starts at the same record.
+  const auto it =
+      std::upper_bound(first_record_.begin(), first_record_.end(), index) - 1;
+  const size_t file = it - first_record_.begin();
+  return files_[file]->get(index - *it);
+}
+
+optional<size_t> RecordDataset::size() const {
+  return first_record_.back();
+}
+} // namespace datasets
+} // namespace data
+} // namespace torch
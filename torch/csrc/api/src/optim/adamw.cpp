@@ -7,8 +7,10 @@
 
 #include <ATen/ATen.h>
 
+#include <algorithm>
 #include <cmath>
 #include <functional>
+#include <vector>
 
 namespace torch {
 namespace optim {
@@ -61,6 +63,21 @@ void AdamWParamState::serialize(torch::serialize::InputArchive& archive) {
   _TORCH_OPTIM_DESERIALIZE_TORCH_ARG(Tensor, max_exp_avg_sq);
 }
 
+namespace {
+// Parameters of a group that are updated together by _fused_adam_: they
+// share device, dtype and step, and so the bias corrections.
+struct AdamWBucket {
+  Device device;
+  ScalarType dtype;
+  int64_t step;
+  std::vector<Tensor> params;
+  std::vector<Tensor> grads;
+  std::vector<Tensor> exp_avgs;
+  std::vector<Tensor> exp_avg_sqs;
+  std::vector<Tensor> max_exp_avg_sqs;
+};
+} // namespace
+
 Tensor AdamW::step(LossClosure closure)  {
   NoGradGuard no_grad;
   Tensor loss = {};
@@ -69,6 +86,8 @@ Tensor AdamW::step(LossClosure closure)  {
     loss = closure();
   }
   for (auto& group : param_groups_) {
+    auto& options = static_cast<AdamWOptions&>(group.options());
+    std::vector<AdamWBucket> buckets;
     for (auto& p : group.params()) {
       if (!p.grad().defined()) {
         continue;
@@ -76,12 +95,6 @@ Tensor AdamW::step(LossClosure closure)  {
       auto grad = p.grad();
       TORCH_CHECK(!grad.is_sparse(), "AdamW does not support sparse gradients"/*, please consider SparseAdamW instead*/);
       auto param_state = state_.find(c10::guts::to_string(p.unsafeGetTensorImpl()));
-      auto& options = static_cast<AdamWOptions&>(group.options());
-
-      // Perform stepweight decay
-      if(options.weight_decay() != 0) {
-        p.mul_(1 - options.lr() * options.weight_decay());
-      }
 
       // State initialization
       if(param_state == state_.end()) {
@@ -99,33 +112,40 @@ Tensor AdamW::step(LossClosure closure)  {
       }
 
       auto& state = static_cast<AdamWParamState&>(*state_[c10::guts::to_string(p.unsafeGetTensorImpl())]);
-      auto& exp_avg = state.exp_avg();
-      auto& exp_avg_sq = state.exp_avg_sq();
-      auto& max_exp_avg_sq = state.max_exp_avg_sq();
-
       state.step(state.step()+1);
-      auto beta1 = std::get<0>(options.betas());
-      auto beta2 = std::get<1>(options.betas());
 
-      auto bias_correction1 = 1 - std::pow(beta1, state.step());
-      auto bias_correction2 = 1 - std::pow(beta2, state.step());
-
-      // Decay the first and second moment running average coefficient
-      exp_avg.mul_(beta1).add_(grad, 1 - beta1);
-      exp_avg_sq.mul_(beta2).addcmul_(grad, grad, 1 - beta2);
-
-      Tensor denom;
+      auto bucket = std::find_if(buckets.begin(), buckets.end(), [&](const AdamWBucket& b) {
+        return b.device == p.device() && b.dtype == p.scalar_type() && b.step == state.step();
+      });
+      if (bucket == buckets.end()) {
+        buckets.push_back(AdamWBucket{p.device(), p.scalar_type(), state.step()});
+        bucket = buckets.end() - 1;
+      }
+      bucket->params.push_back(p);
+      bucket->grads.push_back(grad);
+      bucket->exp_avgs.push_back(state.exp_avg());
+      bucket->exp_avg_sqs.push_back(state.exp_avg_sq());
       if(options.amsgrad()) {
-        // Maintains the maximum of all 2nd moment running avg. till now
-        torch::max_out(max_exp_avg_sq, exp_avg_sq, max_exp_avg_sq);
-        // Use the max. for normalizing running avg. of gradient
-        denom = (max_exp_avg_sq.sqrt() / sqrt(bias_correction2)).add_(options.eps());
-      } else {
-        denom = (exp_avg_sq.sqrt() / sqrt(bias_correction2)).add_(options.eps());
+        bucket->max_exp_avg_sqs.push_back(state.max_exp_avg_sq());
       }
+    }
 
-      auto step_size = options.lr() / bias_correction1;
-      p.addcdiv_(exp_avg, denom, -step_size);
+    // One multi-tensor update per bucket, which reads and writes every
+    // parameter and its state once, instead of one pass per op and parameter
+    for (auto& bucket : buckets) {
+      torch::_fused_adam_(
+          bucket.params,
+          bucket.grads,
+          bucket.exp_avgs,
+          bucket.exp_avg_sqs,
+          bucket.max_exp_avg_sqs,
+          bucket.step,
+          options.lr(),
+          std::get<0>(options.betas()),
+          std::get<1>(options.betas()),
+          options.weight_decay(),
+          options.eps(),
+          /*decoupled_weight_decay=*/true);
     }
   }
   return loss;
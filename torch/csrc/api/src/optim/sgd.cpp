@@ -9,7 +9,9 @@
 
 #include <ATen/ATen.h>
 
+#include <algorithm>
 #include <functional>
+#include <vector>
 
 namespace torch {
 namespace optim {
@@ -52,6 +54,19 @@ void SGDParamState::serialize(torch::serialize::InputArchive& archive) {
   _TORCH_OPTIM_DESERIALIZE_TORCH_ARG(Tensor, momentum_buffer);
 }
 
+namespace {
+// Dense parameters of a group that are updated together by _fused_sgd_: they
+// share device, dtype and whether their momentum buffer is new.
+struct SGDBucket {
+  Device device;
+  ScalarType dtype;
+  bool is_first_step;
+  std::vector<Tensor> params;
+  std::vector<Tensor> grads;
+  std::vector<Tensor> momentum_buffers;
+};
+} // namespace
+
 Tensor SGD::step(LossClosure closure)  {
   NoGradGuard no_grad;
   Tensor loss = {};
@@ -65,34 +80,82 @@ Tensor SGD::step(LossClosure closure)  {
     auto momentum = options.momentum();
     auto dampening = options.dampening();
     auto nesterov = options.nesterov();
+    std::vector<SGDBucket> buckets;
 
     for (auto& p : group.params()) {
       if (!p.grad().defined()) {
         continue;
       }
-      auto d_p = p.grad().data();
-      if (weight_decay != 0) {
-        d_p = d_p.add(p.data(), weight_decay);
+      if (p.grad().is_sparse()) {
+        auto d_p = p.grad().data();
+        if (weight_decay != 0) {
+          d_p = d_p.add(p.data(), weight_decay);
+        }
+        if (momentum != 0) {
+          Tensor buf;
+          auto param_state = state_.find(c10::guts::to_string(p.unsafeGetTensorImpl()));
+          if(param_state == state_.end()) {
+            buf = torch::clone(d_p).detach();
+            auto state = std::make_unique<SGDParamState>();
+            state->momentum_buffer(buf);
+            state_[c10::guts::to_string(p.unsafeGetTensorImpl())] = std::move(state);
+          } else {
+            buf = static_cast<SGDParamState&>(*param_state->second).momentum_buffer();
+            buf.mul_(momentum).add_(d_p, 1 - dampening);
+          }
+          if (nesterov) {
+            d_p = d_p.add(buf, momentum);
+          } else {
+            d_p = buf;
+          }
+        }
+        p.data().add_(d_p, -1 * options.lr());
+        continue;
       }
+
+      Tensor buf;
+      bool is_first_step = false;
       if (momentum != 0) {
-        Tensor buf;
         auto param_state = state_.find(c10::guts::to_string(p.unsafeGetTensorImpl()));
         if(param_state == state_.end()) {
-          buf = torch::clone(d_p).detach();
+          // filled with the first update by _fused_sgd_
+          buf = torch::empty_like(p, MemoryFormat::Preserve);
+          is_first_step = true;
           auto state = std::make_unique<SGDParamState>();
           state->momentum_buffer(buf);
           state_[c10::guts::to_string(p.unsafeGetTensorImpl())] = std::move(state);
         } else {
           buf = static_cast<SGDParamState&>(*param_state->second).momentum_buffer();
-          buf.mul_(momentum).add_(d_p, 1 - dampening);
-        }
-        if (nesterov) {
-          d_p = d_p.add(buf, momentum);
-        } else {
-          d_p = buf;
         }
       }
-      p.data().add_(d_p, -1 * options.lr());
+
+      auto bucket = std::find_if(buckets.begin(), buckets.end(), [&](const SGDBucket& b) {
+        return b.device == p.device() && b.dtype == p.scalar_type() && b.is_first_step == is_first_step;
+      });
+      if (bucket == buckets.end()) {
+        buckets.push_back(SGDBucket{p.device(), p.scalar_type(), is_first_step});
+        bucket = buckets.end() - 1;
+      }
+      bucket->params.push_back(p);
+      bucket->grads.push_back(p.grad());
+      if (momentum != 0) {
+        bucket->momentum_buffers.push_back(buf);
+      }
+    }
+
+    // One multi-tensor update per bucket, which reads and writes every
+    // parameter and its momentum buffer once
+    for (auto& bucket : buckets) {
+      torch::_fused_sgd_(
+          bucket.params,
+          bucket.grads,
+          bucket.momentum_buffers,
+          options.lr(),
+          momentum,
+          dampening,
+          weight_decay,
+          nesterov,
+          bucket.is_first_step);
     }
   }
   return loss;
@@ -2839,6 +2839,57 @@ infinitely_differentiable_native_layer_norm_backward(
   return std::make_tuple(dX, dgamma, dbeta);
 }
 
+std::tuple<Tensor, Tensor, Tensor, Tensor>
+fused_dropout_add_layer_norm_backward(
+    const Tensor& dY,
+    const Tensor& dH,
+    const Tensor& H,
+    const Tensor& mask,
+    const Tensor& mean,
+    const Tensor& rstd,
+    const c10::optional<Tensor>& gamma,
+    const c10::optional<Tensor>& beta,
+    IntArrayRef normalized_shape,
+    double p,
+    double eps,
+    std::array<bool, 4> grad_input_mask) {
+  // H = dropout(input) + residual is the input of the normalization
+  Tensor dX;
+  Tensor dgamma;
+  Tensor dbeta;
+  if (dY.defined()) {
+    const std::array<bool, 3> layer_norm_mask = {
+        grad_input_mask[0] || grad_input_mask[1],
+        grad_input_mask[2],
+        grad_input_mask[3]};
+    if (GradMode::is_enabled()) {
+      std::tie(dX, dgamma, dbeta) =
+          infinitely_differentiable_native_layer_norm_backward(
+              dY, Tensor(), Tensor(), H, mean, rstd, gamma, normalized_shape,
+              eps, layer_norm_mask);
+    } else {
+      std::tie(dX, dgamma, dbeta) = at::native_layer_norm_backward(
+          dY.is_contiguous() ? dY : dY.contiguous(), H, normalized_shape,
+          mean, rstd, gamma, beta, layer_norm_mask);
+    }
+  }
+  if (dH.defined()) {
+    dX = dX.defined() ? dX + dH : dH;
+  }
+
+  Tensor dinput;
+  Tensor dresidual;
+  if (dX.defined()) {
+    if (grad_input_mask[0]) {
+      dinput = _fused_dropout_backward(dX, mask, p);
+    }
+    if (grad_input_mask[1]) {
+      dresidual = dX;
+    }
+  }
+  return std::make_tuple(dinput, dresidual, dgamma, dbeta);
+}
+
 std::tuple<Tensor, Tensor, Tensor>
 infinitely_differentiable_native_group_norm_backward(
     const Tensor& dY,
@@ -223,6 +223,20 @@ infinitely_differentiable_native_layer_norm_backward(
     IntArrayRef normalized_shape,
     double eps,
     std::array<bool, 3> grad_input_mask);
+std::tuple<Tensor, Tensor, Tensor, Tensor>
+fused_dropout_add_layer_norm_backward(
+    const Tensor& dY,
+    const Tensor& dH,
+    const Tensor& H,
+    const Tensor& mask,
+    const Tensor& mean,
+    const Tensor& rstd,
+    const c10::optional<Tensor>& gamma,
+    const c10::optional<Tensor>& beta,
+    IntArrayRef normalized_shape,
+    double p,
+    double eps,
+    std::array<bool, 4> grad_input_mask);
 std::tuple<Tensor, Tensor> polar_backward(
     const Tensor& grad,
     const Tensor& result);
@@ -47,6 +47,11 @@ namespace torch { namespace autograd {
 // b = torch.rand(2, requires_grad=True)
 // a.copy_(b)
 inline void check_inplace(const Tensor& tensor, bool requires_grad) {
+  // Checked before the update rather than when bumping the version, see
+  // InferenceMode. Autograd kernels don't run in InferenceMode.
+  TORCH_CHECK(!tensor.is_inference(),
+    "Inplace update to inference tensor outside InferenceMode is not allowed. "
+    "You can make a clone to get a normal tensor before doing inplace update.");
   if (requires_grad && GradMode::is_enabled()) {
     if (tensor.is_view()) {
       // NB: is_view() ==> get_autograd_meta()
@@ -137,6 +142,11 @@ template<typename... Args> inline variable_list flatten_tensor_args(Args&&... ar
 inline Tensor as_view(const Tensor & base, const Tensor & tensor, bool is_bw_differentiable,
         bool is_fw_differentiable, std::function<Tensor(const Tensor&)> view_func=nullptr,
         CreationMeta creation_meta=CreationMeta::DEFAULT, bool allow_tensor_metadata_change=true) {
+  // Views of inference tensors are inference tensors, which autograd doesn't
+  // track, see InferenceMode
+  if (base.unsafeGetTensorImpl()->is_inference()) {
+    return make_variable_non_differentiable_view(base, tensor, allow_tensor_metadata_change);
+  }
   if (!isForwardADEnabled()) {
     // Fast codepath for backward only code
     // It is useful as it avoids the creation of the temporary c10<optional> which makes
@@ -203,6 +213,12 @@ inline Tensor as_view(const Tensor & base, const Tensor & tensor, bool is_bw_dif
 // See NOTE [ Autograd View Variables ] for details.
 inline std::vector<Tensor> as_view(const Tensor & base, std::vector<Tensor>& tensors, bool is_bw_differentiable,
                                    bool is_fw_differentiable, CreationMeta creation_meta=CreationMeta::DEFAULT) {
+  if (base.unsafeGetTensorImpl()->is_inference()) {
+    for (Tensor& tensor : tensors) {
+      tensor = make_variable_non_differentiable_view(base, tensor);
+    }
+    return tensors;
+  }
   c10::optional<ViewInfo> new_bw_info = c10::nullopt;
   c10::optional<ViewInfo> new_fw_info = c10::nullopt;
 
@@ -1,5 +1,7 @@
 #include <torch/csrc/autograd/variable.h>
 
+#include <ATen/BatchedTensorImpl.h>
+
 namespace torch {
 namespace autograd {
 
@@ -63,6 +65,16 @@ using at::Tensor;
 // Case 4 is handled by set_fw_grad by properly setting the forward grad of the base if needed.
 // Case 5 is handled in fw_grad by reading the forward grad from the base if needed.
 
+// Note [Batched tangents]
+// A tangent may be a BatchedTensor (see ATen/BatchedTensorImpl.h) while its
+// primal is a regular Tensor: running a function on dual Tensors under vmap,
+// with only the tangents being vmapped over, computes one jvp per batch
+// element in a single pass. Forward formulas then simply run on
+// BatchedTensors and go through the batching rules.
+// A BatchedTensor can't be given arbitrary strides or storage offset, so the
+// layout constraint above is not enforced for these tangents and in-place
+// operations on views of such dual Tensors are not supported.
+
 
 namespace {
   // Check if two Tensor have the same storage offset, sizes and strides
@@ -120,6 +132,16 @@ void AutogradMeta::set_fw_grad(const Variable& new_grad_, const Variable& self,
     TORCH_INTERNAL_ASSERT(fw_grad_->value(level).is_same(new_grad_), "Cannot set a value of a forward grad if it "
                           "already exists. Inplace operations should modify it inplace.");
   } else {
+    if (at::isBatchedTensor(new_grad_)) {
+      // See Note [Batched tangents]
+      TORCH_CHECK(!(is_inplace_op && is_view_), "In-place operations on a view of a dual Tensor ",
+                  "are not supported when its tangent is batched (vmapped over).");
+      TORCH_CHECK(new_grad_.sizes().equals(self.sizes()), "Trying to set a batched forward gradient of size ",
+                  new_grad_.sizes(), " (per batch element) on a Tensor of size ", self.sizes());
+      fw_grad_->set_value(new_grad_, level);
+      return;
+    }
+
     // TODO(alband) remove this spurious version counter bump
     auto new_grad = new_grad_;
 
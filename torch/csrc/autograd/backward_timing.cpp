@@ -0,0 +1,183 @@
+#include <torch/csrc/autograd/backward_timing.h>
+
+#include <c10/util/Type.h>
+#include <torch/csrc/autograd/function.h>
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <typeinfo>
+#include <unordered_map>
+
+namespace torch { namespace autograd {
+
+std::atomic<bool> BackwardTiming::enabled_{false};
+constexpr size_t BackwardTiming::kMaxNodeTypes;
+constexpr size_t BackwardTiming::kEventsPerThread;
+
+namespace {
+
+// The buffers of one thread. The owning thread is the only writer; the mutex
+// is only ever contended while a summary is being built.
+struct ThreadTimings {
+  struct Slot {
+    const std::type_info* type = nullptr;
+    uint64_t count = 0;
+    uint64_t total_ns = 0;
+    uint64_t max_ns = 0;
+  };
+  struct Event {
+    const std::type_info* type = nullptr;
+    uint64_t sequence_nr = 0;
+    uint64_t duration_ns = 0;
+  };
+
+  std::mutex mutex;
+  // Open addressing on the address of the type_info.
+  std::array<Slot, BackwardTiming::kMaxNodeTypes> slots;
+  uint64_t dropped = 0;
+  std::array<Event, BackwardTiming::kEventsPerThread> events;
+  // Total number of events recorded; the ring position is this modulo its size.
+  uint64_t num_events = 0;
+
+  void clear() {
+    slots.fill(Slot());
+    events.fill(Event());
+    dropped = 0;
+    num_events = 0;
+  }
+};
+
+std::mutex& registry_mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+// Buffers are kept after their thread exits so that its timings still show
+// up in summaries; reset() drops those.
+std::vector<std::shared_ptr<ThreadTimings>>& registry() {
+  static std::vector<std::shared_ptr<ThreadTimings>> timings;
+  return timings;
+}
+
+ThreadTimings& local_timings() {
+  thread_local std::shared_ptr<ThreadTimings> timings = []() {
+    auto t = std::make_shared<ThreadTimings>();
+    std::lock_guard<std::mutex> lock(registry_mutex());
+    registry().push_back(t);
+    return t;
+  }();
+  return *timings;
+}
+
+std::string type_name(const std::type_info* type) {
+  return c10::demangle(type->name());
+}
+
+} // namespace
+
+void BackwardTiming::record(const Node& fn, uint64_t duration_ns) {
+  const std::type_info* type = &typeid(fn);
+  auto& timings = local_timings();
+  std::lock_guard<std::mutex> lock(timings.mutex);
+
+  auto& event = timings.events[timings.num_events++ % kEventsPerThread];
+  event.type = type;
+  event.sequence_nr = fn.sequence_nr();
+  event.duration_ns = duration_ns;
+
+  const size_t hash = std::hash<const void*>()(type);
+  for (size_t i = 0; i < kMaxNodeTypes; ++i) {
+    auto& slot = timings.slots[(hash + i) % kMaxNodeTypes];
+    if (slot.type == nullptr) {
+      slot.type = type;
+    } else if (slot.type != type) {
+      continue;
+    }
+    slot.count++;
+    slot.total_ns += duration_ns;
+    slot.max_ns = std::max(slot.max_ns, duration_ns);
+    return;
+  }
+  timings.dropped++;
+}
+
+std::vector<BackwardTiming::NodeStats> BackwardTiming::summary() {
+  // The same type may be seen through different type_info objects across
+  // shared libraries, so merge by name.
+  std::unordered_map<std::string, NodeStats> merged;
+  std::lock_guard<std::mutex> registry_lock(registry_mutex());
+  for (const auto& timings : registry()) {
+    std::lock_guard<std::mutex> lock(timings->mutex);
+    for (const auto& slot : timings->slots) {
+      if (slot.type == nullptr) {
+        continue;
+      }
+      auto name = type_name(slot.type);
+      auto it = merged.find(name);
+      if (it == merged.end()) {
+        it = merged.emplace(name, NodeStats{name, 0, 0, 0}).first;
+      }
+      it->second.count += slot.count;
+      it->second.total_ns += slot.total_ns;
+      it->second.max_ns = std::max(it->second.max_ns, slot.max_ns);
+    }
+  }
+
+  std::vector<NodeStats> result;
+  result.reserve(merged.size());
+  for (auto& entry : merged) {
+    result.push_back(std::move(entry.second));
+  }
+  std::sort(result.begin(), result.end(), [](const NodeStats& a, const NodeStats& b) {
+    return a.total_ns > b.total_ns;
+  });
+  return result;
+}
+
+std::vector<BackwardTiming::NodeEvent> BackwardTiming::recent_events() {
+  std::vector<NodeEvent> result;
+  {
+    std::lock_guard<std::mutex> registry_lock(registry_mutex());
+    for (const auto& timings : registry()) {
+      std::lock_guard<std::mutex> lock(timings->mutex);
+      const uint64_t count = std::min<uint64_t>(timings->num_events, kEventsPerThread);
+      for (uint64_t i = 0; i < count; ++i) {
+        const auto& event = timings->events[i];
+        result.push_back(NodeEvent{type_name(event.type), event.sequence_nr, event.duration_ns});
+      }
+    }
+  }
+  std::sort(result.begin(), result.end(), [](const NodeEvent& a, const NodeEvent& b) {
+    return a.sequence_nr < b.sequence_nr;
+  });
+  return result;
+}
+
+uint64_t BackwardTiming::dropped() {
+  uint64_t dropped = 0;
+  std::lock_guard<std::mutex> registry_lock(registry_mutex());
+  for (const auto& timings : registry()) {
+    std::lock_guard<std::mutex> lock(timings->mutex);
+    dropped += timings->dropped;
+  }
+  return dropped;
+}
+
+void BackwardTiming::reset() {
+  std::lock_guard<std::mutex> registry_lock(registry_mutex());
+  auto& timings = registry();
+  // Only the registry still references the buffers of exited threads.
+  timings.erase(
+      std::remove_if(timings.begin(), timings.end(),
+          [](const std::shared_ptr<ThreadTimings>& t) { return t.use_count() == 1; }),
+      timings.end());
+  for (const auto& t : timings) {
+    std::lock_guard<std::mutex> lock(t->mutex);
+    t->clear();
+  }
+}
+
+}} // namespace torch::autograd
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace torch { namespace autograd {
+
+// forward declaration of Node from function.h
+struct Node;
+
+/// Cheap timing of the nodes run by the autograd engine, meant to be left on
+/// in production. When enabled, the engine measures the wall time of every
+/// Node it applies (hooks included) and records it into buffers of a fixed
+/// size owned by the thread that ran the node: one counter per Node type and
+/// a ring of the most recent nodes with their sequence numbers. Nothing is
+/// allocated on the hot path once a thread has recorded its first node.
+///
+/// Nodes are keyed by their C++ type, so all custom Python functions are
+/// reported as a single `PyNode` entry.
+struct TORCH_API BackwardTiming {
+  static constexpr size_t kMaxNodeTypes = 256;
+  static constexpr size_t kEventsPerThread = 1024;
+
+  struct NodeStats {
+    std::string name;
+    uint64_t count;
+    uint64_t total_ns;
+    uint64_t max_ns;
+  };
+
+  struct NodeEvent {
+    std::string name;
+    uint64_t sequence_nr;
+    uint64_t duration_ns;
+  };
+
+  static bool is_enabled() {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+  static void set_enabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+  }
+
+  static void record(const Node& fn, uint64_t duration_ns);
+
+  /// Counters of all threads merged per Node type, by decreasing total time.
+  static std::vector<NodeStats> summary();
+  /// Time spent per sequence number by the most recent nodes of each thread
+  /// (at most kEventsPerThread each), by increasing sequence number.
+  static std::vector<NodeEvent> recent_events();
+  /// Number of nodes not counted because a thread saw more than
+  /// kMaxNodeTypes different Node types.
+  static uint64_t dropped();
+  static void reset();
+
+ private:
+  static std::atomic<bool> enabled_;
+};
+
+}} // namespace torch::autograd
@@ -202,7 +202,8 @@ typename std::enable_if<std::is_same<T, Variable>::value, T>::type to_output_typ
 template<class T>
 template<typename X, typename... Args>
 auto Function<T>::apply(Args&&... args) -> std::enable_if_t<std::is_same<X,T>::value, forward_t<X,Args...>> {
-  std::shared_ptr<CppNode<T>> node(new CppNode<T>(), deleteNode);
+  std::shared_ptr<CppNode<T>> node(
+      new CppNode<T>(), deleteNode, NodePoolAllocator<CppNode<T>>());
   variable_list input_vars;
 
   const size_t num_inputs = sizeof...(Args);
@@ -5,10 +5,12 @@
 #include <torch/csrc/autograd/functions/basic_ops.h>
 #include <torch/csrc/autograd/grad_mode.h>
 #include <torch/csrc/autograd/anomaly_mode.h>
+#include <torch/csrc/autograd/backward_timing.h>
 #include <torch/csrc/autograd/variable.h>
 #include <torch/csrc/utils/memory.h>
 
 #include <ATen/DeviceGuard.h>
+#include <ATen/core/Vitals.h>
 #include <ATen/ExpandUtils.h>
 #include <ATen/Parallel.h>
 #include <c10/util/Exception.h>
@@ -31,6 +33,7 @@
 #include <thread>
 #include <unordered_set>
 #include <typeinfo>
+#include <utility>
 #include <sstream>
 #include <queue>
 #include <TH/TH.h>
@@ -98,6 +101,15 @@ static thread_local std::shared_ptr<GraphTask> current_graph_task = nullptr;
 // see Note [Reentrant backwards] for more details.
 static thread_local std::shared_ptr<ReadyQueue> local_ready_queue = nullptr;
 
+// Wakes up the other CPU workers of graph_task once it is completed or has
+// failed. See Note [Parallel CPU backward]
+static void wake_up_cpu_workers(const std::shared_ptr<GraphTask>& graph_task) {
+  for (int i = 1; i < graph_task->num_cpu_workers_; ++i) {
+    graph_task->cpu_ready_queue_->push(
+        NodeTask(graph_task, nullptr, InputBuffer(0)));
+  }
+}
+
 // Note [Reentrant backwards]
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~
 // To understand the reentrant backwards problem, we have to notice two
@@ -128,6 +140,27 @@ static thread_local std::shared_ptr<ReadyQueue> local_ready_queue = nullptr;
 // When the GraphTask is finished, the parent worker thread that is waiting on
 // the task is notified and the current thread returns to the pool.
 
+// Note [Parallel CPU backward]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// By default the CPU nodes of a backward pass all run on the thread that
+// called backward(), even when the graph has independent branches. With
+// Engine::set_num_cpu_threads(n) and n > 1, a non-reentrant backward gets a
+// CPU ready queue of its own instead of the caller's thread local one, and
+// n - 1 threads from the reentrant thread pool join the caller in popping
+// from it. Nodes still become ready through the dependency counts in
+// GraphTask, so independent branches overlap while each node runs once its
+// inputs are complete.
+//
+// Every thread sharing the queue runs thread_main on the same graph task, so
+// whoever completes it (or records an error) pushes one empty task per other
+// worker to wake up the ones blocked in pop(). Each worker consumes at most
+// one of them before it sees the completed future and exits.
+//
+// A reentrant backward started from a node on such a worker gets another
+// private queue that only the calling thread drives, as in
+// Note [Reentrant backwards]. This keeps it from sleeping on a queue whose
+// tasks are being taken by the other workers.
+
 // Note [Streaming backwards]
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~
 // On CUDA devices the autograd engine's device operations are run on the
@@ -221,7 +254,7 @@ bool ReadyQueue::empty() const {
   return heap_.empty();
 }
 
-Engine::Engine() : max_recursion_depth_(MAX_DEPTH), non_reentrant_device_thread_count_(0) {}
+Engine::Engine() : max_recursion_depth_(MAX_DEPTH), num_cpu_threads_(1), fuse_accumulate_grad_(false), non_reentrant_device_thread_count_(0) {}
 
 // Send shutdown tasks to all device_ready_queues_ if no backward tasks are running
 // Even though readyQueue should be empty, shutdown tasks have the highest priority
@@ -372,6 +405,9 @@ auto Engine::thread_main(const std::shared_ptr<GraphTask>& graph_task) -> void {
     // The outer graph_task represents the overall graph_task we need to execute
     // for reentrant execution.
     std::shared_ptr<GraphTask> local_graph_task;
+    // Empty tasks only wake this thread up, see
+    // Note [Parallel CPU backward]
+    bool ran_node = false;
     {
       // Scope this block of execution since NodeTask is not needed after this
       // block and can be deallocated (release any references to grad tensors
@@ -390,6 +426,7 @@ auto Engine::thread_main(const std::shared_ptr<GraphTask>& graph_task) -> void {
         continue;
       }
 
+      ran_node = task.fn_ != nullptr;
       if (task.fn_ && !local_graph_task->has_error_.load()) {
         AutoGradMode grad_mode(local_graph_task->grad_mode_);
         try {
@@ -402,6 +439,7 @@ auto Engine::thread_main(const std::shared_ptr<GraphTask>& graph_task) -> void {
           evaluate_function(local_graph_task, task.fn_.get(), task.inputs_, local_graph_task->cpu_ready_queue_);
         } catch (std::exception& e) {
           thread_on_exception(local_graph_task, task.fn_, e);
+          wake_up_cpu_workers(local_graph_task);
         }
       }
     }
@@ -412,6 +450,9 @@ auto Engine::thread_main(const std::shared_ptr<GraphTask>& graph_task) -> void {
     // Check if we've completed execution.
     if (local_graph_task->completed()) {
       local_graph_task->mark_as_completed_and_run_post_processing();
+      if (ran_node) {
+        wake_up_cpu_workers(local_graph_task);
+      }
 
       auto base_owner = local_graph_task->owner_;
       // The current worker thread finish the graph_task, but the owning thread
@@ -505,6 +546,13 @@ void GraphTask::exec_post_processing() {
     throw std::runtime_error("could not compute gradients for some functions");
   }
 
+  // Gradients have to be in place before final callbacks (which may read
+  // them) run and before leaf streams are synced below.
+  // See Note [Fused gradient accumulation]
+  if (deferred_grad_accumulations_) {
+    deferred_grad_accumulations_->run();
+  }
+
   // set the thread_local current_graph_task_ as more callbacks can be installed
   // by existing final callbacks.
   GraphTaskGuard guard(shared_from_this());
@@ -739,7 +787,20 @@ void Engine::evaluate_function(
   const auto opt_parent_stream = (*func).stream(c10::DeviceType::CUDA);
   c10::OptionalStreamGuard parent_stream_guard{opt_parent_stream};
 
+  DeferGradAccumulationGuard defer_guard(
+      graph_task->deferred_grad_accumulations_.get());
+  // See BackwardTiming
+  const bool record_timing = BackwardTiming::is_enabled();
+  const auto start = record_timing ? std::chrono::steady_clock::now()
+                                   : std::chrono::steady_clock::time_point();
   auto outputs = call_function(graph_task, func, inputs);
+  if (record_timing) {
+    BackwardTiming::record(
+        *func,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count());
+  }
 
   auto& fn = *func;
   if (!graph_task->keep_graph_) {
@@ -880,6 +941,8 @@ auto Engine::execute(const edge_list& roots,
                      bool create_graph,
                      bool accumulate_grad,
                      const edge_list& outputs) -> variable_list {
+  static auto& backward_calls = at::vitals::counter("autograd.backward_calls");
+  backward_calls.add();
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
   validate_outputs(roots, const_cast<variable_list&>(inputs), [](const std::string& msg) {
     return msg;
@@ -892,11 +955,24 @@ auto Engine::execute(const edge_list& roots,
   init_local_ready_queue();
   bool not_reentrant_backward_call = worker_device == NO_DEVICE;
 
+  // A backward run by several CPU threads, or a reentrant one started from a
+  // thread that shares its queue with others, needs a CPU ready queue of its
+  // own. See Note [Parallel CPU backward]
+  const int num_cpu_workers = not_reentrant_backward_call ? num_cpu_threads() : 1;
+  const bool in_shared_cpu_queue = worker_device == CPU_DEVICE &&
+      current_graph_task && current_graph_task->num_cpu_workers_ > 1;
   auto graph_task = std::make_shared<GraphTask>(
       /* keep_graph */ keep_graph,
       /* create_graph */ create_graph,
       /* depth */ not_reentrant_backward_call ? 0 : total_depth + 1,
-      /* cpu_ready_queue */ local_ready_queue);
+      /* cpu_ready_queue */ num_cpu_workers > 1 || in_shared_cpu_queue
+          ? std::make_shared<ReadyQueue>()
+          : local_ready_queue);
+  graph_task->num_cpu_workers_ = num_cpu_workers;
+  if (accumulate_grad && !create_graph && fuse_accumulate_grad()) {
+    graph_task->deferred_grad_accumulations_ =
+        make_unique<DeferredGradAccumulations>();
+  }
 
   // If we receive a single root, skip creating extra root node
   bool skip_dummy_node = roots.size() == 1;
@@ -970,9 +1046,17 @@ std::shared_ptr<at::ivalue::Future> Engine::execute_with_graph_task(
     queue->push(NodeTask(graph_task, std::move(graph_root), std::move(input_buffer)));
 
     // The owning thread start to drive the engine execution for any CPU task that
-    // was just pushed or will be added later from other worker threads
+    // was just pushed or will be added later from other worker threads,
+    // together with the extra CPU workers if any.
+    // See Note [Parallel CPU backward]
     lock.unlock();
+    for (int i = 1; i < graph_task->num_cpu_workers_; ++i) {
+      add_thread_pool_task(graph_task);
+    }
+    auto prev_ready_queue =
+        std::exchange(local_ready_queue, graph_task->cpu_ready_queue_);
     thread_main(graph_task);
+    local_ready_queue = std::move(prev_ready_queue);
     TORCH_INTERNAL_ASSERT(graph_task->future_result_->completed());
     // reset the worker_device after the completion of the graph_task, this is so
     // that the initial state of the engine remains the same across every backward()
@@ -1003,7 +1087,10 @@ std::shared_ptr<at::ivalue::Future> Engine::execute_with_graph_task(
       // complete!
       ++current_depth;
       lock.unlock();
+      auto prev_ready_queue =
+          std::exchange(local_ready_queue, graph_task->cpu_ready_queue_);
       thread_main(graph_task);
+      local_ready_queue = std::move(prev_ready_queue);
       --current_depth;
       --total_depth;
 
@@ -1050,6 +1137,26 @@ bool Engine::is_checkpoint_valid() {
   return checkpoint_valid;
 }
 
+void Engine::set_num_cpu_threads(int num_threads) {
+  TORCH_CHECK(
+      num_threads >= 1,
+      "Expected the number of CPU threads for backward to be positive, got ",
+      num_threads);
+  num_cpu_threads_.store(num_threads);
+}
+
+int Engine::num_cpu_threads() const {
+  return num_cpu_threads_.load();
+}
+
+void Engine::set_fuse_accumulate_grad(bool enabled) {
+  fuse_accumulate_grad_.store(enabled);
+}
+
+bool Engine::fuse_accumulate_grad() const {
+  return fuse_accumulate_grad_.load();
+}
+
 void Engine::init_local_ready_queue(std::shared_ptr<ReadyQueue> ready_queue) {
   if (ready_queue) {
     // if ready_queue provided in the caller, use the caller's ready_queue to initialize local_ready_queue
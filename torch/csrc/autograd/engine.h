@@ -9,6 +9,7 @@
 #include <torch/csrc/WindowsTorchApiMacro.h>
 #include <torch/csrc/autograd/anomaly_mode.h>
 #include <torch/csrc/autograd/function.h>
+#include <torch/csrc/autograd/functions/accumulate_grad.h>
 #include <torch/csrc/autograd/functions/basic_ops.h>
 #include <torch/csrc/autograd/input_buffer.h>
 
@@ -152,6 +153,16 @@ struct GraphTask: std::enable_shared_from_this<GraphTask> {
   // and but next NodeTask should be run on CPU.
   std::shared_ptr<ReadyQueue> cpu_ready_queue_;
 
+  // Number of CPU threads, including the owner, that pop tasks from
+  // cpu_ready_queue_. Set before the graph task is queued and safe to read
+  // without synchronization afterwards. See Note [Parallel CPU backward]
+  int num_cpu_workers_ = 1;
+
+  // Set when AccumulateGrad nodes of this graph task should batch their
+  // in place accumulations, which are then run by exec_post_processing().
+  // See Note [Fused gradient accumulation]
+  std::unique_ptr<DeferredGradAccumulations> deferred_grad_accumulations_;
+
   // Future representing the completion of the graph task. Notified when all
   // tasks are done.
   std::shared_ptr<at::ivalue::Future> future_result_;
@@ -319,6 +330,18 @@ struct TORCH_API Engine {
 
   bool is_checkpoint_valid();
 
+  // Number of CPU threads, including the calling thread, that run the CPU
+  // nodes of a backward pass. With the default of 1 all CPU work runs on the
+  // thread that called backward(). See Note [Parallel CPU backward]
+  void set_num_cpu_threads(int num_threads);
+  int num_cpu_threads() const;
+
+  // Whether AccumulateGrad nodes of the backward passes started from now on
+  // add their gradients in batches at the end of the pass instead of one by
+  // one. Off by default. See Note [Fused gradient accumulation]
+  void set_fuse_accumulate_grad(bool enabled);
+  bool fuse_accumulate_grad() const;
+
   size_t ready_queue_size(const std::shared_ptr<GraphTask>& graph_task, at::Device device);
 
   // Should be called after fork to notify that worker threads are gone
@@ -366,6 +389,12 @@ struct TORCH_API Engine {
   // How many nested reentrant calls are allowed until a new thread is used
   int max_recursion_depth_;
 
+  // See set_num_cpu_threads()
+  std::atomic<int> num_cpu_threads_;
+
+  // See set_fuse_accumulate_grad()
+  std::atomic<bool> fuse_accumulate_grad_;
+
   struct ThreadPoolShared {
     // Data structures used by the threads for executing reentrant backwards
     // tasks. See Note [Reentrant backwards]
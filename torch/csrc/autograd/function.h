@@ -6,6 +6,7 @@
 #include <torch/csrc/autograd/profiler.h>
 #include <torch/csrc/autograd/saved_variable.h>
 #include <torch/csrc/autograd/input_metadata.h>
+#include <torch/csrc/autograd/node_pool.h>
 #include <torch/csrc/autograd/variable.h>
 #include <torch/csrc/utils/python_stub.h>
 #include <torch/csrc/utils/variadic.h>
@@ -137,6 +138,16 @@ struct TORCH_API Node : std::enable_shared_from_this<Node> {
   Node& operator=(Node&& other) = delete;
   virtual ~Node() = default;
 
+  /// Nodes are allocated from a pool, see NOTE [ Node Pool ]. The sized
+  /// delete gets the size of the most derived type through the virtual
+  /// destructor.
+  static void* operator new(size_t size) {
+    return node_pool::allocate(size);
+  }
+  static void operator delete(void* ptr, size_t size) noexcept {
+    node_pool::deallocate(ptr, size);
+  }
+
   /// Evaluates the function on the given inputs and returns the result of the
   /// function call.
   variable_list operator()(variable_list&& inputs) {
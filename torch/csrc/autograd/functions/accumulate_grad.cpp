@@ -6,6 +6,11 @@
 #include <torch/csrc/autograd/functions/tensor.h>
 #include <torch/csrc/autograd/functions/utils.h>
 
+#include <ATen/ATen.h>
+#include <c10/core/StreamGuard.h>
+#include <c10/core/impl/VirtualGuardImpl.h>
+
+#include <algorithm>
 #include <cstdint>
 #include <stdexcept>
 #include <utility>
@@ -14,6 +19,26 @@ using at::Tensor;
 
 namespace torch { namespace autograd {
 
+namespace {
+
+// See DeferGradAccumulationGuard
+thread_local DeferredGradAccumulations* deferred_accumulations = nullptr;
+
+// Whether accumulateGrad would end up in its plain `variable_grad += new_grad`
+// case, which is the only one that can be postponed and fused.
+bool can_fuse_accumulation(const Tensor& variable_grad, const Tensor& new_grad) {
+  return variable_grad.defined() &&
+      variable_grad.layout() == c10::kStrided &&
+      new_grad.layout() == c10::kStrided &&
+      (variable_grad.device().is_cpu() || variable_grad.is_cuda()) &&
+      variable_grad.device() == new_grad.device() &&
+      variable_grad.scalar_type() == new_grad.scalar_type() &&
+      variable_grad.sizes().equals(new_grad.sizes()) &&
+      at::inplaceIsVmapCompatible(variable_grad, new_grad);
+}
+
+} // namespace
+
 // AccumulateGrad sets sequence_nr to the max value so it's always called
 // ASAP during backwards.
 AccumulateGrad::AccumulateGrad(Variable variable_)
@@ -45,6 +70,15 @@ auto AccumulateGrad::apply(variable_list&& grads) -> variable_list {
 
   at::Tensor& grad = variable.mutable_grad();
 
+  // See Note [Fused gradient accumulation]
+  if (deferred_accumulations && !GradMode::is_enabled() &&
+      post_hooks().empty() && can_fuse_accumulation(grad, new_grad)) {
+    deferred_accumulations->add(
+        std::static_pointer_cast<AccumulateGrad>(shared_from_this()),
+        std::move(new_grad));
+    return variable_list();
+  }
+
   // If the function has post hooks (for example, a DDP allreduce hook),
   // call_function in Engine.cpp will temporarily bump the expected refcount
   // by one, hence the addition of !post_hooks().empty() for 'num_expected_refs'
@@ -60,4 +94,92 @@ auto AccumulateGrad::apply(variable_list&& grads) -> variable_list {
 
   return variable_list();
 }
+
+void DeferredGradAccumulations::add(
+    std::shared_ptr<AccumulateGrad> fn,
+    Tensor new_grad) {
+  const auto device = new_grad.device();
+  const auto stream =
+      c10::impl::VirtualGuardImpl(device.type()).getStream(device);
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.push_back(Entry{std::move(fn), std::move(new_grad), stream});
+}
+
+void DeferredGradAccumulations::run() {
+  std::vector<Entry> entries;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries.swap(entries_);
+  }
+  if (entries.empty()) {
+    return;
+  }
+
+  // Lock the nodes in address order, so that two graph tasks running their
+  // lists at the same time can't wait on each other in opposite orders.
+  std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+    return a.fn.get() < b.fn.get();
+  });
+  std::vector<std::unique_lock<std::mutex>> locks;
+  locks.reserve(entries.size());
+
+  struct Group {
+    c10::Stream stream;
+    at::ScalarType dtype;
+    std::vector<Tensor> grads;
+    std::vector<Tensor> new_grads;
+  };
+  std::vector<Group> groups;
+
+  at::NoGradGuard no_grad;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    auto& entry = entries[i];
+    auto& variable = entry.fn->variable;
+    const bool repeated = i > 0 && entry.fn == entries[i - 1].fn;
+    if (!repeated) {
+      locks.emplace_back(entry.fn->mutex_);
+    }
+    if (!variable.requires_grad()) {
+      continue;
+    }
+    at::Tensor& grad = variable.mutable_grad();
+    if (!repeated && can_fuse_accumulation(grad, entry.new_grad)) {
+      const auto dtype = grad.scalar_type();
+      auto it = std::find_if(groups.begin(), groups.end(), [&](const Group& g) {
+        return g.stream == entry.stream && g.dtype == dtype;
+      });
+      if (it == groups.end()) {
+        groups.push_back(Group{entry.stream, dtype, {}, {}});
+        it = groups.end() - 1;
+      }
+      it->grads.push_back(grad);
+      it->new_grads.push_back(std::move(entry.new_grad));
+    } else {
+      // The grad was replaced since the accumulation was postponed.
+      c10::StreamGuard stream_guard(entry.stream);
+      AccumulateGrad::accumulateGrad(
+          variable,
+          grad,
+          entry.new_grad,
+          1 /* num_expected_refs */,
+          [&grad](at::Tensor&& grad_update) { grad = std::move(grad_update); });
+    }
+  }
+
+  for (auto& group : groups) {
+    c10::StreamGuard stream_guard(group.stream);
+    at::_foreach_add_(group.grads, group.new_grads);
+  }
+}
+
+DeferGradAccumulationGuard::DeferGradAccumulationGuard(
+    DeferredGradAccumulations* accumulations)
+    : prev_(deferred_accumulations) {
+  deferred_accumulations = accumulations;
+}
+
+DeferGradAccumulationGuard::~DeferGradAccumulationGuard() {
+  deferred_accumulations = prev_;
+}
+
 }} // namespace torch::autograd
@@ -5,8 +5,11 @@
 #include <torch/csrc/autograd/utils/grad_layout_contract.h>
 #include <torch/csrc/WindowsTorchApiMacro.h>
 #include <ATen/BatchedTensorImpl.h>
+#include <c10/core/Stream.h>
 
+#include <memory>
 #include <mutex>
+#include <vector>
 
 namespace torch { namespace autograd {
 
@@ -22,6 +25,21 @@ namespace torch { namespace autograd {
     } \
   }
 
+// Note [Fused gradient accumulation]
+// At the end of a backward pass every parameter gets its own
+// `variable_grad += new_grad`, which for models with thousands of small
+// parameters is dominated by per kernel overhead. When the engine is asked to
+// (Engine::set_fuse_accumulate_grad), a graph task owns a
+// DeferredGradAccumulations and AccumulateGrad nodes running for it don't do
+// the plain in place addition themselves: they append new_grad to that list
+// and return. The engine runs the list right before the final callbacks of
+// the graph task, with one _foreach_add_ per (stream, dtype). Anything else
+// (a missing, sparse or mismatched grad, double backward, post hooks) still
+// goes through accumulateGrad() immediately. Since other graph tasks may have
+// replaced `.grad` in between, the conditions are checked again, under the
+// node's lock, when the list is run.
+struct DeferredGradAccumulations;
+
 struct TORCH_API AccumulateGrad : public Node {
   explicit AccumulateGrad(Variable variable_);
 
@@ -227,6 +245,38 @@ struct TORCH_API AccumulateGrad : public Node {
   }
 
   Variable variable;
+
+ private:
+  friend struct DeferredGradAccumulations;
+};
+
+// Gradient accumulations postponed by AccumulateGrad nodes of one graph task.
+// See Note [Fused gradient accumulation]
+struct TORCH_API DeferredGradAccumulations {
+  void add(std::shared_ptr<AccumulateGrad> fn, at::Tensor new_grad);
+  // Runs and clears every accumulation added so far.
+  void run();
+
+ private:
+  struct Entry {
+    std::shared_ptr<AccumulateGrad> fn;
+    at::Tensor new_grad;
+    // The stream AccumulateGrad would have run the addition on.
+    c10::Stream stream;
+  };
+  std::mutex mutex_;
+  std::vector<Entry> entries_;
+};
+
+// AccumulateGrad nodes run on this thread while the guard is alive postpone
+// their accumulations into `accumulations` (nothing is postponed if it is
+// null).
+struct TORCH_API DeferGradAccumulationGuard {
+  explicit DeferGradAccumulationGuard(DeferredGradAccumulations* accumulations);
+  ~DeferGradAccumulationGuard();
+
+ private:
+  DeferredGradAccumulations* prev_;
 };
 
 #undef CHECK_RESULT
@@ -1,17 +1,23 @@
 #include <torch/csrc/python_headers.h>
 
 #include <c10/core/DeviceType.h>
+#include <c10/core/InferenceMode.h>
 #include <torch/csrc/Exceptions.h>
 #include <torch/csrc/utils/pybind.h>
 #include <torch/csrc/autograd/autograd.h>
+#include <torch/csrc/autograd/backward_timing.h>
+#include <torch/csrc/autograd/engine.h>
 #include <torch/csrc/autograd/grad_mode.h>
 #include <ATen/autocast_mode.h>
 #include <torch/csrc/autograd/profiler.h>
 #include <torch/csrc/autograd/python_function.h>
+#include <torch/csrc/autograd/python_saved_variable_hooks.h>
 #include <torch/csrc/autograd/function.h>
 #include <torch/csrc/autograd/utils/wrap_outputs.h>
 #include <torch/csrc/autograd/utils/python_arg_parsing.h>
 #include <torch/csrc/utils/pycfunction_helpers.h>
+#include <torch/csrc/Dtype.h>
+#include <torch/csrc/DynamicTypes.h>
 
 PyObject* THPAutograd_initExtension(PyObject* _unused, PyObject *unused) {
   using namespace torch::autograd::profiler;
@@ -60,7 +66,8 @@ PyObject* THPAutograd_initExtension(PyObject* _unused, PyObject *unused) {
       .value("CUDA", ActivityType::CUDA);
 
   py::class_<ProfilerConfig>(m, "ProfilerConfig")
-      .def(py::init<ProfilerState, bool, bool, bool, bool>());
+      .def(py::init<ProfilerState, bool, bool, bool, bool>())
+      .def(py::init<ProfilerState, bool, bool, bool, bool, double>());
 
   py::class_<LegacyEvent>(m, "ProfilerEvent")
       .def("kind", &LegacyEvent::kindStr)
@@ -74,6 +81,7 @@ PyObject* THPAutograd_initExtension(PyObject* _unused, PyObject *unused) {
       .def("shapes", &LegacyEvent::shapes)
       .def("cpu_memory_usage", &LegacyEvent::cpuMemoryUsage)
       .def("cuda_memory_usage", &LegacyEvent::cudaMemoryUsage)
+      .def("memory_addr", &LegacyEvent::memoryAddr)
       .def("handle", &LegacyEvent::handle)
       .def("node_id", &LegacyEvent::nodeId)
       .def("is_remote", &LegacyEvent::isRemote)
@@ -203,6 +211,57 @@ PyObject* THPAutograd_initExtension(PyObject* _unused, PyObject *unused) {
   m.def("_clear_callbacks", []() {
     at::clearCallbacks();
   });
+  m.def("_set_backward_cpu_threads", [](int num_threads) {
+    torch::autograd::Engine::get_default_engine().set_num_cpu_threads(num_threads);
+  });
+  m.def("_get_backward_cpu_threads", []() {
+    return torch::autograd::Engine::get_default_engine().num_cpu_threads();
+  });
+  m.def("_set_fuse_accumulate_grad", [](bool enabled) {
+    torch::autograd::Engine::get_default_engine().set_fuse_accumulate_grad(enabled);
+  });
+  m.def("_get_fuse_accumulate_grad", []() {
+    return torch::autograd::Engine::get_default_engine().fuse_accumulate_grad();
+  });
+  m.def("_set_backward_timing_enabled", [](bool enabled) {
+    torch::autograd::BackwardTiming::set_enabled(enabled);
+  });
+  m.def("_is_backward_timing_enabled", []() {
+    return torch::autograd::BackwardTiming::is_enabled();
+  });
+  m.def("_backward_timing_summary", []() {
+    std::vector<std::tuple<std::string, uint64_t, uint64_t, uint64_t>> result;
+    for (auto& stats : torch::autograd::BackwardTiming::summary()) {
+      result.emplace_back(std::move(stats.name), stats.count, stats.total_ns, stats.max_ns);
+    }
+    return result;
+  });
+  m.def("_backward_timing_events", []() {
+    std::vector<std::tuple<std::string, uint64_t, uint64_t>> result;
+    for (auto& event : torch::autograd::BackwardTiming::recent_events()) {
+      result.emplace_back(std::move(event.name), event.sequence_nr, event.duration_ns);
+    }
+    return result;
+  });
+  m.def("_backward_timing_dropped", []() {
+    return torch::autograd::BackwardTiming::dropped();
+  });
+  m.def("_reset_backward_timing", []() {
+    torch::autograd::BackwardTiming::reset();
+  });
+  m.def("_push_saved_tensors_default_hooks", [](py::function& pack_hook, py::function& unpack_hook) {
+    torch::autograd::push_default_saved_variable_hooks(pack_hook, unpack_hook);
+  });
+  m.def("_pop_saved_tensors_default_hooks", []() {
+    torch::autograd::pop_default_saved_variable_hooks();
+  });
+
+  // The guard lives as long as the Python object, see torch.inference_mode
+  py::class_<c10::InferenceMode>(_C_m, "_InferenceMode")
+      .def(py::init<bool>());
+  _C_m.def("is_inference_mode_enabled", []() {
+    return c10::InferenceMode::is_enabled();
+  });
 
   Py_RETURN_TRUE;
 }
@@ -229,6 +288,47 @@ static PyObject * is_autocast_enabled(PyObject* _unused, PyObject *arg) {
   END_HANDLE_TH_ERRORS
 }
 
+static PyObject * set_autocast_cpu_enabled(PyObject* _unused, PyObject *arg) {
+  HANDLE_TH_ERRORS
+  if (!PyBool_Check(arg)) {
+    throw TypeError("enabled must be a bool (got %s)", Py_TYPE(arg)->tp_name);
+  }
+  at::autocast::set_cpu_enabled(arg == Py_True);
+  Py_RETURN_NONE;
+  END_HANDLE_TH_ERRORS
+}
+
+static PyObject * is_autocast_cpu_enabled(PyObject* _unused, PyObject *arg) {
+  HANDLE_TH_ERRORS
+  if (at::autocast::is_cpu_enabled()) {
+    Py_RETURN_TRUE;
+  } else {
+    Py_RETURN_FALSE;
+  }
+  END_HANDLE_TH_ERRORS
+}
+
+static PyObject * set_autocast_cpu_dtype(PyObject* _unused, PyObject *arg) {
+  HANDLE_TH_ERRORS
+  if (!THPDtype_Check(arg)) {
+    throw TypeError(
+        "dtype must be a torch.dtype (got %s)", Py_TYPE(arg)->tp_name);
+  }
+  at::ScalarType targetType = reinterpret_cast<THPDtype*>(arg)->scalar_type;
+  at::autocast::set_autocast_cpu_dtype(targetType);
+  Py_RETURN_NONE;
+  END_HANDLE_TH_ERRORS
+}
+
+static PyObject * get_autocast_cpu_dtype(PyObject* _unused, PyObject *arg) {
+  HANDLE_TH_ERRORS
+  at::ScalarType current_dtype = at::autocast::get_autocast_cpu_dtype();
+  auto dtype = (PyObject*)torch::getTHPDtype(current_dtype);
+  Py_INCREF(dtype);
+  return dtype;
+  END_HANDLE_TH_ERRORS
+}
+
 static PyObject * clear_autocast_cache(PyObject* _unused, PyObject *arg) {
   HANDLE_TH_ERRORS
   at::autocast::clear_cache();
@@ -338,6 +438,10 @@ static PyMethodDef methods[] = { // NOLINT
   {"_is_forward_AD_enabled", is_forward_AD_enabled, METH_NOARGS, nullptr},
   {"set_autocast_enabled", set_autocast_enabled, METH_O, nullptr},
   {"is_autocast_enabled", is_autocast_enabled, METH_NOARGS, nullptr},
+  {"set_autocast_cpu_enabled", set_autocast_cpu_enabled, METH_O, nullptr},
+  {"is_autocast_cpu_enabled", is_autocast_cpu_enabled, METH_NOARGS, nullptr},
+  {"set_autocast_cpu_dtype", set_autocast_cpu_dtype, METH_O, nullptr},
+  {"get_autocast_cpu_dtype", get_autocast_cpu_dtype, METH_NOARGS, nullptr},
   {"clear_autocast_cache", clear_autocast_cache, METH_NOARGS, nullptr},
   {"autocast_increment_nesting", autocast_increment_nesting, METH_NOARGS, nullptr},
   {"autocast_decrement_nesting", autocast_decrement_nesting, METH_NOARGS, nullptr},
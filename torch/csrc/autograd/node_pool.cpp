@@ -0,0 +1,193 @@
+#include <torch/csrc/autograd/node_pool.h>
+
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace torch { namespace autograd { namespace node_pool {
+
+namespace {
+
+// Size classes are multiples of kAlignment up to kMaxSize bytes
+constexpr size_t kAlignment = 16;
+constexpr size_t kMaxSize = 1024;
+constexpr size_t kNumClasses = kMaxSize / kAlignment;
+// Number of blocks moved between a thread and the depot at once
+constexpr size_t kBatchSize = 64;
+// A thread keeps at most this many free blocks per size class
+constexpr size_t kMaxCached = 2 * kBatchSize;
+// The depot keeps at most this many batches per size class
+constexpr size_t kMaxDepotBatches = 256;
+
+bool pool_enabled() {
+  static const bool enabled = [] {
+    const char* env = std::getenv("PYTORCH_NO_AUTOGRAD_NODE_POOL");
+    return env == nullptr || std::strcmp(env, "0") == 0;
+  }();
+  return enabled;
+}
+
+inline size_t size_class(size_t size) {
+  return (size + kAlignment - 1) / kAlignment - 1;
+}
+
+inline size_t class_size(size_t cls) {
+  return (cls + 1) * kAlignment;
+}
+
+using Batch = std::vector<void*>;
+
+struct Depot {
+  std::mutex mutex;
+  std::array<std::vector<Batch>, kNumClasses> batches;
+
+  // Returns false if the depot is full and the batch must be freed
+  bool put(size_t cls, Batch&& batch) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (batches[cls].size() >= kMaxDepotBatches) {
+      return false;
+    }
+    batches[cls].push_back(std::move(batch));
+    return true;
+  }
+
+  bool take(size_t cls, Batch& out) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (batches[cls].empty()) {
+      return false;
+    }
+    out = std::move(batches[cls].back());
+    batches[cls].pop_back();
+    return true;
+  }
+};
+
+// Leaked, so that threads exiting after static destruction can still return
+// their blocks
+Depot& depot() {
+  static Depot* depot = new Depot();
+  return *depot;
+}
+
+void free_batch(Batch& batch) {
+  for (void* ptr : batch) {
+    ::operator delete(ptr);
+  }
+  batch.clear();
+}
+
+// Set when the cache of the thread is destroyed at thread exit. Nodes freed
+// by the thread_local destructors that run after it bypass the pool.
+thread_local bool thread_cache_destroyed = false;
+
+struct ThreadCache {
+  std::array<Batch, kNumClasses> free;
+
+  ~ThreadCache() {
+    thread_cache_destroyed = true;
+    for (size_t cls = 0; cls < kNumClasses; ++cls) {
+      try {
+        if (!free[cls].empty() && depot().put(cls, std::move(free[cls]))) {
+          continue;
+        }
+      } catch (const std::bad_alloc&) {
+      }
+      free_batch(free[cls]);
+    }
+  }
+
+  void* allocate(size_t cls) {
+    auto& blocks = free[cls];
+    if (blocks.empty() && !depot().take(cls, blocks)) {
+      return ::operator new(class_size(cls));
+    }
+    void* ptr = blocks.back();
+    blocks.pop_back();
+    return ptr;
+  }
+
+  void deallocate(void* ptr, size_t cls) {
+    auto& blocks = free[cls];
+    if (blocks.size() == kMaxCached) {
+      flush(cls);
+    }
+    // Only the first push allocates, before ptr is owned by the cache
+    if (blocks.capacity() < kMaxCached) {
+      blocks.reserve(kMaxCached);
+    }
+    blocks.push_back(ptr);
+  }
+
+  // Moves the last kBatchSize blocks to the depot, or frees them if it is full
+  void flush(size_t cls) noexcept {
+    auto& blocks = free[cls];
+    const auto first = blocks.end() - kBatchSize;
+    try {
+      if (depot().put(cls, Batch(first, blocks.end()))) {
+        blocks.erase(first, blocks.end());
+        return;
+      }
+    } catch (const std::bad_alloc&) {
+    }
+    for (auto it = first; it != blocks.end(); ++it) {
+      ::operator delete(*it);
+    }
+    blocks.erase(first, blocks.end());
+  }
+};
+
+ThreadCache* thread_cache() {
+  if (thread_cache_destroyed) {
+    return nullptr;
+  }
+  static thread_local ThreadCache cache;
+  return &cache;
+}
+
+} // namespace
+
+void* allocate(size_t size) {
+  ThreadCache* cache = nullptr;
+  if (size <= kMaxSize && pool_enabled()) {
+    cache = thread_cache();
+  }
+  if (cache == nullptr) {
+    return ::operator new(size);
+  }
+  return cache->allocate(size_class(size));
+}
+
+void deallocate(void* ptr, size_t size) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+  ThreadCache* cache = nullptr;
+  if (size <= kMaxSize && pool_enabled()) {
+    cache = thread_cache();
+  }
+  if (cache == nullptr) {
+    ::operator delete(ptr);
+    return;
+  }
+  try {
+    cache->deallocate(ptr, size_class(size));
+  } catch (const std::bad_alloc&) {
+    ::operator delete(ptr);
+  }
+}
+
+size_t cached_blocks() {
+  auto cache = thread_cache();
+  size_t count = 0;
+  if (cache != nullptr) {
+    for (const auto& blocks : cache->free) {
+      count += blocks.size();
+    }
+  }
+  return count;
+}
+
+}}} // namespace torch::autograd::node_pool
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+#include <cstddef>
+
+namespace torch { namespace autograd {
+
+// NOTE [ Node Pool ]
+// ~~~~~~~~~~~~~~~~~~
+// Every differentiable op run with grad enabled allocates a Node (and the
+// control block of the shared_ptr that owns it), and every backward frees
+// them again. For graphs of many small ops this malloc/free traffic is a
+// large part of the cost of recording the graph, so Nodes are allocated from
+// a pool of free blocks, kept per thread and per size class.
+//
+// Nodes are often freed on another thread than the one that created them
+// (e.g. by the autograd engine's device threads), so a thread that holds too
+// many free blocks hands them in batches to a global depot, from which the
+// threads that run out take them back. Blocks larger than the biggest size
+// class go straight to the global allocator.
+//
+// Set PYTORCH_NO_AUTOGRAD_NODE_POOL=1 to allocate every Node with the global
+// allocator, e.g. when looking for memory errors with ASAN or valgrind.
+namespace node_pool {
+
+TORCH_API void* allocate(size_t size);
+TORCH_API void deallocate(void* ptr, size_t size) noexcept;
+
+// Number of free blocks cached by the calling thread, for tests
+TORCH_API size_t cached_blocks();
+
+} // namespace node_pool
+
+// Allocator for the control blocks of the shared_ptrs that own Nodes, e.g.
+//   std::shared_ptr<T>(new T(...), deleteNode, NodePoolAllocator<T>())
+template <class T>
+struct NodePoolAllocator {
+  using value_type = T;
+
+  NodePoolAllocator() = default;
+  template <class U>
+  NodePoolAllocator(const NodePoolAllocator<U>&) noexcept {}
+
+  T* allocate(size_t n) {
+    return static_cast<T*>(node_pool::allocate(n * sizeof(T)));
+  }
+  void deallocate(T* ptr, size_t n) noexcept {
+    node_pool::deallocate(ptr, n * sizeof(T));
+  }
+
+  template <class U>
+  bool operator==(const NodePoolAllocator<U>&) const noexcept {
+    return true;
+  }
+  template <class U>
+  bool operator!=(const NodePoolAllocator<U>&) const noexcept {
+    return false;
+  }
+};
+
+}} // namespace torch::autograd
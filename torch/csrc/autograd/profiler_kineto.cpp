@@ -96,7 +96,7 @@ struct TORCH_API KinetoThreadLocalState : public ProfilerThreadLocalState {
 
   // TODO: use kineto
   void reportMemoryUsage(
-      void* /* unused */,
+      void* ptr,
       int64_t alloc_size,
       c10::Device device) override {
     if (config_.profile_memory && config_.state != ProfilerState::Disabled) {
@@ -108,6 +108,7 @@ struct TORCH_API KinetoThreadLocalState : public ProfilerThreadLocalState {
           config_.state == ProfilerState::CUDA);
       evt.setCpuUs(getTimeUs()); // upd. time using Kineto's clock
       evt.updateMemoryStats(alloc_size, device);
+      evt.setMemoryAddr(reinterpret_cast<uint64_t>(ptr));
       getEventList(thread_id).record(std::move(evt));
     }
   }
@@ -207,7 +208,8 @@ void pushProfilingCallbacks() {
         libkineto::api().activityProfiler().popCorrelationId();
       })
     .needsInputs(state_ptr->config().report_input_shapes)
-    .needsIds(true));
+    .needsIds(true)
+    .samplingProb(state_ptr->config().sampling_prob));
   state_ptr->setCallbackHandle(handle);
 }
 
@@ -270,7 +270,7 @@ void ProfilerThreadLocalState::popRange(const at::RecordFunction& fn, const bool
 }
 
 void ProfilerThreadLocalState::reportMemoryUsage(
-    void* /* unused */,
+    void* ptr,
     int64_t alloc_size,
     c10::Device device) {
   if (config_.profile_memory && config_.state != ProfilerState::Disabled) {
@@ -281,6 +281,7 @@ void ProfilerThreadLocalState::reportMemoryUsage(
         thread_id,
         config_.state == ProfilerState::CUDA);
     evt.updateMemoryStats(alloc_size, device);
+    evt.setMemoryAddr(reinterpret_cast<uint64_t>(ptr));
     getEventList(thread_id).record(std::move(evt));
   }
 }
@@ -226,6 +226,16 @@ struct TORCH_API LegacyEvent {
     return cuda_memory_usage_;
   }
 
+  // Address of the allocated or freed block of a memory event, used to match
+  // deallocations with allocations
+  uint64_t memoryAddr() const {
+    return memory_addr_;
+  }
+
+  void setMemoryAddr(uint64_t memory_addr) {
+    memory_addr_ = memory_addr;
+  }
+
   at::RecordFunctionHandle handle() const {
     return handle_;
   }
@@ -319,6 +329,7 @@ struct TORCH_API LegacyEvent {
   std::vector<std::vector<int64_t>> shapes_;
   int64_t cpu_memory_usage_ = 0;
   int64_t cuda_memory_usage_ = 0;
+  uint64_t memory_addr_ = 0;
   int device_ = -1;
   CUDAEventStub cuda_event = nullptr;
   int node_id_ = 0;
@@ -388,18 +399,24 @@ struct TORCH_API ProfilerConfig {
       bool report_input_shapes = false,
       bool profile_memory = false,
       bool with_stack = false,
-      bool with_flops = false)
+      bool with_flops = false,
+      double sampling_prob = 1.0)
       : state(state),
         report_input_shapes(report_input_shapes),
         profile_memory(profile_memory),
         with_stack(with_stack),
-        with_flops(with_flops) {}
+        with_flops(with_flops),
+        sampling_prob(sampling_prob) {}
   ~ProfilerConfig() = default;
   ProfilerState state;
   bool report_input_shapes;
   bool profile_memory;
   bool with_stack;
   bool with_flops;
+  // Probability to record any given CPU op, uses RecordFunction's sampling so
+  // that ops that are not sampled don't run the profiler callbacks at all.
+  // Only used by the Kineto profiler
+  double sampling_prob;
 
   // Returns IValues corresponding to ProfilerConfig struct, to be used for
   // serialization.
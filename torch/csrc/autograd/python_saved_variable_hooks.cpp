@@ -0,0 +1,84 @@
+#include <torch/csrc/autograd/python_saved_variable_hooks.h>
+
+#include <torch/csrc/Exceptions.h>
+#include <torch/csrc/autograd/python_variable.h>
+#include <torch/csrc/utils/object_ptr.h>
+
+#include <utility>
+#include <vector>
+
+namespace torch { namespace autograd {
+
+namespace {
+
+// The Python callables behind the factories pushed on this thread, so that
+// popping them can drop the references taken when they were pushed.
+thread_local std::vector<std::pair<PyObject*, PyObject*>> py_hooks_stack;
+
+} // namespace
+
+PySavedVariableHooks::PySavedVariableHooks(PyObject* pack_hook, PyObject* unpack_hook)
+  : pack_hook_(pack_hook), unpack_hook_(unpack_hook)
+{
+  // Variables are saved from inside operators, which may run without the GIL.
+  pybind11::gil_scoped_acquire gil;
+  Py_INCREF(pack_hook_);
+  Py_INCREF(unpack_hook_);
+}
+
+PySavedVariableHooks::~PySavedVariableHooks() {
+  // The graph may be freed after the interpreter is gone.
+  if (Py_IsInitialized()) {
+    pybind11::gil_scoped_acquire gil;
+    Py_XDECREF(data_);
+    Py_DECREF(pack_hook_);
+    Py_DECREF(unpack_hook_);
+  }
+}
+
+void PySavedVariableHooks::call_pack_hook(const at::Tensor& tensor) {
+  pybind11::gil_scoped_acquire gil;
+  THPObjectPtr obj(THPVariable_Wrap(tensor));
+  if (!obj) throw python_error();
+  PyObject* packed = PyObject_CallFunctionObjArgs(pack_hook_, obj.get(), nullptr);
+  if (!packed) throw python_error();
+  Py_XDECREF(data_);
+  data_ = packed;
+}
+
+at::Tensor PySavedVariableHooks::call_unpack_hook() {
+  pybind11::gil_scoped_acquire gil;
+  TORCH_INTERNAL_ASSERT(data_, "unpack hook called before the pack hook");
+  THPObjectPtr res(PyObject_CallFunctionObjArgs(unpack_hook_, data_, nullptr));
+  if (!res) throw python_error();
+  if (!THPVariable_Check(res.get())) {
+    throw TypeError(
+        "Output of saved tensor unpack_hook expected to be a Tensor but got "
+        "result of type %s", Py_TYPE(res.get())->tp_name);
+  }
+  return THPVariable_Unpack(res.get());
+}
+
+void push_default_saved_variable_hooks(py::function& pack_hook, py::function& unpack_hook) {
+  PyObject* pack = pack_hook.ptr();
+  PyObject* unpack = unpack_hook.ptr();
+  Py_INCREF(pack);
+  Py_INCREF(unpack);
+  py_hooks_stack.emplace_back(pack, unpack);
+  impl::push_default_saved_variable_hooks([pack, unpack]() {
+    return std::unique_ptr<SavedVariableHooks>(
+        new PySavedVariableHooks(pack, unpack));
+  });
+}
+
+void pop_default_saved_variable_hooks() {
+  TORCH_CHECK(
+      !py_hooks_stack.empty(),
+      "No saved tensors hooks were registered on this thread");
+  impl::pop_default_saved_variable_hooks();
+  Py_DECREF(py_hooks_stack.back().first);
+  Py_DECREF(py_hooks_stack.back().second);
+  py_hooks_stack.pop_back();
+}
+
+}} // namespace torch::autograd
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <torch/csrc/python_headers.h>
+#include <torch/csrc/autograd/saved_variable_hooks.h>
+#include <torch/csrc/utils/pybind.h>
+
+namespace torch { namespace autograd {
+
+// Runs a pair of Python callables as the hooks of a SavedVariable. The object
+// returned by the pack hook is kept alive until the SavedVariable is released
+// and is passed to the unpack hook every time the variable is unpacked.
+struct PySavedVariableHooks : public SavedVariableHooks {
+  PySavedVariableHooks(PyObject* pack_hook, PyObject* unpack_hook);
+  ~PySavedVariableHooks() override;
+  void call_pack_hook(const at::Tensor& tensor) override;
+  at::Tensor call_unpack_hook() override;
+
+ private:
+  PyObject* pack_hook_;
+  PyObject* unpack_hook_;
+  PyObject* data_ = nullptr;
+};
+
+// Backs torch.autograd.graph.saved_tensors_hooks.
+void push_default_saved_variable_hooks(py::function& pack_hook, py::function& unpack_hook);
+void pop_default_saved_variable_hooks();
+
+}} // namespace torch::autograd
@@ -610,6 +610,17 @@ PyObject *THPVariable_is_mkldnn(THPVariable *self, void *unused)
   END_HANDLE_TH_ERRORS
 }
 
+PyObject *THPVariable_is_nested(THPVariable *self, void *unused)
+{
+  HANDLE_TH_ERRORS
+  if (check_has_torch_function((PyObject *)self)) {
+    return handle_torch_function_getter(self, "is_nested");
+  }
+  auto& self_ = self->cdata;
+  return torch::autograd::utils::wrap(self_.is_nested());
+  END_HANDLE_TH_ERRORS
+}
+
 PyObject *THPVariable_is_mlc(THPVariable *self, void *unused)
 {
   HANDLE_TH_ERRORS
@@ -762,6 +773,7 @@ static struct PyGetSetDef THPVariable_properties[] = {
   {"is_xpu", (getter)THPVariable_is_xpu, nullptr, nullptr, nullptr},
   {"is_sparse", (getter)THPVariable_is_sparse, nullptr, nullptr, nullptr},
   {"is_mkldnn", (getter)THPVariable_is_mkldnn, nullptr, nullptr, nullptr},
+  {"is_nested", (getter)THPVariable_is_nested, nullptr, nullptr, nullptr},
   {"is_mlc", (getter)THPVariable_is_mlc, nullptr, nullptr, nullptr},
   {"is_vulkan", (getter)THPVariable_is_vulkan, nullptr, nullptr, nullptr},
   {"is_complex", (getter)THPVariable_is_complex, nullptr, nullptr, nullptr},
@@ -783,6 +795,114 @@ static PyMappingMethods THPVariable_as_mapping = {
   THPVariable_setitem,
 };
 
+namespace {
+
+// Shape and strides of a Py_buffer exported by a tensor, in the units Python
+// expects, owned by Py_buffer::internal
+struct TensorBufferInfo {
+  std::vector<Py_ssize_t> shape;
+  std::vector<Py_ssize_t> strides;
+};
+
+// struct module format of the elements of a buffer
+const char* buffer_format(ScalarType scalar_type) {
+  switch (scalar_type) {
+    case kDouble: return "d";
+    case kFloat: return "f";
+    case kHalf: return "e";
+    case kComplexDouble: return "Zd";
+    case kComplexFloat: return "Zf";
+    case kLong: return "q";
+    case kInt: return "i";
+    case kShort: return "h";
+    case kChar: return "b";
+    case kByte: return "B";
+    case kBool: return "?";
+    default: return nullptr;
+  }
+}
+
+} // namespace
+
+// Buffer protocol, so that memoryview, NumPy, Arrow, sockets, etc. can use
+// the memory of CPU tensors directly. Like numpy(), this keeps the tensor
+// alive but disables resizing its storage.
+static int THPVariable_getbuffer(PyObject* self, Py_buffer* view, int flags) {
+  HANDLE_TH_ERRORS
+  view->obj = nullptr;
+  const auto& tensor = reinterpret_cast<THPVariable*>(self)->cdata;
+  auto fail = [](const std::string& msg) {
+    PyErr_SetString(PyExc_BufferError, msg.c_str());
+    return -1;
+  };
+  if (tensor.device().type() != DeviceType::CPU) {
+    return fail(c10::str(
+        "can't export a buffer of a ", tensor.device().str(),
+        " device type tensor. Use Tensor.cpu() to copy the tensor to host "
+        "memory first."));
+  }
+  if (tensor.layout() != Layout::Strided) {
+    return fail(c10::str(
+        "can't export a buffer of a ", tensor.layout(), " layout tensor."));
+  }
+  if (at::GradMode::is_enabled() && tensor.requires_grad()) {
+    return fail(
+        "can't export a buffer of a Tensor that requires grad. Use "
+        "tensor.detach() instead.");
+  }
+  const char* format = buffer_format(tensor.scalar_type());
+  if (!format) {
+    return fail(c10::str(
+        "can't export a buffer of a ", tensor.scalar_type(), " tensor."));
+  }
+  // Requests without strides, or for a contiguous buffer, need C-contiguous
+  // memory. Only 0 and 1-d tensors can be F-contiguous as well.
+  bool needs_contiguous = (flags & PyBUF_STRIDES) != PyBUF_STRIDES ||
+      (flags & PyBUF_C_CONTIGUOUS) == PyBUF_C_CONTIGUOUS ||
+      (flags & PyBUF_ANY_CONTIGUOUS) == PyBUF_ANY_CONTIGUOUS;
+  if (needs_contiguous && !tensor.is_contiguous()) {
+    return fail("tensor is not contiguous, a buffer with strides is needed.");
+  }
+  if ((flags & PyBUF_F_CONTIGUOUS) == PyBUF_F_CONTIGUOUS &&
+      !(tensor.dim() <= 1 && tensor.is_contiguous())) {
+    return fail("tensor is not Fortran contiguous.");
+  }
+
+  auto itemsize = static_cast<Py_ssize_t>(tensor.element_size());
+  auto info = std::make_unique<TensorBufferInfo>();
+  info->shape.assign(tensor.sizes().begin(), tensor.sizes().end());
+  for (auto stride : tensor.strides()) {
+    // Python strides use bytes
+    info->strides.push_back(stride * itemsize);
+  }
+  view->buf = tensor.data_ptr();
+  view->len = tensor.numel() * itemsize;
+  view->readonly = 0;
+  view->itemsize = itemsize;
+  view->format = (flags & PyBUF_FORMAT) ? const_cast<char*>(format) : nullptr;
+  view->ndim = tensor.dim();
+  view->shape = (flags & PyBUF_ND) == PyBUF_ND ? info->shape.data() : nullptr;
+  view->strides =
+      (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? info->strides.data() : nullptr;
+  view->suboffsets = nullptr;
+  view->internal = info.release();
+  // Use the private storage API
+  tensor.storage().unsafeGetStorageImpl()->set_resizable(false);
+  Py_INCREF(self);
+  view->obj = self;
+  return 0;
+  END_HANDLE_TH_ERRORS_RET(-1)
+}
+
+static void THPVariable_releasebuffer(PyObject* self, Py_buffer* view) {
+  delete static_cast<TensorBufferInfo*>(view->internal);
+}
+
+static PyBufferProcs THPVariable_as_buffer = {
+  THPVariable_getbuffer,
+  THPVariable_releasebuffer,
+};
+
 static PyMethodDef extra_methods[] = {
   {"as_subclass", castPyCFunctionWithKeywords(THPVariable_as_subclass),
     METH_VARARGS | METH_KEYWORDS, nullptr},
@@ -810,7 +930,7 @@ PyTypeObject THPVariableType = {
   nullptr,                                     /* tp_str */
   nullptr,                                     /* tp_getattro */
   nullptr,                                     /* tp_setattro */
-  nullptr,                                     /* tp_as_buffer */
+  &THPVariable_as_buffer,                      /* tp_as_buffer */
   Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC, /* tp_flags */
   nullptr,                                     /* tp_doc */
   (traverseproc)THPVariable_traverse,          /* tp_traverse */
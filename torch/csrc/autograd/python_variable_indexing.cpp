@@ -208,6 +208,118 @@ static inline Variable applySlicing(
   return result;
 }
 
+// Fast path of applySlicing for index tuples made of Python ints, slices of
+// ints, None and at most one Ellipsis, e.g. x[i, j] or x[:, 0]. These always
+// produce a view, whose sizes, strides and storage offset are computed here
+// the same way select, slice and unsqueeze do, and which is then created by a
+// single as_strided call instead of one call per index.
+//
+// Returns false if the index or the tensor isn't handled, leaving errors such
+// as out of bounds indices to applySlicing. Tensors that require grad are not
+// handled either, since the backward of as_strided is much more expensive than
+// the ones of select and slice. Others still get the view tracking of
+// as_strided, so that in-place ops on the result are seen by autograd.
+static inline bool applyBasicSlicing(
+    const Variable& self,
+    PyObject* index,
+    Variable& result) {
+  if (self.layout() != kStrided ||
+      !self.unsafeGetTensorImpl()->has_storage() || self.is_quantized() ||
+      self.is_nested() || self.has_names() || self.requires_grad() ||
+      self.fw_grad(/*level=*/0).defined()) {
+    return false;
+  }
+
+  int64_t size = PyTuple_GET_SIZE(index);
+  int64_t specified_dims = 0;
+  bool has_ellipsis = false;
+  for (int64_t i = 0; i < size; i++) {
+    PyObject* obj = PyTuple_GET_ITEM(index, i);
+    if (PyLong_CheckExact(obj)) {
+      specified_dims++;
+    } else if (PySlice_Check(obj)) {
+      PySliceObject* sliceobj = (PySliceObject*)obj;
+      for (PyObject* field : {sliceobj->start, sliceobj->stop, sliceobj->step}) {
+        if (field != Py_None && !PyLong_CheckExact(field)) {
+          return false;
+        }
+      }
+      specified_dims++;
+    } else if (obj == Py_Ellipsis) {
+      if (has_ellipsis) {
+        return false;
+      }
+      has_ellipsis = true;
+    } else if (obj != Py_None) {
+      return false;
+    }
+  }
+  if (specified_dims > self.dim()) {
+    return false;
+  }
+
+  std::vector<int64_t> sizes = self.sizes().vec();
+  std::vector<int64_t> strides = self.strides().vec();
+  int64_t storage_offset = self.storage_offset();
+  int64_t dim = 0;
+  for (int64_t i = 0; i < size; i++) {
+    PyObject* obj = PyTuple_GET_ITEM(index, i);
+    if (PyLong_CheckExact(obj)) {
+      int64_t idx = THPUtils_unpackLong(obj);
+      int64_t dim_size = sizes[dim];
+      if (idx < -dim_size || idx >= dim_size) {
+        return false;
+      }
+      if (idx < 0) {
+        idx += dim_size;
+      }
+      storage_offset += idx * strides[dim];
+      sizes.erase(sizes.begin() + dim);
+      strides.erase(strides.begin() + dim);
+    } else if (PySlice_Check(obj)) {
+      Py_ssize_t start, stop, step;
+      checkUnpackSlice(obj, &start, &stop, &step);
+      if (step <= 0) {
+        return false;
+      }
+      // Same clamping as at::slice
+      int64_t dim_size = sizes[dim];
+      int64_t start_val = start == INT64_MAX ? 0 : start;
+      int64_t end_val = stop;
+      if (start_val < 0) {
+        start_val += dim_size;
+      }
+      if (end_val < 0) {
+        end_val += dim_size;
+      }
+      if (start_val < 0) {
+        start_val = 0;
+      } else if (start_val >= dim_size) {
+        start_val = dim_size;
+      }
+      if (end_val < start_val) {
+        end_val = start_val;
+      } else if (end_val >= dim_size) {
+        end_val = dim_size;
+      }
+      storage_offset += start_val * strides[dim];
+      sizes[dim] = (end_val - start_val + step - 1) / step;
+      strides[dim] *= step;
+      dim++;
+    } else if (obj == Py_Ellipsis) {
+      dim += self.dim() - specified_dims;
+    } else {
+      // None, same geometry as unsqueeze
+      int64_t new_stride = dim >= (int64_t)sizes.size() ? 1 : sizes[dim] * strides[dim];
+      sizes.insert(sizes.begin() + dim, 1);
+      strides.insert(strides.begin() + dim, new_stride);
+      dim++;
+    }
+  }
+  result = self.as_strided(sizes, strides, storage_offset);
+  return true;
+}
+
 static inline bool treatSequenceAsTuple(PyObject* index) {
   if (PyTuple_Check(index)) {
     return true;
@@ -264,7 +376,11 @@ static inline THPObjectPtr wrapTuple(PyObject* index) {
 // 1. Python 1-D getter calls C++ `at::indexing::get_item` after
 // converting Python index to C++ TensorIndex.
 //
-// 2. Python N-D getter calls C++ `at::indexing::handleDimInMultiDimIndexing`
+// 2. Python N-D getter made of integers, slices, None and ellipsis computes
+// the geometry of the view itself and calls `as_strided` (see
+// `applyBasicSlicing`), for the tensors it supports.
+//
+// 3. Other Python N-D getters call C++ `at::indexing::handleDimInMultiDimIndexing`
 // for each dim, after converting Python index to C++ TensorIndex. If advanced
 // indexing is needed, it calls C++ `at::indexing::dispatch_index`.
 PyObject* THPVariable_getitem(PyObject* self, PyObject* index) {
@@ -308,6 +424,14 @@ PyObject* THPVariable_getitem(PyObject* self, PyObject* index) {
     })());
   }
 
+  // handle tuples of integers, slices, none and ellipsis
+  if (PyTuple_CheckExact(index) && !is_tracing) {
+    Variable result;
+    if (applyBasicSlicing(self_, index, result)) {
+      return THPVariable_Wrap(std::move(result));
+    }
+  }
+
   // wrap index in a tuple if it's not already one
   THPObjectPtr holder = wrapTuple(index);
 
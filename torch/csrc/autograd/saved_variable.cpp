@@ -11,11 +11,41 @@
 #include <list>
 #include <memory>
 #include <sstream>
+#include <vector>
 
 namespace torch { namespace autograd {
 
+namespace {
+
+thread_local std::vector<SavedVariableHooksFactory> default_hooks_stack;
+
+} // namespace
+
+namespace impl {
+
+void push_default_saved_variable_hooks(SavedVariableHooksFactory factory) {
+  default_hooks_stack.push_back(std::move(factory));
+}
+
+void pop_default_saved_variable_hooks() {
+  TORCH_INTERNAL_ASSERT(!default_hooks_stack.empty());
+  default_hooks_stack.pop_back();
+}
+
+std::unique_ptr<SavedVariableHooks> make_default_saved_variable_hooks() {
+  if (default_hooks_stack.empty()) {
+    return nullptr;
+  }
+  return default_hooks_stack.back()();
+}
+
+} // namespace impl
+
 SavedVariable::SavedVariable(const Variable& variable, bool is_output, bool is_inplace_view) {
   if (variable.defined()) {
+    TORCH_CHECK(!variable.unsafeGetTensorImpl()->is_inference(),
+      "Inference tensors cannot be saved for backward. To work around "
+      "you can make a clone to get a normal tensor and use it in autograd.");
     was_default_constructed_ = false;
     output_nr_ = variable.output_nr();
     requires_grad_ = variable.requires_grad();
@@ -39,6 +69,12 @@ SavedVariable::SavedVariable(const Variable& variable, bool is_output, bool is_i
     }
     version_counter_ = impl::version_counter(variable);
     saved_version_ = version_counter_.current_version();
+
+    hooks_ = impl::make_default_saved_variable_hooks();
+    if (hooks_) {
+      hooks_->call_pack_hook(data_);
+      data_.reset();
+    }
   }
 }
 
@@ -46,7 +82,7 @@ SavedVariable::SavedVariable(const c10::optional<Variable>& variable, bool is_ou
   : SavedVariable(variable.has_value() ? *variable : Variable(), is_output, is_inplace_view) {}
 
 Variable SavedVariable::unpack(std::shared_ptr<Node> saved_for) const {
-  if (!data_.defined()) {
+  if (!data_.defined() && !hooks_) {
     if (!was_default_constructed_) {
       throw std::runtime_error(ERR_BACKWARD_TWICE);
     }
@@ -66,8 +102,10 @@ Variable SavedVariable::unpack(std::shared_ptr<Node> saved_for) const {
   if (saved_version_ != version_counter_.current_version()) {
     std::stringstream message;
     message << "one of the variables needed for gradient computation has been "
-        "modified by an inplace operation: [" << data_.toString() << " "
-        << data_.sizes() << "]";
+        "modified by an inplace operation";
+    if (data_.defined()) {
+      message << ": [" << data_.toString() << " " << data_.sizes() << "]";
+    }
     if (grad_fn) {
         message << ", which is output " << output_nr_
             << " of " << grad_fn->name() << ",";
@@ -87,14 +125,19 @@ Variable SavedVariable::unpack(std::shared_ptr<Node> saved_for) const {
     throw std::runtime_error(message.str());
   }
 
+  const at::Tensor data = hooks_ ? hooks_->call_unpack_hook() : data_;
+  TORCH_CHECK(
+      data.defined(),
+      "The unpack hook of a saved variable returned an undefined tensor");
+
   // NB: saved views are unpacked as normal Variables (not views) even though
   // they still share the same storage. This works only because we never call
   // in-place functions on unpacked variables.
   Variable var;
   if (grad_fn) {
-    var = make_variable(data_, Edge(std::move(grad_fn), output_nr_));
+    var = make_variable(data, Edge(std::move(grad_fn), output_nr_));
   } else {
-    var = make_variable(data_, requires_grad_);
+    var = make_variable(data, requires_grad_);
   }
   impl::set_version_counter(var, saved_version_);
 
@@ -2,6 +2,7 @@
 
 #include <torch/csrc/WindowsTorchApiMacro.h>
 #include <torch/csrc/autograd/forward_grad.h>
+#include <torch/csrc/autograd/saved_variable_hooks.h>
 
 #include <ATen/ATen.h>
 
@@ -37,6 +38,7 @@ class TORCH_API SavedVariable {
   Variable unpack(std::shared_ptr<Node> saved_for = nullptr) const;
 
   void reset_data() {
+    hooks_.reset();
     return data_.reset();
   }
 
@@ -47,6 +49,11 @@ class TORCH_API SavedVariable {
  private:
   at::Tensor data_;
 
+  // Set when the variable was saved while default hooks were registered. The
+  // tensor then lives in the hooks (data_ stays undefined) and is recovered
+  // by unpack() through call_unpack_hook().
+  std::unique_ptr<SavedVariableHooks> hooks_;
+
   // This field is used to store the forward AD gradients associated with
   // the saved Tensor. Note that this shared_ptr must never be shared with
   // either the saved Tensor or the unpacked Tensor. See note [ Using ForwardGrad ]
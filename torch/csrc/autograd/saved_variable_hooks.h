@@ -0,0 +1,40 @@
+#pragma once
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+#include <ATen/ATen.h>
+
+#include <functional>
+#include <memory>
+
+namespace torch { namespace autograd {
+
+/// Hooks that take over how a `SavedVariable` keeps its tensor alive between
+/// the forward and the backward pass. `call_pack_hook` is called once, when
+/// the variable is saved, and the hooks object holds on to whatever the
+/// tensor was packed into (a CPU copy, a lower precision copy, the inputs
+/// needed to recompute it, ...). `call_unpack_hook` is called every time the
+/// saved variable is unpacked during backward and must return a tensor with
+/// the same metadata as the one that was packed.
+struct TORCH_API SavedVariableHooks {
+  virtual void call_pack_hook(const at::Tensor& tensor) = 0;
+  virtual at::Tensor call_unpack_hook() = 0;
+  virtual ~SavedVariableHooks() = default;
+};
+
+/// Creates the hooks of a newly saved variable.
+using SavedVariableHooksFactory =
+    std::function<std::unique_ptr<SavedVariableHooks>()>;
+
+namespace impl {
+
+// Default hooks are kept in a thread local stack: variables saved on this
+// thread use the factory on top of the stack, if any. They are not
+// propagated to other threads.
+TORCH_API void push_default_saved_variable_hooks(SavedVariableHooksFactory factory);
+TORCH_API void pop_default_saved_variable_hooks();
+TORCH_API std::unique_ptr<SavedVariableHooks> make_default_saved_variable_hooks();
+
+} // namespace impl
+
+}} // namespace torch::autograd
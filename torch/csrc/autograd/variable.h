@@ -675,8 +675,11 @@ inline Variable make_variable(
       }
       return Variable(std::move(data_impl));
     } else {
+      // Copies of inference tensors stay inference tensors
       auto data_impl_copy = data.getIntrusivePtr()->shallow_copy_and_detach(
-        /*version_counter=*/0,
+        /*version_counter=*/data.is_inference()
+            ? c10::VariableVersion(c10::VariableVersion::DISABLED)
+            : c10::VariableVersion(0),
         /*allow_tensor_metadata_change=*/allow_tensor_metadata_change);
       if (requires_grad) {
         data_impl_copy->set_autograd_meta(std::make_unique<AutogradMeta>(
@@ -27,12 +27,19 @@ void THCPGraph_init(PyObject *module) {
       .def("capture_begin",
            &::at::cuda::CUDAGraph::capture_begin,
            py::call_guard<py::gil_scoped_release>(),
-           R"(``capture_begin`` begins Cuda graph capture on the current stream.)")
+           R"(``capture_begin`` begins Cuda graph capture on the current stream.
+           Allocations made during capture come from the private memory pool
+           ``pool``, as returned by ``pool()`` of another graph, or from a new
+           pool if ``pool`` is 0.)",
+           py::arg("pool") = 0)
       .def("capture_end",
            &::at::cuda::CUDAGraph::capture_end,
            py::call_guard<py::gil_scoped_release>(),
            R"(``capture_end`` ends Cuda graph capture on the current stream.
            After ``capture_end``, ``replay`` may be called on this instance.)")
+      .def("pool",
+           &::at::cuda::CUDAGraph::pool,
+           R"(``pool`` returns the id of the private memory pool this graph allocates from.)")
       .def("replay",
            &::at::cuda::CUDAGraph::replay,
            py::call_guard<py::gil_scoped_release>(),
@@ -6,8 +6,11 @@
 #include <TH/TH.h>
 #include <ATen/ATen.h>
 #include <ATen/cuda/CUDAContext.h>
+#include <ATen/cuda/CUDAEvent.h>
 #include <ATen/CUDAGeneratorImpl.h>
+#include <ATen/cuda/CUDAGraphsUtils.cuh>
 #include <c10/cuda/CUDAFunctions.h>
+#include <c10/cuda/CUDAGuard.h>
 #include <c10/cuda/CUDACachingAllocator.h>
 #ifdef USE_NCCL
 #include <torch/csrc/cuda/python_nccl.h>
@@ -174,6 +177,41 @@ PyObject * THCPModule_setStream_wrap(PyObject *self, PyObject *obj)
   END_HANDLE_TH_ERRORS
 }
 
+// Makes a stream PyTorch doesn't manage, e.g. the one a consumer passes to
+// Tensor.__dlpack__, wait for the work queued so far on the current stream of
+// a device. The host is not blocked.
+PyObject * THCPModule_externalStreamWaitCurrentStream(PyObject *_unused, PyObject *args)
+{
+  HANDLE_TH_ERRORS
+  PyObject* device_o = nullptr;
+  PyObject* stream_o = nullptr;
+  if (!PyArg_ParseTuple(args, "OO", &device_o, &stream_o) ||
+      !THPUtils_checkLong(device_o) || !THPUtils_checkLong(stream_o)) {
+    THPUtils_invalidArguments(
+        args,
+        nullptr,
+        "_cuda_externalStreamWaitCurrentStream",
+        1,
+        "(int device, int stream_ptr)");
+    return nullptr;
+  }
+  auto device = THPUtils_unpackLong(device_o);
+  uint64_t stream_ptr = PyLong_AsUnsignedLongLong(stream_o);
+  if (stream_ptr == static_cast<uint64_t>(-1) && PyErr_Occurred()) {
+    throw python_error();
+  }
+  auto external = reinterpret_cast<cudaStream_t>(stream_ptr);
+  auto current = at::cuda::getCurrentCUDAStream(device);
+  if (external != current.stream()) {
+    at::cuda::CUDAGuard guard(current.device_index());
+    at::cuda::CUDAEvent event;
+    event.record(current);
+    AT_CUDA_CHECK(cudaStreamWaitEvent(external, event, 0));
+  }
+  Py_RETURN_NONE;
+  END_HANDLE_TH_ERRORS
+}
+
 PyObject * THCPModule_getCompiledVersion(PyObject *self, PyObject *noargs)
 {
   return THPUtils_packInt64((int64_t) CUDA_VERSION);
@@ -227,6 +265,7 @@ PyObject * THCPModule_cudaIPCCollect(PyObject *_unused, PyObject *noargs)
 {
   HANDLE_TH_ERRORS
   torch::CudaIPCCollect();
+  c10::cuda::CUDACachingAllocator::releaseCachedIpcDevPtrs();
   Py_RETURN_NONE;
   END_HANDLE_TH_ERRORS
 }
@@ -319,6 +358,84 @@ PyObject * THCPModule_emptyCache(PyObject *_unused, PyObject *noargs)
   Py_RETURN_NONE;
 }
 
+PyObject * THCPModule_isCurrentStreamCapturing(PyObject *_unused, PyObject *noargs)
+{
+  HANDLE_TH_ERRORS
+  if (at::cuda::currentStreamCaptureStatus() == at::cuda::CaptureStatus::None) {
+    Py_RETURN_FALSE;
+  } else {
+    Py_RETURN_TRUE;
+  }
+  END_HANDLE_TH_ERRORS
+}
+
+PyObject * THCPModule_createPoolId(PyObject *_unused, PyObject *noargs)
+{
+  HANDLE_TH_ERRORS
+  return PyLong_FromUnsignedLongLong(c10::cuda::CUDACachingAllocator::createPoolId());
+  END_HANDLE_TH_ERRORS
+}
+
+PyObject * THCPModule_retainPool(PyObject *_unused, PyObject *args)
+{
+  HANDLE_TH_ERRORS
+  int device;
+  unsigned long long mempool_id;
+  if (!PyArg_ParseTuple(args, "iK", &device, &mempool_id)) {
+    THPUtils_invalidArguments(args, nullptr, "_cuda_retainPool", 1, "(int device, int pool);");
+    return nullptr;
+  }
+  c10::cuda::CUDACachingAllocator::retainPool(device, mempool_id);
+  END_HANDLE_TH_ERRORS
+  Py_RETURN_NONE;
+}
+
+PyObject * THCPModule_releasePool(PyObject *_unused, PyObject *args)
+{
+  HANDLE_TH_ERRORS
+  int device;
+  unsigned long long mempool_id;
+  if (!PyArg_ParseTuple(args, "iK", &device, &mempool_id)) {
+    THPUtils_invalidArguments(args, nullptr, "_cuda_releasePool", 1, "(int device, int pool);");
+    return nullptr;
+  }
+  c10::cuda::CUDACachingAllocator::releasePool(device, mempool_id);
+  END_HANDLE_TH_ERRORS
+  Py_RETURN_NONE;
+}
+
+PyObject * THCPModule_beginAllocateToPool(PyObject *_unused, PyObject *args)
+{
+  HANDLE_TH_ERRORS
+  int device;
+  unsigned long long mempool_id;
+  unsigned long long stream;
+  if (!PyArg_ParseTuple(args, "iKK", &device, &mempool_id, &stream)) {
+    THPUtils_invalidArguments(
+        args, nullptr, "_cuda_beginAllocateToPool", 1, "(int device, int pool, int stream);");
+    return nullptr;
+  }
+  c10::cuda::CUDACachingAllocator::beginAllocateToPool(
+      device, mempool_id, reinterpret_cast<cudaStream_t>(stream));
+  END_HANDLE_TH_ERRORS
+  Py_RETURN_NONE;
+}
+
+PyObject * THCPModule_endAllocateToPool(PyObject *_unused, PyObject *args)
+{
+  HANDLE_TH_ERRORS
+  int device;
+  unsigned long long stream;
+  if (!PyArg_ParseTuple(args, "iK", &device, &stream)) {
+    THPUtils_invalidArguments(args, nullptr, "_cuda_endAllocateToPool", 1, "(int device, int stream);");
+    return nullptr;
+  }
+  c10::cuda::CUDACachingAllocator::endAllocateToPool(
+      device, reinterpret_cast<cudaStream_t>(stream));
+  END_HANDLE_TH_ERRORS
+  Py_RETURN_NONE;
+}
+
 PyObject * THCPModule_memoryStats(PyObject *_unused, PyObject *arg)
 {
   HANDLE_TH_ERRORS
@@ -404,6 +521,7 @@ PyObject * THCPModule_memorySnapshot(PyObject *_unused, PyObject *noargs)
     segmentDict["allocated_size"] = segmentInfo.allocated_size;
     segmentDict["active_size"] = segmentInfo.active_size;
     segmentDict["segment_type"] = (segmentInfo.is_large ? "large" : "small");
+    segmentDict["is_expandable"] = segmentInfo.is_expandable;
 
     py::list blocks;
     for (const auto& blockInfo : segmentInfo.blocks) {
@@ -428,6 +546,68 @@ PyObject * THCPModule_memorySnapshot(PyObject *_unused, PyObject *noargs)
   END_HANDLE_TH_ERRORS
 }
 
+PyObject * THCPModule_recordMemoryHistory(PyObject *_unused, PyObject *args)
+{
+  HANDLE_TH_ERRORS
+  int enabled;
+  Py_ssize_t max_entries;
+  Py_ssize_t stack_depth;
+  const char* oom_dump_path;
+  if (!PyArg_ParseTuple(args, "pnns", &enabled, &max_entries, &stack_depth, &oom_dump_path)) {
+    THPUtils_invalidArguments(
+        args, nullptr, "_cuda_recordMemoryHistory", 1,
+        "(bool enabled, int max_entries, int stack_depth, str oom_dump_path);");
+    return nullptr;
+  }
+  THPUtils_assert(max_entries >= 0 && stack_depth >= 0,
+                  "max_entries and stack_depth must be non-negative");
+  c10::cuda::CUDACachingAllocator::recordHistory(
+      enabled, max_entries, stack_depth, oom_dump_path);
+  END_HANDLE_TH_ERRORS
+  Py_RETURN_NONE;
+}
+
+PyObject * THCPModule_memoryTrace(PyObject *_unused, PyObject *arg)
+{
+  HANDLE_TH_ERRORS
+  THPUtils_assert(THPUtils_checkLong(arg), "invalid argument to memory_trace");
+  const int device = (int) THPUtils_unpackLong(arg);
+
+  using c10::cuda::CUDACachingAllocator::TraceEntry;
+
+  const std::array<const char*, 7> actionNames = {
+    "alloc", "free", "segment_alloc", "segment_free", "segment_map", "segment_unmap", "oom"
+  };
+
+  // Entries share stacks, so each one is symbolized only once.
+  std::unordered_map<uint32_t, py::str> stacks;
+  const std::vector<TraceEntry> trace = c10::cuda::CUDACachingAllocator::getTrace(device);
+  py::list result;
+  for (const auto& entry : trace) {
+    py::dict entryDict;
+    entryDict["action"] = actionNames.at(entry.action);
+    entryDict["addr"] = entry.addr;
+    entryDict["size"] = entry.size;
+    entryDict["stream"] = reinterpret_cast<uint64_t>(entry.stream);
+    entryDict["time_us"] = entry.time_us;
+    if (entry.stack_id != 0) {
+      auto it = stacks.find(entry.stack_id);
+      if (it == stacks.end()) {
+        it = stacks.emplace(
+            entry.stack_id,
+            py::str(c10::cuda::CUDACachingAllocator::getTraceStack(entry.stack_id))).first;
+      }
+      entryDict["frames"] = it->second;
+    } else {
+      entryDict["frames"] = py::none();
+    }
+    result.append(entryDict);
+  }
+
+  return result.release().ptr();
+  END_HANDLE_TH_ERRORS
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Cuda module initialization
 ////////////////////////////////////////////////////////////////////////////////
@@ -545,6 +725,8 @@ static struct PyMethodDef _THCPModule_methods[] = {
     THCPModule_getDefaultStream_wrap, METH_O, nullptr},
   {"_cuda_getCurrentBlasHandle", THCPModule_getCurrentBlasHandle_wrap, METH_NOARGS, nullptr},
   {"_cuda_setStream",    THCPModule_setStream_wrap,  METH_O, nullptr},
+  {"_cuda_externalStreamWaitCurrentStream",
+    THCPModule_externalStreamWaitCurrentStream, METH_VARARGS, nullptr},
   {"_cuda_getCompiledVersion", THCPModule_getCompiledVersion, METH_NOARGS, nullptr},
   {"_cuda_hasPrimaryContext", THCPModule_hasPrimaryContext,  METH_O,  nullptr},
   {"_cuda_setMemoryFraction", THCPModule_setMemoryFraction, METH_VARARGS,  nullptr},
@@ -553,6 +735,14 @@ static struct PyMethodDef _THCPModule_methods[] = {
   {"_cuda_resetAccumulatedMemoryStats", THCPModule_resetAccumulatedMemoryStats, METH_O, nullptr},
   {"_cuda_resetPeakMemoryStats", THCPModule_resetPeakMemoryStats, METH_O,  nullptr},
   {"_cuda_memorySnapshot", THCPModule_memorySnapshot, METH_NOARGS, nullptr},
+  {"_cuda_recordMemoryHistory", THCPModule_recordMemoryHistory, METH_VARARGS, nullptr},
+  {"_cuda_memoryTrace", THCPModule_memoryTrace, METH_O, nullptr},
+  {"_cuda_isCurrentStreamCapturing", THCPModule_isCurrentStreamCapturing, METH_NOARGS, nullptr},
+  {"_cuda_createPoolId", THCPModule_createPoolId, METH_NOARGS, nullptr},
+  {"_cuda_retainPool", THCPModule_retainPool, METH_VARARGS, nullptr},
+  {"_cuda_releasePool", THCPModule_releasePool, METH_VARARGS, nullptr},
+  {"_cuda_beginAllocateToPool", THCPModule_beginAllocateToPool, METH_VARARGS, nullptr},
+  {"_cuda_endAllocateToPool", THCPModule_endAllocateToPool, METH_VARARGS, nullptr},
   {"_cuda_cudaHostAllocator", THCPModule_cudaHostAllocator, METH_NOARGS, nullptr},
   {"_cuda_cudaCachingAllocator_raw_alloc", THCPModule_cudaCachingAllocator_raw_alloc, METH_VARARGS, nullptr},
   {"_cuda_cudaCachingAllocator_raw_delete", THCPModule_cudaCachingAllocator_raw_delete, METH_O, nullptr},
@@ -12,6 +12,7 @@ using version_tuple = std::tuple<size_t, size_t, size_t>;
 
 #ifdef USE_CUDNN
 #include <cudnn.h>
+#include <ATen/native/cudnn/ConvShared.h>
 
 namespace {
 
@@ -95,6 +96,10 @@ void initCudnnBindings(PyObject* module) {
   cudnn.def("getRuntimeVersion", getRuntimeVersion);
   cudnn.def("getCompileVersion", getCompileVersion);
   cudnn.def("getVersionInt", getVersionInt);
+#ifdef USE_CUDNN
+  cudnn.def("_save_benchmark_cache", at::native::cudnn_save_benchmark_cache);
+  cudnn.def("_load_benchmark_cache", at::native::cudnn_load_benchmark_cache);
+#endif
 }
 
 } // namespace shared
@@ -18,6 +18,11 @@ Package InterpreterManager::load_package(const std::string& uri) {
   return Package(uri, this);
 }
 
+Package InterpreterManager::load_package(
+    std::shared_ptr<caffe2::serialize::ReadAdapterInterface> reader) {
+  return Package(std::move(reader), this);
+}
+
 PythonObject InterpreterSession::from_movable(const MovableObject& obj) {
   return impl_->unpickle_or_get(obj.pImpl_->object_id_, obj.pImpl_->data_);
 }
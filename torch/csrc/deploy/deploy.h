@@ -1,5 +1,6 @@
 #pragma once
 #include <assert.h>
+#include <caffe2/serialize/mmap_file_adapter.h>
 #include <torch/csrc/deploy/interpreter/interpreter_impl.h>
 #include <fstream>
 #include <iostream>
@@ -24,6 +25,8 @@ struct TORCH_API InterpreterSession {
   PythonObject global(const char* module, const char* name) {
     return impl_->global(module, name);
   }
+  // Tensors in ivalue are passed without copying their data, including the
+  // ones returned by (and still alive in) another interpreter.
   PythonObject from_ivalue(at::IValue ivalue) {
     return impl_->from_ivalue(std::move(ivalue));
   }
@@ -119,7 +122,14 @@ struct TORCH_API InterpreterManager {
     AT_ASSERT(N <= instances_.size());
     resources_.setResourceLimit(N);
   }
+  // The package file is memory mapped, so the tensors it contains point into
+  // the mapping rather than into copies of it (see MmapFileAdapter): they are
+  // loaded once, and the MovableObjects created from the package share them
+  // with every interpreter they are moved to.
   Package load_package(const std::string& uri);
+  // Loads the package through reader, e.g. an in memory or stream adapter.
+  Package load_package(
+      std::shared_ptr<caffe2::serialize::ReadAdapterInterface> reader);
   InterpreterManager(const InterpreterManager&) = delete;
   InterpreterManager& operator=(const InterpreterManager&) = delete;
   InterpreterManager& operator=(InterpreterManager&&) = delete;
@@ -185,9 +195,16 @@ struct TORCH_API Package {
       const std::string& uri,
       InterpreterManager*
           pm) // or really any of the constructors to our zip file format
+      : Package(
+            std::make_shared<caffe2::serialize::MmapFileAdapter>(uri),
+            pm) {}
+  Package(
+      std::shared_ptr<caffe2::serialize::ReadAdapterInterface> reader,
+      InterpreterManager* pm)
       : manager_(pm),
         container_file_(
-            std::make_shared<caffe2::serialize::PyTorchStreamReader>(uri)) {}
+            std::make_shared<caffe2::serialize::PyTorchStreamReader>(
+                std::move(reader))) {}
   friend struct MovableObject;
   friend struct InterpreterManager;
   InterpreterManager* manager_;
@@ -9,6 +9,7 @@
 #include <pybind11/embed.h>
 #include <stdio.h>
 #include <torch/csrc/autograd/generated/variable_factories.h>
+#include <torch/csrc/autograd/python_variable.h>
 #include <torch/csrc/jit/python/pybind_utils.h>
 #include <iostream>
 #include <map>
@@ -339,6 +340,56 @@ struct ConcreteInterpreterImpl : public torch::InterpreterImpl {
   std::mutex init_lock_;
 };
 
+// The Python object of a tensor is cached on its TensorImpl (pyobj()), and
+// THPVariable_Wrap returns the cached object as is. For a tensor that is alive
+// in another interpreter that object belongs to the other interpreter's Python,
+// so it must not be handed out here.
+static bool owned_by_other_interpreter(const at::Tensor& tensor) {
+  PyObject* obj = tensor.unsafeGetTensorImpl()->pyobj();
+  return obj && !PyObject_TypeCheck(obj, (PyTypeObject*)THPVariableClass);
+}
+
+// Replaces the tensors of value that are owned by another interpreter with new
+// TensorImpls that share their storage, so they move between interpreters
+// without copying their data. The new tensors don't carry autograd history.
+static IValue share_foreign_tensors(const IValue& value) {
+  if (value.isTensor()) {
+    const auto& tensor = value.toTensor();
+    return owned_by_other_interpreter(tensor) ? IValue(tensor.variable_data())
+                                              : value;
+  }
+  if (value.isTuple()) {
+    const auto& tuple = value.toTuple();
+    std::vector<IValue> elements;
+    elements.reserve(tuple->elements().size());
+    for (const auto& element : tuple->elements()) {
+      elements.push_back(share_foreign_tensors(element));
+    }
+    auto type = tuple->type();
+    return type->schema()
+        ? c10::ivalue::Tuple::createNamed(std::move(elements), std::move(type))
+        : c10::ivalue::Tuple::create(std::move(elements));
+  }
+  if (value.isList()) {
+    auto list = value.toList();
+    c10::impl::GenericList shared(list.elementType());
+    shared.reserve(list.size());
+    for (size_t i = 0, N = list.size(); i < N; ++i) {
+      shared.push_back(share_foreign_tensors(list.get(i)));
+    }
+    return shared;
+  }
+  if (value.isGenericDict()) {
+    auto dict = value.toGenericDict();
+    c10::impl::GenericDict shared(dict.keyType(), dict.valueType());
+    for (const auto& entry : dict) {
+      shared.insert(entry.key(), share_foreign_tensors(entry.value()));
+    }
+    return shared;
+  }
+  return value;
+}
+
 struct ConcreteInterpreterSessionImpl : public torch::InterpreterSessionImpl {
   ConcreteInterpreterSessionImpl(ConcreteInterpreterImpl* interp)
       : interp_(interp) {}
@@ -347,7 +398,7 @@ struct ConcreteInterpreterSessionImpl : public torch::InterpreterSessionImpl {
   }
 
   PythonObject from_ivalue(IValue value) override {
-    return wrap(torch::jit::toPyObject(value));
+    return wrap(torch::jit::toPyObject(share_foreign_tensors(value)));
   }
   PythonObject create_or_get_package_importer_from_container_file(
       const std::shared_ptr<caffe2::serialize::PyTorchStreamReader>&
@@ -427,7 +478,7 @@ struct ConcreteInterpreterSessionImpl : public torch::InterpreterSessionImpl {
   PythonObject call(PythonObject obj, at::ArrayRef<IValue> args) override {
     py::tuple m_args(args.size());
     for (size_t i = 0, N = args.size(); i != N; ++i) {
-      m_args[i] = torch::jit::toPyObject(args[i]);
+      m_args[i] = torch::jit::toPyObject(share_foreign_tensors(args[i]));
     }
     return wrap(call(unwrap(obj), m_args));
   }
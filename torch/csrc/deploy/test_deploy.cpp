@@ -121,3 +121,36 @@ TEST(TorchpyTest, ThreadedSimpleModel) {
     ASSERT_TRUE(ref_output.equal(outputs[i]));
   }
 }
+
+TEST(TorchpyTest, SharedWeights) {
+  size_t ninterp = 3;
+  torch::InterpreterManager manager(ninterp);
+  torch::Package p = manager.load_package(path("SIMPLE", simple));
+  auto model = p.load_pickle("model", "model.pkl");
+
+  // every interpreter sees the same weight storage
+  std::vector<void*> weights;
+  for (const auto& interp : manager.all_instances()) {
+    auto I = model.acquire_session(&interp);
+    weights.push_back(I.self.attr("weight").toIValue().toTensor().data_ptr());
+  }
+  for (size_t i = 1; i < ninterp; i++) {
+    ASSERT_EQ(weights[0], weights[i]);
+  }
+}
+
+TEST(TorchpyTest, FromIValueAcrossInterpreters) {
+  torch::InterpreterManager manager(2);
+  auto I0 = manager.all_instances()[0].acquire_session();
+  auto I1 = manager.all_instances()[1].acquire_session();
+
+  // the tensor is still referenced by interpreter 0 when it is passed to
+  // interpreter 1
+  auto obj0 = I0.global("torch", "ones")({10});
+  at::Tensor t0 = obj0.toIValue().toTensor();
+  auto obj1 = I1.from_ivalue(t0);
+  at::Tensor t1 = obj1.attr("add_")({1}).toIValue().toTensor();
+
+  ASSERT_EQ(t0.data_ptr(), t1.data_ptr());
+  ASSERT_TRUE(t0.equal(torch::full({10}, 2.)));
+}
@@ -12,7 +12,7 @@ namespace autograd {
 using torch::autograd::AccumulateGrad;
 
 DistAutogradContext::DistAutogradContext(int64_t contextId)
-    : contextId_(contextId) {}
+    : contextId_(contextId), numGradientRpcs_(0) {}
 
 int64_t DistAutogradContext::contextId() const {
   return contextId_;
@@ -144,6 +144,12 @@ void DistAutogradContext::addOutstandingRpc(
   });
   std::lock_guard<std::mutex> guard(lock_);
   outStandingRpcs_.push_back(jitFuture);
+  ++numGradientRpcs_;
+}
+
+int64_t DistAutogradContext::numGradientRpcs() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return numGradientRpcs_;
 }
 
 void DistAutogradContext::clearOutstandingRpcs() {
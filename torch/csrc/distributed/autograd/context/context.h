@@ -54,6 +54,11 @@ class TORCH_API DistAutogradContext {
   void addOutstandingRpc(
       const std::shared_ptr<rpc::JitFuture>& jitFuture);
 
+  // Number of RPCs this node sent to propagate gradients to other nodes in
+  // this context. Gradients bound for the same node are batched, so this can
+  // be lower than the number of 'recv' functions executed.
+  int64_t numGradientRpcs() const;
+
   // Returns all gradients.
   const c10::Dict<torch::Tensor, torch::Tensor> getGradients() const;
 
@@ -136,6 +141,9 @@ class TORCH_API DistAutogradContext {
   // successfully only if all these futures are done and are successful.
   std::vector<std::shared_ptr<rpc::JitFuture>> outStandingRpcs_;
 
+  // Total number of RPCs added to 'outStandingRpcs_', across backward passes.
+  int64_t numGradientRpcs_;
+
   // Lock to protect concurrent modification of the context.
   mutable std::mutex lock_;
 };
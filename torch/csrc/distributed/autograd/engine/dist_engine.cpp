@@ -328,6 +328,15 @@ void DistEngine::execute_graph_task_until_ready_queue_empty(
 
   torch::autograd::set_device(torch::autograd::CPU_DEVICE);
   graph_task->owner_ = torch::autograd::CPU_DEVICE;
+  // Gradients that RecvRpcBackward functions propagate to other nodes are
+  // collected here and sent with one RPC per node once we run out of local
+  // work, rather than one RPC per 'recv' function.
+  PropagateGradientsBatch gradientsBatch;
+  // Tasks whose gradients are still waiting in the batch. They stay
+  // outstanding until the batch is flushed, otherwise another thread running
+  // the same GraphTask could see it complete and wait for the outstanding
+  // RPCs before those are sent.
+  int unflushedTasks = 0;
   while (!cpu_ready_queue->empty()) {
     std::shared_ptr<GraphTask> local_graph_task;
     {
@@ -354,8 +363,14 @@ void DistEngine::execute_graph_task_until_ready_queue_empty(
       }
     }
     // Decrement the outstanding task.
-    --local_graph_task->outstanding_tasks_;
+    if (gradientsBatch.empty()) {
+      --local_graph_task->outstanding_tasks_;
+    } else {
+      ++unflushedTasks;
+    }
   }
+  gradientsBatch.flush();
+  graph_task->outstanding_tasks_ -= unflushedTasks;
   // Check if we've completed execution.
   if (graph_task->completed()) {
     // We don't need to explicitly notify the owner thread, since
@@ -10,6 +10,30 @@ namespace autograd {
 using torch::autograd::Variable;
 using torch::autograd::variable_list;
 
+namespace {
+
+thread_local PropagateGradientsBatch* current_batch = nullptr;
+
+// Sends the gradients over to the appropriate node and records the future in
+// the autograd context.
+void sendGradients(
+    const ContextPtr& autogradContext,
+    rpc::worker_id_t toWorkerId,
+    const std::unordered_map<c10::DeviceIndex, c10::DeviceIndex>& deviceMap,
+    PropagateGradientsReq&& gradCall) {
+  auto rpcAgent = rpc::RpcAgent::getCurrentRpcAgent();
+  auto jitFuture = rpcAgent->send(
+      rpcAgent->getWorkerInfo(toWorkerId),
+      std::move(gradCall).toMessage(),
+      rpc::kUnsetRpcTimeout,
+      deviceMap);
+
+  // Record the future in the context.
+  autogradContext->addOutstandingRpc(jitFuture);
+}
+
+} // namespace
+
 RecvRpcBackward::RecvRpcBackward(
     const AutogradMetadata& autogradMetadata,
     ContextPtr autogradContext,
@@ -40,29 +64,99 @@ variable_list RecvRpcBackward::apply(variable_list&& grads) {
           "means the autograd context was cleaned up by a different thread due ",
           "to an error before RecvRcpBackward had a chance to run"));
 
-  // Send the gradients over the wire and record the future in the autograd
-  // context.
-  PropagateGradientsReq gradCall(
-      autogradMetadata_,
-      outputGrads,
-      sharedContext->retrieveGraphTask()->keep_graph_);
-
-  // Send the gradients over to the appropriate node.
-  auto rpcAgent = rpc::RpcAgent::getCurrentRpcAgent();
-  auto jitFuture = rpcAgent->send(
-      rpcAgent->getWorkerInfo(fromWorkerId_),
-      std::move(gradCall).toMessage(),
-      rpc::kUnsetRpcTimeout,
-      deviceMap_);
-
-  // Record the future in the context.
-  sharedContext->addOutstandingRpc(jitFuture);
+  bool retainGraph = sharedContext->retrieveGraphTask()->keep_graph_;
+  if (auto batch = PropagateGradientsBatch::current()) {
+    // Leave it to the engine to send the gradients along with the others
+    // bound for the same node once it runs out of local work.
+    batch->add(
+        std::move(sharedContext),
+        fromWorkerId_,
+        deviceMap_,
+        autogradMetadata_,
+        std::move(outputGrads),
+        retainGraph);
+  } else {
+    // Send the gradients over the wire and record the future in the autograd
+    // context.
+    sendGradients(
+        sharedContext,
+        fromWorkerId_,
+        deviceMap_,
+        PropagateGradientsReq(
+            autogradMetadata_, std::move(outputGrads), retainGraph));
+  }
 
   // 'recv' function sends the gradients over the wire using RPC, it doesn't
   // need to return anything for any downstream autograd function.
   return variable_list();
 }
 
+PropagateGradientsBatch::PropagateGradientsBatch() : prev_(current_batch) {
+  current_batch = this;
+}
+
+PropagateGradientsBatch::~PropagateGradientsBatch() {
+  flush();
+  current_batch = prev_;
+}
+
+PropagateGradientsBatch* PropagateGradientsBatch::current() {
+  return current_batch;
+}
+
+void PropagateGradientsBatch::add(
+    ContextPtr autogradContext,
+    rpc::worker_id_t toWorkerId,
+    const std::unordered_map<c10::DeviceIndex, c10::DeviceIndex>& deviceMap,
+    const AutogradMetadata& autogradMetadata,
+    std::vector<Variable> grads,
+    bool retainGraph) {
+  PropagateGradientsReq::Entry entry{autogradMetadata, std::move(grads)};
+  // There are only a handful of destinations, a linear search is enough.
+  for (auto& destination : destinations_) {
+    if (destination.autogradContext == autogradContext &&
+        destination.toWorkerId == toWorkerId &&
+        destination.deviceMap == deviceMap &&
+        destination.retainGraph == retainGraph) {
+      destination.entries.push_back(std::move(entry));
+      return;
+    }
+  }
+  std::vector<PropagateGradientsReq::Entry> entries;
+  entries.push_back(std::move(entry));
+  destinations_.push_back(Destination{std::move(autogradContext),
+                                      toWorkerId,
+                                      deviceMap,
+                                      retainGraph,
+                                      std::move(entries)});
+}
+
+bool PropagateGradientsBatch::empty() const {
+  return destinations_.empty();
+}
+
+void PropagateGradientsBatch::flush() {
+  auto destinations = std::move(destinations_);
+  destinations_.clear();
+  for (auto& destination : destinations) {
+    try {
+      sendGradients(
+          destination.autogradContext,
+          destination.toWorkerId,
+          destination.deviceMap,
+          PropagateGradientsReq(
+              std::move(destination.entries), destination.retainGraph));
+    } catch (const std::exception&) {
+      // The RecvRpcBackward functions have already returned, so report the
+      // error through the outstanding RPCs of the context, which fails the
+      // backward pass.
+      auto jitFuture = std::make_shared<rpc::JitFuture>(at::AnyClassType::get());
+      jitFuture->setError(std::current_exception());
+      destination.autogradContext->addOutstandingRpc(jitFuture);
+    }
+  }
+}
+
 } // namespace autograd
 } // namespace distributed
 } // namespace torch
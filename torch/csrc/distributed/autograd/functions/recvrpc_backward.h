@@ -3,6 +3,7 @@
 #include <torch/csrc/autograd/function.h>
 #include <torch/csrc/distributed/autograd/context/context.h>
 #include <torch/csrc/distributed/autograd/rpc_messages/autograd_metadata.h>
+#include <torch/csrc/distributed/autograd/rpc_messages/propagate_gradients_req.h>
 #include <torch/csrc/distributed/rpc/rpc_agent.h>
 
 namespace torch {
@@ -44,6 +45,52 @@ class TORCH_API RecvRpcBackward : public torch::autograd::Node {
   const std::unordered_map<c10::DeviceIndex, c10::DeviceIndex> deviceMap_;
 };
 
+// Collects the gradients that the RecvRpcBackward functions run on this
+// thread propagate to other nodes, so that all the gradients bound for the
+// same node are sent as a single PropagateGradientsReq instead of one RPC per
+// 'recv' function. The DistEngine installs one while it drains a local ready
+// queue and flushes it once the queue is empty; RecvRpcBackward sends right
+// away on threads without one (e.g. device threads).
+class TORCH_API PropagateGradientsBatch {
+ public:
+  PropagateGradientsBatch();
+  // Flushes any gradients left and restores the previous batch.
+  ~PropagateGradientsBatch();
+
+  PropagateGradientsBatch(const PropagateGradientsBatch&) = delete;
+  PropagateGradientsBatch& operator=(const PropagateGradientsBatch&) = delete;
+
+  // The innermost batch installed on this thread, nullptr if there is none.
+  static PropagateGradientsBatch* current();
+
+  void add(
+      std::shared_ptr<DistAutogradContext> autogradContext,
+      rpc::worker_id_t toWorkerId,
+      const std::unordered_map<c10::DeviceIndex, c10::DeviceIndex>& deviceMap,
+      const AutogradMetadata& autogradMetadata,
+      std::vector<torch::autograd::Variable> grads,
+      bool retainGraph);
+
+  bool empty() const;
+
+  // Sends one RPC per destination and records the futures in the autograd
+  // contexts. Errors in sending are reported through those futures.
+  void flush();
+
+ private:
+  // Gradients bound for the same node with the same options.
+  struct Destination {
+    std::shared_ptr<DistAutogradContext> autogradContext;
+    rpc::worker_id_t toWorkerId;
+    std::unordered_map<c10::DeviceIndex, c10::DeviceIndex> deviceMap;
+    bool retainGraph;
+    std::vector<PropagateGradientsReq::Entry> entries;
+  };
+
+  std::vector<Destination> destinations_;
+  PropagateGradientsBatch* prev_;
+};
+
 } // namespace autograd
 } // namespace distributed
 } // namespace torch
@@ -64,7 +64,11 @@ PyObject* dist_autograd_init(PyObject* _unused, PyObject* noargs) {
                 }
                 return funcs;
               })
-          .def("_known_worker_ids", &DistAutogradContext::getKnownWorkerIds);
+          .def("_known_worker_ids", &DistAutogradContext::getKnownWorkerIds)
+          .def(
+              "_num_gradient_rpcs",
+              &DistAutogradContext::numGradientRpcs,
+              py::call_guard<py::gil_scoped_release>());
 
   module.def(
       "_new_context",
@@ -14,21 +14,25 @@ PropagateGradientsReq::PropagateGradientsReq(
     const AutogradMetadata& autogradMetadata,
     std::vector<Variable> grads,
     bool retainGraph)
-    : autogradMetadata_(autogradMetadata),
-      grads_(std::move(grads)),
-      retainGraph_(retainGraph) {}
+    : retainGraph_(retainGraph) {
+  entries_.push_back(Entry{autogradMetadata, std::move(grads)});
+}
+
+PropagateGradientsReq::PropagateGradientsReq(
+    std::vector<Entry> entries,
+    bool retainGraph)
+    : entries_(std::move(entries)), retainGraph_(retainGraph) {}
 
 Message PropagateGradientsReq::toMessageImpl() && {
   std::vector<at::IValue> ivalues;
-  // Add all the grad tensors.
-  for (const auto& grad : grads_) {
-    ivalues.emplace_back(grad);
+  // Add one (autogradContextId, autogradMessageId, grads) tuple per entry.
+  for (auto& entry : entries_) {
+    ivalues.emplace_back(c10::ivalue::Tuple::create(
+        {entry.autogradMetadata.autogradContextId,
+         entry.autogradMetadata.autogradMessageId,
+         c10::List<at::Tensor>(entry.grads)}));
   }
 
-  // Now add autograd metadata.
-  ivalues.emplace_back(autogradMetadata_.autogradContextId);
-  ivalues.emplace_back(autogradMetadata_.autogradMessageId);
-
   // Add retain graph.
   ivalues.emplace_back(retainGraph_);
 
@@ -53,41 +57,33 @@ std::unique_ptr<PropagateGradientsReq> PropagateGradientsReq::fromMessage(
       payload_size,
       *rpc::RpcAgent::getCurrentRpcAgent()->getTypeResolver(),
       &message.tensors());
-  std::vector<at::IValue> tupleElements = tuple.toTuple()->elements();
+  const auto& tupleElements = tuple.toTuple()->elements();
 
   // Build PropagateGradientsReq.
-  TORCH_INTERNAL_ASSERT(tupleElements.size() >= 3);
+  TORCH_INTERNAL_ASSERT(tupleElements.size() >= 2);
 
   // Retrieve retainGraph.
   bool retainGraph = tupleElements.back().toBool();
-  tupleElements.pop_back();
 
-  // Build AutogradMetadata.
-  int64_t autogradContextId, autogradMessageId;
-  autogradMessageId = tupleElements.back().toInt();
-  tupleElements.pop_back();
-  autogradContextId = tupleElements.back().toInt();
-  tupleElements.pop_back();
-
-  AutogradMetadata autogradMetadata(autogradContextId, autogradMessageId);
-
-  // Retrieve the gradient tensors.
-  std::vector<Variable> grads(tupleElements.size());
-  for (size_t i = 0; i < tupleElements.size(); i++) {
-    grads[i] = tupleElements[i].toTensor();
+  // Retrieve the entries.
+  std::vector<Entry> entries;
+  entries.reserve(tupleElements.size() - 1);
+  for (size_t i = 0; i + 1 < tupleElements.size(); i++) {
+    const auto& entryElements = tupleElements[i].toTuple()->elements();
+    TORCH_INTERNAL_ASSERT(entryElements.size() == 3);
+    AutogradMetadata autogradMetadata(
+        entryElements[0].toInt(), entryElements[1].toInt());
+    entries.push_back(
+        Entry{autogradMetadata, entryElements[2].toTensorVector()});
   }
 
   return std::unique_ptr<PropagateGradientsReq>(
-      new PropagateGradientsReq(autogradMetadata, grads, retainGraph));
-}
-
-const AutogradMetadata& PropagateGradientsReq::getAutogradMetadata() {
-  return autogradMetadata_;
+      new PropagateGradientsReq(std::move(entries), retainGraph));
 }
 
-const std::vector<torch::autograd::Variable>& PropagateGradientsReq::
-    getGrads() {
-  return grads_;
+const std::vector<PropagateGradientsReq::Entry>& PropagateGradientsReq::
+    getEntries() {
+  return entries_;
 }
 
 bool PropagateGradientsReq::retainGraph() {
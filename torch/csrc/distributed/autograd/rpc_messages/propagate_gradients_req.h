@@ -11,17 +11,24 @@ namespace autograd {
 
 // Used to propagate gradients from one node to another during a distributed
 // backwards pass. This RPC call is invoked when we hit a `recv` autograd
-// function during backward pass execution.
+// function during backward pass execution. A single request can carry the
+// gradients of several `recv` functions bound for the same node, one entry
+// per `send` function to execute on that node.
 class TORCH_API PropagateGradientsReq : public rpc::RpcCommandBase {
  public:
+  struct Entry {
+    AutogradMetadata autogradMetadata;
+    std::vector<torch::autograd::Variable> grads;
+  };
+
   PropagateGradientsReq(
       const AutogradMetadata& autogradMetadata,
       std::vector<torch::autograd::Variable> grads,
       bool retainGraph = false);
 
-  const AutogradMetadata& getAutogradMetadata();
+  PropagateGradientsReq(std::vector<Entry> entries, bool retainGraph = false);
 
-  const std::vector<torch::autograd::Variable>& getGrads();
+  const std::vector<Entry>& getEntries();
 
   // Serialization and deserialization methods.
   rpc::Message toMessageImpl() && override;
@@ -32,8 +39,7 @@ class TORCH_API PropagateGradientsReq : public rpc::RpcCommandBase {
   bool retainGraph();
 
  private:
-  AutogradMetadata autogradMetadata_;
-  std::vector<torch::autograd::Variable> grads_;
+  std::vector<Entry> entries_;
   bool retainGraph_;
 };
 
@@ -148,8 +148,9 @@ void _register_comm_hook(
 // function of the reducer input to set the hook type.
 void _register_builtin_comm_hook(
     ::c10d::Reducer& reducer,
-    ::c10d::BuiltinCommHookType comm_hook_type) {
-  reducer.register_builtin_comm_hook(comm_hook_type);
+    ::c10d::BuiltinCommHookType comm_hook_type,
+    const ::c10d::BuiltinCommHookOptions& options) {
+  reducer.register_builtin_comm_hook(comm_hook_type, options);
 }
 
 PyObject* c10d_init(PyObject* _unused, PyObject* noargs) {
@@ -182,7 +183,8 @@ PyObject* c10d_init(PyObject* _unused, PyObject* noargs) {
           "_register_builtin_comm_hook",
           &_register_builtin_comm_hook,
           py::arg("reducer"),
-          py::arg("comm_hook_type"));
+          py::arg("comm_hook_type"),
+          py::arg("options") = ::c10d::BuiltinCommHookOptions());
 
   shared_ptr_class_<::c10d::GradBucket>(module, "GradBucket")
       .def(
@@ -238,9 +240,38 @@ Returns:
 )");
 
   py::enum_<::c10d::BuiltinCommHookType>(module, "BuiltinCommHookType", R"(
-An enum-like class for built-in communication hooks: ``ALLREDUCE`` and ``FP16_COMPRESS``.)")
+An enum-like class for built-in communication hooks: ``ALLREDUCE``, ``FP16_COMPRESS``,
+``POWER_SGD`` and ``TOPK_COMPRESS``.)")
       .value("ALLREDUCE", ::c10d::BuiltinCommHookType::ALLREDUCE)
-      .value("FP16_COMPRESS", ::c10d::BuiltinCommHookType::FP16_COMPRESS);
+      .value("FP16_COMPRESS", ::c10d::BuiltinCommHookType::FP16_COMPRESS)
+      .value("POWER_SGD", ::c10d::BuiltinCommHookType::POWER_SGD)
+      .value("TOPK_COMPRESS", ::c10d::BuiltinCommHookType::TOPK_COMPRESS);
+
+  py::class_<::c10d::BuiltinCommHookOptions>(
+      module,
+      "BuiltinCommHookOptions",
+      R"(
+Hyperparameters of the built-in communication hooks. The fields that do not apply
+to the registered hook type are ignored.)")
+      .def(py::init<>())
+      .def_readwrite(
+          "matrix_approximation_rank",
+          &::c10d::BuiltinCommHookOptions::matrix_approximation_rank)
+      .def_readwrite(
+          "start_powerSGD_iter",
+          &::c10d::BuiltinCommHookOptions::start_powerSGD_iter)
+      .def_readwrite(
+          "min_compression_rate",
+          &::c10d::BuiltinCommHookOptions::min_compression_rate)
+      .def_readwrite(
+          "use_error_feedback",
+          &::c10d::BuiltinCommHookOptions::use_error_feedback)
+      .def_readwrite(
+          "warm_start", &::c10d::BuiltinCommHookOptions::warm_start)
+      .def_readwrite(
+          "random_seed", &::c10d::BuiltinCommHookOptions::random_seed)
+      .def_readwrite(
+          "compress_ratio", &::c10d::BuiltinCommHookOptions::compress_ratio);
 
   shared_ptr_class_<::c10d::Reducer>(module, "Reducer")
       .def(
@@ -290,6 +321,25 @@ An enum-like class for built-in communication hooks: ``ALLREDUCE`` and ``FP16_CO
           "_push_all_rebuilt_params",
           &::c10d::Reducer::push_rebuilt_params_for_all_indices,
           py::call_guard<py::gil_scoped_release>())
+      .def(
+          "_set_bucket_bytes_cap_autotuning",
+          &::c10d::Reducer::set_bucket_bytes_cap_autotuning,
+          py::arg("bucket_bytes_cap_candidates"),
+          py::arg("iterations_per_candidate"),
+          py::call_guard<py::gil_scoped_release>())
+      .def(
+          "_set_gradient_sharding",
+          &::c10d::Reducer::set_gradient_sharding,
+          py::arg("enabled"),
+          py::call_guard<py::gil_scoped_release>())
+      .def(
+          "_set_static_graph",
+          &::c10d::Reducer::set_static_graph,
+          py::call_guard<py::gil_scoped_release>())
+      .def(
+          "_get_grad_shards",
+          &::c10d::Reducer::get_grad_shards,
+          py::call_guard<py::gil_scoped_release>())
       .def(
           "_set_forward_pass_work_handle",
           &::c10d::Reducer::set_forward_pass_work_handle,
@@ -373,7 +423,9 @@ They are used in specifying strategies for reduction collectives, e.g.,
   py::class_<::c10d::AllreduceOptions>(module, "AllreduceOptions")
       .def(py::init<>())
       .def_readwrite("reduceOp", &::c10d::AllreduceOptions::reduceOp)
-      .def_readwrite("timeout", &::c10d::AllreduceOptions::timeout);
+      .def_readwrite("timeout", &::c10d::AllreduceOptions::timeout)
+      .def_readwrite(
+          "high_priority", &::c10d::AllreduceOptions::highPriority);
 
   py::class_<::c10d::AllreduceCoalescedOptions>(
       module, "AllreduceCoalescedOptions")
@@ -769,7 +821,58 @@ Example::
       .def_property_readonly(
           "port",
           &::c10d::TCPStore::getPort,
-          R"(Gets the port number on which the store listens for requests.)");
+          R"(Gets the port number on which the store listens for requests.)")
+      // Convert from std::vector<uint8_t> to py::bytes.
+      .def(
+          "multi_get",
+          [](::c10d::TCPStore& store, const std::vector<std::string>& keys) {
+            std::vector<std::vector<uint8_t>> values;
+            {
+              py::gil_scoped_release release;
+              values = store.multiGet(keys);
+            }
+            py::list result;
+            for (auto& value : values) {
+              result.append(py::bytes(
+                  reinterpret_cast<char*>(value.data()), value.size()));
+            }
+            return result;
+          },
+          py::arg("keys"),
+          R"(
+Retrieves the values associated with the given ``keys`` in a single round trip
+to the server store, waiting for ``timeout`` for all of them to be set.
+
+Arguments:
+    keys (list): List of keys to retrieve.
+
+Returns:
+    A list with the value associated with each key.
+)")
+      // Convert from std::string to std::vector<uint8>.
+      .def(
+          "multi_set",
+          [](::c10d::TCPStore& store,
+             const std::vector<std::string>& keys,
+             const std::vector<std::string>& values) {
+            std::vector<std::vector<uint8_t>> values_;
+            values_.reserve(values.size());
+            for (const auto& value : values) {
+              values_.emplace_back(value.begin(), value.end());
+            }
+            store.multiSet(keys, values_);
+          },
+          py::call_guard<py::gil_scoped_release>(),
+          py::arg("keys"),
+          py::arg("values"),
+          R"(
+Inserts several key-value pairs into the store with a single query to the
+server store. Keys that already exist in the store are overwritten.
+
+Arguments:
+    keys (list): List of keys to insert.
+    values (list): List of values, one for each key.
+)");
 
   intrusive_ptr_class_<::c10d::PrefixStore>(
       module,
@@ -1076,7 +1179,13 @@ Arguments:
       .def(py::init<>())
       .def_readwrite("devices", &::c10d::ProcessGroupGloo::Options::devices)
       .def_readwrite("timeout", &::c10d::ProcessGroupGloo::Options::timeout)
-      .def_readwrite("threads", &::c10d::ProcessGroupGloo::Options::threads);
+      .def_readwrite("threads", &::c10d::ProcessGroupGloo::Options::threads)
+      .def_readwrite(
+          "pipelined_allreduce_min_bytes",
+          &::c10d::ProcessGroupGloo::Options::pipelinedAllreduceMinBytes)
+      .def_readwrite(
+          "pipelined_allreduce_chunk_bytes",
+          &::c10d::ProcessGroupGloo::Options::pipelinedAllreduceChunkBytes);
 
   processGroupGloo.def_static(
       "create_device",
@@ -1172,7 +1281,19 @@ Arguments:
           "is_high_priority",
           &::c10d::ProcessGroupNCCL::Options::isHighPriorityStream)
       .def_readwrite(
-          "op_timeout", &::c10d::ProcessGroupNCCL::Options::opTimeout);
+          "op_timeout", &::c10d::ProcessGroupNCCL::Options::opTimeout)
+      .def_readwrite(
+          "hierarchical_allreduce",
+          &::c10d::ProcessGroupNCCL::Options::hierarchicalAllreduce)
+      .def_readwrite(
+          "priority_allreduce",
+          &::c10d::ProcessGroupNCCL::Options::priorityAllreduce)
+      .def_readwrite(
+          "allreduce_stripes",
+          &::c10d::ProcessGroupNCCL::Options::allreduceStripes)
+      .def_readwrite(
+          "allreduce_stripe_min_bytes",
+          &::c10d::ProcessGroupNCCL::Options::allreduceStripeMinBytes);
   processGroupNCCL.def_static(
       "_group_start", []() { ::c10d::ProcessGroupNCCL::groupStart(); });
   processGroupNCCL.def_static(
@@ -1326,6 +1447,9 @@ py::class_<c10::DDPLoggingData>(module, "DDPLoggingData")
           "has_rebuilt_buckets", &c10::DDPLoggingData::has_rebuilt_buckets)
       .def_readwrite(
           "rebuilt_bucket_sizes", &c10::DDPLoggingData::rebuilt_bucket_sizes)
+      .def_readwrite(
+          "autotuned_bucket_cap_mb",
+          &c10::DDPLoggingData::autotuned_bucket_cap_mb)
       .def_readwrite(
           "avg_forward_compute_time",
           &c10::DDPLoggingData::avg_forward_compute_time)
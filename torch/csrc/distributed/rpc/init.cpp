@@ -619,6 +619,15 @@ PyObject* rpc_init(PyObject* _unused, PyObject* noargs) {
           "device_maps",
           &TensorPipeRpcBackendOptions::deviceMaps,
           R"(The device map locations.)")
+      .def_readwrite(
+          "_max_batch_size",
+          &TensorPipeRpcBackendOptions::maxBatchSize,
+          R"(
+              The maximum number of CPU-only requests to the same worker that
+              :class:`~torch.distributed.rpc.TensorPipeAgent` coalesces into
+              a single write while a previous write is in flight. ``1``
+              disables batching.
+          )")
       .def("set_device_map", &TensorPipeRpcBackendOptions::setDeviceMap);
 
   module.attr("_DEFAULT_NUM_WORKER_THREADS") =
@@ -679,7 +688,46 @@ PyObject* rpc_init(PyObject* _unused, PyObject* noargs) {
       .def(
           "_set_reverse_device_maps",
           // intentionally not releasing GIL to avoid unnecessary context switch
-          &TensorPipeAgent::setReverseDeviceMaps);
+          &TensorPipeAgent::setReverseDeviceMaps)
+      .def(
+          "_get_metrics_snapshot",
+          [](TensorPipeAgent& agent) {
+            DefaultRpcMetricsHandler::Snapshot snapshot;
+            {
+              py::gil_scoped_release release;
+              snapshot = agent.getMetricsSnapshot();
+            }
+            py::dict histograms;
+            for (const auto& entry : snapshot.histograms) {
+              const auto& histogram = entry.second;
+              py::dict pyHistogram;
+              pyHistogram["count"] = histogram.count;
+              pyHistogram["sum"] = histogram.sum;
+              pyHistogram["max"] = histogram.max;
+              pyHistogram["p50"] = histogram.percentile(50);
+              pyHistogram["p90"] = histogram.percentile(90);
+              pyHistogram["p99"] = histogram.percentile(99);
+              pyHistogram["buckets"] = std::vector<uint64_t>(
+                  histogram.buckets.begin(), histogram.buckets.end());
+              histograms[py::str(entry.first)] = std::move(pyHistogram);
+            }
+            py::dict result;
+            result["histograms"] = std::move(histograms);
+            result["counters"] = snapshot.counters;
+            result["gauges"] = snapshot.gauges;
+            return result;
+          },
+          R"(
+              Returns the agent's built-in metrics as a dict with the keys
+              ``histograms``, ``counters`` and ``gauges``. Histograms have
+              power-of-two buckets, where bucket ``i > 0`` counts values in
+              ``[2^(i-1), 2^i)``, and come with their count, sum, max and
+              upper bounds of the p50, p90 and p99.
+          )")
+      .def(
+          "_reset_metrics",
+          &TensorPipeAgent::resetMetrics,
+          py::call_guard<py::gil_scoped_release>());
 
 #endif // USE_TENSORPIPE
 
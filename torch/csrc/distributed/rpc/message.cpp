@@ -1,5 +1,7 @@
 #include <torch/csrc/distributed/rpc/message.h>
 
+#include <cstring>
+
 namespace torch {
 namespace distributed {
 namespace rpc {
@@ -104,6 +106,87 @@ Message createExceptionResponse(const std::string& exceptionStr, int64_t id) {
       id);
 }
 
+Message createBatchedRequestsMessage(std::vector<Message>&& requests) {
+  TORCH_INTERNAL_ASSERT(!requests.empty(), "Cannot batch zero requests");
+  const size_t headerSize = sizeof(int64_t) * (1 + 4 * requests.size());
+  size_t payloadSize = headerSize;
+  size_t numTensors = 0;
+  for (const auto& request : requests) {
+    TORCH_INTERNAL_ASSERT(
+        request.isRequest() && request.type() != BATCHED_REQUESTS,
+        "Cannot batch a message of type ",
+        request.type());
+    payloadSize += request.payload().size();
+    numTensors += request.tensors().size();
+  }
+
+  std::vector<char> payload(payloadSize);
+  std::vector<torch::Tensor> tensors;
+  tensors.reserve(numTensors);
+  int64_t* header = reinterpret_cast<int64_t*>(payload.data());
+  char* data = payload.data() + headerSize;
+  *header++ = requests.size();
+  for (auto& request : requests) {
+    *header++ = request.type();
+    *header++ = request.id();
+    *header++ = request.payload().size();
+    *header++ = request.tensors().size();
+    std::memcpy(data, request.payload().data(), request.payload().size());
+    data += request.payload().size();
+    for (auto& tensor : request.tensors()) {
+      tensors.emplace_back(std::move(tensor));
+    }
+  }
+
+  return Message(
+      std::move(payload),
+      std::move(tensors),
+      MessageType::BATCHED_REQUESTS,
+      requests.front().id());
+}
+
+std::vector<Message> splitBatchedRequestsMessage(Message&& batch) {
+  TORCH_INTERNAL_ASSERT(
+      batch.type() == MessageType::BATCHED_REQUESTS,
+      "Expected a message of type BATCHED_REQUESTS, got ",
+      batch.type());
+  const auto& payload = batch.payload();
+  auto& tensors = batch.tensors();
+  TORCH_CHECK(payload.size() >= sizeof(int64_t), "Malformed batch of requests");
+  const int64_t* header = reinterpret_cast<const int64_t*>(payload.data());
+  const int64_t numRequests = *header++;
+  const size_t headerSize = sizeof(int64_t) * (1 + 4 * numRequests);
+  TORCH_CHECK(
+      numRequests > 0 && payload.size() >= headerSize,
+      "Malformed batch of requests");
+
+  std::vector<Message> requests;
+  requests.reserve(numRequests);
+  size_t payloadOffset = headerSize;
+  size_t tensorOffset = 0;
+  for (int64_t i = 0; i < numRequests; ++i) {
+    const auto type = static_cast<MessageType>(*header++);
+    const int64_t id = *header++;
+    const size_t payloadSize = *header++;
+    const size_t numTensors = *header++;
+    TORCH_CHECK(
+        payloadOffset + payloadSize <= payload.size() &&
+            tensorOffset + numTensors <= tensors.size(),
+        "Malformed batch of requests");
+    std::vector<char> requestPayload(
+        payload.begin() + payloadOffset,
+        payload.begin() + payloadOffset + payloadSize);
+    std::vector<torch::Tensor> requestTensors(
+        std::make_move_iterator(tensors.begin() + tensorOffset),
+        std::make_move_iterator(tensors.begin() + tensorOffset + numTensors));
+    requests.emplace_back(
+        std::move(requestPayload), std::move(requestTensors), type, id);
+    payloadOffset += payloadSize;
+    tensorOffset += numTensors;
+  }
+  return requests;
+}
+
 namespace {
 
 // NB: need to call torch::class_ to register Message in the map returned by
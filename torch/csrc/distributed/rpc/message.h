@@ -84,6 +84,10 @@ enum MessageType {
   RREF_BACKWARD_REQ = 23 | MessageTypeFlags::REQUEST_TYPE,
   RREF_BACKWARD_RESP = 24 | MessageTypeFlags::RESPONSE_TYPE,
 
+  // Several requests coalesced by the agent into a single message. They are
+  // split again on the receiving side and each gets its own response.
+  BATCHED_REQUESTS = 25 | MessageTypeFlags::REQUEST_TYPE,
+
   // Other internal message types
   EXCEPTION = 55 | MessageTypeFlags::RESPONSE_TYPE,
   UNKNOWN = 60
@@ -169,6 +173,16 @@ TORCH_API Message createExceptionResponse(const std::exception& e, int64_t id);
 TORCH_API Message
 createExceptionResponse(const std::string& exceptionStr, int64_t id);
 
+// Coalesce several request Messages into a single BATCHED_REQUESTS Message,
+// which can be sent with a single write. The payload of the batch contains a
+// header with the type, id, payload size and number of tensors of every
+// request, followed by their payloads. The tensors of all requests are
+// concatenated. The batch takes the id of its first request.
+TORCH_API Message createBatchedRequestsMessage(std::vector<Message>&& requests);
+
+// Split a BATCHED_REQUESTS Message back into the requests it contains.
+TORCH_API std::vector<Message> splitBatchedRequestsMessage(Message&& batch);
+
 using JitFuture = c10::ivalue::Future;
 
 } // namespace rpc
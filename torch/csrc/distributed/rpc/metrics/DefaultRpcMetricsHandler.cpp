@@ -0,0 +1,186 @@
+#include <torch/csrc/distributed/rpc/metrics/DefaultRpcMetricsHandler.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <c10/util/StringUtil.h>
+#include <c10/util/llvmMathExtras.h>
+
+namespace torch {
+namespace distributed {
+namespace rpc {
+
+namespace {
+
+size_t bucketIndex(uint64_t value) {
+  if (value == 0) {
+    return 0;
+  }
+  size_t index = 64 - c10::llvm::countLeadingZeros(value);
+  return std::min(index, RpcMetricsHistogram::kNumBuckets - 1);
+}
+
+uint64_t bucketUpperBound(size_t index) {
+  if (index == 0) {
+    return 0;
+  }
+  if (index >= 64) {
+    return std::numeric_limits<uint64_t>::max();
+  }
+  return (uint64_t(1) << index) - 1;
+}
+
+} // namespace
+
+uint64_t RpcMetricsHistogram::Snapshot::percentile(double p) const {
+  if (count == 0) {
+    return 0;
+  }
+  const uint64_t target = std::max<uint64_t>(
+      1, static_cast<uint64_t>(std::ceil(p / 100.0 * count)));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    seen += buckets[i];
+    if (seen >= target) {
+      return std::min(bucketUpperBound(i), max);
+    }
+  }
+  return max;
+}
+
+RpcMetricsHistogram::RpcMetricsHistogram() {
+  for (auto& bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+}
+
+void RpcMetricsHistogram::record(uint64_t value) {
+  buckets_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(value, std::memory_order_relaxed);
+  uint64_t prevMax = max_.load(std::memory_order_relaxed);
+  while (value > prevMax &&
+         !max_.compare_exchange_weak(
+             prevMax, value, std::memory_order_relaxed)) {
+  }
+}
+
+RpcMetricsHistogram::Snapshot RpcMetricsHistogram::snapshot() const {
+  Snapshot snapshot;
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    snapshot.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+    snapshot.count += snapshot.buckets[i];
+  }
+  snapshot.sum = sum_.load(std::memory_order_relaxed);
+  snapshot.max = max_.load(std::memory_order_relaxed);
+  return snapshot;
+}
+
+void RpcMetricsHistogram::reset() {
+  for (auto& bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  sum_.store(0, std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+void DefaultRpcMetricsHandler::accumulateMetric(
+    const std::string& name,
+    double value) {
+  histogram(name).record(value > 0 ? static_cast<uint64_t>(value) : 0);
+}
+
+void DefaultRpcMetricsHandler::incrementMetric(const std::string& name) {
+  counter(name).fetch_add(1, std::memory_order_relaxed);
+}
+
+RpcMetricsHistogram& DefaultRpcMetricsHandler::histogram(
+    const std::string& name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& histogram = histograms_[name];
+  if (!histogram) {
+    histogram = std::make_unique<RpcMetricsHistogram>();
+  }
+  return *histogram;
+}
+
+std::atomic<uint64_t>& DefaultRpcMetricsHandler::counter(
+    const std::string& name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& counter = counters_[name];
+  if (!counter) {
+    counter = std::make_unique<std::atomic<uint64_t>>(0);
+  }
+  return *counter;
+}
+
+std::atomic<int64_t>& DefaultRpcMetricsHandler::gauge(const std::string& name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& gauge = gauges_[name];
+  if (!gauge) {
+    gauge = std::make_unique<std::atomic<int64_t>>(0);
+  }
+  return *gauge;
+}
+
+DefaultRpcMetricsHandler::Snapshot DefaultRpcMetricsHandler::snapshot() const {
+  Snapshot snapshot;
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& entry : histograms_) {
+    snapshot.histograms.emplace(entry.first, entry.second->snapshot());
+  }
+  for (const auto& entry : counters_) {
+    snapshot.counters.emplace(
+        entry.first, entry.second->load(std::memory_order_relaxed));
+  }
+  for (const auto& entry : gauges_) {
+    snapshot.gauges.emplace(
+        entry.first, entry.second->load(std::memory_order_relaxed));
+  }
+  return snapshot;
+}
+
+std::unordered_map<std::string, std::string> DefaultRpcMetricsHandler::summary()
+    const {
+  std::unordered_map<std::string, std::string> summary;
+  auto snap = snapshot();
+  for (const auto& entry : snap.histograms) {
+    const auto& name = entry.first;
+    const auto& histogram = entry.second;
+    summary[name + ".count"] = c10::to_string(histogram.count);
+    summary[name + ".mean"] = c10::to_string(
+        histogram.count == 0 ? 0.0
+                             : static_cast<double>(histogram.sum) /
+                static_cast<double>(histogram.count));
+    summary[name + ".p50"] = c10::to_string(histogram.percentile(50));
+    summary[name + ".p90"] = c10::to_string(histogram.percentile(90));
+    summary[name + ".p99"] = c10::to_string(histogram.percentile(99));
+    summary[name + ".max"] = c10::to_string(histogram.max);
+  }
+  for (const auto& entry : snap.counters) {
+    summary[entry.first] = c10::to_string(entry.second);
+  }
+  for (const auto& entry : snap.gauges) {
+    summary[entry.first] = c10::to_string(entry.second);
+  }
+  return summary;
+}
+
+void DefaultRpcMetricsHandler::reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& entry : histograms_) {
+    entry.second->reset();
+  }
+  for (auto& entry : counters_) {
+    entry.second->store(0, std::memory_order_relaxed);
+  }
+}
+
+C10_REGISTER_CLASS(
+    RpcMetricsHandlerRegistry,
+    DefaultRpcMetricsHandler,
+    DefaultRpcMetricsHandler);
+
+} // namespace rpc
+} // namespace distributed
+} // namespace torch
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <torch/csrc/distributed/rpc/metrics/RpcMetricsHandler.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <c10/macros/Export.h>
+
+namespace torch {
+namespace distributed {
+namespace rpc {
+
+// A histogram with power-of-two buckets whose updates are lock-free. Bucket 0
+// counts the value 0 and bucket i > 0 counts values in [2^(i-1), 2^i), with
+// the last bucket also absorbing everything larger. Values are unit-agnostic;
+// the agent records latencies in microseconds.
+class TORCH_API RpcMetricsHistogram {
+ public:
+  static constexpr size_t kNumBuckets = 40;
+
+  struct Snapshot {
+    uint64_t count{0};
+    uint64_t sum{0};
+    uint64_t max{0};
+    std::array<uint64_t, kNumBuckets> buckets{};
+
+    // Returns an upper bound on the given percentile (in [0, 100]), i.e., the
+    // upper edge of the bucket that contains it, capped at the maximum.
+    uint64_t percentile(double p) const;
+  };
+
+  RpcMetricsHistogram();
+
+  void record(uint64_t value);
+  Snapshot snapshot() const;
+  void reset();
+
+ private:
+  std::array<std::atomic<uint64_t>, kNumBuckets> buckets_;
+  std::atomic<uint64_t> sum_{0};
+  std::atomic<uint64_t> max_{0};
+};
+
+// The metrics handler used by default by the RPC agents. It keeps named
+// histograms, monotonic counters and gauges. Looking a metric up by name takes
+// a lock, but the returned references stay valid for the lifetime of the
+// handler, so that hot paths can resolve them once and then update them with
+// plain atomic operations.
+class TORCH_API DefaultRpcMetricsHandler : public RpcMetricsHandler {
+ public:
+  struct Snapshot {
+    std::unordered_map<std::string, RpcMetricsHistogram::Snapshot> histograms;
+    std::unordered_map<std::string, uint64_t> counters;
+    std::unordered_map<std::string, int64_t> gauges;
+  };
+
+  // Records value into the histogram called name.
+  void accumulateMetric(const std::string& name, double value) override;
+  // Increments the counter called name by one.
+  void incrementMetric(const std::string& name) override;
+
+  RpcMetricsHistogram& histogram(const std::string& name);
+  std::atomic<uint64_t>& counter(const std::string& name);
+  std::atomic<int64_t>& gauge(const std::string& name);
+
+  // Returns a consistent-per-metric copy of all metrics, for export.
+  Snapshot snapshot() const;
+
+  // Returns a flattened summary of all metrics, suitable for debug info. Each
+  // histogram contributes its count, mean, p50, p90, p99 and max.
+  std::unordered_map<std::string, std::string> summary() const;
+
+  // Resets histograms and counters. Gauges track live state and are kept.
+  void reset();
+
+ private:
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, std::unique_ptr<RpcMetricsHistogram>>
+      histograms_;
+  std::unordered_map<std::string, std::unique_ptr<std::atomic<uint64_t>>>
+      counters_;
+  std::unordered_map<std::string, std::unique_ptr<std::atomic<int64_t>>>
+      gauges_;
+};
+
+} // namespace rpc
+} // namespace distributed
+} // namespace torch
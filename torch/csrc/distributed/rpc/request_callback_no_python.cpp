@@ -430,34 +430,68 @@ void RequestCallbackNoPython::processBackwardAutogradReq(
     const int64_t messageId,
     const std::shared_ptr<JitFuture>& responseFuture) const {
   auto& gradientsCall = static_cast<PropagateGradientsReq&>(rpc);
-  const auto& autogradMetadata = gradientsCall.getAutogradMetadata();
-
-  // Retrieve the appropriate autograd context.
-  auto autogradContext = DistAutogradContainer::getInstance().retrieveContext(
-      autogradMetadata.autogradContextId);
-
-  // Lookup the appropriate 'send' function to enqueue.
-  std::shared_ptr<SendRpcBackward> sendFunction =
-      autogradContext->retrieveSendFunction(autogradMetadata.autogradMessageId);
-
-  // Attach the gradients to the send function.
-  sendFunction->setGrads(gradientsCall.getGrads());
-
-  // Now execute the autograd graph using the "distributed engine."
-  auto execFuture = DistEngine::getInstance().executeSendFunctionAsync(
-      autogradContext, sendFunction, gradientsCall.retainGraph());
-
-  // Our response is satisfied when the rpcs come back.
-  execFuture->addCallback([responseFuture, messageId, execFuture]() {
-    if (!execFuture->hasError()) {
-      Message m = std::move(PropagateGradientsResp()).toMessage();
-      m.setId(messageId);
-      responseFuture->markCompleted(
-          IValue(c10::make_intrusive<Message>(std::move(m))));
-    } else {
-      responseFuture->setError(execFuture->exception_ptr());
-    }
-  });
+  const auto& entries = gradientsCall.getEntries();
+
+  // The request carries one entry per 'send' function to execute, and our
+  // response is satisfied when all of them are done.
+  struct State {
+    explicit State(size_t count) : remaining(count) {}
+    std::mutex mutex;
+    size_t remaining;
+    std::exception_ptr error;
+  };
+  auto state = std::make_shared<State>(entries.size());
+
+  // Lookup all the 'send' functions before running any of them, so that an
+  // invalid entry fails the request before anything was enqueued.
+  std::vector<std::pair<ContextPtr, std::shared_ptr<SendRpcBackward>>>
+      sendFunctions;
+  for (const auto& entry : entries) {
+    const auto& autogradMetadata = entry.autogradMetadata;
+
+    // Retrieve the appropriate autograd context.
+    auto autogradContext = DistAutogradContainer::getInstance().retrieveContext(
+        autogradMetadata.autogradContextId);
+
+    // Lookup the appropriate 'send' function to enqueue.
+    std::shared_ptr<SendRpcBackward> sendFunction =
+        autogradContext->retrieveSendFunction(
+            autogradMetadata.autogradMessageId);
+    sendFunctions.emplace_back(
+        std::move(autogradContext), std::move(sendFunction));
+  }
+
+  for (size_t i = 0; i < entries.size(); i++) {
+    const auto& autogradContext = sendFunctions[i].first;
+    const auto& sendFunction = sendFunctions[i].second;
+
+    // Attach the gradients to the send function.
+    sendFunction->setGrads(entries[i].grads);
+
+    // Now execute the autograd graph using the "distributed engine."
+    auto execFuture = DistEngine::getInstance().executeSendFunctionAsync(
+        autogradContext, sendFunction, gradientsCall.retainGraph());
+
+    // Our response is satisfied when the rpcs come back.
+    execFuture->addCallback([responseFuture, messageId, execFuture, state]() {
+      std::unique_lock<std::mutex> lock(state->mutex);
+      if (execFuture->hasError() && !state->error) {
+        state->error = execFuture->exception_ptr();
+      }
+      if (--state->remaining > 0) {
+        return;
+      }
+      lock.unlock();
+      if (!state->error) {
+        Message m = std::move(PropagateGradientsResp()).toMessage();
+        m.setId(messageId);
+        responseFuture->markCompleted(
+            IValue(c10::make_intrusive<Message>(std::move(m))));
+      } else {
+        responseFuture->setError(state->error);
+      }
+    });
+  }
 }
 
 void RequestCallbackNoPython::processCleanupAutogradContextReq(
@@ -2,6 +2,7 @@
 
 #ifdef USE_TENSORPIPE
 
+#include <algorithm>
 #include <limits>
 #include <tuple>
 #include <utility>
@@ -41,6 +42,44 @@ const std::string kClientActiveCalls = "agent.client_active_calls";
 const std::string kServerActiveCalls = "agent.server_active_calls";
 const std::string kServerActiveAsyncCalls = "agent.server_active_async_calls";
 
+const std::string kLatencyByDestination =
+    std::string(kRpcMetricsKeyPrefix) + "latency_us.destination.";
+const std::string kLatencyByMessageType =
+    std::string(kRpcMetricsKeyPrefix) + "latency_us.message_type.";
+const std::string kSerializationTime =
+    std::string(kRpcMetricsKeyPrefix) + "serialization_time_us";
+const std::string kDeserializationTime =
+    std::string(kRpcMetricsKeyPrefix) + "deserialization_time_us";
+const std::string kBytesSent = std::string(kRpcMetricsKeyPrefix) + "bytes_sent";
+const std::string kBytesReceived =
+    std::string(kRpcMetricsKeyPrefix) + "bytes_received";
+const std::string kThreadPoolQueueDepth =
+    std::string(kRpcMetricsKeyPrefix) + "thread_pool_queue_depth";
+const std::string kPendingResponses =
+    std::string(kRpcMetricsKeyPrefix) + "pending_responses";
+const std::string kPendingBatchedRequests =
+    std::string(kRpcMetricsKeyPrefix) + "pending_batched_requests";
+const std::string kClientInFlightCalls =
+    std::string(kRpcMetricsKeyPrefix) + "client_in_flight_calls";
+const std::string kServerInFlightCalls =
+    std::string(kRpcMetricsKeyPrefix) + "server_in_flight_calls";
+
+// Approximates the bytes a message occupies on the wire by its payload and the
+// storages of its tensors, which is what gets transferred.
+uint64_t messageNumBytes(const Message& message) {
+  uint64_t numBytes = message.payload().size();
+  for (const auto& tensor : message.tensors()) {
+    numBytes += tensor.storage().nbytes();
+  }
+  return numBytes;
+}
+
+uint64_t microsecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
 std::vector<c10::DeviceIndex> getDevicesForTensors(
     const std::vector<torch::Tensor>& tensors,
     const tensorpipe::DeviceMap& deviceMap,
@@ -468,6 +507,15 @@ TensorPipeAgent::TensorPipeAgent(
 
   // Initialize the time-series metrics tracking map
   timeSeriesMetrics_.emplace(kGilAverageWaitTime, TimeSeriesMetricsTracker());
+
+  serializationTimeUs_ = &metricsHandler_.histogram(kSerializationTime);
+  deserializationTimeUs_ = &metricsHandler_.histogram(kDeserializationTime);
+  bytesSent_ = &metricsHandler_.counter(kBytesSent);
+  bytesReceived_ = &metricsHandler_.counter(kBytesReceived);
+  threadPoolQueueDepth_ = &metricsHandler_.gauge(kThreadPoolQueueDepth);
+  for (auto& histogram : latencyHistogramByType_) {
+    histogram.store(nullptr, std::memory_order_relaxed);
+  }
 }
 
 TensorPipeAgent::~TensorPipeAgent() {
@@ -615,7 +663,7 @@ void TensorPipeAgent::pipeRead(
         const tensorpipe::Error&,
         Message&&,
         std::shared_ptr<LazyStreamContext>)> fn) noexcept {
-  pipe->readDescriptor([fn{std::move(fn)}, pipe](
+  pipe->readDescriptor([this, fn{std::move(fn)}, pipe](
                            const tensorpipe::Error& error,
                            tensorpipe::Message tpMessage) mutable {
     if (error) {
@@ -628,7 +676,8 @@ void TensorPipeAgent::pipeRead(
 
     pipe->read(
         std::move(tpMessage),
-        [tpBuffers{
+        [this,
+         tpBuffers{
              std::make_shared<TensorpipeReadBuffers>(std::move(tpBuffers))},
          fn{std::move(fn)},
          ctx{std::move(ctx)}](
@@ -641,8 +690,12 @@ void TensorPipeAgent::pipeRead(
 
           // FIXME This does some unpickling, which could be a bit expensive:
           // perhaps it would be best to perform it inside the worker threads?
+          auto startTime = std::chrono::steady_clock::now();
           Message rpcMessage = tensorpipeDeserialize(
               std::move(tpMessage), std::move(*tpBuffers));
+          deserializationTimeUs_->record(microsecondsSince(startTime));
+          bytesReceived_->fetch_add(
+              messageNumBytes(rpcMessage), std::memory_order_relaxed);
 
           fn(error, std::move(rpcMessage), std::move(ctx));
         });
@@ -660,8 +713,11 @@ void TensorPipeAgent::pipeWrite(
   tensorpipe::Message tpMessage;
   TensorpipeWriteBuffers tpBuffers;
 
+  bytesSent_->fetch_add(messageNumBytes(rpcMessage), std::memory_order_relaxed);
+  auto startTime = std::chrono::steady_clock::now();
   std::tie(tpMessage, tpBuffers) =
       tensorpipeSerialize(std::move(rpcMessage), std::move(devices), ctx);
+  serializationTimeUs_->record(microsecondsSince(startTime));
 
   pipe->write(
       std::move(tpMessage),
@@ -766,59 +822,77 @@ void TensorPipeAgent::respond(std::shared_ptr<tensorpipe::Pipe>& pipe) {
         // Arm for next read
         respond(pipe);
 
-        uint64_t messageId = requestMessage.id();
-        increaseCallCount(serverActiveCalls_);
-
-        VLOG(1) << "RPC agent for " << workerInfo_.name_
-                << " received request #" << messageId << " from "
-                << pipe->getRemoteName();
-
-        // Defer user RPC UDF run to thread pool
-        threadPool_.run([this,
-                         pipe,
-                         messageId,
-                         requestMessage{std::move(requestMessage)},
-                         ctx{std::move(ctx)}]() mutable {
-          // create guards again as this function runs on a different thread
-          MultiStreamGuard guard(ctx);
+        if (requestMessage.type() == MessageType::BATCHED_REQUESTS) {
           VLOG(1) << "RPC agent for " << workerInfo_.name_
-                  << " is running request #" << messageId << " from "
-                  << pipe->getRemoteName() << " in thread pool";
-
-          std::shared_ptr<JitFuture> futureResponseMessage;
-          try {
-            futureResponseMessage = cb_->operator()(requestMessage);
-          } catch (const std::exception& /* unused */) {
-            futureResponseMessage =
-                std::make_shared<JitFuture>(at::AnyClassType::get());
-            futureResponseMessage->setError(std::current_exception());
+                  << " received batch #" << requestMessage.id() << " from "
+                  << pipe->getRemoteName();
+          for (auto& subMessage :
+               splitBatchedRequestsMessage(std::move(requestMessage))) {
+            handleRequest(pipe, std::move(subMessage), ctx);
           }
+        } else {
+          handleRequest(pipe, std::move(requestMessage), std::move(ctx));
+        }
+      });
+}
 
-          // Shortcut if immediately done
-          if (futureResponseMessage->completed()) {
-            decreaseCallCount(serverActiveCalls_);
-            sendCompletedResponseMessage(
-                pipe, futureResponseMessage, messageId, std::move(ctx));
-          } else {
-            // Not complete yet
-            increaseCallCount(serverActiveAsyncCalls_);
-            futureResponseMessage->addCallback([this,
-                                                pipe,
-                                                futureResponseMessage,
-                                                messageId,
-                                                ctx{std::move(ctx)}]() mutable {
-              decreaseCallCount(serverActiveCalls_);
-              decreaseCallCount(serverActiveAsyncCalls_);
-              sendCompletedResponseMessage(
-                  pipe, futureResponseMessage, messageId, std::move(ctx));
-            });
-          }
+void TensorPipeAgent::handleRequest(
+    std::shared_ptr<tensorpipe::Pipe>& pipe,
+    Message&& requestMessage,
+    std::shared_ptr<LazyStreamContext> ctx) {
+  uint64_t messageId = requestMessage.id();
+  increaseCallCount(serverActiveCalls_);
+
+  VLOG(1) << "RPC agent for " << workerInfo_.name_ << " received request #"
+          << messageId << " from " << pipe->getRemoteName();
+
+  // Defer user RPC UDF run to thread pool
+  threadPoolQueueDepth_->fetch_add(1, std::memory_order_relaxed);
+  threadPool_.run([this,
+                   pipe,
+                   messageId,
+                   requestMessage{std::move(requestMessage)},
+                   ctx{std::move(ctx)}]() mutable {
+    threadPoolQueueDepth_->fetch_sub(1, std::memory_order_relaxed);
+    // create guards again as this function runs on a different thread
+    MultiStreamGuard guard(ctx);
+    VLOG(1) << "RPC agent for " << workerInfo_.name_
+            << " is running request #" << messageId << " from "
+            << pipe->getRemoteName() << " in thread pool";
 
-          VLOG(1) << "RPC agent for " << workerInfo_.name_
-                  << " done running request #" << messageId << " from "
-                  << pipe->getRemoteName() << " in thread pool";
-        });
+    std::shared_ptr<JitFuture> futureResponseMessage;
+    try {
+      futureResponseMessage = cb_->operator()(requestMessage);
+    } catch (const std::exception& /* unused */) {
+      futureResponseMessage =
+          std::make_shared<JitFuture>(at::AnyClassType::get());
+      futureResponseMessage->setError(std::current_exception());
+    }
+
+    // Shortcut if immediately done
+    if (futureResponseMessage->completed()) {
+      decreaseCallCount(serverActiveCalls_);
+      sendCompletedResponseMessage(
+          pipe, futureResponseMessage, messageId, std::move(ctx));
+    } else {
+      // Not complete yet
+      increaseCallCount(serverActiveAsyncCalls_);
+      futureResponseMessage->addCallback([this,
+                                          pipe,
+                                          futureResponseMessage,
+                                          messageId,
+                                          ctx{std::move(ctx)}]() mutable {
+        decreaseCallCount(serverActiveCalls_);
+        decreaseCallCount(serverActiveAsyncCalls_);
+        sendCompletedResponseMessage(
+            pipe, futureResponseMessage, messageId, std::move(ctx));
       });
+    }
+
+    VLOG(1) << "RPC agent for " << workerInfo_.name_
+            << " done running request #" << messageId << " from "
+            << pipe->getRemoteName() << " in thread pool";
+  });
 }
 
 std::shared_ptr<JitFuture> TensorPipeAgent::send(
@@ -857,12 +931,16 @@ std::shared_ptr<JitFuture> TensorPipeAgent::send(
           std::forward_as_tuple(toWorkerInfo.id_),
           std::forward_as_tuple(context_->connect(
               url, tensorpipe::PipeOptions().remoteName(toWorkerInfo.name_))));
+      it->second.latencyHistogram_ = &metricsHandler_.histogram(
+          kLatencyByDestination + toWorkerInfo.name_);
     }
   }
   ClientPipe& clientPipe = it->second;
 
   auto futureResponseMessage = std::make_shared<AtomicJitFuture>(
       reverseDeviceMaps_.empty() && opts_.deviceMaps.empty());
+  futureResponseMessage->startTime = std::chrono::steady_clock::now();
+  futureResponseMessage->messageType = requestMessage.type();
   uint64_t messageId = nextMessageID_++;
   requestMessage.setId(messageId);
 
@@ -919,14 +997,63 @@ std::shared_ptr<JitFuture> TensorPipeAgent::send(
   VLOG(1) << "RPC agent for " << workerInfo_.name_ << " is sending request #"
           << messageId << " to " << clientPipe.pipe_->getRemoteName();
 
+  // Only CPU-only requests are batched, as device maps and CUDA streams are
+  // tracked per write.
+  if (opts_.maxBatchSize > 1 && deviceMap.empty() &&
+      std::all_of(devices.begin(), devices.end(), [](c10::DeviceIndex d) {
+        return d == -1;
+      })) {
+    std::unique_lock<std::mutex> lock(clientPipe.mutex_);
+    if (clientPipe.batchWriteInFlight_) {
+      clientPipe.batchedRequests_.push_back(std::move(requestMessage));
+      if (clientPipe.batchedRequests_.size() <
+          static_cast<size_t>(opts_.maxBatchSize)) {
+        return futureResponseMessage->jitFuture;
+      }
+      // The batch is full, send it without waiting for the write in flight.
+      std::vector<Message> batch;
+      std::swap(batch, clientPipe.batchedRequests_);
+      lock.unlock();
+      const size_t numRequests = batch.size();
+      writeRequest(
+          clientPipe,
+          createBatchedRequestsMessage(std::move(batch)),
+          numRequests,
+          {},
+          createLazyStreamContext());
+      return futureResponseMessage->jitFuture;
+    }
+    clientPipe.batchWriteInFlight_ = true;
+  }
+
   auto ctx = createLazyStreamContext();
   ctx->waitForCurrentStreams(requestMessage.tensors());
+  writeRequest(
+      clientPipe,
+      std::move(requestMessage),
+      1,
+      std::move(devices),
+      std::move(ctx),
+      deviceMap);
+
+  return futureResponseMessage->jitFuture;
+}
+
+void TensorPipeAgent::writeRequest(
+    ClientPipe& clientPipe,
+    Message&& requestMessage,
+    size_t numRequests,
+    std::vector<c10::DeviceIndex>&& devices,
+    std::shared_ptr<LazyStreamContext> ctx,
+    const tensorpipe::DeviceMap& deviceMap) {
+  uint64_t messageId = requestMessage.id();
   pipeWrite(
       clientPipe.pipe_,
       std::move(requestMessage),
       std::move(devices),
       std::move(ctx),
-      [this, &clientPipe, messageId](const tensorpipe::Error& error) mutable {
+      [this, &clientPipe, messageId, numRequests](
+          const tensorpipe::Error& error) mutable {
         if (error) {
           if (error.isOfType<tensorpipe::PipeClosedError>() &&
               !rpcAgentRunning_.load()) {
@@ -945,71 +1072,111 @@ std::shared_ptr<JitFuture> TensorPipeAgent::send(
         VLOG(1) << "RPC agent for " << workerInfo_.name_ << " sent request #"
                 << messageId << " to " << clientPipe.pipe_->getRemoteName();
 
-        pipeRead(
-            clientPipe.pipe_,
-            [this, &clientPipe](
-                const tensorpipe::Error& error,
-                Message&& responseMessage,
-                std::shared_ptr<LazyStreamContext> ctx) {
-              if (error) {
-                if (error.isOfType<tensorpipe::PipeClosedError>() &&
-                    !rpcAgentRunning_.load()) {
-                  // This is expected.
-                } else {
-                  LOG(WARNING)
-                      << "RPC agent for " << workerInfo_.name_
-                      << " encountered error when reading incoming response from "
-                      << clientPipe.pipe_->getRemoteName() << ": "
-                      << error.what();
-                }
-                handleClientError(clientPipe, error);
-                return;
-              }
-
-              // Identify future response message by message ID
-              uint64_t messageId = responseMessage.id();
-
-              VLOG(1) << "RPC agent for " << workerInfo_.name_
-                      << " received response #" << messageId << " from "
-                      << clientPipe.pipe_->getRemoteName();
-
-              std::shared_ptr<AtomicJitFuture> futureResponseMessage;
-              {
-                std::lock_guard<std::mutex> lock(clientPipe.mutex_);
-                // A read error will lead all following callbacks to be
-                // invoked with error, and shouldn't reach here.
-                TORCH_INTERNAL_ASSERT(
-                    !clientPipe.inError_, "Shouldn't be in error state");
-                auto it = clientPipe.pendingResponseMessage_.find(messageId);
-                TORCH_INTERNAL_ASSERT(
-                    it != clientPipe.pendingResponseMessage_.end(),
-                    "message ID ",
-                    messageId,
-                    " is not recognized");
-                futureResponseMessage = std::move(it->second);
-                clientPipe.pendingResponseMessage_.erase(it);
-              }
-
-              // Remove entry from timeoutMap_.
-              removeFromTimeoutMap(messageId);
-
-              if (responseMessage.type() == MessageType::EXCEPTION) {
-                markFutureWithError(
-                    std::move(futureResponseMessage),
-                    std::string(
-                        responseMessage.payload().begin(),
-                        responseMessage.payload().end()));
-              } else {
-                markFutureAsComplete(
-                    std::move(futureResponseMessage),
-                    std::move(responseMessage),
-                    std::move(ctx));
-              }
-            });
+        // Every request in a batch gets its own response.
+        for (size_t i = 0; i < numRequests; ++i) {
+          readResponse(clientPipe);
+        }
+
+        if (opts_.maxBatchSize > 1) {
+          flushBatchedRequests(clientPipe);
+        }
       },
       deviceMap);
+}
 
-  return futureResponseMessage->jitFuture;
+void TensorPipeAgent::flushBatchedRequests(ClientPipe& clientPipe) {
+  std::vector<Message> batch;
+  {
+    std::lock_guard<std::mutex> lock(clientPipe.mutex_);
+    if (clientPipe.batchedRequests_.empty()) {
+      clientPipe.batchWriteInFlight_ = false;
+      return;
+    }
+    std::swap(batch, clientPipe.batchedRequests_);
+  }
+
+  const size_t numRequests = batch.size();
+  Message requestMessage = numRequests == 1
+      ? std::move(batch.front())
+      : createBatchedRequestsMessage(std::move(batch));
+  VLOG(1) << "RPC agent for " << workerInfo_.name_ << " is sending "
+          << numRequests << " batched requests to "
+          << clientPipe.pipe_->getRemoteName();
+  writeRequest(
+      clientPipe,
+      std::move(requestMessage),
+      numRequests,
+      {},
+      createLazyStreamContext());
+}
+
+void TensorPipeAgent::readResponse(ClientPipe& clientPipe) {
+  pipeRead(
+      clientPipe.pipe_,
+      [this, &clientPipe](
+          const tensorpipe::Error& error,
+          Message&& responseMessage,
+          std::shared_ptr<LazyStreamContext> ctx) {
+        if (error) {
+          if (error.isOfType<tensorpipe::PipeClosedError>() &&
+              !rpcAgentRunning_.load()) {
+            // This is expected.
+          } else {
+            LOG(WARNING)
+                << "RPC agent for " << workerInfo_.name_
+                << " encountered error when reading incoming response from "
+                << clientPipe.pipe_->getRemoteName() << ": " << error.what();
+          }
+          handleClientError(clientPipe, error);
+          return;
+        }
+
+        // Identify future response message by message ID
+        uint64_t messageId = responseMessage.id();
+
+        VLOG(1) << "RPC agent for " << workerInfo_.name_
+                << " received response #" << messageId << " from "
+                << clientPipe.pipe_->getRemoteName();
+
+        std::shared_ptr<AtomicJitFuture> futureResponseMessage;
+        {
+          std::lock_guard<std::mutex> lock(clientPipe.mutex_);
+          // A read error will lead all following callbacks to be
+          // invoked with error, and shouldn't reach here.
+          TORCH_INTERNAL_ASSERT(
+              !clientPipe.inError_, "Shouldn't be in error state");
+          auto it = clientPipe.pendingResponseMessage_.find(messageId);
+          TORCH_INTERNAL_ASSERT(
+              it != clientPipe.pendingResponseMessage_.end(),
+              "message ID ",
+              messageId,
+              " is not recognized");
+          futureResponseMessage = std::move(it->second);
+          clientPipe.pendingResponseMessage_.erase(it);
+        }
+
+        // Remove entry from timeoutMap_.
+        removeFromTimeoutMap(messageId);
+
+        const auto latency =
+            microsecondsSince(futureResponseMessage->startTime);
+        clientPipe.latencyHistogram_->record(latency);
+        getLatencyHistogramForType(futureResponseMessage->messageType)
+            .record(latency);
+
+        if (responseMessage.type() == MessageType::EXCEPTION) {
+          markFutureWithError(
+              std::move(futureResponseMessage),
+              std::string(
+                  responseMessage.payload().begin(),
+                  responseMessage.payload().end()));
+        } else {
+          markFutureAsComplete(
+              std::move(futureResponseMessage),
+              std::move(responseMessage),
+              std::move(ctx));
+        }
+      });
 }
 
 void TensorPipeAgent::handleClientError(
@@ -1022,6 +1189,8 @@ void TensorPipeAgent::handleClientError(
   {
     std::lock_guard<std::mutex> lock(clientPipe.mutex_);
     std::swap(clientPipe.pendingResponseMessage_, pendingMsgs);
+    clientPipe.batchedRequests_.clear();
+    clientPipe.batchWriteInFlight_ = false;
     clientPipe.inError_ = true;
   }
   std::string errorMsg = error.what();
@@ -1226,6 +1395,10 @@ std::unordered_map<std::string, std::string> TensorPipeAgent::getMetrics() {
       metrics[kGilAverageWaitTime] = c10::to_string(averageGilWaitTime);
     }
   }
+  updateMetricsGauges();
+  for (auto& entry : metricsHandler_.summary()) {
+    metrics.emplace(std::move(entry));
+  }
 
   return metrics;
 }
@@ -1236,6 +1409,49 @@ void TensorPipeAgent::addGilWaitTime(
   timeSeriesMetrics_[kGilAverageWaitTime].addData(gilWaitTime.count());
 }
 
+RpcMetricsHistogram& TensorPipeAgent::getLatencyHistogramForType(
+    MessageType type) {
+  auto& slot = latencyHistogramByType_[type & 0xFF];
+  RpcMetricsHistogram* histogram = slot.load(std::memory_order_acquire);
+  if (histogram == nullptr) {
+    // Racing threads resolve the same histogram, so it's fine to overwrite.
+    histogram = &metricsHandler_.histogram(
+        kLatencyByMessageType + c10::to_string(type & 0xFF));
+    slot.store(histogram, std::memory_order_release);
+  }
+  return *histogram;
+}
+
+void TensorPipeAgent::updateMetricsGauges() {
+  {
+    std::unique_lock<std::mutex> lock(callCountMutex_);
+    metricsHandler_.gauge(kClientInFlightCalls) = clientActiveCalls_;
+    metricsHandler_.gauge(kServerInFlightCalls) = serverActiveCalls_;
+  }
+  int64_t pendingResponses = 0;
+  int64_t pendingBatchedRequests = 0;
+  {
+    std::unique_lock<std::mutex> lock(connectedPipesMutex_);
+    for (const auto& entry : connectedPipes_) {
+      const ClientPipe& clientPipe = entry.second;
+      std::lock_guard<std::mutex> pipeLock(clientPipe.mutex_);
+      pendingResponses += clientPipe.pendingResponseMessage_.size();
+      pendingBatchedRequests += clientPipe.batchedRequests_.size();
+    }
+  }
+  metricsHandler_.gauge(kPendingResponses) = pendingResponses;
+  metricsHandler_.gauge(kPendingBatchedRequests) = pendingBatchedRequests;
+}
+
+DefaultRpcMetricsHandler::Snapshot TensorPipeAgent::getMetricsSnapshot() {
+  updateMetricsGauges();
+  return metricsHandler_.snapshot();
+}
+
+void TensorPipeAgent::resetMetrics() {
+  metricsHandler_.reset();
+}
+
 TensorPipeAgent::NetworkDataDict TensorPipeAgent::getNetworkData() {
   std::lock_guard<std::mutex> lock(networkDataMutex_);
   return networkData_;
@@ -2,6 +2,7 @@
 
 #ifdef USE_TENSORPIPE
 
+#include <array>
 #include <atomic>
 #include <thread>
 
@@ -10,6 +11,7 @@
 #include <c10d/ProcessGroup.hpp>
 #include <c10d/Store.hpp>
 #include <torch/csrc/distributed/rpc/macros.h>
+#include <torch/csrc/distributed/rpc/metrics/DefaultRpcMetricsHandler.h>
 #include <torch/csrc/distributed/rpc/rpc_agent.h>
 
 #ifdef USE_CUDA_NOT_ROCM
@@ -89,6 +91,7 @@ struct CudaChannelRegistration {
 C10_DECLARE_REGISTRY(TensorPipeCudaChannelRegistry, CudaChannelRegistration);
 
 constexpr auto kDefaultNumWorkerThreads = 16;
+constexpr auto kDefaultMaxBatchSize = 1;
 
 struct TensorPipeRpcBackendOptions : public RpcBackendOptions {
   TensorPipeRpcBackendOptions(
@@ -145,6 +148,12 @@ struct TensorPipeRpcBackendOptions : public RpcBackendOptions {
   const optional<std::vector<std::string>> transports;
   const optional<std::vector<std::string>> channels;
   std::unordered_map<std::string, tensorpipe::DeviceMap> deviceMaps;
+  // Maximum number of CPU-only requests to the same worker that may be
+  // coalesced into a single write. Requests issued while a previous write to
+  // that worker is still in flight are queued and sent together once it
+  // completes, so batching adds no latency when the pipe is idle. A value of
+  // 1 disables batching.
+  int maxBatchSize{kDefaultMaxBatchSize};
 };
 
 // Struct to track the network source metrics
@@ -218,6 +227,13 @@ class TensorPipeAgent : public RpcAgent {
   // Returns NetworkSourceInfo struct
   NetworkSourceInfo getNetworkSourceInfo();
 
+  // Returns the latency histograms (per destination and per message type),
+  // the serialization times, the bytes sent and received, and gauges for the
+  // in-flight calls and queue depths.
+  DefaultRpcMetricsHandler::Snapshot getMetricsSnapshot();
+  // Resets the histograms and counters returned by getMetricsSnapshot().
+  void resetMetrics();
+
   static const std::string& guessAddress();
 
   // For testing purposes.
@@ -262,6 +278,12 @@ class TensorPipeAgent : public RpcAgent {
   // Respond to a call from a peer
   void respond(std::shared_ptr<tensorpipe::Pipe>& pipe);
 
+  // Run a single request received from a peer and send back its response
+  void handleRequest(
+      std::shared_ptr<tensorpipe::Pipe>& pipe,
+      Message&& requestMessage,
+      std::shared_ptr<LazyStreamContext> ctx);
+
   void sendCompletedResponseMessage(
       std::shared_ptr<tensorpipe::Pipe>& pipe,
       std::shared_ptr<JitFuture>& futureResponseMessage,
@@ -326,6 +348,9 @@ class TensorPipeAgent : public RpcAgent {
 
     std::atomic_flag isComplete = ATOMIC_FLAG_INIT;
     std::shared_ptr<JitFuture> jitFuture;
+    // Used to record the latency of the request once its response arrives.
+    std::chrono::steady_clock::time_point startTime;
+    MessageType messageType{MessageType::UNKNOWN};
   };
 
   // Maintains state per client pipe to track pending response messages and
@@ -341,6 +366,12 @@ class TensorPipeAgent : public RpcAgent {
     // Map from Message Request ID's to corresponding futures.
     std::unordered_map<uint64_t, std::shared_ptr<AtomicJitFuture>>
         pendingResponseMessage_;
+    // Whether a batchable write is in flight, in which case new batchable
+    // requests are queued in batchedRequests_ until it completes.
+    bool batchWriteInFlight_{false};
+    std::vector<Message> batchedRequests_;
+    // Latency histogram of the requests sent to this destination.
+    RpcMetricsHistogram* latencyHistogram_{nullptr};
   };
 
   const TensorPipeRpcBackendOptions opts_;
@@ -416,6 +447,23 @@ class TensorPipeAgent : public RpcAgent {
       ClientPipe& clientPipe,
       const tensorpipe::Error& error);
 
+  // Write a request, or a batch of numRequests requests, to the client pipe
+  // and, once written, arm one read for the response of each of them.
+  void writeRequest(
+      ClientPipe& clientPipe,
+      Message&& requestMessage,
+      size_t numRequests,
+      std::vector<c10::DeviceIndex>&& devices,
+      std::shared_ptr<LazyStreamContext> ctx,
+      const tensorpipe::DeviceMap& deviceMap = {});
+
+  // Send the requests queued on the client pipe as a single batch, or mark
+  // the pipe as having no batchable write in flight if there are none.
+  void flushBatchedRequests(ClientPipe& clientPipe);
+
+  // Read a response from the client pipe and complete its future
+  void readResponse(ClientPipe& clientPipe);
+
   // This is a generic struct for capturing Time-Series Metrics. It keeps a
   // running sum and count of data points (observations), and can return an
   // average of the data points seen so far. This is currently only used for
@@ -443,6 +491,21 @@ class TensorPipeAgent : public RpcAgent {
   // Mutex to guard timeSeriesMetrics_
   std::mutex metricsMutex_;
 
+  // Built-in metrics. The frequently updated ones are resolved once and then
+  // updated through these pointers, which remain valid as long as the handler.
+  DefaultRpcMetricsHandler metricsHandler_;
+  RpcMetricsHistogram* serializationTimeUs_;
+  RpcMetricsHistogram* deserializationTimeUs_;
+  std::atomic<uint64_t>* bytesSent_;
+  std::atomic<uint64_t>* bytesReceived_;
+  std::atomic<int64_t>* threadPoolQueueDepth_;
+  // Lazily resolved latency histograms, indexed by message type.
+  std::array<std::atomic<RpcMetricsHistogram*>, 256> latencyHistogramByType_{};
+
+  RpcMetricsHistogram& getLatencyHistogramForType(MessageType type);
+  // Sets the gauges that are derived from the agent's state.
+  void updateMetricsGauges();
+
   // Map to Track Network Data
   NetworkDataDict networkData_;
   // Mutex to guard networkData_
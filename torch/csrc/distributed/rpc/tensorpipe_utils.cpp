@@ -8,6 +8,7 @@
 #include <tensorpipe/tensorpipe.h>
 #endif
 
+#include <c10/core/CPUAllocator.h>
 #include <tensorpipe/core/message.h>
 
 namespace torch {
@@ -39,6 +40,87 @@ inline c10::Device indexToDevice(c10::DeviceIndex index) {
 
 } // namespace
 
+struct TensorpipeCpuBufferPool::Block {
+  void* ptr;
+  size_t nbytes;
+  TensorpipeCpuBufferPool* pool;
+};
+
+TensorpipeCpuBufferPool::TensorpipeCpuBufferPool(size_t maxCachedBytes)
+    : maxCachedBytes_(maxCachedBytes) {}
+
+TensorpipeCpuBufferPool::~TensorpipeCpuBufferPool() {
+  emptyCache();
+}
+
+TensorpipeCpuBufferPool& TensorpipeCpuBufferPool::getDefault() {
+  // Leaked on purpose, as received tensors may outlive static destruction.
+  static auto* pool =
+      new TensorpipeCpuBufferPool(/* maxCachedBytes */ 256 * 1024 * 1024);
+  return *pool;
+}
+
+c10::DataPtr TensorpipeCpuBufferPool::allocate(size_t nbytes) {
+  if (nbytes < kMinPooledBytes) {
+    return at::getCPUAllocator()->allocate(nbytes);
+  }
+  void* ptr = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = freeBuffers_.find(nbytes);
+    if (it != freeBuffers_.end()) {
+      ptr = it->second.back();
+      it->second.pop_back();
+      if (it->second.empty()) {
+        freeBuffers_.erase(it);
+      }
+      cachedBytes_ -= nbytes;
+    }
+  }
+  if (ptr == nullptr) {
+    ptr = c10::alloc_cpu(nbytes);
+  }
+  return c10::DataPtr(
+      ptr,
+      new Block{ptr, nbytes, this},
+      &TensorpipeCpuBufferPool::deleteBlock,
+      c10::Device(c10::DeviceType::CPU));
+}
+
+void TensorpipeCpuBufferPool::deleteBlock(void* ctx) {
+  auto* block = static_cast<Block*>(ctx);
+  block->pool->release(block);
+}
+
+void TensorpipeCpuBufferPool::release(Block* block) {
+  std::unique_ptr<Block> blockGuard(block);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (cachedBytes_ + block->nbytes <= maxCachedBytes_) {
+      freeBuffers_[block->nbytes].push_back(block->ptr);
+      cachedBytes_ += block->nbytes;
+      return;
+    }
+  }
+  c10::free_cpu(block->ptr);
+}
+
+void TensorpipeCpuBufferPool::emptyCache() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& entry : freeBuffers_) {
+    for (void* ptr : entry.second) {
+      c10::free_cpu(ptr);
+    }
+  }
+  freeBuffers_.clear();
+  cachedBytes_ = 0;
+}
+
+size_t TensorpipeCpuBufferPool::cachedBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cachedBytes_;
+}
+
 std::tuple<tensorpipe::Message, TensorpipeWriteBuffers> tensorpipeSerialize(
     Message&& rpcMessage,
     std::vector<c10::DeviceIndex> deviceIndices,
@@ -175,7 +257,8 @@ TensorpipeReadBuffers tensorpipeAllocate(
   for (auto& tensor : tpMessage.tensors) {
     if (tensor.buffer.type == tensorpipe::DeviceType::kCpu) {
       buffers.tensors.emplace_back(
-          at::getCPUAllocator()->allocate(tensor.buffer.cpu.length));
+          TensorpipeCpuBufferPool::getDefault().allocate(
+              tensor.buffer.cpu.length));
       tensor.buffer.cpu.ptr = buffers.tensors.back().get();
 #ifdef USE_CUDA_NOT_ROCM
     } else if (tensor.buffer.type == tensorpipe::DeviceType::kCuda) {
@@ -5,6 +5,9 @@
 #include <torch/csrc/distributed/rpc/macros.h>
 #include <torch/csrc/distributed/rpc/utils.h>
 
+#include <mutex>
+#include <unordered_map>
+
 #ifdef USE_CUDA_NOT_ROCM
 #include <ATen/cuda/CUDAEvent.h>
 #include <c10/cuda/CUDACachingAllocator.h>
@@ -114,6 +117,42 @@ inline std::shared_ptr<LazyStreamContext> createLazyStreamContext() {
 
 #endif
 
+// Caches the CPU buffers that incoming tensors are received into, so that
+// receiving tensors of recurring sizes, e.g., the embedding rows exchanged with
+// a parameter server, doesn't hit the system allocator for every message.
+// Buffers are matched by their exact size, and a buffer goes back to the pool
+// once the storage of the received tensor is freed. The pool must outlive all
+// the buffers it handed out.
+class TORCH_API TensorpipeCpuBufferPool {
+ public:
+  // Buffers smaller than this are not worth caching and come straight from
+  // the CPU allocator.
+  static constexpr size_t kMinPooledBytes = 64 * 1024;
+
+  explicit TensorpipeCpuBufferPool(size_t maxCachedBytes);
+  ~TensorpipeCpuBufferPool();
+
+  // The pool used by tensorpipeAllocate. It is never destroyed.
+  static TensorpipeCpuBufferPool& getDefault();
+
+  c10::DataPtr allocate(size_t nbytes);
+
+  // Frees all the cached buffers.
+  void emptyCache();
+
+  size_t cachedBytes() const;
+
+ private:
+  struct Block;
+  static void deleteBlock(void* ctx);
+  void release(Block* block);
+
+  const size_t maxCachedBytes_;
+  mutable std::mutex mutex_;
+  std::unordered_map<size_t, std::vector<void*>> freeBuffers_;
+  size_t cachedBytes_{0};
+};
+
 // A struct that holds pointers that keep alive all the memory that will be
 // accessed by TensorPipe during a write operation.
 struct TensorpipeWriteBuffers {
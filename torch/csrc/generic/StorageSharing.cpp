@@ -4,6 +4,7 @@
 #include <c10/cuda/CUDAGuard.h>
 #endif
 
+#include <torch/csrc/multiprocessing/shared_memory_pool.h>
 #include <torch/csrc/utils/python_numbers.h>
 #include <random>
 
@@ -16,6 +17,8 @@ static PyObject * THPStorage_(sharedDecref)(PyObject *_self, PyObject *noargs)
   THManagedMapAllocator *ctx = THManagedMapAllocator::fromDataPtr(storage->data_ptr());
   if (ctx) {
     ctx->decref();
+  } else {
+    torch::multiprocessing::releasePooledSharedMemory(storage->data_ptr());
   }
 #endif
   Py_INCREF(self);
@@ -32,6 +35,8 @@ static PyObject * THPStorage_(sharedIncref)(PyObject *_self, PyObject *noargs)
   THManagedMapAllocator *ctx = THManagedMapAllocator::fromDataPtr(storage->data_ptr());
   if (ctx) {
     ctx->incref();
+  } else {
+    torch::multiprocessing::retainPooledSharedMemory(storage->data_ptr());
   }
 #endif
   Py_RETURN_NONE;
@@ -135,6 +140,11 @@ static PyObject * THPStorage_(newSharedFilename)(PyObject *_unused, PyObject *ar
 
 static THWStorage* THPStorage_(newFdStorage)(ptrdiff_t size)
 {
+  // See NOTE [ Shared Memory Pool ]
+  auto pooled = torch::multiprocessing::allocatePooledSharedMemory(size * sizeof(scalar_t));
+  if (pooled) {
+    return THWStorage_(newWithDataAndAllocator)(std::move(pooled), size, /* allocator */ nullptr);
+  }
   int flags = TH_ALLOCATOR_MAPPED_SHAREDMEM |
               TH_ALLOCATOR_MAPPED_EXCLUSIVE |
               TH_ALLOCATOR_MAPPED_KEEPFD |
@@ -160,28 +170,36 @@ static PyObject * THPStorage_(shareFd)(PyObject *_self, PyObject *noargs)
   HANDLE_TH_ERRORS
   auto self = (THPStorage*)_self;
   THWStorage *storage = self->cdata;
-  THMapAllocator *ctx;
   // Storage is already in shared memory, just return a handle
-  if ((ctx = THMapAllocator::fromDataPtr(storage->data_ptr()))) {
-    // done
-  } else {
+  if (!THMapAllocator::fromDataPtr(storage->data_ptr()) &&
+      torch::multiprocessing::pooledSharedMemoryFd(storage->data_ptr()) == -1) {
     THWStoragePtr new_storage(
         THPStorage_(newFdStorage)(storage->nbytes() / sizeof(scalar_t)));
     THWStorage_(copy)(new_storage, storage);
     THWStorage_(swap)(storage, new_storage);
-    ctx = THMapAllocator::fromDataPtr(storage->data_ptr());
+  }
+
+  // See NOTE [ Shared Memory Pool ]
+  int fd = torch::multiprocessing::pooledSharedMemoryFd(storage->data_ptr());
+  const bool pooled = fd != -1;
+  if (!pooled) {
+    THMapAllocator *ctx = THMapAllocator::fromDataPtr(storage->data_ptr());
     AT_ASSERT(ctx);
+    fd = ctx->fd();
   }
 
-  THPObjectPtr storage_handle(THPUtils_packInt32(ctx->fd()));
+  THPObjectPtr storage_handle(THPUtils_packInt32(fd));
   if (!storage_handle) return nullptr;
   THPObjectPtr size(THPUtils_packUInt64(storage->nbytes() / sizeof(scalar_t)));
   if (!size) return nullptr;
+  THPObjectPtr is_pooled(PyBool_FromLong(pooled));
+  if (!is_pooled) return nullptr;
 
-  THPObjectPtr tuple(PyTuple_New(2));
+  THPObjectPtr tuple(PyTuple_New(3));
   if (!tuple) return nullptr;
   PyTuple_SET_ITEM(tuple.get(), 0, storage_handle.release());
   PyTuple_SET_ITEM(tuple.get(), 1, size.release());
+  PyTuple_SET_ITEM(tuple.get(), 2, is_pooled.release());
   return tuple.release();
   END_HANDLE_TH_ERRORS
 }
@@ -189,12 +207,14 @@ static PyObject * THPStorage_(shareFd)(PyObject *_self, PyObject *noargs)
 static PyObject * THPStorage_(newSharedFd)(PyObject *_unused, PyObject *args)
 {
   HANDLE_TH_ERRORS
-  THPUtils_assert(PyTuple_GET_SIZE(args) == 2, "tuple of 2 items expected");
+  THPUtils_assert(PyTuple_GET_SIZE(args) == 2 || PyTuple_GET_SIZE(args) == 3,
+      "tuple of 2 or 3 items expected");
   PyObject *_tmp_fd = PyTuple_GET_ITEM(args, 0);
   PyObject *_size = PyTuple_GET_ITEM(args, 1);
-  if (!THPUtils_checkLong(_tmp_fd) || !THPUtils_checkLong(_size)) {
+  PyObject *_pooled = PyTuple_GET_SIZE(args) == 3 ? PyTuple_GET_ITEM(args, 2) : Py_False;
+  if (!THPUtils_checkLong(_tmp_fd) || !THPUtils_checkLong(_size) || !PyBool_Check(_pooled)) {
     THPUtils_invalidArguments(args, nullptr, "_new_shared in file descriptor mode",
-        1, "a file descriptor (int) and storage size (int)");
+        1, "a file descriptor (int), storage size (int) and whether it is pooled (bool)");
     return nullptr;
   }
   int fd;
@@ -205,6 +225,13 @@ static PyObject * THPStorage_(newSharedFd)(PyObject *_unused, PyObject *args)
     return nullptr;
   }
 
+  if (_pooled == Py_True) {
+    return THPStorage_(New)(
+            THWStorage_(newWithDataAndAllocator)(
+              torch::multiprocessing::receivePooledSharedMemory(fd),
+              size, /* allocator */ nullptr));
+  }
+
   int flags = TH_ALLOCATOR_MAPPED_SHAREDMEM |
               TH_ALLOCATOR_MAPPED_NOCREATE |
               TH_ALLOCATOR_MAPPED_KEEPFD |
@@ -321,19 +348,11 @@ static PyObject * THPStorage_(releaseIPCCounter)(PyObject *_unused, PyObject *ar
   ptrdiff_t ref_counter_offset =
       (ptrdiff_t)THPUtils_unpackLong(_ref_counter_offset);
   // We don't want to break existing code, so resource deletion is best
-  // effort basis. Exception expected if producer process terminated
+  // effort basis. The counters are missing if producer process terminated
   // before consumer released data.
-  int flags =
-      TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_NOCREATE;
-  try {
-    auto sptr = THRefcountedMapAllocator::makeDataPtr(
-        ref_counter_handle.c_str(),
-        flags,
-        sizeof(int64_t) * torch::CUDA_IPC_REF_COUNTER_FILE_SIZE,
-        nullptr);
-    *(static_cast<int64_t*>(sptr.get()) + ref_counter_offset) -= 1;
-  } catch (c10::Error& err) {
-    // Already warned inside of producer process
+  auto ref_counters = torch::GetReceivedRefCounters(ref_counter_handle);
+  if (ref_counters) {
+    *(ref_counters.get() + ref_counter_offset) -= 1;
   }
   Py_RETURN_NONE;
   END_HANDLE_TH_ERRORS
@@ -407,10 +426,15 @@ static PyObject * THPStorage_(newSharedCuda)(PyObject *_unused, PyObject *args)
 
   std::string ref_counter_handle = PyBytes_AS_STRING(_ref_counter);
   ptrdiff_t ref_counter_offset = (ptrdiff_t)THPUtils_unpackLong(_ref_counter_offset);
+  // We don't want to break existing code, so resource deletion is best
+  // effort basis. The counters are missing if producer process terminated
+  // before consumer received data.
+  std::shared_ptr<int64_t> ref_counters =
+      torch::GetReceivedRefCounters(ref_counter_handle);
 
   auto c = new torch::CudaIPCReceivedData(std::move(basePtr));
   auto sp = std::shared_ptr<void>(
-      (void*)c, [ref_counter_handle, ref_counter_offset, device](void* ptr) {
+      (void*)c, [ref_counters, ref_counter_offset, device](void* ptr) {
         delete static_cast<torch::CudaIPCReceivedData*>(ptr);
         // Sync default stream to make sure all operations related to the storage is
         // finished (otherwise another process may reuse memory and corrupt
@@ -426,20 +450,8 @@ static PyObject * THPStorage_(newSharedCuda)(PyObject *_unused, PyObject *args)
         // Callback and release counter inside of it (need to check performance impact)
         cudaStreamSynchronize(c10::cuda::getCurrentCUDAStream(device));
 
-        // We don't want to break existing code, so resource deletion is best
-        // effort basis. Exception expected if producer process terminated
-        // before consumer released data.
-        int flags =
-            TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_NOCREATE;
-        try {
-          auto sptr = THRefcountedMapAllocator::makeDataPtr(
-              ref_counter_handle.c_str(),
-              flags,
-              sizeof(int64_t) * torch::CUDA_IPC_REF_COUNTER_FILE_SIZE,
-              nullptr);
-          *(static_cast<int64_t*>(sptr.get()) + ref_counter_offset) -= 1;
-        } catch (c10::Error& err) {
-          // Already warned inside of producer process
+        if (ref_counters) {
+          *(ref_counters.get() + ref_counter_offset) -= 1;
         }
       });
 
@@ -513,6 +525,10 @@ PyObject * THPStorage_(sharedFd)(PyObject *_self, PyObject *noargs)
 #ifndef THC_GENERIC_FILE
   THWStorage *storage = self->cdata;
   ctx = THMapAllocator::fromDataPtr(storage->data_ptr());
+  int fd = torch::multiprocessing::pooledSharedMemoryFd(storage->data_ptr());
+  if (fd != -1) {
+    return THPUtils_packInt32(fd);
+  }
 #endif
 
   THPUtils_assert(ctx, "couldn't retrieve a shared file descriptor");
@@ -527,7 +543,8 @@ PyObject * THPStorage_(isShared)(PyObject *_self, PyObject *noargs)
   Py_RETURN_TRUE;
 #else
   if (THMapAllocator::fromDataPtr(self->cdata->data_ptr()) ||
-      THManagedMapAllocator::fromDataPtr(self->cdata->data_ptr())) {
+      THManagedMapAllocator::fromDataPtr(self->cdata->data_ptr()) ||
+      torch::multiprocessing::pooledSharedMemoryFd(self->cdata->data_ptr()) != -1) {
     Py_RETURN_TRUE;
   } else {
     Py_RETURN_FALSE;
@@ -492,7 +492,14 @@ std::vector<at::Tensor> FusionExecutor::runFusion(
     }
   }
 
-  KernelArgumentHolder kernel_arguments;
+  // The arguments of a recorded input set keep their layout, only their
+  // values are updated
+  KernelArgumentHolder new_arguments;
+  const bool rebind_arguments =
+      executor_entry && executor_entry->kernel_arguments;
+  KernelArgumentHolder& kernel_arguments =
+      rebind_arguments ? *executor_entry->kernel_arguments : new_arguments;
+  kernel_arguments.rebind();
   kernel_arguments.push(inputs);
   kernel_arguments.push(alloced_outputs);
   kernel_arguments.push(global_buffers.empty_buffers);
@@ -515,7 +522,11 @@ std::vector<at::Tensor> FusionExecutor::runFusion(
         stream,
         kernel_arguments.getBuffer(),
         nullptr));
-    AT_CUDA_CHECK(cudaStreamSynchronize(stream));
+  }
+
+  if (executor_entry && !rebind_arguments) {
+    executor_entry->kernel_arguments =
+        std::make_unique<KernelArgumentHolder>(std::move(new_arguments));
   }
 
   return alloced_outputs;
@@ -1,4 +1,5 @@
 #pragma once
+#include <torch/csrc/jit/codegen/cuda/executor_kernel_arg.h>
 #include <torch/csrc/jit/codegen/cuda/executor_launch_params.h>
 #include <torch/csrc/jit/codegen/cuda/executor_utils.h>
 #include <torch/csrc/jit/codegen/cuda/expr_evaluator.h>
@@ -71,6 +72,8 @@ class TORCH_CUDA_CU_API FusionExecutor : public NonCopyable {
     std::vector<std::vector<int64_t>> zero_buffer_sizes;
     std::vector<at::ScalarType> zero_buffer_types;
     uint64_t rand_offset;
+    // Arguments of the last launch, rebound for the next ones
+    std::unique_ptr<KernelArgumentHolder> kernel_arguments;
   };
 
   Kernel* kernel() const {
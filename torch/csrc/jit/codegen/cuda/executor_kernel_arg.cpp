@@ -33,8 +33,18 @@ std::unique_ptr<TensorArgAbstract> getTensorArg(
 
 // Push a tensor to the arguments
 void KernelArgumentHolder::push(const at::Tensor& tensor) {
-  changed_ = true;
   int nDims = tensor.ndimension();
+  if (next_ < arguments_.size()) {
+    auto tensor_arg =
+        static_cast<TensorArgAbstract*>(arguments_[next_++].get());
+    tensor_arg->setPointer(tensor.data_ptr());
+    for (int i = 0; i < nDims; i++) {
+      tensor_arg->setSize(i, tensor.sizes()[i]);
+      tensor_arg->setStride(i, tensor.strides()[i]);
+    }
+    return;
+  }
+  changed_ = true;
 
   c10::ScalarType dtype = tensor.scalar_type();
   std::unique_ptr<TensorArgAbstract> tensor_arg = getTensorArg(dtype, nDims);
@@ -44,21 +54,36 @@ void KernelArgumentHolder::push(const at::Tensor& tensor) {
     tensor_arg->setStride(i, tensor.strides()[i]);
   }
   arguments_.push_back(std::move(tensor_arg));
+  next_++;
 }
 
 // Push a scalar or integer to the arguments
 void KernelArgumentHolder::push(const IValue& val) {
-  changed_ = true;
   TORCH_INTERNAL_ASSERT(
       val.isScalar(),
       "Tried to push an arg to run in a fused kernel, expected a scalar but got, ",
       val);
+  const bool rebind = next_ < arguments_.size();
+  if (!rebind) {
+    changed_ = true;
+  }
   switch (val.toScalar().type()) {
     case c10::ScalarType::Double:
-      arguments_.push_back(std::make_unique<FloatArg>((float)val.toDouble()));
+      if (rebind) {
+        static_cast<FloatArg*>(arguments_[next_++].get())->val_ =
+            (float)val.toDouble();
+      } else {
+        arguments_.push_back(std::make_unique<FloatArg>((float)val.toDouble()));
+        next_++;
+      }
       return;
     case c10::ScalarType::Long:
-      arguments_.push_back(std::make_unique<LongArg>(val.toInt()));
+      if (rebind) {
+        static_cast<LongArg*>(arguments_[next_++].get())->val_ = val.toInt();
+      } else {
+        arguments_.push_back(std::make_unique<LongArg>(val.toInt()));
+        next_++;
+      }
       return;
     default:
       TORCH_INTERNAL_ASSERT(
@@ -71,7 +96,13 @@ void KernelArgumentHolder::push(const IValue& val) {
 }
 
 void KernelArgumentHolder::push(const uint64_t& val) {
+  if (next_ < arguments_.size()) {
+    static_cast<ULongArg*>(arguments_[next_++].get())->val_ = val;
+    return;
+  }
+  changed_ = true;
   arguments_.push_back(std::make_unique<ULongArg>(val));
+  next_++;
 }
 
 // Create buffer, flatten arguments into it, align by 8 Bytes, return pointers
@@ -148,6 +148,14 @@ std::unique_ptr<TensorArgAbstract> getTensorArg(
 
 class KernelArgumentHolder {
  public:
+  // Start binding the arguments of another launch. The arguments pushed after
+  // this update the ones pushed for the previous launch in place, so they must
+  // come in the same order with the same types and ranks, as for a recorded
+  // input set of a kernel. The buffer returned by getBuffer() stays valid.
+  void rebind() {
+    next_ = 0;
+  }
+
   // Push a tensor to the arguments
   void push(const at::Tensor& tensor);
 
@@ -170,6 +178,9 @@ class KernelArgumentHolder {
   std::vector<std::unique_ptr<ArgAbstract>> arguments_;
   std::vector<void*> void_ptrs_;
   bool changed_ = true;
+  // Index of the argument the next push updates, arguments_.size() when they
+  // are appended
+  size_t next_ = 0;
 };
 
 } // namespace cuda
@@ -18,7 +18,10 @@
 #include <nvfuser_resources/random_numbers.h>
 #include <nvfuser_resources/tensor.h>
 
+#include <cstdio>
 #include <fstream>
+#include <iomanip>
+#include <random>
 
 namespace torch {
 namespace jit {
@@ -244,6 +247,120 @@ StatefulExpressionEvaluator statefulBindInputs(
   return evaluator;
 }
 
+namespace {
+
+// Identifies the layout of the entries in the on-disk kernel cache. Bump it
+// whenever the layout written by writeCachedKernel changes.
+constexpr const char* kKernelCacheMagic = "nvfuser-kernel-cache-v1";
+
+// 64-bit FNV-1a. Unlike std::hash, its value is specified, so that processes
+// built by different toolchains agree on the cache entry names.
+uint64_t fnv1aHash(const std::string& str) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (const char c : str) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+// Returns the path of the on-disk cache entry for a program, or an empty
+// string if PYTORCH_CUDA_FUSER_CACHE_DIR is not set. The key covers everything
+// that determines the NVRTC output: the generated source, which already bakes
+// in the launch configuration the fusion was scheduled for, the compile
+// options, which name the target architecture, and the NVRTC version.
+std::string kernelCachePath(
+    const std::string& code,
+    const std::string& func_name,
+    const std::vector<const char*>& args) {
+  const char* cache_dir = getenv("PYTORCH_CUDA_FUSER_CACHE_DIR");
+  if (!cache_dir || !*cache_dir) {
+    return "";
+  }
+
+  int nvrtc_major = 0, nvrtc_minor = 0;
+  AT_CUDA_NVRTC_CHECK(
+      at::globalContext().getNVRTC().nvrtcVersion(&nvrtc_major, &nvrtc_minor));
+
+  std::stringstream key;
+  key << kKernelCacheMagic << "\n"
+      << nvrtc_major << "." << nvrtc_minor << "\n"
+      << func_name << "\n";
+  for (const auto arg : args) {
+    key << arg << "\n";
+  }
+  key << code;
+
+  std::stringstream path;
+  path << cache_dir << "/" << std::hex << std::setw(16) << std::setfill('0')
+       << fnv1aHash(key.str()) << ".bin";
+  return path.str();
+}
+
+// Reads the entry at path into lowered_name and binary. Returns false if there
+// is no such entry or if it is malformed, e.g., written by another version.
+bool readCachedKernel(
+    const std::string& path,
+    std::string& lowered_name,
+    std::vector<char>& binary) {
+  FUSER_PERF_SCOPE("readCachedKernel");
+
+  std::ifstream file(path, std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+
+  std::string magic;
+  size_t size = 0;
+  if (!std::getline(file, magic) || magic != kKernelCacheMagic ||
+      !std::getline(file, lowered_name) || !(file >> size) ||
+      file.get() != '\n') {
+    return false;
+  }
+
+  binary.resize(size);
+  file.read(binary.data(), size);
+  return static_cast<size_t>(file.gcount()) == size;
+}
+
+// Writes an entry to path. Entries are written to a temporary file that is
+// then renamed, so that processes sharing the cache directory never observe
+// a partially written entry. Failing to write is not an error, the kernel is
+// simply compiled again next time.
+void writeCachedKernel(
+    const std::string& path,
+    const std::string& lowered_name,
+    const std::vector<char>& binary) {
+  FUSER_PERF_SCOPE("writeCachedKernel");
+
+  std::stringstream tmp_path;
+  tmp_path << path << ".tmp" << std::hex << std::random_device()();
+
+  {
+    std::ofstream file(tmp_path.str(), std::ios::out | std::ios::binary);
+    if (file.is_open()) {
+      file << kKernelCacheMagic << "\n"
+           << lowered_name << "\n"
+           << binary.size() << "\n";
+      file.write(binary.data(), binary.size());
+    }
+    if (file.is_open() && file.good()) {
+      file.close();
+      if (std::rename(tmp_path.str().c_str(), path.c_str()) == 0) {
+        return;
+      }
+    }
+  }
+
+  std::remove(tmp_path.str().c_str());
+  TORCH_WARN_ONCE(
+      "Failed to write to the nvFuser kernel cache at ",
+      path,
+      ", make sure that PYTORCH_CUDA_FUSER_CACHE_DIR is a writable directory");
+}
+
+} // namespace
+
 NvrtcFunction nvrtcCompile(
     const std::string& code,
     const std::string& func_name,
@@ -265,20 +382,6 @@ NvrtcFunction nvrtcCompile(
   bool compile_to_sass = false;
   codegenOutputQuery(prop, major, minor, compile_to_sass);
 
-  nvrtcProgram program; // NOLINT(cppcoreguidelines-init-variables)
-
-  {
-    FUSER_PERF_SCOPE("nvrtcCreateProgram");
-    AT_CUDA_NVRTC_CHECK(at::globalContext().getNVRTC().nvrtcCreateProgram(
-        &program, code.c_str(), nullptr, 0, nullptr, nullptr));
-  }
-
-  ResourceGuard holdProgram([&] {
-    FUSER_PERF_SCOPE("nvrtcDestroyProgram");
-    AT_CUDA_NVRTC_CHECK(
-        at::globalContext().getNVRTC().nvrtcDestroyProgram(&program));
-  });
-
 #ifdef __HIP_PLATFORM_HCC__
   std::vector<const char*> args = {"--std=c++14"};
 #else
@@ -331,54 +434,83 @@ NvrtcFunction nvrtcCompile(
     }
   }
 
-  at::globalContext().getNVRTC().nvrtcAddNameExpression(
-      program, func_name.c_str());
+  // Reuse the binary compiled by an earlier (or concurrent) process if the
+  // on-disk kernel cache is enabled and holds an entry for this program.
+  const std::string cache_path = kernelCachePath(code, func_name, args);
 
-  {
-    FUSER_PERF_SCOPE("nvrtcCompileProgram");
-
-    const auto result = at::globalContext().getNVRTC().nvrtcCompileProgram(
-        program, args.size(), args.data());
+  std::string lowered_kernel_name;
+  std::vector<char> ptx;
 
-    if (result != NVRTC_SUCCESS) {
-      size_t logsize;
-      at::globalContext().getNVRTC().nvrtcGetProgramLogSize(program, &logsize);
-      std::vector<char> log(logsize);
-      at::globalContext().getNVRTC().nvrtcGetProgramLog(program, log.data());
+  if (cache_path.empty() ||
+      !readCachedKernel(cache_path, lowered_kernel_name, ptx)) {
+    nvrtcProgram program; // NOLINT(cppcoreguidelines-init-variables)
 
-      TORCH_INTERNAL_ASSERT(
-          false, code.c_str(), "\nCUDA NVRTC compile error: ", log.data());
+    {
+      FUSER_PERF_SCOPE("nvrtcCreateProgram");
+      AT_CUDA_NVRTC_CHECK(at::globalContext().getNVRTC().nvrtcCreateProgram(
+          &program, code.c_str(), nullptr, 0, nullptr, nullptr));
     }
 
-    AT_CUDA_NVRTC_CHECK(result);
-  }
+    ResourceGuard holdProgram([&] {
+      FUSER_PERF_SCOPE("nvrtcDestroyProgram");
+      AT_CUDA_NVRTC_CHECK(
+          at::globalContext().getNVRTC().nvrtcDestroyProgram(&program));
+    });
 
-  const char* lowered_kernel_name = nullptr;
-  at::globalContext().getNVRTC().nvrtcGetLoweredName(
-      program, func_name.c_str(), &lowered_kernel_name);
+    at::globalContext().getNVRTC().nvrtcAddNameExpression(
+        program, func_name.c_str());
 
-  size_t ptx_size = 0;
-  std::vector<char> ptx;
+    {
+      FUSER_PERF_SCOPE("nvrtcCompileProgram");
 
-  {
-    FUSER_PERF_SCOPE("get PTX");
+      const auto result = at::globalContext().getNVRTC().nvrtcCompileProgram(
+          program, args.size(), args.data());
+
+      if (result != NVRTC_SUCCESS) {
+        size_t logsize;
+        at::globalContext().getNVRTC().nvrtcGetProgramLogSize(
+            program, &logsize);
+        std::vector<char> log(logsize);
+        at::globalContext().getNVRTC().nvrtcGetProgramLog(program, log.data());
+
+        TORCH_INTERNAL_ASSERT(
+            false, code.c_str(), "\nCUDA NVRTC compile error: ", log.data());
+      }
+
+      AT_CUDA_NVRTC_CHECK(result);
+    }
+
+    const char* lowered_name = nullptr;
+    at::globalContext().getNVRTC().nvrtcGetLoweredName(
+        program, func_name.c_str(), &lowered_name);
+    lowered_kernel_name = lowered_name;
+
+    {
+      FUSER_PERF_SCOPE("get PTX");
 #if CUDA_VERSION >= 11010
-    // compile_to_sass determines whether we are generating SASS or PTX, hence
-    // the different API.
-    const auto getSize = compile_to_sass
-        ? at::globalContext().getNVRTC().nvrtcGetCUBINSize
-        : at::globalContext().getNVRTC().nvrtcGetPTXSize;
-    const auto getFunc = compile_to_sass
-        ? at::globalContext().getNVRTC().nvrtcGetCUBIN
-        : at::globalContext().getNVRTC().nvrtcGetPTX;
+      // compile_to_sass determines whether we are generating SASS or PTX, hence
+      // the different API.
+      const auto getSize = compile_to_sass
+          ? at::globalContext().getNVRTC().nvrtcGetCUBINSize
+          : at::globalContext().getNVRTC().nvrtcGetPTXSize;
+      const auto getFunc = compile_to_sass
+          ? at::globalContext().getNVRTC().nvrtcGetCUBIN
+          : at::globalContext().getNVRTC().nvrtcGetPTX;
 #else
-    const auto getSize = at::globalContext().getNVRTC().nvrtcGetPTXSize;
-    const auto getFunc = at::globalContext().getNVRTC().nvrtcGetPTX;
+      const auto getSize = at::globalContext().getNVRTC().nvrtcGetPTXSize;
+      const auto getFunc = at::globalContext().getNVRTC().nvrtcGetPTX;
 #endif
-    AT_CUDA_NVRTC_CHECK(getSize(program, &ptx_size));
-    ptx.resize(ptx_size);
-    AT_CUDA_NVRTC_CHECK(getFunc(program, ptx.data()));
+      size_t size = 0;
+      AT_CUDA_NVRTC_CHECK(getSize(program, &size));
+      ptx.resize(size);
+      AT_CUDA_NVRTC_CHECK(getFunc(program, ptx.data()));
+    }
+
+    if (!cache_path.empty()) {
+      writeCachedKernel(cache_path, lowered_kernel_name, ptx);
+    }
   }
+  const size_t ptx_size = ptx.size();
 
   NvrtcFunction compiled_kernel_;
 
@@ -457,7 +589,7 @@ NvrtcFunction nvrtcCompile(
   AT_CUDA_DRIVER_CHECK(at::globalContext().getNVRTC().cuModuleGetFunction(
       &(compiled_kernel_.function),
       compiled_kernel_.module,
-      lowered_kernel_name));
+      lowered_kernel_name.c_str()));
 
   return compiled_kernel_;
 }
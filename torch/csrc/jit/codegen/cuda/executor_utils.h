@@ -46,6 +46,10 @@ struct NvrtcFunction {
   CUfunction function = CUfunction();
 };
 
+// Compiles code with NVRTC and loads func_name from it. If the environment
+// variable PYTORCH_CUDA_FUSER_CACHE_DIR names a directory, compiled binaries
+// are stored there and reused by later compilations of the same code for the
+// same architecture, including ones in other processes.
 NvrtcFunction nvrtcCompile(
     const std::string& code,
     const std::string& func_name,
@@ -6,6 +6,8 @@
 #include <torch/csrc/jit/codegen/cuda/scheduler.h>
 #include <torch/csrc/jit/runtime/graph_executor.h>
 
+#include <c10/util/hash.h>
+
 namespace torch {
 namespace jit {
 namespace fuser {
@@ -88,6 +90,19 @@ void debugPrint(const TensorTypePtr& type) {
 }
 #pragma clang diagnostic pop
 
+// Returns the outputs of all reductions in the fusion, in topological order.
+std::vector<TensorView*> findReductionTensors(Fusion* fusion) {
+  FusionGuard fg(fusion);
+
+  std::vector<TensorView*> reduction_tvs;
+  for (auto expr : fusion->exprs(true)) {
+    if (expr->getExprType() == ExprType::ReductionOp) {
+      reduction_tvs.push_back(expr->output(0)->as<TensorView>());
+    }
+  }
+  return reduction_tvs;
+}
+
 at::DimVector graphReductionAxes(const std::shared_ptr<Graph>& graph) {
   FUSER_PERF_SCOPE("graphReductionAxes");
 
@@ -204,58 +219,67 @@ at::DimVector inversePermutation(
 
 } // namespace
 
+size_t InputsIdLookup::EncodingHash::operator()(
+    const Encoding& encoding) const {
+  size_t hash = encoding.size();
+  for (auto value : encoding) {
+    hash = c10::hash_combine(hash, std::hash<int64_t>()(value));
+  }
+  return hash;
+}
+
 InputsIdLookup::IdLookupReturn InputsIdLookup::lookupId(
     const at::ArrayRef<IValue>& inputs) {
   IdLookupReturn ret;
-  std::stringstream encoded_inputs;
+  encoding_.clear();
   for (const auto& input : inputs) {
     if (input.isTensor()) {
       auto& input_tensor = input.toTensor();
-
-      encoded_inputs << ";";
-      auto sep = "";
-      for (auto size : input_tensor.sizes()) {
-        encoded_inputs << sep << size;
-        sep = ",";
-      }
-      encoded_inputs << "@";
-      sep = "";
-      for (auto stride : input_tensor.strides()) {
-        encoded_inputs << sep << stride;
-        sep = ",";
-      }
-      encoded_inputs << "@" << input_tensor.device().str();
+      // the rank delimits the sizes and strides
+      encoding_.push_back(input_tensor.dim());
+      encoding_.insert(
+          encoding_.end(),
+          input_tensor.sizes().begin(),
+          input_tensor.sizes().end());
+      encoding_.insert(
+          encoding_.end(),
+          input_tensor.strides().begin(),
+          input_tensor.strides().end());
+      encoding_.push_back(static_cast<int64_t>(input_tensor.scalar_type()));
+      encoding_.push_back(static_cast<int64_t>(input_tensor.device().type()));
+      encoding_.push_back(input_tensor.device().index());
     } else {
-      // encode s for scalar;
-      encoded_inputs << ";s";
+      // encode -1 for scalar;
+      encoding_.push_back(-1);
     }
   }
-  auto& id_iter_pair = encoding_lookup_[encoded_inputs.str()];
 
-  // short-cut to leave LRU entry as is;
-  if (id_iter_pair.lru_iter == used_entry_.begin()) {
+  auto encoding_iter = encoding_lookup_.find(encoding_);
+  if (encoding_iter != encoding_lookup_.end()) {
+    auto& id_iter_pair = encoding_iter->second;
     ret.id = id_iter_pair.id;
+    // move the entry to the front, unless it is already there
+    if (id_iter_pair.lru_iter != used_entry_.begin()) {
+      used_entry_.splice(
+          used_entry_.begin(), used_entry_, id_iter_pair.lru_iter);
+    }
     return ret;
   }
 
-  if (id_iter_pair.id == 0) {
-    // no entry existed for given input set, set id for given entry
-    id_iter_pair.id = current_id_++;
-    if (used_entry_.size() == max_cache_size_) {
-      // pop least recently used cache;
-      const auto& remove_iter = encoding_lookup_.find(used_entry_.back());
-      used_entry_.pop_back();
-      ret.evict_id = remove_iter->second.id;
-      ret.eviction = true;
-      encoding_lookup_.erase(remove_iter);
-    }
-  } else {
-    used_entry_.erase(id_iter_pair.lru_iter);
+  // no entry existed for given input set
+  if (used_entry_.size() == max_cache_size_) {
+    // pop least recently used cache;
+    const auto& remove_iter = encoding_lookup_.find(used_entry_.back());
+    ret.evict_id = remove_iter->second.id;
+    ret.eviction = true;
+    encoding_lookup_.erase(remove_iter);
+    used_entry_.pop_back();
   }
 
-  ret.id = id_iter_pair.id;
-  id_iter_pair.lru_iter =
-      used_entry_.insert(used_entry_.begin(), encoded_inputs.str());
+  ret.id = current_id_++;
+  used_entry_.push_front(encoding_);
+  encoding_lookup_.emplace(
+      encoding_, EncodingEntry{ret.id, used_entry_.begin()});
   return ret;
 }
 
@@ -264,6 +288,7 @@ FusionExecutorCache::FusionExecutorCache(std::unique_ptr<Fusion>&& fusion)
   FUSER_PERF_SCOPE("FusionExecutorCache::FusionExecutorCache");
   // avoid putting `has_reduction_` in the initializer list
   has_reduction_ = fusion_->hasReduction();
+  is_normalization_ = has_reduction_ && isNormalizationFusion(fusion_.get());
 }
 
 std::vector<at::Tensor> FusionExecutorCache::runFusionWithInputs(
@@ -286,7 +311,36 @@ std::vector<at::Tensor> FusionExecutorCache::runFusionWithInputs(
     // entries in cached `FusionExecutor` or compile new one as needed.
 
     // caching strategy is different for pw-fusion and reduction-fusion.
-    if (has_reduction_) {
+    if (is_normalization_) {
+      // Generate the normalization parameters
+      auto reduction_params = getNormalizationHeuristics(
+          fusion_.get(), inputs, findReductionTensors(fusion_.get()));
+
+      TORCH_INTERNAL_ASSERT(
+          reduction_params.has_value(),
+          "Error getting normalization heuristics for scheduling.");
+
+      launch_params = reduction_params.value().lparams;
+
+      auto fusion_executor =
+          &red_fusion_executor_cache_[device_index][reduction_params.value()];
+
+      if (!fusion_executor->compiled()) {
+        Fusion fusion = *fusion_;
+
+        FusionGuard fg(&fusion);
+
+        scheduleNormalization(
+            &fusion, reduction_params.value(), findReductionTensors(&fusion));
+
+        CompileOptions options;
+        options.device = c10::Device(DeviceType::CUDA, device_index);
+        fusion_executor->compileFusion(&fusion, options);
+      }
+      // record new short cut to `FusionExecutor`
+      code_to_fe_lookup_[unique_id] = fusion_executor;
+
+    } else if (has_reduction_) {
       // Grab the fusion to analyze for heuristics
       FusionGuard fg(fusion_.get());
 
@@ -557,7 +611,11 @@ GraphCache::GraphCache(const std::shared_ptr<Graph>& graph) {
       }
     }
   }
-  extractPermutation(acc_type);
+  // Normalizations operate on the innermost axes of their input, which the
+  // permutation would reorder, so graphs containing them are left as is.
+  if (!hasNormalizationNode(graph->block())) {
+    extractPermutation(acc_type);
+  }
   createFusion(graph);
 }
 
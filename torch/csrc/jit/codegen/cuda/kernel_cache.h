@@ -7,8 +7,10 @@
 #include <c10/util/ArrayRef.h>
 #include <torch/csrc/WindowsTorchApiMacro.h>
 
+#include <list>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 namespace torch {
 namespace jit {
@@ -23,6 +25,11 @@ namespace cuda {
 //! grow gigantic when we have input shapes that does not stabalize to a finite
 //! set.
 //!
+//! Input sets are encoded as a sequence of integers: for each tensor its rank,
+//! sizes, strides, scalar type and device, and a marker for each scalar. This
+//! is cheap to build and hash compared to formatting the input set, as
+//! `lookupId` is called on every run.
+//!
 //! \note the uniqueness of the ide generated for a given input set is only
 //!   local to the instance of `InputsIdLookup`.
 //!
@@ -52,10 +59,16 @@ class TORCH_CUDA_CU_API InputsIdLookup {
   }
 
  private:
+  using Encoding = std::vector<int64_t>;
+
+  struct EncodingHash {
+    size_t operator()(const Encoding& encoding) const;
+  };
+
   //! entry stored in `encoding_lookup_` to implement LRU
   struct EncodingEntry {
     size_t id;
-    std::list<std::string>::iterator lru_iter;
+    std::list<Encoding>::iterator lru_iter;
   };
 
   //! maximum cache size for LRU
@@ -68,12 +81,15 @@ class TORCH_CUDA_CU_API InputsIdLookup {
   //! entry in the cache, This is used to implement LRU cache, where entries in
   //! the list is ordered by their recent usage (freshly used entry is placed at
   //! the beginning)
-  std::list<std::string> used_entry_;
+  std::list<Encoding> used_entry_;
 
-  //! map from `std::string` to a unique id `size_t` (packaged in
+  //! map from `Encoding` to a unique id `size_t` (packaged in
   //! `EncodingEntry`
   //! ). We store an iterator to `used_entry_` to implement LRU
-  std::unordered_map<std::string, EncodingEntry> encoding_lookup_;
+  std::unordered_map<Encoding, EncodingEntry, EncodingHash> encoding_lookup_;
+
+  //! reused across lookups to encode the inputs without allocating
+  Encoding encoding_;
 };
 
 //! [ Note -- 2 level cache implementation ]
@@ -160,6 +176,10 @@ class FusionExecutorCache {
   //! cache fusion->hasReduction() because it's expensive;
   bool has_reduction_;
 
+  //! cache isNormalizationFusion(fusion), normalization fusions contain
+  //! reductions and are scheduled by `scheduleNormalization`;
+  bool is_normalization_;
+
   //! TODO: ugly logic for now. We should integrate the hashing of cache for
   //!       different kernels. (alternatively we could do so in scheduler).
   //! ugly bits now:
@@ -169,6 +189,7 @@ class FusionExecutorCache {
   //!    `pw_fusion_executor_cache_`
   //! 2. For reduction fusion we have a hash table with ReductionParams as entry
   //!    pointing to the actual `FusionExecutor` in `red_fusion_executor_cache_`
+  //!    Normalization fusions are keyed on their ReductionParams as well.
   //!
   //! Both cache_ key on device_index, because `FusionExecutor` is designated to
   //! a single device
@@ -500,6 +500,84 @@ class IrParser {
           },
           true);
     }
+
+    {
+      auto ptr_op = getOperatorForLiteral(
+          "aten::layer_norm(Tensor input, int[] normalized_shape, Tensor? weight=None, Tensor? bias=None, float eps=1e-05, bool cudnn_enable=True) -> Tensor");
+      registerParseRule(
+          ptr_op,
+          [](const Node* node,
+             std::unordered_map<size_t, CgValue>& value_map) -> void {
+            auto input = value_map[node->input(0)->unique()]->as<TensorView>();
+            auto norm_shape = constant_as<c10::List<int64_t>>(node->input(1));
+            TORCH_INTERNAL_ASSERT(
+                norm_shape.has_value(), "requires static normalized_shape");
+            auto eps = value_map[node->input(4)->unique()];
+
+            const size_t num_input_dims = input->getRootDomain().size();
+            const size_t num_norm_dims = norm_shape->size();
+            const size_t num_outer_dims = num_input_dims - num_norm_dims;
+
+            std::vector<int> reduction_axes;
+            std::vector<bool> inner_broadcast_mask(num_input_dims, false);
+            std::vector<bool> outer_broadcast_mask(num_input_dims, false);
+            Val* num_features = new Int(1);
+            for (size_t axis = 0; axis < num_input_dims; axis++) {
+              if (axis < num_outer_dims) {
+                outer_broadcast_mask[axis] = true;
+              } else {
+                reduction_axes.push_back(static_cast<int>(axis));
+                inner_broadcast_mask[axis] = true;
+                num_features = mul(
+                    num_features, input->getRootDomain()[axis]->extent());
+              }
+            }
+
+            // The variance is computed in a second pass over the centered
+            // input, which is as stable as a single Welford pass. The
+            // centered input is computed again for the output instead of
+            // being kept around, so that it doesn't need a buffer per row.
+            auto x_sum = sum(input, reduction_axes);
+            auto x_sum_bcast = broadcast(x_sum, inner_broadcast_mask);
+            auto x_mean = div(x_sum_bcast, num_features);
+            auto x_mean_sub = sub(input, x_mean);
+            auto x_mean_sub_pow = mul(x_mean_sub, x_mean_sub);
+            auto var_sum = sum(x_mean_sub_pow, reduction_axes);
+            auto var_sum_bcast = broadcast(var_sum, inner_broadcast_mask);
+            auto var = div(var_sum_bcast, num_features);
+            auto var_eps = add(var, eps);
+            auto rvar = unaryOp(UnaryOpType::Rsqrt, var_eps);
+            auto output = mul(sub(input, x_mean), rvar);
+
+            if (!node->input(2)->type()->isSubtypeOf(
+                    static_cast<c10::TypePtr>(NoneType::get()))) {
+              auto weight =
+                  value_map[node->input(2)->unique()]->as<TensorView>();
+              output = mul(output, broadcast(weight, outer_broadcast_mask));
+            }
+            if (!node->input(3)->type()->isSubtypeOf(
+                    static_cast<c10::TypePtr>(NoneType::get()))) {
+              auto bias = value_map[node->input(3)->unique()]->as<TensorView>();
+              output = add(output, broadcast(bias, outer_broadcast_mask));
+            }
+            value_map.emplace(node->output()->unique(), output);
+          },
+          [](const Node* node) -> bool {
+            // we don't support dynamic normalized_shape;
+            if (node->input(1)->node()->kind() != prim::Constant) {
+              return false;
+            }
+            // we need at least one outer axis to distribute across blocks;
+            auto input_type = node->input(0)->type()->cast<TensorType>();
+            auto norm_shape = constant_as<c10::List<int64_t>>(node->input(1));
+            if (!input_type || !input_type->dim().has_value() ||
+                !norm_shape.has_value() ||
+                *input_type->dim() <= norm_shape->size()) {
+              return false;
+            }
+            return true;
+          });
+    }
   }
 
   void processJitNode(const JitOp* node) {
@@ -634,6 +712,24 @@ bool isReductionNode(const Node* node) {
   return IrParser::isReductionNode(node);
 }
 
+bool isNormalizationNode(const Node* node) {
+  return node->kind() == aten::layer_norm;
+}
+
+bool hasNormalizationNode(const Block* block) {
+  for (auto node : block->nodes()) {
+    if (isNormalizationNode(node)) {
+      return true;
+    }
+    for (auto block : node->blocks()) {
+      if (hasNormalizationNode(block)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 bool isNodeParsible(const Node* node) {
   return IrParser::canParseNode(node);
 }
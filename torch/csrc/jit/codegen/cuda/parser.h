@@ -34,6 +34,12 @@ TORCH_CUDA_CU_API bool hasReductionNode(const Block* block);
 
 TORCH_CUDA_CU_API bool isReductionNode(const Node* node);
 
+// Normalizations reduce and broadcast back their innermost axes, but keep the
+// shape of their input, so the partition treats them as pointwise operations.
+TORCH_CUDA_CU_API bool isNormalizationNode(const Node* node);
+
+TORCH_CUDA_CU_API bool hasNormalizationNode(const Block* block);
+
 // returns whether or not a parsing function exists for the given node type.
 TORCH_CUDA_CU_API bool isNodeParsible(const Node* node);
 
@@ -7,10 +7,13 @@
 #include <torch/csrc/jit/codegen/cuda/ir_all_nodes.h>
 #include <torch/csrc/jit/codegen/cuda/ir_iostream.h>
 #include <torch/csrc/jit/codegen/cuda/ir_utils.h>
+#include <torch/csrc/jit/codegen/cuda/iter_visitor.h>
 #include <torch/csrc/jit/codegen/cuda/parser.h>
 
 #include <ATen/cuda/CUDAContext.h>
 
+#include <algorithm>
+
 namespace torch {
 namespace jit {
 namespace fuser {
@@ -678,6 +681,286 @@ void scheduleReduction(
   }
 }
 
+bool isNormalizationFusion(Fusion* fusion) {
+  FusionGuard fg(fusion);
+
+  if (!fusion->hasReduction()) {
+    return false;
+  }
+
+  std::vector<Val*> reduction_tvs;
+  std::vector<Val*> broadcast_inputs;
+  for (auto expr : fusion->exprs(true)) {
+    if (expr->getExprType() == ExprType::ReductionOp) {
+      reduction_tvs.push_back(expr->output(0));
+    } else if (expr->getExprType() == ExprType::BroadcastOp) {
+      broadcast_inputs.push_back(expr->as<BroadcastOp>()->in());
+    }
+  }
+
+  for (auto broadcast_input : broadcast_inputs) {
+    for (auto reduction_tv : reduction_tvs) {
+      if (broadcast_input == reduction_tv ||
+          DependencyCheck::isDependencyOf(reduction_tv, broadcast_input)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+namespace {
+
+// Returns the number of innermost root axes reduced by all of reduction_tvs,
+// or 0 if they don't reduce the same innermost axes or if no iteration axis
+// is left to distribute across blocks.
+size_t innerReductionAxes(const std::vector<TensorView*>& reduction_tvs) {
+  size_t rank = 0;
+  size_t num_red_axes = 0;
+  for (auto tv : reduction_tvs) {
+    const auto& root = tv->getRootDomain();
+    size_t num_inner = 0;
+    while (num_inner < root.size() &&
+           root[root.size() - 1 - num_inner]->isReduction()) {
+      num_inner++;
+    }
+    for (size_t i = 0; i < root.size() - num_inner; i++) {
+      if (root[i]->isReduction()) {
+        return 0;
+      }
+    }
+    if (rank == 0) {
+      rank = root.size();
+      num_red_axes = num_inner;
+    } else if (rank != root.size() || num_red_axes != num_inner) {
+      return 0;
+    }
+  }
+  return num_red_axes < rank ? num_red_axes : 0;
+}
+
+// Returns the tensors that span the normalized axes and are read by more than
+// one expression. A row of each of them is needed by several passes over the
+// row; intermediates have to be buffered in shared memory, inputs can be read
+// again from global memory instead.
+std::vector<TensorView*> persistentBuffers(
+    Fusion* fusion,
+    size_t rank,
+    size_t num_red_axes) {
+  std::vector<TensorView*> buffers;
+  auto used_vals = DependencyCheck::getAllValsBetween(
+      {fusion->inputs().begin(), fusion->inputs().end()}, fusion->outputs());
+  for (auto tv : ir_utils::filterByType<TensorView>(used_vals)) {
+    const auto& root = tv->getRootDomain();
+    if (fusion->hasOutput(tv) || tv->hasReduction() || root.size() != rank ||
+        fusion->unordered_uses(tv).size() < 2) {
+      continue;
+    }
+    if (std::any_of(
+            root.end() - num_red_axes, root.end(), [](IterDomain* id) {
+              return !id->isBroadcast();
+            })) {
+      buffers.push_back(tv);
+    }
+  }
+  return buffers;
+}
+
+} // namespace
+
+TORCH_CUDA_CU_API c10::optional<ReductionParams> getNormalizationHeuristics(
+    Fusion* fusion,
+    const at::ArrayRef<c10::IValue>& fusion_inputs,
+    const std::vector<TensorView*>& reduction_tvs) {
+  FUSER_PERF_SCOPE("getNormalizationHeuristics");
+
+  FusionGuard fg(fusion);
+
+  if (reduction_tvs.empty()) {
+    return c10::nullopt;
+  }
+
+  const size_t num_red_axes = innerReductionAxes(reduction_tvs);
+  if (num_red_axes == 0) {
+    return c10::nullopt;
+  }
+  const size_t rank = reduction_tvs[0]->getRootDomain().size();
+
+  StatefulExpressionEvaluator evaluator(
+      executor_utils::statefulBindInputs(fusion_inputs, fusion));
+
+  int64_t red_outputs = 1;
+  int64_t red_elements = 1;
+
+  for (auto id : reduction_tvs[0]->getRootDomain()) {
+    auto inferred_val = evaluator.inferValue(id->rawExtent());
+    TORCH_INTERNAL_ASSERT(
+        inferred_val.has_value(), "Error inferring reduction size.");
+    if (id->isReduction()) {
+      red_elements *= inferred_val.value();
+    } else {
+      red_outputs *= inferred_val.value();
+    }
+  }
+
+  int64_t input_buffer_bytes = 0;
+  int64_t intermediate_buffer_bytes = 0;
+  for (auto tv : persistentBuffers(fusion, rank, num_red_axes)) {
+    const int64_t bytes =
+        dataTypeSize(tv->getDataType().value()) * red_elements;
+    if (fusion->hasInput(tv)) {
+      input_buffer_bytes += bytes;
+    } else {
+      intermediate_buffer_bytes += bytes;
+    }
+  }
+
+  ReductionParams rparams;
+  rparams.fastest_dim = true;
+  rparams.cross_block = true;
+  rparams.loop_unroll = 1;
+
+  // A block normalizes one row. Each thread handles a few values of the row
+  // before the block reduction, so that short rows don't idle most threads.
+  constexpr int kMaxNumThreads = 512;
+  constexpr int kTargetValuesPerThread = 4;
+  const int device_warp_size = at::cuda::warp_size();
+  int bdimx = lastPow2(static_cast<int>(std::min<int64_t>(
+      ceilDiv(red_elements, kTargetValuesPerThread), kMaxNumThreads)));
+  bdimx = std::max(bdimx, device_warp_size);
+
+  // Shared memory left after the workspace of block reductions and broadcasts
+  const int64_t smem_budget = static_cast<int64_t>(
+      at::cuda::getCurrentDeviceProperties()->sharedMemPerBlock -
+      bdimx * sizeof(double));
+
+  // Intermediates read by several passes have to stay on chip.
+  if (intermediate_buffer_bytes > smem_budget) {
+    return c10::nullopt;
+  }
+
+  // Rows that fit in shared memory are loaded once and kept there for all
+  // passes. Longer rows are read again from global memory by each pass.
+  rparams.persistent_kernel = input_buffer_bytes > 0 &&
+      input_buffer_bytes + intermediate_buffer_bytes <= smem_budget;
+
+  const char* debug_env = getenv("PYTORCH_CUDA_FUSER_RED_SCHED_DEBUG");
+  if (debug_env && atoi(debug_env)) {
+    std::cout << "\n===== Normalization Parameters ========" << std::endl
+              << "Inputs:" << std::endl
+              << "\tRed Elems: " << red_elements
+              << " Red Outputs: " << red_outputs
+              << " Num Reductions: " << reduction_tvs.size() << std::endl
+              << "\tInput Buffers: " << input_buffer_bytes
+              << "B Intermediate Buffers: " << intermediate_buffer_bytes
+              << "B Smem Budget: " << smem_budget << "B" << std::endl
+              << "Normalization Characteristics:" << std::endl
+              << "\tPersistent? " << rparams.persistent_kernel << std::endl
+              << "Recommended Blocking:" << std::endl
+              << "\tBlckX: " << bdimx << std::endl
+              << "====================================" << std::endl;
+  }
+
+  rparams.lparams = LaunchParams(
+      LaunchParams::UNINITIALIZED_VAL,
+      LaunchParams::UNINITIALIZED_VAL,
+      LaunchParams::UNINITIALIZED_VAL,
+      bdimx,
+      LaunchParams::UNINITIALIZED_VAL,
+      LaunchParams::UNINITIALIZED_VAL);
+  return rparams;
+}
+
+// fusion is the input IR that will be modified by this function
+void scheduleNormalization(
+    Fusion* fusion,
+    const ReductionParams& rparams,
+    const std::vector<TensorView*>& reduction_tvs) {
+  FUSER_PERF_SCOPE("scheduleNormalization");
+
+  FusionGuard fg(fusion);
+
+  const size_t num_red_axes = innerReductionAxes(reduction_tvs);
+  TORCH_INTERNAL_ASSERT(
+      num_red_axes > 0,
+      "Normalization fusions have to reduce the same innermost axes.");
+  const size_t rank = reduction_tvs[0]->getRootDomain().size();
+  const size_t num_iter_axes = rank - num_red_axes;
+
+  // Intermediates read by several passes over a row live in shared memory.
+  // Inputs read by several passes are only cached there in persistent mode.
+  for (auto tv : persistentBuffers(fusion, rank, num_red_axes)) {
+    if (!fusion->hasInput(tv)) {
+      tv->setMemoryType(MemoryType::Shared);
+    } else if (rparams.persistent_kernel) {
+      tv->cache_after()->setMemoryType(MemoryType::Shared);
+    }
+  }
+
+  std::vector<TensorView*> all_tvs;
+  auto used_vals = DependencyCheck::getAllValsBetween(
+      {fusion->inputs().begin(), fusion->inputs().end()}, fusion->outputs());
+  for (auto tv : ir_utils::filterByType<TensorView>(used_vals)) {
+    if (!fusion->hasInput(tv) && tv->nDims() == rank) {
+      all_tvs.push_back(tv);
+    }
+  }
+
+  // Coalesce iteration and normalized axes and split the latter by the block
+  //      [I0, .., In, N0, .., Nm] => [I, N/TIDx, TIDx]
+  // Idx:                              0    1      2
+  for (auto tv : all_tvs) {
+    for (size_t i = 1; i < num_red_axes; i++) {
+      tv->merge(static_cast<int>(num_iter_axes));
+    }
+    for (size_t i = 1; i < num_iter_axes; i++) {
+      tv->merge(0);
+    }
+    tv->split(-1, NamedScalar::getParallelDim(ParallelType::TIDx));
+  }
+
+  // Reduction Tensors
+  //   rFactored: [I, rN/TIDx, TIDx]
+  //   Reduction: [I, rTIDx]
+  for (auto red_tv : reduction_tvs) {
+    all_tvs.push_back(red_tv->rFactor({1}));
+  }
+
+  // Compute all passes over a row within the row loop...
+  for (auto output : ir_utils::filterByType<TensorView>(fusion->outputs())) {
+    for (auto input : fusion->inputsOf(output)) {
+      if (input->getValType().value() == ValType::TensorView) {
+        input->as<TensorView>()->computeAt(output, 1);
+      }
+    }
+  }
+
+  // ...and inline tensors that are read once into their consumer, so that
+  // only the persistent buffers hold a whole row.
+  for (auto expr : fusion->exprs(true)) {
+    for (auto tv : ir_utils::filterByType<TensorView>(expr->outputs())) {
+      if (fusion->hasOutput(tv) || tv->nDims() != 3 ||
+          tv->getMemoryType() != MemoryType::Local) {
+        continue;
+      }
+      const auto uses = fusion->unordered_uses(tv);
+      if (uses.size() != 1) {
+        continue;
+      }
+      auto consumer = (*uses.begin())->output(0);
+      if (consumer->getValType().value() == ValType::TensorView &&
+          consumer->as<TensorView>()->nDims() == 3) {
+        tv->computeAt(consumer->as<TensorView>(), 2);
+      }
+    }
+  }
+
+  for (auto tv : all_tvs) {
+    tv->axis(0)->parallelize(ParallelType::BIDx);
+    tv->axis(-1)->parallelize(ParallelType::TIDx);
+  }
+}
+
 } // namespace cuda
 } // namespace fuser
 } // namespace jit
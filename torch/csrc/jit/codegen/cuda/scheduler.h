@@ -30,6 +30,9 @@ struct ReductionParams {
   bool mul_reds_per_blk = false;
   // Unrolling factor
   int loop_unroll = 4;
+  // Keep inputs read by several reduction passes in shared memory? Only used
+  // by normalization schedules.
+  bool persistent_kernel = false;
 
   LaunchParams lparams;
 
@@ -38,7 +41,8 @@ struct ReductionParams {
     bool attr_equal = other.fastest_dim == fastest_dim &&
         other.cross_block == cross_block && other.cross_grid == cross_grid &&
         other.mul_reds_per_blk == mul_reds_per_blk &&
-        other.loop_unroll == loop_unroll;
+        other.loop_unroll == loop_unroll &&
+        other.persistent_kernel == persistent_kernel;
     return attr_equal;
   }
 };
@@ -51,7 +55,8 @@ class ReductionParamsHash {
     size_t attr_hash = static_cast<size_t>(rp.fastest_dim) << (bits - 1) |
         static_cast<size_t>(rp.cross_block) << (bits - 2) |
         static_cast<size_t>(rp.cross_grid) << (bits - 3) |
-        static_cast<size_t>(rp.mul_reds_per_blk) << (bits - 4);
+        static_cast<size_t>(rp.mul_reds_per_blk) << (bits - 4) |
+        static_cast<size_t>(rp.persistent_kernel) << (bits - 5);
     return attr_hash;
   }
 };
@@ -67,6 +72,24 @@ TORCH_CUDA_CU_API void scheduleReduction(
     TensorView* red_tv,
     std::vector<TensorView*> outs_of_red);
 
+// return true if a reduction result in fusion is broadcast back and combined
+// with the tensor it reduced, as in layer_norm or softmax. Such fusions are
+// scheduled with getNormalizationHeuristics and scheduleNormalization.
+TORCH_CUDA_CU_API bool isNormalizationFusion(Fusion* fusion);
+
+// Returns c10::nullopt if the reductions in the fusion don't all reduce the
+// same innermost axes, or if the intermediates that have to be kept around
+// between reduction passes don't fit in shared memory.
+TORCH_CUDA_CU_API c10::optional<ReductionParams> getNormalizationHeuristics(
+    Fusion* fusion,
+    const at::ArrayRef<c10::IValue>& fusion_inputs,
+    const std::vector<TensorView*>& reduction_tvs);
+
+TORCH_CUDA_CU_API void scheduleNormalization(
+    Fusion* fusion,
+    const ReductionParams& rparams,
+    const std::vector<TensorView*>& reduction_tvs);
+
 } // namespace cuda
 } // namespace fuser
 } // namespace jit
@@ -77,13 +77,9 @@ void delValueTrace(const IValue& var) {
   getTracingState()->delValue(var);
 }
 void TracingState::delValue(const IValue& var) {
+  const WeakIValue key(var);
   for (size_t i = 0; i < env_stack.size(); ++i) {
-    auto& value_map = env_stack.at(env_stack.size() - 1 - i);
-    auto it = value_map.find(var);
-    if (it == value_map.end()) {
-      continue;
-    }
-    value_map.erase(it);
+    env_stack.at(env_stack.size() - 1 - i).erase(key);
   }
 }
 
@@ -143,14 +139,17 @@ Value* TracingState::getValue(const IValue& var) {
       Node* n = graph->createNone();
       return graph->insertNode(n)->output();
     }
+    // Every input of every traced op is looked up here, so the key is made
+    // once rather than per frame.
+    const WeakIValue key(var);
     for (size_t i = 0; i < env_stack.size(); ++i) {
       auto& value_map = env_stack.at(env_stack.size() - 1 - i);
-      auto it = value_map.find(var);
+      auto it = value_map.find(key);
       if (it == value_map.end()) {
         continue;
       }
-      if (!it->second->hasDebugName()) {
-        auto unique_name = getTracingState()->lookup_var_name_fn(ten);
+      if (record_debug_info && !it->second->hasDebugName()) {
+        auto unique_name = lookup_var_name_fn(ten);
         if (!unique_name.empty()) {
           it->second->setDebugName(unique_name);
         }
@@ -227,8 +226,9 @@ Value* TracingState::getValue(const IValue& var) {
   }
 }
 bool TracingState::hasValue(const IValue& var) const {
+  const WeakIValue key(var);
   for (const auto& frame : env_stack) {
-    if (frame.count(var)) {
+    if (frame.count(key)) {
       return true;
     }
   }
@@ -451,7 +451,8 @@ std::pair<std::shared_ptr<TracingState>, Stack> trace(
     bool strict,
     bool force_outplace,
     Module* self,
-    const std::vector<std::string>& argument_names) {
+    const std::vector<std::string>& argument_names,
+    bool record_debug_info) {
   try {
     // Start tracing, treating 'inputs' as inputs to the trace, which can be
     // varied on subsequent invocations of the trace.  Any other variables
@@ -460,6 +461,7 @@ std::pair<std::shared_ptr<TracingState>, Stack> trace(
       AT_ERROR("Tracing can't be nested");
     }
     auto state = std::make_shared<TracingState>();
+    state->record_debug_info = record_debug_info;
     setTracingState(state);
 
     // if we are a module, then make sure the modules parameters are in the map
@@ -966,6 +968,10 @@ void defaultRecordSourceLocation(Node* n) {}
 std::atomic<decltype(&defaultRecordSourceLocation)> record_source_location(
     defaultRecordSourceLocation);
 void recordSourceLocation(Node* n) {
+  const auto& state = getTracingState();
+  if (state && !state->record_debug_info) {
+    return;
+  }
   return record_source_location.load()(n);
 }
 void setRecordSourceLocation(void (*v)(Node*)) {
@@ -4,6 +4,7 @@
 #include <ATen/core/jit_type.h>
 #include <ATen/core/stack.h>
 #include <c10/util/Exception.h>
+#include <c10/util/flat_hash_map.h>
 #include <torch/csrc/WindowsTorchApiMacro.h>
 
 #include <torch/csrc/jit/api/object.h>
@@ -48,6 +49,12 @@ struct TORCH_API TracingState
   bool warn = true;
   bool strict = true;
   bool force_outplace = false;
+  // Whether to record the Python source range of every node, the Python
+  // variable names of the values and the scopes of the modules. Each of these
+  // inspects the Python interpreter state, which dominates the time it takes
+  // to trace very large models. Without scopes, the traced module methods are
+  // not split into calls to the submodules.
+  bool record_debug_info = true;
   std::function<std::string(const Variable& var)> lookup_var_name_fn =
       [](const Variable& var) { return ""; };
 
@@ -81,7 +88,7 @@ struct TORCH_API TracingState
   };
 
   using Frame =
-      std::unordered_map<WeakIValue, Value*, WeakIValueHasher, WeakIValueEq>;
+      ska::flat_hash_map<WeakIValue, Value*, WeakIValueHasher, WeakIValueEq>;
   std::vector<Frame> env_stack;
 };
 
@@ -215,7 +222,8 @@ TORCH_API std::pair<std::shared_ptr<TracingState>, Stack> trace(
     bool strict = true,
     bool force_outplace = false,
     Module* self = nullptr,
-    const std::vector<std::string>& argument_names = {});
+    const std::vector<std::string>& argument_names = {},
+    bool record_debug_info = true);
 
 TORCH_API void abandon();
 
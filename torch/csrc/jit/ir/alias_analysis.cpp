@@ -152,6 +152,7 @@ AliasDb::AliasDb(std::shared_ptr<Graph> graph, bool isFrozen)
       isFrozen_(isFrozen),
       memoryDAGBuilder_(std::make_unique<MemoryDAGBuilder>()),
       writeRegistry_(std::make_unique<AliasDb::WriteRegistry>()) {
+  JIT_PASS_TIMER;
   analyze(graph_);
 
   memoryDAG_ = std::make_unique<MemoryDAG>(std::move(memoryDAGBuilder_));
@@ -252,6 +253,9 @@ bool AliasDb::hasWriters(const Value* v) const {
   }
 
   const auto& el = it->second;
+  if (!writtenToLocationsIndex_) {
+    writtenToLocationsIndex_ = buildWrittenToLocationsIndex();
+  }
   return writtenToLocationsIndex_->intersects(
       memoryDAG_->getMemoryLocations(el));
 }
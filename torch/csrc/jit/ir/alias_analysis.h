@@ -267,8 +267,9 @@ class AliasDb {
   // Map of nodes to the memory locations that they write to
   using TWriteIndex = ska::flat_hash_map<Node*, MemoryLocations>;
   c10::optional<TWriteIndex> writeIndex_;
-  // Collection of all memory locations that are written to.
-  c10::optional<MemoryLocations> writtenToLocationsIndex_;
+  // Collection of all memory locations that are written to. Built lazily, so
+  // that passes updating the write index only pay for it when they query it.
+  mutable c10::optional<MemoryLocations> writtenToLocationsIndex_;
   MemoryLocations buildWrittenToLocationsIndex() const;
 
   std::unordered_set<const Value*> wildcards_;
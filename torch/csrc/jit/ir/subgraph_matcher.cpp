@@ -332,6 +332,13 @@ std::vector<Match> findPatternMatches(const Graph& pattern, Graph& graph) {
   std::vector<Match> matches;
   std::stack<Block*> blocks_to_visit;
 
+  // Only nodes of the kind of the last node of the pattern can anchor a
+  // match, which rules out most nodes without setting up a match for them.
+  const Node* bottom_node = (*pattern.nodes().end())->input(0)->node();
+  const bool any_anchor =
+      bottom_node->kind() == Symbol::fromQualString("match::module") ||
+      bottom_node->kind() == prim::Param;
+
   // Iterate over all nodes in the graph (including nodes in subblocks) trying
   // to match the pattern each node.
   blocks_to_visit.push(graph.block());
@@ -339,7 +346,8 @@ std::vector<Match> findPatternMatches(const Graph& pattern, Graph& graph) {
     Block* block = blocks_to_visit.top();
     blocks_to_visit.pop();
     for (Node* n : block->nodes()) {
-      if (m.matchesSubgraphFromAnchorNode(n)) {
+      if ((any_anchor || n->kind() == bottom_node->kind()) &&
+          m.matchesSubgraphFromAnchorNode(n)) {
         matches.push_back({n, m.nodes_map(), m.values_map()});
       }
       for (Block* subblock : n->blocks()) {
@@ -1,7 +1,11 @@
 
+#include <chrono>
 #include <cstdlib>
 #include <iomanip>
+#include <iostream>
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 #include <ATen/core/function.h>
@@ -52,23 +56,72 @@ static std::unordered_map<std::string, size_t> parseJITLogOption(
   return files_to_levels;
 }
 
-bool is_enabled(const char* cfname, JitLoggingLevels level) {
-  static const char* c_log_level = std::getenv("PYTORCH_JIT_LOG_LEVEL");
-  static const std::unordered_map<std::string, size_t> files_to_levels =
-      parseJITLogOption(c_log_level);
+static std::string fileNameNoExt(const char* cfname) {
   std::string fname{cfname};
   fname = c10::detail::StripBasename(fname);
   auto end_index = fname.find_last_of('.') == std::string::npos
       ? fname.size()
       : fname.find_last_of('.');
-  auto fname_no_ext = fname.substr(0, end_index);
+  return fname.substr(0, end_index);
+}
 
-  auto it = files_to_levels.find(fname_no_ext);
+static int64_t fileLogLevel(const char* cfname) {
+  static const char* c_log_level = std::getenv("PYTORCH_JIT_LOG_LEVEL");
+  static const std::unordered_map<std::string, size_t> files_to_levels =
+      parseJITLogOption(c_log_level);
+  auto it = files_to_levels.find(fileNameNoExt(cfname));
   if (it == files_to_levels.end()) {
-    return false;
+    return -1;
   }
+  return it->second;
+}
 
-  return level <= static_cast<JitLoggingLevels>(it->second);
+bool is_enabled(const char* cfname, JitLoggingLevels level) {
+  // Passes log in their inner loops, where building the file name of every
+  // statement used to dominate the run time on large graphs
+  thread_local std::unordered_map<const char*, int64_t> cached_levels;
+  auto it = cached_levels.find(cfname);
+  if (it == cached_levels.end()) {
+    it = cached_levels.emplace(cfname, fileLogLevel(cfname)).first;
+  }
+  return it->second >= 0 &&
+      level <= static_cast<JitLoggingLevels>(it->second);
+}
+
+static bool passTimingEnabled() {
+  static const bool enabled = []() {
+    const char* c_timing = std::getenv("PYTORCH_JIT_PASS_TIMING");
+    return c_timing && std::string(c_timing) != "0";
+  }();
+  return enabled;
+}
+
+static int64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+JitPassTimer::JitPassTimer(const char* cfname) : cfname_(cfname) {
+  if (passTimingEnabled()) {
+    start_ns_ = nowNs();
+  }
+}
+
+JitPassTimer::~JitPassTimer() {
+  if (start_ns_ < 0) {
+    return;
+  }
+  const int64_t elapsed_ns = nowNs() - start_ns_;
+  static std::mutex mutex;
+  static std::unordered_map<std::string, int64_t> total_ns;
+  auto pass = fileNameNoExt(cfname_);
+  std::lock_guard<std::mutex> guard(mutex);
+  auto& total = total_ns[pass];
+  total += elapsed_ns;
+  std::cerr << "[PASS TIMING] " << pass << ": " << std::fixed
+            << std::setprecision(3) << elapsed_ns / 1e6 << " ms ("
+            << total / 1e6 << " ms in total)" << std::endl;
 }
 
 // Unfortunately, in `GraphExecutor` where `log_function` is invoked
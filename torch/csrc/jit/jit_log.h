@@ -1,5 +1,6 @@
 #pragma once
 #include <torch/csrc/WindowsTorchApiMacro.h>
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -65,6 +66,8 @@ TORCH_API std::string jit_log_prefix(
     int l,
     const std::string& in_str);
 
+// cfname must be a string literal such as __FILE__: the result is cached per
+// pointer, since this is called by every logging statement.
 TORCH_API bool is_enabled(
     const char* cfname,
     ::torch::jit::JitLoggingLevels level);
@@ -99,6 +102,26 @@ TORCH_API std::ostream& operator<<(
 #define GRAPH_DEBUG(...) \
   JIT_LOG(::torch::jit::JitLoggingLevels::GRAPH_DEBUG, __VA_ARGS__);
 
+// Setting `PYTORCH_JIT_PASS_TIMING=1` makes every pass that declares a
+// `JIT_PASS_TIMER` at the start of its entry point print to stderr the wall
+// time of each of its runs and the total time spent in it so far. Passes are
+// named after their file, as for logging. Runs of nested passes are included
+// in the time of the enclosing ones.
+class TORCH_API JitPassTimer {
+ public:
+  explicit JitPassTimer(const char* cfname);
+  ~JitPassTimer();
+
+  JitPassTimer(const JitPassTimer&) = delete;
+  JitPassTimer& operator=(const JitPassTimer&) = delete;
+
+ private:
+  const char* cfname_;
+  int64_t start_ns_{-1};
+};
+
+#define JIT_PASS_TIMER ::torch::jit::JitPassTimer jit_pass_timer_(__FILE__)
+
 #define GRAPH_DUMP_ENABLED \
   (is_enabled(__FILE__, ::torch::jit::JitLoggingLevels::GRAPH_DUMP))
 #define GRAPH_UPDATE_ENABLED \
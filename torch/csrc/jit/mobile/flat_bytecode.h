@@ -0,0 +1,136 @@
+#pragma once
+
+#include <c10/util/Exception.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+// bytecode.flat holds the same methods as bytecode.pkl, laid out so that the
+// lite interpreter loads them with plain reads at known offsets instead of
+// running the Unpickler and the type parser. It is written next to
+// bytecode.pkl, and the loader uses it when present and falls back to
+// bytecode.pkl for older files or a mismatching magic or format version
+// (e.g. a file produced on a machine of the other endianness).
+//
+// All integers are in the byte order of the producer.
+//
+// file:      u32 kFlatBytecodeMagic, u32 kFlatBytecodeVersion,
+//            i64 bytecode version (caffe2::serialize::kProducedBytecodeVersion)
+//            u32 number of opcode names, opcode names
+//            u32 number of functions, u64 offset of each function in the file
+// function:  name
+//            u32 n, n x instruction {u8 opcode name index, u8 unused,
+//                                    u16 N, i32 X}
+//            u32 n, n x operator {name, overload name}
+//            u32 n, n x constant
+//            u32 n, n x type
+//            u32 register size
+//            u32 n, n x argument {name, type, default value as a constant}
+//            u32 n, n x return {name, type, default value as a constant}
+//            u32 n, n x module debug info of the operators (n is 0 when the
+//                       debug info was not saved)
+// string:    u32 size, bytes
+// constant:  u8 FlatConstantTag, then i64, double, u8, string or the u32
+//            index into the tuple of bytecode_constants.pkl, which holds the
+//            constants that are not scalars, e.g. tensors and lists
+// type:      u8 FlatTypeTag, then the contained types, or the annotation
+//            string for the types without a tag (e.g. classes)
+
+namespace torch {
+namespace jit {
+namespace mobile {
+
+constexpr uint32_t kFlatBytecodeMagic = 0x42465450; // "PTFB"
+constexpr uint32_t kFlatBytecodeVersion = 1;
+
+enum class FlatConstantTag : uint8_t {
+  None = 0,
+  Int = 1,
+  Double = 2,
+  Bool = 3,
+  String = 4,
+  Pickled = 5,
+};
+
+enum class FlatTypeTag : uint8_t {
+  Annotation = 0,
+  Tensor = 1,
+  Int = 2,
+  Float = 3,
+  Bool = 4,
+  String = 5,
+  None = 6,
+  Device = 7,
+  Number = 8,
+  Any = 9,
+  Optional = 10,
+  List = 11,
+  Tuple = 12,
+  Dict = 13,
+};
+
+class FlatBytecodeBuffer {
+ public:
+  template <typename T>
+  void write(T value) {
+    data_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  void writeString(const std::string& str) {
+    write<uint32_t>(str.size());
+    data_.append(str);
+  }
+
+  size_t size() const {
+    return data_.size();
+  }
+
+  const std::string& data() const {
+    return data_;
+  }
+
+ private:
+  std::string data_;
+};
+
+class FlatBytecodeCursor {
+ public:
+  FlatBytecodeCursor(const char* data, size_t size)
+      : data_(data), size_(size) {}
+
+  template <typename T>
+  T read() {
+    check(sizeof(T));
+    T value;
+    std::memcpy(&value, data_ + pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return value;
+  }
+
+  std::string readString() {
+    auto size = read<uint32_t>();
+    check(size);
+    std::string str(data_ + pos_, size);
+    pos_ += size;
+    return str;
+  }
+
+  void seek(uint64_t pos) {
+    TORCH_CHECK(pos <= size_, "bytecode.flat: offset ", pos, " is out of range");
+    pos_ = pos;
+  }
+
+ private:
+  void check(size_t n) const {
+    TORCH_CHECK(n <= size_ - pos_, "bytecode.flat is truncated");
+  }
+
+  const char* data_;
+  size_t size_;
+  size_t pos_ = 0;
+};
+
+} // namespace mobile
+} // namespace jit
+} // namespace torch
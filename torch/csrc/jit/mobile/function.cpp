@@ -1,19 +1,133 @@
 #include <torch/csrc/jit/mobile/function.h>
 
+#include <ATen/Functions.h>
+#include <c10/mobile/CPUProfilingAllocator.h>
 #include <caffe2/serialize/inline_container.h>
 #include <torch/csrc/jit/mobile/interpreter.h>
 #include <torch/csrc/jit/runtime/instruction.h>
 #include <torch/csrc/jit/runtime/operator.h>
 #include <torch/custom_class_detail.h>
 
+#include <mutex>
+#include <unordered_map>
+
 namespace torch {
 namespace jit {
 
 char const* toString(OpCode op);
 namespace mobile {
+namespace {
+
+using OperatorFunction = std::function<void(Stack&)>;
+
+// Call stubs for operators that dominate typical mobile models. They unbox
+// their arguments and call the typed at:: function, rather than going
+// through the boxed kernel wrapper.
+const std::unordered_map<c10::OperatorName, OperatorFunction>&
+unboxedOperators() {
+  static const std::unordered_map<c10::OperatorName, OperatorFunction> ops = {
+      {c10::OperatorName("aten::add", "Tensor"),
+       [](Stack& stack) {
+         at::Tensor self, other;
+         at::Scalar alpha;
+         pop(stack, self, other, alpha);
+         push(stack, at::add(self, other, alpha));
+       }},
+      {c10::OperatorName("aten::mul", "Tensor"),
+       [](Stack& stack) {
+         at::Tensor self, other;
+         pop(stack, self, other);
+         push(stack, at::mul(self, other));
+       }},
+      {c10::OperatorName("aten::matmul", ""),
+       [](Stack& stack) {
+         at::Tensor self, other;
+         pop(stack, self, other);
+         push(stack, at::matmul(self, other));
+       }},
+      {c10::OperatorName("aten::relu", ""),
+       [](Stack& stack) {
+         at::Tensor self;
+         pop(stack, self);
+         push(stack, at::relu(self));
+       }},
+      {c10::OperatorName("aten::sigmoid", ""),
+       [](Stack& stack) {
+         at::Tensor self;
+         pop(stack, self);
+         push(stack, at::sigmoid(self));
+       }},
+      {c10::OperatorName("aten::tanh", ""),
+       [](Stack& stack) {
+         at::Tensor self;
+         pop(stack, self);
+         push(stack, at::tanh(self));
+       }},
+  };
+  return ops;
+}
+
+OperatorFunction findOperator(const c10::OperatorName& opname) {
+  auto jit_op = findOperatorFor(opname);
+  if (jit_op) {
+    auto unboxed = unboxedOperators().find(opname);
+    if (unboxed != unboxedOperators().end()) {
+      return unboxed->second;
+    }
+    // resolve the Operation once rather than on every call
+    return [operation = jit_op->getOperation()](Stack& stack) {
+      operation(&stack);
+    };
+  }
+  auto op = c10::Dispatcher::singleton().findSchema(opname);
+  if (op.has_value()) {
+    return [op](Stack& stack) { op->callBoxed(&stack); };
+  }
+  return nullptr;
+}
+
+// Operators are looked up once per process rather than once per use. Models
+// share most of their operators, so after the first model is loaded the
+// registry lookups above are mostly skipped. Only operators that were found
+// are cached, since a library loaded later may register the others.
+OperatorFunction resolveOperator(const c10::OperatorName& opname) {
+  static std::mutex mutex;
+  static std::unordered_map<c10::OperatorName, OperatorFunction> resolved;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = resolved.find(opname);
+  if (it != resolved.end()) {
+    return it->second;
+  }
+  auto fn = findOperator(opname);
+  if (fn) {
+    resolved.emplace(opname, fn);
+  }
+  return fn;
+}
+
+} // namespace
+
+struct Function::MemoryPlan {
+  enum class State { Profile, Validate, Planned, Disabled };
+
+  // Runs of the function that find the mutex taken run without the plan.
+  std::mutex mutex;
+  State state{State::Profile};
+  // whether the plan being validated was loaded rather than profiled
+  bool loaded{false};
+  c10::AllocationPlan plan;
+  c10::CPUProfilingAllocator allocator;
+
+  MemoryPlan() {
+    allocator.set_fallback_on_mismatch(true);
+  }
+};
+
 Function::Function(c10::QualifiedName name)
     : name_(std::move(name)), code_(std::make_shared<Code>()) {}
 
+Function::~Function() = default;
+
 const c10::QualifiedName& Function::qualname() const {
   return name_;
 }
@@ -38,19 +152,9 @@ bool Function::append_operator(
   code_->op_names_.emplace_back(name, overload_name);
   auto opname = code_->op_names_.back();
 
-  const auto& opname_c10 = opname;
-  std::function<void(Stack&)> fn;
-
-  auto jit_op = findOperatorFor(opname);
-  if (jit_op) {
-    fn = [jit_op](Stack& stack) { jit_op->getOperation()(&stack); };
-  } else {
-    auto op = c10::Dispatcher::singleton().findSchema(opname_c10);
-    if (op.has_value()) {
-      fn = [op](Stack& stack) { op->callBoxed(&stack); };
-    } else {
-      return false;
-    }
+  auto fn = resolveOperator(opname);
+  if (!fn) {
+    return false;
   }
 
   if (model_version == 0x3LL &&
@@ -66,7 +170,7 @@ bool Function::append_operator(
     };
   }
 
-  code_->operators_.emplace_back(fn);
+  code_->operators_.emplace_back(std::move(fn));
   return true;
 }
 
@@ -117,10 +221,97 @@ bool Function::run(Stack& stack) const {
     schema->checkAndNormalizeInputs(
         stack, std::unordered_map<std::string, IValue>{} /*kwargs*/);
   }
+  if (memory_plan_) {
+    return run_with_memory_plan(stack);
+  }
   InterpreterState interp_state(code_);
   return interp_state.run(stack);
 }
 
+bool Function::run_with_memory_plan(Stack& stack) const {
+  InterpreterState interp_state(code_);
+  // allocations are already being profiled or planned by the caller
+  if (c10::GetThreadLocalAllocationPlanner() ||
+      c10::GetThreadLocalProfilingAllocator()) {
+    return interp_state.run(stack);
+  }
+  std::unique_lock<std::mutex> lock(memory_plan_->mutex, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    return interp_state.run(stack);
+  }
+
+  auto& memory_plan = *memory_plan_;
+  using State = MemoryPlan::State;
+  bool result = false;
+  switch (memory_plan.state) {
+    case State::Profile: {
+      {
+        c10::WithProfileAllocationsGuard guard(&memory_plan.plan);
+        result = interp_state.run(stack);
+      }
+      memory_plan.state = State::Validate;
+    } break;
+    case State::Validate: {
+      bool success = false;
+      {
+        c10::WithValidateAllocationPlanGuard guard(&memory_plan.plan, &success);
+        result = interp_state.run(stack);
+      }
+      if (success) {
+        memory_plan.state = State::Planned;
+      } else if (memory_plan.loaded) {
+        // the plan was made by another build or device, make a new one
+        memory_plan.state = State::Profile;
+      } else {
+        memory_plan.state = State::Disabled;
+      }
+      memory_plan.loaded = false;
+    } break;
+    case State::Planned: {
+      {
+        c10::WithProfilingAllocatorGuard guard(
+            &memory_plan.allocator, &memory_plan.plan);
+        result = interp_state.run(stack);
+      }
+      if (memory_plan.allocator.mismatched()) {
+        memory_plan.state = State::Disabled;
+      }
+    } break;
+    case State::Disabled:
+      lock.unlock();
+      result = interp_state.run(stack);
+      break;
+  }
+  return result;
+}
+
+void Function::enable_memory_planning() {
+  if (!memory_plan_) {
+    memory_plan_ = std::make_unique<MemoryPlan>();
+  }
+}
+
+bool Function::set_allocation_plan(const std::vector<uint64_t>& plan) {
+  enable_memory_planning();
+  if (!memory_plan_->plan.deserialize(plan)) {
+    return false;
+  }
+  memory_plan_->state = MemoryPlan::State::Validate;
+  memory_plan_->loaded = true;
+  return true;
+}
+
+c10::optional<std::vector<uint64_t>> Function::get_allocation_plan() const {
+  if (!memory_plan_) {
+    return c10::nullopt;
+  }
+  std::lock_guard<std::mutex> lock(memory_plan_->mutex);
+  if (memory_plan_->state != MemoryPlan::State::Planned) {
+    return c10::nullopt;
+  }
+  return memory_plan_->plan.serialize();
+}
+
 c10::IValue Function::operator()(Stack& stack) const {
   run(stack);
   return stack.front();
@@ -2,6 +2,7 @@
 
 #include <ATen/core/function_schema.h>
 #include <ATen/core/ivalue.h>
+#include <memory>
 #include <vector>
 
 namespace torch {
@@ -15,6 +16,7 @@ struct Code;
 class Function {
  public:
   Function(c10::QualifiedName name);
+  ~Function();
   bool run(Stack& stack) const;
   c10::IValue operator()(Stack& stack) const;
   const std::string& name() const;
@@ -37,11 +39,29 @@ class Function {
   void setSchema(c10::FunctionSchema schema);
   const at::optional<c10::FunctionSchema>& getSchema() const;
 
+  // Plans the CPU allocations of the runs of this function, see
+  // c10/mobile/CPUProfilingAllocator.h. The first run records its
+  // allocations, the second one checks that it allocates the same way, and
+  // later runs allocate their intermediates out of a single block laid out
+  // by the plan. Planning stops as soon as a run allocates differently, e.g.
+  // for inputs of another shape.
+  void enable_memory_planning();
+  // Starts from a plan returned by get_allocation_plan() in an earlier
+  // process, which only has to be validated. Returns false if the plan is
+  // malformed.
+  bool set_allocation_plan(const std::vector<uint64_t>& plan);
+  // The plan this function's runs use, once it has been validated.
+  c10::optional<std::vector<uint64_t>> get_allocation_plan() const;
+
  private:
+  struct MemoryPlan;
+  bool run_with_memory_plan(Stack& stack) const;
+
   c10::QualifiedName name_;
   std::shared_ptr<Code> code_;
   at::optional<c10::FunctionSchema> schema_; // (byte-code version 4+)
   std::vector<std::string> pc_to_module_debug_info_;
+  std::unique_ptr<MemoryPlan> memory_plan_;
 };
 
 } // namespace mobile
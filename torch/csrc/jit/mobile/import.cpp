@@ -3,6 +3,7 @@
 #include <ATen/core/ivalue.h>
 #include <caffe2/serialize/inline_container.h>
 #include <torch/csrc/jit/api/compilation_unit.h>
+#include <torch/csrc/jit/mobile/flat_bytecode.h>
 #include <torch/csrc/jit/mobile/observer.h>
 #include <torch/csrc/jit/runtime/instruction.h>
 #include <torch/csrc/jit/serialization/import_export_constants.h>
@@ -11,6 +12,8 @@
 
 #include <exception>
 #include <fstream>
+#include <functional>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -49,6 +52,9 @@
 //  ('__torch__.m.forward',
 //   (('module_debug_info', (top(A).foo(B).forward)))))
 
+// The same methods are also saved in bytecode.flat, which is loaded instead
+// of bytecode.pkl when present, see torch/csrc/jit/mobile/flat_bytecode.h.
+
 // Note that currently the backward compatibility is not supported by bytecode.
 // This format and process need to be revisited and redesigned if we want to
 // support backward compatibility in future.
@@ -127,6 +133,10 @@ class BytecodeDeserializer final {
 
  private:
   TypePtr resolveTypeName(const c10::QualifiedName& qn);
+  TypePtr resolveCodeType(const std::string& type_str);
+  void checkModelVersion(int64_t model_version);
+  // Returns false if the file has no bytecode.flat that can be read
+  bool parseFlatMethods(std::shared_ptr<mobile::CompilationUnit> mcu);
   void parseMethods(
       const std::vector<IValue>& vals,
       const c10::optional<std::vector<IValue>>& debug_info_vals,
@@ -136,6 +146,7 @@ class BytecodeDeserializer final {
       std::shared_ptr<mobile::CompilationUnit> mcu);
   std::unordered_map<std::string, std::string> readMobileMetadata(
       std::shared_ptr<mobile::CompilationUnit> mcu);
+  void readAllocationPlans(mobile::CompilationUnit& mcu);
   /**
    * Loads operators by looking them up in the Dispatcher and returns
    * the set of operator names (with overload) that are not supported
@@ -204,6 +215,36 @@ TypePtr BytecodeDeserializer::resolveTypeName(const c10::QualifiedName& qn) {
   }
 }
 
+// Resolves the types used by the code of a method, which are either torchbind
+// classes or built-in types
+TypePtr BytecodeDeserializer::resolveCodeType(const std::string& type_str) {
+  static const c10::QualifiedName classPrefix = "__torch__.torch.classes";
+  c10::QualifiedName qn(type_str);
+  if (classPrefix.isPrefixOf(qn)) {
+    auto classType = getCustomClass(qn.qualifiedName());
+    TORCH_CHECK(
+        classType,
+        "The implementation of class ",
+        qn.qualifiedName(),
+        " cannot be found.");
+    return classType;
+  }
+  return c10::parseType(type_str);
+}
+
+void BytecodeDeserializer::checkModelVersion(int64_t model_version) {
+  TORCH_CHECK(
+      caffe2::serialize::kMinSupportedBytecodeVersion <= model_version &&
+          model_version <= caffe2::serialize::kProducedBytecodeVersion,
+      "Lite Interpreter verson number does not match. ",
+      "The model version must be between ",
+      caffe2::serialize::kMinSupportedBytecodeVersion,
+      " and ",
+      caffe2::serialize::kProducedBytecodeVersion,
+      "But the model version is ",
+      model_version);
+}
+
 void BytecodeDeserializer::parseMethods(
     const std::vector<IValue>& vals,
     const c10::optional<std::vector<IValue>>& debug_info_vals,
@@ -218,16 +259,7 @@ void BytecodeDeserializer::parseMethods(
     model_version = vals[0].toInt();
     method_i_start = 1;
   }
-  TORCH_CHECK(
-      caffe2::serialize::kMinSupportedBytecodeVersion <= model_version &&
-          model_version <= caffe2::serialize::kProducedBytecodeVersion,
-      "Lite Interpreter verson number does not match. ",
-      "The model version must be between ",
-      caffe2::serialize::kMinSupportedBytecodeVersion,
-      " and ",
-      caffe2::serialize::kProducedBytecodeVersion,
-      "But the model version is ",
-      model_version);
+  checkModelVersion(model_version);
 
   bool has_debug_info = debug_info_vals.has_value();
   if (has_debug_info) {
@@ -322,20 +354,8 @@ void BytecodeDeserializer::parseMethods(
       function->append_constant(constant);
     }
 
-    static const c10::QualifiedName classPrefix = "__torch__.torch.classes";
     for (const auto& t : types_list) {
-      c10::QualifiedName qn(t.toStringRef());
-      if (classPrefix.isPrefixOf(qn)) {
-        auto classType = getCustomClass(qn.qualifiedName());
-        TORCH_CHECK(
-            classType,
-            "The implementation of class ",
-            qn.qualifiedName(),
-            " cannot be found.");
-        function->append_type(classType);
-      } else {
-        function->append_type(c10::parseType(t.toStringRef()));
-      }
+      function->append_type(resolveCodeType(t.toStringRef()));
     }
 
     function->set_register_size(register_size);
@@ -385,6 +405,200 @@ void BytecodeDeserializer::parseMethods(
   }
 }
 
+bool BytecodeDeserializer::parseFlatMethods(
+    std::shared_ptr<mobile::CompilationUnit> mcu) {
+  if (!reader_->hasRecord("bytecode.flat")) {
+    return false;
+  }
+  at::DataPtr flat_ptr;
+  size_t flat_size = 0;
+  std::tie(flat_ptr, flat_size) = reader_->getRecord("bytecode.flat");
+  mobile::FlatBytecodeCursor cursor(
+      static_cast<const char*>(flat_ptr.get()), flat_size);
+  if (flat_size < 2 * sizeof(uint32_t) ||
+      cursor.read<uint32_t>() != mobile::kFlatBytecodeMagic ||
+      cursor.read<uint32_t>() != mobile::kFlatBytecodeVersion) {
+    return false;
+  }
+  auto model_version = cursor.read<int64_t>();
+  checkModelVersion(model_version);
+
+  std::vector<OpCode> opcodes(cursor.read<uint32_t>());
+  for (auto& opcode : opcodes) {
+    opcode = parseOpCode(cursor.readString().c_str());
+  }
+
+  // only read when a method has constants that are not scalars
+  c10::optional<std::vector<IValue>> pickled_constants;
+  auto readConstant = [&]() -> IValue {
+    using Tag = mobile::FlatConstantTag;
+    switch (cursor.read<Tag>()) {
+      case Tag::None:
+        return IValue();
+      case Tag::Int:
+        return cursor.read<int64_t>();
+      case Tag::Double:
+        return cursor.read<double>();
+      case Tag::Bool:
+        return static_cast<bool>(cursor.read<uint8_t>());
+      case Tag::String:
+        return cursor.readString();
+      case Tag::Pickled: {
+        if (!pickled_constants) {
+          pickled_constants = readArchive("bytecode_constants", mcu)
+                                  .toTuple()
+                                  ->elements();
+        }
+        return pickled_constants->at(cursor.read<uint32_t>());
+      }
+    }
+    TORCH_CHECK(false, "bytecode.flat: unknown constant tag");
+  };
+
+  std::function<TypePtr(const std::function<TypePtr(const std::string&)>&)>
+      readType = [&](const std::function<TypePtr(const std::string&)>&
+                         resolve) -> TypePtr {
+    using Tag = mobile::FlatTypeTag;
+    switch (cursor.read<Tag>()) {
+      case Tag::Annotation:
+        return resolve(cursor.readString());
+      case Tag::Tensor:
+        return c10::TensorType::get();
+      case Tag::Int:
+        return c10::IntType::get();
+      case Tag::Float:
+        return c10::FloatType::get();
+      case Tag::Bool:
+        return c10::BoolType::get();
+      case Tag::String:
+        return c10::StringType::get();
+      case Tag::None:
+        return c10::NoneType::get();
+      case Tag::Device:
+        return c10::DeviceObjType::get();
+      case Tag::Number:
+        return c10::NumberType::get();
+      case Tag::Any:
+        return c10::AnyType::get();
+      case Tag::Optional:
+        return c10::OptionalType::create(readType(resolve));
+      case Tag::List:
+        return c10::ListType::create(readType(resolve));
+      case Tag::Tuple: {
+        std::vector<TypePtr> elements(cursor.read<uint32_t>());
+        for (auto& element : elements) {
+          element = readType(resolve);
+        }
+        return c10::TupleType::create(std::move(elements));
+      }
+      case Tag::Dict: {
+        auto key = readType(resolve);
+        return c10::DictType::create(key, readType(resolve));
+      }
+    }
+    TORCH_CHECK(false, "bytecode.flat: unknown type tag");
+  };
+  auto resolveCode = [this](const std::string& type_str) {
+    return resolveCodeType(type_str);
+  };
+  auto resolveSchema = [this](const std::string& type_str) {
+    return resolveTypeName(type_str);
+  };
+
+  std::vector<uint64_t> offsets(cursor.read<uint32_t>());
+  for (auto& offset : offsets) {
+    offset = cursor.read<uint64_t>();
+  }
+  for (uint64_t offset : offsets) {
+    cursor.seek(offset);
+    const std::string function_name = cursor.readString();
+    auto function = std::unique_ptr<mobile::Function>(
+        new mobile::Function(c10::QualifiedName(function_name)));
+
+    struct FlatInstruction {
+      uint8_t opcode;
+      uint8_t unused;
+      uint16_t N;
+      int32_t X;
+    };
+    static_assert(sizeof(FlatInstruction) == 8, "");
+    std::vector<FlatInstruction> instructions(cursor.read<uint32_t>());
+    for (auto& ins : instructions) {
+      ins = cursor.read<FlatInstruction>();
+      TORCH_CHECK(
+          ins.opcode < opcodes.size(),
+          "bytecode.flat: unknown opcode in ",
+          function_name);
+      function->append_instruction(opcodes[ins.opcode], ins.X, ins.N);
+    }
+
+    std::unordered_set<std::string> unsupported_op_names;
+    const auto num_operators = cursor.read<uint32_t>();
+    for (uint32_t i = 0; i < num_operators; ++i) {
+      auto name = cursor.readString();
+      auto overload_name = cursor.readString();
+      if (!function->append_operator(name, overload_name, model_version)) {
+        unsupported_op_names.emplace(operator_str(name, overload_name));
+      }
+    }
+    if ((module_load_options_ & MobileModuleLoadOptions::OPERATOR_CHECK) &&
+        !unsupported_op_names.empty()) {
+      print_unsupported_ops_and_throw(unsupported_op_names);
+    }
+
+    const auto num_constants = cursor.read<uint32_t>();
+    for (uint32_t i = 0; i < num_constants; ++i) {
+      function->append_constant(readConstant());
+    }
+
+    const auto num_types = cursor.read<uint32_t>();
+    for (uint32_t i = 0; i < num_types; ++i) {
+      function->append_type(readType(resolveCode));
+    }
+
+    function->set_register_size(cursor.read<uint32_t>());
+
+    std::vector<c10::Argument> args[2];
+    for (auto& arg_list : args) {
+      arg_list.resize(cursor.read<uint32_t>());
+      for (auto& arg : arg_list) {
+        auto name = cursor.readString();
+        auto type = readType(resolveSchema);
+        IValue default_value = readConstant();
+        arg = c10::Argument(name, type, c10::nullopt /*N*/, default_value);
+      }
+    }
+    function->setSchema(c10::FunctionSchema(
+        function_name,
+        "" /*overload_name*/,
+        std::move(args[0]),
+        std::move(args[1]),
+        false /*is_varargs*/,
+        false /*is_varret*/));
+
+    std::vector<std::string> module_debug_info(cursor.read<uint32_t>());
+    for (auto& info : module_debug_info) {
+      info = cursor.readString();
+    }
+    TORCH_CHECK(
+        module_debug_info.empty() ||
+            module_debug_info.size() == num_operators,
+        "The numbers of operators and module info strings do not match.");
+    function->set_module_debug_info_list_size(instructions.size());
+    for (size_t i = 0; i < instructions.size(); ++i) {
+      if (opcodes[instructions[i].opcode] == OP) {
+        function->set_module_info(
+            module_debug_info.empty() ? ""
+                                      : module_debug_info.at(instructions[i].X),
+            i);
+      }
+    }
+
+    mcu->register_function(std::move(function));
+  }
+  return true;
+}
+
 std::unordered_map<std::string, std::string> BytecodeDeserializer::
     deserializeMetadata(c10::optional<at::Device> device) {
   device_ = device;
@@ -429,17 +643,57 @@ mobile::Module BytecodeDeserializer::deserialize(
   // being a Tuple (int, table), and the integer stands for the bytecode version
   // number. The rest of the elements are the same as before.
   //
-  auto bvals = readArchive("bytecode", mcu).toTuple()->elements();
+  if (!parseFlatMethods(mcu)) {
+    auto bvals = readArchive("bytecode", mcu).toTuple()->elements();
 
-  c10::optional<std::vector<IValue>> debug_info_bvals;
-  if (reader_->hasRecord("mobile_debug.pkl")) {
-    debug_info_bvals = readArchive("mobile_debug", mcu).toTuple()->elements();
+    c10::optional<std::vector<IValue>> debug_info_bvals;
+    if (reader_->hasRecord("mobile_debug.pkl")) {
+      debug_info_bvals =
+          readArchive("mobile_debug", mcu).toTuple()->elements();
+    }
+    parseMethods(bvals, debug_info_bvals, *mcu);
+  }
+  if (module_load_options_ & MobileModuleLoadOptions::PLAN_ALLOCATIONS) {
+    for (auto& function : mcu->methods()) {
+      function->enable_memory_planning();
+    }
   }
-  parseMethods(bvals, debug_info_bvals, *mcu);
+  readAllocationPlans(*mcu);
   auto meta_dict = readMobileMetadata(mcu);
   return mobile::Module(readArchive("data", mcu).toObject(), meta_dict, mcu);
 }
 
+// Reads the plans written by mobile::Module::_allocation_plans(), one line
+// per method: its qualified name followed by the flattened plan.
+void BytecodeDeserializer::readAllocationPlans(mobile::CompilationUnit& mcu) {
+  const std::string key = "extra/mobile_allocation_plans";
+  if (!reader_->hasRecord(key)) {
+    return;
+  }
+  at::DataPtr plans_ptr;
+  size_t plans_size = 0;
+  std::tie(plans_ptr, plans_size) = reader_->getRecord(key);
+  std::istringstream plans(
+      std::string(static_cast<char*>(plans_ptr.get()), plans_size));
+  std::string line;
+  while (std::getline(plans, line)) {
+    std::istringstream fields(line);
+    std::string function_name;
+    if (!(fields >> function_name)) {
+      continue;
+    }
+    std::vector<uint64_t> plan;
+    uint64_t value = 0;
+    while (fields >> value) {
+      plan.push_back(value);
+    }
+    auto function = mcu.find_function(c10::QualifiedName(function_name));
+    if (function && !function->set_allocation_plan(plan)) {
+      TORCH_WARN("Ignoring the malformed allocation plan of ", function_name);
+    }
+  }
+}
+
 std::unordered_map<std::string, std::string> BytecodeDeserializer::
     readMobileMetadata(std::shared_ptr<mobile::CompilationUnit> mcu) {
   std::unordered_map<std::string, std::string> res;
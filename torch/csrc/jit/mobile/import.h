@@ -15,6 +15,10 @@ using ExtraFilesMap = std::unordered_map<std::string, std::string>;
 
 enum MobileModuleLoadOptions {
   OPERATOR_CHECK = 1,
+  // Plan the CPU allocations of method runs, see
+  // mobile::Function::enable_memory_planning(). Models saved with the
+  // "mobile_allocation_plans" extra file use their stored plans regardless.
+  PLAN_ALLOCATIONS = 2,
 };
 
 const uint64_t _default_mobile_module_load_options =
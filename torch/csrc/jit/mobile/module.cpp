@@ -4,6 +4,7 @@
 #include <torch/csrc/jit/mobile/observer.h>
 #include <torch/csrc/jit/runtime/jit_exception.h>
 #include <exception>
+#include <sstream>
 
 #include <ATen/record_function.h>
 
@@ -125,6 +126,20 @@ const std::vector<Method> Module::get_methods() const {
   return methods;
 }
 
+std::string Module::_allocation_plans() const {
+  std::ostringstream plans;
+  for (const auto& fn : cu_->methods()) {
+    if (auto plan = fn->get_allocation_plan()) {
+      plans << fn->qualname().qualifiedName();
+      for (auto value : *plan) {
+        plans << " " << value;
+      }
+      plans << "\n";
+    }
+  }
+  return plans.str();
+}
+
 Method::Method(const Module* owner, Function* function)
     : owner_(owner), function_(function) {}
 
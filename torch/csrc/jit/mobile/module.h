@@ -96,6 +96,11 @@ class TORCH_API Module {
     return metadata_;
   }
   const std::vector<Method> get_methods() const;
+  // Returns the allocation plans that the methods of this module settled on
+  // (see Function::enable_memory_planning()). Saving them as the
+  // "mobile_allocation_plans" extra file of the model makes later loads
+  // start from them rather than profile a run.
+  std::string _allocation_plans() const;
 
   c10::IValue attr(const std::string& name, c10::IValue or_else) const {
     if (auto r = object_->type()->findAttributeSlot(name)) {
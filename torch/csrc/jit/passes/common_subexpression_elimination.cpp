@@ -88,6 +88,7 @@ void EliminateCommonSubexpression(
 } // namespace
 
 void EliminateCommonSubexpression(const std::shared_ptr<Graph>& graph) {
+  JIT_PASS_TIMER;
   AliasDb aliasDb(graph);
   GRAPH_DUMP("Before CSE", graph);
   EliminateCommonSubexpression(
@@ -383,6 +383,7 @@ struct ConstantPropagator {
 void ConstantPropagation(
     std::shared_ptr<Graph>& graph,
     bool ignore_custom_classes) {
+  JIT_PASS_TIMER;
   ConstantPropagator cp =
       ConstantPropagator::WithAliasDb(graph, ignore_custom_classes);
   cp.run();
@@ -0,0 +1,89 @@
+#include <ATen/Utils.h>
+#include <c10/util/Exception.h>
+#include <torch/csrc/jit/ir/constants.h>
+#include <torch/csrc/jit/ir/ir.h>
+#include <torch/csrc/jit/jit_log.h>
+#include <torch/csrc/jit/passes/frozen_batch_norm_relu.h>
+
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+using Tensor = at::Tensor;
+
+bool isConstant(Value* v) {
+  return v->node()->kind() == prim::Constant;
+}
+
+// The fused op only has a CPU kernel for float and double, and the frozen
+// statistics tell the device and dtype the batch norm runs with.
+bool fusableBatchNorm(Node* bn) {
+  if (bn->kind() != aten::batch_norm || bn->output()->uses().size() != 1) {
+    return false;
+  }
+  for (const char* name :
+       {"weight", "bias", "running_mean", "running_var", "training", "eps"}) {
+    if (!isConstant(bn->namedInput(name))) {
+      return false;
+    }
+  }
+  if (constant_as<bool>(bn->namedInput("training")).value_or(true)) {
+    return false;
+  }
+  auto running_mean = constant_as<Tensor>(bn->namedInput("running_mean"));
+  auto running_var = constant_as<Tensor>(bn->namedInput("running_var"));
+  if (!running_mean || !running_var) {
+    return false;
+  }
+  return running_mean->device().is_cpu() &&
+      (running_mean->scalar_type() == at::kFloat ||
+       running_mean->scalar_type() == at::kDouble);
+}
+
+void collectBatchNormRelu(Block* b, std::vector<Node*>& relus) {
+  for (Node* n : b->nodes()) {
+    for (Block* block : n->blocks()) {
+      collectBatchNormRelu(block, relus);
+    }
+    if ((n->kind() == aten::relu || n->kind() == aten::relu_) &&
+        fusableBatchNorm(n->input(0)->node())) {
+      relus.push_back(n);
+    }
+  }
+}
+
+} // namespace
+
+bool FuseFrozenBatchNormRelu(std::shared_ptr<Graph>& graph) {
+  GRAPH_DUMP("Before FuseFrozenBatchNormRelu", graph);
+  std::vector<Node*> relus;
+  collectBatchNormRelu(graph->block(), relus);
+  for (Node* relu : relus) {
+    Node* bn = relu->input(0)->node();
+    WithInsertPoint guard(relu);
+    Value* fused = graph->insert(
+        aten::_batch_norm_relu_inference,
+        {bn->namedInput("input"),
+         bn->namedInput("weight"),
+         bn->namedInput("bias"),
+         bn->namedInput("running_mean"),
+         bn->namedInput("running_var"),
+         bn->namedInput("eps")});
+    fused->setType(relu->output()->type());
+    GRAPH_UPDATE(
+        "Fusing ", bn->output()->debugName(), " and ", relu->output()->debugName());
+    relu->output()->replaceAllUsesWith(fused);
+    relu->destroy();
+    bn->destroy();
+  }
+  if (!relus.empty()) {
+    GRAPH_DUMP("After FuseFrozenBatchNormRelu", graph);
+  }
+  return !relus.empty();
+}
+
+} // namespace jit
+} // namespace torch
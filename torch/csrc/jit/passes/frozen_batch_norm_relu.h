@@ -0,0 +1,16 @@
+#pragma once
+
+#include <torch/csrc/jit/ir/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Fuses aten::batch_norm in inference mode -> aten::relu into a single
+// aten::_batch_norm_relu_inference, which writes the output in one pass.
+// This is for the batch norms that could not be folded into a convolution.
+// Returns true if the graph was modified.
+// This pass only works on Frozen Graphs; otherwise it is a No-Op.
+TORCH_API bool FuseFrozenBatchNormRelu(std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
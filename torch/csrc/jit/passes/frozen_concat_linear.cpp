@@ -0,0 +1,215 @@
+#include <ATen/Utils.h>
+#include <c10/util/Exception.h>
+#include <torch/csrc/jit/ir/alias_analysis.h>
+#include <torch/csrc/jit/ir/constants.h>
+#include <torch/csrc/jit/ir/ir.h>
+#include <torch/csrc/jit/jit_log.h>
+#include <torch/csrc/jit/passes/frozen_concat_linear.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+using Tensor = at::Tensor;
+
+// Returns the constant weight of a node we can concatenate, or nullopt.
+c10::optional<Tensor> concatenableWeight(Node* n) {
+  if (n->kind() == aten::linear) {
+    if (n->namedInput("weight")->node()->kind() != prim::Constant ||
+        n->namedInput("bias")->node()->kind() != prim::Constant) {
+      return c10::nullopt;
+    }
+    auto weight = constant_as<Tensor>(n->namedInput("weight"));
+    if (!weight || weight->dim() != 2) {
+      return c10::nullopt;
+    }
+    return weight;
+  }
+  if (n->kind() == aten::matmul) {
+    if (n->inputs().at(1)->node()->kind() != prim::Constant) {
+      return c10::nullopt;
+    }
+    auto weight = constant_as<Tensor>(n->inputs().at(1));
+    if (!weight || weight->dim() != 2) {
+      return c10::nullopt;
+    }
+    return weight;
+  }
+  return c10::nullopt;
+}
+
+bool hasBias(Node* n) {
+  return n->kind() == aten::linear &&
+      n->namedInput("bias")->type() != NoneType::get();
+}
+
+// Number of output features, i.e. the size of the last output dimension.
+int64_t outputFeatures(Node* n, const Tensor& weight) {
+  return n->kind() == aten::linear ? weight.size(0) : weight.size(1);
+}
+
+bool compatible(
+    Node* a,
+    const Tensor& a_weight,
+    Node* b,
+    const Tensor& b_weight) {
+  if (a->kind() != b->kind() || hasBias(a) != hasBias(b)) {
+    return false;
+  }
+  if (a_weight.scalar_type() != b_weight.scalar_type() ||
+      a_weight.device() != b_weight.device()) {
+    return false;
+  }
+  // the reduced dimension must match for the weights to be concatenated
+  return a->kind() == aten::linear ? a_weight.size(1) == b_weight.size(1)
+                                   : a_weight.size(0) == b_weight.size(0);
+}
+
+class ConcatLinearLayers {
+ public:
+  explicit ConcatLinearLayers(std::shared_ptr<Graph> graph)
+      : graph_(std::move(graph)) {}
+
+  bool run() {
+    AliasDb aliasDb(graph_);
+    collectGroups(graph_->block(), aliasDb);
+    // Groups are only rewritten once all of them were validated, as the
+    // rewrite adds nodes the alias db does not know about.
+    for (auto& group : groups_) {
+      concat(group);
+    }
+    return !groups_.empty();
+  }
+
+ private:
+  struct Candidate {
+    Node* node;
+    Tensor weight;
+  };
+
+  void collectGroups(Block* b, AliasDb& aliasDb) {
+    // candidates in this block, by their shared input
+    std::unordered_map<Value*, std::vector<std::vector<Candidate>>> buckets;
+    std::vector<Value*> inputs;
+    for (Node* n : b->nodes()) {
+      for (Block* block : n->blocks()) {
+        collectGroups(block, aliasDb);
+      }
+      auto weight = concatenableWeight(n);
+      if (!weight) {
+        continue;
+      }
+      Value* input = n->inputs().at(0);
+      auto it = buckets.find(input);
+      if (it == buckets.end()) {
+        inputs.push_back(input);
+        it = buckets.emplace(input, std::vector<std::vector<Candidate>>())
+                 .first;
+      }
+      auto& groups = it->second;
+      auto group = std::find_if(
+          groups.begin(), groups.end(), [&](const std::vector<Candidate>& g) {
+            return compatible(g.front().node, g.front().weight, n, *weight);
+          });
+      if (group == groups.end()) {
+        groups.push_back({Candidate{n, *weight}});
+      } else {
+        group->push_back(Candidate{n, *weight});
+      }
+    }
+
+    for (Value* input : inputs) {
+      for (auto& group : buckets[input]) {
+        // Every member runs at the position of the first one, so members
+        // that cannot be hoisted there, e.g. because their input is mutated
+        // in between, are left alone.
+        Node* base = group.front().node;
+        std::vector<Candidate> movable{group.front()};
+        for (size_t i = 1; i < group.size(); ++i) {
+          if (aliasDb.couldMoveBeforeTopologically(group[i].node, base)) {
+            movable.push_back(group[i]);
+          }
+        }
+        if (movable.size() > 1) {
+          groups_.push_back(std::move(movable));
+        }
+      }
+    }
+  }
+
+  void concat(const std::vector<Candidate>& group) {
+    Node* base = group.front().node;
+    const bool is_linear = base->kind() == aten::linear;
+    std::vector<Tensor> weights;
+    std::vector<Tensor> biases;
+    for (const auto& candidate : group) {
+      weights.push_back(candidate.weight);
+      if (hasBias(candidate.node)) {
+        biases.push_back(
+            constant_as<Tensor>(candidate.node->namedInput("bias")).value());
+      }
+    }
+
+    WithInsertPoint guard(base);
+    Value* weight =
+        graph_->insertConstant(at::cat(weights, is_linear ? 0 : 1));
+    Node* concat_node = nullptr;
+    if (is_linear) {
+      Value* bias = biases.empty() ? graph_->insertConstant(IValue())
+                                   : graph_->insertConstant(at::cat(biases));
+      concat_node =
+          graph_->create(aten::linear, {base->inputs().at(0), weight, bias});
+    } else {
+      concat_node =
+          graph_->create(aten::matmul, {base->inputs().at(0), weight});
+    }
+    graph_->insertNode(concat_node);
+    Value* concat_output = concat_node->output();
+    if (auto type = base->output()->type()->cast<TensorType>()) {
+      concat_output->setType(type->dimensionedOnly());
+    }
+    GRAPH_UPDATE(
+        "Concatenating ",
+        group.size(),
+        " ",
+        base->kind().toQualString(),
+        " nodes into ",
+        concat_output->debugName());
+
+    int64_t start = 0;
+    for (const auto& candidate : group) {
+      const int64_t end =
+          start + outputFeatures(candidate.node, candidate.weight);
+      Value* slice =
+          graph_->insert(aten::slice, {concat_output, -1, start, end, 1});
+      slice->setType(candidate.node->output()->type());
+      candidate.node->output()->replaceAllUsesWith(slice);
+      start = end;
+    }
+    for (const auto& candidate : group) {
+      candidate.node->destroy();
+    }
+  }
+
+  std::shared_ptr<Graph> graph_;
+  std::vector<std::vector<Candidate>> groups_;
+};
+
+} // namespace
+
+bool FrozenConcatLinear(std::shared_ptr<Graph>& graph) {
+  GRAPH_DUMP("Before FrozenConcatLinear", graph);
+  bool changed = ConcatLinearLayers(graph).run();
+  if (changed) {
+    GRAPH_DUMP("After FrozenConcatLinear", graph);
+  }
+  return changed;
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <torch/csrc/jit/ir/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Concatenates the weights of sibling aten::linear nodes, and of aten::matmul
+// nodes with a constant 2-d right operand, that share an input, so that they
+// run as a single larger GEMM whose output is sliced back into the original
+// outputs. Returns true if the graph was modified.
+// This pass only works on Frozen Graphs; otherwise it is a No-Op.
+TORCH_API bool FrozenConcatLinear(std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
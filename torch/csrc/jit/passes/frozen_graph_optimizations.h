@@ -8,6 +8,7 @@
  * - FoldFrozenConvBatchnorm
  * - FoldFrozenConvAddOrSub
  * - FoldFrozenConvMulOrDiv
+ * - FrozenConcatLinear
  */
 
 namespace torch {
@@ -2,6 +2,7 @@
 
 #include <ATen/Config.h>
 #include <c10/core/ScalarType.h>
+#include <c10/util/accumulate.h>
 #include <c10/util/Exception.h>
 #include <torch/csrc/jit/ir/constants.h>
 #include <torch/csrc/jit/ir/ir.h>
@@ -129,6 +130,24 @@ void replaceInputWithMKLDNNTensor(Node* n, const std::string& name) {
   replaceInputWithMKLDNNTensor(n, name, mkldnn_tensor);
 }
 
+// Returns the sizes of `v` if they were recorded, e.g. by tracing or
+// profiling. Weights are reordered for these sizes ahead of time, see
+// [mkldnn weight pre-layout].
+c10::optional<std::vector<int64_t>> knownSizes(Value* v) {
+  auto tensor_type = v->type()->cast<TensorType>();
+  if (!tensor_type) {
+    return c10::nullopt;
+  }
+  return tensor_type->sizes().concrete_sizes();
+}
+
+// [mkldnn weight pre-layout]
+// oneDNN picks the blocked format of conv and linear weights based on the
+// shape of the input. Weights that are not in that format are reordered every
+// time the op runs. When the input sizes of the op are known, we reorder the
+// frozen weights into the exact format the primitive will pick; otherwise we
+// use the format oneDNN expects for an unknown input, which may still need a
+// reorder at run time.
 void moveConvWeightsToMKLDNN(Node* conv) {
   auto conv_w_mkldnn =
       constant_as<Tensor>(conv->namedInput("weight")).value().to_mkldnn();
@@ -139,13 +158,18 @@ void moveConvWeightsToMKLDNN(Node* conv) {
   std::vector<int64_t> dilation =
       toIValue(conv->namedInput("dilation"))->toIntVector();
   auto groups = constant_as<int64_t>(conv->namedInput("groups")).value();
+  auto input_size = knownSizes(conv->namedInput("input"));
+  c10::optional<at::IntArrayRef> input_size_ref;
+  if (input_size) {
+    input_size_ref = *input_size;
+  }
 
   if (conv->kind() == aten::conv2d) {
     conv_w_mkldnn = mkldnn_reorder_conv2d_weight(
-        conv_w_mkldnn, padding, stride, dilation, groups);
+        conv_w_mkldnn, padding, stride, dilation, groups, input_size_ref);
   } else if (conv->kind() == aten::conv3d) {
     conv_w_mkldnn = mkldnn_reorder_conv3d_weight(
-        conv_w_mkldnn, padding, stride, dilation, groups);
+        conv_w_mkldnn, padding, stride, dilation, groups, input_size_ref);
   } else {
     TORCH_INTERNAL_ASSERT(false);
   }
@@ -156,11 +180,30 @@ void moveConvWeightsToMKLDNN(Node* conv) {
   }
 }
 
+void moveLinearWeightsToMKLDNN(Node* linear) {
+  auto linear_w_mkldnn =
+      constant_as<Tensor>(linear->namedInput("weight")).value().to_mkldnn();
+  // mkldnn_linear flattens all but the last dimension of the input
+  c10::optional<int64_t> batch_size;
+  if (auto input_size = knownSizes(linear->namedInput("input"))) {
+    batch_size = c10::multiply_integers(
+        input_size->begin(), input_size->end() - 1);
+  }
+  linear_w_mkldnn = mkldnn_reorder_linear_weight(linear_w_mkldnn, batch_size);
+  replaceInputWithMKLDNNTensor(linear, "weight", linear_w_mkldnn);
+
+  if (linear->namedInput("bias")->type() != NoneType::get()) {
+    replaceInputWithMKLDNNTensor(linear, "bias");
+  }
+}
+
 void moveWeightsToMKLDNN(Node* n) {
-  // conv goes through special pathway so we can call mkldnn reorder conv
-  // primitive
+  // conv and linear go through special pathways so we can call the mkldnn
+  // weight reorder primitives
   if (n->kind() == aten::conv2d || n->kind() == aten::conv3d) {
     moveConvWeightsToMKLDNN(n);
+  } else if (n->kind() == aten::linear) {
+    moveLinearWeightsToMKLDNN(n);
   } else {
     for (size_t i = 0; i < n->inputs().size(); ++i) {
       if (!n->input(i)->type()->cast<TensorType>() ||
@@ -484,6 +527,33 @@ class MKLDNNSubgraphSlicer {
   AliasDb& aliasDb_;
 };
 
+// MKLDNN groups are built per block, so a value computed in MKLDNN that is
+// used by a group in another block, or by a group that could not be merged
+// with its producer, is converted to_dense and straight back to_mkldnn. Remove
+// these round trips across the whole graph.
+void removeRedundantLayoutConversions(Block* b) {
+  for (Node* n : b->nodes()) {
+    for (Block* block : n->blocks()) {
+      removeRedundantLayoutConversions(block);
+    }
+    if (n->kind() != aten::to_mkldnn) {
+      continue;
+    }
+    Node* to_dense = n->input(0)->node();
+    if (to_dense->kind() != aten::to_dense ||
+        n->input(1)->type() != NoneType::get() ||
+        to_dense->input(1)->type() != NoneType::get()) {
+      continue;
+    }
+    GRAPH_UPDATE(
+        "Removing layout round trip ",
+        to_dense->output()->debugName(),
+        " -> ",
+        n->output()->debugName());
+    n->output()->replaceAllUsesWith(to_dense->input(0));
+  }
+}
+
 bool containsMKLDNNGroup(Block* b) {
   for (Node* n : b->nodes()) {
     for (Block* block : n->blocks()) {
@@ -522,6 +592,7 @@ void ConvertFrozenOpsToMKLDNN(std::shared_ptr<Graph>& graph) {
     });
     AliasDb db(graph);
     MKLDNNSubgraphSlicer(graph->block(), graph, db).run();
+    removeRedundantLayoutConversions(graph->block());
     EliminateDeadCode(graph);
     GRAPH_DUMP("After convert frozen ops to mkldnn", graph);
   } else {
@@ -1,3 +1,4 @@
+#include <torch/csrc/jit/ir/constants.h>
 #include <torch/csrc/jit/passes/fuse_linear.h>
 #include <torch/csrc/jit/passes/quantization/helper.h>
 #include <torch/csrc/jit/passes/subgraph_rewrite.h>
@@ -89,5 +90,40 @@ void FuseLinear(std::shared_ptr<Graph>& graph) {
       linear_weight_extra_transpose, linear_weight_no_transpose);
   cleanup.runOnGraph(graph);
 }
+
+void FuseLinearActivation(std::shared_ptr<Graph>& graph) {
+  // the weight of a frozen graph is a constant, and the blocked epilogue of
+  // aten::_linear_activation only runs on CPU
+  auto frozen_cpu_weight =
+      [](const Match& match,
+         const std::unordered_map<std::string, Value*>& vmap) {
+        const auto& match_vmap = match.values_map;
+        auto weight = toIValue(match_vmap.at(vmap.at("weight")));
+        return weight && weight->isTensor() &&
+            weight->toTensor().device().is_cpu();
+      };
+
+  // aten op that follows the linear, and the activation it fuses to. relu_
+  // writes to the output of linear, so it is fused like relu.
+  const std::vector<std::pair<std::string, std::string>> activations = {
+      {"relu", "relu"}, {"relu_", "relu"}, {"gelu", "gelu"}};
+  for (const auto& activation : activations) {
+    std::string linear_activation_pattern = R"IR(
+    graph(%input, %weight, %bias):
+        %output = aten::linear(%input, %weight, %bias)
+        %res = aten::)IR" + activation.first + R"IR((%output)
+        return (%res))IR";
+    std::string fused_linear_activation = R"IR(
+    graph(%input, %weight, %bias):
+        %activation : str = prim::Constant[value=")IR" + activation.second + R"IR("]()
+        %res = aten::_linear_activation(%input, %weight, %bias, %activation)
+        return (%res))IR";
+
+    SubgraphRewriter linear_activation;
+    linear_activation.RegisterRewritePattern(
+        linear_activation_pattern, fused_linear_activation);
+    linear_activation.runOnGraph(graph, frozen_cpu_weight);
+  }
+}
 } // namespace jit
 } // namespace torch
@@ -13,5 +13,13 @@ namespace jit {
  * This pass can be deleted once the JIT can emit the aten::linear in the future
  */
 TORCH_API void FuseLinear(std::shared_ptr<Graph>& graph);
+
+/** \brief Fuse aten::linear followed by aten::relu or aten::gelu into a single
+ * aten::_linear_activation, which applies the activation to the GEMM output
+ * block by block instead of in a second pass over it.
+ * Only the linears with a constant CPU weight are fused, so this is meant for
+ * frozen graphs.
+ */
+TORCH_API void FuseLinearActivation(std::shared_ptr<Graph>& graph);
 } // namespace jit
 } // namespace torch
@@ -126,6 +126,49 @@ void fuseHardtanhWithPackedOps(std::shared_ptr<Graph>& graph) {
   rewriter.runOnGraph(graph, torch::jit::graph_rewrite_helper::isClampFusable);
 }
 
+void fuseSigmoidWithPackedOps(std::shared_ptr<Graph>& graph) {
+  SubgraphRewriter rewriter;
+
+  std::string conv2d_prepack_run_sigmoid = R"(
+    graph(%input, %weight, %bias, %stride:int[], %padding:int[],
+          %dilation:int[], %groups:int, %dummy_min_max):
+        %packed_weight_bias = metal_prepack::conv2d_prepack(
+            %weight, %bias, %stride, %padding, %dilation, %groups,
+            %dummy_min_max, %dummy_min_max)
+        %r = metal_prepack::conv2d_run(%input, %packed_weight_bias)
+        %r = aten::sigmoid(%r)
+        return (%r) )";
+
+  std::string conv2d_prepack_run_sigmoid_fused = R"(
+    graph(%input, %weight, %bias, %stride:int[], %padding:int[],
+          %dilation:int[], %groups:int, %dummy_min_max):
+        %packed_weight_bias: __torch__.torch.classes.metal.Conv2dOpContext = metal_prepack::conv2d_prepack(
+            %weight, %bias, %stride, %padding, %dilation, %groups,
+            %dummy_min_max, %dummy_min_max)
+        %r = metal_prepack::conv2d_sigmoid_run(%input, %packed_weight_bias)
+        return (%r) )";
+
+  rewriter.RegisterRewritePattern(
+      conv2d_prepack_run_sigmoid, conv2d_prepack_run_sigmoid_fused);
+
+  std::string conv2d_prepack_run_sigmoid_inplace = R"(
+    graph(%input, %weight, %bias, %stride:int[], %padding:int[],
+          %dilation:int[], %groups:int, %dummy_min_max):
+        %packed_weight_bias = metal_prepack::conv2d_prepack(
+            %weight, %bias, %stride, %padding, %dilation, %groups,
+            %dummy_min_max, %dummy_min_max)
+        %r = metal_prepack::conv2d_run(%input, %packed_weight_bias)
+        %r = aten::sigmoid_(%r)
+        return (%r) )";
+
+  rewriter.RegisterRewritePattern(
+      conv2d_prepack_run_sigmoid_inplace, conv2d_prepack_run_sigmoid_fused);
+
+  // The sigmoid can't be applied on top of a clamped output, so only fuse
+  // convolutions with no output range.
+  rewriter.runOnGraph(graph, torch::jit::graph_rewrite_helper::isClampFusable);
+}
+
 } // namespace
 
 void metalInsertPrePackedOps(std::shared_ptr<Graph>& graph) {
@@ -154,6 +197,7 @@ void metalFusePrePackedConvWithClamp(script::Module& module) {
   auto graph = module.get_method("forward").graph();
   fuseReluWithPackedOps(graph);
   fuseHardtanhWithPackedOps(graph);
+  fuseSigmoidWithPackedOps(graph);
 }
 
 void metalInsertCopyOps(script::Module& module) {
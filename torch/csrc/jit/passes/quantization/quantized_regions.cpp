@@ -0,0 +1,274 @@
+#include <torch/csrc/jit/passes/quantization/quantized_regions.h>
+
+#include <torch/csrc/jit/ir/alias_analysis.h>
+#include <torch/csrc/jit/jit_log.h>
+#include <torch/csrc/jit/passes/dead_code_elimination.h>
+#include <torch/csrc/jit/passes/quantization/finalize.h>
+
+#include <unordered_set>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+bool isTensor(Value* v) {
+  return v->type()->cast<TensorType>() != nullptr;
+}
+
+bool producesTensors(Node* n) {
+  for (Value* output : n->outputs()) {
+    if (isTensor(output) ||
+        output->type()->isSubtypeOf(ListType::ofTensors())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool isQuantize(Node* n) {
+  return n->kind() == aten::quantize_per_tensor ||
+      n->kind() == aten::quantize_per_channel;
+}
+
+bool isDequantize(Node* n) {
+  return n->kind() == aten::dequantize && n->inputs().size() == 1 &&
+      isTensor(n->input());
+}
+
+// Ops on a single tensor that only move or select its values, and so give
+// the same result before and after a per tensor (de)quantization
+bool commutesWithQuantization(Node* n) {
+  static const std::unordered_set<Symbol> kinds = {
+      aten::view,
+      aten::reshape,
+      aten::flatten,
+      aten::transpose,
+      aten::permute,
+      aten::contiguous,
+      aten::squeeze,
+      aten::unsqueeze,
+      aten::detach,
+      aten::repeat,
+      aten::relu,
+      aten::max_pool1d,
+      aten::max_pool2d,
+      aten::max_pool3d,
+  };
+  if (!kinds.count(n->kind()) || n->outputs().size() != 1 ||
+      !isTensor(n->output()) || n->inputs().empty() ||
+      !isTensor(n->input(0))) {
+    return false;
+  }
+  for (size_t i = 1; i < n->inputs().size(); ++i) {
+    if (isTensor(n->input(i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Whether the inputs of n other than the first one are defined before other
+bool argumentsDefinedBefore(Node* n, Node* other) {
+  for (size_t i = 1; i < n->inputs().size(); ++i) {
+    Value* input = n->input(i);
+    if (input->node()->owningBlock() == other->owningBlock() &&
+        !input->node()->isBefore(other)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// op(dequantize(x)) -> dequantize(op(x))
+bool sinkDequantize(
+    Node* n,
+    AliasDb& aliasDb,
+    std::unordered_set<Node*>& touched) {
+  if (!commutesWithQuantization(n) || touched.count(n)) {
+    return false;
+  }
+  Node* dequant = n->input(0)->node();
+  if (!isDequantize(dequant) || touched.count(dequant) ||
+      dequant->owningBlock() != n->owningBlock() ||
+      aliasDb.hasWriters(dequant->input()) ||
+      aliasDb.hasWriters(dequant->output())) {
+    return false;
+  }
+  GRAPH_UPDATE("Moving ", *dequant, " after ", *n);
+  Graph* graph = n->owningGraph();
+  WithInsertPoint guard(n->next());
+  Value* dequantized = graph->insert(aten::dequantize, {n->output()});
+  dequantized->setType(n->output()->type());
+  n->output()->replaceAllUsesWith(dequantized);
+  // replaceAllUsesWith also redirected the input of the new dequantize
+  dequantized->node()->replaceInput(0, n->output());
+  n->replaceInput(0, dequant->input());
+  n->output()->setType(TensorType::get());
+  touched.insert({n, dequant, dequantized->node()});
+  return true;
+}
+
+// quantize(op(y)) -> op(quantize(y))
+bool hoistQuantize(
+    Node* quant,
+    AliasDb& aliasDb,
+    std::unordered_set<Node*>& touched) {
+  if (quant->kind() != aten::quantize_per_tensor || touched.count(quant)) {
+    return false;
+  }
+  Node* op = quant->input(0)->node();
+  if (!commutesWithQuantization(op) || touched.count(op) ||
+      op->owningBlock() != quant->owningBlock() ||
+      op->output()->uses().size() != 1 || !argumentsDefinedBefore(quant, op) ||
+      aliasDb.hasWriters(op->input(0)) || aliasDb.hasWriters(op->output())) {
+    return false;
+  }
+  GRAPH_UPDATE("Moving ", *quant, " before ", *op);
+  Value* quantized = quant->output();
+  quantized->replaceAllUsesWith(op->output());
+  quant->replaceInput(0, op->input(0));
+  quant->moveBefore(op);
+  op->replaceInput(0, quantized);
+  op->output()->setType(quantized->type());
+  quantized->setType(TensorType::get());
+  touched.insert({quant, op});
+  return true;
+}
+
+bool moveQuantizationOps(
+    Block* block,
+    AliasDb& aliasDb,
+    std::unordered_set<Node*>& touched) {
+  bool changed = false;
+  for (auto it = block->nodes().begin(); it != block->nodes().end();) {
+    Node* n = *it++;
+    for (Block* sub_block : n->blocks()) {
+      changed |= moveQuantizationOps(sub_block, aliasDb, touched);
+    }
+    changed |= sinkDequantize(n, aliasDb, touched);
+    changed |= hoistQuantize(n, aliasDb, touched);
+  }
+  return changed;
+}
+
+// Grows the island of dequant from the nodes using its values
+void collectIsland(
+    Node* dequant,
+    std::unordered_set<Node*>& visited,
+    std::vector<QuantIsland>& islands) {
+  QuantIsland island;
+  bool escapes = false;
+  std::vector<Node*> worklist = {dequant};
+  visited.insert(dequant);
+  while (!worklist.empty()) {
+    Node* n = worklist.back();
+    worklist.pop_back();
+    if (isDequantize(n)) {
+      island.dequantizes.push_back(n);
+    } else {
+      island.nodes.push_back(n);
+      for (Value* input : n->inputs()) {
+        Node* producer = input->node();
+        if (isDequantize(producer) &&
+            producer->owningBlock() == n->owningBlock() &&
+            visited.insert(producer).second) {
+          worklist.push_back(producer);
+        }
+      }
+    }
+    for (Value* output : n->outputs()) {
+      for (const Use& use : output->uses()) {
+        Node* user = use.user;
+        if (isQuantize(user) && use.offset == 0) {
+          if (visited.insert(user).second) {
+            island.quantizes.push_back(user);
+          }
+        } else if (
+            user->kind() == prim::Return || !user->blocks().empty() ||
+            user->owningBlock() != n->owningBlock()) {
+          escapes = true;
+        } else if (producesTensors(user) && visited.insert(user).second) {
+          worklist.push_back(user);
+        }
+      }
+    }
+  }
+  if (!escapes && !island.quantizes.empty()) {
+    islands.push_back(std::move(island));
+  }
+}
+
+void findQuantIslands(
+    Block* block,
+    std::unordered_set<Node*>& visited,
+    std::vector<QuantIsland>& islands) {
+  for (Node* n : block->nodes()) {
+    for (Block* sub_block : n->blocks()) {
+      findQuantIslands(sub_block, visited, islands);
+    }
+    if (isDequantize(n) && !visited.count(n)) {
+      collectIsland(n, visited, islands);
+    }
+  }
+}
+
+} // namespace
+
+c10::optional<int64_t> QuantIsland::convertedNumel() const {
+  int64_t numel = 0;
+  auto add = [&](Value* v) {
+    auto type = v->type()->cast<TensorType>();
+    if (!type || !type->numel()) {
+      return false;
+    }
+    numel += *type->numel();
+    return true;
+  };
+  for (Node* dequant : dequantizes) {
+    if (!add(dequant->output())) {
+      return c10::nullopt;
+    }
+  }
+  for (Node* quant : quantizes) {
+    if (!add(quant->input(0))) {
+      return c10::nullopt;
+    }
+  }
+  return numel;
+}
+
+std::vector<QuantIsland> FindQuantIslands(
+    const std::shared_ptr<Graph>& graph) {
+  std::vector<QuantIsland> islands;
+  std::unordered_set<Node*> visited;
+  findQuantIslands(graph->block(), visited, islands);
+  for (const auto& island : islands) {
+    GRAPH_DEBUG(
+        "Found fp32 island of ",
+        island.nodes.size(),
+        " nodes costing ",
+        island.numConversions(),
+        " conversions");
+  }
+  return islands;
+}
+
+void MaximizeQuantizedRegions(
+    std::shared_ptr<Graph>& graph,
+    QuantType quant_type) {
+  // Every move invalidates the alias information of the values it touches,
+  // so each sweep skips those and the next one starts over
+  bool changed = true;
+  while (changed) {
+    AliasDb aliasDb(graph);
+    std::unordered_set<Node*> touched;
+    changed = moveQuantizationOps(graph->block(), aliasDb, touched);
+  }
+  EliminateDeadCode(graph);
+  QuantFusion(graph, quant_type);
+  GRAPH_DUMP("After MaximizeQuantizedRegions: ", graph);
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <torch/csrc/jit/ir/ir.h>
+#include <torch/csrc/jit/passes/quantization/quantization_type.h>
+
+namespace torch {
+namespace jit {
+
+/** \brief A region of a quantized graph that runs in fp32
+ *
+ * The nodes are connected through tensors that are dequantized from int8
+ * values and end up quantized again. A region without nodes is a
+ * dequantize feeding a quantize directly.
+ */
+struct TORCH_API QuantIsland {
+  std::vector<Node*> nodes;
+  // aten::dequantize nodes feeding the island
+  std::vector<Node*> dequantizes;
+  // quantize nodes consuming its results
+  std::vector<Node*> quantizes;
+
+  // Number of dequantize and quantize conversions the island costs, each
+  // one a pass over a tensor
+  size_t numConversions() const {
+    return dequantizes.size() + quantizes.size();
+  }
+  // Number of elements the conversions go over, if the graph has complete
+  // shapes for all of them
+  c10::optional<int64_t> convertedNumel() const;
+};
+
+/** \brief Finds the fp32 islands left in a quantized graph
+ *
+ * Reports every set of nodes connected through values that come from
+ * aten::dequantize and flow into aten::quantize_per_tensor, e.g. ops that
+ * have no quantized counterpart. Values that leave the graph in fp32 don't
+ * form an island.
+ */
+TORCH_API std::vector<QuantIsland> FindQuantIslands(
+    const std::shared_ptr<Graph>& graph);
+
+/** \brief Grows the int8 regions of a quantized graph
+ *
+ * Moves dequantize after and quantize before ops that only move or select
+ * values, which give the same result on int8 values, e.g. aten::view or
+ * aten::max_pool2d. Then runs QuantFusion again, so that ops that were
+ * separated from their dequantize and quantize by such ops, e.g. aten::add,
+ * aten::cat, aten::clamp or aten::sigmoid, are swapped for their quantized
+ * counterparts. Only per tensor quantization is moved, per channel
+ * quantization depends on the layout.
+ */
+TORCH_API void MaximizeQuantizedRegions(
+    std::shared_ptr<Graph>& graph,
+    QuantType quant_type = QuantType::STATIC);
+
+} // namespace jit
+} // namespace torch
@@ -11,6 +11,42 @@ void MutationRemover::removeTensorMutation() {
   RemoveTensorMutation(graph_->block());
 }
 
+namespace {
+
+void collectNodes(Block* block, std::vector<Node*>& nodes) {
+  for (Node* n : block->nodes()) {
+    nodes.push_back(n);
+    for (Block* b : n->blocks()) {
+      collectNodes(b, nodes);
+    }
+  }
+}
+
+} // namespace
+
+void MutationRemover::functionalizeTensorMutation() {
+  std::vector<Node*> nodes;
+  collectNodes(graph_->block(), nodes);
+  std::vector<Value*> roots;
+  for (Node* n : nodes) {
+    if (!functionalizableOp(n)) {
+      continue;
+    }
+    Value* root = mutationRoot(n->inputs().at(0));
+    if (std::find(roots.begin(), roots.end(), root) == roots.end()) {
+      roots.push_back(root);
+    }
+  }
+
+  // Functionalizing the mutations of a root destroys the in-place ops, which
+  // are not roots themselves
+  for (Value* root : roots) {
+    if (tryFunctionalizeMutations(root)) {
+      aliasDb_ = torch::make_unique<AliasDb>(graph_);
+    }
+  }
+}
+
 bool MutationRemover::newMemoryLocation(Value* v) {
   // bail on nodes with side effects, blocks, or graph / graph inputs
   Node* n = v->node();
@@ -43,6 +79,144 @@ Node* MutationRemover::createSpecialMappedOp(Node* n) {
   return new_node;
 }
 
+Node* MutationRemover::createFunctionalOp(Node* n) {
+  if (isSpecialMappedOp(n)) {
+    return createSpecialMappedOp(n);
+  }
+  Node* new_node;
+  if (isCopy(n)) {
+    // self.copy_(src) writes src, broadcast and converted to the dtype and
+    // device of self, over all of self
+    WithInsertPoint guard(n);
+    auto inputs = n->inputs();
+    Value* src = graph_->insert(aten::type_as, {inputs.at(1), inputs.at(0)});
+    Value* expanded = graph_->insert(aten::expand_as, {src, inputs.at(0)});
+    new_node = graph_->insert(aten::clone, {expanded})->node();
+  } else {
+    auto schema_name = n->schema().name();
+    auto new_schema = schema_name.substr(0, schema_name.size() - 1);
+    new_node = graph_->create(Symbol::fromQualString(new_schema), 1);
+    new_node->insertBefore(n);
+    for (Value* input : n->inputs()) {
+      new_node->addInput(input);
+    }
+  }
+  new_node->copyMetadata(n);
+  new_node->output()->setType(n->output()->type());
+  return new_node;
+}
+
+bool MutationRemover::isCopy(Node* n) {
+  return n->matches(
+      "aten::copy_(Tensor(a!) self, Tensor src, bool non_blocking=False) -> Tensor(a!)");
+}
+
+bool MutationRemover::functionalizableOp(Node* n) {
+  if (mutation_filter_ && !(*mutation_filter_)(n)) {
+    return false;
+  }
+  if (isCopy(n)) {
+    return !aliasDb_->writesToAlias(n, {n->inputs().at(1)});
+  }
+  return inplaceOpVariant(n);
+}
+
+Value* MutationRemover::mutationRoot(Value* v) {
+  // The output of an in-place op is the tensor it mutated
+  while (functionalizableOp(v->node())) {
+    v = v->node()->inputs().at(0);
+  }
+  return v;
+}
+
+bool MutationRemover::tryFunctionalizeMutations(Value* root) {
+  bool is_graph_input = root->node() == graph_->param_node();
+  if (!is_graph_input && !newMemoryLocation(root)) {
+    return false;
+  }
+  if (is_graph_input) {
+    // Inputs may alias each other
+    for (Value* input : graph_->inputs()) {
+      if (input != root && input->hasUses() &&
+          aliasDb_->mayContainAlias(input, root)) {
+        return false;
+      }
+    }
+  }
+
+  // The mutations must form a chain of in-place ops in the block of root,
+  // and be the only values aliasing root
+  Block* block = root->node()->owningBlock();
+  std::vector<Node*> chain;
+  std::unordered_set<const Value*> chain_values = {root};
+  std::vector<Node*> nodes;
+  collectNodes(graph_->block(), nodes);
+  for (Node* n : nodes) {
+    if (aliasDb_->writesToAlias(n, {root})) {
+      if (n->owningBlock() != block || !functionalizableOp(n) ||
+          !chain_values.count(n->inputs().at(0))) {
+        return false;
+      }
+      chain.push_back(n);
+      chain_values.insert(n->output());
+      continue;
+    }
+    // Loop carried values alias their initial values through the block
+    // parameters, which we don't track
+    if (n->kind() == prim::Loop) {
+      for (Value* input : n->inputs()) {
+        if (chain_values.count(input)) {
+          return false;
+        }
+      }
+    }
+    for (Value* output : n->outputs()) {
+      if (aliasDb_->mayContainAlias(output, root)) {
+        return false;
+      }
+    }
+  }
+  if (chain.empty()) {
+    return false;
+  }
+
+  // We rewrite something like:
+  // x.add_(1)
+  // y = x * 2
+  // x.mul_(3)
+  // return x, y
+  // to:
+  // x1 = x.add(1)
+  // y = x1 * 2
+  // x2 = x1.mul(3)
+  // return x2, y
+  // Every use of a version of x after a mutation reads the new version.
+  std::vector<Value*> versions = {root};
+  for (Node* n : chain) {
+    Node* new_node = createFunctionalOp(n);
+    for (Value* version : versions) {
+      version->replaceAllUsesAfterNodeWith(n, new_node->output());
+    }
+    n->output()->replaceAllUsesWith(new_node->output());
+    n->destroy();
+    versions.push_back(new_node->output());
+  }
+
+  if (is_graph_input) {
+    // The caller observes the mutation of the input
+    WithInsertPoint guard(graph_->return_node());
+    Value* write_back =
+        graph_->insert(aten::copy_, {root, versions.back()});
+    write_back->setType(root->type());
+    for (size_t i = 0; i < graph_->outputs().size(); ++i) {
+      if (graph_->outputs()[i] == versions.back()) {
+        graph_->return_node()->replaceInput(i, write_back);
+      }
+    }
+  }
+  return true;
+}
+
 bool MutationRemover::listAppendFollowingListConstruct(Node* n) {
   return n->kind() == aten::append &&
       n->inputs().at(0)->node()->kind() == prim::ListConstruct;
@@ -127,9 +301,7 @@ void MutationRemover::RemoveListMutation(Block* block) {
     aliasDb_->writeIndex_->erase(node);
     node->destroy();
 
-    // TODO: don't strictly need to reset write cache, evaluate on models
-    aliasDb_->writtenToLocationsIndex_ =
-        aliasDb_->buildWrittenToLocationsIndex();
+    aliasDb_->writtenToLocationsIndex_ = c10::nullopt;
   }
 }
 
@@ -160,20 +332,7 @@ void MutationRemover::RemoveTensorMutation(Block* block) {
       continue;
     }
 
-    Node* new_node;
-    if (isSpecialMappedOp(node)) {
-      new_node = createSpecialMappedOp(node);
-    } else {
-      auto schema_name = node->schema().name();
-      auto new_schema = schema_name.substr(0, schema_name.size() - 1);
-      new_node = graph_->create(Symbol::fromQualString(new_schema), 1);
-      new_node->copyMetadata(node);
-      new_node->insertBefore(node);
-      for (Value* input : node->inputs()) {
-        new_node->addInput(input);
-      }
-      new_node->output()->setType(node->output()->type());
-    }
+    Node* new_node = createFunctionalOp(node);
 
     mutated_value->replaceAllUsesAfterNodeWith(node, new_node->output());
     node->output()->replaceAllUsesWith(new_node->output());
@@ -202,9 +361,7 @@ void MutationRemover::RemoveTensorMutation(Block* block) {
     node->destroy();
 
     // now that we have removed a mutating op, the write cache is stale
-    // TODO: don't strictly need to reset write cache, evaluate on models
-    aliasDb_->writtenToLocationsIndex_ =
-        aliasDb_->buildWrittenToLocationsIndex();
+    aliasDb_->writtenToLocationsIndex_ = c10::nullopt;
   }
 }
 
@@ -220,5 +377,12 @@ void RemoveTensorMutation(
   mr.removeTensorMutation();
 }
 
+void FunctionalizeTensorMutation(
+    const std::shared_ptr<Graph>& graph,
+    c10::optional<std::function<bool(Node*)>> mutation_filter) {
+  MutationRemover mr(graph, std::move(mutation_filter));
+  mr.functionalizeTensorMutation();
+}
+
 } // namespace jit
 } // namespace torch
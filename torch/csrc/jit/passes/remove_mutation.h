@@ -22,6 +22,8 @@ struct MutationRemover {
 
   void removeTensorMutation();
 
+  void functionalizeTensorMutation();
+
   bool isSpecialMappedOp(Node* n) {
     return n->matches("aten::zero_(Tensor(a!) self) -> Tensor(a!)") ||
         n->matches(
@@ -72,6 +74,11 @@ struct MutationRemover {
  private:
   bool newMemoryLocation(Value* v);
   Node* createSpecialMappedOp(Node* n);
+  Node* createFunctionalOp(Node* n);
+  bool isCopy(Node* n);
+  bool functionalizableOp(Node* n);
+  Value* mutationRoot(Value* v);
+  bool tryFunctionalizeMutations(Value* root);
   bool listAppendFollowingListConstruct(Node* n);
   bool tryMakeCreationAndMutationAtomic(
       Value* mutated_value,
@@ -98,5 +105,16 @@ TORCH_API void RemoveTensorMutation(
     const std::shared_ptr<Graph>& graph,
     c10::optional<std::function<bool(Node*)>> mutation_filter = c10::nullopt);
 
+// Replaces in-place aten ops, including copy_, with their functional
+// equivalents, as long as every value that may alias the mutated tensor is
+// one of the results of these ops. Unlike RemoveTensorMutation, this also
+// handles a mutated value that is read between two of its mutations, and the
+// mutation of a graph input, which is kept observable by a single copy_ into
+// the input at the end of the graph. Inputs are only handled when no other
+// input that may alias them is used. Mutation through views is left as is.
+TORCH_API void FunctionalizeTensorMutation(
+    const std::shared_ptr<Graph>& graph,
+    c10::optional<std::function<bool(Node*)>> mutation_filter = c10::nullopt);
+
 } // namespace jit
 } // namespace torch
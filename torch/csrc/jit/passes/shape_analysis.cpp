@@ -47,6 +47,62 @@ bool isValidArgumentForRunning(Value* v) {
   return v->type()->isSubtypeOf(FloatType::get());
 }
 
+// The order of the strides of type from the innermost dimension, see
+// TensorType::computeStrideProps, if they are known to be channels last.
+c10::optional<std::vector<size_t>> channelsLastStrideOrder(
+    const TensorTypePtr& type) {
+  static const std::vector<size_t> channels_last{1, 3, 2, 0};
+  static const std::vector<size_t> channels_last_3d{1, 4, 3, 2, 0};
+  const auto& stride_props = type->stride_properties().sizes();
+  if (!stride_props) {
+    return c10::nullopt;
+  }
+  std::vector<size_t> stride_order;
+  for (const auto& stride : *stride_props) {
+    if (!stride || !stride->stride_index_) {
+      return c10::nullopt;
+    }
+    stride_order.push_back(*stride->stride_index_);
+  }
+  if (stride_order != channels_last && stride_order != channels_last_3d) {
+    return c10::nullopt;
+  }
+  return stride_order;
+}
+
+// Is type known to be contiguous in channels last memory format
+bool isDenseChannelsLast(const TensorTypePtr& type) {
+  if (!channelsLastStrideOrder(type)) {
+    return false;
+  }
+  for (const auto& stride : *type->stride_properties().sizes()) {
+    if (!stride->contiguous_ || !*stride->contiguous_) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Ops that allocate their output in the memory format of their input keep
+// channels last. Without concrete sizes, the order of the input strides is all
+// that is known about the strides of the output.
+TensorTypePtr dimensionedWithMemoryFormat(const TensorTypePtr& type) {
+  const auto stride_order = channelsLastStrideOrder(type);
+  if (!stride_order) {
+    return type->dimensionedOnly();
+  }
+  std::vector<c10::Stride> strides;
+  for (const auto index : *stride_order) {
+    strides.emplace_back(index, c10::nullopt, c10::nullopt);
+  }
+  return TensorType::create(
+      type->scalarType(),
+      type->device(),
+      c10::SymbolicShape(type->dim()),
+      c10::VaryingShape<c10::Stride>(strides),
+      type->requiresGrad());
+}
+
 bool isValidReturnForRunning(Value* v) {
   return v->type()->isSubtypeOf(TensorType::get()) ||
       v->type()->isSubtypeOf(NumberType::get());
@@ -812,27 +868,19 @@ class ShapePropagator {
             "aten::acos(Tensor self) -> Tensor",
             "aten::neg(Tensor self) -> Tensor",
             "aten::t(Tensor self) -> Tensor",
-            "aten::sigmoid(Tensor self) -> Tensor",
             "aten::logit(Tensor self, float? eps=None) -> Tensor",
-            "aten::tanh(Tensor self) -> Tensor",
-            "aten::relu(Tensor self) -> Tensor",
             "aten::asin(Tensor self) -> Tensor",
             "aten::atan(Tensor self) -> Tensor",
             "aten::ceil(Tensor self) -> Tensor",
             "aten::clone(Tensor self, *, MemoryFormat? memory_format=None) -> Tensor",
             "aten::contiguous(Tensor(a) self, *, MemoryFormat memory_format=contiguous_format) -> Tensor(a)",
             "aten::bernoulli(Tensor self, *, Generator? generator) -> Tensor",
-            "aten::celu(Tensor self, Scalar alpha) -> Tensor",
-            "aten::clamp(Tensor self, Scalar? min, Scalar? max) -> Tensor",
-            "aten::clamp_max(Tensor self, Scalar max) -> Tensor",
-            "aten::clamp_min(Tensor self, Scalar min) -> Tensor",
             "aten::alpha_dropout(Tensor input, float p, bool train) -> Tensor",
             "aten::bernoulli(Tensor self, float p, *, Generator? generator) -> Tensor",
             "aten::cos(Tensor self) -> Tensor",
             "aten::cosh(Tensor self) -> Tensor",
             "aten::digamma(Tensor self) -> Tensor",
             "aten::dropout(Tensor input, float p, bool train) -> Tensor",
-            "aten::elu(Tensor self, Scalar alpha, Scalar scale, Scalar input_scale) -> Tensor",
             "aten::erf(Tensor self) -> Tensor",
             "aten::erfc(Tensor self) -> Tensor",
             "aten::erfinv(Tensor self) -> Tensor",
@@ -849,10 +897,8 @@ class ShapePropagator {
             "aten::feature_alpha_dropout(Tensor input, float p, bool train) -> Tensor",
             "aten::feature_dropout(Tensor input, float p, bool train) -> Tensor",
             "aten::hardshrink(Tensor self, Scalar lambd) -> Tensor",
-            "aten::hardtanh(Tensor self, Scalar min_val, Scalar max_val) -> Tensor",
             "aten::glu(Tensor self, int dim) -> Tensor",
             "aten::inverse(Tensor self) -> Tensor",
-            "aten::leaky_relu(Tensor self, Scalar negative_slope) -> Tensor",
             "aten::lgamma(Tensor self) -> Tensor",
             "aten::mvlgamma(Tensor self, int p) -> Tensor",
             "aten::normal(float mean, Tensor std, *, Generator? generator) -> Tensor",
@@ -861,13 +907,11 @@ class ShapePropagator {
             "aten::pin_memory(Tensor(a) self) -> Tensor(a)",
             "aten::pinverse(Tensor self, float rcond) -> Tensor",
             "aten::reciprocal(Tensor self) -> Tensor",
-            "aten::relu(Tensor self) -> Tensor",
             "aten::round(Tensor self) -> Tensor",
             "aten::rrelu(Tensor self, Scalar lower, Scalar upper, bool training, Generator? generator) -> Tensor",
             "aten::rsqrt(Tensor self) -> Tensor",
             "aten::selu(Tensor self) -> Tensor",
             "aten::gelu(Tensor self) -> Tensor",
-            "aten::sigmoid(Tensor self) -> Tensor",
             "aten::sign(Tensor self) -> Tensor",
             "aten::sin(Tensor self) -> Tensor",
             "aten::sinh(Tensor self) -> Tensor",
@@ -875,7 +919,6 @@ class ShapePropagator {
             "aten::softshrink(Tensor self, Scalar lambd) -> Tensor",
             "aten::sqrt(Tensor self) -> Tensor",
             "aten::tan(Tensor self) -> Tensor",
-            "aten::tanh(Tensor self) -> Tensor",
             "aten::threshold(Tensor self, Scalar threshold, Scalar value) -> Tensor",
             "aten::transpose(Tensor self, int dim0, int dim1) -> Tensor",
             "aten::tril(Tensor self, int diagonal) -> Tensor",
@@ -892,6 +935,35 @@ class ShapePropagator {
                             : type_vec_t{};
         }};
 
+    // Requirements:
+    //   dims           : preserved
+    //   scalar type    : preserved
+    //   device         : preserved
+    //   memory format  : preserved
+    //   tensor inputs  : 1
+    //   tensor outputs : 1
+    // Additionally:
+    //   - First input should be the only tensor input
+    static const register_formula_for elementwise_unary_ops{
+        {
+            "aten::celu(Tensor self, Scalar alpha) -> Tensor",
+            "aten::clamp(Tensor self, Scalar? min, Scalar? max) -> Tensor",
+            "aten::clamp_max(Tensor self, Scalar max) -> Tensor",
+            "aten::clamp_min(Tensor self, Scalar min) -> Tensor",
+            "aten::elu(Tensor self, Scalar alpha, Scalar scale, Scalar input_scale) -> Tensor",
+            "aten::hardtanh(Tensor self, Scalar min_val, Scalar max_val) -> Tensor",
+            "aten::leaky_relu(Tensor self, Scalar negative_slope) -> Tensor",
+            "aten::relu(Tensor self) -> Tensor",
+            "aten::sigmoid(Tensor self) -> Tensor",
+            "aten::tanh(Tensor self) -> Tensor",
+        },
+        [](Node* node) -> type_vec_t {
+          auto input_type = node->input(0)->type()->cast<TensorType>();
+          return input_type
+              ? type_vec_t{dimensionedWithMemoryFormat(input_type)}
+              : type_vec_t{};
+        }};
+
     // Requirements:
     //   dims           : preserved
     //   scalar type    : preserved, except complex maps to float
@@ -1152,7 +1224,6 @@ class ShapePropagator {
     //     infer the output type.
     static const register_formula_for nn_ops_first_input_preserving{
         {
-            "aten::batch_norm(Tensor input, Tensor? weight, Tensor? bias, Tensor? running_mean, Tensor? running_var, bool training, float momentum, float eps, bool cudnn_enabled) -> Tensor",
             "aten::conv1d(Tensor input, Tensor weight, Tensor? bias, int[] stride, int[] padding, int[] dilation, int groups) -> Tensor",
             "aten::conv2d(Tensor input, Tensor weight, Tensor? bias, int[] stride, int[] padding, int[] dilation, int groups) -> Tensor",
             "aten::conv3d(Tensor input, Tensor weight, Tensor? bias, int[] stride, int[] padding, int[] dilation, int groups) -> Tensor",
@@ -1164,13 +1235,10 @@ class ShapePropagator {
             "aten::_convolution(Tensor input, Tensor weight, Tensor? bias, int[] stride, int[] padding, int[] dilation, bool transposed, int[] output_padding, int groups, bool benchmark, bool deterministic, bool cudnn_enabled) -> Tensor", // deprecated _convolution
             "aten::_convolution(Tensor input, Tensor weight, Tensor? bias, int[] stride, int[] padding, int[] dilation, bool transposed, int[] output_padding, int groups, bool benchmark, bool deterministic, bool cudnn_enabled, bool allow_tf32) -> Tensor",
             "aten::adaptive_avg_pool1d(Tensor self, int[] output_size) -> Tensor",
-            "aten::adaptive_avg_pool2d(Tensor self, int[] output_size) -> Tensor",
             "aten::adaptive_avg_pool3d(Tensor self, int[] output_size) -> Tensor",
             "aten::avg_pool1d(Tensor self, int[] kernel_size, int[] stride, int[] padding, bool ceil_mode, bool count_include_pad) -> Tensor",
-            "aten::avg_pool2d(Tensor self, int[] kernel_size, int[] stride, int[] padding, bool ceil_mode, bool count_include_pad, int? divisor_override) -> Tensor",
             "aten::avg_pool3d(Tensor self, int[] kernel_size, int[] stride, int[] padding, bool ceil_mode, bool count_include_pad, int? divisor_override) -> Tensor",
             "aten::max_pool1d(Tensor self, int[] kernel_size, int[] stride, int[] padding, int[] dilation, bool ceil_mode) -> Tensor",
-            "aten::max_pool2d(Tensor self, int[] kernel_size, int[] stride, int[] padding, int[] dilation, bool ceil_mode) -> Tensor",
             "aten::max_pool3d(Tensor self, int[] kernel_size, int[] stride, int[] padding, int[] dilation, bool ceil_mode) -> Tensor",
             "aten::max_unpool2d(Tensor self, Tensor indices, int[] output_size) -> Tensor",
             "aten::max_unpool3d(Tensor self, Tensor indices, int[] output_size, int[] stride, int[] padding) -> Tensor",
@@ -1179,11 +1247,8 @@ class ShapePropagator {
             "aten::replication_pad1d(Tensor self, int[] padding) -> Tensor",
             "aten::replication_pad2d(Tensor self, int[] padding) -> Tensor",
             "aten::replication_pad3d(Tensor self, int[] padding) -> Tensor",
-            "aten::upsample_bilinear2d(Tensor self, int[] output_size, bool align_corners, float? scales_h, float? scales_w) -> Tensor",
             "aten::upsample_linear1d(Tensor self, int[] output_size, bool align_corners, float? scales) -> Tensor",
             "aten::upsample_nearest1d(Tensor self, int[] output_size, float? scales) -> Tensor",
-            "aten::upsample_nearest2d(Tensor self, int[] output_size, float? scales_h, float? scales_w) -> Tensor",
-            "aten::upsample_nearest3d(Tensor self, int[] output_size, float? scales_d, float? scales_h, float? scales_w) -> Tensor",
             "aten::upsample_trilinear3d(Tensor self, int[] output_size, bool align_corners, float? scales_d, float? scales_h, float? scales_w) -> Tensor",
             "aten::prelu(Tensor self, Tensor weight) -> Tensor",
         },
@@ -1194,6 +1259,28 @@ class ShapePropagator {
           return {};
         }};
 
+    // Same as nn_ops_first_input_preserving, for ops whose CPU kernels keep
+    // channels last inputs in channels last.
+    static const register_formula_for nn_ops_memory_format_preserving{
+        {
+            "aten::batch_norm(Tensor input, Tensor? weight, Tensor? bias, Tensor? running_mean, Tensor? running_var, bool training, float momentum, float eps, bool cudnn_enabled) -> Tensor",
+            "aten::adaptive_avg_pool2d(Tensor self, int[] output_size) -> Tensor",
+            "aten::avg_pool2d(Tensor self, int[] kernel_size, int[] stride, int[] padding, bool ceil_mode, bool count_include_pad, int? divisor_override) -> Tensor",
+            "aten::max_pool2d(Tensor self, int[] kernel_size, int[] stride, int[] padding, int[] dilation, bool ceil_mode) -> Tensor",
+            "aten::upsample_bilinear2d(Tensor self, int[] output_size, bool align_corners, float? scales_h, float? scales_w) -> Tensor",
+            "aten::upsample_nearest2d(Tensor self, int[] output_size, float? scales_h, float? scales_w) -> Tensor",
+            "aten::upsample_nearest3d(Tensor self, int[] output_size, float? scales_d, float? scales_h, float? scales_w) -> Tensor",
+            "aten::group_norm(Tensor input, int num_groups, Tensor? weight=None, Tensor? bias=None, float eps=1e-05, bool cudnn_enabled=True) -> Tensor",
+            "aten::pixel_shuffle(Tensor self, int upscale_factor) -> Tensor",
+            "aten::pixel_unshuffle(Tensor self, int downscale_factor) -> Tensor",
+        },
+        [](Node* node) -> type_vec_t {
+          if (auto type = node->input(0)->type()->cast<TensorType>()) {
+            return {dimensionedWithMemoryFormat(type)};
+          }
+          return {};
+        }};
+
     // Requirements:
     //   dims           : 0
     //   scalar type    : preserved
@@ -1976,7 +2063,10 @@ class ShapePropagator {
         node->matches("aten::neg(Tensor self) -> Tensor") ||
         node->matches("aten::sigmoid(Tensor self) -> Tensor") ||
         node->matches("aten::tanh(Tensor self) -> Tensor")) {
-      node->output()->setType(tensor_types.at(0)->contiguous());
+      // The output is allocated like the input, which keeps channels last
+      auto type = tensor_types.at(0);
+      node->output()->setType(
+          isDenseChannelsLast(type) ? type : type->contiguous());
       return true;
     } else if (node->matches("aten::mm(Tensor self, Tensor mat2) -> Tensor")) {
       auto lhs_type = tensor_types.at(0);
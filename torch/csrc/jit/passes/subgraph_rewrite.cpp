@@ -2,6 +2,7 @@
 
 #include <torch/csrc/jit/ir/irparser.h>
 #include <torch/csrc/jit/ir/subgraph_matcher.h>
+#include <torch/csrc/jit/jit_log.h>
 
 namespace torch {
 namespace jit {
@@ -39,6 +40,7 @@ Module SubgraphRewriter::runOnModule(const Module& module) {
 void SubgraphRewriter::runOnGraph(
     std::shared_ptr<Graph>& graph,
     const std::vector<MatchFilter>& filters) {
+  JIT_PASS_TIMER;
   for (const RewritePatternDescr& pattern : patterns_) {
     rewriteSinglePatternOnGraph(graph, pattern, filters);
   }
@@ -27,6 +27,8 @@ namespace torch {
 namespace jit {
 
 static bool texpr_reductions_enabled = false;
+static bool texpr_external_calls_enabled = false;
+static bool texpr_dynamic_shapes_enabled = false;
 
 bool isSupportedForBlock(Node* node) {
   switch (node->kind()) {
@@ -177,9 +179,19 @@ bool isSupported(Node* node) {
   static const OperatorSet supported_reduction_set{
       "aten::sum(Tensor self, *, ScalarType? dtype=None) -> Tensor",
       "aten::sum.dim_IntList(Tensor self, int[1] dim, bool keepdim=False, *, ScalarType? dtype=None) -> Tensor",
+      "aten::mean(Tensor self, *, ScalarType? dtype=None) -> Tensor",
+      "aten::mean.dim(Tensor self, int[1] dim, bool keepdim=False, *, ScalarType? dtype=None) -> Tensor",
+      "aten::amax(Tensor self, int[1] dim=[], bool keepdim=False) -> Tensor",
       "aten::softmax.int(Tensor self, int dim , ScalarType? dtype=None) -> Tensor",
       "aten::log_softmax.int(Tensor self, int dim, ScalarType? dtype=None) -> Tensor",
   };
+  // These are computed by calling into ATen from the kernel, see
+  // external_functions.cpp, so that their elementwise consumers can be fused.
+  // External calls are only supported by the CPU backends.
+  static const OperatorSet supported_external_call_set{
+      "aten::matmul(Tensor self, Tensor other) -> Tensor",
+      "aten::linear(Tensor input, Tensor weight, Tensor? bias=None) -> Tensor",
+  };
   static const OperatorSet supported_misc_set{
       "aten::cat(Tensor[] tensors, int dim=0) -> Tensor",
       "aten::unsqueeze(Tensor(a) self, int dim) -> Tensor(a)",
@@ -188,7 +200,9 @@ bool isSupported(Node* node) {
 
   if (node->isMemberOf(supported_eltwise_set()) ||
       node->isMemberOf(supported_misc_set) ||
-      (texpr_reductions_enabled && node->isMemberOf(supported_reduction_set))) {
+      (texpr_reductions_enabled && node->isMemberOf(supported_reduction_set)) ||
+      (texpr_external_calls_enabled &&
+       node->isMemberOf(supported_external_call_set))) {
     // We only insert guards on Tensor types, so we rely on the output
     // of a node being uniquely determined by its input types.
     // bail if any non-Tensor input affects the output type
@@ -212,6 +226,21 @@ bool isSupported(Node* node) {
       }
     }
 
+    // Operator is only supported on CPU, and its tensor operands are passed
+    // to the external call as buffers, so they can't be constants.
+    if (node->isMemberOf(supported_external_call_set)) {
+      auto device = tensorexpr::pickDeviceType(node->inputs());
+      if (!device || !device->is_cpu()) {
+        return false;
+      }
+      for (Value* v : node->inputs()) {
+        if (v->type()->cast<TensorType>() &&
+            v->node()->kind() == prim::Constant) {
+          return false;
+        }
+      }
+    }
+
     // non-const dtype / device
     for (auto arg_name : {"dtype", "device"}) {
       if (auto index = node->schema().argumentIndexWithName(arg_name)) {
@@ -268,6 +297,26 @@ bool texprReductionsEnabled() {
   return texpr_reductions_enabled;
 }
 
+bool setTexprExternalCallsEnabled(bool value) {
+  bool old_value = texpr_external_calls_enabled;
+  texpr_external_calls_enabled = value;
+  return old_value;
+}
+
+bool texprExternalCallsEnabled() {
+  return texpr_external_calls_enabled;
+}
+
+bool setTexprDynamicShapesEnabled(bool value) {
+  bool old_value = texpr_dynamic_shapes_enabled;
+  texpr_dynamic_shapes_enabled = value;
+  return old_value;
+}
+
+bool texprDynamicShapesEnabled() {
+  return texpr_dynamic_shapes_enabled;
+}
+
 void removeProfileNodesAndSpecializeTypes(Block* b) {
   for (auto it = b->nodes().begin(); it != b->nodes().end(); it++) {
     if (it->kind() == prim::profile) {
@@ -872,6 +921,12 @@ class TensorExprFuser {
       "aten::remainder.Scalar(Tensor self, Scalar other) -> Tensor",
       "aten::remainder.Tensor(Tensor self, Tensor other) -> Tensor",
     };
+    static const OperatorSet float_tensor_only_operator_set{
+      "aten::mean(Tensor self, *, ScalarType? dtype=None) -> Tensor",
+      "aten::mean.dim(Tensor self, int[1] dim, bool keepdim=False, *, ScalarType? dtype=None) -> Tensor",
+      "aten::matmul(Tensor self, Tensor other) -> Tensor",
+      "aten::linear(Tensor input, Tensor weight, Tensor? bias=None) -> Tensor",
+    };
     static const OperatorSet int_only_operator_set{
       "aten::__lshift__.Scalar(Tensor self, Scalar other) -> Tensor",
       "aten::__lshift__.Tensor(Tensor self, Tensor other) -> Tensor",
@@ -901,6 +956,13 @@ class TensorExprFuser {
           return false;
         }
 
+        // These operators only support floating point tensors, but may take
+        // non-tensor arguments of other types.
+        if (node->isMemberOf(float_tensor_only_operator_set) &&
+            !isFloatingType(*st)) {
+          return false;
+        }
+
         // These operators have complicated casting rules for floats.
         if (node->isMemberOf(int_only_operator_set) && isFloatingType(*st)) {
           return false;
@@ -965,8 +1027,13 @@ class TensorExprFuser {
           // All tensor types should be known.
           return false;
         }
-        if (c10::isComplexType(*st) || c10::isQIntType(*st) ||
-            *st == c10::ScalarType::BFloat16) {
+        if (c10::isComplexType(*st) || c10::isQIntType(*st)) {
+          return false;
+        }
+        // BFloat16 is only supported by the CPU codegens, which compute it in
+        // Float.
+        if (*st == c10::ScalarType::BFloat16 &&
+            (!tt->device() || !tt->device()->is_cpu())) {
           return false;
         }
       }
@@ -1107,10 +1174,27 @@ class TensorExprFuser {
     for (Node* fusion_group : fusion_groups) {
       removeOutputsUsedOnlyInSize(fusion_group);
       liftTensorConstantsFromFusionGroups(fusion_group);
-      insertTypeGuard(
-          fusion_group,
-          [](const TensorTypePtr& t) { return t; },
-          prim::TypeCheck);
+      if (texpr_dynamic_shapes_enabled) {
+        // Only guard on dtype, device and requires_grad: TensorExprKernel
+        // compiles and caches a specialization for every new input shape.
+        insertTypeGuard(
+            fusion_group,
+            [](const TensorTypePtr& t) {
+              return TensorType::create(
+                  t->scalarType(),
+                  t->device(),
+                  c10::SymbolicShape(),
+                  c10::VaryingShape<c10::Stride>{},
+                  t->requiresGrad(),
+                  t->undefined());
+            },
+            prim::TypeCheck);
+      } else {
+        insertTypeGuard(
+            fusion_group,
+            [](const TensorTypePtr& t) { return t; },
+            prim::TypeCheck);
+      }
     }
   }
 
@@ -24,6 +24,10 @@ TORCH_API void setTensorExprFuserEnabled(bool val);
 TORCH_API bool tensorExprFuserEnabled();
 TORCH_API bool setTexprReductionsEnabled(bool value);
 TORCH_API bool texprReductionsEnabled();
+TORCH_API bool setTexprExternalCallsEnabled(bool value);
+TORCH_API bool texprExternalCallsEnabled();
+TORCH_API bool setTexprDynamicShapesEnabled(bool value);
+TORCH_API bool texprDynamicShapesEnabled();
 
 TORCH_API void RemoveProfileNodesAndSpecializeTypes(
     std::shared_ptr<Graph>& graph);
@@ -22,6 +22,8 @@
 #include <torch/csrc/jit/passes/erase_number_types.h>
 #include <torch/csrc/jit/passes/fold_conv_bn.h>
 #include <torch/csrc/jit/passes/freeze_module.h>
+#include <torch/csrc/jit/passes/frozen_batch_norm_relu.h>
+#include <torch/csrc/jit/passes/frozen_concat_linear.h>
 #include <torch/csrc/jit/passes/frozen_conv_folding.h>
 #include <torch/csrc/jit/passes/frozen_graph_optimizations.h>
 #include <torch/csrc/jit/passes/frozen_ops_to_mkldnn.h>
@@ -58,6 +60,7 @@
 #include <torch/csrc/jit/passes/quantization/insert_observers.h>
 #include <torch/csrc/jit/passes/quantization/insert_quant_dequant.h>
 #include <torch/csrc/jit/passes/quantization/quantization_type.h>
+#include <torch/csrc/jit/passes/quantization/quantized_regions.h>
 #include <torch/csrc/jit/passes/remove_dropout.h>
 #include <torch/csrc/jit/passes/remove_expands.h>
 #include <torch/csrc/jit/passes/remove_inplace_ops.h>
@@ -82,6 +85,7 @@
 #include <torch/csrc/jit/runtime/jit_exception.h>
 #include <torch/csrc/jit/runtime/operator.h>
 #include <torch/csrc/jit/runtime/print_handler.h>
+#include <torch/csrc/jit/runtime/profiling_graph_executor_impl.h>
 #include <torch/csrc/jit/runtime/static/init.h>
 #include <torch/csrc/jit/serialization/export.h>
 #include <torch/csrc/jit/serialization/import.h>
@@ -295,6 +299,29 @@ void initJITBindings(PyObject* module) {
       .def(
           "_jit_pass_quant_fusion",
           [](std::shared_ptr<Graph>& g) { return QuantFusion(g); })
+      .def(
+          "_jit_pass_quant_find_islands",
+          [](std::shared_ptr<Graph>& g) {
+            // (nodes, dequantizes, quantizes) of each island
+            std::vector<std::tuple<
+                std::vector<Node*>,
+                std::vector<Node*>,
+                std::vector<Node*>>>
+                islands;
+            for (const auto& island : FindQuantIslands(g)) {
+              islands.emplace_back(
+                  island.nodes, island.dequantizes, island.quantizes);
+            }
+            return islands;
+          })
+      .def(
+          "_jit_pass_maximize_quantized_regions",
+          [](std::shared_ptr<Graph>& g, int quant_type_int) {
+            auto quant_type = static_cast<QuantType>(quant_type_int);
+            return MaximizeQuantizedRegions(g, quant_type);
+          },
+          py::arg("graph"),
+          py::arg("quant_type_int") = 1)
       .def("_jit_pass_fold_convbn", &FoldConvBatchNorm)
       .def(
           "_jit_onnx_list_model_parameters",
@@ -315,9 +342,12 @@ void initJITBindings(PyObject* module) {
       .def("_jit_pass_fold_frozen_conv_bn", &FoldFrozenConvBatchnorm)
       .def("_jit_pass_fold_frozen_conv_add_or_sub", &FoldFrozenConvAddOrSub)
       .def("_jit_pass_fold_frozen_conv_mul_or_div", &FoldFrozenConvMulOrDiv)
+      .def("_jit_pass_concat_frozen_linear", &FrozenConcatLinear)
+      .def("_jit_pass_fuse_frozen_batch_norm_relu", &FuseFrozenBatchNormRelu)
       .def("_jit_pass_convert_frozen_ops_to_mkldnn", &ConvertFrozenOpsToMKLDNN)
       .def("_jit_pass_optimize_frozen_graph", &OptimizeFrozenGraph)
       .def("_jit_pass_fuse_linear", &FuseLinear)
+      .def("_jit_pass_fuse_linear_activation", &FuseLinearActivation)
       .def(
           "_jit_pass_fuse_add_relu",
           [](std::shared_ptr<Graph>& graph) { FuseAddRelu(graph); })
@@ -374,6 +404,11 @@ void initJITBindings(PyObject* module) {
             RemoveListMutation(g);
             return RemoveTensorMutation(g);
           })
+      .def(
+          "_jit_pass_functionalize_tensor_mutation",
+          [](std::shared_ptr<Graph>& g) {
+            return FunctionalizeTensorMutation(g);
+          })
       .def(
           "_jit_pass_inline_functional_graphs",
           [](std::shared_ptr<Graph>& g) { return InlineFunctionalGraphs(g); })
@@ -534,6 +569,13 @@ void initJITBindings(PyObject* module) {
             getProfilingMode() = profiling_flag;
             return oldState;
           })
+      .def(
+          "_jit_set_interpreter_superinstructions",
+          [](bool enabled) {
+            bool old_state = getInterpreterSuperinstructions();
+            getInterpreterSuperinstructions() = enabled;
+            return old_state;
+          })
       .def(
           "_jit_set_profiling_executor",
           [](bool profiling_flag) {
@@ -562,6 +604,34 @@ void initJITBindings(PyObject* module) {
             getBailoutDepth() = depth;
             return old_depth;
           })
+      .def(
+          "_jit_set_num_specializations",
+          [](size_t num) {
+            size_t old_num = getNumSpecializations();
+            getNumSpecializations() = num;
+            return old_num;
+          })
+      .def(
+          "_jit_set_memory_planning_enabled",
+          [](bool enabled) {
+            bool old_enabled = getMemoryPlanningEnabled();
+            getMemoryPlanningEnabled() = enabled;
+            return old_enabled;
+          })
+      .def(
+          "_jit_get_profiling_executor_stats",
+          []() {
+            const auto& stats = getProfilingExecutorStats();
+            py::dict result;
+            result["specializations"] = stats.specializations.load();
+            result["specialization_hits"] = stats.specializationHits.load();
+            result["guard_failures"] = stats.guardFailures.load();
+            result["fallback_executions"] = stats.fallbackExecutions.load();
+            return result;
+          })
+      .def(
+          "_jit_reset_profiling_executor_stats",
+          []() { getProfilingExecutorStats().reset(); })
       .def(
           "_jit_set_inline_everything_mode",
           [](bool enabled) { getInlineEverythingMode() = enabled; })
@@ -617,12 +687,76 @@ void initJITBindings(PyObject* module) {
             using namespace torch::jit::tensorexpr;
             return getTECudaPointwiseBlockSize() = block_size;
           })
+      .def(
+          "_jit_get_te_cuda_pointwise_vectorize",
+          []() -> bool {
+            using namespace torch::jit::tensorexpr;
+            return getTECudaPointwiseVectorize();
+          })
+      .def(
+          "_jit_set_te_cuda_pointwise_vectorize",
+          [](bool vectorize) {
+            using namespace torch::jit::tensorexpr;
+            return getTECudaPointwiseVectorize() = vectorize;
+          })
+      .def(
+          "_jit_get_te_cuda_pointwise_autotune",
+          []() -> bool {
+            using namespace torch::jit::tensorexpr;
+            return getTECudaPointwiseAutotune();
+          })
+      .def(
+          "_jit_set_te_cuda_pointwise_autotune",
+          [](bool autotune) {
+            using namespace torch::jit::tensorexpr;
+            return getTECudaPointwiseAutotune() = autotune;
+          })
       .def("_jit_set_texpr_fuser_enabled", &setTensorExprFuserEnabled)
       .def("_jit_texpr_fuser_enabled", &tensorExprFuserEnabled)
       .def("_jit_texpr_fallback_allowed", &tensorexpr::fallbackAllowed)
       .def("_jit_texpr_set_fallback_allowed", &tensorexpr::setFallbackAllowed)
       .def("_jit_set_texpr_reductions_enabled", &setTexprReductionsEnabled)
       .def("_jit_texpr_reductions_enabled", &texprReductionsEnabled)
+      .def(
+          "_jit_set_texpr_external_calls_enabled",
+          &setTexprExternalCallsEnabled)
+      .def("_jit_texpr_external_calls_enabled", &texprExternalCallsEnabled)
+      .def(
+          "_jit_set_texpr_dynamic_shapes_enabled",
+          &setTexprDynamicShapesEnabled)
+      .def("_jit_texpr_dynamic_shapes_enabled", &texprDynamicShapesEnabled)
+      .def(
+          "_jit_get_te_kernel_specialization_cache_size",
+          []() -> int {
+            using namespace torch::jit::tensorexpr;
+            return getTEKernelSpecializationCacheSize();
+          })
+      .def(
+          "_jit_set_te_kernel_specialization_cache_size",
+          [](int cache_size) {
+            using namespace torch::jit::tensorexpr;
+            return getTEKernelSpecializationCacheSize() = cache_size;
+          })
+      .def(
+          "_jit_get_te_kernel_stats",
+          []() {
+            using namespace torch::jit::tensorexpr;
+            const auto& stats = getTEKernelStats();
+            py::dict result;
+            result["compiles"] = stats.compiles.load();
+            result["compile_time_us"] = stats.compileTimeUs.load();
+            result["specialization_hits"] = stats.specializationHits.load();
+            result["specialization_misses"] = stats.specializationMisses.load();
+            result["specialization_evictions"] =
+                stats.specializationEvictions.load();
+            return result;
+          })
+      .def(
+          "_jit_reset_te_kernel_stats",
+          []() {
+            using namespace torch::jit::tensorexpr;
+            getTEKernelStats().reset();
+          })
       .def(
           "_jit_set_te_generate_block_code",
           [](bool gen_block_code) {
@@ -866,6 +1000,8 @@ void initJITBindings(PyObject* module) {
       .def(py::init<std::string>())
       .def(py::init([](const py::object& buffer) {
         auto writer_func = [=](const void* data, size_t size) {
+          // called from the writer thread in async mode
+          py::gil_scoped_acquire acquire;
           auto bytes = py::bytes(reinterpret_cast<const char*>(data), size);
           buffer.attr("write")(std::move(bytes));
           return size;
@@ -873,13 +1009,32 @@ void initJITBindings(PyObject* module) {
         return std::make_unique<PyTorchStreamWriter>(std::move(writer_func));
       }))
       .def(py::init<const std::function<size_t(const void*, size_t)>&>())
+      .def(
+          "enable_async_writes",
+          &PyTorchStreamWriter::enableAsyncWrites,
+          py::arg("max_pending_bytes") =
+              PyTorchStreamWriter::kDefaultMaxPendingBytes)
+      .def(
+          "enable_compression",
+          &PyTorchStreamWriter::enableCompression,
+          py::arg("level") = PyTorchStreamWriter::kDefaultCompressionLevel,
+          py::arg("chunk_size") =
+              PyTorchStreamWriter::kDefaultCompressionChunkSize)
       .def(
           "write_record",
           [](PyTorchStreamWriter& self,
              const std::string& name,
              const char* data,
-             size_t size) { return self.writeRecord(name, data, size); })
-      .def("write_end_of_file", &PyTorchStreamWriter::writeEndOfFile)
+             size_t size) { return self.writeRecord(name, data, size); },
+          py::call_guard<py::gil_scoped_release>())
+      .def(
+          "write_end_of_file",
+          &PyTorchStreamWriter::writeEndOfFile,
+          py::call_guard<py::gil_scoped_release>())
+      .def(
+          "wait_for_writes",
+          &PyTorchStreamWriter::waitForWrites,
+          py::call_guard<py::gil_scoped_release>())
       .def("set_min_version", &PyTorchStreamWriter::setMinVersion)
       .def(
           "write_record",
@@ -889,7 +1044,8 @@ void initJITBindings(PyObject* module) {
              size_t size) {
             return self.writeRecord(
                 name, reinterpret_cast<const char*>(data), size);
-          })
+          },
+          py::call_guard<py::gil_scoped_release>())
       .def("archive_name", &PyTorchStreamWriter::archiveName)
       .def(
           "get_all_written_records",
@@ -75,7 +75,8 @@ std::pair<std::shared_ptr<Graph>, Stack> createGraphByTracing(
     bool strict,
     bool force_outplace,
     Module* self,
-    const std::vector<std::string>& argument_names) {
+    const std::vector<std::string>& argument_names,
+    bool record_debug_info) {
   C10_LOG_API_USAGE_ONCE("torch.tracer");
 
   auto lookup_fn_adapter =
@@ -104,7 +105,8 @@ std::pair<std::shared_ptr<Graph>, Stack> createGraphByTracing(
       strict,
       force_outplace,
       self,
-      argument_names);
+      argument_names,
+      record_debug_info);
   return std::make_pair(std::get<0>(outs)->graph, std::get<1>(outs));
 }
 
@@ -168,9 +170,17 @@ void initPythonTracerBindings(PyObject* module) {
       .def(
           "push_scope",
           [](TracingState& s, const std::string& scope_name) {
-            s.graph->push_scope(scope_name);
+            if (s.record_debug_info) {
+              s.graph->push_scope(scope_name);
+            }
+          })
+      .def(
+          "pop_scope",
+          [](TracingState& s) {
+            if (s.record_debug_info) {
+              s.graph->pop_scope();
+            }
           })
-      .def("pop_scope", [](TracingState& s) { s.graph->pop_scope(); })
       .def(
           "current_scope",
           [](TracingState& s) {
@@ -193,7 +203,8 @@ void initPythonTracerBindings(PyObject* module) {
       py::arg("strict"),
       py::arg("force_outplace"),
       py::arg("self") = nullptr,
-      py::arg("argument_names") = std::vector<std::string>());
+      py::arg("argument_names") = std::vector<std::string>(),
+      py::arg("record_debug_info") = true);
   m.def("_get_tracing_state", []() { return getTracingState(); });
   m.def("_set_tracing_state", [](std::shared_ptr<TracingState> state) {
     return setTracingState(std::move(state));
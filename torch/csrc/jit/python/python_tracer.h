@@ -31,7 +31,8 @@ std::pair<std::shared_ptr<Graph>, Stack> createGraphByTracing(
     bool strict,
     bool force_outplace,
     Module* self = nullptr,
-    const std::vector<std::string>& argument_names = {});
+    const std::vector<std::string>& argument_names = {},
+    bool record_debug_info = true);
 } // namespace tracer
 } // namespace jit
 } // namespace torch
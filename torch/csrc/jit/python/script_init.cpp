@@ -1053,7 +1053,8 @@ void initJitScriptBindings(PyObject* module) {
              const py::function& var_name_lookup_fn,
              bool strict,
              bool force_outplace,
-             const std::vector<std::string>& argument_names) {
+             const std::vector<std::string>& argument_names,
+             bool record_debug_info) {
             // prereq: Module's buffers and parameters are unique
             // this was ensured in python before calling this function
             auto typed_inputs = toTraceableStack(input_tuple);
@@ -1066,7 +1067,8 @@ void initJitScriptBindings(PyObject* module) {
                     strict,
                     force_outplace,
                     &self,
-                    argument_names));
+                    argument_names,
+                    record_debug_info));
             const auto method_name = QualifiedName(*self.type()->name(), name);
             auto fn = self._ivalue()->compilation_unit()->create_function(
                 method_name, graph);
@@ -1079,7 +1081,8 @@ void initJitScriptBindings(PyObject* module) {
           py::arg("var_name_lookup_fn"),
           py::arg("strict"),
           py::arg("force_outplace"),
-          py::arg("argument_names") = std::vector<std::string>())
+          py::arg("argument_names") = std::vector<std::string>(),
+          py::arg("record_debug_info") = true)
       .def(
           "_get_forward_hooks",
           [](const Module& m) {
@@ -1459,7 +1462,8 @@ void initJitScriptBindings(PyObject* module) {
          const py::function& var_name_lookup_fn,
          bool strict,
          bool force_outplace,
-         const std::vector<std::string>& argument_names) {
+         const std::vector<std::string>& argument_names,
+         bool record_debug_info) {
         auto typed_inputs = toTraceableStack(input_tuple);
         std::shared_ptr<Graph> graph = std::get<0>(tracer::createGraphByTracing(
             func,
@@ -1468,7 +1472,8 @@ void initJitScriptBindings(PyObject* module) {
             strict,
             force_outplace,
             /*self=*/nullptr,
-            argument_names));
+            argument_names,
+            record_debug_info));
 
         auto cu = get_python_cu();
         auto name = c10::QualifiedName(qualname);
@@ -1484,7 +1489,8 @@ void initJitScriptBindings(PyObject* module) {
       py::arg("var_name_lookup_fn"),
       py::arg("strict"),
       py::arg("force_outplace"),
-      py::arg("argument_names") = std::vector<std::string>());
+      py::arg("argument_names") = std::vector<std::string>(),
+      py::arg("record_debug_info") = true);
 
   m.def(
       "_jit_script_class_compile",
@@ -1,5 +1,6 @@
 #include <torch/csrc/jit/runtime/graph_executor.h>
 
+#include <ATen/core/Vitals.h>
 #include <ATen/core/ivalue.h>
 #include <c10/util/Exception.h>
 #include <torch/csrc/autograd/grad_mode.h>
@@ -537,7 +538,11 @@ void GraphExecutorImplBase::run(Stack& stack) {
 
   const ExecutionPlan& plan =
       getPlanFor(stack, GraphExecutor::getDefaultNumBailOuts());
-  InterpreterState(plan.code).run(stack);
+  if (plan.memory_plan) {
+    plan.memory_plan->run([&] { InterpreterState(plan.code).run(stack); });
+  } else {
+    InterpreterState(plan.code).run(stack);
+  }
   last_executed_optimized_graph = plan.graph;
 }
 
@@ -641,6 +646,8 @@ struct GraphExecutorImpl : public GraphExecutorImplBase {
   }
 
   ExecutionPlan compileSpec(const ArgumentSpec& spec) {
+    static auto& optimized_graphs = at::vitals::counter("jit.optimized_graphs");
+    optimized_graphs.add();
     auto opt_graph = graph->copy();
     GRAPH_DUMP("Optimizing the following function:", opt_graph);
     arg_spec_creator_.specializeTypes(*opt_graph, spec);
@@ -7,6 +7,7 @@
 #include <torch/csrc/jit/python/update_graph_executor_opt.h>
 #include <torch/csrc/jit/runtime/argument_spec.h>
 #include <torch/csrc/jit/runtime/interpreter.h>
+#include <torch/csrc/jit/runtime/memory_plan.h>
 #include <torch/csrc/jit/runtime/variable_tensor_list.h>
 
 C10_DECLARE_bool(torch_jit_enable_new_executor);
@@ -31,6 +32,9 @@ struct ExecutionPlan {
 
   Code code;
   std::shared_ptr<Graph> graph;
+  // Set for the optimized plans of the profiling executor when memory
+  // planning is enabled
+  std::shared_ptr<MemoryPlan> memory_plan;
 };
 
 // Notice that those structs don't manage lifetime of their members.
@@ -109,6 +113,12 @@ TORCH_API std::atomic<bool>& getProfilingMode();
 TORCH_API std::atomic<bool>& getExecutorMode();
 TORCH_API std::atomic<size_t>& getNumProfiledRuns();
 TORCH_API std::atomic<size_t>& getBailoutDepth();
+// Maximum number of optimized plans the profiling executor keeps per graph,
+// each for a different signature of profiled input types.
+TORCH_API std::atomic<size_t>& getNumSpecializations();
+// Whether the optimized plans of the profiling executor serve the CPU
+// allocations of their runs from a memory plan, see MemoryPlan
+TORCH_API std::atomic<bool>& getMemoryPlanningEnabled();
 TORCH_API bool IsNewExecutorEnabled();
 
 struct TORCH_API GraphOptimizerEnabledGuard {
@@ -17,6 +17,7 @@ namespace jit {
 // T - index into the type table, used for guard instructions
 // S - index into object slots
 // C - index into code table
+// A - index into the operand table, whose entries are LOAD, MOVE or LOADC
 
 #define FORALL_OPCODES(_)                                                      \
   _(OP, "O") /* invoke operator X */                                           \
@@ -54,7 +55,10 @@ namespace jit {
   _(FORK, "CN") /* launch a thread to run code entry x with N inputs  */       \
   _(WARN, "I") /* emit a warning with line information */                      \
   _(ENTER, "EN") /* enter scope of a contextmanager */                         \
-  _(EXIT, "EX") /* exit the last entered contextmanager */
+  _(EXIT, "EX") /* exit the last entered contextmanager */                     \
+  _(LOADS, "AI") /* push the N operands at operand_table[X, X+N) */            \
+  _(OP_STORE, "OR") /* invoke operator X, store its output to register N */    \
+  _(OP_JF, "OP") /* invoke operator X, pop its output, if false branch to N */
 
 enum OpCode : uint8_t {
 #define DEFINE_OP(op, _) op,
@@ -31,6 +31,7 @@ using torch::distributed::autograd::DistAutogradContainer;
 
 #include <exception>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <ostream>
@@ -274,6 +275,15 @@ inline int64_t getDistAutogradContextId() {
   return 0;
 #endif
 }
+
+// Waits for future, running tasks of the inter-op pool meanwhile if called
+// from one of its threads. The future may well be a fork queued behind them,
+// and a pool whose threads all block on their forks would never run it.
+void waitHelpingInterOp(c10::ivalue::Future& future) {
+  while (!future.completed() && at::internal::run_pending_interop_task()) {
+  }
+  future.wait();
+}
 } // namespace
 
 std::ostream& operator<<(std::ostream& out, Instruction inst);
@@ -451,6 +461,8 @@ struct CodeImpl {
   std::vector<Node*> instructions_source_;
 
   std::vector<IValue> constant_table_;
+  // LOAD, MOVE and LOADC instructions, fused into LOADS
+  std::vector<Instruction> operand_table_;
   std::vector<Operation> operator_table_;
   std::vector<Function*> function_table_;
   std::vector<std::unique_ptr<GraphFunction>> forked_functions_;
@@ -494,7 +506,8 @@ struct CodeImpl {
   CodeImpl(
       const std::shared_ptr<Graph>& graph,
       std::string function_name,
-      size_t remaining_bailout_depth)
+      size_t remaining_bailout_depth,
+      bool emit_superinstructions)
       : function_name_(std::move(function_name)),
         preprocess_(*graph),
         current_node_(preprocess_.graph->return_node()),
@@ -514,6 +527,9 @@ struct CodeImpl {
     // we deferred the emission of bailout blocks so they appear at the end
     // emit them now and patch up the jumps
     insertBailoutBlocks();
+    if (emit_superinstructions && getInterpreterSuperinstructions()) {
+      fuseSuperinstructions();
+    }
   }
 
   const std::vector<c10::IValue>& constant_table() const {
@@ -587,6 +603,100 @@ struct CodeImpl {
     truncateInstructions(jf_index + 1);
   }
 
+  // Rewrites instructions_, fusing
+  // * runs of LOAD, MOVE and LOADC into a LOADS of their operands,
+  // * OP followed by STORE into OP_STORE,
+  // * OP followed by JF into OP_JF.
+  // Jump targets always start a new instruction, and jump offsets are
+  // remapped once the new instructions are known.
+  void fuseSuperinstructions() {
+    const size_t n = instructions_.size();
+    auto isJump = [](OpCode op) {
+      return op == JF || op == JMP || op == LOOP;
+    };
+    auto jumpTarget = [&](size_t i) -> size_t {
+      return static_cast<int64_t>(i) + instructions_[i].X;
+    };
+    auto isOperand = [](OpCode op) {
+      return op == LOAD || op == MOVE || op == LOADC;
+    };
+    auto fitsN = [](int64_t v) {
+      return v >= 0 && v <= std::numeric_limits<uint16_t>::max();
+    };
+
+    std::vector<bool> is_target(n + 1, false);
+    for (size_t i = 0; i < n; ++i) {
+      if (isJump(instructions_[i].op)) {
+        is_target[jumpTarget(i)] = true;
+      }
+    }
+    auto fusable = [&](size_t i, OpCode op) {
+      return i < n && !is_target[i] && instructions_[i].op == op;
+    };
+
+    std::vector<Instruction> instructions;
+    std::vector<Node*> instructions_source;
+    // index of each old instruction in the new ones
+    std::vector<size_t> new_index(n + 1);
+    // (new index, old index) of the instructions whose jump is remapped
+    std::vector<std::pair<size_t, size_t>> jumps;
+    for (size_t i = 0; i < n;) {
+      const Instruction& inst = instructions_[i];
+      size_t length = 1;
+      if (isOperand(inst.op)) {
+        while (i + length < n && !is_target[i + length] &&
+               isOperand(instructions_[i + length].op) &&
+               length < std::numeric_limits<uint16_t>::max()) {
+          ++length;
+        }
+        if (length > 1) {
+          instructions.emplace_back(LOADS, operand_table_.size(), length);
+          operand_table_.insert(
+              operand_table_.end(),
+              instructions_.begin() + i,
+              instructions_.begin() + i + length);
+        }
+      } else if (
+          inst.op == OP && fusable(i + 1, STORE) &&
+          fitsN(instructions_[i + 1].X)) {
+        instructions.emplace_back(OP_STORE, inst.X, instructions_[i + 1].X);
+        length = 2;
+      } else if (
+          inst.op == OP && fusable(i + 1, JF) &&
+          fitsN(instructions_[i + 1].X + 1)) {
+        jumps.emplace_back(instructions.size(), i + 1);
+        instructions.emplace_back(OP_JF, inst.X, 0);
+        length = 2;
+      }
+      if (length == 1) {
+        if (isJump(inst.op)) {
+          jumps.emplace_back(instructions.size(), i);
+        }
+        instructions.push_back(inst);
+      }
+      instructions_source.push_back(instructions_source_[i]);
+      for (size_t k = 0; k < length; ++k) {
+        new_index[i + k] = instructions.size() - 1;
+      }
+      i += length;
+    }
+    new_index[n] = instructions.size();
+
+    for (const auto& jump : jumps) {
+      Instruction& inst = instructions[jump.first];
+      int64_t offset =
+          static_cast<int64_t>(new_index[jumpTarget(jump.second)]) -
+          static_cast<int64_t>(jump.first);
+      if (inst.op == OP_JF) {
+        inst.N = static_cast<uint16_t>(offset);
+      } else {
+        inst.X = offset;
+      }
+    }
+    instructions_ = std::move(instructions);
+    instructions_source_ = std::move(instructions_source);
+  }
+
   int allocRegs(at::ArrayRef<Value*> vs) {
     int result = register_size_ + 1;
     for (Value* v : vs) {
@@ -1033,7 +1143,8 @@ struct CodeImpl {
   void dump(std::ostream& out, size_t i) const {
     out << i << " " << instructions_[i];
     if (instructions_[i].op == OP || instructions_[i].op == CALL ||
-        instructions_[i].op == OPN) {
+        instructions_[i].op == OPN || instructions_[i].op == OP_STORE ||
+        instructions_[i].op == OP_JF) {
       out << " # " << *instructions_source_[i];
     } else {
       out << "\n";
@@ -1258,6 +1369,30 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
             stack.emplace_back(frame.function->constant_table_[inst.X]);
             ++frame.pc;
             break;
+          case LOADS: {
+            const Instruction* operand =
+                &frame.function->operand_table_[inst.X];
+            for (size_t i = 0; i < inst.N; ++i, ++operand) {
+              if (operand->op == LOAD) {
+                stack.emplace_back(reg(operand->X));
+              } else if (operand->op == MOVE) {
+                stack.emplace_back(std::move(reg(operand->X)));
+              } else {
+                stack.emplace_back(
+                    frame.function->constant_table_[operand->X]);
+              }
+            }
+            ++frame.pc;
+          } break;
+          case OP_STORE:
+            frame.function->operator_table_[inst.X](&stack);
+            reg(inst.N) = pop(stack);
+            ++frame.pc;
+            break;
+          case OP_JF:
+            frame.function->operator_table_[inst.X](&stack);
+            frame.pc += (pop(stack).toBool()) ? 1 : inst.N;
+            break;
           case GET_ATTR: {
             auto userObj = pop(stack).toObject();
             auto value = userObj->getSlot(inst.X);
@@ -1347,6 +1482,11 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
             return false;
           case WAIT: {
             auto future = stack.back().toFuture();
+            if (!future->completed() && !future_) {
+              // A synchronous run blocks on its result anyway, so it waits
+              // here rather than suspending and resuming on another thread
+              waitHelpingInterOp(*future);
+            }
             if (!future->completed()) {
               getOrCreateFuture();
 
@@ -1683,7 +1823,7 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
 
   void run(Stack& stack) {
     if (runImpl(stack)) {
-      future_->wait();
+      waitHelpingInterOp(*future_);
 
       auto num_outputs = frames.front().function->n_outputs;
       if (num_outputs == 1) {
@@ -1715,14 +1855,23 @@ std::ostream& operator<<(std::ostream& out, const Code& code) {
   return out;
 }
 
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+static std::atomic<bool> interpreter_superinstructions{true};
+
+std::atomic<bool>& getInterpreterSuperinstructions() {
+  return interpreter_superinstructions;
+}
+
 Code::Code(
     const std::shared_ptr<Graph>& graph,
     std::string function_name,
-    size_t remaining_bailout_depth)
+    size_t remaining_bailout_depth,
+    bool emit_superinstructions)
     : pImpl(new CodeImpl(
           graph,
           std::move(function_name),
-          remaining_bailout_depth)) {}
+          remaining_bailout_depth,
+          emit_superinstructions)) {}
 Code::~Code() = default;
 
 const std::vector<GraphExecutor*>& Code::grad_executors() {
@@ -1,5 +1,6 @@
 #pragma once
 #include <c10/util/Optional.h>
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -43,10 +44,14 @@ struct TORCH_API Code {
   // remaining_bailout_depth is irrelevant in a `Code` object unless the `Code`
   // is directly created by `GraphExecutor` in which case it's likely to contain
   // `prim::BailOut`s to control the maximum depth of bailout chains
+  // emit_superinstructions allows fusing common instruction sequences, see
+  // getInterpreterSuperinstructions(). Code whose instructions are exported
+  // for the lite interpreter, which doesn't implement them, must disable it.
   explicit Code(
       const std::shared_ptr<Graph>& graph,
       std::string function_name,
-      size_t remaining_bailout_depth = 0);
+      size_t remaining_bailout_depth = 0,
+      bool emit_superinstructions = true);
   ~Code();
 
   const std::vector<GraphExecutor*>& grad_executors();
@@ -71,6 +76,10 @@ struct TORCH_API Code {
   friend std::ostream& operator<<(std::ostream& out, const Code& code);
 };
 
+// Whether Code fuses LOAD/MOVE/LOADC runs and OP followed by STORE or JF into
+// superinstructions, which saves a dispatch per fused instruction.
+TORCH_API std::atomic<bool>& getInterpreterSuperinstructions();
+
 struct InterpreterState {
   TORCH_API InterpreterState(
       const Code& code,
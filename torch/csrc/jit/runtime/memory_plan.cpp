@@ -0,0 +1,122 @@
+#include <torch/csrc/jit/runtime/memory_plan.h>
+
+#include <ATen/Context.h>
+#include <torch/csrc/jit/jit_log.h>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// Number of plans that don't match later runs after which a graph gives up
+constexpr size_t kMaxFailedPlans = 3;
+
+bool canPlan() {
+  // Runs nested in a planned one are part of its plan
+  if (c10::GetThreadLocalAllocationPlanner() != nullptr ||
+      c10::GetThreadLocalProfilingAllocator() != nullptr) {
+    return false;
+  }
+  // MKLDNN allocates through Allocator::raw_allocate, which needs the
+  // context of a DataPtr to be its data, unlike the DataPtrs of the blob
+  return !at::hasMKLDNN() || !at::globalContext().userEnabledMkldnn();
+}
+
+} // namespace
+
+bool MemoryPlan::active() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return state_ == State::Active;
+}
+
+void MemoryPlan::replan() {
+  if (++num_failed_plans_ < kMaxFailedPlans) {
+    GRAPH_DEBUG("Memory plan doesn't match, planning again");
+    state_ = State::Profiling;
+  } else {
+    GRAPH_DEBUG("Memory plan doesn't match, disabling memory planning");
+    state_ = State::Disabled;
+    allocators_.clear();
+  }
+  plan_.reset();
+}
+
+void MemoryPlan::run(const std::function<void()>& fn) {
+  if (!canPlan()) {
+    fn();
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (state_ == State::Active) {
+    auto plan = plan_;
+    std::unique_ptr<c10::CPUProfilingAllocator> allocator;
+    if (allocators_.empty()) {
+      allocator = std::make_unique<c10::CPUProfilingAllocator>();
+      allocator->set_fallback_on_mismatch(true);
+    } else {
+      allocator = std::move(allocators_.back());
+      allocators_.pop_back();
+    }
+    lock.unlock();
+
+    bool mismatched = false;
+    try {
+      c10::WithProfilingAllocatorGuard guard(allocator.get(), plan.get());
+      fn();
+      mismatched = allocator->mismatched();
+    } catch (...) {
+      lock.lock();
+      allocators_.push_back(std::move(allocator));
+      throw;
+    }
+    lock.lock();
+    if (state_ != State::Disabled) {
+      allocators_.push_back(std::move(allocator));
+    }
+    // Concurrent runs may have found the mismatch already
+    if (mismatched && plan == plan_) {
+      replan();
+    }
+    return;
+  }
+  if (state_ == State::Disabled || busy_) {
+    lock.unlock();
+    fn();
+    return;
+  }
+
+  busy_ = true;
+  const bool validating = state_ == State::Validating;
+  auto plan = validating ? plan_ : std::make_shared<c10::AllocationPlan>();
+  lock.unlock();
+
+  bool success = true;
+  try {
+    if (validating) {
+      c10::WithValidateAllocationPlanGuard guard(plan.get(), &success);
+      fn();
+    } else {
+      c10::WithProfileAllocationsGuard guard(plan.get());
+      fn();
+    }
+  } catch (...) {
+    // The next run starts over in the same state
+    lock.lock();
+    busy_ = false;
+    throw;
+  }
+
+  lock.lock();
+  busy_ = false;
+  if (!validating) {
+    plan_ = std::move(plan);
+    state_ = State::Validating;
+  } else if (success) {
+    state_ = State::Active;
+  } else {
+    replan();
+  }
+}
+
+} // namespace jit
+} // namespace torch
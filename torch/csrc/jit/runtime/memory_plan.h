@@ -0,0 +1,48 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <c10/mobile/CPUProfilingAllocator.h>
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+namespace torch {
+namespace jit {
+
+// Plans the CPU memory of the tensors a graph allocates and frees within one
+// run. The first run records the size and lifetime of each allocation and
+// lays them out in a single blob, the next one checks that they are the
+// same, and from then on runs take their memory from the blob of a pooled
+// allocator instead of the system allocator. A run whose allocations differ
+// from the plan, e.g. for inputs of another shape, falls back to the system
+// allocator from the first difference on and makes the graph plan again,
+// until it has failed too often to keep trying.
+//
+// Only allocations made on the calling thread are planned. Runs nested in
+// another planned run, e.g. of called functions, are not planned on their
+// own.
+class TORCH_API MemoryPlan {
+ public:
+  void run(const std::function<void()>& fn);
+  // Whether runs use the blob
+  bool active() const;
+
+ private:
+  enum class State { Profiling, Validating, Active, Disabled };
+
+  void replan();
+
+  mutable std::mutex mutex_;
+  State state_{State::Profiling};
+  // Whether a profiling or validating run is in progress. Runs made
+  // concurrently with it are not planned.
+  bool busy_{false};
+  size_t num_failed_plans_{0};
+  std::shared_ptr<c10::AllocationPlan> plan_;
+  std::vector<std::unique_ptr<c10::CPUProfilingAllocator>> allocators_;
+};
+
+} // namespace jit
+} // namespace torch
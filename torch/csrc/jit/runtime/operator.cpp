@@ -14,13 +14,18 @@ namespace jit {
 namespace {
 using OperatorMap =
     std::unordered_map<Symbol, std::vector<std::shared_ptr<Operator>>>;
+void checkSpecialCases(const Operator& op);
+
 struct OperatorRegistry {
  private:
   std::mutex lock;
   OperatorMap operators;
-  // list of operators whose schema have not yet been parsed, and must
-  // be registered before any call to lookup an operator
-  std::vector<std::shared_ptr<Operator>> to_register;
+  // operators whose schema have not yet been parsed, by qualified name. They
+  // are moved to the maps below the first time an operator of their name is
+  // looked up, so that startup does not pay for parsing the schemas of all
+  // the registered operators, and the first lookup only for those of one name.
+  std::unordered_map<std::string, std::vector<std::shared_ptr<Operator>>>
+      to_register;
   // Those two maps are used to implement lookupByLiteral, which is needed for
   // the n->match(...) calls. Basically, every function schema is assigned a
   // unique string you can use to match it. However, parsing those strings or
@@ -44,13 +49,34 @@ struct OperatorRegistry {
 #endif
 
   // XXX - caller must be holding lock
-  void registerPendingOperators() {
-    for (const auto& op : to_register) {
+  void registerPendingOperators(
+      std::vector<std::shared_ptr<Operator>>&& pending) {
+    for (const auto& op : pending) {
+      checkSpecialCases(*op);
       Symbol sym = Symbol::fromQualString(op->schema().name());
       operators[sym].push_back(op);
       operators_by_sig[canonicalSchemaString(op->schema())] = op;
     }
+  }
+
+  // XXX - caller must be holding lock
+  void registerPendingOperators(const std::string& name) {
+    auto it = to_register.find(name);
+    if (it == to_register.end()) {
+      return;
+    }
+    auto pending = std::move(it->second);
+    to_register.erase(it);
+    registerPendingOperators(std::move(pending));
+  }
+
+  // XXX - caller must be holding lock
+  void registerAllPendingOperators() {
+    auto pending = std::move(to_register);
     to_register.clear();
+    for (auto& kv : pending) {
+      registerPendingOperators(std::move(kv.second));
+    }
   }
 
  public:
@@ -64,7 +90,8 @@ struct OperatorRegistry {
         "\" to JIT but the operator name was already registered before. Please add or change the overload name.");
     registered_operator_names.insert(op.schema().operator_name());
 #endif
-    to_register.push_back(std::make_shared<Operator>(std::move(op)));
+    auto name = op.qualifiedName();
+    to_register[name].push_back(std::make_shared<Operator>(std::move(op)));
   }
 
   void deregisterOperator(const FunctionSchema& schema) {
@@ -81,13 +108,20 @@ struct OperatorRegistry {
     registered_operator_names.erase(schema.operator_name());
 #endif
     // Try removing from pending operators list first
-    auto pending_it = to_register.begin();
-    while (pending_it != to_register.end() && (*pending_it)->schema() != schema)
-      ++pending_it;
-
-    if (pending_it != to_register.end()) {
-      to_register.erase(pending_it);
-      return;
+    auto pending_list_it = to_register.find(schema.name());
+    if (pending_list_it != to_register.end()) {
+      auto& pending = pending_list_it->second;
+      auto pending_it = pending.begin();
+      while (pending_it != pending.end() && (*pending_it)->schema() != schema)
+        ++pending_it;
+
+      if (pending_it != pending.end()) {
+        pending.erase(pending_it);
+        if (pending.empty()) {
+          to_register.erase(pending_list_it);
+        }
+        return;
+      }
     }
 
     // Remove operator from signature map
@@ -120,14 +154,15 @@ struct OperatorRegistry {
 
   const std::shared_ptr<Operator>& lookupByLiteral(const char* name) {
     std::lock_guard<std::mutex> guard(lock);
-    registerPendingOperators();
     auto it = operators_by_sig_literal.find(name);
     if (it == operators_by_sig_literal.end()) {
-      auto op_ptr_it =
-          operators_by_sig.find(canonicalSchemaString(parseSchema(name)));
+      auto schema = parseSchema(name);
+      registerPendingOperators(schema.name());
+      auto op_ptr_it = operators_by_sig.find(canonicalSchemaString(schema));
       // Handy debugging code that dumps all operators we know about on mismatch
 #if 0
       if (op_ptr_it == operators_by_sig.end()) {
+        registerAllPendingOperators();
         for (auto & entry : operators_by_sig) {
           std::cout << entry.first << std::endl;
         }
@@ -145,7 +180,7 @@ struct OperatorRegistry {
 
   const std::vector<std::shared_ptr<Operator>>& getOperators(Symbol name) {
     std::lock_guard<std::mutex> guard(lock);
-    registerPendingOperators();
+    registerPendingOperators(name.toQualString());
     static std::vector<std::shared_ptr<Operator>> empty;
     auto it = operators.find(name);
     if (it != operators.end())
@@ -155,7 +190,7 @@ struct OperatorRegistry {
 
   std::vector<Symbol> findSimilarOperators(Symbol input_op) {
     std::lock_guard<std::mutex> guard(lock);
-    registerPendingOperators();
+    registerAllPendingOperators();
 
     using EntryPair = std::pair<int64_t, Symbol>;
     auto cmp = [](const EntryPair& lhs, const EntryPair& rhs) {
@@ -182,7 +217,7 @@ struct OperatorRegistry {
 
   const std::vector<std::shared_ptr<Operator>> getAllOperators() {
     std::lock_guard<std::mutex> guard(lock);
-    registerPendingOperators();
+    registerAllPendingOperators();
     std::vector<std::shared_ptr<Operator>> values;
     values.clear();
     for (auto& kv : operators) {
@@ -267,6 +302,36 @@ bool printerHasSpecialCaseFor(Symbol sym) {
       !required_namespaces.count(sym.ns());
 }
 
+// Checked when the schema of the operator gets parsed, on the first lookup of
+// its name, rather than when it is registered.
+void checkSpecialCases(const Operator& op) {
+  if (op.schema().is_varret()) {
+    Symbol s = Symbol::fromQualString(op.schema().name());
+    if (!printerHasSpecialCaseFor(s)) {
+      AT_ERROR(
+          "Missing special case in python printer for non-schematized"
+          " operator ",
+          op.schema().name(),
+          ". File a bug to add a case for this operator.\n");
+    }
+    if (!aliasAnalysisHasSpecialCaseFor(s) &&
+        op.aliasAnalysisKind() == AliasAnalysisKind::CONSERVATIVE) {
+      AT_ERROR(
+          "Missing special case in alias analysis for non-schematized"
+          " operator ",
+          op.schema().name(),
+          ". File a bug to add a case for this operator.\n");
+    }
+    if (aliasAnalysisHasSpecialCaseFor(s) &&
+        op.aliasAnalysisKind() == AliasAnalysisKind::FROM_SCHEMA) {
+      AT_ERROR(
+          "The operator ",
+          op.schema().name(),
+          " is special cased and cannot use explicit alias analysis.");
+    }
+  }
+}
+
 } // anonymous namespace
 
 bool aliasAnalysisHasSpecialCaseFor(Symbol symbol) {
@@ -343,31 +408,6 @@ bool aliasAnalysisHasSpecialCaseFor(Symbol symbol) {
 }
 
 void registerOperator(Operator&& op) {
-  if (op.schema().is_varret()) {
-    Symbol s = Symbol::fromQualString(op.schema().name());
-    if (!printerHasSpecialCaseFor(s)) {
-      AT_ERROR(
-          "Missing special case in python printer for non-schematized"
-          " operator ",
-          op.schema().name(),
-          ". File a bug to add a case for this operator.\n");
-    }
-    if (!aliasAnalysisHasSpecialCaseFor(s) &&
-        op.aliasAnalysisKind() == AliasAnalysisKind::CONSERVATIVE) {
-      AT_ERROR(
-          "Missing special case in alias analysis for non-schematized"
-          " operator ",
-          op.schema().name(),
-          ". File a bug to add a case for this operator.\n");
-    }
-    if (aliasAnalysisHasSpecialCaseFor(s) &&
-        op.aliasAnalysisKind() == AliasAnalysisKind::FROM_SCHEMA) {
-      AT_ERROR(
-          "The operator ",
-          op.schema().name(),
-          " is special cased and cannot use explicit alias analysis.");
-    }
-  }
   getRegistry().registerOperator(std::move(op));
 }
 
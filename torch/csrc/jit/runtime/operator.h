@@ -141,6 +141,24 @@ struct TORCH_API Operator {
         });
   }
 
+  // The qualified name of the operator without the overload name, e.g.
+  // "aten::add". Unlike schema().name(), this does not parse a schema that
+  // was given as a string, so that the registry can group operators by name
+  // and parse only the schemas of the names that are looked up.
+  std::string qualifiedName() const {
+    return op_.fold<std::string>(
+        [](const C10Operator& op) { return op.handle_.operator_name().name; },
+        [](const JitOnlyOperator& op) {
+          if (op.schema_.is_left()) {
+            return op.schema_.left().name();
+          }
+          const auto& schema_string = op.schema_.right().schema_string_;
+          const auto begin = schema_string.find_first_not_of(" \t\n");
+          const auto end = schema_string.find_first_of(".( \t\n", begin);
+          return schema_string.substr(begin, end - begin);
+        });
+  }
+
   bool isC10Op() const {
     return op_.is_left();
   }
@@ -1,5 +1,7 @@
 #include <torch/csrc/jit/runtime/profiling_graph_executor_impl.h>
 
+#include <ATen/core/Vitals.h>
+
 #include <torch/csrc/jit/jit_log.h>
 #include <torch/csrc/jit/passes/bailout_graph.h>
 #include <torch/csrc/jit/passes/batch_mm.h>
@@ -47,6 +49,7 @@ C10_DEFINE_bool(
 
 constexpr size_t kDefaultNumProfiledRuns = 1;
 constexpr size_t kDefaultBailoutDepth = 20;
+constexpr size_t kDefaultNumSpecializations = 1;
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 C10_DEFINE_int64(
@@ -58,6 +61,17 @@ C10_DEFINE_int64(
     torch_jit_bailout_depth,
     kDefaultBailoutDepth,
     "Number of re-specializations");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+C10_DEFINE_int64(
+    torch_jit_num_specializations,
+    kDefaultNumSpecializations,
+    "Number of optimized plans kept per graph for different input types");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+C10_DEFINE_bool(
+    torch_jit_enable_memory_planning,
+    false,
+    "Plan the CPU memory of the runs of optimized graphs from their first "
+    "runs. Only takes effect while MKLDNN is disabled");
 
 namespace torch {
 namespace jit {
@@ -78,6 +92,10 @@ static std::atomic<bool> profiling_mode{true};
 static std::atomic<size_t> num_profiled_runs{kDefaultNumProfiledRuns};
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 static std::atomic<size_t> bailout_depth{kDefaultBailoutDepth};
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+static std::atomic<size_t> num_specializations{kDefaultNumSpecializations};
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+static std::atomic<bool> memory_planning_enabled{false};
 
 std::atomic<bool>& getProfilingMode() {
   return profiling_mode;
@@ -105,6 +123,81 @@ std::atomic<size_t>& getBailoutDepth() {
   return bailout_depth;
 }
 
+std::atomic<size_t>& getNumSpecializations() {
+  // Initialize num_specializations from command-line flag.
+  static const size_t init = []() {
+    return num_specializations = FLAGS_torch_jit_num_specializations;
+  }();
+  (void)init; // Silence clang-tidy.
+  return num_specializations;
+}
+
+std::atomic<bool>& getMemoryPlanningEnabled() {
+  // Initialize memory_planning_enabled from command-line flag.
+  static const bool init = []() {
+    return memory_planning_enabled = FLAGS_torch_jit_enable_memory_planning;
+  }();
+  (void)init; // Silence clang-tidy.
+  return memory_planning_enabled;
+}
+
+void ProfilingExecutorStats::reset() {
+  specializations = 0;
+  specializationHits = 0;
+  guardFailures = 0;
+  fallbackExecutions = 0;
+}
+
+ProfilingExecutorStats& getProfilingExecutorStats() {
+  static ProfilingExecutorStats stats;
+  return stats;
+}
+
+// Returns the types profiled for the inputs of a profiled graph, with nullptr
+// for inputs that weren't profiled as tensors. Returns an empty vector if
+// there is no such input, in which case the graph isn't specialized.
+static std::vector<TensorTypePtr> profiledInputTypes(
+    const std::shared_ptr<Graph>& graph) {
+  std::vector<TensorTypePtr> types;
+  bool any_profiled = false;
+  for (Value* input : graph->inputs()) {
+    TensorTypePtr type;
+    // only top-level uses are guaranteed to have run while profiling
+    for (const Use& use : input->uses()) {
+      if (use.user->kind() == prim::profile &&
+          use.user->owningBlock() == graph->block() &&
+          use.user->hasAttribute(attr::profiled_type)) {
+        type = use.user->ty(attr::profiled_type)->cast<TensorType>();
+        break;
+      }
+    }
+    any_profiled |= type != nullptr;
+    types.push_back(std::move(type));
+  }
+  if (!any_profiled) {
+    types.clear();
+  }
+  return types;
+}
+
+static bool matchesProfiledInputTypes(
+    const std::vector<TensorTypePtr>& types,
+    const Stack& stack) {
+  if (stack.size() < types.size()) {
+    return false;
+  }
+  auto inputs = last(stack, types.size());
+  for (size_t i = 0; i < types.size(); i++) {
+    if (!types[i]) {
+      continue;
+    }
+    if (!inputs[i].isTensor() || !types[i]->matchTensor(inputs[i].toTensor())) {
+      return false;
+    }
+  }
+  return true;
+}
+
 static bool needsGradientInProfilingMode(Block* b) {
   for (auto n : b->nodes()) {
     if (n->kind() == prim::BailOut) {
@@ -553,7 +646,41 @@ void ProfilingGraphExecutorImpl::runProfilingInsensitiveOptimizations(
 ProfilingGraphExecutorImpl::ProfilingGraphExecutorImpl(
     const std::shared_ptr<Graph>& graph,
     std::string function_name)
-    : GraphExecutorImplBase(graph, std::move(function_name)) {}
+    : GraphExecutorImplBase(graph, std::move(function_name)),
+      is_fallback_(function_name_ == "fallback_function") {}
+
+std::unique_ptr<ProfilingRecord> ProfilingGraphExecutorImpl::
+    createProfilingRecord() {
+  auto copy = graph->copy();
+  runProfilingInsensitiveOptimizations(copy);
+  auto pr = ProfilingRecord::instrumentGraph(copy);
+  // `InsertProfileNodesForSpecializeAutogradZero` profiles a definition vs a
+  // use and it doesn't expect any profile nodes between a graph input and its
+  // consumer, `aten::_grad_sum_to_size`. This means we need to run it first,
+  // before any other pass that could insert `prim::iprofile_value` node on
+  // `aten::_grad_sum_to_size` input.
+  InsertProfileNodesForSpecializeAutogradZero(pr.get());
+  GRAPH_DUMP("Profiled Graph: ", pr->graph());
+  return pr;
+}
+
+ExecutionPlan ProfilingGraphExecutorImpl::createOptimizedPlan(
+    ProfilingRecord& pr) {
+  static auto& optimized_graphs = at::vitals::counter("jit.optimized_graphs");
+  optimized_graphs.add();
+  auto copy = pr.graph()->copy();
+  ProfilingRecord::removeProfileCounter(copy->block());
+  runProfilingOptimizations(copy);
+  // replaces a fallback graph inserted by
+  // specialize_autogradzero if one exists
+  replaceFallbackGraphWithFallbackFunction(copy->block());
+  GRAPH_DUMP("Optimized Graph: ", copy);
+  ExecutionPlan plan(copy, function_name_, *remaining_bailout_depth_);
+  if (getMemoryPlanningEnabled()) {
+    plan.memory_plan = std::make_shared<MemoryPlan>();
+  }
+  return plan;
+}
 
 const ExecutionPlan& ProfilingGraphExecutorImpl::getOptimizedPlanFor(
     Stack& stack,
@@ -595,16 +722,7 @@ const ExecutionPlan& ProfilingGraphExecutorImpl::getOptimizedPlanFor(
 
   // if a profiling graph hasn't been created yet
   if (!pr_) {
-    auto copy = graph->copy();
-    runProfilingInsensitiveOptimizations(copy);
-    pr_ = ProfilingRecord::instrumentGraph(copy);
-    // `InsertProfileNodesForSpecializeAutogradZero` profiles a definition vs a
-    // use and it doesn't expect any profile nodes between a graph input and its
-    // consumer, `aten::_grad_sum_to_size`. This means we need to run it first,
-    // before any other pass that could insert `prim::iprofile_value` node on
-    // `aten::_grad_sum_to_size` input.
-    InsertProfileNodesForSpecializeAutogradZero(pr_.get());
-    GRAPH_DUMP("Profiled Graph: ", pr_->graph());
+    pr_ = createProfilingRecord();
     profiling_plan_ = ExecutionPlan(pr_->graph(), function_name_);
     // fall-through
   }
@@ -614,15 +732,48 @@ const ExecutionPlan& ProfilingGraphExecutorImpl::getOptimizedPlanFor(
     return *profiling_plan_;
   }
 
-  auto copy = pr_->graph()->copy();
-  ProfilingRecord::removeProfileCounter(copy->block());
-  runProfilingOptimizations(copy);
-  // replaces a fallback graph inserted by
-  // specialize_autogradzero if one exists
-  replaceFallbackGraphWithFallbackFunction(copy->block());
-  GRAPH_DUMP("Optimized Graph: ", copy);
-  optimized_plan_ =
-      ExecutionPlan(copy, function_name_, *remaining_bailout_depth_);
+  if (getNumSpecializations() > 1) {
+    specialized_types_ = profiledInputTypes(pr_->graph());
+  }
+  optimized_plan_ = createOptimizedPlan(*pr_);
+  return *optimized_plan_;
+}
+
+const ExecutionPlan& ProfilingGraphExecutorImpl::getSpecializedPlanFor(
+    Stack& stack) {
+  for (auto& specialization : specializations_) {
+    if (specialization.optimized_plan &&
+        matchesProfiledInputTypes(specialization.input_types, stack)) {
+      getProfilingExecutorStats().specializationHits++;
+      return *specialization.optimized_plan;
+    }
+  }
+  getProfilingExecutorStats().guardFailures++;
+
+  // finish the specialization that is being profiled, if any
+  if (!specializations_.empty() && !specializations_.back().optimized_plan) {
+    auto& specialization = specializations_.back();
+    if (!specialization.pr->ready()) {
+      return *specialization.profiling_plan;
+    }
+    specialization.input_types =
+        profiledInputTypes(specialization.pr->graph());
+    specialization.optimized_plan = createOptimizedPlan(*specialization.pr);
+    getProfilingExecutorStats().specializations++;
+    return *specialization.optimized_plan;
+  }
+
+  if (specializations_.size() + 1 < getNumSpecializations()) {
+    specializations_.emplace_back();
+    auto& specialization = specializations_.back();
+    specialization.pr = createProfilingRecord();
+    specialization.profiling_plan =
+        ExecutionPlan(specialization.pr->graph(), function_name_);
+    return *specialization.profiling_plan;
+  }
+
+  // out of specializations, the guards of the first optimized plan send the
+  // inputs it wasn't specialized for down its fallback paths
   return *optimized_plan_;
 }
 
@@ -631,10 +782,20 @@ const ExecutionPlan& ProfilingGraphExecutorImpl::getPlanFor(
     size_t remaining_bailout_depth) {
   std::lock_guard<std::mutex> lock(compile_mutex);
 
+  // the first call is made when the fallback function is created, rather
+  // than when it is run, and is the one that sets remaining_bailout_depth_
+  if (is_fallback_ && remaining_bailout_depth_) {
+    getProfilingExecutorStats().fallbackExecutions++;
+  }
+
   // IMPORTANT: This is a hot path of calling a torchscript function. Try not to
   // add any code above this.
   if (optimized_plan_) {
-    return *optimized_plan_;
+    if (specialized_types_.empty() ||
+        matchesProfiledInputTypes(specialized_types_, stack)) {
+      return *optimized_plan_;
+    }
+    return getSpecializedPlanFor(stack);
   }
 
   return getOptimizedPlanFor(stack, remaining_bailout_depth);
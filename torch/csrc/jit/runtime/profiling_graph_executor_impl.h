@@ -1,9 +1,28 @@
 #pragma once
 #include <torch/csrc/jit/runtime/graph_executor_impl.h>
 
+#include <list>
+
 namespace torch {
 namespace jit {
 
+// Counters of the profiling executor, aggregated over all executors.
+struct TORCH_API ProfilingExecutorStats {
+  // Optimized plans compiled for additional input type signatures.
+  std::atomic<uint64_t> specializations{0};
+  // Runs served by one of those additional plans.
+  std::atomic<uint64_t> specializationHits{0};
+  // Runs whose inputs matched the profiled types of no optimized plan.
+  std::atomic<uint64_t> guardFailures{0};
+  // Runs of fallback functions, i.e. of the unoptimized paths taken when the
+  // guards inside an optimized graph fail.
+  std::atomic<uint64_t> fallbackExecutions{0};
+
+  void reset();
+};
+
+TORCH_API ProfilingExecutorStats& getProfilingExecutorStats();
+
 struct ProfilingGraphExecutorImpl : public GraphExecutorImplBase {
   ProfilingGraphExecutorImpl(
       const std::shared_ptr<Graph>& graph,
@@ -20,6 +39,8 @@ struct ProfilingGraphExecutorImpl : public GraphExecutorImplBase {
     fallback_plan_.reset();
     profiling_plan_.reset();
     optimized_plan_.reset();
+    specialized_types_.clear();
+    specializations_.clear();
     // prevent memory leaks
     fallback_functions_.clear();
     remaining_bailout_depth_.reset();
@@ -29,6 +50,9 @@ struct ProfilingGraphExecutorImpl : public GraphExecutorImplBase {
   const ExecutionPlan& getOptimizedPlanFor(
       Stack& stack,
       size_t remaining_bailout_depth);
+  const ExecutionPlan& getSpecializedPlanFor(Stack& stack);
+  std::unique_ptr<ProfilingRecord> createProfilingRecord();
+  ExecutionPlan createOptimizedPlan(ProfilingRecord& pr);
   void runProfilingInsensitiveOptimizations(std::shared_ptr<Graph>& graph);
   void runProfilingOptimizations(std::shared_ptr<Graph>& graph);
   void replaceFallbackGraphWithFallbackFunction(Block* b);
@@ -36,6 +60,21 @@ struct ProfilingGraphExecutorImpl : public GraphExecutorImplBase {
   c10::optional<ExecutionPlan>
       profiling_plan_; // plan to run in order to profiling the code
   c10::optional<ExecutionPlan> optimized_plan_;
+  // the input types optimized_plan_ was profiled with. It is only filled in
+  // when getNumSpecializations() > 1, inputs that don't match them are then
+  // served by specializations_
+  std::vector<TensorTypePtr> specialized_types_;
+  // additional plans, each profiled and optimized for input types that
+  // didn't match any of the previous ones. Plans are handed out by
+  // reference, so entries are never evicted, and at most
+  // getNumSpecializations() - 1 are created
+  struct Specialization {
+    std::unique_ptr<ProfilingRecord> pr;
+    c10::optional<ExecutionPlan> profiling_plan;
+    c10::optional<ExecutionPlan> optimized_plan;
+    std::vector<TensorTypePtr> input_types;
+  };
+  std::list<Specialization> specializations_;
   // this plan is used if getGraphExecutorOptimize is unset
   c10::optional<ExecutionPlan> fallback_plan_;
   // fallback functions are inserted for tensorexpr fusion groups
@@ -48,6 +87,9 @@ struct ProfilingGraphExecutorImpl : public GraphExecutorImplBase {
   // of the GraphExecutor and only shared with InterpreterState
   std::vector<std::unique_ptr<Function>> fallback_functions_;
   c10::optional<size_t> remaining_bailout_depth_;
+  // whether this executor runs a fallback function, see
+  // replaceFallbackGraphWithFallbackFunction
+  bool is_fallback_;
 };
 
 } // namespace jit
@@ -0,0 +1,158 @@
+#include <torch/csrc/jit/runtime/static/batching.h>
+
+#include <ATen/ATen.h>
+#include <c10/util/llvmMathExtras.h>
+
+#include <numeric>
+
+namespace torch {
+namespace jit {
+
+StaticBatchingRuntime::StaticBatchingRuntime(
+    std::shared_ptr<StaticModule> sm,
+    const StaticBatchingOptions& opts)
+    : module_(std::move(sm)), opts_(opts) {
+  TORCH_CHECK(module_, "StaticBatchingRuntime needs a StaticModule");
+  TORCH_CHECK(opts_.max_batch_size > 0, "max_batch_size must be positive");
+}
+
+size_t StaticBatchingRuntime::num_batches() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_batches_;
+}
+
+std::vector<at::Tensor> StaticBatchingRuntime::operator()(
+    const std::vector<at::Tensor>& inps) {
+  TORCH_CHECK(
+      inps.size() == module_->num_inputs(),
+      "Expected ",
+      module_->num_inputs(),
+      " inputs, got ",
+      inps.size());
+  TORCH_CHECK(!inps.empty(), "Batched requests need at least one input");
+  const int64_t batch_size = inps[0].size(opts_.batch_dim);
+  for (const auto& t : inps) {
+    TORCH_CHECK(
+        t.size(opts_.batch_dim) == batch_size,
+        "All the inputs of a request must have the same batch size");
+  }
+
+  Request request{&inps, batch_size};
+  std::unique_lock<std::mutex> lock(mutex_);
+  pending_.push_back(&request);
+  pending_rows_ += batch_size;
+  cv_.notify_all();
+
+  while (!request.done) {
+    if (collecting_ || pending_.empty()) {
+      cv_.wait(lock);
+      continue;
+    }
+    // Lead the next batch, which starts with the oldest pending request and
+    // may not contain this one.
+    collecting_ = true;
+    cv_.wait_for(lock, opts_.max_latency, [this] {
+      return pending_rows_ >= opts_.max_batch_size;
+    });
+    auto batch = takeBatch();
+    collecting_ = false;
+    ++num_batches_;
+    // Another request may collect the next batch while this one runs
+    cv_.notify_all();
+
+    lock.unlock();
+    runBatch(batch);
+    lock.lock();
+    for (auto* r : batch) {
+      r->done = true;
+    }
+    cv_.notify_all();
+  }
+  lock.unlock();
+
+  if (request.error) {
+    std::rethrow_exception(request.error);
+  }
+  return std::move(request.outputs);
+}
+
+std::vector<StaticBatchingRuntime::Request*> StaticBatchingRuntime::
+    takeBatch() {
+  std::vector<Request*> batch;
+  int64_t rows = 0;
+  while (!pending_.empty()) {
+    auto* r = pending_.front();
+    if (!batch.empty() && rows + r->batch_size > opts_.max_batch_size) {
+      break;
+    }
+    rows += r->batch_size;
+    batch.push_back(r);
+    pending_.pop_front();
+  }
+  pending_rows_ -= rows;
+  return batch;
+}
+
+void StaticBatchingRuntime::runBatch(const std::vector<Request*>& batch) {
+  try {
+    std::vector<int64_t> rows;
+    rows.reserve(batch.size());
+    for (auto* r : batch) {
+      rows.push_back(r->batch_size);
+    }
+    const int64_t total_rows =
+        std::accumulate(rows.begin(), rows.end(), int64_t{0});
+
+    std::vector<at::Tensor> inputs;
+    if (batch.size() == 1) {
+      inputs = *batch[0]->inputs;
+    } else {
+      const size_t num_inputs = batch[0]->inputs->size();
+      inputs.reserve(num_inputs);
+      std::vector<at::Tensor> parts(batch.size());
+      for (size_t i = 0; i < num_inputs; i++) {
+        for (size_t j = 0; j < batch.size(); j++) {
+          parts[j] = (*batch[j]->inputs)[i];
+        }
+        inputs.emplace_back(at::cat(parts, opts_.batch_dim));
+      }
+    }
+
+    std::vector<at::Tensor> outputs;
+    {
+      auto& bucket = buckets_[c10::llvm::Log2_64_Ceil(
+          static_cast<uint64_t>(std::max<int64_t>(total_rows, 1)))];
+      std::lock_guard<std::mutex> guard(bucket.mutex);
+      if (!bucket.runtime) {
+        bucket.runtime = std::make_unique<StaticRuntime>(*module_);
+      }
+      outputs = (*bucket.runtime)(inputs);
+    }
+
+    if (batch.size() == 1) {
+      batch[0]->outputs = std::move(outputs);
+      return;
+    }
+    for (auto* r : batch) {
+      r->outputs.reserve(outputs.size());
+    }
+    for (const auto& output : outputs) {
+      TORCH_CHECK(
+          output.size(opts_.batch_dim) == total_rows,
+          "The outputs of a batch must have as many rows as its inputs");
+      auto chunks = output.split_with_sizes(rows, opts_.batch_dim);
+      for (size_t j = 0; j < batch.size(); j++) {
+        batch[j]->outputs.emplace_back(std::move(chunks[j]));
+      }
+    }
+  } catch (...) {
+    auto error = std::current_exception();
+    for (auto* r : batch) {
+      r->outputs.clear();
+      r->error = error;
+    }
+  }
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <torch/csrc/jit/runtime/static/impl.h>
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace torch {
+namespace jit {
+
+struct TORCH_API StaticBatchingOptions {
+  // The dimension along which the inputs of the concurrent requests are
+  // concatenated and the outputs are split back. All the inputs and outputs
+  // of the module must have it.
+  int64_t batch_dim{0};
+  // A batch stops collecting requests once it has this many rows. A single
+  // request larger than this still runs on its own.
+  int64_t max_batch_size{64};
+  // How long the first request of a batch waits for more requests
+  std::chrono::microseconds max_latency{1000};
+};
+
+/// Serves concurrent requests to a StaticModule by running them in batches.
+///
+/// Each request is a call to operator() from its own thread. The first
+/// request that arrives while no batch is being collected waits up to
+/// max_latency for more requests, concatenates their inputs along batch_dim,
+/// runs them in a single StaticRuntime pass and splits the outputs back
+/// along batch_dim, row for row. The module must therefore treat the rows of
+/// the batch dimension independently.
+///
+/// Batches are run by one StaticRuntime per power of two bucket of batch
+/// sizes, so that the memory planned for a bucket is reused by all the
+/// batches that fall in it.
+///
+/// @code
+///   auto smodule = std::make_shared<StaticModule>(m);
+///   StaticBatchingRuntime runtime(smodule, opts);
+///   // from any number of threads
+///   auto outputs = runtime(inputs);
+/// @endcode
+class TORCH_API StaticBatchingRuntime {
+ public:
+  explicit StaticBatchingRuntime(
+      std::shared_ptr<StaticModule> sm,
+      const StaticBatchingOptions& opts = StaticBatchingOptions());
+
+  std::vector<at::Tensor> operator()(const std::vector<at::Tensor>& inps);
+
+  const StaticBatchingOptions& opts() const {
+    return opts_;
+  }
+
+  // The number of batches run so far, for monitoring
+  size_t num_batches() const;
+
+ private:
+  struct Request {
+    const std::vector<at::Tensor>* inputs;
+    int64_t batch_size;
+    std::vector<at::Tensor> outputs;
+    std::exception_ptr error;
+    bool done{false};
+  };
+
+  struct Bucket {
+    std::mutex mutex;
+    std::unique_ptr<StaticRuntime> runtime;
+  };
+
+  // Takes the oldest pending requests, up to max_batch_size rows
+  std::vector<Request*> takeBatch();
+  void runBatch(const std::vector<Request*>& batch);
+
+  std::shared_ptr<StaticModule> module_;
+  StaticBatchingOptions opts_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Request*> pending_;
+  int64_t pending_rows_{0};
+  bool collecting_{false};
+  size_t num_batches_{0};
+
+  // Bucket i runs the batches of at most 2^i rows
+  std::array<Bucket, 64> buckets_;
+};
+
+} // namespace jit
+} // namespace torch
@@ -6,6 +6,7 @@
 #include <torch/csrc/jit/passes/dead_code_elimination.h>
 #include <torch/csrc/jit/passes/freeze_module.h>
 #include <torch/csrc/jit/passes/remove_mutation.h>
+#include <torch/csrc/jit/passes/tensorexpr_fuser.h>
 #include <torch/csrc/jit/passes/utils/subgraph_utils.h>
 #include <torch/csrc/jit/runtime/custom_operator.h>
 #include <torch/csrc/jit/runtime/static/impl.h>
@@ -283,5 +284,107 @@ void createFusionGroups(Block* block, AliasDb* aliasDb) {
   }
 }
 
+bool canFuseWithTensorExprs(Node* node) {
+  static const std::unordered_set<Symbol> kElementwiseOps = {
+      aten::add,
+      aten::sub,
+      aten::mul,
+      aten::div,
+      aten::sigmoid,
+      aten::tanh,
+      aten::relu,
+      aten::clamp,
+      aten::exp,
+      aten::log,
+      aten::neg,
+      aten::abs,
+      aten::sqrt,
+      aten::rsqrt,
+      aten::reciprocal,
+  };
+  REQ(kElementwiseOps.count(node->kind()));
+  REQ(tensorexpr::isSupported(node));
+  REQ(node->outputs().size() == 1);
+  REQ(node->output()->type()->cast<TensorType>());
+  for (Value* input : node->inputs()) {
+    REQ(input->type()->cast<TensorType>() ||
+        input->node()->kind() == prim::Constant);
+  }
+  return true;
+}
+
+graph_node_list::iterator createTensorExprGroup(Node* n, AliasDb* aliasDb) {
+  Node* group = SubgraphUtils::createSingletonSubgraphAndUpdateAliasing(
+      n, prim::TensorExprGroup, *aliasDb);
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (auto input : sortReverseTopological(
+             group->inputs(), group->owningBlock())) {
+      Node* producer = input->node();
+      if (!canFuseWithTensorExprs(producer) ||
+          !aliasDb->moveBeforeTopologicallyValid(producer, group)) {
+        continue;
+      }
+      GRAPH_UPDATE("Merging ", getHeader(producer));
+      SubgraphUtils::mergeNodeIntoSubgraphAndUpdateAliasing(
+          producer, group, *aliasDb);
+      // The inputs of the group have changed, so rescan them
+      changed = true;
+      break;
+    }
+  }
+  return ++group->reverseIterator();
+}
+
+// Non-tensor inputs of a group are constants, which the kernel needs to see
+// to compile the ops using them.
+void inlineConstantInputs(Node* group) {
+  auto subgraph = group->g(attr::Subgraph);
+  for (size_t i = group->inputs().size(); i-- > 0;) {
+    Value* input = group->input(i);
+    if (input->type()->cast<TensorType>()) {
+      continue;
+    }
+    TORCH_INTERNAL_ASSERT(input->node()->kind() == prim::Constant);
+    WithInsertPoint guard(subgraph->nodes().front());
+    Node* constant = subgraph->insertNode(
+        subgraph->createClone(input->node(), [](Value* v) { return v; }));
+    subgraph->inputs()[i]->replaceAllUsesWith(constant->output());
+    subgraph->eraseInput(i);
+    group->removeInput(i);
+  }
+}
+
+void performTensorExprFusion(std::shared_ptr<Graph> graph) {
+  auto aliasDb = torch::make_unique<AliasDb>(graph);
+  Block* block = graph->block();
+  for (auto it = block->nodes().rbegin(); it != block->nodes().rend();) {
+    if (canFuseWithTensorExprs(*it)) {
+      it = createTensorExprGroup(*it, aliasDb.get());
+    } else {
+      ++it;
+    }
+  }
+
+  std::vector<Node*> groups;
+  for (Node* n : block->nodes()) {
+    if (n->kind() == prim::TensorExprGroup) {
+      groups.push_back(n);
+    }
+  }
+  for (Node* group : groups) {
+    // A single op gains nothing from a kernel over its out variant
+    auto nodes = group->g(attr::Subgraph)->nodes();
+    if (std::next(nodes.begin()) == nodes.end()) {
+      SubgraphUtils::unmergeSubgraph(group);
+    } else {
+      inlineConstantInputs(group);
+    }
+  }
+  EliminateDeadCode(graph);
+  GRAPH_DUMP("After TensorExpr fusion: ", graph);
+}
+
 } // namespace jit
 } // namespace torch
@@ -7,5 +7,10 @@ namespace jit {
 
 TORCH_API void fuseStaticSubgraphs(std::shared_ptr<Graph> graph);
 
+// Groups chains of at least two elementwise ops that NNC can compile into
+// prim::TensorExprGroup nodes, which Static Runtime runs as one kernel
+// writing into its managed output tensors.
+TORCH_API void performTensorExprFusion(std::shared_ptr<Graph> graph);
+
 } // namespace jit
 } // namespace torch
@@ -1,8 +1,10 @@
 #include <torch/csrc/jit/runtime/static/impl.h>
 
+#include <ATen/Parallel.h>
 #include <ATen/core/LegacyTypeDispatch.h>
 #include <ATen/core/interned_strings.h>
 #include <c10/core/CPUAllocator.h>
+#include <c10/util/ThreadLocalDebugInfo.h>
 #include <caffe2/core/scope_guard.h>
 #include <caffe2/core/timer.h>
 #include <torch/csrc/jit/ir/alias_analysis.h>
@@ -11,9 +13,17 @@
 #include <torch/csrc/jit/passes/freeze_module.h>
 #include <torch/csrc/jit/passes/remove_mutation.h>
 #include <torch/csrc/jit/passes/subgraph_rewrite.h>
+#include <torch/csrc/jit/runtime/static/fusion.h>
 #include <torch/csrc/jit/runtime/static/ops.h>
 #include <torch/csrc/jit/runtime/static/passes.h>
 #include <torch/csrc/jit/runtime/vararg_functions.h>
+#include <algorithm>
+#include <condition_variable>
+#include <iomanip>
+#include <iterator>
+#include <mutex>
+#include <numeric>
+#include <sstream>
 
 namespace torch {
 namespace jit {
@@ -424,6 +434,149 @@ std::unordered_map<const Value*, std::vector<const Value*>> FindShared(
   return shared;
 }
 
+// Computes the lifetime of every value produced by a non-constant node as the
+// closed interval [def, last use] of node indices in execution order. Values
+// that may alias a value created earlier extend the lifetime of that value,
+// since they can keep its memory in use after its own last use. Uses by the
+// graph return node extend the lifetime to the end of the graph.
+std::unordered_map<const Value*, std::pair<size_t, size_t>> GetValueLifetimes(
+    const std::shared_ptr<torch::jit::Graph>& graph,
+    AliasDb& db) {
+  std::unordered_map<const Node*, size_t> node_indices;
+  std::vector<const Value*> values_in_creation_order;
+  for (const auto* node : graph->nodes()) {
+    if (node->kind() == prim::Constant) {
+      continue;
+    }
+    const size_t idx = node_indices.size();
+    node_indices[node] = idx;
+    for (const auto* v : node->outputs()) {
+      values_in_creation_order.emplace_back(v);
+    }
+  }
+  const size_t num_nodes = node_indices.size();
+
+  std::unordered_map<const Value*, std::pair<size_t, size_t>> lifetimes;
+  for (const auto* v : values_in_creation_order) {
+    const size_t def = node_indices.at(v->node());
+    size_t last = def;
+    for (const auto& u : v->uses()) {
+      auto it = node_indices.find(u.user);
+      last = std::max(last, it == node_indices.end() ? num_nodes : it->second);
+    }
+    lifetimes[v] = std::make_pair(def, last);
+  }
+
+  // walk backwards so the lifetimes of later aliases already include their
+  // own aliases when they are folded in
+  for (size_t i = values_in_creation_order.size(); i-- > 0;) {
+    const auto* v = values_in_creation_order[i];
+    auto& lifetime = lifetimes.at(v);
+    for (size_t j = i + 1; j < values_in_creation_order.size(); ++j) {
+      const auto* alias_v = values_in_creation_order[j];
+      if (mayContainAlias(db, v, alias_v)) {
+        lifetime.second =
+            std::max(lifetime.second, lifetimes.at(alias_v).second);
+      }
+    }
+  }
+  return lifetimes;
+}
+
+// Builds the dependency DAG used for inter-op parallel execution. A node
+// depends on the producers of its inputs. Nodes with side effects, or that
+// read or write memory some node mutates, are barriers: they depend on every
+// node since the previous barrier, and every later node depends on them.
+void BuildNodeDependencies(
+    const std::vector<ProcessedNode>& nodes,
+    const std::unordered_map<int, std::vector<std::pair<int, int>>>& index_map,
+    AliasDb& db,
+    std::vector<std::vector<size_t>>& dependents,
+    std::vector<size_t>& num_dependencies) {
+  dependents.assign(nodes.size(), {});
+  num_dependencies.assign(nodes.size(), 0);
+
+  c10::optional<size_t> last_barrier;
+  for (size_t idx = 0; idx < nodes.size(); ++idx) {
+    const Node* node = nodes[idx].node();
+    std::set<size_t> deps;
+    for (const auto& input_idx : index_map.at(idx)) {
+      // inputs (-1) and constants (-2) are available from the start
+      if (input_idx.first >= 0) {
+        deps.insert(input_idx.first);
+      }
+    }
+    const bool is_barrier = node->hasSideEffects() || db.hasWriters(node);
+    if (is_barrier) {
+      const size_t first = last_barrier ? *last_barrier : 0;
+      for (size_t prev = first; prev < idx; ++prev) {
+        deps.insert(prev);
+      }
+    } else if (last_barrier) {
+      deps.insert(*last_barrier);
+    }
+    for (size_t dep : deps) {
+      dependents[dep].emplace_back(idx);
+    }
+    num_dependencies[idx] = deps.size();
+    if (is_barrier) {
+      last_barrier = idx;
+    }
+  }
+}
+
+// Counts the memory allocated while installed as the profiler state, see
+// c10::reportMemoryUsageToProfiler. Allocations can be reported from intra-op
+// worker threads, which inherit the thread local debug info.
+class AllocationCounter : public c10::MemoryReportingInfoBase {
+ public:
+  void reportMemoryUsage(void* /* unused */, int64_t alloc_size, c10::Device)
+      override {
+    if (alloc_size > 0) {
+      bytes_ += alloc_size;
+      allocs_++;
+    }
+  }
+
+  bool memoryProfilingEnabled() const override {
+    return true;
+  }
+
+  // Returns the bytes and number of allocations since the last call
+  std::pair<size_t, size_t> reset() {
+    return std::make_pair(bytes_.exchange(0), allocs_.exchange(0));
+  }
+
+ private:
+  std::atomic<size_t> bytes_{0};
+  std::atomic<size_t> allocs_{0};
+};
+
+void WriteJsonString(std::ostream& out, const std::string& str) {
+  out << '"';
+  for (char c : str) {
+    switch (c) {
+      case '"':
+        out << "\\\"";
+        break;
+      case '\\':
+        out << "\\\\";
+        break;
+      case '\n':
+        out << "\\n";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+              << static_cast<int>(c) << std::dec << std::setfill(' ');
+        } else {
+          out << c;
+        }
+    }
+  }
+  out << '"';
+}
+
 } // namespace
 
 void PrepareGraphForStaticModule(std::shared_ptr<torch::jit::Graph> graph) {
@@ -476,6 +629,11 @@ StaticModule::StaticModule(
     : opts_(opts),
       graph_(std::move(graph_and_schema.first)),
       schema_(std::move(graph_and_schema.second)) {
+  // The groups only run as out variants
+  if (opts.enable_tensorexpr_fusion && opts.enable_out_variant) {
+    performTensorExprFusion(graph_);
+  }
+
   std::unordered_map<Value*, IValue*> val_to_ival;
   // value -> index into nodes, index into outputs of node
   std::unordered_map<Value*, std::pair<int, int>> val_to_idx;
@@ -542,12 +700,26 @@ StaticModule::StaticModule(
   AliasDb alias_db(graph_);
   auto lm = GetLivenessInformation(graph_, alias_db);
   external_values_ = lm.second;
-  if (opts_.optimize_memory) {
+  if (opts_.enable_inter_op_parallelism) {
+    BuildNodeDependencies(
+        nodes_,
+        index_map_,
+        alias_db,
+        node_dependents_,
+        node_num_dependencies_);
+  }
+  // Memory reuse assumes nodes run one after another in graph order, which
+  // doesn't hold when independent nodes run concurrently.
+  if (opts_.optimize_memory && !opts_.enable_inter_op_parallelism) {
     auto values = GetOptimizableValues(graph_);
     if (!opts_.enable_out_variant) {
       values.first = {};
     }
-    shared_values_ = FindShared(lm, values, alias_db);
+    if (opts_.optimize_memory_by_lifetime) {
+      value_lifetimes_ = GetValueLifetimes(graph_, alias_db);
+    } else {
+      shared_values_ = FindShared(lm, values, alias_db);
+    }
   }
 }
 
@@ -580,7 +752,10 @@ c10::IValue StaticModule::operator()(
   return runtime()(args, kwargs);
 }
 
-StaticRuntime::StaticRuntime(const StaticModule& sm) : static_module_(sm) {
+StaticRuntime::StaticRuntime(
+    const StaticModule& sm,
+    std::shared_ptr<StaticRuntimeArena> arena)
+    : arena_(std::move(arena)), static_module_(sm) {
   // NB: create unchanging std::vector<IValue>s we can reference
   inputs_.resize(sm.num_inputs());
   nodes_.resize(sm.nodes().size());
@@ -683,8 +858,12 @@ c10::IValue StaticRuntime::operator()(
   // NB: before optimizing the order of execution, ensure that the
   // memory optimization pass (LivenessMap) is
   // aware of the new order!
-  for (auto& n : nodes_) {
-    n.run();
+  if (static_module_.opts().enable_inter_op_parallelism) {
+    run_nodes_in_parallel();
+  } else {
+    for (auto& n : nodes_) {
+      n.run();
+    }
   }
 
   if (static_module_.opts().cleanup_activations) {
@@ -693,7 +872,9 @@ c10::IValue StaticRuntime::operator()(
           this,
           static_module_.shared_values(),
           static_module_.external_values(),
-          static_module_.opts().enable_out_variant);
+          static_module_.opts().enable_out_variant,
+          static_module_.value_lifetimes(),
+          arena_);
     }
     planner_->deallocate();
     // clean up owning refs of input tensors
@@ -721,6 +902,94 @@ c10::IValue StaticRuntime::operator()(
   return std::move(*outputs_[0]);
 }
 
+void StaticRuntime::run_nodes_in_parallel() {
+  const auto& dependents = static_module_.node_dependents();
+  const auto& num_dependencies = static_module_.node_num_dependencies();
+  const size_t num_nodes = nodes_.size();
+  if (num_nodes == 0) {
+    return;
+  }
+
+  // State shared by all tasks of this run. It lives on this stack frame,
+  // which is only left once every node has been accounted for.
+  struct RunState {
+    explicit RunState(size_t n)
+        : pending(new std::atomic<size_t>[n]), remaining(n) {}
+    std::unique_ptr<std::atomic<size_t>[]> pending;
+    std::atomic<bool> failed{false};
+    std::mutex mutex;
+    // guarded by mutex
+    size_t remaining;
+    std::exception_ptr error;
+    std::condition_variable done;
+  } state(num_nodes);
+
+  std::vector<size_t> roots;
+  for (size_t idx = 0; idx < num_nodes; ++idx) {
+    state.pending[idx].store(num_dependencies[idx], std::memory_order_relaxed);
+    if (num_dependencies[idx] == 0) {
+      roots.emplace_back(idx);
+    }
+  }
+
+  // Runs a node, then keeps going on this thread with the first of its
+  // dependents that became ready and launches the others. After a failure
+  // nodes are only accounted for, not run, so that `remaining` still drops to
+  // zero.
+  std::function<void(size_t)> run_from;
+  run_from = [&](size_t idx) {
+    while (true) {
+      if (!state.failed.load(std::memory_order_acquire)) {
+        try {
+          nodes_[idx].run();
+        } catch (...) {
+          std::lock_guard<std::mutex> guard(state.mutex);
+          if (!state.failed.exchange(true)) {
+            state.error = std::current_exception();
+          }
+        }
+      }
+      c10::optional<size_t> next;
+      for (size_t dependent : dependents[idx]) {
+        if (state.pending[dependent].fetch_sub(1) == 1) {
+          if (!next) {
+            next = dependent;
+          } else {
+            at::launch([&run_from, dependent]() { run_from(dependent); });
+          }
+        }
+      }
+      {
+        // decrement under the lock so that the waiting thread can't observe
+        // completion and tear down `state` before notify_all returns
+        std::lock_guard<std::mutex> guard(state.mutex);
+        if (--state.remaining == 0) {
+          state.done.notify_all();
+        }
+      }
+      if (!next) {
+        return;
+      }
+      idx = *next;
+    }
+  };
+
+  for (size_t i = 1; i < roots.size(); ++i) {
+    const size_t root = roots[i];
+    at::launch([&run_from, root]() { run_from(root); });
+  }
+  // the calling thread takes part in the execution instead of just waiting
+  run_from(roots[0]);
+
+  {
+    std::unique_lock<std::mutex> lock(state.mutex);
+    state.done.wait(lock, [&state]() { return state.remaining == 0; });
+  }
+  if (state.error) {
+    std::rethrow_exception(state.error);
+  }
+}
+
 void StaticRuntime::benchmark(
     const std::vector<c10::IValue>& args,
     const std::unordered_map<std::string, c10::IValue>& kwargs,
@@ -736,7 +1005,8 @@ void StaticRuntime::benchmark(
   for (size_t i = 0; i < nodes_.size(); i++) {
     const Node* node = nodes_[i].node();
     std::cout << "Node #" << i << ": " << results.time_per_node[i]
-              << " ms/iter, ";
+              << " ms/iter, " << results.alloc_bytes_per_node[i]
+              << " bytes allocated/iter, ";
     node->print(std::cout, 0, nullptr, false);
   }
 
@@ -751,13 +1021,25 @@ void StaticRuntime::benchmark(
   for (const auto& p : time_per_node_type_vec) {
     const std::string& kind = p.first;
     const double ms = p.second;
+    const int instances = results.instances_per_node_type[kind];
+    const int out_instances = results.out_instances_per_node_type[kind];
+    const int native_instances = results.native_instances_per_node_type[kind];
     std::cout << std::setw(15) << ms << " ms. " << std::setw(10)
               << results.percent_per_node_type[kind] << "%. " << kind << " ("
-              << results.instances_per_node_type[kind] << " nodes)"
-              << std::endl;
+              << instances << " nodes, " << out_instances << " out, "
+              << native_instances << " native, "
+              << instances - out_instances - native_instances << " fallback, "
+              << results.alloc_bytes_per_node_type[kind]
+              << " bytes allocated/iter)" << std::endl;
   }
   std::cout << std::setw(15) << results.total_time << " ms. in Total"
             << std::endl;
+  std::cout << "Nodes with out variant: " << results.out_nodes_count << " ("
+            << results.native_nodes_count << " native, "
+            << results.total_nodes_count - results.out_nodes_count -
+          results.native_nodes_count
+            << " fallback) out of " << results.total_nodes_count << " nodes"
+            << std::endl;
   std::cout << "StaticRuntime setup time: " << results.setup_time << " ms"
             << std::endl;
   std::cout << "Memory allocation time: " << results.memory_alloc_time
@@ -808,6 +1090,8 @@ StaticRuntime::IndividualMetrics StaticRuntime::benchmark_individual_ops(
 
   IndividualMetrics results;
   results.time_per_node.resize(nodes_.size(), 0);
+  results.alloc_bytes_per_node.resize(nodes_.size(), 0);
+  results.allocs_per_node.resize(nodes_.size(), 0);
 
   // setup time
   caffe2::Timer timer;
@@ -830,6 +1114,11 @@ StaticRuntime::IndividualMetrics StaticRuntime::benchmark_individual_ops(
     operator()(args, kwargs);
   }
 
+  // track the allocations made inside each node during the main runs
+  auto alloc_counter = std::make_shared<AllocationCounter>();
+  c10::DebugInfoGuard alloc_guard(
+      c10::DebugInfoKind::PROFILER_STATE, alloc_counter);
+
   // main runs
   for (int k = 0; k < main_runs; k++) {
     for (size_t i = 0; i < stack.size(); i++) {
@@ -842,11 +1131,15 @@ StaticRuntime::IndividualMetrics StaticRuntime::benchmark_individual_ops(
     float millis = timer.MilliSeconds();
     results.memory_alloc_time += millis;
 
+    alloc_counter->reset();
     for (size_t i = 0; i < nodes_.size(); i++) {
       timer.Start();
       nodes_[i].run();
       millis = timer.MilliSeconds();
       results.time_per_node[i] += millis;
+      auto allocated = alloc_counter->reset();
+      results.alloc_bytes_per_node[i] += allocated.first;
+      results.allocs_per_node[i] += allocated.second;
     }
     timer.Start();
     if (static_module_.opts().cleanup_activations) {
@@ -855,7 +1148,9 @@ StaticRuntime::IndividualMetrics StaticRuntime::benchmark_individual_ops(
             this,
             static_module_.shared_values(),
             static_module_.external_values(),
-            static_module_.opts().enable_out_variant);
+            static_module_.opts().enable_out_variant,
+            static_module_.value_lifetimes(),
+            arena_);
       }
       planner_->deallocate();
       // clean up owning refs of input tensors
@@ -899,7 +1194,19 @@ StaticRuntime::IndividualMetrics StaticRuntime::benchmark_individual_ops(
     results.time_per_node_type[kind] += results.time_per_node[i];
     results.instances_per_node_type[kind]++;
     results.total_time += results.time_per_node[i];
+    results.alloc_bytes_per_node[i] /= main_runs;
+    results.allocs_per_node[i] /= main_runs;
+    results.alloc_bytes_per_node_type[kind] += results.alloc_bytes_per_node[i];
+    results.allocs_per_node_type[kind] += results.allocs_per_node[i];
+    if (nodes_[i].has_out_variant()) {
+      results.out_nodes_count++;
+      results.out_instances_per_node_type[kind]++;
+    } else if (nodes_[i].has_native_fn()) {
+      results.native_nodes_count++;
+      results.native_instances_per_node_type[kind]++;
+    }
   }
+  results.total_nodes_count = nodes_.size();
   results.memory_alloc_time /= static_cast<float>(main_runs);
   results.memory_dealloc_time /= static_cast<float>(main_runs);
   results.output_dealloc_time /= static_cast<float>(main_runs);
@@ -910,6 +1217,51 @@ StaticRuntime::IndividualMetrics StaticRuntime::benchmark_individual_ops(
   return results;
 }
 
+std::string StaticRuntime::IndividualMetrics::to_json() const {
+  std::vector<std::pair<std::string, float>> time_per_node_type_vec{
+      time_per_node_type.begin(), time_per_node_type.end()};
+  std::sort(
+      time_per_node_type_vec.begin(),
+      time_per_node_type_vec.end(),
+      [](auto& left, auto& right) { return left.second > right.second; });
+
+  auto get = [](const auto& map, const std::string& kind) {
+    auto it = map.find(kind);
+    return it == map.end() ? 0 : it->second;
+  };
+
+  std::ostringstream out;
+  out << "{\"setup_time_ms\": " << setup_time
+      << ", \"memory_alloc_time_ms\": " << memory_alloc_time
+      << ", \"memory_dealloc_time_ms\": " << memory_dealloc_time
+      << ", \"output_dealloc_time_ms\": " << output_dealloc_time
+      << ", \"total_time_ms\": " << total_time
+      << ", \"out_nodes_count\": " << out_nodes_count
+      << ", \"native_nodes_count\": " << native_nodes_count
+      << ", \"total_nodes_count\": " << total_nodes_count
+      << ", \"node_types\": [";
+  for (size_t i = 0; i < time_per_node_type_vec.size(); ++i) {
+    const std::string& kind = time_per_node_type_vec[i].first;
+    const int instances = get(instances_per_node_type, kind);
+    const int out_instances = get(out_instances_per_node_type, kind);
+    const int native_instances = get(native_instances_per_node_type, kind);
+    out << (i == 0 ? "" : ", ") << "{\"kind\": ";
+    WriteJsonString(out, kind);
+    out << ", \"instances\": " << instances
+        << ", \"out_variant\": " << out_instances
+        << ", \"native\": " << native_instances
+        << ", \"fallback\": " << instances - out_instances - native_instances
+        << ", \"time_ms\": " << time_per_node_type_vec[i].second
+        << ", \"percent\": " << get(percent_per_node_type, kind)
+        << ", \"alloc_bytes_per_iter\": "
+        << get(alloc_bytes_per_node_type, kind)
+        << ", \"allocs_per_iter\": " << get(allocs_per_node_type, kind)
+        << "}";
+  }
+  out << "]}";
+  return out.str();
+}
+
 void StaticRuntime::check_for_memory_leak(bool output_returned) {
   if (!static_module_.opts().cleanup_activations) {
     return;
@@ -957,7 +1309,11 @@ MemoryPlanner::MemoryPlanner(
     const std::unordered_map<const Value*, std::vector<const Value*>>&
         should_share,
     const std::unordered_set<const Value*>& external_values,
-    bool out_variants) {
+    bool out_variants,
+    const std::unordered_map<const Value*, std::pair<size_t, size_t>>&
+        value_lifetimes,
+    std::shared_ptr<StaticRuntimeArena> arena)
+    : arena_(std::move(arena)), plan_by_lifetime_(!value_lifetimes.empty()) {
   // collect register indices of outputs of ops with out variant
   std::unordered_set<const Value*> managed_values;
   std::unordered_set<IValue*> unmanaged_ivalue_set;
@@ -1003,8 +1359,10 @@ MemoryPlanner::MemoryPlanner(
   // some Values should share storage, this map will
   // keep track of the index into managed_storage_
   std::unordered_map<const Value*, size_t> shared;
-  // the StorageImpls of Tensor views should not be managed
-  std::unordered_set<c10::StorageImpl*> managed_storage_impls;
+  // the StorageImpls of Tensor views should not be managed. With lifetime
+  // based planning, also maps each StorageImpl to its index into
+  // managed_storage_
+  std::unordered_map<c10::StorageImpl*, size_t> managed_storage_impls;
 
   // Snapshot of the current memory state
   for (const auto& pnode : runtime->nodes()) {
@@ -1015,7 +1373,23 @@ MemoryPlanner::MemoryPlanner(
         TORCH_CHECK(ival.isTensor());
         auto* impl = ival.toTensor().storage().unsafeGetStorageImpl();
 
-        auto didInsert = managed_storage_impls.insert(impl).second;
+        auto didInsert =
+            managed_storage_impls.emplace(impl, managed_storage_.size()).second;
+        if (plan_by_lifetime_) {
+          // every StorageImpl is planned on its own; values backed by the
+          // same StorageImpl extend its lifetime
+          const auto& lifetime = value_lifetimes.at(val);
+          if (didInsert) {
+            managed_storage_.emplace_back(
+                0, std::vector<c10::StorageImpl*>{impl});
+            managed_lifetimes_.emplace_back(lifetime);
+          } else {
+            auto& l = managed_lifetimes_[managed_storage_impls.at(impl)];
+            l.first = std::min(l.first, lifetime.first);
+            l.second = std::max(l.second, lifetime.second);
+          }
+          continue;
+        }
         if (!didInsert) {
           continue;
         }
@@ -1036,6 +1410,7 @@ MemoryPlanner::MemoryPlanner(
       }
     }
   }
+  managed_offsets_.resize(managed_lifetimes_.size(), 0);
 }
 
 // Don't change the size if it is already aligned, otherwise increase the size
@@ -1054,31 +1429,45 @@ void MemoryPlanner::allocate() {
   if (managed_bytes_ == 0) {
     return;
   }
-  buffer_ = allocate_buffer(managed_bytes_);
+  if (arena_) {
+    buffer_ = arena_->acquire(managed_bytes_, buffer_capacity_);
+  } else {
+    buffer_ = allocate_buffer(managed_bytes_);
+  }
 
   size_t offset = 0;
   uint8_t* start = static_cast<uint8_t*>(buffer_.get());
 
-  reused_tensors_ = 0;
-  for (const auto& ms : managed_storage_) {
+  if (!plan_by_lifetime_) {
+    reused_tensors_ = 0;
+  }
+  for (size_t idx = 0; idx < managed_storage_.size(); ++idx) {
+    const auto& ms = managed_storage_[idx];
     auto tensor_size = ms.first;
     if (tensor_size == 0) {
       continue;
     }
     const auto& impls = ms.second;
+    if (plan_by_lifetime_) {
+      offset = managed_offsets_[idx];
+    }
     DCHECK_LE(offset + tensor_size, managed_bytes_);
     void* src = static_cast<void*>(start + offset);
 
     for (auto& impl : impls) {
       impl->set_data_ptr_noswap(at::DataPtr(src, src, nullptr, impl->device()));
       impl->set_nbytes(tensor_size);
-      reused_tensors_++;
+      if (!plan_by_lifetime_) {
+        reused_tensors_++;
+      }
+    }
+    if (!plan_by_lifetime_) {
+      reused_tensors_--;
     }
-    reused_tensors_--;
 
     offset += tensor_size;
   }
-  DCHECK_EQ(offset, managed_bytes_);
+  DCHECK(plan_by_lifetime_ || offset == managed_bytes_);
 }
 
 void MemoryPlanner::deallocate() {
@@ -1097,12 +1486,147 @@ void MemoryPlanner::deallocate() {
     ms.first = max;
     managed_bytes_ += max;
   }
+  if (plan_by_lifetime_) {
+    plan_offsets_by_lifetime();
+  }
   for (auto& iv : unmanaged_values_) {
     *iv = IValue();
   }
+  if (arena_ && buffer_) {
+    arena_->release(std::move(buffer_), buffer_capacity_);
+  }
   buffer_ = {};
 }
 
+at::DataPtr StaticRuntimeArena::acquire(size_t size, size_t& capacity) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto best = idle_.end();
+    for (auto it = idle_.begin(); it != idle_.end(); ++it) {
+      if (it->capacity >= size &&
+          (best == idle_.end() || it->capacity < best->capacity)) {
+        best = it;
+      }
+    }
+    if (best == idle_.end() && !idle_.empty()) {
+      // Every idle buffer is too small: drop the largest one rather than
+      // keeping buffers that the runs have outgrown
+      best = std::max_element(
+          idle_.begin(),
+          idle_.end(),
+          [](const IdleBuffer& a, const IdleBuffer& b) {
+            return a.capacity < b.capacity;
+          });
+      idle_bytes_ -= best->capacity;
+      idle_.erase(best);
+    } else if (best != idle_.end()) {
+      at::DataPtr buffer = std::move(best->buffer);
+      capacity = best->capacity;
+      idle_bytes_ -= capacity;
+      idle_.erase(best);
+      return buffer;
+    }
+  }
+  // Not the caching allocator: the arena does the caching itself, and the
+  // buffers it frees have to go back to the system
+  capacity = size;
+  return c10::GetCPUAllocator()->allocate(size);
+}
+
+void StaticRuntimeArena::release(at::DataPtr buffer, size_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  idle_.push_back(
+      {std::move(buffer), capacity, std::chrono::steady_clock::now()});
+  idle_bytes_ += capacity;
+}
+
+size_t StaticRuntimeArena::shrink(
+    std::chrono::steady_clock::duration idle_time) {
+  const auto now = std::chrono::steady_clock::now();
+  std::vector<IdleBuffer> freed;
+  size_t freed_bytes = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::stable_partition(
+        idle_.begin(), idle_.end(), [&](const IdleBuffer& b) {
+          return now - b.released < idle_time;
+        });
+    std::move(it, idle_.end(), std::back_inserter(freed));
+    idle_.erase(it, idle_.end());
+    for (const auto& b : freed) {
+      freed_bytes += b.capacity;
+    }
+    idle_bytes_ -= freed_bytes;
+  }
+  // the buffers are freed here, outside of the lock
+  return freed_bytes;
+}
+
+size_t StaticRuntimeArena::idle_bytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return idle_bytes_;
+}
+
+// Greedy interval coloring: storages are placed in decreasing size order (ties
+// broken by the start of their lifetime for determinism) at the lowest offset
+// that fits between the storages already placed whose lifetimes overlap.
+// Updates managed_offsets_, managed_bytes_ and reused_tensors_.
+void MemoryPlanner::plan_offsets_by_lifetime() {
+  std::vector<size_t> order(managed_storage_.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+    if (managed_storage_[a].first != managed_storage_[b].first) {
+      return managed_storage_[a].first > managed_storage_[b].first;
+    }
+    return managed_lifetimes_[a].first < managed_lifetimes_[b].first;
+  });
+
+  managed_bytes_ = 0;
+  reused_tensors_ = 0;
+  std::vector<size_t> placed;
+  placed.reserve(order.size());
+  // [begin, end) byte ranges of placed storages with overlapping lifetimes
+  std::vector<std::pair<size_t, size_t>> conflicts;
+  for (size_t idx : order) {
+    const size_t size = managed_storage_[idx].first;
+    if (size == 0) {
+      managed_offsets_[idx] = 0;
+      continue;
+    }
+    const auto& lifetime = managed_lifetimes_[idx];
+    conflicts.clear();
+    for (size_t other : placed) {
+      const auto& other_lifetime = managed_lifetimes_[other];
+      if (other_lifetime.first <= lifetime.second &&
+          lifetime.first <= other_lifetime.second) {
+        conflicts.emplace_back(
+            managed_offsets_[other],
+            managed_offsets_[other] + managed_storage_[other].first);
+      }
+    }
+    std::sort(conflicts.begin(), conflicts.end());
+
+    size_t offset = 0;
+    for (const auto& range : conflicts) {
+      if (offset + size <= range.first) {
+        break;
+      }
+      offset = std::max(offset, range.second);
+    }
+    // reusing memory that was already handed out to another storage
+    for (size_t other : placed) {
+      if (managed_offsets_[other] < offset + size &&
+          offset < managed_offsets_[other] + managed_storage_[other].first) {
+        reused_tensors_++;
+        break;
+      }
+    }
+    managed_offsets_[idx] = offset;
+    managed_bytes_ = std::max(managed_bytes_, offset + size);
+    placed.emplace_back(idx);
+  }
+}
+
 ProcessedNode::ProcessedNode(
     Node* node,
     std::vector<const IValue*>&& inputs,
@@ -1112,7 +1636,10 @@ ProcessedNode::ProcessedNode(
   outputs_.resize(node->outputs().size());
   if (node->kind() != prim::ListConstruct &&
       node->kind() != prim::TupleConstruct &&
-      node->kind() != prim::ListUnpack) {
+      node->kind() != prim::ListUnpack &&
+      node->kind() != prim::TensorExprGroup) {
+    // prim::TensorExprGroup nodes of Static Runtime have no shape information
+    // and always run through their out variant
     const Operator& op = node->getOperator();
     TORCH_CHECK(op.hasOperation());
     op_ = op.getOperation(node);
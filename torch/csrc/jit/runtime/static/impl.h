@@ -9,6 +9,9 @@
 #include <torch/csrc/jit/passes/freeze_module.h>
 #include <torch/csrc/jit/passes/inliner.h>
 
+#include <chrono>
+#include <mutex>
+
 namespace torch {
 namespace jit {
 
@@ -16,6 +19,21 @@ struct TORCH_API StaticModuleOptions {
   bool cleanup_activations{true};
   bool enable_out_variant{true};
   bool optimize_memory{true};
+  // If true (and optimize_memory is set), the memory planner assigns each
+  // managed tensor an offset into the arena by interval coloring over the
+  // tensor lifetimes, instead of grouping tensors into fixed clusters. Tensors
+  // whose lifetimes don't overlap may then share any part of the arena, so the
+  // arena is sized at the peak live set rather than the sum of the clusters.
+  bool optimize_memory_by_lifetime{false};
+  // If true, independent nodes of a single run are executed concurrently on
+  // the inter-op thread pool (at::launch), following the dependency DAG built
+  // at StaticModule construction. Memory reuse between managed tensors is
+  // disabled in this mode because it relies on the sequential node order.
+  bool enable_inter_op_parallelism{false};
+  // If true (and enable_out_variant is set), chains of elementwise ops are
+  // fused into NNC kernels that write straight into the managed output
+  // tensors, saving the intermediate tensors and passes over memory.
+  bool enable_tensorexpr_fusion{false};
 };
 
 /// The static runime supports two execution modes.
@@ -39,33 +57,23 @@ struct TORCH_API StaticModuleOptions {
 /// Mode 2: similar to data parallelism, run the same model for different inputs
 /// on different threads at the same time.
 /// You should have one StaticModule per model, and one StaticRuntime instance
-/// per running thread. To avoiding creating StaticRuntimes on the fly, use a
-/// synchronized stack (i.e. boost::lockfree::stack) to cache all the
-/// StaticRuntime instances in your code.
+/// per running thread. StaticRuntimePool (see pool.h) checks runtimes out per
+/// request and lets the runtimes that don't run at the same time share their
+/// memory planner buffers.
 /// @code
 ///   // initialization
 ///   auto module = std::make_shared<StaticModule>(m, opts);
+///   StaticRuntimePool pool(module);
 ///
-///   // 128 is good for most cases. Pick a number that works for you
-///   boost::lockfree::stack<std::shared_ptr<StaticRuntime>,
-///     boost::lockfree::fixed_sized<true>> pool(128);
-///
-///   // inference
-///   std::shared_ptr<StaticRuntime> runtime = nullptr;
-///   pool.pop(runtime);
-///   if (!runtime) {
-///     // holds a reference to the underlying module
-///     // but does its own memory management
-///     runtime = std::make_shared<StaticRuntime>(*module);
-///   }
-///   auto output = runtime(args, kwargs);
-///   pool.push(runtime);
+///   // inference, from any number of threads
+///   auto output = pool(args, kwargs);
 /// @endcode
 ///
 
 class MemoryPlanner;
 class ProcessedNode;
 class StaticRuntime;
+class StaticRuntimeArena;
 class TORCH_API StaticModule {
  public:
   explicit StaticModule(
@@ -130,6 +138,26 @@ class TORCH_API StaticModule {
     return external_values_;
   }
 
+  // Closed interval [first, last] of node indices (into nodes()) during which
+  // the memory of a value needs to stay valid. Only populated when
+  // opts().optimize_memory_by_lifetime is set.
+  inline const std::unordered_map<const Value*, std::pair<size_t, size_t>>&
+  value_lifetimes() const {
+    return value_lifetimes_;
+  }
+
+  // Dependency DAG over nodes(), only populated when
+  // opts().enable_inter_op_parallelism is set. node_dependents()[i] lists the
+  // nodes that can only start after node i finished, and
+  // node_num_dependencies()[i] is the number of nodes node i waits for.
+  inline const std::vector<std::vector<size_t>>& node_dependents() const {
+    return node_dependents_;
+  }
+
+  inline const std::vector<size_t>& node_num_dependencies() const {
+    return node_num_dependencies_;
+  }
+
   StaticRuntime& runtime();
 
  private:
@@ -146,6 +174,9 @@ class TORCH_API StaticModule {
   // with which it could potentially share memory.
   std::unordered_map<const Value*, std::vector<const Value*>> shared_values_;
   std::unordered_set<const Value*> external_values_;
+  std::unordered_map<const Value*, std::pair<size_t, size_t>> value_lifetimes_;
+  std::vector<std::vector<size_t>> node_dependents_;
+  std::vector<size_t> node_num_dependencies_;
 
   // Original input
   std::shared_ptr<torch::jit::Graph> graph_;
@@ -154,7 +185,11 @@ class TORCH_API StaticModule {
 
 class TORCH_API StaticRuntime {
  public:
-  explicit StaticRuntime(const StaticModule& sm);
+  // If arena is given, the memory planner takes its buffer from it for the
+  // duration of every run instead of allocating it.
+  explicit StaticRuntime(
+      const StaticModule& sm,
+      std::shared_ptr<StaticRuntimeArena> arena = nullptr);
 
   std::vector<at::Tensor> operator()(const std::vector<at::Tensor>& inps);
 
@@ -186,6 +221,22 @@ class TORCH_API StaticRuntime {
     std::unordered_map<std::string, float> time_per_node_type;
     std::unordered_map<std::string, float> percent_per_node_type;
     std::unordered_map<std::string, int> instances_per_node_type;
+    // How each node is executed. Nodes that have neither an out variant nor
+    // a native implementation fall back to the boxed JIT operator.
+    int out_nodes_count{0};
+    int native_nodes_count{0};
+    int total_nodes_count{0};
+    std::unordered_map<std::string, int> out_instances_per_node_type;
+    std::unordered_map<std::string, int> native_instances_per_node_type;
+    // Memory allocated per iteration from inside the nodes, i.e. not counting
+    // the buffer handed out by the memory planner
+    std::vector<size_t> alloc_bytes_per_node;
+    std::vector<size_t> allocs_per_node;
+    std::unordered_map<std::string, size_t> alloc_bytes_per_node_type;
+    std::unordered_map<std::string, size_t> allocs_per_node_type;
+
+    // Serializes the per node type metrics as a JSON object, sorted by time
+    std::string to_json() const;
   };
 
   IndividualMetrics benchmark_individual_ops(
@@ -225,10 +276,16 @@ class TORCH_API StaticRuntime {
   void check_for_memory_leak(bool output_returned = true);
 
  private:
+  // Runs nodes_ following StaticModule::node_dependents(), scheduling every
+  // node that becomes ready on the inter-op thread pool. Returns once all
+  // nodes have finished and rethrows the first exception raised by a node.
+  void run_nodes_in_parallel();
+
   // Memory planning is only enabled if sm->opts().cleanup_activations is true.
   // Otherwise, the memory used by activations is cached inside the static
   // runtime.
   std::unique_ptr<MemoryPlanner> planner_;
+  std::shared_ptr<StaticRuntimeArena> arena_;
   std::vector<IValue> inputs_;
   std::vector<IValue*> outputs_;
   const StaticModule& static_module_;
@@ -256,9 +313,54 @@ class TORCH_API StaticRuntime {
 ///      the default allocator for memory allocation.
 ///   3. free the buffer at the end of each iteration
 /// Steps 1 and 3 are handled by `deallocate()`, and step 2 by `allocate()`.
+///
+/// With StaticModuleOptions::optimize_memory_by_lifetime, every StorageImpl is
+/// planned on its own and the offsets are recomputed in `deallocate()` from
+/// the recorded sizes: storages are placed in decreasing size order at the
+/// lowest offset that doesn't overlap any already placed storage whose
+/// lifetime intersects theirs.
 /// Only models with simple output types are supported, i.e. None, Tensor or
 /// List/Tuple of Tensors. Complex output types such as List of Lists are not
 /// supported.
+///
+/// Given a StaticRuntimeArena, the buffer of step 2 is taken from the arena
+/// and handed back to it in step 3, so that runtimes that don't run at the
+/// same time can share it.
+
+/// Idle memory planner buffers shared by StaticRuntimes. Only the buffers of
+/// the runs in progress are in use, so the arena holds about as many buffers
+/// as there are concurrent runs, however many runtimes use it. Thread safe.
+class TORCH_API StaticRuntimeArena {
+ public:
+  StaticRuntimeArena() = default;
+  StaticRuntimeArena(const StaticRuntimeArena&) = delete;
+  StaticRuntimeArena& operator=(const StaticRuntimeArena&) = delete;
+
+  // Returns the smallest idle buffer of at least size bytes, or a new one,
+  // and sets capacity to its size.
+  at::DataPtr acquire(size_t size, size_t& capacity);
+
+  // Makes a buffer returned by acquire() idle again
+  void release(at::DataPtr buffer, size_t capacity);
+
+  // Frees the buffers that have been idle for at least idle_time, returns the
+  // number of bytes freed.
+  size_t shrink(std::chrono::steady_clock::duration idle_time =
+                    std::chrono::steady_clock::duration::zero());
+
+  size_t idle_bytes() const;
+
+ private:
+  struct IdleBuffer {
+    at::DataPtr buffer;
+    size_t capacity;
+    std::chrono::steady_clock::time_point released;
+  };
+
+  mutable std::mutex mutex_;
+  std::vector<IdleBuffer> idle_;
+  size_t idle_bytes_{0};
+};
 
 class MemoryPlanner {
  public:
@@ -266,7 +368,10 @@ class MemoryPlanner {
       StaticRuntime* runtime,
       const std::unordered_map<const Value*, std::vector<const Value*>>&,
       const std::unordered_set<const Value*>& external_values,
-      bool out_variants);
+      bool out_variants,
+      const std::unordered_map<const Value*, std::pair<size_t, size_t>>&
+          value_lifetimes = {},
+      std::shared_ptr<StaticRuntimeArena> arena = nullptr);
 
   void allocate();
   void deallocate();
@@ -287,7 +392,19 @@ class MemoryPlanner {
   size_t managed_bytes_{0};
   size_t reused_tensors_{0};
   at::DataPtr buffer_; // allocated each time we call Run()
-
+  // Only used with an arena: the buffer comes from it, and may be larger than
+  // managed_bytes_.
+  std::shared_ptr<StaticRuntimeArena> arena_;
+  size_t buffer_capacity_{0};
+
+  // Only used for lifetime based planning. Both are parallel to
+  // managed_storage_: the closed interval of node indices during which the
+  // storage is alive, and its offset into buffer_.
+  bool plan_by_lifetime_{false};
+  std::vector<std::pair<size_t, size_t>> managed_lifetimes_;
+  std::vector<size_t> managed_offsets_;
+
+  void plan_offsets_by_lifetime();
   static size_t compute_aligned_tensor_size(size_t nbytes);
   static at::DataPtr allocate_buffer(size_t size);
 };
@@ -334,6 +451,10 @@ class ProcessedNode {
     return static_cast<bool>(fn_);
   }
 
+  bool has_native_fn() const {
+    return !fn_ && static_cast<bool>(native_fn_);
+  }
+
  private:
   Node* node_;
   c10::optional<Operation> op_;
@@ -33,7 +33,33 @@ void initStaticModuleBindings(PyObject* module) {
           &StaticRuntime::IndividualMetrics::percent_per_node_type)
       .def_readonly(
           "instances_per_node_type",
-          &StaticRuntime::IndividualMetrics::instances_per_node_type);
+          &StaticRuntime::IndividualMetrics::instances_per_node_type)
+      .def_readonly(
+          "out_nodes_count", &StaticRuntime::IndividualMetrics::out_nodes_count)
+      .def_readonly(
+          "native_nodes_count",
+          &StaticRuntime::IndividualMetrics::native_nodes_count)
+      .def_readonly(
+          "total_nodes_count",
+          &StaticRuntime::IndividualMetrics::total_nodes_count)
+      .def_readonly(
+          "out_instances_per_node_type",
+          &StaticRuntime::IndividualMetrics::out_instances_per_node_type)
+      .def_readonly(
+          "native_instances_per_node_type",
+          &StaticRuntime::IndividualMetrics::native_instances_per_node_type)
+      .def_readonly(
+          "alloc_bytes_per_node",
+          &StaticRuntime::IndividualMetrics::alloc_bytes_per_node)
+      .def_readonly(
+          "allocs_per_node", &StaticRuntime::IndividualMetrics::allocs_per_node)
+      .def_readonly(
+          "alloc_bytes_per_node_type",
+          &StaticRuntime::IndividualMetrics::alloc_bytes_per_node_type)
+      .def_readonly(
+          "allocs_per_node_type",
+          &StaticRuntime::IndividualMetrics::allocs_per_node_type)
+      .def("to_json", &StaticRuntime::IndividualMetrics::to_json);
   static_module
       .def(
           "__call__",
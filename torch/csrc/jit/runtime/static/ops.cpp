@@ -7,11 +7,14 @@
 #include <ATen/native/IndexingUtils.h>
 #include <ATen/native/Resize.h>
 #include <ATen/native/TensorAdvancedIndexing.h>
+#include <ATen/native/quantized/cpu/packed_params.h>
 #include <ATen/native/quantized/cpu/qembeddingbag.h>
 #include <torch/csrc/jit/ir/ir.h>
+#include <torch/csrc/jit/runtime/interpreter.h>
 #include <torch/csrc/jit/runtime/vararg_functions.h>
 #include <torch/csrc/jit/tensorexpr/ir.h>
 #include <torch/csrc/jit/tensorexpr/ir_simplifier.h>
+#include <torch/csrc/jit/tensorexpr/kernel.h>
 #include <torch/csrc/jit/tensorexpr/llvm_codegen.h>
 #include <torch/csrc/jit/tensorexpr/loopnest.h>
 
@@ -249,6 +252,76 @@ REGISTER_OPERATOR_FUNCTOR(
       };
     });
 
+// Groups created by performTensorExprFusion. The kernel is compiled for the
+// shapes of the first run, and specialized for the other shapes it sees; the
+// interpreter runs the subgraph when NNC can't handle the inputs. The state is
+// shared by the StaticRuntime instances of all threads.
+REGISTER_OPERATOR_FUNCTOR(
+    prim::TensorExprGroup,
+    prim_TensorExprGroup,
+    [](Node* n) -> SROperator {
+      struct State {
+        std::shared_ptr<Graph> subgraph;
+        Code code;
+        std::mutex mutex;
+        bool compiled{false};
+        std::shared_ptr<tensorexpr::TensorExprKernel> kernel;
+
+        explicit State(std::shared_ptr<Graph> g)
+            : subgraph(std::move(g)), code(subgraph, "") {}
+
+        std::shared_ptr<tensorexpr::TensorExprKernel> getKernel(
+            const std::vector<IValue>& inputs) {
+          std::lock_guard<std::mutex> guard(mutex);
+          if (!compiled) {
+            kernel = tensorexpr::TensorExprKernel::createForInputs(
+                subgraph, inputs);
+            compiled = true;
+          }
+          return kernel;
+        }
+      };
+      auto state = std::make_shared<State>(n->g(attr::Subgraph));
+      return [state](ProcessedNode* p_node) {
+        const size_t num_inputs = p_node->inputs().size();
+        const size_t num_outputs = p_node->outputs().size();
+        std::vector<IValue> inputs;
+        inputs.reserve(num_inputs);
+        for (size_t i = 0; i < num_inputs; i++) {
+          inputs.push_back(p_node->Input(i));
+        }
+        std::vector<at::Tensor> results(num_outputs);
+        for (size_t i = 0; i < num_outputs; i++) {
+          if (!p_node->Output(i).isNone()) {
+            results[i] = p_node->Output(i).toTensor();
+          }
+        }
+
+        auto kernel = state->getKernel(inputs);
+        if (!kernel || !kernel->runWithOutputs(inputs, results)) {
+          Stack stack(std::move(inputs));
+          InterpreterState(state->code).run(stack);
+          for (size_t i = 0; i < num_outputs; i++) {
+            results[i] = stack[i].toTensor();
+          }
+        }
+
+        // The memory planner keeps the storages of the outputs, so they are
+        // written in place rather than replaced once they exist.
+        for (size_t i = 0; i < num_outputs; i++) {
+          if (p_node->Output(i).isNone()) {
+            p_node->Output(i) = std::move(results[i]);
+            continue;
+          }
+          auto& out_t = p_node->Output(i).toTensor();
+          if (!out_t.is_same(results[i])) {
+            at::native::resize_(out_t, results[i].sizes());
+            out_t.copy_(results[i]);
+          }
+        }
+      };
+    });
+
 REGISTER_OPERATOR_FUNCTOR(aten::add, aten_add, [](Node* n) -> SROperator {
   return [](ProcessedNode* p_node) {
     const auto& in0_t = p_node->Input(0).toTensor();
@@ -708,6 +781,76 @@ REGISTER_OPERATOR_FUNCTOR(
       };
     });
 
+REGISTER_OPERATOR_FUNCTOR(
+    quantized::linear_dynamic,
+    quantized_linear_dynamic,
+    [](Node* n) -> SROperator {
+      return [](ProcessedNode* p_node) {
+        const auto& input = p_node->Input(0).toTensor();
+        const auto packed_weight =
+            p_node->Input(1).toCustomClass<LinearPackedParamsBase>();
+        const auto reduce_range = p_node->Input(2).toBool();
+        if (p_node->Output(0).isNone()) {
+          p_node->Output(0) = create_empty_from(input, at::kFloat);
+        }
+        auto& out_t = p_node->Output(0).toTensor();
+        fastResizeToZero(out_t);
+        packed_weight->apply_dynamic_out(input, out_t, reduce_range);
+      };
+    });
+
+REGISTER_OPERATOR_FUNCTOR(
+    quantized::linear_relu_dynamic,
+    quantized_linear_relu_dynamic,
+    [](Node* n) -> SROperator {
+      return [](ProcessedNode* p_node) {
+        const auto& input = p_node->Input(0).toTensor();
+        const auto packed_weight =
+            p_node->Input(1).toCustomClass<LinearPackedParamsBase>();
+        const auto reduce_range = p_node->Input(2).toBool();
+        if (p_node->Output(0).isNone()) {
+          p_node->Output(0) = create_empty_from(input, at::kFloat);
+        }
+        auto& out_t = p_node->Output(0).toTensor();
+        fastResizeToZero(out_t);
+        packed_weight->apply_dynamic_relu_out(input, out_t, reduce_range);
+      };
+    });
+
+REGISTER_OPERATOR_FUNCTOR(
+    quantized::linear_dynamic_fp16,
+    quantized_linear_dynamic_fp16,
+    [](Node* n) -> SROperator {
+      return [](ProcessedNode* p_node) {
+        const auto& input = p_node->Input(0).toTensor();
+        const auto packed_weight =
+            p_node->Input(1).toCustomClass<LinearPackedParamsBase>();
+        if (p_node->Output(0).isNone()) {
+          p_node->Output(0) = create_empty_from(input, at::kFloat);
+        }
+        auto& out_t = p_node->Output(0).toTensor();
+        fastResizeToZero(out_t);
+        packed_weight->apply_dynamic_out(input, out_t);
+      };
+    });
+
+REGISTER_OPERATOR_FUNCTOR(
+    quantized::linear_relu_dynamic_fp16,
+    quantized_linear_relu_dynamic_fp16,
+    [](Node* n) -> SROperator {
+      return [](ProcessedNode* p_node) {
+        const auto& input = p_node->Input(0).toTensor();
+        const auto packed_weight =
+            p_node->Input(1).toCustomClass<LinearPackedParamsBase>();
+        if (p_node->Output(0).isNone()) {
+          p_node->Output(0) = create_empty_from(input, at::kFloat);
+        }
+        auto& out_t = p_node->Output(0).toTensor();
+        fastResizeToZero(out_t);
+        packed_weight->apply_dynamic_relu_out(input, out_t);
+      };
+    });
+
 // The out variant takes precedence over native
 REGISTER_OPERATOR_FUNCTOR(
     aten::narrow_copy,
@@ -0,0 +1,124 @@
+#include <torch/csrc/jit/runtime/static/pool.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace torch {
+namespace jit {
+
+StaticRuntimePool::StaticRuntimePool(
+    std::shared_ptr<StaticModule> sm,
+    const StaticRuntimePoolOptions& opts)
+    : module_(std::move(sm)),
+      opts_(opts),
+      arena_(
+          opts.share_arena ? std::make_shared<StaticRuntimeArena>() : nullptr),
+      last_shrink_(std::chrono::steady_clock::now()) {
+  TORCH_CHECK(module_, "StaticRuntimePool needs a StaticModule");
+}
+
+void StaticRuntimePool::Checkin::operator()(StaticRuntime* runtime) const {
+  pool->release(runtime);
+}
+
+StaticRuntimePool::Handle StaticRuntimePool::acquire() {
+  maybeShrink();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!idle_.empty()) {
+      // the most recently used runtime, whose memory is the most likely to
+      // still be in the caches
+      auto runtime = std::move(idle_.back().runtime);
+      idle_.pop_back();
+      return Handle(runtime.release(), Checkin{this});
+    }
+    ++num_runtimes_;
+  }
+  // Created outside of the lock, the runtimes are independent of each other
+  try {
+    return Handle(new StaticRuntime(*module_, arena_), Checkin{this});
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    --num_runtimes_;
+    throw;
+  }
+}
+
+void StaticRuntimePool::release(StaticRuntime* runtime) {
+  std::unique_ptr<StaticRuntime> owned(runtime);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (idle_.size() < opts_.max_idle_runtimes) {
+      idle_.push_back({std::move(owned), std::chrono::steady_clock::now()});
+    } else {
+      --num_runtimes_;
+    }
+  }
+  // destroys the runtime outside of the lock if it wasn't kept
+  owned.reset();
+  maybeShrink();
+}
+
+std::vector<at::Tensor> StaticRuntimePool::operator()(
+    const std::vector<at::Tensor>& inps) {
+  auto runtime = acquire();
+  return (*runtime)(inps);
+}
+
+c10::IValue StaticRuntimePool::operator()(
+    const std::vector<c10::IValue>& args,
+    const std::unordered_map<std::string, c10::IValue>& kwargs) {
+  auto runtime = acquire();
+  return (*runtime)(args, kwargs);
+}
+
+size_t StaticRuntimePool::shrink(
+    std::chrono::steady_clock::duration idle_time) {
+  const auto now = std::chrono::steady_clock::now();
+  std::vector<IdleRuntime> freed;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    last_shrink_ = now;
+    // idle_ is ordered by check in time, the oldest first
+    auto it = std::find_if(
+        idle_.begin(), idle_.end(), [&](const IdleRuntime& r) {
+          return now - r.released < idle_time;
+        });
+    std::move(idle_.begin(), it, std::back_inserter(freed));
+    idle_.erase(idle_.begin(), it);
+    num_runtimes_ -= freed.size();
+  }
+  // the runtimes are destroyed here, outside of the lock
+  freed.clear();
+  return arena_ ? arena_->shrink(idle_time) : 0;
+}
+
+void StaticRuntimePool::maybeShrink() {
+  if (opts_.max_idle_time.count() == 0) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (std::chrono::steady_clock::now() - last_shrink_ < opts_.max_idle_time) {
+      return;
+    }
+  }
+  shrink(opts_.max_idle_time);
+}
+
+size_t StaticRuntimePool::num_runtimes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_runtimes_;
+}
+
+size_t StaticRuntimePool::num_idle_runtimes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return idle_.size();
+}
+
+size_t StaticRuntimePool::idle_arena_bytes() const {
+  return arena_ ? arena_->idle_bytes() : 0;
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <torch/csrc/jit/runtime/static/impl.h>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+struct TORCH_API StaticRuntimePoolOptions {
+  // If true, the runtimes of the pool share one StaticRuntimeArena, so that
+  // only the runs in progress hold memory planner buffers.
+  bool share_arena{true};
+  // Idle runtimes beyond this number are destroyed when checked back in
+  size_t max_idle_runtimes{64};
+  // Idle runtimes and arena buffers that haven't been used for this long are
+  // freed by the next check out or check in. Zero disables it, shrink() can
+  // still be called explicitly.
+  std::chrono::milliseconds max_idle_time{0};
+};
+
+/// Hands out the StaticRuntimes of a StaticModule per request, so that a
+/// serving process doesn't need one StaticRuntime per thread.
+///
+/// Runtimes are checked out by acquire(), reusing the most recently checked in
+/// one, and checked back in when the returned handle goes away. With
+/// share_arena, the memory planners of the runtimes take their buffers from
+/// one arena for the duration of a run, so the memory held by the pool follows
+/// the number of concurrent runs rather than the number of runtimes.
+///
+/// @code
+///   auto smodule = std::make_shared<StaticModule>(m);
+///   StaticRuntimePool pool(smodule);
+///   // from any number of threads
+///   auto outputs = pool(args, kwargs);
+///   // or, to keep the runtime for longer
+///   auto runtime = pool.acquire();
+///   auto outputs = (*runtime)(args, kwargs);
+/// @endcode
+///
+/// The pool must outlive the handles it returned.
+class TORCH_API StaticRuntimePool {
+ public:
+  explicit StaticRuntimePool(
+      std::shared_ptr<StaticModule> sm,
+      const StaticRuntimePoolOptions& opts = StaticRuntimePoolOptions());
+
+  StaticRuntimePool(const StaticRuntimePool&) = delete;
+  StaticRuntimePool& operator=(const StaticRuntimePool&) = delete;
+
+  struct TORCH_API Checkin {
+    StaticRuntimePool* pool;
+    void operator()(StaticRuntime* runtime) const;
+  };
+  using Handle = std::unique_ptr<StaticRuntime, Checkin>;
+
+  // Checks out an idle runtime, or a new one if there is none
+  Handle acquire();
+
+  // Run the module on a runtime checked out for the call
+  std::vector<at::Tensor> operator()(const std::vector<at::Tensor>& inps);
+  c10::IValue operator()(
+      const std::vector<c10::IValue>& args,
+      const std::unordered_map<std::string, c10::IValue>& kwargs);
+
+  // Frees the runtimes and the arena buffers that have been idle for at least
+  // idle_time, returns the number of arena bytes freed.
+  size_t shrink(std::chrono::steady_clock::duration idle_time =
+                    std::chrono::steady_clock::duration::zero());
+
+  const StaticRuntimePoolOptions& opts() const {
+    return opts_;
+  }
+
+  // For monitoring: the runtimes alive (idle or checked out), the idle
+  // runtimes, and the bytes held by idle arena buffers.
+  size_t num_runtimes() const;
+  size_t num_idle_runtimes() const;
+  size_t idle_arena_bytes() const;
+
+ private:
+  struct IdleRuntime {
+    std::unique_ptr<StaticRuntime> runtime;
+    std::chrono::steady_clock::time_point released;
+  };
+
+  void release(StaticRuntime* runtime);
+  // Calls shrink(max_idle_time) at most every max_idle_time
+  void maybeShrink();
+
+  std::shared_ptr<StaticModule> module_;
+  StaticRuntimePoolOptions opts_;
+  std::shared_ptr<StaticRuntimeArena> arena_;
+
+  mutable std::mutex mutex_;
+  // Most recently checked in last
+  std::vector<IdleRuntime> idle_;
+  size_t num_runtimes_{0};
+  std::chrono::steady_clock::time_point last_shrink_;
+};
+
+} // namespace jit
+} // namespace torch
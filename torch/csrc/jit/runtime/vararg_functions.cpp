@@ -100,7 +100,17 @@ void addFormattedArg(
 
 void tupleUnpack(Stack& stack) {
   auto tuple = pop(stack).toTuple();
-  stack.insert(stack.end(), tuple->elements().begin(), tuple->elements().end());
+  auto& elems = tuple->elements();
+  if (tuple.use_count() == 1) {
+    // Nothing else refers to the tuple, e.g. it was just constructed to be
+    // returned, so its elements can be moved instead of copied
+    stack.insert(
+        stack.end(),
+        std::make_move_iterator(elems.begin()),
+        std::make_move_iterator(elems.end()));
+  } else {
+    stack.insert(stack.end(), elems.begin(), elems.end());
+  }
 }
 
 void format(Stack& stack, size_t num_inputs) {
@@ -265,10 +275,14 @@ void isinstance(Stack& stack, at::ArrayRef<at::TypePtr> types) {
 
 void tupleSlice(Stack& stack, size_t begin, size_t end) {
   auto tuple = pop(stack).toTuple();
+  auto& elems = tuple->elements();
   std::vector<IValue> output_elems;
-  output_elems.reserve(end - begin);
-  for (size_t i = begin; i < end; ++i) {
-    output_elems.emplace_back(tuple->elements()[i]);
+  if (tuple.use_count() == 1) {
+    output_elems.assign(
+        std::make_move_iterator(elems.begin() + begin),
+        std::make_move_iterator(elems.begin() + end));
+  } else {
+    output_elems.assign(elems.begin() + begin, elems.begin() + end);
   }
   push(stack, c10::ivalue::Tuple::create(std::move(output_elems)));
 }
@@ -4,6 +4,7 @@
 #include <torch/csrc/jit/ir/attributes.h>
 #include <torch/csrc/jit/ir/ir.h>
 #include <torch/csrc/jit/ir/type_hashing.h>
+#include <torch/csrc/jit/mobile/flat_bytecode.h>
 #include <torch/csrc/jit/mobile/function.h>
 #include <torch/csrc/jit/mobile/interpreter.h>
 #include <torch/csrc/jit/mobile/method.h>
@@ -16,6 +17,7 @@
 #include <torch/csrc/jit/serialization/python_print.h>
 #include <torch/csrc/jit/serialization/source_range_serialization.h>
 #include <torch/csrc/jit/serialization/type_name_uniquer.h>
+#include <torch/csrc/jit/tensorexpr/aot_cache.h>
 
 #include <caffe2/serialize/inline_container.h>
 
@@ -24,6 +26,7 @@
 #include <ATen/core/jit_type.h>
 #include <ATen/core/qualified_name.h>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace torch {
@@ -31,6 +34,189 @@ namespace jit {
 
 char const* toString(OpCode op);
 
+// Writes the methods of bytecode.pkl once more as bytecode.flat, see
+// torch/csrc/jit/mobile/flat_bytecode.h
+class FlatBytecodeWriter {
+ public:
+  void writeFunction(
+      const std::string& name,
+      const std::vector<Instruction>& instructions,
+      const std::vector<c10::OperatorName>& opnames,
+      const std::vector<IValue>& constants,
+      const std::vector<TypePtr>& types,
+      size_t register_size,
+      const c10::FunctionSchema& schema,
+      const std::vector<std::string>& op_module_paths) {
+    offsets_.push_back(functions_.size());
+    functions_.writeString(name);
+
+    functions_.write<uint32_t>(instructions.size());
+    for (const Instruction& ins : instructions) {
+      functions_.write<uint8_t>(opcodeIndex(ins.op));
+      functions_.write<uint8_t>(0);
+      functions_.write<uint16_t>(ins.N);
+      functions_.write<int32_t>(ins.X);
+    }
+
+    functions_.write<uint32_t>(opnames.size());
+    for (const auto& opname : opnames) {
+      functions_.writeString(opname.name);
+      functions_.writeString(opname.overload_name);
+    }
+
+    functions_.write<uint32_t>(constants.size());
+    for (const auto& constant : constants) {
+      writeConstant(constant);
+    }
+
+    functions_.write<uint32_t>(types.size());
+    for (const auto& type : types) {
+      writeType(type);
+    }
+
+    functions_.write<uint32_t>(register_size);
+
+    for (const auto* args : {&schema.arguments(), &schema.returns()}) {
+      functions_.write<uint32_t>(args->size());
+      for (const auto& arg : *args) {
+        functions_.writeString(arg.name());
+        writeType(arg.type());
+        writeConstant(arg.default_value() ? *arg.default_value() : IValue());
+      }
+    }
+
+    functions_.write<uint32_t>(op_module_paths.size());
+    for (const auto& path : op_module_paths) {
+      functions_.writeString(path);
+    }
+  }
+
+  // The contents of bytecode.flat
+  std::string finish(int64_t bytecode_version) const {
+    mobile::FlatBytecodeBuffer header;
+    header.write<uint32_t>(mobile::kFlatBytecodeMagic);
+    header.write<uint32_t>(mobile::kFlatBytecodeVersion);
+    header.write<int64_t>(bytecode_version);
+    header.write<uint32_t>(opcode_names_.size());
+    for (const auto& opcode_name : opcode_names_) {
+      header.writeString(opcode_name);
+    }
+    header.write<uint32_t>(offsets_.size());
+    const uint64_t header_size =
+        header.size() + offsets_.size() * sizeof(uint64_t);
+    for (uint64_t offset : offsets_) {
+      header.write<uint64_t>(header_size + offset);
+    }
+    return header.data() + functions_.data();
+  }
+
+  // The constants that are not scalars, written to bytecode_constants.pkl
+  const std::vector<IValue>& pickledConstants() const {
+    return pickled_constants_;
+  }
+
+ private:
+  uint8_t opcodeIndex(OpCode op) {
+    auto it = opcode_indices_.find(op);
+    if (it == opcode_indices_.end()) {
+      TORCH_INTERNAL_ASSERT(opcode_names_.size() <= UINT8_MAX);
+      it = opcode_indices_.emplace(op, opcode_names_.size()).first;
+      opcode_names_.emplace_back(toString(op));
+    }
+    return it->second;
+  }
+
+  void writeConstant(const IValue& value) {
+    using Tag = mobile::FlatConstantTag;
+    if (value.isNone()) {
+      functions_.write(Tag::None);
+    } else if (value.isInt()) {
+      functions_.write(Tag::Int);
+      functions_.write<int64_t>(value.toInt());
+    } else if (value.isDouble()) {
+      functions_.write(Tag::Double);
+      functions_.write<double>(value.toDouble());
+    } else if (value.isBool()) {
+      functions_.write(Tag::Bool);
+      functions_.write<uint8_t>(value.toBool());
+    } else if (value.isString()) {
+      functions_.write(Tag::String);
+      functions_.writeString(value.toStringRef());
+    } else {
+      functions_.write(Tag::Pickled);
+      functions_.write<uint32_t>(pickled_constants_.size());
+      pickled_constants_.push_back(value);
+    }
+  }
+
+  void writeType(const TypePtr& type) {
+    using Tag = mobile::FlatTypeTag;
+    switch (type->kind()) {
+      case TypeKind::TensorType:
+        functions_.write(Tag::Tensor);
+        return;
+      case TypeKind::IntType:
+        functions_.write(Tag::Int);
+        return;
+      case TypeKind::FloatType:
+        functions_.write(Tag::Float);
+        return;
+      case TypeKind::BoolType:
+        functions_.write(Tag::Bool);
+        return;
+      case TypeKind::StringType:
+        functions_.write(Tag::String);
+        return;
+      case TypeKind::NoneType:
+        functions_.write(Tag::None);
+        return;
+      case TypeKind::DeviceObjType:
+        functions_.write(Tag::Device);
+        return;
+      case TypeKind::NumberType:
+        functions_.write(Tag::Number);
+        return;
+      case TypeKind::AnyType:
+        functions_.write(Tag::Any);
+        return;
+      case TypeKind::OptionalType:
+        functions_.write(Tag::Optional);
+        writeType(type->expect<c10::OptionalType>()->getElementType());
+        return;
+      case TypeKind::ListType:
+        functions_.write(Tag::List);
+        writeType(type->expect<c10::ListType>()->getElementType());
+        return;
+      case TypeKind::DictType:
+        functions_.write(Tag::Dict);
+        writeType(type->expect<c10::DictType>()->getKeyType());
+        writeType(type->expect<c10::DictType>()->getValueType());
+        return;
+      case TypeKind::TupleType:
+        // named tuples are written by name
+        if (!type->expect<c10::TupleType>()->name()) {
+          functions_.write(Tag::Tuple);
+          functions_.write<uint32_t>(type->containedTypes().size());
+          for (const auto& element : type->containedTypes()) {
+            writeType(element);
+          }
+          return;
+        }
+        break;
+      default:
+        break;
+    }
+    functions_.write(Tag::Annotation);
+    functions_.writeString(type->annotation_str());
+  }
+
+  mobile::FlatBytecodeBuffer functions_;
+  std::vector<uint64_t> offsets_;
+  std::vector<std::string> opcode_names_;
+  std::unordered_map<int, uint8_t> opcode_indices_;
+  std::vector<IValue> pickled_constants_;
+};
+
 namespace {
 
 ExportModuleExtraFilesHook& GetExtraFilesHook() {
@@ -109,12 +295,14 @@ std::string getModuleTypeName(const Module& module, const std::string& prefix) {
 std::pair<IValue, c10::optional<IValue>> getFunctionTuple(
     const Module& module,
     const Function& func,
-    bool save_mobile_debug_info) {
+    bool save_mobile_debug_info,
+    FlatBytecodeWriter* flat_writer) {
   auto graph = func.graph()->copy();
 
   Inline(*graph);
 
-  torch::jit::Code code(graph, func.name());
+  torch::jit::Code code(
+      graph, func.name(), 0, /*emit_superinstructions=*/false);
   auto instructions_copy = code.instructions();
 
   // operator names
@@ -272,6 +460,18 @@ std::pair<IValue, c10::optional<IValue>> getFunctionTuple(
       {"returns", makeArgTuple(schema.returns())},
   });
 
+  if (flat_writer) {
+    flat_writer->writeFunction(
+        func.qualname().qualifiedName(),
+        instructions_copy,
+        opnames,
+        constants,
+        code.type_table(),
+        register_size,
+        schema,
+        op_module_paths);
+  }
+
   // function tuple
   auto bytecode_vals =
       Tup({func.qualname().qualifiedName(), codeTable, schemaTable});
@@ -295,7 +495,8 @@ void setstateTuple(
     const IValue& ivalue,
     std::vector<c10::IValue>& elements,
     c10::optional<std::vector<c10::IValue>>& debug_info_elements,
-    bool save_mobile_debug_info) {
+    bool save_mobile_debug_info,
+    FlatBytecodeWriter* flat_writer) {
   if (!ivalue.isObject())
     return;
   auto obj = ivalue.toObject();
@@ -303,8 +504,8 @@ void setstateTuple(
   if (checkHasValidSetGetState(type)) {
     Function& setstate = type->getMethod("__setstate__");
     if (setstate.isGraphFunction()) {
-      auto func_tuple =
-          getFunctionTuple(module, setstate, save_mobile_debug_info);
+      auto func_tuple = getFunctionTuple(
+          module, setstate, save_mobile_debug_info, flat_writer);
       elements.push_back(func_tuple.first);
       if (save_mobile_debug_info) {
         debug_info_elements->push_back(func_tuple.second.value());
@@ -317,7 +518,8 @@ void setstateTuple(
           obj->getSlot(i),
           elements,
           debug_info_elements,
-          save_mobile_debug_info);
+          save_mobile_debug_info,
+          flat_writer);
     }
   }
 }
@@ -327,12 +529,13 @@ void moduleMethodsTuple(
     const Module& module,
     std::vector<c10::IValue>& elements, // note: appended to in-place
     c10::optional<std::vector<c10::IValue>>& debug_info_elements,
-    bool save_mobile_debug_info) {
+    bool save_mobile_debug_info,
+    FlatBytecodeWriter* flat_writer = nullptr) {
   auto methods = module.get_methods();
   // top level methods
   for (const auto& method : methods) {
-    auto func_tuple =
-        getFunctionTuple(module, method.function(), save_mobile_debug_info);
+    auto func_tuple = getFunctionTuple(
+        module, method.function(), save_mobile_debug_info, flat_writer);
     elements.push_back(func_tuple.first);
     if (save_mobile_debug_info) {
       debug_info_elements->push_back(func_tuple.second.value());
@@ -345,7 +548,8 @@ void moduleMethodsTuple(
       module._ivalue(),
       elements,
       debug_info_elements,
-      save_mobile_debug_info);
+      save_mobile_debug_info,
+      flat_writer);
 }
 
 void SetExportModuleExtraFilesHook(ExportModuleExtraFilesHook hook) {
@@ -373,8 +577,13 @@ class ScriptModuleSerializer {
       bool save_mobile_debug_info) {
     C10_LOG_API_USAGE_ONCE("torch.script.save");
     writeExtraFiles(module, extra_files);
+    // Embed the fused kernels compiled while recording was enabled.
+    auto& aot_kernels = tensorexpr::AOTKernelCache::get();
+    if (aot_kernels.recording()) {
+      aot_kernels.writeTo(writer_);
+    }
     // Serialize the model object
-    writeArchive("data", module._ivalue());
+    writeArchive("data", module._ivalue(), /*pack_primitive_lists=*/true);
     // Then we serialize all code info.
     writeCode(module.type());
     // The tensor constants from the code are written to a separate archive
@@ -394,7 +603,10 @@ class ScriptModuleSerializer {
   }
 
  private:
-  void writeArchive(const std::string& archive_name, const IValue& value) {
+  void writeArchive(
+      const std::string& archive_name,
+      const IValue& value,
+      bool pack_primitive_lists = false) {
     std::vector<char> data;
     // Vector to capture the run-time class types during pickling the IValues
     std::vector<c10::ClassTypePtr> memoizedClassTypes;
@@ -407,9 +619,13 @@ class ScriptModuleSerializer {
           return type_name_uniquer_.getUniqueName(t);
         },
         &memoizedClassTypes);
+    data_pickle.setPackPrimitiveLists(pack_primitive_lists);
     data_pickle.protocol();
     data_pickle.pushIValue(value);
     data_pickle.stop();
+    if (data_pickle.wrotePackedLists()) {
+      writer_.setMinVersion(caffe2::serialize::kMinVersionForPackedLists);
+    }
     size_t i = 0;
     std::string prefix = archive_name + "/";
     for (const auto& td : data_pickle.tensorData()) {
@@ -522,10 +738,22 @@ class ScriptModuleSerializer {
           static_cast<int64_t>(caffe2::serialize::kProducedBytecodeVersion));
     }
 
+    FlatBytecodeWriter flat_writer;
     moduleMethodsTuple(
-        module, elements, debug_info_elements, save_mobile_debug_info);
+        module,
+        elements,
+        debug_info_elements,
+        save_mobile_debug_info,
+        &flat_writer);
     auto telements = Tup(std::move(elements));
     writeArchive("bytecode", telements);
+    // Loaded instead of bytecode.pkl by the runtimes that know the format
+    std::string flat = flat_writer.finish(
+        static_cast<int64_t>(caffe2::serialize::kProducedBytecodeVersion));
+    writer_.writeRecord("bytecode.flat", flat.data(), flat.size());
+    if (!flat_writer.pickledConstants().empty()) {
+      writeArchive("bytecode_constants", Tup(flat_writer.pickledConstants()));
+    }
     if (save_mobile_debug_info) {
       auto debug_info_telements = Tup(std::move(debug_info_elements.value()));
       writeArchive("mobile_debug", debug_info_telements);
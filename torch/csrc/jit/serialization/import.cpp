@@ -14,12 +14,14 @@
 #include <torch/csrc/jit/serialization/pickle.h>
 #include <torch/csrc/jit/serialization/source_range_serialization.h>
 #include <torch/csrc/jit/serialization/unpickler.h>
+#include <torch/csrc/jit/tensorexpr/aot_cache.h>
 
 #include <caffe2/serialize/file_adapter.h>
 #include <caffe2/serialize/inline_container.h>
 #include <caffe2/serialize/istream_adapter.h>
 
 #include <ATen/ATen.h>
+#include <ATen/Parallel.h>
 #include <fmt/format.h>
 
 #include <fstream>
@@ -58,6 +60,46 @@ void postSetStateValidate(const IValue& v) {
   }
 }
 
+namespace {
+
+// Names of the records under prefix, relative to prefix
+std::vector<std::string> recordsUnder(
+    PyTorchStreamReader& stream_reader,
+    const std::string& prefix) {
+  std::vector<std::string> names;
+  for (const auto& record : stream_reader.getAllRecords()) {
+    if (record.compare(0, prefix.size(), prefix) == 0) {
+      names.push_back(record.substr(prefix.size()));
+    }
+  }
+  return names;
+}
+
+// Reads (and CRC checks) all the given records under prefix in parallel
+// instead of one at a time as the unpickler asks for them, keyed by their
+// name relative to prefix
+std::unordered_map<std::string, at::DataPtr> readRecordsInParallel(
+    PyTorchStreamReader& stream_reader,
+    const std::string& prefix,
+    std::vector<std::string> names) {
+  std::unordered_map<std::string, at::DataPtr> records;
+  if (names.size() < 2) {
+    return records;
+  }
+  std::vector<at::DataPtr> data_ptrs(names.size());
+  at::parallel_for(0, names.size(), 1, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      data_ptrs[i] = std::get<0>(stream_reader.getRecord(prefix + names[i]));
+    }
+  });
+  for (size_t i = 0; i < names.size(); ++i) {
+    records.emplace(std::move(names[i]), std::move(data_ptrs[i]));
+  }
+  return records;
+}
+
+} // namespace
+
 IValue readArchiveAndTensors(
     const std::string& archive_name,
     c10::optional<TypeResolver> type_resolver,
@@ -65,6 +107,16 @@ IValue readArchiveAndTensors(
     c10::optional<at::Device> device,
     PyTorchStreamReader& stream_reader) {
   std::string picklename = archive_name + ".pkl";
+  std::string archive_name_plus_slash = archive_name + "/";
+  auto tensor_names = recordsUnder(stream_reader, archive_name_plus_slash);
+  // Lets adapters that read slowly, e.g. RangeReadAdapter, start fetching the
+  // tensors while the pickle is read
+  std::vector<std::string> record_names = {picklename};
+  for (const auto& name : tensor_names) {
+    record_names.push_back(archive_name_plus_slash + name);
+  }
+  stream_reader.prefetchRecords(record_names);
+
   at::DataPtr pickle_ptr;
   size_t pickle_size;
   std::tie(pickle_ptr, pickle_size) = stream_reader.getRecord(picklename);
@@ -83,8 +135,20 @@ IValue readArchiveAndTensors(
     return len;
   };
 
-  std::string archive_name_plus_slash = archive_name + "/";
+  std::unordered_map<std::string, at::DataPtr> prefetched;
+  // Tensors that are moved to another device are released one by one while
+  // unpickling, prefetching them all would hold the whole archive in memory
+  if (!device || device->is_cpu()) {
+    prefetched = readRecordsInParallel(
+        stream_reader, archive_name_plus_slash, std::move(tensor_names));
+  }
   auto read_record = [&](const std::string& name) {
+    auto it = prefetched.find(name);
+    if (it != prefetched.end()) {
+      at::DataPtr data_ptr = std::move(it->second);
+      prefetched.erase(it);
+      return data_ptr;
+    }
     std::string ss = archive_name_plus_slash + name;
     return std::get<0>(stream_reader.getRecord(ss));
   };
@@ -256,6 +320,8 @@ Module ScriptModuleDeserializer::deserialize(
           std::string(static_cast<char*>(meta_ptr.get()), meta_size);
     }
   }
+  // Make the fused kernels compiled ahead of time available to the fuser.
+  tensorexpr::AOTKernelCache::get().readFrom(*reader_);
   if (reader_->hasRecord("model.json")) {
 #if !defined(C10_MOBILE) && !defined(C10_DISABLE_LEGACY_IMPORT)
     return torch::jit::LEGACY_deserialize(compilation_unit_, reader_, device_);
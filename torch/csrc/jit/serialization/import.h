@@ -80,6 +80,10 @@ TORCH_API Module load(
 /// The reader adapter, which is for customized input stream, must contain a
 /// serialized `Module`, exported either via `ScriptModule.save()` in
 /// Python or `torch::jit::ExportModule` in C++.
+///
+/// Passing a `caffe2::serialize::MmapFileAdapter` maps the file instead of
+/// reading it: tensors stored in the archive then point into the mapping
+/// rather than into a copy, see `PyTorchStreamReader::getRecord`.
 TORCH_API Module load(
     std::shared_ptr<caffe2::serialize::ReadAdapterInterface> rai,
     c10::optional<c10::Device> device = c10::nullopt);
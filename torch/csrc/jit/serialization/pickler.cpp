@@ -62,29 +62,60 @@ void Pickler::pushIValueImpl(const IValue& ivalue) {
   } else if (ivalue.isNone()) {
     push<PickleOpCode>(PickleOpCode::NONE);
   } else if (ivalue.isIntList()) {
-    pushSpecializedList(ivalue, "build_intlist", [=](const IValue& ivalue) {
-      for (const int64_t item : ivalue.toIntVector()) {
-        pushInt(item);
-      }
-    });
+    const auto& list = ivalue.toListRef();
+    if (shouldPackList(list.size(), sizeof(int64_t))) {
+      std::vector<int64_t> values = ivalue.toIntVector();
+      pushPackedList(
+          "build_packed_intlist",
+          values.data(),
+          values.size() * sizeof(int64_t));
+    } else {
+      pushSpecializedList(ivalue, "build_intlist", [=](const IValue& ivalue) {
+        for (const IValue& item : ivalue.toListRef()) {
+          pushInt(item.toInt());
+        }
+      });
+    }
   } else if (ivalue.isTensorList()) {
     pushSpecializedList(ivalue, "build_tensorlist", [=](const IValue& ivalue) {
-      for (const at::Tensor& item : ivalue.toTensorVector()) {
+      // push the list's IValues directly, there is no need to copy the
+      // tensors out into a vector first
+      for (const IValue& item : ivalue.toListRef()) {
         pushIValue(item);
       }
     });
   } else if (ivalue.isDoubleList()) {
-    pushSpecializedList(ivalue, "build_doublelist", [=](const IValue& ivalue) {
-      for (double item : ivalue.toDoubleVector()) {
-        pushDouble(item);
-      }
-    });
+    const auto& list = ivalue.toListRef();
+    if (shouldPackList(list.size(), sizeof(double))) {
+      std::vector<double> values = ivalue.toDoubleVector();
+      pushPackedList(
+          "build_packed_doublelist",
+          values.data(),
+          values.size() * sizeof(double));
+    } else {
+      pushSpecializedList(
+          ivalue, "build_doublelist", [=](const IValue& ivalue) {
+            for (const IValue& item : ivalue.toListRef()) {
+              pushDouble(item.toDouble());
+            }
+          });
+    }
   } else if (ivalue.isBoolList()) {
-    pushSpecializedList(ivalue, "build_boollist", [=](const IValue& ivalue) {
-      for (bool item : ivalue.toBoolList()) {
-        pushBool(item);
+    const auto& list = ivalue.toListRef();
+    if (shouldPackList(list.size(), sizeof(uint8_t))) {
+      std::vector<uint8_t> values;
+      values.reserve(list.size());
+      for (const IValue& item : list) {
+        values.push_back(item.toBool());
       }
-    });
+      pushPackedList("build_packed_boollist", values.data(), values.size());
+    } else {
+      pushSpecializedList(ivalue, "build_boollist", [=](const IValue& ivalue) {
+        for (const IValue& item : ivalue.toListRef()) {
+          pushBool(item.toBool());
+        }
+      });
+    }
     // note: isList must be after isIntList and friends because
     // isList is true for all lists.
   } else if (ivalue.isList()) {
@@ -424,6 +455,31 @@ void Pickler::pushLiteralTensor(const IValue& ivalue) {
   push<PickleOpCode>(PickleOpCode::REDUCE);
 }
 
+bool Pickler::shouldPackList(size_t num_elements, size_t element_size) const {
+  return pack_primitive_lists_ && num_elements >= kMinPackedListSize &&
+      num_elements * element_size <= std::numeric_limits<uint32_t>::max();
+}
+
+// Packed lists are a call to one of the build_packed_* globals with a single
+// BINBYTES argument that holds the raw (little endian) elements of the list,
+// bools are one byte each. This replaces one opcode per element with a single
+// memcpy on both ends.
+void Pickler::pushPackedList(
+    const char* list_name,
+    const void* data,
+    size_t nbytes) {
+  pushGlobal("torch.jit._pickle", list_name);
+
+  push<PickleOpCode>(PickleOpCode::BINBYTES);
+  push<uint32_t>(nbytes);
+  flush();
+  writer_(static_cast<const char*>(data), nbytes);
+
+  push<PickleOpCode>(PickleOpCode::TUPLE1);
+  push<PickleOpCode>(PickleOpCode::REDUCE);
+  wrote_packed_lists_ = true;
+}
+
 void Pickler::pushSpecializedList(
     const IValue& ivalue,
     const char* list_name,
@@ -533,9 +589,18 @@ void Pickler::pushDict(const IValue& ivalue) {
     push<PickleOpCode>(PickleOpCode::MARK);
 
     // Sort the dict for deterministic keys
-    for (const auto& entry : dict) {
-      pushIValue(entry.key());
-      pushIValue(entry.value());
+    if (dict.keyType()->kind() == StringType::Kind) {
+      // fast path for Dict[str, T] (e.g. state dicts), strings are memoized
+      // by value so there is no need to go through pushIValue
+      for (const auto& entry : dict) {
+        pushString(entry.key().toStringRef());
+        pushIValue(entry.value());
+      }
+    } else {
+      for (const auto& entry : dict) {
+        pushIValue(entry.key());
+        pushIValue(entry.value());
+      }
     }
 
     push<PickleOpCode>(PickleOpCode::SETITEMS);
@@ -154,6 +154,20 @@ class TORCH_API Pickler {
   void pushInt(int64_t value);
   void pushLong(const std::string& data);
 
+  // Write int, float and bool lists of at least kMinPackedListSize elements
+  // as a single byte string instead of one opcode per element. Archives that
+  // contain packed lists can't be read by versions of PyTorch older than
+  // caffe2::serialize::kMinVersionForPackedLists, so callers are expected to
+  // check wrotePackedLists() and bump the archive version.
+  void setPackPrimitiveLists(bool pack) {
+    pack_primitive_lists_ = pack;
+  }
+  bool wrotePackedLists() const {
+    return wrote_packed_lists_;
+  }
+
+  static CONSTEXPR_EXCEPT_WIN_CUDA size_t kMinPackedListSize = 1024;
+
  private:
   void pushIValueImpl(const IValue& ivalue);
   void startTypeTag();
@@ -178,6 +192,8 @@ class TORCH_API Pickler {
   void pushStorageOfTensor(const at::Tensor& tensor);
 
   void pushBinGet(uint32_t memo_id);
+  bool shouldPackList(size_t num_elements, size_t element_size) const;
+  void pushPackedList(const char* list_name, const void* data, size_t nbytes);
   void pushSpecializedList(
       const IValue& ivalue,
       const char* list_name,
@@ -264,6 +280,9 @@ class TORCH_API Pickler {
   std::unordered_map<std::string, uint32_t> memoized_globals_map_;
   std::unordered_map<std::string, uint32_t> memoized_strings_map_;
   std::unordered_map<std::string, uint32_t> memoized_devices_map_;
+
+  bool pack_primitive_lists_ = false;
+  bool wrote_packed_lists_ = false;
 };
 
 // returns a (tensor, record_size) for a tensor, converting it to a CPU tensor
@@ -245,6 +245,28 @@ static std::vector<T> convertList(const IValue& v) {
   return fmap(v.toListRef(), [](const IValue& elem) { return elem.to<T>(); });
 }
 
+// Decodes the reduce arguments of a build_packed_* global, see
+// Pickler::pushPackedList
+template <typename T, typename Packed>
+static c10::List<T> unpackList(const IValue& args) {
+  const std::string& data = args.toTuple()->elements().at(0).toStringRef();
+  TORCH_CHECK(
+      data.size() % sizeof(Packed) == 0,
+      "Packed list of ",
+      data.size(),
+      " bytes is not a multiple of the element size ",
+      sizeof(Packed));
+  size_t num_elements = data.size() / sizeof(Packed);
+  c10::List<T> list;
+  list.reserve(num_elements);
+  for (size_t i = 0; i < num_elements; ++i) {
+    Packed value;
+    memcpy(&value, data.data() + i * sizeof(Packed), sizeof(Packed));
+    list.push_back(static_cast<T>(value));
+  }
+  return list;
+}
+
 PickleOpCode Unpickler::readInstruction() {
   auto opcode = readOpCode();
   switch (opcode) {
@@ -306,6 +328,18 @@ PickleOpCode Unpickler::readInstruction() {
       uint32_t length = read<uint32_t>();
       stack_.emplace_back(readBytes(length));
     } break;
+    case PickleOpCode::SHORT_BINBYTES: {
+      uint8_t length = read<uint8_t>();
+      stack_.emplace_back(readBytes(length));
+    } break;
+    case PickleOpCode::BINBYTES: {
+      uint32_t length = read<uint32_t>();
+      stack_.emplace_back(readBytes(length));
+    } break;
+    case PickleOpCode::BINBYTES8: {
+      uint64_t length = read<uint64_t>();
+      stack_.emplace_back(readBytes(length));
+    } break;
     case PickleOpCode::BINFLOAT:
       stack_.emplace_back(readFloat());
       break;
@@ -358,8 +392,9 @@ PickleOpCode Unpickler::readInstruction() {
       size_t start = marks_.back();
       marks_.pop_back();
       auto dict = stack_.at(start - 1).toGenericDict();
+      dict.reserve(dict.size() + (stack_.size() - start) / 2);
       for (size_t i = start; i < stack_.size(); i += 2) {
-        dict.insert_or_assign(stack_[i], stack_[i + 1]);
+        dict.insert_or_assign(std::move(stack_[i]), std::move(stack_[i + 1]));
       }
       stack_.erase(stack_.begin() + start, stack_.end());
     } break;
@@ -508,6 +543,18 @@ void Unpickler::readGlobal(
         restoreContainerTypeTags(data.at(0), type);
         stack_.emplace_back(data.at(0));
       });
+    } else if (class_name == "build_packed_intlist") {
+      globals_.emplace_back([this] {
+        stack_.back() = unpackList<int64_t, int64_t>(stack_.back());
+      });
+    } else if (class_name == "build_packed_doublelist") {
+      globals_.emplace_back([this] {
+        stack_.back() = unpackList<double, double>(stack_.back());
+      });
+    } else if (class_name == "build_packed_boollist") {
+      globals_.emplace_back([this] {
+        stack_.back() = unpackList<bool, uint8_t>(stack_.back());
+      });
     } else {
       TypePtr elem_type = nullptr;
       if (class_name == "build_intlist") {
@@ -815,8 +862,9 @@ void Unpickler::readList(IValue list_ivalue) {
   } else if (list_ivalue.isList()) {
     auto list = std::move(list_ivalue).toList();
     list.reserve(num_elements);
-    for (const auto& elem : elements) {
-      list.emplace_back(elem);
+    // the elements are erased from the stack below, so move them
+    for (size_t i = start; i < stack_.size(); ++i) {
+      list.emplace_back(std::move(stack_[i]));
     }
   } else {
     AT_ERROR("Unknown IValue list kind: ", list_ivalue.tagKind());
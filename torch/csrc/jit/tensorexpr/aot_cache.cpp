@@ -0,0 +1,90 @@
+#include <torch/csrc/jit/tensorexpr/aot_cache.h>
+
+#include <caffe2/serialize/inline_container.h>
+
+namespace torch {
+namespace jit {
+namespace tensorexpr {
+
+constexpr const char* AOTKernelCache::kArchiveDir;
+
+AOTKernelCache& AOTKernelCache::get() {
+  static AOTKernelCache cache;
+  return cache;
+}
+
+void AOTKernelCache::setRecording(bool recording) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  recording_ = recording;
+}
+
+bool AOTKernelCache::recording() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return recording_;
+}
+
+void AOTKernelCache::insert(const std::string& key, std::string object) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  objects_[key] = std::move(object);
+}
+
+c10::optional<std::string> AOTKernelCache::lookup(
+    const std::string& key) const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto it = objects_.find(key);
+  if (it == objects_.end()) {
+    return c10::nullopt;
+  }
+  return it->second;
+}
+
+std::vector<std::string> AOTKernelCache::keys() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  std::vector<std::string> keys;
+  keys.reserve(objects_.size());
+  for (const auto& kv : objects_) {
+    keys.push_back(kv.first);
+  }
+  return keys;
+}
+
+bool AOTKernelCache::empty() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return objects_.empty();
+}
+
+void AOTKernelCache::clear() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  objects_.clear();
+}
+
+void AOTKernelCache::writeTo(
+    caffe2::serialize::PyTorchStreamWriter& writer) const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  for (const auto& kv : objects_) {
+    writer.writeRecord(
+        kArchiveDir + kv.first, kv.second.data(), kv.second.size());
+  }
+}
+
+size_t AOTKernelCache::readFrom(caffe2::serialize::PyTorchStreamReader& reader) {
+  const std::string prefix = kArchiveDir;
+  size_t count = 0;
+  for (const auto& name : reader.getAllRecords()) {
+    if (name.compare(0, prefix.size(), prefix) != 0) {
+      continue;
+    }
+    at::DataPtr data;
+    size_t size;
+    std::tie(data, size) = reader.getRecord(name);
+    insert(
+        name.substr(prefix.size()),
+        std::string(static_cast<char*>(data.get()), size));
+    count++;
+  }
+  return count;
+}
+
+} // namespace tensorexpr
+} // namespace jit
+} // namespace torch
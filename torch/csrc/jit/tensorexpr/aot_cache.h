@@ -0,0 +1,60 @@
+#pragma once
+
+#include <c10/util/Optional.h>
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace caffe2 {
+namespace serialize {
+class PyTorchStreamReader;
+class PyTorchStreamWriter;
+} // namespace serialize
+} // namespace caffe2
+
+namespace torch {
+namespace jit {
+namespace tensorexpr {
+
+// A process-wide cache of the object code of kernels compiled by the LLVM
+// backend, keyed by a hash of the unoptimized LLVM module and of the target.
+//
+// While recording is enabled, every kernel the LLVM backend compiles is added
+// to the cache and torch.jit.save embeds the cached objects into the model
+// archive. torch.jit.load adds the objects of an archive to the cache, so that
+// the matching kernels are linked from them instead of being optimized and
+// compiled again.
+class TORCH_API AOTKernelCache {
+ public:
+  // Archive records holding the objects are named kArchiveDir + key.
+  static constexpr const char* kArchiveDir = "nnc_kernels/";
+
+  static AOTKernelCache& get();
+
+  void setRecording(bool recording);
+  bool recording() const;
+
+  void insert(const std::string& key, std::string object);
+  c10::optional<std::string> lookup(const std::string& key) const;
+  std::vector<std::string> keys() const;
+  bool empty() const;
+  void clear();
+
+  void writeTo(caffe2::serialize::PyTorchStreamWriter& writer) const;
+  // Returns the number of objects read from the archive.
+  size_t readFrom(caffe2::serialize::PyTorchStreamReader& reader);
+
+ private:
+  AOTKernelCache() = default;
+
+  mutable std::mutex mutex_;
+  bool recording_{false};
+  std::unordered_map<std::string, std::string> objects_;
+};
+
+} // namespace tensorexpr
+} // namespace jit
+} // namespace torch
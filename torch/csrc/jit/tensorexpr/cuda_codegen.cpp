@@ -2,6 +2,7 @@
 #include <torch/csrc/jit/tensorexpr/half_support.h>
 
 #include <ATen/CUDAGeneratorImpl.h>
+#include <ATen/cuda/CUDAEvent.h>
 #include <c10/cuda/CUDAFunctions.h>
 #include <torch/csrc/jit/codegen/fuser/cuda/resource_strings.h>
 #include <torch/csrc/jit/jit_log.h>
@@ -445,7 +446,175 @@ class AtomicAddFuser : public IRMutator {
   std::unordered_set<const Var*> nontrivial_metavars_;
 };
 
+// Whether e is a multiple of factor for all the values of its variables,
+// looking through sums and products only.
+static bool isMultipleOf(const Expr* e, int64_t factor) {
+  if (e->isConstant()) {
+    return immediateAs<int64_t>(e) % factor == 0;
+  }
+  if (auto add = dynamic_cast<const Add*>(e)) {
+    return isMultipleOf(add->lhs(), factor) && isMultipleOf(add->rhs(), factor);
+  }
+  if (auto sub = dynamic_cast<const Sub*>(e)) {
+    return isMultipleOf(sub->lhs(), factor) && isMultipleOf(sub->rhs(), factor);
+  }
+  if (auto mul = dynamic_cast<const Mul*>(e)) {
+    return isMultipleOf(mul->lhs(), factor) || isMultipleOf(mul->rhs(), factor);
+  }
+  return false;
+}
+
+// Returns the index of the first element of a vector access that can be done
+// with one load or store of an aligned_vector, or nullptr. The buffers are
+// expected to be aligned to the size of these vectors, which the kernel
+// checks before every call.
+static const Expr* alignedVectorBase(const Expr* index, Dtype dtype) {
+  auto ramp = dynamic_cast<const Ramp*>(index);
+  if (!ramp || !ramp->stride()->isConstant() ||
+      immediateAs<int64_t>(ramp->stride()) != 1) {
+    return nullptr;
+  }
+  const int bytes = ramp->lanes() * Dtype(dtype.scalar_type()).byte_size();
+  if (bytes > 16 || (bytes & (bytes - 1)) != 0) {
+    return nullptr;
+  }
+  if (!isMultipleOf(ramp->base(), ramp->lanes())) {
+    return nullptr;
+  }
+  return ramp->base();
+}
+
+static std::string alignedVectorType(Dtype dtype) {
+  return "aligned_vector<" +
+      cudaDtypeCppString(Dtype(dtype.scalar_type())) + ", " +
+      std::to_string(dtype.lanes()) + ">";
+}
+
+// Rewrites a vector expression into the scalar expression of one of its
+// lanes. The loads that were done as a whole vector are replaced by the
+// variables holding their lanes.
+class LaneExtractor : public IRMutator {
+ public:
+  LaneExtractor(
+      int lane,
+      const std::unordered_map<const Load*, std::vector<const Var*>>&
+          vector_loads)
+      : lane_(lane), vector_loads_(vector_loads) {}
+
+  const Expr* mutate(const Ramp* v) override {
+    return new Add(
+        v->base(),
+        new Mul(v->stride(), getImmediateByType(v->stride()->dtype(), lane_)));
+  }
+
+  const Expr* mutate(const Broadcast* v) override {
+    return v->value();
+  }
+
+  const Expr* mutate(const Load* v) override {
+    if (v->dtype().lanes() == 1) {
+      return v;
+    }
+    auto it = vector_loads_.find(v);
+    if (it != vector_loads_.end()) {
+      return it->second[lane_];
+    }
+    return new Load(
+        Dtype(v->dtype().scalar_type()),
+        v->buf(),
+        {v->flat_index()->accept_mutator(this)},
+        v->mask()->accept_mutator(this));
+  }
+
+  const Expr* mutate(const Cast* v) override {
+    return new Cast(
+        Dtype(v->dtype().scalar_type()), v->src_value()->accept_mutator(this));
+  }
+
+  const Expr* mutate(const BitCast* v) override {
+    return new BitCast(
+        Dtype(v->dtype().scalar_type()), v->src_value()->accept_mutator(this));
+  }
+
+  const Expr* mutate(const Var* v) override {
+    if (v->dtype().lanes() != 1) {
+      throw unimplemented_lowering(v);
+    }
+    return v;
+  }
+
+ private:
+  int lane_;
+  const std::unordered_map<const Load*, std::vector<const Var*>>&
+      vector_loads_;
+};
+
+void CudaPrinter::visitVectorStore(const Store* v) {
+  const Dtype dtype = v->value()->dtype();
+  const int lanes = dtype.lanes();
+
+  // Load the vectors that can be loaded at once into one variable per lane
+  std::unordered_map<const Load*, std::vector<const Var*>> vector_loads;
+  for (const Load* load : NodeFinder<Load>::find(v->value())) {
+    if (load->dtype().lanes() == 1 || vector_loads.count(load)) {
+      continue;
+    }
+    const Expr* base = alignedVectorBase(load->flat_index(), load->dtype());
+    if (!base) {
+      continue;
+    }
+    const std::string vector_type = alignedVectorType(load->dtype());
+    const Var* vector_var = new Var("vec", load->dtype());
+    emitIndent();
+    os() << vector_type << " " << *vector_var << " = *reinterpret_cast<const "
+         << vector_type << "*>(" << *load->base_handle() << " + " << *base
+         << ");" << std::endl;
+    std::vector<const Var*> lane_vars;
+    for (int i = 0; i < load->dtype().lanes(); i++) {
+      const Var* lane_var = new Var("v", Dtype(load->dtype().scalar_type()));
+      emitIndent();
+      os() << cudaDtypeCppString(lane_var->dtype()) << " " << *lane_var
+           << " = " << *vector_var << ".val[" << i << "];" << std::endl;
+      lane_vars.push_back(lane_var);
+    }
+    vector_loads.emplace(load, std::move(lane_vars));
+  }
+
+  const Expr* base = alignedVectorBase(v->flat_index(), dtype);
+  const Var* vector_var = nullptr;
+  if (base) {
+    vector_var = new Var("vec", dtype);
+    emitIndent();
+    os() << alignedVectorType(dtype) << " " << *vector_var << ";"
+         << std::endl;
+  }
+  for (int i = 0; i < lanes; i++) {
+    LaneExtractor lane_extractor(i, vector_loads);
+    const Expr* value =
+        IRSimplifier::simplify(v->value()->accept_mutator(&lane_extractor));
+    emitIndent();
+    if (base) {
+      os() << *vector_var << ".val[" << i << "] = ";
+    } else {
+      const Expr* index = IRSimplifier::simplify(
+          v->flat_index()->accept_mutator(&lane_extractor));
+      os() << *v->base_handle() << "[" << *index << "] = ";
+    }
+    os() << *value << ";" << std::endl;
+  }
+  if (base) {
+    emitIndent();
+    os() << "*reinterpret_cast<" << alignedVectorType(dtype) << "*>("
+         << *v->base_handle() << " + " << *base << ") = " << *vector_var << ";"
+         << std::endl;
+  }
+}
+
 void CudaPrinter::visit(const Store* v) {
+  if (v->value()->dtype().lanes() > 1) {
+    visitVectorStore(v);
+    return;
+  }
   emitIndent();
   if (v->indices().empty()) {
     os() << *v->base_handle() << " = ";
@@ -540,6 +709,10 @@ class PrioritizeLoad : public IRMutator {
     if (v->indices().size() == 0) {
       return IRMutator::mutate(v);
     }
+    // Vector loads are printed with their store, see visitVectorStore
+    if (v->dtype().lanes() > 1) {
+      return IRMutator::mutate(v);
+    }
     if (nested_store_) {
       if (v->base_handle() == nested_store_->buf()->base_handle() &&
           v->indices().size() == nested_store_->indices().size()) {
@@ -914,6 +1087,16 @@ __device__ T minimum(T a, T b) {
 
 )";
 
+// Loaded and stored as a whole by the vector accesses, like in
+// ATen/native/cuda/MemoryAccess.cuh
+static const char* vector_resource_string = R"(
+template<typename scalar_t, int vec_size>
+struct __align__(sizeof(scalar_t) * vec_size) aligned_vector {
+  scalar_t val[vec_size];
+};
+
+)";
+
 void CudaCodeGen::Initialize() {
   // TODO: handle multiple kernels.
   // TODO: handle dynamic dimension.
@@ -932,6 +1115,13 @@ void CudaCodeGen::Initialize() {
 
   os() << device_resource_string << shared_resource_string;
 
+  for (const Store* store : NodeFinder<Store>::find(stmt())) {
+    if (store->value()->dtype().lanes() > 1) {
+      os() << vector_resource_string;
+      break;
+    }
+  }
+
   if (has_random_) {
     os() << philox_random_string << std::endl;
   }
@@ -1108,7 +1298,7 @@ void CudaCodeGen::call(const std::vector<CallArg>& args) {
   case ScalarType::Name:                  \
     ptr_to_args[i] = args[i].Name##Ptr(); \
     break;
-        AT_FORALL_SCALAR_TYPES_AND2(Bool, Half, TYPE_CASE);
+        AT_FORALL_SCALAR_TYPES_AND3(Bool, Half, BFloat16, TYPE_CASE);
 #undef TYPE_CASE
         default:
           throw unsupported_dtype();
@@ -1159,6 +1349,22 @@ void CudaCodeGen::call(const std::vector<CallArg>& args) {
   }
 }
 
+c10::optional<double> CudaCodeGen::benchmark(
+    const std::vector<CallArg>& args,
+    int runs) {
+  c10::cuda::CUDAGuard device_guard(device());
+  call(args);
+  at::cuda::CUDAEvent start(cudaEventDefault);
+  at::cuda::CUDAEvent stop(cudaEventDefault);
+  start.record();
+  for (int i = 0; i < runs; i++) {
+    call(args);
+  }
+  stop.record();
+  stop.synchronize();
+  return start.elapsed_time(stop) / std::max(runs, 1);
+}
+
 at::Tensor CudaCodeGen::empty_strided(
     c10::IntArrayRef size,
     c10::IntArrayRef stride,
@@ -181,6 +181,10 @@ class CudaPrinter : public IRPrinter {
   using IRPrinter::visit;
 
  private:
+  // Prints a store of a vector value lane by lane, loading and storing the
+  // contiguous and aligned vectors as a whole.
+  void visitVectorStore(const Store* v);
+
   const Var* rand_func_;
   const CudaAnalysis* cuda_analysis_;
 };
@@ -211,6 +215,10 @@ class TORCH_CUDA_CU_API CudaCodeGen : public CodeGen {
 
   void call(const std::vector<CallArg>& args) override;
 
+  // Times the kernel with CUDA events on the current stream
+  c10::optional<double> benchmark(const std::vector<CallArg>& args, int runs)
+      override;
+
   template <typename... Ts>
   void operator()(const Ts&... ts) {
     call(std::vector<CallArg>({CallArg(ts)...}));
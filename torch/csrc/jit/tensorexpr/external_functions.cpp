@@ -111,12 +111,42 @@ void nnc_aten_matmul(
   }
 }
 
+void nnc_aten_linear(
+    int64_t bufs_num,
+    void** buf_data,
+    int64_t* buf_ranks,
+    int64_t* buf_dims,
+    int8_t* buf_dtypes,
+    int64_t args_num,
+    int64_t* extra_args) {
+  std::vector<at::Tensor> tensors =
+      constructTensors(bufs_num, buf_data, buf_ranks, buf_dims, buf_dtypes);
+
+  at::Tensor& r = tensors[0];
+  const at::Tensor& x = tensors[1];
+  const at::Tensor& w = tensors[2];
+  try {
+    if (bufs_num < 4) {
+      at::matmul_out(r, x, w.t());
+    } else if (x.dim() == 2) {
+      at::addmm_out(r, tensors[3], x, w.t());
+    } else {
+      at::matmul_out(r, x, w.t());
+      r.add_(tensors[3]);
+    }
+  } catch (...) {
+  }
+}
+
 static RegisterNNCExternalFunction nnc_conv2d(
     "nnc_aten_conv2d",
     nnc_aten_conv2d);
 static RegisterNNCExternalFunction nnc_matmul(
     "nnc_aten_matmul",
     nnc_aten_matmul);
+static RegisterNNCExternalFunction nnc_linear(
+    "nnc_aten_linear",
+    nnc_aten_linear);
 
 } // namespace tensorexpr
 } // namespace jit
@@ -45,10 +45,17 @@ class HalfChecker : public IRVisitor {
   bool hasHalf_{false};
 };
 
+// Computes the Half and BFloat16 operations in Float, only loading and
+// storing in reduced precision.
 class HalfRewriter : public IRMutator {
+  static bool isReducedFloat(Dtype dtype) {
+    return dtype.scalar_type() == ScalarType::Half ||
+        dtype.scalar_type() == ScalarType::BFloat16;
+  }
+
   const Expr* mutate(const Load* v) override {
     const Expr* child = IRMutator::mutate(v);
-    if (child->dtype().scalar_type() != ScalarType::Half) {
+    if (!isReducedFloat(child->dtype())) {
       return child;
     }
 
@@ -63,9 +70,8 @@ class HalfRewriter : public IRMutator {
     const Expr* new_val = v->value()->accept_mutator(this);
 
     Dtype newType = v->value()->dtype();
-    if (newType.scalar_type() == ScalarType::Half) {
-      new_val =
-          new Cast(newType.cloneWithScalarType(ScalarType::Half), new_val);
+    if (isReducedFloat(newType)) {
+      new_val = new Cast(newType, new_val);
       inserted_half_casts_.insert(new_val);
     }
 
@@ -76,11 +82,15 @@ class HalfRewriter : public IRMutator {
     return new Cast(kFloat, v);
   }
 
+  const Expr* mutate(const BFloat16Imm* v) override {
+    return new Cast(kFloat, v);
+  }
+
   const Expr* mutate(const Cast* v) override {
     const Expr* child = v->src_value()->accept_mutator(this);
 
     // just don't allow half casts we didn't insert.
-    if (v->dtype().scalar_type() == ScalarType::Half) {
+    if (isReducedFloat(v->dtype())) {
       if (inserted_half_casts_.count(v) < 1) {
         return child;
       }
@@ -102,7 +112,7 @@ class HalfRewriter : public IRMutator {
     return new Cast(v->dtype(), child);
   }
   Stmt* mutate(const Let* v) override {
-    if (v->dtype().scalar_type() == ScalarType::Half) {
+    if (isReducedFloat(v->dtype())) {
       const Var* load_new_var = new Var(v->var()->name_hint(), kFloat);
       const Expr* new_value = new Cast(
           v->dtype().cloneWithScalarType(ScalarType::Float),
@@ -128,7 +128,7 @@ const Expr* IRMutator::mutate(const CompareSelect* v) {
   const Expr* IRMutator::mutate(const Name##Imm* v) { \
     return v;                                         \
   }
-AT_FORALL_SCALAR_TYPES_AND2(Bool, Half, IMM_MUTATE_DEFINE);
+AT_FORALL_SCALAR_TYPES_AND3(Bool, Half, BFloat16, IMM_MUTATE_DEFINE);
 #undef IMM_MUTATE_DEFINE
 
 const Expr* IRMutator::mutate(const Cast* v) {
@@ -33,7 +33,7 @@ class TORCH_API IRPrinter : public IRVisitor {
   void visit(const Rshift* v) override;
   void visit(const CompareSelect* v) override;
 #define IMM_PRINT_VISIT(Type, Name) void visit(const Name##Imm* v) override;
-  AT_FORALL_SCALAR_TYPES_AND2(Bool, Half, IMM_PRINT_VISIT);
+  AT_FORALL_SCALAR_TYPES_AND3(Bool, Half, BFloat16, IMM_PRINT_VISIT);
 #undef IMM_PRINT_VISIT
   void visit(const Cast* v) override;
   void visit(const Var* v) override;
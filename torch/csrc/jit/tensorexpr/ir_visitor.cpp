@@ -73,7 +73,7 @@ void IRVisitor::visit(const CompareSelect* v) {
 // NOLINTNEXTLINE
 #define IMM_VISIT(Type, Name) \
   void IRVisitor::visit(const Name##Imm* v) {}
-AT_FORALL_SCALAR_TYPES_AND2(Bool, Half, IMM_VISIT);
+AT_FORALL_SCALAR_TYPES_AND3(Bool, Half, BFloat16, IMM_VISIT);
 #undef IMM_VISIT
 
 void IRVisitor::visit(const Cast* v) {
@@ -22,7 +22,7 @@ class CompareSelect;
 
 #define IMM_DECLARE(Type, Name) class Name##Imm;
 
-AT_FORALL_SCALAR_TYPES_AND2(Bool, Half, IMM_DECLARE)
+AT_FORALL_SCALAR_TYPES_AND3(Bool, Half, BFloat16, IMM_DECLARE)
 #undef IMM_DECLARE
 
 class Cast;
@@ -72,7 +72,7 @@ class TORCH_API IRVisitor {
 
 #define IMM_PRINT_VISIT(Type, Name) virtual void visit(const Name##Imm* v);
 
-  AT_FORALL_SCALAR_TYPES_AND2(Bool, Half, IMM_PRINT_VISIT)
+  AT_FORALL_SCALAR_TYPES_AND3(Bool, Half, BFloat16, IMM_PRINT_VISIT)
 #undef IMM_PRINT_VISIT
 
   virtual void visit(const Cast* v);
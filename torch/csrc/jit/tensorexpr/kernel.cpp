@@ -1,15 +1,20 @@
 #include <torch/csrc/jit/tensorexpr/kernel.h>
 
 #include <ATen/ExpandUtils.h>
+#include <ATen/Parallel.h>
 #include <ATen/TensorGeometry.h>
+#include <c10/util/accumulate.h>
 #include <c10/util/string_utils.h>
 #include <torch/csrc/jit/jit_log.h>
+#include <torch/csrc/jit/passes/shape_analysis.h>
 #include <torch/csrc/jit/passes/utils/subgraph_utils.h>
 #include <torch/csrc/jit/tensorexpr/analysis.h>
 #include <torch/csrc/jit/tensorexpr/ir_printer.h>
 #include <torch/csrc/jit/tensorexpr/ir_simplifier.h>
 #include <torch/csrc/jit/tensorexpr/loopnest.h>
 
+#include <chrono>
+
 using namespace torch::jit;
 using namespace torch::jit::tensorexpr;
 
@@ -20,9 +25,12 @@ namespace tensorexpr {
 static int te_cuda_pointwise_loop_levels = -1;
 static int te_cuda_pointwise_block_count = -1;
 static int te_cuda_pointwise_block_size = -1;
+static bool te_cuda_pointwise_vectorize = true;
+static bool te_cuda_pointwise_autotune = true;
 static bool fallback_allowed = false;
 static bool te_generate_block_code = false;
 static bool te_must_use_llvm_on_cpu = true;
+static int te_kernel_specialization_cache_size = 8;
 
 bool setFallbackAllowed(bool value) {
   bool old_value = fallback_allowed;
@@ -76,6 +84,14 @@ int& getTECudaPointwiseBlockSize() {
   return te_cuda_pointwise_block_size;
 }
 
+bool& getTECudaPointwiseVectorize() {
+  return te_cuda_pointwise_vectorize;
+}
+
+bool& getTECudaPointwiseAutotune() {
+  return te_cuda_pointwise_autotune;
+}
+
 // TODO: Remove this global var
 // Ideally Block code gen should be decided
 // based on device type in tensor.
@@ -87,6 +103,23 @@ bool& getTEMustUseLLVMOnCPU() {
   return te_must_use_llvm_on_cpu;
 }
 
+int& getTEKernelSpecializationCacheSize() {
+  return te_kernel_specialization_cache_size;
+}
+
+void TensorExprKernelStats::reset() {
+  compiles = 0;
+  compileTimeUs = 0;
+  specializationHits = 0;
+  specializationMisses = 0;
+  specializationEvictions = 0;
+}
+
+TensorExprKernelStats& getTEKernelStats() {
+  static TensorExprKernelStats stats;
+  return stats;
+}
+
 c10::optional<at::Device> pickDeviceType(
     const at::ArrayRef<torch::jit::Value*>& inputs) {
   c10::optional<at::Device> device = c10::nullopt;
@@ -185,7 +218,7 @@ ExprHandle promoteToDtype(ExprHandle e, ScalarType dt) {
   case ScalarType::Name:      \
     e = cast<Type>(e);        \
     break;
-    AT_FORALL_SCALAR_TYPES_AND2(Half, Bool, TYPE_CASE);
+    AT_FORALL_SCALAR_TYPES_AND3(Half, BFloat16, Bool, TYPE_CASE);
 #undef TYPE_CASE
     default:
       throw unsupported_dtype();
@@ -536,7 +569,7 @@ ExprHandle TensorExprKernel::demoteOutput(
 #define TYPE_CASE(Type, Name) \
   case at::ScalarType::Name:  \
     return cast<Type>(e);
-    AT_FORALL_SCALAR_TYPES_AND(Half, TYPE_CASE);
+    AT_FORALL_SCALAR_TYPES_AND2(Half, BFloat16, TYPE_CASE);
 #undef TYPE_CASE
     case at::ScalarType::Bool:
       return cast<bool>(e);
@@ -1514,7 +1547,22 @@ Tensor* TensorExprKernel::computeValue(const torch::jit::Value* v) {
     }
 
     case aten::sum: {
-      return computeSum(v);
+      return computeReduction(v, "sum", Sum());
+    }
+
+    case aten::mean: {
+      return computeMean(v);
+    }
+
+    case aten::amax: {
+      auto tt = v->type()->expect<TensorType>();
+      return computeReduction(
+          v, "amax", Maximum(ToDtype(*tt->scalarType())));
+    }
+
+    case aten::matmul:
+    case aten::linear: {
+      return computeMatmul(v);
     }
 
     case aten::softmax: {
@@ -1531,7 +1579,93 @@ Tensor* TensorExprKernel::computeValue(const torch::jit::Value* v) {
   }
 }
 
-Stmt* TensorExprKernel::transformLoops(BackendType backendType, Stmt* st) {
+// Distributes the outer iterations of every reduction-free loop nest across
+// the intra-op thread pool. Outer loops are flattened until they provide
+// enough independent iterations to balance the work across the threads; if
+// that consumes the whole nest, the flattened loop is split into chunks
+// instead, so that the inner loops stay long enough to be vectorized.
+static void parallelizeOuterLoops(LoopNest& l) {
+  const int64_t numThreads = at::get_num_threads();
+  if (numThreads <= 1) {
+    return;
+  }
+  // Smaller nests do not amortize waking up the thread pool. This is the
+  // grain size ATen uses for its own pointwise kernels.
+  const int64_t kMinParallelElements = 32768;
+  // A few tasks per thread even out the imbalance between uneven tasks.
+  const int64_t kTasksPerThread = 4;
+  // Chunks are a multiple of every vector width, and each one spans whole
+  // cache lines for any dtype, so threads do not write to the same line.
+  const int64_t kChunkAlignment = 64;
+  const int64_t numTasks = numThreads * kTasksPerThread;
+
+  Block* root = dynamic_cast<Block*>(l.root_stmt());
+  if (!root) {
+    return;
+  }
+  std::vector<For*> nests;
+  for (Stmt* s : *root) {
+    if (For* f = dynamic_cast<For*>(s)) {
+      nests.push_back(f);
+    }
+  }
+
+  for (For* nest : nests) {
+    if (NodeFinder<ReduceOp>::find(nest).size() != 0) {
+      continue;
+    }
+
+    // Collect the perfectly nested loops, which must have constant bounds.
+    std::vector<For*> loops;
+    std::vector<int64_t> tripCounts;
+    bool constantBounds = true;
+    for (For* f = nest; f;) {
+      if (!f->start()->isConstant() || !f->stop()->isConstant()) {
+        constantBounds = false;
+        break;
+      }
+      loops.push_back(f);
+      tripCounts.push_back(
+          immediateAs<int64_t>(f->stop()) - immediateAs<int64_t>(f->start()));
+      f = f->body()->nstmts() == 1 ? dynamic_cast<For*>(f->body()->front())
+                                   : nullptr;
+    }
+    if (!constantBounds) {
+      continue;
+    }
+    int64_t numel = 1;
+    for (int64_t tripCount : tripCounts) {
+      numel *= tripCount;
+    }
+    if (numel < kMinParallelElements) {
+      continue;
+    }
+
+    size_t numOuter = 0;
+    int64_t outerTrips = 1;
+    while (numOuter < loops.size() && outerTrips < numTasks) {
+      outerTrips *= tripCounts[numOuter++];
+    }
+    For* outer = nullptr;
+    LoopNest::flatten(
+        std::vector<For*>(loops.begin(), loops.begin() + numOuter), &outer);
+
+    if (numOuter == loops.size()) {
+      int64_t chunk = (numel + numTasks - 1) / numTasks;
+      chunk = (chunk + kChunkAlignment - 1) / kChunkAlignment * kChunkAlignment;
+      For* inner = nullptr;
+      For* tail = nullptr;
+      LoopNest::splitWithTail(
+          outer, static_cast<int>(chunk), &outer, &inner, &tail);
+    }
+    outer->set_parallel();
+  }
+}
+
+Stmt* TensorExprKernel::transformLoops(
+    BackendType backendType,
+    Stmt* st,
+    const CudaSchedule& cudaSchedule) {
   std::unordered_set<const Buf*> output_bufs;
   for (auto t : tensorOutputs_) {
     output_bufs.insert(t->buf());
@@ -1558,6 +1692,10 @@ Stmt* TensorExprKernel::transformLoops(BackendType backendType, Stmt* st) {
       (backendType == kCudaCodeGen || backendType == kBlockCodeGen);
   l.inlineIntermediateBufs(allow_duplicated_work);
 
+  // Loops of the CUDA kernel whose iterations are done by one thread as
+  // vector operations
+  std::unordered_set<const Var*> vectorLoopVars;
+
   if (backendType == kCudaCodeGen) {
     for (auto tensor : tensorOutputs_) {
       std::vector<For*> loops = l.getLoopStmtsFor(tensor);
@@ -1570,7 +1708,8 @@ Stmt* TensorExprKernel::transformLoops(BackendType backendType, Stmt* st) {
       const int kDefaultLoopLevels = 2;
       loopLevels = (loopLevels > 0) ? loopLevels : kDefaultLoopLevels;
       int blockCount = getTECudaPointwiseBlockCount();
-      int blockSize = getTECudaPointwiseBlockSize();
+      int blockSize = cudaSchedule.blockSize > 0 ? cudaSchedule.blockSize
+                                                 : getTECudaPointwiseBlockSize();
 
       if (loopLevels == 2) {
         For* outer;
@@ -1579,6 +1718,20 @@ Stmt* TensorExprKernel::transformLoops(BackendType backendType, Stmt* st) {
         if (blockSize < 0) {
           blockSize = kDefaultBlockSize;
         }
+        // Outputs whose size is a multiple of the vector width are split
+        // without a tail, every thread handling one vector.
+        int64_t numel = 1;
+        for (auto size : bufferSizes(tensor)) {
+          numel *= size;
+        }
+        if (cudaSchedule.vectorWidth > 1 && !hasReduction &&
+            numel % cudaSchedule.vectorWidth == 0) {
+          For* vectorLoop;
+          l.splitWithMask(
+              flattened, cudaSchedule.vectorWidth, &outer, &vectorLoop);
+          vectorLoopVars.insert(vectorLoop->var());
+          flattened = outer;
+        }
         l.splitWithMask(flattened, blockSize, &outer, &inner);
         l.setGPUBlockIndex(outer, 0);
         l.setGPUThreadIndex(inner, 0);
@@ -1627,12 +1780,26 @@ Stmt* TensorExprKernel::transformLoops(BackendType backendType, Stmt* st) {
     }
   }
 
+  if (backendType == kLLVMCodeGen) {
+    parallelizeOuterLoops(l);
+  }
+
   l.prepareForCodegen();
 
   if (backendType == kLLVMCodeGen && !hasReduction) {
     l.vectorizeInnerLoops();
   }
 
+  // The CUDA codegen emits the contiguous and aligned accesses of the
+  // vectorized loops as vector loads and stores.
+  if (!vectorLoopVars.empty()) {
+    for (For* loop : NodeFinder<For>::find(l.root_stmt())) {
+      if (vectorLoopVars.count(loop->var())) {
+        LoopNest::vectorize(loop);
+      }
+    }
+  }
+
   Stmt* stmt = l.root_stmt();
   // Arithmetic Simplification.
   stmt = IRSimplifier::simplify(stmt);
@@ -1792,12 +1959,15 @@ std::vector<VarHandle> squeezeIndices(
 
 } // namespace
 
-Tensor* TensorExprKernel::computeSum(const torch::jit::Value* v) {
+Tensor* TensorExprKernel::computeReduction(
+    const torch::jit::Value* v,
+    const std::string& name,
+    const Reducer& reducer) {
   auto reduction_info = getReductionInfo(v->node());
   return Reduce(
-      "sum",
+      name,
       reduction_info.outputDims,
-      Sum(),
+      reducer,
       [&](ParameterList& indices) {
         const auto& axes = reduction_info.axes;
         // "Squeeze" out indices inserted when keepdim is set.
@@ -1828,6 +1998,55 @@ Tensor* TensorExprKernel::computeSum(const torch::jit::Value* v) {
       reduction_info.reductionDims);
 }
 
+Tensor* TensorExprKernel::computeMean(const torch::jit::Value* v) {
+  // The mean is computed as a sum reduction followed by an elementwise
+  // division by the number of reduced elements.
+  auto reduction_info = getReductionInfo(v->node());
+  Tensor* sum = computeReduction(v, "mean_sum", Sum());
+  ExprHandle numel = 1;
+  for (const auto& dim : reduction_info.reductionDims) {
+    numel = numel * dim.dim();
+  }
+  numel = Cast::make(sum->buf()->dtype(), IRSimplifier::simplify(numel));
+  auto result = Compute(
+      "mean",
+      reduction_info.outputDims,
+      [&](const std::vector<VarHandle>& axes) {
+        std::vector<ExprHandle> indices(axes.begin(), axes.end());
+        return sum->call(indices) / numel;
+      });
+  return new Tensor(result->buf(), new Block({sum->stmt(), result->stmt()}));
+}
+
+Tensor* TensorExprKernel::computeMatmul(const torch::jit::Value* v) {
+  // Matrix multiplications are delegated to ATen through an external call,
+  // which writes into a buffer that the rest of the kernel then reads like any
+  // other. This lets elementwise epilogues (bias, activations, ...) be fused
+  // in the same kernel instead of breaking the fusion group.
+  auto const& n = v->node();
+  auto tt = v->type()->expect<TensorType>();
+  BufHandle resultBuf(
+      n->kind() == aten::linear ? "linear" : "matmul",
+      sizesForValue(v),
+      ToDtype(*tt->scalarType()));
+  std::vector<BufHandle> bufArgs;
+  for (auto const& input : n->inputs()) {
+    // aten::linear without a bias.
+    if (input->type()->cast<NoneType>()) {
+      continue;
+    }
+    auto it = tensors_.find(input->unique());
+    if (it == tensors_.end()) {
+      throw malformed_input("matmul operands must be tensors");
+    }
+    bufArgs.emplace_back(it->second->buf());
+  }
+  auto funcName =
+      n->kind() == aten::linear ? "nnc_aten_linear" : "nnc_aten_matmul";
+  return new Tensor(
+      resultBuf.node(), ExternalCall::make(resultBuf, funcName, bufArgs, {}));
+}
+
 Tensor* TensorExprKernel::computeSoftmax(
     const torch::jit::Value* v,
     bool log_softmax) {
@@ -1994,7 +2213,9 @@ TensorExprKernel::ReductionInfo TensorExprKernel::getReductionInfo(
     std::sort(axes.begin(), axes.end());
     axes.erase(std::unique(axes.begin(), axes.end()), axes.end());
     keepdim = node->get(attr::keepdim)->toBool();
-  } else {
+  }
+  // No axes means a reduction over all dimensions.
+  if (axes.empty()) {
     axes.resize(sizes.size());
     std::iota(axes.begin(), axes.end(), 0);
   }
@@ -2016,10 +2237,13 @@ TensorExprKernel::ReductionInfo TensorExprKernel::getReductionInfo(
     }
   }
   c10::optional<Dtype> dtype;
-  auto dtypeValue = node->get(attr::dtype);
-  if (!dtypeValue->isNone()) {
-    auto scalarType = static_cast<ScalarType>(dtypeValue->toInt());
-    dtype = ToDtype(scalarType);
+  // Not all reductions take a dtype, e.g., aten::amax doesn't.
+  if (node->schema().argumentIndexWithName("dtype")) {
+    auto dtypeValue = node->get(attr::dtype);
+    if (!dtypeValue->isNone()) {
+      auto scalarType = static_cast<ScalarType>(dtypeValue->toInt());
+      dtype = ToDtype(scalarType);
+    }
   }
   return {reductionDims, outputDims, axes, keepdim, dtype};
 }
@@ -2142,6 +2366,13 @@ void TensorExprKernel::compile() {
   for (auto const& input : graph_->inputs()) {
     bindInput(input);
     inputTypes_.push_back(input->type());
+    if (auto tt = input->type()->cast<TensorType>()) {
+      inputSizes_.push_back(*tt->sizes().concrete_sizes());
+      inputStrides_.push_back(*tt->strides().concrete_sizes());
+    } else {
+      inputSizes_.emplace_back();
+      inputStrides_.emplace_back();
+    }
     if (input->type()->kind() == TypeKind::TensorType) {
       tensor_stmts.push_back(Stmt::clone(tensors_.at(input->unique())->stmt()));
     }
@@ -2203,7 +2434,38 @@ void TensorExprKernel::compile() {
   }
 
   BackendType backendType = inferBackendTypeFromDevice(device_);
-  Stmt* stmt = transformLoops(backendType, new Block(tensor_stmts));
+  Stmt* stmt = new Block(tensor_stmts);
+
+  // Pointwise CUDA kernels with the default loop levels can use vector
+  // accesses and be tuned, both of which need the loops to be scheduled again.
+  if (backendType == kCudaCodeGen && getTECudaPointwiseLoopLevels() <= 2 &&
+      NodeFinder<ReduceOp>::find(stmt).empty() && !hasRandom_) {
+    if (getTECudaPointwiseVectorize()) {
+      // Up to 4 elements, in at most 16 bytes for the largest dtype, like the
+      // vectorized ATen CUDA kernels
+      int maxElementSize = 1;
+      for (const auto& arg : bufferArgs_) {
+        if (!arg.isVar()) {
+          maxElementSize = std::max(maxElementSize, arg.dtype().byte_size());
+        }
+      }
+      cudaSchedule_.vectorWidth = std::max(std::min(4, 16 / maxElementSize), 1);
+    }
+    // Small kernels are bound by the launch latency, whatever their block size
+    constexpr int64_t kMinTunedElements = 1 << 16;
+    int64_t outputElements = 0;
+    for (const auto& sizes : tensorOutputSizes_) {
+      outputElements += c10::multiply_integers(sizes);
+    }
+    cudaTunable_ = getTECudaPointwiseAutotune() &&
+        getTECudaPointwiseBlockSize() < 0 &&
+        outputElements >= kMinTunedElements;
+    if (cudaSchedule_.vectorWidth > 1 || cudaTunable_) {
+      cudaStmt_ = Stmt::clone(stmt);
+    }
+  }
+
+  stmt = transformLoops(backendType, stmt, cudaSchedule_);
 
   // Generate code.
   codegen_ = CreateCodeGen(
@@ -2214,10 +2476,140 @@ void TensorExprKernel::compile() {
       SubgraphUtils::generateNameForGraph(graph_));
 }
 
+std::unique_ptr<CodeGen> TensorExprKernel::createCudaCodeGen(
+    const CudaSchedule& schedule) {
+  Stmt* stmt =
+      transformLoops(kCudaCodeGen, Stmt::clone(cudaStmt_), schedule);
+  return CreateCodeGen(
+      getCodeGenName(kCudaCodeGen),
+      stmt,
+      bufferArgs_,
+      device_,
+      SubgraphUtils::generateNameForGraph(graph_));
+}
+
+bool TensorExprKernel::cudaArgsAligned(
+    const std::vector<CodeGen::CallArg>& runArgs) const {
+  if (cudaSchedule_.vectorWidth <= 1) {
+    return true;
+  }
+  for (size_t i = 0; i < bufferArgs_.size(); i++) {
+    if (bufferArgs_[i].isVar()) {
+      continue;
+    }
+    const auto alignment = static_cast<uintptr_t>(
+        cudaSchedule_.vectorWidth * bufferArgs_[i].dtype().byte_size());
+    if (reinterpret_cast<uintptr_t>(runArgs[i].data()) % alignment != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void TensorExprKernel::tuneCudaBlockSize(
+    const std::vector<CodeGen::CallArg>& runArgs) {
+  // Kernels are timed on the arguments of their first call, which they can
+  // overwrite again as they are pointwise and don't draw random numbers.
+  constexpr int kTimedRuns = 3;
+  auto bestTime = codegen_->benchmark(runArgs, kTimedRuns);
+  if (!bestTime) {
+    return;
+  }
+  CudaSchedule best = cudaSchedule_;
+  for (int blockSize : {128, 256, 1024}) {
+    CudaSchedule schedule = cudaSchedule_;
+    schedule.blockSize = blockSize;
+    try {
+      auto candidate = createCudaCodeGen(schedule);
+      auto time = candidate->benchmark(runArgs, kTimedRuns);
+      if (time && *time < *bestTime) {
+        bestTime = time;
+        best = schedule;
+        codegen_ = std::move(candidate);
+      }
+    } catch (const std::exception& e) {
+      GRAPH_DEBUG("Cannot compile with block size ", blockSize, ": ", e.what());
+    }
+  }
+  cudaSchedule_.blockSize = best.blockSize;
+  GRAPH_DEBUG(
+      "Tuned CUDA block size: ",
+      best.blockSize > 0 ? std::to_string(best.blockSize) : "default",
+      " (",
+      *bestTime,
+      " ms)");
+}
+
+void TensorExprKernel::callCodeGen(
+    const std::vector<CodeGen::CallArg>& runArgs) {
+  if (cudaStmt_) {
+    if (!cudaArgsAligned(runArgs)) {
+      // Misaligned buffers are rare enough for this kernel to keep the
+      // default block size.
+      std::call_once(cudaScalarOnce_, [&] {
+        cudaScalarCodegen_ = createCudaCodeGen(CudaSchedule());
+      });
+      cudaScalarCodegen_->call(runArgs);
+      return;
+    }
+    if (cudaTunable_) {
+      std::call_once(cudaTuneOnce_, [&] { tuneCudaBlockSize(runArgs); });
+    }
+  }
+  codegen_->call(runArgs);
+}
+
+namespace {
+
+// Records the number and duration of kernel compilations.
+class CompileTimer {
+ public:
+  CompileTimer() : start_(std::chrono::steady_clock::now()) {}
+  ~CompileTimer() {
+    auto& stats = getTEKernelStats();
+    stats.compiles++;
+    stats.compileTimeUs += std::chrono::duration_cast<std::chrono::microseconds>(
+                               std::chrono::steady_clock::now() - start_)
+                               .count();
+  }
+
+ private:
+  std::chrono::steady_clock::time_point start_;
+};
+
+// Returns a copy of graph whose inputs have the shapes of the given inputs, with
+// the shapes of all other values inferred from them.
+std::shared_ptr<Graph> specializeGraph(
+    const std::shared_ptr<Graph>& graph,
+    const at::ArrayRef<IValue>& inputs) {
+  auto specialized = graph->copy();
+  EraseShapeInformation(specialized);
+  for (size_t i = 0; i < inputs.size(); i++) {
+    if (inputs[i].isTensor()) {
+      specialized->inputs()[i]->setType(
+          TensorType::create(inputs[i].toTensor()));
+    }
+  }
+  PropagateInputShapes(specialized);
+  for (auto const& n : specialized->nodes()) {
+    for (auto const& output : n->outputs()) {
+      auto tt = output->type()->cast<TensorType>();
+      if (tt && !tt->isComplete()) {
+        throw malformed_input(
+            "cannot infer the shape of %" + output->debugName());
+      }
+    }
+  }
+  return specialized;
+}
+
+} // namespace
+
 TensorExprKernel::TensorExprKernel(const std::shared_ptr<Graph>& subgraph)
     : graph_(subgraph), code_(subgraph, "") {
   allow_fallback_ = fallbackAllowed();
   if (!allow_fallback_) {
+    CompileTimer timer;
     compile();
     return;
   }
@@ -2228,6 +2620,7 @@ TensorExprKernel::TensorExprKernel(const std::shared_ptr<Graph>& subgraph)
   }
 
   try {
+    CompileTimer timer;
     compile();
   } catch (...) {
     use_fallback_ = true;
@@ -2264,16 +2657,28 @@ std::vector<CodeGen::CallArg> TensorExprKernel::prepareRunArgs(
     }
   }
 
+  outputs.resize(tensorOutputs_.size());
   for (size_t i = 0, e = tensorOutputs_.size(); i < e; ++i) {
     auto const& opts = tensorOutputTensorOptions_[i];
-    outputs.emplace_back(codegen_->empty_strided(
-        tensorOutputSizes_[i],
-        tensorOutputStrides_[i],
-        opts.dtype,
-        opts.layout,
-        opts.device,
-        opts.pinned_memory));
-    runArgs.emplace_back(outputs.back().data_ptr());
+    auto& output = outputs[i];
+    if (output.defined() && output.scalar_type() == opts.dtype &&
+        output.device() == device_) {
+      // Dense outputs fit in the storage of a contiguous tensor of the same
+      // size, so only their strides need to be fixed up.
+      output.resize_(tensorOutputSizes_[i]);
+      if (!output.strides().equals(tensorOutputStrides_[i])) {
+        output.as_strided_(tensorOutputSizes_[i], tensorOutputStrides_[i]);
+      }
+    } else {
+      output = codegen_->empty_strided(
+          tensorOutputSizes_[i],
+          tensorOutputStrides_[i],
+          opts.dtype,
+          opts.layout,
+          opts.device,
+          opts.pinned_memory);
+    }
+    runArgs.emplace_back(output.data_ptr());
   }
   return runArgs;
 }
@@ -2282,17 +2687,115 @@ Stmt* TensorExprKernel::getCodeGenStmt() {
   return codegen_->stmt();
 }
 
+bool TensorExprKernel::matchesInputShapes(
+    const at::ArrayRef<IValue>& inputs) const {
+  for (size_t i = 0; i < inputs.size(); i++) {
+    if (!inputs[i].isTensor()) {
+      continue;
+    }
+    const auto& t = inputs[i].toTensor();
+    if (!t.sizes().equals(inputSizes_[i]) ||
+        !t.strides().equals(inputStrides_[i]) ||
+        t.scalar_type() != inputTypes_[i]->expectRef<TensorType>().scalarType()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::shared_ptr<TensorExprKernel> TensorExprKernel::getSpecialization(
+    const at::ArrayRef<IValue>& inputs) {
+  std::vector<int64_t> key;
+  for (const auto& input : inputs) {
+    if (input.isTensor()) {
+      const auto& t = input.toTensor();
+      key.push_back(static_cast<int64_t>(t.scalar_type()));
+      key.push_back(t.dim());
+      key.insert(key.end(), t.sizes().begin(), t.sizes().end());
+      key.insert(key.end(), t.strides().begin(), t.strides().end());
+    }
+  }
+
+  auto& stats = getTEKernelStats();
+  // The lock is held while compiling a new specialization, so that concurrent
+  // calls with the same new shapes compile it only once.
+  std::lock_guard<std::mutex> guard(specializationsMutex_);
+  for (auto it = specializations_.begin(); it != specializations_.end(); ++it) {
+    if (it->first == key) {
+      specializations_.splice(specializations_.begin(), specializations_, it);
+      stats.specializationHits++;
+      return it->second;
+    }
+  }
+
+  stats.specializationMisses++;
+  std::shared_ptr<TensorExprKernel> kernel;
+  try {
+    kernel = std::make_shared<TensorExprKernel>(specializeGraph(graph_, inputs));
+  } catch (const std::exception& e) {
+    // Remember the failure as well, so that these shapes are not retried.
+    GRAPH_DEBUG("Cannot specialize TensorExprKernel: ", e.what());
+  }
+  specializations_.emplace_front(std::move(key), kernel);
+  size_t cacheSize =
+      static_cast<size_t>(std::max(getTEKernelSpecializationCacheSize(), 0));
+  while (specializations_.size() > cacheSize) {
+    specializations_.pop_back();
+    stats.specializationEvictions++;
+  }
+  return kernel;
+}
+
+std::shared_ptr<TensorExprKernel> TensorExprKernel::createForInputs(
+    const std::shared_ptr<Graph>& subgraph,
+    const at::ArrayRef<IValue>& inputs) {
+  try {
+    return std::make_shared<TensorExprKernel>(specializeGraph(subgraph, inputs));
+  } catch (const std::exception& e) {
+    GRAPH_DEBUG("Cannot compile TensorExprKernel: ", e.what());
+  }
+  return nullptr;
+}
+
+bool TensorExprKernel::runWithOutputs(
+    const at::ArrayRef<IValue>& inputs,
+    std::vector<at::Tensor>& outputs) {
+  if (use_fallback_) {
+    return false;
+  }
+  if (!matchesInputShapes(inputs)) {
+    auto kernel = getSpecialization(inputs);
+    return kernel && kernel->runWithOutputs(inputs, outputs);
+  }
+
+  KernelScope kernelScope(&kernelArena_);
+  std::vector<CodeGen::CallArg> runArgs = prepareRunArgs(inputs, outputs);
+  callCodeGen(runArgs);
+  return true;
+}
+
 void TensorExprKernel::runKernel(Stack& stack) {
+  // The fusion group guard only checks ranks and dtypes when dynamic shapes
+  // are enabled; other shapes are served by specialized kernels.
+  auto inputs = last(stack, nInputs_);
+  if (!matchesInputShapes(inputs)) {
+    if (auto kernel = getSpecialization(inputs)) {
+      kernel->run(stack);
+    } else {
+      fallback(stack);
+    }
+    return;
+  }
+
   KernelScope kernelScope(&kernelArena_);
 
   // Set up arguments (inputs, then outputs) for kernel call.
-  auto inputs = last(stack, nInputs_);
   std::vector<at::Tensor> outputs;
 
   std::vector<CodeGen::CallArg> runArgs = prepareRunArgs(inputs, outputs);
 
   // Call the kernel.
-  codegen_->call(runArgs);
+  callCodeGen(runArgs);
 
   // Update the stack.
   drop(stack, nInputs_);
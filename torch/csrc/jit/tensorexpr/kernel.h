@@ -6,6 +6,10 @@
 #include <torch/csrc/jit/tensorexpr/codegen.h>
 #include <torch/csrc/jit/tensorexpr/tensor.h>
 
+#include <atomic>
+#include <list>
+#include <mutex>
+
 namespace torch {
 namespace jit {
 namespace tensorexpr {
@@ -25,6 +29,22 @@ class TORCH_API TensorExprKernel {
 
   void run(Stack& stack);
 
+  // Runs the kernel on inputs and writes the results to outputs. Outputs that
+  // are already defined with the dtype and device of the result are resized
+  // and written in place, so that their storage can be managed by the
+  // caller; the others are allocated. Returns false without running anything
+  // if the inputs can only be handled by the interpreter fallback.
+  bool runWithOutputs(
+      const at::ArrayRef<IValue>& inputs,
+      std::vector<at::Tensor>& outputs);
+
+  // Compiles subgraph, whose inputs need not carry any shape or dtype
+  // information, for the sizes, strides and dtypes of the given inputs.
+  // Returns nullptr if the graph cannot be compiled for them.
+  static std::shared_ptr<TensorExprKernel> createForInputs(
+      const std::shared_ptr<Graph>& subgraph,
+      const at::ArrayRef<IValue>& inputs);
+
   void fallback(Stack& stack) {
     InterpreterState(code_).run(stack);
   }
@@ -59,6 +79,15 @@ class TORCH_API TensorExprKernel {
 
   void runKernel(Stack& stack);
 
+  // Whether the inputs have the sizes and strides this kernel was compiled
+  // for.
+  bool matchesInputShapes(const at::ArrayRef<IValue>& inputs) const;
+
+  // Returns a kernel compiled for the shapes of the given inputs, or nullptr
+  // if the graph cannot be compiled for them.
+  std::shared_ptr<TensorExprKernel> getSpecialization(
+      const at::ArrayRef<IValue>& inputs);
+
   std::vector<DimArg> dimsFromSizes(const std::vector<ExprHandle>& sizes);
   std::vector<ExprHandle> sizesForValue(const torch::jit::Value* v);
   std::vector<ExprHandle> inferSizesForValue(const torch::jit::Value* v);
@@ -136,19 +165,47 @@ class TORCH_API TensorExprKernel {
           const ExprHandle&,
           const ExprHandle&)>& innerExpr);
 
-  Tensor* computeSum(const torch::jit::Value* v);
+  Tensor* computeReduction(
+      const torch::jit::Value* v,
+      const std::string& name,
+      const Reducer& reducer);
+
+  Tensor* computeMean(const torch::jit::Value* v);
+
+  Tensor* computeMatmul(const torch::jit::Value* v);
 
   Tensor* computeSoftmax(const torch::jit::Value* v, bool log_softmax);
 
   Tensor* computeValue(const torch::jit::Value* v);
 
-  Stmt* transformLoops(BackendType backendType, Stmt* st);
+  // How the loops of pointwise CUDA kernels are mapped to threads.
+  struct CudaSchedule {
+    // Threads per block, or -1 for the configured block size
+    int blockSize{-1};
+    // Consecutive elements handled by every thread with vector loads and
+    // stores, or 1
+    int vectorWidth{1};
+  };
+
+  Stmt* transformLoops(
+      BackendType backendType,
+      Stmt* st,
+      const CudaSchedule& cudaSchedule = CudaSchedule());
 
   std::string getCodeGenName(BackendType backendType);
 
+  std::unique_ptr<CodeGen> createCudaCodeGen(const CudaSchedule& schedule);
+
   std::vector<CodeGen::CallArg> prepareRunArgs(
       const at::ArrayRef<IValue>& inputs,
       std::vector<at::Tensor>& outputs);
+
+  // Calls the generated code. CUDA kernels are tuned on their first call,
+  // and calls whose buffers are not aligned for the vector accesses of the
+  // kernel use a kernel without them.
+  void callCodeGen(const std::vector<CodeGen::CallArg>& runArgs);
+  bool cudaArgsAligned(const std::vector<CodeGen::CallArg>& runArgs) const;
+  void tuneCudaBlockSize(const std::vector<CodeGen::CallArg>& runArgs);
   BackendType inferBackendTypeFromDevice(at::Device device);
 
   void bindInput(const torch::jit::Value* input);
@@ -197,6 +254,8 @@ class TORCH_API TensorExprKernel {
   at::Device device_ = at::kCPU;
   KernelArena kernelArena_;
   std::vector<TypePtr> inputTypes_;
+  std::vector<std::vector<int64_t>> inputSizes_;
+  std::vector<std::vector<int64_t>> inputStrides_;
   std::shared_ptr<Graph> graph_;
   Code code_;
   bool allow_fallback_{false};
@@ -205,13 +264,47 @@ class TORCH_API TensorExprKernel {
   bool hasBroadcast_{false};
   std::unordered_map<const torch::jit::Value*, std::vector<ExprHandle>>
       known_sizes_;
+
+  // The loops of a pointwise CUDA kernel before scheduling, kept to compile
+  // them with other schedules: the block sizes tried by the tuner, and the
+  // kernel without vector accesses for misaligned buffers.
+  Stmt* cudaStmt_{nullptr};
+  CudaSchedule cudaSchedule_;
+  bool cudaTunable_{false};
+  std::once_flag cudaTuneOnce_;
+  std::unique_ptr<CodeGen> cudaScalarCodegen_;
+  std::once_flag cudaScalarOnce_;
+
+  // Kernels compiled for other input shapes than the profiled ones, most
+  // recently used first. The key holds the rank, sizes and strides of every
+  // tensor input.
+  std::list<std::pair<std::vector<int64_t>, std::shared_ptr<TensorExprKernel>>>
+      specializations_;
+  std::mutex specializationsMutex_;
 };
 
+// Compilation counters of all TensorExprKernels, including the shape
+// specializations compiled at run time.
+struct TORCH_API TensorExprKernelStats {
+  std::atomic<uint64_t> compiles{0};
+  std::atomic<uint64_t> compileTimeUs{0};
+  std::atomic<uint64_t> specializationHits{0};
+  std::atomic<uint64_t> specializationMisses{0};
+  std::atomic<uint64_t> specializationEvictions{0};
+
+  void reset();
+};
+
+TORCH_API TensorExprKernelStats& getTEKernelStats();
+
 TORCH_API int& getTECudaPointwiseLoopLevels();
 TORCH_API int& getTECudaPointwiseBlockCount();
 TORCH_API int& getTECudaPointwiseBlockSize();
+TORCH_API bool& getTECudaPointwiseVectorize();
+TORCH_API bool& getTECudaPointwiseAutotune();
 TORCH_API bool& getTEGenerateBlockCode();
 TORCH_API bool& getTEMustUseLLVMOnCPU();
+TORCH_API int& getTEKernelSpecializationCacheSize();
 TORCH_API bool fallbackAllowed();
 TORCH_API bool setFallbackAllowed(bool value);
 
@@ -2,6 +2,7 @@
 
 #include <torch/csrc/jit/tensorexpr/llvm_codegen.h>
 
+#include <ATen/Parallel.h>
 #include <c10/util/Exception.h>
 #include <torch/csrc/jit/tensorexpr/llvm_jit.h>
 
@@ -14,8 +15,10 @@
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/MDBuilder.h>
 #include <llvm/IR/Verifier.h>
+#include <llvm/ADT/StringExtras.h>
 #include <llvm/MC/MCSubtargetInfo.h>
 #include <llvm/Support/Host.h>
+#include <llvm/Support/SHA1.h>
 #include <llvm/Support/TargetSelect.h>
 
 #if LLVM_VERSION_MAJOR >= 10
@@ -32,6 +35,8 @@
 #include <llvm/Support/TypeSize.h>
 #endif
 
+#include <torch/csrc/jit/tensorexpr/analysis.h>
+#include <torch/csrc/jit/tensorexpr/aot_cache.h>
 #include <torch/csrc/jit/tensorexpr/execution_counter.h>
 #include <torch/csrc/jit/tensorexpr/expr.h>
 #include <torch/csrc/jit/tensorexpr/external_functions_registry.h>
@@ -121,6 +126,19 @@ llvm::ElementCount ElementCount(int lanes) {
 }
 #endif
 
+// Identifies a kernel by its unoptimized module and the target it is compiled
+// for.
+std::string hashModule(const llvm::Module& module, llvm::TargetMachine& TM) {
+  std::string text;
+  llvm::raw_string_ostream stream(text);
+  module.print(stream, nullptr);
+  stream << TM.getTargetTriple().str() << TM.getTargetCPU()
+         << TM.getTargetFeatureString();
+  llvm::SHA1 hasher;
+  hasher.update(stream.str());
+  return llvm::toHex(hasher.result(), /*LowerCase=*/true);
+}
+
 } // namespace
 
 class LLVMCodeGenImpl : public IRVisitor {
@@ -136,10 +154,15 @@ class LLVMCodeGenImpl : public IRVisitor {
   std::unique_ptr<void* []> argv_ { nullptr };
 
 #define LLVM_TYPE_DECLARE(_1, Name) llvm::Type* Name##Ty_;
-  AT_FORALL_SCALAR_TYPES_AND2(Bool, Half, LLVM_TYPE_DECLARE);
+  AT_FORALL_SCALAR_TYPES_AND3(Bool, Half, BFloat16, LLVM_TYPE_DECLARE);
 #undef LLVM_TYPE_DECLARE
   llvm::Type* Int8PtrTy_;
 
+  // Key of the kernel in the AOTKernelCache, and its object code if it was
+  // found there.
+  std::string aotKey_;
+  c10::optional<std::string> aotObject_;
+
   std::unordered_map<const Var*, int> varToArg_;
   std::unordered_map<const Var*, llvm::Value*> varToVal_;
   std::unordered_map<const Block*, std::vector<const Var*>> scopeToVar_;
@@ -151,7 +174,11 @@ class LLVMCodeGenImpl : public IRVisitor {
   llvm::Type* dtypeToLLVMPtr(Dtype dtype);
   void emitWrapper(const std::vector<llvm::Type*>& params);
   void emitKernel(Stmt* stmt, const std::vector<llvm::Type*>& params);
+  std::string emitObject();
   llvm::Value* toVec(llvm::Value* v, int lanes);
+  llvm::Value* bfloat16ToFloat(llvm::Value* v, int lanes);
+  llvm::Value* floatToBFloat16(llvm::Value* v, int lanes);
+  void processParallelFor(const For* v);
 
   enum Arity {
     Unary,
@@ -191,7 +218,7 @@ class LLVMCodeGenImpl : public IRVisitor {
   void visit(const CompareSelect* v) override;
 
 #define IMM_VISIT_DECLARE(_1, Name) void visit(const Name##Imm* v) override;
-  AT_FORALL_SCALAR_TYPES_AND2(Bool, Half, IMM_VISIT_DECLARE);
+  AT_FORALL_SCALAR_TYPES_AND3(Bool, Half, BFloat16, IMM_VISIT_DECLARE);
 #undef IMM_VISIT_DECLARE
 
   void visit(const Cast* v) override;
@@ -260,7 +287,7 @@ static void* argToPtr(
     return callArg.Name##Ptr();
     break;
 
-    AT_FORALL_SCALAR_TYPES_AND2(Bool, Half, TYPE_CASE);
+    AT_FORALL_SCALAR_TYPES_AND3(Bool, Half, BFloat16, TYPE_CASE);
 #undef TYPE_CASE
 
     default:
@@ -321,6 +348,9 @@ LLVMCodeGenImpl::LLVMCodeGenImpl(
   IntTy_ = llvm::Type::getInt32Ty(getContext());
   LongTy_ = llvm::Type::getInt64Ty(getContext());
   HalfTy_ = llvm::Type::getHalfTy(getContext());
+  // The bits of c10::BFloat16, converted from and to float by hand as older
+  // LLVM versions don't have a bfloat type.
+  BFloat16Ty_ = llvm::Type::getInt16Ty(getContext());
   FloatTy_ = llvm::Type::getFloatTy(getContext());
   DoubleTy_ = llvm::Type::getDoubleTy(getContext());
   Int8PtrTy_ = llvm::Type::getInt8PtrTy(getContext());
@@ -334,8 +364,8 @@ LLVMCodeGenImpl::LLVMCodeGenImpl(
   module_->setDataLayout(jit_->getDataLayout());
   module_->setTargetTriple(jit_->getTargetMachine().getTargetTriple().str());
 
-  // We support float16 ops by casting expr inputs to float32
-  // and then casting the result back to float16
+  // We support float16 and bfloat16 ops by casting expr inputs to float32
+  // and then casting the result back to float16 or bfloat16
   HalfRewriter hsFix;
   stmt = stmt->accept_mutator(&hsFix);
 
@@ -366,7 +396,18 @@ LLVMCodeGenImpl::LLVMCodeGenImpl(
   emitWrapper(params);
   emitKernel(stmt, params);
 
-  jit_->addModule(std::move(module_), std::move(context_));
+  auto& aotKernels = AOTKernelCache::get();
+  if (aotObject_) {
+    jit_->addObject(
+        llvm::MemoryBuffer::getMemBufferCopy(*aotObject_, "nnc_aot_kernel"));
+  } else if (aotKernels.recording()) {
+    std::string object = emitObject();
+    aotKernels.insert(aotKey_, object);
+    jit_->addObject(
+        llvm::MemoryBuffer::getMemBufferCopy(object, "nnc_aot_kernel"));
+  } else {
+    jit_->addModule(std::move(module_), std::move(context_));
+  }
   auto sym = jit_->findSymbol("wrapper");
   kernelAddress_ = assertSuccess(sym.getAddress());
   argv_ = std::make_unique<void*[]>(params.size());
@@ -385,7 +426,7 @@ llvm::Type* LLVMCodeGenImpl::dtypeToLLVM(Dtype dtype) {
     return n##Ty_;       \
     break;
 
-    AT_FORALL_SCALAR_TYPES_AND2(Bool, Half, TYPE_CASE);
+    AT_FORALL_SCALAR_TYPES_AND3(Bool, Half, BFloat16, TYPE_CASE);
 #undef TYPE_CASE
     default:
       throw unsupported_dtype();
@@ -484,6 +525,17 @@ void LLVMCodeGenImpl::emitKernel(
   GRAPH_DEBUG(
       "\nLLVM module before optimizations\n\n", asmStream.str().str(), "\n");
 
+  // Kernels are looked up in the AOTKernelCache by a hash of the module before
+  // optimization, so that a hit skips both optimization and code generation.
+  auto& aotKernels = AOTKernelCache::get();
+  if (aotKernels.recording() || !aotKernels.empty()) {
+    aotKey_ = hashModule(*module_, jit_->getTargetMachine());
+    aotObject_ = aotKernels.lookup(aotKey_);
+    if (aotObject_) {
+      return;
+    }
+  }
+
   optimize(*module_);
 
   // print graph debug info after optimization
@@ -506,6 +558,23 @@ void LLVMCodeGenImpl::emitKernel(
       "\nLLVM module after optimizations\n\n", asmStream.str().str(), "\n");
 }
 
+std::string LLVMCodeGenImpl::emitObject() {
+  llvm::SmallVector<char, 0> objBuffer;
+  llvm::raw_svector_ostream objStream(objBuffer);
+  llvm::legacy::PassManager PM;
+  jit_->getTargetMachine().addPassesToEmitFile(
+      PM,
+      objStream,
+      nullptr,
+#if LLVM_VERSION_MAJOR >= 10
+      llvm::CodeGenFileType::CGFT_ObjectFile);
+#else
+      llvm::TargetMachine::CodeGenFileType::CGFT_ObjectFile);
+#endif
+  PM.run(*module_);
+  return std::string(objBuffer.begin(), objBuffer.end());
+}
+
 // TODO: The binary ops are copypasta.
 
 void LLVMCodeGenImpl::visit(const Add* v) {
@@ -832,6 +901,10 @@ void LLVMCodeGenImpl::visit(const HalfImm* v) {
   value_ = llvm::ConstantFP::get(HalfTy_, v->value());
 }
 
+void LLVMCodeGenImpl::visit(const BFloat16Imm* v) {
+  value_ = llvm::ConstantInt::get(BFloat16Ty_, v->value().x);
+}
+
 void LLVMCodeGenImpl::visit(const BoolImm* v) {
   value_ = llvm::ConstantInt::get(BoolTy_, v->value());
 }
@@ -845,6 +918,27 @@ llvm::Type* llvmTypeToVec(llvm::Type* type, int lanes) {
 }
 
 void LLVMCodeGenImpl::visit(const Cast* v) {
+  // BFloat16 is only converted from and to float, the other casts go through
+  // float.
+  const ScalarType srcScalarType = v->src_value()->dtype().scalar_type();
+  const ScalarType dstScalarType = v->dtype().scalar_type();
+  if ((srcScalarType == ScalarType::BFloat16) !=
+      (dstScalarType == ScalarType::BFloat16)) {
+    const ScalarType otherScalarType =
+        srcScalarType == ScalarType::BFloat16 ? dstScalarType : srcScalarType;
+    if (otherScalarType != ScalarType::Float) {
+      const Expr* floatValue = new Cast(
+          v->dtype().cloneWithScalarType(ScalarType::Float), v->src_value());
+      (new Cast(v->dtype(), floatValue))->accept(this);
+      return;
+    }
+    v->src_value()->accept(this);
+    value_ = srcScalarType == ScalarType::BFloat16
+        ? bfloat16ToFloat(value_, v->dtype().lanes())
+        : floatToBFloat16(value_, v->dtype().lanes());
+    return;
+  }
+
   v->src_value()->accept(this);
 
   llvm::Type* dstType =
@@ -973,7 +1067,7 @@ void LLVMCodeGenImpl::visit(const Ramp* v) {
   case ScalarType::Name:                                       \
     vecType = llvm::VectorType::get(Name##Ty_, element_count); \
     break;
-    AT_FORALL_SCALAR_TYPES_AND2(Bool, Half, TYPE_CASE);
+    AT_FORALL_SCALAR_TYPES_AND3(Bool, Half, BFloat16, TYPE_CASE);
 #undef TYPE_CASE
     default:
       throw std::runtime_error("invalid dtype in Ramp");
@@ -1047,7 +1141,7 @@ void LLVMCodeGenImpl::visit(const Load* v) {
   case ScalarType::Name:                                        \
     loadType = llvm::VectorType::get(Name##Ty_, element_count); \
     break;
-    AT_FORALL_SCALAR_TYPES_AND2(Bool, Half, TYPE_CASE);
+    AT_FORALL_SCALAR_TYPES_AND3(Bool, Half, BFloat16, TYPE_CASE);
 #undef TYPE_CASE
     default:
       throw std::runtime_error("invalid dtype in Load");
@@ -1109,7 +1203,100 @@ void LLVMCodeGenImpl::visit(const Load* v) {
   value_ = load;
 }
 
+// Outlines the body of a parallel loop into a function taking the loop index
+// and a pointer to the values it captures, and hands it to DispatchParallel.
+void LLVMCodeGenImpl::processParallelFor(const For* v) {
+  // Create "start" and "stop" values.
+  v->start()->accept(this);
+  auto start = this->value_;
+  v->stop()->accept(this);
+  auto stop = this->value_;
+
+  // Collect the values the body refers to from the enclosing function: kernel
+  // arguments, buffers, enclosing loop indices and let-bound vars.
+  std::vector<const Var*> captured;
+  std::vector<llvm::Value*> capturedVals;
+  std::vector<llvm::Type*> capturedTypes;
+  for (const Var* var : VarFinder::find(v->body())) {
+    if (var == v->var() || (!varToArg_.count(var) && !varToVal_.count(var))) {
+      continue;
+    }
+    var->accept(this);
+    captured.push_back(var);
+    capturedVals.push_back(value_);
+    capturedTypes.push_back(value_->getType());
+  }
+
+  // Pack them into a struct allocated in the entry block, so that nesting the
+  // loop inside another one does not grow the stack.
+  auto packedTy = llvm::StructType::get(getContext(), capturedTypes);
+  llvm::IRBuilder<> entryBuilder(
+      &fn_->getEntryBlock(), fn_->getEntryBlock().begin());
+  auto packed = entryBuilder.CreateAlloca(packedTy);
+  for (size_t i = 0; i < captured.size(); i++) {
+    irb_.CreateStore(
+        capturedVals[i], irb_.CreateStructGEP(packedTy, packed, i));
+  }
+
+  // Emit the body as `void parallel_body(int64_t index, int8_t* packed)`.
+  auto bodyTy = llvm::FunctionType::get(
+      llvm::Type::getVoidTy(getContext()), {LongTy_, Int8PtrTy_}, false);
+  auto bodyFn = llvm::Function::Create(
+      bodyTy, llvm::Function::PrivateLinkage, "parallel_body", module_.get());
+
+  auto outerFn = fn_;
+  auto outerBlock = irb_.GetInsertBlock();
+  std::unordered_map<const Var*, int> outerVarToArg;
+  std::unordered_map<const Var*, llvm::Value*> outerVarToVal;
+  std::swap(outerVarToArg, varToArg_);
+  std::swap(outerVarToVal, varToVal_);
+
+  fn_ = bodyFn;
+  irb_.SetInsertPoint(llvm::BasicBlock::Create(getContext(), "entry", fn_));
+  auto index = fn_->arg_begin();
+  auto packedArg = irb_.CreatePointerCast(
+      fn_->arg_begin() + 1, packedTy->getPointerTo());
+  for (size_t i = 0; i < captured.size(); i++) {
+    varToVal_[captured[i]] = irb_.CreateLoad(
+        capturedTypes[i], irb_.CreateStructGEP(packedTy, packedArg, i));
+  }
+  varToVal_[v->var()] =
+      irb_.CreateIntCast(index, dtypeToLLVM(v->var()->dtype()), true);
+
+  v->body()->accept(this);
+  irb_.CreateRetVoid();
+
+  fn_ = outerFn;
+  irb_.SetInsertPoint(outerBlock);
+  std::swap(outerVarToArg, varToArg_);
+  std::swap(outerVarToVal, varToVal_);
+
+  // Dispatch the iterations to the thread pool.
+  FunctionCallee dispatcher = module_->getOrInsertFunction(
+      "DispatchParallel",
+      llvm::FunctionType::get(
+          llvm::Type::getVoidTy(getContext()),
+          {Int8PtrTy_, LongTy_, LongTy_, Int8PtrTy_},
+          false));
+  auto dispatcherTy = dispatcher.getFunctionType();
+  auto dispatcherFn = dispatcher.getCallee();
+  llvm::cast<llvm::Function>(dispatcherFn)->addFnAttr(llvm::Attribute::NoUnwind);
+  irb_.CreateCall(
+      dispatcherTy,
+      dispatcherFn,
+      {irb_.CreatePointerCast(bodyFn, Int8PtrTy_),
+       irb_.CreateSExtOrTrunc(start, LongTy_),
+       irb_.CreateSExtOrTrunc(stop, LongTy_),
+       irb_.CreatePointerCast(packed, Int8PtrTy_)});
+  value_ = llvm::ConstantInt::get(IntTy_, 0);
+}
+
 void LLVMCodeGenImpl::visit(const For* v) {
+  if (v->loop_options().is_parallel()) {
+    processParallelFor(v);
+    return;
+  }
+
   // Create "start" and "stop" values.
   v->start()->accept(this);
   auto start = this->value_;
@@ -1382,6 +1569,34 @@ llvm::Value* LLVMCodeGenImpl::toVec(llvm::Value* v, int lanes) {
   }
 }
 
+llvm::Value* LLVMCodeGenImpl::bfloat16ToFloat(llvm::Value* v, int lanes) {
+  // The bfloat16 bits are the high half of the float bits
+  llvm::Value* bits = irb_.CreateZExt(v, llvmTypeToVec(IntTy_, lanes));
+  bits = irb_.CreateShl(bits, toVec(llvm::ConstantInt::get(IntTy_, 16), lanes));
+  return irb_.CreateBitCast(bits, llvmTypeToVec(FloatTy_, lanes));
+}
+
+llvm::Value* LLVMCodeGenImpl::floatToBFloat16(llvm::Value* v, int lanes) {
+  // Rounds to nearest even like c10::round_to_nearest_even, a nan becomes the
+  // canonical bfloat16 nan.
+  auto intVec = [&](int value) {
+    return toVec(llvm::ConstantInt::get(IntTy_, value), lanes);
+  };
+  llvm::Value* bits = irb_.CreateBitCast(v, llvmTypeToVec(IntTy_, lanes));
+  llvm::Value* lsb =
+      irb_.CreateAnd(irb_.CreateLShr(bits, intVec(16)), intVec(1));
+  llvm::Value* rounded =
+      irb_.CreateAdd(bits, irb_.CreateAdd(lsb, intVec(0x7fff)));
+  llvm::Value* result = irb_.CreateTrunc(
+      irb_.CreateLShr(rounded, intVec(16)),
+      llvmTypeToVec(BFloat16Ty_, lanes));
+  llvm::Value* isNan = irb_.CreateFCmpUNO(v, v);
+  return irb_.CreateSelect(
+      isNan,
+      toVec(llvm::ConstantInt::get(BFloat16Ty_, 0x7fc0), lanes),
+      result);
+}
+
 void LLVMCodeGenImpl::emitIsNan(const Intrinsics* v) {
   v->param(0)->accept(this);
   llvm::Type* dstType = dtypeToLLVM(v->dtype());
@@ -1885,4 +2100,28 @@ void LLVMCodeGenImpl::optimize(llvm::Module& M) {
 
 RegisterCodeGen<LLVMCodeGen> llvm_codegen_reg("llvm_codegen");
 
+extern "C" {
+
+typedef void (*ParallelCallee)(int64_t, int8_t*);
+void DispatchParallel(
+    int8_t* func,
+    int64_t start,
+    int64_t stop,
+    int8_t* packed_data) noexcept {
+  // Exceptions cannot unwind through the JIT-ed frames that called us, so they
+  // are reported here instead.
+  try {
+    ParallelCallee callee = reinterpret_cast<ParallelCallee>(func);
+    at::parallel_for(start, stop, 1, [&](int64_t f_begin, int64_t f_end) {
+      for (int64_t index = f_begin; index < f_end; index++) {
+        callee(index, packed_data);
+      }
+    });
+  } catch (const std::exception& e) {
+    TORCH_WARN("Exception in a parallel NNC loop: ", e.what());
+  }
+}
+
+} // extern "C"
+
 #endif // TORCH_ENABLE_LLVM
@@ -66,4 +66,15 @@ class TORCH_API LLVMCodeGen : public CodeGen {
 } // namespace jit
 } // namespace torch
 
+extern "C" {
+// Runtime entry point for loops marked parallel. Calls func(index, packed_data)
+// for every index in [start, stop) on the intra-op thread pool; packed_data
+// holds the values the loop body captured from the enclosing kernel.
+TORCH_API void DispatchParallel(
+    int8_t* func,
+    int64_t start,
+    int64_t stop,
+    int8_t* packed_data) noexcept;
+}
+
 #endif // TORCH_ENABLE_LLVM
@@ -1,6 +1,7 @@
 #ifdef TORCH_ENABLE_LLVM
 
 #include <torch/csrc/jit/tensorexpr/intrinsic_symbols.h>
+#include <torch/csrc/jit/tensorexpr/llvm_codegen.h>
 #include <torch/csrc/jit/tensorexpr/llvm_jit.h>
 
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
@@ -83,6 +84,8 @@ static void registerIntrinsics(
     intrinsics.insert(sym.symbol);
   }
   assertSuccess(JD.define(absoluteSymbols(symbols)));
+  assertSuccess(
+      JD.define(absoluteSymbols({entry("DispatchParallel", DispatchParallel)})));
 
   for (const auto& kv : getNNCFunctionRegistry()) {
     assertSuccess(
@@ -132,6 +135,12 @@ class TORCH_API PytorchLLVMJITImpl {
         "Failed to add module to compile layer");
   }
 
+  void addObject(std::unique_ptr<MemoryBuffer> Obj) {
+    assertSuccess(
+        LLJ->addObjectFile(std::move(Obj)),
+        "Failed to add object to the JIT");
+  }
+
   JITSymbol findSymbol(const std::string Name) {
     return assertSuccess(LLJ->lookup(Name));
   }
@@ -209,6 +218,13 @@ class TORCH_API PytorchLLVMJITImpl {
         "Failed to add module to compile layer");
   }
 
+  void addObject(std::unique_ptr<MemoryBuffer> Obj) {
+    auto K = ES.allocateVModule();
+    assertSuccess(
+        ObjectLayer.addObject(K, std::move(Obj)),
+        "Failed to add object to the JIT");
+  }
+
   JITSymbol findSymbol(const std::string Name) {
     std::string MangledName;
     raw_string_ostream MangledNameStream(MangledName);
@@ -248,6 +264,10 @@ void PytorchLLVMJIT::addModule(
   impl_->addModule(std::move(M), std::move(C));
 }
 
+void PytorchLLVMJIT::addObject(std::unique_ptr<MemoryBuffer> Obj) {
+  impl_->addObject(std::move(Obj));
+}
+
 JITSymbol PytorchLLVMJIT::findSymbol(const std::string Name) {
   return impl_->findSymbol(std::move(Name));
 }
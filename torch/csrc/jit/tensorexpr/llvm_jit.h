@@ -7,6 +7,7 @@
 #include <llvm/ExecutionEngine/JITSymbol.h>
 #include <llvm/ExecutionEngine/Orc/Core.h>
 #include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Target/TargetMachine.h>
 
 #include <memory>
@@ -50,6 +51,8 @@ class TORCH_API PytorchLLVMJIT {
 
   void addModule(std::unique_ptr<Module> M, std::unique_ptr<LLVMContext> C);
 
+  void addObject(std::unique_ptr<MemoryBuffer> Obj);
+
   JITSymbol findSymbol(const std::string Name);
 
   bool hasSymbol(const std::string& Name);
@@ -538,17 +538,33 @@ class TORCH_API LoopOptions {
     gpu_thread_index_ = index;
   }
 
+  // CPU parallel loop: iterations are independent and may be distributed
+  // across the intra-op thread pool.
+  bool is_parallel() const {
+    return is_parallel_;
+  }
+
+  void set_parallel() {
+    if (is_gpu_block_index() || is_gpu_thread_index()) {
+      throw std::runtime_error("Cannot parallelize a loop bound to a GPU axis");
+    }
+    is_parallel_ = true;
+  }
+
   std::string ToString() const {
     if (is_gpu_block_index()) {
       return gpu_block_index_str();
     } else if (is_gpu_thread_index()) {
       return gpu_thread_index_str();
+    } else if (is_parallel()) {
+      return "parallel";
     }
     return "";
   }
 
   bool isDefault() const {
-    return gpu_block_index_ == IDX_UNSET && gpu_thread_index_ == IDX_UNSET;
+    return gpu_block_index_ == IDX_UNSET && gpu_thread_index_ == IDX_UNSET &&
+        !is_parallel_;
   }
 
   void set_buffer_mapping(
@@ -563,6 +579,7 @@ class TORCH_API LoopOptions {
  private:
   int gpu_block_index_{IDX_UNSET};
   int gpu_thread_index_{IDX_UNSET};
+  bool is_parallel_{false};
   std::unordered_map<std::string, const Buf*> map_input_to_tensor_bufs_;
 };
 
@@ -647,6 +664,10 @@ class TORCH_API For : public StmtNode<For> {
     loop_options_.set_gpu_thread_index(thread_index);
   }
 
+  void set_parallel() {
+    loop_options_.set_parallel();
+  }
+
   void set_buffer_map(const std::unordered_map<std::string, const Buf*>& map) {
     loop_options_.set_buffer_mapping(map);
   }
@@ -1,6 +1,7 @@
 #include <pybind11/functional.h>
 #include <pybind11/operators.h>
 #include <torch/csrc/jit/python/pybind_utils.h>
+#include <torch/csrc/jit/tensorexpr/aot_cache.h>
 #include <torch/csrc/jit/tensorexpr/codegen.h>
 #ifdef USE_CUDA
 #include <torch/csrc/jit/tensorexpr/cuda_codegen.h>
@@ -27,7 +28,7 @@ void initTensorExprBindings(PyObject* module) {
 #define DTYPE_SINGLETON_ACCESSOR(ctype, name) \
   dtype_class.def_property_readonly_static(   \
       #name, [](py::object) { return k##name; }); // NOLINT
-  AT_FORALL_SCALAR_TYPES_AND2(Bool, Half, DTYPE_SINGLETON_ACCESSOR)
+  AT_FORALL_SCALAR_TYPES_AND3(Bool, Half, BFloat16, DTYPE_SINGLETON_ACCESSOR)
 #undef DTYPE_SINGLETON_ACCESSOR
 
   auto expr_handle_class =
@@ -102,7 +103,7 @@ void initTensorExprBindings(PyObject* module) {
 
 #define EXPRHANDLE_CTOR(ctype, name) \
   expr_handle_class.def_static(#ctype, [](ctype v) { return ExprHandle(v); });
-  AT_FORALL_SCALAR_TYPES_AND2(Bool, Half, EXPRHANDLE_CTOR)
+  AT_FORALL_SCALAR_TYPES_AND3(Bool, Half, BFloat16, EXPRHANDLE_CTOR)
 #undef EXPRHANDLE_CTOR
 
   py::class_<VarHandle, ExprHandle>(te, "VarHandle")
@@ -413,6 +414,13 @@ void initTensorExprBindings(PyObject* module) {
         }
         return cg;
       });
+
+  te.def("set_aot_recording", [](bool recording) {
+    AOTKernelCache::get().setRecording(recording);
+  });
+  te.def("aot_recording", []() { return AOTKernelCache::get().recording(); });
+  te.def("aot_kernel_keys", []() { return AOTKernelCache::get().keys(); });
+  te.def("clear_aot_kernels", []() { AOTKernelCache::get().clear(); });
 }
 } // namespace jit
 } // namespace torch
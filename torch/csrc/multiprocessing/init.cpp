@@ -1,4 +1,5 @@
 #include <torch/csrc/python_headers.h>
+#include <torch/csrc/multiprocessing/shared_memory_pool.h>
 #include <torch/csrc/utils/object_ptr.h>
 #include <torch/csrc/utils/pybind.h>
 
@@ -34,6 +35,10 @@ PyObject* multiprocessing_init(PyObject* _unused, PyObject *noargs) {
 #endif
   });
 
+  module.def("_set_shared_memory_pool_size", [](size_t segments) {
+    setSharedMemoryPoolSize(segments);
+  });
+
   Py_RETURN_TRUE;
 }
 
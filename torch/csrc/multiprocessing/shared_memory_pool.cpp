@@ -0,0 +1,198 @@
+#include <torch/csrc/multiprocessing/shared_memory_pool.h>
+
+#include <TH/THAllocator.h>
+#include <c10/util/Exception.h>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <c10/util/win32-headers.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace torch {
+namespace multiprocessing {
+
+namespace {
+
+// The counter of references of other processes follows the data of a segment
+constexpr size_t kCounterBytes = 64;
+// Segments are rounded up to pages, reused ones may waste up to half
+constexpr size_t kPageBytes = 4096;
+
+struct Segment {
+  explicit Segment(std::unique_ptr<THMapAllocator> mapping)
+      : mapping(std::move(mapping)),
+        capacity(this->mapping->size() - kCounterBytes) {}
+
+  void* data() const {
+    return mapping->data();
+  }
+
+  std::atomic<int64_t>* references() const {
+    return reinterpret_cast<std::atomic<int64_t>*>(
+        static_cast<char*>(mapping->data()) + capacity);
+  }
+
+  std::unique_ptr<THMapAllocator> mapping;
+  size_t capacity;
+};
+
+std::string newHandle() {
+  static std::random_device rd;
+  std::string handle = "/torch_";
+#ifdef _WIN32
+  handle += std::to_string(GetCurrentProcessId());
+#else
+  handle += std::to_string(getpid());
+#endif
+  handle += "_";
+  handle += std::to_string(rd());
+  return handle;
+}
+
+struct Pool {
+  std::mutex mutex;
+  size_t size = 0;
+  // Released segments, most recently released first
+  std::deque<std::unique_ptr<Segment>> segments;
+};
+
+// Leaked, so that storages freed during shutdown can still be released to it
+Pool& pool() {
+  static Pool* pool = new Pool();
+  return *pool;
+}
+
+// Deleter of the storages created in this process, returns their segment to
+// the pool
+void releaseOwnedSegment(void* ctx) {
+  std::unique_ptr<Segment> segment(static_cast<Segment*>(ctx));
+  std::vector<std::unique_ptr<Segment>> dropped;
+  auto& p = pool();
+  std::lock_guard<std::mutex> lock(p.mutex);
+  p.segments.push_front(std::move(segment));
+  while (p.segments.size() > p.size) {
+    dropped.push_back(std::move(p.segments.back()));
+    p.segments.pop_back();
+  }
+}
+
+// Deleter of the storages rebuilt from a received segment
+void releaseReceivedSegment(void* ctx) {
+  std::unique_ptr<Segment> segment(static_cast<Segment*>(ctx));
+  segment->references()->fetch_sub(1, std::memory_order_release);
+}
+
+Segment* fromDataPtr(const at::DataPtr& data_ptr) {
+  if (auto segment = data_ptr.cast_context<Segment>(&releaseOwnedSegment)) {
+    return segment;
+  }
+  return data_ptr.cast_context<Segment>(&releaseReceivedSegment);
+}
+
+} // namespace
+
+void setSharedMemoryPoolSize(size_t segments) {
+  std::vector<std::unique_ptr<Segment>> dropped;
+  auto& p = pool();
+  std::lock_guard<std::mutex> lock(p.mutex);
+  p.size = segments;
+  while (p.segments.size() > p.size) {
+    dropped.push_back(std::move(p.segments.back()));
+    p.segments.pop_back();
+  }
+}
+
+at::DataPtr allocatePooledSharedMemory(size_t nbytes) {
+  const size_t capacity = (nbytes + kPageBytes - 1) / kPageBytes * kPageBytes;
+  auto& p = pool();
+  {
+    std::lock_guard<std::mutex> lock(p.mutex);
+    if (p.size == 0 || nbytes == 0) {
+      return at::DataPtr();
+    }
+    for (auto it = p.segments.begin(); it != p.segments.end(); ++it) {
+      auto& segment = *it;
+      if (segment->capacity >= nbytes && segment->capacity / 2 <= capacity &&
+          segment->references()->load(std::memory_order_acquire) == 0) {
+        auto reused = segment.release();
+        p.segments.erase(it);
+        return at::DataPtr(
+            reused->data(), reused, &releaseOwnedSegment, at::DeviceType::CPU);
+      }
+    }
+  }
+
+  int flags = TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_EXCLUSIVE |
+      TH_ALLOCATOR_MAPPED_KEEPFD | TH_ALLOCATOR_MAPPED_UNLINK;
+  auto segment = std::make_unique<Segment>(std::make_unique<THMapAllocator>(
+      newHandle().c_str(), flags, capacity + kCounterBytes));
+  new (segment->references()) std::atomic<int64_t>(0);
+  auto data = segment->data();
+  return at::DataPtr(
+      data, segment.release(), &releaseOwnedSegment, at::DeviceType::CPU);
+}
+
+int pooledSharedMemoryFd(const at::DataPtr& data_ptr) {
+  auto segment = fromDataPtr(data_ptr);
+  return segment ? segment->mapping->fd() : -1;
+}
+
+at::DataPtr receivePooledSharedMemory(int fd) {
+  std::unique_ptr<THMapAllocator> mapping;
+  try {
+#ifndef _WIN32
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) == -1) {
+      AT_ERROR("unable to stat the received shared memory segment");
+    }
+    TORCH_INTERNAL_ASSERT(
+        static_cast<size_t>(file_stat.st_size) > kCounterBytes);
+    int flags = TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_NOCREATE |
+        TH_ALLOCATOR_MAPPED_KEEPFD | TH_ALLOCATOR_MAPPED_FROMFD;
+    mapping = std::make_unique<THMapAllocator>(
+        WITH_FD, nullptr, fd, flags, file_stat.st_size);
+#else
+    AT_ERROR("pooled shared memory segments are unsupported on Windows");
+#endif
+  } catch (...) {
+#ifndef _WIN32
+    ::close(fd);
+#endif
+    throw;
+  }
+  auto segment = std::make_unique<Segment>(std::move(mapping));
+  auto data = segment->data();
+  return at::DataPtr(
+      data, segment.release(), &releaseReceivedSegment, at::DeviceType::CPU);
+}
+
+bool retainPooledSharedMemory(const at::DataPtr& data_ptr) {
+  auto segment = fromDataPtr(data_ptr);
+  if (!segment) {
+    return false;
+  }
+  segment->references()->fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+bool releasePooledSharedMemory(const at::DataPtr& data_ptr) {
+  auto segment = fromDataPtr(data_ptr);
+  if (!segment) {
+    return false;
+  }
+  segment->references()->fetch_sub(1, std::memory_order_release);
+  return true;
+}
+
+} // namespace multiprocessing
+} // namespace torch
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <c10/core/Allocator.h>
+
+#include <cstddef>
+
+namespace torch {
+namespace multiprocessing {
+
+// NOTE [ Shared Memory Pool ]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// With the file_descriptor sharing strategy, every storage sent to another
+// process lives in its own shared memory segment, so a DataLoader worker pays
+// for shm_open, ftruncate, mmap, the page faults of fresh memory and munmap
+// for every batch it returns.
+//
+// When the pool is enabled, the segments of storages created by
+// _new_using_fd are kept by the process after their storage is freed, and
+// given to the next storages of about the same size. Every segment ends with a
+// counter of the references other processes hold on it: pickling the storage
+// increments it, and the receiving process decrements it when the storage it
+// rebuilt is freed, or right away if it already had the storage. A segment is
+// only reused once the counter is back to zero, so a worker ends up cycling
+// through the same few segments while the main process frees the batches.
+//
+// The pool keeps at most the given number of segments, dropping the least
+// recently released ones. Dropping a segment only unmaps it in this process;
+// the processes still using it keep their own mappings.
+
+// Sets the number of released segments the pool of this process keeps. 0, the
+// default, disables the pool and releases the segments it holds.
+void setSharedMemoryPoolSize(size_t segments);
+
+// Returns nbytes in a pooled shared memory segment, or an empty DataPtr if the
+// pool is disabled.
+at::DataPtr allocatePooledSharedMemory(size_t nbytes);
+
+// Returns the file descriptor of the pooled segment of data_ptr, or -1 if
+// data_ptr isn't in a pooled segment.
+int pooledSharedMemoryFd(const at::DataPtr& data_ptr);
+
+// Maps the pooled segment fd, received from another process, and takes
+// ownership of fd. The reference counted when it was sent is released when
+// the DataPtr is freed.
+at::DataPtr receivePooledSharedMemory(int fd);
+
+// Counts one more reference of another process on the pooled segment of
+// data_ptr, or returns false if data_ptr isn't in a pooled segment.
+bool retainPooledSharedMemory(const at::DataPtr& data_ptr);
+
+// Releases one reference counted by retainPooledSharedMemory on the pooled
+// segment of data_ptr, or returns false if data_ptr isn't in a pooled segment.
+bool releasePooledSharedMemory(const at::DataPtr& data_ptr);
+
+} // namespace multiprocessing
+} // namespace torch
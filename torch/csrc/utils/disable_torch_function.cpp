@@ -3,10 +3,27 @@
 #include <torch/csrc/Exceptions.h>
 #include <torch/csrc/utils/python_strings.h>
 
+#include <unordered_map>
+
 namespace torch {
   static thread_local bool enable_torch_function = true;
   PyObject* disabled_torch_function = nullptr;
 
+  // Whether the instances of a type have a __torch_function__ other than
+  // disabled_torch_function, cached per type so that arguments of a type
+  // seen before cost one lookup instead of an attribute lookup through the
+  // MRO. Entries are keyed by the type's version tag, which CPython changes
+  // whenever the type or one of its bases is modified and never reuses for
+  // another type. Only accessed with the GIL held.
+  struct TorchFunctionTypeCacheEntry {
+    unsigned int version_tag;
+    bool has_torch_function;
+  };
+  static std::unordered_map<PyTypeObject*, TorchFunctionTypeCacheEntry>
+      torch_function_type_cache;
+  // Dropped rather than evicted, it only fills up with types created in a loop
+  constexpr size_t kMaxTorchFunctionTypeCacheSize = 1024;
+
   bool torch_function_enabled() {
       return enable_torch_function;
   }
@@ -17,6 +34,7 @@ namespace torch {
 
   void set_disabled_torch_function_impl(PyObject* value) {
     disabled_torch_function = value;
+    torch_function_type_cache.clear();
   }
 }
 
@@ -166,6 +184,32 @@ inline bool has_torch_function_attr(PyObject* obj) {
     attr.ptr() != torch::disabled_torch_function);
 }
 
+// The result only depends on the type when attributes are looked up the
+// default way. Attributes set on an instance's __dict__ are not expected to
+// differ from the class, __torch_function__ being a (class) method.
+static bool has_torch_function_attr_cached(PyObject* obj) {
+  PyTypeObject *tp = Py_TYPE(obj);
+  if (tp->tp_getattro != PyObject_GenericGetAttr) {
+    return has_torch_function_attr(obj);
+  }
+  auto& cache = torch::torch_function_type_cache;
+  auto it = cache.find(tp);
+  if (it != cache.end() &&
+      PyType_HasFeature(tp, Py_TPFLAGS_VALID_VERSION_TAG) &&
+      it->second.version_tag == tp->tp_version_tag) {
+    return it->second.has_torch_function;
+  }
+  const bool result = has_torch_function_attr(obj);
+  // the lookup above assigns a version tag unless the type can't have one
+  if (PyType_HasFeature(tp, Py_TPFLAGS_VALID_VERSION_TAG)) {
+    if (cache.size() >= torch::kMaxTorchFunctionTypeCacheSize) {
+      cache.clear();
+    }
+    cache[tp] = {tp->tp_version_tag, result};
+  }
+  return result;
+}
+
 namespace torch {
 auto check_has_torch_function(PyObject* obj) -> bool
 {
@@ -174,7 +218,7 @@ auto check_has_torch_function(PyObject* obj) -> bool
     !THPVariable_CheckTypeExact(tp) &&
     !is_basic_python_type(tp) &&
     torch::torch_function_enabled() &&
-    has_torch_function_attr(obj)
+    has_torch_function_attr_cached(obj)
   );
 }
 } // namespace torch
@@ -1,3 +1,4 @@
+#include <ATen/core/Vitals.h>
 #include <ATen/core/ivalue.h>
 #include <torch/csrc/utils/init.h>
 #include <torch/csrc/utils/throughput_benchmark.h>
@@ -17,11 +18,18 @@ void initThroughputBenchmarkBindings(PyObject* module) {
       .def_readwrite("num_worker_threads", &BenchmarkConfig::num_worker_threads)
       .def_readwrite("num_warmup_iters", &BenchmarkConfig::num_warmup_iters)
       .def_readwrite("num_iters", &BenchmarkConfig::num_iters)
-      .def_readwrite("profiler_output_path", &BenchmarkConfig::profiler_output_path);
+      .def_readwrite("profiler_output_path", &BenchmarkConfig::profiler_output_path)
+      .def_readwrite("target_qps", &BenchmarkConfig::target_qps)
+      .def_readwrite("cpu_affinity", &BenchmarkConfig::cpu_affinity);
 
   py::class_<BenchmarkExecutionStats>(m, "BenchmarkExecutionStats")
       .def_readonly("latency_avg_ms", &BenchmarkExecutionStats::latency_avg_ms)
-      .def_readonly("num_iters", &BenchmarkExecutionStats::num_iters);
+      .def_readonly("num_iters", &BenchmarkExecutionStats::num_iters)
+      .def_readonly("total_time_ms", &BenchmarkExecutionStats::total_time_ms)
+      .def_readonly("latency_p50_ms", &BenchmarkExecutionStats::latency_p50_ms)
+      .def_readonly("latency_p90_ms", &BenchmarkExecutionStats::latency_p90_ms)
+      .def_readonly("latency_p99_ms", &BenchmarkExecutionStats::latency_p99_ms)
+      .def_readonly("latency_p999_ms", &BenchmarkExecutionStats::latency_p999_ms);
 
   py::class_<ThroughputBenchmark>(m, "ThroughputBenchmark", py::dynamic_attr())
       .def(py::init<jit::Module>())
@@ -50,4 +58,56 @@ void initThroughputBenchmarkBindings(PyObject* module) {
 }
 
 } // namespace throughput_benchmark
+
+namespace vitals {
+
+void initVitalsBindings(PyObject* module) {
+  auto m = py::handle(module).cast<py::module>();
+  using namespace at::vitals;
+  // Metrics live until the end of the process, so Python only holds
+  // references to them
+  py::class_<Counter, std::unique_ptr<Counter, py::nodelete>>(m, "_VitalsCounter")
+      .def("add", &Counter::add, py::arg("n") = 1)
+      .def("value", &Counter::value);
+
+  py::class_<Gauge, std::unique_ptr<Gauge, py::nodelete>>(m, "_VitalsGauge")
+      .def("set", &Gauge::set)
+      .def("add", &Gauge::add)
+      .def("value", &Gauge::value);
+
+  py::class_<Histogram, std::unique_ptr<Histogram, py::nodelete>>(m, "_VitalsHistogram")
+      .def("observe", &Histogram::observe)
+      .def("bounds", &Histogram::bounds)
+      .def("counts", &Histogram::counts)
+      .def("count", &Histogram::count)
+      .def("sum", &Histogram::sum);
+
+  m.def("_vitals_counter", &counter, py::return_value_policy::reference);
+  m.def("_vitals_gauge", &gauge, py::return_value_policy::reference);
+  m.def("_vitals_histogram", &histogram, py::return_value_policy::reference);
+  m.def("_vitals_snapshot", []() {
+    py::dict result;
+    for (const auto& snapshot : snapshotMetrics()) {
+      switch (snapshot.kind) {
+        case MetricKind::Counter:
+        case MetricKind::Gauge:
+          result[py::str(snapshot.name)] = snapshot.value;
+          break;
+        case MetricKind::Histogram: {
+          py::dict histogram;
+          histogram["bounds"] = snapshot.bounds;
+          histogram["counts"] = snapshot.counts;
+          histogram["count"] = snapshot.count;
+          histogram["sum"] = snapshot.sum;
+          result[py::str(snapshot.name)] = histogram;
+          break;
+        }
+      }
+    }
+    return result;
+  });
+  m.def("_vitals_reset", &resetMetrics);
+}
+
+} // namespace vitals
 } // namespace torch
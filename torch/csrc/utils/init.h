@@ -9,3 +9,11 @@ void initThroughputBenchmarkBindings(PyObject* module);
 
 } // namespace throughput_benchmark
 } // namespace torch
+
+namespace torch {
+namespace vitals {
+
+void initVitalsBindings(PyObject* module);
+
+} // namespace vitals
+} // namespace torch
@@ -507,6 +507,23 @@ auto FunctionParameter::check(PyObject* obj, std::vector<py::handle> &overloaded
   }
 }
 
+// Whether check() may give different results for objects of the same type.
+// Tensor subclasses, sequences and any type that isn't listed below are
+// treated as such, e.g. because of the contents of a list, the dimension of a
+// tensor, or whether __torch_function__ is currently enabled.
+static bool check_depends_on_value(const FunctionParameter& param, PyObject* obj) {
+  if (param.type_ == ParameterType::PYOBJECT) {
+    return false;
+  }
+  if (THPVariable_CheckExact(obj)) {
+    return param.type_ != ParameterType::TENSOR;
+  }
+  return !(PyLong_CheckExact(obj) || PyFloat_CheckExact(obj) || PyBool_Check(obj) ||
+           PyComplex_CheckExact(obj) || PyUnicode_CheckExact(obj) || obj == Py_None ||
+           THPDtype_Check(obj) || THPLayout_Check(obj) || THPMemoryFormat_Check(obj) ||
+           THPDevice_Check(obj) || THPGenerator_Check(obj) || THPQScheme_Check(obj));
+}
+
 std::string FunctionParameter::type_name() const {
   switch (type_) {
     case ParameterType::TENSOR: return "Tensor";
@@ -868,11 +885,14 @@ static void extra_kwargs(FunctionSignature& signature, PyObject* kwargs, ssize_t
 }
 
 bool FunctionSignature::parse(PyObject* self, PyObject* args, PyObject* kwargs, PyObject* dst[],  // NOLINT
-                              bool raise_exception) {
+                              bool raise_exception, bool* failed_on_value) {
   auto nargs = args ? PyTuple_GET_SIZE(args) : 0;
   ssize_t remaining_kwargs = kwargs ? PyDict_Size(kwargs) : 0;
   ssize_t arg_pos = 0;
   bool allow_varargs_intlist = false;
+  if (failed_on_value) {
+    *failed_on_value = false;
+  }
 
   // if there is a single positional IntArrayRef argument, i.e. expand(..), view(...),
   // allow a var-args style IntArrayRef, so expand(5,3) behaves as expand((5,3))
@@ -919,6 +939,9 @@ bool FunctionSignature::parse(PyObject* self, PyObject* args, PyObject* kwargs,
       is_kwd = true;
     }
 
+    if (obj && failed_on_value && check_depends_on_value(param, obj)) {
+      *failed_on_value = true;
+    }
     if ((!obj && param.optional) || (obj == Py_None && param.allow_none)) {
       dst[i++] = nullptr;
     } else if (!obj) {
@@ -1015,6 +1038,48 @@ void PythonArgParser::check_deprecated(const FunctionSignature & signature) {
   }
 }
 
+int PythonArgParser::find_cached_signature(PyObject* args) const {
+  auto nargs = args ? PyTuple_GET_SIZE(args) : 0;
+  for (const auto& cached : signature_cache_) {
+    if (static_cast<ssize_t>(cached.arg_types.size()) != nargs) {
+      continue;
+    }
+    bool same_types = true;
+    for (ssize_t i = 0; i < nargs && same_types; ++i) {
+      same_types = cached.arg_types[i] == (PyObject*)Py_TYPE(PyTuple_GET_ITEM(args, i));
+    }
+    if (same_types) {
+      return cached.signature_idx;
+    }
+  }
+  return -1;
+}
+
+void PythonArgParser::cache_signature(PyObject* args, int signature_idx) {
+  static constexpr size_t kMaxCachedSignatures = 8;
+  auto nargs = args ? PyTuple_GET_SIZE(args) : 0;
+  CachedSignature cached;
+  cached.signature_idx = signature_idx;
+  cached.arg_types.reserve(nargs);
+  for (ssize_t i = 0; i < nargs; ++i) {
+    auto type = (PyObject*)Py_TYPE(PyTuple_GET_ITEM(args, i));
+    // Parsers are static and outlive the interpreter, so the types are only
+    // released when evicted
+    Py_INCREF(type);
+    cached.arg_types.push_back(type);
+  }
+  if (signature_cache_.size() < kMaxCachedSignatures) {
+    signature_cache_.push_back(std::move(cached));
+    return;
+  }
+  auto& evicted = signature_cache_[next_evicted_signature_];
+  for (auto type : evicted.arg_types) {
+    Py_DECREF(type);
+  }
+  evicted = std::move(cached);
+  next_evicted_signature_ = (next_evicted_signature_ + 1) % kMaxCachedSignatures;
+}
+
 PythonArgs PythonArgParser::raw_parse(PyObject* self, PyObject* args, PyObject* kwargs, PyObject* parsed_args[]) {  // NOLINT
   if (signatures_.size() == 1) {
     auto& signature = signatures_[0];
@@ -1023,13 +1088,34 @@ PythonArgs PythonArgParser::raw_parse(PyObject* self, PyObject* args, PyObject*
     return PythonArgs(traceable, signature, parsed_args);
   }
 
-  for (auto& signature : signatures_) {
+  // The first signature that matches wins. For calls without keyword
+  // arguments, we remember which one matched for the types of the arguments,
+  // if the signatures before it were ruled out by these types alone. Later
+  // calls with the same types can then skip them. The GIL protects the cache.
+  const bool use_cache = !kwargs || PyDict_Size(kwargs) == 0;
+  int cached_idx = use_cache ? find_cached_signature(args) : -1;
+  if (cached_idx >= 0) {
+    auto& signature = signatures_[cached_idx];
     if (signature.parse(self, args, kwargs, parsed_args, false)) {
       check_deprecated(signature);
       return PythonArgs(traceable, signature, parsed_args);
     }
   }
 
+  bool ruled_out_by_types = true;
+  for (size_t i = 0; i < signatures_.size(); ++i) {
+    auto& signature = signatures_[i];
+    bool failed_on_value = false;
+    if (signature.parse(self, args, kwargs, parsed_args, false, &failed_on_value)) {
+      if (use_cache && ruled_out_by_types && cached_idx < 0) {
+        cache_signature(args, i);
+      }
+      check_deprecated(signature);
+      return PythonArgs(traceable, signature, parsed_args);
+    }
+    ruled_out_by_types = ruled_out_by_types && !failed_on_value;
+  }
+
   print_error(self, args, kwargs, parsed_args);
 }
 
@@ -113,17 +113,32 @@ private:
   void print_error(PyObject* self, PyObject* args, PyObject* kwargs, PyObject* parsed_args[]);
   void check_deprecated(const FunctionSignature & signature);
   PythonArgs raw_parse(PyObject* self, PyObject* args, PyObject* kwargs, PyObject* parsed_args[]);
+  int find_cached_signature(PyObject* args) const;
+  void cache_signature(PyObject* args, int signature_idx);
 
   std::vector<FunctionSignature> signatures_;
   std::string function_name;
   ssize_t max_args;
   bool traceable;
+
+  // The overload that matched for a tuple of positional argument types, see
+  // raw_parse. The types are referenced, so that their addresses can't be
+  // reused by other types.
+  struct CachedSignature {
+    std::vector<PyObject*> arg_types;
+    int signature_idx;
+  };
+  std::vector<CachedSignature> signature_cache_;
+  size_t next_evicted_signature_ = 0;
 };
 
 struct PYBIND11_EXPORT FunctionSignature {
   explicit FunctionSignature(const std::string& fmt, int index);
 
-  bool parse(PyObject* self, PyObject* args, PyObject* kwargs, PyObject* dst[], bool raise_exception);
+  // If the arguments don't match, failed_on_value is set to whether the
+  // outcome may be different for other arguments of the same types
+  bool parse(PyObject* self, PyObject* args, PyObject* kwargs, PyObject* dst[], bool raise_exception,
+             bool* failed_on_value = nullptr);
 
   std::string toString() const;
 
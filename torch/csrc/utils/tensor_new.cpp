@@ -277,7 +277,8 @@ Tensor internal_new_from_data(
 
   if (is_numpy_available() && PyArray_Check(data)) {
     TORCH_CHECK(!pin_memory, "Can't pin tensor constructed from numpy");
-    auto tensor = tensor_from_numpy(data, /*warn_if_not_writeable=*/!copy_numpy);
+    // torch.tensor copies anyway, and torch.as_tensor is allowed to copy
+    auto tensor = tensor_from_numpy(data, /*warn_if_not_writeable=*/!copy_numpy, /*flip_negative_strides=*/true);
     const auto& inferred_scalar_type = type_inference ? tensor.scalar_type() : scalar_type;
     auto device = device_opt.has_value() ? *device_opt : at::Device(computeDeviceType(dispatch_key));
     pybind11::gil_scoped_release no_gil;
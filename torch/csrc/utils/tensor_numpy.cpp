@@ -8,7 +8,7 @@ namespace torch { namespace utils {
 PyObject* tensor_to_numpy(const at::Tensor& tensor) {
   throw std::runtime_error("PyTorch was compiled without NumPy support");
 }
-at::Tensor tensor_from_numpy(PyObject* obj, bool warn_if_not_writeable/*=true*/) {
+at::Tensor tensor_from_numpy(PyObject* obj, bool warn_if_not_writeable/*=true*/, bool flip_negative_strides/*=false*/) {
   throw std::runtime_error("PyTorch was compiled without NumPy support");
 }
 
@@ -131,6 +131,12 @@ PyObject* tensor_to_numpy(const at::Tensor& tensor) {
     stride *= element_size_in_bytes;
   }
 
+  // Tensors made with from_blob, e.g. from_numpy of an unaligned array, may
+  // not be aligned, and NumPy must not assume they are
+  int flags = NPY_ARRAY_WRITEABLE;
+  if (reinterpret_cast<uintptr_t>(tensor.data_ptr()) % element_size_in_bytes == 0) {
+    flags |= NPY_ARRAY_ALIGNED;
+  }
   auto array = THPObjectPtr(PyArray_New(
       &PyArray_Type,
       tensor.dim(),
@@ -139,7 +145,7 @@ PyObject* tensor_to_numpy(const at::Tensor& tensor) {
       strides.data(),
       tensor.data_ptr(),
       0,
-      NPY_ARRAY_ALIGNED | NPY_ARRAY_WRITEABLE,
+      flags,
       nullptr));
   if (!array) return nullptr;
 
@@ -158,7 +164,7 @@ PyObject* tensor_to_numpy(const at::Tensor& tensor) {
   return array.release();
 }
 
-at::Tensor tensor_from_numpy(PyObject* obj, bool warn_if_not_writeable/*=true*/) {
+at::Tensor tensor_from_numpy(PyObject* obj, bool warn_if_not_writeable/*=true*/, bool flip_negative_strides/*=false*/) {
   if (!is_numpy_available()) {
     throw std::runtime_error("Numpy is not available");
   }
@@ -167,19 +173,6 @@ at::Tensor tensor_from_numpy(PyObject* obj, bool warn_if_not_writeable/*=true*/)
   }
   auto array = (PyArrayObject*)obj;
 
-  // warn_if_not_writable is true when a copy of numpy variable is created.
-  // the warning is suppressed when a copy is being created.
-  if (!PyArray_ISWRITEABLE(array) && warn_if_not_writeable) {
-    TORCH_WARN_ONCE(
-      "The given NumPy array is not writeable, and PyTorch does "
-      "not support non-writeable tensors. This means you can write to the "
-      "underlying (supposedly non-writeable) NumPy array using the tensor. "
-      "You may want to copy the array to protect its data or make it writeable "
-      "before converting it to a tensor. This type of warning will be "
-      "suppressed for the rest of this program.");
-
-  }
-
   int ndim = PyArray_NDIM(array);
   auto sizes = to_aten_shape(ndim, PyArray_DIMS(array));
   auto strides = to_aten_shape(ndim, PyArray_STRIDES(array));
@@ -194,27 +187,48 @@ at::Tensor tensor_from_numpy(PyObject* obj, bool warn_if_not_writeable/*=true*/)
     stride /= element_size_in_bytes;
   }
 
-  size_t storage_size = 1;
+  char* data_ptr = static_cast<char*>(PyArray_DATA(array));
+  // Dimensions with negative strides are read from their last element with
+  // the opposite stride, then flipped
+  std::vector<int64_t> flipped_dims;
   for (int i = 0; i < ndim; i++) {
     if (strides[i] < 0) {
-      throw ValueError(
-          "At least one stride in the given numpy array is negative, "
-          "and tensors with negative strides are not currently supported. "
-          "(You can probably work around this by making a copy of your array "
-          " with array.copy().) ");
+      if (!flip_negative_strides) {
+        throw ValueError(
+            "At least one stride in the given numpy array is negative, "
+            "and tensors with negative strides are not currently supported. "
+            "(You can probably work around this by making a copy of your array "
+            " with array.copy().) ");
+      }
+      if (sizes[i] > 1) {
+        data_ptr += (sizes[i] - 1) * strides[i] * element_size_in_bytes;
+        flipped_dims.push_back(i);
+      }
+      strides[i] = -strides[i];
     }
-    // XXX: this won't work for negative strides
-    storage_size += (sizes[i] - 1) * strides[i];
   }
 
-  void* data_ptr = PyArray_DATA(array);
   if (!PyArray_EquivByteorders(PyArray_DESCR(array)->byteorder, NPY_NATIVE)) {
     throw ValueError(
         "given numpy array has byte order different from the native byte order. "
         "Conversion between byte orders is currently not supported.");
   }
+  // warn_if_not_writable is true when a copy of numpy variable is created.
+  // the warning is suppressed when a copy is being created, which is also
+  // the case when dimensions are flipped.
+  if (!PyArray_ISWRITEABLE(array) && warn_if_not_writeable && flipped_dims.empty()) {
+    TORCH_WARN_ONCE(
+      "The given NumPy array is not writeable, and PyTorch does "
+      "not support non-writeable tensors. This means you can write to the "
+      "underlying (supposedly non-writeable) NumPy array using the tensor. "
+      "You may want to copy the array to protect its data or make it writeable "
+      "before converting it to a tensor. This type of warning will be "
+      "suppressed for the rest of this program.");
+
+  }
+
   Py_INCREF(obj);
-  return at::from_blob(
+  auto tensor = at::from_blob(
       data_ptr,
       sizes,
       strides,
@@ -224,6 +238,11 @@ at::Tensor tensor_from_numpy(PyObject* obj, bool warn_if_not_writeable/*=true*/)
       },
       at::device(kCPU).dtype(numpy_dtype_to_aten(PyArray_TYPE(array)))
   );
+  if (!flipped_dims.empty()) {
+    // Tensors can't have negative strides, so this copies
+    tensor = tensor.flip(flipped_dims);
+  }
+  return tensor;
 }
 
 int aten_to_numpy_dtype(const ScalarType scalar_type) {
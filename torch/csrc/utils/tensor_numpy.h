@@ -6,7 +6,9 @@
 namespace torch { namespace utils {
 
 PyObject* tensor_to_numpy(const at::Tensor& tensor);
-at::Tensor tensor_from_numpy(PyObject* obj, bool warn_if_not_writeable=true);
+// Shares the memory of the array, unless flip_negative_strides is set and
+// the array has negative strides, in which case the result is a copy
+at::Tensor tensor_from_numpy(PyObject* obj, bool warn_if_not_writeable=true, bool flip_negative_strides=false);
 
 int aten_to_numpy_dtype(const at::ScalarType scalar_type);
 at::ScalarType numpy_dtype_to_aten(int dtype);
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <random>
 #include <thread>
 
@@ -21,13 +25,27 @@ BenchmarkExecutionStats BenchmarkHelper<Input, Output, Model>::benchmark(
       config.num_worker_threads == 1,
       "Only parallelization by callers is supported");
 
+  TORCH_CHECK(
+      config.target_qps >= 0,
+      "Expected a non-negative target_qps, got ",
+      config.target_qps);
+  for (int cpu : config.cpu_affinity) {
+    TORCH_CHECK(cpu >= 0, "Expected non-negative CPU ids, got ", cpu);
+  }
+
   LOG(INFO) << at::get_parallel_info();
 
+  using Clock = std::chrono::steady_clock;
+  using TimePoint = std::chrono::time_point<Clock>;
+
   // We pre-generate inputs here for each of the threads. This allows us to
   // safely move inputs out for each of the threads independently and thus avoid
   // overhead from the benchmark runner itself
   std::vector<std::vector<Input>> thread_inputs(config.num_calling_threads);
   std::vector<size_t> input_iters(config.num_calling_threads);
+  // In the open-loop mode request i is issued at start_time + arrivals[i]
+  const bool open_loop = config.target_qps > 0;
+  std::vector<Clock::duration> arrivals;
   {
     std::random_device seeder;
     std::mt19937 engine(seeder());
@@ -46,6 +64,18 @@ BenchmarkExecutionStats BenchmarkHelper<Input, Output, Model>::benchmark(
       }
       input_iters[thread_id] = 0;
     }
+
+    if (open_loop) {
+      // Poisson arrivals, i.e. exponentially distributed inter-arrival times
+      std::exponential_distribution<double> inter_arrival_s(config.target_qps);
+      double arrival_s = 0;
+      arrivals.reserve(config.num_iters);
+      for (int64_t i = 0; i < config.num_iters; ++i) {
+        arrival_s += inter_arrival_s(engine);
+        arrivals.push_back(std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(arrival_s)));
+      }
+    }
   }
 
   std::mutex m;
@@ -55,14 +85,26 @@ BenchmarkExecutionStats BenchmarkHelper<Input, Output, Model>::benchmark(
   int64_t initialized{0};
   int64_t finished{0};
   bool start{false};
+  TimePoint start_time;
   std::atomic<int64_t> num_attempted_iters{0};
+  // Each thread records the latencies of its own requests, they are merged
+  // once all the threads are done
+  std::vector<std::vector<float>> thread_latencies_ms(
+      config.num_calling_threads);
   std::vector<std::thread> callers;
 
   for (auto thread_id = 0; thread_id < config.num_calling_threads;
        ++thread_id) {
     callers.emplace_back([&, thread_id]() {
+      if (!config.cpu_affinity.empty()) {
+        setCurrentThreadAffinity(
+            config.cpu_affinity[thread_id % config.cpu_affinity.size()]);
+      }
+      auto& latencies_ms = thread_latencies_ms[thread_id];
+      latencies_ms.reserve(config.num_iters);
       // We use conditional variable as a barrier to make sure each thread
-      // performs required warmeup iterations before we start measuring
+      // performs required warmeup iterations before we start measuring.
+      // Warmup always runs back to back and is not part of the statistics
       for (auto j = 0; j < config.num_warmup_iters; ++j) {
         runOnce(std::move(thread_inputs[thread_id][input_iters[thread_id]]));
         ++input_iters[thread_id];
@@ -76,9 +118,23 @@ BenchmarkExecutionStats BenchmarkHelper<Input, Output, Model>::benchmark(
         }
       }
       LOG(INFO) << "Starting forward thread " << thread_id;
-      while (num_attempted_iters.fetch_add(1) < config.num_iters) {
+      int64_t iter;
+      while ((iter = num_attempted_iters.fetch_add(1)) < config.num_iters) {
+        TimePoint request_start;
+        if (open_loop) {
+          // A request that arrived while all the threads were busy is served
+          // late, and the wait counts towards its latency
+          request_start = start_time + arrivals[iter];
+          std::this_thread::sleep_until(request_start);
+        } else {
+          request_start = Clock::now();
+        }
         runOnce(std::move(thread_inputs[thread_id][input_iters[thread_id]]));
         ++input_iters[thread_id];
+        latencies_ms.push_back(
+            std::chrono::duration<float, std::milli>(
+                Clock::now() - request_start)
+                .count());
       }
 
       {
@@ -92,10 +148,6 @@ BenchmarkExecutionStats BenchmarkHelper<Input, Output, Model>::benchmark(
     });
   }
 
-  using Clock = std::chrono::high_resolution_clock;
-  using TimePoint = std::chrono::time_point<Clock>;
-  TimePoint start_time;
-
   std::unique_ptr<torch::autograd::profiler::RecordProfile> profiler_guard;
   {
     std::unique_lock<std::mutex> lock(m);
@@ -119,25 +171,45 @@ BenchmarkExecutionStats BenchmarkHelper<Input, Output, Model>::benchmark(
     worker_main_cv.wait(
         lock, [&]() { return finished == config.num_calling_threads; });
   }
-  auto end_time = std::chrono::high_resolution_clock::now();
+  auto end_time = Clock::now();
   profiler_guard.reset();
   LOG(INFO) << "Finished benchmark";
 
+  for (auto& t : callers) {
+    t.join();
+  }
+
   BenchmarkExecutionStats stats;
   float total_time_ms = std::chrono::duration_cast<std::chrono::nanoseconds>(
                             end_time - start_time)
                             .count() /
       1000.0 / 1000.0;
-  // We use config.num_iters instead of num_attempted_iters as it is
-  // repsesatative of the real work done. Last attempted iteration on each
-  // calling threads doesn't represent the real work (i.e. running the model)
-  stats.latency_avg_ms =
-      total_time_ms * config.num_calling_threads / config.num_iters;
+  stats.total_time_ms = total_time_ms;
   stats.num_iters = config.num_iters;
 
-  for (auto& t : callers) {
-    t.join();
+  std::vector<float> latencies_ms;
+  latencies_ms.reserve(config.num_iters);
+  for (const auto& thread_latencies : thread_latencies_ms) {
+    latencies_ms.insert(
+        latencies_ms.end(), thread_latencies.begin(), thread_latencies.end());
+  }
+  if (open_loop) {
+    // The threads are idle between arrivals, so the wall time says nothing
+    // about the latency
+    double sum_ms = 0;
+    for (float latency_ms : latencies_ms) {
+      sum_ms += latency_ms;
+    }
+    stats.latency_avg_ms =
+        latencies_ms.empty() ? -1 : sum_ms / latencies_ms.size();
+  } else {
+    // We use config.num_iters instead of num_attempted_iters as it is
+    // repsesatative of the real work done. Last attempted iteration on each
+    // calling threads doesn't represent the real work (i.e. running the model)
+    stats.latency_avg_ms =
+        total_time_ms * config.num_calling_threads / config.num_iters;
   }
+  computeLatencyPercentiles(latencies_ms, stats);
   return stats;
 }
 
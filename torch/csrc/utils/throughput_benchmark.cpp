@@ -3,12 +3,24 @@
 #include <pybind11/pybind11.h>
 #include <torch/csrc/jit/python/pybind_utils.h>
 
+#include <algorithm>
+#include <cmath>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 namespace torch {
 namespace throughput_benchmark {
 
 std::ostream& operator<<(std::ostream& os, const BenchmarkExecutionStats& value) {
     return os << "Average latency / iter (ms): " << value.latency_avg_ms
-              << "\n Total number of iters: " << value.num_iters;
+              << "\n Latency p50 / p90 / p99 / p99.9 (ms): "
+              << value.latency_p50_ms << " / " << value.latency_p90_ms << " / "
+              << value.latency_p99_ms << " / " << value.latency_p999_ms
+              << "\n Total number of iters: " << value.num_iters
+              << "\n Total time (ms): " << value.total_time_ms;
 }
 
 void ThroughputBenchmark::addInput(py::args args, py::kwargs kwargs) {
@@ -134,6 +146,38 @@ ScriptModuleInput cloneInput<ScriptModuleInput>(
   return input;
 }
 
+void computeLatencyPercentiles(
+    std::vector<float>& latencies_ms,
+    BenchmarkExecutionStats& stats) {
+  if (latencies_ms.empty()) {
+    return;
+  }
+  std::sort(latencies_ms.begin(), latencies_ms.end());
+  // Nearest-rank percentile
+  auto percentile = [&](double p) {
+    auto rank = static_cast<size_t>(std::ceil(p * latencies_ms.size()));
+    return latencies_ms[std::max(rank, size_t(1)) - 1];
+  };
+  stats.latency_p50_ms = percentile(0.5);
+  stats.latency_p90_ms = percentile(0.9);
+  stats.latency_p99_ms = percentile(0.99);
+  stats.latency_p999_ms = percentile(0.999);
+}
+
+void setCurrentThreadAffinity(int cpu) {
+#if defined(__linux__)
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  CPU_SET(cpu, &cpuset);
+  int err = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+  if (err != 0) {
+    TORCH_WARN("Failed to pin a calling thread to CPU ", cpu, ", error ", err);
+  }
+#else
+  TORCH_WARN_ONCE("Pinning calling threads is only supported on Linux");
+#endif
+}
+
 } // namespace detail
 
 } // namespace throughput_benchmark
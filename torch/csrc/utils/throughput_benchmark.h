@@ -23,6 +23,15 @@ namespace throughput_benchmark {
 struct BenchmarkExecutionStats {
   float latency_avg_ms{-1};
   int64_t num_iters{-1};
+  // Wall time of the measured part of the run, warmup excluded
+  float total_time_ms{-1};
+  // Percentiles of the per-request latencies. In the open-loop mode the
+  // latency of a request is counted from its scheduled arrival, so it includes
+  // the time the request waited for a free calling thread
+  float latency_p50_ms{-1};
+  float latency_p90_ms{-1};
+  float latency_p99_ms{-1};
+  float latency_p999_ms{-1};
 };
 
 std::ostream& operator<<(std::ostream& os, const BenchmarkExecutionStats& value);
@@ -57,6 +66,15 @@ struct BenchmarkConfig {
   // before the main benchmark loop (but after the warmup):
   // RecordProfile guard(profiler_output_path);
   std::string profiler_output_path{""};
+  // If positive, requests arrive at this average rate (per second) following a
+  // Poisson process, independently of how fast they are served, and are picked
+  // up by the first free calling thread (open-loop load). Otherwise each calling
+  // thread issues its next request as soon as the previous one is done
+  // (closed-loop load)
+  double target_qps{0};
+  // If not empty, calling thread i is pinned to CPU
+  // cpu_affinity[i % cpu_affinity.size()]. Only supported on Linux
+  std::vector<int> cpu_affinity;
 };
 
 namespace detail {
@@ -112,6 +130,15 @@ typedef at::IValue ScriptModuleOutput;
 template<class Input>
 Input cloneInput(const Input& input);
 
+// Fills the latency percentiles of stats from the per-request latencies of the
+// run, the order of latencies_ms is not preserved
+void computeLatencyPercentiles(
+    std::vector<float>& latencies_ms,
+    BenchmarkExecutionStats& stats);
+
+// Pins the calling thread to the given CPU
+void setCurrentThreadAffinity(int cpu);
+
 typedef BenchmarkHelper<
     ScriptModuleInput,
     at::IValue,
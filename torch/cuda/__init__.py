@@ -409,7 +409,9 @@ def ipc_collect():
         Checks if any sent CUDA tensors could be cleaned from the memory. Force
         closes shared memory file used for reference counting if there is no
         active counters. Useful when the producer process stopped actively sending
-        tensors and want to release unused memory.
+        tensors and want to release unused memory. In a consumer process, also
+        closes the memory handles kept open by
+        ``PYTORCH_CUDA_IPC_CACHED_HANDLES`` that no received tensor uses.
     """
     _lazy_init()
     return torch._C._cuda_ipc_collect()
@@ -451,6 +453,8 @@ def current_blas_handle():
 
 from .memory import *
 
+from .graphs import CUDAGraph, graph, graph_pool_handle, is_current_stream_capturing, make_graphed_callables
+
 
 from .random import *
 
@@ -1,7 +1,7 @@
 import collections
 import contextlib
 import warnings
-from typing import Any, Dict, Union
+from typing import Any, Dict, List, Union
 
 import torch
 from . import is_initialized, _get_device_index, _lazy_init
@@ -114,6 +114,62 @@ def empty_cache() -> None:
         torch._C._cuda_emptyCache()
 
 
+class MemPool(object):
+    r"""A private memory pool of the CUDA caching allocator on one device.
+
+    Allocations made on a stream inside :func:`~torch.cuda.use_mem_pool` come
+    from, and are returned to, the pool only, so that allocations on other
+    streams cannot reuse or fragment its memory. The pool's cached memory is
+    kept, even across :func:`~torch.cuda.empty_cache`, until the pool is
+    released and all tensors allocated from it are freed.
+
+    Args:
+        device (torch.device or int, optional): selected device. If it is
+            ``None`` the default CUDA device is used.
+
+    .. note::
+        See :ref:`cuda-memory-management` for more details about GPU memory
+        management.
+    """
+
+    def __init__(self, device: Union[Device, int] = None):
+        _lazy_init()
+        self.device = _get_device_index(device, optional=True)
+        self.id = torch._C._cuda_createPoolId()
+        torch._C._cuda_retainPool(self.device, self.id)
+
+    def release(self) -> None:
+        r"""Drops the reference to the pool. Its memory is returned by the next
+        :func:`~torch.cuda.empty_cache` once it is not in use anymore."""
+        if self.id != 0:
+            torch._C._cuda_releasePool(self.device, self.id)
+            self.id = 0
+
+    def __del__(self):
+        self.release()
+
+
+@contextlib.contextmanager
+def use_mem_pool(pool: MemPool, stream=None):
+    r"""Context-manager that serves the allocations made on a stream from a
+    private memory pool.
+
+    Args:
+        pool (MemPool): the pool to allocate from.
+        stream (torch.cuda.Stream, optional): selected stream. If it is
+            ``None`` the current stream of the pool's device is used.
+    """
+    if pool.id == 0:
+        raise RuntimeError('Cannot allocate from a released MemPool')
+    if stream is None:
+        stream = torch.cuda.current_stream(pool.device)
+    torch._C._cuda_beginAllocateToPool(pool.device, pool.id, stream.cuda_stream)
+    try:
+        yield
+    finally:
+        torch._C._cuda_endAllocateToPool(pool.device, stream.cuda_stream)
+
+
 def memory_stats(device: Union[Device, int] = None) -> Dict[str, Any]:
     r"""Returns a dictionary of CUDA memory allocator statistics for a
     given device.
@@ -397,6 +453,59 @@ def memory_snapshot():
     return torch._C._cuda_memorySnapshot()
 
 
+def record_memory_history(enabled: bool = True, max_entries: int = 10000,
+                          stack_depth: int = 16, oom_dump_path: str = "") -> None:
+    r"""Starts or stops recording the recent events of the CUDA memory
+    allocator on all devices.
+
+    Each device keeps its last :attr:`max_entries` allocations, frees and
+    segment allocations in a ring buffer, together with up to
+    :attr:`stack_depth` frames of the C++ call stack that caused them. Stacks
+    are stored as raw addresses and only symbolized when they are read, so
+    recording is cheap enough to leave enabled. If an allocation fails while
+    recording, the events of its device are written to :attr:`oom_dump_path`,
+    or to stderr, before the out of memory error is raised. Any call clears
+    the events recorded so far.
+
+    Arguments:
+        enabled (bool, optional): whether to record events. Default: ``True``.
+        max_entries (int, optional): number of events kept per device.
+            Default: ``10000``.
+        stack_depth (int, optional): number of stack frames kept per event,
+            ``0`` to record no stacks. Default: ``16``.
+        oom_dump_path (str, optional): file the events are written to on out
+            of memory errors. Default: ``""`` (stderr).
+
+    .. note::
+        See :ref:`cuda-memory-management` for more details about GPU memory
+        management.
+    """
+    if not is_initialized():
+        _lazy_init()
+    torch._C._cuda_recordMemoryHistory(enabled, max_entries, stack_depth, oom_dump_path)
+
+
+def memory_trace(device: Union[Device, int] = None) -> List[Dict[str, Any]]:
+    r"""Returns the events recorded by :func:`record_memory_history` for a
+    given device, oldest first.
+
+    Each event is a dictionary with the keys ``"action"`` (one of
+    ``"alloc"``, ``"free"``, ``"segment_alloc"``, ``"segment_free"``,
+    ``"segment_map"``, ``"segment_unmap"`` and ``"oom"``), ``"addr"``,
+    ``"size"``, ``"stream"``, ``"time_us"`` and ``"frames"``, the symbolized
+    call stack or ``None``.
+
+    Arguments:
+        device (torch.device or int, optional): selected device. Returns
+            events for the current device, given by :func:`~torch.cuda.current_device`,
+            if :attr:`device` is ``None`` (default).
+    """
+    if not is_initialized():
+        return []
+    device = _get_device_index(device, optional=True)
+    return torch._C._cuda_memoryTrace(device)
+
+
 def memory_summary(device: Union[Device, int] = None, abbreviated: bool = False) -> str:
     r"""Returns a human-readable printout of the current memory allocator
     statistics for a given device.
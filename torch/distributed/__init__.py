@@ -30,6 +30,7 @@ if is_available():
         Reducer,
         Logger,
         BuiltinCommHookType,
+        BuiltinCommHookOptions,
         GradBucket,
         _DEFAULT_FIRST_BUCKET_BYTES,
         _register_comm_hook,
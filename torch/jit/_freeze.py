@@ -113,6 +113,9 @@ def optimize_frozen_module(mod, optimize_numerics: bool = True):
         - Conv -> Batchnorm folding
         - Conv -> Add/Sub folding
         - Conv -> Mul/Div folding
+        - Concatenating sibling Linear layers that share an input
+        - Batchnorm -> ReLU fusion, for the batch norms not folded into a conv
+        - Linear -> ReLU/GELU fusion, for Linear layers with a CPU weight
 
     Args:
         mod (:class:`ScriptModule`): a frozen module to be optimized
@@ -121,7 +124,7 @@ def optimize_frozen_module(mod, optimize_numerics: bool = True):
         preserve numerics. These optimizations preserve default rtol and atol of `torch.testing.assert_allclose`
         when applied on a single transformation, however in a module where many transformations are applied
         the rtol or atol may no longer fall within the default `assert_allclose` tolerance. Conv -> Batchnorm folding,
-        Conv-Add/Sub, and Conv -> Mul/Div folding all may alter numerics.
+        Conv-Add/Sub, Conv -> Mul/Div folding and Linear concatenation all may alter numerics.
 
     Returns:
         None
@@ -153,3 +156,4 @@ def optimize_frozen_module(mod, optimize_numerics: bool = True):
             torch._C._jit_pass_fold_frozen_conv_bn(mod.graph)
             torch._C._jit_pass_fold_frozen_conv_add_or_sub(mod.graph)
             torch._C._jit_pass_fold_frozen_conv_mul_or_div(mod.graph)
+        torch._C._jit_pass_concat_frozen_linear(mod.graph)
@@ -1,6 +1,8 @@
 # These functions are referenced from the pickle archives produced by
 # ScriptModule.save()
 
+import struct
+
 
 # These (`build_*`) functions used to be used by `pickler.cpp` to specify
 # the type of the list for certain special types, but now all lists get
@@ -23,6 +25,23 @@ def build_boollist(data):
     return data
 
 
+# Large int, float and bool lists are written as a single byte string holding
+# the little endian elements of the list (8 byte ints and floats, 1 byte bools)
+# when archives have file format version 7 or higher, see
+# `Pickler::pushPackedList` in `pickler.cpp`.
+
+def build_packed_intlist(data):
+    return list(struct.unpack('<{}q'.format(len(data) // 8), data))
+
+
+def build_packed_doublelist(data):
+    return list(struct.unpack('<{}d'.format(len(data) // 8), data))
+
+
+def build_packed_boollist(data):
+    return [b != 0 for b in bytearray(data)]
+
+
 def build_tensor_from_id(data):
     if isinstance(data, int):
         # just the id, can't really do anything
@@ -578,6 +578,7 @@ def trace(
     _force_outplace=False,
     _module_class=None,
     _compilation_unit=_python_cu,
+    _record_debug_info=True,
 ):
     """
     Trace a function and return an executable  or :class:`ScriptFunction`
@@ -740,6 +741,7 @@ def trace(
             strict,
             _force_outplace,
             _module_class,
+            _record_debug_info=_record_debug_info,
         )
 
     if (
@@ -757,6 +759,7 @@ def trace(
             strict,
             _force_outplace,
             _module_class,
+            _record_debug_info=_record_debug_info,
         )
 
     # Special case for common case of passing a single Tensor
@@ -782,7 +785,8 @@ def trace(
         var_lookup_fn,
         strict,
         _force_outplace,
-        get_callable_argument_names(func)
+        get_callable_argument_names(func),
+        _record_debug_info,
     )
 
     # Check the trace against new traces created from user-specified inputs
@@ -827,6 +831,7 @@ def trace_module(
     _force_outplace=False,
     _module_class=None,
     _compilation_unit=_python_cu,
+    _record_debug_info=True,
 ):
     """
     Trace a module and return an executable :class:`ScriptModule` that will be optimized
@@ -955,6 +960,7 @@ def trace_module(
                 strict,
                 _force_outplace,
                 argument_names,
+                _record_debug_info,
             )
             check_trace_method = module._c._get_method(method_name)
 
@@ -458,7 +458,10 @@ void ProcessGroupGloo::RecvWork::abort() {
 }
 
 ProcessGroupGloo::Options::Options()
-    : timeout(std::chrono::milliseconds(10 * 1000)), threads(2) {}
+    : timeout(std::chrono::milliseconds(10 * 1000)),
+      threads(2),
+      pipelinedAllreduceMinBytes(16 * 1024 * 1024),
+      pipelinedAllreduceChunkBytes(4 * 1024 * 1024) {}
 
 namespace {
 
@@ -584,6 +587,8 @@ ProcessGroupGloo::ProcessGroupGloo(
     : ProcessGroup(rank, size),
       store_(new GlooStore(store)),
       stop_(false),
+      pipelinedAllreduceMinBytes_(options.pipelinedAllreduceMinBytes),
+      pipelinedAllreduceChunkBytes_(options.pipelinedAllreduceChunkBytes),
       collectiveCounter_(0) {
   auto& devices = options.devices;
   if (devices.empty()) {
@@ -852,10 +857,17 @@ class AsyncAllreduceWork : public ProcessGroupGloo::AsyncWork {
   const uint32_t tag;
 
   void allreduce(std::vector<at::Tensor>& tensors) {
+    allreduce(context, tag, tensors);
+  }
+
+  void allreduce(
+      const std::shared_ptr<gloo::Context>& ctx,
+      uint32_t allreduceTag,
+      std::vector<at::Tensor>& tensors) {
     const auto& scalarType = tensors[0].scalar_type();
-    gloo::AllreduceOptions opts(context);
+    gloo::AllreduceOptions opts(ctx);
     opts.setReduceFunction(getFunction(scalarType, reduceOp));
-    opts.setTag(tag);
+    opts.setTag(allreduceTag);
     GENERATE_ALL_TYPES(scalarType, setOutputs, opts, tensors);
     gloo::allreduce(opts);
   }
@@ -890,6 +902,71 @@ class AsyncAllreduceWork : public ProcessGroupGloo::AsyncWork {
   std::vector<at::Tensor> outputs_;
 };
 
+// Splits a single contiguous tensor into chunks and reduces them over all
+// contexts at the same time. Chunk i uses tag `tag + i` and is reduced on
+// context `i % contexts.size()`. Every context reduces its chunks in order on
+// its own thread, so the chunks are matched up across processes.
+class AsyncPipelinedAllreduceWork : public AsyncAllreduceWork {
+ public:
+  AsyncPipelinedAllreduceWork(
+      std::vector<std::shared_ptr<gloo::Context>> contexts,
+      std::vector<at::Tensor>& inputs,
+      ReduceOp reduceOp,
+      uint32_t tag,
+      int64_t chunkNumel)
+      : AsyncAllreduceWork(contexts[0], inputs, reduceOp, tag),
+        contexts(std::move(contexts)),
+        chunkNumel(chunkNumel) {}
+
+  std::vector<std::shared_ptr<gloo::Context>> contexts;
+  const int64_t chunkNumel;
+
+  void allreduceChunks(size_t contextIndex, const at::Tensor& flat) {
+    const int64_t numel = flat.numel();
+    const int64_t stride = static_cast<int64_t>(contexts.size()) * chunkNumel;
+    for (int64_t offset = static_cast<int64_t>(contextIndex) * chunkNumel;
+         offset < numel;
+         offset += stride) {
+      std::vector<at::Tensor> chunk = {
+          flat.narrow(0, offset, std::min(chunkNumel, numel - offset))};
+      allreduce(
+          contexts[contextIndex],
+          tag + static_cast<uint32_t>(offset / chunkNumel),
+          chunk);
+    }
+  }
+
+  void run() override {
+    const auto flat = inputs[0].view({-1});
+    std::vector<std::exception_ptr> errors(contexts.size());
+    std::vector<std::thread> threads;
+    threads.reserve(contexts.size() - 1);
+    for (size_t i = 1; i < contexts.size(); i++) {
+      threads.emplace_back([this, i, &flat, &errors] {
+        try {
+          allreduceChunks(i, flat);
+        } catch (...) {
+          errors[i] = std::current_exception();
+        }
+      });
+    }
+    try {
+      allreduceChunks(0, flat);
+    } catch (...) {
+      errors[0] = std::current_exception();
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    for (const auto& error : errors) {
+      if (error) {
+        std::rethrow_exception(error);
+      }
+    }
+    outputs_ = inputs;
+  }
+};
+
 class AsyncAllreduceCoalescedWork : public AsyncAllreduceWork {
  public:
   AsyncAllreduceCoalescedWork(
@@ -1354,7 +1431,21 @@ c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupGloo::allreduce(
   auto tag = nextTag();
   auto context = getContext(tag);
   if (device.type() == at::kCPU) {
-    if (layout == c10::kStrided) {
+    const auto nbytes = inputs[0].numel() * inputs[0].element_size();
+    if (layout == c10::kStrided && contexts_.size() > 1 &&
+        inputs.size() == 1 && inputs[0].is_contiguous() &&
+        pipelinedAllreduceMinBytes_ > 0 &&
+        static_cast<size_t>(nbytes) >= pipelinedAllreduceMinBytes_) {
+      const int64_t chunkNumel = std::max<int64_t>(
+          1, pipelinedAllreduceChunkBytes_ / inputs[0].element_size());
+      const int64_t numChunks =
+          (inputs[0].numel() + chunkNumel - 1) / chunkNumel;
+      // Reserve a tag for every chunk. This is deterministic across
+      // processes, as the tensor sizes match.
+      collectiveCounter_ += numChunks - 1;
+      work = c10::make_intrusive<AsyncPipelinedAllreduceWork>(
+          contexts_, inputs, opts.reduceOp, tag, chunkNumel);
+    } else if (layout == c10::kStrided) {
       work = c10::make_intrusive<AsyncAllreduceWork>(
           std::move(context), inputs, opts.reduceOp, tag);
     } else if (layout == c10::kSparse) {
@@ -2336,11 +2427,84 @@ c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupGloo::scatter(
   return work;
 }
 
+namespace {
+
+// Gloo has no reduce-scatter collective for inputs of different sizes, so the
+// inputs are coalesced into a single flat tensor and allreduced, and this
+// rank's part is copied to the output.
+class AsyncReduceScatterWork : public AsyncAllreduceWork {
+ public:
+  AsyncReduceScatterWork(
+      const std::shared_ptr<gloo::Context>& context,
+      std::vector<at::Tensor>& outputs,
+      std::vector<at::Tensor>& inputs,
+      int rank,
+      ReduceOp reduceOp,
+      uint32_t tag)
+      : AsyncAllreduceWork(context, inputs, reduceOp, tag),
+        outputTensors(outputs),
+        rank(rank) {}
+
+  std::vector<at::Tensor> outputTensors;
+  const int rank;
+
+  void run() override {
+    std::vector<at::Tensor> allreduceInput = {flattenDenseTensors(inputs)};
+    allreduce(allreduceInput);
+
+    int64_t offset = 0;
+    for (int i = 0; i < rank; ++i) {
+      offset += inputs[i].numel();
+    }
+    auto& output = outputTensors[0];
+    output.copy_(
+        allreduceInput[0].narrow(0, offset, output.numel()).view_as(output));
+    outputs_ = outputTensors;
+  }
+};
+
+} // namespace
+
 c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupGloo::reduce_scatter(
     std::vector<at::Tensor>& outputs,
     std::vector<std::vector<at::Tensor>>& inputs,
     const ReduceScatterOptions& opts) {
-  throw std::runtime_error("ProcessGroupGloo does not support reduce_scatter");
+  static auto invalidArgument = [](const std::string& msg) {
+    throw std::invalid_argument("ProcessGroupGloo::reduce_scatter: " + msg);
+  };
+
+  assertSingleElementOutput(invalidArgument, outputs);
+  assertDense(invalidArgument, outputs);
+  assertCPU(invalidArgument, outputs);
+  if (inputs.size() != 1) {
+    std::stringstream ss;
+    ss << "requires a single-element input list containing a list with "
+       << getSize() << " tensors";
+    invalidArgument(ss.str());
+  } else if (inputs[0].size() != static_cast<size_t>(getSize())) {
+    std::stringstream ss;
+    ss << "Incorrect input list size " << inputs[0].size()
+       << ". Input list size should be " << getSize()
+       << ", same as size of the process group.";
+    invalidArgument(ss.str());
+  }
+  // The inputs may have different sizes, but only the input of this rank has
+  // to match the output.
+  const auto& options = outputs[0].options();
+  for (size_t i = 0; i < inputs[0].size(); ++i) {
+    assertTypeMatch(invalidArgument, options, inputs[0], i);
+  }
+  if (inputs[0][getRank()].numel() != outputs[0].numel()) {
+    invalidArgument(
+        "requires the input of this rank to have as many elements as the output");
+  }
+
+  auto tag = nextTag();
+  auto context = getContext(tag);
+  auto work = c10::make_intrusive<AsyncReduceScatterWork>(
+      std::move(context), outputs, inputs[0], getRank(), opts.reduceOp, tag);
+  enqueue(work);
+  return work;
 }
 
 namespace {
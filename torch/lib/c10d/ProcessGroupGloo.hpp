@@ -138,6 +138,16 @@ class ProcessGroupGloo : public ProcessGroup {
     std::vector<std::shared_ptr<::gloo::transport::Device>> devices;
     std::chrono::milliseconds timeout;
     int threads;
+
+    // Dense CPU allreduce of a single contiguous tensor with at least
+    // `pipelinedAllreduceMinBytes` bytes is split into chunks of
+    // `pipelinedAllreduceChunkBytes` bytes, and the chunks are reduced over
+    // all contexts at the same time, each context on its own thread. This
+    // only applies with more than one device. To saturate a fast NIC, list
+    // the same interface several times so that every device gets its own I/O
+    // thread. A threshold of zero disables pipelining.
+    size_t pipelinedAllreduceMinBytes;
+    size_t pipelinedAllreduceChunkBytes;
   };
 
   const std::string getBackendName() const override {
@@ -251,6 +261,10 @@ class ProcessGroupGloo : public ProcessGroup {
   std::vector<std::thread> threads_;
   bool stop_;
 
+  // See Options::pipelinedAllreduceMinBytes.
+  const size_t pipelinedAllreduceMinBytes_;
+  const size_t pipelinedAllreduceChunkBytes_;
+
   // Incremented for every collective we kick off.
   // The value is used as tag for collective operations. Collectives are kicked
   // off in identical order across processes. Therefore the tag can be used
@@ -442,11 +442,72 @@ c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupMPI::allgather(
 }
 
 c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupMPI::allgather_coalesced(
-    std::vector<std::vector<at::Tensor>>& /* unused */,
-    std::vector<at::Tensor>& /* unused */,
+    std::vector<std::vector<at::Tensor>>& outputTensorLists,
+    std::vector<at::Tensor>& inputTensors,
     const AllgatherOptions& /* unused */) {
-  throw std::runtime_error(
-      "ProcessGroupMPI does not support allgather_coalesced");
+  if (inputTensors.empty()) {
+    throw std::runtime_error(
+        "All gather coalesced: input tensor list must be nonempty");
+  }
+  if (static_cast<size_t>(size_) != outputTensorLists.size()) {
+    throw std::runtime_error(
+        "All gather coalesced: number of output lists should equal "
+        "to the world size");
+  }
+  for (const auto& input : inputTensors) {
+    if (input.scalar_type() != inputTensors[0].scalar_type() ||
+        input.device() != inputTensors[0].device()) {
+      throw std::runtime_error(
+          "All gather coalesced: input tensors should have the same data "
+          "type and device");
+    }
+    checkSingleTensorHelper(input);
+  }
+  // The i'th tensor of every output list receives the i'th input tensor of
+  // the corresponding rank, and the outputs are flattened in that order.
+  std::vector<at::Tensor> outputTensors;
+  for (const auto& outputList : outputTensorLists) {
+    if (outputList.size() != inputTensors.size()) {
+      throw std::runtime_error(
+          "All gather coalesced: every output list should have as many "
+          "tensors as the input list");
+    }
+    for (size_t i = 0; i < outputList.size(); ++i) {
+      checkSameSizeAndType(inputTensors[i], {outputList[i]});
+      outputTensors.push_back(outputList[i]);
+    }
+  }
+
+  // Gather all tensors with a single MPI_Allgather over flattened buffers.
+  std::function<void(std::unique_ptr<WorkEntry>&)> runFunc =
+      [this](std::unique_ptr<WorkEntry>& entry) {
+        auto flatInputTensor = flattenDenseTensors(entry->src);
+        const auto numel = flatInputTensor.numel();
+        auto flatOutputTensor =
+            at::empty({size_ * numel}, flatInputTensor.options());
+
+        c10::DeviceGuard guard(flatInputTensor.device());
+        std::unique_lock<std::mutex> globalLock(pgGlobalMutex_);
+        MPI_CHECK(MPI_Allgather(
+            flatInputTensor.data_ptr(),
+            numel,
+            mpiDatatype.at(flatInputTensor.scalar_type()),
+            flatOutputTensor.data_ptr(),
+            numel,
+            mpiDatatype.at(flatInputTensor.scalar_type()),
+            pgComm_));
+
+        int64_t offset = 0;
+        for (auto& outputTensor : entry->dst) {
+          outputTensor.copy_(
+              flatOutputTensor.narrow(0, offset, outputTensor.numel())
+                  .view(outputTensor.sizes()));
+          offset += outputTensor.numel();
+        }
+      };
+  auto entry = std::unique_ptr<WorkEntry>(
+      new WorkEntry(&inputTensors, &outputTensors, std::move(runFunc)));
+  return enqueue(std::move(entry));
 }
 
 c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupMPI::gather(
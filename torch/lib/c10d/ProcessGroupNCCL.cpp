@@ -1,6 +1,12 @@
 #include <c10d/ProcessGroupNCCL.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <climits>
+#include <cstring>
 #include <map>
+#include <system_error>
 #include <tuple>
 #include <unordered_set>
 
@@ -15,6 +21,8 @@
 namespace c10d {
 
 constexpr const char* const kNCCLAbortedCommStoreKey = "NCCLABORTEDCOMM";
+constexpr const char* const kHierarchicalAllreduceStoreKey =
+    "HIERARCHICALALLREDUCE";
 
 namespace {
 
@@ -109,6 +117,24 @@ std::string getKeyFromDevices(const std::vector<at::Device>& devices) {
   return deviceList;
 }
 
+// The communicators and streams of the high priority collectives of a set of
+// devices are cached under the key of the devices with this suffix
+const std::string kHighPriorityKeySuffix = ":high_priority";
+
+bool isHighPriorityKey(const std::string& devicesKey) {
+  return devicesKey.size() > kHighPriorityKeySuffix.size() &&
+      devicesKey.compare(
+          devicesKey.size() - kHighPriorityKeySuffix.size(),
+          kHighPriorityKeySuffix.size(),
+          kHighPriorityKeySuffix) == 0;
+}
+
+// The communicators and streams of the stripes of large allreduces, see
+// `ProcessGroupNCCL::Options::allreduceStripes`.
+std::string getStripeKey(const std::string& devicesKey, int stripe) {
+  return devicesKey + ":stripe" + std::to_string(stripe);
+}
+
 std::string getKeySendRecv(int myRank, int peer) {
   int lowRank = myRank < peer ? myRank : peer;
   int highRank = myRank < peer ? peer : myRank;
@@ -410,6 +436,26 @@ ProcessGroupNCCL::ProcessGroupNCCL(
     "ProcessGroupNCCL is only supported with GPUs, no GPUs found!");
   blockingWait_ = parseEnvVarFlag(NCCL_BLOCKING_WAIT);
   asyncErrorHandling_ = parseEnvVarFlag(NCCL_ASYNC_ERROR_HANDLING);
+  hierarchicalAllreduce_ = options->hierarchicalAllreduce ||
+      parseEnvVarFlag(NCCL_HIERARCHICAL_ALLREDUCE);
+  priorityAllreduce_ = options->priorityAllreduce ||
+      parseEnvVarFlag(NCCL_PRIORITY_ALLREDUCE);
+  allreduceStripes_ = options->allreduceStripes;
+  allreduceStripeMinBytes_ = options->allreduceStripeMinBytes;
+  const char* stripes = std::getenv(NCCL_ALLREDUCE_STRIPES);
+  if (allreduceStripes_ == 1 && stripes != nullptr) {
+    try {
+      allreduceStripes_ = std::stoi(stripes);
+    } catch (std::exception& e) {
+      throw std::runtime_error(
+          "Invalid value for environment variable: " +
+          std::string(NCCL_ALLREDUCE_STRIPES));
+    }
+  }
+  TORCH_CHECK(
+      allreduceStripes_ >= 1,
+      "The number of allreduce stripes must be at least 1, got ",
+      allreduceStripes_);
 
   if (blockingWait_ && asyncErrorHandling_) {
     LOG(INFO) << "[Rank " << rank_
@@ -440,6 +486,9 @@ ProcessGroupNCCL::ProcessGroupNCCL(
             << "\nNCCL_BLOCKING_WAIT: " << blockingWait_
             << "\nTIMEOUT(ms): " << opTimeout_.count()
             << "\nUSE_HIGH_PRIORITY_STREAM: " << isHighPriorityStream_
+            << "\nHIERARCHICAL_ALLREDUCE: " << hierarchicalAllreduce_
+            << "\nPRIORITY_ALLREDUCE: " << priorityAllreduce_
+            << "\nALLREDUCE_STRIPES: " << allreduceStripes_
             << "\nNCCL_DEBUG: " << ncclDebugLevel;
 }
 
@@ -825,7 +874,8 @@ std::vector<std::shared_ptr<NCCLComm>>& ProcessGroupNCCL::getNCCLComm(
     ncclComms[i] = NCCLComm::create(numRanks, rank, ncclID);
 
     // Creates the NCCL streams
-    streamVal.push_back(at::cuda::getStreamFromPool(isHighPriorityStream_));
+    streamVal.push_back(at::cuda::getStreamFromPool(
+        isHighPriorityStream_ || isHighPriorityKey(devicesKey)));
   }
 
   // [Note 2 ]
@@ -858,6 +908,117 @@ std::vector<std::shared_ptr<NCCLComm>>& ProcessGroupNCCL::getNCCLComm(
   return devNCCLCommMap_[devicesKey];
 }
 
+bool ProcessGroupNCCL::initHierarchicalAllreduce(const at::Device& device) {
+  auto& comms = hierarchicalComms_;
+  if (comms.initialized) {
+    // The communicators can only be used on the device they were created on.
+    return comms.usable && comms.deviceIndex == device.index();
+  }
+  comms.initialized = true;
+  comms.deviceIndex = device.index();
+
+  // Group the ranks into nodes by their hostnames. The nodes are ordered by
+  // their lowest rank, so every rank derives the same layout.
+  const std::string keyPrefix =
+      std::string(kHierarchicalAllreduceStoreKey) + ":";
+  std::array<char, HOST_NAME_MAX> hostname{};
+  if (gethostname(hostname.data(), HOST_NAME_MAX) != 0) {
+    throw std::system_error(errno, std::system_category());
+  }
+  store_->set(
+      keyPrefix + "host:" + std::to_string(rank_),
+      std::vector<uint8_t>(
+          hostname.data(), hostname.data() + strlen(hostname.data())));
+  std::vector<std::string> nodes;
+  std::vector<int> localSizes;
+  for (int rank = 0; rank < size_; ++rank) {
+    const auto vec = store_->get(keyPrefix + "host:" + std::to_string(rank));
+    const std::string host(vec.begin(), vec.end());
+    const auto it = std::find(nodes.begin(), nodes.end(), host);
+    const int node = it - nodes.begin();
+    if (it == nodes.end()) {
+      nodes.push_back(host);
+      localSizes.push_back(0);
+    }
+    if (rank == rank_) {
+      comms.nodeRank = node;
+      comms.localRank = localSizes[node];
+    }
+    localSizes[node]++;
+  }
+  comms.numNodes = nodes.size();
+  comms.localSize = localSizes[comms.nodeRank];
+
+  if (comms.numNodes == 1 || comms.localSize == 1) {
+    LOG(INFO) << "[Rank " << rank_ << "] Found " << comms.numNodes
+              << " node(s) with " << comms.localSize
+              << " rank(s) on this node, so hierarchical allreduce falls back "
+              << "to flat allreduce.";
+    return false;
+  }
+  if (std::any_of(localSizes.begin(), localSizes.end(), [&](int localSize) {
+        return localSize != comms.localSize;
+      })) {
+    LOG(WARNING) << "[Rank " << rank_
+                 << "] Hierarchical allreduce requires the same number of "
+                 << "ranks on every node. Falling back to flat allreduce.";
+    return false;
+  }
+
+  // The intra-node communicator connects the ranks on the same node, and the
+  // inter-node communicator connects the ranks with the same local rank.
+  auto createComm = [&](const std::string& storeKey, int numRanks, int rank) {
+    ncclUniqueId ncclID;
+    if (rank == 0) {
+      C10D_NCCL_CHECK(ncclGetUniqueId(&ncclID));
+      store_->set(
+          storeKey,
+          std::vector<uint8_t>(
+              reinterpret_cast<uint8_t*>(&ncclID),
+              reinterpret_cast<uint8_t*>(&ncclID) + NCCL_UNIQUE_ID_BYTES));
+    } else {
+      const auto vec = store_->get(storeKey);
+      TORCH_CHECK(vec.size() == NCCL_UNIQUE_ID_BYTES);
+      std::memcpy(&ncclID, vec.data(), vec.size());
+    }
+    return NCCLComm::create(numRanks, rank, ncclID);
+  };
+
+  at::cuda::OptionalCUDAGuard gpuGuard(device);
+  // See [Group Start/End Note]
+  for (size_t i = 0; i < ncclActiveGroupCounter_; ++i) {
+    C10D_NCCL_CHECK(ncclGroupEnd());
+  }
+  comms.intraNodeComm = createComm(
+      keyPrefix + "intra:" + std::to_string(comms.nodeRank),
+      comms.localSize,
+      comms.localRank);
+  comms.interNodeComm = createComm(
+      keyPrefix + "inter:" + std::to_string(comms.localRank),
+      comms.numNodes,
+      comms.nodeRank);
+  for (size_t i = 0; i < ncclActiveGroupCounter_; ++i) {
+    C10D_NCCL_CHECK(ncclGroupStart());
+  }
+
+  {
+    // Cache the communicators so that the watchdog checks them for errors and
+    // they are aborted on destruction like the other communicators.
+    std::lock_guard<std::mutex> lock(mutex_);
+    devNCCLCommMap_.emplace(
+        keyPrefix + std::to_string(device.index()),
+        std::vector<std::shared_ptr<NCCLComm>>{
+            comms.intraNodeComm, comms.interNodeComm});
+  }
+
+  LOG(INFO) << "[Rank " << rank_ << "] Hierarchical allreduce is enabled on "
+            << comms.numNodes << " nodes with " << comms.localSize
+            << " ranks each. Local rank: " << comms.localRank
+            << ", node rank: " << comms.nodeRank << ".";
+  comms.usable = true;
+  return true;
+}
+
 namespace {
 
 // Check validity of tensor
@@ -910,6 +1071,27 @@ void check_gpu_tensors(const std::vector<at::Tensor>& tensors) {
   }
 }
 
+// Check that the tensors of a coalesced collective can be flattened into a
+// single buffer on one GPU.
+void check_coalesced_gpu_tensors(const std::vector<at::Tensor>& tensors) {
+  if (tensors.size() == 0) {
+    throw std::runtime_error("Tensor list must be nonempty");
+  }
+
+  const auto& first = tensors.front();
+  for (const auto& t : tensors) {
+    if (!t.is_cuda() || t.is_sparse()) {
+      throw std::runtime_error("Tensors must be CUDA and dense");
+    }
+    if (t.scalar_type() != first.scalar_type()) {
+      throw std::runtime_error("Tensors must have identical type");
+    }
+    if (t.device() != first.device()) {
+      throw std::runtime_error("Tensors must be on the same GPU device");
+    }
+  }
+}
+
 // Flatten each list in `tensor_lists' for a gather or scatter operation, and
 // ensure compatibility with the corresponding tensor in `other'.
 std::vector<at::Tensor> flatten_for_scatter_gather(
@@ -984,7 +1166,11 @@ void ProcessGroupNCCL::workEnqueue(
 }
 ProcessGroupNCCL::Options::Options()
     : opTimeout(kProcessGroupNCCLOpTimeoutMillis),
-      isHighPriorityStream(false) {}
+      isHighPriorityStream(false),
+      hierarchicalAllreduce(false),
+      priorityAllreduce(false),
+      allreduceStripes(1),
+      allreduceStripeMinBytes(16 * 1024 * 1024) {}
 
 template <typename Fn, typename PreProcess, typename PostProcess>
 c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupNCCL::collective(
@@ -994,9 +1180,13 @@ c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupNCCL::collective(
     PreProcess pre,
     PostProcess post,
     OpType opType,
-    const char* profilingTitle) {
+    const char* profilingTitle,
+    bool highPriority) {
   const auto devices = getDeviceList(inputs);
-  const auto key = getKeyFromDevices(devices);
+  auto key = getKeyFromDevices(devices);
+  if (highPriority) {
+    key += kHighPriorityKeySuffix;
+  }
   auto& ncclComms = getNCCLComm(key, devices, opType);
 
   // First let NCCL streams wait for input tensors allocation streams
@@ -1161,7 +1351,8 @@ c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupNCCL::collective(
     std::vector<at::Tensor>& outputs,
     Fn fn,
     OpType opType,
-    const char* profilingTitle) {
+    const char* profilingTitle,
+    bool highPriority) {
   return collective(
       inputs,
       outputs,
@@ -1169,7 +1360,8 @@ c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupNCCL::collective(
       [](std::vector<at::cuda::CUDAStream>&) {},
       [](std::vector<at::cuda::CUDAStream>&) {},
       opType,
-      profilingTitle);
+      profilingTitle,
+      highPriority);
 }
 
 template <typename Fn>
@@ -1187,11 +1379,236 @@ c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupNCCL::pointToPoint(
       [](std::vector<at::cuda::CUDAStream>&) {});
 }
 
+c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupNCCL::allreduceHierarchical(
+    std::vector<at::Tensor>& tensors,
+    const AllreduceOptions& opts) {
+  const auto devices = getDeviceList(tensors);
+  const auto key = getKeyFromDevices(devices);
+  auto& ncclComms = getNCCLComm(key, devices, OpType::ALLREDUCE);
+  const auto& comms = hierarchicalComms_;
+  auto& tensor = tensors[0];
+
+  // First let NCCL streams wait for input tensors allocation streams
+  syncStreams(devices, ncclEvents_[key], ncclStreams_[key]);
+
+  auto work = initWork(
+      devices,
+      rank_,
+      OpType::ALLREDUCE,
+      "nccl:all_reduce_hierarchical",
+      c10::optional<std::vector<at::Tensor>>(tensors));
+
+  // Store references to outputs to be used by WorkNCCL::result and operator<<.
+  work->outputs_ = std::make_shared<std::vector<at::Tensor>>(tensors);
+
+  at::cuda::OptionalCUDAGuard gpuGuard(devices[0]);
+  at::cuda::CUDAStream& ncclStream = ncclStreams_[key][0];
+  // See [Sync Streams].
+  c10::cuda::CUDACachingAllocator::recordStream(
+      tensor.storage().data_ptr(), ncclStream);
+
+  // Reduce-scatter and allgather operate on equally sized shards, so the
+  // tensor is padded to a multiple of the local size if needed. The padding
+  // only ever reduces with itself and is discarded.
+  const int64_t numel = tensor.numel();
+  const int64_t shardNumel = (numel + comms.localSize - 1) / comms.localSize;
+  auto buffer = tensor;
+  const bool padded = shardNumel * comms.localSize != numel;
+  if (padded) {
+    at::cuda::CUDAStreamGuard guard(ncclStream);
+    buffer = at::zeros({shardNumel * comms.localSize}, tensor.options());
+    buffer.narrow(0, 0, numel).copy_(tensor.view(-1));
+  }
+
+  const auto dataType = getNcclDataType(tensor.scalar_type());
+  const auto reduceOp = getNcclReduceOp(opts.reduceOp, tensor);
+  void* data = buffer.data_ptr();
+  void* shard = static_cast<char*>(data) +
+      comms.localRank * shardNumel * buffer.element_size();
+  {
+    // The three steps depend on each other, so they are enqueued in order on
+    // the same stream instead of as a NCCL group.
+    std::lock_guard<std::mutex> freeMutexLock(
+        *c10::cuda::CUDACachingAllocator::getFreeMutex());
+    C10D_NCCL_CHECK(ncclReduceScatter(
+        data,
+        shard,
+        shardNumel,
+        dataType,
+        reduceOp,
+        comms.intraNodeComm->getNcclComm(),
+        ncclStream.stream()));
+    C10D_NCCL_CHECK(ncclAllReduce(
+        shard,
+        shard,
+        shardNumel,
+        dataType,
+        reduceOp,
+        comms.interNodeComm->getNcclComm(),
+        ncclStream.stream()));
+    C10D_NCCL_CHECK(ncclAllGather(
+        shard,
+        data,
+        shardNumel,
+        dataType,
+        comms.intraNodeComm->getNcclComm(),
+        ncclStream.stream()));
+  }
+
+  if (padded) {
+    at::cuda::CUDAStreamGuard guard(ncclStream);
+    tensor.view(-1).copy_(buffer.narrow(0, 0, numel), /*non_blocking=*/true);
+  }
+
+  (*work->cudaEvents_)[0].record(ncclStream);
+  work->ncclComms_[0] = ncclComms[0];
+
+  {
+    at::cuda::CUDAMultiStreamGuard streamGuard(ncclStreams_[key]);
+    work->future_ = c10::make_intrusive<at::cuda::CUDAFuture>(
+        c10::ListType::create(c10::TensorType::get()));
+    work->future_->markCompleted(at::IValue(*work->outputs_));
+  }
+
+  // Set appropriate work parameters.
+  work->blockingWait_ = blockingWait_;
+  work->opTimeout_ = opTimeout_;
+  work->store_ = store_;
+
+  if (work->recordFunctionEndCallback_) {
+    // See the comment in `collective`.
+    work->recordFunctionEndCallback_();
+  }
+
+  if (asyncErrorHandling_) {
+    workEnqueue(work);
+  }
+
+  return work;
+}
+
+c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupNCCL::allreduceStriped(
+    std::vector<at::Tensor>& tensors,
+    const AllreduceOptions& opts) {
+  const auto devices = getDeviceList(tensors);
+  const auto devicesKey = getKeyFromDevices(devices);
+  auto& tensor = tensors[0];
+
+  // The stripes are multiples of 128 bytes, so that every stripe but the last
+  // one starts and ends at the same alignment as the tensor.
+  const int64_t numel = tensor.numel();
+  const int64_t elementSize = tensor.element_size();
+  const int64_t alignment = std::max<int64_t>(128 / elementSize, 1);
+  int64_t stripeNumel = (numel + allreduceStripes_ - 1) / allreduceStripes_;
+  stripeNumel = (stripeNumel + alignment - 1) / alignment * alignment;
+  const int numStripes = (numel + stripeNumel - 1) / stripeNumel;
+
+  std::vector<std::string> keys;
+  std::vector<std::shared_ptr<NCCLComm>> ncclComms;
+  for (int i = 0; i < numStripes; ++i) {
+    auto key = getStripeKey(devicesKey, i);
+    if (opts.highPriority && priorityAllreduce_) {
+      key += kHighPriorityKeySuffix;
+    }
+    ncclComms.push_back(getNCCLComm(key, devices, OpType::ALLREDUCE)[0]);
+    // First let NCCL streams wait for input tensors allocation streams
+    syncStreams(devices, ncclEvents_[key], ncclStreams_[key]);
+    keys.push_back(std::move(key));
+  }
+
+  auto work = initWork(
+      devices,
+      rank_,
+      OpType::ALLREDUCE,
+      "nccl:all_reduce_striped",
+      c10::optional<std::vector<at::Tensor>>(tensors));
+
+  // Store references to outputs to be used by WorkNCCL::result and operator<<.
+  work->outputs_ = std::make_shared<std::vector<at::Tensor>>(tensors);
+
+  at::cuda::OptionalCUDAGuard gpuGuard(devices[0]);
+  for (const auto& key : keys) {
+    // See [Sync Streams].
+    c10::cuda::CUDACachingAllocator::recordStream(
+        tensor.storage().data_ptr(), ncclStreams_[key][0]);
+  }
+
+  const auto dataType = getNcclDataType(tensor.scalar_type());
+  const auto reduceOp = getNcclReduceOp(opts.reduceOp, tensor);
+  char* data = static_cast<char*>(tensor.data_ptr());
+  {
+    // The stripes are independent of each other, so they are launched as one
+    // NCCL group and run concurrently on their streams.
+    AutoNcclGroup nccl_group_guard;
+    for (int i = 0; i < numStripes; ++i) {
+      const int64_t offset = i * stripeNumel;
+      void* stripe = data + offset * elementSize;
+      C10D_NCCL_CHECK(ncclAllReduce(
+          stripe,
+          stripe,
+          std::min(stripeNumel, numel - offset),
+          dataType,
+          reduceOp,
+          ncclComms[i]->getNcclComm(),
+          ncclStreams_[keys[i]][0].stream()));
+    }
+  }
+
+  // Join the stripes on the stream of the first one, which the work and its
+  // future wait on. The watchdog checks the communicators of the other
+  // stripes for errors.
+  at::cuda::CUDAStream& ncclStream = ncclStreams_[keys[0]][0];
+  for (int i = 1; i < numStripes; ++i) {
+    at::cuda::CUDAEvent& joinEvent = ncclEvents_[keys[i]][0];
+    joinEvent.record(ncclStreams_[keys[i]][0]);
+    joinEvent.block(ncclStream);
+  }
+  (*work->cudaEvents_)[0].record(ncclStream);
+  work->ncclComms_[0] = ncclComms[0];
+
+  {
+    at::cuda::CUDAMultiStreamGuard streamGuard(ncclStreams_[keys[0]]);
+    work->future_ = c10::make_intrusive<at::cuda::CUDAFuture>(
+        c10::ListType::create(c10::TensorType::get()));
+    work->future_->markCompleted(at::IValue(*work->outputs_));
+  }
+
+  // Set appropriate work parameters.
+  work->blockingWait_ = blockingWait_;
+  work->opTimeout_ = opTimeout_;
+  work->store_ = store_;
+
+  if (work->recordFunctionEndCallback_) {
+    // See the comment in `collective`.
+    work->recordFunctionEndCallback_();
+  }
+
+  if (asyncErrorHandling_) {
+    workEnqueue(work);
+  }
+
+  return work;
+}
+
 c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupNCCL::allreduce(
     std::vector<at::Tensor>& tensors,
     const AllreduceOptions& opts) {
   check_gpu_tensors(tensors);
 
+  // Hierarchical allreduce only supports a single device per process.
+  if (hierarchicalAllreduce_ && tensors.size() == 1 &&
+      initHierarchicalAllreduce(tensors[0].device())) {
+    return allreduceHierarchical(tensors, opts);
+  }
+
+  // So does striped allreduce, which only pays off for large tensors.
+  if (allreduceStripes_ > 1 && tensors.size() == 1) {
+    const size_t nbytes = tensors[0].numel() * tensors[0].element_size();
+    if (nbytes > 0 && nbytes >= allreduceStripeMinBytes_) {
+      return allreduceStriped(tensors, opts);
+    }
+  }
+
   return collective(
       tensors,
       tensors,
@@ -1209,14 +1626,54 @@ c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupNCCL::allreduce(
             stream.stream());
       },
       OpType::ALLREDUCE,
-      "nccl:all_reduce");
+      "nccl:all_reduce",
+      opts.highPriority && priorityAllreduce_);
 }
 
 c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupNCCL::allreduce_coalesced(
     std::vector<at::Tensor>& tensors,
     const AllreduceCoalescedOptions& opts) {
-  throw std::runtime_error(
-      "allreduce_coalesced is currently not supported with NCCL");
+  check_coalesced_gpu_tensors(tensors);
+
+  // Reduce all tensors with a single ncclAllReduce over a flattened buffer,
+  // instead of paying the launch overhead for every tensor.
+  std::vector<at::Tensor> flattened = {flattenDenseTensors(tensors)};
+
+  return collective(
+      flattened,
+      flattened,
+      [&](at::Tensor& input,
+          at::Tensor& output,
+          ncclComm_t comm,
+          at::cuda::CUDAStream& stream) {
+        return ncclAllReduce(
+            input.data_ptr(),
+            output.data_ptr(),
+            input.numel(),
+            getNcclDataType(input.scalar_type()),
+            getNcclReduceOp(opts.reduceOp, input),
+            comm,
+            stream.stream());
+      },
+      [&](std::vector<at::cuda::CUDAStream>& ncclStreams) {},
+      [&](std::vector<at::cuda::CUDAStream>& ncclStreams) {
+        // Copy the reduced buffer back to the tensors.
+        at::cuda::CUDAStreamGuard guard(ncclStreams[0]);
+        int64_t offset = 0;
+        for (auto& tensor : tensors) {
+          // See [Sync Streams].
+          c10::cuda::CUDACachingAllocator::recordStream(
+              tensor.storage().data_ptr(), ncclStreams[0]);
+          tensor.copy_(
+              flattened[0].narrow(0, offset, tensor.numel()).view(
+                  tensor.sizes()),
+              true);
+          offset += tensor.numel();
+        }
+      },
+      OpType::ALLREDUCE_COALESCED,
+      "nccl:all_reduce_coalesced",
+      opts.highPriority && priorityAllreduce_);
 }
 
 c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupNCCL::broadcast(
@@ -1317,11 +1774,162 @@ c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupNCCL::allgather(
 }
 
 c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupNCCL::allgather_coalesced(
-    std::vector<std::vector<at::Tensor>>& /* unused */,
-    std::vector<at::Tensor>& /* unused */,
+    std::vector<std::vector<at::Tensor>>& outputTensorLists,
+    std::vector<at::Tensor>& inputTensors,
     const AllgatherOptions& /* unused */) {
-  throw std::runtime_error(
-      "ProcessGroupNCCL does not support allgather_coalesced");
+  check_coalesced_gpu_tensors(inputTensors);
+  if (outputTensorLists.size() != static_cast<size_t>(size_)) {
+    throw std::runtime_error(
+        "Tensor list input to allgather_coalesced must have one output list "
+        "per collective participant");
+  }
+  // The i'th tensor of every output list receives the i'th input tensor of
+  // the corresponding rank.
+  for (const auto& outputTensors : outputTensorLists) {
+    if (outputTensors.size() != inputTensors.size()) {
+      throw std::runtime_error(
+          "All output lists of allgather_coalesced must have as many tensors "
+          "as the input list");
+    }
+    for (size_t i = 0; i < outputTensors.size(); ++i) {
+      if (outputTensors[i].sizes() != inputTensors[i].sizes() ||
+          !outputTensors[i].options().type_equal(inputTensors[i].options())) {
+        throw std::runtime_error(
+            "Output tensors of allgather_coalesced must match the input "
+            "tensors in size and type");
+      }
+    }
+  }
+
+  // Gather all tensors with a single ncclAllGather over flattened buffers.
+  std::vector<at::Tensor> inputFlattened = {flattenDenseTensors(inputTensors)};
+  const auto inputNumel = inputFlattened[0].numel();
+  std::vector<at::Tensor> outputFlattened = {
+      at::empty({size_ * inputNumel}, inputFlattened[0].options())};
+
+  return collective(
+      inputFlattened,
+      outputFlattened,
+      [&](at::Tensor& input,
+          at::Tensor& output,
+          ncclComm_t comm,
+          at::cuda::CUDAStream& stream) {
+        c10::cuda::CUDACachingAllocator::recordStream(
+            output.storage().data_ptr(), stream);
+        return ncclAllGather(
+            input.data_ptr(),
+            output.data_ptr(),
+            input.numel(),
+            getNcclDataType(input.scalar_type()),
+            comm,
+            stream.stream());
+      },
+      [&](std::vector<at::cuda::CUDAStream>& ncclStreams) {},
+      [&](std::vector<at::cuda::CUDAStream>& ncclStreams) {
+        // Copy the flattened output to the output lists.
+        at::cuda::CUDAStreamGuard guard(ncclStreams[0]);
+        int64_t offset = 0;
+        for (auto& outputTensors : outputTensorLists) {
+          for (auto& outputTensor : outputTensors) {
+            // See [Sync Streams].
+            c10::cuda::CUDACachingAllocator::recordStream(
+                outputTensor.storage().data_ptr(), ncclStreams[0]);
+            outputTensor.copy_(
+                outputFlattened[0]
+                    .narrow(0, offset, outputTensor.numel())
+                    .view(outputTensor.sizes()),
+                true);
+            offset += outputTensor.numel();
+          }
+        }
+      },
+      OpType::ALLGATHER_COALESCED,
+      "nccl:all_gather_coalesced");
+}
+
+c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupNCCL::reduceScatterCoalesced(
+    std::vector<at::Tensor>& outputTensors,
+    std::vector<std::vector<at::Tensor>>& inputTensors,
+    const ReduceScatterOptions& opts) {
+  TORCH_CHECK(
+      outputTensors.size() == 1 && inputTensors.size() == 1,
+      "reduce_scatter with inputs of different sizes only supports a single "
+      "device per process");
+  auto& inputs = inputTensors[0];
+  const auto& output = outputTensors[0];
+  TORCH_CHECK(
+      inputs.size() == static_cast<size_t>(size_),
+      "Tensor list input to scatter/gather must match number of collective"
+      " participants");
+  TORCH_CHECK(
+      inputs[rank_].numel() == output.numel(),
+      "The output of reduce_scatter must have the same number of elements as "
+      "the input of this rank");
+
+  std::vector<int64_t> offsets;
+  offsets.reserve(inputs.size());
+  int64_t totalNumel = 0;
+  for (const auto& input : inputs) {
+    TORCH_CHECK(
+        input.device() == output.device(),
+        "Corresponding input/output tensors to scatter/gather must all reside"
+        " on the same device");
+    TORCH_CHECK(
+        input.scalar_type() == output.scalar_type(),
+        "All tensor operands to scatter/gather must have the same type");
+    offsets.push_back(totalNumel);
+    totalNumel += input.numel();
+  }
+
+  std::vector<at::Tensor> inputFlattened = {
+      at::empty({totalNumel}, output.options())};
+
+  return collective(
+      inputFlattened,
+      outputTensors,
+      [&](at::Tensor& input,
+          at::Tensor& output,
+          ncclComm_t comm,
+          at::cuda::CUDAStream& stream) {
+        c10::cuda::CUDACachingAllocator::recordStream(
+            output.storage().data_ptr(), stream);
+        const auto dataType = getNcclDataType(input.scalar_type());
+        const auto reduceOp = getNcclReduceOp(opts.reduceOp, input);
+        // The reductions to the different roots are independent, so they can
+        // run in the same NCCL group.
+        for (int root = 0; root < size_; ++root) {
+          void* sendbuff = static_cast<char*>(input.data_ptr()) +
+              offsets[root] * input.element_size();
+          auto result = ncclReduce(
+              sendbuff,
+              root == rank_ ? output.data_ptr() : sendbuff,
+              inputs[root].numel(),
+              dataType,
+              reduceOp,
+              root,
+              comm,
+              stream.stream());
+          if (result != ncclSuccess) {
+            return result;
+          }
+        }
+        return ncclSuccess;
+      },
+      [&](std::vector<at::cuda::CUDAStream>& ncclStreams) {
+        // Copy the input tensors to the flattened input.
+        at::cuda::CUDAStreamGuard guard(ncclStreams[0]);
+        for (size_t i = 0; i < inputs.size(); ++i) {
+          // See [Sync Streams].
+          c10::cuda::CUDACachingAllocator::recordStream(
+              inputs[i].storage().data_ptr(), ncclStreams[0]);
+          inputFlattened[0]
+              .narrow(0, offsets[i], inputs[i].numel())
+              .copy_(inputs[i].reshape({-1}), true);
+        }
+      },
+      [&](std::vector<at::cuda::CUDAStream>& ncclStreams) {},
+      OpType::REDUCE_SCATTER,
+      "nccl:reduce_scatter");
 }
 
 c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupNCCL::reduce_scatter(
@@ -1330,6 +1938,21 @@ c10::intrusive_ptr<ProcessGroup::Work> ProcessGroupNCCL::reduce_scatter(
     const ReduceScatterOptions& opts) {
   check_gpu_tensors(outputTensors);
 
+  // Inputs whose sizes differ from the outputs, e.g. uneven shards of a
+  // flattened buffer, cannot use ncclReduceScatter.
+  const bool differentSizes = std::any_of(
+      inputTensors.begin(),
+      inputTensors.end(),
+      [&](const std::vector<at::Tensor>& inputs) {
+        return std::any_of(
+            inputs.begin(), inputs.end(), [&](const at::Tensor& input) {
+              return input.numel() != outputTensors[0].numel();
+            });
+      });
+  if (differentSizes) {
+    return reduceScatterCoalesced(outputTensors, inputTensors, opts);
+  }
+
   auto inputFlattened =
       flatten_for_scatter_gather(inputTensors, outputTensors, size_);
   check_gpu_tensors(inputFlattened);
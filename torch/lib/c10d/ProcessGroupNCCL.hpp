@@ -32,6 +32,19 @@ constexpr const char* NCCL_BLOCKING_WAIT = "NCCL_BLOCKING_WAIT";
 // Handling with NCCL.
 constexpr const char* NCCL_ASYNC_ERROR_HANDLING = "NCCL_ASYNC_ERROR_HANDLING";
 
+// Environment variable which enables hierarchical allreduce, see
+// `ProcessGroupNCCL::Options::hierarchicalAllreduce`.
+constexpr const char* NCCL_HIERARCHICAL_ALLREDUCE =
+    "TORCH_NCCL_HIERARCHICAL_ALLREDUCE";
+
+// Environment variable which enables priority allreduce, see
+// `ProcessGroupNCCL::Options::priorityAllreduce`.
+constexpr const char* NCCL_PRIORITY_ALLREDUCE = "TORCH_NCCL_PRIORITY_ALLREDUCE";
+
+// Environment variable which sets the number of stripes of large allreduces,
+// see `ProcessGroupNCCL::Options::allreduceStripes`.
+constexpr const char* NCCL_ALLREDUCE_STRIPES = "TORCH_NCCL_ALLREDUCE_STRIPES";
+
 constexpr const char* NCCL_BACKEND_NAME = "nccl";
 
 // ProcessGroupNCCL implements NCCL bindings for c10d.
@@ -194,6 +207,29 @@ class ProcessGroupNCCL : public ProcessGroup {
 
     std::chrono::milliseconds opTimeout;
     bool isHighPriorityStream;
+    // Run allreduce in three steps: reduce-scatter among the ranks on the
+    // same node, allreduce of the shards across nodes, and allgather among the
+    // ranks on the same node. The nodes are discovered through the store on
+    // the first allreduce. Only applies to single-device-per-process
+    // allreduce, and falls back to a flat allreduce if there is only one node
+    // or only one rank per node, or if the nodes have different numbers of
+    // ranks. Also enabled by TORCH_NCCL_HIERARCHICAL_ALLREDUCE=1.
+    bool hierarchicalAllreduce;
+    // Run the allreduces marked with `AllreduceOptions::highPriority`, such
+    // as DDP's gradient buckets, on their own NCCL communicators and high
+    // priority CUDA streams. They are then neither queued behind the other
+    // collectives of the group, nor behind compute kernels on a busy GPU.
+    // Each set of devices gets a second communicator, which costs the memory
+    // of its NCCL buffers. Also enabled by TORCH_NCCL_PRIORITY_ALLREDUCE=1.
+    bool priorityAllreduce;
+    // Split the single-device allreduces of at least `allreduceStripeMinBytes`
+    // into this many stripes, each reduced on its own NCCL communicator and
+    // CUDA stream, so that one large gradient bucket can use the channels and
+    // NICs of several communicators at once. Every set of devices gets one
+    // communicator per stripe. 1 disables striping, the number of stripes can
+    // also be set by TORCH_NCCL_ALLREDUCE_STRIPES.
+    int allreduceStripes;
+    size_t allreduceStripeMinBytes;
   };
 
   // If you wish to create multiple process groups, each with a potentially
@@ -333,6 +369,12 @@ class ProcessGroupNCCL : public ProcessGroup {
       int p2pRank = 0,
       bool isSendRecvSelf = false);
 
+  // Discovers the nodes of this process group through the store and creates
+  // the intra-node and inter-node communicators for hierarchical allreduce on
+  // the given device, if not done yet. Returns whether hierarchical allreduce
+  // is usable.
+  bool initHierarchicalAllreduce(const at::Device& device);
+
   // Wrapper method which can be overridden for tests.
   virtual std::exception_ptr checkForNCCLErrors(
       const std::vector<std::shared_ptr<NCCLComm>>& ncclComms);
@@ -357,7 +399,10 @@ class ProcessGroupNCCL : public ProcessGroup {
       std::vector<at::Tensor>& output,
       Fn fn,
       OpType opType,
-      const char* profilingTitle = nullptr);
+      const char* profilingTitle = nullptr,
+      bool highPriority = false);
+  // If highPriority, the collective runs on the priority communicators and
+  // streams, see `Options::priorityAllreduce`.
   template <typename Fn, typename PreProcess, typename PostProcess>
   c10::intrusive_ptr<ProcessGroup::Work> collective(
       std::vector<at::Tensor>& input,
@@ -366,7 +411,28 @@ class ProcessGroupNCCL : public ProcessGroup {
       PreProcess pre,
       PostProcess post,
       OpType opType,
-      const char* profilingTitle = nullptr);
+      const char* profilingTitle = nullptr,
+      bool highPriority = false);
+
+  // Reduce-scatter whose inputs have different sizes. The inputs are coalesced
+  // into a single flat tensor, and every input is reduced to the rank that
+  // owns it. Only supports a single device per process.
+  c10::intrusive_ptr<ProcessGroup::Work> reduceScatterCoalesced(
+      std::vector<at::Tensor>& outputTensors,
+      std::vector<std::vector<at::Tensor>>& inputTensors,
+      const ReduceScatterOptions& opts);
+
+  // Allreduce of a single tensor through `hierarchicalComms_`. See
+  // `Options::hierarchicalAllreduce`.
+  c10::intrusive_ptr<ProcessGroup::Work> allreduceHierarchical(
+      std::vector<at::Tensor>& tensors,
+      const AllreduceOptions& opts);
+
+  // Allreduce of a single tensor split across `allreduceStripes_`
+  // communicators. See `Options::allreduceStripes`.
+  c10::intrusive_ptr<ProcessGroup::Work> allreduceStriped(
+      std::vector<at::Tensor>& tensors,
+      const AllreduceOptions& opts);
 
   // Helper that encapsulates work shared across point-to-point communication
   // primitives. It is the same structure as the helper used for collective
@@ -539,6 +605,37 @@ class ProcessGroupNCCL : public ProcessGroup {
   // Schedule NCCL operations on high priority CUDA streams.
   bool isHighPriorityStream_ = false;
 
+  // Whether allreduce is hierarchical. See `Options::hierarchicalAllreduce`.
+  bool hierarchicalAllreduce_ = false;
+
+  // Whether high priority allreduces get their own communicators and streams.
+  // See `Options::priorityAllreduce`.
+  bool priorityAllreduce_ = false;
+
+  // The number of stripes of the large allreduces and the size from which an
+  // allreduce is striped. See `Options::allreduceStripes`.
+  int allreduceStripes_ = 1;
+  size_t allreduceStripeMinBytes_ = 0;
+
+  // The node layout and communicators used by hierarchical allreduce.
+  struct HierarchicalComms {
+    // Whether `initHierarchicalAllreduce` has run.
+    bool initialized = false;
+    // Whether the layout benefits from hierarchical allreduce.
+    bool usable = false;
+    // The device that the communicators are created on.
+    int deviceIndex = -1;
+    // Rank and size within the node.
+    int localRank = 0;
+    int localSize = 1;
+    // Index of the node and the number of nodes.
+    int nodeRank = 0;
+    int numNodes = 1;
+    std::shared_ptr<NCCLComm> intraNodeComm;
+    std::shared_ptr<NCCLComm> interNodeComm;
+  };
+  HierarchicalComms hierarchicalComms_;
+
   // The number of active ncclGroupStart() calls. This counter will be increased
   // by 1 when ncclGroupStart() is called and decreased by 1 when ncclGroupEnd()
   // is called.
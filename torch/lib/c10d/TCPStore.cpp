@@ -8,6 +8,10 @@
 #include <unistd.h>
 #endif
 
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
 #include <algorithm>
 #include <fcntl.h>
 #include <system_error>
@@ -24,13 +28,28 @@ enum class QueryType : uint8_t {
   CHECK,
   WAIT,
   GETNUMKEYS,
-  DELETE_KEY
+  DELETE_KEY,
+  MULTI_GET,
+  MULTI_SET,
+  WAIT_COUNT
 };
 
 enum class CheckResponseType : uint8_t { READY, NOT_READY };
 
 enum class WaitResponseType : uint8_t { STOP_WAITING };
 
+#ifdef __linux__
+// Maximum number of events returned by a single epoll_wait call.
+constexpr int kMaxEpollEvents = 64;
+// Maximum number of threads handling queries in the daemon.
+constexpr unsigned kMaxHandlerThreads = 8;
+#endif
+
+int64_t parseCounter(const std::vector<uint8_t>& value) {
+  auto buf = reinterpret_cast<const char*>(value.data());
+  return std::stoll(std::string(buf, value.size()));
+}
+
 } // anonymous namespace
 
 // TCPStoreDaemon class methods
@@ -81,43 +100,63 @@ void TCPStoreDaemon::queryFds(std::vector<struct pollfd>& fds) {
       // exception, other connections will get an exception once they try to
       // use the store. We will go ahead and close this connection whenever
       // we hit an exception here.
-      tcputil::closeSocket(fds[fdIdx].fd);
-
-      // Remove all the tracking state of the close FD
-      for (auto it = waitingSockets_.begin(); it != waitingSockets_.end();) {
-        for (auto vecIt = it->second.begin(); vecIt != it->second.end();) {
-          if (*vecIt == fds[fdIdx].fd) {
-            vecIt = it->second.erase(vecIt);
-          } else {
-            ++vecIt;
-          }
-        }
-        if (it->second.size() == 0) {
-          it = waitingSockets_.erase(it);
-        } else {
-          ++it;
-        }
-      }
-      for (auto it = keysAwaited_.begin(); it != keysAwaited_.end();) {
-        if (it->first == fds[fdIdx].fd) {
-          it = keysAwaited_.erase(it);
-        } else {
-          ++it;
-        }
-      }
+      closeSocket(fds[fdIdx].fd);
       fds.erase(fds.begin() + fdIdx);
-      sockets_.erase(sockets_.begin() + fdIdx - CONNECT_SOCKET_OFFSET);
       --fdIdx;
       continue;
     }
   }
 }
 
+void TCPStoreDaemon::closeSocket(int socket) {
+  std::lock_guard<std::mutex> lock(storeMutex_);
+  // Remove all the tracking state of the socket before closing it, so that
+  // its fd cannot be reused by a new connection in the meantime.
+  for (auto it = waitingSockets_.begin(); it != waitingSockets_.end();) {
+    for (auto vecIt = it->second.begin(); vecIt != it->second.end();) {
+      if (*vecIt == socket) {
+        vecIt = it->second.erase(vecIt);
+      } else {
+        ++vecIt;
+      }
+    }
+    if (it->second.size() == 0) {
+      it = waitingSockets_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  keysAwaited_.erase(socket);
+  for (auto it = countWaitingSockets_.begin();
+       it != countWaitingSockets_.end();) {
+    auto& waiters = it->second;
+    waiters.erase(
+        std::remove_if(
+            waiters.begin(),
+            waiters.end(),
+            [socket](const std::pair<int64_t, int>& waiter) {
+              return waiter.second == socket;
+            }),
+        waiters.end());
+    if (waiters.empty()) {
+      it = countWaitingSockets_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  sockets_.erase(
+      std::remove(sockets_.begin(), sockets_.end(), socket), sockets_.end());
+  tcputil::closeSocket(socket);
+}
+
 // query communicates with the worker. The format
 // of the query is as follows:
 // type of query | size of arg1 | arg1 | size of arg2 | arg2 | ...
-// or, in the case of wait
+// or, in the case of wait, check and multi_get
 // type of query | number of args | size of arg1 | arg1 | ...
+// or, in the case of multi_set
+// type of query | number of pairs | size of key1 | key1 | size of value1 |
+// value1 | ...
 void TCPStoreDaemon::query(int socket) {
   QueryType qt;
   tcputil::recvBytes<QueryType>(socket, &qt, 1);
@@ -146,6 +185,15 @@ void TCPStoreDaemon::query(int socket) {
   } else if (qt == QueryType::DELETE_KEY) {
     deleteHandler(socket);
 
+  } else if (qt == QueryType::MULTI_GET) {
+    multiGetHandler(socket);
+
+  } else if (qt == QueryType::MULTI_SET) {
+    multiSetHandler(socket);
+
+  } else if (qt == QueryType::WAIT_COUNT) {
+    waitCountHandler(socket);
+
   } else {
     throw std::runtime_error("Unexpected query type");
   }
@@ -164,9 +212,33 @@ void TCPStoreDaemon::wakeupWaitingClients(const std::string& key) {
   }
 }
 
+void TCPStoreDaemon::wakeupCountWaitingClients(
+    const std::string& key,
+    int64_t count) {
+  auto socketsToWait = countWaitingSockets_.find(key);
+  if (socketsToWait == countWaitingSockets_.end()) {
+    return;
+  }
+  auto& waiters = socketsToWait->second;
+  for (auto it = waiters.begin(); it != waiters.end();) {
+    if (it->first <= count) {
+      tcputil::sendValue<WaitResponseType>(
+          it->second, WaitResponseType::STOP_WAITING);
+      it = waiters.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  if (waiters.empty()) {
+    countWaitingSockets_.erase(socketsToWait);
+  }
+}
+
 void TCPStoreDaemon::setHandler(int socket) {
   std::string key = tcputil::recvString(socket);
-  tcpStore_[key] = tcputil::recvVector<uint8_t>(socket);
+  std::vector<uint8_t> newData = tcputil::recvVector<uint8_t>(socket);
+  std::lock_guard<std::mutex> lock(storeMutex_);
+  tcpStore_[key] = std::move(newData);
   // On "set", wake up all clients that have been waiting
   wakeupWaitingClients(key);
 }
@@ -176,6 +248,7 @@ void TCPStoreDaemon::compareSetHandler(int socket) {
   std::vector<uint8_t> currentValue = tcputil::recvVector<uint8_t>(socket);
   std::vector<uint8_t> newValue = tcputil::recvVector<uint8_t>(socket);
 
+  std::lock_guard<std::mutex> lock(storeMutex_);
   auto pos = tcpStore_.find(key);
   if (pos == tcpStore_.end()) {
     // TODO: This code path is not ideal as we are "lying" to the caller in case
@@ -193,10 +266,9 @@ void TCPStoreDaemon::addHandler(int socket) {
   std::string key = tcputil::recvString(socket);
   int64_t addVal = tcputil::recvValue<int64_t>(socket);
 
+  std::lock_guard<std::mutex> lock(storeMutex_);
   if (tcpStore_.find(key) != tcpStore_.end()) {
-    auto buf = reinterpret_cast<const char*>(tcpStore_[key].data());
-    auto len = tcpStore_[key].size();
-    addVal += std::stoll(std::string(buf, len));
+    addVal += parseCounter(tcpStore_[key]);
   }
   auto addValStr = std::to_string(addVal);
   tcpStore_[key] = std::vector<uint8_t>(addValStr.begin(), addValStr.end());
@@ -204,20 +276,68 @@ void TCPStoreDaemon::addHandler(int socket) {
   tcputil::sendValue<int64_t>(socket, addVal);
   // On "add", wake up all clients that have been waiting
   wakeupWaitingClients(key);
+  wakeupCountWaitingClients(key, addVal);
 }
 
 void TCPStoreDaemon::getHandler(int socket) const {
   std::string key = tcputil::recvString(socket);
-  auto data = tcpStore_.at(key);
+  std::lock_guard<std::mutex> lock(storeMutex_);
+  const auto& data = tcpStore_.at(key);
   tcputil::sendVector<uint8_t>(socket, data);
 }
 
 void TCPStoreDaemon::getNumKeysHandler(int socket) const {
+  std::lock_guard<std::mutex> lock(storeMutex_);
   tcputil::sendValue<int64_t>(socket, tcpStore_.size());
 }
 
+void TCPStoreDaemon::multiGetHandler(int socket) const {
+  SizeType nargs;
+  tcputil::recvBytes<SizeType>(socket, &nargs, 1);
+  std::vector<std::string> keys(nargs);
+  for (size_t i = 0; i < nargs; i++) {
+    keys[i] = tcputil::recvString(socket);
+  }
+  std::lock_guard<std::mutex> lock(storeMutex_);
+  for (size_t i = 0; i < nargs; i++) {
+    tcputil::sendVector<uint8_t>(
+        socket, tcpStore_.at(keys[i]), (i != (nargs - 1)));
+  }
+}
+
+void TCPStoreDaemon::multiSetHandler(int socket) {
+  SizeType nargs;
+  tcputil::recvBytes<SizeType>(socket, &nargs, 1);
+  std::vector<std::string> keys(nargs);
+  std::vector<std::vector<uint8_t>> values(nargs);
+  for (size_t i = 0; i < nargs; i++) {
+    keys[i] = tcputil::recvString(socket);
+    values[i] = tcputil::recvVector<uint8_t>(socket);
+  }
+  std::lock_guard<std::mutex> lock(storeMutex_);
+  for (size_t i = 0; i < nargs; i++) {
+    tcpStore_[keys[i]] = std::move(values[i]);
+    wakeupWaitingClients(keys[i]);
+  }
+}
+
+void TCPStoreDaemon::waitCountHandler(int socket) {
+  std::string key = tcputil::recvString(socket);
+  int64_t count = tcputil::recvValue<int64_t>(socket);
+
+  std::lock_guard<std::mutex> lock(storeMutex_);
+  auto pos = tcpStore_.find(key);
+  if (pos != tcpStore_.end() && parseCounter(pos->second) >= count) {
+    tcputil::sendValue<WaitResponseType>(
+        socket, WaitResponseType::STOP_WAITING);
+  } else {
+    countWaitingSockets_[key].emplace_back(count, socket);
+  }
+}
+
 void TCPStoreDaemon::deleteHandler(int socket) {
   std::string key = tcputil::recvString(socket);
+  std::lock_guard<std::mutex> lock(storeMutex_);
   auto numDeleted = tcpStore_.erase(key);
   tcputil::sendValue<int64_t>(socket, numDeleted);
 }
@@ -230,6 +350,7 @@ void TCPStoreDaemon::checkHandler(int socket) const {
     keys[i] = tcputil::recvString(socket);
   }
   // Now we have received all the keys
+  std::lock_guard<std::mutex> lock(storeMutex_);
   if (checkKeys(keys)) {
     tcputil::sendValue<CheckResponseType>(socket, CheckResponseType::READY);
   } else {
@@ -244,6 +365,7 @@ void TCPStoreDaemon::waitHandler(int socket) {
   for (size_t i = 0; i < nargs; i++) {
     keys[i] = tcputil::recvString(socket);
   }
+  std::lock_guard<std::mutex> lock(storeMutex_);
   if (checkKeys(keys)) {
     tcputil::sendValue<WaitResponseType>(
         socket, WaitResponseType::STOP_WAITING);
@@ -344,6 +466,115 @@ void TCPStoreDaemon::stop() {
   }
 }
 
+#ifdef __linux__
+void TCPStoreDaemon::run() {
+  SYSCHECK_ERR_RETURN_NEG1(epollFd_ = ::epoll_create1(EPOLL_CLOEXEC));
+  struct epoll_event event {};
+  event.events = EPOLLIN;
+  event.data.fd = storeListenSocket_;
+  SYSCHECK_ERR_RETURN_NEG1(
+      ::epoll_ctl(epollFd_, EPOLL_CTL_ADD, storeListenSocket_, &event));
+  // Watch the read end of the pipe to signal the stopping of the daemon run
+  event.events = EPOLLHUP;
+  event.data.fd = controlPipeFd_[0];
+  SYSCHECK_ERR_RETURN_NEG1(
+      ::epoll_ctl(epollFd_, EPOLL_CTL_ADD, controlPipeFd_[0], &event));
+
+  const auto numHandlerThreads = std::max(
+      1u, std::min(std::thread::hardware_concurrency(), kMaxHandlerThreads));
+  for (unsigned i = 0; i < numHandlerThreads; ++i) {
+    handlerThreads_.emplace_back(&TCPStoreDaemon::handlerLoop, this);
+  }
+
+  // receive the queries
+  std::vector<struct epoll_event> events(kMaxEpollEvents);
+  bool finished = false;
+  while (!finished) {
+    int numEvents;
+    SYSCHECK_ERR_RETURN_NEG1(
+        numEvents =
+            ::epoll_wait(epollFd_, events.data(), kMaxEpollEvents, -1));
+
+    for (int i = 0; i < numEvents; ++i) {
+      const int fd = events[i].data.fd;
+      if (fd == storeListenSocket_) {
+        // TCPStore's listening socket has an event and it should now be able
+        // to accept new connections.
+        if (events[i].events ^ EPOLLIN) {
+          throw std::system_error(
+              ECONNABORTED,
+              std::system_category(),
+              "Unexpected epoll event on the master's listening socket: " +
+                  std::to_string(events[i].events));
+        }
+        int sockFd = std::get<0>(tcputil::accept(storeListenSocket_));
+        {
+          std::lock_guard<std::mutex> lock(storeMutex_);
+          sockets_.push_back(sockFd);
+        }
+        event.events = EPOLLIN | EPOLLONESHOT;
+        event.data.fd = sockFd;
+        SYSCHECK_ERR_RETURN_NEG1(
+            ::epoll_ctl(epollFd_, EPOLL_CTL_ADD, sockFd, &event));
+      } else if (fd == controlPipeFd_[0]) {
+        // The pipe receives an event which tells us to shutdown the daemon
+        finished = true;
+        break;
+      } else {
+        // A client socket has a query, hand it to a handler thread
+        {
+          std::lock_guard<std::mutex> lock(readySocketsMutex_);
+          readySockets_.push_back(fd);
+        }
+        readySocketsCV_.notify_one();
+      }
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(readySocketsMutex_);
+    stopHandlers_ = true;
+  }
+  readySocketsCV_.notify_all();
+  for (auto& thread : handlerThreads_) {
+    thread.join();
+  }
+  ::close(epollFd_);
+  epollFd_ = -1;
+}
+
+void TCPStoreDaemon::handlerLoop() {
+  while (true) {
+    int socket;
+    {
+      std::unique_lock<std::mutex> lock(readySocketsMutex_);
+      readySocketsCV_.wait(
+          lock, [this] { return stopHandlers_ || !readySockets_.empty(); });
+      if (stopHandlers_) {
+        return;
+      }
+      socket = readySockets_.front();
+      readySockets_.pop_front();
+    }
+
+    try {
+      query(socket);
+    } catch (...) {
+      // See the comment in queryFds.
+      closeSocket(socket);
+      continue;
+    }
+
+    // Re-arm the socket for its next query, which may already be buffered.
+    struct epoll_event event {};
+    event.events = EPOLLIN | EPOLLONESHOT;
+    event.data.fd = socket;
+    if (::epoll_ctl(epollFd_, EPOLL_CTL_MOD, socket, &event) == -1) {
+      closeSocket(socket);
+    }
+  }
+}
+#else
 void TCPStoreDaemon::run() {
   std::vector<struct pollfd> fds;
   tcputil::addPollfd(fds, storeListenSocket_, POLLIN);
@@ -390,6 +621,7 @@ void TCPStoreDaemon::run() {
     queryFds(fds);
   }
 }
+#endif // __linux__
 #endif
 
 // TCPStore class methods
@@ -445,25 +677,49 @@ TCPStore::~TCPStore() {
 void TCPStore::waitForWorkers() {
   addHelper_(initKey_, 1);
   // Let server block until all workers have completed, this ensures that
-  // the server daemon thread is always running until the very end
+  // the server daemon thread is always running until the very end. The
+  // daemon answers this single query once the last worker has joined, rather
+  // than having the server poll the number of workers.
   if (isServer_) {
-    const auto start = std::chrono::steady_clock::now();
-    while (true) {
-      std::vector<uint8_t> value = getHelper_(initKey_);
-      auto buf = reinterpret_cast<const char*>(value.data());
-      auto len = value.size();
-      int numWorkersCompleted = std::stoi(std::string(buf, len));
-      if (numWorkersCompleted >= numWorkers_.value_or(-1)) {
-        break;
-      }
-      const auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
-          std::chrono::steady_clock::now() - start);
-      if (timeout_ != kNoTimeout && elapsed > timeout_) {
-        break;
-      }
-      /* sleep override */
-      std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    }
+    waitCountHelper_(initKey_, numWorkers_.value_or(-1), timeout_);
+  }
+}
+
+std::vector<std::vector<uint8_t>> TCPStore::multiGet(
+    const std::vector<std::string>& keys) {
+  std::vector<std::string> regKeys(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    regKeys[i] = regularPrefix_ + keys[i];
+  }
+  waitHelper_(regKeys, timeout_);
+  tcputil::sendValue<QueryType>(storeSocket_, QueryType::MULTI_GET);
+  SizeType nkeys = regKeys.size();
+  tcputil::sendBytes<SizeType>(storeSocket_, &nkeys, 1, (nkeys > 0));
+  for (size_t i = 0; i < nkeys; i++) {
+    tcputil::sendString(storeSocket_, regKeys[i], (i != (nkeys - 1)));
+  }
+  std::vector<std::vector<uint8_t>> values(nkeys);
+  for (size_t i = 0; i < nkeys; i++) {
+    values[i] = tcputil::recvVector<uint8_t>(storeSocket_);
+  }
+  return values;
+}
+
+void TCPStore::multiSet(
+    const std::vector<std::string>& keys,
+    const std::vector<std::vector<uint8_t>>& values) {
+  if (keys.size() != values.size()) {
+    throw std::invalid_argument(
+        "multiSet requires as many values as keys, got " +
+        std::to_string(keys.size()) + " keys and " +
+        std::to_string(values.size()) + " values");
+  }
+  tcputil::sendValue<QueryType>(storeSocket_, QueryType::MULTI_SET);
+  SizeType nkeys = keys.size();
+  tcputil::sendBytes<SizeType>(storeSocket_, &nkeys, 1, (nkeys > 0));
+  for (size_t i = 0; i < nkeys; i++) {
+    tcputil::sendString(storeSocket_, regularPrefix_ + keys[i], true);
+    tcputil::sendVector<uint8_t>(storeSocket_, values[i], (i != (nkeys - 1)));
   }
 }
 
@@ -556,9 +812,7 @@ void TCPStore::wait(
   waitHelper_(regKeys, timeout);
 }
 
-void TCPStore::waitHelper_(
-    const std::vector<std::string>& keys,
-    const std::chrono::milliseconds& timeout) {
+void TCPStore::setReceiveTimeout_(const std::chrono::milliseconds& timeout) {
   // Set the socket timeout if there is a wait timeout
   if (timeout != kNoTimeout) {
 #ifdef _WIN32
@@ -575,6 +829,12 @@ void TCPStore::waitHelper_(
         reinterpret_cast<char*>(&timeoutTV),
         sizeof(timeoutTV)));
   }
+}
+
+void TCPStore::waitHelper_(
+    const std::vector<std::string>& keys,
+    const std::chrono::milliseconds& timeout) {
+  setReceiveTimeout_(timeout);
   tcputil::sendValue<QueryType>(storeSocket_, QueryType::WAIT);
   SizeType nkeys = keys.size();
   tcputil::sendBytes<SizeType>(storeSocket_, &nkeys, 1, (nkeys > 0));
@@ -587,6 +847,20 @@ void TCPStore::waitHelper_(
   }
 }
 
+void TCPStore::waitCountHelper_(
+    const std::string& key,
+    int64_t count,
+    const std::chrono::milliseconds& timeout) {
+  setReceiveTimeout_(timeout);
+  tcputil::sendValue<QueryType>(storeSocket_, QueryType::WAIT_COUNT);
+  tcputil::sendString(storeSocket_, key, true);
+  tcputil::sendValue<int64_t>(storeSocket_, count);
+  auto waitResponse = tcputil::recvValue<WaitResponseType>(storeSocket_);
+  if (waitResponse != WaitResponseType::STOP_WAITING) {
+    throw std::runtime_error("Stop_waiting response is expected");
+  }
+}
+
 const std::string& TCPStore::getHost() const noexcept {
   return tcpStoreAddr_;
 }
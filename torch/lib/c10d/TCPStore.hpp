@@ -1,6 +1,9 @@
 #pragma once
 
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <unordered_map>
 
@@ -27,6 +30,8 @@ class TCPStoreDaemon {
 
   void queryFds(std::vector<struct pollfd>& fds);
   void query(int socket);
+  // Closes the socket of a client and removes all its tracking state.
+  void closeSocket(int socket);
 
   void setHandler(int socket);
   void compareSetHandler(int socket);
@@ -36,9 +41,13 @@ class TCPStoreDaemon {
   void getNumKeysHandler(int socket) const;
   void deleteHandler(int socket);
   void waitHandler(int socket);
+  void multiGetHandler(int socket) const;
+  void multiSetHandler(int socket);
+  void waitCountHandler(int socket);
 
   bool checkKeys(const std::vector<std::string>& keys) const;
   void wakeupWaitingClients(const std::string& key);
+  void wakeupCountWaitingClients(const std::string& key, int64_t count);
 
   void initStopSignal();
   void closeStopSignal();
@@ -49,9 +58,31 @@ class TCPStoreDaemon {
   std::unordered_map<std::string, std::vector<int>> waitingSockets_;
   // From socket -> number of keys awaited
   std::unordered_map<int, size_t> keysAwaited_;
+  // From counter key -> the list of (count, socket) waiting on it to reach
+  // count
+  std::unordered_map<std::string, std::vector<std::pair<int64_t, int>>>
+      countWaitingSockets_;
+  // Guards the store and the tracking state above, as well as sockets_,
+  // since queries are handled concurrently on Linux.
+  mutable std::mutex storeMutex_;
 
   std::vector<int> sockets_;
   int storeListenSocket_;
+#ifdef __linux__
+  // On Linux the daemon thread only waits for socket events with epoll, and
+  // hands the sockets that are ready to a pool of handler threads. Every
+  // client socket is registered with EPOLLONESHOT, so that its queries are
+  // handled by one thread at a time and in order, and it is re-armed once
+  // its query has been handled.
+  void handlerLoop();
+
+  int epollFd_ = -1;
+  std::vector<std::thread> handlerThreads_;
+  std::deque<int> readySockets_;
+  std::mutex readySocketsMutex_;
+  std::condition_variable readySocketsCV_;
+  bool stopHandlers_ = false;
+#endif
 #ifdef _WIN32
   const std::chrono::milliseconds checkTimeout_
       = std::chrono::milliseconds(10);
@@ -99,6 +130,16 @@ class TCPStore : public Store {
   // Waits for all workers to join.
   void waitForWorkers();
 
+  // Retrieves the values of several keys in a single round trip, waiting for
+  // all of them to be set.
+  std::vector<std::vector<uint8_t>> multiGet(
+      const std::vector<std::string>& keys);
+
+  // Sets several key-value pairs with a single query.
+  void multiSet(
+      const std::vector<std::string>& keys,
+      const std::vector<std::vector<uint8_t>>& values);
+
   // Returns the hostname used by the TCPStore.
   const std::string& getHost() const noexcept;
 
@@ -111,6 +152,12 @@ class TCPStore : public Store {
   void waitHelper_(
       const std::vector<std::string>& keys,
       const std::chrono::milliseconds& timeout);
+  // Waits until the counter stored under key reaches count.
+  void waitCountHelper_(
+      const std::string& key,
+      int64_t count,
+      const std::chrono::milliseconds& timeout);
+  void setReceiveTimeout_(const std::chrono::milliseconds& timeout);
 
   bool isServer_;
   int storeSocket_ = -1;
@@ -27,6 +27,11 @@ struct BroadcastOptions {
 struct AllreduceOptions {
   ReduceOp reduceOp = ReduceOp::SUM;
   std::chrono::milliseconds timeout = kUnsetTimeout;
+  // Hint that the allreduce is on the critical path, e.g. a gradient bucket
+  // reduced during backward. ProcessGroupNCCL can run such allreduces ahead
+  // of the other collectives, see
+  // `ProcessGroupNCCL::Options::priorityAllreduce`. Ignored otherwise.
+  bool highPriority = false;
 };
 
 struct AllreduceCoalescedOptions : AllreduceOptions {};
@@ -2,13 +2,17 @@
 
 #include <c10d/comm.hpp>
 #include <c10d/ProcessGroup.hpp>
+#include <ATen/CPUGeneratorImpl.h>
+#include <ATen/core/functional.h>
 #include <torch/torch.h>
 
 namespace c10d {
 
 c10::intrusive_ptr<c10::ivalue::Future> AllReduceCommHook::runHook(
     GradBucket& bucket) {
-  auto allreduce_work = state_->allreduce(bucket.getTensorsRef());
+  AllreduceOptions opts;
+  opts.highPriority = true;
+  auto allreduce_work = state_->allreduce(bucket.getTensorsRef(), opts);
 
   auto div_by_process_group_size = [allreduce_work, this]() {
     auto tensor = allreduce_work->result()[0] / state_->getSize();
@@ -25,7 +29,9 @@ c10::intrusive_ptr<c10::ivalue::Future> FP16CompressCommHook::runHook(
   for (auto& tensor : tensors) {
     tensor.copy_(tensor.to(torch::kFloat16));
   }
-  auto allreduce_work = state_->allreduce(tensors);
+  AllreduceOptions opts;
+  opts.highPriority = true;
+  auto allreduce_work = state_->allreduce(tensors, opts);
 
   auto decompress_and_div_by_process_group_size = [allreduce_work, this]() {
     auto tensor = allreduce_work->result()[0];
@@ -38,4 +44,332 @@ c10::intrusive_ptr<c10::ivalue::Future> FP16CompressCommHook::runHook(
       decompress_and_div_by_process_group_size, fut->elementType());
 }
 
+namespace {
+
+// Applies Gram-Schmidt procedure to orthogonalize the columns of a 2D tensor
+// in place. See `_orthogonalize` in the Python PowerSGD hook.
+void orthogonalize(at::Tensor& matrix, double epsilon = 1e-8) {
+  const auto num_cols = matrix.size(1);
+  for (int64_t i = 0; i < num_cols; ++i) {
+    // Normalize the i'th column. The epsilon avoids a division by zero that
+    // may be caused by vanishing gradients.
+    auto col = matrix.narrow(1, i, 1);
+    col.div_(col.norm() + epsilon);
+    // Project it on the rest and remove it.
+    if (i + 1 < num_cols) {
+      auto rest = matrix.narrow(1, i + 1, num_cols - i - 1);
+      rest.sub_(at::sum(col * rest, 0) * col);
+    }
+  }
+}
+
+// Whether a 2D tensor of size (num_rows, num_cols) is worth compressing, i.e.,
+// (num_rows + num_cols) * rank * min_compression_rate < num_rows * num_cols.
+bool shouldCompress(
+    int64_t num_rows,
+    int64_t num_cols,
+    int64_t matrix_approximation_rank,
+    double min_compression_rate) {
+  return (num_rows + num_cols) * matrix_approximation_rank *
+      min_compression_rate <
+      num_rows * num_cols;
+}
+
+c10::intrusive_ptr<c10::ivalue::Future> allreduceAndDivide(
+    ProcessGroup* process_group,
+    std::vector<at::Tensor>& tensors) {
+  auto allreduce_work = process_group->allreduce(tensors);
+  auto div_by_process_group_size = [allreduce_work, process_group]() {
+    auto tensor = allreduce_work->result()[0] / process_group->getSize();
+    return c10::IValue(tensor);
+  };
+  auto fut = allreduce_work->getFuture();
+  return fut->then(div_by_process_group_size, fut->elementType());
+}
+
+} // namespace
+
+PowerSGDState::PowerSGDState(
+    ProcessGroup* process_group,
+    const BuiltinCommHookOptions& options)
+    : process_group(process_group),
+      matrix_approximation_rank(options.matrix_approximation_rank),
+      start_powerSGD_iter(options.start_powerSGD_iter),
+      min_compression_rate(options.min_compression_rate),
+      use_error_feedback(options.use_error_feedback),
+      warm_start(options.warm_start),
+      rng(at::make_generator<at::CPUGeneratorImpl>(options.random_seed)) {
+  // DDP rebuilds its buckets after the first iteration, which would
+  // invalidate any per-bucket tensor remembered before that.
+  TORCH_CHECK(
+      !(use_error_feedback || warm_start) || start_powerSGD_iter > 1,
+      "Expect `start_powerSGD_iter` > 1 if `use_error_feedback` or `warm_start` is enabled, "
+      "because PowerSGD can only be applied after the first two iterations in DDP.");
+  TORCH_CHECK(
+      matrix_approximation_rank > 0,
+      "Expect `matrix_approximation_rank` > 0, but got ",
+      matrix_approximation_rank);
+  LOG(INFO) << "PowerSGD config: matrix_approximation_rank = "
+            << matrix_approximation_rank
+            << "; start_powerSGD_iter = " << start_powerSGD_iter
+            << "; min_compression_rate = " << min_compression_rate
+            << "; use_error_feedback = " << use_error_feedback
+            << "; warm_start = " << warm_start << ";";
+}
+
+void PowerSGDState::maybeIncreaseIter(const GradBucket& bucket) {
+  if (bucket.isTheLastBucketToAllreduce()) {
+    ++iter;
+    if (iter == start_powerSGD_iter) {
+      LOG(INFO) << "Start to apply PowerSGD after " << iter << " iterations.";
+    }
+  }
+}
+
+c10::intrusive_ptr<c10::ivalue::Future> PowerSGDCommHook::runHook(
+    GradBucket& bucket) {
+  auto& state = state_;
+  auto process_group = state.process_group;
+
+  // Run vanilla allreduce in the first `start_powerSGD_iter` iterations.
+  if (state.iter < state.start_powerSGD_iter) {
+    state.maybeIncreaseIter(bucket);
+    return allreduceAndDivide(process_group, bucket.getTensorsRef());
+  }
+
+  // The input tensor is a flattened 1D tensor.
+  auto input_tensor = bucket.getTensors()[0];
+  const auto bucket_index = bucket.getIndex();
+  const auto options = input_tensor.options();
+
+  // Incorporate the error from the previous state into the gradients, and keep
+  // a copy of the input to compute the local error caused by compression.
+  at::Tensor input_tensor_cp;
+  if (state.use_error_feedback) {
+    auto it = state.error_dict.find(bucket_index);
+    if (it != state.error_dict.end()) {
+      input_tensor.add_(it->second);
+    } else {
+      LOG(INFO) << "A zero tensor of length " << input_tensor.numel()
+                << " that represents local error is created.";
+      state.error_dict[bucket_index] = at::zeros_like(input_tensor);
+    }
+    input_tensor_cp = input_tensor.clone();
+  }
+
+  // Step I: Divide the per-parameter tensors into the ones that are compressed
+  // before allreduce and the ones that are directly allreduced.
+  std::vector<at::Tensor> tensors_to_compress;
+  std::vector<at::Tensor> uncompressed_tensors;
+  int64_t total_ps_size = 0;
+  int64_t total_qs_size = 0;
+  for (const auto& tensor : bucket.getPerParameterTensors()) {
+    auto matrix = tensor.view({tensor.dim() > 0 ? tensor.size(0) : 1, -1});
+    const auto n = matrix.size(0);
+    const auto m = matrix.size(1);
+    const auto rank =
+        std::min(std::min(n, m), state.matrix_approximation_rank);
+    if (shouldCompress(n, m, rank, state.min_compression_rate)) {
+      tensors_to_compress.push_back(matrix);
+      total_ps_size += n * rank;
+      total_qs_size += m * rank;
+    } else {
+      uncompressed_tensors.push_back(tensor);
+    }
+  }
+
+  // Step II: Allocate contiguous memory for the uncompressed tensors to
+  // allreduce them efficiently.
+  std::vector<at::Tensor> uncompressed_tensors_memory = {
+      uncompressed_tensors.empty()
+          ? at::empty({0}, options)
+          : at::cat(c10::fmap(
+                uncompressed_tensors,
+                [](const at::Tensor& tensor) { return tensor.view(-1); }))};
+
+  // Step III: Allocate contiguous memory for Ps and Qs. If warm start is
+  // enabled, reuse Ps and Qs from the previous iteration if possible.
+  bool need_randomize_qs = false;
+  if (!state.warm_start || state.p_memory_dict.count(bucket_index) == 0) {
+    need_randomize_qs = true;
+    if (state.warm_start) {
+      LOG(INFO) << "Allocating contiguous memory of length " << total_ps_size
+                << " for Ps, and of length " << total_qs_size
+                << " for Qs, respectively.";
+    }
+    state.p_memory_dict[bucket_index] = at::empty({total_ps_size}, options);
+    state.q_memory_dict[bucket_index] = at::empty({total_qs_size}, options);
+  }
+  auto p_memory = state.p_memory_dict[bucket_index];
+  auto q_memory = state.q_memory_dict[bucket_index];
+
+  // Create Ps and Qs that point to the allocated memory.
+  std::vector<at::Tensor> ps;
+  std::vector<at::Tensor> qs;
+  ps.reserve(tensors_to_compress.size());
+  qs.reserve(tensors_to_compress.size());
+  int64_t p_idx = 0;
+  int64_t q_idx = 0;
+  for (const auto& tensor : tensors_to_compress) {
+    const auto n = tensor.size(0);
+    const auto m = tensor.size(1);
+    const auto rank =
+        std::min(std::min(n, m), state.matrix_approximation_rank);
+    ps.push_back(p_memory.narrow(0, p_idx, n * rank).view({n, rank}));
+    qs.push_back(q_memory.narrow(0, q_idx, m * rank).view({m, rank}));
+    p_idx += n * rank;
+    q_idx += m * rank;
+  }
+
+  // Reuse Qs from the previous iteration if possible. Otherwise fill them with
+  // random values drawn on CPU, which is much cheaper than forking the RNG
+  // state of the devices and gives the same projection on every replica.
+  for (auto& q : qs) {
+    if (need_randomize_qs) {
+      q.copy_(at::randn(q.sizes(), state.rng, options.device(at::kCPU)));
+    }
+    orthogonalize(q);
+  }
+
+  // Compute Ps.
+  for (size_t i = 0; i < tensors_to_compress.size(); ++i) {
+    at::matmul_out(ps[i], tensors_to_compress[i], qs[i]);
+  }
+
+  // This allreduce is only applied to the uncompressed tensors, so kick it off
+  // before waiting on the allreduce of Ps to hide some of its cost.
+  auto allreduce_uncompressed_work =
+      process_group->allreduce(uncompressed_tensors_memory);
+  std::vector<at::Tensor> p_memory_list = {p_memory};
+  auto allreduce_ps_work = process_group->allreduce(p_memory_list);
+
+  auto compress_and_decompress = [this,
+                                  process_group,
+                                  bucket_index,
+                                  input_tensor,
+                                  input_tensor_cp,
+                                  uncompressed_tensors,
+                                  tensors_to_compress,
+                                  ps,
+                                  qs,
+                                  p_memory,
+                                  q_memory,
+                                  allreduce_uncompressed_work,
+                                  allreduce_ps_work,
+                                  last_bucket =
+                                      bucket.isTheLastBucketToAllreduce()]() mutable {
+    auto& state = state_;
+    const auto world_size = process_group->getSize();
+
+    // Unpack the uncompressed tensors.
+    auto uncompressed_memory =
+        allreduce_uncompressed_work->result()[0].div_(world_size);
+    int64_t idx = 0;
+    for (const auto& tensor : uncompressed_tensors) {
+      tensor.copy_(
+          uncompressed_memory.narrow(0, idx, tensor.numel()).view_as(tensor));
+      idx += tensor.numel();
+    }
+
+    // Since these Ps will be orthogonalized, no need to divide them by world
+    // size.
+    allreduce_ps_work->wait();
+    for (auto& p : ps) {
+      orthogonalize(p);
+    }
+
+    // Compute and allreduce Qs.
+    for (size_t i = 0; i < tensors_to_compress.size(); ++i) {
+      at::matmul_out(qs[i], tensors_to_compress[i].t(), ps[i]);
+    }
+    std::vector<at::Tensor> q_memory_list = {q_memory};
+    process_group->allreduce(q_memory_list)->wait();
+    q_memory.div_(world_size);
+
+    // Decompress.
+    for (size_t i = 0; i < tensors_to_compress.size(); ++i) {
+      at::matmul_out(tensors_to_compress[i], ps[i], qs[i].t());
+    }
+
+    if (state.use_error_feedback) {
+      // Memorize the local errors.
+      state.error_dict[bucket_index] = input_tensor_cp - input_tensor;
+    }
+    if (!state.warm_start) {
+      state.p_memory_dict.clear();
+      state.q_memory_dict.clear();
+    }
+    if (last_bucket) {
+      ++state.iter;
+    }
+    return c10::IValue(input_tensor);
+  };
+
+  auto fut = allreduce_uncompressed_work->getFuture();
+  return fut->then(compress_and_decompress, fut->elementType());
+}
+
+c10::intrusive_ptr<c10::ivalue::Future> TopKCompressCommHook::runHook(
+    GradBucket& bucket) {
+  auto& state = state_;
+  auto process_group = state.process_group;
+  auto input_tensor = bucket.getTensors()[0];
+  const auto bucket_index = bucket.getIndex();
+
+  // Incorporate the error from the previous iteration. The error is dropped if
+  // the bucket has changed its size, e.g., because DDP rebuilt the buckets.
+  auto it = state.error_dict.find(bucket_index);
+  if (it != state.error_dict.end() &&
+      it->second.numel() == input_tensor.numel()) {
+    input_tensor.add_(it->second);
+  }
+
+  const auto numel = input_tensor.numel();
+  const auto k = std::min<int64_t>(
+      numel,
+      std::max<int64_t>(1, static_cast<int64_t>(numel * state.compress_ratio)));
+  auto indices = std::get<1>(
+      input_tensor.abs().topk(k, /*dim=*/0, /*largest=*/true, /*sorted=*/false));
+  auto values = input_tensor.index_select(0, indices);
+
+  // Everything that is not sent becomes the local error of this iteration.
+  state.error_dict[bucket_index] = input_tensor.index_fill(0, indices, 0);
+
+  // All of the replicas send the same number of elements, so the values and
+  // the indices can simply be allgathered.
+  const auto world_size = process_group->getSize();
+  std::vector<at::Tensor> values_list = {values};
+  std::vector<at::Tensor> indices_list = {indices};
+  std::vector<std::vector<at::Tensor>> gathered_values = {
+      std::vector<at::Tensor>(world_size)};
+  std::vector<std::vector<at::Tensor>> gathered_indices = {
+      std::vector<at::Tensor>(world_size)};
+  for (int i = 0; i < world_size; ++i) {
+    gathered_values[0][i] = at::empty_like(values);
+    gathered_indices[0][i] = at::empty_like(indices);
+  }
+  auto allgather_indices_work =
+      process_group->allgather(gathered_indices, indices_list);
+  auto allgather_values_work =
+      process_group->allgather(gathered_values, values_list);
+
+  auto decompress = [input_tensor,
+                     world_size,
+                     gathered_values,
+                     gathered_indices,
+                     allgather_indices_work,
+                     allgather_values_work]() {
+    allgather_indices_work->wait();
+    allgather_values_work->wait();
+    input_tensor.zero_();
+    input_tensor.index_add_(
+        0, at::cat(gathered_indices[0]), at::cat(gathered_values[0]));
+    input_tensor.div_(world_size);
+    return c10::IValue(input_tensor);
+  };
+
+  auto fut = allgather_values_work->getFuture();
+  return fut->then(decompress, fut->elementType());
+}
+
 } // namespace c10d
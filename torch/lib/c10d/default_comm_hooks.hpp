@@ -3,11 +3,34 @@
 #include <c10d/comm.hpp>
 #include <c10d/ProcessGroup.hpp>
 
+#include <unordered_map>
+
 namespace c10d {
 
 enum class BuiltinCommHookType {
   ALLREDUCE = 1,
   FP16_COMPRESS = 2,
+  POWER_SGD = 3,
+  TOPK_COMPRESS = 4,
+};
+
+// Hyperparameters of the built-in compression hooks. The fields that do not
+// apply to the registered hook type are ignored.
+struct BuiltinCommHookOptions {
+  // POWER_SGD. See `PowerSGDState` in
+  // torch/distributed/algorithms/ddp_comm_hooks/powerSGD_hook.py for what these
+  // hyperparameters mean and how to tune them.
+  int64_t matrix_approximation_rank = 1;
+  int64_t start_powerSGD_iter = 10;
+  double min_compression_rate = 2;
+  bool use_error_feedback = true;
+  bool warm_start = true;
+  int64_t random_seed = 0;
+
+  // TOPK_COMPRESS. The fraction of the elements of each bucket that are
+  // communicated. The rest are kept locally as error feedback and added to the
+  // bucket in the next iteration.
+  double compress_ratio = 0.01;
 };
 
 class AllReduceCommHook : public CppCommHookInterface<ProcessGroup*> {
@@ -30,4 +53,68 @@ class FP16CompressCommHook : public CppCommHookInterface<ProcessGroup*> {
   c10::intrusive_ptr<c10::ivalue::Future> runHook(GradBucket& bucket) override;
 };
 
+// The C++ counterpart of `PowerSGDState` in the Python PowerSGD hook. The
+// internal state is keyed by bucket index, because a single state instance is
+// shared by all of the buckets.
+struct PowerSGDState {
+  PowerSGDState(
+      ProcessGroup* process_group,
+      const BuiltinCommHookOptions& options);
+
+  // Increases `iter` once per iteration, i.e., after bucket 0 that is the last
+  // bucket to allreduce in an iteration.
+  void maybeIncreaseIter(const GradBucket& bucket);
+
+  ProcessGroup* process_group; // Not owned.
+  int64_t matrix_approximation_rank;
+  int64_t start_powerSGD_iter;
+  double min_compression_rate;
+  bool use_error_feedback;
+  bool warm_start;
+
+  // Used for initializing Qs. It is seeded identically on every replica so
+  // that all of the replicas use the same random projection at every step.
+  at::Generator rng;
+  std::unordered_map<size_t, at::Tensor> error_dict;
+  std::unordered_map<size_t, at::Tensor> p_memory_dict;
+  std::unordered_map<size_t, at::Tensor> q_memory_dict;
+  int64_t iter = 0;
+};
+
+// Implements the same algorithm as `powerSGD_hook` in
+// torch/distributed/algorithms/ddp_comm_hooks/powerSGD_hook.py. Every
+// per-parameter tensor M that is worth compressing is approximated by P Q^T
+// with low-rank P and Q, and only Ps and Qs are allreduced. The rest of the
+// tensors are allreduced as a batch without compression.
+class PowerSGDCommHook : public CppCommHookInterface<PowerSGDState> {
+ public:
+  explicit PowerSGDCommHook(PowerSGDState state)
+      : CppCommHookInterface<PowerSGDState>(state) {}
+
+  ~PowerSGDCommHook() override {}
+
+  c10::intrusive_ptr<c10::ivalue::Future> runHook(GradBucket& bucket) override;
+};
+
+struct TopKCompressState {
+  ProcessGroup* process_group; // Not owned.
+  double compress_ratio;
+  // The local errors of the last iteration, keyed by bucket index.
+  std::unordered_map<size_t, at::Tensor> error_dict;
+};
+
+// Top-k sparsification with error feedback: every replica only communicates
+// the `compress_ratio` fraction of its bucket elements with the largest
+// magnitude, as (value, index) pairs gathered from all of the replicas. The
+// elements that were not sent are carried over to the next iteration.
+class TopKCompressCommHook : public CppCommHookInterface<TopKCompressState> {
+ public:
+  explicit TopKCompressCommHook(TopKCompressState state)
+      : CppCommHookInterface<TopKCompressState>(state) {}
+
+  ~TopKCompressCommHook() override {}
+
+  c10::intrusive_ptr<c10::ivalue::Future> runHook(GradBucket& bucket) override;
+};
+
 } // namespace c10d
@@ -173,6 +173,19 @@ void Logger::calculate_avg_gpu_time(
 void Logger::set_runtime_stats_and_log() {
   // Sync with reducer's data
   std::lock_guard<std::mutex> lock(reducer_->mutex_);
+  // Log the bucket layout once bucket size autotuning has locked it in.
+  if (reducer_->bucket_autotuning_.chosen_bucket_bytes_cap > 0 &&
+      ddp_logging_data_->autotuned_bucket_cap_mb < 0) {
+    ddp_logging_data_->autotuned_bucket_cap_mb =
+        (float)reducer_->bucket_autotuning_.chosen_bucket_bytes_cap /
+        (1024 * 1024);
+    ddp_logging_data_->rebuilt_bucket_sizes = get_bucket_sizes();
+    LOG(INFO) << "[Rank " << ddp_logging_data_->rank
+              << "]: DDP bucket size autotuning chose bucket_cap_mb = "
+              << ddp_logging_data_->autotuned_bucket_cap_mb << " with "
+              << ddp_logging_data_->rebuilt_bucket_sizes.size() << " buckets.";
+    LogPyTorchDDPUsage(*ddp_logging_data_);
+  }
   // Set runtime stats at the sampling iterations.
   if (!reducer_->should_collect_runtime_stats()) {
     return;
@@ -451,20 +451,23 @@ void Reducer::autograd_hook(VariableIndex index) {
   // rebuilt_params_ and rebuilt_param_indices_, and then will be broadcasted
   // and initialized. Also we only need to dump tensors and parameter indices of
   // one replica.
-  push_rebuilt_params(index);
 
   // If `find_unused_parameters_` is true there may be model parameters that
   // went unused when computing the model output, they won't be part of the
   // autograd graph, and won't receive gradients. These parameters are
   // discovered in the `prepare_for_backward` function and their indexes stored
-  // in the `unused_parameters_` vector.
+  // in the `unused_parameters_` vector. With a static graph, they are ready
+  // first and go to the front of the rebuilt buckets.
   if (!has_marked_unused_parameters_ && find_unused_parameters_) {
     has_marked_unused_parameters_ = true;
     for (const auto& unused_index : unused_parameters_) {
+      push_rebuilt_params(unused_index);
       mark_variable_ready(unused_index);
     }
   }
 
+  push_rebuilt_params(index);
+
   // Finally mark variable for which this function was originally called.
   mark_variable_ready(index);
 }
@@ -624,8 +627,24 @@ void Reducer::mark_bucket_ready(size_t bucket_index) {
     // See Note [DDP Communication Hook]
     // TODO(@sinannasir): merge `work` and `future_work`. Related to GH Issue
     // #41266.
-    if (comm_hook_ == nullptr) {
-      bucket.work = process_group_->allreduce(tensors);
+    if (comm_hook_ == nullptr && shard_gradients_) {
+      // Every rank only receives the reduced gradients of its own shard.
+      const auto world_size = process_group_->getSize();
+      std::vector<std::vector<at::Tensor>> inputs(1);
+      inputs[0].reserve(world_size);
+      for (int rank = 0; rank < world_size; ++rank) {
+        const auto range = get_bucket_shard_range(bucket, rank);
+        inputs[0].push_back(
+            tensors[0].narrow(0, range.first, range.second));
+      }
+      std::vector<at::Tensor> outputs = {
+          inputs[0][process_group_->getRank()]};
+      bucket.work = process_group_->reduce_scatter(outputs, inputs);
+    } else if (comm_hook_ == nullptr) {
+      // Gradient buckets are on the critical path of the iteration.
+      AllreduceOptions opts;
+      opts.highPriority = true;
+      bucket.work = process_group_->allreduce(tensors, opts);
     } else {
       GradBucket grad_bucket(
           next_bucket_,
@@ -936,6 +955,12 @@ void Reducer::prepare_for_backward(
     return;
   }
 
+  // A static graph uses the same parameters as in the first iteration.
+  if (static_graph_ && has_static_unused_parameters_) {
+    unused_parameters_ = static_unused_parameters_;
+    return;
+  }
+
   // Seed queue with the grad functions of all outputs.
   for (const auto& output : outputs) {
     const auto& grad_fn = output.grad_fn();
@@ -970,6 +995,11 @@ void Reducer::prepare_for_backward(
     }
   }
 
+  if (static_graph_) {
+    static_unused_parameters_ = unused_parameters_;
+    has_static_unused_parameters_ = true;
+  }
+
   // Warn user about unnecessary perf hit if all parameters were used in forward.
   if (unused_parameters_.empty()) {
     TORCH_WARN_ONCE(
@@ -1145,6 +1175,16 @@ void Reducer::finalize_backward() {
           "Expected bucket.work not to be null. "
           "This may indicate that allreduce hooks were not properly installed.");
       bucket.work->wait();
+      if (shard_gradients_) {
+        // Zero the gradients outside of this rank's shard, which still hold
+        // the local gradients.
+        auto& contents = bucket.replicas[0].contents;
+        const auto range =
+            get_bucket_shard_range(bucket, process_group_->getRank());
+        const auto shard_end = range.first + range.second;
+        contents.narrow(0, 0, range.first).zero_();
+        contents.narrow(0, shard_end, contents.numel() - shard_end).zero_();
+      }
     } else {
       TORCH_INTERNAL_ASSERT(
           bucket.future_work,
@@ -1195,6 +1235,9 @@ void Reducer::finalize_backward() {
   if (should_collect_runtime_stats()) {
     record_backward_comm_end_time();
   }
+  if (bucket_autotuning_.in_progress) {
+    bucket_autotuning_.sample_ready = true;
+  }
 }
 
 void Reducer::runGradCallbackForVariable(
@@ -1303,6 +1346,9 @@ bool Reducer::rebuild_buckets() {
   // exception below.
   ensure_prior_reduction_finished();
   std::lock_guard<std::mutex> lock(mutex_);
+  if (bucket_autotuning_.in_progress) {
+    return autotune_buckets();
+  }
   if (!should_rebuild_buckets() || rebuilt_params_.empty()) {
     return false;
   }
@@ -1322,27 +1368,225 @@ bool Reducer::rebuild_buckets() {
           replicas_[0].size(),
           " versus rebuilt params size of: ",
           rebuilt_param_indices_.size()));
+  has_rebuilt_bucket_ = true;
+  if (!bucket_autotuning_.candidates.empty()) {
+    // Keep the ready order around, as every candidate is built from it.
+    auto& state = bucket_autotuning_;
+    state.params = std::move(rebuilt_params_);
+    state.param_indices = std::move(rebuilt_param_indices_);
+    state.in_progress = true;
+    rebuild_buckets_by_size(
+        state.params, state.param_indices, state.candidates[state.current]);
+  } else {
+    rebuild_buckets_by_size(
+        rebuilt_params_, rebuilt_param_indices_, bucket_bytes_cap_);
+  }
+  rebuilt_params_.clear();
+  rebuilt_param_indices_.clear();
+  return true;
+}
+
+void Reducer::rebuild_buckets_by_size(
+    const std::vector<at::Tensor>& params,
+    const std::vector<int64_t>& param_indices,
+    int64_t bucket_bytes_cap) {
   std::vector<std::vector<size_t>> rebuilt_bucket_indices;
   std::vector<size_t> bucket_size_limits;
   bucket_size_limits.push_back(kDefaultFirstBucketBytes);
-  bucket_size_limits.push_back(bucket_bytes_cap_);
+  bucket_size_limits.push_back(bucket_bytes_cap);
   rebuilt_bucket_indices = compute_bucket_assignment_by_size(
-      rebuilt_params_,
-      bucket_size_limits,
-      expect_sparse_gradients_[0],
-      rebuilt_param_indices_);
+      params, bucket_size_limits, expect_sparse_gradients_[0], param_indices);
 
   // For rebuilt bucket indices, it needs to be synced across all ranks.
   // Broadcast the newly rebuilt bucket indices from rank 0 in default.
   // After syncing up rebuilt bucket indices, initialize buckets for reducer.
   sync_bucket_indices(rebuilt_bucket_indices);
 
-  has_rebuilt_bucket_ = true;
-  rebuilt_params_.clear();
-  rebuilt_param_indices_.clear();
-
   initialize_buckets(std::move(rebuilt_bucket_indices));
-  return true;
+}
+
+void Reducer::set_bucket_bytes_cap_autotuning(
+    std::vector<int64_t> bucket_bytes_cap_candidates,
+    int64_t iterations_per_candidate) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  TORCH_CHECK(
+      num_iterations_ == 0,
+      "Bucket size autotuning must be enabled before the first iteration.");
+  TORCH_CHECK(
+      !find_unused_parameters_,
+      "Bucket size autotuning is not supported with find_unused_parameters=True, "
+      "because buckets are never rebuilt in that case.");
+  TORCH_CHECK(
+      !bucket_bytes_cap_candidates.empty(),
+      "Expect at least one bucket size cap candidate.");
+  TORCH_CHECK(
+      iterations_per_candidate > 0,
+      "Expect `iterations_per_candidate` > 0, but got ",
+      iterations_per_candidate);
+  for (const auto cap : bucket_bytes_cap_candidates) {
+    TORCH_CHECK(cap > 0, "Expect positive bucket size caps, but got ", cap);
+  }
+
+  auto& state = bucket_autotuning_;
+  state = BucketAutotuningState();
+  state.candidates = std::move(bucket_bytes_cap_candidates);
+  state.iterations_per_candidate = iterations_per_candidate;
+  state.exposed_comm_times.assign(state.candidates.size(), 0);
+}
+
+bool Reducer::autotune_buckets() {
+  auto& state = bucket_autotuning_;
+  // Only the iterations that reduced gradients are measured, e.g., the ones
+  // under no_sync are skipped.
+  if (!state.sample_ready) {
+    return false;
+  }
+  state.sample_ready = false;
+  state.exposed_comm_times[state.current] += get_last_exposed_comm_time();
+  if (++state.iterations_recorded < state.iterations_per_candidate) {
+    return false;
+  }
+
+  state.iterations_recorded = 0;
+  if (++state.current < state.candidates.size()) {
+    rebuild_buckets_by_size(
+        state.params, state.param_indices, state.candidates[state.current]);
+    return true;
+  }
+
+  // All of the candidates have been tried. Sum up the measurements of all the
+  // ranks, so that every rank locks in the same candidate.
+  const auto num_candidates = static_cast<int64_t>(state.candidates.size());
+  auto times_tensor = at::empty({num_candidates}, at::kLong);
+  auto times_accessor = times_tensor.accessor<int64_t, 1>();
+  for (int64_t i = 0; i < num_candidates; i++) {
+    times_accessor[i] = state.exposed_comm_times[i];
+  }
+  // Copy CPU tensor to device tensor, as the process_group_ could be NCCL.
+  auto times_tensor_device = at::empty(
+      {num_candidates},
+      at::TensorOptions().dtype(at::kLong).device(replicas_[0][0].device()));
+  times_tensor_device.copy_(times_tensor, /*non_blocking=*/true);
+  std::vector<at::Tensor> times_tensor_list = {times_tensor_device};
+  process_group_->allreduce(times_tensor_list)->wait();
+  times_tensor.copy_(times_tensor_list.front(), /*non_blocking=*/false);
+
+  size_t best = 0;
+  for (size_t i = 0; i < state.candidates.size(); i++) {
+    state.exposed_comm_times[i] = times_accessor[i];
+    if (state.exposed_comm_times[i] < state.exposed_comm_times[best]) {
+      best = i;
+    }
+  }
+  state.in_progress = false;
+  state.chosen_bucket_bytes_cap = state.candidates[best];
+  LOG(INFO) << "Bucket size autotuning locked in bucket_cap_mb = "
+            << (float)state.chosen_bucket_bytes_cap / (1024 * 1024)
+            << " out of " << num_candidates << " candidates.";
+
+  // The buckets are already built with the last candidate.
+  const bool rebuilt = best + 1 != state.candidates.size();
+  if (rebuilt) {
+    rebuild_buckets_by_size(
+        state.params, state.param_indices, state.chosen_bucket_bytes_cap);
+  }
+  state.params.clear();
+  state.param_indices.clear();
+  return rebuilt;
+}
+
+int64_t Reducer::get_last_exposed_comm_time() {
+  int64_t exposed_comm_time = 0;
+  if (replicas_[0][0].is_cuda()) {
+#ifdef USE_CUDA
+    // Events are only recorded for single process single device and single
+    // device module.
+    if (replicas_.size() == 1 && !is_multi_device_module_ &&
+        gpu_timer_.backward_compute_end.isCreated() &&
+        gpu_timer_.backward_comm_end.isCreated()) {
+      at::DeviceGuard g(replicas_[0][0].device());
+      gpu_timer_.backward_comm_end.synchronize();
+      // elapsed_time is in milliseconds.
+      exposed_comm_time = int64_t(
+          gpu_timer_.backward_compute_end.elapsed_time(
+              gpu_timer_.backward_comm_end) *
+          1000000);
+    }
+#endif
+  } else {
+    exposed_comm_time =
+        cpu_timer_.backward_comm_end_time - cpu_timer_.backward_compute_end_time;
+  }
+  return std::max<int64_t>(exposed_comm_time, 0);
+}
+
+void Reducer::set_gradient_sharding(bool enabled) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (enabled) {
+    TORCH_CHECK(
+        num_iterations_ == 0,
+        "Gradient sharding must be enabled before the first iteration.");
+    TORCH_CHECK(
+        comm_hook_ == nullptr,
+        "Gradient sharding cannot be combined with a communication hook.");
+    TORCH_CHECK(
+        replicas_.size() == 1,
+        "Gradient sharding does not support single-process multiple-device mode.");
+    for (const auto& bucket : buckets_) {
+      TORCH_CHECK(
+          !bucket.expect_sparse_gradient,
+          "Gradient sharding does not support sparse gradients.");
+    }
+  }
+  shard_gradients_ = enabled;
+}
+
+void Reducer::set_static_graph() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  TORCH_CHECK(
+      num_iterations_ == 0,
+      "Static graph must be set before the first iteration.");
+  static_graph_ = true;
+}
+
+std::pair<int64_t, int64_t> Reducer::get_bucket_shard_range(
+    const Bucket& bucket,
+    int rank) const {
+  // Balance the shards so that their sizes differ by at most one element.
+  const auto numel = bucket.replicas[0].contents.numel();
+  const auto world_size = process_group_->getSize();
+  const auto base = numel / world_size;
+  const auto remainder = numel % world_size;
+  return std::make_pair(
+      rank * base + std::min<int64_t>(rank, remainder),
+      base + (rank < remainder ? 1 : 0));
+}
+
+std::vector<std::tuple<torch::autograd::Variable, int64_t, at::Tensor>>
+Reducer::get_grad_shards() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  TORCH_CHECK(shard_gradients_, "Gradient sharding is not enabled.");
+  std::vector<std::tuple<torch::autograd::Variable, int64_t, at::Tensor>>
+      grad_shards;
+  const auto rank = process_group_->getRank();
+  for (const auto& bucket : buckets_) {
+    const auto& replica = bucket.replicas[0];
+    const auto range = get_bucket_shard_range(bucket, rank);
+    const auto shard_end = range.first + range.second;
+    for (size_t i = 0; i < replica.variables.size(); i++) {
+      const int64_t offset = replica.offsets[i];
+      const int64_t start = std::max<int64_t>(offset, range.first);
+      const int64_t end =
+          std::min<int64_t>(offset + replica.lengths[i], shard_end);
+      if (start < end) {
+        grad_shards.emplace_back(
+            replica.variables[i],
+            start - offset,
+            replica.contents.narrow(0, start, end - start));
+      }
+    }
+  }
+  return grad_shards;
 }
 
 // See Note [DDP Communication Hook]
@@ -1350,6 +1594,9 @@ void Reducer::register_comm_hook(std::unique_ptr<CommHookInterface> iface) {
   TORCH_CHECK(
       comm_hook_ == nullptr,
       "register_comm_hook or register_builtin_comm_hook can only be called once.");
+  TORCH_CHECK(
+      !shard_gradients_,
+      "Communication hooks cannot be combined with gradient sharding.");
   // TODO(#42542): Single-process multiple-device mode support for DDP
   // communication hook.
   TORCH_CHECK(
@@ -1361,10 +1608,14 @@ void Reducer::register_comm_hook(std::unique_ptr<CommHookInterface> iface) {
 
 // See Note [DDP Communication Hook]
 void Reducer::register_builtin_comm_hook(
-    c10d::BuiltinCommHookType comm_hook_type) {
+    c10d::BuiltinCommHookType comm_hook_type,
+    const c10d::BuiltinCommHookOptions& options) {
   TORCH_CHECK(
       comm_hook_ == nullptr,
       "register_builtin_comm_hook or register_comm_hook can only be called once.");
+  TORCH_CHECK(
+      !shard_gradients_,
+      "Communication hooks cannot be combined with gradient sharding.");
   TORCH_CHECK(
       replicas_.size() == 1,
       "Communication hook does not support single-process multiple-device mode.");
@@ -1385,6 +1636,21 @@ void Reducer::register_builtin_comm_hook(
           std::make_unique<c10d::FP16CompressCommHook>(process_group_.get());
       LOG(INFO) << "Built-in communication hook FP16_COMPRESS is registered.";
       break;
+    case c10d::BuiltinCommHookType::POWER_SGD:
+      comm_hook_ = std::make_unique<c10d::PowerSGDCommHook>(
+          c10d::PowerSGDState(process_group_.get(), options));
+      LOG(INFO) << "Built-in communication hook POWER_SGD is registered.";
+      break;
+    case c10d::BuiltinCommHookType::TOPK_COMPRESS:
+      TORCH_CHECK(
+          options.compress_ratio > 0 && options.compress_ratio <= 1,
+          "Expect `compress_ratio` in (0, 1], but got ",
+          options.compress_ratio);
+      comm_hook_ = std::make_unique<c10d::TopKCompressCommHook>(
+          c10d::TopKCompressState{
+              process_group_.get(), options.compress_ratio, {}});
+      LOG(INFO) << "Built-in communication hook TOPK_COMPRESS is registered.";
+      break;
     default:
       TORCH_WARN_ONCE(
           "Unknown built-in DDP comm hook type is provided. No comm hook will be used.");
@@ -1432,6 +1698,10 @@ void Reducer::ensure_prior_reduction_finished() {
 }
 
 bool Reducer::should_collect_runtime_stats() {
+  // Bucket size autotuning measures every iteration.
+  if (bucket_autotuning_.in_progress) {
+    return true;
+  }
   if (num_iterations_ > 0 &&
     (num_iterations_ <= 10 ||
     num_iterations_ % kDDPRuntimeLoggingSampleRate == 0)) {
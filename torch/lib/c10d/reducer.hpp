@@ -74,12 +74,41 @@ class Reducer {
 
   // Registers a built-in C++ comm hook to the reducer. This function can only
   // be called once before calling backward.
-  // Cannot combine with the call of `register_comm_hook`.
-  void register_builtin_comm_hook(c10d::BuiltinCommHookType comm_hook_type);
+  // Cannot combine with the call of `register_comm_hook`. `options` only
+  // matters for the compression hooks that have hyperparameters.
+  void register_builtin_comm_hook(
+      c10d::BuiltinCommHookType comm_hook_type,
+      const c10d::BuiltinCommHookOptions& options = {});
 
   // Returns a vector of tensors in each bucket in sequential order.
   std::vector<std::vector<at::Tensor>> get_bucket_tensors() const;
 
+  // Enables sharded gradient reduction for ZeRO-style optimizers that only
+  // keep the optimizer state of a shard of the parameters. Every bucket is
+  // split into one contiguous shard per rank and reduce-scattered instead of
+  // allreduced, so each rank only receives the averaged gradients of its own
+  // shard, and the gradients outside of the shard are zeroed. Must be called
+  // before the first iteration. Cannot be combined with a communication hook,
+  // sparse gradients or single-process multiple-device mode.
+  void set_gradient_sharding(bool enabled);
+
+  // Tells the reducer that the parameters used by every iteration, and the
+  // order in which their gradients become ready, never change. With
+  // find_unused_parameters_, the autograd graph is then only traversed in the
+  // first iteration, and the parameters found unused there are marked ready in
+  // every later iteration without a traversal. The buckets are also rebuilt
+  // once in the gradient ready order of the first iteration, which
+  // find_unused_parameters_ otherwise prevents. Must be called before the
+  // first iteration.
+  void set_static_graph();
+
+  // Returns the gradients in this rank's shards. Every variable that
+  // intersects a shard gets one (variable, offset, gradient shard) entry,
+  // where the gradient shard is a 1D view of the bucket contents that
+  // corresponds to the elements of the flattened variable starting at offset.
+  std::vector<std::tuple<torch::autograd::Variable, int64_t, at::Tensor>>
+  get_grad_shards() const;
+
   // Rebuild buckets based on rebuilt_params_ and rebuilt_param_indices_
   // according to when tensors received grads in the backward pass.
   // TODO this function makes broadcast communication call and
@@ -95,14 +124,25 @@ class Reducer {
 
   // Returns true if we should rebuild buckets, else false. We only rebuild
   // buckets once after the first iteration and never rebuild them if
-  // find_unused_parameters_.
+  // find_unused_parameters_, unless the graph is static.
   inline bool should_rebuild_buckets() const {
-    return !find_unused_parameters_ && !has_rebuilt_bucket_;
+    return (static_graph_ || !find_unused_parameters_) && !has_rebuilt_bucket_;
   }
 
   // Pushes all parameters to be rebuilt.
   void push_rebuilt_params_for_all_indices();
 
+  // Enables autotuning of the bucket size cap. Instead of rebuilding the
+  // buckets once with `bucket_bytes_cap_`, the first rebuild starts to try each
+  // of `bucket_bytes_cap_candidates` for `iterations_per_candidate` iterations,
+  // and then locks in the candidate with the least exposed communication time,
+  // i.e., the time from the end of backward computation to the end of the
+  // last communication, summed over all ranks. Must be called before the
+  // first iteration. Not supported if find_unused_parameters_ is true.
+  void set_bucket_bytes_cap_autotuning(
+      std::vector<int64_t> bucket_bytes_cap_candidates,
+      int64_t iterations_per_candidate);
+
   // Creates and sets ForwardPassWorkHandle given a ProcessGroup::Work and the
   // corresponding tensor being reduced.
   void set_forward_pass_work_handle(
@@ -135,6 +175,13 @@ class Reducer {
 
   void push_rebuilt_params(const VariableIndex& index);
 
+  // Computes the bucket assignment of `params` in the given order with the
+  // given bucket size cap, syncs it from rank 0, and initializes the buckets.
+  void rebuild_buckets_by_size(
+      const std::vector<at::Tensor>& params,
+      const std::vector<int64_t>& param_indices,
+      int64_t bucket_bytes_cap);
+
   mutable std::mutex mutex_;
   std::vector<std::vector<torch::autograd::Variable>> replicas_;
   c10::intrusive_ptr<::c10d::ProcessGroup> process_group_;
@@ -155,6 +202,11 @@ class Reducer {
   const bool find_unused_parameters_;
   const bool gradient_as_bucket_view_;
   std::vector<VariableIndex> unused_parameters_;
+  // See `set_static_graph`. The unused parameters found by the traversal of
+  // the first iteration, valid once has_static_unused_parameters_ is set.
+  bool static_graph_ = false;
+  bool has_static_unused_parameters_ = false;
+  std::vector<VariableIndex> static_unused_parameters_;
   // Locally used parameter maps indicating if parameters are used locally
   // during the current iteration or no_sync session if no_sync is on. One
   // tensor for each model replica and each tensor is one-dim int32 tensor of
@@ -383,6 +435,47 @@ class Reducer {
   std::vector<int64_t> rebuilt_param_indices_;
   const int64_t bucket_bytes_cap_;
 
+  // Whether buckets are reduce-scattered. See `set_gradient_sharding`.
+  bool shard_gradients_ = false;
+
+  // Returns the [start, start + length) range of the bucket contents that is
+  // owned by the given rank in sharded gradient reduction.
+  std::pair<int64_t, int64_t> get_bucket_shard_range(
+      const Bucket& bucket,
+      int rank) const;
+
+  // State of the bucket size cap autotuning. See
+  // `set_bucket_bytes_cap_autotuning`.
+  struct BucketAutotuningState {
+    std::vector<int64_t> candidates;
+    int64_t iterations_per_candidate = 0;
+    // Index of the candidate that the current buckets are built with.
+    size_t current = 0;
+    // The number of measured iterations for the current candidate.
+    int64_t iterations_recorded = 0;
+    // Accumulated exposed communication time (ns) of each candidate.
+    std::vector<int64_t> exposed_comm_times;
+    // The parameters and their indices in the gradient ready order of the
+    // first iteration, which are reused for every candidate.
+    std::vector<at::Tensor> params;
+    std::vector<int64_t> param_indices;
+    // Whether the candidates are being tried.
+    bool in_progress = false;
+    // Whether the last backward pass reduced gradients and can be measured.
+    bool sample_ready = false;
+    // The locked-in bucket size cap, or -1 if not decided yet.
+    int64_t chosen_bucket_bytes_cap = -1;
+  };
+  BucketAutotuningState bucket_autotuning_;
+
+  // Measures one iteration of autotuning, and rebuilds the buckets when moving
+  // on to the next candidate or locking in the best one. Returns true if the
+  // buckets were rebuilt.
+  bool autotune_buckets();
+
+  // Returns the exposed communication time of the last iteration (ns).
+  int64_t get_last_exposed_comm_time();
+
   struct RpcContext {
     using ContextPtr = torch::distributed::autograd::ContextPtr;
     // The shared_ptr is to hold the context instance.
@@ -278,13 +278,17 @@ def storage_from_cache(cls, key):
     return cls._new_with_weak_ptr(storage_ref.cdata)
 
 
-def rebuild_storage_fd(cls, df, size):
+def rebuild_storage_fd(cls, df, size, pooled=False):
     fd = df.detach()
     try:
         storage = storage_from_cache(cls, fd_id(fd))
         if storage is not None:
+            # The pooled segment counted this process once more when it was
+            # pickled, see NOTE [ Shared Memory Pool ]
+            if pooled:
+                storage._shared_decref()
             return storage
-        storage = cls._new_shared_fd(fd, size)
+        storage = cls._new_shared_fd(fd, size, pooled)
         shared_cache[fd_id(fd)] = StorageWeakRef(storage)
         return storage
     finally:
@@ -318,11 +322,13 @@ def reduce_storage(storage):
         # (with size 0) cannot be mmapped.
         return (rebuild_storage_empty, (type(storage),))
     else:
-        fd, size = storage._share_fd_()
+        fd, size, pooled = storage._share_fd_()
         df = multiprocessing.reduction.DupFd(fd)
         cache_key = fd_id(fd)
-        metadata = (df, size)
+        metadata = (df, size, pooled)
         rebuild = rebuild_storage_fd  # type: ignore[assignment]
+        if pooled:
+            storage._shared_incref()
 
     shared_cache[cache_key] = StorageWeakRef(storage)
     return (rebuild, (type(storage),) + metadata)
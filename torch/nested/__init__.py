@@ -0,0 +1,56 @@
+r"""
+Nested tensors hold a batch of tensors that only differ in the size of their
+first dimension, e.g. sequences of different lengths, without padding them to
+a common length. The components are packed in a single buffer, so that
+pointwise ops, :func:`torch.nn.functional.linear` and
+:func:`torch.nn.functional.layer_norm` over the inner dimensions run once over
+the actual elements instead of over the padded batch.
+
+The size of a nested tensor is the size of its padded form, i.e.
+``(len(components), max_length, *inner_size)``, and :meth:`~torch.Tensor.unbind`
+returns its components. Nested tensors don't support autograd.
+"""
+from typing import List
+
+import torch
+from torch import Tensor
+
+
+__all__ = [
+    'nested_tensor',
+    'from_padded',
+    'to_padded_tensor',
+]
+
+
+def nested_tensor(tensors: List[Tensor]) -> Tensor:
+    r"""Packs :attr:`tensors` into a nested tensor.
+
+    Args:
+        tensors (list of Tensor): the components. They must have the same
+            dtype, device and number of dimensions, and only differ in the size
+            of their first dimension.
+
+    Example::
+
+        >>> nt = torch.nested.nested_tensor([torch.randn(2, 4), torch.randn(5, 4)])
+        >>> nt.size()
+        torch.Size([2, 5, 4])
+    """
+    return torch._nested_tensor_from_tensor_list(tensors)
+
+
+def from_padded(padded: Tensor, lengths: List[int]) -> Tensor:
+    r"""Packs the first ``lengths[i]`` elements of each ``padded[i]`` into a
+    nested tensor, e.g. to get rid of the padding of a batch of sequences.
+
+    Args:
+        padded (Tensor): a batch of size ``(B, L, *)``
+        lengths (list of int): the ``B`` lengths, at most ``L`` each
+    """
+    return torch._nested_from_padded(padded, lengths)
+
+
+def to_padded_tensor(nt: Tensor, padding: float = 0.) -> Tensor:
+    r"""See :func:`torch.to_padded_tensor`"""
+    return torch.to_padded_tensor(nt, padding)
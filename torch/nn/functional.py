@@ -3363,20 +3363,20 @@ upsample.__doc__ = upsample.__doc__.format(**reproducibility_notes)
 
 
 @_overload  # noqa: F811
-def interpolate(input, size=None, scale_factor=None, mode='nearest', align_corners=None, recompute_scale_factor=None):  # noqa: F811
-    # type: (Tensor, Optional[int], Optional[List[float]], str, Optional[bool], Optional[bool]) -> Tensor
+def interpolate(input, size=None, scale_factor=None, mode='nearest', align_corners=None, recompute_scale_factor=None, antialias=False):  # noqa: F811
+    # type: (Tensor, Optional[int], Optional[List[float]], str, Optional[bool], Optional[bool], bool) -> Tensor
     pass
 
 
 @_overload  # noqa: F811
-def interpolate(input, size=None, scale_factor=None, mode='nearest', align_corners=None, recompute_scale_factor=None):  # noqa: F811
-    # type: (Tensor, Optional[List[int]], Optional[List[float]], str, Optional[bool], Optional[bool]) -> Tensor
+def interpolate(input, size=None, scale_factor=None, mode='nearest', align_corners=None, recompute_scale_factor=None, antialias=False):  # noqa: F811
+    # type: (Tensor, Optional[List[int]], Optional[List[float]], str, Optional[bool], Optional[bool], bool) -> Tensor
     pass
 
 
 @_overload  # noqa: F811
-def interpolate(input, size=None, scale_factor=None, mode='nearest', align_corners=None, recompute_scale_factor=None):  # noqa: F811
-    # type: (Tensor, Optional[int], Optional[float], str, Optional[bool], Optional[bool]) -> Tensor
+def interpolate(input, size=None, scale_factor=None, mode='nearest', align_corners=None, recompute_scale_factor=None, antialias=False):  # noqa: F811
+    # type: (Tensor, Optional[int], Optional[float], str, Optional[bool], Optional[bool], bool) -> Tensor
     pass
 
 
@@ -3388,11 +3388,12 @@ def interpolate(  # noqa: F811
     mode: str = "nearest",
     align_corners: Optional[bool] = None,
     recompute_scale_factor: Optional[bool] = None,
+    antialias: bool = False,
 ) -> Tensor:  # noqa: F811
     pass
 
-def interpolate(input, size=None, scale_factor=None, mode='nearest', align_corners=None, recompute_scale_factor=None):  # noqa: F811
-    # type: (Tensor, Optional[int], Optional[List[float]], str, Optional[bool], Optional[bool]) -> Tensor
+def interpolate(input, size=None, scale_factor=None, mode='nearest', align_corners=None, recompute_scale_factor=None, antialias=False):  # noqa: F811
+    # type: (Tensor, Optional[int], Optional[List[float]], str, Optional[bool], Optional[bool], bool) -> Tensor
     r"""Down/up samples the input to either the given :attr:`size` or the given
     :attr:`scale_factor`
 
@@ -3434,6 +3435,11 @@ def interpolate(input, size=None, scale_factor=None, mode='nearest', align_corne
             `output_size` were passed-in explicitly).  Note that when `scale_factor` is floating-point,
             the recomputed scale_factor may differ from the one passed in due to rounding and precision
             issues.
+        antialias (bool, optional): flag to apply anti-aliasing. Default: ``False``. Using anti-alias
+            option together with ``align_corners=False``, interpolation result would match Pillow
+            result for downsampling operation. Supported modes: ``'bilinear'``, ``'bicubic'``,
+            on 4-D CPU inputs of dtype ``float``, ``double`` or ``uint8``, in contiguous or
+            channels last memory format.
 
     .. note::
         With ``mode='bicubic'``, it's possible to cause overshoot, in other words it can produce
@@ -3471,6 +3477,7 @@ def interpolate(input, size=None, scale_factor=None, mode='nearest', align_corne
             mode=mode,
             align_corners=align_corners,
             recompute_scale_factor=recompute_scale_factor,
+            antialias=antialias,
         )
 
     if mode in ("nearest", "area"):
@@ -3489,6 +3496,9 @@ def interpolate(input, size=None, scale_factor=None, mode='nearest', align_corne
             )
             align_corners = False
 
+    if antialias and not (mode in ("bilinear", "bicubic") and input.dim() == 4):
+        raise ValueError("Anti-alias option is only supported for bilinear and bicubic modes")
+
     dim = input.dim() - 2  # Number of spatial dimensions.
 
     # Process size and scale_factor.  Validate that exactly one is set.
@@ -3581,12 +3591,16 @@ def interpolate(input, size=None, scale_factor=None, mode='nearest', align_corne
         return torch._C._nn.upsample_linear1d(input, output_size, align_corners, scale_factors)
     if input.dim() == 4 and mode == "bilinear":
         assert align_corners is not None
+        if antialias:
+            return torch._C._nn._upsample_bilinear2d_aa(input, output_size, align_corners, scale_factors)
         return torch._C._nn.upsample_bilinear2d(input, output_size, align_corners, scale_factors)
     if input.dim() == 5 and mode == "trilinear":
         assert align_corners is not None
         return torch._C._nn.upsample_trilinear3d(input, output_size, align_corners, scale_factors)
     if input.dim() == 4 and mode == "bicubic":
         assert align_corners is not None
+        if antialias:
+            return torch._C._nn._upsample_bicubic2d_aa(input, output_size, align_corners, scale_factors)
         return torch._C._nn.upsample_bicubic2d(input, output_size, align_corners, scale_factors)
 
     if input.dim() == 3 and mode == "bilinear":
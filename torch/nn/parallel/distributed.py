@@ -414,6 +414,8 @@ class DistributedDataParallel(Module):
         self.device = list(self.module.parameters())[0].device
         self.broadcast_buffers = broadcast_buffers
         self.find_unused_parameters = find_unused_parameters
+        self.static_graph = False
+        self._static_graph_outputs_found = False
         self.require_backward_grad_sync = True
         self.require_forward_param_sync = True
         self.ddp_uneven_inputs_config = _DDPUnevenInputsConfig(
@@ -536,6 +538,10 @@ class DistributedDataParallel(Module):
         self.__dict__.setdefault('require_backward_grad_sync', True)
         parameters, expect_sparse_gradient = self._build_params_for_reducer()
         self._ddp_init_helper(parameters, expect_sparse_gradient)
+        # The new reducer has to find the unused parameters again
+        self._static_graph_outputs_found = False
+        if self.__dict__.setdefault('static_graph', False):
+            self.reducer._set_static_graph()
 
     def _replicate_modules_within_process(self):
         if self.device_ids and len(self.device_ids) > 1:
@@ -749,8 +755,11 @@ class DistributedDataParallel(Module):
             # because we need to figure out which parameters were used during
             # this forward pass, to ensure we short circuit reduction for any
             # unused parameters. Only if `find_unused_parameters` is set.
-            if self.find_unused_parameters:
+            # With a static graph, the reducer only looks at the outputs of
+            # the first iteration.
+            if self.find_unused_parameters and not self._static_graph_outputs_found:
                 self.reducer.prepare_for_backward(list(_find_tensors(output)))
+                self._static_graph_outputs_found = self.static_graph
             else:
                 self.reducer.prepare_for_backward([])
         else:
@@ -1146,7 +1155,7 @@ class DistributedDataParallel(Module):
         dist._register_comm_hook(self.reducer, state, hook)
 
     def _register_builtin_comm_hook(
-        self, comm_hook_type
+        self, comm_hook_type, **options
     ):
         r"""
         Registers a built-in communication hook that specifies how DDP
@@ -1157,6 +1166,9 @@ class DistributedDataParallel(Module):
         Args:
             comm_hook_type (dist.BuiltinCommHookType): type of communication hook, such as
             ALLREDUCE, FP16_COMPRESS, etc.
+            **options: hyperparameters of the hook, which are set as the fields of
+            ``dist.BuiltinCommHookOptions``, such as ``matrix_approximation_rank``
+            for POWER_SGD and ``compress_ratio`` for TOPK_COMPRESS.
 
         .. warning ::
             DDP communication hook can only be registered once and should be registered
@@ -1176,9 +1188,121 @@ class DistributedDataParallel(Module):
 
             >>> ddp._register_builtin_comm_hook(dist.BuiltinCommHookType.FP16_COMPRESS)
 
+            Below is an example of PowerSGD implemented in C++, which avoids
+            acquiring the GIL for every bucket.
+
+            >>> ddp._register_builtin_comm_hook(
+            >>>     dist.BuiltinCommHookType.POWER_SGD, matrix_approximation_rank=2
+            >>> )
+
         """
+        hook_options = dist.BuiltinCommHookOptions()
+        for name, value in options.items():
+            if not hasattr(hook_options, name):
+                raise ValueError(f"Unknown built-in comm hook option: {name}")
+            setattr(hook_options, name, value)
         self.logger._set_comm_hook_name(str(comm_hook_type))
-        dist._register_builtin_comm_hook(self.reducer, comm_hook_type)
+        dist._register_builtin_comm_hook(self.reducer, comm_hook_type, hook_options)
+
+    def _enable_bucket_cap_autotuning(
+        self, bucket_caps_mb, iterations_per_candidate=5
+    ):
+        r"""
+        Lets DDP choose the bucket size cap by itself. Instead of rebuilding the
+        buckets once with ``bucket_cap_mb`` after the first iteration, DDP tries
+        each of ``bucket_caps_mb`` for ``iterations_per_candidate`` iterations,
+        and then locks in the one with the least exposed communication time,
+        i.e., the time spent waiting for communication after backward
+        computation has finished, summed over all ranks. The chosen value is
+        reported as ``autotuned_bucket_cap_mb`` in the DDP logging data.
+
+        Args:
+            bucket_caps_mb (List[float]): the candidate bucket size caps in MB.
+            iterations_per_candidate (int): the number of iterations that
+                reduce gradients to measure each candidate over.
+
+        .. warning ::
+            This must be called before the first iteration, and is not
+            supported with ``find_unused_parameters=True``.
+
+        .. warning ::
+            The buckets are rebuilt for every candidate, so communication hooks
+            that keep per-bucket state (e.g., PowerSGD with error feedback)
+            should only start compressing after the autotuning iterations.
+
+        Example::
+
+            >>> ddp._enable_bucket_cap_autotuning([5, 25, 100])
+        """
+        self.reducer._set_bucket_bytes_cap_autotuning(
+            [int(cap_mb * 1024 * 1024) for cap_mb in bucket_caps_mb],
+            iterations_per_candidate,
+        )
+
+    def _set_static_graph(self):
+        r"""
+        Tells DDP that the wrapped module uses the same parameters, in the same
+        order, in every iteration. With ``find_unused_parameters=True``, the
+        autograd graph is then only traversed in the first iteration, and the
+        parameters found unused there are marked ready in every later
+        iteration without a traversal. The buckets are also rebuilt once in
+        the gradient ready order of the first iteration, which
+        ``find_unused_parameters=True`` otherwise prevents.
+
+        .. warning ::
+            This must be called before the first iteration. If a later
+            iteration uses a parameter that was unused in the first one, DDP
+            raises an error about marking a variable ready twice, and if it
+            leaves a parameter that was used unused, DDP hangs waiting for its
+            gradient.
+
+        Example::
+
+            >>> ddp = torch.nn.parallel.DistributedDataParallel(
+            >>>     model, find_unused_parameters=True)
+            >>> ddp._set_static_graph()
+        """
+        self.reducer._set_static_graph()
+        self.static_graph = True
+
+    def _enable_gradient_sharding(self):
+        r"""
+        Reduces gradients for ZeRO-style optimizers that only keep the optimizer
+        state of a shard of the parameters on each rank. Every gradient bucket
+        is split into one contiguous shard per rank and reduce-scattered instead
+        of allreduced, so after backward each rank only holds the averaged
+        gradients of its own shards, and the gradients outside of them are
+        zero. Use :meth:`_get_grad_shards` to retrieve the shards to step on.
+
+        .. warning ::
+            This must be called before the first iteration, and cannot be
+            combined with communication hooks, sparse gradients, or
+            single-process multi-device mode.
+
+        .. warning ::
+            The bucket layout, and therefore the shard of each rank, can change
+            after the first iteration, when the buckets are rebuilt.
+
+        Example::
+
+            >>> ddp._enable_gradient_sharding()
+            >>> ddp(input).sum().backward()
+            >>> for param, offset, grad_shard in ddp._get_grad_shards():
+            >>>     param_shard = param.detach().view(-1).narrow(
+            >>>         0, offset, grad_shard.numel())
+            >>>     param_shard.add_(grad_shard, alpha=-lr)
+        """
+        self.reducer._set_gradient_sharding(True)
+
+    def _get_grad_shards(self):
+        r"""
+        Returns a list of ``(param, offset, grad_shard)`` tuples, one for every
+        parameter that intersects a shard owned by this rank, where
+        ``grad_shard`` is a 1D view of the reduced gradient for the elements of
+        the flattened ``param`` starting at ``offset``. Only available after
+        :meth:`_enable_gradient_sharding`.
+        """
+        return self.reducer._get_grad_shards()
 
     def _distributed_broadcast_coalesced(
         self, tensors, buffer_size, authoritative_rank=0
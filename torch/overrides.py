@@ -113,6 +113,8 @@ def get_ignored_functions() -> Set[Callable]:
         torch.qscheme,
         torch.set_grad_enabled,
         torch.no_grad,
+        torch.inference_mode,
+        torch.is_inference_mode_enabled,
         torch.enable_grad,
         torch.layout,
         torch.align_tensors,
@@ -178,6 +180,10 @@ def get_ignored_functions() -> Set[Callable]:
         handle_torch_function,
         torch.set_autocast_enabled,
         torch.is_autocast_enabled,
+        torch.set_autocast_cpu_enabled,
+        torch.is_autocast_cpu_enabled,
+        torch.set_autocast_cpu_dtype,
+        torch.get_autocast_cpu_dtype,
         torch.clear_autocast_cache,
         torch.autocast_increment_nesting,
         torch.autocast_decrement_nesting,
@@ -427,6 +433,9 @@ def get_testing_overrides() -> Dict[Callable, Callable]:
         torch.fliplr: lambda input: -1,
         torch.flipud: lambda input: -1,
         torch.frobenius_norm: lambda input, dim=None, keepdim=False, out=None: -1,
+        torch.fused_moving_avg_obs_fake_quant: (lambda x, observer_on, fake_quant_on, running_min, running_max, scale,
+                                                zero_point, averaging_const, quant_min, quant_max, ch_axis,
+                                                per_row_fake_quant=False, symmetric_quant=False: -1),
         torch.floor: lambda input, out=None: -1,
         torch.floor_divide: lambda input, other: -1,
         torch.float_power: lambda input, exponent, out=None: -1,
@@ -640,7 +649,7 @@ def get_testing_overrides() -> Dict[Callable, Callable]:
         torch.nn.functional.instance_norm: (lambda input, running_mean=None, running_var=None, weight=None, bias=None,
                                             use_input_stats=True, momentum=0.1, eps=1e-05: -1),
         torch.nn.functional.interpolate: (lambda input, size=None, scale_factor=None, mode='nearest', align_corners=None,
-                                          recompute_scale_factor=None: -1),
+                                          recompute_scale_factor=None, antialias=False: -1),
         torch.nn.functional.kl_div: lambda input, target, size_average=None, reduce=None, reduction='mean', log_target=False: -1,
         torch.nn.functional.l1_loss: lambda input, target, size_average=None, reduce=None, reduction='mean': -1,
         torch.nn.functional.layer_norm: lambda input, normalized_shape, weight=None, bias=None, eps=1e-05: -1,
@@ -837,6 +846,7 @@ def get_testing_overrides() -> Dict[Callable, Callable]:
         torch.threshold: lambda input, threshold, value, inplace=False: -1,
         torch.tile: lambda input, dims: -1,
         torch.topk: lambda input, k, dim=-1, descending=False, out=None: -1,
+        torch.to_padded_tensor: lambda input, padding=0: -1,
         torch.trace: lambda input: -1,
         torch.transpose: lambda input, dim0, dim1: -1,
         torch.trapz: lambda y, x=None, dim=-1: -1,
@@ -912,6 +922,7 @@ def get_testing_overrides() -> Dict[Callable, Callable]:
         Tensor.is_meta.__get__: lambda self: -1,
         Tensor.is_mlc.__get__: lambda self: -1,
         Tensor.is_mkldnn.__get__: lambda self: -1,
+        Tensor.is_nested.__get__: lambda self: -1,
         Tensor.is_quantized.__get__: lambda self: -1,
         Tensor.is_sparse.__get__: lambda self: -1,
         Tensor.is_vulkan.__get__: lambda self: -1,
@@ -926,6 +937,8 @@ def get_testing_overrides() -> Dict[Callable, Callable]:
         Tensor.real.__get__: lambda self: -1,
         Tensor.imag.__get__: lambda self: -1,
         Tensor.__cuda_array_interface__.__get__: lambda self: -1,
+        Tensor.__dlpack__: lambda self, stream=None: -1,
+        Tensor.__dlpack_device__: lambda self: -1,
         Tensor.type: lambda self, dtype=None, non_blocking=False, **kwargs: -1,
         Tensor._coalesced_: lambda self: -1,
         Tensor._dimI: lambda self: -1,
@@ -972,6 +985,7 @@ def get_testing_overrides() -> Dict[Callable, Callable]:
         Tensor.int: lambda self, memory_format=torch.preserve_format: -1,
         Tensor.is_coalesced: lambda self: -1,
         Tensor.is_contiguous: lambda self: -1,
+        Tensor.is_inference: lambda self: -1,
         Tensor.is_pinned: lambda self: -1,
         Tensor.is_set_to: lambda self, tensor: -1,
         Tensor.is_shared: lambda self: -1,
@@ -1019,6 +1033,7 @@ def get_testing_overrides() -> Dict[Callable, Callable]:
         Tensor.tile: lambda self, *reps: -1,
         Tensor.to: lambda self, dtype, non_blocking=False, copy=False, memory_format=torch.preserve_format: -1,
         Tensor.to_dense: lambda self: -1,
+        Tensor.to_padded_tensor: lambda self, padding=0: -1,
         Tensor.to_sparse: lambda self: -1,
         Tensor.tolist: lambda self: -1,
         Tensor.to_mkldnn: lambda self: -1,
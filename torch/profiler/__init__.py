@@ -9,6 +9,6 @@ examine their input shapes and stack traces, study device kernel activity and vi
 
 '''
 
-from .profiler import profile, schedule, tensorboard_trace_handler, ProfilerAction, ProfilerActivity
+from .profiler import profile, schedule, on_demand_schedule, tensorboard_trace_handler, ProfilerAction, ProfilerActivity
 from torch.autograd import kineto_available, DeviceType
 from torch.autograd.profiler import record_function
@@ -45,6 +45,73 @@ def schedule(*, wait: int, warmup: int, active: int, repeat: int = 0) -> Callabl
     return schedule_fn
 
 
+def on_demand_schedule(
+        *,
+        trigger_file: Optional[str] = None,
+        trigger_signal: Optional[int] = None,
+        warmup: int = 1,
+        active: int = 1) -> Callable:
+    """
+    Returns a callable that can be used as profiler ``schedule`` argument for long-running jobs.
+    The profiler stays off until a capture is requested, either by creating ``trigger_file``
+    (e.g. ``touch /tmp/trigger``; the file is removed once the request is seen) or by sending
+    ``trigger_signal`` to the process (e.g. ``signal.SIGUSR2``). It then does the warmup for the
+    next ``warmup`` steps, records the next ``active`` steps, hands the trace to ``on_trace_ready``
+    and goes back to waiting for the next request.
+
+    While waiting no profiler is installed, so the cost per step is a check of a flag and,
+    with ``trigger_file``, of the file's existence. The signal handler is installed by this
+    function, so it has to be called from the main thread when ``trigger_signal`` is used.
+    """
+    import os
+    import signal
+
+    assert trigger_file is not None or trigger_signal is not None, \
+        "Either trigger_file or trigger_signal must be specified"
+    assert warmup >= 0 and active > 0, \
+        "Invalid profiler schedule arguments"
+    if warmup == 0:
+        warn("Profiler won't be using warmup, this can skew profiler results")
+
+    signaled = False
+    capture_start: Optional[int] = None
+
+    if trigger_signal is not None:
+        def signal_handler(signum, frame):
+            nonlocal signaled
+            signaled = True
+        signal.signal(trigger_signal, signal_handler)
+
+    def consume_trigger() -> bool:
+        nonlocal signaled
+        if signaled:
+            signaled = False
+            return True
+        if trigger_file is not None and os.path.exists(trigger_file):
+            try:
+                os.remove(trigger_file)
+            except OSError:
+                pass
+            return True
+        return False
+
+    def schedule_fn(step: int) -> ProfilerAction:
+        nonlocal capture_start
+        assert step >= 0
+        if capture_start is not None and step - capture_start >= warmup + active:
+            capture_start = None
+        if capture_start is None:
+            if not consume_trigger():
+                return ProfilerAction.NONE
+            capture_start = step
+        offset = step - capture_start
+        if offset < warmup:
+            return ProfilerAction.WARMUP
+        return ProfilerAction.RECORD if offset < warmup + active - 1 \
+            else ProfilerAction.RECORD_AND_SAVE
+    return schedule_fn
+
+
 def _default_schedule_fn(_: int) -> ProfilerAction:
     """
     Default profiler behavior - immediately starts recording the events,
@@ -94,6 +161,8 @@ class profile(object):
     - ``profile_memory`` - track tensor memory allocation/deallocation;
     - ``with_stack`` - record source information (file and line number) for the ops;
     - ``with_flops`` - use formula to estimate the FLOPS of specific operators (matrix multiplication and 2D convolution);
+    - ``sampling_prob`` - probability to record any given CPU op, ops that are not sampled don't
+      pay for the profiler callbacks and don't appear in the trace;
     - ``use_cuda`` - (deprecated, use ``activities``).
 
     .. note::
@@ -103,6 +172,11 @@ class profile(object):
         of the training process.
         The default schedule simply records all the events continuously for the
         duration of the context manager.
+        Use ``torch.profiler.on_demand_schedule`` to keep the profiler off until
+        a capture is requested with a file or a signal, e.g. for jobs running for days.
+        Combined with ``sampling_prob`` and ``tensorboard_trace_handler``, each capture
+        is written to its own file as soon as it is done, so traces don't accumulate
+        in memory.
 
     .. note::
         Use ``torch.profiler.tensorboard_trace_handler`` to generate result files for TensorBoard:
@@ -180,6 +254,7 @@ class profile(object):
             profile_memory: bool = False,
             with_stack: bool = False,
             with_flops: bool = False,
+            sampling_prob: float = 1.0,
             # deprecated:
             use_cuda: Optional[bool] = None):
         if activities:
@@ -212,6 +287,7 @@ class profile(object):
         self.with_flops = with_flops
         self.profile_memory = profile_memory
         self.with_stack = with_stack
+        self.sampling_prob = sampling_prob
         self.step_num = 0
         self.current_action = self.schedule(self.step_num)
         self.profiler: Optional[prof.profile] = None
@@ -333,6 +409,16 @@ class profile(object):
         assert self.profiler
         return self.profiler.function_events
 
+    def memory_timeline(self):
+        """
+        Returns the live tensor memory over time, with each allocation attributed to the
+        ops and ``record_function`` ranges that were open when it was made. Use its
+        ``peak_breakdown()`` to see what owns the memory at the peak.
+        Requires ``profile_memory=True``.
+        """
+        assert self.profiler
+        return self.profiler.memory_timeline()
+
     def _enter_actions(self):
         if self.current_action == ProfilerAction.WARMUP:
             self._start_warmup()
@@ -360,6 +446,7 @@ class profile(object):
             profile_memory=self.profile_memory,
             with_stack=self.with_stack,
             use_kineto=True,
+            sampling_prob=self.sampling_prob,
         )
         self.profiler._prepare_kineto_trace()
 
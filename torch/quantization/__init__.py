@@ -50,6 +50,8 @@ _all__ = [
     'default_affine_fixed_qparams_fake_quant',
     'default_per_channel_weight_fake_quant',
     'default_histogram_fake_quant',
+    'default_fused_act_fake_quant', 'default_fused_wt_fake_quant',
+    'default_fused_per_channel_wt_fake_quant',
     # QConfig
     'QConfig', 'default_qconfig', 'default_dynamic_qconfig', 'float16_dynamic_qconfig',
     'float_qparams_weight_only_qconfig',
@@ -193,6 +193,45 @@ class FakeQuantize(FakeQuantizeBase):
         super(FakeQuantize, self)._load_from_state_dict(state_dict, prefix, local_metadata, strict,
                                                         missing_keys, unexpected_keys, error_msgs)
 
+class FusedMovingAvgObsFakeQuantize(FakeQuantize):
+    r"""Fused version of FakeQuantize with a moving average min/max observer.
+
+    The observer update, the computation of scale and zero point and the fake
+    quantization run in a single native op, ``torch.fused_moving_avg_obs_fake_quant``,
+    instead of a series of small ops and host syncs on every forward. The results
+    are the same as the ones of :class:`FakeQuantize` with the same observer.
+
+    Only :class:`~torch.quantization.observer.MovingAverageMinMaxObserver` and
+    :class:`~torch.quantization.observer.MovingAveragePerChannelMinMaxObserver`
+    are supported, and symmetric ``torch.quint8`` quantization only with the full
+    [0, 255] range.
+    """
+
+    def __init__(self, observer=MovingAverageMinMaxObserver, quant_min=0, quant_max=255, **observer_kwargs):
+        super().__init__(observer, quant_min, quant_max, **observer_kwargs)
+        assert isinstance(self.activation_post_process, (MovingAverageMinMaxObserver,
+                                                         MovingAveragePerChannelMinMaxObserver)), \
+            'Fused observer and fake quantize supports only the moving average min/max observers'
+        assert self.activation_post_process._calculate_qmin_qmax() == (quant_min, quant_max), \
+            'quant_min and quant_max must match the quantization range of the observer'
+        self.is_symmetric_quant = self.qscheme in [torch.per_tensor_symmetric, torch.per_channel_symmetric]
+        assert not self.is_symmetric_quant or self.dtype != torch.quint8 or (quant_min, quant_max) == (0, 255), \
+            'Symmetric torch.quint8 quantization is only supported for the [0, 255] range'
+
+    def forward(self, X):
+        if self.is_per_channel:
+            running_min = self.activation_post_process.min_vals
+            running_max = self.activation_post_process.max_vals
+        else:
+            running_min = self.activation_post_process.min_val
+            running_max = self.activation_post_process.max_val
+        return torch.fused_moving_avg_obs_fake_quant(
+            X, self.observer_enabled, self.fake_quant_enabled,
+            running_min, running_max, self.scale, self.zero_point,
+            self.activation_post_process.averaging_constant,
+            self.quant_min, self.quant_max, self.ch_axis,
+            self.is_per_channel, self.is_symmetric_quant)
+
 class FixedQParamsFakeQuantize(FakeQuantizeBase):
     """ Simulate quantize and dequantize with fixed quantization
     parameters in training time. Only per tensor quantization
@@ -270,6 +309,27 @@ default_histogram_fake_quant = FakeQuantize.with_args(observer=HistogramObserver
                                                       qscheme=torch.per_tensor_affine,
                                                       reduce_range=True)
 
+default_fused_act_fake_quant = FusedMovingAvgObsFakeQuantize.with_args(observer=MovingAverageMinMaxObserver,
+                                                                      quant_min=0,
+                                                                      quant_max=255,
+                                                                      dtype=torch.quint8,
+                                                                      qscheme=torch.per_tensor_affine,
+                                                                      reduce_range=False)
+default_fused_wt_fake_quant = FusedMovingAvgObsFakeQuantize.with_args(observer=MovingAverageMinMaxObserver,
+                                                                     quant_min=-128,
+                                                                     quant_max=127,
+                                                                     dtype=torch.qint8,
+                                                                     qscheme=torch.per_tensor_symmetric,
+                                                                     reduce_range=False)
+default_fused_per_channel_wt_fake_quant = FusedMovingAvgObsFakeQuantize.with_args(
+    observer=MovingAveragePerChannelMinMaxObserver,
+    quant_min=-128,
+    quant_max=127,
+    dtype=torch.qint8,
+    qscheme=torch.per_channel_symmetric,
+    reduce_range=False,
+    ch_axis=0)
+
 def _is_fake_quant_script_module(mod):
     ''' Returns true if given mod is an instance of FakeQuantize script module.
     '''
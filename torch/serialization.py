@@ -331,7 +331,8 @@ def _check_dill_version(pickle_module) -> None:
             ))
 
 def save(obj, f: Union[str, os.PathLike, BinaryIO, IO[bytes]],
-         pickle_module=pickle, pickle_protocol=DEFAULT_PROTOCOL, _use_new_zipfile_serialization=True) -> None:
+         pickle_module=pickle, pickle_protocol=DEFAULT_PROTOCOL, _use_new_zipfile_serialization=True,
+         _use_compression=False) -> None:
     """Saves an object to a disk file.
 
     See also: `saving-loading-tensors`
@@ -356,6 +357,12 @@ def save(obj, f: Union[str, os.PathLike, BinaryIO, IO[bytes]],
         load files in the old format. If for any reason you want ``torch.save``
         to use the old format, pass the kwarg ``_use_new_zipfile_serialization=False``.
 
+    .. note::
+        Passing ``_use_compression=True`` deflates the records of the zipfile,
+        compressing large storages in parallel chunks. ``torch.load`` reads
+        these files like any other, and they can still be loaded by earlier
+        releases, though without the parallel decompression.
+
     Example:
         >>> # Save to file
         >>> x = torch.tensor([0, 1, 2, 3, 4])
@@ -369,6 +376,8 @@ def save(obj, f: Union[str, os.PathLike, BinaryIO, IO[bytes]],
     with _open_file_like(f, 'wb') as opened_file:
         if _use_new_zipfile_serialization:
             with _open_zipfile_writer(opened_file) as opened_zipfile:
+                if _use_compression:
+                    opened_zipfile.enable_compression()
                 _save(obj, opened_zipfile, pickle_module, pickle_protocol)
                 return
         _legacy_save(obj, opened_file, pickle_module, pickle_protocol)
@@ -14,6 +14,7 @@ from torch.overrides import (
     has_torch_function, has_torch_function_unary, has_torch_function_variadic,
     handle_torch_function)
 import torch.utils.hooks as hooks
+from torch.utils.dlpack import DLDeviceType
 
 
 def _wrap_type_error_to_not_implemented(f):
@@ -719,6 +720,50 @@ class Tensor(torch._C._TensorBase):
 
         return dict(typestr=typestr, shape=shape, strides=strides, data=data, version=2)
 
+    def __dlpack__(self, stream=None):
+        """Exports the tensor as a DLPack capsule, for the ``from_dlpack`` of
+        another library.
+
+        Args:
+            stream (int, optional): the CUDA stream the consumer will use the
+                tensor on, as a raw ``cudaStream_t`` value. 1 is the legacy
+                default stream and 2 the per-thread default stream. The
+                consumer stream is made to wait for the work queued on the
+                current stream so far, without blocking the host. ``None``
+                or -1 skip the synchronization, e.g. when the consumer
+                already took care of it.
+        """
+        if has_torch_function_unary(self):
+            return handle_torch_function(Tensor.__dlpack__, (self,), self, stream=stream)
+
+        # RuntimeError, matching tensor.__array__() behavior.
+        if self.requires_grad:
+            raise RuntimeError(
+                "Can't export tensors that require gradient, use tensor.detach()")
+        if self.is_sparse:
+            raise RuntimeError("Can't export sparse tensors through DLPack")
+        if stream is not None and type(stream) is not int:
+            raise TypeError("stream must be ``int`` or ``None``")
+
+        if self.is_cuda and stream is not None and stream != -1:
+            torch._C._cuda_externalStreamWaitCurrentStream(self.device.index, stream)
+        return torch.utils.dlpack.to_dlpack(self)
+
+    def __dlpack_device__(self) -> Tuple[int, int]:
+        """Returns the ``(device_type, device_id)`` pair of DLPack's
+        ``DLContext`` for the tensor."""
+        if has_torch_function_unary(self):
+            return handle_torch_function(Tensor.__dlpack_device__, (self,), self)
+        idx = self.device.index if self.device.index is not None else 0
+        if self.is_cuda:
+            # ROCm builds look like CUDA to PyTorch, but not to DLPack
+            device_type = DLDeviceType.kDLROCM if torch.version.hip is not None else DLDeviceType.kDLGPU
+        elif self.device.type == 'cpu':
+            device_type = DLDeviceType.kDLCPU
+        else:
+            raise ValueError("Unknown device type {} for DLPack".format(self.device.type))
+        return (device_type, idx)
+
     def refine_names(self, *names):
         r"""Refines the dimension names of :attr:`self` according to :attr:`names`.
 
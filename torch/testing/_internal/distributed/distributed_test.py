@@ -2065,6 +2065,34 @@ class DistributedTest:
                 rank_to_GPU=None
             )
 
+        @require_backend({"nccl"})
+        @skip_if_no_gpu
+        def test_all_reduce_coalesced_sum_cuda(self):
+            group, group_id, rank = self._init_global_test()
+            rank_to_GPU = self._init_multigpu_helper()
+            self._test_all_reduce_coalesced_helper(
+                group,
+                group_id,
+                rank,
+                dist.ReduceOp.SUM,
+                cuda=True,
+                rank_to_GPU=rank_to_GPU,
+            )
+
+        @require_backend({"nccl"})
+        @skip_if_no_gpu
+        def test_all_reduce_coalesced_max_cuda(self):
+            group, group_id, rank = self._init_global_test()
+            rank_to_GPU = self._init_multigpu_helper()
+            self._test_all_reduce_coalesced_helper(
+                group,
+                group_id,
+                rank,
+                dist.ReduceOp.MAX,
+                cuda=True,
+                rank_to_GPU=rank_to_GPU,
+            )
+
         # SCATTER
         def _test_scatter_helper(self, group, group_id, rank):
             for dest in group:
@@ -2311,33 +2339,53 @@ class DistributedTest:
 
             self._barrier()
 
-        @unittest.skipIf(BACKEND == "nccl", "all_gather_coalesced does not support NCCL")
-        @unittest.skipIf(BACKEND == "mpi", "all_gather_coalesced does not support MPI")
+        @unittest.skipIf(BACKEND == "nccl", "Nccl does not support CPU tensors")
         def test_all_gather_coalesced_simple(self):
             group, group_id, rank = self._init_global_test()
             self._test_all_gather_coalesced_helper(group, group_id, rank)
 
-        @unittest.skipIf(BACKEND == "nccl", "all_gather_coalesced does not support NCCL")
-        @unittest.skipIf(BACKEND == "mpi", "all_gather_coalesced does not support MPI")
+        @unittest.skipIf(BACKEND == "nccl", "Nccl does not support CPU tensors")
         def test_all_gather_coalesced_complex(self):
             group, group_id, rank = self._init_global_test()
             self._test_all_gather_coalesced_helper(group, group_id, rank, dtype=torch.cfloat)
 
         @skip_if_small_worldsize
-        @unittest.skipIf(BACKEND == "nccl", "all_gather_coalesced does not support NCCL")
-        @unittest.skipIf(BACKEND == "mpi", "all_gather_coalesced does not support MPI")
+        @unittest.skipIf(BACKEND == "nccl", "Nccl does not support CPU tensors")
         def test_all_gather_coalesced_group(self):
             group, group_id, rank = self._init_group_test()
             self._test_all_gather_coalesced_helper(group, group_id, rank)
 
-        @unittest.skipIf(BACKEND == "nccl", "all_gather_coalesced does not support NCCL")
-        @unittest.skipIf(BACKEND == "mpi", "all_gather_coalesced does not support MPI")
+        @unittest.skipIf(BACKEND == "nccl", "Nccl does not support CPU tensors")
         def test_all_gather_coalesced_full_group(self):
             group, group_id, rank = self._init_full_group_test()
             self._test_all_gather_coalesced_helper(group, group_id, rank)
 
-        @unittest.skipIf(BACKEND == "nccl", "all_gather_coalesced does not support NCCL")
-        @unittest.skipIf(BACKEND == "mpi", "all_gather_coalesced does not support MPI")
+        @require_backend({"nccl"})
+        @skip_if_no_gpu
+        def test_all_gather_coalesced_cuda(self):
+            group, group_id, rank = self._init_global_test()
+            rank_to_GPU = self._init_multigpu_helper()
+            device = rank_to_GPU[rank][0]
+            input_tensors = [
+                rank * torch.ones([2, 2], device=device),
+                torch.ones([0], device=device),
+                (rank + 1) * torch.ones([3], device=device),
+            ]
+            output_tensors_lists = [
+                [torch.empty_like(t) for t in input_tensors] for _ in group
+            ]
+            expected_tensors = [
+                [
+                    r * torch.ones([2, 2], device=device),
+                    torch.ones([0], device=device),
+                    (r + 1) * torch.ones([3], device=device),
+                ] for r in group
+            ]
+            assert self._run_all_gather_coalesced_and_verify(
+                output_tensors_lists, input_tensors, expected_tensors, group_id)
+            self._barrier()
+
+        @unittest.skipIf(BACKEND == "nccl", "Nccl does not support CPU tensors")
         def test_all_gather_coalesced_with_empty(self):
             group, group_id, rank = self._init_global_test()
             input_tensors = [
@@ -3610,6 +3658,78 @@ class DistributedTest:
                 ddp_logging_data.bucket_sizes,
                 [params[1].numel() * params[1].element_size(), params[0].numel() * params[0].element_size()])
 
+        @unittest.skipIf(
+            BACKEND == "nccl", "nccl does not support DDP on CPU models"
+        )
+        def test_ddp_bucket_cap_autotuning_cpu(self):
+            self._init_global_test()
+            torch.manual_seed(0)
+            model = LargeNet()
+            local_model = copy.deepcopy(model)
+            model_DDP = nn.parallel.DistributedDataParallel(model)
+            model_DDP._enable_bucket_cap_autotuning([1.5, 25], iterations_per_candidate=2)
+            params = list(model_DDP.parameters())
+            param_sizes = [p.numel() * p.element_size() for p in params]
+            # 1 iteration to record the ready order, 2 iterations per candidate, 1
+            # iteration whose forward locks in the result, and 1 more iteration for
+            # the logger to pick it up.
+            for _ in range(7):
+                model_DDP.zero_grad()
+                local_model.zero_grad()
+                inp = torch.randn(2, 1000)
+                model_DDP(inp).sum().backward()
+                local_model(inp).sum().backward()
+                # Every rank uses the same input, so the averaged grads are the local ones.
+                for p_ddp, p_local in zip(params, local_model.parameters()):
+                    self.assertEqual(p_ddp.grad, p_local.grad)
+
+            ddp_logging_data = model_DDP.logger.get_ddp_logging_data()
+            self.assertIn(ddp_logging_data.autotuned_bucket_cap_mb, [1.5, 25])
+            self.assertEqual(sum(ddp_logging_data.rebuilt_bucket_sizes), sum(param_sizes))
+
+            with self.assertRaisesRegex(RuntimeError, "before the first iteration"):
+                model_DDP._enable_bucket_cap_autotuning([25])
+
+        @unittest.skipIf(
+            BACKEND == "nccl", "nccl does not support DDP on CPU models"
+        )
+        def test_ddp_gradient_sharding_cpu(self):
+            self._init_global_test()
+            torch.manual_seed(0)
+            model = LargeNet()
+            local_model = copy.deepcopy(model)
+            model_DDP = nn.parallel.DistributedDataParallel(model, bucket_cap_mb=1.5)
+            model_DDP._enable_gradient_sharding()
+            params = list(model_DDP.parameters())
+            # Run twice to cover the buckets before and after rebuilding.
+            for _ in range(2):
+                model_DDP.zero_grad()
+                local_model.zero_grad()
+                inp = torch.randn(2, 1000)
+                model_DDP(inp).sum().backward()
+                local_model(inp).sum().backward()
+
+                # Every rank uses the same input, so the averaged grads are the local ones.
+                expected_grads = {
+                    id(p_ddp): torch.zeros_like(p_local.grad).view(-1)
+                    for p_ddp, p_local in zip(params, local_model.parameters())
+                }
+                local_grads = {
+                    id(p_ddp): p_local.grad.view(-1)
+                    for p_ddp, p_local in zip(params, local_model.parameters())
+                }
+                for param, offset, grad_shard in model_DDP._get_grad_shards():
+                    length = grad_shard.numel()
+                    expected_shard = local_grads[id(param)].narrow(0, offset, length)
+                    self.assertEqual(grad_shard, expected_shard)
+                    expected_grads[id(param)].narrow(0, offset, length).copy_(expected_shard)
+                # Gradients outside of this rank's shards are zeroed.
+                for param in params:
+                    self.assertEqual(param.grad.view(-1), expected_grads[id(param)])
+
+            with self.assertRaisesRegex(RuntimeError, "before the first iteration"):
+                model_DDP._enable_gradient_sharding()
+
         @unittest.skipIf(BACKEND != 'nccl' and BACKEND != 'gloo',
                          "Only Nccl & Gloo backend support DistributedDataParallel")
         @skip_if_no_gpu
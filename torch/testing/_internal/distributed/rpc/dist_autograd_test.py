@@ -1079,6 +1079,24 @@ class DistAutogradTest(RpcAgentTestFixture):
                 )
                 local_grads = ret if ret else local_grads
 
+    @dist_init
+    def test_backward_batched_gradient_rpcs(self):
+        dst = worker_name(self._next_rank())
+        tensors = [torch.rand((3, 3), requires_grad=True) for _ in range(3)]
+        with dist_autograd.context() as context_id:
+            vals = [rpc.rpc_sync(dst, torch.add, args=(t, t)) for t in tensors]
+            loss = torch.stack(vals).sum()
+            dist_autograd.backward(context_id, [loss])
+
+            # The gradients of the three responses all go back to dst, so
+            # they are sent with a single RPC.
+            ctx = dist_autograd._retrieve_context(context_id)
+            self.assertEqual(1, ctx._num_gradient_rpcs())
+
+            grads = dist_autograd.get_gradients(context_id)
+            for t in tensors:
+                self.assertEqual(torch.full((3, 3), 2.0), grads[t])
+
     @dist_init
     def test_backward_different_tensor_dims(self):
         local_grads = None
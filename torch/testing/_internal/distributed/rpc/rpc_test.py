@@ -4611,6 +4611,41 @@ class TensorPipeAgentRpcTest(RpcAgentTestFixture):
                 rpc_timeout=timeout,
             )
 
+    @dist_init
+    def test_tensorpipe_metrics_snapshot(self):
+        agent = rpc.api._get_current_rpc_agent()
+        dst = worker_name((self.rank + 1) % self.world_size)
+        num_calls = 10
+        for _ in range(num_calls):
+            rpc.rpc_sync(dst, torch.add, args=(torch.ones(2, 2), 1))
+
+        snapshot = agent._get_metrics_snapshot()
+        prefix = "torch.distributed.rpc."
+        latency = snapshot["histograms"][prefix + "latency_us.destination." + dst]
+        self.assertEqual(latency["count"], num_calls)
+        self.assertEqual(sum(latency["buckets"]), num_calls)
+        self.assertLessEqual(latency["p50"], latency["p99"])
+        self.assertLessEqual(latency["p99"], latency["max"])
+        self.assertGreater(snapshot["counters"][prefix + "bytes_sent"], 0)
+        self.assertGreater(snapshot["counters"][prefix + "bytes_received"], 0)
+        self.assertGreaterEqual(
+            snapshot["histograms"][prefix + "serialization_time_us"]["count"],
+            num_calls,
+        )
+        self.assertIn(prefix + "thread_pool_queue_depth", snapshot["gauges"])
+        self.assertEqual(snapshot["gauges"][prefix + "pending_responses"], 0)
+
+        info = agent.get_debug_info()
+        self.assertEqual(
+            int(info[prefix + "latency_us.destination." + dst + ".count"]),
+            num_calls,
+        )
+
+        agent._reset_metrics()
+        snapshot = agent._get_metrics_snapshot()
+        latency = snapshot["histograms"][prefix + "latency_us.destination." + dst]
+        self.assertEqual(latency["count"], 0)
+
     def _test_device_maps(self, options, errMsg="Invalid device_map"):
         with self.assertRaisesRegex(ValueError, errMsg):
             rpc.init_rpc(
@@ -121,7 +121,7 @@ class _ResumeIteration(object):
 
 def _worker_loop(dataset_kind, dataset, index_queue, data_queue, done_event,
                  auto_collation, collate_fn, drop_last, seed, init_fn, worker_id,
-                 num_workers, persistent_workers):
+                 num_workers, persistent_workers, prefetch_factor):
     # See NOTE [ Data Loader Multiprocessing Shutdown Logic ] for details on the
     # logic of this function.
 
@@ -134,6 +134,11 @@ def _worker_loop(dataset_kind, dataset, index_queue, data_queue, done_event,
         signal_handling._set_worker_signal_handlers()
 
         torch.set_num_threads(1)
+        # With the file_descriptor sharing strategy, reuse the shared memory
+        # segments of the batches the main process has freed instead of
+        # creating new ones for every batch. See NOTE [ Shared Memory Pool ]
+        # in torch/csrc/multiprocessing/shared_memory_pool.h
+        torch.multiprocessing._set_shared_memory_pool_size(4 * prefetch_factor)
         random.seed(seed)
         torch.manual_seed(seed)
 
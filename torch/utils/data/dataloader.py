@@ -15,6 +15,7 @@ from typing import Any, Callable, TypeVar, Generic, Sequence, List, Optional
 import multiprocessing as python_multiprocessing
 import torch
 import torch.multiprocessing as multiprocessing
+import torch.utils.vitals
 from torch._utils import ExceptionWrapper
 from torch._six import string_classes
 
@@ -40,6 +41,10 @@ default_collate: _collate_fn_t = _utils.collate.default_collate
 
 get_worker_info = _utils.worker.get_worker_info
 
+# Batches requested from the workers of all the multi-process iterators, but
+# not received yet. See `torch.utils.vitals`.
+_tasks_outstanding_gauge = torch.utils.vitals.gauge("dataloader.tasks_outstanding")
+
 class _DatasetKind(object):
     Map = 0
     Iterable = 1
@@ -904,7 +909,7 @@ class _MultiProcessingDataLoaderIter(_BaseDataLoaderIter):
                       self._worker_result_queue, self._workers_done_event,
                       self._auto_collation, self._collate_fn, self._drop_last,
                       self._base_seed + i, self._worker_init_fn, i, self._num_workers,
-                      self._persistent_workers))
+                      self._persistent_workers, self._prefetch_factor))
             w.daemon = True
             # NB: Process.start() actually take some time as it needs to
             #     start a process and pass the arguments over via a pipe.
@@ -948,6 +953,9 @@ class _MultiProcessingDataLoaderIter(_BaseDataLoaderIter):
         # map: task idx => - (worker_id,)        if data isn't fetched (outstanding)
         #                  \ (worker_id, data)   if data is already fetched (out-of-order)
         self._task_info = {}
+        if not first_iter:
+            # The tasks of the previous epoch are dropped
+            _tasks_outstanding_gauge.add(-self._tasks_outstanding)
         self._tasks_outstanding = 0  # always equal to count(v for v in task_info.values() if len(v) == 1)
         # A list of booleans representing whether each worker still has work to
         # do, i.e., not having exhausted its iterable dataset object. It always
@@ -1182,6 +1190,7 @@ class _MultiProcessingDataLoaderIter(_BaseDataLoaderIter):
             assert not self._shutdown and self._tasks_outstanding > 0
             idx, data = self._get_data()
             self._tasks_outstanding -= 1
+            _tasks_outstanding_gauge.add(-1)
             if self._dataset_kind == _DatasetKind.Iterable:
                 # Check for _IterableDatasetStopIteration
                 if isinstance(data, _utils.worker._IterableDatasetStopIteration):
@@ -1217,6 +1226,7 @@ class _MultiProcessingDataLoaderIter(_BaseDataLoaderIter):
         self._index_queues[worker_queue_idx].put((self._send_idx, index))
         self._task_info[self._send_idx] = (worker_queue_idx,)
         self._tasks_outstanding += 1
+        _tasks_outstanding_gauge.add(1)
         self._send_idx += 1
 
     def _process_data(self, data):
@@ -1264,6 +1274,9 @@ class _MultiProcessingDataLoaderIter(_BaseDataLoaderIter):
         # See (1) and the second half of the note.
         if not self._shutdown:
             self._shutdown = True
+            # Use getattr in case error happens before we set the attribute.
+            _tasks_outstanding_gauge.add(-getattr(self, '_tasks_outstanding', 0))
+            self._tasks_outstanding = 0
             try:
                 # Normal exit when last reference is gone / iterator is depleted.
                 # See (1) and the second half of the note.
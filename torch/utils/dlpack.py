@@ -1,19 +1,23 @@
+from typing import Any
+
+import enum
+
 import torch
 
-from torch._C import _from_dlpack as from_dlpack
+from torch._C import _from_dlpack
 from torch._C import _to_dlpack as to_dlpack
 
-torch._C._add_docstr(from_dlpack, r"""from_dlpack(dlpack) -> Tensor
-
-Decodes a DLPack to a tensor.
 
-Args:
-    dlpack: a PyCapsule object with the dltensor
+class DLDeviceType(enum.IntEnum):
+    # Enums as in DLPack specification (aten/src/ATen/dlpack.h)
+    kDLCPU = 1
+    kDLGPU = 2
+    kDLCPUPinned = 3
+    kDLOpenCL = 4
+    kDLMetal = 8
+    kDLVPI = 9
+    kDLROCM = 10
 
-The tensor will share the memory with the object represented
-in the dlpack.
-Note that each dlpack can only be consumed once.
-""")
 
 torch._C._add_docstr(to_dlpack, r"""to_dlpack(tensor) -> PyCapsule
 
@@ -25,3 +29,38 @@ Args:
 The dlpack shares the tensors memory.
 Note that each dlpack can only be consumed once.
 """)
+
+
+def from_dlpack(ext_tensor: Any) -> torch.Tensor:
+    r"""from_dlpack(ext_tensor) -> Tensor
+
+    Decodes a DLPack to a tensor.
+
+    Args:
+        ext_tensor: a PyCapsule object with the dltensor, or an object of
+            another library that implements ``__dlpack__`` and
+            ``__dlpack_device__``
+
+    The tensor will share the memory with the object represented
+    in the dlpack. When :attr:`ext_tensor` implements ``__dlpack__``, the
+    current stream of the tensor's CUDA device is passed to it, so that the
+    producer can make that stream wait for its pending work instead of
+    synchronizing the device. Kernels launched on the current stream
+    afterwards can use the tensor safely.
+    Note that each dlpack can only be consumed once.
+    """
+    if hasattr(ext_tensor, '__dlpack__'):
+        device = ext_tensor.__dlpack_device__()
+        # The legacy default stream is 1 in the protocol, because 0 is
+        # ambiguous
+        if device[0] in (DLDeviceType.kDLGPU, DLDeviceType.kDLROCM):
+            stream = torch.cuda.current_stream('cuda:{}'.format(device[1]))
+            is_cuda = device[0] == DLDeviceType.kDLGPU
+            stream_ptr = 1 if is_cuda and stream.cuda_stream == 0 else stream.cuda_stream
+            dlpack = ext_tensor.__dlpack__(stream=stream_ptr)
+        else:
+            dlpack = ext_tensor.__dlpack__()
+    else:
+        # A capsule from to_dlpack or the converter of another library
+        dlpack = ext_tensor
+    return _from_dlpack(dlpack)
@@ -36,6 +36,22 @@ class ExecutionStats(object):
     def num_iters(self):
         return self._c_stats.num_iters
 
+    @property
+    def latency_p50_ms(self):
+        return self._c_stats.latency_p50_ms
+
+    @property
+    def latency_p90_ms(self):
+        return self._c_stats.latency_p90_ms
+
+    @property
+    def latency_p99_ms(self):
+        return self._c_stats.latency_p99_ms
+
+    @property
+    def latency_p999_ms(self):
+        return self._c_stats.latency_p999_ms
+
     @property
     def iters_per_second(self):
         '''
@@ -45,13 +61,14 @@ class ExecutionStats(object):
 
     @property
     def total_time_seconds(self):
-        return self.num_iters * (
-            self.latency_avg_ms / 1000.0) / self.benchmark_config.num_calling_threads
-
+        return self._c_stats.total_time_ms / 1000.0
 
     def __str__(self):
         return '\n'.join([
             "Average latency per example: " + format_time(time_ms=self.latency_avg_ms),
+            "Latency p50 / p90 / p99 / p99.9: " + " / ".join(
+                format_time(time_ms=t) for t in
+                [self.latency_p50_ms, self.latency_p90_ms, self.latency_p99_ms, self.latency_p999_ms]),
             "Total number of iterations: {}".format(self.num_iters),
             "Total number of iterations per second (across all threads): {:.2f}".format(self.iters_per_second),
             "Total time: " + format_time(time_s=self.total_time_seconds)
@@ -89,6 +106,9 @@ class ThroughputBenchmark(object):
             )
         >>> print("Avg latency (ms): {}".format(stats.latency_avg_ms))
         >>> print("Number of iterations: {}".format(stats.num_iters))
+        >>> # Open-loop load at 200 requests per second, for capacity planning
+        >>> stats = bench.benchmark(num_calling_threads=4, num_iters=1000, target_qps=200)
+        >>> print("p99 latency (ms): {}".format(stats.latency_p99_ms))
 
     '''
 
@@ -121,7 +141,9 @@ class ThroughputBenchmark(object):
             num_calling_threads=1,
             num_warmup_iters=10,
             num_iters=100,
-            profiler_output_path=""):
+            profiler_output_path="",
+            target_qps=0,
+            cpu_affinity=None):
         '''
         Args:
             num_warmup_iters (int): Warmup iters are used to make sure we run a module
@@ -141,16 +163,34 @@ class ThroughputBenchmark(object):
                 execution (but not the warmup phase). The full trace will be saved
                 into the file path provided by this argument
 
+            target_qps (float): If positive, the benchmark generates an open-loop load:
+                requests arrive at this average rate per second following a Poisson
+                process, whether or not the previous ones are done, and are served by
+                the first free calling thread. The latency of a request then includes
+                the time it waited for a thread. If 0, each calling thread sends its
+                next request as soon as the previous one is done (closed-loop load).
+                Warmup iterations always run closed-loop and are not measured
+
+            cpu_affinity (list of int, optional): CPUs to pin the calling threads to.
+                Calling thread i is pinned to cpu_affinity[i % len(cpu_affinity)].
+                Only supported on Linux
+
 
-        This function returns BenchmarkExecutionStats object which is defined via pybind11.
-        It currently has two fields:
+        This function returns an ExecutionStats object wrapping the
+        BenchmarkExecutionStats defined via pybind11. Its fields are:
             - num_iters - number of actual iterations the benchmark have made
-            - avg_latency_ms - average time it took to infer on one input example in milliseconds
+            - latency_avg_ms - average time it took to infer on one input example in milliseconds
+            - latency_p50_ms, latency_p90_ms, latency_p99_ms, latency_p999_ms -
+              percentiles of the per-request latencies in milliseconds
+            - total_time_seconds - wall time of the measured iterations
         '''
         config = torch._C.BenchmarkConfig()
         config.num_calling_threads = num_calling_threads
         config.num_warmup_iters = num_warmup_iters
         config.num_iters = num_iters
         config.profiler_output_path = profiler_output_path
+        config.target_qps = target_qps
+        if cpu_affinity is not None:
+            config.cpu_affinity = list(cpu_affinity)
         c_stats = self._benchmark.benchmark(config)
         return ExecutionStats(c_stats, config)
@@ -0,0 +1,69 @@
+r"""
+Always-on performance counters of the process, e.g. how many graphs the JIT
+has optimized or how many backward passes the autograd engine has run. They
+are cheap enough to leave in production code, and :func:`snapshot` reads all
+of them at once, e.g. to export them to a monitoring system.
+
+Metrics are registered by name on first use, and a name can only refer to one
+kind of metric. The ones registered by PyTorch itself are:
+
+- ``autograd.backward_calls`` (counter): calls to the autograd engine
+- ``jit.optimized_graphs`` (counter): graphs optimized by the graph executors
+- ``dataloader.tasks_outstanding`` (gauge): batches requested from
+  :class:`~torch.utils.data.DataLoader` workers but not received yet
+
+Example::
+
+    >>> requests = torch.utils.vitals.counter("my_app.requests")
+    >>> latency = torch.utils.vitals.histogram("my_app.latency_ms", [1, 10, 100])
+    >>> requests.add()
+    >>> latency.observe(3.5)
+    >>> torch.utils.vitals.snapshot()["my_app.latency_ms"]
+    {'bounds': [1.0, 10.0, 100.0], 'counts': [0, 1, 0, 0], 'count': 1, 'sum': 3.5}
+"""
+from typing import Any, Dict, List
+
+import torch._C
+
+
+__all__ = ['counter', 'gauge', 'histogram', 'snapshot', 'reset']
+
+
+def counter(name: str) -> torch._C._VitalsCounter:
+    r"""Returns the counter registered under :attr:`name`, registering it on
+    first use. A counter only goes up, with ``add(n=1)``, and ``value()``
+    returns its current value."""
+    return torch._C._vitals_counter(name)
+
+
+def gauge(name: str) -> torch._C._VitalsGauge:
+    r"""Returns the gauge registered under :attr:`name`, registering it on
+    first use. A gauge goes up and down, with ``set(v)`` and ``add(n)``, and
+    ``value()`` returns its current value."""
+    return torch._C._vitals_gauge(name)
+
+
+def histogram(name: str, bounds: List[float]) -> torch._C._VitalsHistogram:
+    r"""Returns the histogram registered under :attr:`name`, registering it on
+    first use. ``observe(v)`` counts ``v`` in the first bucket whose bound is
+    at least ``v``, or in an extra last bucket if it is above all of them.
+
+    Args:
+        name (str): the name of the histogram
+        bounds (list of float): the sorted upper bounds of the buckets. They
+            must be the same every time the histogram is looked up.
+    """
+    return torch._C._vitals_histogram(name, bounds)
+
+
+def snapshot() -> Dict[str, Any]:
+    r"""Returns the current values of all the registered metrics, by name.
+    Counters and gauges are ints, and histograms are dicts with the
+    ``bounds``, ``counts``, ``count`` and ``sum`` of their observations."""
+    return torch._C._vitals_snapshot()
+
+
+def reset() -> None:
+    r"""Sets all the counters and histograms back to zero. Gauges track the
+    current state of their subsystem, and are left alone."""
+    torch._C._vitals_reset()